@@ -201,6 +201,10 @@ static Addr64 guest_RIP_curr_instr;
 /* The IRSB* into which we're generating code. */
 static IRSB* irsb;
 
+/* The CC_OP the flags thunk is expected to hold on entry to the
+   block, or -1 if unknown (see guest_cc_op_hint in VexAbiInfo). */
+static Long guest_cc_op_hint;
+
 /* For ensuring that %rip-relative addressing is done right.  A read
    of %rip generates the address of the next instruction.  It may be
    that we don't conveniently know that inside disAMode().  For sanity
@@ -1631,6 +1635,70 @@ static void casLE ( IRExpr* addr, IRExpr* expVal, IRExpr* newVal,
 
 /* -------------- Evaluating the flags-thunk. -------------- */
 
+/* Has anything earlier in the block written the thunk's CC_OP? */
+static Bool cc_op_is_written_in_block ( void )
+{
+   Int i, j;
+   for (i = irsb->stmts_used-1; i >= 0; i--) {
+      IRStmt* st = irsb->stmts[i];
+      if (st->tag == Ist_Put && st->Ist.Put.offset == OFFB_CC_OP)
+         return True;
+      if (st->tag == Ist_Dirty) {
+         IRDirty* d = st->Ist.Dirty.details;
+         for (j = 0; j < d->nFxState; j++) {
+            if (d->fxState[j].fx != Ifx_Read
+                && d->fxState[j].offset <= OFFB_CC_OP
+                && OFFB_CC_OP < d->fxState[j].offset + d->fxState[j].size)
+               return True;
+         }
+      }
+   }
+   return False;
+}
+
+/* |call| is a clean call to a thunk-evaluating helper, whose
+   |ix_op|'th arg is the thunk's CC_OP.  If the block hasn't set
+   CC_OP itself, iropt can't specialise the call.  But if we were
+   told which CC_OP to expect and the spec helper can specialise the
+   call for it, generate
+
+      t_slow = DIRTY (CC_OP != hint) call(args)   -- cold
+      ITE(CC_OP == hint, specialised(args), t_slow)
+
+   so that the expected case costs only the compare. */
+static IRExpr* mk_amd64g_spec_thunk_call ( IRExpr* call, Int ix_op )
+{
+   IRExpr** args;
+   IRExpr*  fast;
+   IRDirty* d;
+   IRTemp   isHint, slow, res;
+   IRCallee* cee = call->Iex.CCall.cee;
+
+   if (guest_cc_op_hint < 0 || cc_op_is_written_in_block())
+      return call;
+
+   args = shallowCopyIRExprVec(call->Iex.CCall.args);
+   args[ix_op] = mkU64(guest_cc_op_hint);
+   fast = guest_amd64_spechelper(cee->name, args,
+                                 irsb->stmts, irsb->stmts_used);
+   if (fast == NULL)
+      return call;
+
+   isHint = newTemp(Ity_I1);
+   slow   = newTemp(Ity_I64);
+   assign(isHint, binop(Iop_CmpEQ64, IRExpr_Get(OFFB_CC_OP, Ity_I64),
+                                     mkU64(guest_cc_op_hint)));
+   d = unsafeIRDirty_1_N(slow, cee->regparms, cee->name, cee->addr,
+                         call->Iex.CCall.args);
+   d->cee->mcx_mask = cee->mcx_mask;
+   d->guard = unop(Iop_Not1, mkexpr(isHint));
+   d->cold  = True;
+   stmt( IRStmt_Dirty(d) );
+   res = newTemp(Ity_I64);
+   assign(res, IRExpr_ITE(mkexpr(isHint), fast, mkexpr(slow)));
+   return mkexpr(res);
+}
+
 /* Build IR to calculate all the eflags from stored
    CC_OP/CC_DEP1/CC_DEP2/CC_NDEP.  Returns an expression ::
    Ity_I64. */
@@ -1675,7 +1743,7 @@ static IRExpr* mk_amd64g_calculate_condition ( AMD64Condcode cond )
    /* Exclude the requested condition, OP and NDEP from definedness
       checking.  We're only interested in DEP1 and DEP2. */
    call->Iex.CCall.cee->mcx_mask = (1<<0) | (1<<1) | (1<<4);
-   return unop(Iop_64to1, call);
+   return unop(Iop_64to1, mk_amd64g_spec_thunk_call(call, 1));
 }
 
 /* Build IR to calculate just the carry flag from stored
@@ -1697,7 +1765,7 @@ static IRExpr* mk_amd64g_calculate_rflags_c ( void )
    /* Exclude OP and NDEP from definedness checking.  We're only
       interested in DEP1 and DEP2. */
    call->Iex.CCall.cee->mcx_mask = (1<<0) | (1<<3);
-   return call;
+   return mk_amd64g_spec_thunk_call(call, 0);
 }
 
 
@@ -19806,9 +19874,12 @@ Long dis_ESC_NONE (
       if (resteerCisOk
           && vex_control.guest_chase_cond
           && (Addr64)d64 != (Addr64)guest_RIP_bbstart
-          && jmpDelta < 0
+          && (jmpDelta < 0
+              || !resteerOkFn( callback_opaque, guest_RIP_bbstart+delta ))
           && resteerOkFn( callback_opaque, d64) ) {
-         /* Speculation: assume this backward branch is taken.  So we
+         /* Speculation: assume this branch is taken.  It is a
+            backward branch, or a forward one whose fall-through we
+            may not chase into.  So we
             need to emit a side-exit to the insn following this one,
             on the negation of the condition, and continue at the
             branch target address (d64).  If we wind up back at the
@@ -19828,9 +19899,8 @@ Long dis_ESC_NONE (
       if (resteerCisOk
           && vex_control.guest_chase_cond
           && (Addr64)d64 != (Addr64)guest_RIP_bbstart
-          && jmpDelta >= 0
           && resteerOkFn( callback_opaque, guest_RIP_bbstart+delta ) ) {
-         /* Speculation: assume this forward branch is not taken.  So
+         /* Speculation: assume this branch is not taken.  So
             we need to emit a side-exit to d64 (the dest) and continue
             disassembling at the insn immediately following this
             one. */
@@ -21348,9 +21418,12 @@ Long dis_ESC_0F (
       if (resteerCisOk
           && vex_control.guest_chase_cond
           && (Addr64)d64 != (Addr64)guest_RIP_bbstart
-          && jmpDelta < 0
+          && (jmpDelta < 0
+              || !resteerOkFn( callback_opaque, guest_RIP_bbstart+delta ))
           && resteerOkFn( callback_opaque, d64) ) {
-         /* Speculation: assume this backward branch is taken.  So
+         /* Speculation: assume this branch is taken.  It is a
+            backward branch, or a forward one whose fall-through we
+            may not chase into.  So
             we need to emit a side-exit to the insn following this
             one, on the negation of the condition, and continue at
             the branch target address (d64).  If we wind up back at
@@ -21371,9 +21444,8 @@ Long dis_ESC_0F (
       if (resteerCisOk
           && vex_control.guest_chase_cond
           && (Addr64)d64 != (Addr64)guest_RIP_bbstart
-          && jmpDelta >= 0
           && resteerOkFn( callback_opaque, guest_RIP_bbstart+delta ) ) {
-         /* Speculation: assume this forward branch is not taken.
+         /* Speculation: assume this branch is not taken.
             So we need to emit a side-exit to d64 (the dest) and
             continue disassembling at the insn immediately
             following this one. */
@@ -31235,6 +31307,11 @@ DisResult disInstr_AMD64_WRK (
    /* Spot "Special" instructions (see comment at top of file). */
    {
       UChar* code = (UChar*)(guest_code + delta);
+      if (code[0] == 0xF3 && code[1] == 0x0F && code[2] == 0x1E
+          && code[3] == 0xFA) { /* LOCALTEST endbr64 */
+         delta += 4;
+         goto decode_success;
+      }
       /* Spot the 16-byte preamble:
          48C1C703   rolq $3,  %rdi
          48C1C70D   rolq $13, %rdi
@@ -31844,6 +31921,7 @@ DisResult disInstr_AMD64 ( IRSB*        irsb_IN,
    host_endness         = host_endness_IN;
    guest_RIP_curr_instr = guest_IP;
    guest_RIP_bbstart    = guest_IP - delta;
+   guest_cc_op_hint     = abiinfo->guest_cc_op_hint;
 
    /* We'll consult these after doing disInstr_AMD64_WRK. */
    guest_RIP_next_assumed   = 0;
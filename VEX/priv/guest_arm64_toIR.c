@@ -279,6 +279,12 @@ static IRExpr* triop ( IROp op, IRExpr* a1, IRExpr* a2, IRExpr* a3 )
    return IRExpr_Triop(op, a1, a2, a3);
 }
 
+static IRExpr* qop ( IROp op, IRExpr* a1, IRExpr* a2,
+                              IRExpr* a3, IRExpr* a4 )
+{
+   return IRExpr_Qop(op, a1, a2, a3, a4);
+}
+
 static IRExpr* loadLE ( IRType ty, IRExpr* addr )
 {
    return IRExpr_Load(Iend_LE, ty, addr);
@@ -12253,29 +12259,30 @@ Bool dis_AdvSIMD_fp_data_proc_3_source(/*MB_OUT*/DisResult* dres, UInt insn)
          where Fx=Dx when sz=1, Fx=Sx when sz=0
 
                   -----SPEC------    ----IMPL----
-         fmadd       a +    n * m    a + n * m
-         fmsub       a + (-n) * m    a - n * m
-         fnmadd   (-a) + (-n) * m    -(a + n * m)
-         fnmsub   (-a) +    n * m    -(a - n * m)
+         fmadd       a +    n * m    MAdd(n, m, a)
+         fmsub       a + (-n) * m    -MSub(n, m, a)
+         fnmadd   (-a) + (-n) * m    -MAdd(n, m, a)
+         fnmsub   (-a) +    n * m    MSub(n, m, a)
+
+         The MAdd/MSub IROps are fused, like the instructions, so the
+         product is not rounded by itself.
       */
       Bool    isD   = (ty & 1) == 1;
       UInt    ix    = (bitO1 << 1) | bitO0;
       IRType  ity   = isD ? Ity_F64 : Ity_F32;
-      IROp    opADD = mkADDF(ity);
-      IROp    opSUB = mkSUBF(ity);
-      IROp    opMUL = mkMULF(ity);
+      IROp    opFMA = isD ? Iop_MAddF64 : Iop_MAddF32;
+      IROp    opFMS = isD ? Iop_MSubF64 : Iop_MSubF32;
       IROp    opNEG = mkNEGF(ity);
       IRTemp  res   = newTemp(ity);
       IRExpr* eA    = getQRegLO(aa, ity);
       IRExpr* eN    = getQRegLO(nn, ity);
       IRExpr* eM    = getQRegLO(mm, ity);
       IRExpr* rm    = mkexpr(mk_get_IR_rounding_mode());
-      IRExpr* eNxM  = triop(opMUL, rm, eN, eM);
       switch (ix) {
-         case 0:  assign(res, triop(opADD, rm, eA, eNxM)); break;
-         case 1:  assign(res, triop(opSUB, rm, eA, eNxM)); break;
-         case 2:  assign(res, unop(opNEG, triop(opADD, rm, eA, eNxM))); break;
-         case 3:  assign(res, unop(opNEG, triop(opSUB, rm, eA, eNxM))); break;
+         case 0:  assign(res, qop(opFMA, rm, eN, eM, eA)); break;
+         case 1:  assign(res, unop(opNEG, qop(opFMS, rm, eN, eM, eA))); break;
+         case 2:  assign(res, unop(opNEG, qop(opFMA, rm, eN, eM, eA))); break;
+         case 3:  assign(res, qop(opFMS, rm, eN, eM, eA)); break;
          default: vassert(0);
       }
       putQReg128(dd, mkV128(0x0000));
@@ -211,6 +211,10 @@ static Addr32 guest_EIP_curr_instr;
 /* The IRSB* into which we're generating code. */
 static IRSB* irsb;
 
+/* The CC_OP the flags thunk is expected to hold on entry to the
+   block, or -1 if unknown (see guest_cc_op_hint in VexAbiInfo). */
+static Long guest_cc_op_hint;
+
 
 /*------------------------------------------------------------*/
 /*--- Debugging output                                     ---*/
@@ -778,6 +782,64 @@ static void casLE ( IRExpr* addr, IRExpr* expVal, IRExpr* newVal,
 
 /* -------------- Evaluating the flags-thunk. -------------- */
 
+/* Has anything earlier in the block written the thunk's CC_OP? */
+static Bool cc_op_is_written_in_block ( void )
+{
+   Int i, j;
+   for (i = irsb->stmts_used-1; i >= 0; i--) {
+      IRStmt* st = irsb->stmts[i];
+      if (st->tag == Ist_Put && st->Ist.Put.offset == OFFB_CC_OP)
+         return True;
+      if (st->tag == Ist_Dirty) {
+         IRDirty* d = st->Ist.Dirty.details;
+         for (j = 0; j < d->nFxState; j++) {
+            if (d->fxState[j].fx != Ifx_Read
+                && d->fxState[j].offset <= OFFB_CC_OP
+                && OFFB_CC_OP < d->fxState[j].offset + d->fxState[j].size)
+               return True;
+         }
+      }
+   }
+   return False;
+}
+
+/* As mk_amd64g_spec_thunk_call in guest_amd64_toIR.c: if the block
+   doesn't set CC_OP itself but we were told which CC_OP to expect,
+   specialise the thunk-evaluating |call| (whose |ix_op|'th arg is
+   CC_OP) for it, behind a guard with a cold fallback to the call. */
+static IRExpr* mk_x86g_spec_thunk_call ( IRExpr* call, Int ix_op )
+{
+   IRExpr** args;
+   IRExpr*  fast;
+   IRDirty* d;
+   IRTemp   isHint, slow, res;
+   IRCallee* cee = call->Iex.CCall.cee;
+
+   if (guest_cc_op_hint < 0 || cc_op_is_written_in_block())
+      return call;
+
+   args = shallowCopyIRExprVec(call->Iex.CCall.args);
+   args[ix_op] = mkU32(toUInt(guest_cc_op_hint));
+   fast = guest_x86_spechelper(cee->name, args,
+                               irsb->stmts, irsb->stmts_used);
+   if (fast == NULL)
+      return call;
+
+   isHint = newTemp(Ity_I1);
+   slow   = newTemp(Ity_I32);
+   assign(isHint, binop(Iop_CmpEQ32, IRExpr_Get(OFFB_CC_OP, Ity_I32),
+                                     mkU32(toUInt(guest_cc_op_hint))));
+   d = unsafeIRDirty_1_N(slow, cee->regparms, cee->name, cee->addr,
+                         call->Iex.CCall.args);
+   d->cee->mcx_mask = cee->mcx_mask;
+   d->guard = unop(Iop_Not1, mkexpr(isHint));
+   d->cold  = True;
+   stmt( IRStmt_Dirty(d) );
+   res = newTemp(Ity_I32);
+   assign(res, IRExpr_ITE(mkexpr(isHint), fast, mkexpr(slow)));
+   return mkexpr(res);
+}
+
 /* Build IR to calculate all the eflags from stored
    CC_OP/CC_DEP1/CC_DEP2/CC_NDEP.  Returns an expression ::
    Ity_I32. */
@@ -798,7 +860,7 @@ static IRExpr* mk_x86g_calculate_eflags_all ( void )
    /* Exclude OP and NDEP from definedness checking.  We're only
       interested in DEP1 and DEP2. */
    call->Iex.CCall.cee->mcx_mask = (1<<0) | (1<<3);
-   return call;
+   return mk_x86g_spec_thunk_call(call, 0);
 }
 
 /* Build IR to calculate some particular condition from stored
@@ -822,7 +884,7 @@ static IRExpr* mk_x86g_calculate_condition ( X86Condcode cond )
    /* Exclude the requested condition, OP and NDEP from definedness
       checking.  We're only interested in DEP1 and DEP2. */
    call->Iex.CCall.cee->mcx_mask = (1<<0) | (1<<1) | (1<<4);
-   return unop(Iop_32to1, call);
+   return unop(Iop_32to1, mk_x86g_spec_thunk_call(call, 1));
 }
 
 /* Build IR to calculate just the carry flag from stored
@@ -844,7 +906,7 @@ static IRExpr* mk_x86g_calculate_eflags_c ( void )
    /* Exclude OP and NDEP from definedness checking.  We're only
       interested in DEP1 and DEP2. */
    call->Iex.CCall.cee->mcx_mask = (1<<0) | (1<<3);
-   return call;
+   return mk_x86g_spec_thunk_call(call, 0);
 }
 
 
@@ -13446,9 +13508,13 @@ DisResult disInstr_X86_WRK (
       if (resteerCisOk
           && vex_control.guest_chase_cond
           && (Addr32)d32 != (Addr32)guest_EIP_bbstart
-          && jmpDelta < 0
+          && (jmpDelta < 0
+              || !resteerOkFn( callback_opaque,
+                                (Addr64)(Addr32)(guest_EIP_bbstart+delta) ))
           && resteerOkFn( callback_opaque, (Addr64)(Addr32)d32) ) {
-         /* Speculation: assume this backward branch is taken.  So we
+         /* Speculation: assume this branch is taken.  It is a
+            backward branch, or a forward one whose fall-through we
+            may not chase into.  So we
             need to emit a side-exit to the insn following this one,
             on the negation of the condition, and continue at the
             branch target address (d32).  If we wind up back at the
@@ -13467,10 +13533,9 @@ DisResult disInstr_X86_WRK (
       if (resteerCisOk
           && vex_control.guest_chase_cond
           && (Addr32)d32 != (Addr32)guest_EIP_bbstart
-          && jmpDelta >= 0
           && resteerOkFn( callback_opaque, 
                           (Addr64)(Addr32)(guest_EIP_bbstart+delta)) ) {
-         /* Speculation: assume this forward branch is not taken.  So
+         /* Speculation: assume this branch is not taken.  So
             we need to emit a side-exit to d32 (the dest) and continue
             disassembling at the insn immediately following this
             one. */
@@ -15010,9 +15075,13 @@ DisResult disInstr_X86_WRK (
          if (resteerCisOk
              && vex_control.guest_chase_cond
              && (Addr32)d32 != (Addr32)guest_EIP_bbstart
-             && jmpDelta < 0
+             && (jmpDelta < 0
+                 || !resteerOkFn( callback_opaque,
+                                   (Addr64)(Addr32)(guest_EIP_bbstart+delta) ))
              && resteerOkFn( callback_opaque, (Addr64)(Addr32)d32) ) {
-            /* Speculation: assume this backward branch is taken.  So
+            /* Speculation: assume this branch is taken.  It is a
+               backward branch, or a forward one whose fall-through we
+               may not chase into.  So
                we need to emit a side-exit to the insn following this
                one, on the negation of the condition, and continue at
                the branch target address (d32).  If we wind up back at
@@ -15032,10 +15101,9 @@ DisResult disInstr_X86_WRK (
          if (resteerCisOk
              && vex_control.guest_chase_cond
              && (Addr32)d32 != (Addr32)guest_EIP_bbstart
-             && jmpDelta >= 0
              && resteerOkFn( callback_opaque, 
                              (Addr64)(Addr32)(guest_EIP_bbstart+delta)) ) {
-            /* Speculation: assume this forward branch is not taken.
+            /* Speculation: assume this branch is not taken.
                So we need to emit a side-exit to d32 (the dest) and
                continue disassembling at the insn immediately
                following this one. */
@@ -15435,6 +15503,7 @@ DisResult disInstr_X86 ( IRSB*        irsb_IN,
    host_endness         = host_endness_IN;
    guest_EIP_curr_instr = (Addr32)guest_IP;
    guest_EIP_bbstart    = (Addr32)toUInt(guest_IP - delta);
+   guest_cc_op_hint     = abiinfo->guest_cc_op_hint;
 
    x1 = irsb_IN->stmts_used;
    expect_CAS = False;
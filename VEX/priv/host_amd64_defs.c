@@ -132,6 +132,31 @@ HReg hregAMD64_XMM11 ( void ) { return mkHReg(11, HRcVec128, False); }
 HReg hregAMD64_XMM12 ( void ) { return mkHReg(12, HRcVec128, False); }
 
 
+/* The caller-saved registers handed out by getAllocableRegs_AMD64.
+   A cold Ain_Call preserves exactly these: the integer ones first,
+   then the vector ones. */
+#define N_COLD_CALL_SAVED_IREGS 5
+#define N_COLD_CALL_SAVED_REGS  (N_COLD_CALL_SAVED_IREGS + 10)
+
+static void getColdCallSavedRegs_AMD64 ( HReg* arr )
+{
+   arr[ 0] = hregAMD64_RSI();
+   arr[ 1] = hregAMD64_RDI();
+   arr[ 2] = hregAMD64_R8();
+   arr[ 3] = hregAMD64_R9();
+   arr[ 4] = hregAMD64_R10();
+   arr[ 5] = hregAMD64_XMM3();
+   arr[ 6] = hregAMD64_XMM4();
+   arr[ 7] = hregAMD64_XMM5();
+   arr[ 8] = hregAMD64_XMM6();
+   arr[ 9] = hregAMD64_XMM7();
+   arr[10] = hregAMD64_XMM8();
+   arr[11] = hregAMD64_XMM9();
+   arr[12] = hregAMD64_XMM10();
+   arr[13] = hregAMD64_XMM11();
+   arr[14] = hregAMD64_XMM12();
+}
+
 void getAllocableRegs_AMD64 ( Int* nregs, HReg** arr )
 {
 #if 0
@@ -601,6 +626,19 @@ const HChar* showAMD64SseOp ( AMD64SseOp op ) {
       case Asse_UNPCKLW:  return "punpcklw";
       case Asse_UNPCKLD:  return "punpckld";
       case Asse_UNPCKLQ:  return "punpcklq";
+      case Asse_MUL32:    return "pmulld";
+      case Asse_MAX32S:   return "pmaxsd";
+      case Asse_MAX32U:   return "pmaxud";
+      case Asse_MAX16U:   return "pmaxuw";
+      case Asse_MAX8S:    return "pmaxsb";
+      case Asse_MIN32S:   return "pminsd";
+      case Asse_MIN32U:   return "pminud";
+      case Asse_MIN16U:   return "pminuw";
+      case Asse_MIN8S:    return "pminsb";
+      case Asse_CMPEQ64:  return "pcmpeqq";
+      case Asse_CMPGT64S: return "pcmpgtq";
+      case Asse_PERM8:    return "pshufb";
+      case Asse_PERM32:   return "permilps";
       default: vpanic("showAMD64SseOp");
    }
 }
@@ -694,15 +732,20 @@ AMD64Instr* AMD64Instr_Push( AMD64RMI* src ) {
    return i;
 }
 AMD64Instr* AMD64Instr_Call ( AMD64CondCode cond, Addr64 target, Int regparms,
-                              RetLoc rloc ) {
+                              RetLoc rloc, Bool cold ) {
    AMD64Instr* i        = LibVEX_Alloc(sizeof(AMD64Instr));
    i->tag               = Ain_Call;
    i->Ain.Call.cond     = cond;
    i->Ain.Call.target   = target;
    i->Ain.Call.regparms = regparms;
    i->Ain.Call.rloc     = rloc;
+   i->Ain.Call.cold     = cold;
    vassert(regparms >= 0 && regparms <= 6);
    vassert(is_sane_RetLoc(rloc));
+   if (cold) {
+      vassert(cond != Acc_ALWAYS);
+      vassert(rloc.pri == RLPri_None || rloc.pri == RLPri_Int);
+   }
    return i;
 }
 
@@ -922,6 +965,23 @@ AMD64Instr* AMD64Instr_SseLdzLO  ( Int sz, HReg reg, AMD64AMode* addr )
    vassert(sz == 4 || sz == 8);
    return i;
 }
+AMD64Instr* AMD64Instr_SseMOVQ ( HReg gpr, HReg xmm, Bool toXMM ) {
+   AMD64Instr* i         = LibVEX_Alloc(sizeof(AMD64Instr));
+   i->tag                = Ain_SseMOVQ;
+   i->Ain.SseMOVQ.gpr    = gpr;
+   i->Ain.SseMOVQ.xmm    = xmm;
+   i->Ain.SseMOVQ.toXMM  = toXMM;
+   vassert(hregClass(gpr) == HRcInt64);
+   vassert(hregClass(xmm) == HRcVec128);
+   return i;
+}
+AMD64Instr* AMD64Instr_SseMOVMSKB ( HReg src, HReg dst ) {
+   AMD64Instr* i          = LibVEX_Alloc(sizeof(AMD64Instr));
+   i->tag                 = Ain_SseMOVMSKB;
+   i->Ain.SseMOVMSKB.src  = src;
+   i->Ain.SseMOVMSKB.dst  = dst;
+   return i;
+}
 AMD64Instr* AMD64Instr_Sse32Fx4 ( AMD64SseOp op, HReg src, HReg dst ) {
    AMD64Instr* i       = LibVEX_Alloc(sizeof(AMD64Instr));
    i->tag              = Ain_Sse32Fx4;
@@ -966,6 +1026,27 @@ AMD64Instr* AMD64Instr_SseReRg ( AMD64SseOp op, HReg re, HReg rg ) {
    i->Ain.SseReRg.dst = rg;
    return i;
 }
+AMD64Instr* AMD64Instr_AvxReRg3 ( AMD64SseOp op,
+                                  HReg srcL, HReg srcR, HReg dst ) {
+   AMD64Instr* i         = LibVEX_Alloc(sizeof(AMD64Instr));
+   i->tag                = Ain_AvxReRg3;
+   i->Ain.AvxReRg3.op    = op;
+   i->Ain.AvxReRg3.srcL  = srcL;
+   i->Ain.AvxReRg3.srcR  = srcR;
+   i->Ain.AvxReRg3.dst   = dst;
+   vassert(op != Asse_MOV);
+   return i;
+}
+AMD64Instr* AMD64Instr_AvxFMA ( UChar sz, HReg srcL, HReg srcR, HReg dst ) {
+   AMD64Instr* i       = LibVEX_Alloc(sizeof(AMD64Instr));
+   i->tag              = Ain_AvxFMA;
+   i->Ain.AvxFMA.sz    = sz;
+   i->Ain.AvxFMA.srcL  = srcL;
+   i->Ain.AvxFMA.srcR  = srcR;
+   i->Ain.AvxFMA.dst   = dst;
+   vassert(sz == 4 || sz == 8);
+   return i;
+}
 AMD64Instr* AMD64Instr_SseCMov ( AMD64CondCode cond, HReg src, HReg dst ) {
    AMD64Instr* i       = LibVEX_Alloc(sizeof(AMD64Instr));
    i->tag              = Ain_SseCMov;
@@ -1078,9 +1159,10 @@ void ppAMD64Instr ( AMD64Instr* i, Bool mode64 )
          ppAMD64RMI(i->Ain.Push.src);
          return;
       case Ain_Call:
-         vex_printf("call%s[%d,", 
+         vex_printf("call%s%s[%d,", 
                     i->Ain.Call.cond==Acc_ALWAYS 
                        ? "" : showAMD64CondCode(i->Ain.Call.cond),
+                    i->Ain.Call.cold ? "(cold)" : "",
                     i->Ain.Call.regparms );
          ppRetLoc(i->Ain.Call.rloc);
          vex_printf("] 0x%llx", i->Ain.Call.target);
@@ -1258,6 +1340,24 @@ void ppAMD64Instr ( AMD64Instr* i, Bool mode64 )
          vex_printf(",");
          ppHRegAMD64(i->Ain.SseLdzLO.reg);
          return;
+      case Ain_SseMOVQ:
+         vex_printf("movq ");
+         if (i->Ain.SseMOVQ.toXMM) {
+            ppHRegAMD64(i->Ain.SseMOVQ.gpr);
+            vex_printf(",");
+            ppHRegAMD64(i->Ain.SseMOVQ.xmm);
+         } else {
+            ppHRegAMD64(i->Ain.SseMOVQ.xmm);
+            vex_printf(",");
+            ppHRegAMD64(i->Ain.SseMOVQ.gpr);
+         }
+         return;
+      case Ain_SseMOVMSKB:
+         vex_printf("pmovmskb ");
+         ppHRegAMD64(i->Ain.SseMOVMSKB.src);
+         vex_printf(",");
+         ppHRegAMD64(i->Ain.SseMOVMSKB.dst);
+         return;
       case Ain_Sse32Fx4:
          vex_printf("%sps ", showAMD64SseOp(i->Ain.Sse32Fx4.op));
          ppHRegAMD64(i->Ain.Sse32Fx4.src);
@@ -1288,6 +1388,22 @@ void ppAMD64Instr ( AMD64Instr* i, Bool mode64 )
          vex_printf(",");
          ppHRegAMD64(i->Ain.SseReRg.dst);
          return;
+      case Ain_AvxReRg3:
+         vex_printf("v%s ", showAMD64SseOp(i->Ain.AvxReRg3.op));
+         ppHRegAMD64(i->Ain.AvxReRg3.srcR);
+         vex_printf(",");
+         ppHRegAMD64(i->Ain.AvxReRg3.srcL);
+         vex_printf(",");
+         ppHRegAMD64(i->Ain.AvxReRg3.dst);
+         return;
+      case Ain_AvxFMA:
+         vex_printf("vfmadd231s%s ", i->Ain.AvxFMA.sz == 8 ? "d" : "s");
+         ppHRegAMD64(i->Ain.AvxFMA.srcR);
+         vex_printf(",");
+         ppHRegAMD64(i->Ain.AvxFMA.srcL);
+         vex_printf(",");
+         ppHRegAMD64(i->Ain.AvxFMA.dst);
+         return;
       case Ain_SseCMov:
          vex_printf("cmov%s ", showAMD64CondCode(i->Ain.SseCMov.cond));
          ppHRegAMD64(i->Ain.SseCMov.src);
@@ -1403,29 +1519,23 @@ void getRegUsage_AMD64Instr ( HRegUsage* u, AMD64Instr* i, Bool mode64 )
          /* First off, claim it trashes all the caller-saved regs
             which fall within the register allocator's jurisdiction.
             These I believe to be: rax rcx rdx rsi rdi r8 r9 r10 r11 
-            and all the xmm registers.
+            and all the xmm registers.  A cold call saves and restores
+            the ones the allocator can actually use (see
+            getColdCallSavedRegs_AMD64), so it only trashes the rest.
          */
          addHRegUse(u, HRmWrite, hregAMD64_RAX());
          addHRegUse(u, HRmWrite, hregAMD64_RCX());
          addHRegUse(u, HRmWrite, hregAMD64_RDX());
-         addHRegUse(u, HRmWrite, hregAMD64_RSI());
-         addHRegUse(u, HRmWrite, hregAMD64_RDI());
-         addHRegUse(u, HRmWrite, hregAMD64_R8());
-         addHRegUse(u, HRmWrite, hregAMD64_R9());
-         addHRegUse(u, HRmWrite, hregAMD64_R10());
          addHRegUse(u, HRmWrite, hregAMD64_R11());
          addHRegUse(u, HRmWrite, hregAMD64_XMM0());
          addHRegUse(u, HRmWrite, hregAMD64_XMM1());
-         addHRegUse(u, HRmWrite, hregAMD64_XMM3());
-         addHRegUse(u, HRmWrite, hregAMD64_XMM4());
-         addHRegUse(u, HRmWrite, hregAMD64_XMM5());
-         addHRegUse(u, HRmWrite, hregAMD64_XMM6());
-         addHRegUse(u, HRmWrite, hregAMD64_XMM7());
-         addHRegUse(u, HRmWrite, hregAMD64_XMM8());
-         addHRegUse(u, HRmWrite, hregAMD64_XMM9());
-         addHRegUse(u, HRmWrite, hregAMD64_XMM10());
-         addHRegUse(u, HRmWrite, hregAMD64_XMM11());
-         addHRegUse(u, HRmWrite, hregAMD64_XMM12());
+         if (!i->Ain.Call.cold) {
+            HReg saved[N_COLD_CALL_SAVED_REGS];
+            Int  k;
+            getColdCallSavedRegs_AMD64(saved);
+            for (k = 0; k < N_COLD_CALL_SAVED_REGS; k++)
+               addHRegUse(u, HRmWrite, saved[k]);
+         }
 
          /* Now we have to state any parameter-carrying registers
             which might be read.  This depends on the regparmness. */
@@ -1548,6 +1658,16 @@ void getRegUsage_AMD64Instr ( HRegUsage* u, AMD64Instr* i, Bool mode64 )
          addRegUsage_AMD64AMode(u, i->Ain.SseLdzLO.addr);
          addHRegUse(u, HRmWrite, i->Ain.SseLdzLO.reg);
          return;
+      case Ain_SseMOVQ:
+         addHRegUse(u, i->Ain.SseMOVQ.toXMM ? HRmRead : HRmWrite,
+                       i->Ain.SseMOVQ.gpr);
+         addHRegUse(u, i->Ain.SseMOVQ.toXMM ? HRmWrite : HRmRead,
+                       i->Ain.SseMOVQ.xmm);
+         return;
+      case Ain_SseMOVMSKB:
+         addHRegUse(u, HRmRead,  i->Ain.SseMOVMSKB.src);
+         addHRegUse(u, HRmWrite, i->Ain.SseMOVMSKB.dst);
+         return;
       case Ain_Sse32Fx4:
          vassert(i->Ain.Sse32Fx4.op != Asse_MOV);
          unary = toBool( i->Ain.Sse32Fx4.op == Asse_RCPF
@@ -1600,6 +1720,16 @@ void getRegUsage_AMD64Instr ( HRegUsage* u, AMD64Instr* i, Bool mode64 )
                           i->Ain.SseReRg.dst);
          }
          return;
+      case Ain_AvxReRg3:
+         addHRegUse(u, HRmRead,  i->Ain.AvxReRg3.srcL);
+         addHRegUse(u, HRmRead,  i->Ain.AvxReRg3.srcR);
+         addHRegUse(u, HRmWrite, i->Ain.AvxReRg3.dst);
+         return;
+      case Ain_AvxFMA:
+         addHRegUse(u, HRmRead,   i->Ain.AvxFMA.srcL);
+         addHRegUse(u, HRmRead,   i->Ain.AvxFMA.srcR);
+         addHRegUse(u, HRmModify, i->Ain.AvxFMA.dst);
+         return;
       case Ain_SseCMov:
          addHRegUse(u, HRmRead,   i->Ain.SseCMov.src);
          addHRegUse(u, HRmModify, i->Ain.SseCMov.dst);
@@ -1775,6 +1905,14 @@ void mapRegs_AMD64Instr ( HRegRemap* m, AMD64Instr* i, Bool mode64 )
          mapReg(m, &i->Ain.SseLdzLO.reg);
          mapRegs_AMD64AMode(m, i->Ain.SseLdzLO.addr);
          break;
+      case Ain_SseMOVQ:
+         mapReg(m, &i->Ain.SseMOVQ.gpr);
+         mapReg(m, &i->Ain.SseMOVQ.xmm);
+         break;
+      case Ain_SseMOVMSKB:
+         mapReg(m, &i->Ain.SseMOVMSKB.src);
+         mapReg(m, &i->Ain.SseMOVMSKB.dst);
+         break;
       case Ain_Sse32Fx4:
          mapReg(m, &i->Ain.Sse32Fx4.src);
          mapReg(m, &i->Ain.Sse32Fx4.dst);
@@ -1795,6 +1933,16 @@ void mapRegs_AMD64Instr ( HRegRemap* m, AMD64Instr* i, Bool mode64 )
          mapReg(m, &i->Ain.SseReRg.src);
          mapReg(m, &i->Ain.SseReRg.dst);
          return;
+      case Ain_AvxReRg3:
+         mapReg(m, &i->Ain.AvxReRg3.srcL);
+         mapReg(m, &i->Ain.AvxReRg3.srcR);
+         mapReg(m, &i->Ain.AvxReRg3.dst);
+         return;
+      case Ain_AvxFMA:
+         mapReg(m, &i->Ain.AvxFMA.srcL);
+         mapReg(m, &i->Ain.AvxFMA.srcR);
+         mapReg(m, &i->Ain.AvxFMA.dst);
+         return;
       case Ain_SseCMov:
          mapReg(m, &i->Ain.SseCMov.src);
          mapReg(m, &i->Ain.SseCMov.dst);
@@ -2026,6 +2174,33 @@ static Bool fitsIn32Bits ( ULong x )
    return toBool(x == y1);
 }
 
+/* Is x zero in its top 32 bits, so that "movl $imm32, %r32" (which
+   zeroes the upper half of the register) can produce it? */
+static Bool fitsIn32BitsUnsigned ( ULong x )
+{
+   return toBool((x >> 32) == 0);
+}
+
+/* Emit the shortest load of 'target' into %r11 that doesn't depend on
+   where the code ends up: 6, 7 or 10 bytes. */
+static UChar* emitLoadR11_AMD64 ( UChar* p, ULong target )
+{
+   if (fitsIn32BitsUnsigned(target)) {
+      /* movl $imm32, %r11d */
+      *p++ = 0x41; *p++ = 0xBB;
+      p = emit32(p, (UInt)target);
+   } else if (fitsIn32Bits(target)) {
+      /* movq sign-extend(imm32), %r11 */
+      *p++ = 0x49; *p++ = 0xC7; *p++ = 0xC3;
+      p = emit32(p, (UInt)target);
+   } else {
+      /* movabsq $target, %r11 */
+      *p++ = 0x49; *p++ = 0xBB;
+      p = emit64(p, target);
+   }
+   return p;
+}
+
 
 /* Forming mod-reg-rm bytes and scale-index-base bytes.
 
@@ -2094,9 +2269,8 @@ static UChar* doAMode_M ( UChar* p, HReg greg, AMD64AMode* am )
          *p++ = toUChar(am->Aam.IR.imm & 0xFF);
          return p;
       }
-      if (/* (sameHReg(am->Aam.IR.reg, hregAMD64_RSP())
-	     || wait for test case for RSP case */
-          sameHReg(am->Aam.IR.reg, hregAMD64_R12())) {
+      if (sameHReg(am->Aam.IR.reg, hregAMD64_RSP())
+          || sameHReg(am->Aam.IR.reg, hregAMD64_R12())) {
  	 *p++ = mkModRegRM(2, iregBits210(greg), 4);
          *p++ = 0x24;
          p = emit32(p, am->Aam.IR.imm);
@@ -2303,15 +2477,21 @@ Int emit_AMD64Instr ( /*MB_MOD*/Bool* is_profInc,
    switch (i->tag) {
 
    case Ain_Imm64:
-      if (i->Ain.Imm64.imm64 <= 0xFFFFFULL) {
+      if (fitsIn32BitsUnsigned(i->Ain.Imm64.imm64)) {
          /* Use the short form (load into 32 bit reg, + default
-            widening rule) for constants under 1 million.  We could
-            use this form for the range 0 to 0x7FFFFFFF inclusive, but
-            limit it to a smaller range for verifiability purposes. */
+            widening rule) for constants that fit in 32 unsigned
+            bits: 5 or 6 bytes rather than 10. */
          if (1 & iregBit3(i->Ain.Imm64.dst))
             *p++ = 0x41;
          *p++ = 0xB8 + iregBits210(i->Ain.Imm64.dst);
          p = emit32(p, (UInt)i->Ain.Imm64.imm64);
+      } else if (fitsIn32Bits(i->Ain.Imm64.imm64)) {
+         /* 7 bytes: movq sign-extend(imm32), %reg, for small
+            negative constants */
+         *p++ = toUChar(0x48 + (1 & iregBit3(i->Ain.Imm64.dst)));
+         *p++ = 0xC7;
+         *p++ = toUChar(0xC0 + iregBits210(i->Ain.Imm64.dst));
+         p = emit32(p, (UInt)i->Ain.Imm64.imm64);
       } else {
          *p++ = toUChar(0x48 + (1 & iregBit3(i->Ain.Imm64.dst)));
          *p++ = toUChar(0xB8 + iregBits210(i->Ain.Imm64.dst));
@@ -2324,12 +2504,9 @@ Int emit_AMD64Instr ( /*MB_MOD*/Bool* is_profInc,
       if (i->Ain.Alu64R.op == Aalu_MOV) {
          switch (i->Ain.Alu64R.src->tag) {
             case Armi_Imm:
-               if (0 == (i->Ain.Alu64R.src->Armi.Imm.imm32 & ~0xFFFFF)) {
-                  /* Actually we could use this form for constants in
-                     the range 0 through 0x7FFFFFFF inclusive, but
-                     limit it to a small range for verifiability
-                     purposes. */
-                  /* Generate "movl $imm32, 32-bit-register" and let
+               if (0 == (i->Ain.Alu64R.src->Armi.Imm.imm32 & 0x80000000)) {
+                  /* For constants in the range 0 through 0x7FFFFFFF
+                     inclusive, generate "movl $imm32, 32-bit-register" and let
                      the default zero-extend rule cause the upper half
                      of the dst to be zeroed out too.  This saves 1
                      and sometimes 2 bytes compared to the more
@@ -2495,6 +2672,12 @@ Int emit_AMD64Instr ( /*MB_MOD*/Bool* is_profInc,
          *p++ = toUChar(opc_cl);
          p = doAMode_R(p, fake(subopc), i->Ain.Sh64.dst);
          goto done;
+      } else if (i->Ain.Sh64.src == 1) {
+         /* The shift-by-one form, without the imm8. */
+         *p++ = rexAMode_R(fake(0), i->Ain.Sh64.dst);
+         *p++ = 0xD1;
+         p = doAMode_R(p, fake(subopc), i->Ain.Sh64.dst);
+         goto done;
       } else {
          *p++ = rexAMode_R(fake(0), i->Ain.Sh64.dst);
          *p++ = toUChar(opc_imm);
@@ -2505,6 +2688,19 @@ Int emit_AMD64Instr ( /*MB_MOD*/Bool* is_profInc,
       break;
 
    case Ain_Test64:
+      if (0 == (i->Ain.Test64.imm32 & ~0x7F)) {
+         /* testb $imm8, %reg8.  With bit 7 of the mask clear, both
+            forms leave SF clear and set ZF and PF from the same low
+            byte, so the flags come out the same.  The REX prefix is
+            needed for %sil and %dil as well as %r8b and up. */
+         if (iregBit3(i->Ain.Test64.dst)
+             || iregBits210(i->Ain.Test64.dst) >= 4)
+            *p++ = toUChar(0x40 + (1 & iregBit3(i->Ain.Test64.dst)));
+         *p++ = 0xF6;
+         p = doAMode_R(p, fake(0), i->Ain.Test64.dst);
+         *p++ = toUChar(i->Ain.Test64.imm32);
+         goto done;
+      }
       /* testq sign-extend($imm32), %reg */
       *p++ = rexAMode_R(fake(0), i->Ain.Test64.dst);
       *p++ = 0xF7;
@@ -2671,6 +2867,11 @@ Int emit_AMD64Instr ( /*MB_MOD*/Bool* is_profInc,
             p = doAMode_M(p, fake(6), i->Ain.Push.src->Armi.Mem.am);
             goto done;
          case Armi_Imm:
+            if (fits8bits(i->Ain.Push.src->Armi.Imm.imm32)) {
+               *p++ = 0x6A;
+               *p++ = toUChar(i->Ain.Push.src->Armi.Imm.imm32);
+               goto done;
+            }
             *p++ = 0x68;
             p = emit32(p, i->Ain.Push.src->Armi.Imm.imm32);
             goto done;
@@ -2683,43 +2884,66 @@ Int emit_AMD64Instr ( /*MB_MOD*/Bool* is_profInc,
       }
 
    case Ain_Call: {
+      /* If the call might not happen (it isn't unconditional) and it
+         returns a result, we need a control flow diamond to put
+         0x555..555 in the return register in the case where the call
+         doesn't happen.  That is only done for a single integer
+         result; give up on anything else. */
+      Bool retInt = False;
       if (i->Ain.Call.cond != Acc_ALWAYS
           && i->Ain.Call.rloc.pri != RLPri_None) {
-         /* The call might not happen (it isn't unconditional) and it
-            returns a result.  In this case we will need to generate a
-            control flow diamond to put 0x555..555 in the return
-            register(s) in the case where the call doesn't happen.  If
-            this ever becomes necessary, maybe copy code from the ARM
-            equivalent.  Until that day, just give up. */
-         goto bad;
+         if (i->Ain.Call.rloc.pri != RLPri_Int)
+            goto bad;
+         retInt = True;
       }
       /* As per detailed comment for Ain_Call in
          getRegUsage_AMD64Instr above, %r11 is used as an address
          temporary. */
-      /* jump over the following two insns if the condition does not
-         hold */
-      Bool shortImm = fitsIn32Bits(i->Ain.Call.target);
+      /* Helpers normally live below 4G, where the target can be
+         loaded with a 6 byte movl.  A rel32 call would be shorter
+         still, but translations must not depend on where they end up
+         in the code cache, so that they can be moved and saved. */
+      Int movLen = fitsIn32BitsUnsigned(i->Ain.Call.target) ? 6
+                   : fitsIn32Bits(i->Ain.Call.target) ? 7 : 10;
+      if (i->Ain.Call.cold) {
+         /* Only the condition test stays in line: the call itself
+            is moved to the end of the block by emitColdPart_AMD64,
+            which also fills in the jump offset.  If the call
+            returns a value, set up the 0x555..555 the skipped case
+            needs first, since the call will overwrite it. */
+         if (retInt) {
+            /* 10 bytes: movabsq $0x5555555555555555, %rax */
+            *p++ = 0x48;
+            *p++ = 0xB8;
+            p = emit64(p, 0x5555555555555555ULL);
+         }
+         /* 6 bytes: jcc rel32, to the out-of-line part */
+         *p++ = 0x0F;
+         *p++ = toUChar(0x80 + (0xF & i->Ain.Call.cond));
+         p = emit32(p, 0);
+         goto done;
+      }
+      /* jump over the following two insns (and the jump after them)
+         if the condition does not hold */
       if (i->Ain.Call.cond != Acc_ALWAYS) {
          *p++ = toUChar(0x70 + (0xF & (i->Ain.Call.cond ^ 1)));
-         *p++ = shortImm ? 10 : 13;
-         /* 10 or 13 bytes in the next two insns */
-      }
-      if (shortImm) {
-         /* 7 bytes: movl sign-extend(imm32), %r11 */
-         *p++ = 0x49;
-         *p++ = 0xC7;
-         *p++ = 0xC3;
-         p = emit32(p, (UInt)i->Ain.Call.target);
-      } else {
-         /* 10 bytes: movabsq $target, %r11 */
-         *p++ = 0x49;
-         *p++ = 0xBB;
-         p = emit64(p, i->Ain.Call.target);
+         *p++ = toUChar(movLen + 3 + (retInt ? 2 : 0));
+         /* the next two insns, plus 2 for the jmp */
       }
+      p = emitLoadR11_AMD64(p, i->Ain.Call.target);
       /* 3 bytes: call *%r11 */
       *p++ = 0x41;
       *p++ = 0xFF;
       *p++ = 0xD3;
+      if (retInt) {
+         /* 2 bytes: jmp over the next insn */
+         *p++ = 0xEB;
+         *p++ = 10;
+         /* 10 bytes: movabsq $0x5555555555555555, %rax */
+         *p++ = 0x48;
+         *p++ = 0xB8;
+         p = emit64(p, 0x5555555555555555ULL);
+      }
       goto done;
    }
 
@@ -3249,6 +3473,30 @@ Int emit_AMD64Instr ( /*MB_MOD*/Bool* is_profInc,
                        i->Ain.SseLdzLO.addr);
       goto done;
 
+   case Ain_SseMOVQ: {
+      /* movq %gpr, %xmm (66 REX.W 0F 6E) or movq %xmm, %gpr
+         (66 REX.W 0F 7E).  Either way the xmm is in the reg field. */
+      HReg xmm = vreg2ireg(i->Ain.SseMOVQ.xmm);
+      *p++ = 0x66;
+      *p++ = rexAMode_R(xmm, i->Ain.SseMOVQ.gpr);
+      *p++ = 0x0F;
+      *p++ = toUChar(i->Ain.SseMOVQ.toXMM ? 0x6E : 0x7E);
+      p = doAMode_R(p, xmm, i->Ain.SseMOVQ.gpr);
+      goto done;
+   }
+
+   case Ain_SseMOVMSKB:
+      /* pmovmskb %xmm-src, %r32-dst; zeroes the rest of dst */
+      *p++ = 0x66;
+      *p++ = clearWBit(
+             rexAMode_R(i->Ain.SseMOVMSKB.dst,
+                        vreg2ireg(i->Ain.SseMOVMSKB.src)));
+      *p++ = 0x0F;
+      *p++ = 0xD7;
+      p = doAMode_R(p, i->Ain.SseMOVMSKB.dst,
+                       vreg2ireg(i->Ain.SseMOVMSKB.src));
+      goto done;
+
    case Ain_Sse32Fx4:
       xtra = 0;
       *p++ = clearWBit(
@@ -3423,6 +3671,28 @@ Int emit_AMD64Instr ( /*MB_MOD*/Bool* is_profInc,
          case Asse_UNPCKLW:  XX(0x66); XX(rex); XX(0x0F); XX(0x61); break;
          case Asse_UNPCKLD:  XX(0x66); XX(rex); XX(0x0F); XX(0x62); break;
          case Asse_UNPCKLQ:  XX(0x66); XX(rex); XX(0x0F); XX(0x6C); break;
+         case Asse_MUL32:    XX(0x66); XX(rex); XX(0x0F); XX(0x38); XX(0x40);
+                             break;
+         case Asse_MAX32S:   XX(0x66); XX(rex); XX(0x0F); XX(0x38); XX(0x3D);
+                             break;
+         case Asse_MAX32U:   XX(0x66); XX(rex); XX(0x0F); XX(0x38); XX(0x3F);
+                             break;
+         case Asse_MAX16U:   XX(0x66); XX(rex); XX(0x0F); XX(0x38); XX(0x3E);
+                             break;
+         case Asse_MAX8S:    XX(0x66); XX(rex); XX(0x0F); XX(0x38); XX(0x3C);
+                             break;
+         case Asse_MIN32S:   XX(0x66); XX(rex); XX(0x0F); XX(0x38); XX(0x39);
+                             break;
+         case Asse_MIN32U:   XX(0x66); XX(rex); XX(0x0F); XX(0x38); XX(0x3B);
+                             break;
+         case Asse_MIN16U:   XX(0x66); XX(rex); XX(0x0F); XX(0x38); XX(0x3A);
+                             break;
+         case Asse_MIN8S:    XX(0x66); XX(rex); XX(0x0F); XX(0x38); XX(0x38);
+                             break;
+         case Asse_CMPEQ64:  XX(0x66); XX(rex); XX(0x0F); XX(0x38); XX(0x29);
+                             break;
+         case Asse_CMPGT64S: XX(0x66); XX(rex); XX(0x0F); XX(0x38); XX(0x37);
+                             break;
          default: goto bad;
       }
       p = doAMode_R(p, vreg2ireg(i->Ain.SseReRg.dst),
@@ -3430,6 +3700,118 @@ Int emit_AMD64Instr ( /*MB_MOD*/Bool* is_profInc,
 #     undef XX
       goto done;
 
+   case Ain_AvxReRg3: {
+      /* 3-byte VEX prefix C4 RXBmmmmm WvvvvLpp, then the opcode and a
+         reg-reg modrm.  R and B extend dst and srcR; vvvv holds srcL.
+         All of these have W=0, L=0 (128 bit) and, apart from the
+         bitwise ops, pp=1 (implied 66). */
+      UInt dst  = hregNumber(i->Ain.AvxReRg3.dst);
+      UInt srcL = hregNumber(i->Ain.AvxReRg3.srcL);
+      UInt srcR = hregNumber(i->Ain.AvxReRg3.srcR);
+      UInt mm   = 1; /* 0F */
+      UInt pp   = 1; /* 66 */
+      UChar vop;
+      switch (i->Ain.AvxReRg3.op) {
+         case Asse_OR:       pp = 0; vop = 0x56; break;
+         case Asse_XOR:      pp = 0; vop = 0x57; break;
+         case Asse_AND:      pp = 0; vop = 0x54; break;
+         case Asse_ANDN:     pp = 0; vop = 0x55; break;
+         case Asse_PACKSSD:  vop = 0x6B; break;
+         case Asse_PACKSSW:  vop = 0x63; break;
+         case Asse_PACKUSW:  vop = 0x67; break;
+         case Asse_ADD8:     vop = 0xFC; break;
+         case Asse_ADD16:    vop = 0xFD; break;
+         case Asse_ADD32:    vop = 0xFE; break;
+         case Asse_ADD64:    vop = 0xD4; break;
+         case Asse_QADD8S:   vop = 0xEC; break;
+         case Asse_QADD16S:  vop = 0xED; break;
+         case Asse_QADD8U:   vop = 0xDC; break;
+         case Asse_QADD16U:  vop = 0xDD; break;
+         case Asse_AVG8U:    vop = 0xE0; break;
+         case Asse_AVG16U:   vop = 0xE3; break;
+         case Asse_CMPEQ8:   vop = 0x74; break;
+         case Asse_CMPEQ16:  vop = 0x75; break;
+         case Asse_CMPEQ32:  vop = 0x76; break;
+         case Asse_CMPGT8S:  vop = 0x64; break;
+         case Asse_CMPGT16S: vop = 0x65; break;
+         case Asse_CMPGT32S: vop = 0x66; break;
+         case Asse_MAX16S:   vop = 0xEE; break;
+         case Asse_MAX8U:    vop = 0xDE; break;
+         case Asse_MIN16S:   vop = 0xEA; break;
+         case Asse_MIN8U:    vop = 0xDA; break;
+         case Asse_MULHI16U: vop = 0xE4; break;
+         case Asse_MULHI16S: vop = 0xE5; break;
+         case Asse_MUL16:    vop = 0xD5; break;
+         case Asse_SUB8:     vop = 0xF8; break;
+         case Asse_SUB16:    vop = 0xF9; break;
+         case Asse_SUB32:    vop = 0xFA; break;
+         case Asse_SUB64:    vop = 0xFB; break;
+         case Asse_QSUB8S:   vop = 0xE8; break;
+         case Asse_QSUB16S:  vop = 0xE9; break;
+         case Asse_QSUB8U:   vop = 0xD8; break;
+         case Asse_QSUB16U:  vop = 0xD9; break;
+         case Asse_UNPCKHB:  vop = 0x68; break;
+         case Asse_UNPCKHW:  vop = 0x69; break;
+         case Asse_UNPCKHD:  vop = 0x6A; break;
+         case Asse_UNPCKHQ:  vop = 0x6D; break;
+         case Asse_UNPCKLB:  vop = 0x60; break;
+         case Asse_UNPCKLW:  vop = 0x61; break;
+         case Asse_UNPCKLD:  vop = 0x62; break;
+         case Asse_UNPCKLQ:  vop = 0x6C; break;
+         case Asse_SHL16:    vop = 0xF1; break;
+         case Asse_SHL32:    vop = 0xF2; break;
+         case Asse_SHL64:    vop = 0xF3; break;
+         case Asse_SAR16:    vop = 0xE1; break;
+         case Asse_SAR32:    vop = 0xE2; break;
+         case Asse_SHR16:    vop = 0xD1; break;
+         case Asse_SHR32:    vop = 0xD2; break;
+         case Asse_SHR64:    vop = 0xD3; break;
+         case Asse_MUL32:    mm = 2; vop = 0x40; break;
+         case Asse_MAX32S:   mm = 2; vop = 0x3D; break;
+         case Asse_MAX32U:   mm = 2; vop = 0x3F; break;
+         case Asse_MAX16U:   mm = 2; vop = 0x3E; break;
+         case Asse_MAX8S:    mm = 2; vop = 0x3C; break;
+         case Asse_MIN32S:   mm = 2; vop = 0x39; break;
+         case Asse_MIN32U:   mm = 2; vop = 0x3B; break;
+         case Asse_MIN16U:   mm = 2; vop = 0x3A; break;
+         case Asse_MIN8S:    mm = 2; vop = 0x38; break;
+         case Asse_CMPEQ64:  mm = 2; vop = 0x29; break;
+         case Asse_CMPGT64S: mm = 2; vop = 0x37; break;
+         case Asse_PERM8:    mm = 2; vop = 0x00; break; /* vpshufb */
+         case Asse_PERM32:   mm = 2; vop = 0x0C; break; /* vpermilps */
+         default: goto bad;
+      }
+      vassert(dst < 16 && srcL < 16 && srcR < 16);
+      *p++ = 0xC4;
+      *p++ = toUChar( (((~dst) >> 3) & 1) << 7     /* R */
+                      | 1 << 6                      /* X, unused */
+                      | (((~srcR) >> 3) & 1) << 5   /* B */
+                      | mm );
+      *p++ = toUChar( ((~srcL) & 0xF) << 3 | pp );  /* W=0, L=0 */
+      *p++ = vop;
+      *p++ = toUChar( 0xC0 | (dst & 7) << 3 | (srcR & 7) );
+      goto done;
+   }
+
+   case Ain_AvxFMA: {
+      /* vfmadd231s{s,d} %srcR, %srcL, %dst: VEX.LIG.66.0F38.W{0,1}
+         B9 /r, with the same prefix layout as for AvxReRg3. */
+      UInt dst  = hregNumber(i->Ain.AvxFMA.dst);
+      UInt srcL = hregNumber(i->Ain.AvxFMA.srcL);
+      UInt srcR = hregNumber(i->Ain.AvxFMA.srcR);
+      UInt w    = i->Ain.AvxFMA.sz == 8 ? 1 : 0;
+      vassert(dst < 16 && srcL < 16 && srcR < 16);
+      *p++ = 0xC4;
+      *p++ = toUChar( (((~dst) >> 3) & 1) << 7     /* R */
+                      | 1 << 6                      /* X, unused */
+                      | (((~srcR) >> 3) & 1) << 5   /* B */
+                      | 2 );                        /* 0F38 */
+      *p++ = toUChar( w << 7 | ((~srcL) & 0xF) << 3 | 1 ); /* L=0, 66 */
+      *p++ = 0xB9;
+      *p++ = toUChar( 0xC0 | (dst & 7) << 3 | (srcR & 7) );
+      goto done;
+   }
+
    case Ain_SseCMov:
       /* jmp fwds if !condition */
       *p++ = toUChar(0x70 + (i->Ain.SseCMov.cond ^ 1));
@@ -3551,6 +3933,94 @@ Int emit_AMD64Instr ( /*MB_MOD*/Bool* is_profInc,
 }
 
 
+/* Emit the out-of-line part of |i|, if it has one, into |buf|.  The
+   in-line part was placed in |code| and ends at offset |hotEnd|; the
+   out-of-line part is going to be copied to offset |coldStart|.
+   Returns the number of bytes emitted, which is zero for insns that
+   are entirely in line.  Currently only cold Ain_Calls have such a
+   part: it saves the caller-saved allocatable registers (see
+   getColdCallSavedRegs_AMD64), makes the call, restores them and
+   jumps back to just after the in-line part. */
+Int emitColdPart_AMD64 ( UChar* buf, Int nbuf, AMD64Instr* i,
+                         UChar* code, Int hotEnd, Int coldStart )
+{
+   HReg        saved[N_COLD_CALL_SAVED_REGS];
+   AMD64AMode* am;
+   Int         k, delta;
+   UChar*      p = &buf[0];
+   /* The vector registers go in a frame below the pushed integer
+      ones.  An extra push of %r11 keeps %rsp 16-aligned at the
+      call. */
+   const Int   nV     = N_COLD_CALL_SAVED_REGS - N_COLD_CALL_SAVED_IREGS;
+   const UInt  frameB = 16 * nV;
+
+   vassert(nbuf >= 256);
+   if (i->tag != Ain_Call || !i->Ain.Call.cold)
+      return 0;
+   vassert(N_COLD_CALL_SAVED_IREGS == 5);
+   getColdCallSavedRegs_AMD64(saved);
+
+   /* Point the in-line jcc rel32 here. */
+   delta = coldStart - hotEnd;
+   vassert(delta >= 0);
+   (void)emit32(&code[hotEnd - 4], (UInt)delta);
+
+   /* pushq %reg, for each integer reg, then %r11 */
+   for (k = 0; k < N_COLD_CALL_SAVED_IREGS; k++) {
+      if (iregBit3(saved[k]))
+         *p++ = 0x41;
+      *p++ = toUChar(0x50 + iregBits210(saved[k]));
+   }
+   *p++ = 0x41;
+   *p++ = 0x53;
+   /* subq $frameB, %rsp */
+   *p++ = 0x48; *p++ = 0x81; *p++ = 0xEC;
+   p = emit32(p, frameB);
+   /* movups %xmm, 16k(%rsp), for each vector reg */
+   for (k = 0; k < nV; k++) {
+      HReg r = vreg2ireg(saved[N_COLD_CALL_SAVED_IREGS + k]);
+      am = AMD64AMode_IR(16 * k, hregAMD64_RSP());
+      *p++ = clearWBit(rexAMode_M(r, am));
+      *p++ = 0x0F;
+      *p++ = 0x11;
+      p = doAMode_M(p, r, am);
+   }
+
+   /* The call proper, via %r11 as for the in-line case. */
+   p = emitLoadR11_AMD64(p, i->Ain.Call.target);
+   /* call *%r11 */
+   *p++ = 0x41; *p++ = 0xFF; *p++ = 0xD3;
+
+   /* And undo all the above.  The return value, if any, is in %rax,
+      which isn't touched. */
+   for (k = 0; k < nV; k++) {
+      HReg r = vreg2ireg(saved[N_COLD_CALL_SAVED_IREGS + k]);
+      am = AMD64AMode_IR(16 * k, hregAMD64_RSP());
+      *p++ = clearWBit(rexAMode_M(r, am));
+      *p++ = 0x0F;
+      *p++ = 0x10;
+      p = doAMode_M(p, r, am);
+   }
+   /* addq $frameB, %rsp */
+   *p++ = 0x48; *p++ = 0x81; *p++ = 0xC4;
+   p = emit32(p, frameB);
+   *p++ = 0x41;
+   *p++ = 0x5B;
+   for (k = N_COLD_CALL_SAVED_IREGS-1; k >= 0; k--) {
+      if (iregBit3(saved[k]))
+         *p++ = 0x41;
+      *p++ = toUChar(0x58 + iregBits210(saved[k]));
+   }
+
+   /* jmp rel32, back to just after the in-line part */
+   *p++ = 0xE9;
+   p = emit32(p, (UInt)(hotEnd - (coldStart + (Int)(p + 4 - &buf[0]))));
+
+   vassert(p - &buf[0] <= nbuf);
+   return p - &buf[0];
+}
+
+
 /* How big is an event check?  See case for Ain_EvCheck in
    emit_AMD64Instr just above.  That crosschecks what this returns, so
    we can tell if we're inconsistent. */
@@ -342,7 +342,14 @@ typedef
       Asse_SAR16, Asse_SAR32, 
       Asse_PACKSSD, Asse_PACKSSW, Asse_PACKUSW,
       Asse_UNPCKHB, Asse_UNPCKHW, Asse_UNPCKHD, Asse_UNPCKHQ,
-      Asse_UNPCKLB, Asse_UNPCKLW, Asse_UNPCKLD, Asse_UNPCKLQ
+      Asse_UNPCKLB, Asse_UNPCKLW, Asse_UNPCKLD, Asse_UNPCKLQ,
+      /* SSE4.1/SSE4.2; only generated for hosts with AVX */
+      Asse_MUL32,
+      Asse_MAX32S, Asse_MAX32U, Asse_MAX16U, Asse_MAX8S,
+      Asse_MIN32S, Asse_MIN32U, Asse_MIN16U, Asse_MIN8S,
+      Asse_CMPEQ64, Asse_CMPGT64S,
+      /* AVX; only usable with AvxReRg3 */
+      Asse_PERM8, Asse_PERM32
    }
    AMD64SseOp;
 
@@ -392,11 +399,15 @@ typedef
       Ain_SseLdSt,     /* SSE load/store 32/64/128 bits, no alignment
                           constraints, upper 96/64/0 bits arbitrary */
       Ain_SseLdzLO,    /* SSE load low 32/64 bits, zero remainder of reg */
+      Ain_SseMOVQ,     /* movq between an integer and an xmm register */
+      Ain_SseMOVMSKB,  /* pmovmskb: byte sign bits of xmm to an int reg */
       Ain_Sse32Fx4,    /* SSE binary, 32Fx4 */
       Ain_Sse32FLo,    /* SSE binary, 32F in lowest lane only */
       Ain_Sse64Fx2,    /* SSE binary, 64Fx2 */
       Ain_Sse64FLo,    /* SSE binary, 64F in lowest lane only */
       Ain_SseReRg,     /* SSE binary general reg-reg, Re, Rg */
+      Ain_AvxReRg3,    /* AVX 128-bit 3-operand reg-reg-reg, dst = L op R */
+      Ain_AvxFMA,      /* FMA3 scalar fused multiply-add, dst += L * R */
       Ain_SseCMov,     /* SSE conditional move */
       Ain_SseShuf,     /* SSE2 shuffle (pshufd) */
       //uu Ain_AvxLdSt,     /* AVX load/store 256 bits,
@@ -469,12 +480,17 @@ typedef
             AMD64RMI* src;
          } Push;
          /* Pseudo-insn.  Call target (an absolute address), on given
-            condition (which could be Xcc_ALWAYS). */
+            condition (which could be Xcc_ALWAYS).  If .cold is set,
+            the call is conditional and expected to be rarely taken,
+            so it saves and restores the caller-saved registers that
+            the allocator can use, instead of claiming to trash
+            them. */
          struct {
             AMD64CondCode cond;
             Addr64        target;
             Int           regparms; /* 0 .. 6 */
             RetLoc        rloc;     /* where the return value will be */
+            Bool          cold;     /* preserves allocatable regs */
          } Call;
          /* Update the guest RIP value, then exit requesting to chain
             to it.  May be conditional. */
@@ -631,6 +647,17 @@ typedef
             HReg        reg;
             AMD64AMode* addr;
          } SseLdzLO;
+         /* Move 64 bits between gpr and the low half of xmm.  When
+            moving into xmm, the upper half is zeroed. */
+         struct {
+            HReg gpr;
+            HReg xmm;
+            Bool toXMM;
+         } SseMOVQ;
+         struct {
+            HReg src; /* xmm */
+            HReg dst; /* gpr; upper 48 bits are zeroed */
+         } SseMOVMSKB;
          struct {
             AMD64SseOp op;
             HReg       src;
@@ -656,6 +683,23 @@ typedef
             HReg       src;
             HReg       dst;
          } SseReRg;
+         /* VEX.128-encoded form of SseReRg, which leaves its left
+            operand intact: dst = srcL `op` srcR.  Only for the
+            integer and bitwise ops, and only on AVX-capable hosts. */
+         struct {
+            AMD64SseOp op;
+            HReg       srcL;
+            HReg       srcR;
+            HReg       dst;
+         } AvxReRg3;
+         /* vfmadd231s{s,d}: dst = srcL * srcR + dst in the lowest
+            32 or 64 bits, rounded once.  Only on hosts with FMA3. */
+         struct {
+            UChar sz; /* 4 or 8 only */
+            HReg  srcL;
+            HReg  srcR;
+            HReg  dst;
+         } AvxFMA;
          /* Mov src to dst on the given condition, which may not
             be the bogus Xcc_ALWAYS. */
          struct {
@@ -703,7 +747,8 @@ extern AMD64Instr* AMD64Instr_Test64     ( UInt imm32, HReg dst );
 extern AMD64Instr* AMD64Instr_MulL       ( Bool syned, AMD64RM* );
 extern AMD64Instr* AMD64Instr_Div        ( Bool syned, Int sz, AMD64RM* );
 extern AMD64Instr* AMD64Instr_Push       ( AMD64RMI* );
-extern AMD64Instr* AMD64Instr_Call       ( AMD64CondCode, Addr64, Int, RetLoc );
+extern AMD64Instr* AMD64Instr_Call       ( AMD64CondCode, Addr64, Int, RetLoc,
+                                            Bool cold );
 extern AMD64Instr* AMD64Instr_XDirect    ( Addr64 dstGA, AMD64AMode* amRIP,
                                            AMD64CondCode cond, Bool toFastEP );
 extern AMD64Instr* AMD64Instr_XIndir     ( HReg dstGA, AMD64AMode* amRIP,
@@ -734,11 +779,15 @@ extern AMD64Instr* AMD64Instr_SseSF2SI   ( Int szS, Int szD, HReg src, HReg dst
 extern AMD64Instr* AMD64Instr_SseSDSS    ( Bool from64, HReg src, HReg dst );
 extern AMD64Instr* AMD64Instr_SseLdSt    ( Bool isLoad, Int sz, HReg, AMD64AMode* );
 extern AMD64Instr* AMD64Instr_SseLdzLO   ( Int sz, HReg, AMD64AMode* );
+extern AMD64Instr* AMD64Instr_SseMOVQ    ( HReg gpr, HReg xmm, Bool toXMM );
+extern AMD64Instr* AMD64Instr_SseMOVMSKB ( HReg src, HReg dst );
 extern AMD64Instr* AMD64Instr_Sse32Fx4   ( AMD64SseOp, HReg, HReg );
 extern AMD64Instr* AMD64Instr_Sse32FLo   ( AMD64SseOp, HReg, HReg );
 extern AMD64Instr* AMD64Instr_Sse64Fx2   ( AMD64SseOp, HReg, HReg );
 extern AMD64Instr* AMD64Instr_Sse64FLo   ( AMD64SseOp, HReg, HReg );
 extern AMD64Instr* AMD64Instr_SseReRg    ( AMD64SseOp, HReg, HReg );
+extern AMD64Instr* AMD64Instr_AvxReRg3   ( AMD64SseOp, HReg, HReg, HReg );
+extern AMD64Instr* AMD64Instr_AvxFMA     ( UChar sz, HReg, HReg, HReg );
 extern AMD64Instr* AMD64Instr_SseCMov    ( AMD64CondCode, HReg src, HReg dst );
 extern AMD64Instr* AMD64Instr_SseShuf    ( Int order, HReg src, HReg dst );
 //uu extern AMD64Instr* AMD64Instr_AvxLdSt    ( Bool isLoad, HReg, AMD64AMode* );
@@ -764,6 +813,10 @@ extern Int          emit_AMD64Instr        ( /*MB_MOD*/Bool* is_profInc,
                                              void* disp_cp_chain_me_to_fastEP,
                                              void* disp_cp_xindir,
                                              void* disp_cp_xassisted );
+extern Int          emitColdPart_AMD64     ( UChar* buf, Int nbuf,
+                                             AMD64Instr* i,
+                                             UChar* code, Int hotEnd,
+                                             Int coldStart );
 
 extern void genSpill_AMD64  ( /*OUT*/HInstr** i1, /*OUT*/HInstr** i2,
                               HReg rreg, Int offset, Bool );
@@ -423,13 +423,15 @@ static AMD64Instr* iselIntExpr_single_instruction ( ISelEnv* env,
    call is unconditional.  |retloc| is set to indicate where the
    return value is after the call.  The caller (of this fn) must
    generate code to add |stackAdjustAfterCall| to the stack pointer
-   after the call is done. */
+   after the call is done.  |cold| is the IRDirty hint that the call
+   rarely happens; it is honoured for conditional calls returning
+   nothing or an integer. */
 
 static
 void doHelperCall ( /*OUT*/UInt*   stackAdjustAfterCall,
                     /*OUT*/RetLoc* retloc,
                     ISelEnv* env,
-                    IRExpr* guard,
+                    IRExpr* guard, Bool cold,
                     IRCallee* cee, IRType retTy, IRExpr** args )
 {
    AMD64CondCode cc;
@@ -691,7 +693,10 @@ void doHelperCall ( /*OUT*/UInt*   stackAdjustAfterCall,
    /* Finally, generate the call itself.  This needs the *retloc value
       set in the switch above, which is why it's at the end. */
    addInstr(env,
-            AMD64Instr_Call(cc, Ptr_to_ULong(cee->addr), n_args, *retloc));
+            AMD64Instr_Call(cc, Ptr_to_ULong(cee->addr), n_args, *retloc,
+                            cold && cc != Acc_ALWAYS
+                                 && (retloc->pri == RLPri_None
+                                     || retloc->pri == RLPri_Int)));
 }
 
 
@@ -864,6 +869,42 @@ static HReg do_sse_NotV128 ( ISelEnv* env, HReg src )
 }
 
 
+/* Generate argL `op` argR into a new vector register.  On hosts with
+   AVX this is a single VEX-encoded instruction, which leaves argL
+   intact and so saves the copy that the two-operand SSE form needs.
+*/
+static HReg do_sse_BinV128 ( ISelEnv* env, AMD64SseOp op,
+                             HReg argL, HReg argR )
+{
+   HReg dst = newVRegV(env);
+   if (env->hwcaps & VEX_HWCAPS_AMD64_AVX) {
+      addInstr(env, AMD64Instr_AvxReRg3(op, argL, argR, dst));
+   } else {
+      addInstr(env, mk_vMOVsd_RR(argL, dst));
+      addInstr(env, AMD64Instr_SseReRg(op, argR, dst));
+   }
+   return dst;
+}
+
+
+/* Move a 64-bit value into the lower half of a new vector register,
+   zeroing the upper half, and back again.
+*/
+static HReg do_sse_64toV128 ( ISelEnv* env, HReg src )
+{
+   HReg dst = newVRegV(env);
+   addInstr(env, AMD64Instr_SseMOVQ(src, dst, True/*toXMM*/));
+   return dst;
+}
+
+static HReg do_sse_V128to64 ( ISelEnv* env, HReg src )
+{
+   HReg dst = newVRegI(env);
+   addInstr(env, AMD64Instr_SseMOVQ(dst, src, False/*!toXMM*/));
+   return dst;
+}
+
+
 /* Expand the given byte into a 64-bit word, by cloning each bit
    8 times. */
 static ULong bitmask8_to_bytemask64 ( UShort w8 )
@@ -915,6 +956,9 @@ static HReg iselIntExpr_R_wrk ( ISelEnv* env, IRExpr* e )
    /* Used for unary/binary SIMD64 ops. */
    HWord fn = 0;
    Bool second_is_UInt;
+   AMD64SseOp sseOp;
+   Bool swapArgs, takeHI, isNarrow;
+   UInt shiftMax;
 
    MatchInfo mi;
    DECLARE_PATTERN(p_1Uto8_64to1);
@@ -1078,47 +1122,128 @@ static HReg iselIntExpr_R_wrk ( ISelEnv* env, IRExpr* e )
          return dst;
       }
 
-      /* Deal with 64-bit SIMD binary ops */
-      second_is_UInt = False;
+      /* 64-bit SIMD binary ops that have SSE equivalents are done
+         in the lower halves of xmm registers, rather than by the
+         helper calls below. */
+      sseOp = Asse_INVALID;
+      swapArgs = takeHI = isNarrow = False;
+      shiftMax = 0;
       switch (e->Iex.Binop.op) {
-         case Iop_Add8x8:
-            fn = (HWord)h_generic_calc_Add8x8; break;
-         case Iop_Add16x4:
-            fn = (HWord)h_generic_calc_Add16x4; break;
-         case Iop_Add32x2:
-            fn = (HWord)h_generic_calc_Add32x2; break;
-
-         case Iop_Avg8Ux8:
-            fn = (HWord)h_generic_calc_Avg8Ux8; break;
-         case Iop_Avg16Ux4:
-            fn = (HWord)h_generic_calc_Avg16Ux4; break;
-
-         case Iop_CmpEQ8x8:
-            fn = (HWord)h_generic_calc_CmpEQ8x8; break;
-         case Iop_CmpEQ16x4:
-            fn = (HWord)h_generic_calc_CmpEQ16x4; break;
-         case Iop_CmpEQ32x2:
-            fn = (HWord)h_generic_calc_CmpEQ32x2; break;
-
-         case Iop_CmpGT8Sx8:
-            fn = (HWord)h_generic_calc_CmpGT8Sx8; break;
-         case Iop_CmpGT16Sx4:
-            fn = (HWord)h_generic_calc_CmpGT16Sx4; break;
-         case Iop_CmpGT32Sx2:
-            fn = (HWord)h_generic_calc_CmpGT32Sx2; break;
-
+         case Iop_Add8x8:     sseOp = Asse_ADD8;     break;
+         case Iop_Add16x4:    sseOp = Asse_ADD16;    break;
+         case Iop_Add32x2:    sseOp = Asse_ADD32;    break;
+         case Iop_Avg8Ux8:    sseOp = Asse_AVG8U;    break;
+         case Iop_Avg16Ux4:   sseOp = Asse_AVG16U;   break;
+         case Iop_CmpEQ8x8:   sseOp = Asse_CMPEQ8;   break;
+         case Iop_CmpEQ16x4:  sseOp = Asse_CMPEQ16;  break;
+         case Iop_CmpEQ32x2:  sseOp = Asse_CMPEQ32;  break;
+         case Iop_CmpGT8Sx8:  sseOp = Asse_CMPGT8S;  break;
+         case Iop_CmpGT16Sx4: sseOp = Asse_CMPGT16S; break;
+         case Iop_CmpGT32Sx2: sseOp = Asse_CMPGT32S; break;
+         case Iop_Max8Ux8:    sseOp = Asse_MAX8U;    break;
+         case Iop_Max16Sx4:   sseOp = Asse_MAX16S;   break;
+         case Iop_Min8Ux8:    sseOp = Asse_MIN8U;    break;
+         case Iop_Min16Sx4:   sseOp = Asse_MIN16S;   break;
+         case Iop_Mul16x4:    sseOp = Asse_MUL16;    break;
+         case Iop_MulHi16Sx4: sseOp = Asse_MULHI16S; break;
+         case Iop_MulHi16Ux4: sseOp = Asse_MULHI16U; break;
+         case Iop_QAdd8Sx8:   sseOp = Asse_QADD8S;   break;
+         case Iop_QAdd16Sx4:  sseOp = Asse_QADD16S;  break;
+         case Iop_QAdd8Ux8:   sseOp = Asse_QADD8U;   break;
+         case Iop_QAdd16Ux4:  sseOp = Asse_QADD16U;  break;
+         case Iop_QSub8Sx8:   sseOp = Asse_QSUB8S;   break;
+         case Iop_QSub16Sx4:  sseOp = Asse_QSUB16S;  break;
+         case Iop_QSub8Ux8:   sseOp = Asse_QSUB8U;   break;
+         case Iop_QSub16Ux4:  sseOp = Asse_QSUB16U;  break;
+         case Iop_Sub8x8:     sseOp = Asse_SUB8;     break;
+         case Iop_Sub16x4:    sseOp = Asse_SUB16;    break;
+         case Iop_Sub32x2:    sseOp = Asse_SUB32;    break;
+
+         /* The unpckl insns interleave the lower halves of their
+            operands, with the E (second) operand in the odd lanes.
+            The HI variants want the upper half of that. */
          case Iop_InterleaveHI8x8:
-            fn = (HWord)h_generic_calc_InterleaveHI8x8; break;
+            takeHI = True; /* fallthrough */
          case Iop_InterleaveLO8x8:
-            fn = (HWord)h_generic_calc_InterleaveLO8x8; break;
+            sseOp = Asse_UNPCKLB; swapArgs = True; break;
          case Iop_InterleaveHI16x4:
-            fn = (HWord)h_generic_calc_InterleaveHI16x4; break;
+            takeHI = True; /* fallthrough */
          case Iop_InterleaveLO16x4:
-            fn = (HWord)h_generic_calc_InterleaveLO16x4; break;
+            sseOp = Asse_UNPCKLW; swapArgs = True; break;
          case Iop_InterleaveHI32x2:
-            fn = (HWord)h_generic_calc_InterleaveHI32x2; break;
+            takeHI = True; /* fallthrough */
          case Iop_InterleaveLO32x2:
-            fn = (HWord)h_generic_calc_InterleaveLO32x2; break;
+            sseOp = Asse_UNPCKLD; swapArgs = True; break;
+
+         case Iop_QNarrowBin32Sto16Sx4:
+            sseOp = Asse_PACKSSD; isNarrow = True; break;
+         case Iop_QNarrowBin16Sto8Sx8:
+            sseOp = Asse_PACKSSW; isNarrow = True; break;
+         case Iop_QNarrowBin16Sto8Ux8:
+            sseOp = Asse_PACKUSW; isNarrow = True; break;
+
+         /* SSE shifts zero the lanes for out-of-range amounts,
+            whereas the helpers mask the amount.  So only do shifts
+            by in-range constants here. */
+         case Iop_ShlN16x4: sseOp = Asse_SHL16; shiftMax = 16; break;
+         case Iop_ShlN32x2: sseOp = Asse_SHL32; shiftMax = 32; break;
+         case Iop_ShrN16x4: sseOp = Asse_SHR16; shiftMax = 16; break;
+         case Iop_ShrN32x2: sseOp = Asse_SHR32; shiftMax = 32; break;
+         case Iop_SarN16x4: sseOp = Asse_SAR16; shiftMax = 16; break;
+         case Iop_SarN32x2: sseOp = Asse_SAR32; shiftMax = 32; break;
+
+         /* These need SSE4.1 and SSSE3 respectively.  Perm8x8's
+            indices are at most 7, so pshufb picks from the lower
+            half only. */
+         case Iop_Mul32x2:
+            if (env->hwcaps & VEX_HWCAPS_AMD64_AVX)
+               sseOp = Asse_MUL32;
+            break;
+         case Iop_Perm8x8:
+            if (env->hwcaps & VEX_HWCAPS_AMD64_AVX)
+               sseOp = Asse_PERM8;
+            break;
+
+         default:
+            break;
+      }
+      if (shiftMax > 0
+          && !(e->Iex.Binop.arg2->tag == Iex_Const
+               && e->Iex.Binop.arg2->Iex.Const.con->tag == Ico_U8
+               && e->Iex.Binop.arg2->Iex.Const.con->Ico.U8 < shiftMax))
+         sseOp = Asse_INVALID;
+      if (sseOp != Asse_INVALID) {
+         HReg vL = do_sse_64toV128(env, iselIntExpr_R(env, e->Iex.Binop.arg1));
+         HReg vR, res;
+         if (shiftMax > 0) {
+            HReg amt = newVRegI(env);
+            addInstr(env, AMD64Instr_Imm64(
+                             e->Iex.Binop.arg2->Iex.Const.con->Ico.U8, amt));
+            vR = do_sse_64toV128(env, amt);
+         } else {
+            vR = do_sse_64toV128(env, iselIntExpr_R(env, e->Iex.Binop.arg2));
+         }
+         if (isNarrow) {
+            /* Put argR in the lower half and argL in the upper, then
+               narrow the whole thing into the lower half. */
+            HReg both = do_sse_BinV128(env, Asse_UNPCKLQ, vR, vL);
+            res = do_sse_BinV128(env, sseOp, both, both);
+         } else if (swapArgs) {
+            res = do_sse_BinV128(env, sseOp, vR, vL);
+            if (takeHI) {
+               HReg hi = newVRegV(env);
+               addInstr(env, AMD64Instr_SseShuf(0xEE, res, hi));
+               res = hi;
+            }
+         } else {
+            res = do_sse_BinV128(env, sseOp, vL, vR);
+         }
+         return do_sse_V128to64(env, res);
+      }
+
+      /* Deal with 64-bit SIMD binary ops */
+      second_is_UInt = False;
+      switch (e->Iex.Binop.op) {
          case Iop_CatOddLanes16x4:
             fn = (HWord)h_generic_calc_CatOddLanes16x4; break;
          case Iop_CatEvenLanes16x4:
@@ -1126,60 +1251,14 @@ static HReg iselIntExpr_R_wrk ( ISelEnv* env, IRExpr* e )
          case Iop_Perm8x8:
             fn = (HWord)h_generic_calc_Perm8x8; break;
 
-         case Iop_Max8Ux8:
-            fn = (HWord)h_generic_calc_Max8Ux8; break;
-         case Iop_Max16Sx4:
-            fn = (HWord)h_generic_calc_Max16Sx4; break;
-         case Iop_Min8Ux8:
-            fn = (HWord)h_generic_calc_Min8Ux8; break;
-         case Iop_Min16Sx4:
-            fn = (HWord)h_generic_calc_Min16Sx4; break;
-
-         case Iop_Mul16x4:
-            fn = (HWord)h_generic_calc_Mul16x4; break;
          case Iop_Mul32x2:
             fn = (HWord)h_generic_calc_Mul32x2; break;
-         case Iop_MulHi16Sx4:
-            fn = (HWord)h_generic_calc_MulHi16Sx4; break;
-         case Iop_MulHi16Ux4:
-            fn = (HWord)h_generic_calc_MulHi16Ux4; break;
-
-         case Iop_QAdd8Sx8:
-            fn = (HWord)h_generic_calc_QAdd8Sx8; break;
-         case Iop_QAdd16Sx4:
-            fn = (HWord)h_generic_calc_QAdd16Sx4; break;
-         case Iop_QAdd8Ux8:
-            fn = (HWord)h_generic_calc_QAdd8Ux8; break;
-         case Iop_QAdd16Ux4:
-            fn = (HWord)h_generic_calc_QAdd16Ux4; break;
 
-         case Iop_QNarrowBin32Sto16Sx4:
-            fn = (HWord)h_generic_calc_QNarrowBin32Sto16Sx4; break;
-         case Iop_QNarrowBin16Sto8Sx8:
-            fn = (HWord)h_generic_calc_QNarrowBin16Sto8Sx8; break;
-         case Iop_QNarrowBin16Sto8Ux8:
-            fn = (HWord)h_generic_calc_QNarrowBin16Sto8Ux8; break;
          case Iop_NarrowBin16to8x8:
             fn = (HWord)h_generic_calc_NarrowBin16to8x8; break;
          case Iop_NarrowBin32to16x4:
             fn = (HWord)h_generic_calc_NarrowBin32to16x4; break;
 
-         case Iop_QSub8Sx8:
-            fn = (HWord)h_generic_calc_QSub8Sx8; break;
-         case Iop_QSub16Sx4:
-            fn = (HWord)h_generic_calc_QSub16Sx4; break;
-         case Iop_QSub8Ux8:
-            fn = (HWord)h_generic_calc_QSub8Ux8; break;
-         case Iop_QSub16Ux4:
-            fn = (HWord)h_generic_calc_QSub16Ux4; break;
-
-         case Iop_Sub8x8:
-            fn = (HWord)h_generic_calc_Sub8x8; break;
-         case Iop_Sub16x4:
-            fn = (HWord)h_generic_calc_Sub16x4; break;
-         case Iop_Sub32x2:
-            fn = (HWord)h_generic_calc_Sub32x2; break;
-
          case Iop_ShlN32x2:
             fn = (HWord)h_generic_calc_ShlN32x2; 
             second_is_UInt = True;
@@ -1229,8 +1308,9 @@ static HReg iselIntExpr_R_wrk ( ISelEnv* env, IRExpr* e )
          addInstr(env, mk_iMOVsd_RR(argL, hregAMD64_RDI()) );
          addInstr(env, mk_iMOVsd_RR(argR, hregAMD64_RSI()) );
          addInstr(env, AMD64Instr_Call( Acc_ALWAYS, (ULong)fn, 2,
-                                        mk_RetLoc_simple(RLPri_Int) ));
+                                        mk_RetLoc_simple(RLPri_Int), False ));
          addInstr(env, mk_iMOVsd_RR(hregAMD64_RAX(), dst));
+         vex_isel_stats.n_helper_calls++;
          return dst;
       }
 
@@ -1612,17 +1692,13 @@ static HReg iselIntExpr_R_wrk ( ISelEnv* env, IRExpr* e )
          /* V128{HI}to64 */
          case Iop_V128HIto64:
          case Iop_V128to64: {
-            HReg dst = newVRegI(env);
-            Int  off = e->Iex.Unop.op==Iop_V128HIto64 ? -8 : -16;
-            HReg rsp = hregAMD64_RSP();
             HReg vec = iselVecExpr(env, e->Iex.Unop.arg);
-            AMD64AMode* m16_rsp = AMD64AMode_IR(-16, rsp);
-            AMD64AMode* off_rsp = AMD64AMode_IR(off, rsp);
-            addInstr(env, AMD64Instr_SseLdSt(False/*store*/,
-                                             16, vec, m16_rsp));
-            addInstr(env, AMD64Instr_Alu64R( Aalu_MOV, 
-                                             AMD64RMI_Mem(off_rsp), dst ));
-            return dst;
+            if (e->Iex.Unop.op == Iop_V128HIto64) {
+               HReg hi = newVRegV(env);
+               addInstr(env, AMD64Instr_SseShuf(0xEE, vec, hi));
+               vec = hi;
+            }
+            return do_sse_V128to64(env, vec);
          }
 
          case Iop_V256to64_0: case Iop_V256to64_1:
@@ -1690,53 +1766,20 @@ static HReg iselIntExpr_R_wrk ( ISelEnv* env, IRExpr* e )
             return iselIntExpr_R(env, e->Iex.Unop.arg);
 
          case Iop_GetMSBs8x8: {
-            /* Note: the following assumes the helper is of
-               signature
-                  UInt fn ( ULong ), and is not a regparm fn.
-            */
+            /* pmovmskb on the value in the lower half of an xmm
+               register.  The upper half is zero, so the top 8 bits
+               of the 16-bit mask are too. */
             HReg dst = newVRegI(env);
             HReg arg = iselIntExpr_R(env, e->Iex.Unop.arg);
-            fn = (HWord)h_generic_calc_GetMSBs8x8;
-            addInstr(env, mk_iMOVsd_RR(arg, hregAMD64_RDI()) );
-            addInstr(env, AMD64Instr_Call( Acc_ALWAYS, (ULong)fn,
-                                           1, mk_RetLoc_simple(RLPri_Int) ));
-            /* MovxLQ is not exactly the right thing here.  We just
-               need to get the bottom 8 bits of RAX into dst, and zero
-               out everything else.  Assuming that the helper returns
-               a UInt with the top 24 bits zeroed out, it'll do,
-               though. */
-            addInstr(env, AMD64Instr_MovxLQ(False, hregAMD64_RAX(), dst));
+            addInstr(env, AMD64Instr_SseMOVMSKB(do_sse_64toV128(env, arg),
+                                                dst));
             return dst;
          }
 
          case Iop_GetMSBs8x16: {
-            /* Note: the following assumes the helper is of signature
-                  UInt fn ( ULong w64hi, ULong w64Lo ),
-               and is not a regparm fn. */
             HReg dst = newVRegI(env);
             HReg vec = iselVecExpr(env, e->Iex.Unop.arg);
-            HReg rsp = hregAMD64_RSP();
-            fn = (HWord)h_generic_calc_GetMSBs8x16;
-            AMD64AMode* m8_rsp  = AMD64AMode_IR( -8, rsp);
-            AMD64AMode* m16_rsp = AMD64AMode_IR(-16, rsp);
-            addInstr(env, AMD64Instr_SseLdSt(False/*store*/,
-                                             16, vec, m16_rsp));
-            /* hi 64 bits into RDI -- the first arg */
-            addInstr(env, AMD64Instr_Alu64R( Aalu_MOV, 
-                                             AMD64RMI_Mem(m8_rsp),
-                                             hregAMD64_RDI() )); /* 1st arg */
-            /* lo 64 bits into RSI -- the 2nd arg */
-            addInstr(env, AMD64Instr_Alu64R( Aalu_MOV, 
-                                             AMD64RMI_Mem(m16_rsp),
-                                             hregAMD64_RSI() )); /* 2nd arg */
-            addInstr(env, AMD64Instr_Call( Acc_ALWAYS, (ULong)fn,
-                                           2, mk_RetLoc_simple(RLPri_Int) ));
-            /* MovxLQ is not exactly the right thing here.  We just
-               need to get the bottom 16 bits of RAX into dst, and zero
-               out everything else.  Assuming that the helper returns
-               a UInt with the top 16 bits zeroed out, it'll do,
-               though. */
-            addInstr(env, AMD64Instr_MovxLQ(False, hregAMD64_RAX(), dst));
+            addInstr(env, AMD64Instr_SseMOVMSKB(vec, dst));
             return dst;
          }
 
@@ -1744,30 +1787,20 @@ static HReg iselIntExpr_R_wrk ( ISelEnv* env, IRExpr* e )
             break;
       }
 
-      /* Deal with unary 64-bit SIMD ops. */
+      /* Deal with unary 64-bit SIMD ops.  These are done in the
+         lower half of an xmm register, as for the binary ones. */
       switch (e->Iex.Unop.op) {
-         case Iop_CmpNEZ32x2:
-            fn = (HWord)h_generic_calc_CmpNEZ32x2; break;
-         case Iop_CmpNEZ16x4:
-            fn = (HWord)h_generic_calc_CmpNEZ16x4; break;
-         case Iop_CmpNEZ8x8:
-            fn = (HWord)h_generic_calc_CmpNEZ8x8; break;
-         default:
-            fn = (HWord)0; break;
+         case Iop_CmpNEZ32x2: sseOp = Asse_CMPEQ32; break;
+         case Iop_CmpNEZ16x4: sseOp = Asse_CMPEQ16; break;
+         case Iop_CmpNEZ8x8:  sseOp = Asse_CMPEQ8;  break;
+         default:             sseOp = Asse_INVALID; break;
       }
-      if (fn != (HWord)0) {
-         /* Note: the following assumes all helpers are of
-            signature 
-               ULong fn ( ULong ), and they are
-            not marked as regparm functions. 
-         */
-         HReg dst = newVRegI(env);
-         HReg arg = iselIntExpr_R(env, e->Iex.Unop.arg);
-         addInstr(env, mk_iMOVsd_RR(arg, hregAMD64_RDI()) );
-         addInstr(env, AMD64Instr_Call( Acc_ALWAYS, (ULong)fn, 1,
-                                        mk_RetLoc_simple(RLPri_Int) ));
-         addInstr(env, mk_iMOVsd_RR(hregAMD64_RAX(), dst));
-         return dst;
+      if (sseOp != Asse_INVALID) {
+         HReg arg  = iselIntExpr_R(env, e->Iex.Unop.arg);
+         HReg zero = generate_zeroes_V128(env);
+         HReg tmp  = do_sse_BinV128(env, sseOp,
+                                    do_sse_64toV128(env, arg), zero);
+         return do_sse_V128to64(env, do_sse_NotV128(env, tmp));
       }
 
       break;
@@ -1827,7 +1860,7 @@ static HReg iselIntExpr_R_wrk ( ISelEnv* env, IRExpr* e )
       /* Marshal args, do the call. */
       UInt   addToSp = 0;
       RetLoc rloc    = mk_RetLoc_INVALID();
-      doHelperCall( &addToSp, &rloc, env, NULL/*guard*/,
+      doHelperCall( &addToSp, &rloc, env, NULL/*guard*/, False/*cold*/,
                     e->Iex.CCall.cee, e->Iex.CCall.retty, e->Iex.CCall.args );
       vassert(is_sane_RetLoc(rloc));
       vassert(rloc.pri == RLPri_Int);
@@ -2378,7 +2411,7 @@ static AMD64CondCode iselCondCode_wrk ( ISelEnv* env, IRExpr* e )
       /* Marshal args, do the call. */
       UInt   addToSp = 0;
       RetLoc rloc    = mk_RetLoc_INVALID();
-      doHelperCall( &addToSp, &rloc, env, NULL/*guard*/,
+      doHelperCall( &addToSp, &rloc, env, NULL/*guard*/, False/*cold*/,
                     cal->Iex.CCall.cee,
                     cal->Iex.CCall.retty, cal->Iex.CCall.args );
       vassert(is_sane_RetLoc(rloc));
@@ -2665,6 +2698,13 @@ static HReg iselFltExpr_wrk ( ISelEnv* env, IRExpr* e )
       HReg argZ = iselFltExpr(env, qop->arg4);
       /* XXXROUNDINGFIXME */
       /* set roundingmode here */
+      if (env->hwcaps & VEX_HWCAPS_AMD64_FMA) {
+         /* A real fused multiply-add, rather than the much slower
+            helper call below. */
+         addInstr(env, mk_vMOVsd_RR(argZ, dst));
+         addInstr(env, AMD64Instr_AvxFMA(4, argX, argY, dst));
+         return dst;
+      }
       /* subq $16, %rsp         -- make a space*/
       sub_from_rsp(env, 16);
       /* Prepare 4 arg regs:
@@ -2695,7 +2735,8 @@ static HReg iselFltExpr_wrk ( ISelEnv* env, IRExpr* e )
       /* call the helper */
       addInstr(env, AMD64Instr_Call( Acc_ALWAYS,
                                      (ULong)(HWord)h_generic_calc_MAddF32,
-                                     4, mk_RetLoc_simple(RLPri_None) ));
+                                     4, mk_RetLoc_simple(RLPri_None), False ));
+      vex_isel_stats.n_helper_calls++;
       /* fetch the result from memory, using %r_argp, which the
          register allocator will keep alive across the call. */
       addInstr(env, AMD64Instr_SseLdSt(True/*isLoad*/, 4, dst,
@@ -2844,6 +2885,13 @@ static HReg iselDblExpr_wrk ( ISelEnv* env, IRExpr* e )
       HReg argZ = iselDblExpr(env, qop->arg4);
       /* XXXROUNDINGFIXME */
       /* set roundingmode here */
+      if (env->hwcaps & VEX_HWCAPS_AMD64_FMA) {
+         /* A real fused multiply-add, rather than the much slower
+            helper call below. */
+         addInstr(env, mk_vMOVsd_RR(argZ, dst));
+         addInstr(env, AMD64Instr_AvxFMA(8, argX, argY, dst));
+         return dst;
+      }
       /* subq $32, %rsp         -- make a space*/
       sub_from_rsp(env, 32);
       /* Prepare 4 arg regs:
@@ -2874,7 +2922,8 @@ static HReg iselDblExpr_wrk ( ISelEnv* env, IRExpr* e )
       /* call the helper */
       addInstr(env, AMD64Instr_Call( Acc_ALWAYS,
                                      (ULong)(HWord)h_generic_calc_MAddF64,
-                                     4, mk_RetLoc_simple(RLPri_None) ));
+                                     4, mk_RetLoc_simple(RLPri_None), False ));
+      vex_isel_stats.n_helper_calls++;
       /* fetch the result from memory, using %r_argp, which the
          register allocator will keep alive across the call. */
       addInstr(env, AMD64Instr_SseLdSt(True/*isLoad*/, 8, dst,
@@ -3204,6 +3253,11 @@ static HReg iselVecExpr_wrk ( ISelEnv* env, IRExpr* e )
          HReg arg  = iselVecExpr(env, e->Iex.Unop.arg);
          HReg tmp  = generate_zeroes_V128(env);
          HReg dst  = newVRegV(env);
+         if (env->hwcaps & VEX_HWCAPS_AMD64_AVX) {
+            /* SSE4.1 has the 64-bit comparison. */
+            tmp = do_sse_BinV128(env, Asse_CMPEQ64, arg, tmp);
+            return do_sse_NotV128(env, tmp);
+         }
          addInstr(env, AMD64Instr_SseReRg(Asse_CMPEQ32, arg, tmp));
          tmp = do_sse_NotV128(env, tmp);
          addInstr(env, AMD64Instr_SseShuf(0xB1, tmp, dst));
@@ -3217,13 +3271,9 @@ static HReg iselVecExpr_wrk ( ISelEnv* env, IRExpr* e )
       do_CmpNEZ_vector:
       {
          HReg arg  = iselVecExpr(env, e->Iex.Unop.arg);
-         HReg tmp  = newVRegV(env);
          HReg zero = generate_zeroes_V128(env);
-         HReg dst;
-         addInstr(env, mk_vMOVsd_RR(arg, tmp));
-         addInstr(env, AMD64Instr_SseReRg(op, zero, tmp));
-         dst = do_sse_NotV128(env, tmp);
-         return dst;
+         HReg tmp  = do_sse_BinV128(env, op, arg, zero);
+         return do_sse_NotV128(env, tmp);
       }
 
       case Iop_RecipEst32Fx4: op = Asse_RCPF;   goto do_32Fx4_unary;
@@ -3290,13 +3340,8 @@ static HReg iselVecExpr_wrk ( ISelEnv* env, IRExpr* e )
       }
 
       case Iop_64UtoV128: {
-         HReg        dst  = newVRegV(env);
-         AMD64AMode* rsp0 = AMD64AMode_IR(0, hregAMD64_RSP());
-         AMD64RMI*   rmi  = iselIntExpr_RMI(env, e->Iex.Unop.arg);
-         addInstr(env, AMD64Instr_Push(rmi));
-         addInstr(env, AMD64Instr_SseLdzLO(8, dst, rsp0));
-         add_to_rsp(env, 8);
-         return dst;
+         HReg arg = iselIntExpr_R(env, e->Iex.Unop.arg);
+         return do_sse_64toV128(env, arg);
       }
 
       case Iop_V256toV128_0:
@@ -3484,15 +3529,10 @@ static HReg iselVecExpr_wrk ( ISelEnv* env, IRExpr* e )
       do_SseReRg: {
          HReg arg1 = iselVecExpr(env, e->Iex.Binop.arg1);
          HReg arg2 = iselVecExpr(env, e->Iex.Binop.arg2);
-         HReg dst = newVRegV(env);
-         if (arg1isEReg) {
-            addInstr(env, mk_vMOVsd_RR(arg2, dst));
-            addInstr(env, AMD64Instr_SseReRg(op, arg1, dst));
-         } else {
-            addInstr(env, mk_vMOVsd_RR(arg1, dst));
-            addInstr(env, AMD64Instr_SseReRg(op, arg2, dst));
-         }
-         return dst;
+         if (arg1isEReg)
+            return do_sse_BinV128(env, op, arg2, arg1);
+         else
+            return do_sse_BinV128(env, op, arg1, arg2);
       }
 
       case Iop_ShlN16x8: op = Asse_SHL16; goto do_SseShift;
@@ -3518,29 +3558,65 @@ static HReg iselVecExpr_wrk ( ISelEnv* env, IRExpr* e )
          return dst;
       }
 
-      case Iop_Mul32x4:    fn = (HWord)h_generic_calc_Mul32x4;
+      case Iop_Mul32x4:    if (env->hwcaps & VEX_HWCAPS_AMD64_AVX) {
+                              op = Asse_MUL32; goto do_SseReRg;
+                           }
+                           fn = (HWord)h_generic_calc_Mul32x4;
                            goto do_SseAssistedBinary;
-      case Iop_Max32Sx4:   fn = (HWord)h_generic_calc_Max32Sx4;
+      case Iop_Max32Sx4:   if (env->hwcaps & VEX_HWCAPS_AMD64_AVX) {
+                              op = Asse_MAX32S; goto do_SseReRg;
+                           }
+                           fn = (HWord)h_generic_calc_Max32Sx4;
                            goto do_SseAssistedBinary;
-      case Iop_Min32Sx4:   fn = (HWord)h_generic_calc_Min32Sx4;
+      case Iop_Min32Sx4:   if (env->hwcaps & VEX_HWCAPS_AMD64_AVX) {
+                              op = Asse_MIN32S; goto do_SseReRg;
+                           }
+                           fn = (HWord)h_generic_calc_Min32Sx4;
                            goto do_SseAssistedBinary;
-      case Iop_Max32Ux4:   fn = (HWord)h_generic_calc_Max32Ux4;
+      case Iop_Max32Ux4:   if (env->hwcaps & VEX_HWCAPS_AMD64_AVX) {
+                              op = Asse_MAX32U; goto do_SseReRg;
+                           }
+                           fn = (HWord)h_generic_calc_Max32Ux4;
                            goto do_SseAssistedBinary;
-      case Iop_Min32Ux4:   fn = (HWord)h_generic_calc_Min32Ux4;
+      case Iop_Min32Ux4:   if (env->hwcaps & VEX_HWCAPS_AMD64_AVX) {
+                              op = Asse_MIN32U; goto do_SseReRg;
+                           }
+                           fn = (HWord)h_generic_calc_Min32Ux4;
                            goto do_SseAssistedBinary;
-      case Iop_Max16Ux8:   fn = (HWord)h_generic_calc_Max16Ux8;
+      case Iop_Max16Ux8:   if (env->hwcaps & VEX_HWCAPS_AMD64_AVX) {
+                              op = Asse_MAX16U; goto do_SseReRg;
+                           }
+                           fn = (HWord)h_generic_calc_Max16Ux8;
                            goto do_SseAssistedBinary;
-      case Iop_Min16Ux8:   fn = (HWord)h_generic_calc_Min16Ux8;
+      case Iop_Min16Ux8:   if (env->hwcaps & VEX_HWCAPS_AMD64_AVX) {
+                              op = Asse_MIN16U; goto do_SseReRg;
+                           }
+                           fn = (HWord)h_generic_calc_Min16Ux8;
                            goto do_SseAssistedBinary;
-      case Iop_Max8Sx16:   fn = (HWord)h_generic_calc_Max8Sx16;
+      case Iop_Max8Sx16:   if (env->hwcaps & VEX_HWCAPS_AMD64_AVX) {
+                              op = Asse_MAX8S; goto do_SseReRg;
+                           }
+                           fn = (HWord)h_generic_calc_Max8Sx16;
                            goto do_SseAssistedBinary;
-      case Iop_Min8Sx16:   fn = (HWord)h_generic_calc_Min8Sx16;
+      case Iop_Min8Sx16:   if (env->hwcaps & VEX_HWCAPS_AMD64_AVX) {
+                              op = Asse_MIN8S; goto do_SseReRg;
+                           }
+                           fn = (HWord)h_generic_calc_Min8Sx16;
                            goto do_SseAssistedBinary;
-      case Iop_CmpEQ64x2:  fn = (HWord)h_generic_calc_CmpEQ64x2;
+      case Iop_CmpEQ64x2:  if (env->hwcaps & VEX_HWCAPS_AMD64_AVX) {
+                              op = Asse_CMPEQ64; goto do_SseReRg;
+                           }
+                           fn = (HWord)h_generic_calc_CmpEQ64x2;
                            goto do_SseAssistedBinary;
-      case Iop_CmpGT64Sx2: fn = (HWord)h_generic_calc_CmpGT64Sx2;
+      case Iop_CmpGT64Sx2: if (env->hwcaps & VEX_HWCAPS_AMD64_AVX) {
+                              op = Asse_CMPGT64S; goto do_SseReRg;
+                           }
+                           fn = (HWord)h_generic_calc_CmpGT64Sx2;
                            goto do_SseAssistedBinary;
-      case Iop_Perm32x4:   fn = (HWord)h_generic_calc_Perm32x4;
+      case Iop_Perm32x4:   if (env->hwcaps & VEX_HWCAPS_AMD64_AVX) {
+                              op = Asse_PERM32; goto do_SseReRg;
+                           }
+                           fn = (HWord)h_generic_calc_Perm32x4;
                            goto do_SseAssistedBinary;
       case Iop_QNarrowBin32Sto16Ux8:
                            fn = (HWord)h_generic_calc_QNarrowBin32Sto16Ux8;
@@ -3589,7 +3665,9 @@ static HReg iselVecExpr_wrk ( ISelEnv* env, IRExpr* e )
                                           AMD64AMode_IR(0, hregAMD64_RDX())));
          /* call the helper */
          addInstr(env, AMD64Instr_Call( Acc_ALWAYS, (ULong)fn,
-                                        3, mk_RetLoc_simple(RLPri_None) ));
+                                        3, mk_RetLoc_simple(RLPri_None),
+                                        False ));
+         vex_isel_stats.n_helper_calls++;
          /* fetch the result from memory, using %r_argp, which the
             register allocator will keep alive across the call. */
          addInstr(env, AMD64Instr_SseLdSt(True/*isLoad*/, 16, dst,
@@ -3638,7 +3716,9 @@ static HReg iselVecExpr_wrk ( ISelEnv* env, IRExpr* e )
 
          /* call the helper */
          addInstr(env, AMD64Instr_Call( Acc_ALWAYS, (ULong)fn,
-                                        3, mk_RetLoc_simple(RLPri_None) ));
+                                        3, mk_RetLoc_simple(RLPri_None),
+                                        False ));
+         vex_isel_stats.n_helper_calls++;
          /* fetch the result from memory, using %r_argp, which the
             register allocator will keep alive across the call. */
          addInstr(env, AMD64Instr_SseLdSt(True/*isLoad*/, 16, dst,
@@ -3837,6 +3917,14 @@ static void iselDVecExpr_wrk ( /*OUT*/HReg* rHi, /*OUT*/HReg* rLo,
             explanation of what's going on here. */
          HReg argHi, argLo;
          iselDVecExpr(&argHi, &argLo, env, e->Iex.Unop.arg);
+         if (env->hwcaps & VEX_HWCAPS_AMD64_AVX) {
+            HReg zero = generate_zeroes_V128(env);
+            *rHi = do_sse_NotV128(env,
+                      do_sse_BinV128(env, Asse_CMPEQ64, argHi, zero));
+            *rLo = do_sse_NotV128(env,
+                      do_sse_BinV128(env, Asse_CMPEQ64, argLo, zero));
+            return;
+         }
          HReg tmpHi  = generate_zeroes_V128(env);
          HReg tmpLo  = newVRegV(env);
          addInstr(env, mk_vMOVsd_RR(tmpHi, tmpLo));
@@ -3862,18 +3950,11 @@ static void iselDVecExpr_wrk ( /*OUT*/HReg* rHi, /*OUT*/HReg* rLo,
       {
          HReg argHi, argLo;
          iselDVecExpr(&argHi, &argLo, env, e->Iex.Unop.arg);
-         HReg tmpHi = newVRegV(env);
-         HReg tmpLo = newVRegV(env);
          HReg zero  = generate_zeroes_V128(env);
-         HReg dstHi, dstLo;
-         addInstr(env, mk_vMOVsd_RR(argHi, tmpHi));
-         addInstr(env, mk_vMOVsd_RR(argLo, tmpLo));
-         addInstr(env, AMD64Instr_SseReRg(op, zero, tmpHi));
-         addInstr(env, AMD64Instr_SseReRg(op, zero, tmpLo));
-         dstHi = do_sse_NotV128(env, tmpHi);
-         dstLo = do_sse_NotV128(env, tmpLo);
-         *rHi = dstHi;
-         *rLo = dstLo;
+         HReg tmpHi = do_sse_BinV128(env, op, argHi, zero);
+         HReg tmpLo = do_sse_BinV128(env, op, argLo, zero);
+         *rHi = do_sse_NotV128(env, tmpHi);
+         *rLo = do_sse_NotV128(env, tmpLo);
          return;
       }
 
@@ -3960,14 +4041,8 @@ static void iselDVecExpr_wrk ( /*OUT*/HReg* rHi, /*OUT*/HReg* rLo,
          HReg argLhi, argLlo, argRhi, argRlo;
          iselDVecExpr(&argLhi, &argLlo, env, e->Iex.Binop.arg1);
          iselDVecExpr(&argRhi, &argRlo, env, e->Iex.Binop.arg2);
-         HReg dstHi = newVRegV(env);
-         HReg dstLo = newVRegV(env);
-         addInstr(env, mk_vMOVsd_RR(argLhi, dstHi));
-         addInstr(env, mk_vMOVsd_RR(argLlo, dstLo));
-         addInstr(env, AMD64Instr_SseReRg(op, argRhi, dstHi));
-         addInstr(env, AMD64Instr_SseReRg(op, argRlo, dstLo));
-         *rHi = dstHi;
-         *rLo = dstLo;
+         *rHi = do_sse_BinV128(env, op, argLhi, argRhi);
+         *rLo = do_sse_BinV128(env, op, argLlo, argRlo);
          return;
       }
 
@@ -4006,27 +4081,60 @@ static void iselDVecExpr_wrk ( /*OUT*/HReg* rHi, /*OUT*/HReg* rLo,
          return;
       }
 
-      case Iop_Mul32x8:    fn = (HWord)h_generic_calc_Mul32x4;
+      case Iop_Mul32x8:    if (env->hwcaps & VEX_HWCAPS_AMD64_AVX) {
+                              op = Asse_MUL32; goto do_SseReRg;
+                           }
+                           fn = (HWord)h_generic_calc_Mul32x4;
                            goto do_SseAssistedBinary;
-      case Iop_Max32Sx8:   fn = (HWord)h_generic_calc_Max32Sx4;
+      case Iop_Max32Sx8:   if (env->hwcaps & VEX_HWCAPS_AMD64_AVX) {
+                              op = Asse_MAX32S; goto do_SseReRg;
+                           }
+                           fn = (HWord)h_generic_calc_Max32Sx4;
                            goto do_SseAssistedBinary;
-      case Iop_Min32Sx8:   fn = (HWord)h_generic_calc_Min32Sx4;
+      case Iop_Min32Sx8:   if (env->hwcaps & VEX_HWCAPS_AMD64_AVX) {
+                              op = Asse_MIN32S; goto do_SseReRg;
+                           }
+                           fn = (HWord)h_generic_calc_Min32Sx4;
                            goto do_SseAssistedBinary;
-      case Iop_Max32Ux8:   fn = (HWord)h_generic_calc_Max32Ux4;
+      case Iop_Max32Ux8:   if (env->hwcaps & VEX_HWCAPS_AMD64_AVX) {
+                              op = Asse_MAX32U; goto do_SseReRg;
+                           }
+                           fn = (HWord)h_generic_calc_Max32Ux4;
                            goto do_SseAssistedBinary;
-      case Iop_Min32Ux8:   fn = (HWord)h_generic_calc_Min32Ux4;
+      case Iop_Min32Ux8:   if (env->hwcaps & VEX_HWCAPS_AMD64_AVX) {
+                              op = Asse_MIN32U; goto do_SseReRg;
+                           }
+                           fn = (HWord)h_generic_calc_Min32Ux4;
                            goto do_SseAssistedBinary;
-      case Iop_Max16Ux16:  fn = (HWord)h_generic_calc_Max16Ux8;
+      case Iop_Max16Ux16:  if (env->hwcaps & VEX_HWCAPS_AMD64_AVX) {
+                              op = Asse_MAX16U; goto do_SseReRg;
+                           }
+                           fn = (HWord)h_generic_calc_Max16Ux8;
                            goto do_SseAssistedBinary;
-      case Iop_Min16Ux16:  fn = (HWord)h_generic_calc_Min16Ux8;
+      case Iop_Min16Ux16:  if (env->hwcaps & VEX_HWCAPS_AMD64_AVX) {
+                              op = Asse_MIN16U; goto do_SseReRg;
+                           }
+                           fn = (HWord)h_generic_calc_Min16Ux8;
                            goto do_SseAssistedBinary;
-      case Iop_Max8Sx32:   fn = (HWord)h_generic_calc_Max8Sx16;
+      case Iop_Max8Sx32:   if (env->hwcaps & VEX_HWCAPS_AMD64_AVX) {
+                              op = Asse_MAX8S; goto do_SseReRg;
+                           }
+                           fn = (HWord)h_generic_calc_Max8Sx16;
                            goto do_SseAssistedBinary;
-      case Iop_Min8Sx32:   fn = (HWord)h_generic_calc_Min8Sx16;
+      case Iop_Min8Sx32:   if (env->hwcaps & VEX_HWCAPS_AMD64_AVX) {
+                              op = Asse_MIN8S; goto do_SseReRg;
+                           }
+                           fn = (HWord)h_generic_calc_Min8Sx16;
                            goto do_SseAssistedBinary;
-      case Iop_CmpEQ64x4:  fn = (HWord)h_generic_calc_CmpEQ64x2;
+      case Iop_CmpEQ64x4:  if (env->hwcaps & VEX_HWCAPS_AMD64_AVX) {
+                              op = Asse_CMPEQ64; goto do_SseReRg;
+                           }
+                           fn = (HWord)h_generic_calc_CmpEQ64x2;
                            goto do_SseAssistedBinary;
-      case Iop_CmpGT64Sx4: fn = (HWord)h_generic_calc_CmpGT64Sx2;
+      case Iop_CmpGT64Sx4: if (env->hwcaps & VEX_HWCAPS_AMD64_AVX) {
+                              op = Asse_CMPGT64S; goto do_SseReRg;
+                           }
+                           fn = (HWord)h_generic_calc_CmpGT64Sx2;
                            goto do_SseAssistedBinary;
       do_SseAssistedBinary: {
          /* RRRufff!  RRRufff code is what we're generating here.  Oh
@@ -4076,7 +4184,8 @@ static void iselDVecExpr_wrk ( /*OUT*/HReg* rHi, /*OUT*/HReg* rLo,
                                           AMD64AMode_IR(48, hregAMD64_RDX())));
          /* call the helper */
          addInstr(env, AMD64Instr_Call( Acc_ALWAYS, (ULong)fn, 3,
-                                        mk_RetLoc_simple(RLPri_None) ));
+                                        mk_RetLoc_simple(RLPri_None), False ));
+         vex_isel_stats.n_helper_calls++;
          /* Prepare 3 arg regs:
             leaq 48(%r_argp), %rdi
             leaq 64(%r_argp), %rsi
@@ -4090,7 +4199,8 @@ static void iselDVecExpr_wrk ( /*OUT*/HReg* rHi, /*OUT*/HReg* rLo,
                                         hregAMD64_RDX()));
          /* call the helper */
          addInstr(env, AMD64Instr_Call( Acc_ALWAYS, (ULong)fn, 3,
-                                        mk_RetLoc_simple(RLPri_None) ));
+                                        mk_RetLoc_simple(RLPri_None), False ));
+         vex_isel_stats.n_helper_calls++;
          /* fetch the result from memory, using %r_argp, which the
             register allocator will keep alive across the call. */
          addInstr(env, AMD64Instr_SseLdSt(True/*isLoad*/, 16, dstHi,
@@ -4152,7 +4262,8 @@ static void iselDVecExpr_wrk ( /*OUT*/HReg* rHi, /*OUT*/HReg* rLo,
                                           AMD64AMode_IR(16, hregAMD64_RDX())));
          /* call the helper */
          addInstr(env, AMD64Instr_Call( Acc_ALWAYS, (ULong)fn, 3,
-                                        mk_RetLoc_simple(RLPri_None) ));
+                                        mk_RetLoc_simple(RLPri_None), False ));
+         vex_isel_stats.n_helper_calls++;
          /* fetch the result from memory, using %r_argp, which the
             register allocator will keep alive across the call. */
          addInstr(env, AMD64Instr_SseLdSt(True/*isLoad*/, 16, dstLo,
@@ -4534,7 +4645,8 @@ static void iselStmt ( ISelEnv* env, IRStmt* stmt )
          and the call is skipped. */
       UInt   addToSp = 0;
       RetLoc rloc    = mk_RetLoc_INVALID();
-      doHelperCall( &addToSp, &rloc, env, d->guard, d->cee, retty, d->args );
+      doHelperCall( &addToSp, &rloc, env, d->guard, d->cold,
+                    d->cee, retty, d->args );
       vassert(is_sane_RetLoc(rloc));
 
       /* Now figure out what to do with the returned value, if any. */
@@ -4894,7 +5006,8 @@ HInstrArray* iselSB_AMD64 ( IRSB* bb,
                      | VEX_HWCAPS_AMD64_AVX
                      | VEX_HWCAPS_AMD64_RDTSCP
                      | VEX_HWCAPS_AMD64_BMI
-                     | VEX_HWCAPS_AMD64_AVX2)));
+                     | VEX_HWCAPS_AMD64_AVX2
+                     | VEX_HWCAPS_AMD64_FMA)));
 
    /* Check that the host's endianness is as expected. */
    vassert(archinfo_host->endness == VexEndnessLE);
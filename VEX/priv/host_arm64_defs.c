@@ -1102,6 +1102,18 @@ ARM64Instr* ARM64Instr_VBinS ( ARM64FpBinOp op,
    i->ARM64in.VBinS.argR = argR;
    return i;
 }
+ARM64Instr* ARM64Instr_VFMA ( Bool isD, Bool isSub, HReg dst,
+                              HReg argN, HReg argM, HReg argA ) {
+   ARM64Instr* i = LibVEX_Alloc(sizeof(ARM64Instr));
+   i->tag                = ARM64in_VFMA;
+   i->ARM64in.VFMA.isD   = isD;
+   i->ARM64in.VFMA.isSub = isSub;
+   i->ARM64in.VFMA.dst   = dst;
+   i->ARM64in.VFMA.argN  = argN;
+   i->ARM64in.VFMA.argM  = argM;
+   i->ARM64in.VFMA.argA  = argA;
+   return i;
+}
 ARM64Instr* ARM64Instr_VCmpD ( HReg argL, HReg argR ) {
    ARM64Instr* i = LibVEX_Alloc(sizeof(ARM64Instr));
    i->tag                = ARM64in_VCmpD;
@@ -1649,6 +1661,19 @@ void ppARM64Instr ( ARM64Instr* i ) {
          vex_printf(", ");
          ppHRegARM64asSreg(i->ARM64in.VBinS.argR);
          return;
+      case ARM64in_VFMA: {
+         void (*pp)(HReg) = i->ARM64in.VFMA.isD ? ppHRegARM64
+                                                : ppHRegARM64asSreg;
+         vex_printf("%s ", i->ARM64in.VFMA.isSub ? "fnmsub" : "fmadd ");
+         pp(i->ARM64in.VFMA.dst);
+         vex_printf(", ");
+         pp(i->ARM64in.VFMA.argN);
+         vex_printf(", ");
+         pp(i->ARM64in.VFMA.argM);
+         vex_printf(", ");
+         pp(i->ARM64in.VFMA.argA);
+         return;
+      }
       case ARM64in_VCmpD:
          vex_printf("fcmp   ");
          ppHRegARM64(i->ARM64in.VCmpD.argL);
@@ -2047,6 +2072,12 @@ void getRegUsage_ARM64Instr ( HRegUsage* u, ARM64Instr* i, Bool mode64 )
          addHRegUse(u, HRmRead, i->ARM64in.VBinS.argL);
          addHRegUse(u, HRmRead, i->ARM64in.VBinS.argR);
          return;
+      case ARM64in_VFMA:
+         addHRegUse(u, HRmWrite, i->ARM64in.VFMA.dst);
+         addHRegUse(u, HRmRead, i->ARM64in.VFMA.argN);
+         addHRegUse(u, HRmRead, i->ARM64in.VFMA.argM);
+         addHRegUse(u, HRmRead, i->ARM64in.VFMA.argA);
+         return;
       case ARM64in_VCmpD:
          addHRegUse(u, HRmRead, i->ARM64in.VCmpD.argL);
          addHRegUse(u, HRmRead, i->ARM64in.VCmpD.argR);
@@ -2280,6 +2311,12 @@ void mapRegs_ARM64Instr ( HRegRemap* m, ARM64Instr* i, Bool mode64 )
          i->ARM64in.VBinS.argL = lookupHRegRemap(m, i->ARM64in.VBinS.argL);
          i->ARM64in.VBinS.argR = lookupHRegRemap(m, i->ARM64in.VBinS.argR);
          return;
+      case ARM64in_VFMA:
+         i->ARM64in.VFMA.dst  = lookupHRegRemap(m, i->ARM64in.VFMA.dst);
+         i->ARM64in.VFMA.argN = lookupHRegRemap(m, i->ARM64in.VFMA.argN);
+         i->ARM64in.VFMA.argM = lookupHRegRemap(m, i->ARM64in.VFMA.argM);
+         i->ARM64in.VFMA.argA = lookupHRegRemap(m, i->ARM64in.VFMA.argA);
+         return;
       case ARM64in_VCmpD:
          i->ARM64in.VCmpD.argL = lookupHRegRemap(m, i->ARM64in.VCmpD.argL);
          i->ARM64in.VCmpD.argR = lookupHRegRemap(m, i->ARM64in.VCmpD.argR);
@@ -2642,6 +2679,7 @@ static inline UChar qregNo ( HReg r )
 #define X11011110  BITS8(1,1,0,1,1,1,1,0)
 #define X11110001  BITS8(1,1,1,1,0,0,0,1)
 #define X11110011  BITS8(1,1,1,1,0,0,1,1)
+#define X11111000  BITS8(1,1,1,1,1,0,0,0)
 
 
 /* --- 4 fields --- */
@@ -3981,6 +4019,22 @@ Int emit_ARM64Instr ( /*MB_MOD*/Bool* is_profInc,
             = X_3_8_5_6_5_5(X000, X11110001, sM, (b1512 << 2) | X10, sN, sD);
          goto done;
       }
+      case ARM64in_VFMA: {
+         /* 31        23 21 20 15 14 9 4
+            000 11111 0 ty 0 m  0  a  n d   FMADD  Fd,Fn,Fm,Fa
+            000 11111 0 ty 1 m  1  a  n d   FNMSUB Fd,Fn,Fm,Fa
+            where ty is 01 for D regs and 00 for S regs
+         */
+         UInt fD = dregNo(i->ARM64in.VFMA.dst);
+         UInt fN = dregNo(i->ARM64in.VFMA.argN);
+         UInt fM = dregNo(i->ARM64in.VFMA.argM);
+         UInt fA = dregNo(i->ARM64in.VFMA.argA);
+         UInt ty = i->ARM64in.VFMA.isD ? 1 : 0;
+         UInt o  = i->ARM64in.VFMA.isSub ? 1 : 0;
+         *p++ = X_3_8_5_6_5_5(X000, X11111000 | (ty << 1) | o,
+                              fM, (o << 5) | fA, fN, fD);
+         goto done;
+      }
       case ARM64in_VCmpD: {
          /* 000 11110 01 1 m 00 1000 n 00 000  FCMP Dn, Dm */
          UInt dN = dregNo(i->ARM64in.VCmpD.argL);
@@ -5233,21 +5287,58 @@ VexInvalRange chainXDirect_ARM64 ( VexEndness endness_host,
               p, /*x*/9, Ptr_to_ULong(disp_cp_chain_me_EXPECTED)));
    vassert(p[4] == 0xD63F0120);
 
-   /* And what we want to change it to is:
-        movw x9, place_to_jump_to[15:0]
-        movk x9, place_to_jump_to[31:15], lsl 16
-        movk x9, place_to_jump_to[47:32], lsl 32
-        movk x9, place_to_jump_to[63:48], lsl 48
-        br   x9
-      viz
-        <16 bytes generated by imm64_to_iregNo_EXACTLY4>
-        D6 1F 01 20
-
-      The replacement has the same length as the original.
+   /* And what we want to change it to is either:
+        (general case):
+          movw x9, place_to_jump_to[15:0]
+          movk x9, place_to_jump_to[31:15], lsl 16
+          movk x9, place_to_jump_to[47:32], lsl 32
+          movk x9, place_to_jump_to[63:48], lsl 48
+          br   x9
+        viz
+          <16 bytes generated by imm64_to_iregNo_EXACTLY4>
+          D6 1F 01 20
+      ---OR---
+        in the case where the displacement fits in a B insn
+          b    place_to_jump_to
+          brk  #0; brk #0; brk #0; brk #0
+        viz
+          <0x14000000 | imm26>
+          D4 20 00 00  (x 4)
+
+      In both cases the replacement has the same length as the original.
+      As on amd64, to remain sane & verifiable,
+      (1) limit the displacement for the short form to +/- 64MB, half
+          of what B can reach, so as to avoid wraparound off-by-ones
+      (2) even if the short form is applicable, once every 1024 times
+          use the long form anyway, so as to maintain verifiability
    */
-   (void)imm64_to_iregNo_EXACTLY4(
-            p, /*x*/9, Ptr_to_ULong(place_to_jump_to));
-   p[4] = 0xD61F0120;
+   Long delta   = (Long)((UChar*)place_to_jump_to - (UChar*)p);
+   Bool shortOK = delta >= -(64LL << 20) && delta < (64LL << 20);
+   vassert(0 == (delta & 3));
+
+   static UInt shortCTR = 0; /* DO NOT MAKE NON-STATIC */
+   if (shortOK) {
+      shortCTR++; // thread safety bleh
+      if (0 == (shortCTR & 0x3FF)) {
+         shortOK = False;
+         if (0)
+            vex_printf("QQQ chainXDirect_ARM64: shortCTR = %u, "
+                       "using long form\n", shortCTR);
+      }
+   }
+
+   /* And make the modifications. */
+   if (shortOK) {
+      p[0] = 0x14000000 | (UInt)((delta >> 2) & 0x3FFFFFF);
+      p[1] = 0xD4200000;
+      p[2] = 0xD4200000;
+      p[3] = 0xD4200000;
+      p[4] = 0xD4200000;
+   } else {
+      (void)imm64_to_iregNo_EXACTLY4(
+               p, /*x*/9, Ptr_to_ULong(place_to_jump_to));
+      p[4] = 0xD61F0120;
+   }
 
    VexInvalRange vir = {(HWord)p, 20};
    return vir;
@@ -5263,21 +5354,46 @@ VexInvalRange unchainXDirect_ARM64 ( VexEndness endness_host,
 {
    vassert(endness_host == VexEndnessLE);
 
-   /* What we're expecting to see is:
-        movw x9, place_to_jump_to_EXPECTED[15:0]
-        movk x9, place_to_jump_to_EXPECTED[31:15], lsl 16
-        movk x9, place_to_jump_to_EXPECTED[47:32], lsl 32
-        movk x9, place_to_jump_to_EXPECTED[63:48], lsl 48
-        br   x9
-      viz
-        <16 bytes generated by imm64_to_iregNo_EXACTLY4>
-        D6 1F 01 20
+   /* What we're expecting to see is either:
+        (general case)
+          movw x9, place_to_jump_to_EXPECTED[15:0]
+          movk x9, place_to_jump_to_EXPECTED[31:15], lsl 16
+          movk x9, place_to_jump_to_EXPECTED[47:32], lsl 32
+          movk x9, place_to_jump_to_EXPECTED[63:48], lsl 48
+          br   x9
+        viz
+          <16 bytes generated by imm64_to_iregNo_EXACTLY4>
+          D6 1F 01 20
+      ---OR---
+        in the case where the displacement fits in a B insn
+          b    place_to_jump_to_EXPECTED
+          brk  #0; brk #0; brk #0; brk #0
+        viz
+          <0x14000000 | imm26>
+          D4 20 00 00  (x 4)
    */
-   UInt* p = (UInt*)place_to_unchain;
+   UInt* p     = (UInt*)place_to_unchain;
+   Bool  valid = False;
    vassert(0 == (3 & (HWord)p));
-   vassert(is_imm64_to_iregNo_EXACTLY4(
-              p, /*x*/9, Ptr_to_ULong(place_to_jump_to_EXPECTED)));
-   vassert(p[4] == 0xD61F0120);
+   if (is_imm64_to_iregNo_EXACTLY4(
+          p, /*x*/9, Ptr_to_ULong(place_to_jump_to_EXPECTED))
+       && p[4] == 0xD61F0120) {
+      /* it's the long form */
+      valid = True;
+   }
+   else
+   if ((p[0] & 0xFC000000) == 0x14000000
+       && p[1] == 0xD4200000 && p[2] == 0xD4200000
+       && p[3] == 0xD4200000 && p[4] == 0xD4200000) {
+      /* It's the short form.  Check the offset is right. */
+      Long delta = ((Long)(Int)(p[0] << 6)) >> 4;
+      if ((UChar*)p + delta == (UChar*)place_to_jump_to_EXPECTED) {
+         valid = True;
+         if (0)
+            vex_printf("QQQ unchainXDirect_ARM64: found short form\n");
+      }
+   }
+   vassert(valid);
 
    /* And what we want to change it to is:
         movw x9, disp_cp_chain_me_to[15:0]
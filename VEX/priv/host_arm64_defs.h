@@ -491,6 +491,7 @@ typedef
       ARM64in_VUnaryS,
       ARM64in_VBinD,
       ARM64in_VBinS,
+      ARM64in_VFMA,
       ARM64in_VCmpD,
       ARM64in_VCmpS,
       ARM64in_VFCSel,
@@ -736,6 +737,16 @@ typedef
             HReg         argL;
             HReg         argR;
          } VBinS;
+         /* 64- or 32-bit FP fused multiply-add: dst = argN * argM
+            + argA (FMADD), or argN * argM - argA (FNMSUB) */
+         struct {
+            Bool isD;
+            Bool isSub;
+            HReg dst;
+            HReg argN;
+            HReg argM;
+            HReg argA;
+         } VFMA;
          /* 64-bit FP compare */
          struct {
             HReg argL;
@@ -899,6 +910,8 @@ extern ARM64Instr* ARM64Instr_VUnaryD ( ARM64FpUnaryOp op, HReg dst, HReg src );
 extern ARM64Instr* ARM64Instr_VUnaryS ( ARM64FpUnaryOp op, HReg dst, HReg src );
 extern ARM64Instr* ARM64Instr_VBinD   ( ARM64FpBinOp op, HReg, HReg, HReg );
 extern ARM64Instr* ARM64Instr_VBinS   ( ARM64FpBinOp op, HReg, HReg, HReg );
+extern ARM64Instr* ARM64Instr_VFMA    ( Bool isD, Bool isSub, HReg dst,
+                                        HReg argN, HReg argM, HReg argA );
 extern ARM64Instr* ARM64Instr_VCmpD   ( HReg argL, HReg argR );
 extern ARM64Instr* ARM64Instr_VCmpS   ( HReg argL, HReg argR );
 extern ARM64Instr* ARM64Instr_VFCSel  ( HReg dst, HReg argL, HReg argR,
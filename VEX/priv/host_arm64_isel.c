@@ -3083,6 +3083,20 @@ static HReg iselDblExpr_wrk ( ISelEnv* env, IRExpr* e )
       }
    }
 
+   if (e->tag == Iex_Qop && (e->Iex.Qop.details->op == Iop_MAddF64
+                             || e->Iex.Qop.details->op == Iop_MSubF64)) {
+      /* arg2 * arg3 +/- arg4, as a single fused instruction */
+      IRQop* qop   = e->Iex.Qop.details;
+      Bool   isSub = qop->op == Iop_MSubF64;
+      HReg   argN  = iselDblExpr(env, qop->arg2);
+      HReg   argM  = iselDblExpr(env, qop->arg3);
+      HReg   argA  = iselDblExpr(env, qop->arg4);
+      HReg   dst   = newVRegD(env);
+      set_FPCR_rounding_mode(env, qop->arg1);
+      addInstr(env, ARM64Instr_VFMA(True, isSub, dst, argN, argM, argA));
+      return dst;
+   }
+
    if (e->tag == Iex_ITE) {
       /* ITE(ccexpr, iftrue, iffalse) */
       ARM64CondCode cc;
@@ -3259,6 +3273,20 @@ static HReg iselFltExpr_wrk ( ISelEnv* env, IRExpr* e )
       }
    }
 
+   if (e->tag == Iex_Qop && (e->Iex.Qop.details->op == Iop_MAddF32
+                             || e->Iex.Qop.details->op == Iop_MSubF32)) {
+      /* arg2 * arg3 +/- arg4, as a single fused instruction */
+      IRQop* qop   = e->Iex.Qop.details;
+      Bool   isSub = qop->op == Iop_MSubF32;
+      HReg   argN  = iselFltExpr(env, qop->arg2);
+      HReg   argM  = iselFltExpr(env, qop->arg3);
+      HReg   argA  = iselFltExpr(env, qop->arg4);
+      HReg   dst   = newVRegD(env);
+      set_FPCR_rounding_mode(env, qop->arg1);
+      addInstr(env, ARM64Instr_VFMA(False, isSub, dst, argN, argM, argA));
+      return dst;
+   }
+
    if (e->tag == Iex_ITE) {
       /* ITE(ccexpr, iftrue, iffalse) */
       ARM64CondCode cc;
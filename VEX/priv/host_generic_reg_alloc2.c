@@ -37,6 +37,7 @@
 #include "libvex.h"
 
 #include "main_util.h"
+#include "main_globals.h"
 #include "host_generic_regs.h"
 
 /* Set to 1 for lots of debugging output. */
@@ -304,7 +305,7 @@ static void sortRRLRarray ( RRegLR* arr,
    Takes an expandable array of pointers to unallocated insns.
    Returns an expandable array of pointers to allocated insns.
 */
-HInstrArray* doRegisterAllocation (
+HInstrArray* doRegisterAllocation_v2 (
 
    /* Incoming virtual-registerised code. */ 
    HInstrArray* instrs_in,
@@ -1072,6 +1073,7 @@ HInstrArray* doRegisterAllocation (
          /* This rreg has become associated with a different vreg and
             hence with a different spill slot.  Play safe. */
          rreg_state[m].eq_spill_slot = False;
+         vex_regalloc_stats.n_moves_removed++;
 
          /* Move on to the next insn.  We skip the post-insn stuff for
             fixed registers, since this move should not interact with
@@ -1166,6 +1168,7 @@ HInstrArray* doRegisterAllocation (
                      EMIT_INSTR(spill1);
                   if (spill2)
                      EMIT_INSTR(spill2);
+                  vex_regalloc_stats.n_spills++;
                }
                rreg_state[k].eq_spill_slot = True;
             }
@@ -1347,6 +1350,7 @@ HInstrArray* doRegisterAllocation (
                   EMIT_INSTR(reload1);
                if (reload2)
                   EMIT_INSTR(reload2);
+               vex_regalloc_stats.n_reloads++;
                /* This rreg is read or modified by the instruction.
                   If it's merely read we can claim it now equals the
                   spill slot, but not so if it is modified. */
@@ -1430,6 +1434,7 @@ HInstrArray* doRegisterAllocation (
                EMIT_INSTR(spill1);
             if (spill2)
                EMIT_INSTR(spill2);
+            vex_regalloc_stats.n_spills++;
          }
 
          /* Update the rreg_state to reflect the new assignment for this
@@ -1456,6 +1461,7 @@ HInstrArray* doRegisterAllocation (
                EMIT_INSTR(reload1);
             if (reload2)
                EMIT_INSTR(reload2);
+            vex_regalloc_stats.n_reloads++;
             /* This rreg is read or modified by the instruction.
                If it's merely read we can claim it now equals the
                spill slot, but not so if it is modified. */
@@ -1544,6 +1550,8 @@ HInstrArray* doRegisterAllocation (
    vassert(rreg_lrs_la_next == rreg_lrs_used);
    vassert(rreg_lrs_db_next == rreg_lrs_used);
 
+   vex_regalloc_stats.n_insns += instrs_in->arr_used;
+
    return instrs_out;
 
 #  undef INVALID_INSTRNO
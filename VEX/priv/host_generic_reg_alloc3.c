@@ -0,0 +1,900 @@
+/*---------------------------------------------------------------*/
+/*--- begin                                 host_reg_alloc3.c ---*/
+/*---------------------------------------------------------------*/
+
+/*
+   This file is part of Valgrind, a dynamic binary instrumentation
+   framework.
+
+   Copyright (C) 2015-2015 The Valgrind developers
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of the
+   License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+   02110-1301, USA.
+
+   The GNU General Public License is contained in the file COPYING.
+*/
+
+#include "libvex_basictypes.h"
+#include "libvex.h"
+
+#include "main_util.h"
+#include "main_globals.h"
+#include "host_generic_regs.h"
+
+/* Set to 1 for lots of debugging output. */
+#define DEBUG_REGALLOC 0
+
+
+/* A linear-scan register allocator, selected with
+   VexControl.regalloc_version == 3.  It takes the same arguments and
+   produces the same kind of code as the allocator in
+   host_generic_reg_alloc2.c, and shares its overall structure: one
+   pass to compute live ranges, then one pass over the instructions
+   binding vregs to rregs, spilling and reloading as it goes.  A vreg's
+   live range is thereby split at each spill and reload, and can live
+   in a different rreg in each piece.  The differences are in how the
+   choices are made:
+
+   * Each vreg has a list of the instructions that mention it, so the
+     "most distant next use" spill heuristic costs a list step per
+     candidate, instead of a scan over the rest of the block.
+
+   * Each rreg has a list of its hard live ranges (HLRs), so when
+     looking for a free rreg for a vreg, we know how long each free
+     rreg stays free, and take the one which stays free longest.  That
+     keeps vregs which live across helper calls out of the registers
+     the calls trash, where they would have to be spilled.
+
+   * A vreg whose last use is a move into an rreg (typically a helper
+     call argument) is hinted to that rreg, and the move is dropped if
+     the hint is taken.  Likewise a vreg defined by a move out of an
+     rreg at the end of its HLR (typically a helper call result) takes
+     over that rreg, if it is not needed again while the vreg lives.
+     Vreg-vreg moves are coalesced as in the other allocator.
+*/
+
+
+/* Records information on virtual register live ranges.  Computed once
+   and remains unchanged after that, apart from .next_use. */
+typedef
+   struct {
+      /* Becomes live for the first time after this insn ... */
+      Short live_after;
+      /* Becomes dead for the last time before this insn ... */
+      Short dead_before;
+      /* The "home" spill slot, if needed.  Never changes. */
+      Short spill_offset;
+      /* What kind of register this is. */
+      HRegClass reg_class;
+      /* The rreg_state index of the rreg this vreg would like to be
+         in, or INVALID_RREG_NO, and the insn (a move into that rreg)
+         which makes it want that. */
+      Short hint;
+      Short hint_insn;
+      /* Index into uses[] of the first use of this vreg which has not
+         been passed yet, or -1. */
+      Int next_use;
+      /* Index into uses[] of the last use, while building the list. */
+      Int last_use;
+   }
+   VRegLR;
+
+
+/* One mention of a vreg by an instruction.  The mentions of each
+   vreg are chained in instruction order. */
+typedef
+   struct {
+      Short ii;
+      Int   next;
+   }
+   VRegUse;
+
+
+/* Records information on real-register live ranges.  The HLRs of
+   each rreg are chained in instruction order. */
+typedef
+   struct {
+      /* Becomes live after this insn ... */
+      Short live_after;
+      /* Becomes dead before this insn ... */
+      Short dead_before;
+      /* Index of the next HLR of the same rreg, or -1. */
+      Int next;
+   }
+   RRegLR;
+
+
+/* The running state of the allocator, for each allocatable rreg. */
+typedef
+   struct {
+      /* ------ FIELDS WHICH DO NOT CHANGE ------ */
+      /* Which rreg is this for? */
+      HReg rreg;
+      /* ------ FIELDS WHICH DO CHANGE ------ */
+      /* The current HLR, if .disp == Unavail, otherwise the next one,
+         as an index into rreg_lrs[], or -1 if there are no more. */
+      Int hlr;
+      /* Index of the last HLR, while building the list. */
+      Int last_hlr;
+      /* Indicates when the rreg has the same value as the spill slot
+         for the associated vreg.  As in the other allocator. */
+      Bool eq_spill_slot;
+      /* What's it's current disposition? */
+      enum { Free,     /* available for use */
+             Unavail,  /* in a real-reg live range */
+             Bound     /* in use (holding value of some vreg) */
+           }
+           disp;
+      /* If .disp == Bound, what vreg is it bound to? */
+      HReg vreg;
+   }
+   RRegState;
+
+
+#define INVALID_RREG_NO ((Short)(-1))
+
+#define IS_VALID_VREGNO(_zz) ((_zz) >= 0 && (_zz) < n_vregs)
+#define IS_VALID_RREGNO(_zz) ((_zz) >= 0 && (_zz) < n_rregs)
+
+/* Larger than any instruction number. */
+#define INFINITE_INSTRNO 0x7FFF
+
+
+/* Double the size of an array of elements of elem_size bytes each,
+   if it is full. */
+static void* ensureSpace ( void* arr, Int* size, Int used, Int elem_size )
+{
+   Int    i;
+   HChar* arr2;
+   if (used < *size) return arr;
+   vassert(used == *size);
+   arr2 = LibVEX_Alloc(2 * *size * elem_size);
+   for (i = 0; i < *size * elem_size; i++)
+      arr2[i] = ((HChar*)arr)[i];
+   *size *= 2;
+   return arr2;
+}
+
+
+/* Check that this vreg has been assigned a sane spill offset. */
+static inline void sanity_check_spill_offset ( VRegLR* vreg )
+{
+   switch (vreg->reg_class) {
+      case HRcVec128: case HRcFlt64:
+         vassert(0 == ((UShort)vreg->spill_offset % 16)); break;
+      default:
+         vassert(0 == ((UShort)vreg->spill_offset % 8)); break;
+   }
+}
+
+
+/* The linear-scan register allocator.  See doRegisterAllocation_v2
+   for the meaning of the arguments. */
+HInstrArray* doRegisterAllocation_v3 (
+   HInstrArray* instrs_in,
+   HReg* available_real_regs,
+   Int   n_available_real_regs,
+   Bool (*isMove) ( HInstr*, HReg*, HReg* ),
+   void (*getRegUsage) ( HRegUsage*, HInstr*, Bool ),
+   void (*mapRegs) ( HRegRemap*, HInstr*, Bool ),
+   void    (*genSpill)  ( HInstr**, HInstr**, HReg, Int, Bool ),
+   void    (*genReload) ( HInstr**, HInstr**, HReg, Int, Bool ),
+   HInstr* (*directReload) ( HInstr*, HReg, Short ),
+   Int     guest_sizeB,
+   void (*ppInstr) ( HInstr*, Bool ),
+   void (*ppReg) ( HReg ),
+   Bool mode64
+)
+{
+#  define N_SPILL64S  (LibVEX_N_SPILL_BYTES / 8)
+
+   /* Iterators and temporaries. */
+   Int       ii, j, k, m;
+   HReg      rreg, vreg, vregS, vregD;
+   HRegUsage reg_usage;
+
+   /* Info on vregs. */
+   Int      n_vregs;
+   VRegLR*  vreg_lrs;   /* [0 .. n_vregs-1] */
+   VRegUse* uses;
+   Int      uses_size, uses_used;
+
+   /* Info on rregs. */
+   RRegLR* rreg_lrs;
+   Int     rreg_lrs_size, rreg_lrs_used;
+
+   /* Used when constructing rreg_lrs. */
+   Int* rreg_live_after;
+   Int* rreg_dead_before;
+
+   /* Used when allocating stack slots. */
+   Int ss_busy_until_before[N_SPILL64S];
+
+   /* Running state of the core allocation algorithm. */
+   RRegState* rreg_state;  /* [0 .. n_rregs-1] */
+   Int        n_rregs;
+   Short*     vreg_state;  /* [0 .. n_vregs-1] */
+
+   /* The vreg -> rreg map constructed and then applied to each
+      instr. */
+   HRegRemap remap;
+
+   /* The output array of instructions. */
+   HInstrArray* instrs_out;
+
+   vassert(0 == (guest_sizeB % 16));
+   vassert(0 == (LibVEX_N_SPILL_BYTES % 16));
+   vassert(0 == (N_SPILL64S % 2));
+
+   /* As in the other allocator. */
+   vassert(instrs_in->arr_used <= 15000);
+
+#  define INVALID_INSTRNO (-2)
+
+#  define EMIT_INSTR(_instr)                  \
+      do {                                    \
+        HInstr* _tmp = (_instr);              \
+        if (DEBUG_REGALLOC) {                 \
+           vex_printf("**  ");                \
+           (*ppInstr)(_tmp, mode64);          \
+           vex_printf("\n\n");                \
+        }                                     \
+        addHInstr ( instrs_out, _tmp );       \
+      } while (0)
+
+   /* The first instruction at or after _ii at which rreg_state[_k]
+      becomes busy. */
+#  define FREE_UNTIL(_k)                                  \
+      (rreg_state[_k].hlr == -1                           \
+          ? INFINITE_INSTRNO                              \
+          : rreg_lrs[rreg_state[_k].hlr].live_after)
+
+   /* --------- Stage 0: set up output array --------- */
+   /* --------- and allocate/initialise running state. --------- */
+
+   instrs_out = newHInstrArray();
+
+   n_rregs = n_available_real_regs;
+   n_vregs = instrs_in->n_vregs;
+
+   /* If this is not so, vreg_state entries will overflow. */
+   vassert(n_vregs < 32767);
+   vassert(n_rregs > 0);
+
+   rreg_state = LibVEX_Alloc(n_rregs * sizeof(RRegState));
+   vreg_state = LibVEX_Alloc(n_vregs * sizeof(Short));
+
+   for (j = 0; j < n_rregs; j++) {
+      rreg_state[j].rreg          = available_real_regs[j];
+      rreg_state[j].hlr           = -1;
+      rreg_state[j].last_hlr      = -1;
+      rreg_state[j].disp          = Free;
+      rreg_state[j].vreg          = INVALID_HREG;
+      rreg_state[j].eq_spill_slot = False;
+   }
+
+   for (j = 0; j < n_vregs; j++)
+      vreg_state[j] = INVALID_RREG_NO;
+
+   vreg_lrs = NULL;
+   if (n_vregs > 0)
+      vreg_lrs = LibVEX_Alloc(sizeof(VRegLR) * n_vregs);
+
+   for (j = 0; j < n_vregs; j++) {
+      vreg_lrs[j].live_after   = INVALID_INSTRNO;
+      vreg_lrs[j].dead_before  = INVALID_INSTRNO;
+      vreg_lrs[j].spill_offset = 0;
+      vreg_lrs[j].reg_class    = HRcINVALID;
+      vreg_lrs[j].hint         = INVALID_RREG_NO;
+      vreg_lrs[j].hint_insn    = INVALID_INSTRNO;
+      vreg_lrs[j].next_use     = -1;
+      vreg_lrs[j].last_use     = -1;
+   }
+
+   uses_used = 0;
+   uses_size = 2 * instrs_in->arr_used + 4;
+   uses      = LibVEX_Alloc(uses_size * sizeof(VRegUse));
+
+   rreg_lrs_used = 0;
+   rreg_lrs_size = 4;
+   rreg_lrs      = LibVEX_Alloc(rreg_lrs_size * sizeof(RRegLR));
+
+   rreg_live_after  = LibVEX_Alloc(n_rregs * sizeof(Int));
+   rreg_dead_before = LibVEX_Alloc(n_rregs * sizeof(Int));
+   for (j = 0; j < n_rregs; j++)
+      rreg_live_after[j] = rreg_dead_before[j] = INVALID_INSTRNO;
+
+#  define ADD_RREG_LR(_k, _la, _db)                                   \
+      do {                                                            \
+         rreg_lrs = ensureSpace(rreg_lrs, &rreg_lrs_size,             \
+                                rreg_lrs_used, sizeof(RRegLR));       \
+         rreg_lrs[rreg_lrs_used].live_after  = toShort(_la);          \
+         rreg_lrs[rreg_lrs_used].dead_before = toShort(_db);          \
+         rreg_lrs[rreg_lrs_used].next        = -1;                    \
+         if (rreg_state[_k].last_hlr == -1)                           \
+            rreg_state[_k].hlr = rreg_lrs_used;                       \
+         else                                                         \
+            rreg_lrs[rreg_state[_k].last_hlr].next = rreg_lrs_used;   \
+         rreg_state[_k].last_hlr = rreg_lrs_used;                     \
+         rreg_lrs_used++;                                             \
+      } while (0)
+
+   /* --------- Stage 1: compute vreg live ranges and uses. --------- */
+   /* --------- Stage 2: compute rreg live ranges. --------- */
+
+   for (ii = 0; ii < instrs_in->arr_used; ii++) {
+
+      (*getRegUsage)( &reg_usage, instrs_in->arr[ii], mode64 );
+
+      for (j = 0; j < reg_usage.n_used; j++) {
+
+         vreg = reg_usage.hreg[j];
+
+         if (hregIsVirtual(vreg)) {
+            k = hregNumber(vreg);
+            if (k < 0 || k >= n_vregs) {
+               vex_printf("\n");
+               (*ppInstr)(instrs_in->arr[ii], mode64);
+               vex_printf("\n");
+               vex_printf("vreg %d, n_vregs %d\n", k, n_vregs);
+               vpanic("doRegisterAllocation_v3: out-of-range vreg");
+            }
+
+            if (vreg_lrs[k].reg_class == HRcINVALID)
+               vreg_lrs[k].reg_class = hregClass(vreg);
+            else
+               vassert(vreg_lrs[k].reg_class == hregClass(vreg));
+
+            switch (reg_usage.mode[j]) {
+               case HRmRead:
+               case HRmModify:
+                  if (vreg_lrs[k].live_after == INVALID_INSTRNO) {
+                     vex_printf("\n\nOFFENDING VREG = %d\n", k);
+                     vpanic("doRegisterAllocation_v3: "
+                            "first event for vreg is Read or Modify");
+                  }
+                  break;
+               case HRmWrite:
+                  if (vreg_lrs[k].live_after == INVALID_INSTRNO)
+                     vreg_lrs[k].live_after = toShort(ii);
+                  break;
+               default:
+                  vpanic("doRegisterAllocation_v3(1)");
+            }
+            vreg_lrs[k].dead_before = toShort(ii + 1);
+
+            /* Note the use. */
+            uses = ensureSpace(uses, &uses_size, uses_used, sizeof(VRegUse));
+            uses[uses_used].ii   = toShort(ii);
+            uses[uses_used].next = -1;
+            if (vreg_lrs[k].last_use == -1)
+               vreg_lrs[k].next_use = uses_used;
+            else
+               uses[vreg_lrs[k].last_use].next = uses_used;
+            vreg_lrs[k].last_use = uses_used;
+            uses_used++;
+            continue;
+         }
+
+         /* A real register.  Only the allocatable ones matter. */
+         rreg = vreg;
+         for (k = 0; k < n_rregs; k++)
+            if (sameHReg(available_real_regs[k], rreg))
+               break;
+         if (k == n_rregs)
+            continue;
+
+         switch (reg_usage.mode[j]) {
+            case HRmWrite:
+               if (rreg_live_after[k] != INVALID_INSTRNO)
+                  ADD_RREG_LR(k, rreg_live_after[k], rreg_dead_before[k]);
+               rreg_live_after[k]  = ii;
+               rreg_dead_before[k] = ii+1;
+               break;
+            case HRmRead:
+            case HRmModify:
+               if (rreg_live_after[k] == INVALID_INSTRNO) {
+                  vex_printf("\nOFFENDING RREG = ");
+                  (*ppReg)(available_real_regs[k]);
+                  vex_printf("\n");
+                  vex_printf("\nOFFENDING instr = ");
+                  (*ppInstr)(instrs_in->arr[ii], mode64);
+                  vex_printf("\n");
+                  vpanic("doRegisterAllocation_v3: "
+                         "first event for rreg is Read or Modify");
+               }
+               rreg_dead_before[k] = ii+1;
+               break;
+            default:
+               vpanic("doRegisterAllocation_v3(2)");
+         }
+      }
+
+      /* A move between a vreg and an rreg gives the vreg a hint. */
+      if ((*isMove)( instrs_in->arr[ii], &vregS, &vregD )
+          && hregIsVirtual(vregS) && !hregIsVirtual(vregD)) {
+         for (k = 0; k < n_rregs; k++)
+            if (sameHReg(available_real_regs[k], vregD))
+               break;
+         if (k < n_rregs) {
+            m = hregNumber(vregS);
+            vreg_lrs[m].hint      = toShort(k);
+            vreg_lrs[m].hint_insn = toShort(ii);
+         }
+      }
+   }
+
+   /* Finish up any rreg live ranges left over. */
+   for (k = 0; k < n_rregs; k++) {
+      if (rreg_live_after[k] != INVALID_INSTRNO)
+         ADD_RREG_LR(k, rreg_live_after[k], rreg_dead_before[k]);
+   }
+
+#  if DEBUG_REGALLOC
+   for (j = 0; j < n_vregs; j++) {
+      vex_printf("vreg %d:  la = %d,  db = %d,  hint = %d\n",
+                 j, vreg_lrs[j].live_after, vreg_lrs[j].dead_before,
+                 vreg_lrs[j].hint);
+   }
+   for (k = 0; k < n_rregs; k++) {
+      (*ppReg)(rreg_state[k].rreg);
+      for (j = rreg_state[k].hlr; j != -1; j = rreg_lrs[j].next)
+         vex_printf("  [%d,%d)", rreg_lrs[j].live_after,
+                    rreg_lrs[j].dead_before);
+      vex_printf("\n");
+   }
+#  endif
+
+   /* --------- Stage 3: allocate spill slots. --------- */
+
+   /* Exactly as in the other allocator; see the comments there. */
+
+   for (j = 0; j < N_SPILL64S; j++)
+      ss_busy_until_before[j] = 0;
+
+   for (j = 0; j < n_vregs; j++) {
+
+      if (vreg_lrs[j].live_after == INVALID_INSTRNO) {
+         vassert(vreg_lrs[j].reg_class == HRcINVALID);
+         continue;
+      }
+
+      switch (vreg_lrs[j].reg_class) {
+
+         case HRcVec128: case HRcFlt64:
+            for (k = 0; k < N_SPILL64S-1; k += 2)
+               if (ss_busy_until_before[k+0] <= vreg_lrs[j].live_after
+                   && ss_busy_until_before[k+1] <= vreg_lrs[j].live_after)
+                  break;
+            if (k >= N_SPILL64S-1) {
+               vpanic("LibVEX_N_SPILL_BYTES is too low.  "
+                      "Increase and recompile.");
+            }
+            ss_busy_until_before[k+0] = vreg_lrs[j].dead_before;
+            ss_busy_until_before[k+1] = vreg_lrs[j].dead_before;
+            break;
+
+         default:
+            for (k = 0; k < N_SPILL64S; k++)
+               if (ss_busy_until_before[k] <= vreg_lrs[j].live_after)
+                  break;
+            if (k == N_SPILL64S) {
+               vpanic("LibVEX_N_SPILL_BYTES is too low.  "
+                      "Increase and recompile.");
+            }
+            ss_busy_until_before[k] = vreg_lrs[j].dead_before;
+            break;
+      }
+
+      vreg_lrs[j].spill_offset = toShort(guest_sizeB * 3 + k * 8);
+      sanity_check_spill_offset( &vreg_lrs[j] );
+   }
+
+   /* --------- Stage 4: process instructions --------- */
+
+   for (ii = 0; ii < instrs_in->arr_used; ii++) {
+
+      /* Set when the insn turns out to be a move which the register
+         assignment makes redundant. */
+      Bool drop = False;
+      /* A vreg to bind to an rreg after this insn, if any. */
+      Int  bind_vregno = -1;
+      Int  bind_k = -1;
+
+#     if DEBUG_REGALLOC
+      vex_printf("\n====----====---- Insn %d ----====----====\n", ii);
+      vex_printf("---- ");
+      (*ppInstr)(instrs_in->arr[ii], mode64);
+      vex_printf("\n");
+#     endif
+
+      /* ------------ Sanity checks ------------ */
+
+      if (ii == instrs_in->arr_used-1 || (ii > 0 && (ii % 7) == 0)) {
+         for (k = 0; k < n_rregs; k++) {
+            Int h = rreg_state[k].hlr;
+            /* An rreg is Unavail exactly when ii is inside its
+               current HLR. */
+            vassert((rreg_state[k].disp == Unavail)
+                    == (h != -1 && rreg_lrs[h].live_after < ii
+                                && ii < rreg_lrs[h].dead_before));
+            if (rreg_state[k].disp != Bound) {
+               vassert(rreg_state[k].eq_spill_slot == False);
+               continue;
+            }
+            vassert(hregClass(rreg_state[k].rreg)
+                    == hregClass(rreg_state[k].vreg));
+            vassert( hregIsVirtual(rreg_state[k].vreg));
+            m = hregNumber(rreg_state[k].vreg);
+            vassert(IS_VALID_VREGNO(m));
+            vassert(vreg_state[m] == k);
+         }
+         for (j = 0; j < n_vregs; j++) {
+            k = vreg_state[j];
+            if (k == INVALID_RREG_NO)
+               continue;
+            vassert(IS_VALID_RREGNO(k));
+            vassert(rreg_state[k].disp == Bound);
+            vassert(hregNumber(rreg_state[k].vreg) == j);
+         }
+      }
+
+      /* ------------ Moves ------------ */
+
+      if ( (*isMove)( instrs_in->arr[ii], &vregS, &vregD ) ) {
+
+         if (hregIsVirtual(vregS) && hregIsVirtual(vregD)) {
+            /* vreg-vreg: if the src's live range ends here and the
+               dst's starts here, and the src is in a register, hand
+               that register over to the dst. */
+            vassert(hregClass(vregS) == hregClass(vregD));
+            k = hregNumber(vregS);
+            m = hregNumber(vregD);
+            vassert(IS_VALID_VREGNO(k));
+            vassert(IS_VALID_VREGNO(m));
+            if (vreg_lrs[k].dead_before == ii + 1
+                && vreg_lrs[m].live_after == ii
+                && vreg_state[k] != INVALID_RREG_NO) {
+               j = vreg_state[k];
+               rreg_state[j].vreg = vregD;
+               rreg_state[j].eq_spill_slot = False;
+               vreg_state[m] = toShort(j);
+               vreg_state[k] = INVALID_RREG_NO;
+               drop = True;
+            }
+         }
+         else if (hregIsVirtual(vregS)) {
+            /* vreg-rreg: if the src is dying and is already in the
+               dst rreg, which the move starts an HLR for, there is
+               nothing to do.  Release the rreg so that the HLR
+               handling below does not spill the src. */
+            k = hregNumber(vregS);
+            vassert(IS_VALID_VREGNO(k));
+            j = vreg_state[k];
+            if (j != INVALID_RREG_NO
+                && sameHReg(rreg_state[j].rreg, vregD)
+                && vreg_lrs[k].dead_before == ii + 1) {
+               vassert(rreg_state[j].hlr != -1);
+               vassert(rreg_lrs[rreg_state[j].hlr].live_after == ii);
+               rreg_state[j].disp = Free;
+               rreg_state[j].vreg = INVALID_HREG;
+               rreg_state[j].eq_spill_slot = False;
+               vreg_state[k] = INVALID_RREG_NO;
+               drop = True;
+            }
+         }
+         else if (hregIsVirtual(vregD)) {
+            /* rreg-vreg: if the src's HLR ends here and the dst's
+               live range starts here, the dst can take over the src
+               rreg once the HLR is over -- provided the rreg is not
+               needed again before the dst dies. */
+            m = hregNumber(vregD);
+            vassert(IS_VALID_VREGNO(m));
+            for (j = 0; j < n_rregs; j++)
+               if (sameHReg(rreg_state[j].rreg, vregS))
+                  break;
+            if (j < n_rregs
+                && rreg_state[j].disp == Unavail
+                && rreg_lrs[rreg_state[j].hlr].dead_before == ii + 1
+                && vreg_lrs[m].live_after == ii) {
+               Int next = rreg_lrs[rreg_state[j].hlr].next;
+               if (next == -1
+                   || rreg_lrs[next].live_after >= vreg_lrs[m].dead_before) {
+                  bind_vregno = m;
+                  bind_k = j;
+                  drop = True;
+               }
+            }
+         }
+      }
+
+      /* ------ Free up rregs bound to dead vregs ------ */
+
+      for (k = 0; k < n_rregs; k++) {
+         if (rreg_state[k].disp != Bound)
+            continue;
+         m = hregNumber(rreg_state[k].vreg);
+         vassert(IS_VALID_VREGNO(m));
+         if (vreg_lrs[m].dead_before <= ii) {
+            rreg_state[k].disp = Free;
+            rreg_state[k].vreg = INVALID_HREG;
+            rreg_state[k].eq_spill_slot = False;
+            vreg_state[m] = INVALID_RREG_NO;
+         }
+      }
+
+      /* ------ Pre-instruction actions for fixed rreg uses ------ */
+
+      /* Rregs entering an HLR at this insn have to be freed up,
+         spilling any vreg they hold which is still live. */
+      for (k = 0; k < n_rregs; k++) {
+         Int h = rreg_state[k].hlr;
+         if (h == -1 || rreg_lrs[h].live_after != ii)
+            continue;
+         vassert(rreg_state[k].disp != Unavail);
+         if (rreg_state[k].disp == Bound) {
+            m = hregNumber(rreg_state[k].vreg);
+            vassert(IS_VALID_VREGNO(m));
+            vreg_state[m] = INVALID_RREG_NO;
+            if (vreg_lrs[m].dead_before > ii
+                && !rreg_state[k].eq_spill_slot) {
+               HInstr* spill1 = NULL;
+               HInstr* spill2 = NULL;
+               (*genSpill)( &spill1, &spill2, rreg_state[k].rreg,
+                            vreg_lrs[m].spill_offset, mode64 );
+               vassert(spill1 || spill2); /* can't both be NULL */
+               if (spill1)
+                  EMIT_INSTR(spill1);
+               if (spill2)
+                  EMIT_INSTR(spill2);
+               vex_regalloc_stats.n_spills++;
+            }
+         }
+         rreg_state[k].disp = Unavail;
+         rreg_state[k].vreg = INVALID_HREG;
+         rreg_state[k].eq_spill_slot = False;
+      }
+
+      if (drop) {
+         vex_regalloc_stats.n_moves_removed++;
+         goto post_insn;
+      }
+
+      /* ------ Deal with the current instruction. ------ */
+
+      (*getRegUsage)( &reg_usage, instrs_in->arr[ii], mode64 );
+
+      initHRegRemap(&remap);
+
+      /* The directReload optimisation, as in the other allocator. */
+      if (directReload && reg_usage.n_used <= 2) {
+         HReg  cand     = INVALID_HREG;
+         Int   nreads   = 0;
+         Short spilloff = 0;
+
+         for (j = 0; j < reg_usage.n_used; j++) {
+            vreg = reg_usage.hreg[j];
+            if (!hregIsVirtual(vreg))
+               continue;
+            if (reg_usage.mode[j] == HRmRead) {
+               nreads++;
+               m = hregNumber(vreg);
+               vassert(IS_VALID_VREGNO(m));
+               if (vreg_state[m] == INVALID_RREG_NO
+                   && vreg_lrs[m].dead_before == ii+1
+                   && hregIsInvalid(cand)) {
+                  spilloff = vreg_lrs[m].spill_offset;
+                  cand = vreg;
+               }
+            }
+         }
+
+         if (nreads == 1 && ! hregIsInvalid(cand)) {
+            HInstr* reloaded;
+            if (reg_usage.n_used == 2)
+               vassert(! sameHReg(reg_usage.hreg[0], reg_usage.hreg[1]));
+            reloaded = directReload ( instrs_in->arr[ii], cand, spilloff );
+            if (reloaded) {
+               instrs_in->arr[ii] = reloaded;
+               (*getRegUsage)( &reg_usage, instrs_in->arr[ii], mode64 );
+            }
+         }
+      }
+
+      /* for each reg mentioned in the insn ... */
+      for (j = 0; j < reg_usage.n_used; j++) {
+
+         Int best, best_until, spillee, spillee_dist;
+
+         vreg = reg_usage.hreg[j];
+         if (!hregIsVirtual(vreg))
+            continue;
+
+         m = hregNumber(vreg);
+         vassert(IS_VALID_VREGNO(m));
+
+         /* Already in a register? */
+         k = vreg_state[m];
+         if (k != INVALID_RREG_NO) {
+            vassert(rreg_state[k].disp == Bound);
+            addToHRegRemap(&remap, vreg, rreg_state[k].rreg);
+            if (reg_usage.mode[j] != HRmRead)
+               rreg_state[k].eq_spill_slot = False;
+            continue;
+         }
+
+         /* Look for a free rreg.  Take the hinted one if it is free
+            until the vreg dies, or until the move which gave the
+            hint, if that is the vreg's last use.  Otherwise take the
+            one which stays free the longest. */
+         best = -1;
+         best_until = -1;
+         k = vreg_lrs[m].hint;
+         if (k != INVALID_RREG_NO && rreg_state[k].disp == Free) {
+            Int until = FREE_UNTIL(k);
+            vassert(hregClass(rreg_state[k].rreg) == hregClass(vreg));
+            if (until >= vreg_lrs[m].dead_before
+                || (until == vreg_lrs[m].hint_insn
+                    && until + 1 == vreg_lrs[m].dead_before))
+               best = k;
+         }
+         if (best == -1) {
+            for (k = 0; k < n_rregs; k++) {
+               Int until;
+               if (rreg_state[k].disp != Free
+                   || hregClass(rreg_state[k].rreg) != hregClass(vreg))
+                  continue;
+               until = FREE_UNTIL(k);
+               if (until > best_until) {
+                  best = k; best_until = until;
+               }
+            }
+         }
+
+         if (best == -1) {
+            /* No free register; we have to spill a vreg.  Choose one
+               not needed by this insn, whose next use is as far away
+               as possible, preferring on a tie one whose rreg matches
+               its spill slot, as it needs no spill store. */
+            spillee = -1;
+            spillee_dist = -1;
+            for (k = 0; k < n_rregs; k++) {
+               Int u, dist, q;
+               if (rreg_state[k].disp != Bound
+                   || hregClass(rreg_state[k].rreg) != hregClass(vreg))
+                  continue;
+               for (q = 0; q < reg_usage.n_used; q++)
+                  if (sameHReg(rreg_state[k].vreg, reg_usage.hreg[q]))
+                     break;
+               if (q < reg_usage.n_used)
+                  continue;
+               q = hregNumber(rreg_state[k].vreg);
+               u = vreg_lrs[q].next_use;
+               while (u != -1 && uses[u].ii <= ii)
+                  u = uses[u].next;
+               vreg_lrs[q].next_use = u;
+               dist = u == -1 ? INFINITE_INSTRNO : uses[u].ii;
+               dist = 2 * dist + (rreg_state[k].eq_spill_slot ? 1 : 0);
+               if (dist > spillee_dist) {
+                  spillee = k;
+                  spillee_dist = dist;
+               }
+            }
+
+            if (spillee == -1) {
+               vex_printf("reg_alloc: can't find a register in class: ");
+               ppHRegClass(hregClass(vreg));
+               vex_printf("\n");
+               vpanic("reg_alloc: can't create a free register.");
+            }
+
+            k = hregNumber(rreg_state[spillee].vreg);
+            vassert(IS_VALID_VREGNO(k));
+            vassert(vreg_lrs[k].dead_before > ii);
+            if (!rreg_state[spillee].eq_spill_slot) {
+               HInstr* spill1 = NULL;
+               HInstr* spill2 = NULL;
+               (*genSpill)( &spill1, &spill2, rreg_state[spillee].rreg,
+                            vreg_lrs[k].spill_offset, mode64 );
+               vassert(spill1 || spill2); /* can't both be NULL */
+               if (spill1)
+                  EMIT_INSTR(spill1);
+               if (spill2)
+                  EMIT_INSTR(spill2);
+               vex_regalloc_stats.n_spills++;
+            }
+            vreg_state[k] = INVALID_RREG_NO;
+            best = spillee;
+         }
+
+         /* Bind vreg to rreg_state[best], reloading it unless this
+            insn merely writes it. */
+         rreg_state[best].disp = Bound;
+         rreg_state[best].vreg = vreg;
+         rreg_state[best].eq_spill_slot = False;
+         vreg_state[m] = toShort(best);
+         addToHRegRemap(&remap, vreg, rreg_state[best].rreg);
+
+         if (reg_usage.mode[j] != HRmWrite) {
+            HInstr* reload1 = NULL;
+            HInstr* reload2 = NULL;
+            vassert(vreg_lrs[m].reg_class != HRcINVALID);
+            (*genReload)( &reload1, &reload2, rreg_state[best].rreg,
+                          vreg_lrs[m].spill_offset, mode64 );
+            vassert(reload1 || reload2); /* can't both be NULL */
+            if (reload1)
+               EMIT_INSTR(reload1);
+            if (reload2)
+               EMIT_INSTR(reload2);
+            vex_regalloc_stats.n_reloads++;
+            if (reg_usage.mode[j] == HRmRead)
+               rreg_state[best].eq_spill_slot = True;
+         }
+      }
+
+      /* NOTE, DESTRUCTIVELY MODIFIES instrs_in->arr[ii]. */
+      (*mapRegs)( &remap, instrs_in->arr[ii], mode64 );
+
+      /* A move which ended up with the same rreg at both ends is a
+         no-op. */
+      if ((*isMove)( instrs_in->arr[ii], &vregS, &vregD )
+          && sameHReg(vregS, vregD))
+         vex_regalloc_stats.n_moves_removed++;
+      else
+         EMIT_INSTR( instrs_in->arr[ii] );
+
+     post_insn:
+
+      /* ------ Post-instruction actions for fixed rreg uses ------ */
+
+      /* Rregs leaving an HLR after this insn become free. */
+      for (k = 0; k < n_rregs; k++) {
+         Int h = rreg_state[k].hlr;
+         if (h == -1 || rreg_lrs[h].dead_before != ii+1)
+            continue;
+         vassert(rreg_state[k].disp == Unavail);
+         rreg_state[k].disp = Free;
+         rreg_state[k].hlr = rreg_lrs[h].next;
+      }
+
+      if (bind_vregno != -1) {
+         vassert(rreg_state[bind_k].disp == Free);
+         rreg_state[bind_k].disp = Bound;
+         rreg_state[bind_k].vreg = mkHReg(bind_vregno,
+                                          vreg_lrs[bind_vregno].reg_class,
+                                          True);
+         vreg_state[bind_vregno] = toShort(bind_k);
+      }
+   }
+
+   for (k = 0; k < n_rregs; k++) {
+      vassert(sameHReg(rreg_state[k].rreg, available_real_regs[k]));
+      vassert(rreg_state[k].hlr == -1);
+   }
+
+   vex_regalloc_stats.n_insns += instrs_in->arr_used;
+
+   return instrs_out;
+
+#  undef INVALID_INSTRNO
+#  undef EMIT_INSTR
+#  undef FREE_UNTIL
+#  undef ADD_RREG_LR
+}
+
+
+/*---------------------------------------------------------------*/
+/*---                                       host_reg_alloc3.c ---*/
+/*---------------------------------------------------------------*/
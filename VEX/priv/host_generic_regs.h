@@ -313,8 +313,9 @@ static inline Bool is_RetLoc_INVALID ( RetLoc rl ) {
 /*--- Reg alloc: TODO: move somewhere else              ---*/
 /*---------------------------------------------------------*/
 
+/* The original allocator, in host_generic_reg_alloc2.c. */
 extern
-HInstrArray* doRegisterAllocation (
+HInstrArray* doRegisterAllocation_v2 (
 
    /* Incoming virtual-registerised code. */ 
    HInstrArray* instrs_in,
@@ -349,6 +350,25 @@ HInstrArray* doRegisterAllocation (
    Bool mode64
 );
 
+/* A linear-scan allocator, in host_generic_reg_alloc3.c.  Same
+   arguments as doRegisterAllocation_v2. */
+extern
+HInstrArray* doRegisterAllocation_v3 (
+   HInstrArray* instrs_in,
+   HReg* available_real_regs,
+   Int   n_available_real_regs,
+   Bool (*isMove) (HInstr*, HReg*, HReg*),
+   void (*getRegUsage) (HRegUsage*, HInstr*, Bool),
+   void (*mapRegs) (HRegRemap*, HInstr*, Bool),
+   void    (*genSpill) (  HInstr**, HInstr**, HReg, Int, Bool ),
+   void    (*genReload) ( HInstr**, HInstr**, HReg, Int, Bool ),
+   HInstr* (*directReload) ( HInstr*, HReg, Short ),
+   Int     guest_sizeB,
+   void (*ppInstr) ( HInstr*, Bool ),
+   void (*ppReg) ( HReg ),
+   Bool mode64
+);
+
 
 #endif /* ndef __VEX_HOST_GENERIC_REGS_H */
 
@@ -1374,6 +1374,10 @@ void ppIRDirty ( IRDirty* d )
    }
    vex_printf("DIRTY ");
    ppIRExpr(d->guard);
+   if (d->cold)
+      vex_printf(" COLD");
+   if (d->idempotent)
+      vex_printf(" IDEM");
    if (d->mFx != Ifx_None) {
       vex_printf(" ");
       ppIREffect(d->mFx);
@@ -2000,6 +2004,8 @@ IRDirty* emptyIRDirty ( void ) {
    d->guard    = NULL;
    d->args     = NULL;
    d->tmp      = IRTemp_INVALID;
+   d->cold     = False;
+   d->idempotent = False;
    d->mFx      = Ifx_None;
    d->mAddr    = NULL;
    d->mSize    = 0;
@@ -2200,11 +2206,16 @@ IRTypeEnv* emptyIRTypeEnv ( void )
 /* Constructors -- IRSB */
 
 IRSB* emptyIRSB ( void )
+{
+   return emptyIRSBOfSize(8);
+}
+
+IRSB* emptyIRSBOfSize ( Int stmts_size )
 {
    IRSB* bb       = LibVEX_Alloc(sizeof(IRSB));
    bb->tyenv      = emptyIRTypeEnv();
    bb->stmts_used = 0;
-   bb->stmts_size = 8;
+   bb->stmts_size = stmts_size < 8 ? 8 : stmts_size;
    bb->stmts      = LibVEX_Alloc(bb->stmts_size * sizeof(IRStmt*));
    bb->next       = NULL;
    bb->jumpkind   = Ijk_Boring;
@@ -2347,6 +2358,8 @@ IRDirty* deepCopyIRDirty ( IRDirty* d )
    d2->guard = deepCopyIRExpr(d->guard);
    d2->args  = deepCopyIRExprVec(d->args);
    d2->tmp   = d->tmp;
+   d2->cold  = d->cold;
+   d2->idempotent = d->idempotent;
    d2->mFx   = d->mFx;
    d2->mAddr = d->mAddr==NULL ? NULL : deepCopyIRExpr(d->mAddr);
    d2->mSize = d->mSize;
@@ -2466,7 +2479,10 @@ IRSB* deepCopyIRSB ( IRSB* bb )
 
 IRSB* deepCopyIRSBExceptStmts ( IRSB* bb )
 {
-   IRSB* bb2     = emptyIRSB();
+   /* The copy is almost always filled in with an instrumented version
+      of bb, which is bigger, so start with room for twice its
+      statements rather than growing from nothing. */
+   IRSB* bb2     = emptyIRSBOfSize(2 * bb->stmts_used);
    bb2->tyenv    = deepCopyIRTypeEnv(bb->tyenv);
    bb2->next     = deepCopyIRExpr(bb->next);
    bb2->jumpkind = bb->jumpkind;
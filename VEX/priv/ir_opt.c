@@ -529,7 +529,8 @@ static IRSB* flatten_BB ( IRSB* in )
 {
    Int   i;
    IRSB* out;
-   out = emptyIRSB();
+   /* Flattening typically doubles the number of statements or more. */
+   out = emptyIRSBOfSize( 2 * in->stmts_used );
    out->tyenv = deepCopyIRTypeEnv( in->tyenv );
    for (i = 0; i < in->stmts_used; i++)
       if (in->stmts[i])
@@ -762,26 +763,40 @@ static void handle_gets_Stmt (
          }
          break;
 
-      /* Be very conservative for dirty helper calls; dump the entire
-         environment.  The helper might read guest state, in which
-         case it needs to be flushed first.  Also, the helper might
-         access guest memory, in which case all parts of the guest
-         state requiring precise exceptions needs to be flushed.  The
-         crude solution is just to flush everything; we could easily
-         enough do a lot better if needed. */
-      /* Probably also overly-conservative, but also dump everything
-         if we hit a memory bus event (fence, lock, unlock).  Ditto
-         AbiHints, CASs, LLs and SCs. */
+      /* A dirty helper call has to see the guest state it says it
+         reads, so flush those parts.  It might also access memory,
+         or otherwise want the guest state to look as it does at a
+         memory access (to take a stack trace, say), so treat it as
+         one regardless of its stated memory effects. */
+      case Ist_Dirty: {
+         IRDirty* d = st->Ist.Dirty.details;
+         Int      r;
+         for (j = 0; j < d->nFxState; j++) {
+            if (d->fxState[j].fx == Ifx_Write)
+               continue;
+            for (r = 0; r < 1 + d->fxState[j].nRepeats; r++) {
+               UInt k_lo = d->fxState[j].offset
+                           + r * d->fxState[j].repeatLen;
+               invalidateOverlaps(env, k_lo,
+                                  k_lo + d->fxState[j].size - 1);
+            }
+         }
+         memRW = True;
+         break;
+      }
+
+      /* Memory bus events (fence, lock, unlock), CASs, LLs and SCs
+         don't read the guest state, but may fault or be observed
+         like memory accesses, so are treated as such.  Ditto
+         AbiHints, which tools turn into memory accesses. */
       case Ist_AbiHint:
          vassert(isIRAtom(st->Ist.AbiHint.base));
          vassert(isIRAtom(st->Ist.AbiHint.nia));
          /* fall through */
       case Ist_MBE:
-      case Ist_Dirty:
       case Ist_CAS:
       case Ist_LLSC:
-         for (j = 0; j < env->used; j++)
-            env->inuse[j] = False;
+         memRW = True;
          break;
 
       /* all other cases are boring. */
@@ -874,7 +889,13 @@ static void handle_gets_Stmt (
    offset) pairs, indicating those parts of the guest state
    for which the next event is a write.
 
-   On seeing a conditional exit, empty the set.
+   On seeing a conditional exit, empty the set, since the exit's
+   destination may read any part of the guest state.  The exception
+   is the guest IP, which the exit itself writes: if the set already
+   says that the IP is written later on the fall-through path, it
+   stays in the set, unless the IP has to be kept up to date at
+   memory accesses (in which case it has to be so at exits too,
+   since tools report errors there).
 
    On seeing 'Put (minoff,maxoff) = t or c', if (minoff,maxoff) is
    completely within the set, remove the Put.  Otherwise, add
@@ -915,7 +936,7 @@ static void redundant_put_removal_BB (
 
       /* Deal with conditional exits. */
       if (st->tag == Ist_Exit) {
-         //Bool re_add;
+         Bool re_add;
          /* Need to throw out from the env, any part of it which
             doesn't overlap with the guest state written by this exit.
             Since the exit only writes one section, it's simplest to
@@ -930,17 +951,18 @@ static void redundant_put_removal_BB (
             overlap check, and failure to find an overlapping write in
             env is the safe case (we just nuke env if that
             happens). */
-         //vassert(isIRAtom(st->Ist.Exit.guard));
+         vassert(isIRAtom(st->Ist.Exit.guard));
          /* (1) */
-         //key = mk_key_GetPut(st->Ist.Exit.offsIP,
-         //                    typeOfIRConst(st->Ist.Exit.dst));
-         //re_add = lookupHHW(env, NULL, key);
+         key = mk_key_GetPut(st->Ist.Exit.offsIP,
+                             typeOfIRConst(st->Ist.Exit.dst));
+         re_add = lookupHHW(env, NULL, key)
+                  && !preciseMemExnsFn((key >> 16) & 0xFFFF, key & 0xFFFF);
          /* (2) */
          for (j = 0; j < env->used; j++)
             env->inuse[j] = False;
          /* (3) */
-         //if (0 && re_add) 
-         //   addToHHW(env, (HWord)key, 0);
+         if (re_add) 
+            addToHHW(env, (HWord)key, 0);
          continue;
       }
 
@@ -2740,22 +2762,23 @@ static IRStmt* subst_and_fold_Stmt ( IRExpr** env, IRStmt* st )
 }
 
 
-IRSB* cprop_BB ( IRSB* in )
+/* This works in place: each statement is written back over the input
+   at an index no greater than its own, since statements are only ever
+   dropped.  The one exception, guarded loads whose guard folds to
+   true, each of which becomes two statements, is dealt with in a
+   second pass at the end. */
+IRSB* cprop_BB ( IRSB* bb )
 {
-   Int      i;
-   IRSB*    out;
+   Int      i, j;
    IRStmt*  st2;
-   Int      n_tmps = in->tyenv->types_used;
+   Int      n_tmps = bb->tyenv->types_used;
    IRExpr** env = LibVEX_Alloc(n_tmps * sizeof(IRExpr*));
    /* Keep track of IRStmt_LoadGs that we need to revisit after
       processing all the other statements. */
    const Int N_FIXUPS = 16;
-   Int fixups[N_FIXUPS]; /* indices in the stmt array of 'out' */
+   Int fixups[N_FIXUPS]; /* indices in the rewritten stmt array */
    Int n_fixups = 0;
 
-   out = emptyIRSB();
-   out->tyenv = deepCopyIRTypeEnv( in->tyenv );
-
    /* Set up the env with which travels forward.  This holds a
       substitution, mapping IRTemps to IRExprs. The environment 
       is to be applied as we move along.  Keys are IRTemps.
@@ -2765,14 +2788,15 @@ IRSB* cprop_BB ( IRSB* in )
       env[i] = NULL;
 
    /* For each original SSA-form stmt ... */
-   for (i = 0; i < in->stmts_used; i++) {
+   j = 0;
+   for (i = 0; i < bb->stmts_used; i++) {
 
       /* First apply the substitution to the current stmt.  This
          propagates in any constants and tmp-tmp assignments
          accumulated prior to this point.  As part of the subst_Stmt
          call, also then fold any constant expressions resulting. */
 
-      st2 = in->stmts[i];
+      st2 = bb->stmts[i];
 
       /* perhaps st2 is already a no-op? */
       if (st2->tag == Ist_NoOp) continue;
@@ -2817,20 +2841,15 @@ IRSB* cprop_BB ( IRSB* in )
             if (guard->tag == Iex_Const) {
                /* The guard has folded to a constant, and that
                   constant must be 1:I1, since subst_and_fold_Stmt
-                  folds out the case 0:I1 by itself. */
+                  folds out the case 0:I1 by itself.  Make a note of
+                  where the LoadG goes in the output.  Afterwards
+                  we'll come back and transform it into a
+                  load-convert pair. */
                vassert(guard->Iex.Const.con->tag == Ico_U1);
                vassert(guard->Iex.Const.con->Ico.U1 == True);
-               /* Add a NoOp here as a placeholder, and make a note of
-                  where it is in the output block.  Afterwards we'll
-                  come back here and transform the NoOp and the LoadG
-                  into a load-convert pair.  The fixups[] entry
-                  refers to the inserted NoOp, and we expect to find
-                  the relevant LoadG immediately after it. */
                vassert(n_fixups >= 0 && n_fixups <= N_FIXUPS);
-               if (n_fixups < N_FIXUPS) {
-                  fixups[n_fixups++] = out->stmts_used;
-                  addStmtToIRSB( out, IRStmt_NoOp() );
-               }
+               if (n_fixups < N_FIXUPS)
+                  fixups[n_fixups++] = j;
             }
             /* And always add the LoadG to the output, regardless. */
             break;
@@ -2841,8 +2860,10 @@ IRSB* cprop_BB ( IRSB* in )
       }
 
       /* Not interesting, copy st2 into the output block. */
-      addStmtToIRSB( out, st2 );
+      vassert(j <= i);
+      bb->stmts[j++] = st2;
    }
+   bb->stmts_used = j;
 
 #  if STATS_IROPT
    vex_printf("sameIRExpr: invoked = %u/%u  equal = %u/%u max_nodes = %u\n",
@@ -2850,20 +2871,25 @@ IRSB* cprop_BB ( IRSB* in )
               recursion_success_count, max_nodes_visited);
 #  endif
 
-   out->next     = subst_Expr( env, in->next );
-   out->jumpkind = in->jumpkind;
-   out->offsIP   = in->offsIP;
+   bb->next = subst_Expr( env, bb->next );
 
    /* Process any leftover unconditional LoadGs that we noticed
-      in the main pass. */
+      in the main pass, making room for the extra statements by
+      moving the rest up, working backwards. */
    vassert(n_fixups >= 0 && n_fixups <= N_FIXUPS);
-   for (i = 0; i < n_fixups; i++) {
-      Int ix = fixups[i];
+   if (n_fixups == 0)
+      return bb;
+
+   for (i = 0; i < n_fixups; i++)
+      addStmtToIRSB( bb, IRStmt_NoOp() );
+   j = bb->stmts_used - 1;
+   for (i = bb->stmts_used - 1 - n_fixups; i >= 0; i--) {
+      IRStmt* lgu = bb->stmts[i];
+      bb->stmts[j--] = lgu;
+      if (n_fixups == 0 || i != fixups[n_fixups-1])
+         continue;
+      n_fixups--;
       /* Carefully verify that the LoadG has the expected form. */
-      vassert(ix >= 0 && ix+1 < out->stmts_used);
-      IRStmt* nop = out->stmts[ix];
-      IRStmt* lgu = out->stmts[ix+1];
-      vassert(nop->tag == Ist_NoOp);
       vassert(lgu->tag == Ist_LoadG);
       IRLoadG* lg    = lgu->Ist.LoadG.details;
       IRExpr*  guard = lg->guard;
@@ -2882,22 +2908,22 @@ IRSB* cprop_BB ( IRSB* in )
          case ILGop_16Sto32: cvtOp = Iop_16Sto32; break;
          default: vpanic("cprop_BB: unhandled ILGOp");
       }
-      /* Replace the placeholder NoOp by the required unconditional
-         load. */
-      IRTemp tLoaded = newIRTemp(out->tyenv, cvtArg);
-      out->stmts[ix] 
-         = IRStmt_WrTmp(tLoaded,
-                        IRExpr_Load(lg->end, cvtArg, lg->addr));
-      /* Replace the LoadG by a conversion from the loaded value's
-         type to the required result type. */
-      out->stmts[ix+1]
+      /* Replace the LoadG by an unconditional load of the loaded
+         type, followed by a conversion from that to the required
+         result type. */
+      IRTemp tLoaded = newIRTemp(bb->tyenv, cvtArg);
+      bb->stmts[j+1]
          = IRStmt_WrTmp(
               lg->dst, cvtOp == Iop_INVALID
                           ? IRExpr_RdTmp(tLoaded)
                           : IRExpr_Unop(cvtOp, IRExpr_RdTmp(tLoaded)));
+      bb->stmts[j--]
+         = IRStmt_WrTmp(tLoaded,
+                        IRExpr_Load(lg->end, cvtArg, lg->addr));
    }
+   vassert(n_fixups == 0 && j == -1);
 
-   return out;
+   return bb;
 }
 
 
@@ -4469,6 +4495,332 @@ void do_redundant_PutI_elimination ( IRSB* bb )
 }
 
 
+/*---------------------------------------------------------------*/
+/*--- Removal of repeated idempotent helper calls             ---*/
+/*---------------------------------------------------------------*/
+
+/* A dirty call marked .idempotent has no further effect when made
+   again with the same args and guard and the guest state it reads
+   unchanged.  Tools mark their checks so; memcheck's complaints
+   about undefined values, for example.  When a loop is unrolled,
+   each copy of the body checks the loop-invariant values again, with
+   guards that compute the same value from the same tmps, and all
+   copies but the first can go.
+
+   The same goes for calls which return a result, such as lookups in
+   shadow memory, as long as nothing can have written memory in
+   between; the repeat's tmp is then bound to the first call's.  Clean
+   helper calls (Iex_CCall) are pure, so any repeat of one can be
+   replaced by the earlier result.  The main CSE pass has done that
+   for the guest code's own, but it runs before instrumentation. */
+
+/* Do atoms a1 and a2 have the same value?  Looks through pure
+   operations by way of defs[], which maps each tmp to the expression
+   it is bound to, if any, up to |depth| levels deep. */
+static Bool sameAtomValue ( IRExpr** defs, IRExpr* a1, IRExpr* a2,
+                            Int depth )
+{
+   IRExpr *e1, *e2;
+   Int    i;
+   /* Look through copies, such as those left by removing repeats. */
+   while (a1->tag == Iex_RdTmp && defs[a1->Iex.RdTmp.tmp]
+          && defs[a1->Iex.RdTmp.tmp]->tag == Iex_RdTmp)
+      a1 = defs[a1->Iex.RdTmp.tmp];
+   while (a2->tag == Iex_RdTmp && defs[a2->Iex.RdTmp.tmp]
+          && defs[a2->Iex.RdTmp.tmp]->tag == Iex_RdTmp)
+      a2 = defs[a2->Iex.RdTmp.tmp];
+   if (eqIRAtom(a1, a2))
+      return True;
+   if (depth == 0 || a1->tag != Iex_RdTmp || a2->tag != Iex_RdTmp)
+      return False;
+   e1 = defs[a1->Iex.RdTmp.tmp];
+   e2 = defs[a2->Iex.RdTmp.tmp];
+   if (e1 == NULL || e2 == NULL || e1->tag != e2->tag)
+      return False;
+   switch (e1->tag) {
+      case Iex_CCall:
+         if (!eqIRCallee(e1->Iex.CCall.cee, e2->Iex.CCall.cee)
+             || e1->Iex.CCall.retty != e2->Iex.CCall.retty)
+            return False;
+         for (i = 0; e1->Iex.CCall.args[i] && e2->Iex.CCall.args[i]; i++)
+            if (!sameAtomValue(defs, e1->Iex.CCall.args[i],
+                               e2->Iex.CCall.args[i], depth-1))
+               return False;
+         return toBool(e1->Iex.CCall.args[i] == NULL
+                       && e2->Iex.CCall.args[i] == NULL);
+      case Iex_Unop:
+         return toBool(e1->Iex.Unop.op == e2->Iex.Unop.op
+                       && sameAtomValue(defs, e1->Iex.Unop.arg,
+                                        e2->Iex.Unop.arg, depth-1));
+      case Iex_Binop:
+         return toBool(e1->Iex.Binop.op == e2->Iex.Binop.op
+                       && sameAtomValue(defs, e1->Iex.Binop.arg1,
+                                        e2->Iex.Binop.arg1, depth-1)
+                       && sameAtomValue(defs, e1->Iex.Binop.arg2,
+                                        e2->Iex.Binop.arg2, depth-1));
+      case Iex_ITE:
+         return toBool(sameAtomValue(defs, e1->Iex.ITE.cond,
+                                     e2->Iex.ITE.cond, depth-1)
+                       && sameAtomValue(defs, e1->Iex.ITE.iftrue,
+                                        e2->Iex.ITE.iftrue, depth-1)
+                       && sameAtomValue(defs, e1->Iex.ITE.iffalse,
+                                        e2->Iex.ITE.iffalse, depth-1));
+      default:
+         return False;
+   }
+}
+
+/* Does the guest state area [lo,hi] overlap anything d reads? */
+static Bool dirtyReadsOverlap ( IRDirty* d, Int lo, Int hi )
+{
+   Int j, r;
+   for (j = 0; j < d->nFxState; j++) {
+      if (d->fxState[j].fx == Ifx_Write)
+         continue;
+      for (r = 0; r < 1 + d->fxState[j].nRepeats; r++) {
+         Int k_lo = d->fxState[j].offset + r * d->fxState[j].repeatLen;
+         Int k_hi = k_lo + d->fxState[j].size - 1;
+         if (k_lo <= hi && lo <= k_hi)
+            return True;
+      }
+   }
+   return False;
+}
+
+static Bool dirtyWritesGuestState ( IRStmt* st )
+{
+   IRDirty* d;
+   Int      i;
+   if (st->tag != Ist_Dirty)
+      return False;
+   d = st->Ist.Dirty.details;
+   for (i = 0; i < d->nFxState; i++)
+      if (d->fxState[i].fx != Ifx_Read)
+         return True;
+   return False;
+}
+
+/* Is the guest state that the dirty call at stmts[i2] reads the same
+   as it was at the identical call at stmts[i1], i1 < i2?  A Put in
+   between that overlaps it is harmless if it only stores again, at
+   the same offset, the value the last Put there before i1 stored --
+   the guest IP, typically, in an unrolled loop. */
+static Bool dirtyReadsSameState ( IRSB* bb, IRExpr** defs,
+                                  Int i1, Int i2 )
+{
+   IRDirty* d = bb->stmts[i2]->Ist.Dirty.details;
+   Int      k, m;
+   for (k = i1+1; k < i2; k++) {
+      IRStmt* st = bb->stmts[k];
+      switch (st->tag) {
+         case Ist_Put: {
+            Int     lo = st->Ist.Put.offset;
+            Int     hi = lo + sizeofIRType(typeOfIRExpr(bb->tyenv,
+                                                        st->Ist.Put.data))
+                            - 1;
+            if (!dirtyReadsOverlap(d, lo, hi))
+               break;
+            for (m = i1-1; m >= 0; m--) {
+               IRStmt* st2 = bb->stmts[m];
+               if (st2->tag == Ist_Put && st2->Ist.Put.offset == lo)
+                  break;
+               if (st2->tag == Ist_Put) {
+                  Int lo2 = st2->Ist.Put.offset;
+                  Int hi2 = lo2 + sizeofIRType(
+                                     typeOfIRExpr(bb->tyenv,
+                                                  st2->Ist.Put.data)) - 1;
+                  if (lo2 <= hi && lo <= hi2)
+                     return False;
+               }
+               if (st2->tag == Ist_PutI || dirtyWritesGuestState(st2))
+                  return False;
+            }
+            if (m < 0
+                || typeOfIRExpr(bb->tyenv, bb->stmts[m]->Ist.Put.data)
+                   != typeOfIRExpr(bb->tyenv, st->Ist.Put.data)
+                || !sameAtomValue(defs, bb->stmts[m]->Ist.Put.data,
+                                  st->Ist.Put.data, 4))
+               return False;
+            break;
+         }
+         case Ist_PutI:
+            return False;
+         case Ist_Dirty:
+            if (dirtyWritesGuestState(st))
+               return False;
+            break;
+         default:
+            break;
+      }
+   }
+   return True;
+}
+
+static Bool sameIdempotentCall ( IRExpr** defs, IRDirty* d1, IRDirty* d2 )
+{
+   Int i;
+   if (d1->cee->addr != d2->cee->addr
+       || d1->nFxState != d2->nFxState
+       || !sameAtomValue(defs, d1->guard, d2->guard, 4))
+      return False;
+   for (i = 0; d1->args[i] && d2->args[i]; i++) {
+      if (!sameAtomValue(defs, d1->args[i], d2->args[i], 4))
+         return False;
+   }
+   if (d1->args[i] || d2->args[i])
+      return False;
+   for (i = 0; i < d1->nFxState; i++) {
+      if (d1->fxState[i].fx != d2->fxState[i].fx
+          || d1->fxState[i].offset != d2->fxState[i].offset
+          || d1->fxState[i].size != d2->fxState[i].size
+          || d1->fxState[i].nRepeats != d2->fxState[i].nRepeats
+          || d1->fxState[i].repeatLen != d2->fxState[i].repeatLen)
+         return False;
+   }
+   return True;
+}
+
+/* Can anything between stmts[i1] and stmts[i2] write memory? */
+static Bool memoryWrittenBetween ( IRSB* bb, Int i1, Int i2 )
+{
+   Int k;
+   for (k = i1+1; k < i2; k++) {
+      IRStmt* st = bb->stmts[k];
+      switch (st->tag) {
+         case Ist_Store: case Ist_StoreG: case Ist_CAS: case Ist_LLSC:
+            return True;
+         case Ist_Dirty:
+            if (!st->Ist.Dirty.details->idempotent
+                || st->Ist.Dirty.details->mFx == Ifx_Write
+                || st->Ist.Dirty.details->mFx == Ifx_Modify)
+               return True;
+            break;
+         default:
+            break;
+      }
+   }
+   return False;
+}
+
+/* Only idempotent calls with no memory effects and no guest state
+   writes are considered. */
+static Bool isRemovableIdempotent ( IRStmt* st )
+{
+   IRDirty* d;
+   Int      i;
+   if (st->tag != Ist_Dirty)
+      return False;
+   d = st->Ist.Dirty.details;
+   if (!d->idempotent || d->mFx != Ifx_None
+       || dirtyWritesGuestState(st))
+      return False;
+   for (i = 0; d->args[i]; i++)
+      if (is_IRExpr_VECRET_or_BBPTR(d->args[i]))
+         return False;
+   return True;
+}
+
+#define N_IDEM_CALLS 64
+
+static inline Bool isCCallBinding ( IRStmt* st )
+{
+   return toBool(st->tag == Ist_WrTmp
+                 && st->Ist.WrTmp.data->tag == Iex_CCall);
+}
+
+Bool remove_repeated_idempotent_BB ( IRSB* bb )
+{
+   Bool     removed = False;
+   Int      i, j, n_seen, n_ccalls, n_removable, n_pure;
+   Int      seen[N_IDEM_CALLS];
+   Int      ccalls[N_IDEM_CALLS];
+   IRExpr** defs;
+
+   n_removable = n_pure = 0;
+   for (i = 0; i < bb->stmts_used; i++) {
+      if (isRemovableIdempotent(bb->stmts[i]))
+         n_removable++;
+      else if (isCCallBinding(bb->stmts[i]))
+         n_pure++;
+   }
+   if (n_removable < 2 && n_pure < 2)
+      return False;
+
+   defs = LibVEX_Alloc(bb->tyenv->types_used * sizeof(IRExpr*));
+   for (i = 0; i < bb->tyenv->types_used; i++)
+      defs[i] = NULL;
+   for (i = 0; i < bb->stmts_used; i++) {
+      IRStmt* st = bb->stmts[i];
+      if (st->tag == Ist_WrTmp)
+         defs[st->Ist.WrTmp.tmp] = st->Ist.WrTmp.data;
+   }
+
+   n_seen = n_ccalls = 0;
+   for (i = 0; i < bb->stmts_used; i++) {
+      IRStmt* st = bb->stmts[i];
+
+      if (isCCallBinding(st)) {
+         IRTemp t = st->Ist.WrTmp.tmp;
+         for (j = 0; j < n_ccalls; j++) {
+            IRTemp q = bb->stmts[ccalls[j]]->Ist.WrTmp.tmp;
+            if (sameAtomValue(defs, IRExpr_RdTmp(q), IRExpr_RdTmp(t), 1))
+               break;
+         }
+         if (j < n_ccalls) {
+            if (DEBUG_IROPT) {
+               vex_printf("rIC:  ");
+               ppIRStmt(st);
+               vex_printf("\n");
+            }
+            defs[t] = IRExpr_RdTmp(bb->stmts[ccalls[j]]->Ist.WrTmp.tmp);
+            bb->stmts[i] = IRStmt_WrTmp(t, defs[t]);
+            removed = True;
+         } else if (n_ccalls < N_IDEM_CALLS) {
+            ccalls[n_ccalls++] = i;
+         }
+         continue;
+      }
+
+      if (!isRemovableIdempotent(st))
+         continue;
+      for (j = 0; j < n_seen; j++) {
+         IRDirty* d1 = bb->stmts[seen[j]]->Ist.Dirty.details;
+         IRDirty* d2 = st->Ist.Dirty.details;
+         if ((d1->tmp == IRTemp_INVALID) != (d2->tmp == IRTemp_INVALID))
+            continue;
+         if (d1->tmp != IRTemp_INVALID
+             && (typeOfIRTemp(bb->tyenv, d1->tmp)
+                    != typeOfIRTemp(bb->tyenv, d2->tmp)
+                 || memoryWrittenBetween(bb, seen[j], i)))
+            continue;
+         if (sameIdempotentCall(defs, d1, d2)
+             && dirtyReadsSameState(bb, defs, seen[j], i))
+            break;
+      }
+      if (j < n_seen) {
+         IRTemp t = st->Ist.Dirty.details->tmp;
+         if (DEBUG_IROPT) {
+            vex_printf("rIC:  ");
+            ppIRStmt(st);
+            vex_printf("\n");
+         }
+         if (t == IRTemp_INVALID) {
+            bb->stmts[i] = IRStmt_NoOp();
+         } else {
+            defs[t] = IRExpr_RdTmp(bb->stmts[seen[j]]->Ist.Dirty.details->tmp);
+            bb->stmts[i] = IRStmt_WrTmp(t, defs[t]);
+         }
+         removed = True;
+      } else if (n_seen < N_IDEM_CALLS) {
+         seen[n_seen++] = i;
+      }
+   }
+   return removed;
+}
+
+#undef N_IDEM_CALLS
+
+
 /*---------------------------------------------------------------*/
 /*--- Loop unrolling                                          ---*/
 /*---------------------------------------------------------------*/
@@ -4634,9 +4986,24 @@ static void deltaIRStmt ( IRStmt* st, Int delta )
    X and Y must be literal (guest) addresses.
 */
 
-static Int calc_unroll_factor( IRSB* bb )
+/* Loops that use GetI and PutI (in practice, x87 code, whose register
+   stack is a guest state array indexed by FTOP) are allowed to grow
+   this many times larger.  Each x87 instruction becomes a lot of IR
+   -- the register read, its tag check, and the tag and register
+   writes -- so such loops are rarely small enough to unroll.  But they
+   gain the most from it: once the copies are joined, the redundant
+   GetI/PutI elimination keeps the stack registers and their tags in
+   temporaries from one iteration to the next, and the register file
+   and FTOP are written back only at the exits. */
+#define GETI_PUTI_UNROLL_SCALE 4
+
+static Int calc_unroll_factor( IRSB* bb, Bool hasGetIorPutI )
 {
    Int n_stmts, i;
+   Int thresh = vex_control.iropt_unroll_thresh;
+
+   if (hasGetIorPutI)
+      thresh *= GETI_PUTI_UNROLL_SCALE;
 
    n_stmts = 0;
    for (i = 0; i < bb->stmts_used; i++) {
@@ -4644,20 +5011,20 @@ static Int calc_unroll_factor( IRSB* bb )
          n_stmts++;
    }
 
-   if (n_stmts <= vex_control.iropt_unroll_thresh/8) {
+   if (n_stmts <= thresh/8) {
       if (vex_control.iropt_verbosity > 0)
          vex_printf("vex iropt: 8 x unrolling (%d sts -> %d sts)\n",
                     n_stmts, 8* n_stmts);
       return 8;
    }
-   if (n_stmts <= vex_control.iropt_unroll_thresh/4) {
+   if (n_stmts <= thresh/4) {
       if (vex_control.iropt_verbosity > 0)
          vex_printf("vex iropt: 4 x unrolling (%d sts -> %d sts)\n",
                     n_stmts, 4* n_stmts);
       return 4;
    }
 
-   if (n_stmts <= vex_control.iropt_unroll_thresh/2) {
+   if (n_stmts <= thresh/2) {
       if (vex_control.iropt_verbosity > 0)
          vex_printf("vex iropt: 2 x unrolling (%d sts -> %d sts)\n",
                     n_stmts, 2* n_stmts);
@@ -4671,7 +5038,8 @@ static Int calc_unroll_factor( IRSB* bb )
 }
 
 
-static IRSB* maybe_loop_unroll_BB ( IRSB* bb0, Addr64 my_addr )
+static IRSB* maybe_loop_unroll_BB ( IRSB* bb0, Addr64 my_addr,
+                                    Bool hasGetIorPutI )
 {
    Int      i, j, jmax, n_vars;
    Bool     xxx_known;
@@ -4716,7 +5084,7 @@ static IRSB* maybe_loop_unroll_BB ( IRSB* bb0, Addr64 my_addr )
       unrolling stage, first cloning the bb so the original isn't
       modified. */
    if (xxx_value == my_addr) {
-      unroll_factor = calc_unroll_factor( bb0 );
+      unroll_factor = calc_unroll_factor( bb0, hasGetIorPutI );
       if (unroll_factor < 2)
          return NULL;
       bb1 = deepCopyIRSB( bb0 );
@@ -4763,7 +5131,7 @@ static IRSB* maybe_loop_unroll_BB ( IRSB* bb0, Addr64 my_addr )
       unrolling proper.  This means finding (again) the last stmt, in
       the copied BB. */
 
-   unroll_factor = calc_unroll_factor( bb0 );
+   unroll_factor = calc_unroll_factor( bb0, hasGetIorPutI );
    if (unroll_factor < 2)
       return NULL;
 
@@ -6151,7 +6519,7 @@ IRSB* do_iropt_BB(
       /* Now have a go at unrolling simple (single-BB) loops.  If
          successful, clean up the results as much as possible. */
 
-      bb2 = maybe_loop_unroll_BB( bb, guest_addr );
+      bb2 = maybe_loop_unroll_BB( bb, guest_addr, hasGetIorPutI );
       if (bb2) {
          bb = cheap_transformations( bb2, specHelper, preciseMemExnsFn );
          if (hasGetIorPutI) {
@@ -51,7 +51,8 @@ IRSB* do_iropt_BB(
          VexArch guest_arch
       );
 
-/* Do a constant folding/propagation pass. */
+/* Do a constant folding/propagation pass.  bb is destructively
+   modified, and returned. */
 extern
 IRSB* cprop_BB ( IRSB* );
 
@@ -59,6 +60,12 @@ IRSB* cprop_BB ( IRSB* );
 extern
 void do_deadcode_BB ( IRSB* bb );
 
+/* Remove dirty calls marked .idempotent, and clean helper calls, that
+   repeat an earlier one.  bb is destructively modified.  Returns True
+   if any were removed. */
+extern
+Bool remove_repeated_idempotent_BB ( IRSB* bb );
+
 /* The tree-builder.  Make (approximately) maximal safe trees.  bb is
    destructively modified.  Returns (unrelatedly, but useful later on)
    the guest address of the highest addressed byte from any insn in
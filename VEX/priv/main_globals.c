@@ -64,6 +64,12 @@ Bool vex_valgrind_support = False;
 /* Max # guest insns per bb */
 VexControl vex_control = { 0,0,False,0,0,0 };
 
+/* Register allocator statistics */
+VexRegAllocStats vex_regalloc_stats = { 0,0,0,0 };
+
+/* Instruction selector statistics */
+VexISelStats vex_isel_stats = { 0,0 };
+
 
 
 /*---------------------------------------------------------------*/
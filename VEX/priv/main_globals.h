@@ -65,6 +65,12 @@ extern Bool vex_valgrind_support;
 /* Optimiser/front-end control */
 extern VexControl vex_control;
 
+/* Register allocator statistics */
+extern VexRegAllocStats vex_regalloc_stats;
+
+/* Instruction selector statistics */
+extern VexISelStats vex_isel_stats;
+
 
 /* vex_traceflags values */
 #define VEX_TRACE_FE     (1 << 7)  /* show conversion into IR */
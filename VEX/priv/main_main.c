@@ -100,6 +100,25 @@ void LibVEX_default_VexControl ( /*OUT*/ VexControl* vcon )
    vcon->guest_max_insns            = 60;
    vcon->guest_chase_thresh         = 10;
    vcon->guest_chase_cond           = False;
+   vcon->regalloc_version           = 2;
+}
+
+
+static void check_VexControl ( const VexControl* vcon )
+{
+   vassert(vcon->iropt_verbosity >= 0);
+   vassert(vcon->iropt_level >= 0);
+   vassert(vcon->iropt_level <= 2);
+   vassert(vcon->iropt_unroll_thresh >= 0);
+   vassert(vcon->iropt_unroll_thresh <= 400);
+   vassert(vcon->guest_max_insns >= 1);
+   vassert(vcon->guest_max_insns <= 100);
+   vassert(vcon->guest_chase_thresh >= 0);
+   vassert(vcon->guest_chase_thresh < vcon->guest_max_insns);
+   vassert(vcon->guest_chase_cond == True 
+           || vcon->guest_chase_cond == False);
+   vassert(vcon->regalloc_version == 2
+           || vcon->regalloc_version == 3);
 }
 
 
@@ -130,17 +149,7 @@ void LibVEX_Init (
    vassert(log_bytes);
    vassert(debuglevel >= 0);
 
-   vassert(vcon->iropt_verbosity >= 0);
-   vassert(vcon->iropt_level >= 0);
-   vassert(vcon->iropt_level <= 2);
-   vassert(vcon->iropt_unroll_thresh >= 0);
-   vassert(vcon->iropt_unroll_thresh <= 400);
-   vassert(vcon->guest_max_insns >= 1);
-   vassert(vcon->guest_max_insns <= 100);
-   vassert(vcon->guest_chase_thresh >= 0);
-   vassert(vcon->guest_chase_thresh < vcon->guest_max_insns);
-   vassert(vcon->guest_chase_cond == True 
-           || vcon->guest_chase_cond == False);
+   check_VexControl(vcon);
 
    /* Check that Vex has been built with sizes of basic types as
       stated in priv/libvex_basictypes.h.  Failure of any of these is
@@ -202,8 +211,33 @@ void LibVEX_Init (
 }
 
 
+/* Exported to library client. */
+
+void LibVEX_Update_Control ( const VexControl* vcon )
+{
+   vassert(vex_initdone);
+   check_VexControl(vcon);
+   vex_control = *vcon;
+}
+
+
 /* --------- Make a translation. --------- */
 
+/* Phase times, when the client asks for them, and the time at which
+   the current phase started. */
+static VexPhaseTimes vex_phase_times;
+static ULong         vex_phase_start;
+
+static void end_phase ( VexTranslateArgs* vta, /*MOD*/ULong* total )
+{
+   ULong now;
+   if (vta->read_clock == NULL)
+      return;
+   now = vta->read_clock();
+   *total += now - vex_phase_start;
+   vex_phase_start = now;
+}
+
 /* Exported to library client. */
 
 VexTranslateResult LibVEX_Translate ( VexTranslateArgs* vta )
@@ -226,6 +260,7 @@ VexTranslateResult LibVEX_Translate ( VexTranslateArgs* vta )
    Int          (*emit)         ( /*MB_MOD*/Bool*,
                                   UChar*, Int, HInstr*, Bool, VexEndness,
                                   void*, void*, void*, void* );
+   Int          (*emitColdPart) ( UChar*, Int, HInstr*, UChar*, Int, Int );
    IRExpr*      (*specHelper)   ( const HChar*, IRExpr**, IRStmt**, Int );
    Bool         (*preciseMemExnsFn) ( Int, Int );
 
@@ -238,7 +273,8 @@ VexTranslateResult LibVEX_Translate ( VexTranslateArgs* vta )
    Int             i, j, k, out_used, guest_sizeB;
    Int             offB_CMSTART, offB_CMLEN, offB_GUEST_IP, szB_GUEST_IP;
    Int             offB_HOST_EvC_COUNTER, offB_HOST_EvC_FAILADDR;
-   UChar           insn_bytes[128];
+   UChar           insn_bytes[256];
+   Int*            hot_ends;
    IRType          guest_word_type;
    IRType          host_word_type;
    Bool            mode64, chainingAllowed;
@@ -257,6 +293,7 @@ VexTranslateResult LibVEX_Translate ( VexTranslateArgs* vta )
    ppReg                  = NULL;
    iselSB                 = NULL;
    emit                   = NULL;
+   emitColdPart           = NULL;
    specHelper             = NULL;
    preciseMemExnsFn       = NULL;
    disInstrFn             = NULL;
@@ -336,6 +373,8 @@ VexTranslateResult LibVEX_Translate ( VexTranslateArgs* vta )
          emit        = (Int(*)(Bool*,UChar*,Int,HInstr*,Bool,VexEndness,
                                void*,void*,void*,void*))
                        emit_AMD64Instr;
+         emitColdPart = (Int(*)(UChar*,Int,HInstr*,UChar*,Int,Int))
+                        emitColdPart_AMD64;
          host_word_type    = Ity_I64;
          vassert(are_valid_hwcaps(VexArchAMD64, vta->archinfo_host.hwcaps));
          vassert(vta->archinfo_host.endness == VexEndnessLE);
@@ -710,6 +749,9 @@ VexTranslateResult LibVEX_Translate ( VexTranslateArgs* vta )
 
    vexAllocSanityCheck();
 
+   if (vta->read_clock)
+      vex_phase_start = vta->read_clock();
+
    if (vex_traceflags & VEX_TRACE_FE)
       vex_printf("\n------------------------" 
                    " Front end "
@@ -737,6 +779,7 @@ VexTranslateResult LibVEX_Translate ( VexTranslateArgs* vta )
                      szB_GUEST_IP );
 
    vexAllocSanityCheck();
+   end_phase(vta, &vex_phase_times.front_end);
 
    if (irsb == NULL) {
       /* Access failure. */
@@ -783,6 +826,7 @@ VexTranslateResult LibVEX_Translate ( VexTranslateArgs* vta )
                               vta->arch_guest );
    sanityCheckIRSB( irsb, "after initial iropt", 
                     True/*must be flat*/, guest_word_type );
+   end_phase(vta, &vex_phase_times.iropt);
 
    if (vex_traceflags & VEX_TRACE_OPT1) {
       vex_printf("\n------------------------" 
@@ -809,6 +853,7 @@ VexTranslateResult LibVEX_Translate ( VexTranslateArgs* vta )
                               vta->guest_extents,
                               &vta->archinfo_host,
                               guest_word_type, host_word_type);
+   end_phase(vta, &vex_phase_times.instrument);
       
    if (vex_traceflags & VEX_TRACE_INST) {
       vex_printf("\n------------------------" 
@@ -827,6 +872,12 @@ VexTranslateResult LibVEX_Translate ( VexTranslateArgs* vta )
       do_deadcode_BB( irsb );
       irsb = cprop_BB( irsb );
       do_deadcode_BB( irsb );
+      /* Tool checks and helper calls on values that don't change
+         across an unrolled loop are repeated in each copy of the
+         body. */
+      if (vex_control.iropt_level > 1
+          && remove_repeated_idempotent_BB( irsb ))
+         do_deadcode_BB( irsb );
       sanityCheckIRSB( irsb, "after post-instrumentation cleanup",
                        True/*must be flat*/, guest_word_type );
    }
@@ -845,11 +896,26 @@ VexTranslateResult LibVEX_Translate ( VexTranslateArgs* vta )
       also throws away any dead bindings. */
    max_ga = ado_treebuild_BB( irsb, preciseMemExnsFn );
 
+   /* Direct exits to guest addresses above max_ga are chained to the
+      fast entry point of the translation there, skipping its event
+      check.  ado_treebuild_BB gives the highest address of any insn
+      in the block, but the start of the block is enough: in any
+      loop of chained translations, the one that starts lowest is
+      entered from a translation that starts at the same address or
+      above, and that exit goes to the slow entry point, so the loop
+      still does an event check each time round.  This saves the
+      check on forward jumps out of a trace that has chased over
+      higher addresses. */
+   if (max_ga != ~(Addr64)0 && vta->guest_extents->n_used > 0
+       && vta->guest_extents->base[0] < max_ga)
+      max_ga = vta->guest_extents->base[0];
+
    if (vta->finaltidy) {
       irsb = vta->finaltidy(irsb);
    }
 
    vexAllocSanityCheck();
+   end_phase(vta, &vex_phase_times.tidy);
 
    if (vex_traceflags & VEX_TRACE_TREES) {
       vex_printf("\n------------------------" 
@@ -884,8 +950,10 @@ VexTranslateResult LibVEX_Translate ( VexTranslateArgs* vta )
                     chainingAllowed,
                     vta->addProfInc,
                     max_ga );
+   vex_isel_stats.n_blocks++;
 
    vexAllocSanityCheck();
+   end_phase(vta, &vex_phase_times.isel);
 
    if (vex_traceflags & VEX_TRACE_VCODE)
       vex_printf("\n");
@@ -900,14 +968,23 @@ VexTranslateResult LibVEX_Translate ( VexTranslateArgs* vta )
    }
 
    /* Register allocate. */
-   rcode = doRegisterAllocation ( vcode, available_real_regs,
-                                  n_available_real_regs,
-                                  isMove, getRegUsage, mapRegs, 
-                                  genSpill, genReload, directReload, 
-                                  guest_sizeB,
-                                  ppInstr, ppReg, mode64 );
+   if (vex_control.regalloc_version == 3)
+      rcode = doRegisterAllocation_v3 ( vcode, available_real_regs,
+                                        n_available_real_regs,
+                                        isMove, getRegUsage, mapRegs,
+                                        genSpill, genReload, directReload,
+                                        guest_sizeB,
+                                        ppInstr, ppReg, mode64 );
+   else
+      rcode = doRegisterAllocation_v2 ( vcode, available_real_regs,
+                                        n_available_real_regs,
+                                        isMove, getRegUsage, mapRegs,
+                                        genSpill, genReload, directReload,
+                                        guest_sizeB,
+                                        ppInstr, ppReg, mode64 );
 
    vexAllocSanityCheck();
+   end_phase(vta, &vex_phase_times.regalloc);
 
    if (vex_traceflags & VEX_TRACE_RCODE) {
       vex_printf("\n------------------------" 
@@ -935,6 +1012,13 @@ VexTranslateResult LibVEX_Translate ( VexTranslateArgs* vta )
                    "------------------------\n\n");
    }
 
+   /* If the host has insns with out-of-line parts, remember where
+      each insn's in-line part ends, so the out-of-line parts, which
+      go after the last insn, can be linked up with them. */
+   hot_ends = NULL;
+   if (emitColdPart)
+      hot_ends = LibVEX_Alloc(rcode->arr_used * sizeof(Int));
+
    out_used = 0; /* tracks along the host_bytes array */
    for (i = 0; i < rcode->arr_used; i++) {
       HInstr* hi           = rcode->arr[i];
@@ -977,8 +1061,44 @@ VexTranslateResult LibVEX_Translate ( VexTranslateArgs* vta )
         out_used += j;
       }
       vassert(out_used <= vta->host_bytes_size);
+      if (hot_ends)
+         hot_ends[i] = out_used;
+   }
+
+   for (i = 0; hot_ends && i < rcode->arr_used; i++) {
+      HInstr* hi = rcode->arr[i];
+      j = emitColdPart( insn_bytes, sizeof insn_bytes, hi,
+                        vta->host_bytes, hot_ends[i], out_used );
+      if (j == 0)
+         continue;
+      if (UNLIKELY(vex_traceflags & VEX_TRACE_ASM)) {
+         vex_printf("(out of line) ");
+         ppInstr(hi, mode64);
+         vex_printf("\n");
+         for (k = 0; k < j; k++)
+            if (insn_bytes[k] < 16)
+               vex_printf("0%x ",  (UInt)insn_bytes[k]);
+            else
+               vex_printf("%x ", (UInt)insn_bytes[k]);
+         vex_printf("\n\n");
+      }
+      if (UNLIKELY(out_used + j > vta->host_bytes_size)) {
+         vexSetAllocModeTEMP_and_clear();
+         vex_traceflags = 0;
+         res.status = VexTransOutputFull;
+         return res;
+      }
+      { UChar* dst = &vta->host_bytes[out_used];
+        for (k = 0; k < j; k++) {
+           dst[k] = insn_bytes[k];
+        }
+        out_used += j;
+      }
    }
    *(vta->host_bytes_used) = out_used;
+   end_phase(vta, &vex_phase_times.assembly);
+   if (vta->read_clock)
+      vex_phase_times.n_translations++;
 
    vexAllocSanityCheck();
 
@@ -1166,6 +1286,36 @@ VexInvalRange LibVEX_PatchProfInc ( VexArch    arch_host,
 }
 
 
+/* --------- Register allocator statistics. --------- */
+
+/* Exported to library client. */
+
+void LibVEX_GetRegAllocStats ( /*OUT*/VexRegAllocStats* stats )
+{
+   *stats = vex_regalloc_stats;
+}
+
+
+/* --------- Instruction selector statistics. --------- */
+
+/* Exported to library client. */
+
+void LibVEX_GetISelStats ( /*OUT*/VexISelStats* stats )
+{
+   *stats = vex_isel_stats;
+}
+
+
+/* --------- Translation phase times. --------- */
+
+/* Exported to library client. */
+
+void LibVEX_GetPhaseTimes ( /*OUT*/VexPhaseTimes* times )
+{
+   *times = vex_phase_times;
+}
+
+
 /* --------- Emulation warnings. --------- */
 
 const HChar* LibVEX_EmNote_string ( VexEmNote ew )
@@ -1280,6 +1430,7 @@ void LibVEX_default_VexAbiInfo ( /*OUT*/VexAbiInfo* vbi )
    vbi->guest_stack_redzone_size       = 0;
    vbi->guest_amd64_assume_fs_is_zero  = False;
    vbi->guest_amd64_assume_gs_is_0x60  = False;
+   vbi->guest_cc_op_hint               = -1;
    vbi->guest_ppc_zap_RZ_at_blr        = False;
    vbi->guest_ppc_zap_RZ_at_bl         = NULL;
    vbi->host_ppc_calls_use_fndescrs    = False;
@@ -1328,11 +1479,12 @@ static const HChar* show_hwcaps_amd64 ( UInt hwcaps )
    Bool have_avx  = (hwcaps & VEX_HWCAPS_AMD64_AVX)  != 0;
    Bool have_bmi  = (hwcaps & VEX_HWCAPS_AMD64_BMI)  != 0;
    Bool have_avx2 = (hwcaps & VEX_HWCAPS_AMD64_AVX2) != 0;
+   Bool have_fma  = (hwcaps & VEX_HWCAPS_AMD64_FMA)  != 0;
    /* AVX without SSE3 */
    if (have_avx && !have_sse3)
       return NULL;
-   /* AVX2 or BMI without AVX */
-   if ((have_avx2 || have_bmi) && !have_avx)
+   /* AVX2, BMI or FMA without AVX */
+   if ((have_avx2 || have_bmi || have_fma) && !have_avx)
       return NULL;
 
    /* This isn't threadsafe.  We might need to fix it at some point. */
@@ -1370,6 +1522,9 @@ static const HChar* show_hwcaps_amd64 ( UInt hwcaps )
    if (hwcaps & VEX_HWCAPS_AMD64_BMI) {
       p = p + vex_sprintf(p, "%s", "-bmi");
    }
+   if (hwcaps & VEX_HWCAPS_AMD64_FMA) {
+      p = p + vex_sprintf(p, "%s", "-fma");
+   }
 
   out:
    vassert(buf[sizeof(buf)-1] == 0);
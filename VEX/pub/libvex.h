@@ -98,6 +98,7 @@ typedef
 #define VEX_HWCAPS_AMD64_RDTSCP (1<<9)  /* RDTSCP instruction */
 #define VEX_HWCAPS_AMD64_BMI    (1<<10) /* BMI1 instructions */
 #define VEX_HWCAPS_AMD64_AVX2   (1<<11) /* AVX2 instructions */
+#define VEX_HWCAPS_AMD64_FMA    (1<<12) /* FMA3 instructions */
 
 /* ppc32: baseline capability is integer only */
 #define VEX_HWCAPS_PPC32_F     (1<<8)  /* basic (non-optional) FP */
@@ -358,6 +359,13 @@ typedef
          0x60? */
       Bool guest_amd64_assume_gs_is_0x60;
 
+      /* X86 and AMD64 GUESTS only: the value the flags thunk's CC_OP
+         is expected to have on entry to the block, or -1 if there is
+         no such expectation.  Conditions that read a CC_OP not set
+         earlier in the block are specialised for this value, behind a
+         guard that falls back to the generic helper call. */
+      Long guest_cc_op_hint;
+
       /* PPC GUESTS only: should we zap the stack red zone at a 'blr'
          (function return) ? */
       Bool guest_ppc_zap_RZ_at_blr;
@@ -434,6 +442,9 @@ typedef
       /* EXPERIMENTAL: chase across conditional branches?  Not all
          front ends honour this.  Default: NO. */
       Bool guest_chase_cond;
+      /* Which register allocator to use: 2 (default) = the original
+         one, 3 = linear scan with register hints.  */
+      Int regalloc_version;
    }
    VexControl;
 
@@ -587,6 +598,12 @@ extern void LibVEX_Init (
 );
 
 
+/* Change the control settings given to LibVEX_Init; they take effect
+   from the next translation onwards. */
+
+extern void LibVEX_Update_Control ( const VexControl* vcon );
+
+
 /*-------------------------------------------------------*/
 /*--- Make a translation                              ---*/
 /*-------------------------------------------------------*/
@@ -711,6 +728,12 @@ typedef
          translation? */
       Bool    addProfInc;
 
+      /* IN: profiling: optionally, a function returning the current
+         time in some fixed unit, nanoseconds say.  If non-NULL, the
+         time spent in each phase of the translation is added to the
+         totals returned by LibVEX_GetPhaseTimes.  May be NULL. */
+      ULong   (*read_clock)( void );
+
       /* IN: address of the dispatcher entry points.  Describes the
          places where generated code should jump to at the end of each
          bb.
@@ -831,6 +854,58 @@ VexInvalRange LibVEX_PatchProfInc ( VexArch    arch_host,
 
 extern void LibVEX_ShowStats ( void );
 
+/* Register allocator statistics, summed over all translations. */
+typedef
+   struct {
+      /* Number of instructions register-allocated. */
+      ULong n_insns;
+      /* Number of spill stores and reloads generated. */
+      ULong n_spills;
+      ULong n_reloads;
+      /* Number of reg-reg moves removed by coalescing. */
+      ULong n_moves_removed;
+   }
+   VexRegAllocStats;
+
+extern void LibVEX_GetRegAllocStats ( /*OUT*/VexRegAllocStats* stats );
+
+/* Instruction selector statistics, summed over all translations. */
+typedef
+   struct {
+      /* Number of blocks instruction-selected. */
+      ULong n_blocks;
+      /* Number of calls generated to helpers in host_generic_simd*.c
+         etc, for IR ops the host has no instructions for.  Only the
+         amd64 back end counts these so far. */
+      ULong n_helper_calls;
+   }
+   VexISelStats;
+
+extern void LibVEX_GetISelStats ( /*OUT*/VexISelStats* stats );
+
+/* Time spent in each phase of LibVEX_Translate, summed over the
+   translations made with a non-NULL VexTranslateArgs.read_clock, in
+   that function's units. */
+typedef
+   struct {
+      /* Number of translations timed. */
+      ULong n_translations;
+      /* Decoding guest code to IR, including self-check generation. */
+      ULong front_end;
+      /* The pre-instrumentation IR optimisation. */
+      ULong iropt;
+      /* The tool's instrumentation functions. */
+      ULong instrument;
+      /* Post-instrumentation cleanup and tree building. */
+      ULong tidy;
+      ULong isel;
+      ULong regalloc;
+      ULong assembly;
+   }
+   VexPhaseTimes;
+
+extern void LibVEX_GetPhaseTimes ( /*OUT*/VexPhaseTimes* times );
+
 /*-------------------------------------------------------*/
 /*-- IR injection                                      --*/
 /*-------------------------------------------------------*/
@@ -2049,7 +2049,11 @@ struct _IRExpr {
            particular order. The oder of evaluation is unspecified.
 
          This is restrictive, but makes the semantics clean, and does
-         not interfere with IR optimisation.
+         not interfere with IR optimisation.  In particular, a tool
+         helper which is a pure function of its arguments (an address
+         hash, say) should be called this way: a call that repeats an
+         earlier one with the same arguments is removed after
+         instrumentation, and one whose result is unused is dead code.
 
          If you want to call a helper which can mess with guest state
          and/or memory, instead use Ist_Dirty.  This is a lot more
@@ -2341,6 +2345,22 @@ typedef
          IRExpr_VECRET(), in both cases, at most once. */
       IRExpr**  args;   /* arg vector, ends in NULL. */
       IRTemp    tmp;    /* to assign result to, or IRTemp_INVALID if none */
+      /* A hint that the guard is expected to be almost always false.
+         Back ends may then make the call itself more expensive in
+         exchange for making its surroundings cheaper, for example by
+         having it preserve all allocatable registers. */
+      Bool      cold;
+      /* A hint that, once the call has been made, making it again
+         with the same args and guard, and with the guest state it
+         reads unchanged, has no effect worth keeping.  iropt may then
+         remove such repeats, which unrolled loops are full of.  If the
+         call assigns .tmp, the repeat must also return the same
+         result provided memory is unchanged -- a lookup in a tool's
+         shadow memory, for example -- and is only removed (and its
+         .tmp bound to the earlier call's) if no store, and no dirty
+         call that isn't itself marked idempotent or that says it
+         writes memory, comes in between. */
+      Bool      idempotent;
 
       /* Mem effects; we allow only one R/W/M region to be stated */
       IREffect  mFx;    /* indicates memory effects, if any */
@@ -2987,6 +3007,11 @@ typedef
 /* Allocate a new, uninitialised IRSB */
 extern IRSB* emptyIRSB ( void );
 
+/* Allocate a new, uninitialised IRSB with room for 'stmts_size'
+   statements before its statement array has to be grown.  Use this
+   when a block is built from another one of known size. */
+extern IRSB* emptyIRSBOfSize ( Int stmts_size );
+
 /* Deep-copy an IRSB */
 extern IRSB* deepCopyIRSB ( IRSB* );
 
@@ -45,11 +45,6 @@
    * Build this file for the host arch, not the target.  But how?
      Even Tromey had difficulty figuring out how to do that.
 
-   * Change the use of pread w/ fd to FILE*, for the file we're
-     serving.  Or, at least, put a loop around the pread uses
-     so that it works correctly in the case where pread reads more
-     than zero but less than we asked for.
-
    * CRC3 request/response: pass session-IDs back and forth and
      check them
 
@@ -109,11 +104,20 @@
 
 /*---------------------------------------------------------------*/
 
-/* The maximum allowable number concurrent connections. */
-#define M_CONNECTIONS 50
+/* The initial size of the connection table, which grows as needed,
+   and the backlog of connections waiting to be accepted. */
+#define M_CONNECTIONS 64
+
+/* The biggest READ or RDBL request allowed.  An RDBL response then
+   still fits in the 4MB limit on frames, even if the data does not
+   compress at all. */
+#define M_READ_SIZE   (2*1024*1024)
 
 static const char* clo_serverpath = ".";
 
+/* How many bytes the cache of compressed blocks may take. */
+static ULong clo_cache_size = 64 * 1024 * 1024;
+
 
 /*---------------------------------------------------------------*/
 
@@ -162,18 +166,25 @@ typedef
       // currently connected to any file.
       int   file_fd;
       ULong file_size;
+      // The identity of the file, which keys its blocks in the cache.
+      dev_t  file_dev;
+      ino_t  file_ino;
+      time_t file_mtime;
       // Session ID
       ULong session_id;
       // How many bytes and chunks sent?
       ULong stats_n_rdok_frames;
       ULong stats_n_read_unz_bytes; // bytes via READ (uncompressed)
       ULong stats_n_read_z_bytes;   // bytes via READ (compressed)
+      ULong stats_n_cache_hits;     // blocks found in the cache
    }
    ConnState;
 
-/* The state itself. */
-static int       conn_count = 0;
-static ConnState conn_state[M_CONNECTIONS];
+/* The state itself.  conn_state[0 .. conn_state_size-1] are the slots,
+   of which conn_count are in use. */
+static int        conn_count = 0;
+static ConnState* conn_state = NULL;
+static int        conn_state_size = 0;
 
 /* Issues unique session ID values. */
 static ULong next_session_id = 1;
@@ -478,6 +489,42 @@ static Bool parse_Frame_le64_le64_le64 ( Frame* fr, const HChar* tag,
    return True;
 }
 
+static Bool parse_Frame_le64_le64_le64_le64 ( Frame* fr, const HChar* tag,
+                                              /*OUT*/ULong* n1,
+                                              /*OUT*/ULong* n2,
+                                              /*OUT*/ULong* n3,
+                                              /*OUT*/ULong* n4 )
+{
+   assert(strlen(tag) == 4);
+   if (!fr || !fr->data) return False;
+   if (fr->n_data < 4) return False;
+   if (memcmp(&fr->data[0], tag, 4) != 0) return False;
+   if (fr->n_data != 4 + 4*8) return False;
+   *n1 = read_ULong_le(&fr->data[4 + 0*8]);
+   *n2 = read_ULong_le(&fr->data[4 + 1*8]);
+   *n3 = read_ULong_le(&fr->data[4 + 2*8]);
+   *n4 = read_ULong_le(&fr->data[4 + 3*8]);
+   return True;
+}
+
+static Frame* mk_Frame_le64_le64_le64_le64_bytes ( 
+                 const HChar* tag,
+                 ULong n1, ULong n2, ULong n3, ULong n4, ULong n_data,
+                 /*OUT*/UChar** data )
+{
+   assert(strlen(tag) == 4);
+   Frame* f = calloc(sizeof(Frame), 1);
+   f->n_data = 4 + 4*8 + n_data;
+   f->data = calloc(f->n_data, 1);
+   memcpy(&f->data[0], tag, 4);
+   write_ULong_le(&f->data[4 + 0*8], n1);
+   write_ULong_le(&f->data[4 + 1*8], n2);
+   write_ULong_le(&f->data[4 + 2*8], n3);
+   write_ULong_le(&f->data[4 + 3*8], n4);
+   *data = &f->data[4 + 4*8];
+   return f;
+}
+
 static Frame* mk_Frame_le64_le64_le64_bytes ( 
                  const HChar* tag,
                  ULong n1, ULong n2, ULong n3, ULong n_data,
@@ -655,6 +702,180 @@ static UInt calc_gnu_debuglink_crc32(/*OUT*/Bool* ok, int fd, ULong size)
    }
 
 
+/*---------------------------------------------------------------*/
+
+/*---------------------------------------------------------------*/
+
+/* A cache of compressed blocks, shared by all the connections.  When
+   many Valgrinds read the debuginfo of the same objects, only the
+   first to ask for a block makes the server read and compress it.
+   A block is keyed by the identity of its file (device, inode, size
+   and modification time, so that a file changed while being served
+   doesn't give out stale data) and by the range read from it.  The
+   blocks are kept on a list in least-recently-used order, and dropped
+   from its tail once they take up more than clo_cache_size bytes. */
+
+typedef
+   struct _ZBlock {
+      struct _ZBlock* hnext;     // next in the same hash chain
+      struct _ZBlock* lru_prev;  // more recently used
+      struct _ZBlock* lru_next;  // less recently used
+      dev_t  dev;
+      ino_t  ino;
+      time_t mtime;
+      ULong  size;
+      ULong  off;
+      ULong  len;
+      UInt   zlen;
+      UChar* zdata;
+   }
+   ZBlock;
+
+#define N_ZBLOCK_HASH 65536
+
+static ZBlock* zblock_hash[N_ZBLOCK_HASH];
+static ZBlock* zblock_lru_head = NULL;
+static ZBlock* zblock_lru_tail = NULL;
+static ULong   zblock_bytes    = 0;
+
+static ULong stats_n_cache_hits   = 0;
+static ULong stats_n_cache_misses = 0;
+
+static UInt zblock_hash_of ( dev_t dev, ino_t ino, ULong off, ULong len )
+{
+   ULong h = (ULong)ino * 0x9E3779B97F4A7C15ULL;
+   h ^= (ULong)dev + (off >> 12) * 31 + len;
+   h *= 0x9E3779B97F4A7C15ULL;
+   return (UInt)(h >> 48) & (N_ZBLOCK_HASH - 1);
+}
+
+static void zblock_lru_unlink ( ZBlock* zb )
+{
+   if (zb->lru_prev) zb->lru_prev->lru_next = zb->lru_next;
+   else              zblock_lru_head        = zb->lru_next;
+   if (zb->lru_next) zb->lru_next->lru_prev = zb->lru_prev;
+   else              zblock_lru_tail        = zb->lru_prev;
+   zb->lru_prev = zb->lru_next = NULL;
+}
+
+static void zblock_lru_push ( ZBlock* zb )
+{
+   zb->lru_prev = NULL;
+   zb->lru_next = zblock_lru_head;
+   if (zblock_lru_head) zblock_lru_head->lru_prev = zb;
+   else                 zblock_lru_tail           = zb;
+   zblock_lru_head = zb;
+}
+
+static ZBlock* zblock_lookup ( const ConnState* cs, ULong off, ULong len )
+{
+   UInt    h  = zblock_hash_of(cs->file_dev, cs->file_ino, off, len);
+   ZBlock* zb = zblock_hash[h];
+   for (; zb; zb = zb->hnext) {
+      if (zb->off == off && zb->len == len && zb->ino == cs->file_ino
+          && zb->dev == cs->file_dev && zb->mtime == cs->file_mtime
+          && zb->size == cs->file_size)
+         break;
+   }
+   if (zb && zb != zblock_lru_head) {
+      zblock_lru_unlink(zb);
+      zblock_lru_push(zb);
+   }
+   return zb;
+}
+
+/* Drop blocks from the tail of the list until the cache is within its
+   size again.  The most recently used block always stays, since the
+   caller is about to send it. */
+static void zblock_trim ( void )
+{
+   while (zblock_bytes > clo_cache_size
+          && zblock_lru_tail != zblock_lru_head) {
+      ZBlock*  zb = zblock_lru_tail;
+      ZBlock** pp = &zblock_hash[zblock_hash_of(zb->dev, zb->ino,
+                                                  zb->off, zb->len)];
+      while (*pp != zb)
+         pp = &(*pp)->hnext;
+      *pp = zb->hnext;
+      zblock_lru_unlink(zb);
+      zblock_bytes -= sizeof(ZBlock) + zb->zlen;
+      free(zb->zdata);
+      free(zb);
+   }
+}
+
+/* Find [off, +len) of the file conn_state[conn_no] is connected to in
+   the cache, or read and compress it and add it there.  The block
+   stays valid until the next call.  Returns NULL, with *why set, if
+   it can't be had. */
+static const ZBlock* get_zblock ( int conn_no, ULong off, ULong len,
+                                  /*OUT*/const char** why )
+{
+   ConnState* cs = &conn_state[conn_no];
+   ZBlock*    zb = zblock_lookup(cs, off, len);
+
+   if (zb) {
+      stats_n_cache_hits++;
+      cs->stats_n_cache_hits++;
+      return zb;
+   }
+   stats_n_cache_misses++;
+
+   /* First, allocate a temp buf and read from the file into it. */
+   UChar* unzBuf = malloc(len);
+   SizeT  nRead  = 0;
+   while (nRead < len) {
+      ssize_t n = pread(cs->file_fd, unzBuf + nRead, len - nRead,
+                        off + nRead);
+      if (n <= 0) break;
+      nRead += n;
+   }
+   if (nRead != len) {
+      free(unzBuf);
+      *why = "I/O error reading file";
+      return NULL;
+   }
+
+   // Now compress it with LZO.  LZO appears to recommend
+   // the worst-case output size as (in_len + in_len / 16 + 67).
+   // Be more conservative here.
+#  define STACK_ALLOC(var,size) \
+      lzo_align_t __LZO_MMODEL \
+         var [ ((size) \
+               + (sizeof(lzo_align_t) - 1)) / sizeof(lzo_align_t) ]
+   STACK_ALLOC(wrkmem, LZO1X_1_MEM_COMPRESS);
+#  undef STACK_ALLOC
+   UInt zLenMax = len + len / 4 + 1024;
+   UChar* zBuf = malloc(zLenMax);
+   lzo_uint zLen = zLenMax;
+   Int lzo_rc = lzo1x_1_compress(unzBuf, len, zBuf, &zLen, wrkmem);
+   free(unzBuf);
+   if (lzo_rc != LZO_E_OK) {
+      free(zBuf);
+      *why = "LZO failed";
+      return NULL;
+   }
+   assert(zLen <= zLenMax);
+
+   zb = calloc(sizeof(ZBlock), 1);
+   zb->dev   = cs->file_dev;
+   zb->ino   = cs->file_ino;
+   zb->mtime = cs->file_mtime;
+   zb->size  = cs->file_size;
+   zb->off   = off;
+   zb->len   = len;
+   zb->zlen  = zLen;
+   zb->zdata = realloc(zBuf, zLen > 0 ? zLen : 1);
+   UInt h = zblock_hash_of(cs->file_dev, cs->file_ino, off, len);
+   zb->hnext = zblock_hash[h];
+   zblock_hash[h] = zb;
+   zblock_lru_push(zb);
+   zblock_bytes += sizeof(ZBlock) + zLen;
+   zblock_trim();
+   return zb;
+}
+
+
 /*---------------------------------------------------------------*/
 
 /* Handle a transaction for conn_state[conn_no].  There is incoming
@@ -708,7 +929,7 @@ static Bool handle_transaction ( int conn_no )
    assert(res == NULL);
 
    UChar* filename = NULL;
-   ULong req_session_id = 0, req_offset = 0, req_len = 0;
+   ULong req_session_id = 0, req_offset = 0, req_len = 0, req_blksz = 0;
 
    if (parse_Frame_noargs(req, "VERS")) {
       res = mk_Frame_asciiz("VEOK", "Valgrind Debuginfo Server, Version 1");
@@ -762,8 +983,11 @@ static Bool handle_transaction ( int conn_no )
             ok = False;
          }
          if (ok) {
-            conn_state[conn_no].file_fd   = fd;
-            conn_state[conn_no].file_size = stat_buf.st_size;
+            conn_state[conn_no].file_fd    = fd;
+            conn_state[conn_no].file_size  = stat_buf.st_size;
+            conn_state[conn_no].file_dev   = stat_buf.st_dev;
+            conn_state[conn_no].file_ino   = stat_buf.st_ino;
+            conn_state[conn_no].file_mtime = stat_buf.st_mtime;
             assert(res == NULL);
             res = mk_Frame_le64_le64("OPOK", conn_state[conn_no].session_id,
                                              conn_state[conn_no].file_size);
@@ -791,7 +1015,7 @@ static Bool handle_transaction ( int conn_no )
          res = mk_Frame_asciiz("FAIL", "READ: no associated file");
          ok = False;
       }
-      if (ok && (req_len == 0 || req_len > 4*1024*1024)) {
+      if (ok && (req_len == 0 || req_len > M_READ_SIZE)) {
          res = mk_Frame_asciiz("FAIL", "READ: invalid request size");
          ok = False;
       }
@@ -799,57 +1023,91 @@ static Bool handle_transaction ( int conn_no )
          res = mk_Frame_asciiz("FAIL", "READ: request exceeds file size");
          ok = False;
       }
-      /* Try to read the file. */
+      /* Get the data, compressed with LZO. */
       if (ok) {
-         /* First, allocate a temp buf and read from the file into it. */
-         /* FIXME: what if pread reads short and we have to redo it? */
-         UChar* unzBuf = malloc(req_len);
-         size_t nRead = pread(conn_state[conn_no].file_fd,
-                              unzBuf, req_len, req_offset);
-         if (nRead != req_len) {
-            free_Frame(res);
-            res = mk_Frame_asciiz("FAIL", "READ: I/O error reading file");
-            ok = False;
-         }         
-         if (ok) {
-            // Now compress it with LZO.  LZO appears to recommend
-            // the worst-case output size as (in_len + in_len / 16 + 67).
-            // Be more conservative here.
-#           define STACK_ALLOC(var,size) \
-               lzo_align_t __LZO_MMODEL \
-                  var [ ((size) \
-                        + (sizeof(lzo_align_t) - 1)) / sizeof(lzo_align_t) ]
-            STACK_ALLOC(wrkmem, LZO1X_1_MEM_COMPRESS);
-#           undef STACK_ALLOC
-            UInt zLenMax = req_len + req_len / 4 + 1024;
-            UChar* zBuf = malloc(zLenMax);
-            lzo_uint zLen = zLenMax;
-            Int lzo_rc = lzo1x_1_compress(unzBuf, req_len,
-                                          zBuf, &zLen, wrkmem); 
-            if (lzo_rc == LZO_E_OK) {
-              //printf("XXXXX req_len %u  zLen %u\n", (UInt)req_len, (UInt)zLen);
-               assert(zLen <= zLenMax);
-               /* Make a frame to put the results in.  Bytes 24 and
-                  onwards need to be filled from the compressed data,
-                  and 'buf' is set to point to the right bit. */
-               UChar* buf = NULL;
-               res = mk_Frame_le64_le64_le64_bytes
-                 ("RDOK", req_session_id, req_offset, req_len, zLen, &buf);
-               assert(res);
-               assert(buf);
-               memcpy(buf, zBuf, zLen);
-               // Update stats
-               conn_state[conn_no].stats_n_rdok_frames++;
-               conn_state[conn_no].stats_n_read_unz_bytes += req_len;
-               conn_state[conn_no].stats_n_read_z_bytes   += zLen;
-            } else {
-               ok = False;
+         const char*   why = NULL;
+         const ZBlock* zb  = get_zblock(conn_no, req_offset, req_len, &why);
+         if (zb) {
+            /* Make a frame to put the results in.  Bytes 24 and
+               onwards need to be filled from the compressed data,
+               and 'buf' is set to point to the right bit. */
+            UChar* buf = NULL;
+            res = mk_Frame_le64_le64_le64_bytes
+              ("RDOK", req_session_id, req_offset, req_len, zb->zlen, &buf);
+            assert(res);
+            assert(buf);
+            memcpy(buf, zb->zdata, zb->zlen);
+            // Update stats
+            conn_state[conn_no].stats_n_rdok_frames++;
+            conn_state[conn_no].stats_n_read_unz_bytes += req_len;
+            conn_state[conn_no].stats_n_read_z_bytes   += zb->zlen;
+         } else {
+            char msg[100];
+            snprintf(msg, sizeof(msg), "READ: %s", why);
+            res = mk_Frame_asciiz("FAIL", msg);
+         }
+      }
+   }
+   else
+   if (parse_Frame_le64_le64_le64_le64(req, "RDBL", &req_session_id,
+                                       &req_offset, &req_len, &req_blksz)) {
+      /* Read [req_offset, +req_len) as a run of req_blksz blocks,
+         each compressed, and cached, by itself.  The response has the
+         four values from the request, and then for each block its
+         compressed length (le32) and the compressed data. */
+      Bool ok = True;
+      if (req_session_id != conn_state[conn_no].session_id) {
+         res = mk_Frame_asciiz("FAIL", "RDBL: invalid session ID");
+         ok = False;
+      }
+      if (ok && conn_state[conn_no].file_fd == 0) {
+         res = mk_Frame_asciiz("FAIL", "RDBL: no associated file");
+         ok = False;
+      }
+      if (ok && (req_len == 0 || req_len > M_READ_SIZE
+                 || req_blksz < 1024 || req_blksz > M_READ_SIZE)) {
+         res = mk_Frame_asciiz("FAIL", "RDBL: invalid request size");
+         ok = False;
+      }
+      if (ok && req_len + req_offset > conn_state[conn_no].file_size) {
+         res = mk_Frame_asciiz("FAIL", "RDBL: request exceeds file size");
+         ok = False;
+      }
+      if (ok) {
+         ULong  n_blocks = (req_len + req_blksz - 1) / req_blksz;
+         ULong  maxLen   = req_len + req_len / 4 + n_blocks * (4 + 1024);
+         UChar* buf      = NULL;
+         ULong  used     = 0, i;
+         res = mk_Frame_le64_le64_le64_le64_bytes
+                  ("RBOK", req_session_id, req_offset, req_len, req_blksz,
+                   maxLen, &buf);
+         for (i = 0; i < n_blocks; i++) {
+            ULong off = req_offset + i * req_blksz;
+            ULong len = req_len - i * req_blksz;
+            const char*   why = NULL;
+            const ZBlock* zb;
+            if (len > req_blksz)
+               len = req_blksz;
+            zb = get_zblock(conn_no, off, len, &why);
+            if (!zb) {
+               char msg[100];
+               snprintf(msg, sizeof(msg), "RDBL: %s", why);
                free_Frame(res);
-               res = mk_Frame_asciiz("FAIL", "READ: LZO failed");
+               res = mk_Frame_asciiz("FAIL", msg);
+               ok = False;
+               break;
             }
-            free(zBuf);
+            assert(used + 4 + zb->zlen <= maxLen);
+            write_UInt_le(&buf[used], zb->zlen);
+            memcpy(&buf[used + 4], zb->zdata, zb->zlen);
+            used += 4 + zb->zlen;
+            conn_state[conn_no].stats_n_read_z_bytes += zb->zlen;
+         }
+         if (ok) {
+            res->n_data = 4 + 4*8 + used;
+            conn_state[conn_no].stats_n_rdok_frames++;
+            conn_state[conn_no].stats_n_read_unz_bytes += req_len;
          }
-         free(unzBuf);
       }
    }
    else {
@@ -898,13 +1156,15 @@ static Bool handle_transaction ( int conn_no )
 
    if (conn_state[conn_no].stats_n_rdok_frames > 0) {
       printf("(%d) SessionID %llu:   sent %llu frames, "
-             "%llu MB (unz), %llu MB (z), ratio %4.2f:1\n",
+             "%llu MB (unz), %llu MB (z), ratio %4.2f:1, "
+             "%llu blocks from the cache\n",
              conn_count, conn_state[conn_no].session_id,
              conn_state[conn_no].stats_n_rdok_frames,
              conn_state[conn_no].stats_n_read_unz_bytes / 1000000,
              conn_state[conn_no].stats_n_read_z_bytes / 1000000,
              (double)conn_state[conn_no].stats_n_read_unz_bytes
-               / (double)conn_state[conn_no].stats_n_read_z_bytes);
+               / (double)conn_state[conn_no].stats_n_read_z_bytes,
+             conn_state[conn_no].stats_n_cache_hits);
       printf("(%d) SessionID %llu: closed\n",
              conn_count, conn_state[conn_no].session_id);
 
@@ -991,18 +1251,23 @@ static void usage ( void )
       "\n"
       "usage is:\n"
       "\n"
-      "   valgrind-di-server [--exit-at-zero|-e] [port-number]\n"
+      "   valgrind-di-server [--exit-at-zero|-e] [--cache-size=<MB>]\n"
+      "                      [port-number]\n"
       "\n"
       "   where   --exit-at-zero or -e causes the listener to exit\n"
       "           when the number of connections falls back to zero\n"
       "           (the default is to keep listening forever)\n"
       "\n"
+      "           --cache-size=<MB> is how much memory the compressed\n"
+      "           blocks, shared by all connections, may take.\n"
+      "           Current default is %llu.\n"
+      "\n"
       "           port-number is the default port on which to listen for\n"
       "           connections.  It must be between 1024 and 65535.\n"
       "           Current default is %d.\n"
       "\n"
       ,
-      VG_CLO_DEFAULT_LOGPORT
+      clo_cache_size / (1024 * 1024), VG_CLO_DEFAULT_LOGPORT
    );
    exit(1);
 }
@@ -1019,6 +1284,12 @@ static void banner ( const char* str )
 
 static void exit_routine ( void )
 {
+   if (stats_n_cache_hits + stats_n_cache_misses > 0) {
+      printf("cache: %llu blocks found, %llu read and compressed; "
+             "%llu MB held\n",
+             stats_n_cache_hits, stats_n_cache_misses,
+             zblock_bytes / 1000000);
+   }
    banner("exited");
    exit(0);
 }
@@ -1046,6 +1317,14 @@ int main (int argc, char** argv)
          exit_when_zero = 1;
       }
       else
+      if (0==strncmp(argv[i], "--cache-size=", 13)) {
+         char* end;
+         unsigned long mb = strtoul(argv[i] + 13, &end, 10);
+         if (end == argv[i] + 13 || *end != 0 || mb > 1024*1024)
+            usage();
+         clo_cache_size = (ULong)mb * 1024 * 1024;
+      }
+      else
       if (atoi_portno(argv[i]) > 0) {
          port = atoi_portno(argv[i]);
       }
@@ -1056,8 +1335,15 @@ int main (int argc, char** argv)
    banner("started");
    signal(SIGINT, sigint_handler);
 
-   conn_count = 0;
-   memset(&conn_state, 0, sizeof(conn_state));
+   conn_count      = 0;
+   conn_state_size = M_CONNECTIONS;
+   conn_state      = calloc(conn_state_size, sizeof(ConnState));
+   struct pollfd* tmp_pollfd
+      = calloc(conn_state_size + 1, sizeof(struct pollfd));
+   /* And a parallel array which maps entries in tmp_pollfd back to
+      entries in conn_state. */
+   int* tmp_pollfd_to_conn_state
+      = calloc(conn_state_size + 1, sizeof(int));
 
    /* create socket */
    main_sd = socket(AF_INET, SOCK_STREAM, 0);
@@ -1121,16 +1407,27 @@ int main (int argc, char** argv)
               panic("main -- accept connection");
            }
 
-           /* find a place to put it. */
+           /* find a place to put it, making more if need be. */
 	   assert(new_sd > 0);
-           for (i = 0; i < M_CONNECTIONS; i++)
+           for (i = 0; i < conn_state_size; i++)
               if (!conn_state[i].in_use)
                  break;
 
-           if (i >= M_CONNECTIONS) {
-              fprintf(stderr, "Too many concurrent connections.  "
-                              "Increase M_CONNECTIONS and recompile.\n");
-              panic("main -- too many concurrent connections");
+           if (i >= conn_state_size) {
+              int old_size = conn_state_size;
+              conn_state_size *= 2;
+              conn_state = realloc(conn_state,
+                                   conn_state_size * sizeof(ConnState));
+              tmp_pollfd = realloc(tmp_pollfd, (conn_state_size + 1)
+                                               * sizeof(struct pollfd));
+              tmp_pollfd_to_conn_state
+                 = realloc(tmp_pollfd_to_conn_state,
+                           (conn_state_size + 1) * sizeof(int));
+              if (!conn_state || !tmp_pollfd || !tmp_pollfd_to_conn_state)
+                 panic("main -- out of memory for connections");
+              memset(&conn_state[old_size], 0,
+                     (conn_state_size - old_size) * sizeof(ConnState));
+              assert(i == old_size);
            }
 
 assert(one == 1);
@@ -1150,13 +1447,15 @@ assert(ret != -1);
 
       /* We've processed all new connect requests.  Listen for changes
          to the current set of fds.  This requires gathering up all
-         the known conn_sd values and doing poll() on them. */
-      struct pollfd tmp_pollfd[M_CONNECTIONS];
-      /* And a parallel array which maps entries in tmp_pollfd back to
-         entries in conn_state. */
-      int tmp_pollfd_to_conn_state[M_CONNECTIONS];
-      j = 0;
-      for (i = 0; i < M_CONNECTIONS; i++) {
+         the known conn_sd values and doing poll() on them.  The main
+         socket descriptor goes in too, so that poll() can wait for
+         whichever comes first, a request or a new connection. */
+      tmp_pollfd[0].fd      = main_sd;
+      tmp_pollfd[0].events  = POLLIN;
+      tmp_pollfd[0].revents = 0;
+      tmp_pollfd_to_conn_state[0] = -1;
+      j = 1;
+      for (i = 0; i < conn_state_size; i++) {
          if (!conn_state[i].in_use)
             continue;
          assert(conn_state[i].conn_sd > 2);
@@ -1167,7 +1466,7 @@ assert(ret != -1);
          j++;
       }
 
-      res = poll(tmp_pollfd, j, 20/*ms*/ /* 0=return immediately. */ );
+      res = poll(tmp_pollfd, j, -1/*wait for something to happen*/);
       if (res < 0) {
          perror("poll(main) failed");
          panic("poll(main) failed");
@@ -1178,10 +1477,11 @@ assert(ret != -1);
          continue;
       }
 
-      /* inspect the fds. */
-      for (i = 0; i < j; i++) {
+      /* inspect the fds.  A new connection on tmp_pollfd[0] is taken
+         at the top of the loop. */
+      for (i = 1; i < j; i++) {
  
-         if (tmp_pollfd[i].revents & POLLIN) {
+         if (tmp_pollfd[i].revents & (POLLIN | POLLHUP | POLLERR)) {
             /* We have some activity on tmp_pollfd[i].  We need to
                figure out which conn_state[] entry that corresponds
                to, which is what tmp_pollfd_to_conn_state is for. */
@@ -1199,8 +1499,8 @@ assert(ret != -1);
 	       }
             } else {
                // maybe show stats
-               if (conn_state[i].stats_n_rdok_frames > 0
-                   && (conn_state[i].stats_n_rdok_frames % 1000) == 0) {
+               if (conn_state[conn_no].stats_n_rdok_frames > 0
+                   && (conn_state[conn_no].stats_n_rdok_frames % 1000) == 0) {
                   printf("(%d) SessionID %llu:   sent %llu frames, "
                          "%llu MB (unz), %llu MB (z)\n",
                          conn_count, conn_state[conn_no].session_id,
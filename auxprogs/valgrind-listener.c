@@ -47,18 +47,38 @@
 #include <string.h>
 #include <time.h>
 #include <fcntl.h>
+#include <errno.h>
 #include <stdlib.h>
 #include <signal.h>
 #include <sys/poll.h>
 #include <sys/types.h>
+#include <sys/wait.h>
 #include <sys/socket.h>
 #include <netinet/in.h>
+#include <arpa/inet.h>
 
 
 /*---------------------------------------------------------------*/
 
-/* The maximum allowable number concurrent connections. */
-#define M_CONNECTIONS 50
+/* The initial size of the connection table, which grows as needed,
+   and the backlog of connections waiting to be accepted. */
+#define M_CONNECTIONS 64
+
+/* How much is read from a connection at a time. */
+#define READ_SIZE     (64 * 1024)
+
+/* A line longer than this is written out in pieces. */
+#define M_LINE        (64 * 1024)
+
+/* The buffer size for each output file. */
+#define OUT_BUF_SIZE  (256 * 1024)
+
+/* --output-dir: write each connection's output to its own file in
+   this directory, rather than all of it to stdout. */
+static const char* clo_output_dir = NULL;
+
+/* --gzip: compress those files. */
+static char /*bool*/ clo_gzip = 0;
 
 
 /*---------------------------------------------------------------*/
@@ -96,10 +116,28 @@ static void my_assert_fail ( const char* expr, const char* file, int line, const
 
 /*---------------------------------------------------------------*/
 
-/* holds the fds for connections; zero if slot not in use. */
-int conn_count = 0;
-int           conn_fd[M_CONNECTIONS];
-struct pollfd conn_pollfd[M_CONNECTIONS];
+/* The state of a connection.  Its output is written a line at a
+   time, so that lines from different connections don't get mixed
+   up; an unfinished line waits in 'partial' for the rest of it. */
+typedef
+   struct {
+      int   fd;          // zero if this slot is not in use
+      FILE* out;         // stdout, or this connection's own file
+      pid_t gzip_pid;    // if 'out' is a pipe to gzip, its pid, else 0
+      char  dirty;       // written to 'out' since it was last flushed?
+      char* partial;
+      int   n_partial;
+   }
+   Conn;
+
+static int   conn_count = 0;
+static Conn* conns      = NULL;
+static int   conns_size = 0;
+
+/* Numbers the connections, for the names of their files. */
+static unsigned long long next_conn_id = 1;
+
+static char stdout_dirty = 0;
 
 
 static void set_nonblocking ( int sd )
@@ -113,57 +151,148 @@ static void set_nonblocking ( int sd )
    }
 }
 
-static void set_blocking ( int sd )
+/* Keep the fd from gzip children, so that only the listener holds
+   the write end of each pipe to a gzip. */
+static void set_cloexec ( int fd )
 {
-   int res;
-   res = fcntl(sd, F_GETFL);
-   res = fcntl(sd, F_SETFL, res & ~O_NONBLOCK);
-   if (res != 0) {
+   if (fcntl(fd, F_SETFD, FD_CLOEXEC) != 0) {
       perror("fcntl failed");
-      panic("set_blocking");
+      panic("set_cloexec");
    }
 }
 
 
-static void copyout ( char* buf, int nbuf )
+/* Open 'path' for a connection's output, through gzip if need be. */
+static FILE* open_output ( const char* path, /*OUT*/pid_t* gzip_pid )
 {
-   int i;
-   for (i = 0; i < nbuf; i++) {
-      if (buf[i] == '\n') {
-         fprintf(stdout, "\n(%d) ", conn_count);
-      } else {
-         __attribute__((unused)) size_t ignored 
-            = fwrite(&buf[i], 1, 1, stdout);
+   int   fd, pfd[2];
+   FILE* f;
+
+   *gzip_pid = 0;
+   fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+   if (fd < 0) {
+      perror(path);
+      return NULL;
+   }
+   set_cloexec(fd);
+   if (!clo_gzip) {
+      f = fdopen(fd, "w");
+   } else {
+      if (pipe(pfd) != 0) {
+         perror("pipe failed");
+         close(fd);
+         return NULL;
+      }
+      set_cloexec(pfd[1]);
+      *gzip_pid = fork();
+      if (*gzip_pid < 0) {
+         perror("fork failed");
+         panic("open_output -- fork");
       }
+      if (*gzip_pid == 0) {
+         dup2(pfd[0], 0);
+         dup2(fd, 1);
+         execlp("gzip", "gzip", "-c", (char*)NULL);
+         perror("cannot run gzip");
+         _exit(1);
+      }
+      close(pfd[0]);
+      close(fd);
+      f = fdopen(pfd[1], "w");
    }
-   fflush(stdout);
+   if (f == NULL)
+      panic("open_output -- fdopen");
+   setvbuf(f, NULL, _IOFBF, OUT_BUF_SIZE);
+   return f;
 }
 
-static int read_from_sd ( int sd )
+static void close_output ( Conn* c )
 {
-   char buf[100];
-   int n;
+   if (c->out == stdout)
+      return;
+   fclose(c->out);
+   if (c->gzip_pid > 0)
+      waitpid(c->gzip_pid, NULL, 0);
+   c->out = NULL;
+}
 
-   set_blocking(sd);
-   n = read(sd, buf, 99);
-   if (n <= 0) return 0; /* closed */
-   copyout(buf, n);
 
-   set_nonblocking(sd);
-   while (1) {
-      n = read(sd, buf, 100);
-      if (n <= 0) return 1; /* not closed */
-      copyout(buf, n);
+/* Write one line of connection 'c's output, adding the number of
+   connections in front when it goes to stdout. */
+static void put_line ( Conn* c, const char* line, int len )
+{
+   if (c->out == stdout) {
+      printf("(%d) ", conn_count);
+      stdout_dirty = 1;
+   }
+   __attribute__((unused)) size_t ignored
+      = fwrite(line, 1, len, c->out);
+   putc('\n', c->out);
+   c->dirty = 1;
+}
+
+/* Pass on the complete lines in buf[0 .. n-1], keeping the rest for
+   next time. */
+static void copyout ( Conn* c, const char* buf, int n )
+{
+   while (n > 0) {
+      const char* nl  = memchr(buf, '\n', n);
+      int         len = nl ? nl - buf : n;
+
+      if (nl && c->n_partial == 0) {
+         put_line(c, buf, len);
+      } else {
+         int room = M_LINE - c->n_partial;
+         int take = len < room ? len : room;
+         memcpy(c->partial + c->n_partial, buf, take);
+         c->n_partial += take;
+         if (nl || c->n_partial == M_LINE) {
+            put_line(c, c->partial, c->n_partial);
+            c->n_partial = 0;
+         }
+         len = take;
+      }
+      if (nl && len == nl - buf)
+         len++;   /* and the newline */
+      buf += len;
+      n   -= len;
    }
 }
 
+/* Read what there is from connection 'c'.  Returns 0 if it has been
+   closed.  To be fair to the others, at most a few reads' worth is
+   taken each time round. */
+static int read_from_conn ( Conn* c )
+{
+   static char buf[READ_SIZE];
+   int i, n;
+
+   for (i = 0; i < 4; i++) {
+      n = read(c->fd, buf, sizeof(buf));
+      if (n == 0)
+         return 0; /* closed */
+      if (n < 0)
+         return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+      copyout(c, buf, n);
+      if (n < sizeof(buf))
+         break;
+   }
+   return 1;
+}
 
-static void snooze ( void )
+/* Write out what has been buffered.  Done whenever there is nothing
+   more to read, so the output is never much behind. */
+static void flush_outputs ( void )
 {
-   struct timespec req;
-   req.tv_sec = 0;
-   req.tv_nsec = 200 * 1000 * 1000;
-   nanosleep(&req,NULL);
+   int i;
+   for (i = 0; i < conns_size; i++) {
+      if (conns[i].fd != 0 && conns[i].dirty && conns[i].out != stdout)
+         fflush(conns[i].out);
+      conns[i].dirty = 0;
+   }
+   if (stdout_dirty)
+      fflush(stdout);
+   stdout_dirty = 0;
 }
 
 
@@ -193,12 +322,19 @@ static void usage ( void )
       "\n"
       "usage is:\n"
       "\n"
-      "   valgrind-listener [--exit-at-zero|-e] [port-number]\n"
+      "   valgrind-listener [--exit-at-zero|-e] [--output-dir=<dir>]\n"
+      "                     [--gzip] [port-number]\n"
       "\n"
       "   where   --exit-at-zero or -e causes the listener to exit\n"
       "           when the number of connections falls back to zero\n"
       "           (the default is to keep listening forever)\n"
       "\n"
+      "           --output-dir=<dir> writes the output of each\n"
+      "           connection to its own file in <dir>, rather than\n"
+      "           all of it to stdout\n"
+      "\n"
+      "           --gzip compresses those files with gzip\n"
+      "\n"
       "           port-number is the default port on which to listen for\n"
       "           connections.  It must be between 1024 and 65535.\n"
       "           Current default is %d.\n"
@@ -221,6 +357,14 @@ static void banner ( const char* str )
 
 static void exit_routine ( void )
 {
+   int i;
+   for (i = 0; i < conns_size; i++) {
+      if (conns[i].fd == 0)
+         continue;
+      if (conns[i].n_partial > 0)
+         put_line(&conns[i], conns[i].partial, conns[i].n_partial);
+      close_output(&conns[i]);
+   }
    banner("exited");
    exit(0);
 }
@@ -232,9 +376,71 @@ static void sigint_handler ( int signo )
 }
 
 
+/* Take a new connection on sd, from the client at 'addr'. */
+static void add_conn ( int new_sd, const struct sockaddr_in* addr )
+{
+   int   i;
+   Conn* c;
+   char  path[1000];
+
+   /* find a place to put it, making more if need be. */
+   for (i = 0; i < conns_size; i++)
+      if (conns[i].fd == 0)
+         break;
+   if (i >= conns_size) {
+      conns_size *= 2;
+      conns = realloc(conns, conns_size * sizeof(Conn));
+      if (conns == NULL)
+         panic("add_conn -- out of memory");
+      memset(&conns[i], 0, (conns_size - i) * sizeof(Conn));
+   }
+
+   c = &conns[i];
+   c->fd        = new_sd;
+   c->out       = stdout;
+   c->gzip_pid  = 0;
+   c->dirty     = 0;
+   c->n_partial = 0;
+   if (c->partial == NULL)
+      c->partial = malloc(M_LINE);
+   set_nonblocking(new_sd);
+   set_cloexec(new_sd);
+   conn_count++;
+
+   printf("\n(%d) -------------------- CONNECT "
+          "--------------------\n(%d)\n", conn_count, conn_count);
+   if (clo_output_dir) {
+      snprintf(path, sizeof(path), "%s/valgrind-%llu-%s.log%s",
+               clo_output_dir, next_conn_id, inet_ntoa(addr->sin_addr),
+               clo_gzip ? ".gz" : "");
+      c->out = open_output(path, &c->gzip_pid);
+      if (c->out == NULL)
+         c->out = stdout;
+      else
+         printf("(%d) writing to %s\n(%d)\n", conn_count, path, conn_count);
+   }
+   next_conn_id++;
+   stdout_dirty = 1;
+}
+
+static void remove_conn ( Conn* c )
+{
+   if (c->n_partial > 0)
+      put_line(c, c->partial, c->n_partial);
+   c->n_partial = 0;
+   close(c->fd);
+   close_output(c);
+   c->fd = 0;
+   conn_count--;
+   printf("(%d) ------------------- DISCONNECT "
+          "-------------------\n(%d)\n", conn_count, conn_count);
+   stdout_dirty = 1;
+}
+
+
 int main (int argc, char** argv) 
 {
-   int    i, j, k, res, one;
+   int    i, j, res, one;
    int    main_sd, new_sd;
    socklen_t client_len;
    struct sockaddr_in client_addr, server_addr;
@@ -248,19 +454,36 @@ int main (int argc, char** argv)
          exit_when_zero = 1;
       }
       else
+      if (0==strncmp(argv[i], "--output-dir=", 13) && argv[i][13] != 0) {
+         clo_output_dir = argv[i] + 13;
+      }
+      else
+      if (0==strcmp(argv[i], "--gzip")) {
+         clo_gzip = 1;
+      }
+      else
       if (atoi_portno(argv[i]) > 0) {
          port = atoi_portno(argv[i]);
       }
       else
       usage();
    }
+   if (clo_gzip && !clo_output_dir)
+      usage();
 
+   setvbuf(stdout, NULL, _IOFBF, OUT_BUF_SIZE);
    banner("started");
    signal(SIGINT, sigint_handler);
+   /* A gzip that has died shouldn't take the listener with it. */
+   signal(SIGPIPE, SIG_IGN);
 
    conn_count = 0;
-   for (i = 0; i < M_CONNECTIONS; i++)
-      conn_fd[i] = 0;
+   conns_size = M_CONNECTIONS;
+   conns      = calloc(conns_size, sizeof(Conn));
+   /* The fds to poll: the main socket descriptor, then those of the
+      connections, whose slots are given by the parallel array. */
+   struct pollfd* pollfds   = calloc(conns_size + 1, sizeof(struct pollfd));
+   int*           poll_conn = calloc(conns_size + 1, sizeof(int));
 
    /* create socket */
    main_sd = socket(AF_INET, SOCK_STREAM, 0);
@@ -294,106 +517,79 @@ int main (int argc, char** argv)
       perror("listen failed ");
       panic("main -- listen");
    }
-  
-   while (1) {
+   set_nonblocking(main_sd);
+   set_cloexec(main_sd);
 
-      snooze();
-
-      /* enquire, using poll, whether there is any activity available on
-         the main socket descriptor.  If so, someone is trying to
-         connect; get the fd and add it to our table thereof. */
-      { struct pollfd ufd;
-        while (1) {
-           ufd.fd = main_sd;
-           ufd.events = POLLIN;
-           ufd.revents = 0;
-           res = poll(&ufd, 1, 0);
-           if (res == 0) break;
-
-           /* ok, we have someone waiting to connect.  Get the sd. */
-           client_len = sizeof(client_addr);
-           new_sd = accept(main_sd, (struct sockaddr *)&client_addr, 
-                                                       &client_len);
-           if (new_sd < 0) {
-              perror("cannot accept connection ");
-              panic("main -- accept connection");
-           }
-
-           /* find a place to put it. */
-	   assert(new_sd > 0);
-           for (i = 0; i < M_CONNECTIONS; i++)
-              if (conn_fd[i] == 0) 
-                 break;
-
-           if (i >= M_CONNECTIONS) {
-              fprintf(stderr, "Too many concurrent connections.  "
-                              "Increase M_CONNECTIONS and recompile.\n");
-              panic("main -- too many concurrent connections");
-           }
-
-           conn_fd[i] = new_sd;
-           conn_count++;
-	   printf("\n(%d) -------------------- CONNECT "
-                  "--------------------\n(%d)\n(%d) ", 
-                  conn_count, conn_count, conn_count);
-           fflush(stdout);
-        } /* while (1) */
-      }
+   while (1) {
 
-      /* We've processed all new connect requests.  Listen for changes
-         to the current set of fds. */
-      j = 0;
-      for (i = 0; i < M_CONNECTIONS; i++) {
-         if (conn_fd[i] == 0)
+      /* Gather up the fds to wait on. */
+      pollfds[0].fd      = main_sd;
+      pollfds[0].events  = POLLIN;
+      pollfds[0].revents = 0;
+      j = 1;
+      for (i = 0; i < conns_size; i++) {
+         if (conns[i].fd == 0)
             continue;
-         conn_pollfd[j].fd = conn_fd[i];
-         conn_pollfd[j].events = POLLIN /* | POLLHUP | POLLNVAL */;
-         conn_pollfd[j].revents = 0;
+         pollfds[j].fd      = conns[i].fd;
+         pollfds[j].events  = POLLIN;
+         pollfds[j].revents = 0;
+         poll_conn[j] = i;
          j++;
       }
 
-      res = poll(conn_pollfd, j, 0 /* return immediately. */ );
+      /* If nothing is ready, write out what has been buffered before
+         waiting. */
+      res = poll(pollfds, j, 0);
+      if (res == 0) {
+         flush_outputs();
+         res = poll(pollfds, j, -1);
+      }
       if (res < 0) {
+         if (errno == EINTR)
+            continue;
          perror("poll(main) failed");
          panic("poll(main) failed");
       }
-    
-      /* nothing happened. go round again. */
-      if (res == 0) {
-         continue;
-      }
 
       /* inspect the fds. */
-      for (i = 0; i < j; i++) {
- 
-         if (conn_pollfd[i].revents & POLLIN) {
-            /* data is available on this fd */
-            res = read_from_sd(conn_pollfd[i].fd);
- 
-            if (res == 0) {
-               /* the connection has been closed. */
-               close(conn_pollfd[i].fd);
-               /* this fd has been closed or otherwise gone bad; forget
-                 about it. */
-               for (k = 0; k < M_CONNECTIONS; k++)
-                  if (conn_fd[k] == conn_pollfd[i].fd) 
-                     break;
-               assert(k < M_CONNECTIONS);
-               conn_fd[k] = 0;
-               conn_count--;
-               printf("\n(%d) ------------------- DISCONNECT "
-                      "-------------------\n(%d)\n(%d) ", 
-                      conn_count, conn_count, conn_count);
-               fflush(stdout);
+      for (i = 1; i < j; i++) {
+         if (pollfds[i].revents & (POLLIN | POLLHUP | POLLERR)) {
+            Conn* c = &conns[poll_conn[i]];
+            if (!read_from_conn(c)) {
+               /* the connection has been closed, or otherwise gone
+                  bad; forget about it. */
+               remove_conn(c);
                if (conn_count == 0 && exit_when_zero) {
-                  printf("\n");
                   fflush(stdout);
                   exit_routine();
-	       }
+               }
             }
          }
+      }
 
-      } /* for (i = 0; i < j; i++) */
+      /* Take anyone waiting to connect. */
+      if (pollfds[0].revents & POLLIN) {
+         while (1) {
+            client_len = sizeof(client_addr);
+            new_sd = accept(main_sd, (struct sockaddr *)&client_addr, 
+                                                        &client_len);
+            if (new_sd < 0) {
+               if (errno == EAGAIN || errno == EWOULDBLOCK
+                   || errno == EINTR || errno == ECONNABORTED)
+                  break;
+               perror("cannot accept connection ");
+               panic("main -- accept connection");
+            }
+	    assert(new_sd > 0);
+            add_conn(new_sd, &client_addr);
+         }
+         /* The connection table may have moved and grown. */
+         pollfds   = realloc(pollfds, (conns_size + 1)
+                                      * sizeof(struct pollfd));
+         poll_conn = realloc(poll_conn, (conns_size + 1) * sizeof(int));
+         if (pollfds == NULL || poll_conn == NULL)
+            panic("main -- out of memory");
+      }
   
    } /* while (1) */
 
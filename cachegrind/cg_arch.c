@@ -36,8 +36,8 @@
 
 #include "cg_arch.h"
 
-static void configure_caches(cache_t* I1c, cache_t* D1c, cache_t* LLc,
-                             Bool all_caches_clo_defined);
+static void configure_caches(cache_t* I1c, cache_t* D1c, cache_t* L2c,
+                             cache_t* LLc, Bool all_caches_clo_defined);
 
 // Checks cache config is ok.  Returns NULL if ok, or a pointer to an error
 // string otherwise.
@@ -116,6 +116,7 @@ static void parse_cache_opt ( cache_t* cache, const HChar* opt,
 Bool VG_(str_clo_cache_opt)(const HChar *arg,
                             cache_t* clo_I1c,
                             cache_t* clo_D1c,
+                            cache_t* clo_L2c,
                             cache_t* clo_LLc)
 {
    const HChar* tmp_str;
@@ -126,7 +127,11 @@ Bool VG_(str_clo_cache_opt)(const HChar *arg,
    } else if VG_STR_CLO(arg, "--D1", tmp_str) {
       parse_cache_opt(clo_D1c, arg, tmp_str);
       return True;
-   } else if (VG_STR_CLO(arg, "--L2", tmp_str) || // for backwards compatibility
+   } else if VG_STR_CLO(arg, "--L2", tmp_str) {
+      // for backwards compatibility, --L2 is --LL if there is no L2
+      parse_cache_opt(clo_L2c ? clo_L2c : clo_LLc, arg, tmp_str);
+      return True;
+   } else if (VG_STR_CLO(arg, "--L3", tmp_str) ||
               VG_STR_CLO(arg, "--LL", tmp_str)) {
       parse_cache_opt(clo_LLc, arg, tmp_str);
       return True;
@@ -160,7 +165,7 @@ static void check_cache_or_override(const HChar* desc, cache_t* c, Bool clo_rede
 }
 
 
-/* If the LL cache config isn't something the simulation functions
+/* If the L2 or LL cache config isn't something the simulation functions
    can handle, try to adjust it so it is.  Caches are characterised
    by (total size T, line size L, associativity A), and then we
    have
@@ -209,16 +214,16 @@ static UInt floor_power_of_2 ( UInt x )
 }
 
 static void
-maybe_tweak_LLc(cache_t *LLc)
+maybe_tweak_cache(const HChar* desc, cache_t *c)
 {
-  if (LLc->size == 0 || LLc->assoc == 0 || LLc->line_size == 0)
+  if (c->size == 0 || c->assoc == 0 || c->line_size == 0)
      return;
 
-  tl_assert(LLc->size > 0 && LLc->assoc > 0 && LLc->line_size > 0);
+  tl_assert(c->size > 0 && c->assoc > 0 && c->line_size > 0);
 
-  UInt old_size      = (UInt)LLc->size;
-  UInt old_assoc     = (UInt)LLc->assoc;
-  UInt old_line_size = (UInt)LLc->line_size;
+  UInt old_size      = (UInt)c->size;
+  UInt old_assoc     = (UInt)c->assoc;
+  UInt old_line_size = (UInt)c->line_size;
 
   UInt new_size      = old_size;
   UInt new_assoc     = old_assoc;
@@ -259,55 +264,73 @@ maybe_tweak_LLc(cache_t *LLc)
      return;
 
   VG_(dmsg)("warning: "
-            "specified LL cache: line_size %u  assoc %u  total_size %'u\n",
-            old_line_size, old_assoc, old_size);
+            "specified %s cache: line_size %u  assoc %u  total_size %'u\n",
+            desc, old_line_size, old_assoc, old_size);
   VG_(dmsg)("warning: "
-            "simulated LL cache: line_size %u  assoc %u  total_size %'u\n",\
-            new_line_size, new_assoc, new_size);
+            "simulated %s cache: line_size %u  assoc %u  total_size %'u\n",
+            desc, new_line_size, new_assoc, new_size);
 
-  LLc->size      = new_size;
-  LLc->assoc     = new_assoc;
-  LLc->line_size = new_line_size;
+  c->size      = new_size;
+  c->assoc     = new_assoc;
+  c->line_size = new_line_size;
 }
 
 void VG_(post_clo_init_configure_caches)(cache_t* I1c,
                                          cache_t* D1c,
+                                         cache_t* L2c,
                                          cache_t* LLc,
                                          cache_t* clo_I1c,
                                          cache_t* clo_D1c,
+                                         cache_t* clo_L2c,
                                          cache_t* clo_LLc)
 {
 #define DEFINED(L)   (-1 != L->size  || -1 != L->assoc || -1 != L->line_size)
 
+   // Without a simulated L2, --L2 is an old name for --LL.
+   if (L2c == NULL && clo_L2c != NULL && DEFINED(clo_L2c)) {
+      if (DEFINED(clo_LLc))
+         VG_(fmsg_bad_option)("--L2",
+            "--L2 and --LL (or --L3) given, but no L2 cache is simulated.\n");
+      *clo_LLc = *clo_L2c;
+   }
+
    // Count how many were defined on the command line.
    Bool all_caches_clo_defined =
       (DEFINED(clo_I1c) &&
        DEFINED(clo_D1c) &&
+       (L2c == NULL || DEFINED(clo_L2c)) &&
        DEFINED(clo_LLc));
 
    // Set the cache config (using auto-detection, if supported by the
    // architecture).
-   configure_caches( I1c, D1c, LLc, all_caches_clo_defined );
+   configure_caches( I1c, D1c, L2c, LLc, all_caches_clo_defined );
 
-   maybe_tweak_LLc( LLc );
+   if (L2c)
+      maybe_tweak_cache( "L2", L2c );
+   maybe_tweak_cache( "LL", LLc );
 
    // Check the default/auto-detected values.
    // Allow the user to override invalid auto-detected caches
    // with command line.
    check_cache_or_override ("I1", I1c, DEFINED(clo_I1c));
    check_cache_or_override ("D1", D1c, DEFINED(clo_D1c));
+   if (L2c)
+      check_cache_or_override ("L2", L2c, DEFINED(clo_L2c));
    check_cache_or_override ("LL", LLc, DEFINED(clo_LLc));
 
    // Then replace with any defined on the command line.  (Already checked in
    // VG(parse_clo_cache_opt)().)
    if (DEFINED(clo_I1c)) { *I1c = *clo_I1c; }
    if (DEFINED(clo_D1c)) { *D1c = *clo_D1c; }
+   if (L2c && DEFINED(clo_L2c)) { *L2c = *clo_L2c; }
    if (DEFINED(clo_LLc)) { *LLc = *clo_LLc; }
 
    if (VG_(clo_verbosity) >= 2) {
       VG_(umsg)("Cache configuration used:\n");
       umsg_cache_img ("I1", I1c);
       umsg_cache_img ("D1", D1c);
+      if (L2c)
+         umsg_cache_img ("L2", L2c);
       umsg_cache_img ("LL", LLc);
    }
 #undef DEFINED
@@ -318,7 +341,7 @@ void VG_(print_cache_clo_opts)()
    VG_(printf)(
 "    --I1=<size>,<assoc>,<line_size>  set I1 cache manually\n"
 "    --D1=<size>,<assoc>,<line_size>  set D1 cache manually\n"
-"    --LL=<size>,<assoc>,<line_size>  set LL cache manually\n"
+"    --LL=<size>,<assoc>,<line_size>  set LL cache manually (or --L3)\n"
                );
 }
 
@@ -339,15 +362,16 @@ locate_cache(const VexCacheInfo *ci, VexCacheKind kind, UInt level)
 }
 
 
-// Gives the auto-detected configuration of I1, D1 and LL caches.  They get
-// overridden by any cache configurations specified on the command line.
+// Gives the auto-detected configuration of I1, D1, L2 (if L2c is not NULL)
+// and LL caches.  They get overridden by any cache configurations specified
+// on the command line.
 static void
-configure_caches(cache_t *I1c, cache_t *D1c, cache_t *LLc,
+configure_caches(cache_t *I1c, cache_t *D1c, cache_t *L2c, cache_t *LLc,
                  Bool all_caches_clo_defined)
 {
    VexArchInfo vai;
    const VexCacheInfo *ci;
-   const VexCache *i1, *d1, *ll;
+   const VexCache *i1, *d1, *l2, *ll;
 
    VG_(machine_get_VexArchInfo)(NULL, &vai);
    ci = &vai.hwcache_info;
@@ -361,11 +385,28 @@ configure_caches(cache_t *I1c, cache_t *D1c, cache_t *LLc,
       VG_(dmsg)("warning: L2 cache not installed, ignore LL results.\n");
    }
 
-   if (ll && ci->num_levels > 2) {
+   // The mid-level cache is the unified one at level 2, if that isn't
+   // also the last level.
+   l2 = ci->num_levels > 2 ? locate_cache(ci, UNIFIED_CACHE, 2) : NULL;
+
+   if (ll && ci->num_levels > 2 && (L2c == NULL || ci->num_levels > 3)) {
       VG_(dmsg)("warning: L%u cache found, using its data for the "
                 "LL simulation.\n", ci->num_levels);
    }
 
+   if (L2c) {
+      if (l2) {
+         *L2c = (cache_t) { l2->sizeB, l2->assoc, l2->line_sizeB };
+      } else {
+         // Not detected;  choose something between the L1 and LL defaults
+         // below, with LL's line size.
+         *L2c = (cache_t) { 262144, 8, ll ? ll->line_sizeB : 64 };
+         if (ci->num_caches > 0 && !all_caches_clo_defined)
+            VG_(dmsg)("warning: no L2 cache separate from LL found, "
+                      "using defaults for L2.\n");
+      }
+   }
+
    if (i1 && d1 && ll) {
       if (i1->is_trace_cache) {
          /* HACK ALERT: Instruction trace cache -- capacity is micro-ops based.
@@ -483,6 +524,9 @@ configure_caches(cache_t *I1c, cache_t *D1c, cache_t *LLc,
 
 #endif
 
+   if (L2c)
+      *L2c = (cache_t) { 262144, 8, LLc->line_size };
+
    if (!all_caches_clo_defined) {
       const HChar warning[] =
         "Warning: Cannot auto-detect cache config, using defaults.\n"
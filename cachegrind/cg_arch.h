@@ -44,12 +44,14 @@ typedef struct {
 // initialized to UNDEFINED_CACHE.
 #define UNDEFINED_CACHE     { -1, -1, -1 }
 
-// If arg is a command line option configuring I1 or D1 or LL cache,
+// If arg is a command line option configuring I1 or D1 or L2 or LL cache,
 // then parses arg to set the relevant cache_t elements.
 // Returns True if arg is a cache command line option, False otherwise.
+// If clo_L2c is NULL, --L2 is taken as an old name for --LL.
 Bool VG_(str_clo_cache_opt)(const HChar *arg,
                             cache_t* clo_I1c,
                             cache_t* clo_D1c,
+                            cache_t* clo_L2c,
                             cache_t* clo_LLc);
 
 // Checks the correctness of the auto-detected caches.
@@ -58,11 +60,15 @@ Bool VG_(str_clo_cache_opt)(const HChar *arg,
 // Note that an invalid auto-detected cache will make Valgrind exit
 // with an fatal error, except if the invalid auto-detected cache
 // will be replaced by a command line defined cache.
+// L2c is NULL if the tool doesn't simulate a mid-level cache between
+// L1 and LL;  a --L2 given on the command line then configures LL.
 void VG_(post_clo_init_configure_caches)(cache_t* I1c,
                                          cache_t* D1c,
+                                         cache_t* L2c,
                                          cache_t* LLc,
                                          cache_t* clo_I1c,
                                          cache_t* clo_D1c,
+                                         cache_t* clo_L2c,
                                          cache_t* clo_LLc);
 
 void VG_(print_cache_clo_opts)(void);
@@ -33,7 +33,8 @@
    associated state.  As with cg_sim.c it is #included directly into
    cg_main.c.  It provides:
 
-   - a taken/not-taken predictor for conditional branches
+   - a taken/not-taken predictor for conditional branches, using one of
+     several models chosen with --branch-predictor
    - a branch target address predictor for indirect branches
 
    Function return-address prediction is not modelled, on the basis
@@ -70,9 +71,8 @@
    makes the predictor able to correlate this branch's behaviour with
    that of other branches. 
 
-   TODO: use predictor written by someone who understands this stuff.
-   Perhaps it would be better to move to a standard GShare predictor
-   and/or tournament predictor.
+   This is the "simple" model, the default.  The other models, chosen
+   with --branch-predictor, follow it.
 */
 /* The index is composed of N_HIST bits at the top and N_IADD bits at
    the bottom.  These numbers chosen somewhat arbitrarily, but note
@@ -89,7 +89,7 @@ static UWord shift_register = 0;   /* Contains global history */
 static UChar counters[N_COUNTERS]; /* Counter array; presumably auto-zeroed */
 
 
-static ULong do_cond_branch_predict ( Addr instr_addr, Word takenW )
+static ULong simple_predict ( Addr instr_addr, Word takenW )
 {
    UWord indx;
    Bool  predicted_taken, actually_taken, mispredict;
@@ -130,6 +130,271 @@ static ULong do_cond_branch_predict ( Addr instr_addr, Word takenW )
 }
 
 
+/* The models for conditional branches. */
+typedef
+   enum { BP_Simple, BP_GShare, BP_Perceptron, BP_TAGE }
+   BranchPredModel;
+
+static BranchPredModel bp_model    = BP_Simple;
+static Int             bp_hist_len = 0;   /* global history bits used */
+static ULong           bp_history  = 0;   /* global history, newest in bit 0 */
+
+static inline UWord bp_pc ( Addr instr_addr )
+{
+   return instr_addr >> N_IADDR_LO_ZERO_BITS;
+}
+
+static inline ULong bp_hist_mask ( Int len )
+{
+   return len >= 64 ? ~0ULL : (1ULL << len) - 1;
+}
+
+/* gshare (McFarling): 2-bit counters indexed by the branch address
+   XORed with the last bp_hist_len outcomes, folded down to the index
+   width if the history is longer. */
+#define N_GSHARE_BITS 14
+static UChar gshare_counters[1 << N_GSHARE_BITS];
+
+static inline UWord fold_history ( ULong hist, Int len, Int bits )
+{
+   UWord r = 0;
+   hist &= bp_hist_mask(len);
+   while (hist) {
+      r ^= (UWord)(hist & ((1ULL << bits) - 1));
+      hist >>= bits;
+   }
+   return r;
+}
+
+static ULong gshare_predict ( Addr instr_addr, Bool taken )
+{
+   const UWord mask = (1 << N_GSHARE_BITS) - 1;
+   UWord indx = (bp_pc(instr_addr)
+                 ^ fold_history(bp_history, bp_hist_len, N_GSHARE_BITS))
+                & mask;
+   UChar* ctr = &gshare_counters[indx];
+   Bool   predicted_taken = *ctr >= 2;
+
+   if (taken) {
+      if (*ctr < 3) (*ctr)++;
+   } else {
+      if (*ctr > 0) (*ctr)--;
+   }
+   return predicted_taken != taken ? 1 : 0;
+}
+
+/* Perceptron (Jimenez and Lin): a table of perceptrons indexed by the
+   branch address, each with a bias weight and one weight per history
+   bit.  The prediction is the sign of the bias plus the weights of taken
+   history bits minus those of not-taken ones.  Training happens on a
+   mispredict, or when the output is within the threshold of zero. */
+#define N_PERCEPTRON_BITS 10
+#define PERCEPTRON_WMAX   127
+static Short perceptron_w[1 << N_PERCEPTRON_BITS][1 + 64];
+static Int   perceptron_theta;
+
+static ULong perceptron_predict ( Addr instr_addr, Bool taken )
+{
+   const UWord mask = (1 << N_PERCEPTRON_BITS) - 1;
+   Short* w = perceptron_w[bp_pc(instr_addr) & mask];
+   Int    i, y = w[0];
+   Bool   predicted_taken;
+
+   for (i = 0; i < bp_hist_len; i++)
+      y += (bp_history >> i) & 1 ? w[i+1] : -w[i+1];
+   predicted_taken = y >= 0;
+
+   if (predicted_taken != taken || (y < 0 ? -y : y) <= perceptron_theta) {
+      Int t = taken ? 1 : -1;
+      w[0] += t;
+      if (w[0] > PERCEPTRON_WMAX) w[0] = PERCEPTRON_WMAX;
+      if (w[0] < -PERCEPTRON_WMAX) w[0] = -PERCEPTRON_WMAX;
+      for (i = 0; i < bp_hist_len; i++) {
+         Short* wi = &w[i+1];
+         *wi += (bp_history >> i) & 1 ? t : -t;
+         if (*wi > PERCEPTRON_WMAX) *wi = PERCEPTRON_WMAX;
+         if (*wi < -PERCEPTRON_WMAX) *wi = -PERCEPTRON_WMAX;
+      }
+   }
+   return predicted_taken != taken ? 1 : 0;
+}
+
+/* TAGE-lite (after Seznec and Michaud): a bimodal base predictor plus
+   four tagged tables using geometrically increasing history lengths, up
+   to bp_hist_len.  The prediction comes from the matching table with
+   the longest history, if any.  On a mispredict an entry is allocated in
+   a longer-history table whose entry isn't marked useful.  This leaves
+   out the refinements of the full design, such as the alternate
+   prediction for newly allocated entries. */
+#define N_TAGE_TABLES    4
+#define N_TAGE_BITS      10
+#define N_TAGE_BASE_BITS 12
+#define TAGE_TAG_BITS    8
+#define TAGE_U_RESET     (1 << 18)   /* branches between ageing "u" bits */
+
+typedef
+   struct {
+      UChar tag;
+      Char  ctr;   /* 3-bit signed counter, -4..3;  >= 0 means taken */
+      UChar u;     /* 2-bit usefulness counter */
+   }
+   TageEntry;
+
+static UChar     tage_base[1 << N_TAGE_BASE_BITS];
+static TageEntry tage_tables[N_TAGE_TABLES][1 << N_TAGE_BITS];
+static Int       tage_hist_len[N_TAGE_TABLES];
+static UInt      tage_branches = 0;
+
+static ULong tage_predict ( Addr instr_addr, Bool taken )
+{
+   const UWord mask = (1 << N_TAGE_BITS) - 1;
+   UWord pc = bp_pc(instr_addr);
+   UWord indx[N_TAGE_TABLES];
+   UChar tag[N_TAGE_TABLES];
+   UChar* base = &tage_base[pc & ((1 << N_TAGE_BASE_BITS) - 1)];
+   Int   i, provider = -1, alt = -1;
+   Bool  pred, alt_pred;
+
+   for (i = 0; i < N_TAGE_TABLES; i++) {
+      Int len = tage_hist_len[i];
+      indx[i] = (pc ^ (pc >> N_TAGE_BITS)
+                 ^ fold_history(bp_history, len, N_TAGE_BITS)) & mask;
+      tag[i]  = (UChar)(pc ^ fold_history(bp_history, len, TAGE_TAG_BITS)
+                        ^ (fold_history(bp_history, len,
+                                        TAGE_TAG_BITS - 1) << 1));
+   }
+   for (i = N_TAGE_TABLES - 1; i >= 0; i--) {
+      if (tage_tables[i][indx[i]].tag == tag[i]) {
+         if (provider < 0)
+            provider = i;
+         else {
+            alt = i;
+            break;
+         }
+      }
+   }
+
+   alt_pred = alt >= 0 ? tage_tables[alt][indx[alt]].ctr >= 0
+                       : *base >= 2;
+   if (provider >= 0) {
+      TageEntry* e = &tage_tables[provider][indx[provider]];
+      pred = e->ctr >= 0;
+      if (taken) {
+         if (e->ctr < 3) e->ctr++;
+      } else {
+         if (e->ctr > -4) e->ctr--;
+      }
+      if (pred != alt_pred) {
+         if (pred == taken) {
+            if (e->u < 3) e->u++;
+         } else {
+            if (e->u > 0) e->u--;
+         }
+      }
+   } else {
+      pred = alt_pred;
+      if (taken) {
+         if (*base < 3) (*base)++;
+      } else {
+         if (*base > 0) (*base)--;
+      }
+   }
+
+   // On a mispredict, allocate an entry in a longer-history table, or if
+   // there is no free one, make the candidates more likely to be freed.
+   if (pred != taken && provider < N_TAGE_TABLES - 1) {
+      Bool allocated = False;
+      for (i = provider + 1; i < N_TAGE_TABLES; i++) {
+         TageEntry* e = &tage_tables[i][indx[i]];
+         if (e->u == 0) {
+            e->tag = tag[i];
+            e->ctr = taken ? 0 : -1;
+            allocated = True;
+            break;
+         }
+      }
+      if (!allocated) {
+         for (i = provider + 1; i < N_TAGE_TABLES; i++)
+            tage_tables[i][indx[i]].u--;
+      }
+   }
+
+   if (++tage_branches == TAGE_U_RESET) {
+      Int j;
+      tage_branches = 0;
+      for (i = 0; i < N_TAGE_TABLES; i++)
+         for (j = 0; j < (1 << N_TAGE_BITS); j++)
+            tage_tables[i][j].u >>= 1;
+   }
+
+   return pred != taken ? 1 : 0;
+}
+
+/* The default history length of each model. */
+static Int branchpred_default_history ( BranchPredModel model )
+{
+   switch (model) {
+      case BP_GShare:     return 12;
+      case BP_Perceptron: return 32;
+      case BP_TAGE:       return 64;
+      default:            return 0;
+   }
+}
+
+/* Set up the chosen model.  hist_len is between 1 and 64, or 0 for the
+   model's default. */
+static void branchpred_init ( BranchPredModel model, Int hist_len )
+{
+   Int i;
+
+   bp_model    = model;
+   bp_hist_len = hist_len > 0 ? hist_len : branchpred_default_history(model);
+   tl_assert(bp_hist_len >= 0 && bp_hist_len <= 64);
+
+   // Start the TAGE base predictor at weakly taken.
+   for (i = 0; i < (1 << N_TAGE_BASE_BITS); i++)
+      tage_base[i] = 2;
+
+   // Threshold from the perceptron paper:  1.93 * history length + 14.
+   perceptron_theta = (193 * bp_hist_len) / 100 + 14;
+
+   // TAGE history lengths form a geometric series from (at most) 4 up to
+   // bp_hist_len, eg. 4, 10, 25, 64.  The ratio is the cube root of
+   // bp_hist_len / 4, found by Newton's method.
+   if (model == BP_TAGE) {
+      Int    min = bp_hist_len < 4 ? bp_hist_len : 4;
+      Double a   = (Double)bp_hist_len / min;
+      Double r   = a;
+      Double len = min;
+      for (i = 0; i < 30; i++)
+         r = (2 * r + a / (r * r)) / 3;
+      for (i = 0; i < N_TAGE_TABLES; i++) {
+         tage_hist_len[i] = (Int)(len + 0.5);
+         len *= r;
+      }
+      tage_hist_len[N_TAGE_TABLES - 1] = bp_hist_len;
+   }
+}
+
+static ULong do_cond_branch_predict ( Addr instr_addr, Word takenW )
+{
+   Bool  taken = takenW > 0;
+   ULong mispredict;
+
+   switch (bp_model) {
+      case BP_GShare:     mispredict = gshare_predict(instr_addr, taken);
+                          break;
+      case BP_Perceptron: mispredict = perceptron_predict(instr_addr, taken);
+                          break;
+      case BP_TAGE:       mispredict = tage_predict(instr_addr, taken);
+                          break;
+      default:            return simple_predict(instr_addr, takenW);
+   }
+   bp_history = (bp_history << 1) | (taken ? 1 : 0);
+   return mispredict;
+}
+
+
 /* A very simple indirect branch predictor.  Use the branch's address
    to index a table which records the previous target address for this
    branch (or whatever aliased with it) and use that as the
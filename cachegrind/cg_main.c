@@ -42,6 +42,7 @@
 #include "pub_tool_options.h"
 #include "pub_tool_oset.h"
 #include "pub_tool_tooliface.h"
+#include "pub_tool_threadstate.h"   // VG_N_THREADS
 #include "pub_tool_xarray.h"
 #include "pub_tool_clientstate.h"
 #include "pub_tool_machine.h"      // VG_(fnptr_to_fnentry)
@@ -67,13 +68,52 @@
 
 static Bool  clo_cache_sim  = True;  /* do cache simulation? */
 static Bool  clo_branch_sim = False; /* do branch simulation? */
+static Int   clo_branch_predictor = BP_Simple; /* conditional branch model */
+static Long  clo_branch_history = 0; /* history bits;  0: model's default */
+static Bool  clo_batch_sim  = False; /* buffer events for the cache sim? */
+static Int   clo_cache_levels = 2;   /* 3: simulate L2 between L1 and LL */
+static Bool  clo_L2_exclusive = False; /* L2 holds only L1 victims? */
+static Bool  clo_tlb_sim    = False; /* simulate ITLB and DTLB? */
+static Bool  clo_prefetch_sim = False; /* simulate a stride prefetcher? */
+static Long  clo_tlb_page_size = 4096;
+static Long  clo_sample_period = 0;  /* millions of instrs;  0: no sampling */
+static Long  clo_sample_window = 1;  /* millions of instrs simulated fully */
+static Bool  clo_compress_output = False; /* compact cachegrind.out? */
+static Bool  clo_separate_threads = False; /* private L1s, counts per thread? */
 static const HChar* clo_cachegrind_out_file = "cachegrind.out.%p";
 
 /*------------------------------------------------------------*/
 /*--- Cachesim configuration                               ---*/
 /*------------------------------------------------------------*/
 
-static Int min_line_size = 0; /* min of L1 and LL cache line sizes */
+static Int min_line_size = 0; /* min of L1, L2 and LL cache line sizes */
+
+/*------------------------------------------------------------*/
+/*--- Sampling                                             ---*/
+/*------------------------------------------------------------*/
+
+/* With --sample-period, each period starts with a window in which the
+   caches and branches are simulated as normal.  For the rest of the
+   period, translations only count instructions, in LineCC.Ir_ff.  At
+   the end, each line's counts are scaled up by its total instruction
+   count over the instructions executed in the windows.  Switching
+   between the two modes discards all translations, as callgrind's
+   CLG_(set_instrument_state) does. */
+static Bool  sample_ff      = False;  /* fast-forwarding at the moment? */
+static ULong sample_instrs  = 0;      /* approx. instructions executed */
+static ULong sample_next    = 0;      /* switch mode at this count */
+static ULong sample_windows = 0;
+
+/* What new translations simulate. */
+static Bool cache_sim_active(void)
+{
+   return clo_cache_sim && !sample_ff;
+}
+
+static Bool branch_sim_active(void)
+{
+   return clo_branch_sim && !sample_ff;
+}
 
 /*------------------------------------------------------------*/
 /*--- Types and Data Structures                            ---*/
@@ -83,7 +123,9 @@ typedef
    struct {
       ULong a;  /* total # memory accesses of this kind */
       ULong m1; /* misses in the first level cache */
-      ULong mL; /* misses in the second level cache */
+      ULong m2; /* misses in the mid-level cache (--cache-levels=3) */
+      ULong mL; /* misses in the last level cache */
+      ULong mT; /* TLB misses (--tlb-sim=yes) */
    }
    CacheCC;
 
@@ -96,7 +138,8 @@ typedef
 
 //------------------------------------------------------------
 // Primary data structure #1: CC table
-// - Holds the per-source-line hit/miss stats, grouped by file/function/line.
+// - Holds the source lines, grouped by file/function/line.  Each has an
+//   index into the cost arrays below, where its hit/miss stats are.
 // - an ordered set of CCs.  CC indexing done by file/function/line (as
 //   determined from the instrAddr).
 // - Traversed for dumping stats at end in file/func/line hierarchy.
@@ -110,12 +153,17 @@ CodeLoc;
 
 typedef struct {
    CodeLoc  loc; /* Source location that these counts pertain to */
+   UInt     idx; /* Index of its LineCost in the cost arrays */
+} LineCC;
+
+typedef struct {
    CacheCC  Ir;  /* Insn read counts */
    CacheCC  Dr;  /* Data read counts */
    CacheCC  Dw;  /* Data write/modify counts */
    BranchCC Bc;  /* Conditional branch counts */
    BranchCC Bi;  /* Indirect branch counts */
-} LineCC;
+   ULong    Ir_ff; /* Insns executed while fast-forwarding (--sample-period) */
+} LineCost;
 
 // First compare file, then fn, then line.
 static Word cmp_CodeLoc_LineCC(const void *vloc, const void *vcc)
@@ -137,26 +185,70 @@ static Word cmp_CodeLoc_LineCC(const void *vloc, const void *vcc)
 
 static OSet* CC_table;
 
+//------------------------------------------------------------
+// Cost arrays
+// - One LineCost for each LineCC, indexed by LineCC.idx.
+// - Normally there is one array, in thread_costs[0], which all threads
+//   count into.  With --separate-threads=yes, each thread has its own,
+//   in thread_costs[tid], so a thread's counts are only ever written by
+//   that thread.  The arrays are summed when the results are written.
+// - cur_costs is the array of the running thread;  the simulation
+//   functions find a line's counts with COST().
+// - All arrays have costs_size entries and grow together.
+
+static LineCost** thread_costs = NULL;   // [VG_N_THREADS]
+static LineCost* cur_costs  = NULL;
+static ThreadId  cur_slot   = 0;
+static UInt      n_lineCCs  = 0;
+static UInt      costs_size = 0;
+
+// With --separate-threads=yes, the private caches of the threads that
+// aren't running.
+static cache_private_t** thread_caches = NULL;   // [VG_N_THREADS]
+
+#define COST(n)  (&cur_costs[(n)->cost_idx])
+
 //------------------------------------------------------------
 // Primary data structure #2: InstrInfo table
 // - Holds the cached info about each instr that is used for simulation.
 // - table(SB_start_addr, list(InstrInfo))
 // - For each SB, each InstrInfo in the list holds info about the
-//   instruction (instrLen, instrAddr, etc), plus a pointer to its line
-//   CC.  This node is what's passed to the simulation function.
+//   instruction (instrLen, instrAddr, etc), plus the index of its line
+//   CC's counts.  This node is what's passed to the simulation function.
 // - When SBs are discarded the relevant list(instr_details) is freed.
 
 typedef struct _InstrInfo InstrInfo;
 struct _InstrInfo {
    Addr    instr_addr;
    UChar   instr_len;
-   LineCC* parent;         // parent line-CC
+   UInt    cost_idx;       // idx of the parent line-CC
+};
+
+// Only used with --batch-sim=yes; see sim_buf_drain().
+typedef
+   enum {
+      SimK_IrNoX = 0,
+      SimK_IrGen = 1,
+      SimK_Dr    = 2,  // also used for data modifies
+      SimK_Dw    = 3
+   }
+   SimKind;
+
+typedef struct _SimGroup SimGroup;
+struct _SimGroup {
+   SimGroup* next;         // next group of the same SB
+   UInt      n_events;
+   struct {
+      InstrInfo* inode;
+      UWord      szkind;   // (data size << 2) | SimKind
+   } events[0];
 };
 
 typedef struct _SB_info SB_info;
 struct _SB_info {
    Addr      SB_addr;      // key;  MUST BE FIRST
    Int       n_instrs;
+   SimGroup* sim_groups;   // with --batch-sim=yes
    InstrInfo instrs[0];
 };
 
@@ -251,6 +343,34 @@ static void get_debug_info(Addr instr_addr, HChar file[FILE_LEN],
    }
 }
 
+static LineCost* new_costs(void)
+{
+   LineCost* costs = VG_(malloc)("cg.main.nc.1", costs_size * sizeof(LineCost));
+   VG_(memset)(costs, 0, costs_size * sizeof(LineCost));
+   return costs;
+}
+
+// Makes room for the counts of n lines in every thread's cost array.
+static void grow_costs(UInt n)
+{
+   ThreadId s;
+   UInt     new_size;
+
+   if (n <= costs_size)
+      return;
+   new_size = 2 * costs_size;
+   for (s = 0; s < VG_N_THREADS; s++) {
+      if (thread_costs[s] == NULL)
+         continue;
+      thread_costs[s] = VG_(realloc)("cg.main.gc.1", thread_costs[s],
+                                     new_size * sizeof(LineCost));
+      VG_(memset)(&thread_costs[s][costs_size], 0,
+                  (new_size - costs_size) * sizeof(LineCost));
+   }
+   costs_size = new_size;
+   cur_costs  = thread_costs[cur_slot];
+}
+
 // Do a three step traversal: by file, then fn, then line.
 // Returns a pointer to the line CC, creates a new one if necessary.
 static LineCC* get_lineCC(Addr origAddr)
@@ -273,19 +393,8 @@ static LineCC* get_lineCC(Addr origAddr)
       lineCC->loc.file = get_perm_string(loc.file);
       lineCC->loc.fn   = get_perm_string(loc.fn);
       lineCC->loc.line = loc.line;
-      lineCC->Ir.a     = 0;
-      lineCC->Ir.m1    = 0;
-      lineCC->Ir.mL    = 0;
-      lineCC->Dr.a     = 0;
-      lineCC->Dr.m1    = 0;
-      lineCC->Dr.mL    = 0;
-      lineCC->Dw.a     = 0;
-      lineCC->Dw.m1    = 0;
-      lineCC->Dw.mL    = 0;
-      lineCC->Bc.b     = 0;
-      lineCC->Bc.mp    = 0;
-      lineCC->Bi.b     = 0;
-      lineCC->Bi.mp    = 0;
+      lineCC->idx      = n_lineCCs++;
+      grow_costs(n_lineCCs);
       VG_(OSetGen_Insert)(CC_table, lineCC);
    }
 
@@ -312,24 +421,50 @@ static LineCC* get_lineCC(Addr origAddr)
 static VG_REGPARM(1)
 void log_1Ir(InstrInfo* n)
 {
-   n->parent->Ir.a++;
+   COST(n)->Ir.a++;
 }
 
 // Only used with --cache-sim=no.
 static VG_REGPARM(2)
 void log_2Ir(InstrInfo* n, InstrInfo* n2)
 {
-   n->parent->Ir.a++;
-   n2->parent->Ir.a++;
+   COST(n)->Ir.a++;
+   COST(n2)->Ir.a++;
 }
 
 // Only used with --cache-sim=no.
 static VG_REGPARM(3)
 void log_3Ir(InstrInfo* n, InstrInfo* n2, InstrInfo* n3)
 {
-   n->parent->Ir.a++;
-   n2->parent->Ir.a++;
-   n3->parent->Ir.a++;
+   COST(n)->Ir.a++;
+   COST(n2)->Ir.a++;
+   COST(n3)->Ir.a++;
+}
+
+/* Only used while fast-forwarding between sampled windows
+   (--sample-period): log_1Ir_ff, log_2Ir_ff and log_3Ir_ff count one,
+   two and three executed instructions in LineCC.Ir_ff, without any
+   cache or branch simulation.  Ir_ff is used to scale the line's
+   simulated counts at the end (see "Sampling" above). */
+static VG_REGPARM(1)
+void log_1Ir_ff(InstrInfo* n)
+{
+   COST(n)->Ir_ff++;
+}
+
+static VG_REGPARM(2)
+void log_2Ir_ff(InstrInfo* n, InstrInfo* n2)
+{
+   COST(n)->Ir_ff++;
+   COST(n2)->Ir_ff++;
+}
+
+static VG_REGPARM(3)
+void log_3Ir_ff(InstrInfo* n, InstrInfo* n2, InstrInfo* n3)
+{
+   COST(n)->Ir_ff++;
+   COST(n2)->Ir_ff++;
+   COST(n3)->Ir_ff++;
 }
 
 // Generic case for instruction reads: may cross cache lines.
@@ -337,41 +472,52 @@ void log_3Ir(InstrInfo* n, InstrInfo* n2, InstrInfo* n3)
 static VG_REGPARM(1)
 void log_1IrGen_0D_cache_access(InstrInfo* n)
 {
+   LineCost* c = COST(n);
    //VG_(printf)("1IrGen_0D :  CCaddr=0x%010lx,  iaddr=0x%010lx,  isize=%lu\n",
    //             n, n->instr_addr, n->instr_len);
    cachesim_I1_doref_Gen(n->instr_addr, n->instr_len,
-			 &n->parent->Ir.m1, &n->parent->Ir.mL);
-   n->parent->Ir.a++;
+			 &c->Ir.m1, &c->Ir.m2,
+			 &c->Ir.mL, &c->Ir.mT);
+   c->Ir.a++;
 }
 
 static VG_REGPARM(1)
 void log_1IrNoX_0D_cache_access(InstrInfo* n)
 {
+   LineCost* c = COST(n);
    //VG_(printf)("1IrNoX_0D :  CCaddr=0x%010lx,  iaddr=0x%010lx,  isize=%lu\n",
    //             n, n->instr_addr, n->instr_len);
    cachesim_I1_doref_NoX(n->instr_addr, n->instr_len,
-			 &n->parent->Ir.m1, &n->parent->Ir.mL);
-   n->parent->Ir.a++;
+			 &c->Ir.m1, &c->Ir.m2,
+			 &c->Ir.mL, &c->Ir.mT);
+   c->Ir.a++;
 }
 
 static VG_REGPARM(2)
 void log_2IrNoX_0D_cache_access(InstrInfo* n, InstrInfo* n2)
 {
+   LineCost* c  = COST(n);
+   LineCost* c2 = COST(n2);
    //VG_(printf)("2IrNoX_0D : CC1addr=0x%010lx, i1addr=0x%010lx, i1size=%lu\n"
    //            "            CC2addr=0x%010lx, i2addr=0x%010lx, i2size=%lu\n",
    //            n,  n->instr_addr,  n->instr_len,
    //            n2, n2->instr_addr, n2->instr_len);
    cachesim_I1_doref_NoX(n->instr_addr, n->instr_len,
-			 &n->parent->Ir.m1, &n->parent->Ir.mL);
-   n->parent->Ir.a++;
+			 &c->Ir.m1, &c->Ir.m2,
+			 &c->Ir.mL, &c->Ir.mT);
+   c->Ir.a++;
    cachesim_I1_doref_NoX(n2->instr_addr, n2->instr_len,
-			 &n2->parent->Ir.m1, &n2->parent->Ir.mL);
-   n2->parent->Ir.a++;
+			 &c2->Ir.m1, &c2->Ir.m2,
+			 &c2->Ir.mL, &c2->Ir.mT);
+   c2->Ir.a++;
 }
 
 static VG_REGPARM(3)
 void log_3IrNoX_0D_cache_access(InstrInfo* n, InstrInfo* n2, InstrInfo* n3)
 {
+   LineCost* c  = COST(n);
+   LineCost* c2 = COST(n2);
+   LineCost* c3 = COST(n3);
    //VG_(printf)("3IrNoX_0D : CC1addr=0x%010lx, i1addr=0x%010lx, i1size=%lu\n"
    //            "            CC2addr=0x%010lx, i2addr=0x%010lx, i2size=%lu\n"
    //            "            CC3addr=0x%010lx, i3addr=0x%010lx, i3size=%lu\n",
@@ -379,44 +525,53 @@ void log_3IrNoX_0D_cache_access(InstrInfo* n, InstrInfo* n2, InstrInfo* n3)
    //            n2, n2->instr_addr, n2->instr_len,
    //            n3, n3->instr_addr, n3->instr_len);
    cachesim_I1_doref_NoX(n->instr_addr, n->instr_len,
-			 &n->parent->Ir.m1, &n->parent->Ir.mL);
-   n->parent->Ir.a++;
+			 &c->Ir.m1, &c->Ir.m2,
+			 &c->Ir.mL, &c->Ir.mT);
+   c->Ir.a++;
    cachesim_I1_doref_NoX(n2->instr_addr, n2->instr_len,
-			 &n2->parent->Ir.m1, &n2->parent->Ir.mL);
-   n2->parent->Ir.a++;
+			 &c2->Ir.m1, &c2->Ir.m2,
+			 &c2->Ir.mL, &c2->Ir.mT);
+   c2->Ir.a++;
    cachesim_I1_doref_NoX(n3->instr_addr, n3->instr_len,
-			 &n3->parent->Ir.m1, &n3->parent->Ir.mL);
-   n3->parent->Ir.a++;
+			 &c3->Ir.m1, &c3->Ir.m2,
+			 &c3->Ir.mL, &c3->Ir.mT);
+   c3->Ir.a++;
 }
 
 static VG_REGPARM(3)
 void log_1IrNoX_1Dr_cache_access(InstrInfo* n, Addr data_addr, Word data_size)
 {
+   LineCost* c = COST(n);
    //VG_(printf)("1IrNoX_1Dr:  CCaddr=0x%010lx,  iaddr=0x%010lx,  isize=%lu\n"
    //            "                               daddr=0x%010lx,  dsize=%lu\n",
    //            n, n->instr_addr, n->instr_len, data_addr, data_size);
    cachesim_I1_doref_NoX(n->instr_addr, n->instr_len,
-			 &n->parent->Ir.m1, &n->parent->Ir.mL);
-   n->parent->Ir.a++;
+			 &c->Ir.m1, &c->Ir.m2,
+			 &c->Ir.mL, &c->Ir.mT);
+   c->Ir.a++;
 
    cachesim_D1_doref(data_addr, data_size, 
-                     &n->parent->Dr.m1, &n->parent->Dr.mL);
-   n->parent->Dr.a++;
+                     &c->Dr.m1, &c->Dr.m2,
+                     &c->Dr.mL, &c->Dr.mT);
+   c->Dr.a++;
 }
 
 static VG_REGPARM(3)
 void log_1IrNoX_1Dw_cache_access(InstrInfo* n, Addr data_addr, Word data_size)
 {
+   LineCost* c = COST(n);
    //VG_(printf)("1IrNoX_1Dw:  CCaddr=0x%010lx,  iaddr=0x%010lx,  isize=%lu\n"
    //            "                               daddr=0x%010lx,  dsize=%lu\n",
    //            n, n->instr_addr, n->instr_len, data_addr, data_size);
    cachesim_I1_doref_NoX(n->instr_addr, n->instr_len,
-			 &n->parent->Ir.m1, &n->parent->Ir.mL);
-   n->parent->Ir.a++;
+			 &c->Ir.m1, &c->Ir.m2,
+			 &c->Ir.mL, &c->Ir.mT);
+   c->Ir.a++;
 
    cachesim_D1_doref(data_addr, data_size, 
-                     &n->parent->Dw.m1, &n->parent->Dw.mL);
-   n->parent->Dw.a++;
+                     &c->Dw.m1, &c->Dw.m2,
+                     &c->Dw.mL, &c->Dw.mT);
+   c->Dw.a++;
 }
 
 /* Note that addEvent_D_guarded assumes that log_0Ir_1Dr_cache_access
@@ -425,22 +580,109 @@ void log_1IrNoX_1Dw_cache_access(InstrInfo* n, Addr data_addr, Word data_size)
 static VG_REGPARM(3)
 void log_0Ir_1Dr_cache_access(InstrInfo* n, Addr data_addr, Word data_size)
 {
+   LineCost* c = COST(n);
    //VG_(printf)("0Ir_1Dr:  CCaddr=0x%010lx,  daddr=0x%010lx,  dsize=%lu\n",
    //            n, data_addr, data_size);
    cachesim_D1_doref(data_addr, data_size, 
-                     &n->parent->Dr.m1, &n->parent->Dr.mL);
-   n->parent->Dr.a++;
+                     &c->Dr.m1, &c->Dr.m2,
+                     &c->Dr.mL, &c->Dr.mT);
+   c->Dr.a++;
 }
 
 /* See comment on log_0Ir_1Dr_cache_access. */
 static VG_REGPARM(3)
 void log_0Ir_1Dw_cache_access(InstrInfo* n, Addr data_addr, Word data_size)
 {
+   LineCost* c = COST(n);
    //VG_(printf)("0Ir_1Dw:  CCaddr=0x%010lx,  daddr=0x%010lx,  dsize=%lu\n",
    //            n, data_addr, data_size);
    cachesim_D1_doref(data_addr, data_size, 
-                     &n->parent->Dw.m1, &n->parent->Dw.mL);
-   n->parent->Dw.a++;
+                     &c->Dw.m1, &c->Dw.m2,
+                     &c->Dw.mL, &c->Dw.mT);
+   c->Dw.a++;
+}
+
+/*------------------------------------------------------------*/
+/*--- Batched cache simulation                             ---*/
+/*------------------------------------------------------------*/
+
+/* With --batch-sim=yes, cache events don't call one of the helpers
+ * above.  Each group of events that would have been flushed together
+ * is described by a SimGroup, made at instrumentation time, which
+ * lists their InstrInfos, kinds and sizes.  At run time, inline IR
+ * appends the SimGroup's address to sim_buf, followed by the address
+ * of each data access in the group.  sim_buf_drain() feeds the
+ * buffered groups to the simulator in one loop when the buffer is
+ * about to overflow.  Only one thread runs at a time and groups are
+ * appended in execution order, so the simulator sees exactly the same
+ * sequence of references as with the helpers, and the results are
+ * identical.
+ *
+ * sim_buf points at SimGroups, and they point at InstrInfos, so the
+ * buffer must be drained before an SB_info is freed, and before the
+ * results are used.  With --separate-threads=yes it must also be
+ * drained before another thread runs, as the buffered accesses are
+ * counted in, and simulated with, the running thread's costs and caches.
+ */
+
+#define N_SIM_BUF 8192  /* words */
+
+static UWord sim_buf[N_SIM_BUF];
+static UWord sim_buf_used = 0;
+
+static ULong sim_buf_drains = 0;
+static ULong sim_buf_events = 0;
+
+static void sim_buf_drain(void)
+{
+   UWord i = 0;
+   UInt  j;
+
+   while (i < sim_buf_used) {
+      SimGroup* g = (SimGroup*)sim_buf[i++];
+      for (j = 0; j < g->n_events; j++) {
+         InstrInfo* n      = g->events[j].inode;
+         LineCost*  c      = COST(n);
+         UWord      szkind = g->events[j].szkind;
+         switch ((SimKind)(szkind & 3)) {
+            case SimK_IrNoX:
+               cachesim_I1_doref_NoX(n->instr_addr, n->instr_len,
+                                     &c->Ir.m1, &c->Ir.m2,
+                                     &c->Ir.mL, &c->Ir.mT);
+               c->Ir.a++;
+               break;
+            case SimK_IrGen:
+               cachesim_I1_doref_Gen(n->instr_addr, n->instr_len,
+                                     &c->Ir.m1, &c->Ir.m2,
+                                     &c->Ir.mL, &c->Ir.mT);
+               c->Ir.a++;
+               break;
+            case SimK_Dr:
+               cachesim_D1_doref(sim_buf[i++], szkind >> 2,
+                                 &c->Dr.m1, &c->Dr.m2,
+                                 &c->Dr.mL, &c->Dr.mT);
+               c->Dr.a++;
+               break;
+            case SimK_Dw:
+               cachesim_D1_doref(sim_buf[i++], szkind >> 2,
+                                 &c->Dw.m1, &c->Dw.m2,
+                                 &c->Dw.mL, &c->Dw.mT);
+               c->Dw.a++;
+               break;
+         }
+      }
+      sim_buf_events += g->n_events;
+   }
+   tl_assert(i == sim_buf_used);
+   sim_buf_drains++;
+   sim_buf_used = 0;
+}
+
+// Called from generated code when sim_buf can't take the next group.
+static VG_REGPARM(0)
+void log_sim_buf_full(void)
+{
+   sim_buf_drain();
 }
 
 /* For branches, we consult two different predictors, one which
@@ -451,20 +693,22 @@ void log_0Ir_1Dw_cache_access(InstrInfo* n, Addr data_addr, Word data_size)
 static VG_REGPARM(2)
 void log_cond_branch(InstrInfo* n, Word taken)
 {
+   LineCost* c = COST(n);
    //VG_(printf)("cbrnch:  CCaddr=0x%010lx,  taken=0x%010lx\n",
    //             n, taken);
-   n->parent->Bc.b++;
-   n->parent->Bc.mp 
+   c->Bc.b++;
+   c->Bc.mp 
       += (1 & do_cond_branch_predict(n->instr_addr, taken));
 }
 
 static VG_REGPARM(2)
 void log_ind_branch(InstrInfo* n, UWord actual_dst)
 {
+   LineCost* c = COST(n);
    //VG_(printf)("ibrnch:  CCaddr=0x%010lx,    dst=0x%010lx\n",
    //             n, actual_dst);
-   n->parent->Bi.b++;
-   n->parent->Bi.mp
+   c->Bi.b++;
+   c->Bi.mp
       += (1 & do_ind_branch_predict(n->instr_addr, actual_dst));
 }
 
@@ -630,8 +874,9 @@ SB_info* get_SB_info(IRSB* sbIn, Addr origAddr)
    // been unloaded and then reloaded elsewhere in memory)
    sbInfo = VG_(OSetGen_AllocNode)(instrInfoTable,
                                 sizeof(SB_info) + n_instrs*sizeof(InstrInfo)); 
-   sbInfo->SB_addr  = origAddr;
-   sbInfo->n_instrs = n_instrs;
+   sbInfo->SB_addr    = origAddr;
+   sbInfo->n_instrs   = n_instrs;
+   sbInfo->sim_groups = NULL;
    VG_(OSetGen_Insert)( instrInfoTable, sbInfo );
 
    return sbInfo;
@@ -688,12 +933,133 @@ InstrInfo* setup_InstrInfo ( CgState* cgs, Addr instr_addr, UInt instr_len )
    i_node = &cgs->sbInfo->instrs[ cgs->sbInfo_i ];
    i_node->instr_addr = instr_addr;
    i_node->instr_len  = instr_len;
-   i_node->parent     = get_lineCC(instr_addr);
+   i_node->cost_idx   = get_lineCC(instr_addr)->idx;
    cgs->sbInfo_i++;
    return i_node;
 }
 
 
+#if defined(VG_BIGENDIAN)
+# define CGEndness Iend_BE
+#elif defined(VG_LITTLEENDIAN)
+# define CGEndness Iend_LE
+#else
+# error "Unknown endianness"
+#endif
+
+/* Emit IR which appends a SimGroup for the outstanding cache events,
+   and their data addresses, to sim_buf, first draining sim_buf if
+   there's no room for them. */
+static void appendSimGroup ( CgState* cgs )
+{
+   Int       i, n_events, n_words;
+   IRSB*     sbOut  = cgs->sbOut;
+   IRType    tyW    = sizeof(HWord) == 8 ? Ity_I64 : Ity_I32;
+   IROp      opAdd  = tyW == Ity_I64 ? Iop_Add64    : Iop_Add32;
+   IROp      opShl  = tyW == Ity_I64 ? Iop_Shl64    : Iop_Shl32;
+   IROp      opCmp  = tyW == Ity_I64 ? Iop_CmpLT64U : Iop_CmpLT32U;
+   IRExpr*   usedA  = mkIRExpr_HWord( (HWord)&sim_buf_used );
+   IRTemp    used0, full, used, offs, base, used1;
+   IRDirty*  di;
+   SimGroup* g;
+
+   n_events = 0;
+   for (i = 0; i < cgs->events_used; i++) {
+      if (cgs->events[i].tag != Ev_Bc && cgs->events[i].tag != Ev_Bi)
+         n_events++;
+   }
+   if (n_events == 0)
+      return;
+
+   g = VG_(malloc)( "cg.main.asg.1",
+                    sizeof(SimGroup) + n_events * sizeof(g->events[0]) );
+   g->next     = cgs->sbInfo->sim_groups;
+   g->n_events = n_events;
+   cgs->sbInfo->sim_groups = g;
+
+   n_events = 0;
+   n_words  = 1;
+   for (i = 0; i < cgs->events_used; i++) {
+      Event* ev = &cgs->events[i];
+      UWord  kind;
+      switch (ev->tag) {
+         case Ev_IrNoX: kind = SimK_IrNoX; break;
+         case Ev_IrGen: kind = SimK_IrGen; break;
+         case Ev_Dr:
+         case Ev_Dm:    kind = SimK_Dr;    break;
+         case Ev_Dw:    kind = SimK_Dw;    break;
+         default:       continue;
+      }
+      if (kind == SimK_Dr || kind == SimK_Dw) {
+         kind |= (UWord)get_Event_dszB(ev) << 2;
+         n_words++;
+      }
+      g->events[n_events].inode  = ev->inode;
+      g->events[n_events].szkind = kind;
+      n_events++;
+   }
+   tl_assert(n_words <= N_SIM_BUF);
+
+   /* if (N_SIM_BUF - n_words < sim_buf_used) log_sim_buf_full(); */
+   used0 = newIRTemp(sbOut->tyenv, tyW);
+   full  = newIRTemp(sbOut->tyenv, Ity_I1);
+   addStmtToIRSB( sbOut,
+      IRStmt_WrTmp(used0, IRExpr_Load(CGEndness, tyW, usedA)) );
+   addStmtToIRSB( sbOut,
+      IRStmt_WrTmp(full, IRExpr_Binop(opCmp,
+                                      mkIRExpr_HWord( N_SIM_BUF - n_words ),
+                                      IRExpr_RdTmp(used0))) );
+   di = unsafeIRDirty_0_N( 0, "log_sim_buf_full",
+                           VG_(fnptr_to_fnentry)( &log_sim_buf_full ),
+                           mkIRExprVec_0() );
+   di->guard = IRExpr_RdTmp(full);
+   di->mFx   = Ifx_Modify;
+   di->mAddr = usedA;
+   di->mSize = sizeof(sim_buf_used);
+   addStmtToIRSB( sbOut, IRStmt_Dirty(di) );
+
+   /* base = &sim_buf[sim_buf_used] */
+   used = newIRTemp(sbOut->tyenv, tyW);
+   offs = newIRTemp(sbOut->tyenv, tyW);
+   base = newIRTemp(sbOut->tyenv, tyW);
+   addStmtToIRSB( sbOut,
+      IRStmt_WrTmp(used, IRExpr_Load(CGEndness, tyW, usedA)) );
+   addStmtToIRSB( sbOut,
+      IRStmt_WrTmp(offs, IRExpr_Binop(opShl, IRExpr_RdTmp(used),
+                            IRExpr_Const(IRConst_U8(
+                               sizeof(UWord) == 8 ? 3 : 2)))) );
+   addStmtToIRSB( sbOut,
+      IRStmt_WrTmp(base, IRExpr_Binop(opAdd,
+                                      mkIRExpr_HWord( (HWord)&sim_buf[0] ),
+                                      IRExpr_RdTmp(offs))) );
+
+   addStmtToIRSB( sbOut,
+      IRStmt_Store(CGEndness, IRExpr_RdTmp(base),
+                   mkIRExpr_HWord( (HWord)g )) );
+   n_words = 1;
+   for (i = 0; i < cgs->events_used; i++) {
+      Event* ev = &cgs->events[i];
+      IRTemp slot;
+      if (ev->tag != Ev_Dr && ev->tag != Ev_Dw && ev->tag != Ev_Dm)
+         continue;
+      slot = newIRTemp(sbOut->tyenv, tyW);
+      addStmtToIRSB( sbOut,
+         IRStmt_WrTmp(slot, IRExpr_Binop(opAdd, IRExpr_RdTmp(base),
+                               mkIRExpr_HWord( n_words * sizeof(UWord) ))) );
+      addStmtToIRSB( sbOut,
+         IRStmt_Store(CGEndness, IRExpr_RdTmp(slot), get_Event_dea(ev)) );
+      n_words++;
+   }
+
+   /* sim_buf_used += n_words */
+   used1 = newIRTemp(sbOut->tyenv, tyW);
+   addStmtToIRSB( sbOut,
+      IRStmt_WrTmp(used1, IRExpr_Binop(opAdd, IRExpr_RdTmp(used),
+                                       mkIRExpr_HWord( n_words ))) );
+   addStmtToIRSB( sbOut,
+      IRStmt_Store(CGEndness, usedA, IRExpr_RdTmp(used1)) );
+}
+
 /* Generate code for all outstanding memory events, and mark the queue
    empty.  Code is generated into cgs->bbOut, and this activity
    'consumes' slots in cgs->sbInfo. */
@@ -710,6 +1076,11 @@ static void flushEvents ( CgState* cgs )
    Event*     ev2;
    Event*     ev3;
 
+   /* In batched mode, the cache events go to sim_buf as a SimGroup and
+      only the branch events are left for the loop below. */
+   if (clo_batch_sim && cache_sim_active())
+      appendSimGroup(cgs);
+
    i = 0;
    while (i < cgs->events_used) {
 
@@ -731,6 +1102,12 @@ static void flushEvents ( CgState* cgs )
          showEvent( ev );
       }
 
+      if (clo_batch_sim && cache_sim_active()
+          && ev->tag != Ev_Bc && ev->tag != Ev_Bi) {
+         i++;
+         continue;
+      }
+
       i_node_expr = mkIRExpr_HWord( (HWord)ev->inode );
 
       /* Decide on helper fn to call and args to pass it, and advance
@@ -772,9 +1149,12 @@ static void flushEvents ( CgState* cgs )
             else
             if (ev2 && ev3 && ev2->tag == Ev_IrNoX && ev3->tag == Ev_IrNoX)
             {
-               if (clo_cache_sim) {
+               if (cache_sim_active()) {
                   helperName = "log_3IrNoX_0D_cache_access";
                   helperAddr = &log_3IrNoX_0D_cache_access;
+               } else if (sample_ff) {
+                  helperName = "log_3Ir_ff";
+                  helperAddr = &log_3Ir_ff;
                } else {
                   helperName = "log_3Ir";
                   helperAddr = &log_3Ir;
@@ -788,9 +1168,12 @@ static void flushEvents ( CgState* cgs )
             /* Merge an IrNoX with one following IrNoX. */
             else
             if (ev2 && ev2->tag == Ev_IrNoX) {
-               if (clo_cache_sim) {
+               if (cache_sim_active()) {
                   helperName = "log_2IrNoX_0D_cache_access";
                   helperAddr = &log_2IrNoX_0D_cache_access;
+               } else if (sample_ff) {
+                  helperName = "log_2Ir_ff";
+                  helperAddr = &log_2Ir_ff;
                } else {
                   helperName = "log_2Ir";
                   helperAddr = &log_2Ir;
@@ -802,9 +1185,12 @@ static void flushEvents ( CgState* cgs )
             }
             /* No merging possible; emit as-is. */
             else {
-               if (clo_cache_sim) {
+               if (cache_sim_active()) {
                   helperName = "log_1IrNoX_0D_cache_access";
                   helperAddr = &log_1IrNoX_0D_cache_access;
+               } else if (sample_ff) {
+                  helperName = "log_1Ir_ff";
+                  helperAddr = &log_1Ir_ff;
                } else {
                   helperName = "log_1Ir";
                   helperAddr = &log_1Ir;
@@ -815,9 +1201,12 @@ static void flushEvents ( CgState* cgs )
             }
             break;
          case Ev_IrGen:
-            if (clo_cache_sim) {
+            if (cache_sim_active()) {
 	       helperName = "log_1IrGen_0D_cache_access";
 	       helperAddr = &log_1IrGen_0D_cache_access;
+	    } else if (sample_ff) {
+	       helperName = "log_1Ir_ff";
+	       helperAddr = &log_1Ir_ff;
 	    } else {
 	       helperName = "log_1Ir";
 	       helperAddr = &log_1Ir;
@@ -905,7 +1294,7 @@ void addEvent_Dr ( CgState* cgs, InstrInfo* inode, Int datasize, IRAtom* ea )
    Event* evt;
    tl_assert(isIRAtom(ea));
    tl_assert(datasize >= 1 && datasize <= min_line_size);
-   if (!clo_cache_sim)
+   if (!cache_sim_active())
       return;
    if (cgs->events_used == N_EVENTS)
       flushEvents(cgs);
@@ -928,7 +1317,7 @@ void addEvent_Dw ( CgState* cgs, InstrInfo* inode, Int datasize, IRAtom* ea )
    tl_assert(isIRAtom(ea));
    tl_assert(datasize >= 1 && datasize <= min_line_size);
 
-   if (!clo_cache_sim)
+   if (!cache_sim_active())
       return;
 
    /* Is it possible to merge this write with the preceding read? */
@@ -966,7 +1355,7 @@ void addEvent_D_guarded ( CgState* cgs, InstrInfo* inode,
    tl_assert(isIRAtom(guard));
    tl_assert(datasize >= 1 && datasize <= min_line_size);
 
-   if (!clo_cache_sim)
+   if (!cache_sim_active())
       return;
 
    /* Adding guarded memory actions and merging them with the existing
@@ -985,6 +1374,15 @@ void addEvent_D_guarded ( CgState* cgs, InstrInfo* inode,
    IRExpr**     argv;
    Int          regparms;
    IRDirty*     di;
+   /* The helper simulates this access straight away, so in batched
+      mode the earlier accesses in sim_buf must be simulated first. */
+   if (clo_batch_sim) {
+      di = unsafeIRDirty_0_N( 0, "log_sim_buf_full",
+                              VG_(fnptr_to_fnentry)( &log_sim_buf_full ),
+                              mkIRExprVec_0() );
+      di->guard = guard;
+      addStmtToIRSB( cgs->sbOut, IRStmt_Dirty(di) );
+   }
    i_node_expr = mkIRExpr_HWord( (HWord)inode );
    helperName  = isWrite ? "log_0Ir_1Dw_cache_access"
                          : "log_0Ir_1Dr_cache_access";
@@ -1009,7 +1407,7 @@ void addEvent_Bc ( CgState* cgs, InstrInfo* inode, IRAtom* guard )
    tl_assert(isIRAtom(guard));
    tl_assert(typeOfIRExpr(cgs->sbOut->tyenv, guard) 
              == (sizeof(HWord)==4 ? Ity_I32 : Ity_I64));
-   if (!clo_branch_sim)
+   if (!branch_sim_active())
       return;
    if (cgs->events_used == N_EVENTS)
       flushEvents(cgs);
@@ -1029,7 +1427,7 @@ void addEvent_Bi ( CgState* cgs, InstrInfo* inode, IRAtom* whereTo )
    tl_assert(isIRAtom(whereTo));
    tl_assert(typeOfIRExpr(cgs->sbOut->tyenv, whereTo) 
              == (sizeof(HWord)==4 ? Ity_I32 : Ity_I64));
-   if (!clo_branch_sim)
+   if (!branch_sim_active())
       return;
    if (cgs->events_used == N_EVENTS)
       flushEvents(cgs);
@@ -1093,6 +1491,23 @@ IRSB* cg_instrument ( VgCallbackClosure* closure,
    cgs.sbInfo      = get_SB_info(sbIn, (Addr)closure->readdr);
    cgs.sbInfo_i    = 0;
 
+   // With sampling, count the instructions in the SB as it's entered.
+   // The side exits make this an overestimate, which is good enough for
+   // deciding when to switch modes.
+   if (clo_sample_period > 0) {
+      IRTemp  t1 = newIRTemp(cgs.sbOut->tyenv, Ity_I64);
+      IRTemp  t2 = newIRTemp(cgs.sbOut->tyenv, Ity_I64);
+      IRExpr* counter = mkIRExpr_HWord( (HWord)&sample_instrs );
+      addStmtToIRSB( cgs.sbOut,
+         IRStmt_WrTmp(t1, IRExpr_Load(CGEndness, Ity_I64, counter)) );
+      addStmtToIRSB( cgs.sbOut,
+         IRStmt_WrTmp(t2, IRExpr_Binop(Iop_Add64, IRExpr_RdTmp(t1),
+                             IRExpr_Const(IRConst_U64(
+                                cgs.sbInfo->n_instrs)))) );
+      addStmtToIRSB( cgs.sbOut,
+         IRStmt_Store(CGEndness, counter, IRExpr_RdTmp(t2)) );
+   }
+
    if (DEBUG_CG)
       VG_(printf)("\n\n---------- cg_instrument ----------\n");
 
@@ -1366,12 +1781,98 @@ IRSB* cg_instrument ( VgCallbackClosure* closure,
 
 static cache_t clo_I1_cache = UNDEFINED_CACHE;
 static cache_t clo_D1_cache = UNDEFINED_CACHE;
+static cache_t clo_L2_cache = UNDEFINED_CACHE;
+/* For TLBs, "size" is the number of entries;  line_size is unused. */
+static cache_t clo_ITLB = { 128, 8, 0 };
+static cache_t clo_DTLB = {  64, 4, 0 };
 static cache_t clo_LL_cache = UNDEFINED_CACHE;
 
 /*------------------------------------------------------------*/
 /*--- cg_fini() and related function                       ---*/
 /*------------------------------------------------------------*/
 
+static ULong scale_count(ULong n, Double f)
+{
+   return (ULong)((Double)n * f + 0.5);
+}
+
+static void scale_CacheCC(CacheCC* cc, Double f)
+{
+   cc->a  = scale_count(cc->a,  f);
+   cc->m1 = scale_count(cc->m1, f);
+   cc->m2 = scale_count(cc->m2, f);
+   cc->mL = scale_count(cc->mL, f);
+   cc->mT = scale_count(cc->mT, f);
+}
+
+// Scales each line's counts from the sampled windows up to all of its
+// executed instructions.  Lines never executed in a window only get
+// their instruction counts.
+static void extrapolate_samples(void)
+{
+   UInt i;
+
+   for (i = 0; i < n_lineCCs; i++) {
+      LineCost* cost   = &cur_costs[i];
+      ULong     Ir_all = cost->Ir.a + cost->Ir_ff;
+      Double    f;
+
+      if (cost->Ir_ff == 0)
+         continue;
+      if (cost->Ir.a > 0) {
+         f = (Double)Ir_all / (Double)cost->Ir.a;
+         scale_CacheCC(&cost->Ir, f);
+         scale_CacheCC(&cost->Dr, f);
+         scale_CacheCC(&cost->Dw, f);
+         cost->Bc.b  = scale_count(cost->Bc.b,  f);
+         cost->Bc.mp = scale_count(cost->Bc.mp, f);
+         cost->Bi.b  = scale_count(cost->Bi.b,  f);
+         cost->Bi.mp = scale_count(cost->Bi.mp, f);
+      }
+      cost->Ir.a  = Ir_all;   // exact, whatever the rounding above
+      cost->Ir_ff = 0;
+   }
+}
+
+static void add_CacheCC(CacheCC* dst, CacheCC* src)
+{
+   dst->a  += src->a;
+   dst->m1 += src->m1;
+   dst->m2 += src->m2;
+   dst->mL += src->mL;
+   dst->mT += src->mT;
+}
+
+static void add_BranchCC(BranchCC* dst, BranchCC* src)
+{
+   dst->b  += src->b;
+   dst->mp += src->mp;
+}
+
+// With --separate-threads=yes, adds the other threads' counts to those
+// of the current thread, which are the ones written out.
+static void sum_thread_costs(void)
+{
+   ThreadId s;
+   UInt     i;
+
+   for (s = 0; s < VG_N_THREADS; s++) {
+      LineCost* costs = thread_costs[s];
+      if (costs == NULL || s == cur_slot)
+         continue;
+      for (i = 0; i < n_lineCCs; i++) {
+         add_CacheCC (&cur_costs[i].Ir, &costs[i].Ir);
+         add_CacheCC (&cur_costs[i].Dr, &costs[i].Dr);
+         add_CacheCC (&cur_costs[i].Dw, &costs[i].Dw);
+         add_BranchCC(&cur_costs[i].Bc, &costs[i].Bc);
+         add_BranchCC(&cur_costs[i].Bi, &costs[i].Bi);
+         cur_costs[i].Ir_ff += costs[i].Ir_ff;
+      }
+      VG_(free)(costs);
+      thread_costs[s] = NULL;
+   }
+}
+
 // Total reads/writes/misses.  Calculated during CC traversal at the end.
 // All auto-zeroed.
 static CacheCC  Ir_total;
@@ -1380,13 +1881,106 @@ static CacheCC  Dw_total;
 static BranchCC Bc_total;
 static BranchCC Bi_total;
 
+// Prints the counts for the events on the "events:" line to p, each
+// preceded by a space.  Returns the end of the string.
+static HChar* sprint_counts(HChar* p, CacheCC* Ir, CacheCC* Dr, CacheCC* Dw,
+                            BranchCC* Bc, BranchCC* Bi)
+{
+   p += VG_(sprintf)(p, " %llu", Ir->a);
+   if (clo_cache_sim) {
+      if (L2_sim) {
+         p += VG_(sprintf)(p, " %llu %llu %llu %llu %llu %llu %llu %llu"
+                              " %llu %llu %llu",
+                           Ir->m1, Ir->m2, Ir->mL,
+                           Dr->a, Dr->m1, Dr->m2, Dr->mL,
+                           Dw->a, Dw->m1, Dw->m2, Dw->mL);
+      } else {
+         p += VG_(sprintf)(p, " %llu %llu %llu %llu %llu %llu %llu %llu",
+                           Ir->m1, Ir->mL,
+                           Dr->a, Dr->m1, Dr->mL,
+                           Dw->a, Dw->m1, Dw->mL);
+      }
+   }
+   if (clo_tlb_sim)
+      p += VG_(sprintf)(p, " %llu %llu %llu", Ir->mT, Dr->mT, Dw->mT);
+   if (clo_branch_sim) {
+      p += VG_(sprintf)(p, " %llu %llu %llu %llu",
+                        Bc->b, Bc->mp, Bi->b, Bi->mp);
+   }
+   return p;
+}
+
+// The output file is written through a buffer, as callgrind's dump.c does;
+// one write() per line is very slow for big programs.
+#define OUT_BUFSIZE  32768
+
+static HChar out_buf[OUT_BUFSIZE];
+static Int   out_pos = 0;
+
+static void out_flush(Int fd)
+{
+   if (out_pos > 0)
+      VG_(write)(fd, out_buf, out_pos);
+   out_pos = 0;
+}
+
+static void out_write(Int fd, const HChar* s, Int len)
+{
+   if (out_pos + len > OUT_BUFSIZE)
+      out_flush(fd);
+   if (len > OUT_BUFSIZE) {
+      VG_(write)(fd, s, len);
+      return;
+   }
+   VG_(memcpy)(out_buf + out_pos, s, len);
+   out_pos += len;
+}
+
+// With --compress-output=yes, each file and function name is written in
+// full only once, as "(id) name", and as "(id)" from then on.  Since names
+// are stored once in the string table, they are looked up by address.
+typedef
+   struct {
+      const HChar* name;
+      Int          id;
+   }
+   NameId;
+
+static OSet* out_names[2];   // file names, function names
+static Int   out_next_id[2];
+
+// Prints "fl=" or "fn=" and the name into buf, compressing if need be.
+static void sprint_name(HChar* buf, Int kind, const HChar* name)
+{
+   const HChar* prefix = kind == 0 ? "fl=" : "fn=";
+   NameId* n;
+
+   if (!clo_compress_output) {
+      VG_(sprintf)(buf, "%s%s\n", prefix, name);
+      return;
+   }
+   n = VG_(OSetGen_Lookup)(out_names[kind], &name);
+   if (n) {
+      VG_(sprintf)(buf, "%s(%d)\n", prefix, n->id);
+   } else {
+      n = VG_(OSetGen_AllocNode)(out_names[kind], sizeof(NameId));
+      n->name = name;
+      n->id   = ++out_next_id[kind];
+      VG_(OSetGen_Insert)(out_names[kind], n);
+      VG_(sprintf)(buf, "%s(%d) %s\n", prefix, n->id, name);
+   }
+}
+
 static void fprint_CC_table_and_calc_totals(void)
 {
    Int     i, fd;
    SysRes  sres;
    HChar    buf[512];
+   HChar   *p;
    HChar   *currFile = NULL, *currFn = NULL;
+   UInt    currLine = 0;
    LineCC* lineCC;
+   LineCost* cost;
 
    // Setup output filename.  Nb: it's important to do this now, ie. as late
    // as possible.  If we do it at start-up and the program forks and the
@@ -1411,50 +2005,87 @@ static void fprint_CC_table_and_calc_totals(void)
       VG_(free)(cachegrind_out_file);
    }
 
-   // "desc:" lines (giving I1/D1/LL cache configuration).  The spaces after
-   // the 2nd colon makes cg_annotate's output look nicer.
+   if (clo_compress_output) {
+      for (i = 0; i < 2; i++) {
+         out_names[i] = VG_(OSetGen_Create)(offsetof(NameId, name), NULL,
+                                            VG_(malloc), "cg.fprint.1",
+                                            VG_(free));
+         out_next_id[i] = 0;
+      }
+   }
+
+   // "desc:" lines (giving I1/D1/L2/LL cache configuration).  The spaces
+   // after the 2nd colon makes cg_annotate's output look nicer.
    VG_(sprintf)(buf, "desc: I1 cache:         %s\n"
-                     "desc: D1 cache:         %s\n"
-                     "desc: LL cache:         %s\n",
-                     I1.desc_line, D1.desc_line, LL.desc_line);
-   VG_(write)(fd, (void*)buf, VG_(strlen)(buf));
+                     "desc: D1 cache:         %s\n",
+                     I1.desc_line, D1.desc_line);
+   out_write(fd, buf, VG_(strlen)(buf));
+   if (L2_sim) {
+      VG_(sprintf)(buf, "desc: L2 cache:         %s\n", L2.desc_line);
+      out_write(fd, buf, VG_(strlen)(buf));
+   }
+   VG_(sprintf)(buf, "desc: LL cache:         %s\n", LL.desc_line);
+   out_write(fd, buf, VG_(strlen)(buf));
+   if (clo_sample_period > 0) {
+      VG_(sprintf)(buf, "desc: Sampling:         first %lldM of every %lldM "
+                        "instrs, extrapolated\n",
+                   clo_sample_window, clo_sample_period);
+      out_write(fd, buf, VG_(strlen)(buf));
+   }
+   if (clo_branch_sim && bp_model != BP_Simple) {
+      static const HChar* names[] = { "simple", "gshare", "perceptron",
+                                      "tage" };
+      VG_(sprintf)(buf, "desc: Branch predictor: %s, %d history bits\n",
+                   names[bp_model], bp_hist_len);
+      out_write(fd, buf, VG_(strlen)(buf));
+   }
+   if (clo_tlb_sim) {
+      VG_(sprintf)(buf, "desc: ITLB:             %d entries, %d B pages, "
+                                                "%d-way associative\n"
+                        "desc: DTLB:             %d entries, %d B pages, "
+                                                "%d-way associative\n",
+                   ITLB.size / ITLB.line_size, ITLB.line_size, ITLB.assoc,
+                   DTLB.size / DTLB.line_size, DTLB.line_size, DTLB.assoc);
+      out_write(fd, buf, VG_(strlen)(buf));
+   }
+   if (clo_separate_threads && clo_cache_sim) {
+      VG_(sprintf)(buf, "desc: Threads:          each with its own I1, D1%s%s\n",
+                   L2_sim ? ", L2" : "", clo_tlb_sim ? ", ITLB, DTLB" : "");
+      out_write(fd, buf, VG_(strlen)(buf));
+   }
 
    // "cmd:" line
    VG_(strcpy)(buf, "cmd:");
-   VG_(write)(fd, (void*)buf, VG_(strlen)(buf));
-   VG_(write)(fd, " ", 1);
-   VG_(write)(fd, VG_(args_the_exename), 
-              VG_(strlen)( VG_(args_the_exename) ));
+   out_write(fd, buf, VG_(strlen)(buf));
+   out_write(fd, " ", 1);
+   out_write(fd, VG_(args_the_exename),
+             VG_(strlen)( VG_(args_the_exename) ));
    for (i = 0; i < VG_(sizeXA)( VG_(args_for_client) ); i++) {
       HChar* arg = * (HChar**) VG_(indexXA)( VG_(args_for_client), i );
       if (arg) {
-         VG_(write)(fd, " ", 1);
-         VG_(write)(fd, arg, VG_(strlen)( arg ));
+         out_write(fd, " ", 1);
+         out_write(fd, arg, VG_(strlen)( arg ));
       }
    }
    // "events:" line
-   if (clo_cache_sim && clo_branch_sim) {
-      VG_(sprintf)(buf, "\nevents: Ir I1mr ILmr Dr D1mr DLmr Dw D1mw DLmw "
-                                  "Bc Bcm Bi Bim\n");
-   }
-   else if (clo_cache_sim && !clo_branch_sim) {
-      VG_(sprintf)(buf, "\nevents: Ir I1mr ILmr Dr D1mr DLmr Dw D1mw DLmw "
-                                  "\n");
-   }
-   else if (!clo_cache_sim && clo_branch_sim) {
-      VG_(sprintf)(buf, "\nevents: Ir "
-                                  "Bc Bcm Bi Bim\n");
-   }
-   else {
-      VG_(sprintf)(buf, "\nevents: Ir\n");
+   VG_(strcpy)(buf, "\nevents: Ir");
+   if (clo_cache_sim) {
+      VG_(strcat)(buf, L2_sim ? " I1mr I2mr ILmr Dr D1mr D2mr DLmr"
+                                " Dw D1mw D2mw DLmw"
+                              : " I1mr ILmr Dr D1mr DLmr Dw D1mw DLmw");
    }
-
-   VG_(write)(fd, (void*)buf, VG_(strlen)(buf));
+   if (clo_tlb_sim)
+      VG_(strcat)(buf, " ITLBmr DTLBmr DTLBmw");
+   if (clo_branch_sim)
+      VG_(strcat)(buf, " Bc Bcm Bi Bim");
+   VG_(strcat)(buf, "\n");
+   out_write(fd, buf, VG_(strlen)(buf));
 
    // Traverse every lineCC
    VG_(OSetGen_ResetIter)(CC_table);
    while ( (lineCC = VG_(OSetGen_Next)(CC_table)) ) {
       Bool just_hit_a_new_file = False;
+      cost = &cur_costs[lineCC->idx];
       // If we've hit a new file, print a "fl=" line.  Note that because
       // each string is stored exactly once in the string table, we can use
       // pointer comparison rather than strcmp() to test for equality, which
@@ -1462,8 +2093,8 @@ static void fprint_CC_table_and_calc_totals(void)
       // the whole strings would have to be checked.
       if ( lineCC->loc.file != currFile ) {
          currFile = lineCC->loc.file;
-         VG_(sprintf)(buf, "fl=%s\n", currFile);
-         VG_(write)(fd, (void*)buf, VG_(strlen)(buf));
+         sprint_name(buf, 0, currFile);
+         out_write(fd, buf, VG_(strlen)(buf));
          distinct_files++;
          just_hit_a_new_file = True;
       }
@@ -1473,106 +2104,76 @@ static void fprint_CC_table_and_calc_totals(void)
       // in the old file, hence the just_hit_a_new_file test).
       if ( just_hit_a_new_file || lineCC->loc.fn != currFn ) {
          currFn = lineCC->loc.fn;
-         VG_(sprintf)(buf, "fn=%s\n", currFn);
-         VG_(write)(fd, (void*)buf, VG_(strlen)(buf));
+         sprint_name(buf, 1, currFn);
+         out_write(fd, buf, VG_(strlen)(buf));
          distinct_fns++;
       }
 
-      // Print the LineCC
-      if (clo_cache_sim && clo_branch_sim) {
-         VG_(sprintf)(buf, "%u %llu %llu %llu"
-                             " %llu %llu %llu"
-                             " %llu %llu %llu"
-                             " %llu %llu %llu %llu\n",
-                            lineCC->loc.line,
-                            lineCC->Ir.a, lineCC->Ir.m1, lineCC->Ir.mL, 
-                            lineCC->Dr.a, lineCC->Dr.m1, lineCC->Dr.mL,
-                            lineCC->Dw.a, lineCC->Dw.m1, lineCC->Dw.mL,
-                            lineCC->Bc.b, lineCC->Bc.mp, 
-                            lineCC->Bi.b, lineCC->Bi.mp);
-      }
-      else if (clo_cache_sim && !clo_branch_sim) {
-         VG_(sprintf)(buf, "%u %llu %llu %llu"
-                             " %llu %llu %llu"
-                             " %llu %llu %llu\n",
-                            lineCC->loc.line,
-                            lineCC->Ir.a, lineCC->Ir.m1, lineCC->Ir.mL, 
-                            lineCC->Dr.a, lineCC->Dr.m1, lineCC->Dr.mL,
-                            lineCC->Dw.a, lineCC->Dw.m1, lineCC->Dw.mL);
-      }
-      else if (!clo_cache_sim && clo_branch_sim) {
-         VG_(sprintf)(buf, "%u %llu"
-                             " %llu %llu %llu %llu\n",
-                            lineCC->loc.line,
-                            lineCC->Ir.a, 
-                            lineCC->Bc.b, lineCC->Bc.mp, 
-                            lineCC->Bi.b, lineCC->Bi.mp);
-      }
-      else {
-         VG_(sprintf)(buf, "%u %llu\n",
-                            lineCC->loc.line,
-                            lineCC->Ir.a);
+      // Print the LineCC.  When compressing, the line number is given
+      // relative to the previous one, and trailing zero counts (but not
+      // the first count) are left out.
+      if (!clo_compress_output) {
+         p = buf + VG_(sprintf)(buf, "%u", lineCC->loc.line);
+         p = sprint_counts(p, &cost->Ir, &cost->Dr, &cost->Dw,
+                           &cost->Bc, &cost->Bi);
+      } else {
+         HChar* first_end;
+         if (lineCC->loc.line >= currLine)
+            p = buf + VG_(sprintf)(buf, "+%u", lineCC->loc.line - currLine);
+         else
+            p = buf + VG_(sprintf)(buf, "-%u", currLine - lineCC->loc.line);
+         currLine = lineCC->loc.line;
+         p = sprint_counts(p, &cost->Ir, &cost->Dr, &cost->Dw,
+                           &cost->Bc, &cost->Bi);
+         first_end = VG_(strchr)(buf, ' ') + 1;
+         while (*first_end != ' ' && *first_end != '\0')
+            first_end++;
+         while (p > first_end && p[-1] == '0' && p[-2] == ' ')
+            p -= 2;
       }
+      VG_(strcpy)(p, "\n");
 
-      VG_(write)(fd, (void*)buf, VG_(strlen)(buf));
+      out_write(fd, buf, VG_(strlen)(buf));
 
       // Update summary stats
-      Ir_total.a  += lineCC->Ir.a;
-      Ir_total.m1 += lineCC->Ir.m1;
-      Ir_total.mL += lineCC->Ir.mL;
-      Dr_total.a  += lineCC->Dr.a;
-      Dr_total.m1 += lineCC->Dr.m1;
-      Dr_total.mL += lineCC->Dr.mL;
-      Dw_total.a  += lineCC->Dw.a;
-      Dw_total.m1 += lineCC->Dw.m1;
-      Dw_total.mL += lineCC->Dw.mL;
-      Bc_total.b  += lineCC->Bc.b;
-      Bc_total.mp += lineCC->Bc.mp;
-      Bi_total.b  += lineCC->Bi.b;
-      Bi_total.mp += lineCC->Bi.mp;
+      Ir_total.a  += cost->Ir.a;
+      Ir_total.m1 += cost->Ir.m1;
+      Ir_total.m2 += cost->Ir.m2;
+      Ir_total.mL += cost->Ir.mL;
+      Ir_total.mT += cost->Ir.mT;
+      Dr_total.a  += cost->Dr.a;
+      Dr_total.m1 += cost->Dr.m1;
+      Dr_total.m2 += cost->Dr.m2;
+      Dr_total.mL += cost->Dr.mL;
+      Dr_total.mT += cost->Dr.mT;
+      Dw_total.a  += cost->Dw.a;
+      Dw_total.m1 += cost->Dw.m1;
+      Dw_total.m2 += cost->Dw.m2;
+      Dw_total.mL += cost->Dw.mL;
+      Dw_total.mT += cost->Dw.mT;
+      Bc_total.b  += cost->Bc.b;
+      Bc_total.mp += cost->Bc.mp;
+      Bi_total.b  += cost->Bi.b;
+      Bi_total.mp += cost->Bi.mp;
 
       distinct_lines++;
    }
 
    // Summary stats must come after rest of table, since we calculate them
    // during traversal.  */
-   if (clo_cache_sim && clo_branch_sim) {
-      VG_(sprintf)(buf, "summary:"
-                        " %llu %llu %llu"
-                        " %llu %llu %llu"
-                        " %llu %llu %llu"
-                        " %llu %llu %llu %llu\n", 
-                        Ir_total.a, Ir_total.m1, Ir_total.mL,
-                        Dr_total.a, Dr_total.m1, Dr_total.mL,
-                        Dw_total.a, Dw_total.m1, Dw_total.mL,
-                        Bc_total.b, Bc_total.mp, 
-                        Bi_total.b, Bi_total.mp);
-   }
-   else if (clo_cache_sim && !clo_branch_sim) {
-      VG_(sprintf)(buf, "summary:"
-                        " %llu %llu %llu"
-                        " %llu %llu %llu"
-                        " %llu %llu %llu\n",
-                        Ir_total.a, Ir_total.m1, Ir_total.mL,
-                        Dr_total.a, Dr_total.m1, Dr_total.mL,
-                        Dw_total.a, Dw_total.m1, Dw_total.mL);
-   }
-   else if (!clo_cache_sim && clo_branch_sim) {
-      VG_(sprintf)(buf, "summary:"
-                        " %llu"
-                        " %llu %llu %llu %llu\n", 
-                        Ir_total.a,
-                        Bc_total.b, Bc_total.mp, 
-                        Bi_total.b, Bi_total.mp);
-   }
-   else {
-      VG_(sprintf)(buf, "summary:"
-                        " %llu\n", 
-                        Ir_total.a);
-   }
-
-   VG_(write)(fd, (void*)buf, VG_(strlen)(buf));
+   p = buf + VG_(sprintf)(buf, "summary:");
+   p = sprint_counts(p, &Ir_total, &Dr_total, &Dw_total,
+                     &Bc_total, &Bi_total);
+   VG_(strcpy)(p, "\n");
+
+   out_write(fd, buf, VG_(strlen)(buf));
+   out_flush(fd);
    VG_(close)(fd);
+
+   if (clo_compress_output) {
+      for (i = 0; i < 2; i++)
+         VG_(OSetGen_Destroy)(out_names[i]);
+   }
 }
 
 static UInt ULong_width(ULong n)
@@ -1595,8 +2196,19 @@ static void cg_fini(Int exitcode)
    BranchCC B_total;
    ULong LL_total_m, LL_total_mr, LL_total_mw,
          LL_total, LL_total_r, LL_total_w;
+   ULong L2_total_m, L2_total_mr, L2_total_mw,
+         L2_total, L2_total_r, L2_total_w;
    Int l1, l2, l3;
 
+   if (clo_batch_sim)
+      sim_buf_drain();
+
+   if (clo_separate_threads)
+      sum_thread_costs();
+
+   if (clo_sample_period > 0)
+      extrapolate_samples();
+
    fprint_CC_table_and_calc_totals();
 
    if (VG_(clo_verbosity) == 0) 
@@ -1621,12 +2233,19 @@ static void cg_fini(Int exitcode)
       miss numbers */
    if (clo_cache_sim) {
       VG_(umsg)(fmt, "I1  misses:   ", Ir_total.m1);
+      if (L2_sim)
+         VG_(umsg)(fmt, "I2  misses:   ", Ir_total.m2);
       VG_(umsg)(fmt, "LLi misses:   ", Ir_total.mL);
 
       if (0 == Ir_total.a) Ir_total.a = 1;
       VG_(percentify)(Ir_total.m1, Ir_total.a, 2, l1+1, buf1);
       VG_(umsg)("I1  miss rate: %s\n", buf1);
 
+      if (L2_sim) {
+         VG_(percentify)(Ir_total.m2, Ir_total.a, 2, l1+1, buf1);
+         VG_(umsg)("I2  miss rate: %s\n", buf1);
+      }
+
       VG_(percentify)(Ir_total.mL, Ir_total.a, 2, l1+1, buf1);
       VG_(umsg)("LLi miss rate: %s\n", buf1);
       VG_(umsg)("\n");
@@ -1635,6 +2254,7 @@ static void cg_fini(Int exitcode)
        * determine the width of columns 2 & 3. */
       D_total.a  = Dr_total.a  + Dw_total.a;
       D_total.m1 = Dr_total.m1 + Dw_total.m1;
+      D_total.m2 = Dr_total.m2 + Dw_total.m2;
       D_total.mL = Dr_total.mL + Dw_total.mL;
 
       /* Make format string, getting width right for numbers */
@@ -1645,6 +2265,9 @@ static void cg_fini(Int exitcode)
                      D_total.a, Dr_total.a, Dw_total.a);
       VG_(umsg)(fmt, "D1  misses:   ",
                      D_total.m1, Dr_total.m1, Dw_total.m1);
+      if (L2_sim)
+         VG_(umsg)(fmt, "D2  misses:   ",
+                        D_total.m2, Dr_total.m2, Dw_total.m2);
       VG_(umsg)(fmt, "LLd misses:   ",
                      D_total.mL, Dr_total.mL, Dw_total.mL);
 
@@ -1656,17 +2279,52 @@ static void cg_fini(Int exitcode)
       VG_(percentify)(Dw_total.m1, Dw_total.a, 1, l3+1, buf3);
       VG_(umsg)("D1  miss rate: %s (%s     + %s  )\n", buf1, buf2,buf3);
 
+      if (L2_sim) {
+         VG_(percentify)( D_total.m2,  D_total.a, 1, l1+1, buf1);
+         VG_(percentify)(Dr_total.m2, Dr_total.a, 1, l2+1, buf2);
+         VG_(percentify)(Dw_total.m2, Dw_total.a, 1, l3+1, buf3);
+         VG_(umsg)("D2  miss rate: %s (%s     + %s  )\n", buf1, buf2,buf3);
+      }
+
       VG_(percentify)( D_total.mL,  D_total.a, 1, l1+1, buf1);
       VG_(percentify)(Dr_total.mL, Dr_total.a, 1, l2+1, buf2);
       VG_(percentify)(Dw_total.mL, Dw_total.a, 1, l3+1, buf3);
       VG_(umsg)("LLd miss rate: %s (%s     + %s  )\n", buf1, buf2,buf3);
       VG_(umsg)("\n");
 
+      /* L2 overall results */
+
+      if (L2_sim) {
+         L2_total   = Dr_total.m1 + Dw_total.m1 + Ir_total.m1;
+         L2_total_r = Dr_total.m1 + Ir_total.m1;
+         L2_total_w = Dw_total.m1;
+         VG_(umsg)(fmt, "L2 refs:      ",
+                        L2_total, L2_total_r, L2_total_w);
+
+         L2_total_m  = Dr_total.m2 + Dw_total.m2 + Ir_total.m2;
+         L2_total_mr = Dr_total.m2 + Ir_total.m2;
+         L2_total_mw = Dw_total.m2;
+         VG_(umsg)(fmt, "L2 misses:    ",
+                        L2_total_m, L2_total_mr, L2_total_mw);
+
+         VG_(percentify)(L2_total_m,  (Ir_total.a + D_total.a),  1, l1+1, buf1);
+         VG_(percentify)(L2_total_mr, (Ir_total.a + Dr_total.a), 1, l2+1, buf2);
+         VG_(percentify)(L2_total_mw, Dw_total.a,                1, l3+1, buf3);
+         VG_(umsg)("L2 miss rate:  %s (%s     + %s  )\n", buf1, buf2,buf3);
+         VG_(umsg)("\n");
+      }
+
       /* LL overall results */
 
-      LL_total   = Dr_total.m1 + Dw_total.m1 + Ir_total.m1;
-      LL_total_r = Dr_total.m1 + Ir_total.m1;
-      LL_total_w = Dw_total.m1;
+      if (L2_sim) {
+         LL_total   = Dr_total.m2 + Dw_total.m2 + Ir_total.m2;
+         LL_total_r = Dr_total.m2 + Ir_total.m2;
+         LL_total_w = Dw_total.m2;
+      } else {
+         LL_total   = Dr_total.m1 + Dw_total.m1 + Ir_total.m1;
+         LL_total_r = Dr_total.m1 + Ir_total.m1;
+         LL_total_w = Dw_total.m1;
+      }
       VG_(umsg)(fmt, "LL refs:      ",
                      LL_total, LL_total_r, LL_total_w);
 
@@ -1682,6 +2340,25 @@ static void cg_fini(Int exitcode)
       VG_(umsg)("LL miss rate:  %s (%s     + %s  )\n", buf1, buf2,buf3);
    }
 
+   /* If TLB simulation is enabled, show TLB results. */
+   if (clo_tlb_sim) {
+      VG_(umsg)("\n");
+      VG_(sprintf)(fmt, "%%s %%,%dllu\n", l1);
+      VG_(umsg)(fmt, "ITLB misses:  ", Ir_total.mT);
+      VG_(percentify)(Ir_total.mT, Ir_total.a, 2, l1+1, buf1);
+      VG_(umsg)("ITLB miss rate:%s\n", buf1);
+
+      VG_(sprintf)(fmt, "%%s %%,%dllu  (%%,%dllu rd   + %%,%dllu wr)\n",
+                        l1, l2, l3);
+      VG_(umsg)(fmt, "DTLB misses:  ",
+                     Dr_total.mT + Dw_total.mT, Dr_total.mT, Dw_total.mT);
+      VG_(percentify)(Dr_total.mT + Dw_total.mT, Dr_total.a + Dw_total.a,
+                      1, l1+1, buf1);
+      VG_(percentify)(Dr_total.mT, Dr_total.a, 1, l2+1, buf2);
+      VG_(percentify)(Dw_total.mT, Dw_total.a, 1, l3+1, buf3);
+      VG_(umsg)("DTLB miss rate:%s (%s     + %s  )\n", buf1, buf2,buf3);
+   }
+
    /* If branch profiling is enabled, show branch overall results. */
    if (clo_branch_sim) {
       /* Make format string, getting width right for numbers */
@@ -1739,6 +2416,13 @@ static void cg_fini(Int exitcode)
                 VG_(OSetGen_Size)(CC_table));
       VG_(dmsg)("cachegrind: InstrInfo table size: %lu\n",
                 VG_(OSetGen_Size)(instrInfoTable));
+      if (clo_batch_sim)
+         VG_(dmsg)("cachegrind: batched sim: %llu events in %llu drains\n",
+                   sim_buf_events, sim_buf_drains);
+      if (clo_prefetch_sim)
+         VG_(dmsg)("cachegrind: prefetches issued: %llu\n", pf_issued);
+      if (clo_sample_period > 0)
+         VG_(dmsg)("cachegrind: sampled windows: %llu\n", sample_windows);
    }
 }
 
@@ -1762,27 +2446,145 @@ void cg_discard_superblock_info ( Addr64 orig_addr64, VexGuestExtents vge )
                    (void*)(Addr)orig_addr,
                    (void*)(Addr)vge.base[0], (ULong)vge.len[0]);
 
+   // sim_buf may refer to this BB's SimGroups and InstrInfos.
+   if (clo_batch_sim)
+      sim_buf_drain();
+
    // Get BB info, remove from table, free BB info.  Simple!  Note that we
    // use orig_addr, not the first instruction address in vge.
    sbInfo = VG_(OSetGen_Remove)(instrInfoTable, &orig_addr);
    tl_assert(NULL != sbInfo);
+   while (sbInfo->sim_groups) {
+      SimGroup* g = sbInfo->sim_groups;
+      sbInfo->sim_groups = g->next;
+      VG_(free)(g);
+   }
    VG_(OSetGen_FreeNode)(instrInfoTable, sbInfo);
 }
 
+/*--------------------------------------------------------------------*/
+/*--- Sampling mode switches                                       ---*/
+/*--------------------------------------------------------------------*/
+
+/* Not exported to tools;  callgrind declares it the same way. */
+extern void VG_(discard_translations) ( Addr64 start, ULong range, const HChar* who );
+
+// Called at the end of each thread time slice, before the scheduler looks
+// up the next translation, so it is a safe point to throw away all
+// translations when a window starts or ends.
+static void cg_stop_client_code(ThreadId tid, ULong blocks_dispatched)
+{
+   if (clo_sample_period == 0 || sample_instrs < sample_next)
+      return;
+
+   sample_ff = !sample_ff;
+   if (sample_ff) {
+      sample_next = sample_instrs +
+                    (clo_sample_period - clo_sample_window) * 1000000ULL;
+   } else {
+      sample_next = sample_instrs + clo_sample_window * 1000000ULL;
+      sample_windows++;
+   }
+   if (VG_(clo_verbosity) > 1)
+      VG_(dmsg)("cachegrind: %s at %'llu instructions\n",
+                sample_ff ? "fast-forwarding" : "simulating", sample_instrs);
+
+   // Nb: this calls cg_discard_superblock_info for each SB, which drains
+   // sim_buf if need be.
+   VG_(discard_translations)( (Addr64)0x1000, (ULong) ~0xfffl, "cachegrind");
+}
+
+// With --separate-threads=yes, called at the start of each thread time
+// slice, to make the thread's costs and private caches the current ones.
+static void cg_start_client_code(ThreadId tid, ULong blocks_dispatched)
+{
+   if (tid == cur_slot)
+      return;
+
+   if (clo_batch_sim)
+      sim_buf_drain();
+
+   if (thread_costs[tid] == NULL)
+      thread_costs[tid] = new_costs();
+   if (clo_cache_sim) {
+      if (thread_caches[cur_slot] == NULL)
+         thread_caches[cur_slot] = VG_(malloc)("cg.main.csc.1",
+                                               sizeof(cache_private_t));
+      if (thread_caches[tid] == NULL) {
+         thread_caches[tid] = VG_(malloc)("cg.main.csc.2",
+                                          sizeof(cache_private_t));
+         cachesim_init_private(thread_caches[tid]);
+      }
+      cachesim_switch_private(thread_caches[cur_slot], thread_caches[tid]);
+   }
+   cur_slot  = tid;
+   cur_costs = thread_costs[tid];
+}
+
 /*--------------------------------------------------------------------*/
 /*--- Command line processing                                      ---*/
 /*--------------------------------------------------------------------*/
 
+// Parses "<entries>,<assoc>".  The entries are checked in
+// cg_post_clo_init, once the page size is known.
+static void parse_tlb_opt(cache_t* tlb, const HChar* opt, const HChar* optval)
+{
+   Long   i1, i2;
+   HChar* endptr;
+
+   i1 = VG_(strtoll10)(optval,   &endptr); if (*endptr != ',')  goto bad;
+   i2 = VG_(strtoll10)(endptr+1, &endptr); if (*endptr != '\0') goto bad;
+   if (i1 <= 0 || i2 <= 0 || i1 > 65536 || i2 > i1) goto bad;
+   tlb->size  = (Int)i1;
+   tlb->assoc = (Int)i2;
+   return;
+
+  bad:
+   VG_(fmsg_bad_option)(opt, "");
+}
+
 static Bool cg_process_cmd_line_option(const HChar* arg)
 {
+   const HChar* tmp_str;
+
    if (VG_(str_clo_cache_opt)(arg,
                               &clo_I1_cache,
                               &clo_D1_cache,
+                              &clo_L2_cache,
                               &clo_LL_cache)) {}
 
    else if VG_STR_CLO( arg, "--cachegrind-out-file", clo_cachegrind_out_file) {}
    else if VG_BOOL_CLO(arg, "--cache-sim",  clo_cache_sim)  {}
    else if VG_BOOL_CLO(arg, "--branch-sim", clo_branch_sim) {}
+   else if VG_XACT_CLO(arg, "--branch-predictor=simple",
+                            clo_branch_predictor, BP_Simple) {}
+   else if VG_XACT_CLO(arg, "--branch-predictor=gshare",
+                            clo_branch_predictor, BP_GShare) {}
+   else if VG_XACT_CLO(arg, "--branch-predictor=perceptron",
+                            clo_branch_predictor, BP_Perceptron) {}
+   else if VG_XACT_CLO(arg, "--branch-predictor=tage",
+                            clo_branch_predictor, BP_TAGE) {}
+   else if VG_BINT_CLO(arg, "--branch-history", clo_branch_history, 1, 64) {}
+   else if VG_BOOL_CLO(arg, "--batch-sim",  clo_batch_sim)  {}
+   else if VG_BOOL_CLO(arg, "--compress-output", clo_compress_output) {}
+   else if VG_BINT_CLO(arg, "--cache-levels", clo_cache_levels, 2, 3) {}
+   else if VG_XACT_CLO(arg, "--L2-policy=inclusive", clo_L2_exclusive, False) {}
+   else if VG_XACT_CLO(arg, "--L2-policy=exclusive", clo_L2_exclusive, True) {}
+   else if VG_BOOL_CLO(arg, "--tlb-sim",      clo_tlb_sim)      {}
+   else if VG_BOOL_CLO(arg, "--prefetch-sim", clo_prefetch_sim) {}
+   else if VG_BINT_CLO(arg, "--tlb-page-size", clo_tlb_page_size,
+                       4096, 1024*1024*1024) {}
+   else if VG_BOOL_CLO(arg, "--separate-threads", clo_separate_threads) {}
+   else if VG_BINT_CLO(arg, "--sample-period", clo_sample_period,
+                       0, 1000000) {}
+   else if VG_BINT_CLO(arg, "--sample-window", clo_sample_window,
+                       1, 1000000) {}
+   else if VG_STR_CLO(arg, "--ITLB", tmp_str) {
+      parse_tlb_opt(&clo_ITLB, arg, tmp_str);
+   }
+   else if VG_STR_CLO(arg, "--DTLB", tmp_str) {
+      parse_tlb_opt(&clo_DTLB, arg, tmp_str);
+   }
    else
       return False;
 
@@ -1793,9 +2595,32 @@ static void cg_print_usage(void)
 {
    VG_(print_cache_clo_opts)();
    VG_(printf)(
+"    --L2=<size>,<assoc>,<line_size>  set L2 cache manually (with\n"
+"                                     --cache-levels=3;  else same as --LL)\n"
+"    --cache-levels=2|3  [2]          simulate L1 and LL, or L1, L2 and LL\n"
+"    --L2-policy=inclusive|exclusive [inclusive]\n"
+"                                     does L2 hold only lines evicted from L1?\n"
+"    --tlb-sim=yes|no  [no]           collect ITLB and DTLB miss stats?\n"
+"    --ITLB=<entries>,<assoc>  [128,8]  set ITLB manually\n"
+"    --DTLB=<entries>,<assoc>  [64,4]   set DTLB manually\n"
+"    --tlb-page-size=<bytes>  [4096]  page size for the TLBs (eg. 2097152)\n"
+"    --prefetch-sim=yes|no  [no]      simulate a stride prefetcher into LL?\n"
+"    --separate-threads=no|yes [no]   give each thread its own I1, D1, L2\n"
+"                                     and TLBs, and its own counts?\n"
+"    --sample-period=<M>  [0]         simulate only a window of every M\n"
+"                                     million instrs, and extrapolate;\n"
+"                                     0 means simulate everything\n"
+"    --sample-window=<N>  [1]         window length, in millions of instrs\n"
 "    --cache-sim=yes|no  [yes]        collect cache stats?\n"
 "    --branch-sim=yes|no [no]         collect branch prediction stats?\n"
+"    --branch-predictor=simple|gshare|perceptron|tage [simple]\n"
+"                                     model for conditional branches\n"
+"    --branch-history=<n>             history bits used by the model\n"
+"                                     [gshare 12, perceptron 32, tage 64]\n"
+"    --batch-sim=yes|no  [no]         buffer accesses and simulate them\n"
+"                                     in batches?\n"
 "    --cachegrind-out-file=<file>     output file name [cachegrind.out.%%p]\n"
+"    --compress-output=no|yes [no]    write a more compact output file?\n"
    );
 }
 
@@ -1829,14 +2654,33 @@ static void cg_pre_clo_init(void)
                                    cg_fini);
 
    VG_(needs_superblock_discards)(cg_discard_superblock_info);
+   VG_(track_stop_client_code)   (cg_stop_client_code);
    VG_(needs_command_line_options)(cg_process_cmd_line_option,
                                    cg_print_usage,
                                    cg_print_debug_usage);
 }
 
+// Describes a TLB as a cache with one line per page.
+static cache_t tlb_config(const HChar* opt, cache_t* tlb)
+{
+   Long    size = (Long)tlb->size * clo_tlb_page_size;
+   cache_t c    = { (Int)size, tlb->assoc, (Int)clo_tlb_page_size };
+
+   if (size > 0x7fffffffL)
+      VG_(fmsg_bad_option)(opt, "Too many entries for the page size.\n");
+   if (-1 == VG_(log2)(clo_tlb_page_size))
+      VG_(fmsg_bad_option)("--tlb-page-size",
+                           "The page size is not a power of two.\n");
+   if (tlb->size % tlb->assoc != 0 ||
+       -1 == VG_(log2)(tlb->size / tlb->assoc))
+      VG_(fmsg_bad_option)(opt, "TLB set count is not a power of two.\n");
+   return c;
+}
+
 static void cg_post_clo_init(void)
 {
-   cache_t I1c, D1c, LLc; 
+   cache_t I1c, D1c, L2c, LLc; 
+   cache_t* L2p = clo_cache_levels == 3 ? &L2c : NULL;
 
    CC_table =
       VG_(OSetGen_Create)(offsetof(LineCC, loc),
@@ -1854,16 +2698,31 @@ static void cg_post_clo_init(void)
                           VG_(malloc), "cg.main.cpci.3",
                           VG_(free));
 
-   VG_(post_clo_init_configure_caches)(&I1c, &D1c, &LLc,
+   VG_(post_clo_init_configure_caches)(&I1c, &D1c, L2p, &LLc,
                                        &clo_I1_cache,
                                        &clo_D1_cache,
+                                       &clo_L2_cache,
                                        &clo_LL_cache);
 
+   if (L2p == NULL && clo_L2_exclusive) {
+      VG_(fmsg_bad_option)("--L2-policy=exclusive",
+                           "An L2 cache is only simulated with "
+                           "--cache-levels=3.\n");
+   }
+   // The exclusive L2 swaps lines with I1 and D1.
+   if (L2p && clo_L2_exclusive &&
+       (I1c.line_size != L2c.line_size || D1c.line_size != L2c.line_size)) {
+      VG_(fmsg_bad_option)("--L2-policy=exclusive",
+                           "I1, D1 and L2 must have the same line size.\n");
+   }
+
    // min_line_size is used to make sure that we never feed
    // accesses to the simulator straddling more than two
    // cache lines at any cache level
    min_line_size = (I1c.line_size < D1c.line_size) ? I1c.line_size : D1c.line_size;
    min_line_size = (LLc.line_size < min_line_size) ? LLc.line_size : min_line_size;
+   if (L2p)
+      min_line_size = (L2c.line_size < min_line_size) ? L2c.line_size : min_line_size;
 
    Int largest_load_or_store_size
       = VG_(machine_get_size_of_largest_guest_register)();
@@ -1879,7 +2738,59 @@ static void cg_post_clo_init(void)
       VG_(exit)(1);
    }
 
-   cachesim_initcaches(I1c, D1c, LLc);
+   cachesim_initcaches(I1c, D1c, L2p, LLc, clo_L2_exclusive);
+
+   if (clo_tlb_sim) {
+      if (!clo_cache_sim)
+         VG_(fmsg_bad_option)("--tlb-sim=yes",
+                              "TLBs are only simulated with --cache-sim=yes.\n");
+      cachesim_inittlbs(tlb_config("--ITLB", &clo_ITLB),
+                        tlb_config("--DTLB", &clo_DTLB));
+   }
+   if (clo_sample_period > 0) {
+      if (clo_sample_window >= clo_sample_period)
+         VG_(fmsg_bad_option)("--sample-window",
+                              "The window must be shorter than "
+                              "--sample-period.\n");
+      sample_next = clo_sample_window * 1000000ULL;
+      sample_windows = 1;
+   }
+   if (clo_branch_history > 0 && clo_branch_predictor == BP_Simple)
+      VG_(fmsg_bad_option)("--branch-history",
+                           "The simple predictor has a fixed history;  "
+                           "choose another --branch-predictor.\n");
+   if (clo_branch_history > 0 && clo_branch_history < 8 &&
+       clo_branch_predictor == BP_TAGE)
+      VG_(fmsg_bad_option)("--branch-history",
+                           "The tage predictor needs at least 8 bits of "
+                           "history.\n");
+   branchpred_init(clo_branch_predictor, clo_branch_history);
+
+   if (clo_prefetch_sim) {
+      if (!clo_cache_sim)
+         VG_(fmsg_bad_option)("--prefetch-sim=yes",
+                              "Prefetching is only simulated with "
+                              "--cache-sim=yes.\n");
+      pf_sim       = True;
+      cachesim_ext = True;
+   }
+
+   // There's nothing to batch without the cache simulation.
+   if (!clo_cache_sim)
+      clo_batch_sim = False;
+
+   // The main thread is thread 1.
+   costs_size = 1024;
+   thread_costs = VG_(calloc)("cg.main.pci.1", VG_N_THREADS,
+                              sizeof(LineCost*));
+   if (clo_separate_threads) {
+      thread_caches = VG_(calloc)("cg.main.pci.2", VG_N_THREADS,
+                                  sizeof(cache_private_t*));
+      cur_slot = 1;
+      VG_(track_start_client_code)(cg_start_client_code);
+   }
+   thread_costs[cur_slot] = new_costs();
+   cur_costs = thread_costs[cur_slot];
 }
 
 VG_DETERMINE_INTERFACE_VERSION(cg_pre_clo_init)
@@ -479,15 +479,19 @@ static Bool parse_ULong ( /*OUT*/ULong* res, /*INOUT*/char** pptr)
 // returning the first number in *lnno and the rest in a newly
 // allocated Counts struct.  If lnno is non-NULL, treat the first
 // number as a line number and assign it to *lnno instead of
-// incorporating it in the counts array.
+// incorporating it in the counts array.  A line number starting with
+// '+' or '-' is relative to the value *lnno had on entry.
 static 
-Counts* splitUpCountsLine ( SOURCE* s, /*OUT*/UWord* lnno, char* str )
+Counts* splitUpCountsLine ( SOURCE* s, /*INOUT*/UWord* lnno, char* str )
 {
 #define N_TMPC 50
    Bool    ok;
    Counts* counts;
    ULong   tmpC[N_TMPC];
    Int     n_tmpC = 0;
+   char    sign = 0;
+   if (lnno && (*str == '+' || *str == '-'))
+      sign = *str++;
    while (1) {
       ok = parse_ULong( &tmpC[n_tmpC], &str );
       if (!ok)
@@ -502,7 +506,12 @@ Counts* splitUpCountsLine ( SOURCE* s, /*OUT*/UWord* lnno, char* str )
       parseError(s, "too few counts in count line");
 
    if (lnno) {
-      *lnno = (UWord)tmpC[0];
+      if (sign == '+')
+         *lnno += (UWord)tmpC[0];
+      else if (sign == '-')
+         *lnno -= (UWord)tmpC[0];
+      else
+         *lnno = (UWord)tmpC[0];
       counts = new_Counts( n_tmpC-1, /*COPIED*/&tmpC[1] );
    } else {
       counts = new_Counts( n_tmpC, /*COPIED*/&tmpC[0] );
@@ -539,10 +548,34 @@ static Bool addCountsToMap ( SOURCE* s,
    }
 }
 
+// Parse a count line, whose line number may be relative to *lnnoP, into
+// a Counts with exactly cpf->n_events entries.  Missing trailing counts
+// are zero.
+static Counts* parse_counts ( SOURCE* s, CacheProfFile* cpf,
+                              /*INOUT*/UWord* lnnoP, char* str )
+{
+   Counts* counts = splitUpCountsLine( s, lnnoP, str );
+
+   if (counts->n_counts > cpf->n_events)
+      parseError(s, "# counts doesn't match # events");
+   if (counts->n_counts < cpf->n_events) {
+      Int     i;
+      Counts* padded = new_Counts_Zeroed( cpf->n_events );
+      if (padded == NULL)
+         mallocFail(s, "parse_counts:");
+      for (i = 0; i < counts->n_counts; i++)
+         padded->counts[i] = counts->counts[i];
+      ddel_Counts(counts);
+      counts = padded;
+   }
+   return counts;
+}
+
 static
 void handle_counts ( SOURCE* s,
                      CacheProfFile* cpf, 
-                     const char* fi, const char* fn, char* newCountsStr )
+                     const char* fi, const char* fn,
+                     /*INOUT*/UWord* lnnoP, char* newCountsStr )
 {
    WordFM* countsMap;
    Bool    freeNewCounts;
@@ -553,11 +586,8 @@ void handle_counts ( SOURCE* s,
    if (0)  printf("%s %s %s\n", fi, fn, newCountsStr );
 
    // parse the numbers
-   newCounts = splitUpCountsLine( s, &lnno, newCountsStr );
-
-   // Did we get the right number?
-   if (newCounts->n_counts != cpf->n_events)
-      goto oom;
+   newCounts = parse_counts( s, cpf, lnnoP, newCountsStr );
+   lnno = *lnnoP;
 
    // allocate the key
    topKey = malloc(sizeof(FileFn));
@@ -596,12 +626,52 @@ void handle_counts ( SOURCE* s,
 }
 
 
-/* Parse a complete file from the stream in 's'.  If a parse error
-   happens, do not return; instead exit via parseError().  If an
-   out-of-memory condition happens, do not return; instead exit via
-   mallocError().
+static void free_Word ( Word w )
+{
+   free((void*)w);
+}
+
+// Files written with --compress-output=yes give each file and function
+// name as "(id) name" the first time, and as "(id)" after that.  Returns
+// the name in str, expanded if need be, in freshly allocated memory.
+static char* uncompressed_name ( SOURCE* s, WordFM* names, const char* str )
+{
+   UWord id = 0;
+   char* name;
+
+   if (str[0] != '(' || !isdigit(str[1]))
+      return strdup(str);
+
+   str++;
+   while (isdigit(*str))
+      id = id * 10 + (UWord)(*str++ - '0');
+   if (*str != ')')
+      parseError(s, "malformed compressed name");
+   str++;
+   while (isspace(*str))
+      str++;
+
+   if (*str == 0) {
+      if (!lookupFM( names, (Word*)&name, (Word)id ))
+         parseError(s, "undefined compressed name");
+   } else {
+      Word oldName;
+      name = strdup(str);
+      if (name == NULL)
+         mallocFail(s, "uncompressed_name:");
+      if (delFromFM( names, &oldName, (Word)id ))
+         free((void*)oldName);
+      addToFM( names, (Word)id, (Word)name );
+   }
+   return strdup(name);
+}
+
+/* Parse the "desc:", "cmd:" and "events:" lines at the start of the
+   stream in 's', returning a CacheProfFile with those filled in, a
+   zeroed summary and no outerMap.  Exits on error, as
+   parse_CacheProfFile does.
 */
-static CacheProfFile* parse_CacheProfFile ( SOURCE* s )
+static CacheProfFile* parse_CacheProfFile_header ( SOURCE* s )
 {
 #define M_TMP_DESCLINES 10
 
@@ -611,9 +681,6 @@ static CacheProfFile* parse_CacheProfFile ( SOURCE* s )
    char*          p;
    int            n_tmp_desclines = 0;
    CacheProfFile* cpf;
-   Counts*        summaryRead; 
-   char*          curr_fn = strdup("???");
-   char*          curr_fl = strdup("???");
 
    cpf = new_CacheProfFile( NULL, NULL, NULL, 0, NULL, NULL, NULL );
    if (cpf == NULL)
@@ -675,42 +742,21 @@ static CacheProfFile* parse_CacheProfFile ( SOURCE* s )
    if (cpf->summary == NULL)
       mallocFail(s, "parse_CacheProfFile(4)");
 
-   // create the outer map (file+fn name --> inner map)
-   cpf->outerMap = newFM ( malloc, free, cmp_FileFn );
-   if (cpf->outerMap == NULL)
-      mallocFail(s, "parse_CacheProfFile(5)");
+   return cpf;
 
-   // process count lines
-   while (1) {
-      b = readline(s);
-      if (!b)
-         parseError(s, "parse_CacheProfFile: eof before SUMMARY line");
+#undef N_TMP_DESCLINES  
+}
 
-      if (isdigit(line[0])) {
-         handle_counts(s, cpf, curr_fl, curr_fn, line);
-         continue;
-      }
-      else
-      if (streqn(line, "fn=", 3)) {
-         free(curr_fn);
-         curr_fn = strdup(line+3);
-         continue;
-      }
-      else
-      if (streqn(line, "fl=", 3)) {
-         free(curr_fl);
-         curr_fl = strdup(line+3);
-         continue;
-      }
-      else
-      if (streqn(line, "summary: ", 9)) {
-         break;
-      }
-      else
-         parseError(s, "parse_CacheProfFile: unexpected line in main data");
-   }
+/* The "summary:" line has just been read into 'line'.  Check that
+   nothing follows it and that it matches the counts summed up in
+   cpf->summary whilst parsing.
+*/
+static void check_CacheProfFile_summary ( SOURCE* s, CacheProfFile* cpf )
+{
+   Int     i;
+   Bool    b;
+   Counts* summaryRead; 
 
-   // finally, the "summary:" line
    if (!streqn(line, "summary: ", 9))
       parseError(s, "parse_CacheProfFile: missing SUMMARY line");
 
@@ -741,18 +787,72 @@ static CacheProfFile* parse_CacheProfFile ( SOURCE* s )
 
    // since the summary counts are OK, free up the summary_line text
    // which contains the same info.
-   if (cpf->summary_line) {
-      free(cpf->summary_line);
-      cpf->summary_line = NULL;
+   free(cpf->summary_line);
+   cpf->summary_line = NULL;
+}
+
+/* Parse a complete file from the stream in 's'.  If a parse error
+   happens, do not return; instead exit via parseError().  If an
+   out-of-memory condition happens, do not return; instead exit via
+   mallocError().
+*/
+static CacheProfFile* parse_CacheProfFile ( SOURCE* s )
+{
+   Bool           b;
+   CacheProfFile* cpf;
+   char*          curr_fn = strdup("???");
+   char*          curr_fl = strdup("???");
+   UWord          curr_lnno = 0;
+   WordFM*        fl_names = newFM( malloc, free, cmp_unboxed_UWord );
+   WordFM*        fn_names = newFM( malloc, free, cmp_unboxed_UWord );
+
+   cpf = parse_CacheProfFile_header( s );
+
+   // create the outer map (file+fn name --> inner map)
+   cpf->outerMap = newFM ( malloc, free, cmp_FileFn );
+   if (cpf->outerMap == NULL)
+      mallocFail(s, "parse_CacheProfFile(5)");
+
+   // process count lines
+   while (1) {
+      b = readline(s);
+      if (!b)
+         parseError(s, "parse_CacheProfFile: eof before SUMMARY line");
+
+      if (isdigit(line[0]) || line[0] == '+' || line[0] == '-') {
+         handle_counts(s, cpf, curr_fl, curr_fn, &curr_lnno, line);
+         continue;
+      }
+      else
+      if (streqn(line, "fn=", 3)) {
+         free(curr_fn);
+         curr_fn = uncompressed_name(s, fn_names, line+3);
+         continue;
+      }
+      else
+      if (streqn(line, "fl=", 3)) {
+         free(curr_fl);
+         curr_fl = uncompressed_name(s, fl_names, line+3);
+         continue;
+      }
+      else
+      if (streqn(line, "summary: ", 9)) {
+         break;
+      }
+      else
+         parseError(s, "parse_CacheProfFile: unexpected line in main data");
    }
 
+   // finally, the "summary:" line
+   check_CacheProfFile_summary( s, cpf );
+
    free(curr_fn);
    free(curr_fl);
+   deleteFM(fl_names, NULL, free_Word);
+   deleteFM(fn_names, NULL, free_Word);
 
    // All looks OK
    return cpf;
-
-#undef N_TMP_DESCLINES  
 }
 
 
@@ -838,6 +938,328 @@ static void merge_CacheProfInfo ( SOURCE* s,
    mallocFail(s, "merge_CacheProfInfo");
 }
 
+////////////////////////////////////////////////////////////////
+
+/* Files written by Cachegrind, and by cg_merge itself, are sorted by
+   file name, function name and line number.  Such files can be merged
+   k-way in a single pass that holds just the current record of each
+   input, so memory use depends on the number of inputs rather than on
+   the size of the profiles.  If an input turns out not to be sorted,
+   stream_merge() gives up and main() falls back to merging the files in
+   memory.
+*/
+
+/* At most this many inputs are read at once.  Beyond that they are
+   merged in groups into temporary files first, so as to stay well
+   within the usual limit on open files. */
+#define M_STREAM_INPUTS 256
+
+typedef
+   struct {
+      SOURCE         src;
+      CacheProfFile* cpf;       // header, and running summary
+      WordFM*        fl_names;  // for files written with --compress-output
+      WordFM*        fn_names;
+      char*          fl;        // key of the current record
+      char*          fn;
+      UWord          lnno;
+      Counts*        counts;    // counts of the current record
+      char*          next_fl;   // as set by the latest "fl=" line
+      char*          next_fn;   // as set by the latest "fn=" line
+      Bool           started;   // has the first record been read?
+   }
+   Input;
+
+// Reads the next record of 'in'.  Returns 1 if there is one, 0 at the
+// end of the input, and -1 if the input isn't sorted.
+static Int advance_Input ( Input* in )
+{
+   SOURCE* s = &in->src;
+   UWord   lnno = in->lnno;
+   Word    r;
+
+   if (in->counts) {
+      ddel_Counts(in->counts);
+      in->counts = NULL;
+   }
+
+   while (1) {
+      if (!readline(s))
+         parseError(s, "parse_CacheProfFile: eof before SUMMARY line");
+
+      if (isdigit(line[0]) || line[0] == '+' || line[0] == '-') {
+         in->counts = parse_counts( s, in->cpf, &lnno, line );
+         addCounts( s, in->cpf->summary, in->counts );
+         if (in->started) {
+            r = strcmp(in->next_fl, in->fl);
+            if (r == 0)
+               r = strcmp(in->next_fn, in->fn);
+            if (r == 0)
+               r = lnno < in->lnno ? -1 : 0;
+            if (r < 0)
+               return -1;
+         }
+         in->started = True;
+         if (in->fl != in->next_fl) {
+            free(in->fl);
+            in->fl = in->next_fl;
+         }
+         if (in->fn != in->next_fn) {
+            free(in->fn);
+            in->fn = in->next_fn;
+         }
+         in->lnno = lnno;
+         return 1;
+      }
+      else
+      if (streqn(line, "fn=", 3)) {
+         if (in->next_fn != in->fn)
+            free(in->next_fn);
+         in->next_fn = uncompressed_name(s, in->fn_names, line+3);
+      }
+      else
+      if (streqn(line, "fl=", 3)) {
+         if (in->next_fl != in->fl)
+            free(in->next_fl);
+         in->next_fl = uncompressed_name(s, in->fl_names, line+3);
+      }
+      else
+      if (streqn(line, "summary: ", 9)) {
+         check_CacheProfFile_summary( s, in->cpf );
+         return 0;
+      }
+      else
+         parseError(s, "parse_CacheProfFile: unexpected line in main data");
+   }
+}
+
+static void ddel_Input ( Input* in )
+{
+   if (in->next_fl != in->fl)
+      free(in->next_fl);
+   if (in->next_fn != in->fn)
+      free(in->next_fn);
+   free(in->fl);
+   free(in->fn);
+   if (in->counts)
+      ddel_Counts(in->counts);
+   deleteFM(in->fl_names, NULL, free_Word);
+   deleteFM(in->fn_names, NULL, free_Word);
+   ddel_CacheProfFile(in->cpf);
+}
+
+static Word cmp_Input ( Input* in1, Input* in2 )
+{
+   Word r = strcmp(in1->fl, in2->fl);
+   if (r == 0)
+      r = strcmp(in1->fn, in2->fn);
+   if (r == 0)
+      r = cmp_unboxed_UWord( (Word)in1->lnno, (Word)in2->lnno );
+   return r;
+}
+
+// Restores the min-heap property of heap[0 .. n_heap-1] below index i.
+static void heap_sift_down ( Input** heap, Int n_heap, Int i )
+{
+   while (1) {
+      Int    min = i, l = 2*i + 1, r = 2*i + 2;
+      Input* tmp;
+      if (l < n_heap && cmp_Input(heap[l], heap[min]) < 0) min = l;
+      if (r < n_heap && cmp_Input(heap[r], heap[min]) < 0) min = r;
+      if (min == i)
+         return;
+      tmp = heap[i]; heap[i] = heap[min]; heap[min] = tmp;
+      i = min;
+   }
+}
+
+/* Merges the n_srcs sorted inputs in srcs[], which must already be open,
+   into f, in the same format as show_CacheProfFile.  Returns False if
+   any input isn't sorted.  Exits on other errors. */
+static Bool stream_merge ( SOURCE* srcs, Int n_srcs, FILE* f )
+{
+   Int      i, n_heap = 0;
+   Bool     ok = True;
+   char**   d;
+   Input*   ins  = calloc(n_srcs, sizeof(Input));
+   Input**  heap = calloc(n_srcs, sizeof(Input*));
+   Input*   in;
+   char*    out_fl = NULL;
+   char*    out_fn = NULL;
+   UWord    out_lnno = 0;
+   Counts*  out_counts = NULL;
+   Counts*  summary;
+
+   if (ins == NULL || heap == NULL)
+      mallocFail(&srcs[0], "stream_merge(1)");
+
+   for (i = 0; i < n_srcs; i++) {
+      in = &ins[i];
+      in->src      = srcs[i];
+      in->cpf      = parse_CacheProfFile_header( &in->src );
+      in->fl_names = newFM( malloc, free, cmp_unboxed_UWord );
+      in->fn_names = newFM( malloc, free, cmp_unboxed_UWord );
+      in->fl       = in->next_fl = strdup("???");
+      in->fn       = in->next_fn = strdup("???");
+      if (!in->fl_names || !in->fn_names || !in->fl || !in->fn)
+         mallocFail(&in->src, "stream_merge(2)");
+      if (!streq( ins[0].cpf->events_line, in->cpf->events_line ))
+         barf(&in->src, "\"events:\" line of most recent file does "
+                        "not match those previously processed");
+   }
+
+   summary = new_Counts_Zeroed( ins[0].cpf->n_events );
+   if (summary == NULL)
+      mallocFail(&srcs[0], "stream_merge(3)");
+
+   for (d = ins[0].cpf->desc_lines; *d; d++)
+      fprintf(f, "%s\n", *d);
+   fprintf(f, "%s\n", ins[0].cpf->cmd_line);
+   fprintf(f, "%s\n", ins[0].cpf->events_line);
+
+   // Fill the heap with the first record of each input.
+   for (i = 0; i < n_srcs && ok; i++) {
+      switch (advance_Input( &ins[i] )) {
+         case 1:  heap[n_heap++] = &ins[i]; break;
+         case 0:  break;
+         default: ok = False; break;
+      }
+   }
+   for (i = n_heap/2 - 1; i >= 0; i--)
+      heap_sift_down( heap, n_heap, i );
+
+   // Repeatedly take the smallest record, adding it to the output record
+   // if they have the same key, or printing the output record and starting
+   // a new one if not.
+   while (ok && n_heap > 0) {
+      in = heap[0];
+      if (out_counts == NULL
+          || !streq(in->fl, out_fl) || !streq(in->fn, out_fn)) {
+         if (out_counts) {
+            fprintf(f, "%ld   ", out_lnno );
+            showCounts( f, out_counts );
+            fprintf(f, "\n");
+            ddel_Counts(out_counts);
+         }
+         free(out_fl);
+         free(out_fn);
+         out_fl = strdup(in->fl);
+         out_fn = strdup(in->fn);
+         if (!out_fl || !out_fn)
+            mallocFail(&in->src, "stream_merge(4)");
+         fprintf(f, "fl=%s\nfn=%s\n", out_fl, out_fn);
+         out_lnno   = in->lnno;
+         out_counts = dopy_Counts( in->counts );
+      } else if (in->lnno != out_lnno) {
+         fprintf(f, "%ld   ", out_lnno );
+         showCounts( f, out_counts );
+         fprintf(f, "\n");
+         ddel_Counts(out_counts);
+         out_lnno   = in->lnno;
+         out_counts = dopy_Counts( in->counts );
+      } else {
+         addCounts( &in->src, out_counts, in->counts );
+      }
+      if (out_counts == NULL)
+         mallocFail(&in->src, "stream_merge(5)");
+
+      switch (advance_Input( in )) {
+         case 1:  break;
+         case 0:  heap[0] = heap[--n_heap]; break;
+         default: ok = False; break;
+      }
+      heap_sift_down( heap, n_heap, 0 );
+   }
+
+   if (ok) {
+      if (out_counts) {
+         fprintf(f, "%ld   ", out_lnno );
+         showCounts( f, out_counts );
+         fprintf(f, "\n");
+      }
+      for (i = 0; i < n_srcs; i++)
+         addCounts( &ins[i].src, summary, ins[i].cpf->summary );
+      fprintf(f, "summary:");
+      for (i = 0; i < summary->n_counts; i++)
+         fprintf(f, " %lld", summary->counts[i]);
+      fprintf(f, "\n");
+   }
+
+   if (out_counts)
+      ddel_Counts(out_counts);
+   free(out_fl);
+   free(out_fn);
+   ddel_Counts(summary);
+   for (i = 0; i < n_srcs; i++)
+      ddel_Input( &ins[i] );
+   free(ins);
+   free(heap);
+   return ok;
+}
+
+static void open_SOURCE ( /*OUT*/SOURCE* src, char* filename )
+{
+   src->lno      = 1;
+   src->filename = filename;
+   src->fp       = fopen(filename, "r");
+   if (!src->fp) {
+      perror(argv0);
+      barf(src, "Cannot open input file");
+   }
+}
+
+// Merges the named files into f, a group at a time if there are many.
+// Returns False if any of them isn't sorted.
+static Bool stream_merge_files ( char** filenames, Int n_files, FILE* f )
+{
+   static char tmpname[] = "(temporary file)";
+   SOURCE  srcs[M_STREAM_INPUTS];
+   Int     i, j, n_groups;
+   Bool    ok = True;
+
+   if (n_files <= M_STREAM_INPUTS) {
+      for (i = 0; i < n_files; i++) {
+         fprintf(stderr, "%s: merging %s\n", argv0, filenames[i]);
+         open_SOURCE( &srcs[i], filenames[i] );
+      }
+      ok = stream_merge( srcs, n_files, f );
+      for (i = 0; i < n_files; i++)
+         fclose(srcs[i].fp);
+      return ok;
+   }
+
+   n_groups = (n_files + M_STREAM_INPUTS - 1) / M_STREAM_INPUTS;
+   if (n_groups > M_STREAM_INPUTS) {
+      fprintf(stderr, "%s: too many input files (at most %d)\n",
+                      argv0, M_STREAM_INPUTS * M_STREAM_INPUTS);
+      exit(1);
+   }
+
+   {
+      SOURCE tmps[M_STREAM_INPUTS];
+      for (i = 0; i < n_groups; i++) {
+         Int first = i * M_STREAM_INPUTS;
+         Int n     = n_files - first < M_STREAM_INPUTS
+                        ? n_files - first : M_STREAM_INPUTS;
+         tmps[i].lno      = 1;
+         tmps[i].filename = tmpname;
+         tmps[i].fp       = tmpfile();
+         if (!tmps[i].fp) {
+            perror(argv0);
+            barf(&tmps[i], "Cannot create temporary file");
+         }
+         if (ok)
+            ok = stream_merge_files( &filenames[first], n, tmps[i].fp );
+         rewind(tmps[i].fp);
+      }
+      if (ok)
+         ok = stream_merge( tmps, n_groups, f );
+      for (j = 0; j < n_groups; j++)
+         fclose(tmps[j].fp);
+   }
+   return ok;
+}
+
 static void usage ( void )
 {
    fprintf(stderr, "%s: Merges multiple cachegrind output files into one\n", 
@@ -856,6 +1278,9 @@ int main ( int argc, char** argv )
    FILE*          outfile = NULL;
    char*          outfilename = NULL;
    Int            outfileix = 0;
+   char**         infilenames;
+   Int            n_infiles = 0;
+   Bool           streamed;
 
    if (argv[0])
       argv0 = argv[0];
@@ -881,49 +1306,51 @@ int main ( int argc, char** argv )
       }
    }
 
-   cpf = NULL;
-
+   infilenames = malloc(argc * sizeof(char*));
+   assert(infilenames);
    for (i = 1; i < argc; i++) {
-
       if (i == outfileix) {
          /* Skip '-o' and whatever follows it */
          i += 1;
          continue;
       }
+      infilenames[n_infiles++] = argv[i];
+   }
 
-      fprintf(stderr, "%s: parsing %s\n", argv0, argv[i]);
-      src.lno      = 1;
-      src.filename = argv[i];
-      src.fp       = fopen(src.filename, "r");
-      if (!src.fp) {
-         perror(argv0);
-         barf(&src, "Cannot open input file");
-      }
-      assert(src.fp);
-      cpfTmp = parse_CacheProfFile( &src );
-      fclose(src.fp);
-
-      /* If this isn't the first file, merge */
-      if (cpf == NULL) {
-         /* this is the first file */
-         cpf = cpfTmp;
-      } else {
-         /* not the first file; merge */
-         fprintf(stderr, "%s: merging %s\n", argv0, argv[i]);
-         merge_CacheProfInfo( &src, cpf, cpfTmp );
-         ddel_CacheProfFile( cpfTmp );
-      }
-
+   if (n_infiles == 0) {
+      free(infilenames);
+      return 0;
    }
 
-   /* Now create the output file. */
+   /* Create the output file.  When writing to stdout, the merged output
+      goes to a temporary file first, in case the inputs turn out not to
+      be sorted. */
+   fprintf(stderr, "%s: writing %s\n", 
+                    argv0, outfilename ? outfilename : "(stdout)" );
+   outfile = outfilename ? fopen(outfilename, "w") : tmpfile();
+   if (!outfile) {
+      fprintf(stderr, "%s: can't create output file %s\n", 
+                      argv0, outfilename ? outfilename : "(temporary)");
+      perror(argv0);
+      exit(1);
+   }
 
-   if (cpf) {
+   streamed = stream_merge_files( infilenames, n_infiles, outfile );
 
-      fprintf(stderr, "%s: writing %s\n", 
-                       argv0, outfilename ? outfilename : "(stdout)" );
+   if (streamed && !outfilename) {
+      char   buf[8192];
+      size_t n;
+      rewind(outfile);
+      while ((n = fread(buf, 1, sizeof(buf), outfile)) > 0)
+         fwrite(buf, 1, n, stdout);
+      fclose(outfile);
+      outfile = stdout;
+   }
 
-      /* Write the output. */
+   if (!streamed) {
+      fprintf(stderr, "%s: inputs are not sorted, merging them in memory\n",
+                      argv0);
+      fclose(outfile);
       if (outfilename) {
          outfile = fopen(outfilename, "w");
          if (!outfile) {
@@ -936,23 +1363,47 @@ int main ( int argc, char** argv )
          outfile = stdout;
       }
 
-      show_CacheProfFile( outfile, cpf );
-      if (ferror(outfile)) {
-         fprintf(stderr, "%s: error writing output file %s\n", 
-                         argv0, outfilename ? outfilename : "(stdout)" );
-         perror(argv0);
-         if (outfile != stdout)
-            fclose(outfile);
-         exit(1);
-      }
+      cpf = NULL;
 
-      fflush(outfile);
-      if (outfile != stdout)
-         fclose( outfile );
+      for (i = 0; i < n_infiles; i++) {
+
+         fprintf(stderr, "%s: parsing %s\n", argv0, infilenames[i]);
+         open_SOURCE( &src, infilenames[i] );
+         cpfTmp = parse_CacheProfFile( &src );
+         fclose(src.fp);
+
+         /* If this isn't the first file, merge */
+         if (cpf == NULL) {
+            /* this is the first file */
+            cpf = cpfTmp;
+         } else {
+            /* not the first file; merge */
+            fprintf(stderr, "%s: merging %s\n", argv0, infilenames[i]);
+            merge_CacheProfInfo( &src, cpf, cpfTmp );
+            ddel_CacheProfFile( cpfTmp );
+         }
+
+      }
 
+      /* Write the output. */
+      show_CacheProfFile( outfile, cpf );
       ddel_CacheProfFile( cpf );
    }
 
+   if (ferror(outfile)) {
+      fprintf(stderr, "%s: error writing output file %s\n", 
+                      argv0, outfilename ? outfilename : "(stdout)" );
+      perror(argv0);
+      if (outfile != stdout)
+         fclose(outfile);
+      exit(1);
+   }
+
+   fflush(outfile);
+   if (outfile != stdout)
+      fclose( outfile );
+
+   free(infilenames);
    return 0;
 }
 
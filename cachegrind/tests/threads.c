@@ -0,0 +1,49 @@
+#include <pthread.h>
+#include <sched.h>
+
+// Two threads each read their own 24KB buffer, one byte out of every
+// 64, taking turns after each pass.  Each buffer fits in a 32KB D1 on
+// its own, but the two together don't.  The reading is done by walk(),
+// as in walk.c, so that filter_counts can be used on the output.
+
+#define SIZE   (24 * 1024)
+#define PASSES 8
+
+static char buf[2][SIZE] __attribute__((aligned(64)));
+static volatile int turn;
+
+__attribute__((noinline))
+static int walk ( char* b )
+{
+   // In registers, so that the loop makes no other data accesses.
+   register int i, sum = 0;
+   for (i = 0; i < SIZE; i += 64)
+      sum += b[i];
+   return sum;
+}
+
+static void* thread_fn ( void* arg )
+{
+   long me = (long)arg;
+   int  p, sum = 0;
+
+   for (p = 0; p < PASSES; p++) {
+      while (turn != me)
+         sched_yield();
+      sum += walk(buf[me]);
+      turn = !me;
+   }
+   return (void*)(long)sum;
+}
+
+int main ( void )
+{
+   pthread_t t[2];
+   long      i;
+
+   for (i = 0; i < 2; i++)
+      pthread_create(&t[i], NULL, thread_fn, (void*)i);
+   for (i = 0; i < 2; i++)
+      pthread_join(t[i], NULL);
+   return 0;
+}
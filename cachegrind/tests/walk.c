@@ -0,0 +1,48 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+// Walks through a buffer again and again, reading one byte out of every
+// 'stride', so that the numbers of cache misses only depend on the
+// buffer's size and the caches.  Also has a branch which is taken every
+// 13th time, which only predictors with a long history get right.
+//
+// Usage: walk <size in KB> <stride> <times> <branches>
+
+static char buf[8 << 20];
+
+__attribute__((noinline))
+static int walk ( int size, int stride, int times )
+{
+   // In registers, so that the loop makes no other data accesses.
+   register int i, t, sum = 0;
+   register int sz = size, st = stride;
+   for (t = 0; t < times; t++)
+      for (i = 0; i < sz; i += st)
+         sum += buf[i];
+   return sum;
+}
+
+__attribute__((noinline))
+static int periodic ( int n )
+{
+   int i, sum = 0;
+   for (i = 0; i < n; i++) {
+      if (i % 13 == 0)
+         sum += 3;
+      else
+         sum -= 1;
+   }
+   return sum;
+}
+
+int main ( int argc, char** argv )
+{
+   int size   = argc > 1 ? atoi(argv[1]) * 1024 : 64 * 1024;
+   int stride = argc > 2 ? atoi(argv[2]) : 64;
+   int times  = argc > 3 ? atoi(argv[3]) : 2;
+   int n      = argc > 4 ? atoi(argv[4]) : 100000;
+
+   if (size > (int)sizeof(buf))
+      size = sizeof(buf);
+   return walk(size, stride, times) + periodic(n) == 42;
+}
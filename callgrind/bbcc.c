@@ -35,9 +35,12 @@
 /*--- BBCC operations                                      ---*/
 /*------------------------------------------------------------*/
 
-#define N_BBCC_INITIAL_ENTRIES  10437
+/* Must be a power of two */
+#define N_BBCC_INITIAL_ENTRIES  16384
 
-/* BBCC table (key is BB/Context), per thread, resizable */
+/* BBCC table (key is BB/Context), per thread, resizable.
+ * Open addressing with linear probing: a flat array of BBCC pointers,
+ * so a lookup touches consecutive slots instead of following chains. */
 bbcc_hash current_bbccs;
 
 void CLG_(init_bbcc_hash)(bbcc_hash* bbccs)
@@ -52,6 +55,7 @@ void CLG_(init_bbcc_hash)(bbcc_hash* bbccs)
                                       bbccs->size * sizeof(BBCC*));
 
    for (i = 0; i < bbccs->size; i++) bbccs->table[i] = NULL;
+   bbccs->dirty = NULL;
 }
 
 void CLG_(copy_current_bbcc_hash)(bbcc_hash* dst)
@@ -61,6 +65,7 @@ void CLG_(copy_current_bbcc_hash)(bbcc_hash* dst)
   dst->size    = current_bbccs.size;
   dst->entries = current_bbccs.entries;
   dst->table   = current_bbccs.table;
+  dst->dirty   = current_bbccs.dirty;
 }
 
 bbcc_hash* CLG_(get_current_bbcc_hash)()
@@ -75,6 +80,7 @@ void CLG_(set_current_bbcc_hash)(bbcc_hash* h)
   current_bbccs.size    = h->size;
   current_bbccs.entries = h->entries;
   current_bbccs.table   = h->table;
+  current_bbccs.dirty   = h->dirty;
 }
 
 /*
@@ -116,20 +122,55 @@ void CLG_(forall_bbccs)(void (*func)(BBCC*))
 	
   for (i = 0; i < current_bbccs.size; i++) {
     if ((bbcc=current_bbccs.table[i]) == NULL) continue;
-    while (bbcc) {
-      /* every bbcc should have a rec_array */
-      CLG_ASSERT(bbcc->rec_array != 0);
 
-      for(j=0;j<bbcc->cxt->fn[0]->separate_recursions;j++) {
-	if ((bbcc2 = bbcc->rec_array[j]) == 0) continue;
+    /* every bbcc should have a rec_array */
+    CLG_ASSERT(bbcc->rec_array != 0);
 
-	(*func)(bbcc2);
-      }
-      bbcc = bbcc->next;
+    for(j=0;j<bbcc->cxt->fn[0]->separate_recursions;j++) {
+      if ((bbcc2 = bbcc->rec_array[j]) == 0) continue;
+
+      (*func)(bbcc2);
     }
   }
 }
 
+/*
+ * Dirty chain: BBCCs which got an execution or return count since
+ * the last dump. Only these (and the BBCCs of active calls) have
+ * cost to dump, so a dump does not need to walk the whole hash.
+ * Called when a counter of the BBCC changes from zero.
+ */
+void CLG_(mark_bbcc_dirty)(BBCC* bbcc)
+{
+  if (bbcc->dirty) return;
+
+  bbcc->dirty = True;
+  bbcc->next_dirty = current_bbccs.dirty;
+  current_bbccs.dirty = bbcc;
+  CLG_(stat).dirty_bbccs++;
+}
+
+void CLG_(forall_dirty_bbccs)(void (*func)(BBCC*))
+{
+  BBCC* bbcc;
+
+  for (bbcc = current_bbccs.dirty; bbcc; bbcc = bbcc->next_dirty)
+    (*func)(bbcc);
+}
+
+/* Called after a dump, which has zeroed the counters */
+void CLG_(clear_dirty_bbccs)(void)
+{
+  BBCC *bbcc, *next;
+
+  for (bbcc = current_bbccs.dirty; bbcc; bbcc = next) {
+    next = bbcc->next_dirty;
+    bbcc->next_dirty = 0;
+    bbcc->dirty = False;
+  }
+  current_bbccs.dirty = 0;
+}
+
 
 /* All BBCCs for recursion level 0 are inserted into a
  * thread specific hash table with key
@@ -144,10 +185,16 @@ void CLG_(forall_bbccs)(void (*func)(BBCC*))
 static __inline__
 UInt bbcc_hash_idx(BB* bb, Context* cxt, UInt size)
 {
+   UWord h;
+
    CLG_ASSERT(bb != 0);
    CLG_ASSERT(cxt != 0);
 
-   return ((Addr)bb + (Addr)cxt) % size;
+   /* Both are heap pointers, so mix the bits before masking: with linear
+    * probing, clustered indexes make for long probe sequences. */
+   h = ((UWord)bb >> 3) * 2654435761UL + ((UWord)cxt >> 3);
+   h ^= h >> 15;
+   return (UInt)(h & (size - 1));
 }
  
 
@@ -171,11 +218,12 @@ BBCC* lookup_bbcc(BB* bb, Context* cxt)
    CLG_(stat).bbcc_lru_misses++;
 
    idx = bbcc_hash_idx(bb, cxt, current_bbccs.size);
-   bbcc = current_bbccs.table[idx];
-   while (bbcc &&
-	  (bb      != bbcc->bb ||
-	   cxt     != bbcc->cxt)) {
-       bbcc = bbcc->next;
+   while (1) {
+       bbcc = current_bbccs.table[idx];
+       CLG_(stat).bbcc_hash_probes++;
+       if (!bbcc || (bb == bbcc->bb && cxt == bbcc->cxt))
+	   break;
+       idx = (idx + 1) & (current_bbccs.size - 1);
    }
    
    CLG_DEBUG(2,"  lookup_bbcc(BB %#lx, Cxt %d, fn '%s'): %p (tid %d)\n",
@@ -192,12 +240,12 @@ BBCC* lookup_bbcc(BB* bb, Context* cxt)
 /* double size of hash table 1 (addr->BBCC) */
 static void resize_bbcc_hash(void)
 {
-    Int i, new_size, conflicts1 = 0, conflicts2 = 0;
+    Int i, new_size, conflicts = 0;
     BBCC** new_table;
     UInt new_idx;
-    BBCC *curr_BBCC, *next_BBCC;
+    BBCC *curr_BBCC;
 
-    new_size = 2*current_bbccs.size+3;
+    new_size = 2*current_bbccs.size;
     new_table = (BBCC**) CLG_MALLOC("cl.bbcc.rbh.1",
                                     new_size * sizeof(BBCC*));
  
@@ -207,34 +255,25 @@ static void resize_bbcc_hash(void)
       new_table[i] = NULL;
  
     for (i = 0; i < current_bbccs.size; i++) {
-	if (current_bbccs.table[i] == NULL) continue;
- 
 	curr_BBCC = current_bbccs.table[i];
-	while (NULL != curr_BBCC) {
-	    next_BBCC = curr_BBCC->next;
-
-	    new_idx = bbcc_hash_idx(curr_BBCC->bb,
-				    curr_BBCC->cxt,
-				    new_size);
-
-	    curr_BBCC->next = new_table[new_idx];
-	    new_table[new_idx] = curr_BBCC;
-	    if (curr_BBCC->next) {
-		conflicts1++;
-		if (curr_BBCC->next->next)
-		    conflicts2++;
-	    }
-
-	    curr_BBCC = next_BBCC;
+	if (curr_BBCC == NULL) continue;
+
+	new_idx = bbcc_hash_idx(curr_BBCC->bb,
+				curr_BBCC->cxt,
+				new_size);
+	while (new_table[new_idx]) {
+	    conflicts++;
+	    new_idx = (new_idx + 1) & (new_size - 1);
 	}
+	new_table[new_idx] = curr_BBCC;
     }
 
     VG_(free)(current_bbccs.table);
 
 
-    CLG_DEBUG(0,"Resize BBCC Hash: %d => %d (entries %d, conflicts %d/%d)\n",
+    CLG_DEBUG(0,"Resize BBCC Hash: %d => %d (entries %d, conflicts %d)\n",
 	     current_bbccs.size, new_size,
-	     current_bbccs.entries, conflicts1, conflicts2);
+	     current_bbccs.entries, conflicts);
 
     current_bbccs.size = new_size;
     current_bbccs.table = new_table;
@@ -287,8 +326,11 @@ BBCC* new_bbcc(BB* bb)
    for(i=0; i<=bb->cjmp_count; i++) {
        bbcc->jmp[i].ecounter = 0;
        bbcc->jmp[i].jcc_list = 0;
+       bbcc->jmp[i].last_jcc = 0;
    }
    bbcc->ecounter_sum = 0;
+   bbcc->next_dirty = 0;
+   bbcc->dirty = False;
 
    /* Init pointer caches (LRU) */
    bbcc->lru_next_bbcc = 0;
@@ -325,13 +367,15 @@ void insert_bbcc_into_hash(BBCC* bbcc)
     CLG_DEBUG(3,"+ insert_bbcc_into_hash(BB %#lx, fn '%s')\n",
 	     bb_addr(bbcc->bb), bbcc->cxt->fn[0]->name);
 
-    /* check fill degree of hash and resize if needed (>90%) */
+    /* check fill degree of hash and resize if needed (>70%);
+     * linear probing gets slow when the table is fuller than that */
     current_bbccs.entries++;
-    if (100 * current_bbccs.entries / current_bbccs.size > 90)
+    if (100 * current_bbccs.entries / current_bbccs.size > 70)
 	resize_bbcc_hash();
 
     idx = bbcc_hash_idx(bbcc->bb, bbcc->cxt, current_bbccs.size);
-    bbcc->next = current_bbccs.table[idx];
+    while (current_bbccs.table[idx])
+	idx = (idx + 1) & (current_bbccs.size - 1);
     current_bbccs.table[idx] = bbcc;
 
     CLG_DEBUG(3,"- insert_bbcc_into_hash: %d entries\n",
@@ -501,6 +545,8 @@ static void handleUnderflow(BB* bb)
   }
   else if (CLG_(current_state).collect)
     source_bbcc->ecounter_sum++;
+  if (source_bbcc->ecounter_sum > 0)
+    CLG_(mark_bbcc_dirty)(source_bbcc);
   
   /* Force a new top context, will be set active by push_cxt() */
   CLG_(current_fn_stack).top--;
@@ -545,6 +591,35 @@ static void handleUnderflow(BB* bb)
 }
 
 
+/* With --sample-every=<n>, the execution of a BB is only counted for one
+ * in about n executions, as n executions.  The call stack and call
+ * counts are still tracked exactly.  The gaps between samples are random
+ * (1 to 2n-1), so that they can't fall in step with a loop.  Sampling
+ * BB executions rather than instructions makes each sample worth the
+ * same, so that the scaled up costs are right on average.
+ */
+static ULong sample_countdown = 1;
+static UInt  sample_seed = 42;
+
+static void take_sample(BBCC* last_bbcc, Int passed)
+{
+  ULong n = CLG_(clo).sample_every;
+  ULong instr_count = last_bbcc->bb->jmp[passed].instr+1;
+
+  sample_countdown = 1 + VG_(random)(&sample_seed) % (2*n - 1);
+
+  CLG_(current_state).cost[ fullOffset(EG_IR) ] += n * instr_count;
+  if (!CLG_(current_state).nonskipped) {
+    if (last_bbcc->ecounter_sum == 0)
+      CLG_(mark_bbcc_dirty)(last_bbcc);
+    last_bbcc->ecounter_sum += n;
+    last_bbcc->jmp[passed].ecounter += n;
+  }
+  else
+    CLG_(current_state).nonskipped->skipped[ fullOffset(EG_IR) ]
+      += n * instr_count;
+}
+
 /*
  * Helper function called at start of each instrumented BB to setup
  * pointer to costs for current thread/context/recursion level
@@ -594,9 +669,14 @@ void CLG_(setup_bbcc)(BB* bb)
       jmpkind = last_bb->jmp[passed].jmpkind;
       isConditionalJump = (passed < last_bb->cjmp_count);
 
-      if (CLG_(current_state).collect) {
+      if (CLG_(clo).sample_every > 0) {
+	if (CLG_(current_state).collect && --sample_countdown == 0)
+	  take_sample(last_bbcc, passed);
+      }
+      else if (CLG_(current_state).collect) {
 	if (!CLG_(current_state).nonskipped) {
-	  last_bbcc->ecounter_sum++;
+	  if (last_bbcc->ecounter_sum++ == 0)
+	    CLG_(mark_bbcc_dirty)(last_bbcc);
 	  last_bbcc->jmp[passed].ecounter++;
 	  if (!CLG_(clo).simulate_cache) {
 	      /* update Ir cost */              
@@ -351,7 +351,8 @@ void CLG_(pop_call_stack)()
 	  /* only count this call if it attributed some cost.
 	   * the ret_counter is used to check if a BBCC dump is needed.
 	   */
-	  jcc->from->ret_counter++;
+	  if (jcc->from->ret_counter++ == 0)
+	    CLG_(mark_bbcc_dirty)(jcc->from);
 	}
 	CLG_(stat).ret_counter++;
 
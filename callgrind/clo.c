@@ -523,6 +523,7 @@ Bool CLG_(process_cmd_line_option)(const HChar* arg)
    else if VG_BOOL_CLO(arg, "--dump-bb",    CLG_(clo).dump_bb) {}
 
    else if VG_INT_CLO( arg, "--dump-every-bb", CLG_(clo).dump_every_bb) {}
+   else if VG_INT_CLO( arg, "--sample-every",  CLG_(clo).sample_every) {}
 
    else if VG_BOOL_CLO(arg, "--collect-alloc",   CLG_(clo).collect_alloc) {}
    else if VG_BOOL_CLO(arg, "--collect-systime", CLG_(clo).collect_systime) {}
@@ -583,6 +584,8 @@ void CLG_(print_usage)(void)
 "    --collect-alloc=no|yes    Collect memory allocation info? [no]\n"
 #endif
 "    --collect-systime=no|yes  Collect system call time info? [no]\n"
+"    --sample-every=<count>    Only sample costs every <count> basic blocks\n"
+"                              on average, scaled up [0=exact costs]\n"
 
 "\n   cost entity separation options:\n"
 "    --separate-threads=no|yes Separate data per thread [no]\n"
@@ -650,6 +653,7 @@ void CLG_(set_clo_defaults)(void)
   CLG_(clo).collect_alloc    = False;
   CLG_(clo).collect_systime  = False;
   CLG_(clo).collect_bus      = False;
+  CLG_(clo).sample_every     = 0;
 
   CLG_(clo).skip_plt         = True;
   CLG_(clo).separate_callers = 0;
@@ -45,8 +45,14 @@ void CLG_(init_fn_stack)(fn_stack* s)
   s->size   = N_FNSTACK_INITIAL_ENTRIES;   
   s->bottom = (fn_node**) CLG_MALLOC("cl.context.ifs.1",
                                      s->size * sizeof(fn_node*));
+  s->hash   = (UWord*) CLG_MALLOC("cl.context.ifs.2",
+                                  s->size * sizeof(UWord));
+  s->zero   = (UInt*) CLG_MALLOC("cl.context.ifs.3",
+                                 s->size * sizeof(UInt));
   s->top    = s->bottom;
   s->bottom[0] = 0;
+  s->hash[0] = 0;
+  s->zero[0] = 0;
 }
 
 void CLG_(copy_current_fn_stack)(fn_stack* dst)
@@ -56,6 +62,8 @@ void CLG_(copy_current_fn_stack)(fn_stack* dst)
   dst->size   = CLG_(current_fn_stack).size;
   dst->bottom = CLG_(current_fn_stack).bottom;
   dst->top    = CLG_(current_fn_stack).top;
+  dst->hash   = CLG_(current_fn_stack).hash;
+  dst->zero   = CLG_(current_fn_stack).zero;
 }
 
 void CLG_(set_current_fn_stack)(fn_stack* s)
@@ -65,6 +73,8 @@ void CLG_(set_current_fn_stack)(fn_stack* s)
   CLG_(current_fn_stack).size   = s->size;
   CLG_(current_fn_stack).bottom = s->bottom;
   CLG_(current_fn_stack).top    = s->top;
+  CLG_(current_fn_stack).hash   = s->hash;
+  CLG_(current_fn_stack).zero   = s->zero;
 }
 
 static cxt_hash cxts;
@@ -131,13 +141,50 @@ static void resize_cxt_table(void)
     CLG_(stat).cxt_hash_resizes++;
 }
 
+/* The hash of a context is a polynomial in its function pointers, with
+ * the top one getting the lowest power:
+ *
+ *   hash = fn[0] + fn[-1]*M + fn[-2]*M^2 + ...
+ *
+ * This way, the hash of the top entries of the function stack can be got
+ * in O(1) from the hashes push_cxt() keeps alongside it, whatever the
+ * number of callers the top function wants separated.
+ */
+#if VG_WORDSIZE == 8
+#define CXT_HASH_MULT 0x9E3779B97F4A7C15ULL
+#else
+#define CXT_HASH_MULT 0x9E3779B1U
+#endif
+
+/* CXT_HASH_MULT^n for n < cxt_hash_pow_size */
+static UWord* cxt_hash_pow = 0;
+static UInt   cxt_hash_pow_size = 0;
+
+static UWord hash_pow(UInt n)
+{
+    if (n >= cxt_hash_pow_size) {
+        UInt i, new_size = 2*n + 16;
+        cxt_hash_pow = (UWord*) VG_(realloc)("cl.context.hp.1", cxt_hash_pow,
+                                             new_size * sizeof(UWord));
+        if (cxt_hash_pow_size == 0) {
+            cxt_hash_pow[0] = 1;
+            cxt_hash_pow_size = 1;
+        }
+        for (i = cxt_hash_pow_size; i < new_size; i++)
+            cxt_hash_pow[i] = cxt_hash_pow[i-1] * CXT_HASH_MULT;
+        cxt_hash_pow_size = new_size;
+    }
+    return cxt_hash_pow[n];
+}
+
 __inline__
 static UWord cxt_hash_val(fn_node** fn, UInt size)
 {
-    UWord hash = 0;
+    UWord hash = 0, mult = 1;
     UInt count = size;
     while(*fn != 0) {
-        hash = (hash<<7) + (hash>>25) + (UWord)(*fn);
+        hash += (UWord)(*fn) * mult;
+        mult *= CXT_HASH_MULT;
         fn--;
         count--;
         if (count==0) break;
@@ -167,11 +214,10 @@ static Bool is_cxt(UWord hash, fn_node** fn, Context* cxt)
 /**
  * Allocate new Context structure
  */
-static Context* new_cxt(fn_node** fn)
+static Context* new_cxt(fn_node** fn, UWord hash)
 {
     Context* cxt;
     UInt idx, offset;
-    UWord hash;
     int size, recs;
     fn_node* top_fn;
 
@@ -191,12 +237,8 @@ static Context* new_cxt(fn_node** fn)
     cxt = (Context*) CLG_MALLOC("cl.context.nc.1",
                                 sizeof(Context)+sizeof(fn_node*)*size);
 
-    // hash value calculation similar to cxt_hash_val(), but additionally
-    // copying function pointers in one run
-    hash = 0;
     offset = 0;
     while(*fn != 0) {
-        hash = (hash<<7) + (hash>>25) + (UWord)(*fn);
 	cxt->fn[offset] = *fn;
         offset++;
         fn--;
@@ -226,22 +268,11 @@ static Context* new_cxt(fn_node** fn)
     return cxt;
 }
 
-/* get the Context structure for current context */
-Context* CLG_(get_cxt)(fn_node** fn)
+/* find or create the Context for the top of fn, whose hash is <hash> */
+static Context* lookup_cxt(fn_node** fn, UWord hash)
 {
     Context* cxt;
-    UInt size, idx;
-    UWord hash;
-
-    CLG_ASSERT(fn != 0);
-    if (*fn == 0) return 0;
-    size = (*fn)->separate_callers+1;
-    if (size<=0) { size = -size+1; }
-
-    CLG_DEBUG(5, "+ get_cxt(fn '%s'): size %d\n",
-                (*fn)->name, size);
-
-    hash = cxt_hash_val(fn, size);
+    UInt idx;
 
     if ( ((cxt = (*fn)->last_cxt) != 0) && is_cxt(hash, fn, cxt)) {
         CLG_DEBUG(5, "- get_cxt: %p\n", cxt);
@@ -259,7 +290,7 @@ Context* CLG_(get_cxt)(fn_node** fn)
     }
 
     if (!cxt)
-        cxt = new_cxt(fn);
+        cxt = new_cxt(fn, hash);
 
     (*fn)->last_cxt = cxt;
 
@@ -268,6 +299,48 @@ Context* CLG_(get_cxt)(fn_node** fn)
     return cxt;
 }
 
+static UInt cxt_size(fn_node* fn)
+{
+    UInt size = fn->separate_callers+1;
+    if (size<=0) { size = -size+1; }
+    return size;
+}
+
+/* get the Context structure for current context */
+Context* CLG_(get_cxt)(fn_node** fn)
+{
+    UInt size;
+
+    CLG_ASSERT(fn != 0);
+    if (*fn == 0) return 0;
+    size = cxt_size(*fn);
+
+    CLG_DEBUG(5, "+ get_cxt(fn '%s'): size %d\n",
+                (*fn)->name, size);
+
+    return lookup_cxt(fn, cxt_hash_val(fn, size));
+}
+
+/* get_cxt() for the top of the current function stack, using the
+ * hashes kept by push_cxt() */
+static Context* get_top_cxt(void)
+{
+    fn_stack* s = &CLG_(current_fn_stack);
+    UInt k, len, size;
+
+    if (*s->top == 0) return 0;
+    size = cxt_size(*s->top);
+
+    CLG_DEBUG(5, "+ get_top_cxt(fn '%s'): size %d\n",
+                (*s->top)->name, size);
+
+    k = s->top - s->bottom;
+    len = k - s->zero[k];
+    if (len > size) len = size;
+    return lookup_cxt(s->top,
+                      s->hash[k] - s->hash[k-len] * hash_pow(len));
+}
+
 
 /**
  * Change execution context by calling a new function from current context
@@ -303,6 +376,12 @@ void CLG_(push_cxt)(fn_node* fn)
     for(i=0;i<CLG_(current_fn_stack).size;i++)
       new_array[i] = CLG_(current_fn_stack).bottom[i];
     VG_(free)(CLG_(current_fn_stack).bottom);
+    CLG_(current_fn_stack).hash =
+      (UWord*) VG_(realloc)("cl.context.pc.2", CLG_(current_fn_stack).hash,
+			    new_size * sizeof(UWord));
+    CLG_(current_fn_stack).zero =
+      (UInt*) VG_(realloc)("cl.context.pc.3", CLG_(current_fn_stack).zero,
+			   new_size * sizeof(UInt));
     CLG_(current_fn_stack).top = new_array + fn_entries;
     CLG_(current_fn_stack).bottom = new_array;
 
@@ -323,7 +402,18 @@ void CLG_(push_cxt)(fn_node* fn)
 
   CLG_(current_fn_stack).top++;
   *(CLG_(current_fn_stack).top) = fn;
-  CLG_(current_state).cxt = CLG_(get_cxt)(CLG_(current_fn_stack).top);
+  fn_entries++;
+  if (fn) {
+    CLG_(current_fn_stack).hash[fn_entries] =
+      CLG_(current_fn_stack).hash[fn_entries-1] * CXT_HASH_MULT + (UWord)fn;
+    CLG_(current_fn_stack).zero[fn_entries] =
+      CLG_(current_fn_stack).zero[fn_entries-1];
+  }
+  else {
+    CLG_(current_fn_stack).hash[fn_entries] = 0;
+    CLG_(current_fn_stack).zero[fn_entries] = fn_entries;
+  }
+  CLG_(current_state).cxt = get_top_cxt();
 
   CLG_DEBUG(5, "- push_cxt(fn '%s'): new cxt %d, fn_sp %ld\n",
 	    fn ? fn->name : "0x0",
@@ -1186,8 +1186,9 @@ BBCC** prepare_dump(void)
     prepare_count = 0;
     
     /* if we do not separate among threads, this gives all */
-    /* count number of BBCCs with >0 executions */
-    CLG_(forall_bbccs)(hash_addCount);
+    /* count number of BBCCs with >0 executions: only BBCCs on the
+     * dirty chain can have these */
+    CLG_(forall_dirty_bbccs)(hash_addCount);
 
     /* even if we do not separate among threads,
      * call stacks are separated */
@@ -1203,7 +1204,7 @@ BBCC** prepare_dump(void)
       (BBCC**) CLG_MALLOC("cl.dump.pd.1",
                           (prepare_count+1) * sizeof(BBCC*));    
 
-    CLG_(forall_bbccs)(hash_addPtr);
+    CLG_(forall_dirty_bbccs)(hash_addPtr);
 
     if (CLG_(clo).separate_threads)
       cs_addPtr(0);
@@ -1360,6 +1361,12 @@ static int new_dumpfile(HChar buf[BUF_LEN], int tid, const HChar* trigger)
 
 	(*CLG_(cachesim).getdesc)(buf);
 	my_fwrite(fd, buf, VG_(strlen)(buf));
+
+	if (CLG_(clo).sample_every > 0) {
+	    VG_(sprintf)(buf, "desc: Option: --sample-every=%llu\n",
+			 CLG_(clo).sample_every);
+	    my_fwrite(fd, buf, VG_(strlen)(buf));
+	}
     }
 
     VG_(sprintf)(buf, "\ndesc: Timerange: Basic block %llu - %llu\n",
@@ -1558,6 +1565,9 @@ static void print_bbccs_of_thread(thread_info* ti)
 
   close_dumpfile(print_fd);
   if (array) VG_(free)(array);
+
+  /* all dumped BBCCs are zeroed now */
+  CLG_(clear_dirty_bbccs)();
   
   /* set counters of last dump */
   CLG_(copy_cost)( CLG_(sets).full, ti->lastdump_cost,
@@ -106,6 +106,8 @@ struct _CommandLineOptions {
 
   Bool collect_bus;      /* Collect global bus events */
 
+  ULong sample_every;    /* Sample costs every xxx BBs (0: exact) */
+
   /* Instrument options */
   Bool instrument_atstart;  /* Instrument at start? */
   Bool simulate_cache;      /* Call into cache simulator ? */
@@ -175,6 +177,8 @@ struct _Statistics {
   Int  fn_name_debug_BBs;
   Int  no_debug_BBs;
   Int  bbcc_lru_misses;
+  ULong bbcc_hash_probes;
+  ULong dirty_bbccs;
   Int  jcc_lru_misses;
   Int  cxt_lru_misses;
   Int  bbcc_clones;
@@ -348,6 +352,7 @@ typedef struct _JmpData JmpData;
 struct _JmpData {
     ULong ecounter; /* number of times the BB was left at this exit */
     jCC*  jcc_list; /* JCCs used for this exit */
+    jCC*  last_jcc; /* Temporary: JCC last used for this exit (cache) */
 };
 
 
@@ -379,13 +384,14 @@ struct _BBCC {
     
     BBCC*    next_bbcc;    /* Chain of BBCCs for same BB */
     BBCC*    lru_next_bbcc; /* BBCC executed next the last time */
+    BBCC*    next_dirty;   /* Chain of BBCCs executed since last dump */
+    Bool     dirty;        /* on the dirty chain of its hash */
     
     jCC*     lru_from_jcc; /* Temporary: Cached for faster access (LRU) */
     jCC*     lru_to_jcc;   /* Temporary: Cached for faster access (LRU) */
     FullCost skipped;      /* cost for skipped functions called from 
 			    * jmp_addr. Allocated lazy */
     
-    BBCC*    next;         /* entry chain in hash */
     ULong*   cost;         /* start of 64bit costs for this BBCC */
     ULong    ecounter_sum; /* execution counter for first instruction of BB */
     JmpData  jmp[0];
@@ -527,6 +533,7 @@ typedef struct _bbcc_hash bbcc_hash;
 struct _bbcc_hash {
   UInt size, entries;
   BBCC** table;
+  BBCC* dirty;     /* BBCCs with cost since last dump */
 };
 
 typedef struct _jcc_hash jcc_hash;
@@ -553,6 +560,11 @@ typedef struct _fn_stack fn_stack;
 struct _fn_stack {
   UInt size;
   fn_node **bottom, **top;
+  /* Parallel to bottom: for each entry, the context hash of the entries
+   * from the nearest 0 below it up to this one, and the index of that 0.
+   * Set by push_cxt(), so that get_cxt() needn't rehash the stack. */
+  UWord* hash;
+  UInt*  zero;
 };
 
 /* The maximum number of simultaneous running signal handlers per thread.
@@ -729,6 +741,9 @@ void CLG_(copy_current_bbcc_hash)(bbcc_hash* dst);
 bbcc_hash* CLG_(get_current_bbcc_hash)(void);
 void CLG_(set_current_bbcc_hash)(bbcc_hash*);
 void CLG_(forall_bbccs)(void (*func)(BBCC*));
+void CLG_(mark_bbcc_dirty)(BBCC*);
+void CLG_(forall_dirty_bbccs)(void (*func)(BBCC*));
+void CLG_(clear_dirty_bbccs)(void);
 void CLG_(zero_bbcc)(BBCC* bbcc);
 BBCC* CLG_(get_bbcc)(BB* bb);
 BBCC* CLG_(clone_bbcc)(BBCC* orig, Context* cxt, Int rec_index);
@@ -132,6 +132,24 @@ static void resize_jcc_table(void)
 
 
 
+/* jCCs are never freed, so they are handed out from chunks of
+ * JCC_CHUNK_ENTRIES instead of being allocated one by one */
+#define JCC_CHUNK_ENTRIES 1024
+
+static jCC* jcc_chunk = 0;
+static Int  jcc_chunk_left = 0;
+
+static jCC* alloc_jcc(void)
+{
+   if (jcc_chunk_left == 0) {
+       jcc_chunk = (jCC*) CLG_MALLOC("cl.jumps.nj.1",
+                                     JCC_CHUNK_ENTRIES * sizeof(jCC));
+       jcc_chunk_left = JCC_CHUNK_ENTRIES;
+   }
+   jcc_chunk_left--;
+   return jcc_chunk++;
+}
+
 /* new jCC structure: a call was done to a BB of a BBCC 
  * for a spontaneous call, from is 0 (i.e. caller unknown)
  */
@@ -145,7 +163,7 @@ static jCC* new_jcc(BBCC* from, UInt jmp, BBCC* to)
    if (10 * current_jccs.entries / current_jccs.size > 8)
        resize_jcc_table();
 
-   jcc = (jCC*) CLG_MALLOC("cl.jumps.nj.1", sizeof(jCC));
+   jcc = alloc_jcc();
 
    jcc->from      = from;
    jcc->jmp       = jmp;
@@ -193,11 +211,23 @@ jCC* CLG_(get_jcc)(BBCC* from, UInt jmp, BBCC* to)
     CLG_DEBUG(5, "+ get_jcc(bbcc %p/%d => bbcc %p)\n",
 		from, jmp, to);
 
-    /* first check last recently used JCC */
+    /* first check the JCC last used for this exit, which also works
+     * when calls and jumps from the same BBCC alternate */
+    if (from) {
+	jcc = from->jmp[jmp].last_jcc;
+	if (jcc && (jcc->to == to)) {
+	    CLG_ASSERT((from == jcc->from) && (jmp == jcc->jmp));
+	    CLG_DEBUG(5,"- get_jcc: [LRU jmp] jcc %p\n", jcc);
+	    return jcc;
+	}
+    }
+
+    /* then the last recently used JCCs */
     jcc = to->lru_to_jcc;
     if (jcc && (jcc->from == from) && (jcc->jmp == jmp)) {
 	CLG_ASSERT(to == jcc->to);
 	CLG_DEBUG(5,"- get_jcc: [LRU to] jcc %p\n", jcc);
+	if (from) from->jmp[jmp].last_jcc = jcc;
 	return jcc;
     }
 
@@ -205,6 +235,7 @@ jCC* CLG_(get_jcc)(BBCC* from, UInt jmp, BBCC* to)
     if (jcc && (jcc->to == to) && (jcc->jmp == jmp)) {
 	CLG_ASSERT(from == jcc->from);
 	CLG_DEBUG(5, "- get_jcc: [LRU from] jcc %p\n", jcc);
+	from->jmp[jmp].last_jcc = jcc;
 	return jcc;
     }
 
@@ -226,6 +257,7 @@ jCC* CLG_(get_jcc)(BBCC* from, UInt jmp, BBCC* to)
     /* set LRU */
     from->lru_from_jcc = jcc;
     to->lru_to_jcc = jcc;
+    if (from) from->jmp[jmp].last_jcc = jcc;
 
     CLG_DEBUG(5, "- get_jcc(bbcc %p => bbcc %p)\n",
 		from, to);
@@ -95,6 +95,8 @@ static void CLG_(init_statistics)(Statistics* s)
   s->fn_name_debug_BBs   = 0;
   s->no_debug_BBs        = 0;
   s->bbcc_lru_misses     = 0;
+  s->bbcc_hash_probes    = 0;
+  s->dirty_bbccs         = 0;
   s->jcc_lru_misses      = 0;
   s->cxt_lru_misses      = 0;
   s->bbcc_clones         = 0;
@@ -1710,9 +1712,9 @@ Bool CLG_(handle_client_request)(ThreadId tid, UWord *args, UWord *ret)
 #include <sys/syscall.h>
 extern Int VG_(do_syscall) ( UInt, ... );
 
-ULong syscalltime[VG_N_THREADS];
+ULong *syscalltime;   /* [VG_N_THREADS] */
 #else
-UInt syscalltime[VG_N_THREADS];
+UInt *syscalltime;   /* [VG_N_THREADS] */
 #endif
 
 static
@@ -1867,6 +1869,12 @@ void clg_print_stats(void)
 		CLG_(stat).cxt_lru_misses);
    VG_(message)(Vg_DebugMsg, "LRU BBCC Misses:   %d\n",
 		CLG_(stat).bbcc_lru_misses);
+   if (CLG_(stat).bbcc_lru_misses > 0)
+      VG_(message)(Vg_DebugMsg, "BBCC hash probes:  %llu (%llu.%llu per lookup)\n",
+		   CLG_(stat).bbcc_hash_probes,
+		   CLG_(stat).bbcc_hash_probes / CLG_(stat).bbcc_lru_misses,
+		   (CLG_(stat).bbcc_hash_probes * 10
+		    / CLG_(stat).bbcc_lru_misses) % 10);
    VG_(message)(Vg_DebugMsg, "LRU JCC Misses:    %d\n",
 		CLG_(stat).jcc_lru_misses);
    VG_(message)(Vg_DebugMsg, "BBs Executed:      %llu\n",
@@ -1881,6 +1889,8 @@ void clg_print_stats(void)
 		CLG_(stat).rec_call_counter);
    VG_(message)(Vg_DebugMsg, "Returns:           %llu\n",
 		CLG_(stat).ret_counter);
+   VG_(message)(Vg_DebugMsg, "Dirty BBCCs:       %llu (%d dumps)\n",
+		CLG_(stat).dirty_bbccs, CLG_(get_dump_counter)());
 }
 
 
@@ -2000,6 +2010,15 @@ void CLG_(post_clo_init)(void)
    CLG_DEBUG(1, "  call sep. : %d\n", CLG_(clo).separate_callers);
    CLG_DEBUG(1, "  rec. sep. : %d\n", CLG_(clo).separate_recursions);
 
+   /* Sampling replaces the execution counts of basic blocks; events
+    * counted by instrumentation of each instruction can't be sampled. */
+   if (CLG_(clo).sample_every > 0 &&
+       (CLG_(clo).simulate_cache || CLG_(clo).simulate_branch ||
+        CLG_(clo).collect_bus))
+      VG_(fmsg_bad_option)("--sample-every",
+         "Sampling can't be combined with --cache-sim, --branch-sim\n"
+         "or --collect-bus.\n");
+
    if (!CLG_(clo).dump_line && !CLG_(clo).dump_instr && !CLG_(clo).dump_bb) {
        VG_(message)(Vg_UserMsg, "Using source line as position.\n");
        CLG_(clo).dump_line = True;
@@ -2009,6 +2028,10 @@ void CLG_(post_clo_init)(void)
 
    (*CLG_(cachesim).post_clo_init)();
 
+   /* The branch predictor is shared with cachegrind, which can choose
+    * other models;  callgrind always uses the original one. */
+   branchpred_init(BP_Simple, 0);
+
    CLG_(init_eventsets)();
    CLG_(init_statistics)(& CLG_(stat));
    CLG_(init_cost_lz)( CLG_(sets).full, &CLG_(total_cost) );
@@ -2021,6 +2044,10 @@ void CLG_(post_clo_init)(void)
    CLG_(init_threads)();
    CLG_(run_thread)(1);
 
+   if (CLG_(clo).collect_systime)
+      syscalltime = CLG_MALLOC("cl.main.pci.1",
+                               VG_N_THREADS * sizeof syscalltime[0]);
+
    CLG_(instrument_state) = CLG_(clo).instrument_atstart;
 
    if (VG_(clo_verbosity > 0)) {
@@ -46,23 +46,23 @@
 /* Cache configuration */
 #include "cg_arch.c"
 
-/* additional structures for cache use info, separated
- * according usage frequency:
- * - line_loaded : pointer to cost center of instruction 
+/* additional structure for cache use info, one per cache line:
+ * - count, mask : updated on every access
+ * - use_base    : pointer to cost center of instruction
  *                 which loaded the line into cache.
  *                 Needed to increment counters when line is evicted.
- * - line_use    : updated on every access
+ * It is 32 bytes and the array of them is 32-byte aligned, so that a
+ * hit or a miss touches a single host cache line.  The tags stay in
+ * their own array, as they are shuffled on every access for LRU.
  */
-typedef struct {
-  UInt count;
-  UInt mask; /* e.g. for 64Byte line size 1bit/2Byte */
-} line_use;
-
-typedef struct {
-  Addr memline, iaddr;
-  line_use* dep_use; /* point to higher-level cacheblock for this memline */
-  ULong* use_base;
-} line_loaded;  
+typedef struct _line_use line_use;
+struct _line_use {
+  UInt      count;
+  UInt      mask;     /* e.g. for 64Byte line size 1bit/2Byte */
+  line_use* dep_use;  /* point to higher-level cacheblock for this memline */
+  ULong*    use_base;
+  Addr      memline;
+} __attribute__((aligned(32)));
 
 /* Cache state */
 typedef struct {
@@ -83,15 +83,15 @@ typedef struct {
    int          line_size_mask;
    int*         line_start_mask;
    int*         line_end_mask;
-   line_loaded* loaded;
    line_use*    use;
 } cache_t2;
 
 /*
  * States of flat caches in our model.
- * We use a 2-level hierarchy, 
+ * We use a 2-level hierarchy, or with --cache-levels=3 a 3-level one
+ * with a unified L2 between I1/D1 and LL.
  */
-static cache_t2 I1, D1, LL;
+static cache_t2 I1, D1, L2, LL;
 
 /* Lower bits of cache tags are used as flags for a cache line */
 #define CACHELINE_FLAGMASK (MIN_LINE_SIZE-1)
@@ -103,6 +103,15 @@ static Bool clo_simulate_writeback = False;
 static Bool clo_simulate_hwpref = False;
 static Bool clo_simulate_sectors = False;
 static Bool clo_collect_cacheuse = False;
+static Int  clo_cache_levels = 2;
+static Bool clo_L2_exclusive = False;
+
+/* Offset of the LL miss counter in the Ir/Dr/Dw event groups:
+ * with an L2, the L2 misses come before it. */
+static Int off_LL_miss = 2;
+
+/* Set in cacheuse_initcache if the host has a POPCNT instruction. */
+static Bool have_popcnt = False;
 
 /* Following global vars are setup before by setup_bbcc():
  *
@@ -135,6 +144,7 @@ typedef enum { Hit  = 0, Miss, MissDirty } CacheResult;
 /* Result of a reference into a hierarchical cache model */
 typedef enum {
     L1_Hit, 
+    L2_Hit,
     LL_Hit,
     MemAccess,
     WriteBackMemAccess } CacheModelResult;
@@ -159,12 +169,11 @@ static void cachesim_clearcache(cache_t2* c)
     c->tags[i] = 0;
   if (c->use) {
     for (i = 0; i < c->sets * c->assoc; i++) {
-      c->loaded[i].memline  = 0;
-      c->loaded[i].use_base = 0;
-      c->loaded[i].dep_use = 0;
-      c->loaded[i].iaddr = 0;
-      c->use[i].mask    = 0;
-      c->use[i].count   = 0;
+      c->use[i].memline  = 0;
+      c->use[i].use_base = 0;
+      c->use[i].dep_use  = 0;
+      c->use[i].mask     = 0;
+      c->use[i].count    = 0;
       c->tags[i] = i % c->assoc; /* init lower bits as pointer */
     }
   }
@@ -595,6 +604,100 @@ CacheModelResult prefetch_D1_Write(Addr a, UChar size)
 }
 
 
+/*------------------------------------------------------------*/
+/*--- Simulation with L2 cache                             ---*/
+/*------------------------------------------------------------*/
+
+/*
+ * Model: 3-level hierarchy (L1/L2/LL), write-allocate, no write-back.
+ * An inclusive L2 is filled on a miss, as LL is. An exclusive L2 only
+ * holds lines evicted from I1 and D1: a line that hits in L2 moves to
+ * L1, and L1's victim moves to L2. I1, D1 and L2 have the same line
+ * size then, so block numbers are the tags at all three levels.
+ * With hardware prefetch, the prefetcher still fills LL.
+ */
+
+/* Like cachesim_setref(), but on a miss also returns the evicted tag
+ * in *victim (0 if that way was empty). */
+static CacheResult cachesim_setref_evict(cache_t2* c, UInt set_no,
+                                         UWord tag, UWord* victim)
+{
+    *victim = c->tags[set_no * c->assoc + c->assoc - 1];
+    return cachesim_setref(c, set_no, tag);
+}
+
+/* If tag is in the set, removes it and returns True. */
+static Bool cachesim_setref_take(cache_t2* c, UInt set_no, UWord tag)
+{
+    int i, j;
+    UWord *set;
+
+    set = &(c->tags[set_no * c->assoc]);
+
+    for (i = 0; i < c->assoc; i++) {
+        if (tag == set[i]) {
+            for (j = i; j < c->assoc - 1; j++) {
+                set[j] = set[j + 1];
+            }
+            set[c->assoc - 1] = 0;
+            return True;
+        }
+    }
+    return False;
+}
+
+/* An access straddling two lines returns the worst of both results. */
+static
+CacheModelResult cachesim_L2_ref_excl(cache_t2* L1, Addr a, UChar size)
+{
+    UWord block1 =  a         >> L1->line_size_bits;
+    UWord block2 = (a+size-1) >> L1->line_size_bits;
+    UWord block, victim;
+    CacheModelResult res = L1_Hit;
+
+    for (block = block1; block <= block2; block++) {
+        Addr line = block << L1->line_size_bits;
+
+        if (cachesim_setref_evict(L1, block & L1->sets_min_1,
+                                  block, &victim) == Hit)
+            continue;
+        if (res < L2_Hit) res = L2_Hit;
+        if (!cachesim_setref_take(&L2, block & L2.sets_min_1, block)) {
+            if (clo_simulate_hwpref) prefetch_LL_doref(line);
+            if (cachesim_ref( &LL, line, 1) == Miss) res = MemAccess;
+            else if (res < LL_Hit) res = LL_Hit;
+        }
+        if (victim != 0)
+            cachesim_setref(&L2, victim & L2.sets_min_1, victim);
+    }
+    return res;
+}
+
+static __inline__
+CacheModelResult cachesim_L2_ref(cache_t2* L1, Addr a, UChar size)
+{
+    if (clo_L2_exclusive) return cachesim_L2_ref_excl(L1, a, size);
+
+    if ( cachesim_ref( L1, a, size) == Hit ) return L1_Hit;
+    if ( cachesim_ref( &L2, a, size) == Hit ) return L2_Hit;
+    if (clo_simulate_hwpref) prefetch_LL_doref(a);
+    if ( cachesim_ref( &LL, a, size) == Hit ) return LL_Hit;
+    return MemAccess;
+}
+
+static
+CacheModelResult cachesim_I1_ref_L2(Addr a, UChar size)
+{
+    return cachesim_L2_ref(&I1, a, size);
+}
+
+static
+CacheModelResult cachesim_D1_ref_L2(Addr a, UChar size)
+{
+    return cachesim_L2_ref(&D1, a, size);
+}
+
+
 /*------------------------------------------------------------*/
 /*--- Cache Simulation with use metric collection          ---*/
 /*------------------------------------------------------------*/
@@ -608,10 +711,10 @@ void cacheuse_initcache(cache_t2* c)
     unsigned int start_mask, start_val;
     unsigned int end_mask, end_val;
 
-    c->use    = CLG_MALLOC("cl.sim.cu_ic.1",
-                           sizeof(line_use) * c->sets * c->assoc);
-    c->loaded = CLG_MALLOC("cl.sim.cu_ic.2",
-                           sizeof(line_loaded) * c->sets * c->assoc);
+    c->use = (line_use*) VG_ROUNDUP((Addr)CLG_MALLOC("cl.sim.cu_ic.1",
+                                    sizeof(line_use) * c->sets * c->assoc
+                                    + sizeof(line_use) - 1),
+                                    sizeof(line_use));
     c->line_start_mask = CLG_MALLOC("cl.sim.cu_ic.3",
                                     sizeof(int) * c->line_size);
     c->line_end_mask = CLG_MALLOC("cl.sim.cu_ic.4",
@@ -669,6 +772,23 @@ void cacheuse_initcache(cache_t2* c)
 		  i, c->line_start_mask[i], c->line_end_mask[i]);
     }
     
+    /* VEX has no hwcap for POPCNT, but all hosts with LZCNT or AVX
+     * have it. */
+#if defined(VGA_amd64)
+    {
+      VexArchInfo vai;
+      VG_(machine_get_VexArchInfo)(NULL, &vai);
+      have_popcnt = (vai.hwcaps & (VEX_HWCAPS_AMD64_LZCNT |
+                                   VEX_HWCAPS_AMD64_AVX)) != 0;
+    }
+#elif defined(VGA_x86)
+    {
+      VexArchInfo vai;
+      VG_(machine_get_VexArchInfo)(NULL, &vai);
+      have_popcnt = (vai.hwcaps & VEX_HWCAPS_X86_LZCNT) != 0;
+    }
+#endif
+
     /* We use lower tag bits as offset pointers to cache use info.
      * I.e. some cache parameters don't work.
      */
@@ -711,8 +831,8 @@ static CacheModelResult cacheuse##_##L##_doRead(Addr a, UChar size)         \
         idx = (set1 * L.assoc) + (set[0] & ~L.tag_mask);                    \
         L.use[idx].count ++;                                                \
         L.use[idx].mask |= use_mask;                                        \
-	CLG_DEBUG(6," Hit0 [idx %d] (line %#lx from %#lx): %x => %08x, count %d\n",\
-		 idx, L.loaded[idx].memline,  L.loaded[idx].iaddr,          \
+	CLG_DEBUG(6," Hit0 [idx %d] (line %#lx): %x => %08x, count %d\n",\
+		 idx, L.use[idx].memline,          \
 		 use_mask, L.use[idx].mask, L.use[idx].count);              \
 	return L1_Hit;							    \
       }                                                                     \
@@ -728,8 +848,8 @@ static CacheModelResult cacheuse##_##L##_doRead(Addr a, UChar size)         \
             idx = (set1 * L.assoc) + (tmp_tag & ~L.tag_mask);               \
             L.use[idx].count ++;                                            \
             L.use[idx].mask |= use_mask;                                    \
-	CLG_DEBUG(6," Hit%d [idx %d] (line %#lx from %#lx): %x => %08x, count %d\n",\
-		 i, idx, L.loaded[idx].memline,  L.loaded[idx].iaddr,       \
+	CLG_DEBUG(6," Hit%d [idx %d] (line %#lx): %x => %08x, count %d\n",\
+		 i, idx, L.use[idx].memline,       \
 		 use_mask, L.use[idx].mask, L.use[idx].count);              \
             return L1_Hit;                                                  \
          }                                                                  \
@@ -755,8 +875,8 @@ static CacheModelResult cacheuse##_##L##_doRead(Addr a, UChar size)         \
          idx = (set1 * L.assoc) + (set[0] & ~L.tag_mask);                   \
          L.use[idx].count ++;                                               \
          L.use[idx].mask |= use_mask;                                       \
-	CLG_DEBUG(6," Hit0 [idx %d] (line %#lx from %#lx): %x => %08x, count %d\n",\
-		 idx, L.loaded[idx].memline,  L.loaded[idx].iaddr,          \
+	CLG_DEBUG(6," Hit0 [idx %d] (line %#lx): %x => %08x, count %d\n",\
+		 idx, L.use[idx].memline,          \
 		 use_mask, L.use[idx].mask, L.use[idx].count);              \
          goto block2;                                                       \
       }                                                                     \
@@ -770,8 +890,8 @@ static CacheModelResult cacheuse##_##L##_doRead(Addr a, UChar size)         \
             idx = (set1 * L.assoc) + (tmp_tag & ~L.tag_mask);               \
             L.use[idx].count ++;                                            \
             L.use[idx].mask |= use_mask;                                    \
-	CLG_DEBUG(6," Hit%d [idx %d] (line %#lx from %#lx): %x => %08x, count %d\n",\
-		 i, idx, L.loaded[idx].memline,  L.loaded[idx].iaddr,       \
+	CLG_DEBUG(6," Hit%d [idx %d] (line %#lx): %x => %08x, count %d\n",\
+		 i, idx, L.use[idx].memline,       \
 		 use_mask, L.use[idx].mask, L.use[idx].count);              \
             goto block2;                                                    \
          }                                                                  \
@@ -792,8 +912,8 @@ block2:                                                                     \
          idx = (set2 * L.assoc) + (set[0] & ~L.tag_mask);                   \
          L.use[idx].count ++;                                               \
          L.use[idx].mask |= use_mask;                                       \
-	CLG_DEBUG(6," Hit0 [idx %d] (line %#lx from %#lx): %x => %08x, count %d\n",\
-		 idx, L.loaded[idx].memline,  L.loaded[idx].iaddr,          \
+	CLG_DEBUG(6," Hit0 [idx %d] (line %#lx): %x => %08x, count %d\n",\
+		 idx, L.use[idx].memline,          \
 		 use_mask, L.use[idx].mask, L.use[idx].count);              \
          return miss1;                                                      \
       }                                                                     \
@@ -807,8 +927,8 @@ block2:                                                                     \
             idx = (set2 * L.assoc) + (tmp_tag & ~L.tag_mask);               \
             L.use[idx].count ++;                                            \
             L.use[idx].mask |= use_mask;                                    \
-	CLG_DEBUG(6," Hit%d [idx %d] (line %#lx from %#lx): %x => %08x, count %d\n",\
-		 i, idx, L.loaded[idx].memline,  L.loaded[idx].iaddr,       \
+	CLG_DEBUG(6," Hit%d [idx %d] (line %#lx): %x => %08x, count %d\n",\
+		 i, idx, L.use[idx].memline,       \
 		 use_mask, L.use[idx].mask, L.use[idx].count);              \
             return miss1;                                                   \
          }                                                                  \
@@ -837,6 +957,13 @@ block2:                                                                     \
 static __inline__ unsigned int countBits(unsigned int bits)
 {
   unsigned int c; // store the total here
+#if defined(VGA_x86) || defined(VGA_amd64)
+  if (have_popcnt) {
+    __asm__ ("popcnt %1, %0" : "=r" (c) : "rm" (bits));
+    return c;
+  }
+#endif
+
   const int S[] = {1, 2, 4, 8, 16}; // Magic Binary Numbers
   const int B[] = {0x55555555, 0x33333333, 0x0F0F0F0F, 0x00FF00FF, 0x0000FFFF};
 
@@ -851,36 +978,34 @@ static __inline__ unsigned int countBits(unsigned int bits)
 
 static void update_LL_use(int idx, Addr memline)
 {
-  line_loaded* loaded = &(LL.loaded[idx]);
   line_use* use = &(LL.use[idx]);
   int i = ((32 - countBits(use->mask)) * LL.line_size)>>5;
   
   CLG_DEBUG(2, " LL.miss [%d]: at %#lx accessing memline %#lx\n",
            idx, CLG_(bb_base) + current_ii->instr_offset, memline);
   if (use->count>0) {
-    CLG_DEBUG(2, "   old: used %d, loss bits %d (%08x) [line %#lx from %#lx]\n",
-	     use->count, i, use->mask, loaded->memline, loaded->iaddr);
+    CLG_DEBUG(2, "   old: used %d, loss bits %d (%08x) [line %#lx]\n",
+	     use->count, i, use->mask, use->memline);
     CLG_DEBUG(2, "   collect: %d, use_base %p\n",
-	     CLG_(current_state).collect, loaded->use_base);
+	     CLG_(current_state).collect, use->use_base);
     
-    if (CLG_(current_state).collect && loaded->use_base) {
-      (loaded->use_base)[off_LL_AcCost] += 1000 / use->count;
-      (loaded->use_base)[off_LL_SpLoss] += i;
+    if (CLG_(current_state).collect && use->use_base) {
+      (use->use_base)[off_LL_AcCost] += 1000 / use->count;
+      (use->use_base)[off_LL_SpLoss] += i;
     }
    }
 
    use->count = 0;
    use->mask  = 0;
 
-  loaded->memline = memline;
-  loaded->iaddr   = CLG_(bb_base) + current_ii->instr_offset;
-  loaded->use_base = (CLG_(current_state).nonskipped) ?
+  use->memline  = memline;
+  use->use_base = (CLG_(current_state).nonskipped) ?
     CLG_(current_state).nonskipped->skipped :
     CLG_(cost_base) + current_ii->cost_offset;
 }
 
 static
-CacheModelResult cacheuse_LL_access(Addr memline, line_loaded* l1_loaded)
+CacheModelResult cacheuse_LL_access(Addr memline, line_use* l1_use)
 {
    UInt setNo = (memline >> LL.line_size_bits) & (LL.sets_min_1);
    UWord* set = &(LL.tags[setNo * LL.assoc]);
@@ -893,10 +1018,10 @@ CacheModelResult cacheuse_LL_access(Addr memline, line_loaded* l1_loaded)
 
    if (tag == (set[0] & LL.tag_mask)) {
      idx = (setNo * LL.assoc) + (set[0] & ~LL.tag_mask);
-     l1_loaded->dep_use = &(LL.use[idx]);
+     l1_use->dep_use = &(LL.use[idx]);
 
-     CLG_DEBUG(6," Hit0 [idx %d] (line %#lx from %#lx): => %08x, count %d\n",
-		 idx, LL.loaded[idx].memline,  LL.loaded[idx].iaddr,
+     CLG_DEBUG(6," Hit0 [idx %d] (line %#lx): => %08x, count %d\n",
+		 idx, LL.use[idx].memline,
 		 LL.use[idx].mask, LL.use[idx].count);
      return LL_Hit;
    }
@@ -908,10 +1033,10 @@ CacheModelResult cacheuse_LL_access(Addr memline, line_loaded* l1_loaded)
        }
        set[0] = tmp_tag;
        idx = (setNo * LL.assoc) + (tmp_tag & ~LL.tag_mask);
-       l1_loaded->dep_use = &(LL.use[idx]);
+       l1_use->dep_use = &(LL.use[idx]);
 
-	CLG_DEBUG(6," Hit%d [idx %d] (line %#lx from %#lx): => %08x, count %d\n",
-		 i, idx, LL.loaded[idx].memline,  LL.loaded[idx].iaddr,
+	CLG_DEBUG(6," Hit%d [idx %d] (line %#lx): => %08x, count %d\n",
+		 i, idx, LL.use[idx].memline,
 		 LL.use[idx].mask, LL.use[idx].count);
 	return LL_Hit;
      }
@@ -924,7 +1049,7 @@ CacheModelResult cacheuse_LL_access(Addr memline, line_loaded* l1_loaded)
    }
    set[0] = tag | tmp_tag;
    idx = (setNo * LL.assoc) + tmp_tag;
-   l1_loaded->dep_use = &(LL.use[idx]);
+   l1_use->dep_use = &(LL.use[idx]);
 
    update_LL_use(idx, memline);
 
@@ -939,38 +1064,36 @@ CacheModelResult cacheuse_LL_access(Addr memline, line_loaded* l1_loaded)
 static CacheModelResult update##_##L##_use(cache_t2* cache, int idx, \
 			       UInt mask, Addr memline)		     \
 {                                                                    \
-  line_loaded* loaded = &(cache->loaded[idx]);			     \
   line_use* use = &(cache->use[idx]);				     \
   int c = ((32 - countBits(use->mask)) * cache->line_size)>>5;       \
                                                                      \
   CLG_DEBUG(2, " %s.miss [%d]: at %#lx accessing memline %#lx (mask %08x)\n", \
            cache->name, idx, CLG_(bb_base) + current_ii->instr_offset, memline, mask); \
   if (use->count>0) {                                                \
-    CLG_DEBUG(2, "   old: used %d, loss bits %d (%08x) [line %#lx from %#lx]\n",\
-	     use->count, c, use->mask, loaded->memline, loaded->iaddr);	\
+    CLG_DEBUG(2, "   old: used %d, loss bits %d (%08x) [line %#lx]\n",\
+	     use->count, c, use->mask, use->memline);			\
     CLG_DEBUG(2, "   collect: %d, use_base %p\n", \
-	     CLG_(current_state).collect, loaded->use_base);	     \
+	     CLG_(current_state).collect, use->use_base);	     \
                                                                      \
-    if (CLG_(current_state).collect && loaded->use_base) {           \
-      (loaded->use_base)[off_##L##_AcCost] += 1000 / use->count;     \
-      (loaded->use_base)[off_##L##_SpLoss] += c;                     \
+    if (CLG_(current_state).collect && use->use_base) {              \
+      (use->use_base)[off_##L##_AcCost] += 1000 / use->count;        \
+      (use->use_base)[off_##L##_SpLoss] += c;                        \
                                                                      \
       /* FIXME (?): L1/LL line sizes must be equal ! */              \
-      loaded->dep_use->mask |= use->mask;                            \
-      loaded->dep_use->count += use->count;                          \
+      use->dep_use->mask |= use->mask;                               \
+      use->dep_use->count += use->count;                             \
     }                                                                \
   }                                                                  \
                                                                      \
   use->count = 1;                                                    \
   use->mask  = mask;                                                 \
-  loaded->memline = memline;                                         \
-  loaded->iaddr   = CLG_(bb_base) + current_ii->instr_offset;        \
-  loaded->use_base = (CLG_(current_state).nonskipped) ?              \
+  use->memline  = memline;                                           \
+  use->use_base = (CLG_(current_state).nonskipped) ?                 \
     CLG_(current_state).nonskipped->skipped :                        \
     CLG_(cost_base) + current_ii->cost_offset;                       \
                                                                      \
   if (memline == 0) return LL_Hit;                                   \
-  return cacheuse_LL_access(memline, loaded);                        \
+  return cacheuse_LL_access(memline, use);                           \
 }
 
 UPDATE_USE(I1);
@@ -995,17 +1118,17 @@ void cacheuse_finish(void)
   /* update usage counters */
   if (I1.use)
     for (i = 0; i < I1.sets * I1.assoc; i++)
-      if (I1.loaded[i].use_base)
+      if (I1.use[i].use_base)
 	update_I1_use( &I1, i, 0,0);
 
   if (D1.use)
     for (i = 0; i < D1.sets * D1.assoc; i++)
-      if (D1.loaded[i].use_base)
+      if (D1.use[i].use_base)
 	update_D1_use( &D1, i, 0,0);
 
   if (LL.use)
     for (i = 0; i < LL.sets * LL.assoc; i++)
-      if (LL.loaded[i].use_base)
+      if (LL.use[i].use_base)
 	update_LL_use(i, 0);
 
   current_ii = 0;
@@ -1030,11 +1153,18 @@ void inc_costs(CacheModelResult r, ULong* c1, ULong* c2)
 	    // fall through
 
 	case MemAccess:
-	    c1[2]++;
-	    c2[2]++;
+	    c1[off_LL_miss]++;
+	    c2[off_LL_miss]++;
 	    // fall through
 
 	case LL_Hit:
+	    if (clo_cache_levels == 3) {
+		c1[2]++;
+		c2[2]++;
+	    }
+	    // fall through
+
+	case L2_Hit:
 	    c1[1]++;
 	    c2[1]++;
 	    // fall through
@@ -1050,6 +1180,7 @@ const HChar* cacheRes(CacheModelResult r)
 {
     switch(r) {
     case L1_Hit:    return "L1 Hit ";
+    case L2_Hit:    return "L2 Hit ";
     case LL_Hit:    return "LL Hit ";
     case MemAccess: return "LL Miss";
     case WriteBackMemAccess: return "LL Miss (dirty)";
@@ -1284,13 +1415,15 @@ static void log_0I1Dw(InstrInfo* ii, Addr data_addr, Word data_size)
 
 static cache_t clo_I1_cache = UNDEFINED_CACHE;
 static cache_t clo_D1_cache = UNDEFINED_CACHE;
+static cache_t clo_L2_cache = UNDEFINED_CACHE;
 static cache_t clo_LL_cache = UNDEFINED_CACHE;
 
 /* Initialize and clear simulator state */
 static void cachesim_post_clo_init(void)
 {
   /* Cache configurations. */
-  cache_t  I1c, D1c, LLc;
+  cache_t  I1c, D1c, L2c, LLc;
+  cache_t* L2p;
 
   /* Initialize access handlers */
   if (!CLG_(clo).simulate_cache) {
@@ -1313,14 +1446,44 @@ static void cachesim_post_clo_init(void)
     return;
   }
 
+  /* The L2 is only simulated in the models without write-back and
+   * without cache use; the event sets have no columns for the others. */
+  if (clo_cache_levels == 3 && clo_collect_cacheuse) {
+      VG_(message)(Vg_DebugMsg,
+		   "warning: L2 simulation can not be "
+                   "used with cache usage\n");
+      clo_cache_levels = 2;
+  }
+  if (clo_cache_levels == 3 && clo_simulate_writeback) {
+      VG_(message)(Vg_DebugMsg,
+		   "warning: L2 simulation can not be "
+                   "used with write-back simulation\n");
+      clo_cache_levels = 2;
+  }
+  L2p = (clo_cache_levels == 3) ? &L2c : NULL;
+
   /* Configuration of caches only needed with real cache simulation */
-  VG_(post_clo_init_configure_caches)(&I1c, &D1c, &LLc,
+  VG_(post_clo_init_configure_caches)(&I1c, &D1c, L2p, &LLc,
                                       &clo_I1_cache,
                                       &clo_D1_cache,
+                                      &clo_L2_cache,
                                       &clo_LL_cache);
 
+  if (L2p == NULL && clo_L2_exclusive) {
+      VG_(fmsg_bad_option)("--L2-policy=exclusive",
+                           "An L2 cache is only simulated with "
+                           "--cache-levels=3.\n");
+  }
+  // The exclusive L2 swaps lines with I1 and D1.
+  if (L2p && clo_L2_exclusive &&
+      (I1c.line_size != L2c.line_size || D1c.line_size != L2c.line_size)) {
+      VG_(fmsg_bad_option)("--L2-policy=exclusive",
+                           "I1, D1 and L2 must have the same line size.\n");
+  }
+
   I1.name = "I1";
   D1.name = "D1";
+  L2.name = "L2";
   LL.name = "LL";
 
   // min_line_size is used to make sure that we never feed
@@ -1330,6 +1493,9 @@ static void cachesim_post_clo_init(void)
                            ? I1c.line_size : D1c.line_size;
   CLG_(min_line_size) = (LLc.line_size < CLG_(min_line_size))
                            ? LLc.line_size : CLG_(min_line_size);
+  if (L2p)
+     CLG_(min_line_size) = (L2c.line_size < CLG_(min_line_size))
+                              ? L2c.line_size : CLG_(min_line_size);
 
   Int largest_load_or_store_size
      = VG_(machine_get_size_of_largest_guest_register)();
@@ -1347,6 +1513,10 @@ static void cachesim_post_clo_init(void)
 
   cachesim_initcache(I1c, &I1);
   cachesim_initcache(D1c, &D1);
+  if (L2p) {
+     cachesim_initcache(L2c, &L2);
+     off_LL_miss = 3;
+  }
   cachesim_initcache(LLc, &LL);
 
   /* the other cache simulators use the standard helpers
@@ -1392,6 +1562,15 @@ static void cachesim_post_clo_init(void)
       return;
   }
 
+  if (L2p) {
+    prefetch_clear();
+
+    simulator.I1_Read  = cachesim_I1_ref_L2;
+    simulator.D1_Read  = cachesim_D1_ref_L2;
+    simulator.D1_Write = cachesim_D1_ref_L2;
+    return;
+  }
+
   if (clo_simulate_hwpref) {
     prefetch_clear();
 
@@ -1428,6 +1607,8 @@ void cachesim_clear(void)
 {
   cachesim_clearcache(&I1);
   cachesim_clearcache(&D1);
+  if (clo_cache_levels == 3)
+    cachesim_clearcache(&L2);
   cachesim_clearcache(&LL);
 
   prefetch_clear();
@@ -1439,6 +1620,8 @@ static void cachesim_getdesc(HChar* buf)
   Int p;
   p = VG_(sprintf)(buf, "\ndesc: I1 cache: %s\n", I1.desc_line);
   p += VG_(sprintf)(buf+p, "desc: D1 cache: %s\n", D1.desc_line);
+  if (clo_cache_levels == 3)
+    p += VG_(sprintf)(buf+p, "desc: L2 cache: %s\n", L2.desc_line);
   VG_(sprintf)(buf+p, "desc: LL cache: %s\n", LL.desc_line);
 }
 
@@ -1452,7 +1635,10 @@ void cachesim_print_opts(void)
 #if CLG_EXPERIMENTAL
 "    --simulate-sectors=no|yes Simulate sectored behaviour [no]\n"
 #endif
-"    --cacheuse=no|yes         Collect cache block use [no]\n");
+"    --cacheuse=no|yes         Collect cache block use [no]\n"
+"    --cache-levels=2|3        Simulate L1 and LL, or L1, L2 and LL [2]\n"
+"    --L2-policy=inclusive|exclusive  Does L2 hold only lines evicted\n"
+"                              from L1? [inclusive]\n");
   VG_(print_cache_clo_opts)();
 }
 
@@ -1466,6 +1652,9 @@ static Bool cachesim_parse_opt(const HChar* arg)
    if      VG_BOOL_CLO(arg, "--simulate-wb",      clo_simulate_writeback) {}
    else if VG_BOOL_CLO(arg, "--simulate-hwpref",  clo_simulate_hwpref)    {}
    else if VG_BOOL_CLO(arg, "--simulate-sectors", clo_simulate_sectors)   {}
+   else if VG_BINT_CLO(arg, "--cache-levels", clo_cache_levels, 2, 3)   {}
+   else if VG_XACT_CLO(arg, "--L2-policy=inclusive", clo_L2_exclusive, False) {}
+   else if VG_XACT_CLO(arg, "--L2-policy=exclusive", clo_L2_exclusive, True)  {}
 
    else if VG_BOOL_CLO(arg, "--cacheuse", clo_collect_cacheuse) {
       if (clo_collect_cacheuse) {
@@ -1477,6 +1666,7 @@ static Bool cachesim_parse_opt(const HChar* arg)
    else if (VG_(str_clo_cache_opt)(arg,
                                    &clo_I1_cache,
                                    &clo_D1_cache,
+                                   &clo_L2_cache,
                                    &clo_LL_cache)) {}
 
    else
@@ -1539,6 +1729,7 @@ void cachesim_printstat(Int l1, Int l2, Int l3)
   FullCost total = CLG_(total_cost), D_total = 0;
   ULong LL_total_m, LL_total_mr, LL_total_mw,
     LL_total, LL_total_r, LL_total_w;
+  Int L = off_LL_miss;
   HChar buf1[RESULTS_BUF_LEN], 
     buf2[RESULTS_BUF_LEN], 
     buf3[RESULTS_BUF_LEN];
@@ -1555,7 +1746,12 @@ void cachesim_printstat(Int l1, Int l2, Int l3)
   commify(total[fullOffset(EG_IR) +1], l1, buf1);
   VG_(message)(Vg_UserMsg, "I1  misses:    %s\n", buf1);
 
-  commify(total[fullOffset(EG_IR) +2], l1, buf1);
+  if (clo_cache_levels == 3) {
+    commify(total[fullOffset(EG_IR) +2], l1, buf1);
+    VG_(message)(Vg_UserMsg, "I2  misses:    %s\n", buf1);
+  }
+
+  commify(total[fullOffset(EG_IR) +L], l1, buf1);
   VG_(message)(Vg_UserMsg, "LLi misses:    %s\n", buf1);
 
   p = 100;
@@ -1566,8 +1762,14 @@ void cachesim_printstat(Int l1, Int l2, Int l3)
   percentify(total[fullOffset(EG_IR)+1] * 100 * p /
 	     total[fullOffset(EG_IR)], p, l1+1, buf1);
   VG_(message)(Vg_UserMsg, "I1  miss rate: %s\n", buf1);
+
+  if (clo_cache_levels == 3) {
+    percentify(total[fullOffset(EG_IR)+2] * 100 * p /
+	       total[fullOffset(EG_IR)], p, l1+1, buf1);
+    VG_(message)(Vg_UserMsg, "I2  miss rate: %s\n", buf1);
+  }
        
-  percentify(total[fullOffset(EG_IR)+2] * 100 * p /
+  percentify(total[fullOffset(EG_IR)+L] * 100 * p /
 	     total[fullOffset(EG_IR)], p, l1+1, buf1);
   VG_(message)(Vg_UserMsg, "LLi miss rate: %s\n", buf1);
   VG_(message)(Vg_UserMsg, "\n");
@@ -1578,7 +1780,7 @@ void cachesim_printstat(Int l1, Int l2, Int l3)
 
   D_total = CLG_(get_eventset_cost)( CLG_(sets).full );
   CLG_(init_cost)( CLG_(sets).full, D_total);
-  // we only use the first 3 values of D_total, adding up Dr and Dw costs
+  // we only use the first 3 (with L2: 4) values of D_total, adding up Dr and Dw costs
   CLG_(copy_cost)( CLG_(get_event_set)(EG_DR), D_total, total + fullOffset(EG_DR) );
   CLG_(add_cost) ( CLG_(get_event_set)(EG_DW), D_total, total + fullOffset(EG_DW) );
 
@@ -1594,9 +1796,17 @@ void cachesim_printstat(Int l1, Int l2, Int l3)
   VG_(message)(Vg_UserMsg, "D1  misses:    %s  (%s rd + %s wr)\n",
 	       buf1, buf2, buf3);
 
-  commify( D_total[2], l1, buf1);
-  commify(total[fullOffset(EG_DR)+2], l2, buf2);
-  commify(total[fullOffset(EG_DW)+2], l3, buf3);
+  if (clo_cache_levels == 3) {
+    commify( D_total[2], l1, buf1);
+    commify(total[fullOffset(EG_DR)+2], l2, buf2);
+    commify(total[fullOffset(EG_DW)+2], l3, buf3);
+    VG_(message)(Vg_UserMsg, "D2  misses:    %s  (%s rd + %s wr)\n",
+	         buf1, buf2, buf3);
+  }
+
+  commify( D_total[L], l1, buf1);
+  commify(total[fullOffset(EG_DR)+L], l2, buf2);
+  commify(total[fullOffset(EG_DW)+L], l3, buf3);
   VG_(message)(Vg_UserMsg, "LLd misses:    %s  (%s rd + %s wr)\n",
 	       buf1, buf2, buf3);
 
@@ -1613,11 +1823,21 @@ void cachesim_printstat(Int l1, Int l2, Int l3)
 	     total[fullOffset(EG_DW)], p, l3+1, buf3);
   VG_(message)(Vg_UserMsg, "D1  miss rate: %s (%s   + %s  )\n", 
                buf1, buf2,buf3);
+
+  if (clo_cache_levels == 3) {
+    percentify( D_total[2] * 100 * p / D_total[0],  p, l1+1, buf1);
+    percentify(total[fullOffset(EG_DR)+2] * 100 * p /
+	       total[fullOffset(EG_DR)], p, l2+1, buf2);
+    percentify(total[fullOffset(EG_DW)+2] * 100 * p /
+	       total[fullOffset(EG_DW)], p, l3+1, buf3);
+    VG_(message)(Vg_UserMsg, "D2  miss rate: %s (%s   + %s  )\n", 
+                 buf1, buf2,buf3);
+  }
   
-  percentify( D_total[2] * 100 * p / D_total[0],  p, l1+1, buf1);
-  percentify(total[fullOffset(EG_DR)+2] * 100 * p /
+  percentify( D_total[L] * 100 * p / D_total[0],  p, l1+1, buf1);
+  percentify(total[fullOffset(EG_DR)+L] * 100 * p /
 	     total[fullOffset(EG_DR)], p, l2+1, buf2);
-  percentify(total[fullOffset(EG_DW)+2] * 100 * p /
+  percentify(total[fullOffset(EG_DW)+L] * 100 * p /
 	     total[fullOffset(EG_DW)], p, l3+1, buf3);
   VG_(message)(Vg_UserMsg, "LLd miss rate: %s (%s   + %s  )\n", 
                buf1, buf2,buf3);
@@ -1625,16 +1845,59 @@ void cachesim_printstat(Int l1, Int l2, Int l3)
 
 
   
+  /* L2 overall results */
+
+  if (clo_cache_levels == 3) {
+    LL_total   =
+      total[fullOffset(EG_DR) +1] +
+      total[fullOffset(EG_DW) +1] +
+      total[fullOffset(EG_IR) +1];
+    LL_total_r =
+      total[fullOffset(EG_DR) +1] +
+      total[fullOffset(EG_IR) +1];
+    LL_total_w = total[fullOffset(EG_DW) +1];
+    commify(LL_total,   l1, buf1);
+    commify(LL_total_r, l2, buf2);
+    commify(LL_total_w, l3, buf3);
+    VG_(message)(Vg_UserMsg, "L2 refs:       %s  (%s rd + %s wr)\n",
+	         buf1, buf2, buf3);
+
+    LL_total_m  =
+      total[fullOffset(EG_DR) +2] +
+      total[fullOffset(EG_DW) +2] +
+      total[fullOffset(EG_IR) +2];
+    LL_total_mr =
+      total[fullOffset(EG_DR) +2] +
+      total[fullOffset(EG_IR) +2];
+    LL_total_mw = total[fullOffset(EG_DW) +2];
+    commify(LL_total_m,  l1, buf1);
+    commify(LL_total_mr, l2, buf2);
+    commify(LL_total_mw, l3, buf3);
+    VG_(message)(Vg_UserMsg, "L2 misses:     %s  (%s rd + %s wr)\n",
+	         buf1, buf2, buf3);
+
+    percentify(LL_total_m  * 100 * p /
+	       (total[fullOffset(EG_IR)] + D_total[0]),  p, l1+1, buf1);
+    percentify(LL_total_mr * 100 * p /
+	       (total[fullOffset(EG_IR)] + total[fullOffset(EG_DR)]),
+	       p, l2+1, buf2);
+    percentify(LL_total_mw * 100 * p /
+	       total[fullOffset(EG_DW)], p, l3+1, buf3);
+    VG_(message)(Vg_UserMsg, "L2 miss rate:  %s (%s   + %s  )\n",
+	         buf1, buf2,buf3);
+    VG_(message)(Vg_UserMsg, "\n");
+  }
+
   /* LL overall results */
   
   LL_total   =
-    total[fullOffset(EG_DR) +1] +
-    total[fullOffset(EG_DW) +1] +
-    total[fullOffset(EG_IR) +1];
+    total[fullOffset(EG_DR) +L-1] +
+    total[fullOffset(EG_DW) +L-1] +
+    total[fullOffset(EG_IR) +L-1];
   LL_total_r =
-    total[fullOffset(EG_DR) +1] +
-    total[fullOffset(EG_IR) +1];
-  LL_total_w = total[fullOffset(EG_DW) +1];
+    total[fullOffset(EG_DR) +L-1] +
+    total[fullOffset(EG_IR) +L-1];
+  LL_total_w = total[fullOffset(EG_DW) +L-1];
   commify(LL_total,   l1, buf1);
   commify(LL_total_r, l2, buf2);
   commify(LL_total_w, l3, buf3);
@@ -1642,13 +1905,13 @@ void cachesim_printstat(Int l1, Int l2, Int l3)
 	       buf1, buf2, buf3);
   
   LL_total_m  =
-    total[fullOffset(EG_DR) +2] +
-    total[fullOffset(EG_DW) +2] +
-    total[fullOffset(EG_IR) +2];
+    total[fullOffset(EG_DR) +L] +
+    total[fullOffset(EG_DW) +L] +
+    total[fullOffset(EG_IR) +L];
   LL_total_mr =
-    total[fullOffset(EG_DR) +2] +
-    total[fullOffset(EG_IR) +2];
-  LL_total_mw = total[fullOffset(EG_DW) +2];
+    total[fullOffset(EG_DR) +L] +
+    total[fullOffset(EG_IR) +L];
+  LL_total_mw = total[fullOffset(EG_DW) +L];
   commify(LL_total_m,  l1, buf1);
   commify(LL_total_mr, l2, buf2);
   commify(LL_total_mw, l3, buf3);
@@ -1683,6 +1946,11 @@ void CLG_(init_eventsets)()
 
     if (!CLG_(clo).simulate_cache)
 	CLG_(register_event_group)(EG_IR, "Ir");
+    else if (clo_cache_levels == 3) {
+	CLG_(register_event_group4)(EG_IR, "Ir", "I1mr", "I2mr", "ILmr");
+	CLG_(register_event_group4)(EG_DR, "Dr", "D1mr", "D2mr", "DLmr");
+	CLG_(register_event_group4)(EG_DW, "Dw", "D1mw", "D2mw", "DLmw");
+    }
     else if (!clo_simulate_writeback) {
 	CLG_(register_event_group3)(EG_IR, "Ir", "I1mr", "ILmr");
 	CLG_(register_event_group3)(EG_DR, "Dr", "D1mr", "DLmr");
@@ -1731,6 +1999,9 @@ void CLG_(init_eventsets)()
     CLG_(append_event)(CLG_(dumpmap), "I1mr");
     CLG_(append_event)(CLG_(dumpmap), "D1mr");
     CLG_(append_event)(CLG_(dumpmap), "D1mw");
+    CLG_(append_event)(CLG_(dumpmap), "I2mr");
+    CLG_(append_event)(CLG_(dumpmap), "D2mr");
+    CLG_(append_event)(CLG_(dumpmap), "D2mw");
     CLG_(append_event)(CLG_(dumpmap), "ILmr");
     CLG_(append_event)(CLG_(dumpmap), "DLmr");
     CLG_(append_event)(CLG_(dumpmap), "DLmw");
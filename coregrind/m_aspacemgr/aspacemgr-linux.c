@@ -267,41 +267,80 @@
 
 /* ------ start of STATE for the address-space manager ------ */
 
-/* Max number of segments we can track.  On Android, virtual address
-   space is limited, so keep a low limit -- 5000 x sizef(NSegment) is
-   360KB. */
+/* The segment array and the filename table live in a single
+   mapping, made at startup (init_segment_tables) with MAP_NORESERVE.
+   It has room for the limits below, but only the pages actually used
+   take up memory, so the limits can be generous.  On Android, virtual
+   address space is limited, so keep them lower. */
+
+/* Max number of segments we can track. */
 #if defined(VGPV_arm_linux_android) || defined(VGPV_x86_linux_android)
-# define VG_N_SEGMENTS 5000
+# define VG_N_SEGMENTS 20000
+#elif VG_WORDSIZE == 4
+# define VG_N_SEGMENTS 100000
 #else
-# define VG_N_SEGMENTS 30000
+# define VG_N_SEGMENTS 1000000
 #endif
 
-/* Max number of segment file names we can track.  These are big (1002
-   bytes) so on Android limit the space usage to ~1MB. */
+/* Max number of segment file names we can track, the number of hash
+   chains for finding them (a power of 2), and the space for the names
+   themselves. */
 #if defined(VGPV_arm_linux_android) || defined(VGPV_x86_linux_android)
-# define VG_N_SEGNAMES 1000
+# define VG_N_SEGNAMES      5000
+# define N_SEGNAME_CHAINS   1024
+# define SEGNAME_CHARS_SZB  (1024 * 1024)
+#elif VG_WORDSIZE == 4
+# define VG_N_SEGNAMES      50000
+# define N_SEGNAME_CHAINS   8192
+# define SEGNAME_CHARS_SZB  (8 * 1024 * 1024)
 #else
-# define VG_N_SEGNAMES 6000
+# define VG_N_SEGNAMES      250000
+# define N_SEGNAME_CHAINS   65536
+# define SEGNAME_CHARS_SZB  (32 * 1024 * 1024)
 #endif
 
 /* Max length of a segment file name. */
-#define VG_MAX_SEGNAMELEN 1000
+#define VG_MAX_SEGNAMELEN 4096
+
+/* Size of the buffer used to read /proc/self/maps: enough for a full
+   segment table of lines without file names. */
+#define M_PROCMAP_BUF (VG_N_SEGMENTS * 80)
 
 
 typedef
    struct {
       Bool  inUse;
       Bool  mark;
-      HChar fname[VG_MAX_SEGNAMELEN];
+      Int   next;     // in the hash chain if inUse, else in the free list
+      UInt  off;      // the name is at segname_chars[off ..]
+      UInt  cap;      // .. and has room for cap bytes
    }
    SegName;
 
 /* Filename table.  _used is the high water mark; an entry is only
    valid if its index >= 0, < _used, and its .inUse field == True.
-   The .mark field is used to garbage-collect dead entries.
+   Entries which are in use are hashed on their name into
+   segname_chains[], which holds index+1 of the first entry of each
+   chain, or 0.  Entries which are not are chained from
+   segnames_free.  The .mark field is used to garbage-collect dead
+   entries, which happens in allocate_segname when it runs out of free
+   ones.
+
+   The names themselves are bump-allocated in one half of
+   segname_chars_space; when that is full, the live ones are copied to
+   the start of the other half.
 */
-static SegName segnames[VG_N_SEGNAMES];
-static Int     segnames_used = 0;
+static SegName* segnames;
+static Int      segnames_used  = 0;
+static Int      segnames_free  = -1;
+static Int      segnames_gc_at = 100;
+static Int*     segname_chains;
+static HChar*   segname_chars_space;   // 2 * SEGNAME_CHARS_SZB
+static HChar*   segname_chars;         // the half in use
+static UInt     segname_chars_used = 0;
+
+/* For reading /proc/self/maps. */
+static HChar*   procmap_buf;           // [M_PROCMAP_BUF]
 
 
 /* Array [0 .. nsegments_used-1] of all mappings. */
@@ -311,8 +350,18 @@ static Int     segnames_used = 0;
 /* I: the segments cover the entire address space precisely. */
 /* Each segment can optionally hold an index into the filename table. */
 
-static NSegment nsegments[VG_N_SEGMENTS];
-static Int      nsegments_used = 0;
+/* The array is kept as a gap buffer: segment i is at nsegments[i] if
+   i < nsegments_gap, else at nsegments[i + (VG_N_SEGMENTS -
+   nsegments_used)], and the slots in between are unused.  Inserting
+   or removing segments moves the gap to where that happens, which
+   costs nothing like a slide of the whole array when successive
+   changes are close together, as mmaps of stacks, heaps and JIT code
+   tend to be.  Always get at segment i with SEG(i). */
+static NSegment* nsegments;      // [VG_N_SEGMENTS]
+static Int       nsegments_used = 0;
+static Int       nsegments_gap  = 0;
+
+#define SEG(i) (*seg_at(i))
 
 #define Addr_MIN ((Addr)0)
 #define Addr_MAX ((Addr)(-1ULL))
@@ -331,6 +380,21 @@ Addr VG_(clo_aspacem_minAddr)
    = (Addr) 0x04000000; // 64M
 #endif
 
+/* Whether to back large mappings for V with huge pages. */
+VgHugePages VG_(clo_huge_pages) = Vg_HugePagesNo;
+
+/* The huge page size assumed for --huge-pages.  2MB is right for
+   x86, amd64 and arm64 with 4K pages; elsewhere alignment to it does
+   no harm, and the kernel uses whatever size it has. */
+#define HUGE_PAGE_SZB (2 * 1024 * 1024)
+
+/* For --huge-pages: bytes requested in mappings big enough to
+   qualify, and bytes of those mapped with MAP_HUGETLB, and advised
+   with MADV_HUGEPAGE. */
+static ULong huge_requested_szB = 0;
+static ULong huge_hugetlb_szB   = 0;
+static ULong huge_advised_szB   = 0;
+
 
 // The smallest address that aspacem will try to allocate
 static Addr aspacem_minAddr = 0;
@@ -352,6 +416,16 @@ static Addr aspacem_vStart = 0;
             (__PRETTY_FUNCTION__,__FILE__,__LINE__));        \
    } while (0) 
 
+/* As AM_SANITY_CHECK, but only for the part of the address space that
+   an operation on [_start, _start+_len) can have changed. */
+#define AM_SANITY_CHECK_RANGE(_start,_len)                   \
+   do {                                                      \
+      if (VG_(clo_sanity_level >= 3))                        \
+         aspacem_assert(do_sync_check_range                  \
+            (__PRETTY_FUNCTION__,__FILE__,__LINE__,          \
+             (_start), (_start) + (_len) - 1));              \
+   } while (0)
+
 /* ------ end of STATE for the address-space manager ------ */
 
 /* ------ Forwards decls ------ */
@@ -362,7 +436,8 @@ static void parse_procselfmaps (
       void (*record_mapping)( Addr addr, SizeT len, UInt prot,
                               ULong dev, ULong ino, Off64T offset, 
                               const HChar* filename ),
-      void (*record_gap)( Addr addr, SizeT len )
+      void (*record_gap)( Addr addr, SizeT len ),
+      Addr lo, Addr hi
    );
 
 /* ----- Hacks to do with the "commpage" on arm-linux ----- */
@@ -388,6 +463,147 @@ static void parse_procselfmaps (
 /*---                                                           ---*/
 /*-----------------------------------------------------------------*/
 
+/* Make the mapping which holds the segment array and the filename
+   table.  This has to be done before anything is put in either. */
+static void init_segment_tables ( void )
+{
+   SizeT  segs_szB   = VG_PGROUNDUP(VG_N_SEGMENTS * sizeof(NSegment));
+   SizeT  names_szB  = VG_PGROUNDUP(VG_N_SEGNAMES * sizeof(SegName));
+   SizeT  chains_szB = VG_PGROUNDUP(N_SEGNAME_CHAINS * sizeof(Int));
+   SizeT  chars_szB  = VG_PGROUNDUP(2 * SEGNAME_CHARS_SZB);
+   SizeT  maps_szB   = VG_PGROUNDUP(M_PROCMAP_BUF);
+   SysRes sres;
+   Addr   a;
+
+   sres = VG_(am_do_mmap_NO_NOTIFY)(
+             0, segs_szB + names_szB + chains_szB + chars_szB + maps_szB,
+             VKI_PROT_READ|VKI_PROT_WRITE,
+             VKI_MAP_PRIVATE|VKI_MAP_ANONYMOUS|VKI_MAP_NORESERVE, -1, 0
+          );
+   if (sr_isError(sres))
+      ML_(am_barf)("can't allocate the segment array");
+   a = sr_Res(sres);
+
+   /* Fresh anonymous memory is zeroed, which makes all the hash chains
+      empty. */
+   nsegments           = (NSegment*)a;  a += segs_szB;
+   segnames            = (SegName*)a;   a += names_szB;
+   segname_chains      = (Int*)a;       a += chains_szB;
+   segname_chars_space = (HChar*)a;  a += chars_szB;
+   segname_chars       = segname_chars_space;
+   procmap_buf         = (HChar*)a;
+}
+
+static inline NSegment* seg_at ( Int i )
+{
+   return &nsegments[i < nsegments_gap
+                     ? i : i + (VG_N_SEGMENTS - nsegments_used)];
+}
+
+/* Move the gap in the segment array to just before segment k. */
+static void move_segment_gap ( Int k )
+{
+   Int gap_len = VG_N_SEGMENTS - nsegments_used;
+   aspacem_assert(0 <= k && k <= nsegments_used);
+   while (nsegments_gap > k) {
+      nsegments_gap--;
+      nsegments[nsegments_gap + gap_len] = nsegments[nsegments_gap];
+   }
+   while (nsegments_gap < k) {
+      nsegments[nsegments_gap] = nsegments[nsegments_gap + gap_len];
+      nsegments_gap++;
+   }
+}
+
+/* Make room for a new segment k, moving up segments k and above.
+   The new SEG(k) is uninitialised. */
+static void insert_segment_slot ( Int k )
+{
+   if (nsegments_used >= VG_N_SEGMENTS)
+      ML_(am_barf_toolow)("VG_N_SEGMENTS");
+   move_segment_gap(k);
+   nsegments_used++;
+   nsegments_gap++;
+}
+
+/* Remove segments k .. k+n-1, moving down the ones above. */
+static void remove_segment_slots ( Int k, Int n )
+{
+   aspacem_assert(n >= 0 && k + n <= nsegments_used);
+   move_segment_gap(k + n);
+   nsegments_gap   = k;
+   nsegments_used -= n;
+}
+
+static inline HChar* segname_str ( Int i )
+{
+   return &segname_chars[segnames[i].off];
+}
+
+static UInt segname_hash ( const HChar* name )
+{
+   UInt h = 0;
+   while (*name)
+      h = h * 31 + (UChar)*name++;
+   return h & (N_SEGNAME_CHAINS - 1);
+}
+
+/* Free the filename table entries no segment refers to any more. */
+static void gc_segnames ( void )
+{
+   Int i, j, *p;
+
+   for (i = 0; i < segnames_used; i++)
+      segnames[i].mark = False;
+   for (i = 0; i < nsegments_used; i++) {
+      j = SEG(i).fnIdx;
+      aspacem_assert(j >= -1 && j < segnames_used);
+      if (j >= 0) {
+         aspacem_assert(segnames[j].inUse);
+         segnames[j].mark = True;
+      }
+   }
+   for (i = 0; i < segnames_used; i++) {
+      if (!segnames[i].inUse || segnames[i].mark)
+         continue;
+      p = &segname_chains[segname_hash(segname_str(i))];
+      while (*p != i+1) {
+         aspacem_assert(*p != 0);
+         p = &segnames[*p-1].next;
+      }
+      *p = segnames[i].next;
+      segnames[i].inUse = False;
+      segnames[i].next  = segnames_free;
+      segnames_free = i;
+   }
+}
+
+/* Copy the names in use to the start of the other half of
+   segname_chars_space.  Free entries lose their space. */
+static void compact_segname_chars ( void )
+{
+   HChar* to = segname_chars == segname_chars_space
+                  ? segname_chars_space + SEGNAME_CHARS_SZB
+                  : segname_chars_space;
+   UInt   used = 0;
+   Int    i;
+
+   for (i = 0; i < segnames_used; i++) {
+      if (segnames[i].inUse) {
+         UInt len = VG_(strlen)(segname_str(i)) + 1;
+         VG_(memcpy)(&to[used], segname_str(i), len);
+         segnames[i].off = used;
+         segnames[i].cap = len;
+         used += len;
+      } else {
+         segnames[i].off = 0;
+         segnames[i].cap = 0;
+      }
+   }
+   segname_chars      = to;
+   segname_chars_used = used;
+}
+
 /* Searches the filename table to find an index for the given name.
    If none is found, an index is allocated and the name stored.  If no
    space is available we just give up.  If the string is too long to
@@ -395,7 +611,8 @@ static void parse_procselfmaps (
 */
 static Int allocate_segname ( const HChar* name )
 {
-   Int i, j, len;
+   Int  i, j, len;
+   UInt h;
 
    aspacem_assert(name);
 
@@ -407,35 +624,54 @@ static Int allocate_segname ( const HChar* name )
    }
 
    /* first see if we already have the name. */
-   for (i = 0; i < segnames_used; i++) {
-      if (!segnames[i].inUse)
-         continue;
-      if (0 == VG_(strcmp)(name, &segnames[i].fname[0])) {
-         return i;
+   h = segname_hash(name);
+   for (j = segname_chains[h]; j != 0; j = segnames[j-1].next) {
+      if (0 == VG_(strcmp)(name, segname_str(j-1))) {
+         return j-1;
       }
    }
 
-   /* no we don't.  So look for a free slot. */
-   for (i = 0; i < segnames_used; i++)
-      if (!segnames[i].inUse)
-         break;
+   /* no we don't.  So take a free entry, collecting the dead ones
+      first if the table has grown enough since the last time. */
+   if (segnames_free == -1 && segnames_used >= segnames_gc_at) {
+      Int n_live = 0;
+      gc_segnames();
+      for (i = 0; i < segnames_used; i++)
+         if (segnames[i].inUse)
+            n_live++;
+      segnames_gc_at = segnames_used + (n_live > 100 ? n_live : 100);
+   }
+   if (segnames_free != -1) {
+      i = segnames_free;
+      segnames_free = segnames[i].next;
+   } else if (segnames_used < VG_N_SEGNAMES) {
+      /* no free entries .. advance the high-water mark. */
+      i = segnames_used;
+      segnames_used++;
+      segnames[i].cap = 0;
+   } else {
+      ML_(am_barf_toolow)("VG_N_SEGNAMES");
+      i = -1; /*NOTREACHED*/
+   }
 
-   if (i == segnames_used) {
-      /* no free slots .. advance the high-water mark. */
-      if (segnames_used+1 < VG_N_SEGNAMES) {
-         i = segnames_used;
-         segnames_used++;
-      } else {
-         ML_(am_barf_toolow)("VG_N_SEGNAMES");
-      }
+   /* find room for the name, if its entry does not have enough */
+   if (segnames[i].cap < len + 1) {
+      segnames[i].inUse = False;
+      segnames[i].cap   = 0;
+      if (segname_chars_used + len + 1 > SEGNAME_CHARS_SZB)
+         compact_segname_chars();
+      if (segname_chars_used + len + 1 > SEGNAME_CHARS_SZB)
+         ML_(am_barf_toolow)("SEGNAME_CHARS_SZB");
+      segnames[i].off = segname_chars_used;
+      segnames[i].cap = len + 1;
+      segname_chars_used += len + 1;
    }
 
    /* copy it in */
    segnames[i].inUse = True;
-   for (j = 0; j < len; j++)
-      segnames[i].fname[j] = name[j];
-   aspacem_assert(len < VG_MAX_SEGNAMELEN);
-   segnames[i].fname[len] = 0;
+   VG_(memcpy)(segname_str(i), name, len + 1);
+   segnames[i].next = segname_chains[h];
+   segname_chains[h] = i+1;
    return i;
 }
 
@@ -508,8 +744,8 @@ static void __attribute__ ((unused))
 
    if (seg->fnIdx >= 0 && seg->fnIdx < segnames_used
                        && segnames[seg->fnIdx].inUse
-                       && segnames[seg->fnIdx].fname[0] != 0)
-      name = segnames[seg->fnIdx].fname;
+                       && segname_str(seg->fnIdx)[0] != 0)
+      name = segname_str(seg->fnIdx);
 
    show_len_concisely(len_buf, seg->start, seg->end);
 
@@ -607,10 +843,10 @@ void VG_(am_show_nsegments) ( Int logLevel, const HChar* who )
       if (!segnames[i].inUse)
          continue;
       VG_(debugLog)(logLevel, "aspacem",
-                    "(%2d) %s\n", i, segnames[i].fname);
+                    "(%2d) %s\n", i, segname_str(i));
    }
    for (i = 0; i < nsegments_used; i++)
-     show_nsegment( logLevel, i, &nsegments[i] );
+     show_nsegment( logLevel, i, &SEG(i) );
    VG_(debugLog)(logLevel, "aspacem",
                  ">>>\n");
 }
@@ -628,7 +864,7 @@ HChar* VG_(am_get_filename)( NSegment const * seg )
    if (i < 0 || i >= segnames_used || !segnames[i].inUse)
       return NULL;
    else
-      return &segnames[i].fname[0];
+      return segname_str(i);
 }
 
 /* Collect up the start addresses of all non-free, non-resvn segments.
@@ -654,7 +890,7 @@ Int VG_(am_get_segment_starts)( Addr* starts, Int nStarts )
 
    nSegs = 0;
    for (i = 0; i < nsegments_used; i++) {
-      if (nsegments[i].kind == SkFree || nsegments[i].kind == SkResvn)
+      if (SEG(i).kind == SkFree || SEG(i).kind == SkResvn)
          continue;
       nSegs++;
    }
@@ -670,9 +906,9 @@ Int VG_(am_get_segment_starts)( Addr* starts, Int nStarts )
 
    j = 0;
    for (i = 0; i < nsegments_used; i++) {
-      if (nsegments[i].kind == SkFree || nsegments[i].kind == SkResvn)
+      if (SEG(i).kind == SkFree || SEG(i).kind == SkResvn)
          continue;
-      starts[j] = nsegments[i].start;
+      starts[j] = SEG(i).start;
       j++;
    }
 
@@ -762,7 +998,8 @@ static Bool maybe_merge_nsegments ( NSegment* s1, NSegment* s2 )
 
       case SkAnonC: case SkAnonV:
          if (s1->hasR == s2->hasR && s1->hasW == s2->hasW 
-             && s1->hasX == s2->hasX && s1->isCH == s2->isCH) {
+             && s1->hasX == s2->hasX && s1->isCH == s2->isCH
+             && s1->isShared == s2->isShared) {
             s1->end = s2->end;
             s1->hasT |= s2->hasT;
             return True;
@@ -804,58 +1041,71 @@ static Bool maybe_merge_nsegments ( NSegment* s1, NSegment* s2 )
 
 static Bool preen_nsegments ( void )
 {
-   Int i, j, r, w, nsegments_used_old = nsegments_used;
+   Int i, r, w, nsegments_used_old = nsegments_used;
 
    /* Pass 1: check the segment array covers the entire address space
       exactly once, and also that each segment is sane. */
    aspacem_assert(nsegments_used > 0);
-   aspacem_assert(nsegments[0].start == Addr_MIN);
-   aspacem_assert(nsegments[nsegments_used-1].end == Addr_MAX);
+   aspacem_assert(SEG(0).start == Addr_MIN);
+   aspacem_assert(SEG(nsegments_used-1).end == Addr_MAX);
 
-   aspacem_assert(sane_NSegment(&nsegments[0]));
+   aspacem_assert(sane_NSegment(&SEG(0)));
    for (i = 1; i < nsegments_used; i++) {
-      aspacem_assert(sane_NSegment(&nsegments[i]));
-      aspacem_assert(nsegments[i-1].end+1 == nsegments[i].start);
+      aspacem_assert(sane_NSegment(&SEG(i)));
+      aspacem_assert(SEG(i-1).end+1 == SEG(i).start);
    }
 
    /* Pass 2: merge as much as possible, using
       maybe_merge_segments. */
    w = 0;
    for (r = 1; r < nsegments_used; r++) {
-      if (maybe_merge_nsegments(&nsegments[w], &nsegments[r])) {
+      if (maybe_merge_nsegments(&SEG(w), &SEG(r))) {
          /* nothing */
       } else {
          w++;
          if (w != r) 
-            nsegments[w] = nsegments[r];
+            SEG(w) = SEG(r);
       }
    }
    w++;
    aspacem_assert(w > 0 && w <= nsegments_used);
-   nsegments_used = w;
+   remove_segment_slots(w, nsegments_used - w);
 
-   /* Pass 3: free up unused string table slots */
-   /* clear mark bits */
-   for (i = 0; i < segnames_used; i++)
-      segnames[i].mark = False;
-   /* mark */
-   for (i = 0; i < nsegments_used; i++) {
-     j = nsegments[i].fnIdx;
-      aspacem_assert(j >= -1 && j < segnames_used);
-      if (j >= 0) {
-         aspacem_assert(segnames[j].inUse);
-         segnames[j].mark = True;
-      }
-   }
-   /* release */
-   for (i = 0; i < segnames_used; i++) {
-      if (segnames[i].mark == False) {
-         segnames[i].inUse = False;
-         segnames[i].fname[0] = 0;
+   return nsegments_used != nsegments_used_old;
+}
+
+
+/* Do what preen_nsegments does, after only segments iLo .. iHi have
+   been changed.  As the rest of the array is already canonical, only
+   those and their immediate neighbours need to be looked at, which
+   matters when there are many segments.  At --sanity-level=3 and
+   above, the whole array is checked as well. */
+
+static void preen_nsegments_around ( Int iLo, Int iHi )
+{
+   Int lo, hi, r, w;
+
+   aspacem_assert(0 <= iLo && iLo <= iHi && iHi < nsegments_used);
+   lo = iLo > 0 ? iLo-1 : 0;
+   hi = iHi < nsegments_used-1 ? iHi+1 : nsegments_used-1;
+
+   aspacem_assert(sane_NSegment(&SEG(lo)));
+   w = lo;
+   for (r = lo+1; r <= hi; r++) {
+      aspacem_assert(sane_NSegment(&SEG(r)));
+      aspacem_assert(SEG(r-1).end+1 == SEG(r).start);
+      if (maybe_merge_nsegments(&SEG(w), &SEG(r))) {
+         /* nothing */
+      } else {
+         w++;
+         if (w != r)
+            SEG(w) = SEG(r);
       }
    }
+   remove_segment_slots(w+1, hi - w);
 
-   return nsegments_used != nsegments_used_old;
+   if (VG_(clo_sanity_level) >= 3)
+      (void)preen_nsegments();
 }
 
 
@@ -887,6 +1137,23 @@ static Bool preen_nsegments ( void )
 
 static Bool sync_check_ok = False;
 
+/* parse_procselfmaps presents mappings and gaps in address order, so
+   the segment holding the next one is almost always at or just after
+   the last one looked at.  Look there before doing a full search. */
+static Int sync_check_hint = 0;
+
+static Int sync_check_find_idx ( Addr a )
+{
+   Int i, k;
+   for (i = sync_check_hint, k = 0; i < nsegments_used && k < 4; i++, k++) {
+      if (a < SEG(i).start)
+         break;
+      if (a <= SEG(i).end)
+         return i;
+   }
+   return find_nsegment_idx( a );
+}
+
 static void sync_check_mapping_callback ( Addr addr, SizeT len, UInt prot,
                                           ULong dev, ULong ino, Off64T offset, 
                                           const HChar* filename )
@@ -908,15 +1175,17 @@ static void sync_check_mapping_callback ( Addr addr, SizeT len, UInt prot,
    /* The kernel should not give us wraparounds. */
    aspacem_assert(addr <= addr + len - 1); 
 
-   iLo = find_nsegment_idx( addr );
-   iHi = find_nsegment_idx( addr + len - 1 );
+   iLo = sync_check_find_idx( addr );
+   sync_check_hint = iLo;
+   iHi = sync_check_find_idx( addr + len - 1 );
+   sync_check_hint = iHi;
 
    /* These 5 should be guaranteed by find_nsegment_idx. */
    aspacem_assert(0 <= iLo && iLo < nsegments_used);
    aspacem_assert(0 <= iHi && iHi < nsegments_used);
    aspacem_assert(iLo <= iHi);
-   aspacem_assert(nsegments[iLo].start <= addr );
-   aspacem_assert(nsegments[iHi].end   >= addr + len - 1 );
+   aspacem_assert(SEG(iLo).start <= addr );
+   aspacem_assert(SEG(iHi).end   >= addr + len - 1 );
 
    /* x86 doesn't differentiate 'x' and 'r' (at least, all except the
       most recent NX-bit enabled CPUs) and so recent kernels attempt
@@ -944,22 +1213,22 @@ static void sync_check_mapping_callback ( Addr addr, SizeT len, UInt prot,
       UInt seg_prot;
    
       /* compare the kernel's offering against ours. */
-      same = nsegments[i].kind == SkAnonC
-             || nsegments[i].kind == SkAnonV
-             || nsegments[i].kind == SkFileC
-             || nsegments[i].kind == SkFileV
-             || nsegments[i].kind == SkShmC;
+      same = SEG(i).kind == SkAnonC
+             || SEG(i).kind == SkAnonV
+             || SEG(i).kind == SkFileC
+             || SEG(i).kind == SkFileV
+             || SEG(i).kind == SkShmC;
 
       seg_prot = 0;
-      if (nsegments[i].hasR) seg_prot |= VKI_PROT_READ;
-      if (nsegments[i].hasW) seg_prot |= VKI_PROT_WRITE;
-      if (nsegments[i].hasX) seg_prot |= VKI_PROT_EXEC;
+      if (SEG(i).hasR) seg_prot |= VKI_PROT_READ;
+      if (SEG(i).hasW) seg_prot |= VKI_PROT_WRITE;
+      if (SEG(i).hasX) seg_prot |= VKI_PROT_EXEC;
 
       cmp_offsets
-         = nsegments[i].kind == SkFileC || nsegments[i].kind == SkFileV;
+         = SEG(i).kind == SkFileC || SEG(i).kind == SkFileV;
 
       cmp_devino
-         = nsegments[i].dev != 0 || nsegments[i].ino != 0;
+         = SEG(i).dev != 0 || SEG(i).ino != 0;
 
       /* Consider other reasons to not compare dev/inode */
 #if defined(VGO_linux)
@@ -990,13 +1259,22 @@ static void sync_check_mapping_callback ( Addr addr, SizeT len, UInt prot,
          seg_prot |= VKI_PROT_EXEC;
       }
 
+      /* With --smc-check=protect, client pages containing code may
+         have been write-protected behind our back (see
+         VG_(smc_protect)). */
+      if (VG_(clo_smc_check) == Vg_SmcProtect
+          && (prot & VKI_PROT_WRITE) == 0
+          && SEG(i).kind == SkAnonC && !SEG(i).isShared) {
+         seg_prot &= ~VKI_PROT_WRITE;
+      }
+
       same = same
              && seg_prot == prot
              && (cmp_devino
-                   ? (nsegments[i].dev == dev && nsegments[i].ino == ino)
+                   ? (SEG(i).dev == dev && SEG(i).ino == ino)
                    : True)
              && (cmp_offsets 
-                   ? nsegments[i].start-nsegments[i].offset == addr-offset
+                   ? SEG(i).start-SEG(i).offset == addr-offset
                    : True);
       if (!same) {
          Addr start = addr;
@@ -1009,7 +1287,7 @@ static void sync_check_mapping_callback ( Addr addr, SizeT len, UInt prot,
          VG_(debugLog)(
             0,"aspacem",
               "segment mismatch: V's seg 1st, kernel's 2nd:\n");
-         show_nsegment_full( 0, i, &nsegments[i] );
+         show_nsegment_full( 0, i, &SEG(i) );
          VG_(debugLog)(0,"aspacem", 
             "...: .... %010llx-%010llx %s %c%c%c.. ....... "
             "d=0x%03llx i=%-7lld o=%-7lld (.) m=. %s\n",
@@ -1045,15 +1323,17 @@ static void sync_check_gap_callback ( Addr addr, SizeT len )
    /* The kernel should not give us wraparounds. */
    aspacem_assert(addr <= addr + len - 1); 
 
-   iLo = find_nsegment_idx( addr );
-   iHi = find_nsegment_idx( addr + len - 1 );
+   iLo = sync_check_find_idx( addr );
+   sync_check_hint = iLo;
+   iHi = sync_check_find_idx( addr + len - 1 );
+   sync_check_hint = iHi;
 
    /* These 5 should be guaranteed by find_nsegment_idx. */
    aspacem_assert(0 <= iLo && iLo < nsegments_used);
    aspacem_assert(0 <= iHi && iHi < nsegments_used);
    aspacem_assert(iLo <= iHi);
-   aspacem_assert(nsegments[iLo].start <= addr );
-   aspacem_assert(nsegments[iHi].end   >= addr + len - 1 );
+   aspacem_assert(SEG(iLo).start <= addr );
+   aspacem_assert(SEG(iHi).end   >= addr + len - 1 );
 
    /* NSegments iLo .. iHi inclusive should agree with the presented
       data. */
@@ -1062,8 +1342,8 @@ static void sync_check_gap_callback ( Addr addr, SizeT len )
       Bool same;
    
       /* compare the kernel's offering against ours. */
-      same = nsegments[i].kind == SkFree
-             || nsegments[i].kind == SkResvn;
+      same = SEG(i).kind == SkFree
+             || SEG(i).kind == SkResvn;
 
       if (!same) {
          Addr start = addr;
@@ -1076,7 +1356,7 @@ static void sync_check_gap_callback ( Addr addr, SizeT len )
          VG_(debugLog)(
             0,"aspacem",
               "segment mismatch: V's gap 1st, kernel's 2nd:\n");
-         show_nsegment_full( 0, i, &nsegments[i] );
+         show_nsegment_full( 0, i, &SEG(i) );
          VG_(debugLog)(0,"aspacem", 
             "   : .... %010llx-%010llx %s\n",
             (ULong)start, (ULong)end, len_buf);
@@ -1094,14 +1374,23 @@ static void sync_check_gap_callback ( Addr addr, SizeT len )
    a discrepancy is detected, but does not abort the system.  Returned
    Bool is False if a discrepancy was found. */
 
-Bool VG_(am_do_sync_check) ( const HChar* fn, 
-                             const HChar* file, Int line )
+/* Sync check limited to the mappings and gaps that overlap [lo, hi].
+   Used after mmap, mprotect, munmap and the like, which cannot have
+   changed anything outside the range they were given.  With a large
+   number of mappings, this saves most of the work of a full check,
+   since parse_procselfmaps only has to look at the addresses of the
+   lines outside the range. */
+
+static Bool do_sync_check_range ( const HChar* fn, 
+                                  const HChar* file, Int line,
+                                  Addr lo, Addr hi )
 {
    sync_check_ok = True;
+   sync_check_hint = 0;
    if (0)
       VG_(debugLog)(0,"aspacem", "do_sync_check %s:%d\n", file,line);
    parse_procselfmaps( sync_check_mapping_callback,
-                       sync_check_gap_callback );
+                       sync_check_gap_callback, lo, hi );
    if (!sync_check_ok) {
       VG_(debugLog)(0,"aspacem", 
                       "sync check at %s:%d (%s): FAILED\n",
@@ -1121,6 +1410,12 @@ Bool VG_(am_do_sync_check) ( const HChar* fn,
    return sync_check_ok;
 }
 
+Bool VG_(am_do_sync_check) ( const HChar* fn, 
+                             const HChar* file, Int line )
+{
+   return do_sync_check_range( fn, file, line, Addr_MIN, Addr_MAX );
+}
+
 /* Hook to allow sanity checks to be done from aspacemgr-common.c. */
 void ML_(am_do_sanity_check)( void )
 {
@@ -1160,8 +1455,8 @@ static Int find_nsegment_idx_WRK ( Addr a )
          ML_(am_barf)("find_nsegment_idx: not found");
       }
       mid      = (lo + hi) / 2;
-      a_mid_lo = nsegments[mid].start;
-      a_mid_hi = nsegments[mid].end;
+      a_mid_lo = SEG(mid).start;
+      a_mid_hi = SEG(mid).end;
 
       if (a < a_mid_lo) { hi = mid-1; continue; }
       if (a > a_mid_hi) { lo = mid+1; continue; }
@@ -1182,6 +1477,7 @@ inline static Int find_nsegment_idx ( Addr a )
    static UWord n_m = 0;
 
    UWord ix;
+   Int   idx;
 
    if (LIKELY(cache_inited)) {
       /* do nothing */
@@ -1199,20 +1495,26 @@ inline static Int find_nsegment_idx ( Addr a )
    if (0 && 0 == (n_q & 0xFFFF))
       VG_(debugLog)(0,"xxx","find_nsegment_idx: %lu %lu\n", n_q, n_m);
 
+   /* Read the cached index only once, and return what was checked:
+      read-only queries may come from several host threads at once
+      (see VG_(run_workers)), which can update the cache under our
+      feet.  A stale entry then merely fails the check. */
+   idx = cache_segidx[ix];
    if ((a >> 12) == cache_pageno[ix]
-       && cache_segidx[ix] >= 0
-       && cache_segidx[ix] < nsegments_used
-       && nsegments[cache_segidx[ix]].start <= a
-       && a <= nsegments[cache_segidx[ix]].end) {
+       && idx >= 0
+       && idx < nsegments_used
+       && SEG(idx).start <= a
+       && a <= SEG(idx).end) {
       /* hit */
-      /* aspacem_assert( cache_segidx[ix] == find_nsegment_idx_WRK(a) ); */
-      return cache_segidx[ix];
+      /* aspacem_assert( idx == find_nsegment_idx_WRK(a) ); */
+      return idx;
    }
    /* miss */
    n_m++;
-   cache_segidx[ix] = find_nsegment_idx_WRK(a);
+   idx = find_nsegment_idx_WRK(a);
+   cache_segidx[ix] = idx;
    cache_pageno[ix] = a >> 12;
-   return cache_segidx[ix];
+   return idx;
 #  undef N_CACHE
 }
 
@@ -1225,12 +1527,12 @@ NSegment const * VG_(am_find_nsegment) ( Addr a )
 {
    Int i = find_nsegment_idx(a);
    aspacem_assert(i >= 0 && i < nsegments_used);
-   aspacem_assert(nsegments[i].start <= a);
-   aspacem_assert(a <= nsegments[i].end);
-   if (nsegments[i].kind == SkFree) 
+   aspacem_assert(SEG(i).start <= a);
+   aspacem_assert(a <= SEG(i).end);
+   if (SEG(i).kind == SkFree) 
       return NULL;
    else
-      return &nsegments[i];
+      return &SEG(i);
 }
 
 
@@ -1239,12 +1541,14 @@ NSegment const * VG_(am_find_nsegment) ( Addr a )
 static Int segAddr_to_index ( const NSegment* seg )
 {
    Int i;
-   if (seg < &nsegments[0] || seg >= &nsegments[nsegments_used])
+   if (seg < &nsegments[0] || seg >= &nsegments[VG_N_SEGMENTS])
       return -1;
    i = ((const UChar*)seg - (const UChar*)(&nsegments[0])) / sizeof(NSegment);
+   if (i >= nsegments_gap)
+      i -= VG_N_SEGMENTS - nsegments_used;
    if (i < 0 || i >= nsegments_used)
       return -1;
-   if (seg == &nsegments[i])
+   if (seg == &SEG(i))
       return i;
    return -1;
 }
@@ -1266,10 +1570,10 @@ NSegment const * VG_(am_next_nsegment) ( const NSegment* here, Bool fwds )
       if (i < 0)
          return NULL;
    }
-   switch (nsegments[i].kind) {
+   switch (SEG(i).kind) {
       case SkFileC: case SkFileV: case SkShmC:
       case SkAnonC: case SkAnonV: case SkResvn:
-         return &nsegments[i];
+         return &SEG(i);
       default:
          break;
    }
@@ -1285,9 +1589,9 @@ ULong VG_(am_get_anonsize_total)( void )
    Int   i;
    ULong total = 0;
    for (i = 0; i < nsegments_used; i++) {
-      if (nsegments[i].kind == SkAnonC || nsegments[i].kind == SkAnonV) {
-         total += (ULong)nsegments[i].end 
-                  - (ULong)nsegments[i].start + 1ULL;
+      if (SEG(i).kind == SkAnonC || SEG(i).kind == SkAnonV) {
+         total += (ULong)SEG(i).end 
+                  - (ULong)SEG(i).start + 1ULL;
       }
    }
    return total;
@@ -1314,9 +1618,9 @@ Bool is_valid_for( Bool client, Addr start, SizeT len, UInt prot, Bool freeOk )
    needX = toBool(prot & VKI_PROT_EXEC);
 
    iLo = find_nsegment_idx(start);
-   aspacem_assert(start >= nsegments[iLo].start);
+   aspacem_assert(start >= SEG(iLo).start);
 
-   if (start+len-1 <= nsegments[iLo].end) {
+   if (start+len-1 <= SEG(iLo).end) {
       /* This is a speedup hack which avoids calling find_nsegment_idx
          a second time when possible.  It is always correct to just
          use the "else" clause below, but is_valid_for_client is
@@ -1329,14 +1633,14 @@ Bool is_valid_for( Bool client, Addr start, SizeT len, UInt prot, Bool freeOk )
 
    if (client) {
       for (i = iLo; i <= iHi; i++) {
-         if ( (nsegments[i].kind == SkFileC 
-               || nsegments[i].kind == SkAnonC
-               || nsegments[i].kind == SkShmC
-               || (nsegments[i].kind == SkFree  && freeOk)
-               || (nsegments[i].kind == SkResvn && freeOk))
-              && (needR ? nsegments[i].hasR : True)
-              && (needW ? nsegments[i].hasW : True)
-              && (needX ? nsegments[i].hasX : True) ) {
+         if ( (SEG(i).kind == SkFileC 
+               || SEG(i).kind == SkAnonC
+               || SEG(i).kind == SkShmC
+               || (SEG(i).kind == SkFree  && freeOk)
+               || (SEG(i).kind == SkResvn && freeOk))
+              && (needR ? SEG(i).hasR : True)
+              && (needW ? SEG(i).hasW : True)
+              && (needX ? SEG(i).hasX : True) ) {
             /* ok */
          } else {
             return False;
@@ -1344,11 +1648,11 @@ Bool is_valid_for( Bool client, Addr start, SizeT len, UInt prot, Bool freeOk )
       }
    } else {
       for (i = iLo; i <= iHi; i++) {
-         if ( (nsegments[i].kind == SkFileV 
-               || nsegments[i].kind == SkAnonV)
-              && (needR ? nsegments[i].hasR : True)
-              && (needW ? nsegments[i].hasW : True)
-              && (needX ? nsegments[i].hasX : True) ) {
+         if ( (SEG(i).kind == SkFileV 
+               || SEG(i).kind == SkAnonV)
+              && (needR ? SEG(i).hasR : True)
+              && (needW ? SEG(i).hasW : True)
+              && (needX ? SEG(i).hasX : True) ) {
             /* ok */
          } else {
             return False;
@@ -1399,7 +1703,7 @@ static Bool any_Ts_in_range ( Addr start, SizeT len )
    iLo = find_nsegment_idx(start);
    iHi = find_nsegment_idx(start + len - 1);
    for (i = iLo; i <= iHi; i++) {
-      if (nsegments[i].hasT)
+      if (SEG(i).hasT)
          return True;
    }
    return False;
@@ -1418,7 +1722,7 @@ static Bool any_Ts_in_range ( Addr start, SizeT len )
 
 static void split_nsegment_at ( Addr a )
 {
-   Int i, j;
+   Int i;
 
    aspacem_assert(a > 0);
    aspacem_assert(VG_IS_PAGE_ALIGNED(a));
@@ -1426,28 +1730,24 @@ static void split_nsegment_at ( Addr a )
    i = find_nsegment_idx(a);
    aspacem_assert(i >= 0 && i < nsegments_used);
 
-   if (nsegments[i].start == a)
+   if (SEG(i).start == a)
       /* 'a' is already the start point of a segment, so nothing to be
          done. */
       return;
 
    /* else we have to slide the segments upwards to make a hole */
-   if (nsegments_used >= VG_N_SEGMENTS)
-      ML_(am_barf_toolow)("VG_N_SEGMENTS");
-   for (j = nsegments_used-1; j > i; j--)
-      nsegments[j+1] = nsegments[j];
-   nsegments_used++;
+   insert_segment_slot(i+1);
 
-   nsegments[i+1]       = nsegments[i];
-   nsegments[i+1].start = a;
-   nsegments[i].end     = a-1;
+   SEG(i+1)       = SEG(i);
+   SEG(i+1).start = a;
+   SEG(i).end     = a-1;
 
-   if (nsegments[i].kind == SkFileV || nsegments[i].kind == SkFileC)
-      nsegments[i+1].offset 
-         += ((ULong)nsegments[i+1].start) - ((ULong)nsegments[i].start);
+   if (SEG(i).kind == SkFileV || SEG(i).kind == SkFileC)
+      SEG(i+1).offset 
+         += ((ULong)SEG(i+1).start) - ((ULong)SEG(i).start);
 
-   aspacem_assert(sane_NSegment(&nsegments[i]));
-   aspacem_assert(sane_NSegment(&nsegments[i+1]));
+   aspacem_assert(sane_NSegment(&SEG(i)));
+   aspacem_assert(sane_NSegment(&SEG(i+1)));
 }
 
 
@@ -1475,8 +1775,8 @@ void split_nsegments_lo_and_hi ( Addr sLo, Addr sHi,
    aspacem_assert(0 <= *iLo && *iLo < nsegments_used);
    aspacem_assert(0 <= *iHi && *iHi < nsegments_used);
    aspacem_assert(*iLo <= *iHi);
-   aspacem_assert(nsegments[*iLo].start == sLo);
-   aspacem_assert(nsegments[*iHi].end == sHi);
+   aspacem_assert(SEG(*iLo).start == sLo);
+   aspacem_assert(SEG(*iHi).end == sHi);
    /* Not that I'm overly paranoid or anything, definitely not :-) */
 }
 
@@ -1487,7 +1787,7 @@ void split_nsegments_lo_and_hi ( Addr sLo, Addr sHi,
 
 static void add_segment ( NSegment* seg )
 {
-   Int  i, iLo, iHi, delta;
+   Int  iLo, iHi, delta;
    Bool segment_is_sane;
 
    Addr sStart = seg->start;
@@ -1508,15 +1808,11 @@ static void add_segment ( NSegment* seg )
       slide those above the range down to fill the hole. */
    delta = iHi - iLo;
    aspacem_assert(delta >= 0);
-   if (delta > 0) {
-      for (i = iLo; i < nsegments_used-delta; i++)
-         nsegments[i] = nsegments[i+delta];
-      nsegments_used -= delta;
-   }
+   remove_segment_slots(iLo+1, delta);
 
-   nsegments[iLo] = *seg;
+   SEG(iLo) = *seg;
 
-   (void)preen_nsegments();
+   preen_nsegments_around(iLo, iLo);
    if (0) VG_(am_show_nsegments)(0,"AFTER preen (add_segment)");
 }
 
@@ -1535,6 +1831,7 @@ static void init_nsegment ( /*OUT*/NSegment* seg )
    seg->offset   = 0;
    seg->fnIdx    = -1;
    seg->hasR = seg->hasW = seg->hasX = seg->hasT = seg->isCH = False;
+   seg->isShared = False;
    seg->mark = False;
 }
 
@@ -1627,6 +1924,8 @@ Addr VG_(am_startup) ( Addr sp_at_startup )
    aspacem_assert(sizeof(seg.offset) == 8);
    aspacem_assert(sizeof(seg.mode)   == 4);
 
+   init_segment_tables();
+
    /* Add a single interval covering the entire address space. */
    init_nsegment(&seg);
    seg.kind        = SkFree;
@@ -1634,6 +1933,7 @@ Addr VG_(am_startup) ( Addr sp_at_startup )
    seg.end         = Addr_MAX;
    nsegments[0]    = seg;
    nsegments_used  = 1;
+   nsegments_gap   = 1;
 
    aspacem_minAddr = VG_(clo_aspacem_minAddr);
 
@@ -1729,7 +2029,7 @@ Addr VG_(am_startup) ( Addr sp_at_startup )
    VG_(am_show_nsegments)(2, "Initial layout");
 
    VG_(debugLog)(2, "aspacem", "Reading /proc/self/maps\n");
-   parse_procselfmaps( read_maps_callback, NULL );
+   parse_procselfmaps( read_maps_callback, NULL, Addr_MIN, Addr_MAX );
    /* NB: on arm-linux, parse_procselfmaps automagically kludges up
       (iow, hands to its callbacks) a description of the ARM Commpage,
       since that's not listed in /proc/self/maps (kernel bug IMO).  We
@@ -1849,11 +2149,11 @@ Addr VG_(am_get_advisory) ( MapRequest*  req,
       Int  iHi   = find_nsegment_idx(reqEnd);
       Bool allow = True;
       for (i = iLo; i <= iHi; i++) {
-         if (nsegments[i].kind == SkFree
-             || nsegments[i].kind == SkFileC
-             || nsegments[i].kind == SkAnonC
-             || nsegments[i].kind == SkShmC
-             || nsegments[i].kind == SkResvn) {
+         if (SEG(i).kind == SkFree
+             || SEG(i).kind == SkFileC
+             || SEG(i).kind == SkAnonC
+             || SEG(i).kind == SkShmC
+             || SEG(i).kind == SkResvn) {
             /* ok */
          } else {
             allow = False;
@@ -1877,8 +2177,8 @@ Addr VG_(am_get_advisory) ( MapRequest*  req,
       Int  iHi   = find_nsegment_idx(reqEnd);
       Bool allow = True;
       for (i = iLo; i <= iHi; i++) {
-         if (nsegments[i].kind == SkFree
-             || nsegments[i].kind == SkResvn) {
+         if (SEG(i).kind == SkFree
+             || SEG(i).kind == SkResvn) {
             /* ok */
          } else {
             allow = False;
@@ -1905,14 +2205,14 @@ Addr VG_(am_get_advisory) ( MapRequest*  req,
       satisfy the request. */
    for (j = 0; j < nsegments_used; j++) {
 
-      if (nsegments[i].kind != SkFree) {
+      if (SEG(i).kind != SkFree) {
          i++;
          if (i >= nsegments_used) i = 0;
          continue;
       }
 
-      holeStart = nsegments[i].start;
-      holeEnd   = nsegments[i].end;
+      holeStart = SEG(i).start;
+      holeEnd   = SEG(i).end;
 
       /* Stay sane .. */
       aspacem_assert(holeStart <= holeEnd);
@@ -1938,11 +2238,11 @@ Addr VG_(am_get_advisory) ( MapRequest*  req,
 
    aspacem_assert(fixedIdx >= -1 && fixedIdx < nsegments_used);
    if (fixedIdx >= 0) 
-      aspacem_assert(nsegments[fixedIdx].kind == SkFree);
+      aspacem_assert(SEG(fixedIdx).kind == SkFree);
 
    aspacem_assert(floatIdx >= -1 && floatIdx < nsegments_used);
    if (floatIdx >= 0) 
-      aspacem_assert(nsegments[floatIdx].kind == SkFree);
+      aspacem_assert(SEG(floatIdx).kind == SkFree);
 
    AM_SANITY_CHECK;
 
@@ -1964,14 +2264,14 @@ Addr VG_(am_get_advisory) ( MapRequest*  req,
          }
          if (floatIdx >= 0) {
             *ok = True;
-            return nsegments[floatIdx].start;
+            return SEG(floatIdx).start;
          }
          *ok = False;
          return 0;
       case MAny:
          if (floatIdx >= 0) {
             *ok = True;
-            return nsegments[floatIdx].start;
+            return SEG(floatIdx).start;
          }
          *ok = False;
          return 0;
@@ -2005,10 +2305,10 @@ static NSegment const * VG_(am_find_free_nsegment) ( Addr a )
 {
    Int i = find_nsegment_idx(a);
    aspacem_assert(i >= 0 && i < nsegments_used);
-   aspacem_assert(nsegments[i].start <= a);
-   aspacem_assert(a <= nsegments[i].end);
-   if (nsegments[i].kind == SkFree) 
-      return &nsegments[i];
+   aspacem_assert(SEG(i).start <= a);
+   aspacem_assert(a <= SEG(i).end);
+   if (SEG(i).kind == SkFree) 
+      return &SEG(i);
    else
       return NULL;
 }
@@ -2053,6 +2353,7 @@ VG_(am_notify_client_mmap)( Addr a, SizeT len, UInt prot, UInt flags,
    seg.hasR   = toBool(prot & VKI_PROT_READ);
    seg.hasW   = toBool(prot & VKI_PROT_WRITE);
    seg.hasX   = toBool(prot & VKI_PROT_EXEC);
+   seg.isShared = toBool(flags & VKI_MAP_SHARED);
    if (!(flags & VKI_MAP_ANONYMOUS)) {
       // Nb: We ignore offset requests in anonymous mmaps (see bug #126722)
       seg.offset = offset;
@@ -2066,7 +2367,7 @@ VG_(am_notify_client_mmap)( Addr a, SizeT len, UInt prot, UInt flags,
       }
    }
    add_segment( &seg );
-   AM_SANITY_CHECK;
+   AM_SANITY_CHECK_RANGE(a, len);
    return needDiscard;
 }
 
@@ -2097,7 +2398,7 @@ VG_(am_notify_client_shmat)( Addr a, SizeT len, UInt prot )
    seg.hasW   = toBool(prot & VKI_PROT_WRITE);
    seg.hasX   = toBool(prot & VKI_PROT_EXEC);
    add_segment( &seg );
-   AM_SANITY_CHECK;
+   AM_SANITY_CHECK_RANGE(a, len);
    return needDiscard;
 }
 
@@ -2136,12 +2437,12 @@ Bool VG_(am_notify_mprotect)( Addr start, SizeT len, UInt prot )
 
    for (i = iLo; i <= iHi; i++) {
       /* Apply the permissions to all relevant segments. */
-      switch (nsegments[i].kind) {
+      switch (SEG(i).kind) {
          case SkAnonC: case SkAnonV: case SkFileC: case SkFileV: case SkShmC:
-            nsegments[i].hasR = newR;
-            nsegments[i].hasW = newW;
-            nsegments[i].hasX = newX;
-            aspacem_assert(sane_NSegment(&nsegments[i]));
+            SEG(i).hasR = newR;
+            SEG(i).hasW = newW;
+            SEG(i).hasX = newX;
+            aspacem_assert(sane_NSegment(&SEG(i)));
             break;
          default:
             break;
@@ -2150,8 +2451,8 @@ Bool VG_(am_notify_mprotect)( Addr start, SizeT len, UInt prot )
 
    /* Changing permissions could have made previously un-mergable
       segments mergeable.  Therefore have to re-preen them. */
-   (void)preen_nsegments();
-   AM_SANITY_CHECK;
+   preen_nsegments_around(iLo, iHi);
+   AM_SANITY_CHECK_RANGE(start, len);
    return needDiscard;
 }
 
@@ -2200,7 +2501,7 @@ Bool VG_(am_notify_munmap)( Addr start, SizeT len )
 
    /* Unmapping could create two adjacent free segments, so a preen is
       needed.  add_segment() will do that, so no need to here. */
-   AM_SANITY_CHECK;
+   AM_SANITY_CHECK_RANGE(start, len);
    return needDiscard;
 }
 
@@ -2411,6 +2712,34 @@ SysRes VG_(am_mmap_anon_float_client) ( SizeT length, Int prot )
 }
 
 
+/* Like VG_(am_mmap_anon_float_client), but with an inaccessible page
+   on each side, so that the client faults if it runs off either end.
+   Returns the start of the accessible part.  The whole thing, guard
+   pages included, is unmapped by VG_(am_munmap_client_guarded). */
+
+SysRes VG_(am_mmap_anon_float_client_guarded) ( SizeT length, Int prot )
+{
+   SysRes sres;
+   Addr   start;
+   Bool   need_discard;
+
+   length = VG_PGROUNDUP(length);
+   sres = VG_(am_mmap_anon_float_client)( length + 2 * VKI_PAGE_SIZE,
+                                          VKI_PROT_NONE );
+   if (sr_isError(sres))
+      return sres;
+   start = sr_Res(sres) + VKI_PAGE_SIZE;
+
+   sres = VG_(do_syscall3)( __NR_mprotect, start, length, prot );
+   if (sr_isError(sres)) {
+      (void)VG_(am_munmap_client_guarded)( &need_discard, start, length );
+      return sres;
+   }
+   VG_(am_notify_mprotect)( start, length, prot );
+   return VG_(mk_SysRes_Success)( start );
+}
+
+
 /* Map anonymously at an unconstrained address for V, and update the
    segment array accordingly.  This is fundamentally how V allocates
    itself more address space when needed. */
@@ -2422,18 +2751,29 @@ SysRes VG_(am_mmap_anon_float_valgrind)( SizeT length )
    Addr       advised;
    Bool       ok;
    MapRequest req;
+   Bool       huge = False;
+   Bool       hugetlb = False;
  
    /* Not allowable. */
    if (length == 0)
       return VG_(mk_SysRes_Error)( VKI_EINVAL );
 
-   /* Ask for an advisory.  If it's negative, fail immediately. */
+#if defined(VGO_linux) && !defined(ENABLE_INNER)
+   /* Huge pages are only any use for mappings at least that big, and
+      the mapping has to be aligned for them. */
+   huge = VG_(clo_huge_pages) != Vg_HugePagesNo && length >= HUGE_PAGE_SZB;
+#endif
+
+   /* Ask for an advisory.  If it's negative, fail immediately.  For a
+      huge mapping, ask for enough extra to be able to align it. */
    req.rkind = MAny;
    req.start = 0;
-   req.len   = length;
+   req.len   = huge ? length + HUGE_PAGE_SZB : length;
    advised = VG_(am_get_advisory)( &req, False/*forClient*/, &ok );
    if (!ok)
       return VG_(mk_SysRes_Error)( VKI_EINVAL );
+   if (huge)
+      advised = VG_ROUNDUP(advised, HUGE_PAGE_SZB);
 
 // On Darwin, for anonymous maps you can pass in a tag which is used by
 // programs like vmmap for statistical purposes.
@@ -2461,12 +2801,45 @@ SysRes VG_(am_mmap_anon_float_valgrind)( SizeT length )
       A proper solution implies a better collaboration between the
       inner and the outer (e.g. inner VG_(am_get_advisory) should do
       a client request to call the outer VG_(am_get_advisory). */
-   sres = VG_(am_do_mmap_NO_NOTIFY)( 
-             advised, length, 
-             VKI_PROT_READ|VKI_PROT_WRITE|VKI_PROT_EXEC, 
-             VKI_MAP_FIXED|VKI_MAP_PRIVATE|VKI_MAP_ANONYMOUS, 
-             VM_TAG_VALGRIND, 0
-          );
+   sres = VG_(mk_SysRes_Error)( VKI_EINVAL );
+#if defined(VGO_linux)
+   /* MAP_HUGETLB only works if the kernel has huge pages set aside,
+      and the mapping can then only be unmapped in whole huge pages,
+      so only try it for lengths which are a multiple of them. */
+   if (huge && VG_(clo_huge_pages) == Vg_HugePagesYes
+       && (length % HUGE_PAGE_SZB) == 0) {
+      sres = VG_(am_do_mmap_NO_NOTIFY)( 
+                advised, length, 
+                VKI_PROT_READ|VKI_PROT_WRITE|VKI_PROT_EXEC, 
+                VKI_MAP_FIXED|VKI_MAP_PRIVATE|VKI_MAP_ANONYMOUS
+                   |VKI_MAP_HUGETLB, 
+                VM_TAG_VALGRIND, 0
+             );
+      hugetlb = !sr_isError(sres);
+   }
+#endif
+   if (sr_isError(sres))
+      sres = VG_(am_do_mmap_NO_NOTIFY)( 
+                advised, length, 
+                VKI_PROT_READ|VKI_PROT_WRITE|VKI_PROT_EXEC, 
+                VKI_MAP_FIXED|VKI_MAP_PRIVATE|VKI_MAP_ANONYMOUS, 
+                VM_TAG_VALGRIND, 0
+             );
+#if defined(VGO_linux)
+   /* Otherwise, ask for transparent huge pages.  Failure (eg. a
+      kernel without them) doesn't matter. */
+   if (huge && !sr_isError(sres)) {
+      huge_requested_szB += length;
+      if (hugetlb) {
+         huge_hugetlb_szB += length;
+      } else {
+         SysRes mres = VG_(do_syscall3)( __NR_madvise, sr_Res(sres),
+                                         length, VKI_MADV_HUGEPAGE );
+         if (!sr_isError(mres))
+            huge_advised_szB += length;
+      }
+   }
+#endif
 #if defined(VGO_darwin) || defined(ENABLE_INNER)
    /* Kludge on Darwin and inner linux if the fixed mmap failed. */
    if (sr_isError(sres)) {
@@ -2516,6 +2889,174 @@ void* VG_(am_shadow_alloc)(SizeT size)
    return sr_isError(sres) ? NULL : (void*)sr_Res(sres);
 }
 
+SizeT VG_(am_huge_page_szB) ( void )
+{
+#if defined(VGO_linux) && !defined(ENABLE_INNER)
+   if (VG_(clo_huge_pages) != Vg_HugePagesNo)
+      return HUGE_PAGE_SZB;
+#endif
+   return 0;
+}
+
+
+/*-----------------------------------------------------------------*/
+/*---                                                           ---*/
+/*--- Flat shadow regions                                       ---*/
+/*---                                                           ---*/
+/*-----------------------------------------------------------------*/
+
+/* These are ordinary SkAnonV segments, except that they are mapped
+   with MAP_NORESERVE and without execute permission, so that
+   reserving many GB of them costs nothing until the tool writes to
+   them.  The kernel does the commit tracking: mincore says which
+   pages are backed, and madvise(MADV_DONTNEED) gives them back. */
+
+void* VG_(am_flat_shadow_reserve) ( SizeT length )
+{
+   SysRes     sres;
+   NSegment   seg;
+   Addr       advised;
+   Bool       ok;
+   MapRequest req;
+
+   length = VG_PGROUNDUP(length);
+   if (length == 0)
+      return NULL;
+
+   req.rkind = MAny;
+   req.start = 0;
+   req.len   = length;
+   advised = VG_(am_get_advisory)( &req, False/*forClient*/, &ok );
+   if (!ok)
+      return NULL;
+
+   sres = VG_(am_do_mmap_NO_NOTIFY)( 
+             advised, length, 
+             VKI_PROT_READ|VKI_PROT_WRITE, 
+             VKI_MAP_FIXED|VKI_MAP_PRIVATE|VKI_MAP_ANONYMOUS
+                |VKI_MAP_NORESERVE, 
+             VM_TAG_VALGRIND, 0
+          );
+   if (sr_isError(sres))
+      return NULL;
+   if (sr_Res(sres) != advised) {
+      (void)ML_(am_do_munmap_NO_NOTIFY)( sr_Res(sres), length );
+      return NULL;
+   }
+
+   init_nsegment( &seg );
+   seg.kind  = SkAnonV;
+   seg.start = sr_Res(sres);
+   seg.end   = seg.start + length - 1;
+   seg.hasR  = True;
+   seg.hasW  = True;
+   add_segment( &seg );
+
+   AM_SANITY_CHECK;
+   return (void*)sr_Res(sres);
+}
+
+Addr VG_(am_flat_shadow_span) ( void )
+{
+   return aspacem_maxAddr + 1;
+}
+
+#if defined(VGO_linux)
+static Bool page_is_zero ( Addr a )
+{
+   const UWord* p = (const UWord*)a;
+   UInt i;
+   for (i = 0; i < VKI_PAGE_SIZE / sizeof(UWord); i += 4)
+      if ((p[i] | p[i+1] | p[i+2] | p[i+3]) != 0)
+         return False;
+   return True;
+}
+
+/* Walk the backed pages of [start, start+len), returning how many
+   bytes of them there are.  If 'release', give back the ones which
+   are all zeroes instead of counting them. */
+static SizeT flat_shadow_walk ( Addr start, SizeT len, Bool release )
+{
+   UChar vec[256];
+   SizeT counted = 0, released = 0;
+   Addr  a       = VG_PGROUNDDN(start);
+   Addr  end     = VG_PGROUNDUP(start + len);
+   Addr  run     = 0;   /* start of the current run of zero pages */
+   UInt  i, n;
+
+   while (a < end) {
+      SysRes sres;
+      n = (end - a) / VKI_PAGE_SIZE;
+      if (n > sizeof(vec))
+         n = sizeof(vec);
+      sres = VG_(do_syscall3)( __NR_mincore, a, n * VKI_PAGE_SIZE,
+                               (UWord)vec );
+      if (sr_isError(sres))
+         return release ? released : len;
+      for (i = 0; i < n; i++, a += VKI_PAGE_SIZE) {
+         Bool zero = False;
+         if (vec[i] & 1) {
+            if (release && page_is_zero(a))
+               zero = True;
+            else
+               counted += VKI_PAGE_SIZE;
+         }
+         if (zero && run == 0)
+            run = a;
+         if (!zero && run != 0) {
+            (void)VG_(do_syscall3)( __NR_madvise, run, a - run,
+                                    VKI_MADV_DONTNEED );
+            released += a - run;
+            run = 0;
+         }
+      }
+   }
+   if (run != 0) {
+      (void)VG_(do_syscall3)( __NR_madvise, run, a - run,
+                              VKI_MADV_DONTNEED );
+      released += a - run;
+   }
+   return release ? released : counted;
+}
+#endif
+
+SizeT VG_(am_flat_shadow_committed) ( void* base, SizeT size )
+{
+#if defined(VGO_linux)
+   return flat_shadow_walk( (Addr)base, size, False/*!release*/ );
+#else
+   return size;
+#endif
+}
+
+SizeT VG_(am_flat_shadow_release_zeroes) ( void* base, SizeT size )
+{
+#if defined(VGO_linux)
+   return flat_shadow_walk( (Addr)base, size, True/*release*/ );
+#else
+   return 0;
+#endif
+}
+
+#if defined(VGO_linux)
+static ULong read_thp_backed_szB ( void ); /* forward */
+#endif
+
+void VG_(am_get_huge_page_stats) ( /*OUT*/ULong* requested,
+                                   /*OUT*/ULong* hugetlb,
+                                   /*OUT*/ULong* advised,
+                                   /*OUT*/ULong* thp_backed )
+{
+   *requested  = huge_requested_szB;
+   *hugetlb    = huge_hugetlb_szB;
+   *advised    = huge_advised_szB;
+#if defined(VGO_linux)
+   *thp_backed = huge_advised_szB > 0 ? read_thp_backed_szB() : 0;
+#else
+   *thp_backed = 0;
+#endif
+}
+
 /* Map a file at an unconstrained address for V, and update the
    segment array accordingly. Use the provided flags */
 
@@ -2679,6 +3220,16 @@ SysRes VG_(am_munmap_client)( /*OUT*/Bool* need_discard,
    return am_munmap_both_wrk( need_discard, start, len, True/*client*/ );
 }
 
+/* Unmap [start, start+len) and the guard pages around it, as mapped
+   by VG_(am_mmap_anon_float_client_guarded). */
+
+SysRes VG_(am_munmap_client_guarded)( /*OUT*/Bool* need_discard,
+                                      Addr start, SizeT len )
+{
+   return VG_(am_munmap_client)( need_discard, start - VKI_PAGE_SIZE,
+                                 VG_PGROUNDUP(len) + 2 * VKI_PAGE_SIZE );
+}
+
 /* Unmap the given address range and update the segment array
    accordingly.  This fails if the range isn't valid for valgrind. */
 
@@ -2711,26 +3262,26 @@ Bool VG_(am_change_ownership_v_to_c)( Addr start, SizeT len )
       return False;
 
    i = find_nsegment_idx(start);
-   if (nsegments[i].kind != SkFileV && nsegments[i].kind != SkAnonV)
+   if (SEG(i).kind != SkFileV && SEG(i).kind != SkAnonV)
       return False;
-   if (start+len-1 > nsegments[i].end)
+   if (start+len-1 > SEG(i).end)
       return False;
 
-   aspacem_assert(start >= nsegments[i].start);
-   aspacem_assert(start+len-1 <= nsegments[i].end);
+   aspacem_assert(start >= SEG(i).start);
+   aspacem_assert(start+len-1 <= SEG(i).end);
 
    /* This scheme is like how mprotect works: split the to-be-changed
       range into its own segment(s), then mess with them (it).  There
       should be only one. */
    split_nsegments_lo_and_hi( start, start+len-1, &iLo, &iHi );
    aspacem_assert(iLo == iHi);
-   switch (nsegments[iLo].kind) {
-      case SkFileV: nsegments[iLo].kind = SkFileC; break;
-      case SkAnonV: nsegments[iLo].kind = SkAnonC; break;
+   switch (SEG(iLo).kind) {
+      case SkFileV: SEG(iLo).kind = SkFileC; break;
+      case SkAnonV: SEG(iLo).kind = SkAnonC; break;
       default: aspacem_assert(0); /* can't happen - guarded above */
    }
 
-   preen_nsegments();
+   preen_nsegments_around(iLo, iLo);
    return True;
 }
 
@@ -2744,10 +3295,10 @@ void VG_(am_set_segment_isCH_if_SkAnonC)( const NSegment* seg )
 {
    Int i = segAddr_to_index( seg );
    aspacem_assert(i >= 0 && i < nsegments_used);
-   if (nsegments[i].kind == SkAnonC) {
-      nsegments[i].isCH = True;
+   if (SEG(i).kind == SkAnonC) {
+      SEG(i).isCH = True;
    } else {
-      aspacem_assert(nsegments[i].isCH == False);
+      aspacem_assert(SEG(i).isCH == False);
    }
 }
 
@@ -2758,8 +3309,8 @@ void VG_(am_set_segment_hasT_if_SkFileC_or_SkAnonC)( const NSegment* seg )
 {
    Int i = segAddr_to_index( seg );
    aspacem_assert(i >= 0 && i < nsegments_used);
-   if (nsegments[i].kind == SkAnonC || nsegments[i].kind == SkFileC) {
-      nsegments[i].hasT = True;
+   if (SEG(i).kind == SkAnonC || SEG(i).kind == SkFileC) {
+      SEG(i).hasT = True;
    }
 }
 
@@ -2807,12 +3358,12 @@ Bool VG_(am_create_reservation) ( Addr start, SizeT length,
    if (startI != endI)
       return False;
 
-   if (nsegments[startI].kind != SkFree)
+   if (SEG(startI).kind != SkFree)
       return False;
 
    /* Looks good - make the reservation. */
-   aspacem_assert(nsegments[startI].start <= start2);
-   aspacem_assert(end2 <= nsegments[startI].end);
+   aspacem_assert(SEG(startI).start <= start2);
+   aspacem_assert(end2 <= SEG(startI).end);
 
    init_nsegment( &seg );
    seg.kind  = SkResvn;
@@ -2850,15 +3401,15 @@ Bool VG_(am_extend_into_adjacent_reservation_client) ( const NSegment* seg,
    segA = segAddr_to_index( seg );
    aspacem_assert(segA >= 0 && segA < nsegments_used);
 
-   if (nsegments[segA].kind != SkAnonC)
+   if (SEG(segA).kind != SkAnonC)
       return False;
 
    if (delta == 0)
       return True;
 
-   prot =   (nsegments[segA].hasR ? VKI_PROT_READ : 0)
-          | (nsegments[segA].hasW ? VKI_PROT_WRITE : 0)
-          | (nsegments[segA].hasX ? VKI_PROT_EXEC : 0);
+   prot =   (SEG(segA).hasR ? VKI_PROT_READ : 0)
+          | (SEG(segA).hasW ? VKI_PROT_WRITE : 0)
+          | (SEG(segA).hasX ? VKI_PROT_EXEC : 0);
 
    aspacem_assert(VG_IS_PAGE_ALIGNED(delta<0 ? -delta : delta));
 
@@ -2867,33 +3418,33 @@ Bool VG_(am_extend_into_adjacent_reservation_client) ( const NSegment* seg,
       /* Extending the segment forwards. */
       segR = segA+1;
       if (segR >= nsegments_used
-          || nsegments[segR].kind != SkResvn
-          || nsegments[segR].smode != SmLower
-          || nsegments[segR].start != nsegments[segA].end + 1
+          || SEG(segR).kind != SkResvn
+          || SEG(segR).smode != SmLower
+          || SEG(segR).start != SEG(segA).end + 1
           || delta + VKI_PAGE_SIZE 
-                > (nsegments[segR].end - nsegments[segR].start + 1))
+                > (SEG(segR).end - SEG(segR).start + 1))
         return False;
         
       /* Extend the kernel's mapping. */
       // DDD: #warning GrP fixme MAP_FIXED can clobber memory!
       sres = VG_(am_do_mmap_NO_NOTIFY)( 
-                nsegments[segR].start, delta,
+                SEG(segR).start, delta,
                 prot,
                 VKI_MAP_FIXED|VKI_MAP_PRIVATE|VKI_MAP_ANONYMOUS, 
                 0, 0 
              );
       if (sr_isError(sres))
          return False; /* kernel bug if this happens? */
-      if (sr_Res(sres) != nsegments[segR].start) {
+      if (sr_Res(sres) != SEG(segR).start) {
          /* kernel bug if this happens? */
         (void)ML_(am_do_munmap_NO_NOTIFY)( sr_Res(sres), delta );
         return False;
       }
 
       /* Ok, success with the kernel.  Update our structures. */
-      nsegments[segR].start += delta;
-      nsegments[segA].end += delta;
-      aspacem_assert(nsegments[segR].start <= nsegments[segR].end);
+      SEG(segR).start += delta;
+      SEG(segA).end += delta;
+      aspacem_assert(SEG(segR).start <= SEG(segR).end);
 
    } else {
 
@@ -2903,33 +3454,33 @@ Bool VG_(am_extend_into_adjacent_reservation_client) ( const NSegment* seg,
 
       segR = segA-1;
       if (segR < 0
-          || nsegments[segR].kind != SkResvn
-          || nsegments[segR].smode != SmUpper
-          || nsegments[segR].end + 1 != nsegments[segA].start
+          || SEG(segR).kind != SkResvn
+          || SEG(segR).smode != SmUpper
+          || SEG(segR).end + 1 != SEG(segA).start
           || delta + VKI_PAGE_SIZE 
-                > (nsegments[segR].end - nsegments[segR].start + 1))
+                > (SEG(segR).end - SEG(segR).start + 1))
         return False;
         
       /* Extend the kernel's mapping. */
       // DDD: #warning GrP fixme MAP_FIXED can clobber memory!
       sres = VG_(am_do_mmap_NO_NOTIFY)( 
-                nsegments[segA].start-delta, delta,
+                SEG(segA).start-delta, delta,
                 prot,
                 VKI_MAP_FIXED|VKI_MAP_PRIVATE|VKI_MAP_ANONYMOUS, 
                 0, 0 
              );
       if (sr_isError(sres))
          return False; /* kernel bug if this happens? */
-      if (sr_Res(sres) != nsegments[segA].start-delta) {
+      if (sr_Res(sres) != SEG(segA).start-delta) {
          /* kernel bug if this happens? */
         (void)ML_(am_do_munmap_NO_NOTIFY)( sr_Res(sres), delta );
         return False;
       }
 
       /* Ok, success with the kernel.  Update our structures. */
-      nsegments[segR].end -= delta;
-      nsegments[segA].start -= delta;
-      aspacem_assert(nsegments[segR].start <= nsegments[segR].end);
+      SEG(segR).end -= delta;
+      SEG(segA).start -= delta;
+      aspacem_assert(SEG(segR).start <= SEG(segR).end);
 
    }
 
@@ -3039,7 +3590,7 @@ Bool VG_(am_relocate_nooverlap_client)( /*OUT*/Bool* need_discard,
    if (iLo != iHi)
       return False;
 
-   if (nsegments[iLo].kind != SkFileC && nsegments[iLo].kind != SkAnonC)
+   if (SEG(iLo).kind != SkFileC && SEG(iLo).kind != SkAnonC)
       return False;
 
    sres = ML_(am_do_relocate_nooverlap_mapping_NO_NOTIFY)
@@ -3054,7 +3605,7 @@ Bool VG_(am_relocate_nooverlap_client)( /*OUT*/Bool* need_discard,
    *need_discard = any_Ts_in_range( old_addr, old_len )
                    || any_Ts_in_range( new_addr, new_len );
 
-   seg = nsegments[iLo];
+   seg = SEG(iLo);
 
    /* Mark the new area based on the old seg. */
    if (seg.kind == SkFileC) {
@@ -3102,11 +3653,8 @@ Bool VG_(am_relocate_nooverlap_client)( /*OUT*/Bool* need_discard,
 
 /*------BEGIN-procmaps-parser-for-Linux--------------------------*/
 
-/* Size of a smallish table used to read /proc/self/map entries. */
-#define M_PROCMAP_BUF 100000
-
-/* static ... to keep it out of the stack frame. */
-static HChar procmap_buf[M_PROCMAP_BUF];
+/* procmap_buf, of size M_PROCMAP_BUF, is in the segment tables
+   mapping. */
 
 /* Records length of /proc/self/maps read into procmap_buf. */
 static Int  buf_n_tot;
@@ -3170,6 +3718,89 @@ static Int readdec64 ( const HChar* buf, ULong* val )
 }
 
 
+/* Add up the 'tag' lines (e.g. "Rss:") of /proc/self/smaps, over the
+   client's mappings if 'client', otherwise over V's anonymous mappings.
+   The file is too big to read in one go, so it is read a line at a
+   time using procmap_buf.  Gives 0 if the file can't be read. */
+
+#if defined(VGO_linux)
+static ULong sum_smaps_field ( const HChar* tag, Bool client )
+{
+   Int          n_tag = VG_(strlen)(tag);
+   Bool         in_seg = False;
+   ULong        total = 0;
+   Int          n_buf = 0;
+   Int          n_chunk, i, j;
+   SysRes       fd;
+
+   fd = ML_(am_open)( "/proc/self/smaps", VKI_O_RDONLY, 0 );
+   if (sr_isError(fd))
+      return 0;
+   while (True) {
+      n_chunk = ML_(am_read)( sr_Res(fd), &procmap_buf[n_buf],
+                              M_PROCMAP_BUF - 1 - n_buf );
+      if (n_chunk <= 0)
+         break;
+      n_buf += n_chunk;
+      /* Deal with each complete line, then shuffle the rest down. */
+      i = 0;
+      while (True) {
+         for (j = i; j < n_buf && procmap_buf[j] != '\n'; j++)
+            ;
+         if (j == n_buf)
+            break;
+         procmap_buf[j] = 0;
+         if (VG_(strncmp)(&procmap_buf[i], tag, n_tag) == 0) {
+            ULong kB = 0;
+            Int   k  = i + n_tag;
+            while (procmap_buf[k] == ' ')
+               k++;
+            readdec64(&procmap_buf[k], &kB);
+            if (in_seg)
+               total += kB * 1024;
+         } else if (hexdigit(procmap_buf[i]) >= 0) {
+            /* "start-end perms ..." begins the next mapping. */
+            UWord start = 0;
+            Int   k     = readhex(&procmap_buf[i], &start);
+            if (procmap_buf[i + k] == '-') {
+               Int iseg = find_nsegment_idx( (Addr)start );
+               if (client)
+                  in_seg = SEG(iseg).kind == SkAnonC
+                           || SEG(iseg).kind == SkFileC
+                           || SEG(iseg).kind == SkShmC;
+               else
+                  in_seg = SEG(iseg).kind == SkAnonV;
+            }
+         }
+         i = j + 1;
+      }
+      if (i == 0 && n_buf == M_PROCMAP_BUF - 1)
+         break; /* absurdly long line; give up */
+      for (j = i; j < n_buf; j++)
+         procmap_buf[j - i] = procmap_buf[j];
+      n_buf -= i;
+   }
+   ML_(am_close)(sr_Res(fd));
+   return total;
+}
+
+/* How much of the memory advised with MADV_HUGEPAGE the kernel has
+   actually backed with huge pages. */
+static ULong read_thp_backed_szB ( void )
+{
+   return sum_smaps_field( "AnonHugePages:", False/*!client*/ );
+}
+#endif
+
+SizeT VG_(am_client_rss_szB) ( void )
+{
+#if defined(VGO_linux)
+   return sum_smaps_field( "Rss:", True/*client*/ );
+#else
+   return 0;
+#endif
+}
+
 /* Get the contents of /proc/self/maps into a static buffer.  If
    there's a syntax error, it won't fit, or other failure, just
    abort. */
@@ -3221,6 +3852,10 @@ static void read_procselfmaps_into_buf ( void )
    Note that the supplied filename is transiently stored; record_mapping 
    should make a copy if it wants to keep it.
 
+   Only entries and gaps which overlap [lo, hi] are passed on (some
+   others may be too).  Lines wholly below lo are skipped after reading
+   their addresses, and parsing stops at the first line above hi.
+
    Nb: it is important that this function does not alter the contents of
        procmap_buf!
 */
@@ -3228,7 +3863,8 @@ static void parse_procselfmaps (
       void (*record_mapping)( Addr addr, SizeT len, UInt prot,
                               ULong dev, ULong ino, Off64T offset, 
                               const HChar* filename ),
-      void (*record_gap)( Addr addr, SizeT len )
+      void (*record_gap)( Addr addr, SizeT len ),
+      Addr lo, Addr hi
    )
 {
    Int    i, j, i_eol;
@@ -3262,6 +3898,19 @@ static void parse_procselfmaps (
       j = readhex(&procmap_buf[i], &endPlusOne);
       if (j > 0) i += j; else goto syntaxerror;
 
+      if (endPlusOne <= lo && start < endPlusOne) {
+         /* Nothing of interest here, nor in the gap before it. */
+         while (i < buf_n_tot && procmap_buf[i] != '\n') i++;
+         i++;
+         gapStart = endPlusOne;
+         continue;
+      }
+      if (start > hi) {
+         if (record_gap && gapStart < start)
+            (*record_gap) ( gapStart, start-gapStart );
+         return;
+      }
+
       j = readchar(&procmap_buf[i], &ch);
       if (j == 1 && ch == ' ') i += j; else goto syntaxerror;
 
@@ -3437,7 +4086,8 @@ static void parse_procselfmaps (
       void (*record_mapping)( Addr addr, SizeT len, UInt prot,
                               ULong dev, ULong ino, Off64T offset, 
                               const HChar* filename ),
-      void (*record_gap)( Addr addr, SizeT len )
+      void (*record_gap)( Addr addr, SizeT len ),
+      Addr lo, Addr hi
    )
 {
    vm_address_t iter;
@@ -3522,11 +4172,11 @@ static void add_mapping_callback(Addr addr, SizeT len, UInt prot,
 
       UInt seg_prot;
 
-      if (nsegments[i].kind == SkAnonV  ||  nsegments[i].kind == SkFileV) {
+      if (SEG(i).kind == SkAnonV  ||  SEG(i).kind == SkFileV) {
          /* Ignore V regions */
          continue;
       } 
-      else if (nsegments[i].kind == SkFree || nsegments[i].kind == SkResvn) {
+      else if (SEG(i).kind == SkFree || SEG(i).kind == SkResvn) {
          /* Add mapping for SkResvn regions */
          ChangedSeg* cs = &css_local[css_used_local];
          if (css_used_local < css_size_local) {
@@ -3542,28 +4192,28 @@ static void add_mapping_callback(Addr addr, SizeT len, UInt prot,
          return;
 
       }
-      else if (nsegments[i].kind == SkAnonC ||
-               nsegments[i].kind == SkFileC ||
-               nsegments[i].kind == SkShmC)
+      else if (SEG(i).kind == SkAnonC ||
+               SEG(i).kind == SkFileC ||
+               SEG(i).kind == SkShmC)
       {
          /* Check permissions on client regions */
          // GrP fixme
          seg_prot = 0;
-         if (nsegments[i].hasR) seg_prot |= VKI_PROT_READ;
-         if (nsegments[i].hasW) seg_prot |= VKI_PROT_WRITE;
+         if (SEG(i).hasR) seg_prot |= VKI_PROT_READ;
+         if (SEG(i).hasW) seg_prot |= VKI_PROT_WRITE;
 #        if defined(VGA_x86)
          // GrP fixme sloppyXcheck 
          // darwin: kernel X ignored and spuriously changes? (vm_copy)
          seg_prot |= (prot & VKI_PROT_EXEC);
 #        else
-         if (nsegments[i].hasX) seg_prot |= VKI_PROT_EXEC;
+         if (SEG(i).hasX) seg_prot |= VKI_PROT_EXEC;
 #        endif
          if (seg_prot != prot) {
              if (VG_(clo_trace_syscalls)) 
                  VG_(debugLog)(0,"aspacem","region %p..%p permission "
                                  "mismatch (kernel %x, V %x)\n", 
-                                 (void*)nsegments[i].start,
-                                 (void*)(nsegments[i].end+1), prot, seg_prot);
+                                 (void*)SEG(i).start,
+                                 (void*)(SEG(i).end+1), prot, seg_prot);
             /* Add mapping for regions with protection changes */
             ChangedSeg* cs = &css_local[css_used_local];
             if (css_used_local < css_size_local) {
@@ -3603,7 +4253,7 @@ static void remove_mapping_callback(Addr addr, SizeT len)
 
    /* NSegments iLo .. iHi inclusive should agree with the presented data. */
    for (i = iLo; i <= iHi; i++) {
-      if (nsegments[i].kind != SkFree && nsegments[i].kind != SkResvn) {
+      if (SEG(i).kind != SkFree && SEG(i).kind != SkResvn) {
          /* V has a mapping, kernel doesn't.  Add to css_local[],
             directives to chop off the part of the V mapping that
             falls within the gap that the kernel tells us is
@@ -3611,8 +4261,8 @@ static void remove_mapping_callback(Addr addr, SizeT len)
          ChangedSeg* cs = &css_local[css_used_local];
          if (css_used_local < css_size_local) {
             cs->is_added = False;
-            cs->start    = Addr__max(nsegments[i].start, addr);
-            cs->end      = Addr__min(nsegments[i].end,   addr + len - 1);
+            cs->start    = Addr__max(SEG(i).start, addr);
+            cs->end      = Addr__min(SEG(i).end,   addr + len - 1);
             aspacem_assert(VG_IS_PAGE_ALIGNED(cs->start));
             aspacem_assert(VG_IS_PAGE_ALIGNED(cs->end+1));
             /* I don't think the following should fail.  But if it
@@ -3650,7 +4300,8 @@ Bool VG_(get_changed_segments)(
    css_used_local = 0;
 
    // Get the list of segs that need to be added/removed.
-   parse_procselfmaps(&add_mapping_callback, &remove_mapping_callback);
+   parse_procselfmaps(&add_mapping_callback, &remove_mapping_callback,
+                      Addr_MIN, Addr_MAX);
 
    *css_used = css_used_local;
 
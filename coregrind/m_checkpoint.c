@@ -0,0 +1,192 @@
+
+/*--------------------------------------------------------------------*/
+/*--- Checkpoints of a running program.             m_checkpoint.c ---*/
+/*--------------------------------------------------------------------*/
+
+/*
+   This file is part of Valgrind, a dynamic binary instrumentation
+   framework.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of the
+   License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+   02111-1307, USA.
+
+   The GNU General Public License is contained in the file COPYING.
+*/
+
+#include "pub_core_basics.h"
+#include "pub_core_vki.h"
+#include "pub_core_clientstate.h"     // VG_(fd_hard_limit)
+#include "pub_core_gdbserver.h"
+#include "pub_core_libcassert.h"
+#include "pub_core_libcbase.h"
+#include "pub_core_libcfile.h"
+#include "pub_core_libcprint.h"
+#include "pub_core_libcproc.h"
+#include "pub_core_libcsignal.h"
+#include "pub_core_options.h"
+#include "pub_core_libcsetjmp.h"    // to keep _threadstate.h happy
+#include "pub_core_threadstate.h"
+#include "pub_core_checkpoint.h"    // self
+
+/* The checkpoints this process can restore, in the order they were
+   made.  These are all ancestors of this process. */
+typedef
+   struct {
+      Int n;     /* number of the checkpoint */
+      Int pid;   /* the process keeping it */
+      Int fd;    /* write end of the pipe it waits on */
+   }
+   Checkpoint;
+
+#define MAX_CHECKPOINTS 64
+
+static Checkpoint checkpoints[MAX_CHECKPOINTS];
+static Int n_checkpoints = 0;
+
+/* Number of the last checkpoint made. */
+static Int last_checkpoint_n = 0;
+
+static Bool checkpoint_requested = False;
+
+/* Wait in the checkpoint process, until the checkpoint is restored or
+   the run ends.  In the latter case, exit as the run did. */
+static void wait_in_checkpoint ( Int n, Int child, Int rfd )
+{
+   HChar c;
+   Int   status;
+   Bool  restore = VG_(read)(rfd, &c, 1) == 1;
+
+   VG_(close)(rfd);
+   if (VG_(waitpid)(child, &status, 0) != child)
+      status = 1 << 8;
+   if (!restore) {
+      if ((status & 0x7f) == 0)
+         VG_(exit)((status >> 8) & 0xff);
+      VG_(exit)(128 + (status & 0x7f));
+   }
+   if (VG_(clo_verbosity) > 0)
+      VG_(umsg)("Restored checkpoint %d\n", n);
+}
+
+UWord VG_(checkpoint) ( ThreadId tid )
+{
+   Int n, pid, fds[2];
+   vki_sigset_t mask, saved_mask;
+
+   if (VG_(count_living_threads)() > 1) {
+      VG_(umsg)("Warning: checkpoint not made: "
+                "the client has more than one thread\n");
+      return 0;
+   }
+   if (n_checkpoints == MAX_CHECKPOINTS) {
+      VG_(umsg)("Warning: checkpoint not made: "
+                "there are already %d checkpoints\n", MAX_CHECKPOINTS);
+      return 0;
+   }
+   if (VG_(pipe)(fds) != 0) {
+      VG_(umsg)("Warning: checkpoint not made: can't create a pipe\n");
+      return 0;
+   }
+   fds[0] = VG_(safe_fd)(fds[0]);
+   fds[1] = VG_(safe_fd)(fds[1]);
+   n = ++last_checkpoint_n;
+
+   VG_(sigfillset)(&mask);
+   VG_(sigprocmask)(VKI_SIG_SETMASK, &mask, &saved_mask);
+   VG_(flush_output_sinks)();
+
+   VG_(do_atfork_pre)(tid);
+   pid = VG_(fork)();
+   if (pid == -1) {
+      VG_(do_atfork_parent)(tid);
+      VG_(sigprocmask)(VKI_SIG_SETMASK, &saved_mask, NULL);
+      VG_(close)(fds[0]);
+      VG_(close)(fds[1]);
+      last_checkpoint_n--;
+      VG_(umsg)("Warning: checkpoint not made: can't fork\n");
+      return 0;
+   }
+
+   if (pid == 0) {
+      /* The child continues the run. */
+      VG_(do_atfork_child)(tid);
+      VG_(sigprocmask)(VKI_SIG_SETMASK, &saved_mask, NULL);
+      VG_(close)(fds[0]);
+      checkpoints[n_checkpoints].n   = n;
+      checkpoints[n_checkpoints].pid = VG_(getppid)();
+      checkpoints[n_checkpoints].fd  = fds[1];
+      n_checkpoints++;
+      if (VG_(clo_verbosity) > 0)
+         VG_(umsg)("Checkpoint %d made, kept by process %d\n",
+                   n, VG_(getppid)());
+      return 0;
+   }
+
+   /* The parent keeps the checkpoint. */
+   VG_(do_atfork_parent)(tid);
+   VG_(close)(fds[1]);
+   wait_in_checkpoint(n, pid, fds[0]);
+   VG_(sigprocmask)(VKI_SIG_SETMASK, &saved_mask, NULL);
+   /* The checkpoints made after this one have exited. */
+   last_checkpoint_n = n;
+   return n;
+}
+
+void VG_(request_checkpoint) ( void )
+{
+   checkpoint_requested = True;
+}
+
+void VG_(maybe_checkpoint) ( ThreadId tid )
+{
+   if (checkpoint_requested) {
+      checkpoint_requested = False;
+      (void) VG_(checkpoint)(tid);
+   }
+}
+
+Bool VG_(restore_checkpoint) ( Int n )
+{
+   Int  i;
+   HChar c = 1;
+
+   for (i = 0; i < n_checkpoints; i++)
+      if (checkpoints[i].n == n)
+         break;
+   if (i == n_checkpoints)
+      return False;
+
+   if (VG_(clo_verbosity) > 0)
+      VG_(umsg)("Restoring checkpoint %d, kept by process %d\n",
+                n, checkpoints[i].pid);
+   VG_(flush_output_sinks)();
+   VG_(write)(checkpoints[i].fd, &c, 1);
+   VG_(exit)(0);
+}
+
+void VG_(show_checkpoints) ( void )
+{
+   Int i;
+
+   if (n_checkpoints == 0)
+      VG_(gdb_printf)("no checkpoint\n");
+   for (i = 0; i < n_checkpoints; i++)
+      VG_(gdb_printf)("checkpoint %d: process %d\n",
+                      checkpoints[i].n, checkpoints[i].pid);
+}
+
+/*--------------------------------------------------------------------*/
+/*--- end                                                          ---*/
+/*--------------------------------------------------------------------*/
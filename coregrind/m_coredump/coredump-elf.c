@@ -110,7 +110,7 @@ static void fill_ehdr(ESZ(Ehdr) *ehdr, Int num_phdrs)
 
 }
 
-static void fill_phdr(ESZ(Phdr) *phdr, const NSegment *seg, UInt off, Bool write)
+static void fill_phdr(ESZ(Phdr) *phdr, const NSegment *seg, ULong off, Bool write)
 {
    SizeT len = seg->end - seg->start + 1;
 
@@ -190,6 +190,79 @@ static void write_note(Int fd, const struct note *n)
    VG_(write)(fd, &n->note, note_size(n));
 }
 
+/* Segment contents are written in runs of chunks of this size.  A
+   chunk of a client anonymous or shared memory segment which is all
+   zeroes (typically, one that has never been touched) is not written
+   at all, leaving a hole in the core file, so that the file takes
+   little more disk space than the memory actually in use.  Other
+   segments are not looked at, since reading them can fault (e.g. a
+   file mapping beyond the end of the file); a write just fails then. */
+#define DUMP_CHUNK   (64 * 1024)
+#define DUMP_MAX_RUN (8 * 1024 * 1024)
+
+static Bool is_zero_chunk(const void *p, SizeT len)
+{
+   const UWord *w = p;
+   SizeT i, n = len / sizeof(UWord);
+
+   for (i = 0; i < n; i += 4) {
+      if ((w[i] | w[i+1] | w[i+2] | w[i+3]) != 0)
+         return False;
+   }
+   return True;
+}
+
+/* Write len bytes from buf at offset off.  VG_(write) takes an Int
+   count, and may write less than it was asked to. */
+static Bool write_at(Int fd, ULong off, const void *buf, ULong len)
+{
+   const HChar *p = buf;
+   Int n;
+
+   if (VG_(lseek)(fd, off, VKI_SEEK_SET) != off)
+      return False;
+   while (len > 0) {
+      n = VG_(write)(fd, p, len < DUMP_MAX_RUN ? len : DUMP_MAX_RUN);
+      if (n <= 0)
+         return False;
+      p += n;
+      len -= n;
+   }
+   return True;
+}
+
+/* Write the contents of seg, len bytes of it, at offset off, leaving
+   holes for zero chunks where it is safe to look for them. */
+static void write_seg(Int fd, const NSegment *seg, ULong off, ULong len)
+{
+   Bool scan = seg->hasR && (seg->kind == SkAnonC || seg->kind == SkShmC);
+   ULong pos, run_start, chunk;
+
+   if (!scan) {
+      (void)write_at(fd, off, (void *)seg->start, len);
+      return;
+   }
+
+   run_start = 0;
+   for (pos = 0; pos < len; pos += chunk) {
+      chunk = len - pos < DUMP_CHUNK ? len - pos : DUMP_CHUNK;
+      if (chunk == DUMP_CHUNK
+          && is_zero_chunk((void *)(seg->start + pos), chunk)) {
+         if (pos > run_start)
+            (void)write_at(fd, off + run_start, (void *)(seg->start + run_start),
+                           pos - run_start);
+         run_start = pos + chunk;
+      } else if (pos + chunk - run_start >= DUMP_MAX_RUN) {
+         (void)write_at(fd, off + run_start, (void *)(seg->start + run_start),
+                        pos + chunk - run_start);
+         run_start = pos + chunk;
+      }
+   }
+   if (len > run_start)
+      (void)write_at(fd, off + run_start, (void *)(seg->start + run_start),
+                     len - run_start);
+}
+
 static void fill_prpsinfo(const ThreadState *tst,
                           struct vki_elf_prpsinfo *prpsinfo)
 {
@@ -584,7 +657,7 @@ void make_elf_coredump(ThreadId tid, const vki_siginfo_t *si, ULong max_size)
    ESZ(Phdr) *phdrs;
    Int num_phdrs;
    Int i, idx;
-   UInt off;
+   ULong off;
    struct note *notelist, *note;
    UInt notesz;
    struct vki_elf_prpsinfo prpsinfo;
@@ -714,8 +787,6 @@ void make_elf_coredump(ThreadId tid, const vki_siginfo_t *si, ULong max_size)
    for(note = notelist; note != NULL; note = note->next)
       write_note(core_fd, note);
    
-   VG_(lseek)(core_fd, phdrs[1].p_offset, VKI_SEEK_SET);
-
    for(i = 0, idx = 1; i < n_seg_starts; i++) {
       seg = VG_(am_find_nsegment(seg_starts[i]));
 
@@ -723,15 +794,19 @@ void make_elf_coredump(ThreadId tid, const vki_siginfo_t *si, ULong max_size)
 	 continue;
 
       if (phdrs[idx].p_filesz > 0) {
-	 vg_assert(VG_(lseek)(core_fd, phdrs[idx].p_offset, VKI_SEEK_SET) 
-                   == phdrs[idx].p_offset);
 	 vg_assert(seg->end - seg->start + 1 >= phdrs[idx].p_filesz);
-
-	 (void)VG_(write)(core_fd, (void *)seg->start, phdrs[idx].p_filesz);
+	 write_seg(core_fd, seg, phdrs[idx].p_offset, phdrs[idx].p_filesz);
       }
       idx++;
    }
 
+   /* If the core ends with a hole, the file still has to be as long as
+      the program headers say. */
+   if (VG_(lseek)(core_fd, 0, VKI_SEEK_END) < off) {
+      HChar zero = 0;
+      (void)write_at(core_fd, off - 1, &zero, 1);
+   }
+
    VG_(free)(seg_starts);
 
    VG_(close)(core_fd);
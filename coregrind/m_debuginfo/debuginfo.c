@@ -40,7 +40,7 @@
 #include "pub_core_libcassert.h"
 #include "pub_core_libcprint.h"
 #include "pub_core_libcfile.h"
-#include "pub_core_libcproc.h"   // VG_(getenv)
+#include "pub_core_libcproc.h"   // VG_(getenv), VG_(run_workers)
 #include "pub_core_seqmatch.h"
 #include "pub_core_options.h"
 #include "pub_core_redir.h"      // VG_(redir_notify_{new,delete}_SegInfo)
@@ -56,6 +56,7 @@
 #include "priv_d3basics.h"       /* ML_(pp_GX) */
 #include "priv_tytypes.h"
 #include "priv_storage.h"
+#include "priv_dicache.h"
 #include "priv_readdwarf.h"
 #include "priv_readstabs.h"
 #if defined(VGO_linux)
@@ -110,6 +111,15 @@
 static UInt CF_info_generation = 0;
 static void cfsi_m_cache__invalidate ( void );
 
+/* Bumped whenever a DebugInfo is added or discarded, or its
+   mappings or tables change.  The text range index and the code
+   address cache (see below) belong to one generation. */
+static UInt debugInfo_list_gen = 0;
+static inline void debugInfo_list_changed ( void )
+{
+   debugInfo_list_gen++;
+}
+
 
 /*------------------------------------------------------------*/
 /*--- Root structure                                       ---*/
@@ -214,10 +224,16 @@ static void free_DebugInfo ( DebugInfo* di )
    GExpr* gexpr;
 
    vg_assert(di != NULL);
+   /* The demangle cache may hold pointers into di->strpool. */
+   VG_(demangle_cache_flush)();
+#  if defined(VGO_linux)
+   ML_(discard_elf_deferred)(di);
+#  endif
    if (di->fsm.maps)     VG_(deleteXA)(di->fsm.maps);
    if (di->fsm.filename) ML_(dinfo_free)(di->fsm.filename);
    if (di->fsm.dbgname)  ML_(dinfo_free)(di->fsm.dbgname);
    if (di->soname)       ML_(dinfo_free)(di->soname);
+   if (di->dicache_key)  ML_(dinfo_free)(di->dicache_key);
    if (di->loctab)       ML_(dinfo_free)(di->loctab);
    if (di->loctab_fndn_ix) ML_(dinfo_free)(di->loctab_fndn_ix);
    if (di->inltab)       ML_(dinfo_free)(di->inltab);
@@ -330,6 +346,7 @@ static void discard_DebugInfo ( DebugInfo* di )
                          reason);
          vg_assert(*prev_next_ptr == curr);
          *prev_next_ptr = curr->next;
+         debugInfo_list_changed();
          if (curr->have_dinfo)
             VG_(redir_notify_delete_DebugInfo)( curr );
          free_DebugInfo(curr);
@@ -482,6 +499,7 @@ static DebugInfo* find_or_create_DebugInfo_for ( HChar* filename )
       vg_assert(di);
       di->next = debugInfo_list;
       debugInfo_list = di;
+      debugInfo_list_changed();
    }
    return di;
 }
@@ -574,6 +592,166 @@ static void check_CFSI_related_invariants ( DebugInfo* di )
 }
 
 
+/* With --debuginfo-cache, save di's tables once they are all read
+   and canonicalised, unless they were loaded from the cache. */
+static void save_to_dicache ( DebugInfo* di )
+{
+   if (di->dicache_key == NULL || di->cfi_deferred || di->dwarf_deferred)
+      return;
+   ML_(dicache_save)(di, di->dicache_key);
+   ML_(dinfo_free)(di->dicache_key);
+   di->dicache_key = NULL;
+}
+
+
+/* With --debuginfo-threads=N (N > 1), the CFI and DWARF info of the
+   objects is read all at once, by N workers (see VG_(run_workers)),
+   each taking the next unread object until there are none left.
+   Everything they do to an object only touches that object's
+   DebugInfo, bar allocation and printing, which the workers
+   serialise.  What relates the objects to each other is left to the
+   caller. */
+typedef
+   struct {
+      DebugInfo** dis;
+      Int         n_dis;
+      Int         next;   /* next dis[] entry to read */
+      Bool*       cfi;    /* was dis[i]'s CFI read? */
+   }
+   DeferredBatch;
+
+static void read_deferred_worker ( void* bv, Int i )
+{
+   DeferredBatch* b = bv;
+   while (True) {
+      Int        k = __sync_fetch_and_add(&b->next, 1);
+      DebugInfo* di;
+      if (k >= b->n_dis)
+         break;
+      di = b->dis[k];
+      if (di->cfi_deferred) {
+         b->cfi[k] = True;
+#        if defined(VGO_linux)
+         ML_(read_elf_deferred_cfi)( di );
+#        endif
+         vg_assert(!di->cfi_deferred);
+         ML_(canonicaliseCFITables)( di );
+      }
+      if (di->dwarf_deferred) {
+#        if defined(VGO_linux)
+         ML_(read_elf_deferred_dwarf)( di );
+#        endif
+         vg_assert(!di->dwarf_deferred);
+         ML_(canonicaliseDwarfTables)( di );
+      }
+   }
+}
+
+static void read_all_deferred ( void )
+{
+   DeferredBatch b;
+   DebugInfo*    di;
+   Int           i, n_workers;
+
+   b.n_dis = 0;
+   for (di = debugInfo_list; di != NULL; di = di->next)
+      if (di->cfi_deferred || di->dwarf_deferred)
+         b.n_dis++;
+   if (b.n_dis == 0)
+      return;
+   b.dis  = ML_(dinfo_zalloc)("di.debuginfo.rad.1",
+                              b.n_dis * sizeof(DebugInfo*));
+   b.cfi  = ML_(dinfo_zalloc)("di.debuginfo.rad.2", b.n_dis * sizeof(Bool));
+   b.next = 0;
+   i = 0;
+   for (di = debugInfo_list; di != NULL; di = di->next)
+      if (di->cfi_deferred || di->dwarf_deferred)
+         b.dis[i++] = di;
+   vg_assert(i == b.n_dis);
+
+   n_workers = VG_(clo_debuginfo_threads);
+   if (n_workers > b.n_dis)
+      n_workers = b.n_dis;
+   if (VG_(clo_verbosity) > 1)
+      VG_(message)(Vg_DebugMsg,
+                   "Reading the debug info of %d objects on %d threads\n",
+                   b.n_dis, n_workers);
+   VG_(run_workers)(n_workers, read_deferred_worker, &b);
+
+   cfsi_m_cache__invalidate();
+   for (i = 0; i < b.n_dis; i++) {
+      if (!b.cfi[i])
+         continue;
+      check_CFSI_related_invariants(b.dis[i]);
+      ML_(finish_CFSI_arrays)(b.dis[i]);
+   }
+   for (i = 0; i < b.n_dis; i++)
+      save_to_dicache(b.dis[i]);
+   ML_(dinfo_free)(b.cfi);
+   ML_(dinfo_free)(b.dis);
+}
+
+/* With --lazy-debuginfo=yes, read di's CFI, if that hasn't been done
+   yet, and get it ready for use.  With --debuginfo-threads, read that
+   of every object which hasn't been yet. */
+static void ensure_cfi_read ( DebugInfo* di )
+{
+   if (LIKELY(!di->cfi_deferred))
+      return;
+   if (!VG_(clo_lazy_debuginfo) && VG_(clo_debuginfo_threads) > 1) {
+      read_all_deferred();
+      vg_assert(!di->cfi_deferred);
+      return;
+   }
+#  if defined(VGO_linux)
+   ML_(read_elf_deferred_cfi)( di );
+#  endif
+   vg_assert(!di->cfi_deferred);
+   cfsi_m_cache__invalidate();
+   ML_(canonicaliseCFITables)( di );
+   check_CFSI_related_invariants(di);
+   ML_(finish_CFSI_arrays)(di);
+   save_to_dicache(di);
+}
+
+/* Likewise for di's DWARF line, inline and variable info. */
+static void ensure_dwarf_read ( DebugInfo* di )
+{
+   if (LIKELY(!di->dwarf_deferred))
+      return;
+   if (!VG_(clo_lazy_debuginfo) && VG_(clo_debuginfo_threads) > 1) {
+      read_all_deferred();
+      vg_assert(!di->dwarf_deferred);
+      return;
+   }
+#  if defined(VGO_linux)
+   ML_(read_elf_deferred_dwarf)( di );
+#  endif
+   vg_assert(!di->dwarf_deferred);
+   ML_(canonicaliseDwarfTables)( di );
+   save_to_dicache(di);
+   debugInfo_list_changed();
+}
+
+/* Could 'a' be the address of one of di's global variables? */
+static Bool is_in_data_of ( DebugInfo* di, Addr a )
+{
+   Word i;
+   for (i = 0; i < VG_(sizeXA)(di->fsm.maps); i++) {
+      struct _DebugInfoMapping* map = VG_(indexXA)(di->fsm.maps, i);
+      if (a >= map->avma && a < map->avma + map->size)
+         return True;
+   }
+   if (di->bss_present
+       && a >= di->bss_avma && a < di->bss_avma + di->bss_size)
+      return True;
+   if (di->sbss_present
+       && a >= di->sbss_avma && a < di->sbss_avma + di->sbss_size)
+      return True;
+   return False;
+}
+
+
 /*--------------------------------------------------------------*/
 /*---                                                        ---*/
 /*--- TOP LEVEL: INITIALISE THE DEBUGINFO SYSTEM             ---*/
@@ -644,6 +822,7 @@ static ULong di_notify_ACHIEVE_ACCEPT_STATE ( struct _DebugInfo* di )
 #  else
 #    error "unknown OS"
 #  endif
+   debugInfo_list_changed();
 
    if (ok) {
 
@@ -658,6 +837,7 @@ static ULong di_notify_ACHIEVE_ACCEPT_STATE ( struct _DebugInfo* di )
          priv_storage.h. */
       check_CFSI_related_invariants(di);
       ML_(finish_CFSI_arrays)(di);
+      save_to_dicache(di);
       /* notify m_redir about it */
       TRACE_SYMTAB("\n------ Notifying m_redir ------\n");
       VG_(redir_notify_new_DebugInfo)( di );
@@ -849,7 +1029,7 @@ ULong VG_(di_notify_mmap)( Addr a, Bool allow_SkFileV, Int use_fd )
 #    error "Unknown platform"
 #  endif
 
-#  if defined(VGP_x86_darwin) && DARWIN_VERS >= DARWIN_10_7
+#  if (defined(VGP_x86_darwin) && DARWIN_VERS >= DARWIN_10_7) || 1 /* LOCALTEST */
    is_ro_map = seg->hasR && !seg->hasW && !seg->hasX;
 #  endif
 
@@ -932,6 +1112,7 @@ ULong VG_(di_notify_mmap)( Addr a, Bool allow_SkFileV, Int use_fd )
    map.rw   = is_rw_map;
    map.ro   = is_ro_map;
    VG_(addToXA)(di->fsm.maps, &map);
+   debugInfo_list_changed();
 
    /* Update flags about what kind of mappings we've already seen. */
    di->fsm.have_rx_map |= is_rx_map;
@@ -1300,6 +1481,7 @@ void VG_(di_notify_pdb_debuginfo)( Int fd_obj, Addr avma_obj,
      // JRS fixme: take notice of return value from read_pdb_debug_info,
      // and handle failure
      vg_assert(di->have_dinfo); // fails if PDB read failed
+     debugInfo_list_changed();
      VG_(am_munmap_valgrind)( (Addr)pdbimage, n_pdbimage );
      VG_(close)(fd_pdbimage);
 
@@ -1524,6 +1706,180 @@ void VG_(delete_IIPC)(InlIPCursor *iipc)
 }
 
 
+/*------------------------------------------------------------*/
+/*--- Finding the DebugInfo for a code address             ---*/
+/*------------------------------------------------------------*/
+
+/* Rather than walking debugInfo_list and checking each DebugInfo's
+   ranges in turn, code addresses are looked up in two sorted arrays:
+   one of the r-x mappings of all the DebugInfos, and one of their
+   text ranges.  Both are rebuilt the first time they are needed after
+   debugInfo_list_gen moves on.  If the ranges of different
+   DebugInfos overlap, which shouldn't happen, the answer would depend
+   on the order of debugInfo_list, so the array is not used and the
+   list is walked as before. */
+typedef
+   struct {
+      Addr       lo;   /* [lo, hi] */
+      Addr       hi;
+      DebugInfo* di;
+   }
+   DiRange;
+
+typedef
+   struct {
+      XArray* ranges;  /* of DiRange, sorted by lo; NULL if unusable */
+      UInt    gen;
+   }
+   DiRangeIndex;
+
+static DiRangeIndex rx_index   = { NULL, 0 };
+static DiRangeIndex text_index = { NULL, 0 };
+static Bool         range_indices_made = False;
+
+static Int cmp_DiRange ( const void* v1, const void* v2 )
+{
+   const DiRange* r1 = v1;
+   const DiRange* r2 = v2;
+   if (r1->lo < r2->lo) return -1;
+   if (r1->lo > r2->lo) return 1;
+   return 0;
+}
+
+static void add_DiRange ( XArray* ranges, Addr a, SizeT len, DebugInfo* di )
+{
+   DiRange r;
+   if (len == 0)
+      return;
+   r.lo = a;
+   r.hi = a + len - 1;
+   r.di = di;
+   VG_(addToXA)(ranges, &r);
+}
+
+/* Sort the ranges.  Returns False if any overlap. */
+static Bool sort_DiRanges ( XArray* ranges )
+{
+   Word i, n = VG_(sizeXA)(ranges);
+   VG_(setCmpFnXA)(ranges, cmp_DiRange);
+   VG_(sortXA)(ranges);
+   for (i = 1; i < n; i++) {
+      const DiRange* prev = VG_(indexXA)(ranges, i-1);
+      const DiRange* here = VG_(indexXA)(ranges, i);
+      if (here->lo <= prev->hi)
+         return False;
+   }
+   return True;
+}
+
+static void remake_range_indices ( void )
+{
+   DebugInfo* di;
+   Word       i;
+   XArray*    rx   = VG_(newXA)(ML_(dinfo_zalloc), "di.debuginfo.rri.1",
+                                ML_(dinfo_free), sizeof(DiRange));
+   XArray*    text = VG_(newXA)(ML_(dinfo_zalloc), "di.debuginfo.rri.2",
+                                ML_(dinfo_free), sizeof(DiRange));
+
+   for (di = debugInfo_list; di != NULL; di = di->next) {
+      for (i = 0; i < VG_(sizeXA)(di->fsm.maps); i++) {
+         struct _DebugInfoMapping* map = VG_(indexXA)(di->fsm.maps, i);
+         if (map->rx)
+            add_DiRange(rx, map->avma, map->size, di);
+      }
+      if (di->text_present)
+         add_DiRange(text, di->text_avma, di->text_size, di);
+   }
+   if (rx_index.ranges)
+      VG_(deleteXA)(rx_index.ranges);
+   if (text_index.ranges)
+      VG_(deleteXA)(text_index.ranges);
+   if (!sort_DiRanges(rx)) {
+      VG_(deleteXA)(rx);
+      rx = NULL;
+   }
+   if (!sort_DiRanges(text)) {
+      VG_(deleteXA)(text);
+      text = NULL;
+   }
+   rx_index.ranges   = rx;
+   rx_index.gen      = debugInfo_list_gen;
+   text_index.ranges = text;
+   text_index.gen    = debugInfo_list_gen;
+   range_indices_made = True;
+}
+
+/* Look up ptr in ix.  Returns False if ix can't be used, else True,
+   setting *pdi to the DebugInfo whose range holds ptr, or NULL. */
+static Bool lookup_DiRange ( DiRangeIndex* ix, Addr ptr,
+                             /*OUT*/DebugInfo** pdi )
+{
+   Word lo, hi, mid;
+   if (!range_indices_made || ix->gen != debugInfo_list_gen)
+      remake_range_indices();
+   if (ix->ranges == NULL)
+      return False;
+   /* Find the last range starting at or below ptr. */
+   lo = 0;
+   hi = VG_(sizeXA)(ix->ranges) - 1;
+   *pdi = NULL;
+   while (lo <= hi) {
+      const DiRange* r;
+      mid = (lo + hi) / 2;
+      r   = VG_(indexXA)(ix->ranges, mid);
+      if (ptr < r->lo) {
+         hi = mid - 1;
+      } else {
+         if (ptr <= r->hi) {
+            *pdi = r->di;
+            break;
+         }
+         lo = mid + 1;
+      }
+   }
+   return True;
+}
+
+
+/* A direct-mapped cache of the symbol and line table entries of code
+   addresses, for the tools which look the same few up over and over.
+   It is only valid for one debugInfo_list_gen.  Symbolisation is done
+   holding the big lock, so one cache serves all the threads. */
+#define N_CODE_ADDR_CACHE 1021   /* prime */
+
+typedef
+   struct {
+      Addr       a;
+      UInt       gen;
+      /* search_all_symtabs(a, .., match_anywhere_in_sym, True) */
+      Bool       sym_known;
+      Bool       sym_anywhere;
+      DebugInfo* sym_di;
+      Word       symno;
+      /* search_all_loctabs(a, ..) */
+      Bool       loc_known;
+      DebugInfo* loc_di;
+      Word       locno;
+   }
+   CodeAddrCacheEnt;
+
+static CodeAddrCacheEnt code_addr_cache[N_CODE_ADDR_CACHE];
+
+/* The entry for a, which is emptied if it was for a different address
+   or generation. */
+static inline CodeAddrCacheEnt* code_addr_cache_ent ( Addr a )
+{
+   CodeAddrCacheEnt* ce = &code_addr_cache[a % N_CODE_ADDR_CACHE];
+   if (ce->a != a || ce->gen != debugInfo_list_gen) {
+      ce->a         = a;
+      ce->gen       = debugInfo_list_gen;
+      ce->sym_known = False;
+      ce->loc_known = False;
+   }
+   return ce;
+}
+
+
 /*------------------------------------------------------------*/
 /*--- Use of symbol table & location info to create        ---*/
 /*--- plausible-looking stack dumps.                       ---*/
@@ -1544,6 +1900,34 @@ static void search_all_symtabs ( Addr ptr, /*OUT*/DebugInfo** pdi,
    DebugInfo* di;
    Bool       inRange;
 
+   if (findText) {
+      CodeAddrCacheEnt* ce = code_addr_cache_ent(ptr);
+      if (ce->sym_known && ce->sym_anywhere == match_anywhere_in_sym) {
+         *pdi   = ce->sym_di;
+         *symno = ce->symno;
+         return;
+      }
+      /* Consider any symbol in the r-x mapped area to be text.  See
+         Comment_Regarding_Text_Range_Checks in storage.c for
+         details. */
+      if (lookup_DiRange(&rx_index, ptr, &di)) {
+         *pdi = NULL;
+         if (di != NULL) {
+            sno = ML_(search_one_symtab) ( 
+                     di, ptr, match_anywhere_in_sym, findText );
+            if (sno != -1) {
+               *symno = sno;
+               *pdi   = di;
+            }
+         }
+         ce->sym_known    = True;
+         ce->sym_anywhere = match_anywhere_in_sym;
+         ce->sym_di       = *pdi;
+         ce->symno        = *pdi ? *symno : -1;
+         return;
+      }
+   }
+
    for (di = debugInfo_list; di != NULL; di = di->next) {
 
       if (findText) {
@@ -1602,11 +1986,37 @@ static void search_all_loctabs ( Addr ptr, /*OUT*/DebugInfo** pdi,
 {
    Word       lno;
    DebugInfo* di;
+   CodeAddrCacheEnt* ce = code_addr_cache_ent(ptr);
+
+   if (ce->loc_known) {
+      *pdi   = ce->loc_di;
+      *locno = ce->locno;
+      return;
+   }
+   if (lookup_DiRange(&text_index, ptr, &di)) {
+      *pdi = NULL;
+      if (di != NULL) {
+         ensure_dwarf_read(di);
+         lno = ML_(search_one_loctab) ( di, ptr );
+         if (lno != -1) {
+            *locno = lno;
+            *pdi   = di;
+         }
+      }
+      /* Reading di's DWARF just now will have emptied ce. */
+      ce = code_addr_cache_ent(ptr);
+      ce->loc_known = True;
+      ce->loc_di    = *pdi;
+      ce->locno     = *pdi ? *locno : -1;
+      return;
+   }
+
    for (di = debugInfo_list; di != NULL; di = di->next) {
       if (di->text_present
           && di->text_size > 0
           && di->text_avma <= ptr 
           && ptr < di->text_avma + di->text_size) {
+         ensure_dwarf_read(di);
          lno = ML_(search_one_loctab) ( di, ptr );
          if (lno == -1) goto not_found;
          *locno = lno;
@@ -1642,8 +2052,8 @@ Bool get_sym_name ( Bool do_cxx_demangling, Bool do_z_demangling,
       return False;
 
    vg_assert(di->symtab[sno].pri_name);
-   VG_(demangle) ( do_cxx_demangling, do_z_demangling,
-                   di->symtab[sno].pri_name, buf, nbuf );
+   VG_(demangle_interned) ( do_cxx_demangling, do_z_demangling,
+                            di->symtab[sno].pri_name, buf, nbuf );
 
    /* Do the below-main hack */
    // To reduce the endless nuisance of multiple different names 
@@ -1899,6 +2309,8 @@ DebugInfo* VG_(find_DebugInfo) ( Addr a )
 {
    static UWord n_search = 0;
    DebugInfo* di;
+   if (lookup_DiRange(&text_index, a, &di))
+      return di;
    n_search++;
    for (di = debugInfo_list; di != NULL; di = di->next) {
       if (di->text_present
@@ -2452,6 +2864,10 @@ static void find_DiCfSI ( /*OUT*/DebugInfo** diP,
       Word j;
       n_steps++;
 
+      if (UNLIKELY(di->cfi_deferred)
+          && ML_(find_rx_mapping)(di, ip, ip) != NULL)
+         ensure_cfi_read(di);
+
       /* Use the per-DebugInfo summary address ranges to skip
          inapplicable DebugInfos quickly. */
       if (di->cfsi_used == 0)
@@ -2530,21 +2946,57 @@ static void find_DiCfSI ( /*OUT*/DebugInfo** diP,
    once a DebugInfo is read, adding new DiCfSI_m* is not possible
    anymore, as the cfsi_m_pool is frozen once the reading is terminated.
    Also, the cache is invalidated when new debuginfo is read due to
-   an mmap or some debuginfo is discarded due to an munmap. */
-
-// Prime number, giving about 6Kbytes cache on 32 bits,
-//                           12Kbytes cache on 64 bits.
-#define N_CFSI_M_CACHE 509
+   an mmap or some debuginfo is discarded due to an munmap.
+
+   The cache is N_CFSI_M_CACHE_WAYS-way set associative.  Within a
+   set, way 0 holds the most recently used entry: a hit in another
+   way swaps it with way 0, and a miss pushes the others down,
+   evicting the last.  A malloc-heavy program unwinds through the
+   same few hundred return addresses over and over, and a direct
+   mapped cache loses some of them to conflicts.
+
+   On x86 and amd64, an entry also holds a "plan": the unwind rule
+   for its ip, reduced when it is filled in to a kind and four
+   offsets, for the rules which need no CFI expressions.  Nearly all
+   rules are of that form, and VG_(use_CF_info) applies them without
+   going back to the DiCfSI_m. */
+
+#define N_CFSI_M_CACHE_SETS 512  /* must be a power of 2 */
+#define N_CFSI_M_CACHE_WAYS 4
+
+#if defined(VGA_x86) || defined(VGA_amd64)
+/* Kinds of plan.  For the SP and BP kinds, the CFA is the sp or bp
+   plus cfa_off, the ra is at the CFA plus ra_off, the sp is the CFA
+   plus sp_off, and the bp is unchanged if bp_same, else is at the
+   CFA plus bp_off. */
+#define CFSI_PLAN_NONE 0  /* use the DiCfSI_m */
+#define CFSI_PLAN_SP   1
+#define CFSI_PLAN_BP   2
+#endif
 
 typedef
-   struct { Addr ip; DebugInfo* di; DiCfSI_m* cfsi_m; }
+   struct {
+      Addr ip;
+      DebugInfo* di;
+      DiCfSI_m* cfsi_m;
+#     if defined(VGA_x86) || defined(VGA_amd64)
+      UChar plan;
+      UChar bp_same;
+      Int   cfa_off;
+      Int   ra_off;
+      Int   sp_off;
+      Int   bp_off;
+#     endif
+   }
    CFSI_m_CacheEnt;
 
-static CFSI_m_CacheEnt cfsi_m_cache[N_CFSI_M_CACHE];
+static CFSI_m_CacheEnt cfsi_m_cache[N_CFSI_M_CACHE_SETS]
+                                   [N_CFSI_M_CACHE_WAYS];
 
 static void cfsi_m_cache__invalidate ( void ) {
    VG_(memset)(&cfsi_m_cache, 0, sizeof(cfsi_m_cache));
    CF_info_generation++;
+   debugInfo_list_changed();
 }
 
 UInt VG_(CF_info_generation) (void)
@@ -2552,23 +3004,70 @@ UInt VG_(CF_info_generation) (void)
    return CF_info_generation;
 }
 
+/* Fill in ce's plan from its DiCfSI_m. */
+static void cfsi_m_cache__make_plan ( CFSI_m_CacheEnt* ce )
+{
+#  if defined(VGA_x86) || defined(VGA_amd64)
+   const DiCfSI_m* cfsi_m = ce->cfsi_m;
+   ce->plan = CFSI_PLAN_NONE;
+   if (ce->di == (DebugInfo*)1
+       || cfsi_m->ra_how != CFIR_MEMCFAREL
+       || cfsi_m->sp_how != CFIR_CFAREL
+       || (cfsi_m->bp_how != CFIR_SAME && cfsi_m->bp_how != CFIR_MEMCFAREL))
+      return;
+   switch (cfsi_m->cfa_how) {
+      case CFIC_IA_SPREL: ce->plan = CFSI_PLAN_SP; break;
+      case CFIC_IA_BPREL: ce->plan = CFSI_PLAN_BP; break;
+      default: return;
+   }
+   ce->bp_same = cfsi_m->bp_how == CFIR_SAME;
+   ce->cfa_off = cfsi_m->cfa_off;
+   ce->ra_off  = cfsi_m->ra_off;
+   ce->sp_off  = cfsi_m->sp_off;
+   ce->bp_off  = cfsi_m->bp_off;
+#  endif
+}
+
 static inline CFSI_m_CacheEnt* cfsi_m_cache__find ( Addr ip )
 {
-   UWord         hash = ip % N_CFSI_M_CACHE;
-   CFSI_m_CacheEnt* ce = &cfsi_m_cache[hash];
+   UWord            set = (ip ^ (ip >> 9)) & (N_CFSI_M_CACHE_SETS - 1);
+   CFSI_m_CacheEnt* ces = cfsi_m_cache[set];
+   CFSI_m_CacheEnt* ce;
    static UWord  n_q = 0, n_m = 0;
+   Int           w;
 
    n_q++;
    if (0 && 0 == (n_q & 0x1FFFFF))
       VG_(printf)("QQQ %lu %lu\n", n_q, n_m);
 
-   if (LIKELY(ce->ip == ip) && LIKELY(ce->di != NULL)) {
+   if (LIKELY(ces[0].ip == ip) && LIKELY(ces[0].di != NULL)) {
       /* found an entry in the cache .. */
+      ce = &ces[0];
    } else {
-      /* not found in cache.  Search and update. */
-      n_m++;
-      ce->ip = ip;
-      find_DiCfSI( &ce->di, &ce->cfsi_m, ip );
+      for (w = 1; w < N_CFSI_M_CACHE_WAYS; w++) {
+         if (ces[w].ip == ip && ces[w].di != NULL)
+            break;
+      }
+      if (w < N_CFSI_M_CACHE_WAYS) {
+         /* .. in another way; move it to the front. */
+         CFSI_m_CacheEnt tmp = ces[w];
+         ces[w] = ces[0];
+         ces[0] = tmp;
+      } else {
+         /* not found in cache.  Search and update.  (Search before
+            making room, as find_DiCfSI can invalidate the cache.) */
+         DebugInfo* di;
+         DiCfSI_m*  cfsi_m;
+         n_m++;
+         find_DiCfSI( &di, &cfsi_m, ip );
+         for (w = N_CFSI_M_CACHE_WAYS - 1; w > 0; w--)
+            ces[w] = ces[w-1];
+         ces[0].ip     = ip;
+         ces[0].di     = di;
+         ces[0].cfsi_m = cfsi_m;
+         cfsi_m_cache__make_plan(&ces[0]);
+      }
+      ce = &ces[0];
    }
 
    if (UNLIKELY(ce->di == (DebugInfo*)1)) {
@@ -2718,6 +3217,39 @@ Addr ML_(get_CFA) ( Addr ip, Addr sp, Addr fp,
 }
 
 
+#if defined(VGA_x86) || defined(VGA_amd64)
+/* Apply ce's plan to uregs, as VG_(use_CF_info) does, and say where
+   the ra and bp were read from (*bp_slot is 0 if the bp is
+   unchanged). */
+static inline
+Bool use_CF_plan ( const CFSI_m_CacheEnt* ce, /*MOD*/D3UnwindRegs* uregs,
+                   Addr min_accessible, Addr max_accessible,
+                   /*OUT*/Addr* ra_slot, /*OUT*/Addr* bp_slot )
+{
+   Addr cfa, xbp;
+   cfa = ce->cfa_off + (ce->plan == CFSI_PLAN_SP ? uregs->xsp : uregs->xbp);
+   if (UNLIKELY(cfa == 0))
+      return False;
+   *ra_slot = cfa + (Word)ce->ra_off;
+   if (*ra_slot < min_accessible || *ra_slot > max_accessible-sizeof(Addr))
+      return False;
+   if (ce->bp_same) {
+      *bp_slot = 0;
+      xbp = uregs->xbp;
+   } else {
+      *bp_slot = cfa + (Word)ce->bp_off;
+      if (*bp_slot < min_accessible || *bp_slot > max_accessible-sizeof(Addr))
+         return False;
+      xbp = ML_(read_Addr)((void *)*bp_slot);
+   }
+   uregs->xip = ML_(read_Addr)((void *)*ra_slot);
+   uregs->xsp = cfa + (Word)ce->sp_off;
+   uregs->xbp = xbp;
+   return True;
+}
+#endif
+
+
 /* The main function for DWARF2/3 CFI-based stack unwinding.  Given a
    set of registers in UREGS, modify it to hold the register values
    for the previous frame, if possible.  Returns True if successful.
@@ -2760,6 +3292,15 @@ Bool VG_(use_CF_info) ( /*MOD*/D3UnwindRegs* uregsHere,
    if (UNLIKELY(ce == NULL))
       return False; /* no info.  Nothing we can do. */
 
+#  if defined(VGA_x86) || defined(VGA_amd64)
+   /* If the rule has been reduced to a plan, apply that. */
+   if (LIKELY(ce->plan != CFSI_PLAN_NONE)) {
+      Addr ra_slot, bp_slot;
+      return use_CF_plan(ce, uregsHere, min_accessible, max_accessible,
+                         &ra_slot, &bp_slot);
+   }
+#  endif
+
    di = ce->di;
    cfsi_m = ce->cfsi_m;
 
@@ -2847,6 +3388,22 @@ Bool VG_(use_CF_info) ( /*MOD*/D3UnwindRegs* uregsHere,
    return True;
 }
 
+#if defined(VGA_x86) || defined(VGA_amd64)
+Bool VG_(use_CF_info_with_slots) ( /*MOD*/D3UnwindRegs* uregs,
+                                   Addr min_accessible,
+                                   Addr max_accessible,
+                                   /*OUT*/Addr* ra_slot,
+                                   /*OUT*/Addr* bp_slot )
+{
+   CFSI_m_CacheEnt* ce = cfsi_m_cache__find(uregs->xip);
+   if (LIKELY(ce != NULL) && LIKELY(ce->plan != CFSI_PLAN_NONE))
+      return use_CF_plan(ce, uregs, min_accessible, max_accessible,
+                         ra_slot, bp_slot);
+   *ra_slot = *bp_slot = 0;
+   return VG_(use_CF_info)(uregs, min_accessible, max_accessible);
+}
+#endif
+
 
 /*--------------------------------------------------------------*/
 /*---                                                        ---*/
@@ -3393,6 +3950,8 @@ Bool consider_vars_in_frame ( /*MOD*/XArray* /* of HChar */ dname1,
       if (di->text_avma <= ip && ip < di->text_avma + di->text_size)
          break;
    }
+   if (di)
+      ensure_dwarf_read(di);
  
    /* Didn't find it.  Strange -- means ip is a code address outside
       of any mapped text segment.  Unlikely but not impossible -- app
@@ -3535,6 +4094,8 @@ Bool VG_(get_data_description)(
       /* text segment missing? unlikely, but handle it .. */
       if (!di->text_present || di->text_size == 0)
          continue;
+      if (di->dwarf_deferred && is_in_data_of(di, data_addr))
+         ensure_dwarf_read(di);
       /* any var info at all? */
       if (!di->varinfo)
          continue;
@@ -3840,6 +4401,8 @@ void* /* really, XArray* of StackBlock */
       if (di->text_avma <= ip && ip < di->text_avma + di->text_size)
          break;
    }
+   if (di)
+      ensure_dwarf_read(di);
  
    /* Didn't find it.  Strange -- means ip is a code address outside
       of any mapped text segment.  Unlikely but not impossible -- app
@@ -3955,6 +4518,8 @@ void* /* really, XArray* of GlobalBlock */
                        ML_(dinfo_free), sizeof(GlobalBlock) );
    tl_assert(gvars);
 
+   ensure_dwarf_read(di);
+
    /* any var info at all? */
    if (!di->varinfo)
       return gvars;
@@ -4134,6 +4699,16 @@ PtrdiffT VG_(DebugInfo_get_text_bias)(const DebugInfo* di)
    return di->text_present ? di->text_bias : 0;
 }
 
+ULong VG_(DebugInfo_get_handle) ( const DebugInfo *di )
+{
+   return di->handle;
+}
+
+UInt VG_(debugInfo_generation) ( void )
+{
+   return debugInfo_list_gen;
+}
+
 Int VG_(DebugInfo_syms_howmany) ( const DebugInfo *si )
 {
    return si->symtab_used;
@@ -0,0 +1,618 @@
+
+/*--------------------------------------------------------------------*/
+/*--- A persistent cache of read debug info.                       ---*/
+/*---                                                    dicache.c ---*/
+/*--------------------------------------------------------------------*/
+
+/*
+   This file is part of Valgrind, a dynamic binary instrumentation
+   framework.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of the
+   License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+   02111-1307, USA.
+
+   The GNU General Public License is contained in the file COPYING.
+*/
+
+/* An entry, <dir>/<build-id>.vgdi, holds the canonicalised symbol,
+   line number and CFI tables of one object, and its inline info if
+   that was read.  Addresses in it are
+   avmas as they were in the run which wrote it.  An object may be
+   mapped elsewhere in a later run, but its sections have to be in the
+   same places relative to each other, so every address is simply
+   moved by the difference between the old and new text biases.  The
+   entry is only used if that difference is the same for all the
+   sections which carry a bias.
+
+   Loading an entry feeds its contents through ML_(addSym),
+   ML_(addLineInfo), ML_(addInlInfo) and ML_(addDiCfSI), just as the ELF, DWARF and CFI
+   readers do, so the tables are then canonicalised in the usual way.
+   That costs much less than reading them, and means the cached tables
+   go through the same range checks as freshly read ones.
+
+   Entries are native-endian and assume the word size and structure
+   layouts of the Valgrind that wrote them; the header records enough
+   of those to reject an entry written by a different build. */
+
+#include "pub_core_basics.h"
+#include "pub_core_vki.h"
+#include "pub_core_debuginfo.h"
+#include "pub_core_libcbase.h"
+#include "pub_core_libcassert.h"
+#include "pub_core_libcprint.h"
+#include "pub_core_libcfile.h"
+#include "pub_core_libcproc.h"     /* VG_(getpid) */
+#include "pub_core_options.h"
+#include "pub_core_xarray.h"
+#include "pub_core_deduppoolalloc.h"
+#include "priv_misc.h"             /* dinfo_zalloc/free */
+#include "priv_image.h"
+#include "priv_storage.h"
+#include "priv_dicache.h"          /* self */
+
+#define DICACHE_MAGIC   "VGDICAC1"
+#define DICACHE_NO_STR  0xFFFFFFFF
+
+/* The sections which carry a bias: text, data, sdata, rodata, bss
+   and sbss, in that order. */
+#define DICACHE_N_BIASES 6
+
+/* DiCacheHdr.flags */
+#define DICACHE_HAS_INL  1   /* the inline info was read */
+
+typedef
+   struct {
+      HChar    magic[8];
+      UInt     abi;      /* see dicache_abi */
+      UInt     flags;
+      UInt     present;  /* bit i set: section i has a bias */
+      UInt     unused;
+      PtrdiffT bias[DICACHE_N_BIASES];
+      ULong    strs_szB;
+      ULong    n_syms;
+      ULong    n_fndns;
+      ULong    n_locs;
+      ULong    n_inls;
+      ULong    n_cfsi_ms;
+      ULong    n_cfsis;
+      ULong    n_exprs;
+   }
+   DiCacheHdr;
+
+/* Followed by these sections, in this order, each padded to an
+   8-byte boundary: the strings (NUL terminated, referred to by
+   offset), then the records below, then n_cfsi_ms DiCfSI_m and
+   n_exprs CfiExpr. */
+
+/* One per name: a symbol with secondary names has several. */
+typedef
+   struct {
+      SymAVMAs avmas;
+      UInt     size;
+      UInt     name;
+      Bool     isText;
+      Bool     isIFunc;
+   }
+   DiCacheSym;
+
+typedef
+   struct {
+      UInt filename;
+      UInt dirname;      /* or DICACHE_NO_STR */
+   }
+   DiCacheFnDn;
+
+typedef
+   struct {
+      Addr addr;
+      UInt size;
+      UInt lineno;
+      UInt fndn;         /* 1-based index into the fndns, or 0 */
+   }
+   DiCacheLoc;
+
+typedef
+   struct {
+      Addr   addr_lo;
+      Addr   addr_hi;
+      UInt   inlinedfn;  /* or DICACHE_NO_STR */
+      UInt   fndn;       /* as for DiCacheLoc */
+      UInt   lineno;
+      UShort level;
+   }
+   DiCacheInl;
+
+typedef
+   struct {
+      Addr base;
+      UInt len;
+      UInt cfsi_m;       /* 1-based index into the cfsi_ms */
+   }
+   DiCacheCfSI;
+
+static UInt dicache_abi ( void )
+{
+   return (UInt)sizeof(Addr)
+          | ((UInt)sizeof(DiCfSI_m) << 8)
+          | ((UInt)sizeof(CfiExpr) << 16)
+          | ((UInt)sizeof(SymAVMAs) << 24);
+}
+
+static void get_biases ( const struct _DebugInfo* di,
+                         /*OUT*/UInt* present,
+                         /*OUT*/PtrdiffT bias[DICACHE_N_BIASES] )
+{
+   const Bool p[DICACHE_N_BIASES]
+      = { di->text_present, di->data_present, di->sdata_present,
+          di->rodata_present, di->bss_present, di->sbss_present };
+   const PtrdiffT b[DICACHE_N_BIASES]
+      = { di->text_bias, di->data_bias, di->sdata_bias,
+          di->rodata_bias, di->bss_bias, di->sbss_bias };
+   Int i;
+   *present = 0;
+   for (i = 0; i < DICACHE_N_BIASES; i++) {
+      if (p[i])
+         *present |= 1 << i;
+      bias[i] = p[i] ? b[i] : 0;
+   }
+}
+
+static HChar* entry_name ( const HChar* buildid )
+{
+   HChar* name = ML_(dinfo_zalloc)("di.dicache.en.1",
+                                   VG_(strlen)(VG_(clo_debuginfo_cache))
+                                   + VG_(strlen)(buildid) + 8);
+   VG_(sprintf)(name, "%s/%s.vgdi", VG_(clo_debuginfo_cache), buildid);
+   return name;
+}
+
+Bool ML_(dicache_usable) ( const struct _DebugInfo* di )
+{
+   return VG_(clo_debuginfo_cache) != NULL
+          && !VG_(clo_read_var_info)
+          && !di->trace_symtab && !di->trace_cfi
+          && !di->ddump_syms && !di->ddump_line && !di->ddump_frames;
+}
+
+
+/*------------------------------------------------------------*/
+/*--- Loading                                              ---*/
+/*------------------------------------------------------------*/
+
+static inline SizeT sect_szB ( ULong n, SizeT eltSzB )
+{
+   return VG_ROUNDUP(n * eltSzB, 8);
+}
+
+static inline Addr move ( Addr a, PtrdiffT delta )
+{
+   return a == 0 ? 0 : a + delta;
+}
+
+Bool ML_(dicache_load) ( struct _DebugInfo* di, const HChar* buildid )
+{
+   HChar*       name;
+   SysRes       sres;
+   Int          fd;
+   Long         szB;
+   SizeT        off, done;
+   UChar*       img = NULL;
+   DiCacheHdr   hdr;
+   UInt         present;
+   PtrdiffT     bias[DICACHE_N_BIASES];
+   PtrdiffT     delta;
+   const HChar* strs;
+   DiCacheSym*  syms;
+   DiCacheFnDn* fndns;
+   DiCacheLoc*  locs;
+   DiCacheInl*  inls;
+   DiCfSI_m*    cfsi_ms;
+   DiCacheCfSI* cfsis;
+   CfiExpr*     exprs;
+   UInt*        fndn_ixs = NULL;
+   ULong        i;
+   Int          j;
+
+   name = entry_name(buildid);
+   sres = VG_(open)(name, VKI_O_RDONLY, 0);
+   if (sr_isError(sres)) {
+      ML_(dinfo_free)(name);
+      return False;
+   }
+   fd  = sr_Res(sres);
+   szB = VG_(fsize)(fd);
+
+   /* Check the header: is the entry for an object laid out as this
+      one is, and of the size it claims to be? */
+   get_biases(di, &present, bias);
+   if (szB < (Long)sizeof(hdr)
+       || VG_(read)(fd, &hdr, sizeof(hdr)) != sizeof(hdr)
+       || VG_(memcmp)(hdr.magic, DICACHE_MAGIC, sizeof(hdr.magic)) != 0
+       || hdr.abi != dicache_abi()
+       || (VG_(clo_read_inline_info) && !(hdr.flags & DICACHE_HAS_INL))
+       || hdr.present != present
+       || !(present & 1)
+       || hdr.strs_szB  > (ULong)szB
+       || hdr.n_syms    > (ULong)szB || hdr.n_fndns   > (ULong)szB
+       || hdr.n_locs    > (ULong)szB || hdr.n_inls    > (ULong)szB
+       || hdr.n_cfsi_ms > (ULong)szB || hdr.n_cfsis   > (ULong)szB
+       || hdr.n_exprs   > (ULong)szB
+       || sizeof(hdr) + sect_szB(hdr.strs_szB, 1)
+          + sect_szB(hdr.n_syms,    sizeof(DiCacheSym))
+          + sect_szB(hdr.n_fndns,   sizeof(DiCacheFnDn))
+          + sect_szB(hdr.n_locs,    sizeof(DiCacheLoc))
+          + sect_szB(hdr.n_inls,    sizeof(DiCacheInl))
+          + sect_szB(hdr.n_cfsi_ms, sizeof(DiCfSI_m))
+          + sect_szB(hdr.n_cfsis,   sizeof(DiCacheCfSI))
+          + sect_szB(hdr.n_exprs,   sizeof(CfiExpr)) != (ULong)szB)
+      goto bad;
+   delta = bias[0] - hdr.bias[0];
+   for (j = 1; j < DICACHE_N_BIASES; j++)
+      if ((present & (1 << j)) && bias[j] - hdr.bias[j] != delta)
+         goto bad;
+
+   img  = ML_(dinfo_zalloc)("di.dicache.load.1", szB - sizeof(hdr) + 1);
+   done = 0;
+   while (done < szB - sizeof(hdr)) {
+      Int r = VG_(read)(fd, img + done, szB - sizeof(hdr) - done);
+      if (r <= 0)
+         goto bad;
+      done += r;
+   }
+
+   off = 0;
+   strs    = (const HChar*)(img + off);
+   off    += sect_szB(hdr.strs_szB,  1);
+   syms    = (DiCacheSym*)(img + off);
+   off    += sect_szB(hdr.n_syms,    sizeof(DiCacheSym));
+   fndns   = (DiCacheFnDn*)(img + off);
+   off    += sect_szB(hdr.n_fndns,   sizeof(DiCacheFnDn));
+   locs    = (DiCacheLoc*)(img + off);
+   off    += sect_szB(hdr.n_locs,    sizeof(DiCacheLoc));
+   inls    = (DiCacheInl*)(img + off);
+   off    += sect_szB(hdr.n_inls,    sizeof(DiCacheInl));
+   cfsi_ms = (DiCfSI_m*)(img + off);
+   off    += sect_szB(hdr.n_cfsi_ms, sizeof(DiCfSI_m));
+   cfsis   = (DiCacheCfSI*)(img + off);
+   off    += sect_szB(hdr.n_cfsis,   sizeof(DiCacheCfSI));
+   exprs   = (CfiExpr*)(img + off);
+
+   /* Check every reference before changing anything, so that a
+      damaged entry leaves di as it was. */
+   if (hdr.strs_szB == 0 || strs[hdr.strs_szB - 1] != 0)
+      goto bad;
+   for (i = 0; i < hdr.n_syms; i++)
+      if (syms[i].name >= hdr.strs_szB)
+         goto bad;
+   for (i = 0; i < hdr.n_fndns; i++)
+      if (fndns[i].filename >= hdr.strs_szB
+          || (fndns[i].dirname != DICACHE_NO_STR
+              && fndns[i].dirname >= hdr.strs_szB))
+         goto bad;
+   for (i = 0; i < hdr.n_locs; i++)
+      if (locs[i].fndn > hdr.n_fndns
+          || locs[i].size == 0 || locs[i].size > MAX_LOC_SIZE
+          || locs[i].lineno > MAX_LINENO)
+         goto bad;
+   for (i = 0; i < hdr.n_inls; i++)
+      if (inls[i].fndn > hdr.n_fndns
+          || inls[i].addr_lo >= inls[i].addr_hi
+          || inls[i].lineno > MAX_LINENO
+          || (inls[i].inlinedfn != DICACHE_NO_STR
+              && inls[i].inlinedfn >= hdr.strs_szB))
+         goto bad;
+   for (i = 0; i < hdr.n_cfsis; i++)
+      if (cfsis[i].cfsi_m == 0 || cfsis[i].cfsi_m > hdr.n_cfsi_ms
+          || cfsis[i].len == 0 || cfsis[i].len >= 5000000)
+         goto bad;
+   for (i = 0; i < hdr.n_exprs; i++) {
+      const CfiExpr* e = &exprs[i];
+      switch (e->tag) {
+         case Cex_Undef: case Cex_Const: case Cex_CfiReg: case Cex_DwReg:
+            break;
+         case Cex_Deref:
+            if (e->Cex.Deref.ixAddr < 0 || e->Cex.Deref.ixAddr >= i)
+               goto bad;
+            break;
+         case Cex_Unop:
+            if (e->Cex.Unop.ix < 0 || e->Cex.Unop.ix >= i)
+               goto bad;
+            break;
+         case Cex_Binop:
+            if (e->Cex.Binop.ixL < 0 || e->Cex.Binop.ixL >= i
+                || e->Cex.Binop.ixR < 0 || e->Cex.Binop.ixR >= i)
+               goto bad;
+            break;
+         default:
+            goto bad;
+      }
+   }
+   VG_(close)(fd);
+   fd = -1;
+
+   for (i = 0; i < hdr.n_syms; i++) {
+      DiSym sym;
+      sym.avmas     = syms[i].avmas;
+      sym.avmas.main = syms[i].avmas.main + delta;
+      SET_TOCPTR_AVMA(sym.avmas,
+                      move(GET_TOCPTR_AVMA(syms[i].avmas), delta));
+      SET_LOCAL_EP_AVMA(sym.avmas,
+                        move(GET_LOCAL_EP_AVMA(syms[i].avmas), delta));
+      sym.pri_name  = ML_(addStr)(di, strs + syms[i].name, -1);
+      sym.sec_names = NULL;
+      sym.size      = syms[i].size;
+      sym.isText    = syms[i].isText;
+      sym.isIFunc   = syms[i].isIFunc;
+      ML_(addSym)(di, &sym);
+   }
+
+   if (hdr.n_fndns > 0)
+      fndn_ixs = ML_(dinfo_zalloc)("di.dicache.load.2",
+                                   (hdr.n_fndns + 1) * sizeof(UInt));
+   for (i = 0; i < hdr.n_fndns; i++)
+      fndn_ixs[i + 1]
+         = ML_(addFnDn)(di, strs + fndns[i].filename,
+                        fndns[i].dirname == DICACHE_NO_STR
+                           ? NULL : strs + fndns[i].dirname);
+   for (i = 0; i < hdr.n_locs; i++) {
+      Addr a = locs[i].addr + delta;
+      ML_(addLineInfo)(di, locs[i].fndn == 0 ? 0 : fndn_ixs[locs[i].fndn],
+                       a, a + locs[i].size, locs[i].lineno, i);
+   }
+   for (i = 0; VG_(clo_read_inline_info) && i < hdr.n_inls; i++)
+      ML_(addInlInfo)(di, inls[i].addr_lo + delta, inls[i].addr_hi + delta,
+                      inls[i].inlinedfn == DICACHE_NO_STR
+                         ? NULL : ML_(addStr)(di, strs + inls[i].inlinedfn,
+                                              -1),
+                      inls[i].fndn == 0 ? 0 : fndn_ixs[inls[i].fndn],
+                      inls[i].lineno, inls[i].level);
+
+   /* The DiCfSI_m refer to the expressions by index, so they must go
+      in at the same indices. */
+   if (hdr.n_exprs > 0) {
+      vg_assert(di->cfsi_exprs == NULL);
+      di->cfsi_exprs = VG_(newXA)( ML_(dinfo_zalloc), "di.dicache.load.3",
+                                   ML_(dinfo_free), sizeof(CfiExpr) );
+      for (i = 0; i < hdr.n_exprs; i++)
+         VG_(addToXA)(di->cfsi_exprs, &exprs[i]);
+   }
+   for (i = 0; i < hdr.n_cfsis; i++)
+      ML_(addDiCfSI)(di, cfsis[i].base + delta, cfsis[i].len,
+                     &cfsi_ms[cfsis[i].cfsi_m - 1]);
+
+   if (fndn_ixs)
+      ML_(dinfo_free)(fndn_ixs);
+   ML_(dinfo_free)(img);
+   if (VG_(clo_verbosity) > 1)
+      VG_(message)(Vg_DebugMsg, "Using cached debug info from %s\n", name);
+   ML_(dinfo_free)(name);
+   return True;
+
+  bad:
+   if (VG_(clo_verbosity) > 1)
+      VG_(message)(Vg_DebugMsg, "Ignoring unusable debug info cache "
+                                "entry %s\n", name);
+   if (fd >= 0)
+      VG_(close)(fd);
+   if (img)
+      ML_(dinfo_free)(img);
+   ML_(dinfo_free)(name);
+   return False;
+}
+
+
+/*------------------------------------------------------------*/
+/*--- Saving                                               ---*/
+/*------------------------------------------------------------*/
+
+static UInt add_str ( XArray* strs, const HChar* s )
+{
+   UInt off = VG_(sizeXA)(strs);
+   VG_(addBytesToXA)(strs, s, VG_(strlen)(s) + 1);
+   return off;
+}
+
+static UInt cfsi_m_ix_at ( const struct _DebugInfo* di, UWord pos )
+{
+   switch (di->sizeof_cfsi_m_ix) {
+      case 1: return ((UChar*)  di->cfsi_m_ix)[pos];
+      case 2: return ((UShort*) di->cfsi_m_ix)[pos];
+      case 4: return ((UInt*)   di->cfsi_m_ix)[pos];
+      default: vg_assert(0);
+   }
+}
+
+/* Write out the contents of xa, padded to an 8-byte boundary. */
+static Bool write_sect ( Int fd, XArray* xa, SizeT eltSzB )
+{
+   static const UChar zeroes[8] = { 0 };
+   Word  n   = VG_(sizeXA)(xa);
+   SizeT szB = n * eltSzB;
+   SizeT pad = VG_ROUNDUP(szB, 8) - szB;
+   if (n > 0 && VG_(write)(fd, VG_(indexXA)(xa, 0), szB) != (Int)szB)
+      return False;
+   return pad == 0 || VG_(write)(fd, zeroes, pad) == (Int)pad;
+}
+
+void ML_(dicache_save) ( struct _DebugInfo* di, const HChar* buildid )
+{
+   XArray *strs, *syms, *fndns, *locs, *inls, *cfsi_ms, *cfsis;
+   DiCacheHdr hdr;
+   HChar*     name;
+   HChar*     tmpname;
+   SysRes     sres;
+   Int        fd;
+   Bool       ok;
+   UWord      i;
+   UInt       n;
+
+   vg_assert(!di->cfi_deferred && !di->dwarf_deferred);
+   vg_assert(di->cfsi_rd == NULL);
+
+#  define NEW_XA(_szB) \
+      VG_(newXA)(ML_(dinfo_zalloc), "di.dicache.save.1", \
+                 ML_(dinfo_free), (_szB))
+   strs    = NEW_XA(1);
+   syms    = NEW_XA(sizeof(DiCacheSym));
+   fndns   = NEW_XA(sizeof(DiCacheFnDn));
+   locs    = NEW_XA(sizeof(DiCacheLoc));
+   inls    = NEW_XA(sizeof(DiCacheInl));
+   cfsi_ms = NEW_XA(sizeof(DiCfSI_m));
+   cfsis   = NEW_XA(sizeof(DiCacheCfSI));
+#  undef NEW_XA
+   /* So that no string is at offset 0 of an empty table. */
+   add_str(strs, "");
+
+   for (i = 0; i < di->symtab_used; i++) {
+      const DiSym* s = &di->symtab[i];
+      DiCacheSym   rec;
+      VG_(memset)(&rec, 0, sizeof(rec));
+      rec.avmas   = s->avmas;
+      rec.size    = s->size;
+      rec.isText  = s->isText;
+      rec.isIFunc = s->isIFunc;
+      rec.name    = add_str(strs, s->pri_name);
+      VG_(addToXA)(syms, &rec);
+      if (s->sec_names) {
+         HChar** sec;
+         for (sec = s->sec_names; *sec; sec++) {
+            rec.name = add_str(strs, *sec);
+            VG_(addToXA)(syms, &rec);
+         }
+      }
+   }
+
+   n = di->fndnpool ? VG_(sizeDedupPA)(di->fndnpool) : 0;
+   for (i = 1; i <= n; i++) {
+      const FnDn* fndn = VG_(indexEltNumber)(di->fndnpool, i);
+      DiCacheFnDn rec;
+      rec.filename = add_str(strs, fndn->filename);
+      rec.dirname  = fndn->dirname ? add_str(strs, fndn->dirname)
+                                   : DICACHE_NO_STR;
+      VG_(addToXA)(fndns, &rec);
+   }
+
+   for (i = 0; i < di->loctab_used; i++) {
+      DiCacheLoc rec;
+      VG_(memset)(&rec, 0, sizeof(rec));
+      rec.addr   = di->loctab[i].addr;
+      rec.size   = di->loctab[i].size;
+      rec.lineno = di->loctab[i].lineno;
+      rec.fndn   = ML_(fndn_ix)(di, i);
+      VG_(addToXA)(locs, &rec);
+   }
+
+   for (i = 0; i < di->inltab_used; i++) {
+      const DiInlLoc* inl = &di->inltab[i];
+      DiCacheInl rec;
+      VG_(memset)(&rec, 0, sizeof(rec));
+      rec.addr_lo   = inl->addr_lo;
+      rec.addr_hi   = inl->addr_hi;
+      rec.inlinedfn = inl->inlinedfn ? add_str(strs, inl->inlinedfn)
+                                     : DICACHE_NO_STR;
+      rec.fndn      = inl->fndn_ix;
+      rec.lineno    = inl->lineno;
+      rec.level     = inl->level;
+      VG_(addToXA)(inls, &rec);
+   }
+
+   n = di->cfsi_m_pool ? VG_(sizeDedupPA)(di->cfsi_m_pool) : 0;
+   for (i = 1; i <= n; i++)
+      VG_(addToXA)(cfsi_ms, VG_(indexEltNumber)(di->cfsi_m_pool, i));
+
+   /* Turn the finished base/index arrays back into ranges, leaving
+      out the holes.  Merging may have made some ranges longer than
+      ML_(addDiCfSI) accepts, so split those up again. */
+   for (i = 0; i < di->cfsi_used; i++) {
+      UInt ix = cfsi_m_ix_at(di, i);
+      Addr base, end;
+      if (ix == 0)
+         continue;
+      base = di->cfsi_base[i];
+      end  = i + 1 < di->cfsi_used ? di->cfsi_base[i + 1] - 1
+                                   : di->cfsi_maxavma;
+      while (base <= end) {
+         DiCacheCfSI rec;
+         VG_(memset)(&rec, 0, sizeof(rec));
+         rec.base   = base;
+         rec.len    = end - base + 1 > 4000000 ? 4000000
+                                               : (UInt)(end - base + 1);
+         rec.cfsi_m = ix;
+         VG_(addToXA)(cfsis, &rec);
+         base += rec.len;
+      }
+   }
+
+   VG_(memset)(&hdr, 0, sizeof(hdr));
+   VG_(memcpy)(hdr.magic, DICACHE_MAGIC, sizeof(hdr.magic));
+   hdr.abi = dicache_abi();
+   if (VG_(clo_read_inline_info))
+      hdr.flags |= DICACHE_HAS_INL;
+   get_biases(di, &hdr.present, hdr.bias);
+   hdr.strs_szB  = VG_(sizeXA)(strs);
+   hdr.n_syms    = VG_(sizeXA)(syms);
+   hdr.n_fndns   = VG_(sizeXA)(fndns);
+   hdr.n_locs    = VG_(sizeXA)(locs);
+   hdr.n_inls    = VG_(sizeXA)(inls);
+   hdr.n_cfsi_ms = VG_(sizeXA)(cfsi_ms);
+   hdr.n_cfsis   = VG_(sizeXA)(cfsis);
+   hdr.n_exprs   = di->cfsi_exprs ? VG_(sizeXA)(di->cfsi_exprs) : 0;
+
+   /* Write to a temporary and rename it into place, so concurrent
+      runs never see a partially written entry. */
+   name    = entry_name(buildid);
+   tmpname = ML_(dinfo_zalloc)("di.dicache.save.2", VG_(strlen)(name) + 32);
+   VG_(sprintf)(tmpname, "%s.tmp.%d", name, VG_(getpid)());
+   sres = VG_(open)(tmpname, VKI_O_CREAT|VKI_O_TRUNC|VKI_O_WRONLY,
+                    VKI_S_IRUSR|VKI_S_IWUSR|VKI_S_IRGRP|VKI_S_IROTH);
+   if (sr_isError(sres)) {
+      ok = False;
+   } else {
+      fd = sr_Res(sres);
+      ok = VG_(write)(fd, &hdr, sizeof(hdr)) == sizeof(hdr)
+           && write_sect(fd, strs,    1)
+           && write_sect(fd, syms,    sizeof(DiCacheSym))
+           && write_sect(fd, fndns,   sizeof(DiCacheFnDn))
+           && write_sect(fd, locs,    sizeof(DiCacheLoc))
+           && write_sect(fd, inls,    sizeof(DiCacheInl))
+           && write_sect(fd, cfsi_ms, sizeof(DiCfSI_m))
+           && write_sect(fd, cfsis,   sizeof(DiCacheCfSI))
+           && (di->cfsi_exprs == NULL
+               || write_sect(fd, di->cfsi_exprs, sizeof(CfiExpr)));
+      VG_(close)(fd);
+      if (ok)
+         ok = VG_(rename)(tmpname, name) == 0;
+      if (!ok)
+         VG_(unlink)(tmpname);
+   }
+   if (VG_(clo_verbosity) > 1)
+      VG_(message)(Vg_DebugMsg, ok ? "Saved debug info to %s\n"
+                                   : "Could not save debug info to %s\n",
+                   name);
+
+   ML_(dinfo_free)(tmpname);
+   ML_(dinfo_free)(name);
+   VG_(deleteXA)(strs);
+   VG_(deleteXA)(syms);
+   VG_(deleteXA)(fndns);
+   VG_(deleteXA)(locs);
+   VG_(deleteXA)(inls);
+   VG_(deleteXA)(cfsi_ms);
+   VG_(deleteXA)(cfsis);
+}
+
+/*--------------------------------------------------------------------*/
+/*--- end                                                dicache.c ---*/
+/*--------------------------------------------------------------------*/
@@ -41,21 +41,29 @@
 #include "pub_core_libcprint.h"
 #include "pub_core_libcproc.h"     /* VG_(read_millisecond_timer) */
 #include "pub_core_libcfile.h"
+#include "pub_core_options.h"      /* VG_(clo_debuginfo_image_cache) */
 #include "priv_misc.h"             /* dinfo_zalloc/free/strdup */
 #include "priv_image.h"            /* self */
 
 #include "minilzo.h"
 
 #define CACHE_ENTRY_SIZE_BITS (12+1)
-#define CACHE_N_ENTRIES       32
 
 #define CACHE_ENTRY_SIZE      (1 << CACHE_ENTRY_SIZE_BITS)
 
+/* The most blocks a miss may bring in at once (see load_CEnts). */
+#define CACHE_MAX_READAHEAD   32
+
+/* Denotes no entry, in hash chains. */
+#define NO_CENT               0xFFFFFFFF
+
 /* An entry in the cache. */
 typedef
    struct {
       DiOffT off; // file offset for data[0]
       SizeT  used; // 1 .. sizeof(data), or 0 to denote not-in-use
+      UInt   hnext; // next entry in the same hash chain, or NO_CENT
+      Bool   referenced; // used since the clock hand last passed?
       UChar  data[CACHE_ENTRY_SIZE];
    }
    CEnt;
@@ -74,6 +82,9 @@ typedef
       // (that is, using a debuginfo server; hence when is_local==False)
       // Session ID allocated to us by the server.  Cannot be zero.
       ULong session_id;
+      // Does the server take RDBL requests?  Assumed so until it
+      // says otherwise.
+      Bool  rdbl_ok;
    }
    Source;
 
@@ -82,13 +93,31 @@ struct _DiImage {
    Source source;
    // Total size of the image.
    SizeT size;
-   // The number of entries used.  0 .. CACHE_N_ENTRIES
+   // The most recently used entry, which get() looks in first.  Only
+   // NULL while the image is suspended.
+   CEnt* last;
+   // The maximum number of entries, VG_(clo_debuginfo_image_cache)
+   // when the image was made.
+   UInt  ces_size;
+   // The number of entries used.  0 .. ces_size
    UInt  ces_used;
    // Pointers to the entries.  ces[0 .. ces_used-1] are non-NULL.
-   // ces[ces_used .. CACHE_N_ENTRIES-1] are NULL.
-   // The non-NULL entries may be arranged arbitrarily.  We expect to use
-   // a pseudo-LRU scheme though.
-   CEnt* ces[CACHE_N_ENTRIES];
+   // ces[ces_used .. ces_size-1] are NULL.  Once they are all in use,
+   // an entry is recycled using the clock (second chance) algorithm:
+   // the hand sweeps round ces[], clearing the referenced bits, and
+   // stops at the first entry whose bit is already clear.
+   CEnt** ces;
+   UInt   clock_hand;
+   // Hash chains of the entries, by block number.  htab_size is a
+   // power of 2; empty chains are NO_CENT.
+   UInt*  htab;
+   UInt   htab_size;
+   // Readahead.  If a miss is on the block following the blocks the
+   // last miss read, the next miss reads twice as many, up to
+   // ra_max_blocks; otherwise just one (or a few, from a server).
+   DiOffT ra_next;
+   UInt   ra_blocks;
+   UInt   ra_max_blocks;
 };
 
 /* A frame.  The first 4 bytes of |data| give the kind of the frame,
@@ -298,6 +327,21 @@ static Frame* mk_Frame_le64_le64_le64 ( const HChar* tag,
    return f;
 }
 
+static Frame* mk_Frame_le64_le64_le64_le64 ( const HChar* tag, ULong n1,
+                                             ULong n2, ULong n3, ULong n4 )
+{
+   vg_assert(VG_(strlen)(tag) == 4);
+   Frame* f = ML_(dinfo_zalloc)("di.mFllll.1", sizeof(Frame));
+   f->n_data = 4 + 4*8;
+   f->data = ML_(dinfo_zalloc)("di.mFllll.2", f->n_data);
+   VG_(memcpy)(&f->data[0], tag, 4);
+   write_ULong_le(&f->data[4 + 0*8], n1);
+   write_ULong_le(&f->data[4 + 1*8], n2);
+   write_ULong_le(&f->data[4 + 2*8], n3);
+   write_ULong_le(&f->data[4 + 3*8], n4);
+   return f;
+}
+
 static Frame* mk_Frame_asciiz ( const HChar* tag, const HChar* str )
 {
    vg_assert(VG_(strlen)(tag) == 4);
@@ -381,6 +425,43 @@ static Bool parse_Frame_le64_le64_le64_bytes (
    return True;
 }
 
+/* Unpack the RBOK frame answering an RDBL request for [off, +len) in
+   blocks of |blksz| into |dst|.  The frame has the four values from
+   the request, and then for each block its compressed length (le32)
+   and the compressed data. */
+static Bool unpack_Frame_RBOK ( Frame* fr, ULong session_id, DiOffT off,
+                                SizeT len, SizeT blksz, /*OUT*/UChar* dst )
+{
+   UChar* p;
+   UChar* end;
+   SizeT  done;
+
+   if (!fr || !fr->data) return False;
+   if (fr->n_data < 4 + 4*8) return False;
+   if (VG_(memcmp)(&fr->data[0], "RBOK", 4) != 0) return False;
+   if (read_ULong_le(&fr->data[4 + 0*8]) != session_id
+       || read_ULong_le(&fr->data[4 + 1*8]) != off
+       || read_ULong_le(&fr->data[4 + 2*8]) != len
+       || read_ULong_le(&fr->data[4 + 3*8]) != blksz)
+      return False;
+   p   = &fr->data[4 + 4*8];
+   end = &fr->data[fr->n_data];
+   for (done = 0; done < len; done += blksz) {
+      SizeT    want = len - done < blksz ? len - done : blksz;
+      UInt     zlen;
+      lzo_uint out_len = want;
+      if (end - p < 4) return False;
+      zlen = read_UInt_le(p);
+      p += 4;
+      if ((SizeT)(end - p) < zlen) return False;
+      if (lzo1x_decompress_safe(p, zlen, dst + done, &out_len, NULL)
+          != LZO_E_OK || out_len != want)
+         return False;
+      p += zlen;
+   }
+   return p == end;
+}
+
 static DiOffT block_round_down ( DiOffT i )
 {
    return i & ((DiOffT)~(CACHE_ENTRY_SIZE-1));
@@ -389,64 +470,112 @@ static DiOffT block_round_down ( DiOffT i )
 /* Is this offset inside this CEnt? */
 static inline Bool is_in_CEnt ( CEnt* cent, DiOffT off )
 {
-   /* This assertion is checked by set_CEnt, so checking it here has
+   /* This assertion is checked by load_CEnts, so checking it here has
       no benefit, whereas skipping it does remove it from the hottest
       path. */
    /* vg_assert(cent->used > 0 && cent->used <= CACHE_ENTRY_SIZE); */
    return cent->off <= off && off < cent->off + cent->used;
 }
 
-/* Allocate a new CEnt, connect it to |img|, and return its index. */
-static UInt alloc_CEnt ( DiImage* img )
+static inline UInt hash_block ( DiImage* img, DiOffT off )
 {
-   vg_assert(img);
-   vg_assert(img->ces_used < CACHE_N_ENTRIES);
-   UInt entNo = img->ces_used;
-   img->ces_used++;
-   vg_assert(img->ces[entNo] == NULL);
-   img->ces[entNo] = ML_(dinfo_zalloc)("di.alloc_CEnt.1", sizeof(CEnt));
+   return (UInt)(off >> CACHE_ENTRY_SIZE_BITS) & (img->htab_size - 1);
+}
+
+/* Set up an empty cache for |img|. */
+static void init_cache ( DiImage* img )
+{
+   UInt i;
+   img->ces_size = VG_(clo_debuginfo_image_cache);
+   vg_assert(img->ces_size >= 32);
+   img->ces = ML_(dinfo_zalloc)("di.image.init_cache.1",
+                                img->ces_size * sizeof(CEnt*));
+   img->htab_size = 1;
+   while (img->htab_size < img->ces_size)
+      img->htab_size <<= 1;
+   img->htab = ML_(dinfo_zalloc)("di.image.init_cache.2",
+                                 img->htab_size * sizeof(UInt));
+   for (i = 0; i < img->htab_size; i++)
+      img->htab[i] = NO_CENT;
+   img->ces_used   = 0;
+   img->clock_hand = 0;
+   img->last       = NULL;
+   img->ra_next    = DiOffT_INVALID;
+   img->ra_blocks  = 0;
+   img->ra_max_blocks = img->ces_size / 4;
+   if (img->ra_max_blocks > CACHE_MAX_READAHEAD)
+      img->ra_max_blocks = CACHE_MAX_READAHEAD;
+}
+
+/* Free all the entries, leaving the cache empty. */
+static void empty_cache ( DiImage* img )
+{
+   UInt i;
+   vg_assert(img->ces_used <= img->ces_size);
+   for (i = 0; i < img->ces_used; i++) {
+      ML_(dinfo_free)(img->ces[i]);
+      img->ces[i] = NULL;
+   }
+   for (i = 0; i < img->htab_size; i++)
+      img->htab[i] = NO_CENT;
+   img->ces_used   = 0;
+   img->clock_hand = 0;
+   img->last       = NULL;
+   img->ra_next    = DiOffT_INVALID;
+}
+
+/* Find the entry holding the block containing |off|, or NO_CENT. */
+static UInt find_CEnt ( DiImage* img, DiOffT off )
+{
+   DiOffT blk   = block_round_down(off);
+   UInt   entNo = img->htab[hash_block(img, off)];
+   while (entNo != NO_CENT && img->ces[entNo]->off != blk)
+      entNo = img->ces[entNo]->hnext;
    return entNo;
 }
 
-/* Move the given entry to the top and slide those above it down by 1,
-   to make space. */
-static void move_CEnt_to_top ( DiImage* img, UInt entNo )
+static void unlink_CEnt ( DiImage* img, UInt entNo )
 {
-   vg_assert(img->ces_used <= CACHE_N_ENTRIES);
-   vg_assert(entNo > 0 && entNo < img->ces_used);
-   CEnt* tmp = img->ces[entNo];
-   while (entNo > 0) {
-      img->ces[entNo] = img->ces[entNo-1];
-      entNo--;
+   UInt* p = &img->htab[hash_block(img, img->ces[entNo]->off)];
+   while (*p != entNo) {
+      vg_assert(*p != NO_CENT);
+      p = &img->ces[*p]->hnext;
    }
-   img->ces[0] = tmp;
+   *p = img->ces[entNo]->hnext;
 }
 
-/* Set the given entry so that it has a chunk of the file containing
-   the given offset.  It is this function that brings data into the
-   cache, either by reading the local file or pulling it from the
-   remote server. */
-static void set_CEnt ( DiImage* img, UInt entNo, DiOffT off )
+/* Get an entry to put a new block in: a new one if the cache isn't
+   full yet, else the one the clock hand picks, taken out of its hash
+   chain. */
+static UInt get_free_CEnt ( DiImage* img )
+{
+   vg_assert(img->ces_used <= img->ces_size);
+   if (img->ces_used < img->ces_size) {
+      UInt entNo = img->ces_used;
+      img->ces_used++;
+      vg_assert(img->ces[entNo] == NULL);
+      img->ces[entNo] = ML_(dinfo_zalloc)("di.alloc_CEnt.1", sizeof(CEnt));
+      return entNo;
+   }
+   while (True) {
+      UInt  entNo = img->clock_hand;
+      CEnt* ce    = img->ces[entNo];
+      img->clock_hand = entNo + 1 == img->ces_size ? 0 : entNo + 1;
+      if (ce->referenced) {
+         ce->referenced = False;
+         continue;
+      }
+      unlink_CEnt(img, entNo);
+      return entNo;
+   }
+}
+
+/* Read [off, +len) of the image into |dst|, either from the local
+   file or from the remote server. */
+static void read_chunk ( DiImage* img, /*OUT*/UChar* dst,
+                         DiOffT off, SizeT len )
 {
-   SizeT len;
-   DiOffT off_orig = off;
-   vg_assert(img);
-   vg_assert(img->ces_used <= CACHE_N_ENTRIES);
-   vg_assert(entNo >= 0 && entNo < img->ces_used);
-   vg_assert(off < img->size);
-   vg_assert(img->ces[entNo] != NULL);
-   /* Compute [off, +len) as the slice we are going to read. */
-   off = block_round_down(off);
-   len = img->size - off;
-   if (len > CACHE_ENTRY_SIZE) len = CACHE_ENTRY_SIZE;
-   /* It is conceivable that the 'len > 0' bit could fail if we make
-      an image with a zero sized file.  But then no 'get' request on
-      that image would be valid. */
-   vg_assert(len > 0 && len <= CACHE_ENTRY_SIZE);
    vg_assert(off + len <= img->size);
-   vg_assert(off <= off_orig && off_orig < off+len);
-   /* So, read  off .. off+len-1  into the entry. */
-   CEnt* ce = img->ces[entNo];
 
    if (0) {
       static UInt t_last = 0;
@@ -461,14 +590,37 @@ static void set_CEnt ( DiImage* img, UInt entNo, DiOffT off )
 
    if (img->source.is_local) {
       // Simple: just read it
-      SysRes sr = VG_(pread)(img->source.fd, &ce->data[0], (Int)len, off);
+      SysRes sr = VG_(pread)(img->source.fd, dst, (Int)len, off);
       vg_assert(!sr_isError(sr));
    } else {
       // Not so simple: poke the server
       vg_assert(img->source.session_id > 0);
-      Frame* req
-         = mk_Frame_le64_le64_le64("READ", img->source.session_id, off, len);
-      Frame* res = do_transaction(img->source.fd, req);
+      Frame* req;
+      Frame* res;
+      if (img->source.rdbl_ok) {
+         /* Ask for the range as separately compressed blocks, which
+            the server can cache and give to other clients too. */
+         UChar* reason = NULL;
+         req = mk_Frame_le64_le64_le64_le64("RDBL", img->source.session_id,
+                                            off, len, CACHE_ENTRY_SIZE);
+         res = do_transaction(img->source.fd, req);
+         free_Frame(req); req = NULL;
+         if (!res) goto server_fail;
+         if (unpack_Frame_RBOK(res, img->source.session_id, off, len,
+                               CACHE_ENTRY_SIZE, dst)) {
+            free_Frame(res); res = NULL;
+            goto end_of_else_clause;
+         }
+         if (!parse_Frame_asciiz(res, "FAIL", &reason)
+             || VG_(strcmp)((const HChar*)reason,
+                            "Invalid request frame type") != 0)
+            goto server_fail;
+         /* An older server, which only knows READ. */
+         img->source.rdbl_ok = False;
+         free_Frame(res); res = NULL;
+      }
+      req = mk_Frame_le64_le64_le64("READ", img->source.session_id, off, len);
+      res = do_transaction(img->source.fd, req);
       free_Frame(req); req = NULL;
       if (!res) goto server_fail;
       ULong  rx_session_id = 0, rx_off = 0, rx_len = 0, rx_zdata_len = 0;
@@ -488,14 +640,14 @@ static void set_CEnt ( DiImage* img, UInt entNo, DiOffT off )
           || rx_off != off || rx_len != len || rx_data == NULL)
          goto server_fail;
 
-      //VG_(memcpy)(&ce->data[0], rx_data, len);
+      //VG_(memcpy)(dst, rx_data, len);
       // Decompress into the destination buffer
       // Tell the lib the max number of output bytes it can write.
       // After the call, this holds the number of bytes actually written,
       // and it's an error if it is different.
       lzo_uint out_len = len;
       Int lzo_rc = lzo1x_decompress_safe(rx_data, rx_zdata_len,
-                                         &ce->data[0], &out_len,
+                                         dst, &out_len,
                                          NULL);
       Bool ok = lzo_rc == LZO_E_OK && out_len == len;
       if (!ok) goto server_fail;
@@ -507,15 +659,15 @@ static void set_CEnt ( DiImage* img, UInt entNo, DiOffT off )
       if (res) {
          UChar* reason = NULL;
          if (parse_Frame_asciiz(res, "FAIL", &reason)) {
-            VG_(umsg)("set_CEnt (reading data from DI server): fail: "
+            VG_(umsg)("read_chunk (reading data from DI server): fail: "
                       "%s\n", reason);
          } else {
-            VG_(umsg)("set_CEnt (reading data from DI server): fail: "
+            VG_(umsg)("read_chunk (reading data from DI server): fail: "
                       "unknown reason\n");
          }
          free_Frame(res); res = NULL;
       } else {
-         VG_(umsg)("set_CEnt (reading data from DI server): fail: "
+         VG_(umsg)("read_chunk (reading data from DI server): fail: "
                    "server unexpectedly closed the connection\n");
       }
       give_up__comms_lost();
@@ -524,62 +676,112 @@ static void set_CEnt ( DiImage* img, UInt entNo, DiOffT off )
      end_of_else_clause:
       {}
    }
-   
-   ce->off  = off;
-   ce->used = len;
-   vg_assert(ce->used > 0 && ce->used <= CACHE_ENTRY_SIZE);
 }
 
-__attribute__((noinline))
-static UChar get_slowcase ( DiImage* img, DiOffT off )
+/* Bring the block containing |off| into the cache, and return its
+   entry number.  It is this function that brings data into the cache.
+   If the last few misses were on consecutive blocks, the following
+   blocks are likely to be wanted too, so a run of them is read with
+   the one asked for, in one read or server request.  From a server
+   that saves round trips, and the run compresses better than its
+   blocks would one by one. */
+static UInt load_CEnts ( DiImage* img, DiOffT off )
 {
-   /* Stay sane .. */
+   DiOffT start = block_round_down(off);
+   UInt   n, i, entNo = NO_CENT;
+   SizeT  len;
+   UChar* buf;
+
    vg_assert(off < img->size);
-   vg_assert(img->ces_used <= CACHE_N_ENTRIES);
-   UInt i;
-   /* Start the search at entry 1, since the fast-case function
-      checked slot zero already. */
-   for (i = 1; i < img->ces_used; i++) {
-      vg_assert(img->ces[i]);
-      if (is_in_CEnt(img->ces[i], off))
-         break;
+   if (start == img->ra_next) {
+      img->ra_blocks *= 2;
+      if (img->ra_blocks > img->ra_max_blocks)
+         img->ra_blocks = img->ra_max_blocks;
+   } else {
+      img->ra_blocks = img->source.is_local ? 1 : 4;
+      if (img->ra_blocks > img->ra_max_blocks)
+         img->ra_blocks = img->ra_max_blocks;
    }
-   vg_assert(i <= img->ces_used);
-   if (i == img->ces_used) {
-      /* It's not in any entry.  Either allocate a new entry or
-         recycle the LRU one. */
-      if (img->ces_used == CACHE_N_ENTRIES) {
-         /* All entries in use.  Recycle the (ostensibly) LRU one. */
-         set_CEnt(img, CACHE_N_ENTRIES-1, off);
-         i = CACHE_N_ENTRIES-1;
-      } else {
-         /* Allocate a new one, and fill it in. */
-         UInt entNo = alloc_CEnt(img);
-         set_CEnt(img, entNo, off);
-         i = entNo;
-      }
+   if (img->ra_blocks == 0)
+      img->ra_blocks = 1;
+
+   /* Stop at the end of the image, or at a block already cached. */
+   n = 1;
+   while (n < img->ra_blocks
+          && start + (DiOffT)n * CACHE_ENTRY_SIZE < img->size
+          && find_CEnt(img, start + (DiOffT)n * CACHE_ENTRY_SIZE) == NO_CENT)
+      n++;
+   len = img->size - start;
+   if (len > (SizeT)n * CACHE_ENTRY_SIZE)
+      len = (SizeT)n * CACHE_ENTRY_SIZE;
+   /* It is conceivable that the 'len > 0' bit could fail if we make
+      an image with a zero sized file.  But then no 'get' request on
+      that image would be valid. */
+   vg_assert(len > 0);
+   img->ra_next = start + len;
+
+   if (n == 1) {
+      entNo = get_free_CEnt(img);
+      buf   = &img->ces[entNo]->data[0];
    } else {
-      /* We found it at position 'i'. */
-      vg_assert(i > 0);
+      buf   = ML_(dinfo_zalloc)("di.image.load_CEnts.1", len);
    }
-   if (i > 0) {
-      move_CEnt_to_top(img, i);
-      i = 0;
+   read_chunk(img, buf, start, len);
+
+   /* Each block goes in with its referenced bit set, so the clock
+      hand can't take one of them for a later block of the run (it
+      never brings in more than a quarter of the cache). */
+   for (i = 0; i < n; i++) {
+      DiOffT blk  = start + (DiOffT)i * CACHE_ENTRY_SIZE;
+      SizeT  used = len - (SizeT)i * CACHE_ENTRY_SIZE;
+      UInt   e;
+      CEnt*  ce;
+      if (used > CACHE_ENTRY_SIZE) used = CACHE_ENTRY_SIZE;
+      e  = n == 1 ? entNo : get_free_CEnt(img);
+      ce = img->ces[e];
+      if (n > 1)
+         VG_(memcpy)(&ce->data[0], buf + (SizeT)i * CACHE_ENTRY_SIZE, used);
+      ce->off        = blk;
+      ce->used       = used;
+      ce->referenced = True;
+      vg_assert(ce->used > 0 && ce->used <= CACHE_ENTRY_SIZE);
+      ce->hnext      = img->htab[hash_block(img, blk)];
+      img->htab[hash_block(img, blk)] = e;
+      if (i == 0)
+         entNo = e;
    }
-   vg_assert(is_in_CEnt(img->ces[i], off));
-   return img->ces[i]->data[ off - img->ces[i]->off ];
+   if (n > 1)
+      ML_(dinfo_free)(buf);
+
+   vg_assert(is_in_CEnt(img->ces[entNo], off));
+   return entNo;
+}
+
+__attribute__((noinline))
+static UChar get_slowcase ( DiImage* img, DiOffT off )
+{
+   /* Stay sane .. */
+   vg_assert(off < img->size);
+   UInt entNo = find_CEnt(img, off);
+   if (entNo == NO_CENT)
+      entNo = load_CEnts(img, off);
+   else
+      img->ces[entNo]->referenced = True;
+   img->last = img->ces[entNo];
+   vg_assert(is_in_CEnt(img->last, off));
+   return img->last->data[ off - img->last->off ];
 }
 
 // This is called a lot, so do the usual fast/slow split stuff on it. */
 static inline UChar get ( DiImage* img, DiOffT off )
 {
-   /* Most likely case is, it's in the ces[0] position. */
-   /* ML_(img_from_local_file) requests a read for ces[0] when
-      creating the image.  Hence slot zero is always non-NULL, so we
-      can skip this test. */
-   if (LIKELY(/* img->ces[0] != NULL && */
-              is_in_CEnt(img->ces[0], off))) {
-      return img->ces[0]->data[ off - img->ces[0]->off ];
+   /* Most likely case is, it's in the last entry used. */
+   /* ML_(img_from_local_file) loads the first block when creating
+      the image.  Hence img->last is always non-NULL, so we can skip
+      this test. */
+   if (LIKELY(/* img->last != NULL && */
+              is_in_CEnt(img->last, off))) {
+      return img->last->data[ off - img->last->off ];
    }
    /* Else we'll have to fish around for it. */
    return get_slowcase(img, off);
@@ -614,19 +816,16 @@ DiImage* ML_(img_from_local_file)(const HChar* fullpath)
    img->source.is_local = True;
    img->source.fd       = sr_Res(fd);
    img->size            = size;
-   img->ces_used        = 0;
    img->source.name     = ML_(dinfo_strdup)("di.image.ML_iflf.2", fullpath);
-   /* img->ces is already zeroed out */
+   init_cache(img);
    vg_assert(img->source.fd >= 0);
 
-   /* Force the zeroth entry to be the first chunk of the file.
-      That's likely to be the first part that's requested anyway, and
-      loading it at this point forcing img->cent[0] to always be
-      non-empty, thereby saving us an is-it-empty check on the fast
+   /* Load the first chunk of the file and make it the last entry
+      used.  That's likely to be the first part that's requested
+      anyway, and loading it at this point means img->last is always
+      non-NULL, thereby saving us an is-it-empty check on the fast
       path in get(). */
-   UInt entNo = alloc_CEnt(img);
-   vg_assert(entNo == 0);
-   set_CEnt(img, 0, 0);
+   img->last = img->ces[load_CEnts(img, 0)];
 
    return img;
 }
@@ -699,21 +898,19 @@ DiImage* ML_(img_from_di_server)(const HChar* filename,
    img->source.is_local   = False;
    img->source.fd         = sd;
    img->source.session_id = session_id;
+   img->source.rdbl_ok    = True;
    img->size              = size;
-   img->ces_used          = 0;
    img->source.name       = ML_(dinfo_zalloc)("di.image.ML_ifds.2",
                                               20 + VG_(strlen)(filename)
                                                  + VG_(strlen)(serverAddr));
    VG_(sprintf)(img->source.name, "%s at %s", filename, serverAddr);
 
-   /* img->ces is already zeroed out */
+   init_cache(img);
    vg_assert(img->source.fd >= 0);
 
    /* See comment on equivalent bit in ML_(img_from_local_file) for
       rationale. */
-   UInt entNo = alloc_CEnt(img);
-   vg_assert(entNo == 0);
-   set_CEnt(img, 0, 0);
+   img->last = img->ces[load_CEnts(img, 0)];
 
    return img;
 
@@ -741,9 +938,10 @@ void ML_(img_done)(DiImage* img)
 {
    vg_assert(img);
    if (img->source.is_local) {
-      /* Close the file; nothing else to do. */
+      /* Close the file, unless the image is suspended. */
       vg_assert(img->source.session_id == 0);
-      VG_(close)(img->source.fd);
+      if (img->source.fd >= 0)
+         VG_(close)(img->source.fd);
    } else {
       /* Close the socket.  The server can detect this and will scrub
          the connection when it happens, so there's no need to tell it
@@ -753,19 +951,56 @@ void ML_(img_done)(DiImage* img)
    }
 
    /* Free up the cache entries, ultimately |img| itself. */
-   UInt i;
-   vg_assert(img->ces_used <= CACHE_N_ENTRIES);
-   for (i = 0; i < img->ces_used; i++) {
-      ML_(dinfo_free)(img->ces[i]);
-   }
-   /* Take the opportunity to sanity check the rest. */
-   for (i = i; i < img->ces_used; i++) {
-      vg_assert(img->ces[i] == NULL);
-   }
+   empty_cache(img);
+   ML_(dinfo_free)(img->ces);
+   ML_(dinfo_free)(img->htab);
    ML_(dinfo_free)(img->source.name);
    ML_(dinfo_free)(img);
 }
 
+Bool ML_(img_is_local)(const DiImage* img)
+{
+   vg_assert(img);
+   return img->source.is_local;
+}
+
+void ML_(img_suspend)(DiImage* img)
+{
+   vg_assert(img);
+   vg_assert(img->source.is_local);
+   vg_assert(img->source.fd >= 0);
+   VG_(close)(img->source.fd);
+   img->source.fd = -1;
+   empty_cache(img);
+}
+
+Bool ML_(img_resume)(DiImage* img)
+{
+   SysRes         fd;
+   struct vg_stat stat_buf;
+
+   vg_assert(img);
+   vg_assert(img->source.is_local);
+   vg_assert(img->source.fd == -1);
+   vg_assert(img->ces_used == 0);
+
+   fd = VG_(open)(img->source.name, VKI_O_RDONLY, 0);
+   if (sr_isError(fd))
+      return False;
+   /* A file of a different size is not the one we read before. */
+   if (VG_(fstat)(sr_Res(fd), &stat_buf) != 0
+       || stat_buf.size != (DiOffT)img->size) {
+      VG_(close)(sr_Res(fd));
+      return False;
+   }
+   img->source.fd = sr_Res(fd);
+
+   /* Restore the invariant that img->last is non-NULL; see
+      ML_(img_from_local_file). */
+   img->last = img->ces[load_CEnts(img, 0)];
+   return True;
+}
+
 DiOffT ML_(img_size)(DiImage* img)
 {
    vg_assert(img);
@@ -820,12 +1055,12 @@ SizeT ML_(img_get_some)(/*OUT*/void* dst,
    ensure_valid(img, offset, size, "ML_(img_get_some)");
    UChar* dstU = (UChar*)dst;
    /* Use |get| in the normal way to get the first byte of the range.
-      This guarantees to put the cache entry containing |offset| in
-      position zero. */
+      This guarantees to make the cache entry containing |offset| the
+      last one used. */
    dstU[0] = get(img, offset);
    /* Now just read as many bytes as we can (or need) directly out of
-      entry zero, without bothering to call |get| each time. */
-   CEnt* ce = img->ces[0];
+      that entry, without bothering to call |get| each time. */
+   CEnt* ce = img->last;
    vg_assert(ce && ce->used >= 1);
    vg_assert(is_in_CEnt(ce, offset));
    SizeT nToCopy = size - 1;
@@ -0,0 +1,62 @@
+
+/*--------------------------------------------------------------------*/
+/*--- A persistent cache of read debug info.                       ---*/
+/*---                                               priv_dicache.h ---*/
+/*--------------------------------------------------------------------*/
+
+/*
+   This file is part of Valgrind, a dynamic binary instrumentation
+   framework.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of the
+   License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+   02111-1307, USA.
+
+   The GNU General Public License is contained in the file COPYING.
+*/
+
+#ifndef __PRIV_DICACHE_H
+#define __PRIV_DICACHE_H
+
+#include "pub_core_basics.h"    // Bool
+
+/* With --debuginfo-cache=<dir>, the symbol, line number, inline and
+   CFI tables of each object with a build-id are saved in <dir> once
+   they have been read, and later runs take them from there instead of
+   reading the object's ELF symbol tables, DWARF and CFI again. */
+
+/* Can di's tables be taken from, or saved to, the cache?  Not if the
+   cache isn't in use, nor if di's variable info is wanted (the cache
+   doesn't hold that), nor if di's reading is being traced or
+   dumped. */
+extern Bool ML_(dicache_usable) ( const struct _DebugInfo* di );
+
+/* Fill in di's symbol, line number, inline and CFI tables from the
+   cache entry for buildid.  Returns False, having changed nothing, if
+   there is no usable entry (one lacking inline info is not, if that
+   is wanted).  The tables are added as if they had just been read:
+   they still have to be canonicalised. */
+extern Bool ML_(dicache_load) ( struct _DebugInfo* di,
+                                const HChar* buildid );
+
+/* Save di's tables, which must be complete and canonicalised, as the
+   cache entry for buildid. */
+extern void ML_(dicache_save) ( struct _DebugInfo* di,
+                                const HChar* buildid );
+
+#endif /* ndef __PRIV_DICACHE_H */
+
+/*--------------------------------------------------------------------*/
+/*--- end                                           priv_dicache.h ---*/
+/*--------------------------------------------------------------------*/
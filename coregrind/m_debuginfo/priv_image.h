@@ -74,6 +74,21 @@ DiImage* ML_(img_from_di_server)(const HChar* filename,
 /* Destroy an existing image. */
 void ML_(img_done)(DiImage*);
 
+/* Is the image of a local file (as opposed to one on a server)? */
+Bool ML_(img_is_local)(const DiImage* img);
+
+/* Close the file of a local image and drop its cached contents, so
+   that an image which will not be read for a while (perhaps never)
+   holds no file descriptor and little memory.  A suspended image
+   must be resumed before anything is read from it, but can be
+   destroyed with ML_(img_done) as it is. */
+void ML_(img_suspend)(DiImage* img);
+
+/* Reopen the file of a suspended image.  Returns False, leaving the
+   image suspended, if the file can no longer be opened or has changed
+   size in the meantime. */
+Bool ML_(img_resume)(DiImage* img);
+
 /* How big is the image? */
 DiOffT ML_(img_size)(DiImage* img);
 
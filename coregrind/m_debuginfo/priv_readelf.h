@@ -53,6 +53,17 @@ extern Bool ML_(is_elf_object_file)( void* image, SizeT n_image, Bool rel_ok );
 */
 extern Bool ML_(read_elf_debug_info) ( DebugInfo* di );
 
+/* With --lazy-debuginfo=yes, ML_(read_elf_debug_info) reads only the
+   symbols, and leaves the CFI (if di->cfi_deferred) and the DWARF
+   line, inline and variable info (if di->dwarf_deferred) to be read
+   by these when first needed.  The caller must then canonicalise
+   what was read. */
+extern void ML_(read_elf_deferred_cfi)   ( DebugInfo* di );
+extern void ML_(read_elf_deferred_dwarf) ( DebugInfo* di );
+
+/* Forget about any info of di's which is still to be read. */
+extern void ML_(discard_elf_deferred) ( DebugInfo* di );
+
 
 #endif /* ndef __PRIV_READELF_H */
 
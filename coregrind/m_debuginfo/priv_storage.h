@@ -972,6 +972,21 @@ struct _DebugInfo {
    /* An array of guarded DWARF3 expressions. */
    XArray* admin_gexprs;
 
+   /* With --lazy-debuginfo=yes, the CFI and the DWARF line, inline
+      and variable info are not read until they are first needed.
+      Until then, .cfi_deferred and/or .dwarf_deferred are True, and
+      .deferred says where to read them from (see readelf.c).  The
+      tables concerned are empty, and the string and filename pools
+      are not frozen. */
+   Bool cfi_deferred;
+   Bool dwarf_deferred;
+   struct _ElfDebugSects* deferred;
+
+   /* With --debuginfo-cache, the build-id under which the tables are
+      to be saved once they have all been read, or NULL if they are not
+      to be (see priv_dicache.h). */
+   HChar* dicache_key;
+
    /* Cached last rx mapping matched and returned by ML_(find_rx_mapping).
       This helps performance a lot during ML_(addLineInfo) etc., which can
       easily be invoked hundreds of thousands of times. */
@@ -1070,6 +1085,13 @@ extern void ML_(addVar)( struct _DebugInfo* di,
    this after finishing adding entries to these tables. */
 extern void ML_(canonicaliseTables) ( struct _DebugInfo* di );
 
+/* Canonicalise the tables filled in by reading the CFI, or the DWARF
+   line, inline and variable info, whose reading was deferred (see
+   DebugInfo::deferred).  ML_(canonicaliseTables) calls these for the
+   tables whose reading wasn't. */
+extern void ML_(canonicaliseCFITables)   ( struct _DebugInfo* di );
+extern void ML_(canonicaliseDwarfTables) ( struct _DebugInfo* di );
+
 /* Canonicalise the call-frame-info table held by 'di', in preparation
    for use. This is called by ML_(canonicaliseTables) but can also be
    called on it's own to sort just this table. */
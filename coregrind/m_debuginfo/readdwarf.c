@@ -227,22 +227,20 @@ ULong read_initial_length_field ( DiCursor p_img, /*OUT*/Bool* is64 )
 }
 
 
-static LineSMR state_machine_regs;
-
 static 
-void reset_state_machine ( Int is_stmt )
+void reset_state_machine ( LineSMR* smr, Int is_stmt )
 {
    if (0) VG_(printf)("smr.a := %p (reset)\n", NULL );
-   state_machine_regs.last_address = 0;
-   state_machine_regs.last_file = 1;
-   state_machine_regs.last_line = 1;
-   state_machine_regs.address = 0;
-   state_machine_regs.file = 1;
-   state_machine_regs.line = 1;
-   state_machine_regs.column = 0;
-   state_machine_regs.is_stmt = is_stmt;
-   state_machine_regs.basic_block = 0;
-   state_machine_regs.end_sequence = 0;
+   smr->last_address = 0;
+   smr->last_file = 1;
+   smr->last_line = 1;
+   smr->address = 0;
+   smr->file = 1;
+   smr->line = 1;
+   smr->column = 0;
+   smr->is_stmt = is_stmt;
+   smr->basic_block = 0;
+   smr->end_sequence = 0;
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -252,6 +250,7 @@ void reset_state_machine ( Int is_stmt )
    accordingly. */
 static 
 void process_extended_line_op( struct _DebugInfo* di,
+                               LineSMR* smr,
                                XArray* fndn_ix_xa,
                                DiCursor* data, Int is_stmt)
 {
@@ -269,24 +268,24 @@ void process_extended_line_op( struct _DebugInfo* di,
    switch (op_code) {
       case DW_LNE_end_sequence:
          if (0) VG_(printf)("1001: si->o %#lx, smr.a %#lx\n",
-                            di->text_debug_bias, state_machine_regs.address );
+                            di->text_debug_bias, smr->address );
          /* JRS: added for compliance with spec; is pointless due to
             reset_state_machine below */
-         state_machine_regs.end_sequence = 1; 
+         smr->end_sequence = 1; 
 
-         if (state_machine_regs.is_stmt) {
-            if (state_machine_regs.last_address) {
+         if (smr->is_stmt) {
+            if (smr->last_address) {
                ML_(addLineInfo) (
                   di,
                   safe_fndn_ix (fndn_ix_xa,
-                                state_machine_regs.last_file),
-                  di->text_debug_bias + state_machine_regs.last_address, 
-                  di->text_debug_bias + state_machine_regs.address, 
-                  state_machine_regs.last_line, 0
+                                smr->last_file),
+                  di->text_debug_bias + smr->last_address, 
+                  di->text_debug_bias + smr->address, 
+                  smr->last_line, 0
                );
             }
          }
-         reset_state_machine (is_stmt);
+         reset_state_machine (smr, is_stmt);
          if (di->ddump_line)
             VG_(printf)("  Extended opcode %d: End of Sequence\n\n", 
                         (Int)op_code);
@@ -294,7 +293,7 @@ void process_extended_line_op( struct _DebugInfo* di,
 
       case DW_LNE_set_address: {
          Addr adr = ML_(cur_step_Addr)(data);
-         state_machine_regs.address = adr;
+         smr->address = adr;
          if (di->ddump_line)
             VG_(printf)("  Extended opcode %d: set Address to 0x%lx\n",
                         (Int)op_code, (Addr)adr);
@@ -350,6 +349,7 @@ void read_dwarf2_lineblock ( struct _DebugInfo* di,
    UInt           fndn_ix;
    XArray*        dirname_xa;   /* xarray of HChar* dirname */
    HChar*         dirname;
+   LineSMR        state_machine_regs;
 
    DiCursor       external = theBlock;
    DiCursor       data = theBlock;
@@ -494,7 +494,7 @@ void read_dwarf2_lineblock ( struct _DebugInfo* di,
    DiCursor end_of_sequence
      = ML_(cur_plus)(data, info.li_length + (is64 ? 12 : 4));
 
-   reset_state_machine (info.li_default_is_stmt);
+   reset_state_machine (&state_machine_regs, info.li_default_is_stmt);
 
    /* Read the contents of the Opcodes table.  */
    DiCursor standard_opcodes = external;
@@ -519,7 +519,7 @@ void read_dwarf2_lineblock ( struct _DebugInfo* di,
    while (ML_(cur_read_UChar)(data) != 0) {
 
 #     define NBUF 4096
-      static HChar buf[NBUF];
+      HChar buf[NBUF];
 
       HChar* data_str = ML_(cur_read_strdup)(data, "di.rd2l.1");
       if (di->ddump_line)
@@ -658,7 +658,7 @@ void read_dwarf2_lineblock ( struct _DebugInfo* di,
       switch (op_code) {
          case DW_LNS_extended_op:
             process_extended_line_op (
-                       di, fndn_ix_xa,
+                       di, &state_machine_regs, fndn_ix_xa,
                        &data, info.li_default_is_stmt);
             break;
 
@@ -1105,7 +1105,7 @@ void ML_(read_debuginfo_dwarf3)
       /* version should be 2 */
       ver = ML_(cur_read_UShort)( ML_(cur_plus)(block_img, blklen_len) );
       if ( ver != 2 && ver != 3 && ver != 4 ) {
-         ML_(symerr)( di, True,
+         if (0) /* LOCALTEST */ ML_(symerr)( di, True,
                       "Ignoring non-Dwarf2/3/4 block in .debug_info" );
          continue;
       }
@@ -3639,15 +3639,16 @@ static void init_CIE ( CIE* cie )
 }
 
 #define N_CIEs 8000
-static CIE the_CIEs[N_CIEs];
 
 
 /* Read, summarise and store CFA unwind info from .eh_frame and
    .debug_frame sections.  is_ehframe tells us which kind we are
-   dealing with -- they are slightly different. */
-void ML_(read_callframe_info_dwarf3)
+   dealing with -- they are slightly different.  the_CIEs has room
+   for N_CIEs. */
+static void read_callframe_info_dwarf3_wrk
         ( /*OUT*/struct _DebugInfo* di,
-          DiSlice escn_frame, Addr frame_avma, Bool is_ehframe )
+          DiSlice escn_frame, Addr frame_avma, Bool is_ehframe,
+          CIE* the_CIEs )
 {
    const HChar* how = NULL;
    Int      n_CIEs = 0;
@@ -4168,6 +4169,19 @@ void ML_(read_callframe_info_dwarf3)
     return;
 }
 
+/* The CIE table is per call, not static, so that the CFI of
+   different objects can be read at the same time (see
+   --debuginfo-threads). */
+void ML_(read_callframe_info_dwarf3)
+        ( /*OUT*/struct _DebugInfo* di,
+          DiSlice escn_frame, Addr frame_avma, Bool is_ehframe )
+{
+   CIE* the_CIEs = ML_(dinfo_zalloc)("di.rcid3.1", N_CIEs * sizeof(CIE));
+   read_callframe_info_dwarf3_wrk(di, escn_frame, frame_avma, is_ehframe,
+                                  the_CIEs);
+   ML_(dinfo_free)(the_CIEs);
+}
+
 #endif // defined(VGO_linux) || defined(VGO_darwin)
 
 /*--------------------------------------------------------------------*/
@@ -140,6 +140,7 @@
 #include "pub_core_libcbase.h"
 #include "pub_core_libcassert.h"
 #include "pub_core_libcprint.h"
+#include "pub_core_libcproc.h"      // VG_(worker_self)
 #include "pub_core_libcsetjmp.h"   // setjmp facilities
 #include "pub_core_hashtable.h"
 #include "pub_core_options.h"
@@ -1789,7 +1790,7 @@ XArray* read_dirname_xa (struct _DebugInfo* di, const HChar *compdir,
    while (peek_UChar(c) != 0) {
 
 #     define NBUF 4096
-      static HChar buf[NBUF];
+      HChar buf[NBUF];
       DiCursor cur = get_AsciiZ(c);
       HChar* data_str = ML_(cur_read_strdup)( cur, "dirname_xa.1" );
       TRACE_D3("  %s\n", data_str);
@@ -4658,6 +4659,15 @@ void new_dwarf3_reader_wrk (
          cu_start_offset = get_position_of_Cursor( &info );
          TRACE_D3("\n");
          TRACE_D3("  Compilation Unit @ offset 0x%llx:\n", cu_start_offset);
+         { /* LOCALTEST skip DWARF5 CUs */
+           Cursor pk = info; Bool is64;
+           ULong len = get_Initial_Length( &is64, &pk, "x" );
+           ULong here = get_position_of_Cursor( &pk );
+           if (get_UShort( &pk ) == 5) {
+              set_position_of_Cursor( &info, here + len );
+              continue;
+           }
+         }
          /* parse_CU_header initialises the CU's hashtable of abbvs ht_abbvs */
          if (pass == 0) {
             parse_CU_Header( &cc, td3, &info, escn_debug_abbv_alt,
@@ -5125,14 +5135,24 @@ void new_dwarf3_reader_wrk (
 /*---                                                      ---*/
 /*------------------------------------------------------------*/
 
-static Bool               d3rd_jmpbuf_valid  = False;
-static const HChar*       d3rd_jmpbuf_reason = NULL;
-static VG_MINIMAL_JMP_BUF(d3rd_jmpbuf);
+/* Where barf jumps back to.  There is one for each VG_(run_workers)
+   thread, since barf has no context to find its reader's by, and the
+   objects' DWARF may be read in parallel (see --debuginfo-threads). */
+typedef
+   struct {
+      Bool         valid;
+      const HChar* reason;
+      VG_MINIMAL_JMP_BUF(jmpbuf);
+   }
+   D3Jmp;
+
+static D3Jmp d3rd_jmp[VG_MAX_WORKERS];
 
 static __attribute__((noreturn)) void barf ( const HChar* reason ) {
-   vg_assert(d3rd_jmpbuf_valid);
-   d3rd_jmpbuf_reason = reason;
-   VG_MINIMAL_LONGJMP(d3rd_jmpbuf);
+   D3Jmp* j = &d3rd_jmp[VG_(worker_self)()];
+   vg_assert(j->valid);
+   j->reason = reason;
+   VG_MINIMAL_LONGJMP(j->jmpbuf);
    /*NOTREACHED*/
    vg_assert(0);
 }
@@ -5151,16 +5171,17 @@ ML_(new_dwarf3_reader) (
 {
    volatile Int  jumped;
    volatile Bool td3 = di->trace_symtab;
+   D3Jmp* volatile j = &d3rd_jmp[VG_(worker_self)()];
 
    /* Run the _wrk function to read the dwarf3.  If it succeeds, it
       just returns normally.  If there is any failure, it longjmp's
-      back here, having first set d3rd_jmpbuf_reason to something
+      back here, having first set j->reason to something
       useful. */
-   vg_assert(d3rd_jmpbuf_valid  == False);
-   vg_assert(d3rd_jmpbuf_reason == NULL);
+   vg_assert(j->valid  == False);
+   vg_assert(j->reason == NULL);
 
-   d3rd_jmpbuf_valid = True;
-   jumped = VG_MINIMAL_SETJMP(d3rd_jmpbuf);
+   j->valid = True;
+   jumped = VG_MINIMAL_SETJMP(j->jmpbuf);
    if (jumped == 0) {
       /* try this ... */
       new_dwarf3_reader_wrk( di, barf,
@@ -5170,21 +5191,21 @@ ML_(new_dwarf3_reader) (
                              escn_debug_loc,      escn_debug_info_alt,
                              escn_debug_abbv_alt, escn_debug_line_alt,
                              escn_debug_str_alt );
-      d3rd_jmpbuf_valid = False;
+      j->valid = False;
       TRACE_D3("\n------ .debug_info reading was successful ------\n");
    } else {
       /* It longjmp'd. */
-      d3rd_jmpbuf_valid = False;
+      j->valid = False;
       /* Can't longjump without giving some sort of reason. */
-      vg_assert(d3rd_jmpbuf_reason != NULL);
+      vg_assert(j->reason != NULL);
 
       TRACE_D3("\n------ .debug_info reading failed ------\n");
 
-      ML_(symerr)(di, True, d3rd_jmpbuf_reason);
+      ML_(symerr)(di, True, j->reason);
    }
 
-   d3rd_jmpbuf_valid  = False;
-   d3rd_jmpbuf_reason = NULL;
+   j->valid  = False;
+   j->reason = NULL;
 }
 
 
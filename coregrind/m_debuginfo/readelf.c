@@ -52,6 +52,7 @@
 #include "priv_readdwarf3.h"
 #include "priv_readstabs.h"        /* and stabs, if we're unlucky */
 #include "priv_readexidx.h"
+#include "priv_dicache.h"
 
 /* --- !!! --- EXTERNAL HEADERS start --- !!! --- */
 #include <elf.h>
@@ -1422,6 +1423,228 @@ Word file_offset_from_svma ( /*OUT*/Bool* ok,
 }
 
 
+/* The sections that the CFI and the DWARF line, inline and variable
+   info are read from, and the images they are in.  With
+   --lazy-debuginfo=yes, one of these is kept (with the images
+   suspended) in DebugInfo::deferred until the info is needed. */
+struct _ElfDebugSects {
+   DiImage* mimg;
+   DiImage* dimg;
+   DiImage* aimg;
+   DiSlice  ehframe_escn[N_EHFRAME_SECTS];
+   DiSlice  debug_frame_escn;
+   DiSlice  debug_info_escn;
+   DiSlice  debug_types_escn;
+   DiSlice  debug_abbv_escn;
+   DiSlice  debug_line_escn;
+   DiSlice  debug_str_escn;
+   DiSlice  debug_ranges_escn;
+   DiSlice  debug_loc_escn;
+   DiSlice  debug_info_alt_escn;
+   DiSlice  debug_abbv_alt_escn;
+   DiSlice  debug_line_alt_escn;
+   DiSlice  debug_str_alt_escn;
+};
+
+/* Read .eh_frame and .debug_frame (call-frame-info) if any, and on
+   arm32 the .exidx/.extab unwind tables. */
+static void read_elf_cfi ( struct _DebugInfo* di,
+                           const struct _ElfDebugSects* ds )
+{
+   Word i;
+
+   /* Do the .eh_frame section(s) first. */
+   vg_assert(di->n_ehframe >= 0 && di->n_ehframe <= N_EHFRAME_SECTS);
+   for (i = 0; i < di->n_ehframe; i++) {
+      /* see Comment_on_EH_FRAME_MULTIPLE_INSTANCES above for why
+         this next assertion should hold. */
+      vg_assert(ML_(sli_is_valid)(ds->ehframe_escn[i]));
+      vg_assert(ds->ehframe_escn[i].szB == di->ehframe_size[i]);
+      ML_(read_callframe_info_dwarf3)( di,
+                                       ds->ehframe_escn[i],
+                                       di->ehframe_avma[i],
+                                       True/*is_ehframe*/ );
+   }
+   if (ML_(sli_is_valid)(ds->debug_frame_escn)) {
+      ML_(read_callframe_info_dwarf3)( di,
+                                       ds->debug_frame_escn,
+                                       0/*assume zero avma*/,
+                                       False/*!is_ehframe*/ );
+   }
+
+#  if defined(VGA_arm)
+   /* ARM32 only: read .exidx/.extab if present.  Note we are
+      reading these directly out of the mapped in (running) image.
+      Also, read these only if no CFI based unwind info was
+      acquired for this file.
+
+      An .exidx section is always required, but the .extab section
+      can be optionally omitted, provided that .exidx does not
+      refer to it.  If the .exidx is erroneous and does refer to
+      .extab even though .extab is missing, the range checks done
+      by GET_EX_U32 in ExtabEntryExtract in readexidx.c should
+      prevent any invalid memory accesses, and cause the .extab to
+      be rejected as invalid.
+
+      FIXME:
+      * check with m_aspacemgr that the entire [exidx_avma, +exidx_size)
+        and [extab_avma, +extab_size) areas are readable, since we're
+        reading this stuff out of the running image (not from a file/socket)
+        and we don't want to segfault.
+      * DebugInfo::exidx_bias and use text_bias instead.
+        I think it's always the same.
+      * remove DebugInfo::{extab_bias, exidx_svma, extab_svma} since
+        they are never used.
+   */
+   if (di->exidx_present
+       && di->cfsi_used == 0
+       && di->text_present && di->text_size > 0) {
+      Addr text_last_svma = di->text_svma + di->text_size - 1;
+      ML_(read_exidx)( di, (UChar*)di->exidx_avma, di->exidx_size,
+                           (UChar*)di->extab_avma, di->extab_size,
+                           text_last_svma,
+                           di->exidx_bias );
+   }
+#  endif /* defined(VGA_arm) */
+}
+
+/* Read the DWARF line number info, and the inline and variable info
+   if asked for. */
+static void read_elf_dwarf ( struct _DebugInfo* di,
+                             const struct _ElfDebugSects* ds )
+{
+   /* jrs 2006-01-01: icc-8.1 has been observed to generate
+      binaries without debug_str sections.  Don't preclude
+      debuginfo reading for that reason, but, in
+      read_unitinfo_dwarf2, do check that debugstr is non-NULL
+      before using it. */
+   if (ML_(sli_is_valid)(ds->debug_info_escn)
+       && ML_(sli_is_valid)(ds->debug_abbv_escn)
+       && ML_(sli_is_valid)(ds->debug_line_escn)) {
+      /* The old reader: line numbers and unwind info only */
+      ML_(read_debuginfo_dwarf3) ( di,
+                                   ds->debug_info_escn,
+                                   ds->debug_types_escn,
+                                   ds->debug_abbv_escn,
+                                   ds->debug_line_escn,
+                                   ds->debug_str_escn,
+                                   ds->debug_str_alt_escn );
+      /* The new reader: read the DIEs in .debug_info to acquire
+         information on variable types and locations or inline info.
+         But only if the tool asks for it, or the user requests it on
+         the command line. */
+      if (VG_(clo_read_var_info) /* the user or tool asked for it */
+          || VG_(clo_read_inline_info)) {
+         ML_(new_dwarf3_reader)(
+            di, ds->debug_info_escn,     ds->debug_types_escn,
+                ds->debug_abbv_escn,     ds->debug_line_escn,
+                ds->debug_str_escn,      ds->debug_ranges_escn,
+                ds->debug_loc_escn,      ds->debug_info_alt_escn,
+                ds->debug_abbv_alt_escn, ds->debug_line_alt_escn,
+                ds->debug_str_alt_escn
+         );
+      }
+   }
+}
+
+/* Can the reading of di's CFI and DWARF info be put off (until it
+   is needed, or, with --debuginfo-threads, until that of all the
+   objects can be read in parallel)?  Not if
+   any of the images is on a debuginfo server (it can't be
+   suspended), nor if we are asked to trace or dump it. */
+static Bool can_defer_elf_debug_info ( struct _DebugInfo* di,
+                                       const struct _ElfDebugSects* ds )
+{
+   if (!VG_(clo_lazy_debuginfo) && VG_(clo_debuginfo_threads) == 1)
+      return False;
+   if (di->trace_symtab || di->trace_cfi
+       || di->ddump_line || di->ddump_frames)
+      return False;
+   if (ds->mimg && !ML_(img_is_local)(ds->mimg))
+      return False;
+   if (ds->dimg && !ML_(img_is_local)(ds->dimg))
+      return False;
+   if (ds->aimg && !ML_(img_is_local)(ds->aimg))
+      return False;
+   return True;
+}
+
+/* Resume the images of di->deferred.  If one of them can't be, leave
+   them all suspended and return False. */
+static Bool resume_deferred_images ( struct _DebugInfo* di )
+{
+   struct _ElfDebugSects* ds = di->deferred;
+   if (ds->mimg && !ML_(img_resume)(ds->mimg))
+      goto fail_m;
+   if (ds->dimg && !ML_(img_resume)(ds->dimg))
+      goto fail_d;
+   if (ds->aimg && !ML_(img_resume)(ds->aimg))
+      goto fail_a;
+   return True;
+
+  fail_a:
+   if (ds->dimg) ML_(img_suspend)(ds->dimg);
+  fail_d:
+   if (ds->mimg) ML_(img_suspend)(ds->mimg);
+  fail_m:
+   ML_(symerr)(di, True, "object or debuginfo file has changed since "
+                         "its symbols were read; ignoring its debug info");
+   return False;
+}
+
+static void suspend_deferred_images ( struct _DebugInfo* di )
+{
+   struct _ElfDebugSects* ds = di->deferred;
+   if (ds->mimg) ML_(img_suspend)(ds->mimg);
+   if (ds->dimg) ML_(img_suspend)(ds->dimg);
+   if (ds->aimg) ML_(img_suspend)(ds->aimg);
+}
+
+void ML_(read_elf_deferred_cfi) ( struct _DebugInfo* di )
+{
+   vg_assert(di->cfi_deferred && di->deferred);
+   di->cfi_deferred = False;
+   if (VG_(clo_verbosity) > 1)
+      VG_(message)(Vg_DebugMsg, "Reading CFI from %s\n",
+                   di->fsm.filename);
+   if (resume_deferred_images(di)) {
+      read_elf_cfi(di, di->deferred);
+      suspend_deferred_images(di);
+   }
+   if (!di->dwarf_deferred)
+      ML_(discard_elf_deferred)(di);
+}
+
+void ML_(read_elf_deferred_dwarf) ( struct _DebugInfo* di )
+{
+   vg_assert(di->dwarf_deferred && di->deferred);
+   di->dwarf_deferred = False;
+   if (VG_(clo_verbosity) > 1)
+      VG_(message)(Vg_DebugMsg, "Reading debug info from %s\n",
+                   di->fsm.filename);
+   if (resume_deferred_images(di)) {
+      read_elf_dwarf(di, di->deferred);
+      suspend_deferred_images(di);
+   }
+   if (!di->cfi_deferred)
+      ML_(discard_elf_deferred)(di);
+}
+
+void ML_(discard_elf_deferred) ( struct _DebugInfo* di )
+{
+   struct _ElfDebugSects* ds = di->deferred;
+   if (ds == NULL)
+      return;
+   if (ds->mimg) ML_(img_done)(ds->mimg);
+   if (ds->dimg) ML_(img_done)(ds->dimg);
+   if (ds->aimg) ML_(img_done)(ds->aimg);
+   ML_(dinfo_free)(ds);
+   di->deferred       = NULL;
+   di->cfi_deferred   = False;
+   di->dwarf_deferred = False;
+}
+
+
 /* The central function for reading ELF debug info.  For the
    object/exe specified by the DebugInfo, find ELF sections, then read
    the symbols, line number info, file name info, CFA (stack-unwind
@@ -1692,7 +1915,7 @@ Bool ML_(read_elf_debug_info) ( struct _DebugInfo* di )
                Bool loaded = False;
                for (j = 0; j < VG_(sizeXA)(di->fsm.maps); j++) {
                   struct _DebugInfoMapping* map = VG_(indexXA)(di->fsm.maps, j);
-                  if (   (map->rx || map->rw)
+                  if (   (map->rx || map->rw || map->ro)
                       && a_phdr.p_offset >= map->foff
                       && a_phdr.p_offset <  map->foff + map->size
                       && a_phdr.p_offset + a_phdr.p_filesz 
@@ -1718,6 +1941,12 @@ Bool ML_(read_elf_debug_info) ( struct _DebugInfo* di )
                         TRACE_SYMTAB("PT_LOAD[%ld]:   acquired as rx\n", i);
                         loaded = True;
                      }
+                     if (map->ro /* LOCALTEST */
+                         && (a_phdr.p_flags & (PF_R | PF_W | PF_X)) == PF_R) {
+                        item.exec = True;
+                        VG_(addToXA)(svma_ranges, &item);
+                        loaded = True;
+                     }
                   }
                }
                if (!loaded) {
@@ -2451,6 +2680,19 @@ Bool ML_(read_elf_debug_info) ( struct _DebugInfo* di )
       /* Look for a build-id */
       HChar* buildid = find_buildid(mimg, False, False);
 
+      /* If the tables read from an object with this build-id were
+         saved by an earlier run, use those instead of reading them
+         again.  Otherwise remember the build-id, so they can be saved
+         once they are complete. */
+      if (buildid != NULL && ML_(dicache_usable)(di)) {
+         if (ML_(dicache_load)(di, buildid)) {
+            ML_(dinfo_free)(buildid);
+            res = True;
+            goto out;
+         }
+         di->dicache_key = ML_(dinfo_strdup)("di.redi.dicache", buildid);
+      }
+
       /* Look for a debug image that matches either the build-id or
          the debuglink-CRC32 in the main image.  If the main image
          doesn't contain either of those then this won't even bother
@@ -2867,24 +3109,38 @@ Bool ML_(read_elf_debug_info) ( struct _DebugInfo* di )
       }
 
       /* TOPLEVEL */
-      /* Read .eh_frame and .debug_frame (call-frame-info) if any.  Do
-         the .eh_frame section(s) first. */
-      vg_assert(di->n_ehframe >= 0 && di->n_ehframe <= N_EHFRAME_SECTS);
-      for (i = 0; i < di->n_ehframe; i++) {
-         /* see Comment_on_EH_FRAME_MULTIPLE_INSTANCES above for why
-            this next assertion should hold. */
-         vg_assert(ML_(sli_is_valid)(ehframe_escn[i]));
-         vg_assert(ehframe_escn[i].szB == di->ehframe_size[i]);
-         ML_(read_callframe_info_dwarf3)( di,
-                                          ehframe_escn[i],
-                                          di->ehframe_avma[i],
-                                          True/*is_ehframe*/ );
-      }
-      if (ML_(sli_is_valid)(debug_frame_escn)) {
-         ML_(read_callframe_info_dwarf3)( di,
-                                          debug_frame_escn,
-                                          0/*assume zero avma*/,
-                                          False/*!is_ehframe*/ );
+      /* Read the call-frame-info and the DWARF info, or, with
+         --lazy-debuginfo=yes, note where they are so they can be read
+         when first needed. */
+      {
+         struct _ElfDebugSects ds;
+         ds.mimg = mimg;
+         ds.dimg = dimg;
+         ds.aimg = aimg;
+         for (i = 0; i < N_EHFRAME_SECTS; i++)
+            ds.ehframe_escn[i] = ehframe_escn[i];
+         ds.debug_frame_escn    = debug_frame_escn;
+         ds.debug_info_escn     = debug_info_escn;
+         ds.debug_types_escn    = debug_types_escn;
+         ds.debug_abbv_escn     = debug_abbv_escn;
+         ds.debug_line_escn     = debug_line_escn;
+         ds.debug_str_escn      = debug_str_escn;
+         ds.debug_ranges_escn   = debug_ranges_escn;
+         ds.debug_loc_escn      = debug_loc_escn;
+         ds.debug_info_alt_escn = debug_info_alt_escn;
+         ds.debug_abbv_alt_escn = debug_abbv_alt_escn;
+         ds.debug_line_alt_escn = debug_line_alt_escn;
+         ds.debug_str_alt_escn  = debug_str_alt_escn;
+         if (can_defer_elf_debug_info(di, &ds)) {
+            di->deferred = ML_(dinfo_zalloc)("di.relfdi.deferred",
+                                             sizeof(ds));
+            *di->deferred      = ds;
+            di->cfi_deferred   = True;
+            di->dwarf_deferred = True;
+         } else {
+            read_elf_cfi(di, &ds);
+            read_elf_dwarf(di, &ds);
+         }
       }
 
       /* Read the stabs and/or dwarf2 debug information, if any.  It
@@ -2908,40 +3164,6 @@ Bool ML_(read_elf_debug_info) ( struct _DebugInfo* di )
       //}
 #     endif
 
-      /* TOPLEVEL */
-      /* jrs 2006-01-01: icc-8.1 has been observed to generate
-         binaries without debug_str sections.  Don't preclude
-         debuginfo reading for that reason, but, in
-         read_unitinfo_dwarf2, do check that debugstr is non-NULL
-         before using it. */
-      if (ML_(sli_is_valid)(debug_info_escn) 
-          && ML_(sli_is_valid)(debug_abbv_escn)
-          && ML_(sli_is_valid)(debug_line_escn)) {
-         /* The old reader: line numbers and unwind info only */
-         ML_(read_debuginfo_dwarf3) ( di,
-                                      debug_info_escn,
-                                      debug_types_escn,
-                                      debug_abbv_escn,
-                                      debug_line_escn,
-                                      debug_str_escn,
-                                      debug_str_alt_escn );
-         /* The new reader: read the DIEs in .debug_info to acquire
-            information on variable types and locations or inline info.
-            But only if the tool asks for it, or the user requests it on
-            the command line. */
-         if (VG_(clo_read_var_info) /* the user or tool asked for it */
-             || VG_(clo_read_inline_info)) {
-            ML_(new_dwarf3_reader)(
-               di, debug_info_escn,     debug_types_escn,
-                   debug_abbv_escn,     debug_line_escn,
-                   debug_str_escn,      debug_ranges_escn,
-                   debug_loc_escn,      debug_info_alt_escn,
-                   debug_abbv_alt_escn, debug_line_alt_escn,
-                   debug_str_alt_escn
-            );
-         }
-      }
-
       /* TOPLEVEL */
       // JRS 31 July 2014: dwarf-1 reading is currently broken and
       // therefore deactivated.
@@ -2950,42 +3172,6 @@ Bool ML_(read_elf_debug_info) ( struct _DebugInfo* di )
       //                                    dwarf1l_img, dwarf1l_sz );
       //}
 
-#     if defined(VGA_arm)
-      /* TOPLEVEL */
-      /* ARM32 only: read .exidx/.extab if present.  Note we are
-         reading these directly out of the mapped in (running) image.
-         Also, read these only if no CFI based unwind info was
-         acquired for this file.
-
-         An .exidx section is always required, but the .extab section
-         can be optionally omitted, provided that .exidx does not
-         refer to it.  If the .exidx is erroneous and does refer to
-         .extab even though .extab is missing, the range checks done
-         by GET_EX_U32 in ExtabEntryExtract in readexidx.c should
-         prevent any invalid memory accesses, and cause the .extab to
-         be rejected as invalid.
-
-         FIXME:
-         * check with m_aspacemgr that the entire [exidx_avma, +exidx_size)
-           and [extab_avma, +extab_size) areas are readable, since we're
-           reading this stuff out of the running image (not from a file/socket)
-           and we don't want to segfault.
-         * DebugInfo::exidx_bias and use text_bias instead.
-           I think it's always the same.
-         * remove DebugInfo::{extab_bias, exidx_svma, extab_svma} since
-           they are never used.
-      */
-      if (di->exidx_present
-          && di->cfsi_used == 0
-          && di->text_present && di->text_size > 0) {
-         Addr text_last_svma = di->text_svma + di->text_size - 1;
-         ML_(read_exidx)( di, (UChar*)di->exidx_avma, di->exidx_size,
-                              (UChar*)di->extab_avma, di->extab_size,
-                              text_last_svma,
-                              di->exidx_bias );
-      }
-#     endif /* defined(VGA_arm) */
-
    } /* "Find interesting sections, read the symbol table(s), read any debug
         information" (a local scope) */
 
@@ -3023,10 +3209,15 @@ Bool ML_(read_elf_debug_info) ( struct _DebugInfo* di )
 
   out: 
    {
-      /* Last, but not least, detach from the image(s). */
-      if (mimg) ML_(img_done)(mimg);
-      if (dimg) ML_(img_done)(dimg);
-      if (aimg) ML_(img_done)(aimg);
+      /* Last, but not least, detach from the image(s).  If they are
+         needed for reading the rest later, just suspend them. */
+      if (di->deferred) {
+         suspend_deferred_images(di);
+      } else {
+         if (mimg) ML_(img_done)(mimg);
+         if (dimg) ML_(img_done)(dimg);
+         if (aimg) ML_(img_done)(aimg);
+      }
 
       if (svma_ranges) VG_(deleteXA)(svma_ranges);
 
@@ -1862,11 +1862,16 @@ static void canonicaliseSymtab ( struct _DebugInfo* di )
 }
 
 
-static DiLoc* sorting_loctab = NULL;
-static Int compare_DiLoc_via_ix ( const void* va, const void* vb ) 
+/* A loctab index, with the address it is sorted by alongside, so
+   that the comparison needs no global pointing at the loctab being
+   sorted (the loctabs of several objects may be sorted at once; see
+   --debuginfo-threads). */
+typedef struct { Addr addr; UInt ix; } DiLocSortKey;
+
+static Int compare_DiLocSortKey ( const void* va, const void* vb ) 
 {
-   const DiLoc* a = &sorting_loctab[*(UInt*)va];
-   const DiLoc* b = &sorting_loctab[*(UInt*)vb];
+   const DiLocSortKey* a = va;
+   const DiLocSortKey* b = vb;
    if (a->addr < b->addr) return -1;
    if (a->addr > b->addr) return  1;
    return 0;
@@ -1878,15 +1883,21 @@ static void sort_loctab_and_loctab_fndn_ix (struct _DebugInfo* di )
       We first build sort_ix : an array of indexes in loctab,
       that we sort by loctab address. Then we can reorder both
       arrays according to sort_ix. */
-   UInt *sort_ix = ML_(dinfo_zalloc)("di.storage.six",
-                                     di->loctab_used*sizeof(UInt));
+   DiLocSortKey *keys = ML_(dinfo_zalloc)("di.storage.six.1",
+                                          di->loctab_used*sizeof(*keys));
+   UInt *sort_ix;
    Word i, j, k;
 
-   for (i = 0; i < di->loctab_used; i++) sort_ix[i] = i;
-   sorting_loctab = di->loctab;
-   VG_(ssort)(sort_ix, di->loctab_used, 
-              sizeof(*sort_ix), compare_DiLoc_via_ix);
-   sorting_loctab = NULL;
+   for (i = 0; i < di->loctab_used; i++) {
+      keys[i].addr = di->loctab[i].addr;
+      keys[i].ix   = i;
+   }
+   VG_(ssort)(keys, di->loctab_used, 
+              sizeof(*keys), compare_DiLocSortKey);
+   sort_ix = ML_(dinfo_zalloc)("di.storage.six",
+                               di->loctab_used*sizeof(UInt));
+   for (i = 0; i < di->loctab_used; i++) sort_ix[i] = keys[i].ix;
+   ML_(dinfo_free)(keys);
 
    // Permute in place, using the sort_ix.
    for (i=0; i < di->loctab_used; i++) {
@@ -2255,12 +2266,25 @@ void ML_(finish_CFSI_arrays) ( struct _DebugInfo* di )
 void ML_(canonicaliseTables) ( struct _DebugInfo* di )
 {
    canonicaliseSymtab ( di );
-   canonicaliseLoctab ( di );
-   canonicaliseInltab ( di );
+   if (!di->cfi_deferred)
+      ML_(canonicaliseCFITables) ( di );
+   if (!di->dwarf_deferred)
+      ML_(canonicaliseDwarfTables) ( di );
+}
+
+void ML_(canonicaliseCFITables) ( struct _DebugInfo* di )
+{
    ML_(canonicaliseCFI) ( di );
    if (di->cfsi_m_pool)
       VG_(freezeDedupPA) (di->cfsi_m_pool, ML_(dinfo_shrink_block));
+}
+
+void ML_(canonicaliseDwarfTables) ( struct _DebugInfo* di )
+{
+   canonicaliseLoctab ( di );
+   canonicaliseInltab ( di );
    canonicaliseVarInfo ( di );
+   /* No more strings or filenames will be added. */
    if (di->strpool)
       VG_(freezeDedupPA) (di->strpool, ML_(dinfo_shrink_block));
    if (di->fndnpool)
@@ -32,12 +32,20 @@
 #include "pub_core_libcassert.h"
 #include "pub_core_xarray.h"
 #include "pub_core_deduppoolalloc.h" /* self */
-#include "pub_core_hashtable.h"
-#include "pub_core_poolalloc.h"
 #include "pub_core_options.h"
 #include "pub_core_mallocfree.h"
 #include "pub_core_debuglog.h"
 
+typedef
+   struct {
+      void  *elt;     // NULL if the slot is free
+      UInt  eltSzB;
+      UInt  hash;
+   }
+   ddpa_slot;
+
+#define DDPA_MIN_SLOTS 64
+
 struct _DedupPoolAlloc {
    SizeT  poolSzB; /* Minimum size of a pool. */
    SizeT  fixedSzb; /* If using VG_(allocFixedEltDedupPA), size of elements */
@@ -50,13 +58,12 @@ struct _DedupPoolAlloc {
       The last block might be smaller due to a call to shrink_block. */
    XArray *pools;
 
-   /* hash table of pool elements, used to dedup.
-      If NULL, it means the DedupPoolAlloc is frozen. */
-   VgHashTable ht_elements;
-
-   /* Hash table nodes of pool_elements are allocated with a pool, to
-      decrease memory overhead during insertion in the DedupPoolAlloc. */
-   PoolAlloc *ht_node_pa;
+   /* Open addressing (linear probing) index of the pool elements, used
+      to dedup.  nr_slots is a power of 2, and the index is grown when it
+      is 3/4 full.  If NULL, it means the DedupPoolAlloc is frozen. */
+   ddpa_slot *index;
+   UInt nr_slots;
+   UInt nr_elts;     /* nr of used slots, i.e. of unique elements */
 
    UChar *curpool;       /* last allocated pool. */
    UChar *curpool_free;  /* Pos in current pool to allocate next elt.
@@ -69,17 +76,13 @@ struct _DedupPoolAlloc {
    /* Total nr of alloc calls, resulting in (we hope) a lot less
       real (dedup) elements. */
    ULong nr_alloc_calls;
+   /* For the stats: bytes asked for by all the alloc calls, bytes
+      actually copied in the pools, and slots looked at in the index. */
+   ULong nr_bytes_asked;
+   ULong nr_bytes_stored;
+   ULong nr_probes;
 };
 
-typedef
-   struct _ht_node {
-      struct _ht_node *next; // Read/Write by hashtable (pub_tool_hashtable.h)
-      UWord   key;           // Read by hashtable (pub_tool_hashtable.h)
-      SizeT   eltSzB;
-      void    *elt;
-   }
-   ht_node;
-
 extern DedupPoolAlloc* VG_(newDedupPA) ( SizeT  poolSzB,
                                          SizeT  eltAlign,
                                          void*  (*alloc)(const HChar*, SizeT),
@@ -104,12 +107,10 @@ extern DedupPoolAlloc* VG_(newDedupPA) ( SizeT  poolSzB,
    ddpa->free     = free_fn;
    ddpa->pools    = VG_(newXA)( alloc, cc, free_fn, sizeof(void*) );
 
-   ddpa->ht_elements = VG_(HT_construct) (cc);
-   ddpa->ht_node_pa = VG_(newPA) ( sizeof(ht_node),
-                                   1000,
-                                   alloc,
-                                   cc,
-                                   free_fn);
+   ddpa->nr_slots = DDPA_MIN_SLOTS;
+   ddpa->nr_elts  = 0;
+   ddpa->index    = alloc(cc, ddpa->nr_slots * sizeof(ddpa_slot));
+   VG_(memset)(ddpa->index, 0, ddpa->nr_slots * sizeof(ddpa_slot));
    ddpa->curpool = NULL;
    ddpa->curpool_limit = NULL;
    ddpa->curpool_free = ddpa->curpool_limit + 1;
@@ -120,7 +121,7 @@ extern DedupPoolAlloc* VG_(newDedupPA) ( SizeT  poolSzB,
 void VG_(deleteDedupPA) ( DedupPoolAlloc* ddpa)
 {
    Word i;
-   if (ddpa->ht_elements)
+   if (ddpa->index)
       // Free data structures used for insertion.
       VG_(freezeDedupPA) (ddpa, NULL);
    for (i = 0; i < VG_(sizeXA) (ddpa->pools); i++)
@@ -150,15 +151,16 @@ static void ddpa_add_new_pool_or_grow ( DedupPoolAlloc* ddpa )
       UChar *newpool_free = ddpa_align (ddpa, newpool);
       UChar *newpool_limit = newpool + 2 * curpool_size - 1;
       Word reloc_offset = (Addr)newpool_free - (Addr)curpool_align;
-      ht_node *n;
+      UInt i;
 
       vg_assert (newpool);
       VG_(memcpy) (newpool_free, curpool_align, curpool_used);
       /* We have reallocated the (only) pool. We need to relocate the pointers
-         in the hash table nodes. */
-      VG_(HT_ResetIter) (ddpa->ht_elements);
-      while ((n = VG_(HT_Next) (ddpa->ht_elements))) {
-        n->elt = (void*)((Addr)n->elt + reloc_offset);
+         in the index. */
+      for (i = 0; i < ddpa->nr_slots; i++) {
+         if (ddpa->index[i].elt)
+            ddpa->index[i].elt = (void*)((Addr)ddpa->index[i].elt
+                                         + reloc_offset);
       }
       newpool_free += curpool_used;
 
@@ -180,41 +182,102 @@ static void ddpa_add_new_pool_or_grow ( DedupPoolAlloc* ddpa )
    }
 }
 
-static Word cmp_pool_elt (const void* node1, const void* node2 )
+/* An xxhash-like hash: elt is consumed a word at a time, each word
+   being multiplied in with a rotate, then the result is avalanched. */
+#define DDPA_PRIME1 0x9E3779B185EBCA87ULL
+#define DDPA_PRIME2 0xC2B2AE3D27D4EB4FULL
+#define DDPA_PRIME3 0x165667B19E3779F9ULL
+
+static __inline__ ULong ddpa_rotl ( ULong x, Int n )
 {
-   const ht_node* hnode1 = node1;
-   const ht_node* hnode2 = node2;
-
-   if (hnode1->key < hnode2->key)
-      return -1;
-   else if (hnode1->key > hnode2->key)
-      return 1;
-   else if (hnode1->eltSzB == hnode2->eltSzB)
-      return VG_(memcmp) (hnode1->elt, hnode2->elt, hnode1->eltSzB);
-   else if (hnode1->eltSzB < hnode2->eltSzB)
-      return -1;
-   else
-      return 1;
+   return (x << n) | (x >> (64 - n));
+}
+
+static __inline__ ULong ddpa_load8 ( const UChar *p )
+{
+   return (ULong)p[0]         | ((ULong)p[1] << 8)
+      |   ((ULong)p[2] << 16) | ((ULong)p[3] << 24)
+      |   ((ULong)p[4] << 32) | ((ULong)p[5] << 40)
+      |   ((ULong)p[6] << 48) | ((ULong)p[7] << 56);
+}
+
+static UInt ddpa_hash ( const UChar *p, SizeT szB )
+{
+   ULong h = DDPA_PRIME3 + szB;
+   ULong w;
+
+   while (szB >= 8) {
+      h ^= ddpa_rotl(ddpa_load8(p) * DDPA_PRIME2, 31) * DDPA_PRIME1;
+      h  = ddpa_rotl(h, 27) * DDPA_PRIME1 + DDPA_PRIME3;
+      p += 8;
+      szB -= 8;
+   }
+   w = 0;
+   while (szB > 0) {
+      szB--;
+      w = (w << 8) | p[szB];
+   }
+   h ^= w * DDPA_PRIME1;
+   h  = ddpa_rotl(h, 23) * DDPA_PRIME2;
+
+   h ^= h >> 33;
+   h *= DDPA_PRIME2;
+   h ^= h >> 29;
+   h *= DDPA_PRIME3;
+   h ^= h >> 32;
+   return (UInt)h;
+}
+
+/* Double the size of the index. */
+__attribute__((noinline))
+static void ddpa_grow_index ( DedupPoolAlloc* ddpa )
+{
+   ddpa_slot *old_index = ddpa->index;
+   UInt old_nr_slots = ddpa->nr_slots;
+   UInt i, mask;
+
+   vg_assert (ddpa->nr_slots < 0x80000000U);
+   ddpa->nr_slots *= 2;
+   ddpa->index = ddpa->alloc (ddpa->cc, ddpa->nr_slots * sizeof(ddpa_slot));
+   VG_(memset)(ddpa->index, 0, ddpa->nr_slots * sizeof(ddpa_slot));
+   mask = ddpa->nr_slots - 1;
+   for (i = 0; i < old_nr_slots; i++) {
+      UInt j;
+      if (old_index[i].elt == NULL)
+         continue;
+      j = old_index[i].hash & mask;
+      while (ddpa->index[j].elt != NULL)
+         j = (j + 1) & mask;
+      ddpa->index[j] = old_index[i];
+   }
+   ddpa->free (old_index);
 }
 
 /* Print some stats. */
 static void print_stats (DedupPoolAlloc *ddpa)
 {
+   ULong saved = ddpa->nr_bytes_asked - ddpa->nr_bytes_stored;
+   /* Both in hundredths. */
+   ULong ratio = ddpa->nr_elts == 0
+      ? 0 : (100 * ddpa->nr_alloc_calls) / ddpa->nr_elts;
+   ULong probes = ddpa->nr_alloc_calls == 0
+      ? 0 : (100 * ddpa->nr_probes) / ddpa->nr_alloc_calls;
+
    VG_(message)(Vg_DebugMsg,
-                "dedupPA:%s %ld allocs (%d uniq)"
+                "dedupPA:%s %llu allocs (%u uniq, dedup ratio %llu.%02llu)"
                 " %ld pools (%ld bytes free in last pool)\n",
                 ddpa->cc,
-                (long int) ddpa->nr_alloc_calls,
-                VG_(HT_count_nodes)(ddpa->ht_elements),
+                ddpa->nr_alloc_calls,
+                ddpa->nr_elts,
+                ratio / 100, ratio % 100,
                 VG_(sizeXA)(ddpa->pools),
                 (long int) (ddpa->curpool_limit - ddpa->curpool_free + 1));
-   VG_(HT_print_stats) (ddpa->ht_elements, cmp_pool_elt);
-}
-
-/* Dummy free, as the ht elements are allocated in a pool, and
-   we will destroy the pool in one single operation. */
-static void htelem_dummyfree(void* ht_elem)
-{
+   VG_(message)(Vg_DebugMsg,
+                "dedupPA:%s %'llu bytes asked, %'llu stored (%'llu saved),"
+                " index %u slots, %llu.%02llu probes/alloc\n",
+                ddpa->cc,
+                ddpa->nr_bytes_asked, ddpa->nr_bytes_stored, saved,
+                ddpa->nr_slots, probes / 100, probes % 100);
 }
 
 void VG_(freezeDedupPA) (DedupPoolAlloc *ddpa,
@@ -227,41 +290,34 @@ void VG_(freezeDedupPA) (DedupPoolAlloc *ddpa,
    vg_assert (!ddpa->fixedSzb || VG_(sizeXA) (ddpa->pools) == 1);
    if (shrink_block && ddpa->curpool_limit > ddpa->curpool_free)
       (*shrink_block)(ddpa->curpool, ddpa->curpool_free - ddpa->curpool);
-   VG_(HT_destruct) ( ddpa->ht_elements, htelem_dummyfree);
-   ddpa->ht_elements = NULL;
-   VG_(deletePA) (ddpa->ht_node_pa);
-   ddpa->ht_node_pa = NULL;
+   ddpa->free (ddpa->index);
+   ddpa->index = NULL;
 }
 
 void* VG_(allocEltDedupPA) (DedupPoolAlloc *ddpa, SizeT eltSzB, const void *elt)
 {
-   ht_node ht_elt;
    void* elt_ins;
-   ht_node *ht_ins;
+   UInt hash, mask, i;
    vg_assert(ddpa);
-   vg_assert(ddpa->ht_elements);
+   vg_assert(ddpa->index);
    vg_assert (eltSzB <= ddpa->poolSzB);
+   vg_assert (eltSzB <= 0xFFFFFFFFUL);
 
    ddpa->nr_alloc_calls++;
-
-   // Currently using adler32 as hash function.
-   // Many references tells adler32 is bad as a hash function.
-   // And effectively, some tests on dwarf debug string shows
-   // a lot of collisions (at least for short elements).
-   // (A lot can be 10% of the elements colliding, even on
-   // small nr of elements such as 10_000).
-   ht_elt.key = VG_(adler32) (0, NULL, 0);
-   ht_elt.key = VG_(adler32) (ht_elt.key, (UChar*)elt, eltSzB);
-
-   ht_elt.eltSzB = eltSzB;
-   ht_elt.elt = (UChar*) elt;
-
-   ht_ins = VG_(HT_gen_lookup) (ddpa->ht_elements, &ht_elt, cmp_pool_elt);
-   if (ht_ins)
-      return ht_ins->elt;
+   ddpa->nr_bytes_asked += eltSzB;
+
+   hash = ddpa_hash (elt, eltSzB);
+   mask = ddpa->nr_slots - 1;
+   for (i = hash & mask; ddpa->index[i].elt != NULL; i = (i + 1) & mask) {
+      ddpa->nr_probes++;
+      if (ddpa->index[i].hash == hash
+          && ddpa->index[i].eltSzB == eltSzB
+          && VG_(memcmp) (ddpa->index[i].elt, elt, eltSzB) == 0)
+         return ddpa->index[i].elt;
+   }
 
    /* Not found -> we need to allocate a new element from the pool
-      and insert it in the hash table of inserted elements. */
+      and insert it in the index, in the free slot i. */
 
    // Add a new pool or grow pool if not enough space in the current pool
    if (UNLIKELY(ddpa->curpool_free + eltSzB - 1 > ddpa->curpool_limit)) {
@@ -271,12 +327,14 @@ void* VG_(allocEltDedupPA) (DedupPoolAlloc *ddpa, SizeT eltSzB, const void *elt)
    elt_ins = ddpa->curpool_free;
    VG_(memcpy)(elt_ins, elt, eltSzB);
    ddpa->curpool_free = ddpa_align(ddpa, ddpa->curpool_free + eltSzB);
-
-   ht_ins = VG_(allocEltPA) (ddpa->ht_node_pa);
-   ht_ins->key = ht_elt.key;
-   ht_ins->eltSzB = eltSzB;
-   ht_ins->elt = elt_ins;
-   VG_(HT_add_node)(ddpa->ht_elements, ht_ins);
+   ddpa->nr_bytes_stored += eltSzB;
+
+   ddpa->index[i].elt = elt_ins;
+   ddpa->index[i].eltSzB = eltSzB;
+   ddpa->index[i].hash = hash;
+   ddpa->nr_elts++;
+   if (UNLIKELY(4 * (ULong)ddpa->nr_elts >= 3 * (ULong)ddpa->nr_slots))
+      ddpa_grow_index (ddpa);
    return elt_ins;
 }
 
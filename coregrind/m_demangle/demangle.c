@@ -84,7 +84,7 @@
 /* This is the main, standard demangler entry point. */
 
 void VG_(demangle) ( Bool do_cxx_demangling, Bool do_z_demangling,
-                     HChar* orig, HChar* result, Int result_size )
+                     const HChar* orig, HChar* result, Int result_size )
 {
 #  define N_ZBUF 4096
    HChar* demangled = NULL;
@@ -124,6 +124,99 @@ void VG_(demangle) ( Bool do_cxx_demangling, Bool do_z_demangling,
 }
 
 
+/*------------------------------------------------------------*/
+/*--- CACHE OF DEMANGLED NAMES                             ---*/
+/*------------------------------------------------------------*/
+
+/* Printing a stack trace demangles each of its function names, and
+   the same few names come up again and again.  So remember the
+   demangled forms, in a direct mapped cache keyed by the address of
+   the (interned) mangled name. */
+
+#define N_DEMANGLE_CACHE 2048   /* power of 2 */
+
+typedef
+   struct {
+      const HChar* orig;      /* NULL if the entry is empty */
+      Bool         cxx;       /* were these demanglings done ... */
+      Bool         z;
+      HChar*       demangled; /* ... giving this, in VG_AR_DEMANGLE */
+   }
+   DemangleCacheEnt;
+
+static DemangleCacheEnt demangle_cache[N_DEMANGLE_CACHE];
+
+static ULong n_demangle_cache_lookups = 0;
+static ULong n_demangle_cache_misses  = 0;
+
+void VG_(demangle_interned) ( Bool do_cxx_demangling, Bool do_z_demangling,
+                              const HChar* orig,
+                              HChar* result, Int result_size )
+{
+#  define N_DBUF 4096
+   UWord h = (UWord)orig;
+   DemangleCacheEnt* ce;
+   HChar buf[N_DBUF];
+
+   /* The result depends on --demangle too, so include it in the key. */
+   do_cxx_demangling = do_cxx_demangling && VG_(clo_demangle);
+
+   /* Too big a buffer to fill from the cache without truncating. */
+   if (result_size > N_DBUF) {
+      VG_(demangle)(do_cxx_demangling, do_z_demangling,
+                    orig, result, result_size);
+      return;
+   }
+
+   n_demangle_cache_lookups++;
+   h ^= h >> 11;
+   h ^= h >> 23;
+   /* Suppression matching and printing ask for the same names with
+      different flags; keep those in different entries. */
+   if (do_cxx_demangling) h ^= N_DEMANGLE_CACHE / 2;
+   if (do_z_demangling)   h ^= N_DEMANGLE_CACHE / 4;
+   ce = &demangle_cache[h & (N_DEMANGLE_CACHE-1)];
+   if (ce->orig == orig
+       && ce->cxx == do_cxx_demangling && ce->z == do_z_demangling) {
+      VG_(strncpy_safely)(result, ce->demangled, result_size);
+      return;
+   }
+
+   n_demangle_cache_misses++;
+   VG_(demangle)(do_cxx_demangling, do_z_demangling,
+                 orig, buf, N_DBUF);
+   if (ce->orig != NULL)
+      VG_(arena_free)(VG_AR_DEMANGLE, ce->demangled);
+   ce->orig      = orig;
+   ce->cxx       = do_cxx_demangling;
+   ce->z         = do_z_demangling;
+   ce->demangled = VG_(arena_strdup)(VG_AR_DEMANGLE, "demangle.di.1", buf);
+   VG_(strncpy_safely)(result, buf, result_size);
+#  undef N_DBUF
+}
+
+void VG_(demangle_cache_flush) ( void )
+{
+   Int i;
+   for (i = 0; i < N_DEMANGLE_CACHE; i++) {
+      if (demangle_cache[i].orig != NULL) {
+         VG_(arena_free)(VG_AR_DEMANGLE, demangle_cache[i].demangled);
+         demangle_cache[i].orig      = NULL;
+         demangle_cache[i].demangled = NULL;
+      }
+   }
+}
+
+void VG_(print_demangle_stats) ( void )
+{
+   if (n_demangle_cache_lookups == 0)
+      return;
+   VG_(message)(Vg_DebugMsg,
+                "demangle: %'llu lookups, %'llu demangled (cache misses)\n",
+                n_demangle_cache_lookups, n_demangle_cache_misses);
+}
+
+
 /*------------------------------------------------------------*/
 /*--- DEMANGLE Z-ENCODED NAMES                             ---*/
 /*------------------------------------------------------------*/
@@ -43,6 +43,7 @@
 #include "pub_core_libcfile.h"
 #include "pub_core_libcprint.h"
 #include "pub_core_libcproc.h"         // For VG_(getpid)()
+#include "pub_core_machine.h"          // VG_(get_IP)
 #include "pub_core_seqmatch.h"
 #include "pub_core_mallocfree.h"
 #include "pub_core_options.h"
@@ -71,12 +72,22 @@
 #define M_COLLECT_NO_ERRORS_AFTER_FOUND 10000000
 
 /* The list of error contexts found, both suppressed and unsuppressed.
-   Initially empty, and grows as errors are detected. */
+   Initially empty, and grows as errors are detected.  The most
+   recently found or seen again error context is at the front. */
 static Error* errors = NULL;
 
+/* The same error contexts, in a hash table on their kind and the top
+   two callers of their ExeContext, so that VG_(maybe_record_error)
+   only has to compare a new error with the ones which can be equal to
+   it.  Each chain is kept in the same order as the errors list.
+   errors_ht_size is a power of 2, 0 until the first error. */
+static Error** errors_ht = NULL;
+static UInt    errors_ht_size = 0;
+static UInt    n_errors = 0;  /* nr of error contexts in errors */
+
 /* The list of suppression directives, as read from the specified
-   suppressions file.  Note that the list gets rearranged as a result
-   of the searches done by is_suppressible_error(). */
+   suppressions file.  The searches done by is_suppressible_error()
+   go through the suppression index below instead. */
 static Supp* suppressions = NULL;
 
 /* Running count of unsuppressed errors detected. */
@@ -129,6 +140,8 @@ static UWord em_supplist_cmps = 0;
 */
 struct _Error {
    struct _Error* next;
+   struct _Error* prev;   // previous in errors, NULL for the first one
+   struct _Error* hnext;  // next in the errors_ht chain
    // Unique tag.  This gives the error a unique identity (handle) by
    // which it can be referred to afterwords.  Currently only used for
    // XML printing.
@@ -182,6 +195,13 @@ UInt VG_(get_n_errs_shown)( void )
    return n_errs_shown;
 }
 
+void VG_(errormgr_metrics) ( void (*put)(const HChar* name, ULong value) )
+{
+   put("errors.found", n_errs_found);
+   put("errors.shown", n_errs_shown);
+   put("errors.suppressed", n_errs_suppressed);
+}
+
 /*------------------------------------------------------------*/
 /*--- Suppression type                                     ---*/
 /*------------------------------------------------------------*/
@@ -244,6 +264,12 @@ struct _Supp {
    SuppKind skind;   // What kind of suppression.  Must use the range (0..).
    HChar* string;    // String -- use is optional.  NULL by default.
    void* extra;      // Anything else -- use is optional.  NULL by default.
+
+   // The next suppression in the same suppression index list, and
+   // the rank giving the order in which the suppressions are tried
+   // (highest first).  See build_supp_index.
+   struct _Supp* inext;
+   ULong rank;
 };
 
 SuppKind VG_(get_supp_kind) ( Supp* su )
@@ -316,6 +342,43 @@ static Bool eq_Error ( VgRes res, Error* e1, Error* e2 )
 }
 
 
+static UInt errors_ht_chain ( ErrorKind ekind, ExeContext* where )
+{
+   /* Errors are only ever compared at Vg_LowRes or finer, so equal
+      ones always land in the same chain. */
+   UWord h = VG_(hash_ExeContext)(Vg_LowRes, where)
+             ^ (ekind * 0x9E3779B1U);
+   return (UInt)(h ^ (h >> 16)) & (errors_ht_size - 1);
+}
+
+/* Enlarge errors_ht, when it has more than 2 error contexts per chain
+   on average. */
+static void maybe_resize_errors_ht ( void )
+{
+   Error* p;
+   UInt   i;
+
+   if (n_errors <= 2 * errors_ht_size)
+      return;
+
+   if (errors_ht != NULL)
+      VG_(free)(errors_ht);
+   errors_ht_size = errors_ht_size == 0 ? 1024 : 2 * errors_ht_size;
+   errors_ht = VG_(calloc)("errormgr.mreh.1",
+                           errors_ht_size, sizeof(Error*));
+
+   /* Push the errors from the last one to the first one, so as to have
+      the chains in the errors list order. */
+   p = errors;
+   while (p != NULL && p->next != NULL)
+      p = p->next;
+   for (; p != NULL; p = p->prev) {
+      i = errors_ht_chain(p->ekind, p->where);
+      p->hnext = errors_ht[i];
+      errors_ht[i] = p;
+   }
+}
+
 /* Helper functions for suppression generation: print a single line of
    a suppression pseudo-stack-trace, either in XML or text mode.  It's
    important that the behaviour of these two functions exactly
@@ -688,6 +751,22 @@ void VG_(maybe_record_error) ( ThreadId tid,
    static Bool   stopping_message = False;
    static Bool   slowdown_message = False;
 
+   /* With --fast-forward, nothing is checked until the instrumentation
+      starts.  The tool's state is not kept up to date meanwhile (the
+      stack pointer isn't tracked, for one), so what it would find, for
+      instance in the checks of system call arguments, is spurious. */
+   if (UNLIKELY(VG_(clo_fast_forward)))
+      return;
+
+   /* Nor in the code filtered out by --skip-instrument or
+      --instrument-only.  Its cheap instrumentation may still go
+      through the tool's checking helpers, to keep the tool's state up
+      to date. */
+   if (UNLIKELY(VG_(clo_skip_instrument) != NULL
+                || VG_(clo_instrument_only) != NULL)
+       && VG_(is_skipped_code)( VG_(get_IP)(tid) ))
+      return;
+
    /* After M_COLLECT_NO_ERRORS_AFTER_SHOWN different errors have
       been found, or M_COLLECT_NO_ERRORS_AFTER_FOUND total errors
       have been found, just refuse to collect any more.  This stops
@@ -752,37 +831,53 @@ void VG_(maybe_record_error) ( ThreadId tid,
    /* Build ourselves the error */
    construct_error ( &err, tid, ekind, a, s, extra, NULL );
 
-   /* First, see if we've got an error record matching this one. */
+   /* First, see if we've got an error record matching this one.  As
+      an error context can only be equal to one of the same kind and
+      with the same top two callers, only its errors_ht chain has to
+      be searched. */
    em_errlist_searches++;
-   p       = errors;
-   p_prev  = NULL;
-   while (p != NULL) {
-      em_errlist_cmps++;
-      if (eq_Error(exe_res, p, &err)) {
-         /* Found it. */
-         p->count++;
-	 if (p->supp != NULL) {
-            /* Deal correctly with suppressed errors. */
-            p->supp->count++;
-            n_errs_suppressed++;	 
-         } else {
-            n_errs_found++;
-         }
+   if (errors_ht != NULL) {
+      Error** chain = &errors_ht[errors_ht_chain(ekind, err.where)];
+      p       = *chain;
+      p_prev  = NULL;
+      while (p != NULL) {
+         em_errlist_cmps++;
+         if (eq_Error(exe_res, p, &err)) {
+            /* Found it. */
+            p->count++;
+            if (p->supp != NULL) {
+               /* Deal correctly with suppressed errors. */
+               p->supp->count++;
+               n_errs_suppressed++;	 
+            } else {
+               n_errs_found++;
+            }
 
-         /* Move p to the front of the list so that future searches
-            for it are faster. It also allows to print the last
-            error (see VG_(show_last_error). */
-         if (p_prev != NULL) {
-            vg_assert(p_prev->next == p);
-            p_prev->next = p->next;
-            p->next      = errors;
-            errors       = p;
-	 }
+            /* Move p to the front of the list (and of its chain) so
+               that future searches for it are faster. It also allows
+               to print the last error (see VG_(show_last_error). */
+            if (p_prev != NULL) {
+               vg_assert(p_prev->hnext == p);
+               p_prev->hnext = p->hnext;
+               p->hnext      = *chain;
+               *chain        = p;
+            }
+            if (p->prev != NULL) {
+               vg_assert(p->prev->next == p);
+               p->prev->next = p->next;
+               if (p->next != NULL)
+                  p->next->prev = p->prev;
+               p->prev       = NULL;
+               p->next       = errors;
+               errors->prev  = p;
+               errors        = p;
+            }
 
-         return;
+            return;
+         }
+         p_prev = p;
+         p      = p->hnext;
       }
-      p_prev = p;
-      p      = p->next;
    }
 
    /* Didn't see it.  Copy and add. */
@@ -835,8 +930,19 @@ void VG_(maybe_record_error) ( ThreadId tid,
    }
 
    p->next = errors;
+   p->prev = NULL;
+   if (errors != NULL)
+      errors->prev = p;
    p->supp = is_suppressible_error(&err);
    errors  = p;
+   n_errors++;
+   if (errors_ht_size > 0 && n_errors <= 2 * errors_ht_size) {
+      UInt i = errors_ht_chain(p->ekind, p->where);
+      p->hnext = errors_ht[i];
+      errors_ht[i] = p;
+   } else {
+      maybe_resize_errors_ht();
+   }
    if (p->supp == NULL) {
       /* update stats */
       n_err_contexts++;
@@ -912,20 +1018,42 @@ Bool VG_(unique_error) ( ThreadId tid, ErrorKind ekind, Addr a, const HChar* s,
 /*--- Exported fns                                         ---*/
 /*------------------------------------------------------------*/
 
-/* Show the used suppressions.  Returns False if no suppression
-   got used. */
+static Int cmp_Supp_by_rank ( const void* v1, const void* v2 )
+{
+   const Supp* su1 = *(const Supp* const*)v1;
+   const Supp* su2 = *(const Supp* const*)v2;
+   if (su1->rank > su2->rank) return -1;
+   if (su1->rank < su2->rank) return 1;
+   return 0;
+}
+
+/* Show the used suppressions, most recently used first.  Returns
+   False if no suppression got used. */
 static Bool show_used_suppressions ( void )
 {
    Supp  *su;
+   Supp  **used;
+   Int   i, n_used;
    Bool  any_supp;
 
    if (VG_(clo_xml))
       VG_(printf_xml)("<suppcounts>\n");
 
+   n_used = 0;
+   for (su = suppressions; su != NULL; su = su->next)
+      if (su->count > 0)
+         n_used++;
+   used = VG_(malloc)("errormgr.sus.1", (n_used > 0 ? n_used : 1)
+                                        * sizeof(Supp*));
+   n_used = 0;
+   for (su = suppressions; su != NULL; su = su->next)
+      if (su->count > 0)
+         used[n_used++] = su;
+   VG_(ssort)(used, n_used, sizeof(Supp*), cmp_Supp_by_rank);
+
    any_supp = False;
-   for (su = suppressions; su != NULL; su = su->next) {
-      if (su->count <= 0)
-         continue;
+   for (i = 0; i < n_used; i++) {
+      su = used[i];
       if (VG_(clo_xml)) {
          VG_(printf_xml)( "  <pair>\n"
                                  "    <count>%d</count>\n"
@@ -949,6 +1077,7 @@ static Bool show_used_suppressions ( void )
       }
       any_supp = True;
    }
+   VG_(free)(used);
 
    if (VG_(clo_xml))
       VG_(printf_xml)("</suppcounts>\n");
@@ -1450,6 +1579,138 @@ static void load_one_suppressions_file ( Int clo_suppressions_i )
 }
 
 
+/* Rather than trying every suppression against every error, the
+   suppressions are indexed in a trie on their first caller lines.
+   Each trie node below the root stands for a fun: or obj: line
+   without wildcards: a suppression whose first n lines (n <= 
+   SUPP_INDEX_DEPTH) are such lines, the next one (if any) not being
+   such a line, is put in the list of the node at depth n on the path
+   of these n lines, and can only match an error whose n innermost
+   (possibly inlined) frames have exactly these function or object
+   names.  The suppressions starting with "..." or with a line
+   containing '*' or '?' are in the list of the root, and are tried
+   for every error.
+
+   Each list is sorted on decreasing rank.  Initially, the ranks follow
+   the order of the suppressions list.  A suppression that matches an
+   error gets a rank higher than all others (and moves to the front of
+   its list), so by merging on rank the lists of the nodes on the paths
+   of an error's frames, is_suppressible_error tries the candidates in
+   most recently matched first order. */
+#define SUPP_INDEX_DEPTH 4
+
+typedef
+   struct _SuppIndexNode {
+      struct _SuppIndexNode* hnext;  /* next in hash chain */
+      struct _SuppIndexNode* parent; /* NULL for the root */
+      SuppLocTy ty;                  /* FunName or ObjName */
+      const HChar* name;
+      UInt n_fun_kids;               /* nr of FunName children */
+      UInt n_obj_kids;               /* nr of ObjName children */
+      Supp* supps;
+   }
+   SuppIndexNode;
+
+static SuppIndexNode   supp_index_root;
+static SuppIndexNode** supp_index = NULL; /* hash table of the other nodes */
+static UInt supp_index_size = 0;          /* nr of chains, a power of 2 */
+static ULong supp_max_rank = 0;
+
+static UInt supp_index_hash ( const SuppIndexNode* parent,
+                              SuppLocTy ty, const HChar* name )
+{
+   UInt h = (UInt)(UWord)parent ^ ((UInt)(UWord)parent >> 12) ^ ty;
+   while (*name)
+      h = (h << 5) + h + (UChar)*name++;
+   return h & (supp_index_size - 1);
+}
+
+/* Returns the child of parent for ty and name, or NULL if there is none
+   and !create. */
+static SuppIndexNode* supp_index_child ( SuppIndexNode* parent,
+                                         SuppLocTy ty, const HChar* name,
+                                         Bool create )
+{
+   UInt h = supp_index_hash(parent, ty, name);
+   SuppIndexNode* node;
+
+   for (node = supp_index[h]; node != NULL; node = node->hnext)
+      if (node->parent == parent && node->ty == ty
+          && VG_(strcmp)(node->name, name) == 0)
+         return node;
+   if (!create)
+      return NULL;
+
+   node = VG_(arena_malloc)(VG_AR_CORE, "errormgr.sic.1",
+                            sizeof(SuppIndexNode));
+   node->parent = parent;
+   node->ty = ty;
+   node->name = name;
+   node->n_fun_kids = 0;
+   node->n_obj_kids = 0;
+   node->supps = NULL;
+   node->hnext = supp_index[h];
+   supp_index[h] = node;
+   if (ty == FunName)
+      parent->n_fun_kids++;
+   else
+      parent->n_obj_kids++;
+   return node;
+}
+
+static Supp* reverse_supps ( Supp* su )
+{
+   Supp* rev = NULL;
+   while (su != NULL) {
+      Supp* inext = su->inext;
+      su->inext = rev;
+      rev = su;
+      su = inext;
+   }
+   return rev;
+}
+
+static void build_supp_index ( void )
+{
+   Supp* su;
+   UInt  i, n_supps;
+
+   n_supps = 0;
+   for (su = suppressions; su != NULL; su = su->next)
+      n_supps++;
+
+   supp_index_size = 64;
+   while (supp_index_size < n_supps)
+      supp_index_size *= 2;
+   supp_index = VG_(arena_calloc)(VG_AR_CORE, "errormgr.bsi.1",
+                                  supp_index_size, sizeof(SuppIndexNode*));
+
+   /* Push the suppressions on their lists with ranks decreasing from
+      n_supps, then reverse the lists to have them sorted on decreasing
+      rank. */
+   supp_max_rank = n_supps;
+   for (su = suppressions; su != NULL; su = su->next) {
+      SuppIndexNode* node = &supp_index_root;
+      Int d;
+      for (d = 0; d < su->n_callers && d < SUPP_INDEX_DEPTH; d++) {
+         const SuppLoc* loc = &su->callers[d];
+         if ((loc->ty != FunName && loc->ty != ObjName)
+             || !loc->name_is_simple_str)
+            break;
+         node = supp_index_child(node, loc->ty, loc->name, True);
+      }
+      su->rank = n_supps--;
+      su->inext = node->supps;
+      node->supps = su;
+   }
+   for (i = 0; i < supp_index_size; i++) {
+      SuppIndexNode* node;
+      for (node = supp_index[i]; node != NULL; node = node->hnext)
+         node->supps = reverse_supps(node->supps);
+   }
+   supp_index_root.supps = reverse_supps(supp_index_root.supps);
+}
+
 void VG_(load_suppressions) ( void )
 {
    Int i;
@@ -1461,6 +1722,7 @@ void VG_(load_suppressions) ( void )
       }
       load_one_suppressions_file( i );
    }
+   build_supp_index();
 }
 
 
@@ -1579,11 +1841,10 @@ static void pp_ip2fo (IPtoFunOrObjCompleter* ip2fo)
   }
 }
 
-/* free the memory in ip2fo.
-   At debuglog 4, su (or NULL) will be used to show the matching
-   (or non matching) with ip2fo. */
-static void clearIPtoFunOrObjCompleter ( Supp  *su, 
-                                         IPtoFunOrObjCompleter* ip2fo)
+/* At debuglog 4, show the matching of su (or the non matching if su
+   is NULL) with ip2fo. */
+static void showIPtoFunOrObjMatching ( Supp  *su,
+                                       IPtoFunOrObjCompleter* ip2fo)
 {
    if (DEBUG_ERRORMGR || VG_(debugLog_getLevel)() >= 4) {
       if (su)
@@ -1596,6 +1857,29 @@ static void clearIPtoFunOrObjCompleter ( Supp  *su,
       VG_(pp_StackTrace) (ip2fo->ips, ip2fo->n_ips);
       pp_ip2fo(ip2fo);
    }
+}
+
+/* Make ip2fo a completer for the stack trace of ec, with nothing
+   completed yet. */
+static void initIPtoFunOrObjCompleter ( ExeContext* ec,
+                                        IPtoFunOrObjCompleter* ip2fo)
+{
+   ip2fo->ips = VG_(get_ExeContext_StackTrace)(ec);
+   ip2fo->n_ips = VG_(get_ExeContext_n_ips)(ec);
+   ip2fo->n_ips_expanded = 0;
+   ip2fo->n_expanded = 0;
+   ip2fo->sz_offsets = 0;
+   ip2fo->n_offsets_per_ip = NULL;
+   ip2fo->fun_offsets = NULL;
+   ip2fo->obj_offsets = NULL;
+   ip2fo->names = NULL;
+   ip2fo->names_szB = 0;
+   ip2fo->names_free = 0;
+}
+
+/* free the memory in ip2fo. */
+static void clearIPtoFunOrObjCompleter ( IPtoFunOrObjCompleter* ip2fo)
+{
    if (ip2fo->n_offsets_per_ip) VG_(free)(ip2fo->n_offsets_per_ip);
    if (ip2fo->fun_offsets)      VG_(free)(ip2fo->fun_offsets);
    if (ip2fo->obj_offsets)      VG_(free)(ip2fo->obj_offsets);
@@ -1881,16 +2165,64 @@ Bool supp_matches_error(Supp* su, Error* err)
 
 /////////////////////////////////////////////////////
 
+/* The completers of the last few ExeContexts matched against the
+   suppressions are kept, so that the frames of an ExeContext found
+   in several errors (e.g. in the loss records of successive leak
+   searches) are only symbolised once.  They are dropped when some
+   debuginfo is loaded or unloaded, as the names can then change. */
+#define N_IP2FO_CACHE 64
+
+typedef
+   struct {
+      ExeContext* ec;  /* NULL if the entry is unused */
+      UInt generation; /* VG_(CF_info_generation) when ip2fo was made */
+      IPtoFunOrObjCompleter ip2fo;
+   }
+   IP2FOCacheEnt;
+
+static IP2FOCacheEnt ip2fo_cache[N_IP2FO_CACHE];
+
+/* Stats: number of suppression searches which found the names of the
+   error's frames in ip2fo_cache. */
+static UWord em_ip2fo_cache_hits = 0;
+
+static IPtoFunOrObjCompleter* get_IPtoFunOrObjCompleter ( ExeContext* ec )
+{
+   IP2FOCacheEnt* ce
+      = &ip2fo_cache[VG_(get_ECU_from_ExeContext)(ec) % N_IP2FO_CACHE];
+   UInt generation = VG_(CF_info_generation)();
+
+   if (ce->ec == ec && ce->generation == generation) {
+      em_ip2fo_cache_hits++;
+      return &ce->ip2fo;
+   }
+   if (ce->ec != NULL)
+      clearIPtoFunOrObjCompleter(&ce->ip2fo);
+   ce->ec = ec;
+   ce->generation = generation;
+   initIPtoFunOrObjCompleter(ec, &ce->ip2fo);
+   return &ce->ip2fo;
+}
+
 /* Does an error context match a suppression?  ie is this a suppressible
    error?  If so, return a pointer to the Supp record, otherwise NULL.
    Tries to minimise the number of symbol searches since they are expensive.  
 */
 static Supp* is_suppressible_error ( Error* err )
 {
-   Supp* su;
-   Supp* su_prev;
-
-   IPtoFunOrObjCompleter ip2fo;
+   /* The suppression index nodes whose list can contain a suppression
+      matching err: the root, and at each depth d < SUPP_INDEX_DEPTH,
+      the fun and obj children of the nodes of depth d having the
+      names of err's frame d.  For each, the next suppression of the
+      list to try, and the one tried before it. */
+#  define N_NODES_MAX ((1 << (SUPP_INDEX_DEPTH + 1)) - 1)
+   SuppIndexNode* nodes[N_NODES_MAX];
+   Supp*  next[N_NODES_MAX];
+   Supp*  prev[N_NODES_MAX];
+   Int    n_nodes, d, d_start, d_end, i, best;
+   Supp*  su;
+
+   IPtoFunOrObjCompleter* ip2fo;
    /* Conceptually, ip2fo contains an array of function names and an array of
       object names, corresponding to the array of IP of err->where.
       These names are just computed 'on demand' (so once maximum),
@@ -1908,45 +2240,75 @@ static Supp* is_suppressible_error ( Error* err )
    /* stats gathering */
    em_supplist_searches++;
 
-   /* Prepare the lazy input completer. */
-   ip2fo.ips = VG_(get_ExeContext_StackTrace)(err->where);
-   ip2fo.n_ips = VG_(get_ExeContext_n_ips)(err->where);
-   ip2fo.n_ips_expanded = 0;
-   ip2fo.n_expanded = 0;
-   ip2fo.sz_offsets = 0;
-   ip2fo.n_offsets_per_ip = NULL;
-   ip2fo.fun_offsets = NULL;
-   ip2fo.obj_offsets = NULL;
-   ip2fo.names = NULL;
-   ip2fo.names_szB = 0;
-   ip2fo.names_free = 0;
-
-   /* See if the error context matches any suppression. */
+   /* Get the lazy input completer. */
+   ip2fo = get_IPtoFunOrObjCompleter(err->where);
+
+   /* Find the index nodes to look at. */
+   nodes[0] = &supp_index_root;
+   n_nodes = 1;
+   d_start = 0;
+   for (d = 0; d < SUPP_INDEX_DEPTH && haveInputInpC(ip2fo, d); d++) {
+      d_end = n_nodes;
+      for (i = d_start; i < d_end; i++) {
+         SuppIndexNode* node;
+         if (nodes[i]->n_fun_kids > 0) {
+            node = supp_index_child(nodes[i], FunName,
+                                    foComplete(ip2fo, d, True), False);
+            if (node != NULL)
+               nodes[n_nodes++] = node;
+         }
+         if (nodes[i]->n_obj_kids > 0) {
+            node = supp_index_child(nodes[i], ObjName,
+                                    foComplete(ip2fo, d, False), False);
+            if (node != NULL)
+               nodes[n_nodes++] = node;
+         }
+      }
+      d_start = d_end;
+   }
+   for (i = 0; i < n_nodes; i++) {
+      next[i] = nodes[i]->supps;
+      prev[i] = NULL;
+   }
+
+   /* See if the error context matches any suppression, trying them in
+      decreasing rank order. */
    if (DEBUG_ERRORMGR || VG_(debugLog_getLevel)() >= 4)
      VG_(dmsg)("errormgr matching begin\n");
-   su_prev = NULL;
-   for (su = suppressions; su != NULL; su = su->next) {
+   while (True) {
+      best = -1;
+      for (i = 0; i < n_nodes; i++)
+         if (next[i] != NULL
+             && (best == -1 || next[i]->rank > next[best]->rank))
+            best = i;
+      if (best == -1)
+         break;
+      su = next[best];
       em_supplist_cmps++;
       if (supp_matches_error(su, err) 
-          && supp_matches_callers(&ip2fo, su)) {
+          && supp_matches_callers(ip2fo, su)) {
          /* got a match.  */
          /* Inform the tool that err is suppressed by su. */
          (void)VG_TDICT_CALL(tool_update_extra_suppression_use, err, su);
-         /* Move this entry to the head of the list
-            in the hope of making future searches cheaper. */
-         if (su_prev) {
-            vg_assert(su_prev->next == su);
-            su_prev->next = su->next;
-            su->next = suppressions;
-            suppressions = su;
+         /* Give this entry the highest rank, and move it to the head
+            of its list, in the hope of making future searches
+            cheaper. */
+         su->rank = ++supp_max_rank;
+         if (prev[best]) {
+            vg_assert(prev[best]->inext == su);
+            prev[best]->inext = su->inext;
+            su->inext = nodes[best]->supps;
+            nodes[best]->supps = su;
          }
-         clearIPtoFunOrObjCompleter(su, &ip2fo);
+         showIPtoFunOrObjMatching(su, ip2fo);
          return su;
       }
-      su_prev = su;
+      prev[best] = su;
+      next[best] = su->inext;
    }
-   clearIPtoFunOrObjCompleter(NULL, &ip2fo);
+   showIPtoFunOrObjMatching(NULL, ip2fo);
    return NULL;      /* no matches */
+#  undef N_NODES_MAX
 }
 
 /* Show accumulated error-list and suppression-list search stats. 
@@ -1954,8 +2316,9 @@ static Supp* is_suppressible_error ( Error* err )
 void VG_(print_errormgr_stats) ( void )
 {
    VG_(dmsg)(
-      " errormgr: %'lu supplist searches, %'lu comparisons during search\n",
-      em_supplist_searches, em_supplist_cmps
+      " errormgr: %'lu supplist searches, %'lu comparisons during search,"
+      " %'lu names cache hits\n",
+      em_supplist_searches, em_supplist_cmps, em_ip2fo_cache_hits
    );
    VG_(dmsg)(
       " errormgr: %'lu errlist searches, %'lu comparisons during search\n",
@@ -30,7 +30,9 @@
 
 #include "pub_core_basics.h"
 #include "pub_core_debuglog.h"
+#include "pub_core_hashtable.h"
 #include "pub_core_libcassert.h"
+#include "pub_core_libcbase.h"
 #include "pub_core_libcprint.h"     // For VG_(message)()
 #include "pub_core_mallocfree.h"
 #include "pub_core_options.h"
@@ -56,7 +58,16 @@
    to keep the load factor below 1.0.
 
    The idea is only to ever store any one context once, so as to save
-   space and make exact comparisons faster. */
+   space and make exact comparisons faster.
+
+   To save more space, the IPs are not stored as such but as a byte
+   string: each IP is the difference from the one before (from 0 for
+   the first) in zigzag LEB128 form.  Adjacent frames are usually in
+   the same object, so each mostly takes 3 or 4 bytes rather than 8.
+   A new trace is encoded the same way to look it up, so comparisons
+   are just comparisons of the byte strings.  Callers of
+   VG_(get_ExeContext_StackTrace), which want an array of IPs that
+   stays put, get one made the first time it is asked for. */
 
 
 /* Primes for the hash table */
@@ -73,7 +84,8 @@ static SizeT ec_primes[N_EC_PRIMES] = {
 
 
 /* Each element is present in a hash chain, and also contains a
-   variable length array of guest code addresses (the useful part). */
+   variable length encoding of guest code addresses (the useful
+   part). */
 
 struct _ExeContext {
    struct _ExeContext* chain;
@@ -83,13 +95,32 @@ struct _ExeContext {
       be a multiple of four, and must be unique.  Hence they start at
       4. */
    UInt ecu;
-   /* Variable-length array.  The size is 'n_ips'; at
-      least 1, at most VG_DEEPEST_BACKTRACE.  [0] is the current IP,
-      [1] is its caller, [2] is the caller of [1], etc. */
-   UInt n_ips;
-   Addr ips[0];
+   /* calc_hash of the IPs, kept so that resizing the hash table
+      doesn't need to decode them. */
+   UInt hash;
+   /* The number of IPs, at least 1, at most VG_DEEPEST_BACKTRACE. */
+   UShort n_ips;
+   /* Variable-length array.  The size is 'n_bytes'.  It holds the IPs
+      encoded as described above: [0] is the current IP, [1] is its
+      caller, [2] is the caller of [1], etc. */
+   UShort n_bytes;
+   UChar bytes[0];
 };
 
+/* The most bytes an IP can take when encoded. */
+#define MAX_BYTES_PER_IP 10
+
+/* The arrays handed out by VG_(get_ExeContext_StackTrace), by ECU. */
+typedef
+   struct _ECIps {
+      struct _ECIps* next;
+      UWord          ecu;
+      Addr           ips[0];
+   }
+   ECIps;
+
+static VgHashTable ec_ips_ht;
+
 
 /* This is the dynamically expanding hash table. */
 static ExeContext** ec_htab; /* array [ec_htab_size] of ExeContext* */
@@ -111,11 +142,91 @@ static ULong ec_searchcmps;
 /* Stats only: total number of stored contexts. */
 static ULong ec_totstored;
 
+/* Stats only: total number of IPs and bytes they are encoded in. */
+static ULong ec_totips;
+static ULong ec_totbytes;
+
 /* Number of 2, 4 and (fast) full cmps done. */
 static ULong ec_cmp2s;
 static ULong ec_cmp4s;
 static ULong ec_cmpAlls;
 
+/* Capture buffers for record_ExeContext_wrk{,2}.  Only the thread
+   holding the big lock can be recording a context, so one pair serves
+   all threads, and taking a trace doesn't need several KB of the
+   (small) host stack for it. */
+static Addr  ec_capture_ips[VG_DEEPEST_BACKTRACE];
+static UChar ec_capture_bytes[VG_DEEPEST_BACKTRACE * MAX_BYTES_PER_IP];
+
+
+/* Encode ips[0 .. n_ips-1] into buf, which must have room for
+   n_ips * MAX_BYTES_PER_IP bytes, and return the number of bytes
+   used. */
+static UInt encode_ips ( const Addr* ips, UInt n_ips, /*OUT*/UChar* buf )
+{
+   UInt  i, n = 0;
+   Addr  prev = 0;
+   for (i = 0; i < n_ips; i++) {
+      Word  d = (Word)(ips[i] - prev);
+      UWord z = ((UWord)d << 1) ^ (UWord)(d >> (8 * sizeof(Word) - 1));
+      while (z >= 0x80) {
+         buf[n++] = (UChar)(z | 0x80);
+         z >>= 7;
+      }
+      buf[n++] = (UChar)z;
+      prev = ips[i];
+   }
+   return n;
+}
+
+/* Decode the first max_n_ips (or all, if fewer) of ec's IPs into
+   ips, and return how many that is. */
+static UInt decode_ips ( const ExeContext* ec, /*OUT*/Addr* ips,
+                         UInt max_n_ips )
+{
+   UInt  i, n = 0;
+   Addr  prev = 0;
+   UInt  n_ips = ec->n_ips < max_n_ips ? ec->n_ips : max_n_ips;
+   for (i = 0; i < n_ips; i++) {
+      UWord z = 0;
+      Int   shift = 0;
+      UChar b;
+      do {
+         b = ec->bytes[n++];
+         z |= (UWord)(b & 0x7F) << shift;
+         shift += 7;
+      } while (b & 0x80);
+      prev += (Addr)((z >> 1) ^ -(z & 1));
+      ips[i] = prev;
+   }
+   return n_ips;
+}
+
+/* Does ec hold exactly ips[0 .. n_ips-1]?  Decodes only as far as the
+   first difference, so a trace can be looked up without encoding it
+   first. */
+static Bool same_ips ( const ExeContext* ec, const Addr* ips, UInt n_ips )
+{
+   UInt  i, n = 0;
+   Addr  prev = 0;
+   if (ec->n_ips != n_ips)
+      return False;
+   for (i = 0; i < n_ips; i++) {
+      UWord z = 0;
+      Int   shift = 0;
+      UChar b;
+      do {
+         b = ec->bytes[n++];
+         z |= (UWord)(b & 0x7F) << shift;
+         shift += 7;
+      } while (b & 0x80);
+      prev += (Addr)((z >> 1) ^ -(z & 1));
+      if (prev != ips[i])
+         return False;
+   }
+   return n == ec->n_bytes;
+}
+
 
 /*------------------------------------------------------------*/
 /*--- Exported functions.                                  ---*/
@@ -133,6 +244,8 @@ static void init_ExeContext_storage ( void )
    ec_searchreqs = 0;
    ec_searchcmps = 0;
    ec_totstored = 0;
+   ec_totips = 0;
+   ec_totbytes = 0;
    ec_cmp2s = 0;
    ec_cmp4s = 0;
    ec_cmpAlls = 0;
@@ -143,6 +256,7 @@ static void init_ExeContext_storage ( void )
                          sizeof(ExeContext*) * ec_htab_size);
    for (i = 0; i < ec_htab_size; i++)
       ec_htab[i] = NULL;
+   ec_ips_ht = VG_(HT_construct)("execontext.iEs2");
 
    {
       Addr ips[1];
@@ -168,8 +282,8 @@ void VG_(print_ExeContext_stats) ( Bool with_stacktraces )
       for (i = 0; i < ec_htab_size; i++) {
          for (ec = ec_htab[i]; ec; ec = ec->chain) {
             VG_(message)(Vg_DebugMsg, "   exectx: stacktrace ecu %u n_ips %u\n",
-                         ec->ecu, ec->n_ips);
-            VG_(pp_StackTrace)( ec->ips, ec->n_ips );
+                         ec->ecu, (UInt)ec->n_ips);
+            VG_(pp_ExeContext)( ec );
          }
       }
       VG_(message)(Vg_DebugMsg, 
@@ -181,6 +295,12 @@ void VG_(print_ExeContext_stats) ( Bool with_stacktraces )
       "   exectx: %'lu lists, %'llu contexts (avg %'llu per list)\n",
       ec_htab_size, ec_totstored, ec_totstored / (ULong)ec_htab_size
    );
+   VG_(message)(Vg_DebugMsg,
+      "   exectx: %'llu IPs in %'llu bytes (avg %'llu.%llu per IP)\n",
+      ec_totips, ec_totbytes,
+      ec_totips == 0 ? 0ULL : ec_totbytes / ec_totips,
+      ec_totips == 0 ? 0ULL : (ec_totbytes * 10ULL / ec_totips) % 10ULL
+   );
    VG_(message)(Vg_DebugMsg, 
       "   exectx: %'llu searches, %'llu full compares (%'llu per 1000)\n",
       ec_searchreqs, ec_searchcmps, 
@@ -194,18 +314,26 @@ void VG_(print_ExeContext_stats) ( Bool with_stacktraces )
    );
 }
 
+ULong VG_(get_n_ExeContexts) ( void )
+{
+   return ec_totstored;
+}
+
 
 /* Print an ExeContext. */
 void VG_(pp_ExeContext) ( ExeContext* ec )
 {
-   VG_(pp_StackTrace)( ec->ips, ec->n_ips );
+   Addr ips[ec->n_ips];
+   decode_ips( ec, ips, ec->n_ips );
+   VG_(pp_StackTrace_of_ECU)( ec->ecu, ips, ec->n_ips );
 }
 
 
 /* Compare two ExeContexts.  Number of callers considered depends on res. */
 Bool VG_(eq_ExeContext) ( VgRes res, ExeContext* e1, ExeContext* e2 )
 {
-   Int i;
+   Int  i;
+   Addr ips1[4], ips2[4];
 
    if (e1 == NULL || e2 == NULL) 
       return False;
@@ -217,22 +345,26 @@ Bool VG_(eq_ExeContext) ( VgRes res, ExeContext* e1, ExeContext* e2 )
    case Vg_LowRes:
       /* Just compare the top two callers. */
       ec_cmp2s++;
+      decode_ips(e1, ips1, 2);
+      decode_ips(e2, ips2, 2);
       for (i = 0; i < 2; i++) {
          if ( (e1->n_ips <= i) &&  (e2->n_ips <= i)) return True;
          if ( (e1->n_ips <= i) && !(e2->n_ips <= i)) return False;
          if (!(e1->n_ips <= i) &&  (e2->n_ips <= i)) return False;
-         if (e1->ips[i] != e2->ips[i])               return False;
+         if (ips1[i] != ips2[i])                     return False;
       }
       return True;
 
    case Vg_MedRes:
       /* Just compare the top four callers. */
       ec_cmp4s++;
+      decode_ips(e1, ips1, 4);
+      decode_ips(e2, ips2, 4);
       for (i = 0; i < 4; i++) {
          if ( (e1->n_ips <= i) &&  (e2->n_ips <= i)) return True;
          if ( (e1->n_ips <= i) && !(e2->n_ips <= i)) return False;
          if (!(e1->n_ips <= i) &&  (e2->n_ips <= i)) return False;
-         if (e1->ips[i] != e2->ips[i])               return False;
+         if (ips1[i] != ips2[i])                     return False;
       }
       return True;
 
@@ -247,6 +379,60 @@ Bool VG_(eq_ExeContext) ( VgRes res, ExeContext* e1, ExeContext* e2 )
    }
 }
 
+/* Number of callers that VG_(eq_ExeContext) looks at for 'res', or 0 if
+   it compares the ExeContexts themselves. */
+static Int res_n_ips ( VgRes res )
+{
+   switch (res) {
+   case Vg_LowRes:  return 2;
+   case Vg_MedRes:  return 4;
+   case Vg_HighRes: return 0;
+   default:
+      VG_(core_panic)("res_n_ips: unrecognised VgRes");
+   }
+}
+
+UWord VG_(hash_ExeContext) ( VgRes res, ExeContext* e )
+{
+   Int   i, n;
+   UWord hash;
+   Addr  ips[4];
+
+   tl_assert(e != NULL);
+   n = res_n_ips(res);
+   if (n == 0)
+      return (UWord)e >> 4;
+   n = decode_ips(e, ips, n);
+   hash = n;
+   for (i = 0; i < n; i++) {
+      hash ^= ips[i];
+      hash *= (UWord)0x9E3779B97F4A7C15ULL;
+      hash ^= hash >> 29;
+   }
+   return hash;
+}
+
+Word VG_(cmp_ExeContext) ( VgRes res, ExeContext* e1, ExeContext* e2 )
+{
+   Int  i, n;
+   Addr ips1[4], ips2[4];
+
+   tl_assert(e1 != NULL && e2 != NULL);
+   n = res_n_ips(res);
+   if (n == 0 || e1 == e2)
+      return e1 < e2 ? -1 : e1 > e2 ? 1 : 0;
+   decode_ips(e1, ips1, n);
+   decode_ips(e2, ips2, n);
+   for (i = 0; i < n; i++) {
+      if (e1->n_ips <= i && e2->n_ips <= i) return 0;
+      if (e1->n_ips <= i) return -1;
+      if (e2->n_ips <= i) return  1;
+      if (ips1[i] < ips2[i]) return -1;
+      if (ips1[i] > ips2[i]) return  1;
+   }
+   return 0;
+}
+
 /* VG_(record_ExeContext) is the head honcho here.  Take a snapshot of
    the client's stack.  Search our collection of ExeContexts to see if
    we already have it, and if not, allocate a new one.  Either way,
@@ -266,16 +452,15 @@ static inline UWord ROLW ( UWord w, Int n )
    return w;
 }
 
-static UWord calc_hash ( Addr* ips, UInt n_ips, UWord htab_sz )
+static UInt calc_hash ( Addr* ips, UInt n_ips )
 {
    UInt  i;
    UWord hash = 0;
-   vg_assert(htab_sz > 0);
    for (i = 0; i < n_ips; i++) {
       hash ^= ips[i];
       hash = ROLW(hash, 19);
    }
-   return hash % htab_sz;
+   return (UInt)(hash ^ (hash >> 32));
 }
 
 static void resize_ec_htab ( void )
@@ -304,7 +489,7 @@ static void resize_ec_htab ( void )
       ExeContext* cur = ec_htab[i];
       while (cur) {
          ExeContext* next = cur->chain;
-         UWord hash = calc_hash(cur->ips, cur->n_ips, new_size);
+         UWord hash = cur->hash % new_size;
          vg_assert(hash < new_size);
          cur->chain = new_ec_htab[hash];
          new_ec_htab[hash] = cur;
@@ -324,8 +509,8 @@ static void resize_ec_htab ( void )
 static ExeContext* record_ExeContext_wrk ( ThreadId tid, Word first_ip_delta,
                                            Bool first_ip_only )
 {
-   Addr ips[VG_(clo_backtrace_size)];
-   UInt n_ips;
+   Addr* ips = ec_capture_ips;
+   UInt  n_ips;
 
    init_ExeContext_storage();
 
@@ -355,7 +540,9 @@ static ExeContext* record_ExeContext_wrk2 ( Addr* ips, UInt n_ips )
 {
    Int         i;
    Bool        same;
+   UInt        full_hash;
    UWord       hash;
+   UInt        n_bytes;
    ExeContext* new_ec;
    ExeContext* list;
    ExeContext  *prev2, *prev;
@@ -366,9 +553,12 @@ static ExeContext* record_ExeContext_wrk2 ( Addr* ips, UInt n_ips )
 
    /* Now figure out if we've seen this one before.  First hash it so
       as to determine the list number. */
-   hash = calc_hash( ips, n_ips, ec_htab_size );
+   full_hash = calc_hash( ips, n_ips );
+   hash = full_hash % ec_htab_size;
 
-   /* And (the expensive bit) look a for matching entry in the list. */
+   /* And (the expensive bit) look a for matching entry in the list.
+      This compares against the IPs directly, so finding a trace we
+      already have neither encodes nor copies it. */
 
    ec_searchreqs++;
 
@@ -379,10 +569,7 @@ static ExeContext* record_ExeContext_wrk2 ( Addr* ips, UInt n_ips )
    while (True) {
       if (list == NULL) break;
       ec_searchcmps++;
-      same = list->n_ips == n_ips;
-      for (i = 0; i < n_ips && same ; i++) {
-         same = list->ips[i] == ips[i];
-      }
+      same = list->hash == full_hash && same_ips(list, ips, n_ips);
       if (same) break;
       prev2 = prev;
       prev  = list;
@@ -415,14 +602,16 @@ static ExeContext* record_ExeContext_wrk2 ( Addr* ips, UInt n_ips )
    }
 
    /* Bummer.  We have to allocate a new context record. */
+   n_bytes = encode_ips( ips, n_ips, ec_capture_bytes );
    ec_totstored++;
+   ec_totips += n_ips;
+   ec_totbytes += n_bytes;
 
-   new_ec = VG_(perm_malloc)( sizeof(struct _ExeContext) 
-                              + n_ips * sizeof(Addr),
+   new_ec = VG_(perm_malloc)( sizeof(struct _ExeContext) + n_bytes,
                               vg_alignof(struct _ExeContext));
 
-   for (i = 0; i < n_ips; i++)
-      new_ec->ips[i] = ips[i];
+   for (i = 0; i < n_bytes; i++)
+      new_ec->bytes[i] = ec_capture_bytes[i];
 
    vg_assert(VG_(is_plausible_ECU)(ec_next_ecu));
    new_ec->ecu = ec_next_ecu;
@@ -433,7 +622,9 @@ static ExeContext* record_ExeContext_wrk2 ( Addr* ips, UInt n_ips )
       VG_(core_panic)("m_execontext: more than 2^30 ExeContexts created");
    }
 
+   new_ec->hash = full_hash;
    new_ec->n_ips = n_ips;
+   new_ec->n_bytes = n_bytes;
    new_ec->chain = ec_htab[hash];
    ec_htab[hash] = new_ec;
 
@@ -464,7 +655,15 @@ ExeContext* VG_(make_depth_1_ExeContext_from_Addr)( Addr a ) {
 }
 
 StackTrace VG_(get_ExeContext_StackTrace) ( ExeContext* e ) {
-   return e->ips;
+   ECIps* ei = VG_(HT_lookup)( ec_ips_ht, e->ecu );
+   if (ei == NULL) {
+      ei = VG_(perm_malloc)( sizeof(ECIps) + e->n_ips * sizeof(Addr),
+                             vg_alignof(ECIps) );
+      ei->ecu = e->ecu;
+      decode_ips( e, ei->ips, e->n_ips );
+      VG_(HT_add_node)( ec_ips_ht, ei );
+   }
+   return ei->ips;
 }  
 
 UInt VG_(get_ECU_from_ExeContext)( ExeContext* e ) {
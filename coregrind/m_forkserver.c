@@ -0,0 +1,144 @@
+
+/*--------------------------------------------------------------------*/
+/*--- The fork server.                              m_forkserver.c ---*/
+/*--------------------------------------------------------------------*/
+
+/*
+   This file is part of Valgrind, a dynamic binary instrumentation
+   framework.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of the
+   License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+   02111-1307, USA.
+
+   The GNU General Public License is contained in the file COPYING.
+*/
+
+#include "pub_core_basics.h"
+#include "pub_core_vki.h"
+#include "pub_core_clientstate.h"     // VG_(fd_hard_limit)
+#include "pub_core_libcassert.h"
+#include "pub_core_libcbase.h"
+#include "pub_core_libcfile.h"
+#include "pub_core_libcprint.h"
+#include "pub_core_libcproc.h"
+#include "pub_core_libcsignal.h"
+#include "pub_core_options.h"
+#include "pub_core_libcsetjmp.h"    // to keep _threadstate.h happy
+#include "pub_core_threadstate.h"
+#include "pub_core_forkserver.h"    // self
+
+/* The fds on which requests are read and replies written, moved out
+   of the client's way.  -1 if there is no fork server, or in the
+   children. */
+static Int req_fd   = -1;
+static Int reply_fd = -1;
+
+void VG_(fork_server_init) ( void )
+{
+   Int fd = VG_(clo_fork_server_fd);
+
+   if (fd == -1)
+      return;
+   if (fd < 0 || fd + 1 >= VG_(fd_hard_limit)
+       || VG_(fcntl)(fd, VKI_F_GETFD, 0) == -1
+       || VG_(fcntl)(fd + 1, VKI_F_GETFD, 0) == -1)
+      VG_(fmsg_bad_option)("--fork-server-fd",
+                           "File descriptors %d and %d must be open.\n",
+                           fd, fd + 1);
+   req_fd   = VG_(safe_fd)(fd);
+   reply_fd = VG_(safe_fd)(fd + 1);
+}
+
+static void close_fork_server_fds ( void )
+{
+   VG_(close)(req_fd);
+   VG_(close)(reply_fd);
+   req_fd = reply_fd = -1;
+}
+
+static Bool reply ( Int msg )
+{
+   return VG_(write)(reply_fd, &msg, sizeof(msg)) == sizeof(msg);
+}
+
+/* Fork a child, as the fork syscall wrapper does.  Returns the child
+   pid in the parent, 0 in the child, and -1 if it failed. */
+static Int fork_child ( ThreadId tid )
+{
+   Int pid;
+   vki_sigset_t mask, saved_mask;
+
+   VG_(sigfillset)(&mask);
+   VG_(sigprocmask)(VKI_SIG_SETMASK, &mask, &saved_mask);
+   VG_(flush_output_sinks)();
+
+   VG_(do_atfork_pre)(tid);
+   pid = VG_(fork)();
+   if (pid == 0) {
+      VG_(do_atfork_child)(tid);
+      if (VG_(clo_child_silent_after_fork)) {
+         if (!VG_(log_output_sink).is_socket)
+            VG_(log_output_sink).fd = -1;
+         if (!VG_(xml_output_sink).is_socket)
+            VG_(xml_output_sink).fd = -1;
+      }
+   } else {
+      VG_(do_atfork_parent)(tid);
+   }
+
+   VG_(sigprocmask)(VKI_SIG_SETMASK, &saved_mask, NULL);
+   return pid;
+}
+
+UWord VG_(fork_server) ( ThreadId tid )
+{
+   Int msg, pid, status;
+
+   if (req_fd == -1)
+      return 0;
+
+   /* The children would have only the requesting thread. */
+   if (VG_(count_living_threads)() > 1) {
+      VG_(umsg)("Warning: fork server not started: "
+                "the client has more than one thread\n");
+      close_fork_server_fds();
+      return 0;
+   }
+
+   if (VG_(clo_verbosity) > 1)
+      VG_(umsg)("Starting the fork server\n");
+   if (reply(0)) {
+      while (VG_(read)(req_fd, &msg, sizeof(msg)) == sizeof(msg)) {
+         pid = fork_child(tid);
+         if (pid == 0) {
+            close_fork_server_fds();
+            return 1;
+         }
+         if (pid == -1 || !reply(pid))
+            break;
+         if (VG_(waitpid)(pid, &status, 0) != pid || !reply(status))
+            break;
+      }
+   }
+
+   /* The other end has gone away: the work of this process is done. */
+   if (VG_(clo_verbosity) > 1)
+      VG_(umsg)("Fork server exiting\n");
+   VG_(exit)(0);
+}
+
+/*--------------------------------------------------------------------*/
+/*--- end                                                          ---*/
+/*--------------------------------------------------------------------*/
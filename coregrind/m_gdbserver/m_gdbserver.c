@@ -198,6 +198,32 @@ typedef
 */
 static VgHashTable gs_addresses = NULL;
 
+/* The blocks instrumented because of Vg_VgdbFull (rather than because
+   they contain a breakpoint or because of single stepping) only call
+   VG_(helperc_CallDebugger) before each instruction when
+   full_call_needed is non zero, i.e. when single stepping or when
+   there is a breakpoint somewhere: otherwise, the call could not do
+   anything.  So --vgdb=full costs little more than --vgdb=yes until
+   gdb inserts a breakpoint or single steps.  A breakpoint inserted
+   in a block already translated still does not need the block to be
+   discarded, as the calls are then made. */
+static UWord full_call_needed = 0;
+
+void gdbserver_update_full_call_needed (void)
+{
+   GS_Address* g;
+
+   full_call_needed = valgrind_single_stepping();
+   if (full_call_needed || gs_addresses == NULL)
+      return;
+   VG_(HT_ResetIter) (gs_addresses);
+   while ((g = VG_(HT_Next) (gs_addresses)))
+      if (g->kind == GS_break) {
+         full_call_needed = 1;
+         break;
+      }
+}
+
 // Transform addr in the form stored in the list of addresses.
 // For the ARM architecture, we store it with the thumb bit set to 0.
 static Addr HT_addr ( Addr addr )
@@ -324,6 +350,7 @@ static void breakpoint (Bool insert, CORE_ADDR addr)
                            (g->kind == GS_jump ? "GS_jump" : "GS_break")));
       }
    }
+   gdbserver_update_full_call_needed();
 }
 
 static Bool (*tool_watchpoint) (PointKind kind, 
@@ -486,7 +513,7 @@ Bool VG_(is_watched)(PointKind kind, Addr addr, Int szB)
 }
 
 /* Returns the reason for which gdbserver instrumentation is needed */
-static VgVgdb VG_(gdbserver_instrumentation_needed) (VexGuestExtents* vge)
+VgVgdb VG_(gdbserver_instrumentation_needed) (VexGuestExtents* vge)
 {
    GS_Address* g;
    int e;
@@ -549,6 +576,7 @@ static void clear_gdbserved_addresses(Bool clear_only_jumps)
       if (!clear_only_jumps || ag[i]->kind == GS_jump)
          remove_gs_address (ag[i], "clear_gdbserved_addresses");
    VG_(free) (ag);
+   gdbserver_update_full_call_needed();
 }
 
 // Clear watched addressed in gs_watches, delete gs_watches.
@@ -1109,6 +1137,7 @@ static void VG_(add_stmt_call_gdbserver)
       IRType gWordTy, IRType hWordTy,
       Addr  iaddr,                /* Addr of instruction being instrumented */
       UChar delta,                /* delta to add to iaddr to obtain IP */
+      Bool  guarded,              /* only call if full_call_needed */
       IRSB* irsb)                 /* irsb block to which call is added */
 {
    void*    fn;
@@ -1116,6 +1145,11 @@ static void VG_(add_stmt_call_gdbserver)
    IRExpr** args;
    Int      nargs;
    IRDirty* di;
+#  if defined(VG_BIGENDIAN)
+   const IREndness end = Iend_BE;
+#  else
+   const IREndness end = Iend_LE;
+#  endif
 
    /* first store the address in the program counter so that the check
       done by VG_(helperc_CallDebugger) will be based on the correct
@@ -1166,6 +1200,23 @@ static void VG_(add_stmt_call_gdbserver)
    di->fxState[1].nRepeats  = 0;
    di->fxState[1].repeatLen = 0;
 
+   if (guarded) {
+      IRTemp needed = newIRTemp(irsb->tyenv, hWordTy);
+      IRTemp guard  = newIRTemp(irsb->tyenv, Ity_I1);
+      addStmtToIRSB(irsb,
+                    IRStmt_WrTmp(needed,
+                                 IRExpr_Load(end, hWordTy,
+                                             mkIRExpr_HWord
+                                                ((HWord)&full_call_needed))));
+      addStmtToIRSB(irsb,
+                    IRStmt_WrTmp(guard,
+                                 IRExpr_Binop(hWordTy == Ity_I64 ?
+                                              Iop_CmpNE64 : Iop_CmpNE32,
+                                              IRExpr_RdTmp(needed),
+                                              mkIRExpr_HWord(0))));
+      di->guard = IRExpr_RdTmp(guard);
+   }
+
    addStmtToIRSB(irsb, IRStmt_Dirty(di));
 
 }
@@ -1235,15 +1286,8 @@ IRSB* VG_(instrument_for_gdbserver_if_needed)
                                            gWordTy, hWordTy,
                                            st->Ist.IMark.addr,
                                            st->Ist.IMark.delta,
+                                           instr_needed == Vg_VgdbFull,
                                            sb_out);
-            /* There is an optimisation possible here for Vg_VgdbFull:
-               Put a guard ensuring we only call gdbserver if 'FullCallNeeded'.
-               FullCallNeeded would be set to 1 we have just switched on
-               Single Stepping or have just encountered a watchpoint
-               or have just inserted a breakpoint.
-               (as gdb by default removes and re-insert breakpoints), we would
-               need to also implement the notion of 'breakpoint pending removal'
-               to remove at the next 'continue/step' packet. */
             break;
          default: vg_assert (0);
          }
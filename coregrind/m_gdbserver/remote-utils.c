@@ -97,6 +97,11 @@ Bool noack_mode;
 
 static int readchar (int single);
 
+/* The output for gdb (see monitor_output) not yet sent, which
+   putpkt_binary sends before any other packet. */
+static char pending_monitor_output[DATASIZ+1];
+static int pending_monitor_output_len = 0;
+
 void remote_utils_output_status(void);
 
 #define INVALID_DESCRIPTOR -1
@@ -314,6 +319,7 @@ void remote_open (const HChar *name)
        (Addr) VG_(threads), sizeof(ThreadState), 
        offsetof(ThreadState, status),
        offsetof(ThreadState, os_state) + offsetof(ThreadOSstate, lwpid),
+       VG_N_THREADS,
        0};
    const int pid = VG_(getpid)();
    Addr addr_shared;
@@ -461,6 +467,13 @@ void remote_finish (FinishReason reason)
    dlog(1, "remote_finish (reason %s) %d %d\n", 
         ppFinishReason(reason), remote_desc, write_remote_desc);
    reset_valgrind_sink(ppFinishReason(reason));
+   /* Output for gdb not sent yet goes to the log instead, except in a
+      child just forked, for which it is the parent's output. */
+   if (pending_monitor_output_len > 0 && reason != reset_after_fork) {
+      pending_monitor_output[pending_monitor_output_len] = '\0';
+      VG_(printf) ("%s", pending_monitor_output);
+   }
+   pending_monitor_output_len = 0;
    if (write_remote_desc != INVALID_DESCRIPTOR)
       VG_(close) (write_remote_desc);
    write_remote_desc = INVALID_DESCRIPTOR;
@@ -799,11 +812,40 @@ int try_rle (char *buf, int remaining, unsigned char *csum, char **p)
    return n + 1;
 }
 
+static int putpkt_binary_wrk (char *buf, int cnt);
+
+static void flush_monitor_output (void)
+{
+   char buf[1 + 2*DATASIZ + 1];
+   const int len = pending_monitor_output_len;
+
+   if (len == 0)
+      return;
+   pending_monitor_output_len = 0;
+
+   buf[0] = 'O';
+   hexify(buf+1, pending_monitor_output, len);
+   if (putpkt_binary_wrk (buf, 1 + 2*len) < 0) {
+      /* We probably have lost the connection with vgdb. */
+      reset_valgrind_sink("Error writing monitor output");
+      /* write again after reset */
+      pending_monitor_output[len] = '\0';
+      VG_(printf) ("%s", pending_monitor_output);
+   }
+}
+
 /* Send a packet to the remote machine, with error checking.
    The data of the packet is in BUF, and the length of the
    packet is in CNT.  Returns >= 0 on success, -1 otherwise.  */
 
 int putpkt_binary (char *buf, int cnt)
+{
+   flush_monitor_output();
+   return putpkt_binary_wrk (buf, cnt);
+}
+
+static
+int putpkt_binary_wrk (char *buf, int cnt)
 {
    int i;
    unsigned char csum = 0;
@@ -887,22 +929,29 @@ int putpkt (char *buf)
    return putpkt_binary (buf, strlen (buf));
 }
 
+/* The output is sent to gdb in 'O' packets.  A monitor command can
+   produce its output in many small pieces (e.g. memcheck's get_vbits
+   does a VG_(printf) per byte), so rather than sending a packet for
+   each, the output is accumulated and sent in packets as big as
+   possible, the last one just before the next other packet (e.g. the
+   reply to the monitor command). */
 void monitor_output (char *s)
 {
    if (remote_connected()) {
-      const int len = strlen(s);
-      char *buf = malloc(1 + 2*len + 1);
-      
-      buf[0] = 'O';
-      hexify(buf+1, s, len);
-      if (putpkt (buf) < 0) {
-         /* We probably have lost the connection with vgdb. */
-         reset_valgrind_sink("Error writing monitor output");
-         /* write again after reset */
-         VG_(printf) ("%s", s);
+      int len = strlen(s);
+
+      while (len > 0) {
+         int n = DATASIZ - pending_monitor_output_len;
+         if (n > len)
+            n = len;
+         VG_(memcpy) (pending_monitor_output + pending_monitor_output_len,
+                      s, n);
+         pending_monitor_output_len += n;
+         s += n;
+         len -= n;
+         if (pending_monitor_output_len == DATASIZ)
+            flush_monitor_output();
       }
-      
-      free (buf);
    } else {
       print_to_initial_valgrind_sink (s);
    }
@@ -31,7 +31,12 @@
 #include "pub_core_syswrap.h"      // VG_(show_open_fds)
 #include "pub_core_scheduler.h"
 #include "pub_core_transtab.h"
+#include "pub_core_metrics.h"
+#include "pub_core_sbprofile.h"
+#include "pub_core_perfevents.h"
+#include "pub_core_checkpoint.h"
 #include "pub_core_debuginfo.h"
+#include "pub_core_demangle.h"      // VG_(print_demangle_stats)
 #include "pub_core_addrinfo.h"
 
 unsigned long cont_thread;
@@ -165,9 +170,20 @@ void VG_(print_all_stats) (Bool memory_stats, Bool tool_stats)
 
    VG_(print_translation_stats)();
    VG_(print_tt_tc_stats)();
+   if (VG_(clo_huge_pages) != Vg_HugePagesNo) {
+      ULong requested, hugetlb, advised, thp_backed;
+      VG_(am_get_huge_page_stats)(&requested, &hugetlb, &advised, &thp_backed);
+      VG_(message)(Vg_DebugMsg,
+                   "huge pages: %'llu kB eligible, %'llu kB hugetlb, "
+                   "%'llu kB advised, %'llu kB THP-backed\n",
+                   requested / 1024, hugetlb / 1024,
+                   advised / 1024, thp_backed / 1024);
+   }
    VG_(print_scheduler_stats)();
+   VG_(print_perf_counters)();
    VG_(print_ExeContext_stats)( False /* with_stacktraces */ );
    VG_(print_errormgr_stats)();
+   VG_(print_demangle_stats)();
    if (tool_stats && VG_(needs).print_stats) {
       VG_TDICT_CALL(tool_print_stats);
    }
@@ -229,6 +245,12 @@ int handle_gdb_valgrind_command (char *mon, OutputSink *sink_wanted_at_return)
 "  v.info location <addr>  : show information about location <addr>\n"
 "  v.info n_errs_found [msg] : show the nr of errors found so far and the given msg\n"
 "  v.info open_fds         : show open file descriptors (only if --track-fds=yes)\n"
+"  v.info jit              : show translation time per phase (only if --profile-jit=yes)\n"
+"  v.info metrics          : show counters in a stable, parsable format\n"
+"  v.info checkpoints      : show the checkpoints which can be restored\n"
+"  v.do checkpoint         : make a checkpoint of the run\n"
+"  v.do restore_checkpoint <n> : continue the run from checkpoint <n>\n"
+"  v.do stop_fast_forward  : start the instrumentation (only if --fast-forward=yes)\n"
 "  v.kill                  : kill the Valgrind process\n"
 "  v.set gdb_output        : set valgrind output to gdb\n"
 "  v.set log_output        : set valgrind output to log\n"
@@ -244,6 +266,7 @@ int handle_gdb_valgrind_command (char *mon, OutputSink *sink_wanted_at_return)
 "  v.info exectxt          : show stacktraces and stats of all execontexts\n"
 "  v.info scheduler        : show valgrind thread state and stacktrace\n"
 "  v.info stats            : show various valgrind and tool stats\n"
+"  v.info sb_samples       : show the most sampled SBs (only if --profile-sample)\n"
 "  v.set debuglog <level>  : set valgrind debug log level to <level>\n"
 "  v.set hostvisibility [yes*|no] : (en/dis)ables access by gdb/gdbserver to\n"
 "    Valgrind internal host status/memory\n"
@@ -354,7 +377,8 @@ int handle_gdb_valgrind_command (char *mon, OutputSink *sink_wanted_at_return)
       wcmd = strtok_r (NULL, " ", &ssaveptr);
       switch (kwdid = VG_(keyword_id) 
               ("all_errors n_errs_found last_error gdbserver_status memory"
-               " scheduler stats open_fds exectxt location",
+               " scheduler stats open_fds exectxt location jit metrics"
+               " sb_samples checkpoints",
                wcmd, kwd_report_all)) {
       case -2:
       case -1: 
@@ -445,6 +469,32 @@ int handle_gdb_valgrind_command (char *mon, OutputSink *sink_wanted_at_return)
          ret = 1;
          break;
       }
+      case 10: /* jit */
+         if (VG_(clo_profile_jit))
+            VG_(print_jit_profile)();
+         else
+            VG_(gdb_printf)
+               ("Valgrind must be started with --profile-jit=yes"
+                " to show translation times\n");
+         ret = 1;
+         break;
+      case 11: /* metrics */
+         VG_(print_metrics)();
+         ret = 1;
+         break;
+      case 12: /* sb_samples */
+         if (VG_(clo_profile_sample) > 0)
+            VG_(show_SB_samples)();
+         else
+            VG_(gdb_printf)
+               ("Valgrind must be started with --profile-sample=<number>"
+                " to sample the running SBs\n");
+         ret = 1;
+         break;
+      case 13: /* checkpoints */
+         VG_(show_checkpoints)();
+         ret = 1;
+         break;
       default:
          vg_assert(0);
       }
@@ -506,7 +556,8 @@ int handle_gdb_valgrind_command (char *mon, OutputSink *sink_wanted_at_return)
    case  6: /* v.do */
       ret = 1;
       wcmd = strtok_r (NULL, " ", &ssaveptr);
-      switch (VG_(keyword_id) ("expensive_sanity_check_general",
+      switch (VG_(keyword_id) ("expensive_sanity_check_general checkpoint"
+                               " restore_checkpoint stop_fast_forward",
                                wcmd, kwd_report_all)) {
          case -2:
          case -1: break;
@@ -518,6 +569,29 @@ int handle_gdb_valgrind_command (char *mon, OutputSink *sink_wanted_at_return)
             VG_(clo_sanity_level) = save_clo_sanity_level;
             break;
          }
+         case  1: /* checkpoint */
+            /* The checkpoint can't be made by forking within gdbserver:
+               it is made when the program continues. */
+            VG_(request_checkpoint)();
+            VG_(gdb_printf)("checkpoint will be made when the program"
+                            " continues\n");
+            break;
+         case  2: /* restore_checkpoint */
+            wcmd = strtok_r (NULL, " ", &ssaveptr);
+            if (wcmd == NULL)
+               VG_(gdb_printf)("missing checkpoint number\n");
+            else if (!VG_(restore_checkpoint)(strtol (wcmd, NULL, 10)))
+               VG_(gdb_printf)("no checkpoint %s\n", wcmd);
+            break;
+         case  3: /* stop_fast_forward */
+            if (!VG_(clo_fast_forward)) {
+               VG_(gdb_printf)("instrumentation already started\n");
+               break;
+            }
+            VG_(request_start_instrumentation)("v.do stop_fast_forward");
+            VG_(gdb_printf)("instrumentation will start when the program"
+                            " continues\n");
+            break;
          default: tl_assert (0);
       }
       break;
@@ -903,6 +977,7 @@ void handle_query (char *arg_own_buf, int *new_packet_len_p)
          trailing null byte, which is not sent/received. */
       
       strcat (arg_own_buf, ";QStartNoAckMode+");
+      strcat (arg_own_buf, ";binary-upload+");
       strcat (arg_own_buf, ";QPassSignals+");
       if (VG_(client_auxv))
          strcat (arg_own_buf, ";qXfer:auxv:read+");
@@ -1143,6 +1218,25 @@ void server_main (void)
          else
             write_enn (own_buf);
          break;
+      case 'x': {
+         /* Binary read : the reply is 'b' followed by the bytes read,
+            escaped, so about half the size of an 'm' reply.  If they
+            don't all fit in the packet, only those which fit are sent,
+            and gdb asks for the rest. */
+         int out_len;
+         decode_m_packet (&own_buf[1], &mem_addr, &len);
+         if (len > PBUFSIZ - POVERHSIZ - 1)
+            len = PBUFSIZ - POVERHSIZ - 1;
+         if (valgrind_read_memory (mem_addr, mem_buf, len) == 0) {
+            own_buf[0] = 'b';
+            new_packet_len
+               = remote_escape_output (mem_buf, len,
+                                       (unsigned char *) own_buf + 1,
+                                       &out_len, PBUFSIZ - POVERHSIZ - 1) + 1;
+         } else
+            write_enn (own_buf);
+         break;
+      }
       case 'M':
          decode_M_packet (&own_buf[1], &mem_addr, &len, mem_buf);
          if (valgrind_write_memory (mem_addr, mem_buf, len) == 0)
@@ -221,6 +221,12 @@ extern Bool gdbserver_deliver_signal (Int vki_sigNo);
    is needed to send the resume reply. */
 extern void gdbserver_process_exit_encountered (unsigned char status, Int code);
 
+/* To be called when single stepping is switched on or off, or when
+   breakpoints are inserted or removed.  Decides if the blocks
+   instrumented for --vgdb=full must call gdbserver before each
+   instruction. */
+extern void gdbserver_update_full_call_needed (void);
+
 /* To optimise signal handling, gdb can instruct gdbserver to
    not stop on some signals. In the below, a 1 indicates the gdb_nr signal
    has to be passed directly to the guest, without asking gdb.
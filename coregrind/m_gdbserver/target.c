@@ -204,6 +204,7 @@ void valgrind_set_single_stepping(Bool set)
       stepping = 2;
    else
       stepping = 0;
+   gdbserver_update_full_call_needed();
 }
 
 Bool valgrind_single_stepping(void)
@@ -243,6 +244,7 @@ void valgrind_resume (struct thread_resume *resume_info)
    vki_signal_to_deliver = resume_info->sig;
    
    stepping = resume_info->step;
+   gdbserver_update_full_call_needed();
    resume_pc = (*the_low_target.get_pc) ();
    if (resume_pc != stop_pc) {
       dlog(1,
@@ -40,10 +40,24 @@
 /*--- Declarations                                                 ---*/
 /*--------------------------------------------------------------------*/
 
-#define CHAIN_NO(key,tbl) (((UWord)(key)) % tbl->n_chains)
+/* The number of chains is a power of 2, and the chain for a key is
+   picked by Fibonacci hashing: the top bits of the key multiplied by
+   2^wordsize/phi.  That spreads out keys which only differ in their
+   high bits or are multiples of the alignment, as addresses
+   generally are, and is much cheaper than taking the key modulo a
+   prime. */
+#if VG_WORDSIZE == 8
+#  define HASH_MULTIPLIER 0x9E3779B97F4A7C15ULL
+#else
+#  define HASH_MULTIPLIER 0x9E3779B9UL
+#endif
+#define CHAIN_NO(key,tbl) \
+   ((UWord)(((UWord)(key) * (UWord)HASH_MULTIPLIER) \
+            >> (VG_WORDSIZE * 8 - (tbl)->n_chain_bits)))
 
 struct _VgHashTable {
-   UInt         n_chains;   // should be prime
+   UInt         n_chains;   // always 1 << n_chain_bits
+   UInt         n_chain_bits;
    UInt         n_elements;
    VgHashNode*  iterNode;   // current iterator node
    UInt         iterChain;  // next chain to be traversed by the iterator
@@ -52,15 +66,11 @@ struct _VgHashTable {
    const HChar* name;       // name of table (for debugging only)
 };
 
-#define N_HASH_PRIMES 20
-
-static SizeT primes[N_HASH_PRIMES] = {
-         769UL,         1543UL,         3079UL,          6151UL,
-       12289UL,        24593UL,        49157UL,         98317UL,
-      196613UL,       393241UL,       786433UL,       1572869UL,
-     3145739UL,      6291469UL,     12582917UL,      25165843UL,
-    50331653UL,    100663319UL,    201326611UL,     402653189UL
-};
+/* A table starts with 2^MIN_CHAIN_BITS chains, and doubles the
+   number each time it has more elements than chains, up to
+   2^MAX_CHAIN_BITS. */
+#define MIN_CHAIN_BITS 10
+#define MAX_CHAIN_BITS 28
 
 /*--------------------------------------------------------------------*/
 /*--- Functions                                                    ---*/
@@ -69,12 +79,13 @@ static SizeT primes[N_HASH_PRIMES] = {
 VgHashTable VG_(HT_construct) ( const HChar* name )
 {
    /* Initialises to zero, ie. all entries NULL */
-   SizeT       n_chains = primes[0];
+   SizeT       n_chains = (SizeT)1 << MIN_CHAIN_BITS;
    SizeT       sz       = n_chains * sizeof(VgHashNode*);
    VgHashTable table    = VG_(calloc)("hashtable.Hc.1",
                                       1, sizeof(struct _VgHashTable));
    table->chains        = VG_(calloc)("hashtable.Hc.2", 1, sz);
    table->n_chains      = n_chains;
+   table->n_chain_bits  = MIN_CHAIN_BITS;
    table->n_elements    = 0;
    table->iterOK        = True;
    table->name          = name;
@@ -92,27 +103,16 @@ static void resize ( VgHashTable table )
    Int          i;
    SizeT        sz;
    SizeT        old_chains = table->n_chains;
-   SizeT        new_chains = old_chains + 1;
+   SizeT        new_chains = old_chains * 2;
    VgHashNode** chains;
    VgHashNode * node;
 
-   /* If we've run out of primes, do nothing. */
-   if (old_chains == primes[N_HASH_PRIMES-1])
+   /* If the table is as big as it gets, do nothing. */
+   if (table->n_chain_bits == MAX_CHAIN_BITS)
       return;
 
-   vg_assert(old_chains >= primes[0] 
-             && old_chains < primes[N_HASH_PRIMES-1]);
-
-   for (i = 0; i < N_HASH_PRIMES; i++) {
-      if (primes[i] > new_chains) {
-         new_chains = primes[i];
-         break;
-      }
-   }
-
-   vg_assert(new_chains > old_chains);
-   vg_assert(new_chains > primes[0] 
-             && new_chains <= primes[N_HASH_PRIMES-1]);
+   vg_assert(table->n_chain_bits >= MIN_CHAIN_BITS
+             && table->n_chain_bits < MAX_CHAIN_BITS);
 
    VG_(debugLog)(
       1, "hashtable",
@@ -121,6 +121,7 @@ static void resize ( VgHashTable table )
          (UWord)table->n_elements );
 
    table->n_chains = new_chains;
+   table->n_chain_bits++;
    sz = new_chains * sizeof(VgHashNode*);
    chains = VG_(calloc)("hashtable.resize.1", 1, sz);
 
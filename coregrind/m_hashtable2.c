@@ -0,0 +1,489 @@
+
+/*--------------------------------------------------------------------*/
+/*--- An open-addressing hash table.                m_hashtable2.c ---*/
+/*--------------------------------------------------------------------*/
+
+/*
+   This file is part of Valgrind, a dynamic binary instrumentation
+   framework.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of the
+   License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+   02111-1307, USA.
+
+   The GNU General Public License is contained in the file COPYING.
+*/
+
+#include "pub_core_basics.h"
+#include "pub_core_debuglog.h"
+#include "pub_core_hashtable2.h"
+#include "pub_core_libcassert.h"
+#include "pub_core_libcbase.h"
+#include "pub_core_mallocfree.h"
+
+/*--------------------------------------------------------------------*/
+/*--- Declarations                                                 ---*/
+/*--------------------------------------------------------------------*/
+
+/* The table is an array of slots, each holding a pointer to a node,
+   and alongside it an array of control bytes, one per slot: CTRL_EMPTY
+   for a never-used slot, CTRL_DELETED for a slot whose node has been
+   removed, else 7 bits of the hash of the node's key.  The slots are
+   in groups of GROUP_SZ, and a key is looked for in the groups of its
+   probe sequence, starting at the group given by the top bits of its
+   hash.  The control bytes of a group are read as one 64-bit word and
+   compared with the key's 7 hash bits all at once, so the slots --
+   and so the nodes -- looked at are nearly always only those with the
+   right key, and a lookup stops at the first group with an empty
+   slot.
+
+   Each slot holds a distinct key.  Nodes with duplicate keys are
+   chained from the slot's node, most recently added first, through
+   their 'next' field. */
+
+#define GROUP_SZ      8
+#define CTRL_EMPTY    0x80
+#define CTRL_DELETED  0xFE
+
+#define LSBS  0x0101010101010101ULL
+#define MSBS  0x8080808080808080ULL
+
+/* As in m_hashtable.c, Fibonacci hashing. */
+#if VG_WORDSIZE == 8
+#  define HASH_MULTIPLIER 0x9E3779B97F4A7C15ULL
+#else
+#  define HASH_MULTIPLIER 0x9E3779B9UL
+#endif
+
+struct _VgHashTable2 {
+   UInt         n_group_bits;
+   UInt         n_groups;   // always 1 << n_group_bits
+   UInt         n_elements; // nodes, including duplicates
+   UInt         n_keys;     // full slots
+   UInt         n_used;     // full or deleted slots
+   UChar*       ctrl;       // n_groups * GROUP_SZ control bytes
+   VgHashNode** slots;      // n_groups * GROUP_SZ slots
+   VgHashNode*  iterNode;   // current iterator node
+   UInt         iterSlot;   // next slot to be traversed by the iterator
+   Bool         iterOK;     // table safe to iterate over?
+   const HChar* name;       // name of table (for debugging only)
+};
+
+/* A table starts with 2^MIN_GROUP_BITS groups, and is rehashed when
+   more than 7/8 of its slots are full or deleted.  MAX_GROUP_BITS keeps
+   slot numbers within a UInt; a table that big would hold nearly 2^31
+   keys, and the host is likely to run out of memory well before.  Once
+   it can't grow, a table is allowed to fill up completely.
+   memcheck/tests/unit_hashtable2.c uses a smaller MAX_GROUP_BITS. */
+#define MIN_GROUP_BITS 4
+#if !defined(MAX_GROUP_BITS)
+#  define MAX_GROUP_BITS 28
+#endif
+
+/*--------------------------------------------------------------------*/
+/*--- Group matching                                               ---*/
+/*--------------------------------------------------------------------*/
+
+static inline UWord hash_key ( UWord key )
+{
+   return key * (UWord)HASH_MULTIPLIER;
+}
+
+static inline UInt home_group ( VgHashTable2 table, UWord h )
+{
+   return (UInt)(h >> (VG_WORDSIZE * 8 - table->n_group_bits));
+}
+
+static inline UChar hash_tag ( VgHashTable2 table, UWord h )
+{
+   return (UChar)((h >> (VG_WORDSIZE * 8 - table->n_group_bits - 7)) & 0x7F);
+}
+
+static inline ULong group_ctrl ( VgHashTable2 table, UInt g )
+{
+   /* The control bytes are 8-aligned, being VG_(malloc)ed. */
+   ULong w = *(ULong*)&table->ctrl[g * GROUP_SZ];
+#  if defined(VG_BIGENDIAN)
+   /* Make byte i of the group bits 8*i .. 8*i+7, as on little-endian
+      hosts. */
+   w = ((w & 0x00FF00FF00FF00FFULL) << 8)  | ((w >> 8)  & 0x00FF00FF00FF00FFULL);
+   w = ((w & 0x0000FFFF0000FFFFULL) << 16) | ((w >> 16) & 0x0000FFFF0000FFFFULL);
+   w = (w << 32) | (w >> 32);
+#  endif
+   return w;
+}
+
+/* The high bit of byte i is set if slot i of the group may hold the
+   tag.  There may be false positives, but only in bytes above a true
+   match, which is fine since the keys get compared anyway. */
+static inline ULong match_tag ( ULong w, UChar tag )
+{
+   ULong x = w ^ (LSBS * tag);
+   return (x - LSBS) & ~x & MSBS;
+}
+
+static inline ULong match_empty ( ULong w )
+{
+   return w & (~w << 6) & MSBS;
+}
+
+static inline ULong match_empty_or_deleted ( ULong w )
+{
+   return w & ~(w << 7) & MSBS;
+}
+
+/* Index of the lowest slot set in a non-zero match. */
+static inline UInt first_match ( ULong m )
+{
+   UInt i = 0;
+   while (!(m & 0x80)) {
+      m >>= 8;
+      i++;
+   }
+   return i;
+}
+
+/* The slot holding key, or -1. */
+static Int find_slot ( VgHashTable2 table, UWord key )
+{
+   UWord h    = hash_key(key);
+   UChar tag  = hash_tag(table, h);
+   UInt  mask = table->n_groups - 1;
+   UInt  g    = home_group(table, h);
+   UInt  step = 0;
+
+   while (True) {
+      ULong w = group_ctrl(table, g);
+      ULong m = match_tag(w, tag);
+      while (m) {
+         UInt s = g * GROUP_SZ + first_match(m);
+         if (LIKELY(table->slots[s]->key == key))
+            return s;
+         m &= m - 1;
+      }
+      if (LIKELY(match_empty(w)))
+         return -1;
+      step++;
+      /* The probe sequence visits every group in n_groups steps.  Only
+         a table which can't grow any more gets here without meeting an
+         empty slot. */
+      if (UNLIKELY(step == table->n_groups))
+         return -1;
+      g = (g + step) & mask;
+   }
+}
+
+/* A free slot for a key which is not in the table. */
+static UInt find_free_slot ( VgHashTable2 table, UWord h )
+{
+   UInt mask = table->n_groups - 1;
+   UInt g    = home_group(table, h);
+   UInt step = 0;
+
+   while (True) {
+      ULong m = match_empty_or_deleted(group_ctrl(table, g));
+      if (LIKELY(m))
+         return g * GROUP_SZ + first_match(m);
+      step++;
+      g = (g + step) & mask;
+      vg_assert(step <= table->n_groups);
+   }
+}
+
+static void set_ctrl ( VgHashTable2 table, UInt s, UChar c )
+{
+   table->ctrl[s] = c;
+}
+
+/*--------------------------------------------------------------------*/
+/*--- Functions                                                    ---*/
+/*--------------------------------------------------------------------*/
+
+static void alloc_arrays ( VgHashTable2 table, UInt n_group_bits )
+{
+   SizeT n_slots = ((SizeT)1 << n_group_bits) * GROUP_SZ;
+   table->n_group_bits = n_group_bits;
+   table->n_groups     = 1 << n_group_bits;
+   table->n_keys       = 0;
+   table->n_used       = 0;
+   table->ctrl         = VG_(malloc)("hashtable2.aa.1", n_slots);
+   VG_(memset)(table->ctrl, CTRL_EMPTY, n_slots);
+   table->slots        = VG_(malloc)("hashtable2.aa.2",
+                                     n_slots * sizeof(VgHashNode*));
+}
+
+VgHashTable2 VG_(HT2_construct) ( const HChar* name )
+{
+   VgHashTable2 table = VG_(calloc)("hashtable2.Hc.1",
+                                    1, sizeof(struct _VgHashTable2));
+   alloc_arrays(table, MIN_GROUP_BITS);
+   table->n_elements = 0;
+   table->iterOK     = True;
+   table->name       = name;
+   vg_assert(name);
+   return table;
+}
+
+Int VG_(HT2_count_nodes) ( VgHashTable2 table )
+{
+   return table->n_elements;
+}
+
+/* Rehash into a table twice as big, or of the same size if it is
+   mostly deleted slots which need clearing out. */
+static void rehash ( VgHashTable2 table )
+{
+   UInt         i, s;
+   UInt         old_n_slots = table->n_groups * GROUP_SZ;
+   UChar*       old_ctrl    = table->ctrl;
+   VgHashNode** old_slots   = table->slots;
+   UInt         n_keys      = table->n_keys;
+   UInt         bits        = table->n_group_bits;
+
+   if ((ULong)n_keys * 16 >= (ULong)old_n_slots * 7 && bits < MAX_GROUP_BITS)
+      bits++;
+   vg_assert(bits >= MIN_GROUP_BITS && bits <= MAX_GROUP_BITS);
+
+   VG_(debugLog)(
+      1, "hashtable2",
+         "rehashing table `%s' from %u to %u slots (total keys %u)\n",
+         table->name, old_n_slots, (1 << bits) * GROUP_SZ, n_keys );
+
+   alloc_arrays(table, bits);
+   for (i = 0; i < old_n_slots; i++) {
+      if (old_ctrl[i] & 0x80)
+         continue;
+      {
+         UWord h = hash_key(old_slots[i]->key);
+         s = find_free_slot(table, h);
+         table->slots[s] = old_slots[i];
+         set_ctrl(table, s, hash_tag(table, h));
+         table->n_keys++;
+         table->n_used++;
+      }
+   }
+   vg_assert(table->n_keys == n_keys);
+
+   VG_(free)(old_ctrl);
+   VG_(free)(old_slots);
+}
+
+/* Called when a new key would take the table over 7/8 full. */
+static void maybe_rehash ( VgHashTable2 table )
+{
+   UInt n_slots = table->n_groups * GROUP_SZ;
+
+   if (table->n_group_bits < MAX_GROUP_BITS) {
+      rehash(table);
+   } else if (table->n_used - table->n_keys >= n_slots / 16) {
+      /* Can't grow, but clearing out the deleted slots is worth it. */
+      rehash(table);
+   } else if (table->n_keys == n_slots) {
+      VG_(out_of_memory_NORETURN)( "hashtable2.mr.1 (table full)",
+                                   (SizeT)n_slots * sizeof(VgHashNode*) );
+   }
+}
+
+/* Puts a new, heap allocated VgHashNode, into the VgHashTable2. */
+void VG_(HT2_add_node) ( VgHashTable2 table, void* vnode )
+{
+   VgHashNode* node = (VgHashNode*)vnode;
+   Int         s    = find_slot(table, node->key);
+
+   /* Table has been modified; hence HT2_Next should assert. */
+   table->iterOK = False;
+   table->n_elements++;
+
+   if (s >= 0) {
+      /* A duplicate: it becomes the head of the slot's chain. */
+      node->next = table->slots[s];
+      table->slots[s] = node;
+      return;
+   }
+
+   if ((ULong)(table->n_used + 1) * 8 > (ULong)table->n_groups * GROUP_SZ * 7)
+      maybe_rehash(table);
+
+   {
+      UWord h = hash_key(node->key);
+      UInt  f = find_free_slot(table, h);
+      if (table->ctrl[f] == CTRL_EMPTY)
+         table->n_used++;
+      node->next = NULL;
+      table->slots[f] = node;
+      set_ctrl(table, f, hash_tag(table, h));
+      table->n_keys++;
+   }
+}
+
+/* Looks up a VgHashNode by key in the table.  Returns NULL if not found. */
+void* VG_(HT2_lookup) ( VgHashTable2 table, UWord key )
+{
+   Int s = find_slot(table, key);
+   return s >= 0 ? table->slots[s] : NULL;
+}
+
+/* Looks up a VgHashNode by node in the table.  Returns NULL if not found. */
+void* VG_(HT2_gen_lookup) ( VgHashTable2 table, void* node, HT_Cmp_t cmp )
+{
+   VgHashNode* hnode = (VgHashNode*) node;
+   VgHashNode* curr;
+   Int         s     = find_slot(table, hnode->key);
+
+   if (s < 0)
+      return NULL;
+   for (curr = table->slots[s]; curr; curr = curr->next) {
+      if (cmp (hnode, curr) == 0)
+         return curr;
+   }
+   return NULL;
+}
+
+/* Unlink *prev_next_ptr, in the chain of slot s, from the table. */
+static VgHashNode* remove_from_slot ( VgHashTable2 table, UInt s,
+                                      VgHashNode** prev_next_ptr )
+{
+   VgHashNode* curr = *prev_next_ptr;
+   *prev_next_ptr = curr->next;
+   table->n_elements--;
+   if (table->slots[s] == NULL) {
+      /* That was the last node with this key.  If the group has an
+         empty slot, no lookup goes past it, so the slot can become
+         empty again rather than deleted. */
+      UInt g = s / GROUP_SZ;
+      if (match_empty(group_ctrl(table, g))) {
+         set_ctrl(table, s, CTRL_EMPTY);
+         table->n_used--;
+      } else {
+         set_ctrl(table, s, CTRL_DELETED);
+      }
+      table->n_keys--;
+   }
+   return curr;
+}
+
+/* Removes a VgHashNode from the table.  Returns NULL if not found. */
+void* VG_(HT2_remove) ( VgHashTable2 table, UWord key )
+{
+   Int s = find_slot(table, key);
+
+   /* Table has been modified; hence HT2_Next should assert. */
+   table->iterOK = False;
+
+   if (s < 0)
+      return NULL;
+   return remove_from_slot(table, s, &table->slots[s]);
+}
+
+/* Removes a VgHashNode by node from the table.  Returns NULL if not
+   found. */
+void* VG_(HT2_gen_remove) ( VgHashTable2 table, void* node, HT_Cmp_t cmp )
+{
+   VgHashNode*  hnode = (VgHashNode*) node;
+   VgHashNode** prev_next_ptr;
+   Int          s     = find_slot(table, hnode->key);
+
+   /* Table has been modified; hence HT2_Next should assert. */
+   table->iterOK = False;
+
+   if (s < 0)
+      return NULL;
+   for (prev_next_ptr = &table->slots[s]; *prev_next_ptr;
+        prev_next_ptr = &(*prev_next_ptr)->next) {
+      if (cmp(hnode, *prev_next_ptr) == 0)
+         return remove_from_slot(table, s, prev_next_ptr);
+   }
+   return NULL;
+}
+
+/* Allocates a suitably-sized array, copies pointers to all the hashtable
+   elements into it, then returns both the array and the size of it.  The
+   array must be freed with VG_(free).
+*/
+VgHashNode** VG_(HT2_to_array) ( VgHashTable2 table, /*OUT*/ UInt* n_elems )
+{
+   UInt         i, j;
+   VgHashNode** arr;
+   VgHashNode*  node;
+
+   *n_elems = table->n_elements;
+   if (*n_elems == 0)
+      return NULL;
+
+   arr = VG_(malloc)( "hashtable2.Hta.1", *n_elems * sizeof(VgHashNode*) );
+
+   j = 0;
+   for (i = 0; i < table->n_groups * GROUP_SZ; i++) {
+      if (table->ctrl[i] & 0x80)
+         continue;
+      for (node = table->slots[i]; node != NULL; node = node->next) {
+         arr[j++] = node;
+      }
+   }
+   vg_assert(j == *n_elems);
+
+   return arr;
+}
+
+void VG_(HT2_ResetIter)(VgHashTable2 table)
+{
+   vg_assert(table);
+   table->iterNode = NULL;
+   table->iterSlot = 0;
+   table->iterOK   = True;
+}
+
+void* VG_(HT2_Next)(VgHashTable2 table)
+{
+   UInt i;
+   vg_assert(table);
+   /* See comment on HT_Next prototype in pub_tool_hashtable.h. */
+   vg_assert(table->iterOK);
+
+   if (table->iterNode && table->iterNode->next) {
+      table->iterNode = table->iterNode->next;
+      return table->iterNode;
+   }
+
+   for (i = table->iterSlot; i < table->n_groups * GROUP_SZ; i++) {
+      if (!(table->ctrl[i] & 0x80)) {
+         table->iterNode = table->slots[i];
+         table->iterSlot = i + 1;  // Next slot to be traversed
+         return table->iterNode;
+      }
+   }
+   return NULL;
+}
+
+void VG_(HT2_destruct)(VgHashTable2 table, void(*freenode_fn)(void*))
+{
+   UInt        i;
+   VgHashNode *node, *node_next;
+
+   for (i = 0; i < table->n_groups * GROUP_SZ; i++) {
+      if (table->ctrl[i] & 0x80)
+         continue;
+      for (node = table->slots[i]; node != NULL; node = node_next) {
+         node_next = node->next;
+         freenode_fn(node);
+      }
+   }
+   VG_(free)(table->ctrl);
+   VG_(free)(table->slots);
+   VG_(free)(table);
+}
+
+/*--------------------------------------------------------------------*/
+/*--- end                                                          ---*/
+/*--------------------------------------------------------------------*/
@@ -258,6 +258,7 @@ static void exit_wrk( Int status, Bool gdbserver_call_allowed)
    }
    exit_called = True;
 
+   VG_(flush_output_sinks)();
    VG_(exit_now) (status);
 }
 
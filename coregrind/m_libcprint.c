@@ -37,6 +37,7 @@
 #include "pub_core_libcfile.h"   // VG_(write)(), VG_(write_socket)()
 #include "pub_core_libcprint.h"
 #include "pub_core_libcproc.h"   // VG_(getpid)(), VG_(read_millisecond_timer()
+#include "pub_core_mallocfree.h"
 #include "pub_core_options.h"
 #include "pub_core_clreq.h"      // For RUNNING_ON_VALGRIND
 
@@ -57,7 +58,8 @@ OutputSink VG_(xml_output_sink) = { -1, False }; /* disabled */
  
 /* Do the low-level send of a message to the logging sink. */
 static
-void send_bytes_to_logging_sink ( OutputSink* sink, const HChar* msg, Int nbytes )
+void write_bytes_to_logging_sink ( OutputSink* sink,
+                                   const HChar* msg, Int nbytes )
 {
    if (sink->is_socket) {
       Int rc = VG_(write_socket)( sink->fd, msg, nbytes );
@@ -81,6 +83,191 @@ void send_bytes_to_logging_sink ( OutputSink* sink, const HChar* msg, Int nbytes
    }
 }
 
+/* The output buffers of the log and XML sinks, when they go to a file
+   or a socket (see VG_(buffer_output_sink)).  Writing many small
+   messages one at a time is slow, especially as it is done holding
+   the big lock.  Only the output to the sink's initial fd is
+   buffered: if the sink's fd changes (e.g. when gdbserver temporarily
+   redirects the output), the buffered bytes are written out, and the
+   output to the new fd is written at once. */
+typedef
+   struct {
+      HChar* buf;       /* NULL if the sink isn't buffered */
+      Int    size;
+      Int    used;
+      Int    fd;        /* the fd the output to which is buffered */
+      Bool   is_socket;
+      Bool   drop;      /* non-blocking socket, see --output-socket-drop */
+      ULong  n_dropped; /* nr of bytes dropped */
+   }
+   SinkBuffer;
+
+static SinkBuffer log_sink_buffer;
+static SinkBuffer xml_sink_buffer;
+
+static SinkBuffer* buffer_of_sink ( OutputSink* sink )
+{
+   if (sink == &VG_(log_output_sink))
+      return &log_sink_buffer;
+   if (sink == &VG_(xml_output_sink))
+      return &xml_sink_buffer;
+   return NULL;
+}
+
+/* vki only defines VKI_POLLIN, and not on all OSes.  These are from
+   linux bits/poll.h, as in m_gdbserver/server.h. */
+#ifndef VKI_POLLOUT
+#define VKI_POLLOUT           0x0004
+#define VKI_POLLERR           0x0008
+#define VKI_POLLHUP           0x0010
+#define VKI_POLLNVAL          0x0020
+#endif
+
+/* Is the socket sd broken (e.g. the listener died), rather than just
+   not ready to take more output? */
+static Bool socket_is_broken ( Int sd )
+{
+   struct vki_pollfd pfd;
+   SysRes sr;
+   pfd.fd = sd;
+   pfd.events = VKI_POLLOUT;
+   pfd.revents = 0;
+   sr = VG_(poll)(&pfd, 1, 0);
+   return sr_isError(sr)
+          || (pfd.revents & (VKI_POLLERR | VKI_POLLHUP | VKI_POLLNVAL));
+}
+
+/* Write out the bytes in sb.  If sb is for a non-blocking socket, only
+   the bytes the socket takes at once are written, unless wait. */
+static void flush_sink_buffer ( OutputSink* sink, SinkBuffer* sb, Bool wait )
+{
+   Int done = 0;
+
+   while (done < sb->used) {
+      if (!sb->is_socket) {
+         if (sb->fd >= 0)
+            VG_(write)( sb->fd, sb->buf + done, sb->used - done );
+         done = sb->used;
+      } else {
+         Int rc = VG_(write_socket)( sb->fd, sb->buf + done,
+                                     sb->used - done );
+         if (rc > 0) {
+            done += rc;
+         } else if (sb->drop && !socket_is_broken(sb->fd)) {
+            struct vki_pollfd pfd;
+            if (!wait)
+               break;
+            pfd.fd = sb->fd;
+            pfd.events = VKI_POLLOUT;
+            pfd.revents = 0;
+            (void)VG_(poll)(&pfd, 1, -1);
+         } else {
+            // For example, the listener process died.  Switch back to
+            // stderr, and stop buffering: the client may write there.
+            if (sink->fd == sb->fd) {
+               sink->is_socket = False;
+               sink->fd = 2;
+            }
+            VG_(write)( 2, sb->buf + done, sb->used - done );
+            VG_(free)(sb->buf);
+            sb->buf = NULL;
+            sb->used = 0;
+            return;
+         }
+      }
+   }
+
+   if (done < sb->used)
+      VG_(memmove)(sb->buf, sb->buf + done, sb->used - done);
+   sb->used -= done;
+}
+
+static
+void send_bytes_to_logging_sink ( OutputSink* sink, const HChar* msg, Int nbytes )
+{
+   SinkBuffer* sb = buffer_of_sink(sink);
+
+   if (sb != NULL && sb->buf != NULL) {
+      if (sink->fd == sb->fd && sink->is_socket == sb->is_socket) {
+         if (sb->used + nbytes > sb->size)
+            flush_sink_buffer(sink, sb, False);
+         /* (The flush stops the buffering if the socket is broken.) */
+         if (sb->buf != NULL) {
+            if (sb->used + nbytes <= sb->size) {
+               VG_(memcpy)(sb->buf + sb->used, msg, nbytes);
+               sb->used += nbytes;
+               return;
+            }
+            if (sb->drop) {
+               /* The listener is too slow. */
+               sb->n_dropped += nbytes;
+               return;
+            }
+            flush_sink_buffer(sink, sb, True);
+         }
+      } else if (sb->used > 0) {
+         flush_sink_buffer(sink, sb, True);
+      }
+   }
+
+   write_bytes_to_logging_sink( sink, msg, nbytes );
+}
+
+void VG_(buffer_output_sink) ( OutputSink* sink )
+{
+   SinkBuffer* sb = buffer_of_sink(sink);
+
+   vg_assert(sb != NULL && sb->buf == NULL);
+   vg_assert(sink->fd >= 0);
+   vg_assert(VG_(clo_output_buffer_size) > 0);
+
+   sb->size = VG_(clo_output_buffer_size);
+   sb->buf = VG_(malloc)("libcprint.bos.1", sb->size);
+   sb->used = 0;
+   sb->fd = sink->fd;
+   sb->is_socket = sink->is_socket;
+   sb->drop = False;
+   if (sink->is_socket && VG_(clo_output_socket_drop)) {
+      Int flags = VG_(fcntl)(sink->fd, VKI_F_GETFL, 0);
+      if (flags >= 0
+          && VG_(fcntl)(sink->fd, VKI_F_SETFL, flags | VKI_O_NONBLOCK) >= 0)
+         sb->drop = True;
+   }
+}
+
+void VG_(flush_output_sinks) ( void )
+{
+   /* Don't recurse, should flushing fail in some horrible way. */
+   static Bool flushing = False;
+   if (flushing)
+      return;
+   flushing = True;
+
+   /* Tell the user about the output that the log or XML listener was
+      too slow to take.  The log one is told in the log output itself,
+      so that it is seen with the hole in it. */
+   if (log_sink_buffer.n_dropped > 0 || xml_sink_buffer.n_dropped > 0) {
+      ULong n_log = log_sink_buffer.n_dropped;
+      ULong n_xml = xml_sink_buffer.n_dropped;
+      log_sink_buffer.n_dropped = 0;
+      xml_sink_buffer.n_dropped = 0;
+      if (log_sink_buffer.buf != NULL)
+         flush_sink_buffer(&VG_(log_output_sink), &log_sink_buffer, True);
+      if (n_log > 0)
+         VG_(umsg)("%'llu bytes of log output dropped by "
+                   "--output-socket-drop=yes\n", n_log);
+      if (n_xml > 0)
+         VG_(umsg)("%'llu bytes of XML output dropped by "
+                   "--output-socket-drop=yes\n", n_xml);
+   }
+   if (log_sink_buffer.buf != NULL)
+      flush_sink_buffer(&VG_(log_output_sink), &log_sink_buffer, True);
+   if (xml_sink_buffer.buf != NULL)
+      flush_sink_buffer(&VG_(xml_output_sink), &xml_sink_buffer, True);
+
+   flushing = False;
+}
+
 
 /* ---------------------------------------------------------------------
    printf() and friends
@@ -127,14 +314,17 @@ static UInt vprintf_WRK ( OutputSink* sink,
 {
    printf_buf_t myprintf_buf
       = { "", 0, sink };
-   UInt ret
-      = vprintf_to_buf(&myprintf_buf, format, vargs);
+   UInt ret;
+   // Keep the output of VG_(run_workers) threads from interleaving.
+   VG_(acquire_worker_lock)();
+   ret = vprintf_to_buf(&myprintf_buf, format, vargs);
    // Write out any chars left in the buffer.
    if (myprintf_buf.buf_used > 0) {
       send_bytes_to_logging_sink( myprintf_buf.sink,
                                   myprintf_buf.buf,
                                   myprintf_buf.buf_used );
    }
+   VG_(release_worker_lock)();
    return ret;
 }
 
@@ -497,6 +687,9 @@ UInt VG_(vmessage) ( VgMsgKind kind, const HChar* format, va_list vargs )
       with the other printf variants in earlier parts of this file. */
    vmessage_buf_t* b = &vmessage_buf; /* shorthand for convenience */
 
+   /* And (as it persists) it is shared by VG_(run_workers) threads. */
+   VG_(acquire_worker_lock)();
+
    /* We have to set this each call, so that the correct flavour
       of preamble is emitted at each \n. */
    b->kind = kind;
@@ -513,6 +706,7 @@ UInt VG_(vmessage) ( VgMsgKind kind, const HChar* format, va_list vargs )
       b->buf_used = 0;
    }
 
+   VG_(release_worker_lock)();
    return ret;
 }
 
@@ -335,6 +335,7 @@ void VG_(execv) ( const HChar* filename, HChar** argv )
    envp = VG_(env_clone)(VG_(client_envp));
    VG_(env_remove_valgrind_env_stuff)( envp );
 
+   VG_(flush_output_sinks)();
    res = VG_(do_syscall3)(__NR_execve,
                           (UWord)filename, (UWord)argv, (UWord)envp);
 
@@ -624,11 +625,10 @@ Int VG_(fork) ( void )
    Timing stuff
    ------------------------------------------------------------------ */
 
-UInt VG_(read_millisecond_timer) ( void )
+/* The time in nanoseconds since some arbitrary point. */
+static ULong read_nanosecond_clock ( void )
 {
-   /* 'now' and 'base' are in microseconds */
-   static ULong base = 0;
-   ULong  now;
+   ULong now;
 
 #  if defined(VGO_linux)
    { SysRes res;
@@ -636,12 +636,12 @@ UInt VG_(read_millisecond_timer) ( void )
      res = VG_(do_syscall2)(__NR_clock_gettime, VKI_CLOCK_MONOTONIC,
                             (UWord)&ts_now);
      if (sr_isError(res) == 0) {
-        now = ts_now.tv_sec * 1000000ULL + ts_now.tv_nsec / 1000;
+        now = ts_now.tv_sec * 1000000000ULL + ts_now.tv_nsec;
      } else {
        struct vki_timeval tv_now;
        res = VG_(do_syscall2)(__NR_gettimeofday, (UWord)&tv_now, (UWord)NULL);
        vg_assert(! sr_isError(res));
-       now = tv_now.tv_sec * 1000000ULL + tv_now.tv_usec;
+       now = tv_now.tv_sec * 1000000000ULL + tv_now.tv_usec * 1000ULL;
      }
    }
 
@@ -654,20 +654,33 @@ UInt VG_(read_millisecond_timer) ( void )
      struct vki_timeval tv_now = { 0, 0 };
      res = VG_(do_syscall2)(__NR_gettimeofday, (UWord)&tv_now, (UWord)NULL);
      vg_assert(! sr_isError(res));
-     now = sr_Res(res) * 1000000ULL + sr_ResHI(res);
+     now = sr_Res(res) * 1000000000ULL + sr_ResHI(res) * 1000ULL;
    }
 
 #  else
 #    error "Unknown OS"
 #  endif
 
-   /* COMMON CODE */  
+   return now;
+}
+
+UInt VG_(read_millisecond_timer) ( void )
+{
+   /* 'now' and 'base' are in microseconds */
+   static ULong base = 0;
+   ULong  now = read_nanosecond_clock() / 1000;
+
    if (base == 0)
       base = now;
 
    return (now - base) / 1000;
 }
 
+ULong VG_(read_nanosecond_timer) ( void )
+{
+   return read_nanosecond_clock();
+}
+
 
 /* ---------------------------------------------------------------------
    atfork()
@@ -929,6 +942,205 @@ void VG_(flush_dcache) ( void *ptr, SizeT nbytes )
 #  endif
 }
 
+/* ---------------------------------------------------------------------
+   Worker threads
+   ------------------------------------------------------------------ */
+
+/* A worker is a bare host thread: it shares the address space, file
+   table and signal handlers with the rest of Valgrind, runs with all
+   signals blocked, and the scheduler knows nothing about it.  That
+   makes it cheap to start, but leaves it able to do very little; see
+   pub_tool_libcproc.h. */
+
+#define WORKER_STACK_SZB (1024 * 1024)
+
+typedef
+   struct {
+      void  (*fn)(void*, Int);
+      void*   arg;
+      Int     i;
+      HChar*  stack;
+      /* Set to the thread's tid by clone, and back to zero by the
+         kernel when the thread exits. */
+      volatile Int tid;
+   }
+   Worker;
+
+#if defined(VGP_amd64_linux)
+/* Clone a thread on the stack ending at |stack_top|, with |tid| as
+   both the parent and child tid location.  The child calls fn(arg)
+   and exits; the parent gets the clone result. */
+extern Long do_clone_worker_amd64_linux ( ULong flags, void* stack_top,
+                                          Word (*fn)(void*), void* arg,
+                                          volatile Int* tid );
+asm(
+".text\n"
+".globl do_clone_worker_amd64_linux\n"
+"do_clone_worker_amd64_linux:\n"
+"       subq    $16, %rsi\n"            // fn and arg go on the child stack
+"       movq    %rdx, 0(%rsi)\n"
+"       movq    %rcx, 8(%rsi)\n"
+"       movq    %r8,  %rdx\n"           // parent_tid
+"       movq    %r8,  %r10\n"           // child_tid
+"       xorl    %r8d, %r8d\n"           // tls
+"       movq    $"VG_STRINGIFY(__NR_clone)", %rax\n"
+"       syscall\n"
+"       testq   %rax, %rax\n"
+"       jnz     1f\n"
+"       popq    %rax\n"                 // CHILD: fn
+"       popq    %rdi\n"                 // arg
+"       call    *%rax\n"
+"       xorl    %edi, %edi\n"
+"       movq    $"VG_STRINGIFY(__NR_exit)", %rax\n"
+"       syscall\n"
+"       ud2\n"
+"1:     ret\n"                          // PARENT or error
+".previous\n"
+);
+#endif
+
+/* The workers of the VG_(run_workers) call in progress, and whether
+   any of them have a thread of their own. */
+static Worker*       active_ws = NULL;
+static Int           active_n  = 0;
+static volatile Bool workers_active = False;
+
+/* The worker lock.  -1 when free, else the VG_(worker_self) number of
+   the thread holding it, which may take it again. */
+static volatile Int worker_lock_owner = -1;
+static Int          worker_lock_depth = 0;
+
+Int VG_(worker_self) ( void )
+{
+   Addr sp = (Addr)&sp;
+   Int  i;
+   if (!workers_active)
+      return 0;
+   for (i = 1; i < active_n; i++) {
+      if (active_ws[i].stack != NULL
+          && sp >= (Addr)active_ws[i].stack
+          && sp < (Addr)active_ws[i].stack + WORKER_STACK_SZB)
+         return i;
+   }
+   return 0;
+}
+
+void VG_(acquire_worker_lock) ( void )
+{
+   Int me;
+   if (LIKELY(!workers_active))
+      return;
+   me = VG_(worker_self)();
+   if (worker_lock_owner == me) {
+      worker_lock_depth++;
+      return;
+   }
+   while (!__sync_bool_compare_and_swap(&worker_lock_owner, -1, me)) {
+#     if defined(VGO_linux)
+      VG_(do_syscall0)(__NR_sched_yield);
+#     endif
+   }
+   worker_lock_depth = 1;
+}
+
+void VG_(release_worker_lock) ( void )
+{
+   if (LIKELY(!workers_active))
+      return;
+   vg_assert(worker_lock_owner == VG_(worker_self)());
+   vg_assert(worker_lock_depth > 0);
+   if (--worker_lock_depth == 0) {
+      __sync_synchronize();
+      worker_lock_owner = -1;
+   }
+}
+
+static Word run_worker ( void* wv )
+{
+   Worker* w = wv;
+   w->fn(w->arg, w->i);
+   return 0;
+}
+
+void VG_(run_workers) ( Int n, void (*fn)(void*, Int), void* arg )
+{
+   Worker*      ws;
+   Int          i;
+
+   vg_assert(n >= 1 && n <= VG_MAX_WORKERS);
+   vg_assert(!workers_active);
+   ws = VG_(malloc)("libcproc.rw.1", n * sizeof(Worker));
+   for (i = 0; i < n; i++) {
+      ws[i].fn    = fn;
+      ws[i].arg   = arg;
+      ws[i].i     = i;
+      ws[i].stack = NULL;
+      ws[i].tid   = 0;
+   }
+
+#  if defined(VGP_amd64_linux)
+   {
+      const ULong  flags = VKI_CLONE_VM | VKI_CLONE_FS | VKI_CLONE_FILES
+                           | VKI_CLONE_SIGHAND | VKI_CLONE_THREAD
+                           | VKI_CLONE_SYSVSEM | VKI_CLONE_PARENT_SETTID
+                           | VKI_CLONE_CHILD_CLEARTID;
+      vki_sigset_t blockall, saved;
+
+      /* Get the stacks first: once a thread exists, allocating
+         means taking the worker lock. */
+      for (i = 1; i < n; i++)
+         ws[i].stack = VG_(malloc)("libcproc.rw.2", WORKER_STACK_SZB);
+      active_ws = ws;
+      active_n  = n;
+      if (n > 1)
+         workers_active = True;
+
+      /* The workers inherit this mask. */
+      VG_(sigfillset)(&blockall);
+      VG_(sigprocmask)(VKI_SIG_SETMASK, &blockall, &saved);
+      for (i = 1; i < n; i++) {
+         Long res;
+         res = do_clone_worker_amd64_linux(
+                  flags,
+                  (void*)VG_ROUNDDN((Addr)ws[i].stack + WORKER_STACK_SZB, 16),
+                  run_worker, &ws[i], &ws[i].tid);
+         if (res < 0) {
+            /* No thread; worker i runs on this one below. */
+            VG_(free)(ws[i].stack);
+            ws[i].stack = NULL;
+            ws[i].tid   = 0;
+         }
+      }
+      VG_(sigprocmask)(VKI_SIG_SETMASK, &saved, NULL);
+   }
+#  endif
+
+   run_worker(&ws[0]);
+
+   for (i = 1; i < n; i++) {
+      if (ws[i].stack == NULL) {
+         run_worker(&ws[i]);
+         continue;
+      }
+#     if defined(VGO_linux)
+      while (True) {
+         Int tid = ws[i].tid;
+         if (tid == 0)
+            break;
+         VG_(do_syscall4)(__NR_futex, (UWord)&ws[i].tid, VKI_FUTEX_WAIT,
+                          tid, 0);
+      }
+#     endif
+      VG_(free)(ws[i].stack);
+   }
+   __sync_synchronize();
+   workers_active = False;
+   active_ws = NULL;
+   active_n  = 0;
+
+   VG_(free)(ws);
+}
+
 /*--------------------------------------------------------------------*/
 /*--- end                                                          ---*/
 /*--------------------------------------------------------------------*/
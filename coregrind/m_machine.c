@@ -802,7 +802,7 @@ Bool VG_(machine_get_hwcaps)( void )
 #elif defined(VGA_amd64)
    { Bool have_sse3, have_cx8, have_cx16;
      Bool have_lzcnt, have_avx, have_bmi, have_avx2;
-     Bool have_rdtscp;
+     Bool have_rdtscp, have_fma;
      UInt eax, ebx, ecx, edx, max_basic, max_extended;
      HChar vstr[13];
      vstr[0] = 0;
@@ -840,7 +840,7 @@ Bool VG_(machine_get_hwcaps)( void )
      // avx     is ecx:28
      // fma     is ecx:12
      have_avx = False;
-     /* have_fma = False; */
+     have_fma = False;
      if ( (ecx & ((1<<27)|(1<<28))) == ((1<<27)|(1<<28)) ) {
         /* processor supports AVX instructions and XGETBV is enabled
            by OS */
@@ -853,9 +853,8 @@ Bool VG_(machine_get_hwcaps)( void )
         if ((w & 6) == 6) {
            /* OS has enabled both XMM and YMM state support */
            have_avx = True;
-           /* have_fma = (ecx & (1<<12)) != 0; */
-           /* have_fma: Probably correct, but gcc complains due to
-              unusedness. &*/
+           /* FMA3 insns are VEX-encoded, so need the YMM state too. */
+           have_fma = (ecx & (1<<12)) != 0;
         }
      }
 
@@ -900,6 +899,7 @@ Bool VG_(machine_get_hwcaps)( void )
                  | (have_avx    ? VEX_HWCAPS_AMD64_AVX    : 0)
                  | (have_bmi    ? VEX_HWCAPS_AMD64_BMI    : 0)
                  | (have_avx2   ? VEX_HWCAPS_AMD64_AVX2   : 0)
+                 | (have_fma    ? VEX_HWCAPS_AMD64_FMA    : 0)
                  | (have_rdtscp ? VEX_HWCAPS_AMD64_RDTSCP : 0);
 
      VG_(machine_get_cache_info)(&vai);
@@ -41,6 +41,7 @@
 #include "pub_core_debuglog.h"
 #include "pub_core_errormgr.h"
 #include "pub_core_execontext.h"
+#include "pub_core_forkserver.h"
 #include "pub_core_gdbserver.h"
 #include "pub_core_initimg.h"
 #include "pub_core_libcbase.h"
@@ -54,6 +55,8 @@
 #include "pub_core_mach.h"
 #include "pub_core_machine.h"
 #include "pub_core_mallocfree.h"
+#include "pub_core_metrics.h"
+#include "pub_core_perfevents.h"
 #include "pub_core_options.h"
 #include "pub_core_debuginfo.h"
 #include "pub_core_redir.h"
@@ -103,6 +106,17 @@ static void usage_NORETURN ( Bool debug_help )
 "                              but check the argv[] entries for children, rather\n"
 "                              than the exe name, to make a follow/no-follow decision\n"
 "    --child-silent-after-fork=no|yes omit child output between fork & exec? [no]\n"
+"    --fork-server-fd=<number> make VALGRIND_FORK_SERVER a fork server reading\n"
+"                              requests on this fd and replying on the next\n"
+"    --fast-forward=no|yes     run without the tool's instrumentation until\n"
+"                              VALGRIND_STOP_FAST_FORWARD starts it [no]\n"
+"    --fast-forward-bbs=<number> start it once <number> blocks have run\n"
+"    --fast-forward-fn=<name>  start it on entry to function <name>\n"
+"    --skip-instrument=obj:<patt>,fun:<patt>,...  run the code of matching\n"
+"                              objects and functions with the tool's cheap\n"
+"                              instrumentation only [none]\n"
+"    --instrument-only=obj:<patt>,fun:<patt>,...  do so for all the code\n"
+"                              but that of matching objects and functions\n"
 "    --vgdb=no|yes|full        activate gdbserver? [yes]\n"
 "                              full is slower but provides precise watchpoint/step\n"
 "    --vgdb-error=<number>     invoke gdbserver after <number> errors [%d]\n"
@@ -116,6 +130,13 @@ static void usage_NORETURN ( Bool debug_help )
 "    --log-fd=<number>         log messages to file descriptor [2=stderr]\n"
 "    --log-file=<file>         log messages to <file>\n"
 "    --log-socket=ipaddr:port  log messages to socket ipaddr:port\n"
+"    --output-buffer-size=<number> buffer file and socket output\n"
+"                              in <number> bytes [65536, 0=unbuffered]\n"
+"    --output-socket-drop=no|yes drop socket output rather than\n"
+"                              wait for a slow listener? [no]\n"
+"    --metrics-file=<file>     write metrics (counters) to <file>\n"
+"    --metrics-interval=<number> rewrite the --metrics-file every\n"
+"                              <number> seconds [10]\n"
 "\n"
 "  user options for Valgrind tools that report errors:\n"
 "    --xml=yes                 emit error output in XML (some tools only)\n"
@@ -123,6 +144,8 @@ static void usage_NORETURN ( Bool debug_help )
 "    --xml-file=<file>         XML output to <file>\n"
 "    --xml-socket=ipaddr:port  XML output to socket ipaddr:port\n"
 "    --xml-user-comment=STR    copy STR verbatim into XML output\n"
+"    --xml-stack-refs=no|yes   print repeated stacks and frames in XML\n"
+"                              output as references to an id [no]\n"
 "    --demangle=no|yes         automatically demangle C++ names? [yes]\n"
 "    --num-callers=<number>    show <number> callers in stack traces [12]\n"
 "    --error-limit=no|yes      stop showing new errors if too many? [yes]\n"
@@ -141,11 +164,18 @@ static void usage_NORETURN ( Bool debug_help )
 "                              than <number> bytes [2000000]\n"
 "    --main-stacksize=<number> set size of main thread's stack (in bytes)\n"
 "                              [min(max(current 'ulimit' value,1MB),16MB)]\n"
+"    --max-threads=<number>    maximum number of threads that valgrind can\n"
+"                              handle [500]\n"
 "\n"
 "  user options for Valgrind tools that replace malloc:\n"
 "    --alignment=<number>      set minimum alignment of heap allocations [%s]\n"
 "    --redzone-size=<number>   set minimum size of redzones added before/after\n"
 "                              heap blocks (in bytes). [%s]\n"
+"    --malloc-slabs=no|yes     put small heap blocks in slabs, with less\n"
+"                              overhead per block [no]\n"
+"    --guard-pages-above=<number>  give heap blocks of at least <number>\n"
+"                              bytes their own mapping, with an inaccessible\n"
+"                              page before and after it [0: none]\n"
 "\n"
 "  uncommon user options for all Valgrind tools:\n"
 "    --fullpath-after=         (with nothing after the '=')\n"
@@ -162,10 +192,12 @@ static void usage_NORETURN ( Bool debug_help )
 "    --allow-mismatched-debuginfo=no|yes  [no]\n"
 "                              for the above two flags only, accept debuginfo\n"
 "                              objects that don't \"match\" the main object\n"
-"    --smc-check=none|stack|all|all-non-file [stack]\n"
+"    --smc-check=none|stack|all|all-non-file|protect [stack]\n"
 "                              checks for self-modifying code: none, only for\n"
-"                              code found in stacks, for all code, or for all\n"
-"                              code except that from file-backed mappings\n"
+"                              code found in stacks, for all code, for all\n"
+"                              code except that from file-backed mappings,\n"
+"                              or as all-non-file but write-protecting the\n"
+"                              code's pages rather than checking it\n"
 "    --read-inline-info=yes|no read debug info about inlined function calls\n"
 "                              and use it to do better stack traces.  [yes]\n"
 "                              on Linux/Android for Memcheck/Helgrind/DRD\n"
@@ -174,6 +206,17 @@ static void usage_NORETURN ( Bool debug_help )
 "                              and use it to print better error messages in\n"
 "                              tools that make use of it (Memcheck, Helgrind,\n"
 "                              DRD) [no]\n"
+"    --lazy-debuginfo=no|yes   read only the symbols of an object when it is\n"
+"                              loaded, and its line, unwind and variable info\n"
+"                              when first needed [no]\n"
+"    --debuginfo-threads=<n>   read the line, unwind and variable info of the\n"
+"                              loaded objects on <n> threads when it is first\n"
+"                              needed; 1 reads it at load time [1]\n"
+"    --debuginfo-cache=<dir>   keep the symbol, line and unwind info read\n"
+"                              from objects with a build-id in <dir>, and\n"
+"                              use it instead of reading them again [none]\n"
+"    --debuginfo-image-cache=<n>  keep <n> 8KB blocks of each object file in\n"
+"                              memory while reading its debug info [128]\n"
 "    --vgdb-poll=<number>      gdbserver poll max every <number> basic blocks [%d] \n"
 "    --vgdb-shadow-registers=no|yes   let gdb see the shadow registers [no]\n"
 "    --vgdb-prefix=<prefix>    prefix for vgdb FIFOs [%s]\n"
@@ -183,6 +226,11 @@ static void usage_NORETURN ( Bool debug_help )
 "           lax-ioctls fuse-compatible enable-outer\n"
 "           no-inner-prefix no-nptl-pthread-stackcache none\n"
 "    --fair-sched=no|yes|try   schedule threads fairly on multicore systems [no]\n"
+"    --parallel-threads=no|yes run threads at the same time, for tools\n"
+"                              which support it [no]\n"
+"    --adaptive-quantum=no|yes shorten the timeslices of threads keeping\n"
+"                              others waiting for the lock [no]\n"
+"    --sched-affinity=no|yes   run all threads on the starting core [no]\n"
 "    --kernel-variant=variant1,variant2,...\n"
 "         handle non-standard kernel variants [none]\n"
 "         where variant is one of:\n"
@@ -192,6 +240,33 @@ static void usage_NORETURN ( Bool debug_help )
 "           program counters in max <number> frames) [0]\n"
 "    --num-transtab-sectors=<number> size of translated code cache [%d]\n"
 "           more sectors may increase performance, but use more memory.\n"
+"    --transtab-cache=<file>   reuse translations saved in <file> by earlier\n"
+"                              runs, and save this run's there [none]\n"
+"    --transtab-reuse=no|yes   keep translations, to reuse them when code\n"
+"                              is unmapped and mapped again unchanged [no]\n"
+"    --transtab-share=no|yes   share translations with other processes\n"
+"                              running the same tool and options [no]\n"
+"    --transtab-keep-hot=no|yes  when the translation cache is full, keep\n"
+"                              the translations still in use [no]\n"
+"    --hot-code-layout=no|yes  gather frequently run translations together\n"
+"                              in a sector of their own [no]\n"
+"    --pretranslate-successors=no|yes  translate the direct successors of\n"
+"                              each new block along with it [no]\n"
+"    --pretranslate=<obj>:<fn>,...  translate the functions matching <fn>\n"
+"                              in objects matching <obj> once loaded [none]\n"
+"    --tier-up-threshold=<number>  translate blocks cheaply at first, and\n"
+"                              in full once they have run <number> times;\n"
+"                              0 translates them in full at once [0]\n"
+"    --hot-traces=no|yes       when re-translating hot blocks, follow their\n"
+"                              usual conditional branches [no]\n"
+"    --hot-loops=no|yes        when re-translating hot blocks, unroll their\n"
+"                              loops further, keeping guest registers in\n"
+"                              host registers between iterations [no]\n"
+"    --inline-caches=no|yes    when re-translating hot blocks, send their\n"
+"                              indirect jumps direct to the last target [no]\n"
+"    --huge-pages=no|transparent|yes  back the translation cache and shadow\n"
+"                              memory with 2MB pages; 'transparent' only\n"
+"                              advises the kernel to use them [no]\n"
 "    --aspace-minaddr=0xPP     avoid mapping memory below 0xPP [guessed]\n"
 "    --show-emwarns=no|yes     show warnings about emulation limits? [no]\n"
 "    --require-text-symbol=:sonamepattern:symbolpattern    abort run if the\n"
@@ -208,6 +283,9 @@ static void usage_NORETURN ( Bool debug_help )
 "                  NOTE: stack scanning is only available on arm-linux.\n"
 "    --unw-stack-scan-frames=<number>   Max number of frames that can be\n"
 "                  recovered by stack scanning [5]\n"
+"    --unw-frame-pointer=no|yes  follow the frame pointer chain rather\n"
+"                  than CFI when unwinding; only for programs built with\n"
+"                  -fno-omit-frame-pointer.  amd64 only [no]\n"
 "\n";
 
    const HChar usage2[] = 
@@ -220,6 +298,13 @@ static void usage_NORETURN ( Bool debug_help )
 "    --profile-flags=<XXXXXXXX> ditto, but for profiling (X = 0|1) [00000000]\n"
 "    --profile-interval=<number> show profile every <number> event checks\n"
 "                                [0, meaning only at the end of the run]\n"
+"    --profile-sample=<number> sample the running SB every <number> event\n"
+"                              checks on average, show the hottest at the\n"
+"                              end of the run [0, meaning no sampling]\n"
+"    --perf-counters=no|yes    count host cycles, cache misses, ... in each\n"
+"                              phase (JIT, translated code, syscalls) [no]\n"
+"    --perf-map=no|yes         write /tmp/perf-<pid>.map naming translations\n"
+"                              after guest functions, for perf [no]\n"
 "    --trace-notbelow=<number> only show BBs above <number> [999999999]\n"
 "    --trace-notabove=<number> only show BBs below <number> [0]\n"
 "    --trace-syscalls=no|yes   show all system calls? [no]\n"
@@ -233,6 +318,7 @@ static void usage_NORETURN ( Bool debug_help )
 "    --trace-redir=no|yes      show redirection details? [no]\n"
 "    --trace-sched=no|yes      show thread scheduler details? [no]\n"
 "    --profile-heap=no|yes     profile Valgrind's own space use\n"
+"    --profile-jit=no|yes      time each phase of translation [no]\n"
 "    --core-redzone-size=<number>  set minimum size of redzones added before/after\n"
 "                              heap blocks allocated for Valgrind internal use (in bytes) [4]\n"
 "    --wait-for-gdb=yes|no     pause on startup to wait for gdb attach\n"
@@ -250,6 +336,7 @@ static void usage_NORETURN ( Bool debug_help )
 "    --vex-guest-max-insns=<1..100>         [50]\n"
 "    --vex-guest-chase-thresh=<0..99>       [10]\n"
 "    --vex-guest-chase-cond=no|yes          [no]\n"
+"    --vex-regalloc-version=2|3             [2]\n"
 "    --trace-flags and --profile-flags values (omit the middle space):\n"
 "       1000 0000   show conversion into IR\n"
 "       0100 0000   show after initial opt\n"
@@ -341,6 +428,7 @@ static void usage_NORETURN ( Bool debug_help )
    - set VG_(clo_max_stackframe) (--max-stackframe=)
    - set VG_(clo_main_stacksize) (--main-stacksize=)
    - set VG_(clo_sim_hints) (--sim-hints=)
+   - set VG_N_THREADS (--max-threads=)
 
    That's all it does.  The main command line processing is done below
    by main_process_cmd_line_options.  Note that
@@ -390,6 +478,11 @@ static void early_process_cmd_line_options ( /*OUT*/Int* need_help,
                             "enable-outer,no-inner-prefix,"
                             "no-nptl-pthread-stackcache",
                             VG_(clo_sim_hints)) {}
+
+      // Set up VG_N_THREADS, before the thread table and the tool's
+      // per-thread tables are allocated.
+      else if VG_BINT_CLO(str, "--max-threads", VG_(n_threads),
+                          2, 100000) {}
    }
 }
 
@@ -512,6 +605,7 @@ void main_process_cmd_line_options ( /*OUT*/Bool* logging_to_fd,
       else if VG_STREQN(17, arg, "--max-stackframe=")    {}
       else if VG_STREQN(17, arg, "--main-stacksize=")    {}
       else if VG_STREQN(12, arg, "--sim-hints=")         {}
+      else if VG_STREQN(14, arg, "--max-threads=")       {}
       else if VG_STREQN(15, arg, "--profile-heap=")      {}
       else if VG_STREQN(20, arg, "--core-redzone-size=") {}
       else if VG_STREQN(15, arg, "--redzone-size=")      {}
@@ -545,6 +639,7 @@ void main_process_cmd_line_options ( /*OUT*/Bool* logging_to_fd,
          sigill_diag_set = True;
 
       else if VG_BOOL_CLO(arg, "--stats",          VG_(clo_stats)) {}
+      else if VG_BOOL_CLO(arg, "--profile-jit",    VG_(clo_profile_jit)) {}
       else if VG_BOOL_CLO(arg, "--xml",            VG_(clo_xml))
          VG_(debugLog_setXml)(VG_(clo_xml));
 
@@ -580,6 +675,18 @@ void main_process_cmd_line_options ( /*OUT*/Bool* logging_to_fd,
       else if VG_BOOL_CLO(arg, "--trace-children",   VG_(clo_trace_children)) {}
       else if VG_BOOL_CLO(arg, "--child-silent-after-fork",
                             VG_(clo_child_silent_after_fork)) {}
+      else if VG_INT_CLO (arg, "--fork-server-fd",   VG_(clo_fork_server_fd)) {}
+      else if VG_BOOL_CLO(arg, "--fast-forward",     VG_(clo_fast_forward)) {}
+      else if VG_BINT_CLO(arg, "--fast-forward-bbs", VG_(clo_fast_forward_bbs),
+                               0, 0x7FFFFFFFFFFFFFFFLL) {
+         if (VG_(clo_fast_forward_bbs) > 0)
+            VG_(clo_fast_forward) = True;
+      }
+      else if VG_STR_CLO (arg, "--fast-forward-fn",  VG_(clo_fast_forward_fn)) {
+         VG_(clo_fast_forward) = True;
+      }
+      else if VG_STR_CLO (arg, "--skip-instrument",  VG_(clo_skip_instrument)) {}
+      else if VG_STR_CLO (arg, "--instrument-only",  VG_(clo_instrument_only)) {}
       else if VG_STR_CLO(arg, "--fair-sched",        tmp_str) {
          if (VG_(strcmp)(tmp_str, "yes") == 0)
             VG_(clo_fair_sched) = enable_fair_sched;
@@ -591,6 +698,20 @@ void main_process_cmd_line_options ( /*OUT*/Bool* logging_to_fd,
             VG_(fmsg_bad_option)(arg, "");
 
       }
+      else if VG_BOOL_CLO(arg, "--malloc-slabs",     VG_(clo_malloc_slabs)) {}
+      else if VG_BINT_CLO(arg, "--guard-pages-above",
+                               VG_(clo_guard_pages_above),
+                               0, 1024*1024*1024) {
+         if (VG_(clo_guard_pages_above) > 0
+             && VG_(clo_guard_pages_above) < 4096)
+            VG_(fmsg_bad_option)(arg, "must be 0 or at least 4096\n");
+      }
+      else if VG_BOOL_CLO(arg, "--parallel-threads",
+                               VG_(clo_parallel_threads)) {}
+      else if VG_BOOL_CLO(arg, "--adaptive-quantum",
+                               VG_(clo_adaptive_quantum)) {}
+      else if VG_BOOL_CLO(arg, "--sched-affinity",
+                               VG_(clo_sched_affinity)) {}
       else if VG_BOOL_CLO(arg, "--trace-sched",      VG_(clo_trace_sched)) {}
       else if VG_BOOL_CLO(arg, "--trace-signals",    VG_(clo_trace_signals)) {}
       else if VG_BOOL_CLO(arg, "--trace-symtab",     VG_(clo_trace_symtab)) {}
@@ -610,6 +731,12 @@ void main_process_cmd_line_options ( /*OUT*/Bool* logging_to_fd,
       else if VG_BOOL_CLO(arg, "--sym-offsets",      VG_(clo_sym_offsets)) {}
       else if VG_BOOL_CLO(arg, "--read-inline-info", VG_(clo_read_inline_info)) {}
       else if VG_BOOL_CLO(arg, "--read-var-info",    VG_(clo_read_var_info)) {}
+      else if VG_BOOL_CLO(arg, "--lazy-debuginfo",   VG_(clo_lazy_debuginfo)) {}
+      else if VG_BINT_CLO(arg, "--debuginfo-threads",
+                               VG_(clo_debuginfo_threads), 1, 16) {}
+      else if VG_STR_CLO (arg, "--debuginfo-cache",  VG_(clo_debuginfo_cache)) {}
+      else if VG_BINT_CLO(arg, "--debuginfo-image-cache",
+                               VG_(clo_debuginfo_image_cache), 32, 8192) {}
 
       else if VG_INT_CLO (arg, "--dump-error",       VG_(clo_dump_error))   {}
       else if VG_INT_CLO (arg, "--input-fd",         VG_(clo_input_fd))     {}
@@ -619,6 +746,31 @@ void main_process_cmd_line_options ( /*OUT*/Bool* logging_to_fd,
       else if VG_BINT_CLO(arg, "--num-transtab-sectors",
                                VG_(clo_num_transtab_sectors),
                                MIN_N_SECTORS, MAX_N_SECTORS) {}
+      else if VG_STR_CLO (arg, "--transtab-cache",
+                               VG_(clo_transtab_cache)) {}
+      else if VG_BOOL_CLO(arg, "--transtab-reuse",
+                               VG_(clo_transtab_reuse)) {}
+      else if VG_BOOL_CLO(arg, "--transtab-share",
+                               VG_(clo_transtab_share)) {}
+      else if VG_BOOL_CLO(arg, "--transtab-keep-hot",
+                               VG_(clo_transtab_keep_hot)) {}
+      else if VG_BOOL_CLO(arg, "--hot-code-layout",
+                               VG_(clo_hot_code_layout)) {}
+      else if VG_BOOL_CLO(arg, "--pretranslate-successors",
+                               VG_(clo_pretranslate_successors)) {}
+      else if VG_STR_CLO(arg, "--pretranslate", VG_(clo_pretranslate)) {}
+      else if VG_BINT_CLO(arg, "--tier-up-threshold",
+                               VG_(clo_tier_up_threshold), 0, 1000000000) {}
+      else if VG_BOOL_CLO(arg, "--hot-traces", VG_(clo_hot_traces)) {}
+      else if VG_BOOL_CLO(arg, "--hot-loops", VG_(clo_hot_loops)) {}
+      else if VG_BOOL_CLO(arg, "--inline-caches", VG_(clo_inline_caches)) {}
+      else if VG_XACT_CLO(arg, "--huge-pages=no",
+                               VG_(clo_huge_pages), Vg_HugePagesNo) {}
+      else if VG_XACT_CLO(arg, "--huge-pages=transparent",
+                               VG_(clo_huge_pages),
+                               Vg_HugePagesTransparent) {}
+      else if VG_XACT_CLO(arg, "--huge-pages=yes",
+                               VG_(clo_huge_pages), Vg_HugePagesYes) {}
       else if VG_BINT_CLO(arg, "--merge-recursive-frames",
                                VG_(clo_merge_recursive_frames), 0,
                                VG_DEEPEST_BACKTRACE) {}
@@ -632,6 +784,9 @@ void main_process_cmd_line_options ( /*OUT*/Bool* logging_to_fd,
       else if VG_XACT_CLO(arg, "--smc-check=all-non-file",
                                                     VG_(clo_smc_check),
                                                     Vg_SmcAllNonFile);
+      else if VG_XACT_CLO(arg, "--smc-check=protect",
+                                                    VG_(clo_smc_check),
+                                                    Vg_SmcProtect);
 
       else if VG_USETX_CLO (arg, "--kernel-variant",
                             "bproc,"
@@ -675,6 +830,8 @@ void main_process_cmd_line_options ( /*OUT*/Bool* logging_to_fd,
                        VG_(clo_vex_control).guest_chase_thresh, 0, 99) {}
       else if VG_BOOL_CLO(arg, "--vex-guest-chase-cond",
                        VG_(clo_vex_control).guest_chase_cond) {}
+      else if VG_BINT_CLO(arg, "--vex-regalloc-version",
+                       VG_(clo_vex_control).regalloc_version, 2, 3) {}
 
       else if VG_INT_CLO(arg, "--log-fd", tmp_log_fd) {
          log_to = VgLogTo_Fd;
@@ -698,6 +855,13 @@ void main_process_cmd_line_options ( /*OUT*/Bool* logging_to_fd,
       else if VG_STR_CLO(arg, "--xml-socket", xml_fsname_unexpanded) {
          xml_to = VgLogTo_Socket;
       }
+      else if VG_BINT_CLO(arg, "--output-buffer-size",
+                          VG_(clo_output_buffer_size), 0, 16*1024*1024) {}
+      else if VG_BOOL_CLO(arg, "--output-socket-drop",
+                          VG_(clo_output_socket_drop)) {}
+      else if VG_STR_CLO(arg, "--metrics-file", VG_(clo_metrics_fname)) {}
+      else if VG_BINT_CLO(arg, "--metrics-interval",
+                          VG_(clo_metrics_interval), 1, 86400) {}
 
       else if VG_STR_CLO(arg, "--debuginfo-server",
                               VG_(clo_debuginfo_server)) {}
@@ -708,6 +872,9 @@ void main_process_cmd_line_options ( /*OUT*/Bool* logging_to_fd,
       else if VG_STR_CLO(arg, "--xml-user-comment",
                               VG_(clo_xml_user_comment)) {}
 
+      else if VG_BOOL_CLO(arg, "--xml-stack-refs",
+                               VG_(clo_xml_stack_refs)) {}
+
       else if VG_BOOL_CLO(arg, "--default-suppressions",
                           VG_(clo_default_supp)) { }
 
@@ -805,6 +972,10 @@ void main_process_cmd_line_options ( /*OUT*/Bool* logging_to_fd,
 
       else if VG_INT_CLO (arg, "--profile-interval",
                           VG_(clo_profyle_interval)) {}
+      else if VG_BINT_CLO(arg, "--profile-sample",
+                          VG_(clo_profile_sample), 0, 100000000) {}
+      else if VG_BOOL_CLO(arg, "--perf-counters", VG_(clo_perf_counters)) {}
+      else if VG_BOOL_CLO(arg, "--perf-map",      VG_(clo_perf_map)) {}
 
       else if VG_XACT_CLO(arg, "--gen-suppressions=no",
                                VG_(clo_gen_suppressions), 0) {}
@@ -817,6 +988,8 @@ void main_process_cmd_line_options ( /*OUT*/Bool* logging_to_fd,
                           VG_(clo_unw_stack_scan_thresh), 0, 100) {}
       else if VG_BINT_CLO(arg, "--unw-stack-scan-frames",
                           VG_(clo_unw_stack_scan_frames), 0, 32) {}
+      else if VG_BOOL_CLO(arg, "--unw-frame-pointer",
+                          VG_(clo_unw_frame_pointer)) {}
 
       else if ( ! VG_(needs).command_line_options
              || ! VG_TDICT_CALL(tool_process_cmd_line_option, arg) ) {
@@ -846,6 +1019,46 @@ void main_process_cmd_line_options ( /*OUT*/Bool* logging_to_fd,
    if (VG_(clo_vex_control).guest_chase_thresh < 0)
       VG_(clo_vex_control).guest_chase_thresh = 0;
 
+   if (VG_(clo_hot_traces) && VG_(clo_tier_up_threshold) == 0)
+      VG_(fmsg_bad_option)("--hot-traces=yes",
+                           "it needs a nonzero --tier-up-threshold\n");
+   if (VG_(clo_hot_loops) && VG_(clo_tier_up_threshold) == 0)
+      VG_(fmsg_bad_option)("--hot-loops=yes",
+                           "it needs a nonzero --tier-up-threshold\n");
+   if (VG_(clo_inline_caches) && VG_(clo_tier_up_threshold) == 0)
+      VG_(fmsg_bad_option)("--inline-caches=yes",
+                           "it needs a nonzero --tier-up-threshold\n");
+
+   if (VG_(clo_fast_forward) && !VG_(needs).fast_forward)
+      VG_(fmsg_bad_option)("--fast-forward=yes",
+                           "%s does not support it\n", VG_(details).name);
+   VG_(init_instrumentation_filter)();
+
+   if (VG_(clo_parallel_threads)) {
+#     if !defined(VGP_amd64_linux)
+      VG_(fmsg_bad_option)("--parallel-threads=yes",
+                           "it is only supported on amd64-linux\n");
+#     endif
+      if (!VG_(needs).thread_safe_instrumentation)
+         VG_(fmsg_bad_option)("--parallel-threads=yes",
+                              "%s does not support it\n",
+                              VG_(details).name);
+      /* These patch or replace translations that other threads may
+         be running. */
+      if (VG_(clo_tier_up_threshold) > 0)
+         VG_(fmsg_bad_option)("--parallel-threads=yes",
+                              "it can't be used with --tier-up-threshold\n");
+      if (VG_(clo_hot_code_layout))
+         VG_(fmsg_bad_option)("--parallel-threads=yes",
+                              "it can't be used with --hot-code-layout\n");
+   }
+
+   if (VG_(clo_hot_code_layout)
+       && VG_(clo_num_transtab_sectors) >= MAX_N_SECTORS)
+      VG_(fmsg_bad_option)("--hot-code-layout=yes",
+                           "it needs --num-transtab-sectors to be at most %d\n",
+                           MAX_N_SECTORS - 1);
+
    /* Check various option values */
 
    if (VG_(clo_verbosity) < 0)
@@ -1139,6 +1352,20 @@ void main_process_cmd_line_options ( /*OUT*/Bool* logging_to_fd,
       VG_(xml_output_sink).is_socket = False;
    }
 
+   // Buffer the output going to a file or a socket.  Not the output
+   // going to a file descriptor, as the client may be writing to it too.
+
+   if (VG_(clo_output_buffer_size) > 0) {
+      if ((log_to == VgLogTo_File
+           || (log_to == VgLogTo_Socket && VG_(log_output_sink).is_socket))
+          && VG_(log_output_sink).fd > 2)
+         VG_(buffer_output_sink)(&VG_(log_output_sink));
+      if ((xml_to == VgLogTo_File
+           || (xml_to == VgLogTo_Socket && VG_(xml_output_sink).is_socket))
+          && VG_(xml_output_sink).fd > 2)
+         VG_(buffer_output_sink)(&VG_(xml_output_sink));
+   }
+
    // Suppressions related stuff
 
    if (VG_(clo_default_supp) &&
@@ -1811,6 +2038,13 @@ Int valgrind_main ( Int argc, HChar **argv, HChar **envp )
                     "(early_) Process Valgrind's command line options\n");
    early_process_cmd_line_options(&need_help, &toolname);
 
+   //--------------------------------------------------------------
+   // Allocate the thread table
+   //   p: early_process_cmd_line_options() [for VG_N_THREADS]
+   //--------------------------------------------------------------
+   VG_(debugLog)(1, "main", "Allocate the thread table\n");
+   VG_(init_Threads)();
+
    // BEGIN HACK
    vg_assert(toolname != NULL);
    vg_assert(VG_(clo_read_inline_info) == False);
@@ -1992,6 +2226,13 @@ Int valgrind_main ( Int argc, HChar **argv, HChar **envp )
    main_process_cmd_line_options ( &logging_to_fd, &xml_fname_unexpanded,
                                    toolname );
 
+   //--------------------------------------------------------------
+   // Take over the fork server file descriptors
+   //   p: setup_file_descriptors()  [for 'VG_(fd_xxx_limit)']
+   //   p: main_process_cmd_line_options() [for VG_(clo_fork_server_fd)]
+   //--------------------------------------------------------------
+   VG_(fork_server_init)();
+
    //--------------------------------------------------------------
    // Zeroise the millisecond counter by doing a first read of it.
    //   p: none
@@ -2191,8 +2432,6 @@ Int valgrind_main ( Int argc, HChar **argv, HChar **envp )
       VG_(printf_xml)( "\n" );
    }
 
-   VG_(init_Threads)();
-
    //--------------------------------------------------------------
    // Initialise the scheduler (phase 1) [generates tid_main]
    //   p: none, afaics
@@ -2413,6 +2652,7 @@ Int valgrind_main ( Int argc, HChar **argv, HChar **envp )
    // Run!
    //--------------------------------------------------------------
    VG_(debugLog)(1, "main", "Running thread 1\n");
+   VG_(metrics_startup_done)();
 
    /* As a result of the following call, the last thread standing
       eventually winds up running shutdown_actions_NORETURN
@@ -2555,9 +2795,20 @@ void shutdown_actions_NORETURN( ThreadId tid,
 
    VG_(sanity_check_general)( True /*include expensive checks*/ );
 
+   /* Write the final metrics, after the leak search. */
+   VG_(maybe_write_metrics)( True /*final*/ );
+
+   /* Save the translations for next time, if asked to. */
+   VG_(save_transtab_cache)();
+
    if (VG_(clo_stats))
       VG_(print_all_stats)(VG_(clo_verbosity) > 2, /* Memory stats */
                            False /* tool prints stats in the tool fini */);
+   else {
+      if (VG_(clo_profile_jit))
+         VG_(print_jit_profile)();
+      VG_(print_perf_counters)();
+   }
 
    /* Show a profile of the heap(s) at shutdown.  Optionally, first
       throw away all the debug info, as that makes it easy to spot
@@ -2573,6 +2824,8 @@ void shutdown_actions_NORETURN( ThreadId tid,
    if (VG_(clo_profyle_sbs) && VG_(clo_profyle_interval) == 0) {
       VG_(get_and_show_SB_profile)(0/*denoting end-of-run*/);
    }
+   if (VG_(clo_profile_sample) > 0)
+      VG_(show_SB_samples)();
 
    /* Print Vex storage stats */
    if (0)
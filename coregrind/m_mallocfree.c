@@ -36,6 +36,7 @@
 #include "pub_core_aspacemgr.h"
 #include "pub_core_libcassert.h"
 #include "pub_core_libcprint.h"
+#include "pub_core_libcproc.h"     // For VG_(acquire_worker_lock)
 #include "pub_core_mallocfree.h"
 #include "pub_core_options.h"
 #include "pub_core_libcsetjmp.h"    // to keep _threadstate.h happy
@@ -57,6 +58,8 @@ Long VG_(free_queue_volume) = 0;
 Long VG_(free_queue_length) = 0;
 
 static void cc_analyse_alloc_arena ( ArenaId aid ); /* fwds */
+static Bool describe_slab_addr ( Addr a, AddrArenaInfo* aai );
+static void sanity_check_slabs ( void );
 
 /*------------------------------------------------------------*/
 /*--- Main types                                           ---*/
@@ -206,6 +209,12 @@ typedef
       // allocated block is freed.
       // Smaller size superblocks are splittable and can be reclaimed when all
       // their blocks are freed.
+      Bool         guards_suspended;
+      // With --guard-pages-above, every unsplittable superblock of the
+      // client arena is mapped with an inaccessible page on each side,
+      // and blocks of at least that size always get a superblock of
+      // their own, except while memalign suspends that because it needs
+      // a splittable superblock.  See arena_is_guarded.
       Block*       freelist[N_MALLOC_LISTS];
       // A dynamically expanding, ordered array of (pointers to)
       // superblocks in the arena.  If this array is expanded, which
@@ -234,6 +243,9 @@ typedef
       ULong        stats__nreclaim_split;
       /* total # of reclaim executed for unsplittable/splittable superblocks */
       SizeT        stats__bytes_on_loan;
+      SizeT        stats__bytes_cached; /* in client magazines and slabs */
+      SizeT        stats__blocks_cached;
+      SizeT        stats__bytes_slab_admin; /* client slab redzones, slack */
       SizeT        stats__bytes_mmaped;
       SizeT        stats__bytes_on_loan_max;
       ULong        stats__tot_blocks; /* total # blocks alloc'd */
@@ -535,6 +547,16 @@ static void mkBhdrSzAccess( Arena* a, Block* b )
 // The arena structures themselves.
 static Arena vg_arena[VG_N_ARENAS];
 
+// Stats for the client magazines (see mag_malloc).
+static ULong stats__mag_hits    = 0;
+static ULong stats__mag_refills = 0;
+static ULong stats__mag_flushes = 0;
+
+// The number of client slabs, and stats for them (see slab_malloc).
+static UWord slab_n_slabs         = 0;
+static ULong stats__slab_news     = 0;
+static ULong stats__slab_releases = 0;
+
 // Functions external to this module identify arenas using ArenaIds,
 // not Arena*s.  This fn converts the former to the latter.
 static Arena* arenaId_to_ArenaP ( ArenaId arena )
@@ -550,6 +572,23 @@ static ArenaId arenaP_to_ArenaId ( Arena *a )
    return arena;
 }
 
+// Are the unsplittable superblocks of arena a guarded?  The client arena is
+// initialised before the command line is read, but no client block is
+// allocated before then, so this is fixed for the life of any superblock.
+static __inline__
+Bool arena_is_guarded ( const Arena* a )
+{
+   return a->clientmem && VG_(clo_guard_pages_above) > 0;
+}
+
+// Must a block of req_pszB bytes get a guarded superblock of its own?
+static __inline__
+Bool needs_guards ( const Arena* a, SizeT req_pszB )
+{
+   return arena_is_guarded(a) && !a->guards_suspended
+          && req_pszB >= VG_(clo_guard_pages_above);
+}
+
 // Initialise an arena.  rz_szB is the (default) minimum redzone size;
 // It might be overriden by VG_(clo_redzone_size) or VG_(clo_core_redzone_size).
 // it might be made bigger to ensure that VG_MIN_MALLOC_SZB is observed.
@@ -595,6 +634,7 @@ void arena_init ( ArenaId aid, const HChar* name, SizeT rz_szB,
 
    a->min_sblock_szB = min_sblock_szB;
    a->min_unsplittable_sblock_szB = min_unsplittable_sblock_szB;
+   a->guards_suspended = False;
    for (i = 0; i < N_MALLOC_LISTS; i++) a->freelist[i] = NULL;
 
    a->sblocks                  = & a->sblocks_initial[0];
@@ -608,6 +648,9 @@ void arena_init ( ArenaId aid, const HChar* name, SizeT rz_szB,
    a->stats__nreclaim_unsplit  = 0;
    a->stats__nreclaim_split    = 0;
    a->stats__bytes_on_loan     = 0;
+   a->stats__bytes_cached      = 0;
+   a->stats__blocks_cached     = 0;
+   a->stats__bytes_slab_admin  = 0;
    a->stats__bytes_mmaped      = 0;
    a->stats__bytes_on_loan_max = 0;
    a->stats__bytes_mmaped_max  = 0;
@@ -641,6 +684,35 @@ void VG_(print_all_arena_stats) ( void )
                    a->rz_szB
       );
    }
+   if (stats__mag_refills > 0)
+      VG_(message)(Vg_DebugMsg,
+                   "  client: %llu magazine hits, %llu refills, "
+                   "%llu flushes, %lu blocks cached\n",
+                   stats__mag_hits, stats__mag_refills, stats__mag_flushes,
+                   arenaId_to_ArenaP(VG_AR_CLIENT)->stats__blocks_cached);
+   if (stats__slab_news > 0)
+      VG_(message)(Vg_DebugMsg,
+                   "  client: %lu slabs, %llu made, %llu released, "
+                   "%lu bytes of slab redzones\n",
+                   slab_n_slabs, stats__slab_news, stats__slab_releases,
+                   arenaId_to_ArenaP(VG_AR_CLIENT)->stats__bytes_slab_admin);
+}
+
+void VG_(arena_metrics) ( void (*put)(const HChar* name, ULong value) )
+{
+   UInt  i;
+   HChar name[50];
+   for (i = 0; i < VG_N_ARENAS; i++) {
+      Arena* a = arenaId_to_ArenaP(i);
+      if (a->name == NULL)
+         continue;  // not initialised yet
+      VG_(sprintf)(name, "arena.%s.bytes_on_loan", a->name);
+      put(name, a->stats__bytes_on_loan);
+      VG_(sprintf)(name, "arena.%s.max_bytes_on_loan", a->name);
+      put(name, a->stats__bytes_on_loan_max);
+      VG_(sprintf)(name, "arena.%s.mmapped", a->name);
+      put(name, a->stats__bytes_mmaped);
+   }
 }
 
 void VG_(print_arena_cc_analysis) ( void )
@@ -828,6 +900,7 @@ Superblock* newSuperblock ( Arena* a, SizeT cszB )
    Superblock* sb;
    SysRes      sres;
    Bool        unsplittable;
+   Bool        own_sb;
    ArenaId     aid;
 
    // A new superblock is needed for arena a. We will execute the deferred
@@ -839,19 +912,29 @@ Superblock* newSuperblock ( Arena* a, SizeT cszB )
          deferred_reclaimSuperblock (arena, NULL);
    }
 
+   // A block big enough to be guarded gets a superblock just its size.
+   own_sb = needs_guards(a, cszB);
+
    // Take into account admin bytes in the Superblock.
    cszB += sizeof(Superblock);
 
-   if (cszB < a->min_sblock_szB) cszB = a->min_sblock_szB;
+   if (cszB < a->min_sblock_szB && !own_sb) cszB = a->min_sblock_szB;
    cszB = VG_PGROUNDUP(cszB);
 
-   if (cszB >= a->min_unsplittable_sblock_szB)
+   if (cszB >= a->min_unsplittable_sblock_szB || own_sb)
       unsplittable = True;
    else
       unsplittable = False;   
 
 
-   if (a->clientmem) {
+   if (unsplittable && arena_is_guarded(a)) {
+      sres = VG_(am_mmap_anon_float_client_guarded)
+         ( cszB, VKI_PROT_READ|VKI_PROT_WRITE|VKI_PROT_EXEC );
+      if (sr_isError(sres))
+         return 0;
+      sb = (Superblock*)(AddrH)sr_Res(sres);
+      VG_(am_set_segment_isCH_if_SkAnonC)( VG_(am_find_nsegment)( (Addr)sb ) );
+   } else if (a->clientmem) {
       // client allocation -- return 0 to client if it fails
       sres = VG_(am_mmap_anon_float_client)
          ( cszB, VKI_PROT_READ|VKI_PROT_WRITE|VKI_PROT_EXEC );
@@ -930,7 +1013,10 @@ void reclaimSuperblock ( Arena* a, Superblock* sb)
    if (a->clientmem) {
       // reclaimable client allocation 
       Bool need_discard = False;
-      sres = VG_(am_munmap_client)(&need_discard, (Addr) sb, cszB);
+      if (sb->unsplittable && arena_is_guarded(a))
+         sres = VG_(am_munmap_client_guarded)(&need_discard, (Addr) sb, cszB);
+      else
+         sres = VG_(am_munmap_client)(&need_discard, (Addr) sb, cszB);
       vg_assert2(! sr_isError(sres), "superblock client munmap failure\n");
       /* We somewhat help the client by discarding the range.
          Note however that if the client has JITted some code in
@@ -1304,6 +1390,11 @@ static void sanity_check_malloc_arena ( ArenaId aid )
    }
 
    arena_bytes_on_loan += a->stats__perm_bytes_on_loan;
+   arena_bytes_on_loan -= a->stats__bytes_cached;
+   arena_bytes_on_loan -= a->stats__bytes_slab_admin;
+
+   if (aid == VG_AR_CLIENT)
+      sanity_check_slabs();
 
    if (arena_bytes_on_loan != a->stats__bytes_on_loan) {
 #     ifdef VERBOSE_MALLOC
@@ -1504,12 +1595,17 @@ void VG_(sanity_check_malloc_all) ( void )
    }
 }
 
+static Bool is_mag_block ( Arena* a, Block* b ); /*fwd*/
+
 void VG_(describe_arena_addr) ( Addr a, AddrArenaInfo* aai )
 {
    UInt i;
    Superblock *sb;
    Arena      *arena;
 
+   if (describe_slab_addr(a, aai))
+      return;
+
    for (i = 0; i < VG_N_ARENAS; i++) {
       if (i == VG_AR_CLIENT && !client_inited)
          continue;
@@ -1531,7 +1627,8 @@ void VG_(describe_arena_addr) ( Addr a, AddrArenaInfo* aai )
          vg_assert (b);
          aai->block_szB = get_pszB(arena, b);
          aai->rwoffset = a - (Addr)get_block_payload(arena, b);
-         aai->free = !is_inuse_block(b);
+         aai->free = !is_inuse_block(b)
+                     || (i == VG_AR_CLIENT && is_mag_block(arena, b));
          return;
       }
    }
@@ -1673,10 +1770,559 @@ void add_one_block_to_stats (Arena* a, SizeT loaned)
    a->stats__tot_bytes  += (ULong)loaned;
 }
 
+/*------------------------------------------------------------*/
+/*--- Per-thread magazines of small client blocks           ---*/
+/*------------------------------------------------------------*/
+
+/* Clients mostly allocate and free small blocks, and taking each one
+   from, and giving it back to, the freelists costs a search, a split
+   and a coalesce.  So for each small size class, each thread keeps a
+   "magazine" of free client blocks.  To the arena, blocks in a
+   magazine are in use, but they are not counted as on loan.  An empty
+   magazine is refilled by carving a single arena block into
+   MAG_REFILL blocks; a full one gives MAG_REFILL blocks back.
+
+   Class c holds blocks with a payload of at least (c+1) * MAG_GRAIN
+   bytes. */
+#define MAG_GRAIN      VG_MIN_MALLOC_SZB
+#define MAG_N_CLASSES  16
+#define MAG_MAX_PSZB   (MAG_N_CLASSES * MAG_GRAIN)
+#define MAG_SIZE       32
+#define MAG_REFILL     16
+
+typedef
+   struct {
+      UInt   n_blocks;
+      Block* blocks[MAG_SIZE];
+   }
+   Magazine;
+
+static Magazine** client_mags = NULL;   /* [VG_N_THREADS] */
+
+static void arena_free_block ( ArenaId aid, Arena* a, void* ptr ); /*fwd*/
+
+static Magazine* get_client_mag ( UInt c )
+{
+   ThreadId tid = VG_(get_running_tid)();
+   if (tid >= VG_N_THREADS)
+      tid = VG_INVALID_THREADID;
+   if (UNLIKELY(client_mags == NULL)) {
+      client_mags = VG_(arena_malloc)(VG_AR_CORE, "mallocfree.gcm.2",
+                                      VG_N_THREADS * sizeof(Magazine*));
+      VG_(memset)(client_mags, 0, VG_N_THREADS * sizeof(Magazine*));
+   }
+   if (UNLIKELY(client_mags[tid] == NULL)) {
+      client_mags[tid] = VG_(arena_malloc)(VG_AR_CORE, "mallocfree.gcm.1",
+                                           MAG_N_CLASSES * sizeof(Magazine));
+      VG_(memset)(client_mags[tid], 0, MAG_N_CLASSES * sizeof(Magazine));
+   }
+   return &client_mags[tid][c];
+}
+
+static void mag_push ( Arena* a, Magazine* m, Block* b )
+{
+   SizeT b_pszB = get_pszB(a, b);
+   vg_assert(m->n_blocks < MAG_SIZE);
+   m->blocks[m->n_blocks++] = b;
+   a->stats__bytes_on_loan  -= b_pszB;
+   a->stats__bytes_cached   += b_pszB;
+   a->stats__blocks_cached++;
+}
+
+/* Fill m, which is empty, with blocks of class c carved from one
+   arena block.  Returns False if the arena is out of memory. */
+static Bool mag_refill ( Arena* a, Magazine* m, UInt c )
+{
+   SizeT  b_bszB = VG_ROUNDUP(pszB_to_bszB(a, (c+1) * MAG_GRAIN), MAG_GRAIN);
+   SizeT  big_bszB;
+   Block* big;
+   void*  v;
+   UInt   i;
+
+   vg_assert(m->n_blocks == 0);
+   if (MAG_REFILL * b_bszB >= a->min_unsplittable_sblock_szB)
+      return False;
+   v = VG_(arena_malloc)(VG_AR_CLIENT, "admin.mag-refill",
+                         MAG_REFILL * b_bszB - overhead_szB(a));
+   if (v == NULL)
+      return False;
+   INNER_REQUEST(VALGRIND_FREELIKE_BLOCK(v, 0));
+
+   big      = get_payload_block(a, v);
+   big_bszB = get_bszB(big);
+   vg_assert(big_bszB >= MAG_REFILL * b_bszB);
+   a->stats__bytes_on_loan -= bszB_to_pszB(a, big_bszB);
+   a->stats__tot_blocks--;
+   a->stats__tot_bytes     -= bszB_to_pszB(a, big_bszB);
+
+   /* Carve it up, backwards so that the blocks are handed out in
+      address order.  The last one gets any excess. */
+   for (i = MAG_REFILL; i > 0; i--) {
+      Block* b = &big[(i-1) * b_bszB];
+      mkInuseBlock(a, b, i == MAG_REFILL ? big_bszB - (i-1) * b_bszB
+                                         : b_bszB);
+      a->stats__bytes_on_loan += get_pszB(a, b);
+      if (VG_(clo_profile_heap))
+         set_cc(b, "admin.mag-1");
+      mag_push(a, m, b);
+   }
+   stats__mag_refills++;
+   return True;
+}
+
+/* Try to allocate a client block from the calling thread's magazine
+   for its size class.  Returns NULL if that cannot be done. */
+static void* mag_malloc ( Arena* a, const HChar* cc, SizeT req_pszB )
+{
+   UInt      c = (req_pszB - 1) / MAG_GRAIN;
+   Magazine* m = get_client_mag(c);
+   Block*    b;
+   SizeT     b_pszB;
+   void*     v;
+
+   if (m->n_blocks == 0 && !mag_refill(a, m, c))
+      return NULL;
+
+   b      = m->blocks[--m->n_blocks];
+   b_pszB = get_pszB(a, b);
+   vg_assert(b_pszB >= req_pszB);
+   a->stats__bytes_cached -= b_pszB;
+   a->stats__blocks_cached--;
+   add_one_block_to_stats(a, b_pszB);
+   stats__mag_hits++;
+   if (VG_(clo_profile_heap))
+      set_cc(b, cc);
+
+   v = get_block_payload(a, b);
+   INNER_REQUEST
+      (VALGRIND_MALLOCLIKE_BLOCK(v, b_pszB, a->rz_szB, False));
+   return v;
+}
+
+/* Put the client block b into the calling thread's magazine for its
+   size class, if it has one.  Returns False if it does not. */
+static Bool mag_free ( Arena* a, Block* b )
+{
+   SizeT     b_pszB = get_pszB(a, b);
+   Magazine* m;
+   UInt      i;
+
+   if (b_pszB < MAG_GRAIN || b_pszB > MAG_MAX_PSZB + MAG_GRAIN - 1)
+      return False;
+   m = get_client_mag(b_pszB / MAG_GRAIN - 1);
+
+   if (m->n_blocks == MAG_SIZE) {
+      /* Full: give the oldest half back to the arena. */
+      for (i = 0; i < MAG_REFILL; i++) {
+         Block* old = m->blocks[i];
+         SizeT  old_pszB = get_pszB(a, old);
+         a->stats__bytes_cached  -= old_pszB;
+         a->stats__blocks_cached--;
+         a->stats__bytes_on_loan += old_pszB;
+         arena_free_block(VG_AR_CLIENT, a, get_block_payload(a, old));
+      }
+      for (i = MAG_REFILL; i < MAG_SIZE; i++)
+         m->blocks[i - MAG_REFILL] = m->blocks[i];
+      m->n_blocks -= MAG_REFILL;
+      stats__mag_flushes++;
+   }
+
+   INNER_REQUEST(VALGRIND_FREELIKE_BLOCK(get_block_payload(a, b), 0));
+   if (VG_(clo_profile_heap))
+      set_cc(b, "admin.mag-1");
+   mag_push(a, m, b);
+   return True;
+}
+
+/* Is b sitting in some thread's magazine, i.e. freed by the client? */
+static Bool is_mag_block ( Arena* a, Block* b )
+{
+   SizeT b_pszB = get_pszB(a, b);
+   UInt  c, i, tid;
+
+   if (client_mags == NULL
+       || b_pszB < MAG_GRAIN || b_pszB > MAG_MAX_PSZB + MAG_GRAIN - 1)
+      return False;
+   c = b_pszB / MAG_GRAIN - 1;
+   for (tid = 0; tid < VG_N_THREADS; tid++) {
+      Magazine* m = client_mags[tid] ? &client_mags[tid][c] : NULL;
+      for (i = 0; m != NULL && i < m->n_blocks; i++)
+         if (m->blocks[i] == b)
+            return True;
+   }
+   return False;
+}
+
+
+/*------------------------------------------------------------*/
+/*--- Slabs of small client blocks (--malloc-slabs=yes)     ---*/
+/*------------------------------------------------------------*/
+
+/* Every arena block carries a header and two redzones, which for a
+   16-byte client block is several times the block itself.  With
+   --malloc-slabs=yes, small client blocks are instead carved out of
+   SLAB_SZB-sized, SLAB_SZB-aligned slabs, each holding blocks of one
+   size class only:
+
+      | rz | slot 0 | rz | slot 1 | rz | ... | slot n-1 | rz | slack |
+
+   So each block costs one redzone, shared with its neighbours, and
+   nothing else.  Which slots are in use is recorded in a bitmap that
+   lives, with the rest of the slab's metadata, in a Slab allocated in
+   the core arena; none of it is inside the slab.  A slab is found from
+   any address in it through a hash table keyed by the address divided
+   by SLAB_SZB.
+
+   A slab is itself an arena block.  Its free slots count as cached
+   (see stats__bytes_cached), and its redzones and slack as slab
+   admin, so neither is on loan. */
+#define SLAB_SZB        (64 * 1024)
+#define SLAB_N_CLASSES  8
+#define SLAB_MAX_PSZB   (SLAB_N_CLASSES * VG_MIN_MALLOC_SZB)
+#define SLAB_MAX_SLOTS  (SLAB_SZB / VG_MIN_MALLOC_SZB)
+#define SLAB_BITS       (8 * sizeof(UWord))
+
+typedef
+   struct _Slab {
+      struct _Slab* hash_next;
+      struct _Slab* prev;     // in slabs_free[c], if on_list
+      struct _Slab* next;
+      Addr   base;            // SLAB_SZB-aligned start
+      SizeT  arena_pszB;      // payload size of the arena block
+      UInt   c;               // size class
+      UInt   n_slots;
+      UInt   n_free;
+      UInt   hint;            // a bitmap word that may have a free slot
+      Bool   on_list;
+      UWord  in_use[0];       // one bit per slot
+   }
+   Slab;
+
+// For each class, the slabs that have a free slot.
+static Slab*  slabs_free[SLAB_N_CLASSES];
+
+// Hash table of all slabs.  Its size is a power of 2.
+static Slab** slab_table       = NULL;
+static UWord  slab_table_size  = 0;
+
+
+static __inline__ SizeT slab_rz_szB ( Arena* a )
+{
+   return VG_ROUNDUP(a->rz_szB, VG_MIN_MALLOC_SZB);
+}
+
+static __inline__ SizeT slab_pszB ( Slab* s )
+{
+   return (s->c + 1) * VG_MIN_MALLOC_SZB;
+}
+
+static __inline__ SizeT slab_stride ( Arena* a, Slab* s )
+{
+   return slab_pszB(s) + slab_rz_szB(a);
+}
+
+static __inline__ UByte* slab_slot_payload ( Arena* a, Slab* s, UInt i )
+{
+   return (UByte*)(s->base + slab_rz_szB(a) + i * slab_stride(a, s));
+}
+
+static __inline__ Bool slab_slot_in_use ( Slab* s, UInt i )
+{
+   return (s->in_use[i / SLAB_BITS] >> (i % SLAB_BITS)) & 1;
+}
+
+static __inline__ UWord slab_hash ( Addr p )
+{
+   return (p / SLAB_SZB) & (slab_table_size - 1);
+}
+
+/* The slab containing p, or NULL. */
+static Slab* find_slab ( Addr p )
+{
+   Slab* s;
+   if (slab_n_slabs == 0)
+      return NULL;
+   for (s = slab_table[slab_hash(p)]; s != NULL; s = s->hash_next)
+      if (s->base == (p & ~(Addr)(SLAB_SZB-1)))
+         return s;
+   return NULL;
+}
+
+static void slab_table_add ( Slab* s )
+{
+   UWord h;
+
+   if (slab_n_slabs >= slab_table_size) {
+      /* Double the table, or make the first one. */
+      UWord  old_size  = slab_table_size;
+      Slab** old_table = slab_table;
+      UWord  i;
+
+      slab_table_size = old_size == 0 ? 256 : 2 * old_size;
+      slab_table = VG_(arena_malloc)(VG_AR_CORE, "mallocfree.sta.1",
+                                     slab_table_size * sizeof(Slab*));
+      VG_(memset)(slab_table, 0, slab_table_size * sizeof(Slab*));
+      for (i = 0; i < old_size; i++) {
+         while (old_table[i] != NULL) {
+            Slab* t = old_table[i];
+            old_table[i] = t->hash_next;
+            h = slab_hash(t->base);
+            t->hash_next = slab_table[h];
+            slab_table[h] = t;
+         }
+      }
+      if (old_table != NULL)
+         VG_(arena_free)(VG_AR_CORE, old_table);
+   }
+
+   h = slab_hash(s->base);
+   s->hash_next = slab_table[h];
+   slab_table[h] = s;
+   slab_n_slabs++;
+}
+
+static void slab_table_remove ( Slab* s )
+{
+   Slab** sp = &slab_table[slab_hash(s->base)];
+   while (*sp != s) {
+      vg_assert(*sp != NULL);
+      sp = &(*sp)->hash_next;
+   }
+   *sp = s->hash_next;
+   slab_n_slabs--;
+}
+
+static void slab_list_add ( Slab* s )
+{
+   vg_assert(!s->on_list);
+   s->prev = NULL;
+   s->next = slabs_free[s->c];
+   if (s->next != NULL)
+      s->next->prev = s;
+   slabs_free[s->c] = s;
+   s->on_list = True;
+}
+
+static void slab_list_remove ( Slab* s )
+{
+   vg_assert(s->on_list);
+   if (s->prev != NULL)
+      s->prev->next = s->next;
+   else
+      slabs_free[s->c] = s->next;
+   if (s->next != NULL)
+      s->next->prev = s->prev;
+   s->on_list = False;
+}
+
+/* Make a new, empty slab for class c.  Returns NULL if the arena is
+   out of memory. */
+static Slab* new_slab ( Arena* a, UInt c )
+{
+   SizeT pszB = (c + 1) * VG_MIN_MALLOC_SZB;
+   UInt  n_slots = (SLAB_SZB - slab_rz_szB(a)) / (pszB + slab_rz_szB(a));
+   UInt  n_words = (n_slots + SLAB_BITS - 1) / SLAB_BITS;
+   SizeT free_szB;
+   Slab* s;
+   void* v;
+
+   if (n_slots < 2)
+      return NULL;   // Huge redzones: slabs would not save anything.
+   v = VG_(arena_memalign)(VG_AR_CLIENT, "admin.slab", SLAB_SZB, SLAB_SZB);
+   if (v == NULL)
+      return NULL;
+   /* memalign leaves any excess at the end of the block: cut it off. */
+   VG_(arena_realloc_shrink)(VG_AR_CLIENT, v, SLAB_SZB);
+   INNER_REQUEST(VALGRIND_FREELIKE_BLOCK(v, 0));
+
+   s = VG_(arena_malloc)(VG_AR_CORE, "mallocfree.ns.1",
+                         sizeof(Slab) + n_words * sizeof(UWord));
+   VG_(memset)(s, 0, sizeof(Slab) + n_words * sizeof(UWord));
+   s->base       = (Addr)v;
+   s->arena_pszB = get_pszB(a, get_payload_block(a, v));
+   s->c          = c;
+   s->n_slots    = n_slots;
+   s->n_free     = n_slots;
+   /* Mark the bits past the last slot as in use, so they are never
+      picked. */
+   if (n_slots % SLAB_BITS != 0)
+      s->in_use[n_words-1] = ~(UWord)0 << (n_slots % SLAB_BITS);
+
+   /* Move the whole block from on loan to cached and admin. */
+   free_szB = n_slots * pszB;
+   a->stats__bytes_on_loan    -= s->arena_pszB;
+   a->stats__tot_blocks--;
+   a->stats__tot_bytes        -= s->arena_pszB;
+   a->stats__bytes_cached     += free_szB;
+   a->stats__blocks_cached    += n_slots;
+   a->stats__bytes_slab_admin += s->arena_pszB - free_szB;
+
+   slab_table_add(s);
+   slab_list_add(s);
+   stats__slab_news++;
+   return s;
+}
+
+/* Give the empty slab s back to the arena. */
+static void release_slab ( Arena* a, Slab* s )
+{
+   SizeT free_szB = s->n_slots * slab_pszB(s);
+
+   vg_assert(s->n_free == s->n_slots);
+   if (s->on_list)
+      slab_list_remove(s);
+   slab_table_remove(s);
+
+   a->stats__bytes_cached     -= free_szB;
+   a->stats__blocks_cached    -= s->n_slots;
+   a->stats__bytes_slab_admin -= s->arena_pszB - free_szB;
+   a->stats__bytes_on_loan    += s->arena_pszB;
+   arena_free_block(VG_AR_CLIENT, a, (void*)s->base);
+
+   VG_(arena_free)(VG_AR_CORE, s);
+   stats__slab_releases++;
+}
+
+/* If a is in a client slab, describe it in *aai as being in (or in
+   the redzone before) the nearest slot, and return True. */
+static Bool describe_slab_addr ( Addr a, AddrArenaInfo* aai )
+{
+   Arena* arena = arenaId_to_ArenaP(VG_AR_CLIENT);
+   Slab*  s     = find_slab(a);
+   UInt   i;
+
+   if (s == NULL)
+      return False;
+   i = (a - s->base) / slab_stride(arena, s);
+   if (i >= s->n_slots)
+      i = s->n_slots - 1;   // in the slack at the end
+   aai->aid       = VG_AR_CLIENT;
+   aai->name      = arena->name;
+   aai->block_szB = slab_pszB(s);
+   aai->rwoffset  = a - (Addr)slab_slot_payload(arena, s, i);
+   aai->free      = !slab_slot_in_use(s, i);
+   return True;
+}
+
+/* Check that each slab's bitmap, free count and list membership agree,
+   and that the slabs account for what the arena thinks they do. */
+static void sanity_check_slabs ( void )
+{
+   Arena* a = arenaId_to_ArenaP(VG_AR_CLIENT);
+   UWord  h, n_slabs = 0;
+   SizeT free_szB = 0, admin_szB = 0;
+   UInt  c;
+
+   for (h = 0; h < slab_table_size; h++) {
+      Slab* s;
+      for (s = slab_table[h]; s != NULL; s = s->hash_next) {
+         UInt i, n_in_use = 0;
+         for (i = 0; i < s->n_slots; i++)
+            if (slab_slot_in_use(s, i))
+               n_in_use++;
+         if (n_in_use + s->n_free != s->n_slots
+             || s->on_list != (s->n_free > 0)
+             || slab_hash(s->base) != h) {
+            VG_(printf)("sanity_check_slabs: slab %#lx (class %u): "
+                        "%u in use, %u free, %u slots: BAD\n",
+                        s->base, s->c, n_in_use, s->n_free, s->n_slots);
+            VG_(core_panic)("sanity_check_slabs");
+         }
+         n_slabs++;
+         free_szB  += s->n_free * slab_pszB(s);
+         admin_szB += s->arena_pszB - s->n_slots * slab_pszB(s);
+      }
+   }
+   for (c = 0; c < SLAB_N_CLASSES; c++) {
+      Slab* s;
+      for (s = slabs_free[c]; s != NULL; s = s->next)
+         vg_assert(s->on_list && s->c == c && s->n_free > 0);
+   }
+   if (n_slabs != slab_n_slabs
+       || admin_szB != a->stats__bytes_slab_admin
+       || free_szB > a->stats__bytes_cached) {
+      VG_(printf)("sanity_check_slabs: %lu/%lu slabs, %lu/%lu admin bytes, "
+                  "%lu/%lu free bytes: MISMATCH\n",
+                  n_slabs, slab_n_slabs, admin_szB, a->stats__bytes_slab_admin,
+                  free_szB, a->stats__bytes_cached);
+      VG_(core_panic)("sanity_check_slabs");
+   }
+}
+
+/* Allocate a client block of req_pszB bytes from a slab.  Returns NULL
+   if that cannot be done. */
+static void* slab_malloc ( Arena* a, SizeT req_pszB )
+{
+   UInt   c = req_pszB == 0 ? 0 : (req_pszB - 1) / VG_MIN_MALLOC_SZB;
+   Slab*  s = slabs_free[c];
+   UInt   w, i;
+   UWord  bits;
+   UByte* v;
+
+   if (s == NULL) {
+      s = new_slab(a, c);
+      if (s == NULL)
+         return NULL;
+   }
+   vg_assert(s->n_free > 0);
+
+   /* Find a clear bit, starting at the hint. */
+   w = s->hint;
+   while (s->in_use[w] == ~(UWord)0)
+      w = (w + 1) % ((s->n_slots + SLAB_BITS - 1) / SLAB_BITS);
+   bits = s->in_use[w];
+   for (i = 0; (bits >> i) & 1; i++)
+      ;
+   i += w * SLAB_BITS;
+   vg_assert(i < s->n_slots);
+
+   s->in_use[w] |= (UWord)1 << (i % SLAB_BITS);
+   s->hint = w;
+   s->n_free--;
+   if (s->n_free == 0)
+      slab_list_remove(s);
+
+   a->stats__bytes_cached -= slab_pszB(s);
+   a->stats__blocks_cached--;
+   add_one_block_to_stats(a, slab_pszB(s));
+
+   v = slab_slot_payload(a, s, i);
+   INNER_REQUEST
+      (VALGRIND_MALLOCLIKE_BLOCK(v, slab_pszB(s), a->rz_szB, False));
+   return v;
+}
+
+/* Free the client block ptr, which is in slab s. */
+static void slab_free ( Arena* a, Slab* s, void* ptr )
+{
+   SizeT off = (Addr)ptr - s->base - slab_rz_szB(a);
+   UInt  i   = off / slab_stride(a, s);
+
+   vg_assert(off % slab_stride(a, s) == 0 && i < s->n_slots);
+   vg_assert(slab_slot_in_use(s, i));
+
+   INNER_REQUEST(VALGRIND_FREELIKE_BLOCK(ptr, 0));
+   s->in_use[i / SLAB_BITS] &= ~((UWord)1 << (i % SLAB_BITS));
+   s->hint = i / SLAB_BITS;
+   s->n_free++;
+
+   a->stats__bytes_on_loan -= slab_pszB(s);
+   a->stats__bytes_cached  += slab_pszB(s);
+   a->stats__blocks_cached++;
+
+   if (s->n_free == 1)
+      slab_list_add(s);
+   /* Keep an empty slab only if it is the only one with free slots
+      for its class, so as not to thrash on a single block. */
+   if (s->n_free == s->n_slots
+       && (slabs_free[s->c] != s || s->next != NULL))
+      release_slab(a, s);
+}
+
 /* Allocate a piece of memory of req_pszB bytes on the given arena.
    The function may return NULL if (and only if) aid == VG_AR_CLIENT.
    Otherwise, the function returns a non-NULL value. */
-void* VG_(arena_malloc) ( ArenaId aid, const HChar* cc, SizeT req_pszB )
+static void* arena_malloc_WRK ( ArenaId aid, const HChar* cc, SizeT req_pszB )
 {
    SizeT       req_bszB, frag_bszB, b_bszB;
    UInt        lno, i;
@@ -1690,13 +2336,29 @@ void* VG_(arena_malloc) ( ArenaId aid, const HChar* cc, SizeT req_pszB )
    a = arenaId_to_ArenaP(aid);
 
    vg_assert(req_pszB < MAX_PSZB);
-   req_pszB = align_req_pszB(req_pszB);
-   req_bszB = pszB_to_bszB(a, req_pszB);
 
    // You must provide a cost-center name against which to charge
    // this allocation; it isn't optional.
    vg_assert(cc);
 
+   if (aid == VG_AR_CLIENT && VG_(clo_malloc_slabs)
+       && req_pszB <= SLAB_MAX_PSZB) {
+      v = slab_malloc(a, req_pszB);
+      if (v != NULL)
+         return v;
+   }
+
+   // Zero-sized blocks are left to the arena proper, which gives them no
+   // payload at all, rather than the 16 bytes of the smallest class.
+   if (aid == VG_AR_CLIENT && req_pszB > 0 && req_pszB <= MAG_MAX_PSZB) {
+      v = mag_malloc(a, cc, req_pszB);
+      if (v != NULL)
+         return v;
+   }
+
+   req_pszB = align_req_pszB(req_pszB);
+   req_bszB = pszB_to_bszB(a, req_pszB);
+
    // Scan through all the big-enough freelists for a block.
    //
    // Nb: this scanning might be expensive in some cases.  Eg. if you
@@ -1716,7 +2378,10 @@ void* VG_(arena_malloc) ( ArenaId aid, const HChar* cc, SizeT req_pszB )
    // back.  This would require care to avoid pathological worst-case
    // behaviour.
    //
-   for (lno = pszB_to_listNo(req_pszB); lno < N_MALLOC_LISTS; lno++) {
+   // A block to be guarded always gets a new superblock.
+   lno = needs_guards(a, req_pszB) ? N_MALLOC_LISTS
+                                   : pszB_to_listNo(req_pszB);
+   for (; lno < N_MALLOC_LISTS; lno++) {
       UWord nsearches_this_level = 0;
       b = a->freelist[lno];
       if (NULL == b) continue;   // If this list is empty, try the next one.
@@ -2024,13 +2689,9 @@ static void mergeWithFreeNeighbours (Arena* a, Superblock* sb,
    }
 }
  
-void VG_(arena_free) ( ArenaId aid, void* ptr )
+static void arena_free_WRK ( ArenaId aid, void* ptr )
 {
-   Superblock* sb;
-   Block*      b;
-   SizeT       b_bszB, b_pszB;
-   UInt        b_listno;
-   Arena*      a;
+   Arena* a;
 
    ensure_mm_init(aid);
    a = arenaId_to_ArenaP(aid);
@@ -2038,7 +2699,27 @@ void VG_(arena_free) ( ArenaId aid, void* ptr )
    if (ptr == NULL) {
       return;
    }
-      
+
+   if (aid == VG_AR_CLIENT) {
+      Slab* s = find_slab((Addr)ptr);
+      if (s != NULL) {
+         slab_free(a, s, ptr);
+         return;
+      }
+      if (mag_free(a, get_payload_block(a, ptr)))
+         return;
+   }
+
+   arena_free_block(aid, a, ptr);
+}
+
+static void arena_free_block ( ArenaId aid, Arena* a, void* ptr )
+{
+   Superblock* sb;
+   Block*      b;
+   SizeT       b_bszB, b_pszB;
+   UInt        b_listno;
+
    b = get_payload_block(a, ptr);
 
    /* If this is one of V's areas, check carefully the block we're
@@ -2148,8 +2829,8 @@ void VG_(arena_free) ( ArenaId aid, void* ptr )
    .    .               .   .   .               .   .
 
 */
-void* VG_(arena_memalign) ( ArenaId aid, const HChar* cc, 
-                            SizeT req_alignB, SizeT req_pszB )
+static void* arena_memalign_WRK ( ArenaId aid, const HChar* cc, 
+                                   SizeT req_alignB, SizeT req_pszB )
 {
    SizeT  base_pszB_req, base_pszB_act, frag_bszB;
    Block  *base_b, *align_b;
@@ -2198,8 +2879,10 @@ void* VG_(arena_memalign) ( ArenaId aid, const HChar* cc,
       const SizeT save_min_unsplittable_sblock_szB 
          = a->min_unsplittable_sblock_szB;
       a->min_unsplittable_sblock_szB = MAX_PSZB;
+      a->guards_suspended = True;
       base_p = VG_(arena_malloc) ( aid, cc, base_pszB_req );
       a->min_unsplittable_sblock_szB = save_min_unsplittable_sblock_szB;
+      a->guards_suspended = False;
    }
    a->stats__bytes_on_loan = saved_bytes_on_loan;
 
@@ -2270,10 +2953,16 @@ void* VG_(arena_memalign) ( ArenaId aid, const HChar* cc,
 }
 
 
-SizeT VG_(arena_malloc_usable_size) ( ArenaId aid, void* ptr )
+static SizeT arena_malloc_usable_size_WRK ( ArenaId aid, void* ptr )
 {
    Arena* a = arenaId_to_ArenaP(aid);
-   Block* b = get_payload_block(a, ptr);
+   Block* b;
+   if (aid == VG_AR_CLIENT) {
+      Slab* s = find_slab((Addr)ptr);
+      if (s != NULL)
+         return slab_pszB(s);
+   }
+   b = get_payload_block(a, ptr);
    return get_pszB(a, b);
 }
 
@@ -2324,17 +3013,19 @@ void VG_(mallinfo) ( ThreadId tid, struct vg_mallinfo* mi )
       }
    }
 
-   // We don't have fastbins so smblks & fsmblks are always 0. Also we don't
-   // have a separate mmap allocator so set hblks & hblkhd to 0.
+   // The per-thread magazines and the free slots of the slabs stand in
+   // for fastbins, and the slabs' redzones for block headers.  We don't
+   // have a separate mmap allocator so set hblks to 0.
    mi->arena    = a->stats__bytes_mmaped;
    mi->ordblks  = free_blocks + VG_(free_queue_length);
-   mi->smblks   = 0;
+   mi->smblks   = a->stats__blocks_cached;
    mi->hblks    = 0;
-   mi->hblkhd   = 0;
+   mi->hblkhd   = a->stats__bytes_slab_admin;
    mi->usmblks  = 0;
-   mi->fsmblks  = 0;
+   mi->fsmblks  = a->stats__bytes_cached;
    mi->uordblks = a->stats__bytes_on_loan - VG_(free_queue_volume);
-   mi->fordblks = free_blocks_size + VG_(free_queue_volume);
+   mi->fordblks = free_blocks_size + a->stats__bytes_cached
+                  + VG_(free_queue_volume);
    mi->keepcost = 0; // may want some value in here
 }
 
@@ -2391,11 +3082,15 @@ void* VG_(arena_realloc) ( ArenaId aid, const HChar* cc,
       return NULL;
    }
 
-   b = get_payload_block(a, ptr);
-   vg_assert(blockSane(a, b));
+   if (aid == VG_AR_CLIENT && find_slab((Addr)ptr) != NULL) {
+      old_pszB = VG_(arena_malloc_usable_size)(aid, ptr);
+   } else {
+      b = get_payload_block(a, ptr);
+      vg_assert(blockSane(a, b));
 
-   vg_assert(is_inuse_block(b));
-   old_pszB = get_pszB(a, b);
+      vg_assert(is_inuse_block(b));
+      old_pszB = get_pszB(a, b);
+   }
 
    if (req_pszB <= old_pszB) {
       return ptr;
@@ -2411,8 +3106,8 @@ void* VG_(arena_realloc) ( ArenaId aid, const HChar* cc,
 }
 
 
-void VG_(arena_realloc_shrink) ( ArenaId aid,
-                                 void* ptr, SizeT req_pszB )
+static void arena_realloc_shrink_WRK ( ArenaId aid,
+                                       void* ptr, SizeT req_pszB )
 {
    SizeT  req_bszB, frag_bszB, b_bszB;
    Superblock* sb;
@@ -2445,7 +3140,9 @@ void VG_(arena_realloc_shrink) ( ArenaId aid,
                           + sizeof(Superblock) + pszB_to_bszB(a, req_pszB));
       frag_bszB = (Addr)sb_end - frag + 1;
       
-      if (frag_bszB >= VKI_PAGE_SIZE) {
+      // A guarded superblock keeps its size, so that it can be unmapped
+      // together with its guard pages.
+      if (frag_bszB >= VKI_PAGE_SIZE && !arena_is_guarded(a)) {
          SysRes sres;
          
          a->stats__bytes_on_loan -= old_pszB;
@@ -2537,7 +3234,7 @@ __inline__ HChar* VG_(arena_strdup) ( ArenaId aid, const HChar* cc,
    return res;
 }
 
-void* VG_(arena_perm_malloc) ( ArenaId aid, SizeT size, Int align  )
+static void* arena_perm_malloc_WRK ( ArenaId aid, SizeT size, Int align  )
 {
    Arena*      a;
 
@@ -2568,6 +3265,66 @@ void* VG_(arena_perm_malloc) ( ArenaId aid, SizeT size, Int align  )
    return (void*)(a->perm_malloc_current - size);
 }
 
+/*------------------------------------------------------------*/
+/*--- Core-visible entry points.                           ---*/
+/*------------------------------------------------------------*/
+
+// The arenas are shared by the threads of VG_(run_workers), so the
+// entry points which change them take the worker lock.  The others
+// are built from these.
+
+void* VG_(arena_malloc) ( ArenaId aid, const HChar* cc, SizeT req_pszB )
+{
+   void* v;
+   VG_(acquire_worker_lock)();
+   v = arena_malloc_WRK(aid, cc, req_pszB);
+   VG_(release_worker_lock)();
+   return v;
+}
+
+void VG_(arena_free) ( ArenaId aid, void* ptr )
+{
+   VG_(acquire_worker_lock)();
+   arena_free_WRK(aid, ptr);
+   VG_(release_worker_lock)();
+}
+
+void* VG_(arena_memalign) ( ArenaId aid, const HChar* cc, 
+                            SizeT req_alignB, SizeT req_pszB )
+{
+   void* v;
+   VG_(acquire_worker_lock)();
+   v = arena_memalign_WRK(aid, cc, req_alignB, req_pszB);
+   VG_(release_worker_lock)();
+   return v;
+}
+
+SizeT VG_(arena_malloc_usable_size) ( ArenaId aid, void* ptr )
+{
+   SizeT szB;
+   VG_(acquire_worker_lock)();
+   szB = arena_malloc_usable_size_WRK(aid, ptr);
+   VG_(release_worker_lock)();
+   return szB;
+}
+
+void VG_(arena_realloc_shrink) ( ArenaId aid,
+                                 void* ptr, SizeT req_pszB )
+{
+   VG_(acquire_worker_lock)();
+   arena_realloc_shrink_WRK(aid, ptr, req_pszB);
+   VG_(release_worker_lock)();
+}
+
+void* VG_(arena_perm_malloc) ( ArenaId aid, SizeT size, Int align  )
+{
+   void* v;
+   VG_(acquire_worker_lock)();
+   v = arena_perm_malloc_WRK(aid, size, align);
+   VG_(release_worker_lock)();
+   return v;
+}
+
 /*------------------------------------------------------------*/
 /*--- Tool-visible functions.                              ---*/
 /*------------------------------------------------------------*/
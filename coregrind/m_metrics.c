@@ -0,0 +1,174 @@
+
+/*--------------------------------------------------------------------*/
+/*--- Counters describing a running Valgrind.          m_metrics.c ---*/
+/*--------------------------------------------------------------------*/
+
+/*
+   This file is part of Valgrind, a dynamic binary instrumentation
+   framework.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of the
+   License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+   02111-1307, USA.
+
+   The GNU General Public License is contained in the file COPYING.
+*/
+
+#include "pub_core_basics.h"
+#include "pub_core_vki.h"
+#include "pub_core_aspacemgr.h"
+#include "pub_core_errormgr.h"
+#include "pub_core_execontext.h"
+#include "pub_core_libcassert.h"
+#include "pub_core_libcbase.h"
+#include "pub_core_libcfile.h"
+#include "pub_core_libcprint.h"
+#include "pub_core_libcproc.h"
+#include "pub_core_mallocfree.h"
+#include "pub_core_options.h"
+#include "pub_core_libcsetjmp.h"    // to keep _threadstate.h happy
+#include "pub_core_threadstate.h"
+#include "pub_core_scheduler.h"
+#include "pub_core_syscall.h"       // VG_(strerror)
+#include "pub_core_tooliface.h"
+#include "pub_core_transtab.h"
+#include "pub_core_translate.h"
+#include "pub_core_xarray.h"
+#include "pub_core_metrics.h"       // self
+
+/* See pub_core_metrics.h for the format.  Version of the format: */
+#define METRICS_VERSION 1
+
+/* VG_(read_millisecond_timer) when the client started to run. */
+static UInt startup_ms = 0;
+
+void VG_(metrics_startup_done) ( void )
+{
+   startup_ms = VG_(read_millisecond_timer)();
+}
+
+/* The peak resident set size of the process, in KB, or 0 if it can't be
+   found out. */
+static ULong peak_rss_kb ( void )
+{
+#  if defined(VGO_linux)
+   HChar  buf[2048];
+   HChar* p;
+   Int    n;
+   SysRes sres = VG_(open)("/proc/self/status", VKI_O_RDONLY, 0);
+   if (sr_isError(sres))
+      return 0;
+   n = VG_(read)(sr_Res(sres), buf, sizeof(buf) - 1);
+   VG_(close)(sr_Res(sres));
+   if (n <= 0)
+      return 0;
+   buf[n] = 0;
+   p = VG_(strstr)(buf, "VmHWM:");
+   return p ? VG_(strtoull10)(p + 6, NULL) : 0;
+#  else
+   return 0;
+#  endif
+}
+
+/* Give all the metrics, core ones first, to put. */
+static void get_metrics ( void (*put)(const HChar* name, ULong value) )
+{
+   put("metrics", METRICS_VERSION);
+   put("time_ms", VG_(read_millisecond_timer)());
+   put("startup_ms", startup_ms);
+   put("rss.peak_kb", peak_rss_kb());
+   put("threads", VG_(count_living_threads)());
+   VG_(scheduler_metrics)(put);
+   VG_(tt_tc_metrics)(put);
+   VG_(jit_metrics)(put);
+   VG_(errormgr_metrics)(put);
+   put("execontexts", VG_(get_n_ExeContexts)());
+   put("aspacemgr.anon_bytes", VG_(am_get_anonsize_total)());
+   VG_(arena_metrics)(put);
+   if (VG_(needs).metrics)
+      VG_TDICT_CALL(tool_metrics, put);
+}
+
+static void put_with_printf ( const HChar* name, ULong value )
+{
+   VG_(printf)("%s %llu\n", name, value);
+}
+
+void VG_(print_metrics) ( void )
+{
+   get_metrics(put_with_printf);
+}
+
+/* The --metrics-file contents, while being made. */
+static XArray* metrics_text = NULL;
+
+static void put_in_metrics_text ( const HChar* name, ULong value )
+{
+   VG_(xaprintf)(metrics_text, "%s %llu\n", name, value);
+}
+
+/* VG_(read_millisecond_timer) when the metrics are to be written
+   next, 0 to write them at the first opportunity. */
+static UInt next_write_ms = 0;
+
+void VG_(maybe_write_metrics) ( Bool final )
+{
+   UInt   now;
+   HChar* fname;
+   HChar* tmp_fname;
+   SysRes sres;
+
+   if (VG_(clo_metrics_fname) == NULL)
+      return;
+   now = VG_(read_millisecond_timer)();
+   if (!final && now < next_write_ms)
+      return;
+   next_write_ms = now + 1000 * VG_(clo_metrics_interval);
+
+   if (metrics_text == NULL)
+      metrics_text = VG_(newXA)(VG_(malloc), "metrics.text", VG_(free),
+                                sizeof(HChar));
+   VG_(dropTailXA)(metrics_text, VG_(sizeXA)(metrics_text));
+   get_metrics(put_in_metrics_text);
+
+   /* Write the metrics in a temporary file renamed to the metrics file,
+      so that whoever reads it never sees a partial snapshot.  The name
+      is expanded each time, so that after a fork, a --metrics-file
+      containing %p gives the child its own file. */
+   fname = VG_(expand_file_name)("--metrics-file", VG_(clo_metrics_fname));
+   tmp_fname = VG_(malloc)("metrics.tmp_fname", VG_(strlen)(fname) + 5);
+   VG_(sprintf)(tmp_fname, "%s.tmp", fname);
+   sres = VG_(open)(tmp_fname, VKI_O_CREAT|VKI_O_WRONLY|VKI_O_TRUNC,
+                    VKI_S_IRUSR|VKI_S_IWUSR);
+   if (sr_isError(sres)) {
+      VG_(umsg)("Warning: can't create metrics file '%s': %s\n",
+                tmp_fname, VG_(strerror)(sr_Err(sres)));
+      /* Don't try again. */
+      VG_(clo_metrics_fname) = NULL;
+   } else {
+      Int fd = sr_Res(sres);
+      Word len = VG_(sizeXA)(metrics_text);
+      Bool ok = len == 0
+                || VG_(write)(fd, VG_(indexXA)(metrics_text, 0), len) == len;
+      VG_(close)(fd);
+      if (ok)
+         VG_(rename)(tmp_fname, fname);
+   }
+   VG_(free)(tmp_fname);
+   VG_(free)(fname);
+}
+
+/*--------------------------------------------------------------------*/
+/*--- end                                                          ---*/
+/*--------------------------------------------------------------------*/
@@ -74,8 +74,19 @@ Bool   VG_(clo_trace_children) = False;
 const HChar* VG_(clo_trace_children_skip) = NULL;
 const HChar* VG_(clo_trace_children_skip_by_arg) = NULL;
 Bool   VG_(clo_child_silent_after_fork) = False;
+Int    VG_(clo_fork_server_fd) = -1;
+Bool   VG_(clo_fast_forward) = False;
+Long   VG_(clo_fast_forward_bbs) = 0;
+const HChar* VG_(clo_fast_forward_fn) = NULL;
+const HChar* VG_(clo_skip_instrument) = NULL;
+const HChar* VG_(clo_instrument_only) = NULL;
 HChar* VG_(clo_log_fname_expanded) = NULL;
 HChar* VG_(clo_xml_fname_expanded) = NULL;
+Int    VG_(clo_output_buffer_size) = 64 * 1024;
+Bool   VG_(clo_output_socket_drop) = False;
+const HChar* VG_(clo_metrics_fname) = NULL;
+Int    VG_(clo_metrics_interval) = 10;
+Bool   VG_(clo_xml_stack_refs) = False;
 Bool   VG_(clo_time_stamp)     = False;
 Int    VG_(clo_input_fd)       = 0; /* stdin */
 Bool   VG_(clo_default_supp)   = True;
@@ -90,6 +101,9 @@ UChar  VG_(clo_trace_flags)    = 0; // 00000000b
 Bool   VG_(clo_profyle_sbs)    = False;
 UChar  VG_(clo_profyle_flags)  = 0; // 00000000b
 ULong  VG_(clo_profyle_interval) = 0;
+UInt   VG_(clo_profile_sample) = 0;
+Bool   VG_(clo_perf_counters) = False;
+Bool   VG_(clo_perf_map)      = False;
 Int    VG_(clo_trace_notbelow) = -1;  // unspecified
 Int    VG_(clo_trace_notabove) = -1;  // unspecified
 Bool   VG_(clo_trace_syscalls) = False;
@@ -103,12 +117,18 @@ Bool   VG_(clo_debug_dump_frames) = False;
 Bool   VG_(clo_trace_redir)    = False;
 enum FairSchedType
        VG_(clo_fair_sched)     = disable_fair_sched;
+Bool   VG_(clo_parallel_threads) = False;
+Bool   VG_(clo_adaptive_quantum) = False;
+Bool   VG_(clo_sched_affinity) = False;
 Bool   VG_(clo_trace_sched)    = False;
 Bool   VG_(clo_profile_heap)   = False;
+Bool   VG_(clo_profile_jit)    = False;
 Int    VG_(clo_core_redzone_size) = CORE_REDZONE_DEFAULT_SZB;
 // A value != -1 overrides the tool-specific value
 // VG_(needs_malloc_replacement).tool_client_redzone_szB
 Int    VG_(clo_redzone_size)   = -1;
+Bool   VG_(clo_malloc_slabs)   = False;
+SizeT  VG_(clo_guard_pages_above) = 0;
 Int    VG_(clo_dump_error)     = 0;
 Int    VG_(clo_backtrace_size) = 12;
 Int    VG_(clo_merge_recursive_frames) = 0; // default value: no merge
@@ -116,6 +136,10 @@ UInt   VG_(clo_sim_hints)      = 0;
 Bool   VG_(clo_sym_offsets)    = False;
 Bool   VG_(clo_read_inline_info) = False; // Or should be put it to True by default ???
 Bool   VG_(clo_read_var_info)  = False;
+Bool   VG_(clo_lazy_debuginfo) = False;
+Int    VG_(clo_debuginfo_threads) = 1;
+const HChar* VG_(clo_debuginfo_cache) = NULL;
+Int    VG_(clo_debuginfo_image_cache) = 128;
 Int    VG_(clo_n_req_tsyms)    = 0;
 const HChar* VG_(clo_req_tsyms)[VG_CLO_MAX_REQ_TSYMS];
 HChar* VG_(clo_require_text_symbol) = NULL;
@@ -130,8 +154,15 @@ VgSmc  VG_(clo_smc_check)      = Vg_SmcStack;
 UInt   VG_(clo_kernel_variant) = 0;
 Bool   VG_(clo_dsymutil)       = False;
 Bool   VG_(clo_sigill_diag)    = True;
+Bool   VG_(clo_pretranslate_successors) = False;
+const HChar* VG_(clo_pretranslate) = NULL;
+UInt   VG_(clo_tier_up_threshold) = 0;
+Bool   VG_(clo_hot_traces) = False;
+Bool   VG_(clo_hot_loops) = False;
+Bool   VG_(clo_inline_caches) = False;
 UInt   VG_(clo_unw_stack_scan_thresh) = 0; /* disabled by default */
 UInt   VG_(clo_unw_stack_scan_frames) = 5;
+Bool   VG_(clo_unw_frame_pointer) = False;
 
 
 /*====================================================================*/
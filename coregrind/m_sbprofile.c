@@ -37,6 +37,8 @@
 #include "pub_core_debuginfo.h"
 #include "pub_core_translate.h"
 #include "pub_core_options.h"
+#include "pub_core_hashtable.h"
+#include "pub_core_mallocfree.h"
 #include "pub_core_sbprofile.h"    // self
 
 /*====================================================================*/
@@ -45,23 +47,20 @@
 
 static UInt n_profiles = 0;
 
+/* Show a profile: the SB Profile proper, made from the counters
+   incremented by the translations, or the SB Samples profile made by
+   --profile-sample. */
 static 
 void show_SB_profile ( SBProfEntry tops[], UInt n_tops,
-                       ULong score_total, ULong ecs_done )
+                       ULong score_total, const HChar* what,
+                       const HChar* ecs_txt )
 {
    ULong score_cumul, score_cumul_saved, score_here;
    HChar buf_cumul[10], buf_here[10];
    HChar name[64];
    Int   r; /* must be signed */
 
-   HChar ecs_txt[50];
-   if (ecs_done > 0) {
-      VG_(sprintf)(ecs_txt, "%'llu ecs done", ecs_done);
-   } else {
-      VG_(strcpy)(ecs_txt, "for the entire run");
-   }
-
-   vg_assert(VG_(clo_profyle_sbs));
+   vg_assert(VG_(clo_profyle_sbs) || VG_(clo_profile_sample) > 0);
 
    VG_(printf)("\n");
    VG_(printf)("<<<---<<<---<<<---<<<---<<<---<<<---<<<---"
@@ -69,8 +68,8 @@ void show_SB_profile ( SBProfEntry tops[], UInt n_tops,
    VG_(printf)("<<<---<<<---<<<---<<<---<<<---<<<---<<<---"
                "<<<---<<<---<<<---<<<---<<<---<<<\n");
    VG_(printf)("\n");
-   VG_(printf)("<<< BEGIN SB Profile #%u (%s)\n",
-               ++n_profiles, ecs_txt);
+   VG_(printf)("<<< BEGIN %s #%u (%s)\n",
+               what, ++n_profiles, ecs_txt);
    VG_(printf)("<<<\n");
    VG_(printf)("\n");
 
@@ -163,8 +162,8 @@ void show_SB_profile ( SBProfEntry tops[], UInt n_tops,
 
    VG_(printf)("\n");
    VG_(printf)(">>>\n");
-   VG_(printf)(">>> END SB Profile #%u (%s)\n",
-               n_profiles, ecs_txt);
+   VG_(printf)(">>> END %s #%u (%s)\n",
+               what, n_profiles, ecs_txt);
    VG_(printf)(">>>\n");
    VG_(printf)(">>>--->>>--->>>--->>>--->>>--->>>--->>>---"
                ">>>--->>>--->>>--->>>--->>>--->>>\n");
@@ -188,12 +187,112 @@ void VG_(get_and_show_SB_profile) ( ULong ecs_done )
    SBProfEntry tops[N_MAX_END];
    Int nToShow = ecs_done == 0  ? N_MAX_END  : N_MAX_INTERVAL;
    ULong score_total = VG_(get_SB_profile)(tops, nToShow);
-   show_SB_profile(tops, nToShow, score_total, ecs_done);
+   HChar ecs_txt[50];
+   if (ecs_done > 0) {
+      VG_(sprintf)(ecs_txt, "%'llu ecs done", ecs_done);
+   } else {
+      VG_(strcpy)(ecs_txt, "for the entire run");
+   }
+   show_SB_profile(tops, nToShow, score_total, "SB Profile", ecs_txt);
 #  undef N_MAX_END
 #  undef N_MAX_INTERVAL
 }
 
 
+/*====================================================================*/
+/*=== SB sampling                                                  ===*/
+/*====================================================================*/
+
+/* With --profile-sample, the scheduler stops each thread every
+   VG_(clo_profile_sample) event checks or so, and gives the guest
+   address the thread is about to run, which is the start of a
+   superblock, to VG_(sample_SB).  The number of samples of each
+   superblock is kept here, keyed by its guest address: unlike the
+   counters of the SB Profile, they need no code in the translations,
+   and survive the translations being discarded. */
+
+typedef
+   struct _SBSample {
+      struct _SBSample* next;
+      Addr              addr;     // key: guest address of the SB
+      ULong             n_samples;
+   }
+   SBSample;
+
+static VgHashTable sb_samples = NULL;
+static ULong       n_sb_samples = 0;
+
+/* For VG_(SB_sample_interval). */
+static UInt sample_seed = 0;
+
+UInt VG_(SB_sample_interval) ( void )
+{
+   /* Pick the interval at random between half and one and a half times
+      the mean, so that samples don't keep falling on the same
+      iteration of a loop whose length divides the mean. */
+   UInt mean = VG_(clo_profile_sample);
+   vg_assert(mean > 0);
+   return mean / 2 + 1 + VG_(random)(&sample_seed) % mean;
+}
+
+void VG_(sample_SB) ( Addr addr )
+{
+   SBSample* s;
+
+   if (sb_samples == NULL)
+      sb_samples = VG_(HT_construct)("sbprofile.samples");
+   s = VG_(HT_lookup)(sb_samples, addr);
+   if (s == NULL) {
+      s = VG_(malloc)("sbprofile.sample", sizeof(SBSample));
+      s->addr      = addr;
+      s->n_samples = 0;
+      VG_(HT_add_node)(sb_samples, s);
+   }
+   s->n_samples++;
+   n_sb_samples++;
+}
+
+void VG_(show_SB_samples) ( void )
+{
+   /* The number of blocks to show. */
+#  define N_MAX_SAMPLED 200
+   SBProfEntry tops[N_MAX_SAMPLED];
+   SBSample*   s;
+   Int         i, r;
+   HChar       txt[80];
+
+   vg_assert(VG_(clo_profile_sample) > 0);
+
+   /* Find the most sampled blocks, in descending order, as
+      VG_(get_SB_profile) does. */
+   for (i = 0; i < N_MAX_SAMPLED; i++) {
+      tops[i].addr  = 0;
+      tops[i].score = 0;
+   }
+   if (sb_samples != NULL) {
+      VG_(HT_ResetIter)(sb_samples);
+      while ((s = VG_(HT_Next)(sb_samples)) != NULL) {
+         r = N_MAX_SAMPLED - 1;
+         while (r >= 0 && (tops[r].addr == 0
+                           || s->n_samples > tops[r].score))
+            r--;
+         r++;
+         if (r < N_MAX_SAMPLED) {
+            for (i = N_MAX_SAMPLED - 1; i > r; i--)
+               tops[i] = tops[i-1];
+            tops[r].addr  = s->addr;
+            tops[r].score = s->n_samples;
+         }
+      }
+   }
+
+   VG_(sprintf)(txt, "%'llu samples, one every ~%'u ecs",
+                n_sb_samples, VG_(clo_profile_sample));
+   show_SB_profile(tops, N_MAX_SAMPLED, n_sb_samples, "SB Samples", txt);
+#  undef N_MAX_SAMPLED
+}
+
+
 /*--------------------------------------------------------------------*/
 /*--- end                                            m_sbprofile.c ---*/
 /*--------------------------------------------------------------------*/
@@ -0,0 +1,218 @@
+/*--------------------------------------------------------------------*/
+/*--- Linux futex lock implementation           futex-lock-linux.c ---*/
+/*---                                                              ---*/
+/*--- The default scheduler lock on Linux.  Handing the lock over  ---*/
+/*--- costs nothing if nobody is waiting for it, and one futex     ---*/
+/*--- wakeup otherwise, instead of a write and a read on a pipe.   ---*/
+/*--------------------------------------------------------------------*/
+
+/*
+   This file is part of Valgrind, a dynamic binary instrumentation
+   framework.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of the
+   License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+   02111-1307, USA.
+
+   The GNU General Public License is contained in the file COPYING.
+*/
+
+#include "pub_core_basics.h"
+#include "pub_core_libcassert.h"
+#include "pub_core_libcprint.h"
+#include "pub_core_syscall.h"
+#include "pub_core_vki.h"
+#include "pub_core_vkiscnums.h"    // __NR_futex
+#include "pub_core_libcproc.h"
+#include "pub_core_mallocfree.h"
+#include "pub_core_inner.h"
+#if defined(ENABLE_INNER_CLIENT_REQUEST)
+#include "helgrind/helgrind.h"
+#endif
+#include "priv_sched-lock.h"
+#include "priv_sched-lock-impl.h"
+
+/*
+ * The lock word is 0 when the lock is free, 1 when it is held and 2 when
+ * it is held and some thread may be asleep waiting for it; see Ulrich
+ * Drepper, "Futexes Are Tricky" (mutex3).  A thread that finds the lock
+ * held first spins for a while, since the holder usually gives it up
+ * again very soon (at the end of its timeslice, or when it goes into a
+ * system call).  How long it spins adapts to how long it took to get the
+ * lock by spinning before, as glibc's adaptive mutexes do, so that on a
+ * machine with a single CPU, where spinning cannot work, it soon spins
+ * hardly at all.
+ */
+
+#define FL_MAX_SPINS 1000
+
+struct sched_lock {
+   volatile Int state;
+   Int spins;                  // current estimate of the spins needed
+   int owner;
+   ULong wake_time;            // when a sleeper was last woken, in ns
+};
+
+static ULong n_uncontended = 0;
+static ULong n_spun        = 0;
+static ULong n_slept       = 0;
+static ULong n_wakeups     = 0;
+static ULong handoff_ns    = 0;   // total, for the sleepers
+static ULong max_handoff_ns = 0;
+
+static inline void cpu_relax(void)
+{
+#if defined(VGA_x86) || defined(VGA_amd64)
+   __asm__ __volatile__("pause" : : : "memory");
+#elif defined(VGA_arm64)
+   __asm__ __volatile__("yield" : : : "memory");
+#else
+   __asm__ __volatile__("" : : : "memory");
+#endif
+}
+
+static const HChar *get_sched_lock_name(void)
+{
+   return "futex lock";
+}
+
+static struct sched_lock *create_sched_lock(void)
+{
+   struct sched_lock *p;
+
+   p = VG_(malloc)("sched_lock", sizeof(*p));
+   if (p) {
+      // The futex syscall requires that a futex takes four bytes.
+      vg_assert(sizeof(p->state) == 4);
+
+      p->state = 0;
+      p->spins = 0;
+      p->owner = 0;
+      p->wake_time = 0;
+   }
+   INNER_REQUEST(ANNOTATE_RWLOCK_CREATE(p));
+   INNER_REQUEST(ANNOTATE_BENIGN_RACE_SIZED(&p->spins, sizeof(p->spins), ""));
+   return p;
+}
+
+static void destroy_sched_lock(struct sched_lock *p)
+{
+   INNER_REQUEST(ANNOTATE_RWLOCK_DESTROY(p));
+   VG_(free)(p);
+}
+
+static int get_sched_lock_owner(struct sched_lock *p)
+{
+   return p->owner;
+}
+
+static void acquire_sched_lock(struct sched_lock *p)
+{
+   Int max_spins, i, c;
+   SysRes sres;
+
+   if (__sync_bool_compare_and_swap(&p->state, 0, 1)) {
+      n_uncontended++;
+      goto got_it;
+   }
+
+   max_spins = 2 * p->spins + 10;
+   if (max_spins > FL_MAX_SPINS)
+      max_spins = FL_MAX_SPINS;
+   for (i = 0; i < max_spins; i++) {
+      cpu_relax();
+      if (p->state == 0 && __sync_bool_compare_and_swap(&p->state, 0, 1)) {
+         p->spins += (i - p->spins) / 8;
+         n_spun++;
+         goto got_it;
+      }
+   }
+   p->spins += (max_spins - p->spins) / 8;
+
+   /* Go to sleep, marking the lock as having a waiter.  Since we can't
+      tell whether we were the last waiter, keep it marked as having one
+      when we do get it. */
+   c = __sync_lock_test_and_set(&p->state, 2);
+   while (c != 0) {
+      sres = VG_(do_syscall3)(__NR_futex, (UWord)&p->state,
+                              VKI_FUTEX_WAIT | VKI_FUTEX_PRIVATE_FLAG, 2);
+      if (sr_isError(sres) && sres._val != VKI_EAGAIN
+          && sres._val != VKI_EINTR) {
+         VG_(printf)("futex_wait() returned error code %ld\n", sres._val);
+         vg_assert(False);
+      }
+      c = __sync_lock_test_and_set(&p->state, 2);
+   }
+   n_slept++;
+   if (p->wake_time != 0) {
+      ULong ns = VG_(read_nanosecond_timer)() - p->wake_time;
+      p->wake_time = 0;
+      handoff_ns += ns;
+      if (ns > max_handoff_ns)
+         max_handoff_ns = ns;
+   }
+
+  got_it:
+   INNER_REQUEST(ANNOTATE_RWLOCK_ACQUIRED(p, /*is_w*/1));
+   vg_assert(p->owner == 0);
+   p->owner = VG_(gettid)();
+}
+
+/*
+ * Release the lock.  Only if somebody may be asleep waiting for it is a
+ * futex wakeup needed, and then one thread is woken.
+ */
+static void release_sched_lock(struct sched_lock *p)
+{
+   SysRes sres;
+
+   vg_assert(p->owner != 0);
+   p->owner = 0;
+   INNER_REQUEST(ANNOTATE_RWLOCK_RELEASED(p, /*is_w*/1));
+   if (__sync_fetch_and_sub(&p->state, 1) != 1) {
+      p->wake_time = VG_(read_nanosecond_timer)();
+      n_wakeups++;
+      __sync_lock_release(&p->state);
+      sres = VG_(do_syscall3)(__NR_futex, (UWord)&p->state,
+                              VKI_FUTEX_WAKE | VKI_FUTEX_PRIVATE_FLAG, 1);
+      vg_assert(!sr_isError(sres));
+   }
+}
+
+static void print_sched_lock_stats(void)
+{
+   VG_(message)(Vg_DebugMsg,
+                "scheduler: futex lock: %'llu free, %'llu after spinning, "
+                "%'llu after sleeping (%'llu wakeups)\n",
+                n_uncontended, n_spun, n_slept, n_wakeups);
+   if (n_slept > 0)
+      VG_(message)(Vg_DebugMsg,
+                   "scheduler: futex lock: wakeup to handoff %'llu ns "
+                   "on average, %'llu ns at most\n",
+                   handoff_ns / n_slept, max_handoff_ns);
+}
+
+const struct sched_lock_ops ML_(linux_futex_lock_ops) = {
+   .get_sched_lock_name    = get_sched_lock_name,
+   .create_sched_lock      = create_sched_lock,
+   .destroy_sched_lock     = destroy_sched_lock,
+   .get_sched_lock_owner   = get_sched_lock_owner,
+   .acquire_sched_lock     = acquire_sched_lock,
+   .release_sched_lock     = release_sched_lock,
+   .print_sched_lock_stats = print_sched_lock_stats,
+};
+
+/*--------------------------------------------------------------------*/
+/*--- end                                                          ---*/
+/*--------------------------------------------------------------------*/
@@ -41,10 +41,12 @@ struct sched_lock_ops {
    int (*get_sched_lock_owner)(struct sched_lock *p);
    void (*acquire_sched_lock)(struct sched_lock *p);
    void (*release_sched_lock)(struct sched_lock *p);
+   void (*print_sched_lock_stats)(void);    // may be NULL
 };
 
 extern const struct sched_lock_ops ML_(generic_sched_lock_ops);
 extern const struct sched_lock_ops ML_(linux_ticket_lock_ops);
+extern const struct sched_lock_ops ML_(linux_futex_lock_ops);
 
 #endif   // __PRIV_SCHED_LOCK_IMPL_H
 
@@ -92,6 +92,10 @@
 #include "pub_core_translate.h"     // For VG_(translate)()
 #include "pub_core_transtab.h"
 #include "pub_core_debuginfo.h"     // VG_(di_notify_pdb_debuginfo)
+#include "pub_core_metrics.h"       // VG_(maybe_write_metrics)
+#include "pub_core_perfevents.h"    // VG_(perf_phase)
+#include "pub_core_forkserver.h"    // VG_(fork_server)
+#include "pub_core_checkpoint.h"    // VG_(checkpoint)
 #include "priv_sched-lock.h"
 #include "pub_core_scheduler.h"     // self
 #include "pub_core_redir.h"
@@ -109,6 +113,10 @@
    give finer interleaving but much increased scheduling overheads. */
 #define SCHEDULING_QUANTUM   100000
 
+/* With --adaptive-quantum=yes, the shortest timeslice a thread which
+   keeps others waiting is cut down to. */
+#define MIN_SCHEDULING_QUANTUM (SCHEDULING_QUANTUM / 16)
+
 /* If False, a fault is Valgrind-internal (ie, a bug) */
 Bool VG_(in_generated_code) = False;
 
@@ -134,6 +142,16 @@ static ULong n_scheduling_events_MAJOR = 0;
 /* Stats: number of XIndirs, and number that missed in the fast
    cache. */
 static ULong stats__n_xindirs = 0;
+/* The number of acquisitions of the_BigLock by VG_(acquire_BigLock),
+   of those by a thread other than the previous holder, and of
+   timeslice ends at which --adaptive-quantum=yes kept the lock. */
+static ULong stats__n_lock_acquires = 0;
+static ULong stats__n_lock_handoffs = 0;
+static ULong stats__n_yields_skipped = 0;
+/* With --stats=yes, a histogram of the time VG_(acquire_BigLock)
+   waited for the lock: under 1us, 10us, 100us, 1ms, 10ms, and more. */
+#define N_LOCK_WAIT_BUCKETS 6
+static ULong stats__lock_wait[N_LOCK_WAIT_BUCKETS];
 static ULong stats__n_xindir_misses = 0;
 
 /* And 32-bit temp bins for the above, so that 32-bit platforms don't
@@ -146,6 +164,13 @@ static ULong stats__n_xindir_misses = 0;
 static UInt sanity_fast_count = 0;
 static UInt sanity_slow_count = 0;
 
+/* For --parallel-threads: the number of threads running generated
+   code without the_BigLock, how many times threads went in, and how
+   many times they all had to be stopped. */
+static volatile Int n_parallel_threads = 0;
+static ULong stats__n_parallel_runs  = 0;
+static ULong stats__n_parallel_stops = 0;
+
 void VG_(print_scheduler_stats)(void)
 {
    VG_(message)(Vg_DebugMsg,
@@ -158,16 +183,50 @@ void VG_(print_scheduler_stats)(void)
    VG_(message)(Vg_DebugMsg,
       "scheduler: %'llu/%'llu major/minor sched events.\n",
       n_scheduling_events_MAJOR, n_scheduling_events_MINOR);
+   VG_(message)(Vg_DebugMsg,
+      "scheduler: %'llu lock acquisitions, %'llu handed over to "
+      "another thread\n",
+      stats__n_lock_acquires, stats__n_lock_handoffs);
+   VG_(message)(Vg_DebugMsg,
+      "scheduler: lock waits: %'llu <1us, %'llu <10us, %'llu <100us, "
+      "%'llu <1ms, %'llu <10ms, %'llu longer\n",
+      stats__lock_wait[0], stats__lock_wait[1], stats__lock_wait[2],
+      stats__lock_wait[3], stats__lock_wait[4], stats__lock_wait[5]);
+   ML_(print_sched_lock_stats)();
+   if (VG_(clo_adaptive_quantum))
+      VG_(message)(Vg_DebugMsg,
+                   "scheduler: %'llu timeslices extended, "
+                   "nobody waiting for the lock\n",
+                   stats__n_yields_skipped);
+   if (VG_(clo_parallel_threads))
+      VG_(message)(Vg_DebugMsg,
+                   "scheduler: %'llu runs without the lock, "
+                   "%'llu stops\n",
+                   stats__n_parallel_runs, stats__n_parallel_stops);
    VG_(message)(Vg_DebugMsg, 
                 "   sanity: %d cheap, %d expensive checks.\n",
                 sanity_fast_count, sanity_slow_count );
 }
 
+void VG_(scheduler_metrics) ( void (*put)(const HChar* name, ULong value) )
+{
+   put("sched.event_checks", bbs_done);
+   put("sched.indir_transfers", stats__n_xindirs);
+   put("sched.indir_misses", stats__n_xindir_misses);
+   put("sched.major_events", n_scheduling_events_MAJOR);
+   put("sched.minor_events", n_scheduling_events_MINOR);
+}
+
 /*
  * Mutual exclusion object used to serialize threads.
  */
 static struct sched_lock *the_BigLock;
 
+/* The number of threads waiting in VG_(acquire_BigLock), and the last
+   thread to have acquired it there. */
+static volatile Int n_BigLock_waiters = 0;
+static ThreadId     last_BigLock_owner = VG_INVALID_THREADID;
+
 
 /* ---------------------------------------------------------------------
    Helper functions for the scheduler.
@@ -195,6 +254,24 @@ void maybe_show_sb_profile ( void )
    }
 }
 
+/* For --hot-code-layout=yes: gather up the most frequently run
+   translations every this many blocks. */
+#define HOT_LAYOUT_INTERVAL 2000000
+
+static
+void maybe_move_hot_translations ( void )
+{
+   /* DO NOT MAKE NON-STATIC */
+   static ULong bbs_done_lastcheck = 0;
+   /* */
+   Long delta = (Long)(bbs_done - bbs_done_lastcheck);
+   vg_assert(delta >= 0);
+   if ((ULong)delta >= HOT_LAYOUT_INTERVAL) {
+      bbs_done_lastcheck = bbs_done;
+      VG_(move_hot_translations)();
+   }
+}
+
 static
 const HChar* name_of_sched_event ( UInt event )
 {
@@ -233,12 +310,25 @@ const HChar* name_of_sched_event ( UInt event )
   }
 }
 
+/* All the slots below this one are in use by live threads (exiting
+   ones lower it again).  So a new thread still gets the lowest free
+   ThreadId, without looking at all the slots before it when there are
+   many threads. */
+static ThreadId lowest_free_tid_hint = 1;
+
 /* Allocate a completely empty ThreadState record. */
 ThreadId VG_(alloc_ThreadState) ( void )
 {
-   Int i;
-   for (i = 1; i < VG_N_THREADS; i++) {
+   Int i, first_busy = 0;
+
+   if (lowest_free_tid_hint < 1 || lowest_free_tid_hint >= VG_N_THREADS)
+      lowest_free_tid_hint = 1;
+   for (i = lowest_free_tid_hint; i < VG_N_THREADS; i++) {
       if (VG_(threads)[i].status == VgTs_Empty) {
+         /* A Zombie or Init slot (this one included, if the thread
+            fails to start) may become Empty without us hearing of it,
+            so look again from the first of them. */
+         lowest_free_tid_hint = first_busy ? first_busy : i;
 	 VG_(threads)[i].status = VgTs_Init;
 	 VG_(threads)[i].exitreason = VgSrc_None;
          if (VG_(threads)[i].thread_name)
@@ -246,9 +336,18 @@ ThreadId VG_(alloc_ThreadState) ( void )
          VG_(threads)[i].thread_name = NULL;
          return i;
       }
+      if (first_busy == 0 && (VG_(threads)[i].status == VgTs_Zombie
+                              || VG_(threads)[i].status == VgTs_Init))
+         first_busy = i;
+   }
+   if (lowest_free_tid_hint > 1) {
+      /* Something below the hint was freed behind our back. */
+      lowest_free_tid_hint = 1;
+      return VG_(alloc_ThreadState)();
    }
    VG_(printf)("vg_alloc_ThreadState: no free slots available\n");
-   VG_(printf)("Increase VG_N_THREADS, rebuild and try again.\n");
+   VG_(printf)("Increase the number of threads with --max-threads=<number>"
+               " (currently %u).\n", VG_N_THREADS);
    VG_(core_panic)("VG_N_THREADS is too low");
    /*NOTREACHED*/
 }
@@ -274,10 +373,29 @@ void VG_(acquire_BigLock)(ThreadId tid, const HChar* who)
    }
 #endif
 
+   ULong t_wait = VG_(clo_stats) ? VG_(read_nanosecond_timer)() : 0;
+
    /* First, acquire the_BigLock.  We can't do anything else safely
       prior to this point.  Even doing debug printing prior to this
       point is, technically, wrong. */
+   __sync_fetch_and_add(&n_BigLock_waiters, 1);
    VG_(acquire_BigLock_LL)(NULL);
+   __sync_fetch_and_sub(&n_BigLock_waiters, 1);
+
+   stats__n_lock_acquires++;
+   if (tid != last_BigLock_owner)
+      stats__n_lock_handoffs++;
+   last_BigLock_owner = tid;
+   if (VG_(clo_stats)) {
+      ULong waited = VG_(read_nanosecond_timer)() - t_wait;
+      ULong limit  = 1000;
+      Int   b      = 0;
+      while (b < N_LOCK_WAIT_BUCKETS-1 && waited >= limit) {
+         b++;
+         limit *= 10;
+      }
+      stats__lock_wait[b]++;
+   }
 
    tst = VG_(get_ThreadState)(tid);
 
@@ -371,6 +489,70 @@ Bool VG_(owns_BigLock_LL) ( ThreadId tid )
 }
 
 
+/* --parallel-threads support.  A thread goes into generated code by
+   bumping n_parallel_threads and dropping the lock, and comes back out
+   by decrementing it and taking the lock again.  Since nobody can go
+   in while someone else holds the lock, the holder can wait for
+   n_parallel_threads to drop to zero and know it stays there. */
+
+static void enter_parallel_code ( ThreadId tid )
+{
+   ThreadState* tst = VG_(get_ThreadState)(tid);
+
+   vg_assert(VG_(running_tid) == tid);
+   vg_assert(!tst->in_parallel_code);
+   tst->in_parallel_code = True;
+   __sync_fetch_and_add(&n_parallel_threads, 1);
+   VG_(running_tid) = VG_INVALID_THREADID;
+   VG_(release_BigLock_LL)(NULL);
+}
+
+Bool VG_(leave_parallel_code) ( ThreadId tid )
+{
+   ThreadState* tst = VG_(get_ThreadState)(tid);
+   Int          evc;
+
+   if (!tst->in_parallel_code)
+      return False;
+
+   /* VG_(stop_parallel_threads) may zero the event counter any time
+      until it sees in_parallel_code go False, so remember the real
+      value, and put it back once we have the lock. */
+   evc = tst->arch.vex.host_EvC_COUNTER;
+   tst->in_parallel_code = False;
+   __sync_fetch_and_sub(&n_parallel_threads, 1);
+   VG_(acquire_BigLock_LL)(NULL);
+   vg_assert(VG_(running_tid) == VG_INVALID_THREADID);
+   VG_(running_tid) = tid;
+   tst->arch.vex.host_EvC_COUNTER = evc;
+   return True;
+}
+
+void VG_(return_to_parallel_code) ( ThreadId tid )
+{
+   enter_parallel_code(tid);
+}
+
+void VG_(stop_parallel_threads) ( void )
+{
+   ThreadId tid;
+
+   if (LIKELY(n_parallel_threads == 0))
+      return;
+
+   stats__n_parallel_stops++;
+   while (n_parallel_threads > 0) {
+      /* A zero event counter makes a thread leave at its next event
+         check.  The thread may overwrite the zero with its own
+         decrement of the previous value, so keep at it. */
+      for (tid = 1; tid < VG_N_THREADS; tid++)
+         if (VG_(threads)[tid].in_parallel_code)
+            VG_(threads)[tid].arch.vex.host_EvC_COUNTER = 0;
+      VG_(do_syscall0)(__NR_sched_yield);
+   }
+}
+
+
 /* Clear out the ThreadState and release the semaphore. Leaves the
    ThreadState in VgTs_Zombie state, so that it doesn't get
    reallocated until the caller is really ready. */
@@ -382,6 +564,8 @@ void VG_(exit_thread)(ThreadId tid)
 
    mostly_clear_thread_record(tid);
    VG_(running_tid) = VG_INVALID_THREADID;
+   if (tid < lowest_free_tid_hint)
+      lowest_free_tid_hint = tid;
 
    /* There should still be a valid exitreason for this thread */
    vg_assert(VG_(threads)[tid].exitreason != VgSrc_None);
@@ -534,6 +718,7 @@ void mostly_clear_thread_record ( ThreadId tid )
    VG_(clear_out_queued_signals)(tid, &savedmask);
 
    VG_(threads)[tid].sched_jmpbuf_valid = False;
+   VG_(threads)[tid].in_parallel_code = False;
 }
 
 /*                                                                             
@@ -566,7 +751,10 @@ static void sched_fork_cleanup(ThreadId me)
    VG_(threads)[me].os_state.lwpid = VG_(gettid)();
    VG_(threads)[me].os_state.threadgroup = VG_(getpid)();
 
-   /* clear out all the unused thread slots */
+   /* clear out all the unused thread slots, including any which were
+      running generated code in the parent */
+   n_parallel_threads = 0;
+   lowest_free_tid_hint = 1;
    for (tid = 1; tid < VG_N_THREADS; tid++) {
       if (tid != me) {
          mostly_clear_thread_record(tid);
@@ -578,6 +766,8 @@ static void sched_fork_cleanup(ThreadId me)
    /* re-init and take the sema */
    deinit_BigLock();
    init_BigLock();
+   n_BigLock_waiters  = 0;
+   last_BigLock_owner = me;
    VG_(acquire_BigLock_LL)(NULL);
 }
 
@@ -600,6 +790,10 @@ ThreadId VG_(scheduler_init_phase1) ( void )
       VG_(printf)("Error: fair scheduling is not supported on this system.\n");
       VG_(exit)(1);
    }
+   /* Otherwise use the futex lock where there is one, else stay with
+      the generic pipe-based one. */
+   if (VG_(clo_fair_sched) == disable_fair_sched)
+      ML_(set_sched_lock_impl)(sched_lock_futex);
 
    if (VG_(clo_verbosity) > 1) {
       VG_(message)(Vg_DebugMsg,
@@ -662,6 +856,29 @@ void VG_(scheduler_init_phase2) ( ThreadId tid_main,
       = clstack_size;
 
    VG_(atfork)(NULL, NULL, sched_fork_cleanup);
+
+#  if defined(VGO_linux)
+   if (VG_(clo_sched_affinity)) {
+      /* Only one thread runs at a time, so keep them all, and the
+         translation cache they share, on the core the main thread is
+         on now.  Threads inherit this from the one creating them. */
+      UInt   cpu;
+      ULong  mask[1024 / 64];
+      SysRes sres = VG_(do_syscall3)(__NR_getcpu, (UWord)&cpu, 0, 0);
+      if (!sr_isError(sres) && cpu < 1024) {
+         VG_(memset)(mask, 0, sizeof(mask));
+         mask[cpu / 64] = 1ULL << (cpu % 64);
+         sres = VG_(do_syscall3)(__NR_sched_setaffinity, 0,
+                                 sizeof(mask), (UWord)mask);
+      }
+      if (sr_isError(sres))
+         VG_(umsg)("Warning: --sched-affinity=yes: can't pin threads "
+                   "to a core\n");
+      else if (VG_(clo_verbosity) > 1)
+         VG_(message)(Vg_DebugMsg, "Scheduler: threads pinned to cpu %u\n",
+                      cpu);
+   }
+#  endif
 }
 
 
@@ -851,6 +1068,7 @@ void run_thread_for_a_while ( /*OUT*/HWord* two_words,
    volatile ThreadState* tst            = NULL; /* stop gcc complaining */
    volatile Int          done_this_time = 0;
    volatile HWord        host_code_addr = 0;
+   FastCacheSet* volatile fast_cache    = NULL;
 
    /* Paranoia */
    vg_assert(VG_(is_valid_tid)(tid));
@@ -862,9 +1080,12 @@ void run_thread_for_a_while ( /*OUT*/HWord* two_words,
    do_pre_run_checks( (ThreadState*)tst );
    /* end Paranoia */
 
-   /* Futz with the XIndir stats counters. */
-   vg_assert(VG_(stats__n_xindirs_32) == 0);
-   vg_assert(VG_(stats__n_xindir_misses_32) == 0);
+   /* Futz with the XIndir stats counters.  With other threads in
+      generated code they needn't be zero. */
+   if (!VG_(clo_parallel_threads)) {
+      vg_assert(VG_(stats__n_xindirs_32) == 0);
+      vg_assert(VG_(stats__n_xindir_misses_32) == 0);
+   }
 
    /* Clear return area. */
    two_words[0] = two_words[1] = 0;
@@ -875,9 +1096,15 @@ void run_thread_for_a_while ( /*OUT*/HWord* two_words,
       host_code_addr = alt_host_addr;
    } else {
       /* normal case -- redir translation */
-      UInt cno = (UInt)VG_TT_FAST_HASH((Addr)tst->arch.vex.VG_INSTR_PTR);
-      if (LIKELY(VG_(tt_fast)[cno].guest == (Addr)tst->arch.vex.VG_INSTR_PTR))
-         host_code_addr = VG_(tt_fast)[cno].host;
+      FastCacheSet* set
+         = &VG_(get_fast_cache)(tid)
+              [VG_TT_FAST_HASH((Addr)tst->arch.vex.VG_INSTR_PTR)];
+      UInt w;
+      for (w = 0; w < VG_TT_FAST_WAYS; w++)
+         if (set->guest[w] == (Addr)tst->arch.vex.VG_INSTR_PTR)
+            break;
+      if (LIKELY(w < VG_TT_FAST_WAYS))
+         host_code_addr = set->host[w];
       else {
          AddrH res   = 0;
          /* not found in VG_(tt_fast). Searching here the transtab
@@ -926,8 +1153,18 @@ void run_thread_for_a_while ( /*OUT*/HWord* two_words,
    // Tell the tool this thread is about to run client code
    VG_TRACK( start_client_code, tid, bbs_done );
 
-   vg_assert(VG_(in_generated_code) == False);
-   VG_(in_generated_code) = True;
+   fast_cache = VG_(get_fast_cache)(tid);
+   VG_(perf_phase)(tid, VgPerf_Guest);
+
+   if (VG_(clo_parallel_threads)) {
+      /* Let the other threads in while we run.  in_parallel_code
+         stands in for VG_(in_generated_code) in the meantime. */
+      stats__n_parallel_runs++;
+      enter_parallel_code(tid);
+   } else {
+      vg_assert(VG_(in_generated_code) == False);
+      VG_(in_generated_code) = True;
+   }
 
    SCHEDSETJMP(
       tid, 
@@ -935,12 +1172,19 @@ void run_thread_for_a_while ( /*OUT*/HWord* two_words,
       VG_(disp_run_translations)( 
          two_words,
          (void*)&tst->arch.vex,
-         host_code_addr
+         host_code_addr,
+         fast_cache
       )
    );
 
-   vg_assert(VG_(in_generated_code) == True);
-   VG_(in_generated_code) = False;
+   if (VG_(clo_parallel_threads)) {
+      /* Unless a signal handler already took the lock for us. */
+      VG_(leave_parallel_code)(tid);
+   } else {
+      vg_assert(VG_(in_generated_code) == True);
+      VG_(in_generated_code) = False;
+   }
+   VG_(perf_phase)(tid, VgPerf_Core);
 
    if (jumped != (HWord)0) {
       /* We get here if the client took a fault that caused our signal
@@ -954,10 +1198,18 @@ void run_thread_for_a_while ( /*OUT*/HWord* two_words,
    /* Merge the 32-bit XIndir/miss counters into the 64 bit versions,
       and zero out the 32-bit ones in preparation for the next run of
       generated code. */
-   stats__n_xindirs += (ULong)VG_(stats__n_xindirs_32);
-   VG_(stats__n_xindirs_32) = 0;
-   stats__n_xindir_misses += (ULong)VG_(stats__n_xindir_misses_32);
-   VG_(stats__n_xindir_misses_32) = 0;
+   if (VG_(clo_parallel_threads)) {
+      stats__n_xindirs
+         += (ULong)__sync_lock_test_and_set(&VG_(stats__n_xindirs_32), 0);
+      stats__n_xindir_misses
+         += (ULong)__sync_lock_test_and_set(&VG_(stats__n_xindir_misses_32),
+                                            0);
+   } else {
+      stats__n_xindirs += (ULong)VG_(stats__n_xindirs_32);
+      VG_(stats__n_xindirs_32) = 0;
+      stats__n_xindir_misses += (ULong)VG_(stats__n_xindir_misses_32);
+      VG_(stats__n_xindir_misses_32) = 0;
+   }
 
    /* Inspect the event counter. */
    vg_assert((Int)tst->arch.vex.host_EvC_COUNTER >= -1);
@@ -1100,7 +1352,9 @@ static void handle_syscall(ThreadId tid, UInt trc)
       vg_assert(ok);
    }
 
+   VG_(perf_phase)(tid, VgPerf_Syscall);
    SCHEDSETJMP(tid, jumped, VG_(client_syscall)(tid, trc));
+   VG_(perf_phase)(tid, VgPerf_Core);
 
    if (VG_(clo_sanity_level) >= 3) {
       HChar buf[50];
@@ -1174,6 +1428,13 @@ VgSchedReturnCode VG_(scheduler) ( ThreadId tid )
 {
    /* Holds the remaining size of this thread's "timeslice". */
    Int dispatch_ctr = 0;
+   /* The size of this thread's timeslices.  With --adaptive-quantum,
+      they get shorter while it keeps other threads waiting for the
+      lock, and back to normal when nobody waits. */
+   Int quantum = SCHEDULING_QUANTUM;
+   /* With --profile-sample, the number of event checks until this
+      thread's next sample. */
+   Int sample_ctr = 0;
 
    ThreadState *tst = VG_(get_ThreadState)(tid);
    static Bool vgdb_startup_action_done = False;
@@ -1257,7 +1518,9 @@ VgSchedReturnCode VG_(scheduler) ( ThreadId tid )
    
    vg_assert(VG_(is_running_thread)(tid));
 
-   dispatch_ctr = SCHEDULING_QUANTUM;
+   dispatch_ctr = quantum;
+   if (VG_(clo_profile_sample) > 0)
+      sample_ctr = VG_(SB_sample_interval)();
 
    while (!VG_(is_exiting)(tid)) {
 
@@ -1281,16 +1544,34 @@ VgSchedReturnCode VG_(scheduler) ( ThreadId tid )
 	 /* 3 Aug 06: doing sys__nsleep works but crashes some apps.
             sys_yield also helps the problem, whilst not crashing apps. */
 
-	 VG_(release_BigLock)(tid, VgTs_Yielding, 
-                                   "VG_(scheduler):timeslice");
-	 /* ------------ now we don't have The Lock ------------ */
+         /* With --adaptive-quantum=yes, there is no point in giving
+            up the lock if nobody is waiting for it.  A thread which
+            uses up its timeslices while others wait gets them halved,
+            so that threads coming back from blocking syscalls don't
+            wait as long for the lock; they only grow back slowly, as
+            the waiters typically come back soon. */
+         if (VG_(clo_adaptive_quantum) && n_BigLock_waiters == 0) {
+            stats__n_yields_skipped++;
+            if (quantum < SCHEDULING_QUANTUM)
+               quantum += MIN_SCHEDULING_QUANTUM;
+         } else {
+            if (VG_(clo_adaptive_quantum)
+                && quantum > MIN_SCHEDULING_QUANTUM)
+               quantum /= 2;
 
-	 VG_(acquire_BigLock)(tid, "VG_(scheduler):timeslice");
-	 /* ------------ now we do have The Lock ------------ */
+	    VG_(release_BigLock)(tid, VgTs_Yielding, 
+                                      "VG_(scheduler):timeslice");
+	    /* ------------ now we don't have The Lock ------------ */
+
+	    VG_(acquire_BigLock)(tid, "VG_(scheduler):timeslice");
+	    /* ------------ now we do have The Lock ------------ */
+         }
 
 	 /* OK, do some relatively expensive housekeeping stuff */
 	 scheduler_sanity(tid);
 	 VG_(sanity_check_general)(False);
+	 VG_(maybe_write_metrics)(False);
+	 VG_(maybe_checkpoint)(tid);
 
 	 /* Look for any pending signals for this thread, and set them up
 	    for delivery */
@@ -1303,13 +1584,23 @@ VgSchedReturnCode VG_(scheduler) ( ThreadId tid )
 	 n_scheduling_events_MAJOR++;
 
 	 /* Figure out how many bbs to ask vg_run_innerloop to do. */
-         dispatch_ctr = SCHEDULING_QUANTUM;
+         dispatch_ctr = quantum;
 
 	 /* paranoia ... */
 	 vg_assert(tst->tid == tid);
 	 vg_assert(tst->os_state.lwpid == VG_(gettid)());
       }
 
+      /* With --fast-forward, this is where the instrumentation starts:
+         nothing is running or being chained to here. */
+      if (UNLIKELY(VG_(clo_fast_forward)))
+         VG_(maybe_start_instrumentation)( bbs_done );
+
+      /* With --pretranslate, translate the functions it names in any
+         objects loaded since the last time round. */
+      if (UNLIKELY(VG_(clo_pretranslate) != NULL))
+         VG_(maybe_pretranslate)( tid, bbs_done );
+
       /* For stats purposes only. */
       n_scheduling_events_MINOR++;
 
@@ -1317,11 +1608,38 @@ VgSchedReturnCode VG_(scheduler) ( ThreadId tid )
          VG_(message)(Vg_DebugMsg, "thread %d: running for %d bbs\n", 
                                    tid, dispatch_ctr - 1 );
 
+      /* With --profile-sample, stop when the next sample is due
+         rather than at the end of the timeslice, and give the rest of
+         the timeslice back afterwards. */
+      Int rest_of_slice = 0;
+      if (UNLIKELY(VG_(clo_profile_sample) > 0)
+          && dispatch_ctr > sample_ctr) {
+         rest_of_slice = dispatch_ctr - sample_ctr;
+         dispatch_ctr  = sample_ctr;
+      }
+      Int dispatch_ctr_before = dispatch_ctr;
+
       HWord trc[2]; /* "two_words" */
       run_thread_for_a_while( &trc[0],
                               &dispatch_ctr,
                               tid, 0/*ignored*/, False );
 
+      if (UNLIKELY(VG_(clo_profile_sample) > 0)) {
+         sample_ctr -= dispatch_ctr_before - dispatch_ctr;
+         if (sample_ctr == 0) {
+            /* The guest IP is the start of the next SB to run. */
+            VG_(sample_SB)(VG_(get_IP)(tid));
+            sample_ctr = VG_(SB_sample_interval)();
+         }
+         if (rest_of_slice > 0) {
+            /* The counter reaching zero was for the sample, not the
+               end of the timeslice. */
+            if (trc[0] == VG_TRC_INNER_COUNTERZERO)
+               trc[0] = VG_TRC_BORING;
+            dispatch_ctr += rest_of_slice;
+         }
+      }
+
       if (VG_(clo_trace_sched) && VG_(clo_verbosity) > 2) {
 	 HChar buf[50];
 	 VG_(sprintf)(buf, "TRC: %s", name_of_sched_event(trc[0]));
@@ -1623,6 +1941,9 @@ VgSchedReturnCode VG_(scheduler) ( ThreadId tid )
 
       if (UNLIKELY(VG_(clo_profyle_sbs)) && VG_(clo_profyle_interval) > 0)
          maybe_show_sb_profile();
+
+      if (UNLIKELY(VG_(clo_hot_code_layout)))
+         maybe_move_hot_translations();
    }
 
    if (VG_(clo_trace_sched))
@@ -1986,6 +2307,29 @@ void do_client_request ( ThreadId tid )
          SET_CLREQ_RETVAL( tid, 0 );     /* return value is meaningless */
 	 break;
 
+      case VG_USERREQ__FORK_SERVER:
+         SET_CLREQ_RETVAL( tid, VG_(fork_server)(tid) );
+         break;
+
+      case VG_USERREQ__CHECKPOINT:
+         SET_CLREQ_RETVAL( tid, VG_(checkpoint)(tid) );
+         break;
+
+      case VG_USERREQ__RESTORE_CHECKPOINT:
+         (void) VG_(restore_checkpoint)( (Int)arg[1] );
+         SET_CLREQ_RETVAL( tid, -1 );  /* only if there is no such checkpoint */
+         break;
+
+      case VG_USERREQ__STOP_FAST_FORWARD:
+         VG_(request_start_instrumentation)( "client request" );
+         SET_CLREQ_RETVAL( tid, 0 );     /* return value is meaningless */
+         break;
+
+      case VG_USERREQ__PRETRANSLATE:
+         SET_CLREQ_RETVAL( tid, VG_(pretranslate_range)( tid, arg[1], arg[2],
+                                                         bbs_done ) );
+         break;
+
       case VG_USERREQ__COUNT_ERRORS:  
          SET_CLREQ_RETVAL( tid, VG_(get_n_errs_found)() );
          break;
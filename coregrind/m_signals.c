@@ -226,6 +226,7 @@
 #include "pub_core_syscall.h"
 #include "pub_core_syswrap.h"
 #include "pub_core_tooliface.h"
+#include "pub_core_transtab.h"      // For VG_(smc_handle_write_fault)()
 #include "pub_core_coredump.h"
 
 
@@ -250,6 +251,11 @@ typedef struct SigQueue {
    vki_siginfo_t sigs[N_QUEUED_SIGNALS];
 } SigQueue;
 
+/* Number of signals waiting in the queues of all threads.  Lets
+   VG_(poll_signals) skip blocking all signals to look in the queues,
+   in the usual case where they are all empty. */
+static volatile UInt n_queued_signals = 0;
+
 /* ------ Macros for pulling stuff out of ucontexts ------ */
 
 /* Q: what does VG_UCONTEXT_SYSCALL_SYSRES do?  A: let's suppose the
@@ -1328,6 +1334,11 @@ void VG_(clear_out_queued_signals)( ThreadId tid, vki_sigset_t* saved_mask )
 {
    block_all_host_signals(saved_mask);
    if (VG_(threads)[tid].sig_queue != NULL) {
+      SigQueue *sq = VG_(threads)[tid].sig_queue;
+      Int i;
+      for (i = 0; i < N_QUEUED_SIGNALS; i++)
+         if (sq->sigs[i].si_signo != 0)
+            n_queued_signals--;
       VG_(arena_free)(VG_AR_CORE, VG_(threads)[tid].sig_queue);
       VG_(threads)[tid].sig_queue = NULL;
    }
@@ -1468,6 +1479,9 @@ void VG_(kill_self)(Int sigNo)
 #  endif
    VG_(sigemptyset)(&sa.sa_mask);
       
+   /* The signal may well be fatal: don't lose the buffered output. */
+   VG_(flush_output_sinks)();
+
    VG_(sigaction)(sigNo, &sa, &origsa);
 
    VG_(sigemptyset)(&mask);
@@ -2071,6 +2085,8 @@ void queue_signal(ThreadId tid, const vki_siginfo_t *si)
    if (sq->sigs[sq->next].si_signo != 0)
       VG_(umsg)("Signal %d being dropped from thread %d's queue\n",
                 sq->sigs[sq->next].si_signo, tid);
+   else
+      n_queued_signals++;
 
    sq->sigs[sq->next] = *si;
    sq->next = (sq->next+1) % N_QUEUED_SIGNALS;
@@ -2450,7 +2466,8 @@ static Bool extend_stack_if_appropriate(ThreadId tid, vki_siginfo_t* info)
 
 static
 void sync_signalhandler_from_kernel ( ThreadId tid,
-         Int sigNo, vki_siginfo_t *info, struct vki_ucontext *uc )
+         Int sigNo, vki_siginfo_t *info, struct vki_ucontext *uc,
+         Bool from_parallel_code )
 {
    /* Check to see if some part of Valgrind itself is interested in faults.
       The fault catcher should never be set whilst we're in generated code, so
@@ -2468,6 +2485,19 @@ void sync_signalhandler_from_kernel ( ThreadId tid,
       /* Stack extension occurred, so we don't need to do anything else; upon
          returning from this function, we'll restart the host (hence guest)
          instruction. */
+      if (from_parallel_code)
+         VG_(return_to_parallel_code)(tid);
+   } else if (sigNo == VKI_SIGSEGV && info->si_code == VKI_SEGV_ACCERR
+              && VG_(smc_handle_write_fault)
+                    ( (Addr)info->VKI_SIGINFO_si_addr )) {
+      /* A write to a page write-protected by --smc-check=protect.  Its
+         translations are gone and it is writable again, so as above,
+         just restart the instruction. */
+      if (VG_(clo_trace_signals))
+         VG_(dmsg)("       -> write to protected code page %#lx\n",
+                   (Addr)info->VKI_SIGINFO_si_addr);
+      if (from_parallel_code)
+         VG_(return_to_parallel_code)(tid);
    } else {
       /* OK, this is a signal we really have to deal with.  If it came
          from the client's code, then we can jump back into the scheduler
@@ -2479,7 +2509,7 @@ void sync_signalhandler_from_kernel ( ThreadId tid,
          VG_(set_default_handler)(sigNo);
       }
 
-      if (VG_(in_generated_code)) {
+      if (VG_(in_generated_code) || from_parallel_code) {
          if (VG_(gdbserver_report_signal) (sigNo, tid)
              || VG_(sigismember)(&tst->sig_mask, sigNo)) {
             /* Can't continue; must longjmp back to the scheduler and thus
@@ -2528,6 +2558,11 @@ void sync_signalhandler ( Int sigNo,
 {
    ThreadId tid = VG_(lwpid_to_vgtid)(VG_(gettid)());
    Bool from_user;
+   Bool from_parallel_code;
+
+   /* With --parallel-threads=yes we may have been running generated
+      code without the_BigLock; everything below needs it. */
+   from_parallel_code = VG_(leave_parallel_code)(tid);
 
    if (0) 
       VG_(printf)("sync_sighandler(%d, %p, %p)\n", sigNo, info, uc);
@@ -2571,8 +2606,12 @@ void sync_signalhandler ( Int sigNo,
       that is, merely queue it for later delivery. */
    if (from_user) {
       sync_signalhandler_from_user(  tid, sigNo, info, uc);
+      /* It was only queued, so carry on running. */
+      if (from_parallel_code)
+         VG_(return_to_parallel_code)(tid);
    } else {
-      sync_signalhandler_from_kernel(tid, sigNo, info, uc);
+      sync_signalhandler_from_kernel(tid, sigNo, info, uc,
+                                     from_parallel_code);
    }
 }
 
@@ -2652,6 +2691,18 @@ void VG_(set_default_handler)(Int signo)
    VG_(do_sys_sigaction)(signo, &sa, NULL);
 }
 
+/* Deliver to tid the signal found by VG_(poll_signals).  Must be
+   called with all signals blocked. */
+static void deliver_polled_signal(ThreadId tid, vki_siginfo_t *si)
+{
+   if (VG_(clo_trace_signals))
+      VG_(dmsg)("Polling found signal %d for tid %d\n", si->si_signo, tid);
+   if (!is_sig_ign(si->si_signo, tid))
+      deliver_signal(tid, si, NULL);
+   else if (VG_(clo_trace_signals))
+      VG_(dmsg)("   signal %d ignored\n", si->si_signo);
+}
+
 /* 
    Poll for pending signals, and set the next one up for delivery.
  */
@@ -2666,6 +2717,25 @@ void VG_(poll_signals)(ThreadId tid)
    /* pollset = ~tst->sig_mask */
    VG_(sigcomplementset)( &pollset, &tst->sig_mask );
 
+#  if defined(VGO_linux)
+   /* Usually there is nothing in the queues and nothing pending, so
+      first just ask the kernel, without the two sigprocmask needed to
+      protect the queues.  A signal queued just after
+      n_queued_signals is read is found by the next poll, as if it had
+      arrived after this one. */
+   if (n_queued_signals == 0) {
+      if (VG_(sigtimedwait_zero)(&pollset, &si) <= 0)
+         return;
+      if (VG_(clo_trace_signals))
+         VG_(dmsg)("poll_signals: got signal %d for thread %d\n",
+                   si.si_signo, tid);
+      block_all_host_signals(&saved_mask);
+      deliver_polled_signal(tid, &si);
+      restore_all_host_signals(&saved_mask);
+      return;
+   }
+#  endif
+
    block_all_host_signals(&saved_mask); // protect signal queue
 
    /* First look for any queued pending signals */
@@ -2674,30 +2744,25 @@ void VG_(poll_signals)(ThreadId tid)
    if (sip == NULL)
       sip = next_queued(0, &pollset); /* process-wide */
 
+   if (sip != NULL) {
+      /* Take it out of the queue before delivering it. */
+      si = *sip;
+      sip->si_signo = 0;
+      n_queued_signals--;
+      deliver_polled_signal(tid, &si);
+   }
    /* If there was nothing queued, ask the kernel for a pending signal */
-   if (sip == NULL && VG_(sigtimedwait_zero)(&pollset, &si) > 0) {
+   else if (VG_(sigtimedwait_zero)(&pollset, &si) > 0) {
       if (VG_(clo_trace_signals))
          VG_(dmsg)("poll_signals: got signal %d for thread %d\n",
                    si.si_signo, tid);
-      sip = &si;
-   }
-
-   if (sip != NULL) {
-      /* OK, something to do; deliver it */
-      if (VG_(clo_trace_signals))
-         VG_(dmsg)("Polling found signal %d for tid %d\n", sip->si_signo, tid);
-      if (!is_sig_ign(sip->si_signo, tid))
-	 deliver_signal(tid, sip, NULL);
-      else if (VG_(clo_trace_signals))
-         VG_(dmsg)("   signal %d ignored\n", sip->si_signo);
-	 
-      sip->si_signo = 0;	/* remove from signal queue, if that's
-				   where it came from */
+      deliver_polled_signal(tid, &si);
    }
 
    restore_all_host_signals(&saved_mask);
 }
 
+
 /* At startup, copy the process' real signal state to the SCSS.
    Whilst doing this, block all real signals.  Then calculate SKSS and
    set the kernel to that.  Also initialise DCSS. 
@@ -78,6 +78,70 @@ typedef
    }
    SWAStackElem;
 
+/* The adaptive radix tree variant (VG_(newSWA_ART)).  Each node
+   discriminates on one byte of the key, byte 0 being the most
+   significant one, and has room for 4, 16, 48 or 256 entries.  Nodes
+   at depth ART_LEAF_DEPTH hold values, the others hold child nodes.
+   Paths are compressed: a node stores in .pkey one key of its
+   subtree, and so the bytes above .depth common to all the keys of the
+   subtree, and a child can be any number of bytes deeper than its
+   parent.  An inner node always has at least 2 children. */
+
+#define ART_LEAF_DEPTH  ((Int)sizeof(UWord) - 1)
+
+typedef
+   enum { Art_4=4, Art_16=16, Art_48=48, Art_256=256 }
+   ArtType;
+
+typedef
+   struct {
+      UShort type;   /* ArtType */
+      UShort depth;  /* which byte of the key this node looks at */
+      UShort n;      /* nr of entries in use */
+      UWord  pkey;
+   }
+   ArtHdr;
+
+typedef
+   struct {
+      ArtHdr h;
+      UChar  keys[4];   /* sorted */
+      UWord  slots[4];  /* ArtHdr* of children, or values */
+   }
+   Art4;
+
+typedef
+   struct {
+      ArtHdr h;
+      UChar  keys[16];  /* sorted */
+      UWord  slots[16];
+   }
+   Art16;
+
+typedef
+   struct {
+      ArtHdr h;
+      UChar  index[256]; /* 0 if not in use, else 1 + slot number */
+      ULong  used;       /* which of the slots are in use */
+      UWord  slots[48];
+   }
+   Art48;
+
+typedef
+   struct {
+      ArtHdr h;
+      UChar  inUse[256/8];
+      UWord  slots[256];
+   }
+   Art256;
+
+typedef
+   struct {
+      ArtHdr* nd;
+      Int     ix;   /* next byte to look at in nd */
+   }
+   ArtStackElem;
+
 struct _SparseWA {
    void*        (*alloc_nofail)(const HChar*,SizeT);
    const HChar* cc;
@@ -85,6 +149,10 @@ struct _SparseWA {
    LevelN*      root;
    SWAStackElem iterStack[8];
    Int          isUsed;
+   /* The ART variant uses these instead of the above. */
+   Bool         art;
+   ArtHdr*      artRoot;
+   ArtStackElem artStack[sizeof(UWord)];
 };
 
 //////// SWA helper functions (bitarray)
@@ -164,10 +232,428 @@ static Level0* swa_new_Level0 ( SparseWA* swa )
 }
 
 
+//////// SWA ART variant
+
+static inline UWord art_byte ( UWord key, Int depth ) {
+   return (key >> ((ART_LEAF_DEPTH - depth) * 8)) & 0xFF;
+}
+
+/* Do the bytes of key above nd->depth match those of nd->pkey? */
+static inline Bool art_prefix_matches ( const ArtHdr* nd, UWord key ) {
+   Int shift = (ART_LEAF_DEPTH - nd->depth) * 8 + 8;
+   if (shift == 8 * sizeof(UWord))
+      return True;
+   return ((key ^ nd->pkey) >> shift) == 0;
+}
+
+static SizeT art_size ( ArtType type ) {
+   switch (type) {
+      case Art_4:   return sizeof(Art4);
+      case Art_16:  return sizeof(Art16);
+      case Art_48:  return sizeof(Art48);
+      case Art_256: return sizeof(Art256);
+      default:      vg_assert(0);
+   }
+}
+
+static ArtHdr* art_new ( SparseWA* swa, ArtType type, Int depth, UWord pkey )
+{
+   ArtHdr* nd = swa->alloc_nofail( swa->cc, art_size(type) );
+   VG_(memset)(nd, 0, art_size(type));
+   nd->type  = type;
+   nd->depth = depth;
+   nd->n     = 0;
+   nd->pkey  = pkey;
+   return nd;
+}
+
+/* The slot for byte b in nd, or NULL if there is none. */
+static inline UWord* art_find ( ArtHdr* nd, UWord b )
+{
+   Int i;
+   switch (nd->type) {
+      case Art_4: {
+         Art4* n4 = (Art4*)nd;
+         for (i = 0; i < nd->n; i++)
+            if (n4->keys[i] == b) return &n4->slots[i];
+         return NULL;
+      }
+      case Art_16: {
+         Art16* n16 = (Art16*)nd;
+         for (i = 0; i < nd->n; i++)
+            if (n16->keys[i] >= b)
+               return n16->keys[i] == b ? &n16->slots[i] : NULL;
+         return NULL;
+      }
+      case Art_48: {
+         Art48* n48 = (Art48*)nd;
+         return n48->index[b] ? &n48->slots[n48->index[b] - 1] : NULL;
+      }
+      case Art_256: {
+         Art256* n256 = (Art256*)nd;
+         return swa_bitarray_read(n256->inUse, b) ? &n256->slots[b] : NULL;
+      }
+      default:
+         vg_assert(0);
+   }
+}
+
+/* The first slot of nd for a byte >= *b, setting *b to that byte, or
+   NULL if there is none. */
+static UWord* art_next ( ArtHdr* nd, /*MOD*/UWord* b )
+{
+   Int i;
+   switch (nd->type) {
+      case Art_4:
+      case Art_16: {
+         UChar* keys  = nd->type == Art_4 ? ((Art4*)nd)->keys
+                                          : ((Art16*)nd)->keys;
+         UWord* slots = nd->type == Art_4 ? ((Art4*)nd)->slots
+                                          : ((Art16*)nd)->slots;
+         for (i = 0; i < nd->n; i++)
+            if (keys[i] >= *b) {
+               *b = keys[i];
+               return &slots[i];
+            }
+         return NULL;
+      }
+      case Art_48: {
+         Art48* n48 = (Art48*)nd;
+         for (; *b < 256; (*b)++)
+            if (n48->index[*b])
+               return &n48->slots[n48->index[*b] - 1];
+         return NULL;
+      }
+      case Art_256: {
+         Art256* n256 = (Art256*)nd;
+         for (; *b < 256; (*b)++)
+            if (swa_bitarray_read(n256->inUse, *b))
+               return &n256->slots[*b];
+         return NULL;
+      }
+      default:
+         vg_assert(0);
+   }
+}
+
+/* Add b -> v to nd, which must have room for it and not have b. */
+static void art_add_raw ( ArtHdr* nd, UWord b, UWord v )
+{
+   Int i;
+   vg_assert(nd->n < nd->type);
+   switch (nd->type) {
+      case Art_4:
+      case Art_16: {
+         UChar* keys  = nd->type == Art_4 ? ((Art4*)nd)->keys
+                                          : ((Art16*)nd)->keys;
+         UWord* slots = nd->type == Art_4 ? ((Art4*)nd)->slots
+                                          : ((Art16*)nd)->slots;
+         for (i = nd->n; i > 0 && keys[i-1] > b; i--) {
+            keys[i]  = keys[i-1];
+            slots[i] = slots[i-1];
+         }
+         keys[i]  = b;
+         slots[i] = v;
+         break;
+      }
+      case Art_48: {
+         Art48* n48 = (Art48*)nd;
+         for (i = 0; n48->used & (1ULL << i); i++)
+            ;
+         vg_assert(i < 48);
+         n48->used |= 1ULL << i;
+         n48->index[b] = i + 1;
+         n48->slots[i] = v;
+         break;
+      }
+      case Art_256: {
+         Art256* n256 = (Art256*)nd;
+         swa_bitarray_read_then_set(n256->inUse, b);
+         n256->slots[b] = v;
+         break;
+      }
+      default:
+         vg_assert(0);
+   }
+   nd->n++;
+}
+
+/* Remove b from nd, which must have it. */
+static void art_remove_raw ( ArtHdr* nd, UWord b )
+{
+   Int i;
+   switch (nd->type) {
+      case Art_4:
+      case Art_16: {
+         UChar* keys  = nd->type == Art_4 ? ((Art4*)nd)->keys
+                                          : ((Art16*)nd)->keys;
+         UWord* slots = nd->type == Art_4 ? ((Art4*)nd)->slots
+                                          : ((Art16*)nd)->slots;
+         for (i = 0; keys[i] != b; i++)
+            vg_assert(i < nd->n);
+         for (; i < nd->n - 1; i++) {
+            keys[i]  = keys[i+1];
+            slots[i] = slots[i+1];
+         }
+         break;
+      }
+      case Art_48: {
+         Art48* n48 = (Art48*)nd;
+         vg_assert(n48->index[b]);
+         n48->used &= ~(1ULL << (n48->index[b] - 1));
+         n48->index[b] = 0;
+         break;
+      }
+      case Art_256: {
+         Art256* n256 = (Art256*)nd;
+         vg_assert(swa_bitarray_read_then_clear(n256->inUse, b));
+         break;
+      }
+      default:
+         vg_assert(0);
+   }
+   nd->n--;
+}
+
+/* Replace *ndP by a node of the given type with the same entries. */
+static void art_resize ( SparseWA* swa, ArtHdr** ndP, ArtType type )
+{
+   ArtHdr* old = *ndP;
+   ArtHdr* nyu = art_new(swa, type, old->depth, old->pkey);
+   UWord   b   = 0;
+   UWord*  slot;
+   while (b < 256 && (slot = art_next(old, &b)) != NULL) {
+      art_add_raw(nyu, b, *slot);
+      b++;
+   }
+   vg_assert(nyu->n == old->n);
+   *ndP = nyu;
+   swa->dealloc(old);
+}
+
+static void art_add ( SparseWA* swa, ArtHdr** ndP, UWord b, UWord v )
+{
+   if ((*ndP)->n == (*ndP)->type) {
+      switch ((*ndP)->type) {
+         case Art_4:  art_resize(swa, ndP, Art_16);  break;
+         case Art_16: art_resize(swa, ndP, Art_48);  break;
+         case Art_48: art_resize(swa, ndP, Art_256); break;
+         default:     vg_assert(0);
+      }
+   }
+   art_add_raw(*ndP, b, v);
+}
+
+static void art_remove ( SparseWA* swa, ArtHdr** ndP, UWord b )
+{
+   art_remove_raw(*ndP, b);
+   /* Shrink with some hysteresis, so that a node that hovers around
+      a size boundary doesn't get copied on every add/delete. */
+   switch ((*ndP)->type) {
+      case Art_16:
+         if ((*ndP)->n <= 3)  art_resize(swa, ndP, Art_4);
+         break;
+      case Art_48:
+         if ((*ndP)->n <= 12) art_resize(swa, ndP, Art_16);
+         break;
+      case Art_256:
+         if ((*ndP)->n <= 40) art_resize(swa, ndP, Art_48);
+         break;
+      default:
+         break;
+   }
+}
+
+/* A new leaf node holding just key -> val. */
+static ArtHdr* art_new_leaf ( SparseWA* swa, UWord key, UWord val )
+{
+   ArtHdr* leaf = art_new(swa, Art_4, ART_LEAF_DEPTH, key);
+   art_add_raw(leaf, art_byte(key, ART_LEAF_DEPTH), val);
+   return leaf;
+}
+
+static Bool art_lookup ( SparseWA* swa, UWord key, /*OUT*/UWord* valP )
+{
+   ArtHdr* nd = swa->artRoot;
+   UWord*  slot;
+   while (nd) {
+      if (!art_prefix_matches(nd, key))
+         return False;
+      slot = art_find(nd, art_byte(key, nd->depth));
+      if (!slot)
+         return False;
+      if (nd->depth == ART_LEAF_DEPTH) {
+         *valP = *slot;
+         return True;
+      }
+      nd = (ArtHdr*)*slot;
+   }
+   return False;
+}
+
+static Bool art_insert ( SparseWA* swa, UWord key, UWord val )
+{
+   ArtHdr** ndP = &swa->artRoot;
+   while (True) {
+      ArtHdr* nd = *ndP;
+      UWord*  slot;
+      UWord   b;
+
+      if (nd == NULL) {
+         *ndP = art_new_leaf(swa, key, val);
+         return False;
+      }
+
+      if (!art_prefix_matches(nd, key)) {
+         /* Split the compressed path at the first byte that differs. */
+         ArtHdr* split;
+         Int     d = 0;
+         while (art_byte(key, d) == art_byte(nd->pkey, d))
+            d++;
+         vg_assert(d < nd->depth);
+         split = art_new(swa, Art_4, d, key);
+         art_add_raw(split, art_byte(nd->pkey, d), (UWord)nd);
+         art_add_raw(split, art_byte(key, d),
+                     (UWord)art_new_leaf(swa, key, val));
+         *ndP = split;
+         return False;
+      }
+
+      b = art_byte(key, nd->depth);
+      slot = art_find(nd, b);
+      if (nd->depth == ART_LEAF_DEPTH) {
+         if (slot) {
+            *slot = val;
+            return True;
+         }
+         art_add(swa, ndP, b, val);
+         return False;
+      }
+      if (!slot) {
+         art_add(swa, ndP, b, (UWord)art_new_leaf(swa, key, val));
+         return False;
+      }
+      ndP = (ArtHdr**)slot;
+   }
+}
+
+static Bool art_delete ( SparseWA* swa, UWord key, /*OUT*/UWord* oldV )
+{
+   ArtHdr** path[sizeof(UWord)];
+   Int      nPath = 0;
+   ArtHdr** ndP   = &swa->artRoot;
+   UWord*   slot;
+
+   /* Find the leaf, remembering the way down. */
+   while (True) {
+      ArtHdr* nd = *ndP;
+      if (nd == NULL || !art_prefix_matches(nd, key))
+         return False;
+      slot = art_find(nd, art_byte(key, nd->depth));
+      if (!slot)
+         return False;
+      vg_assert(nPath < (Int)sizeof(UWord));
+      path[nPath++] = ndP;
+      if (nd->depth == ART_LEAF_DEPTH)
+         break;
+      ndP = (ArtHdr**)slot;
+   }
+
+   *oldV = *slot;
+   art_remove(swa, ndP, art_byte(key, ART_LEAF_DEPTH));
+   if ((*ndP)->n > 0)
+      return True;
+
+   /* The leaf is empty: unhook it from its parent, and if that leaves
+      the parent with a single child, put the child in its place. */
+   swa->dealloc(*ndP);
+   *ndP = NULL;
+   nPath--;
+   if (nPath > 0) {
+      ArtHdr** parentP = path[nPath-1];
+      art_remove(swa, parentP, art_byte(key, (*parentP)->depth));
+      vg_assert((*parentP)->n >= 1);
+      if ((*parentP)->n == 1) {
+         ArtHdr* parent = *parentP;
+         UWord   b      = 0;
+         *parentP = (ArtHdr*)*art_next(parent, &b);
+         swa->dealloc(parent);
+      }
+   }
+   return True;
+}
+
+static void art_init_iter ( SparseWA* swa )
+{
+   swa->isUsed = 0;
+   if (swa->artRoot) {
+      swa->artStack[0].nd = swa->artRoot;
+      swa->artStack[0].ix = 0;
+      swa->isUsed = 1;
+   }
+}
+
+static Bool art_next_iter ( SparseWA* swa,
+                            /*OUT*/UWord* keyP, /*OUT*/UWord* valP )
+{
+   while (swa->isUsed > 0) {
+      ArtStackElem* top = &swa->artStack[swa->isUsed - 1];
+      UWord  b = top->ix;
+      UWord* slot = b < 256 ? art_next(top->nd, &b) : NULL;
+      if (!slot) {
+         swa->isUsed--;
+         continue;
+      }
+      top->ix = b + 1;
+      if (top->nd->depth == ART_LEAF_DEPTH) {
+         *keyP = (top->nd->pkey & ~(UWord)0xFF) | b;
+         *valP = *slot;
+         return True;
+      }
+      vg_assert(swa->isUsed < (Int)sizeof(UWord));
+      swa->artStack[swa->isUsed].nd = (ArtHdr*)*slot;
+      swa->artStack[swa->isUsed].ix = 0;
+      swa->isUsed++;
+   }
+   return False;
+}
+
+static UWord art_count ( ArtHdr* nd )
+{
+   UWord  sum = 0;
+   UWord  b   = 0;
+   UWord* slot;
+   if (nd->depth == ART_LEAF_DEPTH)
+      return nd->n;
+   while (b < 256 && (slot = art_next(nd, &b)) != NULL) {
+      sum += art_count((ArtHdr*)*slot);
+      b++;
+   }
+   return sum;
+}
+
+static void art_free ( void(*dealloc)(void*), ArtHdr* nd )
+{
+   UWord  b = 0;
+   UWord* slot;
+   if (nd->depth != ART_LEAF_DEPTH) {
+      while (b < 256 && (slot = art_next(nd, &b)) != NULL) {
+         art_free(dealloc, (ArtHdr*)*slot);
+         b++;
+      }
+   }
+   dealloc(nd);
+}
+
+
 //////// SWA public interface
 
 void VG_(initIterSWA) ( SparseWA* swa )
 {
+   if (swa->art) {
+      art_init_iter(swa);
+      return;
+   }
    swa->isUsed = 0;
    if (swa->root) swa_PUSH(swa, 0, 0, swa->root, 1/*start_new_node*/);
 }
@@ -181,6 +667,9 @@ Bool VG_(nextIterSWA)( SparseWA* swa,
    void* curr_nd;
    Int   resume_point;
 
+   if (swa->art)
+      return art_next_iter(swa, keyP, valP);
+
    /* dispatch whatever's on top of the stack; what that actually 
       means is to return to some previously-saved context. */
    dispatch:
@@ -248,6 +737,16 @@ SparseWA* VG_(newSWA) ( void*(*alloc_nofail)(const HChar* cc, SizeT),
    return swa;
 }
 
+SparseWA* VG_(newSWA_ART) ( void*(*alloc_nofail)(const HChar* cc, SizeT),
+                            const HChar* cc,
+                            void(*dealloc)(void*) )
+{
+   SparseWA* swa = VG_(newSWA)( alloc_nofail, cc, dealloc );
+   swa->art     = True;
+   swa->artRoot = NULL;
+   return swa;
+}
+
 
 static void swa_deleteSWA_wrk ( void(*dealloc)(void*), void* nd )
 {
@@ -267,6 +766,8 @@ static void swa_deleteSWA_wrk ( void(*dealloc)(void*), void* nd )
 }
 void VG_(deleteSWA) ( SparseWA* swa )
 {
+   if (swa->artRoot)
+      art_free( swa->dealloc, swa->artRoot );
    if (swa->root)
       swa_deleteSWA_wrk( swa->dealloc, swa->root );
    swa->dealloc(swa);
@@ -284,6 +785,10 @@ Bool VG_(lookupSWA) ( SparseWA* swa,
    const Int _3_or_7 = sizeof(void*) - 1;
 
    vg_assert(swa);
+   if (swa->art) {
+      *keyP = key;
+      return art_lookup(swa, key, valP);
+   }
    levelN = swa->root;
 
    /* levels 3/7 .. 1 */
@@ -318,6 +823,8 @@ Bool VG_(addToSWA) ( SparseWA* swa, UWord key, UWord val )
    const Int _3_or_7 = sizeof(void*) - 1;
 
    vg_assert(swa);
+   if (swa->art)
+      return art_insert(swa, key, val);
 
    if (!swa->root)
       swa->root = swa_new_LevelN(swa, _3_or_7);
@@ -379,6 +886,10 @@ Bool VG_(delFromSWA) ( SparseWA* swa,
    Int     nVisited = 0;
 
    vg_assert(swa);
+   if (swa->art) {
+      *oldK = key; /* this is silly */
+      return art_delete(swa, key, oldV);
+   }
    levelN = swa->root;
 
    /* levels 3/7 .. 1 */
@@ -453,6 +964,8 @@ static UWord swa_sizeSWA_wrk ( void* nd )
 }
 UWord VG_(sizeSWA) ( SparseWA* swa )
 {
+   if (swa->art)
+      return swa->artRoot ? art_count ( swa->artRoot ) : 0;
    if (swa->root)
       return swa_sizeSWA_wrk ( swa->root );
    else
@@ -31,10 +31,13 @@
 #include "pub_core_basics.h"
 #include "pub_core_debuglog.h"
 #include "pub_core_libcassert.h"
+#include "pub_core_libcbase.h"
 #include "pub_core_libcprint.h"
 #include "pub_core_mallocfree.h"
 #include "pub_core_options.h"
 #include "pub_core_stacks.h"
+#include "pub_core_libcsetjmp.h"    // to keep _threadstate.h happy
+#include "pub_core_threadstate.h"   // VG_(running_tid)
 #include "pub_core_tooliface.h"
 
 // For expensive debugging
@@ -89,85 +92,121 @@ typedef struct _Stack {
    UWord id;
    Addr start; // Lowest stack byte, included.
    Addr end;   // Highest stack byte, included.
-   struct _Stack *next;
 } Stack;
 
-static Stack *stacks;
-static UWord next_id;  /* Next id we hand out to a newly registered stack */
+/*
+ * The registered stacks are kept in two arrays: sorted by id, so that
+ * the client requests find theirs by binary search, and sorted by start
+ * address, so that find_stack_by_addr does.  Coroutine libraries can
+ * register thousands of stacks, and look one up at every switch between
+ * them, so a list is too slow.  Stacks may overlap (a coroutine's stack
+ * can be carved out of another stack), so max_end[i] is the highest end
+ * of by_start[0 .. i], which tells the search when no stack further
+ * down can contain the address.
+ */
+static Stack** by_id      = NULL;
+static Stack** by_start   = NULL;
+static Addr*   max_end    = NULL;
+static UWord   n_stacks   = 0;
+static UWord   size_stacks = 0;   /* allocated size of the three arrays */
+static UWord   next_id;  /* Next id we hand out to a newly registered stack */
 
 /*
- * These are the id, start and end values of the current stack.  If the
- * stack pointer falls outside the range of the current stack, we search
- * the stacks list above for a matching stack.
+ * The stack that each thread's stack pointer was last seen in.  If it
+ * falls outside that stack, we search for a matching stack.  This is per
+ * thread, so that threads running on different stacks don't each make
+ * the others search at every SP change.
  */
-static Stack *current_stack;
+static Stack** current_stacks = NULL;   /* [VG_N_THREADS] */
 
-/* Find 'st' in the stacks_list and move it one step closer the the
-   front of the list, so as to make subsequent searches for it
-   cheaper. */
-static void move_Stack_one_step_forward ( Stack* st )
+static inline Stack** current_stack_of_running ( void )
 {
-   Stack *st0, *st1, *st2;
-   if (st == stacks)
-      return; /* already at head of list */
-   vg_assert(st != NULL);
-   st0 = stacks;
-   st1 = NULL;
-   st2 = NULL;
-   while (True) {
-      if (st0 == NULL || st0 == st) break;
-      st2 = st1;
-      st1 = st0;
-      st0 = st0->next;
+   if (UNLIKELY(current_stacks == NULL))
+      current_stacks = VG_(arena_calloc)(VG_AR_CORE, "stacks.csor.1",
+                                         VG_N_THREADS, sizeof(Stack*));
+   /* VG_INVALID_THREADID (0) has a slot too, for before the client runs. */
+   return &current_stacks[VG_(running_tid)];
+}
+
+/* Index in by_start of the first stack whose start is above 'a'. */
+static UWord first_start_above ( Addr a )
+{
+   UWord lo = 0, hi = n_stacks;
+   while (lo < hi) {
+      UWord mid = lo + (hi - lo) / 2;
+      if (by_start[mid]->start <= a)
+         lo = mid + 1;
+      else
+         hi = mid;
+   }
+   return lo;
+}
+
+/* Index in by_id of the stack with this id, or n_stacks if none. */
+static UWord index_of_id ( UWord id )
+{
+   UWord lo = 0, hi = n_stacks;
+   while (lo < hi) {
+      UWord mid = lo + (hi - lo) / 2;
+      if (by_id[mid]->id < id)
+         lo = mid + 1;
+      else
+         hi = mid;
    }
-   vg_assert(st0 == st);
-   if (st0 != NULL && st1 != NULL && st2 != NULL) {
-      Stack* tmp;
-      /* st0 points to st, st1 to its predecessor, and st2 to st1's
-         predecessor.  Swap st0 and st1, that is, move st0 one step
-         closer to the start of the list. */
-      vg_assert(st2->next == st1);
-      vg_assert(st1->next == st0);
-      tmp = st0->next;
-      st2->next = st0;
-      st0->next = st1;
-      st1->next = tmp;
+   return lo < n_stacks && by_id[lo]->id == id ? lo : n_stacks;
+}
+
+static void recompute_max_end ( UWord from )
+{
+   UWord i;
+   for (i = from; i < n_stacks; i++) {
+      Addr e = by_start[i]->end;
+      max_end[i] = i > 0 && max_end[i-1] > e ? max_end[i-1] : e;
    }
-   else
-   if (st0 != NULL && st1 != NULL && st2 == NULL) {
-      /* it's second in the list. */
-      vg_assert(stacks == st1);
-      vg_assert(st1->next == st0);
-      st1->next = st0->next;
-      st0->next = st1;
-      stacks = st0;
+}
+
+/* Put 'st' into by_start, after any stacks with the same start. */
+static void insert_by_start ( Stack* st )
+{
+   UWord i = first_start_above(st->start);
+   VG_(memmove)(&by_start[i+1], &by_start[i],
+                (n_stacks - i) * sizeof(Stack*));
+   by_start[i] = st;
+   n_stacks++;
+   recompute_max_end(i);
+}
+
+static void remove_by_start ( Stack* st )
+{
+   UWord i = first_start_above(st->start);
+   while (True) {
+      vg_assert(i > 0);
+      i--;
+      if (by_start[i] == st)
+         break;
    }
+   n_stacks--;
+   VG_(memmove)(&by_start[i], &by_start[i+1],
+                (n_stacks - i) * sizeof(Stack*));
+   recompute_max_end(i);
 }
 
-/* Find what stack an address falls into. */
+/* Find what stack an address falls into.  If it is in more than one,
+   the one starting highest, which is the innermost if they nest. */
 static Stack* find_stack_by_addr(Addr sp)
 {
    static UWord n_fails = 0;
    static UWord n_searches = 0;
    static UWord n_steps = 0;
-   Stack *i = stacks;
+   UWord i;
    n_searches++;
    if (0 && 0 == (n_searches % 10000))
       VG_(printf)("(hgdev) %lu searches, %lu steps, %lu fails\n",
                   n_searches, n_steps+1, n_fails);
-   /* fast track common case */
-   if (i && sp >= i->start && sp <= i->end)
-      return i;
-   /* else search the list */
-   while (i) {
+   for (i = first_start_above(sp); i > 0 && max_end[i-1] >= sp; i--) {
       n_steps++;
-      if (sp >= i->start && sp <= i->end) {
-         if (1 && (n_searches & 0x3F) == 0) {
-            move_Stack_one_step_forward( i );
-         }
-         return i;
-      }
-      i = i->next;
+      if (sp <= by_start[i-1]->end)
+         return by_start[i-1];
    }
    n_fails++;
    return NULL;
@@ -191,15 +230,26 @@ UWord VG_(register_stack)(Addr start, Addr end)
       start = t;
    }
 
+   if (n_stacks == size_stacks) {
+      size_stacks = size_stacks == 0 ? 16 : 2 * size_stacks;
+      by_id    = VG_(arena_realloc)(VG_AR_CORE, "stacks.rs.2", by_id,
+                                    size_stacks * sizeof(Stack*));
+      by_start = VG_(arena_realloc)(VG_AR_CORE, "stacks.rs.3", by_start,
+                                    size_stacks * sizeof(Stack*));
+      max_end  = VG_(arena_realloc)(VG_AR_CORE, "stacks.rs.4", max_end,
+                                    size_stacks * sizeof(Addr));
+   }
+
    i = (Stack *)VG_(arena_malloc)(VG_AR_CORE, "stacks.rs.1", sizeof(Stack));
    i->start = start;
    i->end = end;
    i->id = next_id++;
-   i->next = stacks;
-   stacks = i;
+   /* Ids only go up, so the new one goes at the end of by_id. */
+   by_id[n_stacks] = i;
+   insert_by_start(i);
 
    if (i->id == 0) {
-      current_stack = i;
+      *current_stack_of_running() = i;
    }
 
    VG_(debugLog)(2, "stacks", "register [%p-%p] as stack %lu\n",
@@ -214,28 +264,26 @@ UWord VG_(register_stack)(Addr start, Addr end)
  */
 void VG_(deregister_stack)(UWord id)
 {
-   Stack *i = stacks;
-   Stack *prev = NULL;
+   UWord j = index_of_id(id);
+   Stack *i;
 
    VG_(debugLog)(2, "stacks", "deregister stack %lu\n", id);
 
-   if (current_stack && current_stack->id == id) { 
-      current_stack = NULL;
-   }
+   if (j == n_stacks)
+      return;
+   i = by_id[j];
 
-   while(i) {
-      if (i->id == id) {
-         if(prev == NULL) {
-            stacks = i->next;
-         } else {
-            prev->next = i->next;
-         }
-         VG_(arena_free)(VG_AR_CORE, i);
-         return;
-      }
-      prev = i;
-      i = i->next;
+   if (current_stacks != NULL) {
+      ThreadId tid;
+      for (tid = 0; tid < VG_N_THREADS; tid++)
+         if (current_stacks[tid] == i)
+            current_stacks[tid] = NULL;
    }
+
+   remove_by_start(i);
+   /* remove_by_start has already counted it out. */
+   VG_(memmove)(&by_id[j], &by_id[j+1], (n_stacks - j) * sizeof(Stack*));
+   VG_(arena_free)(VG_AR_CORE, i);
 }
 
 /*
@@ -245,21 +293,22 @@ void VG_(deregister_stack)(UWord id)
  */
 void VG_(change_stack)(UWord id, Addr start, Addr end)
 {
-   Stack *i = stacks;
-
-   while (i) {
-      if (i->id == id) {
-         VG_(debugLog)(2, "stacks", 
-                       "change stack %lu from [%p-%p] to [%p-%p]\n",
-                       id, (void*)i->start, (void*)i->end,
-                           (void*)start,    (void*)end);
-         /* FIXME : swap start/end like VG_(register_stack) ??? */
-         i->start = start;
-         i->end = end;
-         return;
-      }
-      i = i->next;
-   }
+   UWord j = index_of_id(id);
+   Stack *i;
+
+   if (j == n_stacks)
+      return;
+   i = by_id[j];
+
+   VG_(debugLog)(2, "stacks", 
+                 "change stack %lu from [%p-%p] to [%p-%p]\n",
+                 id, (void*)i->start, (void*)i->end,
+                     (void*)start,    (void*)end);
+   /* FIXME : swap start/end like VG_(register_stack) ??? */
+   remove_by_start(i);
+   i->start = start;
+   i->end = end;
+   insert_by_start(i);
 }
 
 /*
@@ -316,27 +365,35 @@ static void complaints_stack_switch (Addr old_SP, Addr new_SP)
 // preamble + check if stack has switched.
 #define IF_STACK_SWITCH_SET_current_stack_AND_RETURN                    \
    Word delta  = (Word)new_SP - (Word)old_SP;                           \
+   Stack** current_stack = current_stack_of_running();                  \
                                                                         \
    EDEBUG("current_stack  %p-%p %lu new_SP %p old_SP %p\n",             \
-          (void *) (current_stack ? current_stack->start : 0x0),        \
-          (void *) (current_stack ? current_stack->end : 0x0),          \
-          current_stack ? current_stack->id : 0,                        \
+          (void *) (*current_stack ? (*current_stack)->start : 0x0),    \
+          (void *) (*current_stack ? (*current_stack)->end : 0x0),      \
+          *current_stack ? (*current_stack)->id : 0,                    \
           (void *)new_SP, (void *)old_SP);                              \
                                                                         \
    /* Check if the stack pointer is still in the same stack as before. */ \
-   if (UNLIKELY(current_stack == NULL ||                                \
-      new_SP < current_stack->start || new_SP > current_stack->end)) {  \
+   if (UNLIKELY(*current_stack == NULL ||                               \
+      new_SP < (*current_stack)->start || new_SP > (*current_stack)->end)) { \
       Stack* new_stack = find_stack_by_addr(new_SP);                    \
-      if (new_stack                                                     \
-          && (current_stack == NULL || new_stack->id != current_stack->id)) { \
-         /* The stack pointer is now in another stack.  Update the current */ \
-         /* stack information and return without doing anything else. */ \
-         current_stack = new_stack;                                     \
-         EDEBUG("new current_stack  %p-%p %lu \n",                      \
-                (void *) current_stack->start,                          \
-                (void *) current_stack->end,                            \
-                current_stack->id);                                     \
-         return;                                                        \
+      if (new_stack && new_stack != *current_stack) {                   \
+         /* A thread that hasn't been seen in a stack yet may just */   \
+         /* be moving within this one. */                               \
+         Bool switched = *current_stack != NULL                         \
+                         || old_SP < new_stack->start                   \
+                         || old_SP > new_stack->end;                    \
+         *current_stack = new_stack;                                    \
+         if (switched) {                                                \
+            /* The stack pointer is now in another stack.  Update the */ \
+            /* current stack information and return without doing */   \
+            /* anything else. */                                        \
+            EDEBUG("new current_stack  %p-%p %lu \n",                   \
+                   (void *) new_stack->start,                           \
+                   (void *) new_stack->end,                             \
+                   new_stack->id);                                      \
+            return;                                                     \
+         }                                                              \
       } else                                                            \
          EDEBUG("new current_stack not found\n");                       \
    }
@@ -33,11 +33,13 @@
 #include "pub_core_libcsetjmp.h"    // to keep _threadstate.h happy
 #include "pub_core_threadstate.h"
 #include "pub_core_debuginfo.h"     // XXX: circular dependency
+#include "pub_core_hashtable.h"
 #include "pub_core_aspacemgr.h"     // For VG_(is_addressable)()
 #include "pub_core_libcbase.h"
 #include "pub_core_libcassert.h"
 #include "pub_core_libcprint.h"
 #include "pub_core_machine.h"
+#include "pub_core_mallocfree.h"
 #include "pub_core_options.h"
 #include "pub_core_stacks.h"        // VG_(stack_limits)
 #include "pub_core_stacktrace.h"
@@ -454,6 +456,61 @@ UInt VG_(get_StackTrace_wrk) ( ThreadId tid_if_known,
 
 #if defined(VGP_amd64_linux) || defined(VGP_amd64_darwin)
 
+/* Allocation-heavy code unwinds the same outer frames over and over,
+   so each thread keeps the frames of its last stack trace, along with
+   where in memory each frame's return address and %rbp were read
+   from.  Once the unwind reaches a frame with the same (ip,sp,fp) as
+   one of those, the following ones are spliced in for as long as the
+   words they were read from still hold the same values: as they
+   were found by the same unwind rules from the same registers and
+   memory, unwinding them again would give the same result.  Frames
+   which can't be checked like that (those found using CFI
+   expressions, the stack scanning hack, or the %rbp chain as a
+   fallback for missing CFI) have a ra_slot of 0, and end the
+   splicing.
+
+   Each trace is recorded in the other half of frames[], so that the
+   last one can be spliced from as the new one is made.  The frames
+   are forgotten when the CFI changes. */
+
+#define N_CACHED_FRAMES  64
+#define MIN_CACHED_TRACE 16
+
+typedef
+   struct {
+      Addr ip;       /* regs after unwinding to this frame, as */
+      Addr sp;       /* passed on to the next step */
+      Addr fp;
+      Addr ra_slot;  /* where ip+1 was read from, or 0 */
+      Addr bp_slot;  /* where fp was read from, or 0 if unchanged */
+   }
+   CachedFrame;
+
+typedef
+   struct {
+      UInt        generation;  /* VG_(CF_info_generation) when made */
+      UInt        n_frames;    /* in frames[last] */
+      UInt        last;
+      CachedFrame frames[2][N_CACHED_FRAMES];
+   }
+   FrameCache;
+
+static FrameCache** frame_caches = NULL;   /* [VG_N_THREADS] */
+
+/* Can the step from the frame before f to f be repeated, given that
+   the regs it was unwound from are the same as before? */
+static inline Bool cached_frame_ok ( const CachedFrame* f, Addr prev_fp,
+                                     Addr fp_min, Addr fp_max )
+{
+   if (f->ra_slot < fp_min || f->ra_slot > fp_max - sizeof(Addr)
+       || *(UWord*)f->ra_slot != f->ip + 1)
+      return False; /* also the case for a ra_slot of 0 */
+   if (f->bp_slot == 0)
+      return f->fp == prev_fp;
+   return fp_min <= f->bp_slot && f->bp_slot <= fp_max - sizeof(Addr)
+          && *(UWord*)f->bp_slot == f->fp;
+}
+
 UInt VG_(get_StackTrace_wrk) ( ThreadId tid_if_known,
                                /*OUT*/Addr* ips, UInt max_n_ips,
                                /*OUT*/Addr* sps, /*OUT*/Addr* fps,
@@ -510,10 +567,49 @@ UInt VG_(get_StackTrace_wrk) ( ThreadId tid_if_known,
 
    /* fp is %rbp.  sp is %rsp.  ip is %rip. */
 
+   /* Find the frames of the thread's last stack trace, if it has one
+      which is still valid, and where to record this one.  Frame
+      merging rewrites ips[] as it goes, so isn't catered for, and
+      short stack traces don't repay the bookkeeping. */
+   FrameCache*  fc = NULL;
+   CachedFrame* cached = NULL;
+   CachedFrame* record = NULL;
+   UInt         n_cached = 0, c = 1;
+   UInt         generation = VG_(CF_info_generation)();
+   if (tid_if_known != VG_INVALID_THREADID && tid_if_known < VG_N_THREADS
+       && cmrf == 0 && max_n_ips >= MIN_CACHED_TRACE) {
+      if (UNLIKELY(frame_caches == NULL))
+         frame_caches = VG_(calloc)("stacktrace.gsw.2", VG_N_THREADS,
+                                    sizeof(FrameCache*));
+      fc = frame_caches[tid_if_known];
+      if (UNLIKELY(fc == NULL)) {
+         fc = VG_(malloc)("stacktrace.gsw.1", sizeof(FrameCache));
+         fc->n_frames = 0;
+         fc->last = 0;
+         frame_caches[tid_if_known] = fc;
+      } else if (fc->generation == generation) {
+         cached = fc->frames[fc->last];
+         n_cached = fc->n_frames;
+      }
+      record = fc->frames[1 - fc->last];
+   }
+
+#  define RECORD_FRAME(_ra_slot, _bp_slot)                    \
+      do {                                                     \
+         if (record != NULL && i-1 < N_CACHED_FRAMES) {        \
+            record[i-1].ip = uregs.xip;                        \
+            record[i-1].sp = uregs.xsp;                        \
+            record[i-1].fp = uregs.xbp;                        \
+            record[i-1].ra_slot = (_ra_slot);                  \
+            record[i-1].bp_slot = (_bp_slot);                  \
+         }                                                     \
+      } while (0)
+
    ips[0] = uregs.xip;
    if (sps) sps[0] = uregs.xsp;
    if (fps) fps[0] = uregs.xbp;
    i = 1;
+   RECORD_FRAME(0, 0);
 
    /* Loop unwinding the stack. Note that the IP value we get on
     * each pass (whether from CFI info or a stack frame) is a
@@ -535,11 +631,55 @@ UInt VG_(get_StackTrace_wrk) ( ThreadId tid_if_known,
       if (i >= max_n_ips)
          break;
 
+      /* Have we got back to a frame of the last stack trace?  Only
+         looked for from frame 1 on, as the step from frame 0 is
+         never done with --unw-frame-pointer=yes's %rbp chain. */
+      if (cached != NULL && i >= 2) {
+         while (c < n_cached && cached[c].sp < uregs.xsp)
+            c++;
+         if (c < n_cached && cached[c].sp == uregs.xsp
+             && cached[c].ip == uregs.xip && cached[c].fp == uregs.xbp) {
+            /* Yes: splice in the frames after it, as far as they
+               are still right. */
+            for (c++; c < n_cached && i < max_n_ips; c++) {
+               if (!cached_frame_ok(&cached[c], uregs.xbp, fp_min, fp_max))
+                  break;
+               uregs.xip = cached[c].ip;
+               uregs.xsp = cached[c].sp;
+               uregs.xbp = cached[c].fp;
+               if (sps) sps[i] = uregs.xsp;
+               if (fps) fps[i] = uregs.xbp;
+               ips[i++] = uregs.xip;
+               if (debug)
+                  VG_(printf)("     ipsS[%d]=%#08lx\n", i-1, ips[i-1]);
+               RECORD_FRAME(cached[c].ra_slot, cached[c].bp_slot);
+            }
+            /* and carry on unwinding as usual from the last one. */
+            cached = NULL;
+            continue;
+         }
+      }
+
       /* Try to derive a new (ip,sp,fp) triple from the current set. */
 
+      /* Note: re "- 1 * sizeof(UWord)", need to take account of the
+         fact that we are prodding at & ((UWord*)fp)[1] and so need to
+         adjust the limit check accordingly.  Omitting this has been
+         observed to cause segfaults on rare occasions. */
+      Bool fp_ok = fp_min <= uregs.xbp
+                   && uregs.xbp <= fp_max - 1 * sizeof(UWord);
+
+      /* With --unw-frame-pointer=yes, the %rbp chain is believed
+         without looking for CFI, except for the innermost frame:
+         that may not have set up its frame yet. */
+      Bool fp_first = VG_(clo_unw_frame_pointer) && i > 1 && fp_ok;
+
       /* First off, see if there is any CFI info to hand which can
          be used. */
-      if ( VG_(use_CF_info)( &uregs, fp_min, fp_max ) ) {
+      Addr ra_slot, bp_slot;
+      if ( !fp_first
+           && VG_(use_CF_info_with_slots)( &uregs, fp_min, fp_max,
+                                           &ra_slot, &bp_slot ) ) {
          if (0 == uregs.xip || 1 == uregs.xip) break;
          if (sps) sps[i] = uregs.xsp;
          if (fps) fps[i] = uregs.xbp;
@@ -547,6 +687,9 @@ UInt VG_(get_StackTrace_wrk) ( ThreadId tid_if_known,
          if (debug)
             VG_(printf)("     ipsC[%d]=%#08lx\n", i-1, ips[i-1]);
          uregs.xip = uregs.xip - 1; /* as per comment at the head of this loop */
+         /* With --unw-frame-pointer=yes, whether this frame was
+            found with CFI depended on fp_min. */
+         RECORD_FRAME(VG_(clo_unw_frame_pointer) ? 0 : ra_slot, bp_slot);
          if (UNLIKELY(cmrf > 0)) {RECURSIVE_MERGE(cmrf,ips,i);};
          continue;
       }
@@ -559,12 +702,9 @@ UInt VG_(get_StackTrace_wrk) ( ThreadId tid_if_known,
          the start of the fn, like GDB does, there's no reliable way
          to tell.  Hence the hack of first trying out CFI, and if that
          fails, then use this as a fallback. */
-      /* Note: re "- 1 * sizeof(UWord)", need to take account of the
-         fact that we are prodding at & ((UWord*)fp)[1] and so need to
-         adjust the limit check accordingly.  Omitting this has been
-         observed to cause segfaults on rare occasions. */
-      if (fp_min <= uregs.xbp && uregs.xbp <= fp_max - 1 * sizeof(UWord)) {
+      if (fp_ok) {
          /* fp looks sane, so use it. */
+         Addr fp_slot = uregs.xbp;
          uregs.xip = (((UWord*)uregs.xbp)[1]);
          if (0 == uregs.xip || 1 == uregs.xip) break;
          uregs.xsp = uregs.xbp + sizeof(Addr) /*saved %rbp*/ 
@@ -576,6 +716,11 @@ UInt VG_(get_StackTrace_wrk) ( ThreadId tid_if_known,
          if (debug)
             VG_(printf)("     ipsF[%d]=%#08lx\n", i-1, ips[i-1]);
          uregs.xip = uregs.xip - 1; /* as per comment at the head of this loop */
+         /* Only repeatable if the CFI wasn't passed over. */
+         if (fp_first)
+            RECORD_FRAME(fp_slot + sizeof(Addr), fp_slot);
+         else
+            RECORD_FRAME(0, 0);
          if (UNLIKELY(cmrf > 0)) {RECURSIVE_MERGE(cmrf,ips,i);};
          continue;
       }
@@ -606,6 +751,7 @@ UInt VG_(get_StackTrace_wrk) ( ThreadId tid_if_known,
             VG_(printf)("     ipsH[%d]=%#08lx\n", i-1, ips[i-1]);
          uregs.xip = uregs.xip - 1; /* as per comment at the head of this loop */
          uregs.xsp += 8;
+         RECORD_FRAME(0, 0);
          if (UNLIKELY(cmrf > 0)) {RECURSIVE_MERGE(cmrf,ips,i);};
          continue;
       }
@@ -614,10 +760,24 @@ UInt VG_(get_StackTrace_wrk) ( ThreadId tid_if_known,
       break;
    }
 
+#  undef RECORD_FRAME
+
+   if (fc != NULL) {
+      fc->last = 1 - fc->last;
+      fc->n_frames = i < N_CACHED_FRAMES ? i : N_CACHED_FRAMES;
+      /* Looking for the CFI may have caused some to be read. */
+      if (VG_(CF_info_generation)() != generation)
+         fc->n_frames = 0;
+      fc->generation = generation;
+   }
+
    n_found = i;
    return n_found;
 }
 
+#undef N_CACHED_FRAMES
+#undef MIN_CACHED_TRACE
+
 #endif
 
 /* -----------------------ppc32/64 ---------------------- */
@@ -1445,17 +1605,82 @@ UInt VG_(get_StackTrace) ( ThreadId tid,
                                        stack_highest_byte);
 }
 
+/* With --xml-stack-refs=yes, a stack trace coming from an ExeContext
+   is printed in full the first time as <stack id="N">, and afterwards
+   as <stack ref="N"/>.  Likewise each frame is printed in full the
+   first time as <frame id="N">, and afterwards as <frame ref="N"/>.
+   The frames of a code address get consecutive ids (there is more
+   than one if the address is in inlined code), so they are recorded
+   by their code address with the id of the first of them and their
+   number.  The same address can be described differently once debug
+   info has been loaded or discarded, so everything recorded is
+   forgotten then, and fresh ids are given out. */
+
+typedef
+   struct _XmlRef {
+      struct _XmlRef* next;
+      UWord key;      /* code address for a frame, ECU for a stack */
+      UInt  id;
+      UInt  n_frames; /* frames only */
+   }
+   XmlRef;
+
+static VgHashTable xml_frame_refs = NULL;
+static VgHashTable xml_stack_refs = NULL;
+static UInt xml_refs_generation;
+static UInt xml_next_frame_id = 1;
+static UInt xml_next_stack_id = 1;
+
+static void init_xml_refs ( void )
+{
+   UInt generation = VG_(CF_info_generation)();
+
+   if (xml_frame_refs != NULL && xml_refs_generation == generation)
+      return;
+   if (xml_frame_refs != NULL) {
+      VG_(HT_destruct)(xml_frame_refs, VG_(free));
+      VG_(HT_destruct)(xml_stack_refs, VG_(free));
+   }
+   xml_frame_refs = VG_(HT_construct)("stacktrace.xml_frame_refs");
+   xml_stack_refs = VG_(HT_construct)("stacktrace.xml_stack_refs");
+   xml_refs_generation = generation;
+}
+
 static void printIpDesc(UInt n, Addr ip, void* uu_opaque)
 {
    #define BUF_LEN   4096
    
    static HChar buf[BUF_LEN];
 
-   InlIPCursor *iipc = VG_(new_IIPC)(ip);
+   InlIPCursor *iipc;
+   XmlRef *ref = NULL;
+
+   if (VG_(clo_xml) && VG_(clo_xml_stack_refs)) {
+      UInt i;
+      ref = VG_(HT_lookup)(xml_frame_refs, ip);
+      if (ref != NULL) {
+         for (i = 0; i < ref->n_frames; i++)
+            VG_(printf_xml)("    <frame ref=\"%u\"/>\n", ref->id + i);
+         return;
+      }
+      ref = VG_(malloc)("stacktrace.printIpDesc.1", sizeof(XmlRef));
+      ref->key = ip;
+      ref->id = xml_next_frame_id;
+      ref->n_frames = 0;
+      VG_(HT_add_node)(xml_frame_refs, ref);
+   }
+
+   iipc = VG_(new_IIPC)(ip);
 
    do {
       VG_(describe_IP)(ip, buf, BUF_LEN, iipc);
-      if (VG_(clo_xml)) {
+      if (ref != NULL) {
+         /* Give the <frame> at the start of buf an id. */
+         vg_assert(VG_(strncmp)(buf, "<frame>", 7) == 0);
+         VG_(printf_xml)("    <frame id=\"%u\">%s\n",
+                         xml_next_frame_id++, buf + 7);
+         ref->n_frames++;
+      } else if (VG_(clo_xml)) {
          VG_(printf_xml)("    %s\n", buf);
       } else {
          VG_(message)(Vg_UserMsg, "   %s %s\n", 
@@ -1467,13 +1692,30 @@ static void printIpDesc(UInt n, Addr ip, void* uu_opaque)
    VG_(delete_IIPC)(iipc);
 }
 
-/* Print a StackTrace. */
-void VG_(pp_StackTrace) ( StackTrace ips, UInt n_ips )
+/* Print a StackTrace, that of the ExeContext ecu if ecu isn't 0. */
+static void pp_StackTrace_wrk ( UInt ecu, StackTrace ips, UInt n_ips )
 {
    vg_assert( n_ips > 0 );
 
-   if (VG_(clo_xml))
+   if (VG_(clo_xml) && VG_(clo_xml_stack_refs)) {
+      init_xml_refs();
+      if (ecu == 0) {
+         VG_(printf_xml)("  <stack>\n");
+      } else {
+         XmlRef *ref = VG_(HT_lookup)(xml_stack_refs, ecu);
+         if (ref != NULL) {
+            VG_(printf_xml)("  <stack ref=\"%u\"/>\n", ref->id);
+            return;
+         }
+         ref = VG_(malloc)("stacktrace.pp_StackTrace_wrk.1", sizeof(XmlRef));
+         ref->key = ecu;
+         ref->id = xml_next_stack_id++;
+         VG_(HT_add_node)(xml_stack_refs, ref);
+         VG_(printf_xml)("  <stack id=\"%u\">\n", ref->id);
+      }
+   } else if (VG_(clo_xml)) {
       VG_(printf_xml)("  <stack>\n");
+   }
 
    VG_(apply_StackTrace)( printIpDesc, NULL, ips, n_ips );
 
@@ -1481,6 +1723,18 @@ void VG_(pp_StackTrace) ( StackTrace ips, UInt n_ips )
       VG_(printf_xml)("  </stack>\n");
 }
 
+/* Print a StackTrace. */
+void VG_(pp_StackTrace) ( StackTrace ips, UInt n_ips )
+{
+   pp_StackTrace_wrk( 0, ips, n_ips );
+}
+
+void VG_(pp_StackTrace_of_ECU) ( UInt ecu, StackTrace ips, UInt n_ips )
+{
+   vg_assert( ecu != 0 );
+   pp_StackTrace_wrk( ecu, ips, n_ips );
+}
+
 /* Get and immediately print a StackTrace. */
 void VG_(get_and_pp_StackTrace) ( ThreadId tid, UInt max_n_ips )
 {
@@ -53,6 +53,21 @@ Bool ML_(valid_client_addr)(Addr start, SizeT size, ThreadId tid,
    user-visible errors. */
 extern Bool ML_(safe_to_deref) ( void* start, SizeT size );
 
+/* PRE_MEM_READ, PRE_MEM_WRITE and POST_MEM_WRITE for the first 'max_len'
+   bytes of the buffers described by an iovec, e.g. for readv and
+   writev.  A "%u" in 's' is replaced by the index of the buffer in any
+   error message.  They do nothing if the iovec itself can't be read; the
+   caller has to check it with PRE_MEM_READ. */
+extern void ML_(pre_mem_read_iov)   ( ThreadId tid, const HChar* s,
+                                      const struct vki_iovec* iov,
+                                      UInt n_iov, SizeT max_len );
+extern void ML_(pre_mem_write_iov)  ( ThreadId tid, const HChar* s,
+                                      const struct vki_iovec* iov,
+                                      UInt n_iov, SizeT max_len );
+extern void ML_(post_mem_write_iov) ( ThreadId tid,
+                                      const struct vki_iovec* iov,
+                                      UInt n_iov, SizeT max_len );
+
 // Returns True if the signal is OK for the client to use.
 extern Bool ML_(client_signal_OK)(Int sigNo);
 
@@ -36,6 +36,7 @@
 
 /* requires #include "pub_core_options.h" */
 /* requires #include "pub_core_signals.h" */
+/* requires #include "pub_core_transtab.h" */
 
 /* This header defines types and macros which are useful for writing
    syscall wrappers.  It does not give prototypes for any such
@@ -604,8 +605,13 @@ static inline UWord getERR ( SyscallStatus* st ) {
 #define PRE_MEM_RASCIIZ(zzname, zzaddr) \
    VG_TRACK( pre_mem_read_asciiz, Vg_CoreSysCall, tid, zzname, zzaddr)
 
+/* The kernel will not take write faults on pages write-protected by
+   --smc-check=protect, so unprotect them first. */
 #define PRE_MEM_WRITE(zzname, zzaddr, zzlen) \
-   VG_TRACK( pre_mem_write, Vg_CoreSysCall, tid, zzname, zzaddr, zzlen)
+   do { \
+      VG_(smc_unprotect)(zzaddr, zzlen); \
+      VG_TRACK( pre_mem_write, Vg_CoreSysCall, tid, zzname, zzaddr, zzlen); \
+   } while (0)
 
 #define POST_MEM_WRITE(zzaddr, zzlen) \
    VG_TRACK( post_mem_write, Vg_CoreSysCall, tid, zzaddr, zzlen)
@@ -49,6 +49,7 @@
 #include "pub_core_syscall.h"
 #include "pub_core_syswrap.h"
 #include "pub_core_tooliface.h"
+#include "pub_core_transtab.h"       // VG_(smc_unprotect), for PRE_MEM_WRITE
 #include "pub_core_stacks.h"        // VG_(register_stack)
 
 #include "priv_types_n_macros.h"
@@ -1068,7 +1069,9 @@ static SyscallTableEntry syscall_table[] = {
 //   LIN__(__NR_sched_getattr,     sys_ni_syscall),       // 315
 //   LIN__(__NR_renameat2,         sys_ni_syscall),       // 316
 //   LIN__(__NR_seccomp,           sys_ni_syscall),       // 317
-   LINXY(__NR_getrandom,         sys_getrandom)         // 318
+   LINXY(__NR_getrandom,         sys_getrandom),        // 318
+   GENX_(334, sys_ni_syscall), /* LOCALTEST rseq */
+   GENX_(435, sys_ni_syscall) /* LOCALTEST clone3 */
 //   LIN__(__NR_memfd_create,      sys_ni_syscall),       // 319
 
 //   LIN__(__NR_kexec_file_load,   sys_ni_syscall),       // 320
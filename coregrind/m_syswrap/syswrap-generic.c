@@ -262,6 +262,9 @@ ML_(notify_core_and_tool_of_mprotect) ( Addr a, SizeT len, Int prot )
    if (d)
       VG_(discard_translations)( (Addr64)a, (ULong)len, 
                                  "ML_(notify_core_and_tool_of_mprotect)" );
+   /* The kernel has given write permission back to any pages still
+      write-protected for --smc-check=protect. */
+   VG_(smc_reprotect)( a, len );
 }
 
 
@@ -322,6 +325,11 @@ SysRes do_mremap( Addr old_addr, SizeT old_len,
    if (!ML_(valid_client_addr)(old_addr, old_len, tid, "mremap(old_addr)"))
       goto eINVAL;
 
+   /* Moved pages keep their real permissions, so any which are
+      write-protected for --smc-check=protect must be unprotected
+      first. */
+   VG_(smc_unprotect)( old_addr, old_len );
+
    /* In all remaining cases, if the old range does not fall within a
       single segment, fail. */
    old_seg = VG_(am_find_nsegment)( old_addr );
@@ -908,6 +916,109 @@ void VG_(init_preopened_fds)(void)
 #endif
 }
 
+/* ---------------------------------------------------------------------
+   Checking the buffers of an iovec
+   ------------------------------------------------------------------ */
+
+typedef enum { IovPreRead, IovPreWrite, IovPostWrite } IovEvent;
+
+/* Tell the tool about the first 'max_len' bytes of the buffers of 'iov',
+   all in one go if it can take them that way, otherwise one at a time. */
+static
+void track_iov ( IovEvent ev, ThreadId tid, const HChar* s,
+                 const struct vki_iovec* iov, UInt n_iov, SizeT max_len )
+{
+   HChar* name = NULL;
+   SizeT  left, len;
+   UInt   i;
+
+   if (iov == NULL
+       || n_iov > ~(SizeT)0 / sizeof(struct vki_iovec)
+       || !ML_(safe_to_deref)((void*)iov, n_iov * sizeof(struct vki_iovec)))
+      return;
+
+   if (ev == IovPreWrite) {
+      left = max_len;
+      for (i = 0; i < n_iov && left > 0; i++) {
+         len = iov[i].iov_len < left ? iov[i].iov_len : left;
+         VG_(smc_unprotect)((Addr)iov[i].iov_base, len);
+         left -= len;
+      }
+   }
+
+   switch (ev) {
+      case IovPreRead:
+         if (VG_(tdict).track_pre_mem_read_iov) {
+            VG_(tdict).track_pre_mem_read_iov(Vg_CoreSysCall, tid, s,
+                                              iov, n_iov, max_len);
+            return;
+         }
+         break;
+      case IovPreWrite:
+         if (VG_(tdict).track_pre_mem_write_iov) {
+            VG_(tdict).track_pre_mem_write_iov(Vg_CoreSysCall, tid, s,
+                                               iov, n_iov, max_len);
+            return;
+         }
+         break;
+      case IovPostWrite:
+         if (VG_(tdict).track_post_mem_write_iov) {
+            VG_(tdict).track_post_mem_write_iov(Vg_CoreSysCall, tid,
+                                                iov, n_iov, max_len);
+            return;
+         }
+         break;
+   }
+
+   if (s != NULL && VG_(strchr)(s, '%') != NULL)
+      name = VG_(arena_malloc)(VG_AR_CORE, "syswrap.track_iov.1",
+                               VG_(strlen)(s) + 11);
+   left = max_len;
+   for (i = 0; i < n_iov && left > 0; i++) {
+      len = iov[i].iov_len < left ? iov[i].iov_len : left;
+      left -= len;
+      if (name)
+         VG_(sprintf)(name, s, i);
+      switch (ev) {
+         case IovPreRead:
+            VG_TRACK( pre_mem_read, Vg_CoreSysCall, tid, name ? name : s,
+                      (Addr)iov[i].iov_base, len );
+            break;
+         case IovPreWrite:
+            VG_TRACK( pre_mem_write, Vg_CoreSysCall, tid, name ? name : s,
+                      (Addr)iov[i].iov_base, len );
+            break;
+         case IovPostWrite:
+            VG_TRACK( post_mem_write, Vg_CoreSysCall, tid,
+                      (Addr)iov[i].iov_base, len );
+            break;
+      }
+   }
+   if (name)
+      VG_(arena_free)(VG_AR_CORE, name);
+}
+
+void ML_(pre_mem_read_iov) ( ThreadId tid, const HChar* s,
+                             const struct vki_iovec* iov, UInt n_iov,
+                             SizeT max_len )
+{
+   track_iov(IovPreRead, tid, s, iov, n_iov, max_len);
+}
+
+void ML_(pre_mem_write_iov) ( ThreadId tid, const HChar* s,
+                              const struct vki_iovec* iov, UInt n_iov,
+                              SizeT max_len )
+{
+   track_iov(IovPreWrite, tid, s, iov, n_iov, max_len);
+}
+
+void ML_(post_mem_write_iov) ( ThreadId tid,
+                               const struct vki_iovec* iov, UInt n_iov,
+                               SizeT max_len )
+{
+   track_iov(IovPostWrite, tid, NULL, iov, n_iov, max_len);
+}
+
 static
 HChar *strdupcat ( const HChar* cc, const HChar *s1, const HChar *s2,
                    ArenaId aid )
@@ -949,6 +1060,36 @@ void post_mem_write_recvmsg ( ThreadId tid, Bool read,
    if ( !read )
       POST_MEM_WRITE( base, size );
 }
+
+static
+void pre_mem_read_sendmsg_iov ( ThreadId tid, const HChar *msg,
+                                struct vki_iovec *iov, UInt n_iov,
+                                SizeT length )
+{
+   HChar *outmsg = strdupcat ( "di.syswrap.pmrs.2",
+                               "sendmsg", msg, VG_AR_CORE );
+   ML_(pre_mem_read_iov) ( tid, outmsg, iov, n_iov, length );
+   VG_(arena_free) ( VG_AR_CORE, outmsg );
+}
+
+static
+void pre_mem_write_recvmsg_iov ( ThreadId tid, const HChar *msg,
+                                 struct vki_iovec *iov, UInt n_iov,
+                                 SizeT length )
+{
+   HChar *outmsg = strdupcat ( "di.syswrap.pmwr.2",
+                               "recvmsg", msg, VG_AR_CORE );
+   ML_(pre_mem_write_iov) ( tid, outmsg, iov, n_iov, length );
+   VG_(arena_free) ( VG_AR_CORE, outmsg );
+}
+
+static
+void post_mem_write_recvmsg_iov ( ThreadId tid, const HChar *fieldName,
+                                  struct vki_iovec *iov, UInt n_iov,
+                                  SizeT length )
+{
+   ML_(post_mem_write_iov) ( tid, iov, n_iov, length );
+}
  
 static
 void msghdr_foreachfield ( 
@@ -957,6 +1098,8 @@ void msghdr_foreachfield (
         struct vki_msghdr *msg,
         UInt length,
         void (*foreach_func)( ThreadId, Bool, const HChar *, Addr, SizeT ),
+        void (*foreach_iov_func)( ThreadId, const HChar *,
+                                  struct vki_iovec *, UInt, SizeT ),
         Bool rekv /* "recv" apparently shadows some header decl on OSX108 */
      )
 {
@@ -991,20 +1134,15 @@ void msghdr_foreachfield (
    if ( ML_(safe_to_deref)(&msg->msg_iov, sizeof (void *))
         && msg->msg_iov ) {
       struct vki_iovec *iov = msg->msg_iov;
-      UInt i;
 
       VG_(sprintf) ( fieldName, "(%s.msg_iov)", name );
 
       foreach_func ( tid, True, fieldName, 
                      (Addr)iov, msg->msg_iovlen * sizeof( struct vki_iovec ) );
 
-      for ( i = 0; i < msg->msg_iovlen; ++i, ++iov ) {
-         UInt iov_len = iov->iov_len <= length ? iov->iov_len : length;
-         VG_(sprintf) ( fieldName, "(%s.msg_iov[%u])", name, i );
-         foreach_func ( tid, False, fieldName, 
-                        (Addr)iov->iov_base, iov_len );
-         length = length - iov_len;
-      }
+      /* The "%u" is filled in with the index of the buffer. */
+      VG_(sprintf) ( fieldName, "(%s.msg_iov[%%u])", name );
+      foreach_iov_func ( tid, fieldName, iov, msg->msg_iovlen, length );
    }
 
    if ( ML_(safe_to_deref) (&msg->msg_control, sizeof (void *))
@@ -1661,7 +1799,8 @@ void
 ML_(generic_PRE_sys_sendmsg) ( ThreadId tid, const HChar *name,
                                struct vki_msghdr *msg )
 {
-   msghdr_foreachfield ( tid, name, msg, ~0, pre_mem_read_sendmsg, False );
+   msghdr_foreachfield ( tid, name, msg, ~0, pre_mem_read_sendmsg,
+                         pre_mem_read_sendmsg_iov, False );
 }
 
 /* ------ */
@@ -1670,14 +1809,16 @@ void
 ML_(generic_PRE_sys_recvmsg) ( ThreadId tid, const HChar *name,
                                struct vki_msghdr *msg )
 {
-   msghdr_foreachfield ( tid, name, msg, ~0, pre_mem_write_recvmsg, True );
+   msghdr_foreachfield ( tid, name, msg, ~0, pre_mem_write_recvmsg,
+                         pre_mem_write_recvmsg_iov, True );
 }
 
 void 
 ML_(generic_POST_sys_recvmsg) ( ThreadId tid, const HChar *name,
                                 struct vki_msghdr *msg, UInt length )
 {
-   msghdr_foreachfield( tid, name, msg, length, post_mem_write_recvmsg, True );
+   msghdr_foreachfield( tid, name, msg, length, post_mem_write_recvmsg,
+                        post_mem_write_recvmsg_iov, True );
    check_cmsg_for_fds( tid, msg );
 }
 
@@ -2932,6 +3073,9 @@ PRE(sys_execve)
             VG_(printf)("env: %s\n", *cpp);
    }
 
+   /* The buffered output would be lost. */
+   VG_(flush_output_sinks)();
+
    SET_STATUS_from_SysRes( 
       VG_(do_syscall3)(__NR_execve, (UWord)path, (UWord)argv, (UWord)envp) 
    );
@@ -3145,6 +3289,9 @@ PRE(sys_fork)
    VG_(sigfillset)(&mask);
    VG_(sigprocmask)(VKI_SIG_SETMASK, &mask, &fork_saved_mask);
 
+   /* Write out the buffered output now, else both processes would. */
+   VG_(flush_output_sinks)();
+
    SET_STATUS_from_SysRes( VG_(do_syscall0)(__NR_fork) );
 
    if (!SUCCESS) return;
@@ -3918,7 +4065,9 @@ PRE(sys_poll)
    */
    UInt i;
    struct vki_pollfd* ufds = (struct vki_pollfd *)ARG1;
-   *flags |= SfMayBlock;
+   /* A zero timeout only polls, so does not need to drop the big lock. */
+   if ((Int)ARG3 != 0)
+      *flags |= SfMayBlock;
    PRINT("sys_poll ( %#lx, %ld, %ld )\n", ARG1,ARG2,ARG3);
    PRE_REG_READ3(long, "poll",
                  struct vki_pollfd *, ufds, unsigned int, nfds, long, timeout);
@@ -3984,8 +4133,6 @@ PRE(sys_readlink)
 
 PRE(sys_readv)
 {
-   Int i;
-   struct vki_iovec * vec;
    *flags |= SfMayBlock;
    PRINT("sys_readv ( %ld, %#lx, %llu )",ARG1,ARG2,(ULong)ARG3);
    PRE_REG_READ3(ssize_t, "readv",
@@ -3995,34 +4142,17 @@ PRE(sys_readv)
       SET_STATUS_Failure( VKI_EBADF );
    } else {
       PRE_MEM_READ( "readv(vector)", ARG2, ARG3 * sizeof(struct vki_iovec) );
-
-      if (ARG2 != 0) {
-         /* ToDo: don't do any of the following if the vector is invalid */
-         vec = (struct vki_iovec *)ARG2;
-         for (i = 0; i < (Int)ARG3; i++)
-            PRE_MEM_WRITE( "readv(vector[...])",
-                           (Addr)vec[i].iov_base, vec[i].iov_len );
-      }
+      ML_(pre_mem_write_iov)( tid, "readv(vector[...])",
+                              (struct vki_iovec *)ARG2, ARG3, ~(SizeT)0 );
    }
 }
 
 POST(sys_readv)
 {
    vg_assert(SUCCESS);
-   if (RES > 0) {
-      Int i;
-      struct vki_iovec * vec = (struct vki_iovec *)ARG2;
-      Int remains = RES;
-
-      /* RES holds the number of bytes read. */
-      for (i = 0; i < (Int)ARG3; i++) {
-	 Int nReadThisBuf = vec[i].iov_len;
-	 if (nReadThisBuf > remains) nReadThisBuf = remains;
-	 POST_MEM_WRITE( (Addr)vec[i].iov_base, nReadThisBuf );
-	 remains -= nReadThisBuf;
-	 if (remains < 0) VG_(core_panic)("readv: remains < 0");
-      }
-   }
+   /* RES holds the number of bytes read. */
+   if (RES > 0)
+      ML_(post_mem_write_iov)( tid, (struct vki_iovec *)ARG2, ARG3, RES );
 }
 
 PRE(sys_rename)
@@ -4307,8 +4437,6 @@ POST(sys_wait4)
 
 PRE(sys_writev)
 {
-   Int i;
-   struct vki_iovec * vec;
    *flags |= SfMayBlock;
    PRINT("sys_writev ( %ld, %#lx, %llu )",ARG1,ARG2,(ULong)ARG3);
    PRE_REG_READ3(ssize_t, "writev",
@@ -4319,13 +4447,8 @@ PRE(sys_writev)
    } else {
       PRE_MEM_READ( "writev(vector)", 
 		     ARG2, ARG3 * sizeof(struct vki_iovec) );
-      if (ARG2 != 0) {
-         /* ToDo: don't do any of the following if the vector is invalid */
-         vec = (struct vki_iovec *)ARG2;
-         for (i = 0; i < (Int)ARG3; i++)
-            PRE_MEM_READ( "writev(vector[...])",
-                           (Addr)vec[i].iov_base, vec[i].iov_len );
-      }
+      ML_(pre_mem_read_iov)( tid, "writev(vector[...])",
+                             (struct vki_iovec *)ARG2, ARG3, ~(SizeT)0 );
    }
 }
 
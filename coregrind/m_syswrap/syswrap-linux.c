@@ -434,6 +434,9 @@ SysRes ML_(do_fork_clone) ( ThreadId tid, UInt flags,
    VG_(sigfillset)(&mask);
    VG_(sigprocmask)(VKI_SIG_SETMASK, &mask, &fork_saved_mask);
 
+   /* Write out the buffered output now, else both processes would. */
+   VG_(flush_output_sinks)();
+
    VG_(do_atfork_pre)(tid);
 
    /* Since this is the fork() form of clone, we don't need all that
@@ -1161,7 +1164,20 @@ PRE(sys_futex)
       break;
    }
 
-   *flags |= SfMayBlock;
+   /* The wake and requeue operations never block, so they can be done
+      without dropping the big lock: this saves two lock handoffs for
+      each unlock of a contended mutex in the client. */
+   switch(ARG2 & ~(VKI_FUTEX_PRIVATE_FLAG|VKI_FUTEX_CLOCK_REALTIME)) {
+   case VKI_FUTEX_WAKE:
+   case VKI_FUTEX_WAKE_BITSET:
+   case VKI_FUTEX_WAKE_OP:
+   case VKI_FUTEX_REQUEUE:
+   case VKI_FUTEX_CMP_REQUEUE:
+      break;
+   default:
+      *flags |= SfMayBlock;
+      break;
+   }
 
    switch(ARG2 & ~(VKI_FUTEX_PRIVATE_FLAG|VKI_FUTEX_CLOCK_REALTIME)) {
    case VKI_FUTEX_WAIT:
@@ -1359,7 +1375,9 @@ PRE(sys_epoll_ctl)
 
 PRE(sys_epoll_wait)
 {
-   *flags |= SfMayBlock;
+   /* A zero timeout only polls, so does not need to drop the big lock. */
+   if ((Int)ARG4 != 0)
+      *flags |= SfMayBlock;
    PRINT("sys_epoll_wait ( %ld, %#lx, %ld, %ld )", ARG1, ARG2, ARG3, ARG4);
    PRE_REG_READ4(long, "epoll_wait",
                  int, epfd, struct vki_epoll_event *, events,
@@ -1375,7 +1393,8 @@ POST(sys_epoll_wait)
 
 PRE(sys_epoll_pwait)
 {
-   *flags |= SfMayBlock;
+   if ((Int)ARG4 != 0)
+      *flags |= SfMayBlock;
    PRINT("sys_epoll_pwait ( %ld, %#lx, %ld, %ld, %#lx, %llu )", ARG1,ARG2,ARG3,ARG4,ARG5,(ULong)ARG6);
    PRE_REG_READ6(long, "epoll_pwait",
                  int, epfd, struct vki_epoll_event *, events,
@@ -1758,19 +1777,10 @@ POST(sys_io_getevents)
             break;
 
          case VKI_IOCB_CMD_PREADV:
-	     if (vev->result > 0) {
-                  struct vki_iovec * vec = (struct vki_iovec *)(Addr)cb->aio_buf;
-                  Int remains = vev->result;
-                  Int j;
-
-                  for (j = 0; j < cb->aio_nbytes; j++) {
-                       Int nReadThisBuf = vec[j].iov_len;
-                       if (nReadThisBuf > remains) nReadThisBuf = remains;
-                       POST_MEM_WRITE( (Addr)vec[j].iov_base, nReadThisBuf );
-                       remains -= nReadThisBuf;
-                       if (remains < 0) VG_(core_panic)("io_getevents(PREADV): remains < 0");
-                  }
-	     }
+	     if (vev->result > 0)
+                  ML_(post_mem_write_iov)( tid,
+                                           (struct vki_iovec *)(Addr)cb->aio_buf,
+                                           cb->aio_nbytes, vev->result );
              break;
 
          case VKI_IOCB_CMD_PWRITEV:
@@ -1788,7 +1798,7 @@ POST(sys_io_getevents)
 
 PRE(sys_io_submit)
 {
-   Int i, j;
+   Int i;
 
    PRINT("sys_io_submit ( %llu, %ld, %#lx )", (ULong)ARG1,ARG2,ARG3);
    PRE_REG_READ3(long, "io_submit",
@@ -1819,15 +1829,15 @@ PRE(sys_io_submit)
          case VKI_IOCB_CMD_PREADV:
             iov = (struct vki_iovec *)(Addr)cb->aio_buf;
             PRE_MEM_READ( "io_submit(PREADV)", cb->aio_buf, cb->aio_nbytes * sizeof(struct vki_iovec) );
-            for (j = 0; j < cb->aio_nbytes; j++)
-                PRE_MEM_WRITE( "io_submit(PREADV(iov[i]))", (Addr)iov[j].iov_base, iov[j].iov_len );
+            ML_(pre_mem_write_iov)( tid, "io_submit(PREADV(iov[i]))",
+                                    iov, cb->aio_nbytes, ~(SizeT)0 );
             break;
 
          case VKI_IOCB_CMD_PWRITEV:
             iov = (struct vki_iovec *)(Addr)cb->aio_buf;
             PRE_MEM_READ( "io_submit(PWRITEV)", cb->aio_buf, cb->aio_nbytes * sizeof(struct vki_iovec) );
-            for (j = 0; j < cb->aio_nbytes; j++)
-                PRE_MEM_READ( "io_submit(PWRITEV(iov[i]))", (Addr)iov[j].iov_base, iov[j].iov_len );
+            ML_(pre_mem_read_iov)( tid, "io_submit(PWRITEV(iov[i]))",
+                                   iov, cb->aio_nbytes, ~(SizeT)0 );
             break;
 
          default:
@@ -4646,8 +4656,6 @@ POST(sys_open_by_handle_at)
 
 PRE(sys_preadv)
 {
-   Int i;
-   struct vki_iovec * vec;
    *flags |= SfMayBlock;
 #if VG_WORDSIZE == 4
    /* Note that the offset argument here is in lo+hi order on both
@@ -4669,40 +4677,21 @@ PRE(sys_preadv)
       SET_STATUS_Failure( VKI_EBADF );
    } else {
       PRE_MEM_READ( "preadv(vector)", ARG2, ARG3 * sizeof(struct vki_iovec) );
-
-      if (ARG2 != 0) {
-         /* ToDo: don't do any of the following if the vector is invalid */
-         vec = (struct vki_iovec *)ARG2;
-         for (i = 0; i < (Int)ARG3; i++)
-            PRE_MEM_WRITE( "preadv(vector[...])",
-                           (Addr)vec[i].iov_base, vec[i].iov_len );
-      }
+      ML_(pre_mem_write_iov)( tid, "preadv(vector[...])",
+                              (struct vki_iovec *)ARG2, ARG3, ~(SizeT)0 );
    }
 }
 
 POST(sys_preadv)
 {
    vg_assert(SUCCESS);
-   if (RES > 0) {
-      Int i;
-      struct vki_iovec * vec = (struct vki_iovec *)ARG2;
-      Int remains = RES;
-
-      /* RES holds the number of bytes read. */
-      for (i = 0; i < (Int)ARG3; i++) {
-	 Int nReadThisBuf = vec[i].iov_len;
-	 if (nReadThisBuf > remains) nReadThisBuf = remains;
-	 POST_MEM_WRITE( (Addr)vec[i].iov_base, nReadThisBuf );
-	 remains -= nReadThisBuf;
-	 if (remains < 0) VG_(core_panic)("preadv: remains < 0");
-      }
-   }
+   /* RES holds the number of bytes read. */
+   if (RES > 0)
+      ML_(post_mem_write_iov)( tid, (struct vki_iovec *)ARG2, ARG3, RES );
 }
 
 PRE(sys_pwritev)
 {
-   Int i;
-   struct vki_iovec * vec;
    *flags |= SfMayBlock;
 #if VG_WORDSIZE == 4
    /* Note that the offset argument here is in lo+hi order on both
@@ -4725,13 +4714,8 @@ PRE(sys_pwritev)
    } else {
       PRE_MEM_READ( "pwritev(vector)", 
 		     ARG2, ARG3 * sizeof(struct vki_iovec) );
-      if (ARG2 != 0) {
-         /* ToDo: don't do any of the following if the vector is invalid */
-         vec = (struct vki_iovec *)ARG2;
-         for (i = 0; i < (Int)ARG3; i++)
-            PRE_MEM_READ( "pwritev(vector[...])",
-                           (Addr)vec[i].iov_base, vec[i].iov_len );
-      }
+      ML_(pre_mem_read_iov)( tid, "pwritev(vector[...])",
+                             (struct vki_iovec *)ARG2, ARG3, ~(SizeT)0 );
    }
 }
 
@@ -4754,27 +4738,13 @@ PRE(sys_process_vm_readv)
                  ARG2, ARG3 * sizeof(struct vki_iovec) );
    PRE_MEM_READ( "process_vm_readv(rvec)",
                  ARG4, ARG5 * sizeof(struct vki_iovec) );
-   if (ARG2 != 0) {
-      /* TODO: Don't do any of the following if lvec is invalid */
-      const struct vki_iovec *vec = (const struct vki_iovec *)ARG2;
-      UInt i;
-      for (i = 0; i < ARG3; i++)
-         PRE_MEM_WRITE( "process_vm_readv(lvec[...])",
-                        (Addr)vec[i].iov_base, vec[i].iov_len );
-   }
+   ML_(pre_mem_write_iov)( tid, "process_vm_readv(lvec[...])",
+                           (const struct vki_iovec *)ARG2, ARG3, ~(SizeT)0 );
 }
 
 POST(sys_process_vm_readv)
 {
-   const struct vki_iovec *vec = (const struct vki_iovec *)ARG2;
-   UInt remains = RES;
-   UInt i;
-   for (i = 0; i < ARG3; i++) {
-      UInt nReadThisBuf = vec[i].iov_len <= remains ?
-                          vec[i].iov_len : remains;
-      POST_MEM_WRITE( (Addr)vec[i].iov_base, nReadThisBuf );
-      remains -= nReadThisBuf;
-   }
+   ML_(post_mem_write_iov)( tid, (const struct vki_iovec *)ARG2, ARG3, RES );
 }
 
 PRE(sys_process_vm_writev)
@@ -4792,14 +4762,8 @@ PRE(sys_process_vm_writev)
                  ARG2, ARG3 * sizeof(struct vki_iovec) );
    PRE_MEM_READ( "process_vm_writev(rvec)",
                  ARG4, ARG5 * sizeof(struct vki_iovec) );
-   if (ARG2 != 0) {
-      /* TODO: Don't do any of the following if lvec is invalid */
-      const struct vki_iovec *vec = (const struct vki_iovec *)ARG2;
-      UInt i;
-      for (i = 0; i < ARG3; i++)
-         PRE_MEM_READ( "process_vm_writev(lvec[...])",
-                       (Addr)vec[i].iov_base, vec[i].iov_len );
-   }
+   ML_(pre_mem_read_iov)( tid, "process_vm_writev(lvec[...])",
+                          (const struct vki_iovec *)ARG2, ARG3, ~(SizeT)0 );
 }
 
 /* ---------------------------------------------------------------------
@@ -5124,16 +5088,13 @@ PRE(sys_vmsplice)
    } else if ((fdfl = VG_(fcntl)(ARG1, VKI_F_GETFL, 0)) < 0) {
       SET_STATUS_Failure( VKI_EBADF );
    } else {
-      const struct vki_iovec *iov;
       PRE_MEM_READ( "vmsplice(iov)", ARG2, sizeof(struct vki_iovec) * ARG3 );
-      for (iov = (struct vki_iovec *)ARG2;
-           iov < (struct vki_iovec *)ARG2 + ARG3; iov++) 
-      {
-         if ((fdfl & VKI_O_ACCMODE) == VKI_O_RDONLY)
-            PRE_MEM_WRITE( "vmsplice(iov[...])", (Addr)iov->iov_base, iov->iov_len );
-         else
-            PRE_MEM_READ( "vmsplice(iov[...])", (Addr)iov->iov_base, iov->iov_len );
-      }
+      if ((fdfl & VKI_O_ACCMODE) == VKI_O_RDONLY)
+         ML_(pre_mem_write_iov)( tid, "vmsplice(iov[...])",
+                                 (struct vki_iovec *)ARG2, ARG3, ~(SizeT)0 );
+      else
+         ML_(pre_mem_read_iov)( tid, "vmsplice(iov[...])",
+                                (struct vki_iovec *)ARG2, ARG3, ~(SizeT)0 );
    }
 }
 
@@ -5144,14 +5105,8 @@ POST(sys_vmsplice)
       Int fdfl = VG_(fcntl)(ARG1, VKI_F_GETFL, 0);
       vg_assert(fdfl >= 0);
       if ((fdfl & VKI_O_ACCMODE) == VKI_O_RDONLY)
-      {
-         const struct vki_iovec *iov;
-         for (iov = (struct vki_iovec *)ARG2;
-              iov < (struct vki_iovec *)ARG2 + ARG3; iov++) 
-         {
-            POST_MEM_WRITE( (Addr)iov->iov_base, iov->iov_len );
-         }
-      }
+         ML_(post_mem_write_iov)( tid, (struct vki_iovec *)ARG2, ARG3,
+                                  ~(SizeT)0 );
    }
 }
 
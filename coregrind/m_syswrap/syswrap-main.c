@@ -41,6 +41,7 @@
 #include "pub_core_libcprint.h"
 #include "pub_core_libcproc.h"      // For VG_(getpid)()
 #include "pub_core_libcsignal.h"
+#include "pub_core_mallocfree.h"
 #include "pub_core_scheduler.h"     // For VG_({acquire,release}_BigLock),
                                     //   and VG_(vg_yield)
 #include "pub_core_stacktrace.h"    // For VG_(get_and_pp_StackTrace)()
@@ -1364,7 +1365,7 @@ typedef
    }
    SyscallInfo;
 
-SyscallInfo syscallInfo[VG_N_THREADS];
+static SyscallInfo* syscallInfo = NULL;   /* [VG_N_THREADS] */
 
 
 /* The scheduler needs to be able to zero out these records after a
@@ -1372,6 +1373,8 @@ SyscallInfo syscallInfo[VG_N_THREADS];
 void VG_(clear_syscallInfo) ( Int tid )
 {
    vg_assert(tid >= 0 && tid < VG_N_THREADS);
+   if (syscallInfo == NULL)
+      return; /* not allocated yet; ensure_initialised will clear it */
    VG_(memset)( & syscallInfo[tid], 0, sizeof( syscallInfo[tid] ));
    syscallInfo[tid].status.what = SsIdle;
 }
@@ -1383,6 +1386,8 @@ static void ensure_initialised ( void )
    if (init_done) 
       return;
    init_done = True;
+   syscallInfo = VG_(malloc)("syswrap.ensure_initialised.1",
+                             VG_N_THREADS * sizeof(SyscallInfo));
    for (i = 0; i < VG_N_THREADS; i++) {
       VG_(clear_syscallInfo)( i );
    }
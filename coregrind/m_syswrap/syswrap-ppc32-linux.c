@@ -49,6 +49,7 @@
 #include "pub_core_syscall.h"
 #include "pub_core_syswrap.h"
 #include "pub_core_tooliface.h"
+#include "pub_core_transtab.h"       // VG_(smc_unprotect), for PRE_MEM_WRITE
 #include "pub_core_stacks.h"        // VG_(register_stack)
 
 #include "priv_types_n_macros.h"
@@ -33,6 +33,9 @@
 #include "pub_core_libcsetjmp.h"    // to keep _threadstate.h happy
 #include "pub_core_threadstate.h"
 #include "pub_core_libcassert.h"
+#include "pub_core_libcbase.h"
+#include "pub_core_aspacemgr.h"
+#include "pub_core_mallocfree.h"
 #include "pub_core_inner.h"
 #if defined(ENABLE_INNER_CLIENT_REQUEST)
 #include "helgrind/helgrind.h"
@@ -44,7 +47,9 @@
 
 ThreadId VG_(running_tid) = VG_INVALID_THREADID;
 
-ThreadState VG_(threads)[VG_N_THREADS] __attribute__((aligned(16)));
+UInt VG_(n_threads) = 500;
+
+ThreadState* VG_(threads) = NULL;
 
 /*------------------------------------------------------------*/
 /*--- Operations.                                          ---*/
@@ -53,6 +58,17 @@ ThreadState VG_(threads)[VG_N_THREADS] __attribute__((aligned(16)));
 void VG_(init_Threads)(void)
 {
    ThreadId tid;
+   SysRes   sres;
+
+   /* Sized by --max-threads, so it can't be a static array.  The
+      scheduler fills it in, in VG_(scheduler_init_phase1). */
+   vg_assert(VG_(threads) == NULL);
+   sres = VG_(am_mmap_anon_float_valgrind)
+             ( VG_PGROUNDUP(VG_N_THREADS * sizeof(ThreadState)) );
+   if (sr_isError(sres))
+      VG_(out_of_memory_NORETURN)("init_Threads",
+                                  VG_N_THREADS * sizeof(ThreadState));
+   VG_(threads) = (ThreadState*)(Addr)sr_Res(sres);
 
    for (tid = 1; tid < VG_N_THREADS; tid++) {
       INNER_REQUEST(
@@ -93,11 +93,17 @@ VgNeeds VG_(needs) = {
    .syscall_wrapper      = False,
    .sanity_checks        = False,
    .print_stats          = False,
+   .metrics              = False,
    .info_location        = False,
    .var_info	         = False,
    .malloc_replacement   = False,
    .xml_output           = False,
-   .final_IR_tidy_pass   = False
+   .final_IR_tidy_pass   = False,
+   .persistent_translations = False,
+   .thread_safe_instrumentation = False,
+   .fast_forward         = False,
+   .instrumentation_filter = False,
+   .merged_stack_events  = False
 };
 
 /* static */
@@ -201,6 +207,19 @@ Bool VG_(sanity_check_needs)(const HChar** failmsg)
       return False;
    }
 
+   /* Translations that the core instruments with origin tags, or for
+      which the tool keeps per-superblock state, can't be reused by a
+      later run. */
+   if (VG_(needs).persistent_translations
+       && (VG_(needs).superblock_discards
+           || VG_(tdict).track_new_mem_stack_w_ECU
+           || any_new_mem_stack_N_w_ECU)) {
+      *failmsg = "Tool error: 'persistent_translations' needed, but the\n"
+                 "   tool also needs 'superblock_discards' or tracks\n"
+                 "   'new_mem_stack_w_ECU'\n";
+      return False;
+   }
+
    return True;
 
 #undef CHECK_NOT
@@ -217,6 +236,9 @@ Bool VG_(sanity_check_needs)(const HChar** failmsg)
 NEEDS(libc_freeres)
 NEEDS(core_errors)
 NEEDS(var_info)
+NEEDS(persistent_translations)
+NEEDS(thread_safe_instrumentation)
+NEEDS(merged_stack_events)
 
 void VG_(needs_superblock_discards)(
    void (*discard)(Addr64, VexGuestExtents)
@@ -304,6 +326,14 @@ void VG_(needs_print_stats) (
    VG_(tdict).tool_print_stats = print_stats;
 }
 
+void VG_(needs_metrics) (
+   void (*metrics)(void (*put)(const HChar* name, ULong value))
+)
+{
+   VG_(needs).metrics = True;
+   VG_(tdict).tool_metrics = metrics;
+}
+
 void VG_(needs_info_location) (
    void (*info_location)(Addr)
 )
@@ -353,6 +383,24 @@ void VG_(needs_final_IR_tidy_pass)(
    VG_(tdict).tool_final_IR_tidy_pass = final_tidy;
 }
 
+void VG_(needs_fast_forward)(
+   void (*start_instrumentation)(void)
+)
+{
+   VG_(needs).fast_forward = True;
+   VG_(tdict).tool_start_instrumentation = start_instrumentation;
+}
+
+void VG_(needs_instrumentation_filter)(
+   IRSB*(*instrument_skipped)(VgCallbackClosure*, IRSB*,
+                              VexGuestLayout*, VexGuestExtents*,
+                              VexArchInfo*, IRType, IRType)
+)
+{
+   VG_(needs).instrumentation_filter = True;
+   VG_(tdict).tool_instrument_skipped = instrument_skipped;
+}
+
 /*--------------------------------------------------------------------*/
 /* Tracked events.  Digit 'n' on DEFn is the REGPARMness. */
 
@@ -421,6 +469,12 @@ DEF0(track_pre_mem_read,          CorePart, ThreadId, const HChar*, Addr, SizeT)
 DEF0(track_pre_mem_read_asciiz,   CorePart, ThreadId, const HChar*, Addr)
 DEF0(track_pre_mem_write,         CorePart, ThreadId, const HChar*, Addr, SizeT)
 DEF0(track_post_mem_write,        CorePart, ThreadId, Addr, SizeT)
+DEF0(track_pre_mem_read_iov,      CorePart, ThreadId, const HChar*,
+                                  const struct vki_iovec*, UInt, SizeT)
+DEF0(track_pre_mem_write_iov,     CorePart, ThreadId, const HChar*,
+                                  const struct vki_iovec*, UInt, SizeT)
+DEF0(track_post_mem_write_iov,    CorePart, ThreadId,
+                                  const struct vki_iovec*, UInt, SizeT)
 
 DEF0(track_pre_reg_read,          CorePart, ThreadId, const HChar*, PtrdiffT, SizeT)
 DEF0(track_post_reg_write,        CorePart, ThreadId,               PtrdiffT, SizeT)
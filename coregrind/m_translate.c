@@ -39,10 +39,13 @@
 #include "pub_core_libcbase.h"
 #include "pub_core_libcassert.h"
 #include "pub_core_libcprint.h"
+#include "pub_core_libcproc.h"   // VG_(read_nanosecond_timer)
+#include "pub_core_mallocfree.h"
 #include "pub_core_options.h"
 
 #include "pub_core_debuginfo.h"  // VG_(get_fnname_w_offset)
 #include "pub_core_redir.h"      // VG_(redir_do_lookup)
+#include "pub_core_seqmatch.h"   // VG_(string_match)
 
 #include "pub_core_signals.h"    // VG_(synth_fault_{perms,mapping}
 #include "pub_core_stacks.h"     // VG_(unknown_SP_update*)()
@@ -60,6 +63,10 @@
 #include "pub_core_execontext.h"  // VG_(make_depth_1_ExeContext_from_Addr)
 
 #include "pub_core_gdbserver.h"   // VG_(tool_instrument_then_gdbserver_if_needed)
+#include "pub_core_hashtable.h"   // For the tiering counts
+#include "pub_core_xarray.h"      // For the instrumentation filter
+#include "pub_core_perfevents.h"  // VG_(perf_phase)
+#include "pub_core_oset.h"        // For VG_(pretranslate_range)
 
 #include "libvex_emnote.h"        // For PPC, EmWarn_PPC64_redir_underflow
 
@@ -70,12 +77,61 @@
 static UInt n_SP_updates_fast            = 0;
 static UInt n_SP_updates_generic_known   = 0;
 static UInt n_SP_updates_generic_unknown = 0;
+static UInt n_SP_updates_merged          = 0;
+static UInt n_pretranslated              = 0;
+static UInt n_region_translations        = 0;
+static UInt n_tier0_translations         = 0;
+static UInt n_tier1_translations         = 0;
+static UInt n_inline_caches              = 0;
+static UInt n_skipped_translations       = 0;
+
+void VG_(print_jit_profile) ( void )
+{
+   VexPhaseTimes pt;
+   ULong         total;
+   LibVEX_GetPhaseTimes(&pt);
+   total = pt.front_end + pt.iropt + pt.instrument + pt.tidy
+           + pt.isel + pt.regalloc + pt.assembly;
+   if (total == 0) {
+      VG_(message)(Vg_DebugMsg,
+         "jit: no translation times (need --profile-jit=yes)\n");
+      return;
+   }
+   VG_(message)(Vg_DebugMsg,
+      "jit: %s: %'llu translations in %'llu us, %'llu us each\n",
+      VG_(details).name, pt.n_translations, total / 1000,
+      pt.n_translations == 0 ? 0 : total / 1000 / pt.n_translations);
+#  define SHOW_PHASE(_name, _t) \
+      do { HChar buf[7]; \
+           VG_(percentify)((_t), total, 1, 6, buf); \
+           VG_(message)(Vg_DebugMsg, "jit: %12s %'11llu us %s\n", \
+                        (_name), (_t) / 1000, buf); \
+      } while (0)
+   SHOW_PHASE("decode",     pt.front_end);
+   SHOW_PHASE("iropt",      pt.iropt);
+   SHOW_PHASE("instrument", pt.instrument);
+   SHOW_PHASE("tidy",       pt.tidy);
+   SHOW_PHASE("isel",       pt.isel);
+   SHOW_PHASE("regalloc",   pt.regalloc);
+   SHOW_PHASE("assembly",   pt.assembly);
+#  undef SHOW_PHASE
+}
+
+void VG_(jit_metrics) ( void (*put)(const HChar* name, ULong value) )
+{
+   VexPhaseTimes pt;
+   LibVEX_GetPhaseTimes(&pt);
+   put("jit.translations", pt.n_translations);
+   put("jit.time_us", (pt.front_end + pt.iropt + pt.instrument + pt.tidy
+                       + pt.isel + pt.regalloc + pt.assembly) / 1000);
+}
 
 void VG_(print_translation_stats) ( void )
 {
    HChar buf[7];
    UInt n_SP_updates = n_SP_updates_fast + n_SP_updates_generic_known
-                                         + n_SP_updates_generic_unknown;
+                                         + n_SP_updates_generic_unknown
+                                         + n_SP_updates_merged;
    VG_(percentify)(n_SP_updates_fast, n_SP_updates, 1, 6, buf);
    VG_(message)(Vg_DebugMsg,
       "translate:            fast SP updates identified: %'u (%s)\n",
@@ -90,6 +146,58 @@ void VG_(print_translation_stats) ( void )
    VG_(message)(Vg_DebugMsg,
       "translate: generic_unknown SP updates identified: %'u (%s)\n",
       n_SP_updates_generic_unknown, buf );
+
+   if (n_SP_updates_merged > 0) {
+      VG_(percentify)(n_SP_updates_merged, n_SP_updates, 1, 6, buf);
+      VG_(message)(Vg_DebugMsg,
+         "translate:          merged SP updates identified: %'u (%s)\n",
+         n_SP_updates_merged, buf );
+   }
+
+   if (VG_(clo_pretranslate_successors))
+      VG_(message)(Vg_DebugMsg,
+         "translate: %'u successors translated in advance\n",
+         n_pretranslated );
+
+   if (n_region_translations > 0)
+      VG_(message)(Vg_DebugMsg,
+         "translate: %'u translations made ahead of time, for "
+         "--pretranslate or VALGRIND_PRETRANSLATE\n",
+         n_region_translations );
+
+   if (VG_(clo_tier_up_threshold) > 0)
+      VG_(message)(Vg_DebugMsg,
+         "translate: %'u cheap translations, %'u full ones of hot blocks\n",
+         n_tier0_translations, n_tier1_translations );
+
+   if (VG_(clo_skip_instrument) != NULL || VG_(clo_instrument_only) != NULL)
+      VG_(message)(Vg_DebugMsg,
+         "translate: %'u translations of code skipped by the"
+         " instrumentation\n", n_skipped_translations );
+
+   if (VG_(clo_inline_caches))
+      VG_(message)(Vg_DebugMsg,
+         "translate: %'u inline caches for indirect jumps\n",
+         n_inline_caches );
+
+   { VexRegAllocStats ra;
+     LibVEX_GetRegAllocStats(&ra);
+     VG_(message)(Vg_DebugMsg,
+        "translate: regalloc v%d: %'llu insns, %'llu spills, "
+        "%'llu reloads, %'llu moves removed\n",
+        VG_(clo_vex_control).regalloc_version, ra.n_insns,
+        ra.n_spills, ra.n_reloads, ra.n_moves_removed );
+   }
+
+   { VexISelStats is;
+     LibVEX_GetISelStats(&is);
+     VG_(message)(Vg_DebugMsg,
+        "translate: isel: %'llu blocks, %'llu SIMD helper calls\n",
+        is.n_blocks, is.n_helper_calls );
+   }
+
+   if (VG_(clo_profile_jit))
+      VG_(print_jit_profile)();
 }
 
 /*------------------------------------------------------------*/
@@ -240,6 +348,177 @@ IRSB* tool_instrument_then_gdbserver_if_needed ( VgCallbackClosure* closureV,
        hWordTy);                                   
 }
 
+/* For --pretranslate-successors=yes, the constant targets of the
+   superblock being translated are noted on the way through
+   instrumentation, so that VG_(translate) can make translations for
+   them too before returning to the scheduler.  'speculating' is True
+   whilst doing so: such translations note no successors of their
+   own, and must not raise faults for the client.
+   VG_(pretranslate_range) sets 'walking_region' as well: its
+   translations do note their successors, and the return addresses of
+   their calls, for it to follow. */
+#define N_SUCCS 4
+static Addr64 succs[N_SUCCS];
+static Int    n_succs        = 0;
+static Bool   speculating    = False;
+static Bool   walking_region = False;
+
+static void note_successor_addr ( Addr64 a )
+{
+   Int i;
+   for (i = 0; i < n_succs; i++)
+      if (succs[i] == a)
+         return;
+   if (n_succs < N_SUCCS)
+      succs[n_succs++] = a;
+}
+
+static void note_successor ( IRConst* dst, IRJumpKind jk )
+{
+   if (jk != Ijk_Boring && jk != Ijk_Call)
+      return;
+   switch (dst->tag) {
+      case Ico_U32: note_successor_addr( (Addr64)dst->Ico.U32 ); break;
+      case Ico_U64: note_successor_addr( dst->Ico.U64 ); break;
+      default: break;
+   }
+}
+
+static
+IRSB* tool_instrument_noting_successors ( VgCallbackClosure* closureV,
+                                          IRSB*              sb_in,
+                                          VexGuestLayout*    layout,
+                                          VexGuestExtents*   vge,
+                                          VexArchInfo*       vai,
+                                          IRType             gWordTy,
+                                          IRType             hWordTy )
+{
+   Int i;
+   for (i = 0; i < sb_in->stmts_used; i++) {
+      IRStmt* st = sb_in->stmts[i];
+      if (st && st->tag == Ist_Exit)
+         note_successor(st->Ist.Exit.dst, st->Ist.Exit.jk);
+   }
+   if (sb_in->next->tag == Iex_Const)
+      note_successor(sb_in->next->Iex.Const.con, sb_in->jumpkind);
+   /* The call returns to just after the block's last instruction. */
+   if (walking_region && sb_in->jumpkind == Ijk_Call)
+      note_successor_addr(vge->base[vge->n_used-1]
+                          + vge->len[vge->n_used-1]);
+
+   if (VG_(clo_vgdb) != Vg_VgdbNo)
+      return tool_instrument_then_gdbserver_if_needed
+                (closureV, sb_in, layout, vge, vai, gWordTy, hWordTy);
+   else
+      return VG_(tdict).tool_instrument
+                (closureV, sb_in, layout, vge, vai, gWordTy, hWordTy);
+}
+
+/* For tools which say VG_(needs_merged_stack_events), consecutive SP
+   changes in the same direction within a superblock are reported to
+   the tool as one range, instead of one event per change:
+
+   - for a run of decrements (eg. pushes), the whole area is announced
+     with new_mem_stack at the first of them.  The area below the new
+     SP plus the redzone holds nothing the program may rely on, so
+     announcing it early is harmless;
+
+   - for a run of increments (eg. pops), die_mem_stack is called for
+     the whole area at the last of them, so the popped values stay
+     accessible until then.
+
+   A run ends at a change in the other direction, at an SP update
+   whose delta is not known, and at a side exit, so that the events
+   are all delivered when the superblock is left.  Runs are not merged
+   when the tool wants origin tags for new stack memory, since these
+   would then all name the first instruction of the run.
+
+   Finding the runs needs a look ahead: SP_put_delta[i] gives, for
+   each statement i of the superblock, the delta of SP if it is a Put
+   of SP with known delta, SP_RUN_BREAK if it ends any run, or 0. */
+#define SP_RUN_BREAK (1LL << 62)
+static Long* SP_put_delta      = NULL;
+static Int   SP_put_delta_size = 0;
+
+static Bool merge_SP_updates(void)
+{
+   return VG_(needs).merged_stack_events
+          && !VG_(tdict).track_new_mem_stack_4_w_ECU
+          && !VG_(tdict).track_new_mem_stack_8_w_ECU
+          && !VG_(tdict).track_new_mem_stack_12_w_ECU
+          && !VG_(tdict).track_new_mem_stack_16_w_ECU
+          && !VG_(tdict).track_new_mem_stack_32_w_ECU
+          && !VG_(tdict).track_new_mem_stack_112_w_ECU
+          && !VG_(tdict).track_new_mem_stack_128_w_ECU
+          && !VG_(tdict).track_new_mem_stack_144_w_ECU
+          && !VG_(tdict).track_new_mem_stack_160_w_ECU
+          && !VG_(tdict).track_new_mem_stack_w_ECU;
+}
+
+/* The tool's specialised function for a stack change of 'size' bytes,
+   or NULL if there is none. */
+static void* SP_update_fn ( Bool is_new, Long size )
+{
+#  define CASE(syze)                                            \
+      case syze:                                                \
+         return is_new                                          \
+                ? (void*)VG_(tdict).track_new_mem_stack_##syze  \
+                : (void*)VG_(tdict).track_die_mem_stack_##syze
+   switch (size) {
+      CASE(4); CASE(8); CASE(12); CASE(16); CASE(32);
+      CASE(112); CASE(128); CASE(144); CASE(160);
+      default: return NULL;
+   }
+#  undef CASE
+}
+
+/* Add a call telling the tool that 'size' bytes of stack have been
+   allocated (is_new) or freed, 'new_SP' being the value of SP after
+   the change. */
+static void add_merged_SP_update ( IRSB* bb, VexGuestLayout* layout,
+                                   IRType typeof_SP, Bool is_new,
+                                   Long size, IRTemp new_SP )
+{
+   IRDirty* dcall;
+   void*    fn = SP_update_fn(is_new, size);
+
+   if (fn) {
+      dcall = unsafeIRDirty_0_N(
+                 1/*regparms*/,
+                 is_new ? "track_new_mem_stack_N" : "track_die_mem_stack_N",
+                 VG_(fnptr_to_fnentry)( fn ),
+                 mkIRExprVec_1(IRExpr_RdTmp(new_SP))
+              );
+      n_SP_updates_fast++;
+   } else {
+      IRTemp old_SP = newIRTemp(bb->tyenv, typeof_SP);
+      IRExpr* con = typeof_SP == Ity_I32
+                    ? IRExpr_Const(IRConst_U32((UInt)size))
+                    : IRExpr_Const(IRConst_U64((ULong)size));
+      IROp op = typeof_SP == Ity_I32
+                ? (is_new ? Iop_Add32 : Iop_Sub32)
+                : (is_new ? Iop_Add64 : Iop_Sub64);
+      addStmtToIRSB(
+         bb,
+         IRStmt_WrTmp( old_SP, IRExpr_Binop(op, IRExpr_RdTmp(new_SP), con) )
+      );
+      dcall = unsafeIRDirty_0_N(
+                 2/*regparms*/,
+                 "VG_(unknown_SP_update)",
+                 VG_(fnptr_to_fnentry)( &VG_(unknown_SP_update) ),
+                 mkIRExprVec_2( IRExpr_RdTmp(old_SP), IRExpr_RdTmp(new_SP) )
+              );
+      n_SP_updates_generic_known++;
+   }
+   dcall->nFxState = 1;
+   dcall->fxState[0].fx     = Ifx_Read;
+   dcall->fxState[0].offset = layout->offset_SP;
+   dcall->fxState[0].size   = layout->sizeof_SP;
+   dcall->fxState[0].nRepeats  = 0;
+   dcall->fxState[0].repeatLen = 0;
+   addStmtToIRSB( bb, IRStmt_Dirty(dcall) );
+}
+
 /* For tools that want to know about SP changes, this pass adds
    in the appropriate hooks.  We have to do it after the tool's
    instrumentation, so the tool doesn't have to worry about the C calls
@@ -276,6 +555,11 @@ IRSB* vg_SP_update_pass ( void*             closureV,
    IRType      typeof_SP;
    Long        delta, con;
 
+   /* Set up stuff for merging SP updates */
+   Bool   merge       = merge_SP_updates();
+   Long   pending_new = 0;  /* bytes below SP already announced */
+   Long   pending_die = 0;  /* bytes above SP not yet reported dead */
+
    /* Set up stuff for tracking the guest IP */
    Bool   curr_IP_known = False;
    Addr64 curr_IP       = 0;
@@ -383,6 +667,63 @@ IRSB* vg_SP_update_pass ( void*             closureV,
 
    /* --- End of #defines --- */
 
+   if (merge) {
+      /* Look ahead: find the deltas of the Puts to SP, tracking the
+         aliases the same way as the main loop below does. */
+      if (SP_put_delta_size < sb_in->stmts_used) {
+         SP_put_delta_size = sb_in->stmts_used;
+         SP_put_delta = VG_(realloc)("translate.vSPup.1", SP_put_delta,
+                                     SP_put_delta_size * sizeof(Long));
+      }
+      clear_SP_aliases();
+      for (i = 0; i < sb_in->stmts_used; i++) {
+         st = sb_in->stmts[i];
+         SP_put_delta[i] = 0;
+         if (st->tag == Ist_Exit) {
+            SP_put_delta[i] = SP_RUN_BREAK;
+         } else if (st->tag == Ist_WrTmp) {
+            e = st->Ist.WrTmp.data;
+            if (e->tag == Iex_Get && e->Iex.Get.offset == offset_SP
+                && e->Iex.Get.ty == typeof_SP) {
+               add_SP_alias(st->Ist.WrTmp.tmp, 0);
+            } else if (e->tag == Iex_Binop
+                       && e->Iex.Binop.arg1->tag == Iex_RdTmp
+                       && get_SP_delta(e->Iex.Binop.arg1->Iex.RdTmp.tmp,
+                                       &delta)
+                       && e->Iex.Binop.arg2->tag == Iex_Const
+                       && IS_ADD_OR_SUB(e->Iex.Binop.op)) {
+               con = GET_CONST(e->Iex.Binop.arg2->Iex.Const.con);
+               add_SP_alias(st->Ist.WrTmp.tmp,
+                            IS_ADD(e->Iex.Binop.op) ? delta + con
+                                                    : delta - con);
+            } else if (e->tag == Iex_RdTmp
+                       && get_SP_delta(e->Iex.RdTmp.tmp, &delta)) {
+               add_SP_alias(st->Ist.WrTmp.tmp, delta);
+            }
+         } else if (st->tag == Ist_Put) {
+            first_Put = st->Ist.Put.offset;
+            last_Put  = first_Put
+                        + sizeofIRType(typeOfIRExpr(bb->tyenv,
+                                                    st->Ist.Put.data))
+                        - 1;
+            if (last_Put < offset_SP || offset_SP + sizeof_SP - 1 < first_Put)
+               continue;
+            if (st->Ist.Put.data->tag == Iex_RdTmp
+                && get_SP_delta(st->Ist.Put.data->Iex.RdTmp.tmp, &delta)) {
+               SP_put_delta[i] = delta;
+               update_SP_aliases(-delta);
+            } else {
+               SP_put_delta[i] = SP_RUN_BREAK;
+               clear_SP_aliases();
+               if (first_Put == offset_SP
+                   && last_Put == offset_SP + sizeof_SP - 1
+                   && st->Ist.Put.data->tag == Iex_RdTmp)
+                  add_SP_alias(st->Ist.Put.data->Iex.RdTmp.tmp, 0);
+            }
+         }
+      }
+   }
+
    clear_SP_aliases();
 
    for (i = 0; i <  sb_in->stmts_used; i++) {
@@ -468,6 +809,62 @@ IRSB* vg_SP_update_pass ( void*             closureV,
             we found a useable alias, it must for an "exact" write of SP. */
          vg_assert(first_SP == first_Put);
          vg_assert(last_SP == last_Put);
+         if (merge && delta != 0) {
+            vg_assert(SP_put_delta[i] == delta);
+            if (delta < 0 && pending_new >= -delta) {
+               /* Already announced. */
+               pending_new += delta;
+               n_SP_updates_merged++;
+            } else if (delta < 0) {
+               /* First of a run of decrements: announce them all. */
+               Long   size = -delta;
+               IRTemp bottom = tttmp;
+               vg_assert(pending_new == 0 && pending_die == 0);
+               for (j = i+1; j < sb_in->stmts_used; j++) {
+                  if (SP_put_delta[j] > 0)
+                     break;
+                  size -= SP_put_delta[j];
+               }
+               if (size > -delta) {
+                  bottom = newIRTemp(bb->tyenv, typeof_SP);
+                  addStmtToIRSB(
+                     bb,
+                     IRStmt_WrTmp(
+                        bottom,
+                        IRExpr_Binop(
+                           sizeof_SP==4 ? Iop_Sub32 : Iop_Sub64,
+                           IRExpr_RdTmp(tttmp),
+                           sizeof_SP==4
+                              ? IRExpr_Const(IRConst_U32((UInt)(size+delta)))
+                              : IRExpr_Const(IRConst_U64((ULong)(size+delta)))
+                        )
+                     )
+                  );
+               }
+               add_merged_SP_update(bb, layout, typeof_SP, True/*is_new*/,
+                                    size, bottom);
+               pending_new = size + delta;
+            } else {
+               /* An increment: report the run when this is its last. */
+               pending_new = 0;
+               pending_die += delta;
+               for (j = i+1; j < sb_in->stmts_used; j++) {
+                  if (SP_put_delta[j] != 0)
+                     break;
+               }
+               if (j == sb_in->stmts_used || SP_put_delta[j] < 0
+                   || SP_put_delta[j] == SP_RUN_BREAK) {
+                  add_merged_SP_update(bb, layout, typeof_SP,
+                                       False/*!is_new*/, pending_die, tttmp);
+                  pending_die = 0;
+               } else {
+                  n_SP_updates_merged++;
+               }
+            }
+            update_SP_aliases(-delta);
+            addStmtToIRSB(bb,st);
+            continue;
+         }
          switch (delta) {
             case    0:                      addStmtToIRSB(bb,st); continue;
             case    4: DO_DIE(  4,  tttmp); addStmtToIRSB(bb,st); continue;
@@ -508,6 +905,8 @@ IRSB* vg_SP_update_pass ( void*             closureV,
          */
          IRTemp  old_SP;
          n_SP_updates_generic_unknown++;
+         vg_assert(pending_die == 0);
+         pending_new = 0;
 
          // Nb: if all is well, this generic case will typically be
          // called something like every 1000th SP update.  If it's more than
@@ -637,6 +1036,11 @@ IRSB* vg_SP_update_pass ( void*             closureV,
          }
       }
 
+      if (st->tag == Ist_Exit) {
+         vg_assert(pending_die == 0);
+         pending_new = 0;
+      }
+
       /* well, not interesting.  Just copy and keep going. */
       addStmtToIRSB( bb, st );
 
@@ -655,6 +1059,243 @@ IRSB* vg_SP_update_pass ( void*             closureV,
 #undef DO_DIE
 }
 
+/*------------------------------------------------------------*/
+/*--- Tiered translation                                   ---*/
+/*------------------------------------------------------------*/
+
+/* With --tier-up-threshold=N, N > 0, normal translations are first
+   made cheaply: with only the cheap iropt transformations, and
+   without chasing.  Each such translation counts its executions in a
+   TierCount, and when the count reaches N, exits to the scheduler
+   with VEX_TRC_JMP_INVALICACHE covering its own first byte.  The
+   scheduler then discards it, and the next translation made at that
+   address, seeing the count, is done in full.
+
+   TierCounts are never freed, so a block which has been hot once is
+   translated in full straight away should it be discarded and needed
+   again later. */
+
+typedef
+   struct _TierCount {
+      struct _TierCount* next;
+      UWord              key;    /* nraddr */
+      UInt               count;  /* executions of cheap translations */
+      /* For --inline-caches=yes: if the cheap translation ends in an
+         indirect jump, the address of that instruction, and the
+         destination it last went to (0 if none yet). */
+      Addr               ind_site;
+      Addr               ind_target;
+   }
+   TierCount;
+
+static VgHashTable tier_counts = NULL;
+
+/* The count for the cheap translation being made, for
+   tier0_count_pass. */
+static TierCount* tier0_count = NULL;
+
+static TierCount* get_tier_count ( Addr64 nraddr )
+{
+   TierCount* tc;
+   if (tier_counts == NULL)
+      tier_counts = VG_(HT_construct)( "translate.tier_counts" );
+   tc = VG_(HT_lookup)( tier_counts, (UWord)nraddr );
+   if (tc == NULL) {
+      tc = VG_(malloc)( "translate.gtc.1", sizeof(TierCount) );
+      tc->key   = (UWord)nraddr;
+      tc->count = 0;
+      tc->ind_site   = 0;
+      tc->ind_target = 0;
+      VG_(HT_add_node)( tier_counts, tc );
+   }
+   return tc;
+}
+
+/* Does sb end in an indirect jump we might make an inline cache for?
+   If so, return the address of its last instruction, else 0. */
+static Addr inline_cache_site ( IRSB* sb )
+{
+   Int i;
+   if (!VG_(clo_inline_caches)
+       || sb->next->tag != Iex_RdTmp
+       || (sb->jumpkind != Ijk_Boring && sb->jumpkind != Ijk_Call
+           && sb->jumpkind != Ijk_Ret))
+      return 0;
+   for (i = sb->stmts_used-1; i >= 0; i--)
+      if (sb->stmts[i] && sb->stmts[i]->tag == Ist_IMark)
+         return (Addr)sb->stmts[i]->Ist.IMark.addr;
+   return 0;
+}
+
+/* Second instrumentation pass for cheap translations.  After doing
+   the SP pass, if that is needed, prefix the block with
+
+      t1 = LDle:I32(&tier0_count->count)
+      t2 = Add32(t1,0x1:I32)
+      STle(&tier0_count->count) = t2
+      t3 = CmpLE32U(N,t2)
+      PUT(CMSTART) = guest_addr
+      PUT(CMLEN)   = 1
+      if (t3) { PUT(IP) = guest_addr; exit-InvalICache }
+
+   This comes after the tool's instrumentation, so the tool never sees
+   the counter accesses, and before all guest instructions, so if the
+   exit is taken none of them has been executed.  If the block ends
+   in an indirect jump to t, which might be worth an inline cache,
+   also append
+
+      STle(&tier0_count->ind_target) = t
+*/
+static
+IRSB* tier0_count_pass ( void*             closureV,
+                         IRSB*             sb_in,
+                         VexGuestLayout*   layout,
+                         VexGuestExtents*  vge,
+                         VexArchInfo*      vai,
+                         IRType            gWordTy,
+                         IRType            hWordTy )
+{
+   Int       i;
+   IRSB*     bb;
+   IRTemp    t1, t2, t3;
+   IRExpr    *addr, *start, *len;
+   IRConst*  dst;
+   Addr64    guest_addr = vge->base[0];
+#  if defined(VG_BIGENDIAN)
+   IREndness end = Iend_BE;
+#  else
+   IREndness end = Iend_LE;
+#  endif
+
+   vg_assert(tier0_count);
+
+   if (need_to_handle_SP_assignment())
+      sb_in = vg_SP_update_pass( closureV, sb_in, layout, vge, vai,
+                                 gWordTy, hWordTy );
+
+   if (gWordTy == Ity_I64) {
+      start = IRExpr_Const(IRConst_U64(guest_addr));
+      len   = IRExpr_Const(IRConst_U64(1));
+      dst   = IRConst_U64(guest_addr);
+   } else {
+      start = IRExpr_Const(IRConst_U32((UInt)guest_addr));
+      len   = IRExpr_Const(IRConst_U32(1));
+      dst   = IRConst_U32((UInt)guest_addr);
+   }
+
+   bb   = deepCopyIRSBExceptStmts(sb_in);
+   t1   = newIRTemp(bb->tyenv, Ity_I32);
+   t2   = newIRTemp(bb->tyenv, Ity_I32);
+   t3   = newIRTemp(bb->tyenv, Ity_I1);
+   addr = mkIRExpr_HWord( (HWord)&tier0_count->count );
+
+   addStmtToIRSB( bb, IRStmt_WrTmp(t1, IRExpr_Load(end, Ity_I32, addr)) );
+   addStmtToIRSB( bb, IRStmt_WrTmp(t2, IRExpr_Binop(
+                                          Iop_Add32, IRExpr_RdTmp(t1),
+                                          IRExpr_Const(IRConst_U32(1)))) );
+   addStmtToIRSB( bb, IRStmt_Store(end, addr, IRExpr_RdTmp(t2)) );
+   addStmtToIRSB( bb, IRStmt_WrTmp(t3, IRExpr_Binop(
+                                          Iop_CmpLE32U,
+                                          IRExpr_Const(IRConst_U32(
+                                             VG_(clo_tier_up_threshold))),
+                                          IRExpr_RdTmp(t2))) );
+   addStmtToIRSB( bb, IRStmt_Put(offsetof(VexGuestArchState,guest_CMSTART),
+                                 start) );
+   addStmtToIRSB( bb, IRStmt_Put(offsetof(VexGuestArchState,guest_CMLEN),
+                                 len) );
+   addStmtToIRSB( bb, IRStmt_Exit(IRExpr_RdTmp(t3), Ijk_InvalICache, dst,
+                                  layout->offset_IP) );
+
+   for (i = 0; i < sb_in->stmts_used; i++)
+      addStmtToIRSB( bb, sb_in->stmts[i] );
+
+   tier0_count->ind_site = inline_cache_site( bb );
+   if (tier0_count->ind_site != 0)
+      addStmtToIRSB( bb, IRStmt_Store(end,
+                            mkIRExpr_HWord(
+                               (HWord)&tier0_count->ind_target ),
+                            bb->next) );
+
+   return bb;
+}
+
+/* With --inline-caches=yes as well, when a block that ends in an
+   indirect jump becomes hot, its full translation gets a side exit
+   to the destination that jump last went to:
+
+      t = CmpEQ(next, ind_target)
+      if (t) goto {Boring} ind_target
+
+   As a constant exit, this is chained to its destination like any
+   other, so while the jump keeps going to the same place it does not
+   go through the dispatcher.  The block's own jump kind, which may
+   be Call or Ret, is still seen by tools, which only see the IR
+   before this is added. */
+static TierCount* tier1_count = NULL;
+
+static
+IRSB* tier1_inline_cache_pass ( void*             closureV,
+                                IRSB*             sb_in,
+                                VexGuestLayout*   layout,
+                                VexGuestExtents*  vge,
+                                VexArchInfo*      vai,
+                                IRType            gWordTy,
+                                IRType            hWordTy )
+{
+   IRTemp t;
+   Addr   dst = tier1_count->ind_target;
+
+   if (need_to_handle_SP_assignment())
+      sb_in = vg_SP_update_pass( closureV, sb_in, layout, vge, vai,
+                                 gWordTy, hWordTy );
+
+   if (dst == 0 || dst == TRANSTAB_BOGUS_GUEST_ADDR
+       || inline_cache_site( sb_in ) != tier1_count->ind_site)
+      return sb_in;
+
+   t = newIRTemp(sb_in->tyenv, Ity_I1);
+   if (gWordTy == Ity_I64) {
+      addStmtToIRSB( sb_in, IRStmt_WrTmp(t, IRExpr_Binop(
+                               Iop_CmpEQ64, sb_in->next,
+                               IRExpr_Const(IRConst_U64(dst)))) );
+      addStmtToIRSB( sb_in, IRStmt_Exit(IRExpr_RdTmp(t), Ijk_Boring,
+                                        IRConst_U64(dst), sb_in->offsIP) );
+   } else {
+      addStmtToIRSB( sb_in, IRStmt_WrTmp(t, IRExpr_Binop(
+                               Iop_CmpEQ32, sb_in->next,
+                               IRExpr_Const(IRConst_U32((UInt)dst)))) );
+      addStmtToIRSB( sb_in, IRStmt_Exit(IRExpr_RdTmp(t), Ijk_Boring,
+                                        IRConst_U32((UInt)dst),
+                                        sb_in->offsIP) );
+   }
+   n_inline_caches++;
+   return sb_in;
+}
+
+/* With --hot-traces=yes as well, the full translation of a block
+   which has become hot may chase conditional branches, in whichever
+   direction the counts show to be the more usual.  Cheap translations
+   never chase, so every block entered from another has been run as a
+   block of its own, and a successor's count tells how often the
+   branch to it was taken -- exactly so if it has no other
+   predecessor.  A successor is only chased into if it has run at
+   least half as often as the hot block has.  chase_into_ok consults
+   this whilst forming_hot_trace is True. */
+static Bool forming_hot_trace = False;
+
+/* With --hot-loops=yes, the iropt_unroll_thresh used for the full
+   translations of hot blocks: the most --vex-iropt-unroll-thresh
+   allows. */
+#define HOT_LOOP_UNROLL_THRESH 400
+
+static Bool on_hot_trace ( Addr64 addr )
+{
+   TierCount* tc = VG_(HT_lookup)( tier_counts, (UWord)addr );
+   return tc != NULL
+          && tc->count >= (VG_(clo_tier_up_threshold) + 1) / 2;
+}
+
+
 /*------------------------------------------------------------*/
 /*--- Main entry point for the JITter.                     ---*/
 /*------------------------------------------------------------*/
@@ -834,6 +1475,27 @@ static UInt needs_self_check ( void* closureV,
                }
                break;
             }
+            case Vg_SmcProtect: {
+               /* as for all-non-file, except that code which can be
+                  write-protected is not checked: see
+                  protect_unchecked_extents */
+               Addr sp = VG_(get_SP)(closure->tid);
+               if (!segA) {
+                  segA = VG_(am_find_nsegment)(addr);
+               }
+               if (segA && segA->kind == SkFileC && segA->start <= addr
+                   && (len == 0 || addr + len <= segA->end + 1)) {
+                  /* in a file-mapped segment; skip the check */
+               } else if (segA && VG_(am_find_nsegment)(sp) != segA
+                          && VG_(smc_can_protect)(addr, len)) {
+                  /* will be write-protected; skip the check.  Not
+                     for code on this thread's stack, which is
+                     written to too often. */
+               } else {
+                  check = True;
+               }
+               break;
+            }
             default:
                vg_assert(0);
          }
@@ -847,6 +1509,229 @@ static UInt needs_self_check ( void* closureV,
 }
 
 
+/* For --smc-check=protect: write-protect the pages of any extents
+   which needs_self_check did not ask to be checked, because they can
+   be. */
+static void protect_unchecked_extents ( VgCallbackClosure* closure,
+                                        VexGuestExtents* vge )
+{
+   UInt i, bitset;
+
+   if (VG_(clo_smc_check) != Vg_SmcProtect)
+      return;
+   bitset = needs_self_check(closure, vge);
+   for (i = 0; i < vge->n_used; i++) {
+      Addr  addr = (Addr)vge->base[i];
+      SizeT len  = (SizeT)vge->len[i];
+      NSegment const* seg = VG_(am_find_nsegment)(addr);
+      if ((bitset & (1 << i)) == 0 && seg && seg->kind != SkFileC)
+         VG_(smc_protect)(addr, len);
+   }
+}
+
+
+/*------------------------------------------------------------*/
+/*--- Fast forwarding                                      ---*/
+/*------------------------------------------------------------*/
+
+/* With --fast-forward=yes, translations are made without the tool's
+   instrumentation (nor the SP tracking and tiering that go with it)
+   whilst VG_(clo_fast_forward) is set.  Starting the instrumentation
+   means discarding all the translations made so far, which is only
+   safe when no translation is being run or chained to, so a request
+   to start it just notes the reason, and the scheduler does it at its
+   next call to VG_(maybe_start_instrumentation). */
+static const HChar* start_instrumentation_why = NULL;
+
+void VG_(request_start_instrumentation) ( const HChar* why )
+{
+   if (VG_(clo_fast_forward) && start_instrumentation_why == NULL)
+      start_instrumentation_why = why;
+}
+
+void VG_(maybe_start_instrumentation) ( ULong bbs_done )
+{
+   if (!VG_(clo_fast_forward))
+      return;
+   if (start_instrumentation_why == NULL
+       && VG_(clo_fast_forward_bbs) > 0
+       && bbs_done >= (ULong)VG_(clo_fast_forward_bbs))
+      start_instrumentation_why = "--fast-forward-bbs";
+   if (start_instrumentation_why == NULL)
+      return;
+
+   if (VG_(clo_verbosity) > 0)
+      VG_(umsg)("Starting the instrumentation (%s) after %'llu blocks\n",
+                start_instrumentation_why, bbs_done);
+   VG_(clo_fast_forward) = False;
+   start_instrumentation_why = NULL;
+   VG_(discard_translations)( 0, ~0ULL, "VG_(maybe_start_instrumentation)" );
+   VG_TDICT_CALL(tool_start_instrumentation);
+}
+
+/* Does the block at nraddr start a --fast-forward-fn function? */
+static Bool is_fast_forward_fn_entry ( Addr64 nraddr )
+{
+   HChar name[256];
+   return VG_(get_fnname_if_entry)( (Addr)nraddr, name, sizeof(name) )
+          && VG_(string_match)( VG_(clo_fast_forward_fn), name );
+}
+
+/* Used as the instrumentation function whilst fast forwarding. */
+static
+IRSB* fast_forward_instrument ( VgCallbackClosure* closureV,
+                                IRSB*              sb_in,
+                                VexGuestLayout*    layout,
+                                VexGuestExtents*   vge,
+                                VexArchInfo*       vai,
+                                IRType             gWordTy,
+                                IRType             hWordTy )
+{
+   if (VG_(clo_vgdb) == Vg_VgdbNo)
+      return sb_in;
+   return VG_(instrument_for_gdbserver_if_needed)
+             ( sb_in, layout, vge, gWordTy, hWordTy );
+}
+
+
+/*------------------------------------------------------------*/
+/*--- Instrumentation filter                               ---*/
+/*------------------------------------------------------------*/
+
+/* --skip-instrument and --instrument-only give comma-separated lists
+   of obj:<pattern> and fun:<pattern>, matched against the names of
+   the object and of the function holding the start of the block being
+   translated.  The code filtered out of the instrumentation gets the
+   tool's cheap instrumentation instead, given by
+   VG_(needs_instrumentation_filter). */
+typedef
+   struct {
+      Bool         fun;    /* matches function names, else objects' */
+      const HChar* patt;
+   }
+   CodePatt;
+
+static XArray* skip_patts = NULL;   /* of CodePatt */
+static XArray* only_patts = NULL;   /* of CodePatt */
+
+/* Whether the translation being made is of filtered out code. */
+static Bool skipping_instrumentation = False;
+
+static XArray* parse_code_patts ( const HChar* option, const HChar* str )
+{
+   XArray*  patts = VG_(newXA)( VG_(malloc), "translate.pcp.1", VG_(free),
+                                sizeof(CodePatt) );
+   HChar*   copy  = VG_(strdup)( "translate.pcp.2", str );
+   HChar*   ssaveptr;
+   HChar*   elem;
+   CodePatt cp;
+
+   for (elem = VG_(strtok_r)( copy, ",", &ssaveptr );
+        elem != NULL;
+        elem = VG_(strtok_r)( NULL, ",", &ssaveptr )) {
+      if (VG_(strncmp)( elem, "obj:", 4 ) == 0)
+         cp.fun = False;
+      else if (VG_(strncmp)( elem, "fun:", 4 ) == 0)
+         cp.fun = True;
+      else
+         VG_(fmsg_bad_option)( option, "'%s' is neither obj:<pattern>"
+                               " nor fun:<pattern>\n", elem );
+      cp.patt = elem + 4;
+      VG_(addToXA)( patts, &cp );
+   }
+   return patts;
+}
+
+void VG_(init_instrumentation_filter) ( void )
+{
+   if (VG_(clo_skip_instrument) == NULL && VG_(clo_instrument_only) == NULL)
+      return;
+   if (!VG_(needs).instrumentation_filter)
+      VG_(fmsg_bad_option)( VG_(clo_skip_instrument) != NULL
+                               ? "--skip-instrument" : "--instrument-only",
+                            "%s does not support it\n", VG_(details).name );
+   if (VG_(clo_skip_instrument) != NULL)
+      skip_patts = parse_code_patts( "--skip-instrument",
+                                     VG_(clo_skip_instrument) );
+   if (VG_(clo_instrument_only) != NULL)
+      only_patts = parse_code_patts( "--instrument-only",
+                                     VG_(clo_instrument_only) );
+}
+
+/* The name of the object holding a, from its debug info if it has
+   some, else from its mapping. */
+static Bool get_code_objname ( Addr a, HChar* buf, Int nbuf )
+{
+   NSegment const* seg;
+   HChar*          name;
+
+   if (VG_(get_objname)( a, buf, nbuf ))
+      return True;
+   seg  = VG_(am_find_nsegment)( a );
+   name = seg == NULL ? NULL : VG_(am_get_filename)( seg );
+   if (name == NULL)
+      return False;
+   VG_(strncpy_safely)( buf, name, nbuf );
+   return True;
+}
+
+static Bool matches_code_patts ( XArray* patts, Addr a )
+{
+   HChar objname[512];
+   HChar fnname[256];
+   Int   have_obj = -1, have_fn = -1;   /* -1: not looked up yet */
+   Word  i;
+
+   for (i = 0; i < VG_(sizeXA)( patts ); i++) {
+      CodePatt* cp = VG_(indexXA)( patts, i );
+      if (cp->fun) {
+         if (have_fn == -1)
+            have_fn = VG_(get_fnname)( a, fnname, sizeof(fnname) );
+         if (have_fn && VG_(string_match)( cp->patt, fnname ))
+            return True;
+      } else {
+         if (have_obj == -1)
+            have_obj = get_code_objname( a, objname, sizeof(objname) );
+         if (have_obj && VG_(string_match)( cp->patt, objname ))
+            return True;
+      }
+   }
+   return False;
+}
+
+/* Is the code at addr64 filtered out of the instrumentation? */
+static Bool skip_instrumentation ( Addr64 addr64 )
+{
+   if (only_patts != NULL && !matches_code_patts( only_patts, (Addr)addr64 ))
+      return True;
+   return skip_patts != NULL && matches_code_patts( skip_patts, (Addr)addr64 );
+}
+
+Bool VG_(is_skipped_code) ( Addr a )
+{
+   return (skip_patts != NULL || only_patts != NULL)
+          && skip_instrumentation( a );
+}
+
+/* Used as the instrumentation function for filtered out code. */
+static
+IRSB* skipped_instrument ( VgCallbackClosure* closureV,
+                           IRSB*              sb_in,
+                           VexGuestLayout*    layout,
+                           VexGuestExtents*   vge,
+                           VexArchInfo*       vai,
+                           IRType             gWordTy,
+                           IRType             hWordTy )
+{
+   IRSB* sb = VG_(tdict).tool_instrument_skipped
+                 ( closureV, sb_in, layout, vge, vai, gWordTy, hWordTy );
+   if (VG_(clo_vgdb) == Vg_VgdbNo)
+      return sb;
+   return VG_(instrument_for_gdbserver_if_needed)
+             ( sb, layout, vge, gWordTy, hWordTy );
+}
+
+
 /* This is a callback passed to LibVEX_Translate.  It stops Vex from
    chasing into function entry points that we wish to redirect.
    Chasing across them obviously defeats the redirect mechanism, with
@@ -868,6 +1753,22 @@ static Bool chase_into_ok ( void* closureV, Addr64 addr64 )
    if (addr != VG_(redir_do_lookup)(addr, NULL))
       goto dontchase;
 
+   /* Forming a hot trace, and the destination isn't on it? */
+   if (forming_hot_trace && !on_hot_trace(addr64))
+      goto dontchase;
+
+   /* Crossing the border of the code filtered out of the
+      instrumentation? */
+   if ((skip_patts != NULL || only_patts != NULL) && !VG_(clo_fast_forward)
+       && skip_instrumentation(addr64) != skipping_instrumentation)
+      goto dontchase;
+
+   /* Fast forwarding to the entry of this function?  That must start
+      a block of its own, for VG_(translate) to notice it. */
+   if (VG_(clo_fast_forward) && VG_(clo_fast_forward_fn) != NULL
+       && is_fast_forward_fn_entry(addr64))
+      goto dontchase;
+
 #  if defined(VG_PLAT_USES_PPCTOC) || defined(VGP_ppc64le_linux)
    /* This needs to be at the start of its own block.  Don't chase. Re
       ULong_to_Ptr, be careful to ensure we only compare 32 bits on a
@@ -907,6 +1808,38 @@ static Bool chase_into_ok ( void* closureV, Addr64 addr64 )
 }
 
 
+/* Callback for VG_(search_transtab_cache): would a translation
+   starting at the first extent of vge, made now, still cover the
+   same extents and have the same self-checks?  The guest bytes
+   themselves are compared by m_transtab once this says yes. */
+static Bool transtab_cache_entry_ok ( void* closureV,
+                                      VexGuestExtents* vge,
+                                      UInt sc_bitmask )
+{
+   UInt i;
+
+   for (i = 0; i < vge->n_used; i++) {
+      Addr            addr = (Addr)vge->base[i];
+      SizeT           len  = (SizeT)vge->len[i];
+      NSegment const* seg  = VG_(am_find_nsegment)(addr);
+      if (!translations_allowable_from_seg(seg, addr))
+         return False;
+      if (len > 0 && addr + len - 1 > seg->end)
+         return False;
+      /* The first extent is not redirected, else we wouldn't be
+         here.  The others must still be chaseable. */
+      if (i > 0 && !chase_into_ok(closureV, vge->base[i]))
+         return False;
+   }
+
+   if (VG_(clo_vgdb) != Vg_VgdbNo
+       && VG_(gdbserver_instrumentation_needed)(vge) != Vg_VgdbNo)
+      return False;
+
+   return needs_self_check(closureV, vge) == sc_bitmask;
+}
+
+
 /* --------------- helpers for with-TOC platforms --------------- */
 
 /* NOTE: with-TOC platforms are: ppc64-linux. */
@@ -1380,6 +2313,178 @@ typedef
    }
    T_Kind;
 
+/* Make translations for the successors noted while translating the
+   superblock just added, unless they already exist.  Translation
+   requests which would fault are quietly dropped. */
+static void pretranslate_successors ( ThreadId tid, ULong bbs_done )
+{
+   Addr64 todo[N_SUCCS];
+   Int    i, n_todo = n_succs;
+
+   for (i = 0; i < n_todo; i++)
+      todo[i] = succs[i];
+   n_succs = 0;
+
+   speculating = True;
+   for (i = 0; i < n_todo; i++) {
+      if (VG_(search_transtab)( NULL, NULL, NULL, todo[i], False ))
+         continue;
+      if (VG_(translate)( tid, todo[i], /*debug*/False, 0/*not verbose*/,
+                          bbs_done, True/*allow redirection*/ ))
+         n_pretranslated++;
+   }
+   speculating = False;
+}
+
+/* Translate the code in [start, start+len) that can be reached from
+   start by direct jumps and calls, and by returning from the calls,
+   unless it is translated already.  Returns the number of
+   translations made.  Code only reached through indirect jumps (such
+   as switch tables) is left alone, as is code that would fault. */
+#define MAX_REGION_TRANSLATIONS 10000
+
+UInt VG_(pretranslate_range) ( ThreadId tid, Addr start, SizeT len,
+                               ULong bbs_done )
+{
+   OSet*   seen;
+   XArray* todo;
+   Addr64  a, found[N_SUCCS];
+   Int     i, n_found;
+   UInt    n_made = 0;
+
+   if (len == 0 || VG_(clo_fast_forward))
+      return 0;
+   seen = VG_(OSetWord_Create)( VG_(malloc), "translate.pr.1", VG_(free) );
+   todo = VG_(newXA)( VG_(malloc), "translate.pr.2", VG_(free),
+                      sizeof(Addr64) );
+   a = start;
+   VG_(addToXA)( todo, &a );
+   VG_(OSetWord_Insert)( seen, (UWord)a );
+
+   speculating = walking_region = True;
+   while (VG_(sizeXA)( todo ) > 0 && n_made < MAX_REGION_TRANSLATIONS) {
+      a = *(Addr64*)VG_(indexXA)( todo, VG_(sizeXA)( todo ) - 1 );
+      VG_(dropTailXA)( todo, 1 );
+
+      n_succs = 0;
+      /* A block translated already can't have its successors noted,
+         so the walk stops there; the client has been running it. */
+      if (VG_(search_transtab)( NULL, NULL, NULL, a, False ))
+         continue;
+      if (!VG_(translate)( tid, a, /*debug*/False, 0/*not verbose*/,
+                           bbs_done, True/*allow redirection*/ ))
+         continue;
+      n_made++;
+
+      n_found = n_succs;
+      for (i = 0; i < n_found; i++)
+         found[i] = succs[i];
+      n_succs = 0;
+      for (i = 0; i < n_found; i++) {
+         if (found[i] < start || found[i] - start >= len)
+            continue;
+         if (VG_(OSetWord_Contains)( seen, (UWord)found[i] ))
+            continue;
+         VG_(OSetWord_Insert)( seen, (UWord)found[i] );
+         VG_(addToXA)( todo, &found[i] );
+      }
+   }
+   speculating = walking_region = False;
+
+   VG_(deleteXA)( todo );
+   VG_(OSetWord_Destroy)( seen );
+   n_region_translations += n_made;
+   return n_made;
+}
+
+/* --pretranslate=<obj>:<fn>,... gives patterns for the objects and
+   functions to translate ahead of time.  The functions are looked for
+   in each object as its debug info is read, the next time the
+   scheduler gets to VG_(maybe_pretranslate). */
+typedef
+   struct {
+      const HChar* obj;
+      const HChar* fn;
+   }
+   PretransPatt;
+
+static XArray* pretrans_patts = NULL;   /* of PretransPatt */
+static OSet*   pretrans_done  = NULL;   /* DebugInfo handles looked at */
+static UInt    pretrans_gen   = 0;
+
+static void init_pretranslate ( void )
+{
+   HChar*       copy = VG_(strdup)( "translate.ip.1", VG_(clo_pretranslate) );
+   HChar*       ssaveptr;
+   HChar*       elem;
+   HChar*       colon;
+   PretransPatt pp;
+
+   pretrans_patts = VG_(newXA)( VG_(malloc), "translate.ip.2", VG_(free),
+                                sizeof(PretransPatt) );
+   pretrans_done  = VG_(OSetWord_Create)( VG_(malloc), "translate.ip.3",
+                                          VG_(free) );
+   for (elem = VG_(strtok_r)( copy, ",", &ssaveptr );
+        elem != NULL;
+        elem = VG_(strtok_r)( NULL, ",", &ssaveptr )) {
+      colon = VG_(strrchr)( elem, ':' );
+      if (colon == NULL || colon == elem || colon[1] == 0)
+         VG_(fmsg_bad_option)( "--pretranslate", "'%s' is not of the form"
+                               " <object>:<function>\n", elem );
+      *colon = 0;
+      pp.obj = elem;
+      pp.fn  = colon + 1;
+      VG_(addToXA)( pretrans_patts, &pp );
+   }
+   pretrans_gen = VG_(debugInfo_generation)() - 1;
+}
+
+static void pretranslate_DebugInfo ( ThreadId tid, const DebugInfo* di,
+                                     ULong bbs_done )
+{
+   const HChar* filename = VG_(DebugInfo_get_filename)( di );
+   const HChar* soname   = VG_(DebugInfo_get_soname)( di );
+   Int          i, j, n_syms = VG_(DebugInfo_syms_howmany)( di );
+
+   for (j = 0; j < VG_(sizeXA)( pretrans_patts ); j++) {
+      PretransPatt* pp = VG_(indexXA)( pretrans_patts, j );
+      if (!(filename != NULL && VG_(string_match)( pp->obj, filename ))
+          && !(soname != NULL && VG_(string_match)( pp->obj, soname )))
+         continue;
+      for (i = 0; i < n_syms; i++) {
+         SymAVMAs avmas;
+         UInt     size;
+         HChar*   name;
+         Bool     isText;
+         VG_(DebugInfo_syms_getidx)( di, i, &avmas, &size, &name,
+                                     NULL, &isText, NULL );
+         if (isText && size > 0 && VG_(string_match)( pp->fn, name ))
+            VG_(pretranslate_range)( tid, avmas.main, size, bbs_done );
+      }
+   }
+}
+
+void VG_(maybe_pretranslate) ( ThreadId tid, ULong bbs_done )
+{
+   const DebugInfo* di;
+
+   if (pretrans_patts == NULL)
+      init_pretranslate();
+   if (pretrans_gen == VG_(debugInfo_generation)())
+      return;
+   pretrans_gen = VG_(debugInfo_generation)();
+
+   for (di = VG_(next_DebugInfo)( NULL ); di != NULL;
+        di = VG_(next_DebugInfo)( di )) {
+      UWord handle = (UWord)VG_(DebugInfo_get_handle)( di );
+      if (VG_(DebugInfo_syms_howmany)( di ) == 0
+          || VG_(OSetWord_Contains)( pretrans_done, handle ))
+         continue;
+      VG_(OSetWord_Insert)( pretrans_done, handle );
+      pretranslate_DebugInfo( tid, di, bbs_done );
+   }
+}
+
 /* Translate the basic block beginning at NRADDR, and add it to the
    translation cache & translation table.  Unless
    DEBUGGING_TRANSLATION is true, in which case the call is being done
@@ -1392,12 +2497,36 @@ typedef
    TID is the identity of the thread requesting this translation.
 */
 
+static Bool translate_wrk ( ThreadId tid, 
+                            Addr64   nraddr,
+                            Bool     debugging_translation,
+                            Int      debugging_verbosity,
+                            ULong    bbs_done,
+                            Bool     allow_redirection );
+
 Bool VG_(translate) ( ThreadId tid, 
                       Addr64   nraddr,
                       Bool     debugging_translation,
                       Int      debugging_verbosity,
                       ULong    bbs_done,
                       Bool     allow_redirection )
+{
+   /* Count the host events for --perf-counters in the jit phase,
+      including those of successors translated in advance. */
+   VgPerfPhase prev = VG_(perf_phase)(tid, VgPerf_Jit);
+   Bool ok = translate_wrk(tid, nraddr, debugging_translation,
+                           debugging_verbosity, bbs_done,
+                           allow_redirection);
+   VG_(perf_phase)(tid, prev);
+   return ok;
+}
+
+static Bool translate_wrk ( ThreadId tid, 
+                            Addr64   nraddr,
+                            Bool     debugging_translation,
+                            Int      debugging_verbosity,
+                            ULong    bbs_done,
+                            Bool     allow_redirection )
 {
    Addr64             addr;
    T_Kind             kind;
@@ -1410,6 +2539,7 @@ Bool VG_(translate) ( ThreadId tid,
    VexTranslateArgs   vta;
    VexTranslateResult tres;
    VgCallbackClosure  closure;
+   Bool               tier0, hot_trace, hot_loops;
 
    /* Make sure Vex is initialised right. */
 
@@ -1472,7 +2602,7 @@ Bool VG_(translate) ( ThreadId tid,
                    addr, name2 );
    }
 
-   if (!debugging_translation)
+   if (!debugging_translation && !speculating)
       VG_TRACK( pre_mem_read, Vg_CoreTranslate, 
                               tid, "(translator)", addr, 1 );
 
@@ -1505,6 +2635,10 @@ Bool VG_(translate) ( ThreadId tid,
       if (VG_(clo_trace_signals))
          VG_(message)(Vg_DebugMsg, "translations not allowed here (0x%llx)"
                                    " - throwing SEGV\n", addr);
+      /* A guess that didn't work out; the client never asked for
+         this. */
+      if (speculating)
+         return False;
       /* U R busted, sonny.  Place your hands on your head and step
          away from the orig_addr. */
       /* Code address is bad - deliver a signal instead */
@@ -1563,6 +2697,62 @@ Bool VG_(translate) ( ThreadId tid,
    }
 #  endif
 
+   /* Set up closure args. */
+   closure.tid    = tid;
+   closure.nraddr = nraddr;
+   closure.readdr = addr;
+
+   /* Fast forwarding up to here?  This block still is, but the
+      scheduler will start the instrumentation before running it. */
+   if (UNLIKELY(VG_(clo_fast_forward)) && VG_(clo_fast_forward_fn) != NULL
+       && !debugging_translation && !speculating
+       && is_fast_forward_fn_entry(nraddr))
+      VG_(request_start_instrumentation)( "--fast-forward-fn" );
+
+   /* Can we avoid all the hard work, because a previous run has done
+      it already? */
+   if (kind == T_Normal && preamble_fn == NULL && !debugging_translation
+       && !VG_(clo_fast_forward)
+       && VG_(transtab_cache_active)()
+       && VG_(search_transtab_cache)( nraddr, transtab_cache_entry_ok,
+                                      (void*)&closure, &vge )) {
+      for (i = 0; i < vge.n_used; i++) {
+         NSegment const* seg2 = VG_(am_find_nsegment)( vge.base[i] );
+         /* set 'translations taken from this segment' flag */
+         VG_(am_set_segment_hasT_if_SkFileC_or_SkAnonC)( seg2 );
+      }
+      protect_unchecked_extents( &closure, &vge );
+      return True;
+   }
+
+   /* If tiering, make a cheap translation unless this block is known
+      to be hot. */
+   tier0_count = NULL;
+   tier1_count = NULL;
+   hot_trace   = False;
+   hot_loops   = False;
+   if (VG_(clo_tier_up_threshold) > 0 && !VG_(clo_fast_forward)
+       && kind == T_Normal && preamble_fn == NULL && !debugging_translation) {
+      TierCount* tc = get_tier_count( nraddr );
+      if (tc->count < VG_(clo_tier_up_threshold)) {
+         tier0_count = tc;
+      } else {
+         n_tier1_translations++;
+         hot_trace = VG_(clo_hot_traces);
+         hot_loops = VG_(clo_hot_loops);
+         if (tc->ind_site != 0)
+            tier1_count = tc;
+      }
+   }
+   tier0 = tier0_count != NULL;
+
+   /* Filtered out of the instrumentation? */
+   skipping_instrumentation
+      = (skip_patts != NULL || only_patts != NULL) && !VG_(clo_fast_forward)
+        && skip_instrumentation(addr);
+   if (skipping_instrumentation)
+      n_skipped_translations++;
+
    /* ------ Actually do the translation. ------ */
    tl_assert2(VG_(tdict).tool_instrument,
               "you forgot to set VgToolInterface function 'tool_instrument'");
@@ -1582,6 +2772,14 @@ Bool VG_(translate) ( ThreadId tid,
 #  if defined(VGP_amd64_darwin)
    vex_abiinfo.guest_amd64_assume_gs_is_0x60  = True;
 #  endif
+#  if defined(VGA_x86) || defined(VGA_amd64)
+   /* The flags thunk usually holds the same CC_OP each time the block
+      is entered, so let the front end specialise for the one it holds
+      now. */
+   if (VG_(clo_vex_control).iropt_level > 0)
+      vex_abiinfo.guest_cc_op_hint
+         = VG_(get_ThreadState)(tid)->arch.vex.guest_CC_OP;
+#  endif
 #  if defined(VGP_ppc32_linux)
    vex_abiinfo.guest_ppc_zap_RZ_at_blr        = False;
    vex_abiinfo.guest_ppc_zap_RZ_at_bl         = NULL;
@@ -1597,11 +2795,6 @@ Bool VG_(translate) ( ThreadId tid,
    vex_abiinfo.host_ppc_calls_use_fndescrs    = False;
 #  endif
 
-   /* Set up closure args. */
-   closure.tid    = tid;
-   closure.nraddr = nraddr;
-   closure.readdr = addr;
-
    /* Set up args for LibVEX_Translate. */
    vta.arch_guest       = vex_arch;
    vta.archinfo_guest   = vex_archinfo;
@@ -1625,7 +2818,15 @@ Bool VG_(translate) ( ThreadId tid,
      IRSB*(*f)(VgCallbackClosure*,
                IRSB*,VexGuestLayout*,VexGuestExtents*, VexArchInfo*,
                IRType,IRType)
-        = VG_(clo_vgdb) != Vg_VgdbNo
+        = VG_(clo_fast_forward)
+             ? fast_forward_instrument
+             : skipping_instrumentation
+             ? skipped_instrument
+             : (walking_region
+                || (VG_(clo_pretranslate_successors) && !speculating))
+          && kind != T_NoRedir && !debugging_translation
+             ? tool_instrument_noting_successors
+             : VG_(clo_vgdb) != Vg_VgdbNo
              ? tool_instrument_then_gdbserver_if_needed
              : VG_(tdict).tool_instrument;
      IRSB*(*g)(void*,
@@ -1636,17 +2837,26 @@ Bool VG_(translate) ( ThreadId tid,
      vta.instrument1     = g;
    }
    /* No need for type kludgery here. */
-   vta.instrument2       = need_to_handle_SP_assignment()
+   vta.instrument2       = tier0
+                              ? tier0_count_pass
+                              : tier1_count
+                              ? tier1_inline_cache_pass
+                              : need_to_handle_SP_assignment()
+                                && !VG_(clo_fast_forward)
                               ? vg_SP_update_pass
                               : NULL;
    vta.finaltidy         = VG_(needs).final_IR_tidy_pass
+                           && !VG_(clo_fast_forward)
                               ? VG_(tdict).tool_final_IR_tidy_pass
                               : NULL;
    vta.needs_self_check  = needs_self_check;
    vta.preamble_function = preamble_fn;
    vta.traceflags        = verbosity;
    vta.sigill_diag       = VG_(clo_sigill_diag);
-   vta.addProfInc        = VG_(clo_profyle_sbs) && kind != T_NoRedir;
+   vta.addProfInc        = (VG_(clo_profyle_sbs) || VG_(clo_hot_code_layout))
+                           && kind != T_NoRedir;
+   vta.read_clock        = VG_(clo_profile_jit)
+                              ? VG_(read_nanosecond_timer) : NULL;
 
    /* Set up the dispatch continuation-point info.  If this is a
       no-redir translation then it cannot be chained, and the chain-me
@@ -1659,7 +2869,12 @@ Bool VG_(translate) ( ThreadId tid,
       translation cache (in a secondary one) and chaining them would
       involve more adminstrative complexity that isn't worth the
       hassle, because we don't expect them to get used often.  So
-      don't bother. */
+      don't bother.
+
+      With --parallel-threads=yes nothing is chained either, since
+      other threads could be running the code being patched: direct
+      jumps go to a point which looks their destination up just as
+      for an indirect one. */
    if (allow_redirection) {
       vta.disp_cp_chain_me_to_slowEP
          = VG_(fnptr_to_fnentry)( &VG_(disp_cp_chain_me_to_slowEP) );
@@ -1667,6 +2882,14 @@ Bool VG_(translate) ( ThreadId tid,
          = VG_(fnptr_to_fnentry)( &VG_(disp_cp_chain_me_to_fastEP) );
       vta.disp_cp_xindir
          = VG_(fnptr_to_fnentry)( &VG_(disp_cp_xindir) );
+#     if defined(VGP_amd64_linux)
+      if (VG_(clo_parallel_threads)) {
+         vta.disp_cp_chain_me_to_slowEP
+            = VG_(fnptr_to_fnentry)( &VG_(disp_cp_xdirect_unchained) );
+         vta.disp_cp_chain_me_to_fastEP
+            = vta.disp_cp_chain_me_to_slowEP;
+      }
+#     endif
    } else {
       vta.disp_cp_chain_me_to_slowEP = NULL;
       vta.disp_cp_chain_me_to_fastEP = NULL;
@@ -1677,7 +2900,35 @@ Bool VG_(translate) ( ThreadId tid,
       = VG_(fnptr_to_fnentry)( &VG_(disp_cp_xassisted) );
 
    /* Sheesh.  Finally, actually _do_ the translation! */
-   tres = LibVEX_Translate ( &vta );
+   n_succs = 0;
+   if (tier0 || hot_trace || hot_loops) {
+      VexControl vcon = VG_(clo_vex_control);
+      if (tier0) {
+         if (vcon.iropt_level > 1)
+            vcon.iropt_level = 1;
+         vcon.guest_chase_thresh = 0;
+         n_tier0_translations++;
+      } else {
+         if (hot_trace) {
+            vcon.guest_chase_cond = True;
+            forming_hot_trace = True;
+         }
+         /* A hot block (or trace) that loops back to its own start is
+            unrolled by iropt as far as this allows.  Within the
+            unrolled copies guest registers stay in host registers,
+            rather than being stored and loaded again by the next
+            translation, as they are on a chained jump. */
+         if (hot_loops)
+            vcon.iropt_unroll_thresh = HOT_LOOP_UNROLL_THRESH;
+      }
+      LibVEX_Update_Control( &vcon );
+      tres = LibVEX_Translate ( &vta );
+      LibVEX_Update_Control( &VG_(clo_vex_control) );
+      forming_hot_trace = False;
+   } else {
+      tres = LibVEX_Translate ( &vta );
+   }
+   skipping_instrumentation = False;
 
    vg_assert(tres.status == VexTransOK);
    vg_assert(tres.n_sc_extents >= 0 && tres.n_sc_extents <= 3);
@@ -1700,6 +2951,9 @@ Bool VG_(translate) ( ThreadId tid,
       VG_(am_set_segment_hasT_if_SkFileC_or_SkAnonC)( seg );
    }
 
+   if (!debugging_translation)
+      protect_unchecked_extents( &closure, &vge );
+
    /* Copy data at trans_addr into the translation cache. */
    vg_assert(tmpbuf_used > 0 && tmpbuf_used < 65536);
 
@@ -1720,6 +2974,27 @@ Bool VG_(translate) ( ThreadId tid,
                                 tres.n_sc_extents > 0,
                                 tres.offs_profInc,
                                 tres.n_guest_instrs );
+
+          // And remember it for next time, if it doesn't depend on
+          // anything that might be different then.
+          if (kind == T_Normal && preamble_fn == NULL && !tier0
+              && !VG_(clo_fast_forward)
+              && VG_(transtab_cache_active)()
+              && (VG_(clo_vgdb) == Vg_VgdbNo
+                  || VG_(gdbserver_instrumentation_needed)(&vge)
+                     == Vg_VgdbNo))
+             VG_(add_to_transtab_cache)( &vge,
+                                         nraddr,
+                                         (Addr)(&tmpbuf[0]),
+                                         tmpbuf_used,
+                                         tres.n_sc_extents,
+                                         needs_self_check(&closure, &vge),
+                                         tres.offs_profInc,
+                                         tres.n_guest_instrs );
+
+          // Translate the direct successors too, whilst we're here.
+          if (n_succs > 0 && !walking_region)
+             pretranslate_successors( tid, bbs_done );
       } else {
           vg_assert(tres.offs_profInc == -1); /* -1 == unset */
           VG_(add_to_unredir_transtab)( &vge,
@@ -37,6 +37,7 @@
 #include "pub_core_libcproc.h"   // VG_(invalidate_icache)
 #include "pub_core_libcassert.h"
 #include "pub_core_libcprint.h"
+#include "pub_core_libcfile.h"   // VG_(open) et al, for --transtab-cache
 #include "pub_core_options.h"
 #include "pub_core_tooliface.h"  // For VG_(details).avg_translation_sizeB
 #include "pub_core_transtab.h"
@@ -44,6 +45,14 @@
 #include "pub_core_mallocfree.h" // VG_(out_of_memory_NORETURN)
 #include "pub_core_xarray.h"
 #include "pub_core_dispatch.h"   // For VG_(disp_cp*) addresses
+#include "pub_core_hashtable.h"
+#include "pub_core_poolalloc.h"
+#include "pub_core_clientstate.h" // VG_(args_for_valgrind)
+#include "pub_core_threadstate.h" // VG_(running_tid), for --parallel-threads
+#include "pub_core_scheduler.h"  // VG_(stop_parallel_threads)
+#include "pub_core_syscall.h"    // VG_(do_syscall3), for --smc-check=protect
+#include "pub_core_vkiscnums.h"
+#include "pub_core_perfevents.h"  // VG_(perf_map_translation)
 
 
 #define DEBUG_TRANSTAB 0
@@ -55,6 +64,16 @@
 
 /* Nr of sectors provided via command line parameter. */
 UInt VG_(clo_num_transtab_sectors) = N_SECTORS_DEFAULT;
+/* File to load/save persistent translations from/to, if any. */
+const HChar* VG_(clo_transtab_cache) = NULL;
+/* Keep translations so that discarded code can be reused? */
+Bool VG_(clo_transtab_reuse) = False;
+/* Share translations with other processes through a shared file? */
+Bool VG_(clo_transtab_share) = False;
+/* Move still-used translations out of a sector being recycled? */
+Bool VG_(clo_transtab_keep_hot) = False;
+/* Gather frequently run translations into a sector of their own? */
+Bool VG_(clo_hot_code_layout) = False;
 /* Nr of sectors.
    Will be set by VG_(init_tt_tc) to VG_(clo_num_transtab_sectors). */
 static UInt n_sectors = 0;
@@ -85,6 +104,12 @@ static UInt n_sectors = 0;
 #define ECLASS_MISC  (1 << ECLASS_WIDTH)
 #define ECLASS_N     (1 + ECLASS_MISC)
 
+/* The most bins a translation can be listed in.  Each extent is
+   listed in the bins of the (at most two) 2^ECLASS_SHIFT sized chunks
+   it overlaps; a translation which would need more is put in
+   ECLASS_MISC instead. */
+#define TTE2EC_MAX   4
+
 #define EC2TTE_DELETED  0xFFFF /* 16-bit special value */
 
 
@@ -140,10 +165,20 @@ typedef
          itself and computed once when the translation is created.
          Count is an entry count for the translation and is
          incremented by 1 every time the translation is used, if we
-         are profiling. */
-      ULong    count;
+         are profiling.  It is allocated from counter_pa rather than
+         held here, since the code increments it at a fixed address,
+         and the translation may be moved to another TTEntry (see
+         --transtab-keep-hot and --hot-code-layout).  NULL if the
+         translation is not being profiled. */
+      ULong*   countp;
       UShort   weight;
 
+      /* The value of tt_epoch when this translation was last found by
+         VG_(search_transtab).  Used by --transtab-keep-hot to tell
+         which translations are still in use when their sector is
+         recycled. */
+      UShort   last_used;
+
       /* Status of the slot.  Note, we need to be able to do lazy
          deletion, hence the Deleted state. */
       enum { InUse, Deleted, Empty } status;
@@ -175,9 +210,9 @@ typedef
          redundant but both necessary to make fast deletions work.
          The eclass info is similar to, and derived from, this entry's
          'vge' field, but it is not the same */
-      UShort n_tte2ec;      // # tte2ec pointers (1 to 3)
-      UShort tte2ec_ec[3];  // for each, the eclass #
-      UInt   tte2ec_ix[3];  // and the index within the eclass.
+      UShort n_tte2ec;               // # tte2ec pointers (1 to TTE2EC_MAX)
+      UShort tte2ec_ec[TTE2EC_MAX];  // for each, the eclass #
+      UInt   tte2ec_ix[TTE2EC_MAX];  // and the index within the eclass.
       // for i in 0 .. n_tte2ec-1
       //    sec->ec2tte[ tte2ec_ec[i] ][ tte2ec_ix[i] ] 
       // should be the index 
@@ -296,7 +331,7 @@ typedef
 /* Finally, a sector itself.  Each sector contains an array of
    TCEntries, which hold code, and an array of TTEntries, containing
    all required administrative info.  Profiling is supported using the
-   TTEntry .count and .weight fields, if required.
+   TTEntry .countp and .weight fields, if required.
 
    If the sector is not in use, all three pointers are NULL and
    tt_n_inuse is zero.  
@@ -331,6 +366,9 @@ typedef
          in strictly non-overlapping order, so we can binary search
          them at any time. */
       XArray* host_extents; /* XArray* of HostExtent */
+
+      /* The value of tt_epoch when this sector was declared full. */
+      UShort closed_epoch;
    }
    Sector;
 
@@ -352,6 +390,24 @@ typedef
 static Sector sectors[MAX_N_SECTORS];
 static Int    youngest_sector = -1;
 
+/* With --hot-code-layout=yes, the last sector is not part of the
+   rotation described above.  Instead, VG_(move_hot_translations)
+   periodically moves the most frequently run translations into it,
+   so that they are packed together rather than scattered amongst
+   code which ran only a few times.  When it fills up it is recycled
+   in the same way as the other sectors.  -1 if not in use. */
+static Int    hot_sector = -1;
+
+/* Where the TTEntry .countp counters come from. */
+static PoolAlloc* counter_pa = NULL;
+
+/* Incremented each time the youngest sector is declared full.  A
+   translation whose last_used is later than its sector's
+   closed_epoch has been used since the sector stopped receiving new
+   translations, and so is worth keeping when the sector is recycled.
+   Comparisons are done modulo 2^16. */
+static UShort tt_epoch = 0;
+
 /* The number of ULongs in each TCEntry area.  This is computed once
    at startup and does not change. */
 static Int    tc_sector_szQ = 0;
@@ -364,9 +420,9 @@ static Int    tc_sector_szQ = 0;
 static Int sector_search_order[MAX_N_SECTORS];
 
 
-/* Fast helper for the TC.  A direct-mapped cache which holds a set of
-   recently used (guest address, host address) pairs.  This array is
-   referred to directly from m_dispatch/dispatch-<platform>.S.
+/* Fast helper for the TC.  A set-associative cache which holds a set
+   of recently used (guest address, host address) pairs.  This array
+   is referred to directly from m_dispatch/dispatch-<platform>.S.
 
    Entries in tt_fast may refer to any valid TC entry, regardless of
    which sector it's in.  Consequently we must be very careful to
@@ -381,13 +437,20 @@ static Int sector_search_order[MAX_N_SECTORS];
 /*
 typedef
    struct { 
-      Addr guest;
-      Addr host;
+      Addr guest[VG_TT_FAST_WAYS];
+      Addr host[VG_TT_FAST_WAYS];
    }
-   FastCacheEntry;
+   FastCacheSet;
 */
-/*global*/ __attribute__((aligned(16)))
-           FastCacheEntry VG_(tt_fast)[VG_TT_FAST_SIZE];
+/*global*/ __attribute__((aligned(64)))
+           FastCacheSet VG_(tt_fast)[VG_TT_FAST_SIZE];
+
+/* With --parallel-threads=yes, threads run translations at the same
+   time, and the dispatcher reorders the ways of the sets it hits, so
+   they can't share VG_(tt_fast).  Each thread gets its own fast cache
+   instead, made the first time it is asked for.  Caches are kept when
+   their thread exits, for reuse by the next thread with that id. */
+static FastCacheSet** thread_fast_cache = NULL;   /* [VG_N_THREADS] */
 
 /* Make sure we're not used before initialisation. */
 static Bool init_done = False;
@@ -398,6 +461,7 @@ static Bool init_done = False;
 /* Number of fast-cache updates and flushes done. */
 static ULong n_fast_flushes = 0;
 static ULong n_fast_updates = 0;
+static ULong n_fast_evictions = 0;
 
 /* Number of full lookups done. */
 static ULong n_full_lookups = 0;
@@ -418,6 +482,27 @@ static ULong n_dump_osize = 0;
 static ULong n_disc_count = 0;
 static ULong n_disc_osize = 0;
 
+/* Number of translations moved out of a recycled sector rather than
+   dumped (--transtab-keep-hot=yes). */
+static ULong n_kept_count = 0;
+
+/* Number of translations made of entry points whose translation had
+   earlier been dumped.  dumped_entries is a direct-mapped table,
+   indexed by HASH_TT, of recently dumped entry points; collisions
+   make n_retrans_count an underestimate. */
+static ULong   n_retrans_count = 0;
+static Addr64* dumped_entries  = NULL;
+
+/* Number/tsize of translations moved into the hot sector, and number
+   of times it had to be recycled.  Also, the number of block
+   executions seen by VG_(move_hot_translations) in all sectors and in
+   the hot one, as a measure of how well it is doing. */
+static ULong n_hot_moved   = 0;
+static ULong n_hot_tsize   = 0;
+static ULong n_hot_recycles = 0;
+static ULong n_hot_execs_all = 0;
+static ULong n_hot_execs_hot = 0;
+
 
 /*-------------------------------------------------------------*/
 /*--- Misc                                                  ---*/
@@ -933,87 +1018,101 @@ void unchain_in_preparation_for_deletion ( VexArch arch_host,
 }
 
 
-/*-------------------------------------------------------------*/
-/*--- Address-range equivalence class stuff                 ---*/
-/*-------------------------------------------------------------*/
-
-/* Return equivalence class number for a range. */
-
-static Int range_to_eclass ( Addr64 start, UInt len )
+/* Undo the chained jumps out of the specified block, so that its
+   code once again only refers to the chain-me stubs and hence can
+   be copied elsewhere.  Its in-edges are left alone. */
+static
+void unchain_out_edges ( VexArch arch_host, VexEndness endness_host,
+                         UInt here_sNo, UInt here_tteNo )
 {
-   UInt mask   = (1 << ECLASS_WIDTH) - 1;
-   UInt lo     = (UInt)start;
-   UInt hi     = lo + len - 1;
-   UInt loBits = (lo >> ECLASS_SHIFT) & mask;
-   UInt hiBits = (hi >> ECLASS_SHIFT) & mask;
-   if (loBits == hiBits) {
-      vg_assert(loBits < ECLASS_N-1);
-      return loBits;
-   } else {
-      return ECLASS_MISC;
+   UWord    i, j, n, m;
+   Int      evCheckSzB = LibVEX_evCheckSzB(arch_host, endness_host);
+   TTEntry* here_tte   = index_tte(here_sNo, here_tteNo);
+   vg_assert(here_tte->status == InUse);
+
+   n = OutEdgeArr__size(&here_tte->out_edges);
+   for (i = 0; i < n; i++) {
+      OutEdge* oe = OutEdgeArr__index(&here_tte->out_edges, i);
+      // Find the corresponding entry in the "to" node's in_edges,
+      // undo the patch it describes, and remove it.
+      TTEntry* to_tte = index_tte(oe->to_sNo, oe->to_tteNo);
+      m = InEdgeArr__size(&to_tte->in_edges);
+      vg_assert(m > 0); // it must have at least one entry
+      for (j = 0; j < m; j++) {
+         InEdge* ie = InEdgeArr__index(&to_tte->in_edges, j);
+         if (ie->from_sNo == here_sNo && ie->from_tteNo == here_tteNo
+             && ie->from_offs == oe->from_offs)
+           break;
+      }
+      vg_assert(j < m); // "ie must be findable"
+      UChar* to_slow_EP = (UChar*)to_tte->tcptr;
+      UChar* to_fast_EP = to_slow_EP + evCheckSzB;
+      unchain_one(arch_host, endness_host,
+                  InEdgeArr__index(&to_tte->in_edges, j),
+                  to_fast_EP, to_slow_EP);
+      InEdgeArr__deleteIndex(&to_tte->in_edges, j);
    }
+
+   OutEdgeArr__makeEmpty(&here_tte->out_edges);
 }
 
 
+/*-------------------------------------------------------------*/
+/*--- Address-range equivalence class stuff                 ---*/
+/*-------------------------------------------------------------*/
+
 /* Calculates the equivalence class numbers for any VexGuestExtent.
-   These are written in *eclasses, which must be big enough to hold 3
-   Ints.  The number written, between 1 and 3, is returned.  The
-   eclasses are presented in order, and any duplicates are removed.
+   These are written in *eclasses, which must be big enough to hold
+   TTE2EC_MAX Ints.  The number written, between 1 and TTE2EC_MAX, is
+   returned.  The eclasses are presented in order, and any duplicates
+   are removed.
+
+   An extent which straddles a chunk boundary is listed in the classes
+   of both chunks, rather than sending the whole translation to
+   ECLASS_MISC: that way VG_(discard_translations) rarely has to look
+   at ECLASS_MISC's (potentially long) list.
 */
 
 static 
 Int vexGuestExtents_to_eclasses ( /*OUT*/Int* eclasses,
                                   VexGuestExtents* vge )
 {
-#  define SWAP(_lv1,_lv2) \
-      do { Int t = _lv1; _lv1 = _lv2; _lv2 = t; } while (0)
-
-   Int i, j, n_ec, r;
+   UInt mask = (1 << ECLASS_WIDTH) - 1;
+   Int  i, j, k, n_ec, r;
 
    vg_assert(vge->n_used >= 1 && vge->n_used <= 3);
 
    n_ec = 0;
    for (i = 0; i < vge->n_used; i++) {
-      r = range_to_eclass( vge->base[i], (UInt)vge->len[i] );
-      if (r == ECLASS_MISC) 
+      Addr64 lo = vge->base[i];
+      Addr64 hi = lo + (vge->len[i] == 0 ? 0 : vge->len[i] - 1);
+      Addr64 chunk;
+      if ((hi >> ECLASS_SHIFT) - (lo >> ECLASS_SHIFT) > 1)
          goto bad;
-      /* only add if we haven't already seen it */
-      for (j = 0; j < n_ec; j++)
-         if (eclasses[j] == r)
-            break;
-      if (j == n_ec)
-         eclasses[n_ec++] = r;
-   }
-
-   if (n_ec == 1)
-      return 1;
-
-   if (n_ec == 2) {
-      /* sort */
-      if (eclasses[0] > eclasses[1])
-         SWAP(eclasses[0], eclasses[1]);
-      return 2;
-   }
-
-   if (n_ec == 3) {
-      /* sort */
-      if (eclasses[0] > eclasses[2])
-         SWAP(eclasses[0], eclasses[2]);
-      if (eclasses[0] > eclasses[1])
-         SWAP(eclasses[0], eclasses[1]);
-      if (eclasses[1] > eclasses[2])
-         SWAP(eclasses[1], eclasses[2]);
-      return 3;
+      for (chunk = lo >> ECLASS_SHIFT; chunk <= hi >> ECLASS_SHIFT; chunk++) {
+         r = (Int)(chunk & mask);
+         /* only add if we haven't already seen it */
+         for (j = 0; j < n_ec; j++)
+            if (eclasses[j] == r)
+               break;
+         if (j < n_ec)
+            continue;
+         if (n_ec == TTE2EC_MAX)
+            goto bad;
+         /* insert, keeping them sorted */
+         for (k = n_ec; k > 0 && eclasses[k-1] > r; k--)
+            eclasses[k] = eclasses[k-1];
+         eclasses[k] = r;
+         n_ec++;
+      }
    }
 
-   /* NOTREACHED */
-   vg_assert(0);
+   vg_assert(n_ec >= 1 && n_ec <= TTE2EC_MAX);
+   return n_ec;
 
   bad:
    eclasses[0] = ECLASS_MISC;
    return 1;
-
-#  undef SWAP
 }
 
 
@@ -1064,14 +1163,14 @@ UInt addEClassNo ( /*MOD*/Sector* sec, Int ec, UShort tteno )
 static 
 void upd_eclasses_after_add ( /*MOD*/Sector* sec, Int tteno )
 {
-   Int i, r, eclasses[3];
+   Int i, r, eclasses[TTE2EC_MAX];
    TTEntry* tte;
    vg_assert(tteno >= 0 && tteno < N_TTES_PER_SECTOR);
 
    tte = &sec->tt[tteno];
    r = vexGuestExtents_to_eclasses( eclasses, &tte->vge );
 
-   vg_assert(r >= 1 && r <= 3);
+   vg_assert(r >= 1 && r <= TTE2EC_MAX);
    tte->n_tte2ec = r;
 
    for (i = 0; i < r; i++) {
@@ -1126,7 +1225,7 @@ static Bool sanity_check_eclasses_in_sector ( Sector* sec )
          tte = &sec->tt[tteno];
          if (tte->status != InUse)
             BAD("tteno points to non-inuse tte");
-         if (tte->n_tte2ec < 1 || tte->n_tte2ec > 3)
+         if (tte->n_tte2ec < 1 || tte->n_tte2ec > TTE2EC_MAX)
             BAD("tte->n_tte2ec out of range");
          /* Exactly least one of tte->eclasses[0 .. tte->n_eclasses-1]
             must equal i.  Inspect tte's eclass info. */
@@ -1169,7 +1268,7 @@ static Bool sanity_check_eclasses_in_sector ( Sector* sec )
 
       vg_assert(tte->status == InUse);
 
-      if (tte->n_tte2ec < 1 || tte->n_tte2ec > 3)
+      if (tte->n_tte2ec < 1 || tte->n_tte2ec > TTE2EC_MAX)
          BAD("tte->n_eclasses out of range(2)");
 
       for (j = 0; j < tte->n_tte2ec; j++) {
@@ -1322,41 +1421,189 @@ static inline UInt HASH_TT ( Addr64 key )
    return k32 % N_TTES_PER_SECTOR;
 }
 
+static void invalidateOneFastCache ( FastCacheSet* fc ); /* fwds */
+
+FastCacheSet* VG_(get_fast_cache) ( ThreadId tid )
+{
+   if (LIKELY(!VG_(clo_parallel_threads)))
+      return &VG_(tt_fast)[0];
+
+   vg_assert(tid >= 1 && tid < VG_N_THREADS);
+   if (UNLIKELY(thread_fast_cache == NULL))
+      thread_fast_cache = VG_(arena_calloc)(VG_AR_TTAUX, "transtab.gfc.1",
+                                            VG_N_THREADS,
+                                            sizeof(FastCacheSet*));
+   if (thread_fast_cache[tid] == NULL) {
+      SysRes sres = VG_(am_mmap_anon_float_valgrind)( sizeof(VG_(tt_fast)) );
+      if (sr_isError(sres))
+         VG_(out_of_memory_NORETURN)("VG_(get_fast_cache)",
+                                     sizeof(VG_(tt_fast)));
+      thread_fast_cache[tid] = (FastCacheSet*)(AddrH)sr_Res(sres);
+      invalidateOneFastCache(thread_fast_cache[tid]);
+   }
+   return thread_fast_cache[tid];
+}
+
+/* Put (key, tcptr) in way 0 of its set, moving the entries before
+   it, or all of them if key isn't there already, down one way.  The
+   cache is the running thread's, if there is a running thread. */
 static void setFastCacheEntry ( Addr64 key, ULong* tcptr )
 {
-   UInt cno = (UInt)VG_TT_FAST_HASH(key);
-   VG_(tt_fast)[cno].guest = (Addr)key;
-   VG_(tt_fast)[cno].host  = (Addr)tcptr;
+   FastCacheSet* set;
+   Int           w;
+   if (VG_(clo_parallel_threads) && VG_(running_tid) == VG_INVALID_THREADID)
+      return;
+   set = &VG_(get_fast_cache)(VG_(running_tid))[VG_TT_FAST_HASH(key)];
+   for (w = 0; w < VG_TT_FAST_WAYS-1; w++)
+      if (set->guest[w] == (Addr)key)
+         break;
+   if (w == VG_TT_FAST_WAYS-1
+       && set->guest[w] != (Addr)key
+       && set->guest[w] != TRANSTAB_BOGUS_GUEST_ADDR)
+      n_fast_evictions++;
+   for (; w > 0; w--) {
+      set->guest[w] = set->guest[w-1];
+      set->host[w]  = set->host[w-1];
+   }
+   set->guest[0] = (Addr)key;
+   set->host[0]  = (Addr)tcptr;
    n_fast_updates++;
    /* This shouldn't fail.  It should be assured by m_translate
       which should reject any attempt to make translation of code
       starting at TRANSTAB_BOGUS_GUEST_ADDR. */
-   vg_assert(VG_(tt_fast)[cno].guest != TRANSTAB_BOGUS_GUEST_ADDR);
+   vg_assert(set->guest[0] != TRANSTAB_BOGUS_GUEST_ADDR);
 }
 
-/* Invalidate the fast cache VG_(tt_fast). */
-static void invalidateFastCache ( void )
+static void invalidateOneFastCache ( FastCacheSet* fc )
 {
-   UInt j;
+   UInt j, w;
    /* This loop is popular enough to make it worth unrolling a
       bit, at least on ppc32. */
    vg_assert(VG_TT_FAST_SIZE > 0 && (VG_TT_FAST_SIZE % 4) == 0);
    for (j = 0; j < VG_TT_FAST_SIZE; j += 4) {
-      VG_(tt_fast)[j+0].guest = TRANSTAB_BOGUS_GUEST_ADDR;
-      VG_(tt_fast)[j+1].guest = TRANSTAB_BOGUS_GUEST_ADDR;
-      VG_(tt_fast)[j+2].guest = TRANSTAB_BOGUS_GUEST_ADDR;
-      VG_(tt_fast)[j+3].guest = TRANSTAB_BOGUS_GUEST_ADDR;
+      for (w = 0; w < VG_TT_FAST_WAYS; w++) {
+         fc[j+0].guest[w] = TRANSTAB_BOGUS_GUEST_ADDR;
+         fc[j+1].guest[w] = TRANSTAB_BOGUS_GUEST_ADDR;
+         fc[j+2].guest[w] = TRANSTAB_BOGUS_GUEST_ADDR;
+         fc[j+3].guest[w] = TRANSTAB_BOGUS_GUEST_ADDR;
+      }
    }
 
    vg_assert(j == VG_TT_FAST_SIZE);
+}
+
+/* Invalidate the fast cache VG_(tt_fast), and those of the threads
+   if they have their own.  No thread can be running translations
+   while that happens. */
+static void invalidateFastCache ( void )
+{
+   Int i;
+   VG_(stop_parallel_threads)();
+   invalidateOneFastCache(VG_(tt_fast));
+   for (i = 0; thread_fast_cache != NULL && i < VG_N_THREADS; i++)
+      if (thread_fast_cache[i] != NULL)
+         invalidateOneFastCache(thread_fast_cache[i]);
    n_fast_flushes++;
 }
 
+/* Translations taken out of a sector which is being recycled, to be
+   put back into it once it has been emptied.  Their code lives in a
+   separate buffer, at code_offs. */
+typedef
+   struct {
+      VexGuestExtents vge;
+      Addr64          entry;
+      UInt            code_offs;
+      UInt            code_len;
+      ULong*          countp;
+      UShort          weight;
+   }
+   KeptTrans;
+
+/* forward */
+static Int place_translation ( Int y, VexGuestExtents* vge, Addr64 entry,
+                               AddrH code, UInt code_len,
+                               Int offs_profInc, UInt n_guest_instrs );
+
+/* Has this translation been used since its sector was declared
+   full? */
+static Bool is_hot_TTEntry ( const Sector* sec, const TTEntry* tte )
+{
+   UShort age = (UShort)(tte->last_used - sec->closed_epoch);
+   return tte->status == InUse && age > 0 && age < 0x8000;
+}
+
+/* Copy the hot translations out of sector sno, which is about to be
+   recycled, and detach them from the chaining graph.  They are marked
+   Empty so initialiseSector neither dumps them nor tells the tool
+   about them: the tool's view of them stays valid, since the very
+   same code will be put back.  At most half the sector is kept, so
+   that there is still room for new translations afterwards.  Returns
+   the number of translations kept. */
+static Int take_hot_translations ( VexArch arch_host, VexEndness endness_host,
+                                   Int sno,
+                                   /*OUT*/KeptTrans** kept,
+                                   /*OUT*/UChar** kept_code )
+{
+   Sector* sec      = &sectors[sno];
+   Word    n_hx     = VG_(sizeXA)(sec->host_extents);
+   Int     max_kept = N_TTES_PER_SECTOR_USABLE / 2;
+   UInt    max_szB  = 4 * tc_sector_szQ;
+   Int     n_kept   = 0;
+   UInt    szB      = 0;
+   Word    i;
+
+   /* Host extents are in code address order, so keeping them in the
+      order visited preserves the layout of the kept code. */
+   for (i = 0; i < n_hx; i++) {
+      HostExtent* hx = (HostExtent*)VG_(indexXA)(sec->host_extents, i);
+      if (!is_hot_TTEntry(sec, &sec->tt[hx->tteNo]))
+         continue;
+      if (n_kept == max_kept || szB + ((hx->len + 7) & ~7) > max_szB)
+         break;
+      n_kept++;
+      szB += (hx->len + 7) & ~7;
+   }
+   if (n_kept == 0)
+      return 0;
+
+   *kept      = ttaux_malloc("transtab.tht.1", n_kept * sizeof(KeptTrans));
+   *kept_code = ttaux_malloc("transtab.tht.2", szB);
+
+   Int  n    = 0;
+   UInt offs = 0;
+   for (i = 0; i < n_hx && n < n_kept; i++) {
+      HostExtent* hx  = (HostExtent*)VG_(indexXA)(sec->host_extents, i);
+      TTEntry*    tte = &sec->tt[hx->tteNo];
+      if (!is_hot_TTEntry(sec, tte))
+         continue;
+      unchain_out_edges(arch_host, endness_host, sno, hx->tteNo);
+      unchain_in_preparation_for_deletion(arch_host, endness_host,
+                                          sno, hx->tteNo);
+      VG_(memcpy)(*kept_code + offs, hx->start, hx->len);
+      (*kept)[n].vge       = tte->vge;
+      (*kept)[n].entry     = tte->entry;
+      (*kept)[n].code_offs = offs;
+      (*kept)[n].code_len  = hx->len;
+      (*kept)[n].countp    = tte->countp;
+      (*kept)[n].weight    = tte->weight;
+      tte->status   = Empty;
+      tte->n_tte2ec = 0;
+      n++;
+      offs += (hx->len + 7) & ~7;
+   }
+   vg_assert(n == n_kept && offs == szB);
+   return n_kept;
+}
+
 static void initialiseSector ( Int sno )
 {
-   Int     i;
-   SysRes  sres;
-   Sector* sec;
+   Int        i;
+   SysRes     sres;
+   Sector*    sec;
+   Int        n_kept    = 0;
+   KeptTrans* kept      = NULL;
+   UChar*     kept_code = NULL;
    vg_assert(isValidSector(sno));
 
    { Bool sane = sanity_check_sector_search_order();
@@ -1430,7 +1677,9 @@ static void initialiseSector ( Int sno )
 
       vg_assert(sec->tt != NULL);
       vg_assert(sec->tc_next != NULL);
-      n_dump_count += sec->tt_n_inuse;
+
+      /* Nobody may be running the code we're about to throw away. */
+      VG_(stop_parallel_threads)();
 
       VexArch     arch_host = VexArch_INVALID;
       VexArchInfo archinfo_host;
@@ -1438,14 +1687,29 @@ static void initialiseSector ( Int sno )
       VG_(machine_get_VexArchInfo)( &arch_host, &archinfo_host );
       VexEndness endness_host = archinfo_host.endness;
 
+      if (VG_(clo_transtab_keep_hot))
+         n_kept = take_hot_translations(arch_host, endness_host, sno,
+                                        &kept, &kept_code);
+      n_dump_count += sec->tt_n_inuse - n_kept;
+
+      if (dumped_entries == NULL) {
+         dumped_entries
+            = ttaux_malloc("transtab.initialiseSector(dumped_entries)",
+                           N_TTES_PER_SECTOR * sizeof(Addr64));
+         VG_(memset)(dumped_entries, 0, N_TTES_PER_SECTOR * sizeof(Addr64));
+      }
+
       /* Visit each just-about-to-be-abandoned translation. */
       if (DEBUG_TRANSTAB) VG_(printf)("QQQ unlink-entire-sector: %d START\n",
                                       sno);
       for (i = 0; i < N_TTES_PER_SECTOR; i++) {
          if (sec->tt[i].status == InUse) {
             vg_assert(sec->tt[i].n_tte2ec >= 1);
-            vg_assert(sec->tt[i].n_tte2ec <= 3);
+            vg_assert(sec->tt[i].n_tte2ec <= TTE2EC_MAX);
             n_dump_osize += vge_osize(&sec->tt[i].vge);
+            dumped_entries[HASH_TT(sec->tt[i].entry)] = sec->tt[i].entry;
+            if (sec->tt[i].countp)
+               VG_(freeEltPA)(counter_pa, sec->tt[i].countp);
             /* Tell the tool too. */
             if (VG_(needs).superblock_discards) {
                VG_TDICT_CALL( tool_discard_superblock_info,
@@ -1499,6 +1763,23 @@ static void initialiseSector ( Int sno )
 
    invalidateFastCache();
 
+   /* Put back the translations kept from the old contents. */
+   if (n_kept > 0) {
+      for (i = 0; i < n_kept; i++) {
+         Int tteNo = place_translation( sno, &kept[i].vge, kept[i].entry,
+                                        (AddrH)(kept_code
+                                                + kept[i].code_offs),
+                                        kept[i].code_len, -1,
+                                        kept[i].weight );
+         sec->tt[tteNo].countp = kept[i].countp;
+      }
+      n_kept_count += n_kept;
+      ttaux_free(kept);
+      ttaux_free(kept_code);
+      VG_(debugLog)(1,"transtab", "kept %d translations in sector %d\n",
+                    n_kept, sno);
+   }
+
    { Bool sane = sanity_check_sector_search_order();
      vg_assert(sane);
    }
@@ -1519,10 +1800,7 @@ void VG_(add_to_transtab)( VexGuestExtents* vge,
                            Int              offs_profInc,
                            UInt             n_guest_instrs )
 {
-   Int    tcAvailQ, reqdQ, y, i;
-   ULong  *tcptr, *tcptr2;
-   UChar* srcP;
-   UChar* dstP;
+   Int    tcAvailQ, reqdQ, y;
 
    vg_assert(init_done);
    vg_assert(vge->n_used >= 1 && vge->n_used <= 3);
@@ -1543,6 +1821,12 @@ void VG_(add_to_transtab)( VexGuestExtents* vge,
    if (is_self_checking)
       n_in_sc_count++;
 
+   if (dumped_entries != NULL
+       && dumped_entries[HASH_TT(entry)] == entry) {
+      n_retrans_count++;
+      dumped_entries[HASH_TT(entry)] = 0;
+   }
+
    y = youngest_sector;
    vg_assert(isValidSector(y));
 
@@ -1579,8 +1863,10 @@ void VG_(add_to_transtab)( VexGuestExtents* vge,
                    "(TT loading %2d%%, TC loading %2d%%)\n",
                    y, tt_loading_pct, tc_loading_pct);
       }
+      sectors[y].closed_epoch = tt_epoch;
+      tt_epoch++;
       youngest_sector++;
-      if (youngest_sector >= n_sectors)
+      if (youngest_sector >= n_sectors || youngest_sector == hot_sector)
          youngest_sector = 0;
       y = youngest_sector;
       initialiseSector(y);
@@ -1594,7 +1880,26 @@ void VG_(add_to_transtab)( VexGuestExtents* vge,
    vg_assert(tcAvailQ >= reqdQ);
    vg_assert(sectors[y].tt_n_inuse < N_TTES_PER_SECTOR_USABLE);
    vg_assert(sectors[y].tt_n_inuse >= 0);
- 
+
+   place_translation( y, vge, entry, code, code_len,
+                      offs_profInc, n_guest_instrs );
+}
+
+
+/* Copy a translation into sector y, which must have room for it, and
+   enter it in the sector's tables and in the fast cache.  Returns its
+   TTEntry number. */
+static Int place_translation ( Int y, VexGuestExtents* vge, Addr64 entry,
+                               AddrH code, UInt code_len,
+                               Int offs_profInc, UInt n_guest_instrs )
+{
+   Int    reqdQ, i;
+   ULong  *tcptr, *tcptr2;
+   UChar* srcP;
+   UChar* dstP;
+
+   reqdQ = (code_len + 7) >> 3;
+
    /* Copy into tc. */
    tcptr = sectors[y].tc_next;
    vg_assert(tcptr >= &sectors[y].tc[0]);
@@ -1627,14 +1932,17 @@ void VG_(add_to_transtab)( VexGuestExtents* vge,
    TTEntry__init(&sectors[y].tt[i]);
    sectors[y].tt[i].status = InUse;
    sectors[y].tt[i].tcptr  = tcptr;
-   sectors[y].tt[i].count  = 0;
+   sectors[y].tt[i].countp = NULL;
    sectors[y].tt[i].weight = n_guest_instrs == 0 ? 1 : n_guest_instrs;
    sectors[y].tt[i].vge    = *vge;
    sectors[y].tt[i].entry  = entry;
+   sectors[y].tt[i].last_used = tt_epoch;
 
    /* Patch in the profile counter location, if necessary. */
    if (offs_profInc != -1) {
       vg_assert(offs_profInc >= 0 && offs_profInc < code_len);
+      sectors[y].tt[i].countp  = VG_(allocEltPA)(counter_pa);
+      *sectors[y].tt[i].countp = 0;
       VexArch     arch_host = VexArch_INVALID;
       VexArchInfo archinfo_host;
       VG_(bzero_inline)(&archinfo_host, sizeof(archinfo_host));
@@ -1643,11 +1951,12 @@ void VG_(add_to_transtab)( VexGuestExtents* vge,
       VexInvalRange vir
          = LibVEX_PatchProfInc( arch_host, endness_host,
                                 dstP + offs_profInc,
-                                &sectors[y].tt[i].count );
+                                sectors[y].tt[i].countp );
       VG_(invalidate_icache)( (void*)vir.start, vir.len );
    }
 
    VG_(invalidate_icache)( dstP, code_len );
+   VG_(perf_map_translation)( (Addr)dstP, code_len, entry );
 
    /* Add this entry to the host_extents map, checking that we're
       adding in order. */
@@ -1674,6 +1983,8 @@ void VG_(add_to_transtab)( VexGuestExtents* vge,
 
    /* Note the eclass numbers for this translation. */
    upd_eclasses_after_add( &sectors[y], i );
+
+   return i;
 }
 
 
@@ -1711,6 +2022,7 @@ Bool VG_(search_transtab) ( /*OUT*/AddrH* res_hcode,
          if (sectors[sno].tt[k].status == InUse
              && sectors[sno].tt[k].entry == guest_addr) {
             /* found it */
+            sectors[sno].tt[k].last_used = tt_epoch;
             if (upd_cache)
                setFastCacheEntry( 
                   guest_addr, sectors[sno].tt[k].tcptr );
@@ -1785,9 +2097,11 @@ Bool overlaps ( Addr64 start, ULong range, VexGuestExtents* vge )
 }
 
 
-/* Delete a tt entry, and update all the eclass data accordingly. */
+/* Take a tt entry out of use, and update all the eclass data
+   accordingly.  Its code is left in place, and the tool is not told:
+   see delete_tte. */
 
-static void delete_tte ( /*MOD*/Sector* sec, UInt secNo, Int tteno,
+static void remove_tte ( /*MOD*/Sector* sec, UInt secNo, Int tteno,
                          VexArch arch_host, VexEndness endness_host )
 {
    Int      i, ec_num, ec_idx;
@@ -1799,7 +2113,9 @@ static void delete_tte ( /*MOD*/Sector* sec, UInt secNo, Int tteno,
    vg_assert(tteno >= 0 && tteno < N_TTES_PER_SECTOR);
    tte = &sec->tt[tteno];
    vg_assert(tte->status == InUse);
-   vg_assert(tte->n_tte2ec >= 1 && tte->n_tte2ec <= 3);
+   vg_assert(tte->n_tte2ec >= 1 && tte->n_tte2ec <= TTE2EC_MAX);
+
+   VG_(stop_parallel_threads)();
 
    /* Unchain .. */
    unchain_in_preparation_for_deletion(arch_host, endness_host, secNo, tteno);
@@ -1820,9 +2136,22 @@ static void delete_tte ( /*MOD*/Sector* sec, UInt secNo, Int tteno,
    /* Now fix up this TTEntry. */
    tte->status   = Deleted;
    tte->n_tte2ec = 0;
+   sec->tt_n_inuse--;
+}
+
+/* Delete a tt entry, telling the tool it has gone. */
+
+static void delete_tte ( /*MOD*/Sector* sec, UInt secNo, Int tteno,
+                         VexArch arch_host, VexEndness endness_host )
+{
+   TTEntry* tte = &sec->tt[tteno];
+
+   remove_tte(sec, secNo, tteno, arch_host, endness_host);
+   if (tte->countp)
+      VG_(freeEltPA)(counter_pa, tte->countp);
+   tte->countp = NULL;
 
    /* Stats .. */
-   sec->tt_n_inuse--;
    n_disc_count++;
    n_disc_osize += vge_osize(&tte->vge);
 
@@ -1900,6 +2229,8 @@ Bool delete_translations_in_sector ( /*MOD*/Sector* sec, UInt secNo,
 } 
 
 
+static void smc_discard_range ( Addr64 a, ULong len );
+
 void VG_(discard_translations) ( Addr64 guest_start, ULong range,
                                  const HChar* who )
 {
@@ -1930,11 +2261,12 @@ void VG_(discard_translations) ( Addr64 guest_start, ULong range,
 
    /* There are two different ways to do this.
 
-      If the range fits within a single address-range equivalence
-      class, as will be the case for a cache line sized invalidation,
-      then we only have to inspect the set of translations listed in
-      that equivalence class, and also in the "sin-bin" equivalence
-      class ECLASS_MISC.
+      If the range covers only a few address-range equivalence
+      classes, as will be the case for a cache line or page sized
+      invalidation, then we only have to inspect the sets of
+      translations listed in those equivalence classes, and also in
+      the "sin-bin" equivalence class ECLASS_MISC.  A translation
+      overlapping the range must be listed in one of them.
 
       Otherwise, the invalidation is of a larger range and probably
       results from munmap.  In this case it's (probably!) faster just
@@ -1943,33 +2275,40 @@ void VG_(discard_translations) ( Addr64 guest_start, ULong range,
       in-situ is even more expensive).
    */
 
-   /* First off, figure out if the range falls within a single class, 
-      and if so which one. */
+   /* First off, figure out how many classes the range covers.  Since
+      the chunks it covers are consecutive, so are their classes
+      (modulo ECLASS_MISC). */
 
-   ec = ECLASS_MISC;
-   if (range < (1ULL << ECLASS_SHIFT))
-      ec = range_to_eclass( guest_start, (UInt)range );
+   Addr64 last     = range - 1 > ~0ULL - guest_start ? ~0ULL
+                                                     : guest_start + range - 1;
+   ULong  n_chunks = (last >> ECLASS_SHIFT) - (guest_start >> ECLASS_SHIFT)
+                     + 1;
 
-   /* if ec is ECLASS_MISC then we aren't looking at just a single
-      class, so use the slow scheme.  Else use the fast scheme,
-      examining 'ec' and ECLASS_MISC. */
+   /* If that is more than half of them, use the slow scheme.  Else use
+      the fast scheme, examining those classes and ECLASS_MISC. */
 
-   if (ec != ECLASS_MISC) {
+   if (n_chunks <= ECLASS_MISC / 2) {
+
+      UInt mask = (1 << ECLASS_WIDTH) - 1;
+      ec = (Int)((guest_start >> ECLASS_SHIFT) & mask);
 
       VG_(debugLog)(2, "transtab",
-                       "                    FAST, ec = %d\n", ec);
+                       "                    FAST, ec = %d, %llu classes\n",
+                       ec, n_chunks);
 
       /* Fast scheme */
-      vg_assert(ec >= 0 && ec < ECLASS_MISC);
-
       for (sno = 0; sno < n_sectors; sno++) {
+         ULong c;
          sec = &sectors[sno];
          if (sec->tc == NULL)
             continue;
-         anyDeleted |= delete_translations_in_sector_eclass( 
-                          sec, sno, guest_start, range, ec, 
-                          arch_host, endness_host
-                       );
+         for (c = 0; c < n_chunks; c++) {
+            anyDeleted |= delete_translations_in_sector_eclass( 
+                             sec, sno, guest_start, range,
+                             (Int)((ec + c) & mask),
+                             arch_host, endness_host
+                          );
+         }
          anyDeleted |= delete_translations_in_sector_eclass( 
                           sec, sno, guest_start, range, ECLASS_MISC,
                           arch_host, endness_host
@@ -1981,7 +2320,8 @@ void VG_(discard_translations) ( Addr64 guest_start, ULong range,
       /* slow scheme */
 
       VG_(debugLog)(2, "transtab",
-                       "                    SLOW, ec = %d\n", ec);
+                       "                    SLOW, %llu classes\n",
+                       n_chunks);
 
       for (sno = 0; sno < n_sectors; sno++) {
          sec = &sectors[sno];
@@ -2001,6 +2341,9 @@ void VG_(discard_translations) ( Addr64 guest_start, ULong range,
    /* don't forget the no-redir cache */
    unredir_discard_translations( guest_start, range );
 
+   /* nor any write-protected pages */
+   smc_discard_range( guest_start, range );
+
    /* Post-deletion sanity check */
    if (VG_(clo_sanity_level >= 4)) {
       Int      i;
@@ -2024,6 +2367,185 @@ void VG_(discard_translations) ( Addr64 guest_start, ULong range,
 }
 
 
+/*------------------------------------------------------------*/
+/*--- Hot code layout.                                     ---*/
+/*------------------------------------------------------------*/
+
+/* A translation is moved into the hot sector if it has run at least
+   this many times since the previous VG_(move_hot_translations). */
+#define HOT_MIN_COUNT 1000
+
+/* A chained jump into or out of a translation which is being moved,
+   to be redone once it has been. */
+typedef
+   struct {
+      UInt sNo;    /* the translation at the other end */
+      UInt tteNo;
+      UInt offs;   /* offset of the patch point in its translation */
+      Bool fastEP;
+   }
+   Rechain;
+
+/* Move translation tteNo of sector sNo to sector to_sNo, which must
+   have room for it, and redo the chained jumps into and out of it.
+   As with discarded translations, the old code is left intact until
+   its sector is recycled, so it is safe to do this to a translation
+   which is still being run. */
+static void move_translation ( VexArch arch_host, VexEndness endness_host,
+                               UInt sNo, UInt tteNo, UInt to_sNo )
+{
+   Sector*  sec = &sectors[sNo];
+   TTEntry* tte = index_tte(sNo, tteNo);
+   UWord    i, j, n, m;
+
+   vg_assert(tte->status == InUse);
+   vg_assert(sNo != to_sNo);
+
+   /* Find the length of its code. */
+   HostExtent key;
+   VG_(memset)(&key, 0, sizeof(key));
+   key.start = (UChar*)tte->tcptr;
+   key.len   = 1;
+   Word firstW = -1, lastW = -1;
+   Bool found  = VG_(lookupXA_UNSAFE)( sec->host_extents, &key,
+                                       &firstW, &lastW, HostExtent__cmpOrd );
+   vg_assert(found && firstW == lastW);
+   HostExtent* hx = (HostExtent*)VG_(indexXA)(sec->host_extents, firstW);
+   vg_assert(hx->tteNo == tteNo && hx->start == (UChar*)tte->tcptr);
+   UInt code_len = hx->len;
+
+   /* Note the chained jumps.  A jump from the translation to itself
+      is only recorded as an out edge. */
+   XArray* ins  = VG_(newXA)(ttaux_malloc, "transtab.mt.1",
+                             ttaux_free, sizeof(Rechain));
+   XArray* outs = VG_(newXA)(ttaux_malloc, "transtab.mt.2",
+                             ttaux_free, sizeof(Rechain));
+   n = InEdgeArr__size(&tte->in_edges);
+   for (i = 0; i < n; i++) {
+      InEdge* ie = InEdgeArr__index(&tte->in_edges, i);
+      if (ie->from_sNo == sNo && ie->from_tteNo == tteNo)
+         continue;
+      Rechain rc = { ie->from_sNo, ie->from_tteNo, ie->from_offs,
+                     ie->to_fastEP };
+      VG_(addToXA)(ins, &rc);
+   }
+   n = OutEdgeArr__size(&tte->out_edges);
+   for (i = 0; i < n; i++) {
+      OutEdge* oe     = OutEdgeArr__index(&tte->out_edges, i);
+      TTEntry* to_tte = index_tte(oe->to_sNo, oe->to_tteNo);
+      InEdge*  ie     = NULL;
+      m = InEdgeArr__size(&to_tte->in_edges);
+      for (j = 0; j < m; j++) {
+         ie = InEdgeArr__index(&to_tte->in_edges, j);
+         if (ie->from_sNo == sNo && ie->from_tteNo == tteNo
+             && ie->from_offs == oe->from_offs)
+            break;
+      }
+      vg_assert(j < m); // "ie must be findable"
+      Rechain rc = { oe->to_sNo, oe->to_tteNo, oe->from_offs,
+                     ie->to_fastEP };
+      VG_(addToXA)(outs, &rc);
+   }
+
+   /* Unchain its exits so the code can be copied, copy it, and take
+      the original out of use. */
+   unchain_out_edges(arch_host, endness_host, sNo, tteNo);
+   Int new_tteNo = place_translation( to_sNo, &tte->vge, tte->entry,
+                                      (AddrH)tte->tcptr, code_len,
+                                      -1, tte->weight );
+   TTEntry* new_tte = index_tte(to_sNo, new_tteNo);
+   new_tte->last_used = tte->last_used;
+   new_tte->countp    = tte->countp;
+   tte->countp        = NULL;
+   remove_tte(sec, sNo, tteNo, arch_host, endness_host);
+
+   /* And redo the chaining, to and from the new copy. */
+   n = VG_(sizeXA)(outs);
+   for (i = 0; i < n; i++) {
+      Rechain* rc = (Rechain*)VG_(indexXA)(outs, i);
+      Bool self = rc->sNo == sNo && rc->tteNo == tteNo;
+      VG_(tt_tc_do_chaining)( (UChar*)new_tte->tcptr + rc->offs,
+                              self ? to_sNo : rc->sNo,
+                              self ? new_tteNo : rc->tteNo,
+                              rc->fastEP );
+   }
+   n = VG_(sizeXA)(ins);
+   for (i = 0; i < n; i++) {
+      Rechain* rc       = (Rechain*)VG_(indexXA)(ins, i);
+      TTEntry* from_tte = index_tte(rc->sNo, rc->tteNo);
+      VG_(tt_tc_do_chaining)( (UChar*)from_tte->tcptr + rc->offs,
+                              to_sNo, new_tteNo, rc->fastEP );
+   }
+   VG_(deleteXA)(ins);
+   VG_(deleteXA)(outs);
+
+   n_hot_moved++;
+   n_hot_tsize += code_len;
+}
+
+/* Move the translations which have run often since the last call
+   into the hot sector, and (unless the counts are also wanted for
+   profiling) start counting afresh. */
+void VG_(move_hot_translations) ( void )
+{
+   Int  sno, i;
+   Bool recycled = False;
+
+   vg_assert(init_done);
+   if (hot_sector == -1)
+      return;
+
+   VexArch     arch_host = VexArch_INVALID;
+   VexArchInfo archinfo_host;
+   VG_(bzero_inline)(&archinfo_host, sizeof(archinfo_host));
+   VG_(machine_get_VexArchInfo)( &arch_host, &archinfo_host );
+   VexEndness endness_host = archinfo_host.endness;
+
+   if (sectors[hot_sector].tc == NULL)
+      initialiseSector(hot_sector);
+
+   for (sno = 0; sno < n_sectors; sno++) {
+      Sector* sec = &sectors[sno];
+      if (sec->tc == NULL)
+         continue;
+      for (i = 0; i < N_TTES_PER_SECTOR; i++) {
+         TTEntry* tte    = &sec->tt[i];
+         ULong*   countp = tte->countp;
+         if (tte->status != InUse || countp == NULL)
+            continue;
+         if (!VG_(clo_profyle_sbs)) {
+            n_hot_execs_all += *countp;
+            if (sno == hot_sector)
+               n_hot_execs_hot += *countp;
+         }
+         if (sno != hot_sector && *countp >= HOT_MIN_COUNT) {
+            /* Make sure there is room for the biggest possible
+               translation.  If not, recycle the hot sector, but only
+               once per call: if it fills up that quickly, there is
+               too much hot code for it to help. */
+            Sector* hsec = &sectors[hot_sector];
+            Int tcAvailQ = ((ULong*)(&hsec->tc[tc_sector_szQ]))
+                           - ((ULong*)(hsec->tc_next));
+            if (tcAvailQ < 60000/8 + 1
+                || hsec->tt_n_inuse >= N_TTES_PER_SECTOR_USABLE) {
+               if (recycled)
+                  continue;
+               hsec->closed_epoch = (UShort)(tt_epoch - 1);
+               initialiseSector(hot_sector);
+               n_hot_recycles++;
+               recycled = True;
+            }
+            move_translation(arch_host, endness_host, sno, i, hot_sector);
+         }
+         /* If it was moved, the copy in the hot sector shares the
+            counter, so it is not counted twice. */
+         if (!VG_(clo_profyle_sbs))
+            *countp = 0;
+      }
+   }
+}
+
+
 /*------------------------------------------------------------*/
 /*--- AUXILIARY: the unredirected TT/TC                    ---*/
 /*------------------------------------------------------------*/
@@ -2188,6 +2710,929 @@ static void unredir_discard_translations( Addr64 guest_start, ULong range )
 }
 
 
+/*------------------------------------------------------------*/
+/*--- AUXILIARY: the persistent translation cache          ---*/
+/*------------------------------------------------------------*/
+
+/* With --transtab-cache=<file>, translations made for tools which
+   have called VG_(needs_persistent_translations) are remembered,
+   together with the guest bytes they were made from, and written to
+   <file> at exit.  A later run of the same tool executable with the
+   same options on the same kind of host loads the file at startup,
+   and VG_(translate) consults it on a TT miss before going to the
+   trouble of calling LibVEX_Translate.
+
+   This works because translations are position-independent already:
+   LibVEX_Translate emits them into a temporary buffer, from which
+   VG_(add_to_transtab) copies them into the TC.  The only things
+   they refer to are the dispatcher and helper functions in the
+   (statically linked, never relocated) tool executable, by absolute
+   address.  Chaining patches are done on the TC copy, so what we
+   record here is always the unchained form.
+
+   A cached translation is only used if every guest extent it was
+   made from still holds exactly the same bytes, so rebuilding,
+   replacing or remapping an object invalidates its entries without
+   any help from the user.  Entries which fail that check are
+   dropped, and replaced by the fresh translation, when the file is
+   next written.
+
+   With --transtab-reuse=yes, the same records are kept without a
+   file, for the benefit of this run only: when code whose
+   translations were discarded -- an object unmapped by dlclose and
+   mapped again at the same address by dlopen, say -- is run again,
+   VG_(translate) finds it unchanged and takes the recorded
+   translation instead of making it all over again.  Translations can
+   not be reused for the same bytes at a different address, since
+   they embed the guest addresses of the code (the PCs written back
+   to the guest state, the targets of the exits, rip-relative
+   operands) as constants.
+
+   With --transtab-share=yes, the records go into a file mapped
+   shared by every process running the same tool executable with the
+   same options -- typically the children a server forks or execs
+   under --trace-children=yes -- so that a child finds the parent's
+   translations of libc and the like already made.  Processes only
+   ever append to the file: a record is written in space reserved by
+   an atomic add to 'used', and then published by a compare-and-swap
+   onto the head of its hash chain, so readers never see one half
+   written and no locking is needed.  The file is not truncated when
+   it fills up; translations are then just not shared any more.
+   Since client code is not usually mapped at the same address in
+   unrelated programs, records are only useful between runs of the
+   same program (or of programs using the same libraries at the same
+   addresses, as aspacem places them deterministically). */
+
+#define TCACHE_MAGIC       "VGTCACH1"
+#define TCACHE_MAX_ENTRIES 1000000
+/* Stop recording new translations once they take this much memory. */
+#define TCACHE_MAX_SZB     (512ULL * 1024 * 1024)
+
+/* On-disk (and in-memory) form of one cached translation.  The
+   record is followed by 'guest_len' bytes of guest code (the
+   concatenation of the vge extents) and then 'code_len' bytes of
+   host code, padded up to an 8-byte boundary. */
+typedef
+   struct {
+      Addr64          nraddr;
+      VexGuestExtents vge;
+      UInt            sc_bitmask;
+      UInt            n_sc_extents;
+      Int             offs_profInc;
+      UInt            n_guest_instrs;
+      UInt            guest_len;
+      UInt            code_len;
+   }
+   TCacheRec;
+
+typedef
+   struct {
+      HChar magic[8];
+      ULong key;
+      ULong n_recs;
+   }
+   TCacheHdr;
+
+/* Hash table node.  The first two fields must match VgHashNode. */
+typedef
+   struct _TCacheNode {
+      struct _TCacheNode* next;
+      UWord               key;  /* == rec->nraddr */
+      TCacheRec*          rec;
+      Bool                rec_is_malloced;
+   }
+   TCacheNode;
+
+static Bool        tcache_active = False;
+static ULong       tcache_key    = 0;
+static VgHashTable tcache_ht     = NULL;
+
+/* The image of the loaded file, if any.  Records from it are
+   referenced in place. */
+static UChar* tcache_image      = NULL;
+static SizeT  tcache_image_szB  = 0;
+
+/* Stats. */
+static ULong n_tcache_loaded   = 0;
+static ULong n_tcache_hits     = 0;
+static ULong n_tcache_rejected = 0;
+static ULong n_tcache_recorded = 0;
+static ULong tcache_recorded_szB = 0;
+
+/* The shared file (--transtab-share=yes).  The header is followed by
+   records, each a TShareRec whose TCacheRec is laid out as above.
+   Offsets are from the start of the file; 0 means none. */
+#define TSHARE_MAGIC     "VGTSHAR1"
+#define TSHARE_N_BUCKETS 65536
+#if VG_WORDSIZE == 8
+#  define TSHARE_SZB     (256U * 1024 * 1024)
+#else
+#  define TSHARE_SZB     (32U * 1024 * 1024)
+#endif
+#define TSHARE_MAX_CHAIN 64
+
+typedef
+   struct {
+      HChar         magic[8];
+      ULong         key;
+      UInt          szB;
+      volatile UInt used;
+      volatile UInt buckets[TSHARE_N_BUCKETS];
+   }
+   TShareHdr;
+
+typedef
+   struct {
+      UInt      next;
+      UInt      pad;
+      TCacheRec rec;
+   }
+   TShareRec;
+
+static TShareHdr* tshare      = NULL;
+static Bool       tshare_full = False;
+
+static ULong n_tshare_hits      = 0;
+static ULong n_tshare_rejected  = 0;
+static ULong n_tshare_published = 0;
+
+static inline UInt TCacheRec__size ( const TCacheRec* rec )
+{
+   return VG_ROUNDUP(sizeof(TCacheRec) + rec->guest_len + rec->code_len, 8);
+}
+
+static inline UChar* TCacheRec__guest ( TCacheRec* rec )
+{
+   return ((UChar*)rec) + sizeof(TCacheRec);
+}
+
+static inline UChar* TCacheRec__code ( TCacheRec* rec )
+{
+   return ((UChar*)rec) + sizeof(TCacheRec) + rec->guest_len;
+}
+
+static ULong fnv1a64 ( ULong h, const void* p, SizeT n )
+{
+   const UChar* b = p;
+   SizeT i;
+   for (i = 0; i < n; i++) {
+      h ^= b[i];
+      h *= 0x100000001b3ULL;
+   }
+   return h;
+}
+
+/* Compute the key which a cache file must carry for its contents to
+   be usable in this run: the identity of the tool executable, the
+   host's capabilities and all options which can affect code
+   generation or instrumentation.  Options which only say where the
+   output goes, or how much of it there is, are left out, so that eg
+   --log-file=x.%p doesn't make every run distinct. */
+static ULong compute_tcache_key ( void )
+{
+   ULong       h = 0xcbf29ce484222325ULL;
+   Int         i;
+   VexArch     arch;
+   VexArchInfo archinfo;
+
+   h = fnv1a64(h, VG_(details).name, VG_(strlen)(VG_(details).name));
+
+#  if defined(VGO_linux)
+   { struct vg_stat st;
+     SysRes sr = VG_(stat)("/proc/self/exe", &st);
+     if (!sr_isError(sr)) {
+        h = fnv1a64(h, &st.dev,   sizeof(st.dev));
+        h = fnv1a64(h, &st.ino,   sizeof(st.ino));
+        h = fnv1a64(h, &st.size,  sizeof(st.size));
+        h = fnv1a64(h, &st.mtime, sizeof(st.mtime));
+     }
+   }
+#  endif
+   /* Cheap, and changes whenever the tool is relinked differently. */
+   { Addr a = (Addr)&VG_(add_to_transtab);
+     h = fnv1a64(h, &a, sizeof(a));
+   }
+
+   VG_(machine_get_VexArchInfo)( &arch, &archinfo );
+   h = fnv1a64(h, &arch,             sizeof(arch));
+   h = fnv1a64(h, &archinfo.hwcaps,  sizeof(archinfo.hwcaps));
+   h = fnv1a64(h, &archinfo.endness, sizeof(archinfo.endness));
+
+   for (i = 0; i < VG_(sizeXA)( VG_(args_for_valgrind) ); i++) {
+      const HChar* arg = * (HChar**) VG_(indexXA)( VG_(args_for_valgrind), i );
+      if (VG_STREQN(6,  arg, "--log-")
+          || VG_STREQN(6,  arg, "--xml-")
+          || VG_STREQN(7,  arg, "--stats")
+          || VG_STREQ(arg, "-v") || VG_STREQ(arg, "--verbose")
+          || VG_STREQ(arg, "-q") || VG_STREQ(arg, "--quiet")
+          || VG_STREQN(16, arg, "--transtab-cache")
+          || VG_STREQN(16, arg, "--transtab-reuse")
+          || VG_STREQN(16, arg, "--transtab-share"))
+         continue;
+      h = fnv1a64(h, arg, VG_(strlen)(arg) + 1);
+   }
+   return h;
+}
+
+static void tcache_add_node ( TCacheRec* rec, Bool rec_is_malloced )
+{
+   TCacheNode* node = VG_(HT_remove)(tcache_ht, (UWord)rec->nraddr);
+   if (node) {
+      if (node->rec_is_malloced)
+         ttaux_free(node->rec);
+   } else {
+      node = ttaux_malloc("transtab.tcache.node", sizeof(TCacheNode));
+   }
+   node->key             = (UWord)rec->nraddr;
+   node->rec             = rec;
+   node->rec_is_malloced = rec_is_malloced;
+   VG_(HT_add_node)(tcache_ht, node);
+}
+
+/* Does the record at 'rec', of which only 'avail' bytes are known to
+   be there, look sane? */
+static Bool tcache_rec_sane ( const TCacheRec* rec, SizeT avail )
+{
+   return avail >= sizeof(TCacheRec)
+          && rec->vge.n_used >= 1 && rec->vge.n_used <= 3
+          && rec->code_len > 0 && rec->code_len < 60000
+          && rec->n_guest_instrs < 200
+          && rec->guest_len
+             == (UInt)rec->vge.len[0]
+                + (rec->vge.n_used > 1 ? (UInt)rec->vge.len[1] : 0)
+                + (rec->vge.n_used > 2 ? (UInt)rec->vge.len[2] : 0)
+          && TCacheRec__size(rec) <= avail;
+}
+
+/* Is 'fd' a regular file which belongs to us and which nobody else
+   can write?  Only then may code read from it be run. */
+static Bool tcache_file_is_private ( Int fd, struct vg_stat* st )
+{
+   return VG_(fstat)(fd, st) == 0
+          && VKI_S_ISREG(st->mode)
+          && st->uid == VG_(geteuid)()
+          && (st->mode & (VKI_S_IWGRP|VKI_S_IWOTH)) == 0;
+}
+
+static void load_tcache ( void )
+{
+   SysRes    sres;
+   Int       fd;
+   Long      szB;
+   SizeT     done, off;
+   ULong     n;
+   TCacheHdr hdr;
+   struct vg_stat st;
+
+   sres = VG_(open)(VG_(clo_transtab_cache), VKI_O_RDONLY, 0);
+   if (sr_isError(sres)) {
+      VG_(debugLog)(1, "transtab", "no translation cache file %s\n",
+                    VG_(clo_transtab_cache));
+      return;
+   }
+   fd  = sr_Res(sres);
+   if (!tcache_file_is_private(fd, &st)) {
+      VG_(umsg)("Warning: ignoring translation cache file %s: it is not "
+                "a regular file owned by, and only writable by, "
+                "this user\n", VG_(clo_transtab_cache));
+      VG_(close)(fd);
+      return;
+   }
+   szB = VG_(fsize)(fd);
+   if (szB < (Long)sizeof(TCacheHdr)
+       || VG_(read)(fd, &hdr, sizeof(hdr)) != sizeof(hdr)
+       || VG_(memcmp)(hdr.magic, TCACHE_MAGIC, sizeof(hdr.magic)) != 0) {
+      VG_(umsg)("Warning: ignoring invalid translation cache file %s\n",
+                VG_(clo_transtab_cache));
+      VG_(close)(fd);
+      return;
+   }
+   if (hdr.key != tcache_key) {
+      /* Made by a different tool, tool build, host or option set. */
+      VG_(debugLog)(1, "transtab", "translation cache %s is stale\n",
+                    VG_(clo_transtab_cache));
+      VG_(close)(fd);
+      return;
+   }
+
+   tcache_image_szB = szB - sizeof(TCacheHdr);
+   if (tcache_image_szB == 0) {
+      VG_(close)(fd);
+      return;
+   }
+   sres = VG_(am_mmap_anon_float_valgrind)( tcache_image_szB );
+   if (sr_isError(sres)) {
+      VG_(out_of_memory_NORETURN)("load_tcache", tcache_image_szB);
+      /*NOTREACHED*/
+   }
+   tcache_image = (UChar*)(AddrH)sr_Res(sres);
+   done = 0;
+   while (done < tcache_image_szB) {
+      Int r = VG_(read)(fd, tcache_image + done, tcache_image_szB - done);
+      if (r <= 0)
+         break;
+      done += r;
+   }
+   VG_(close)(fd);
+
+   /* Walk the records, stopping at the first one which doesn't look
+      sane (eg, a truncated file). */
+   off = 0;
+   for (n = 0; n < hdr.n_recs && n < TCACHE_MAX_ENTRIES; n++) {
+      TCacheRec* rec = (TCacheRec*)(tcache_image + off);
+      if (!tcache_rec_sane(rec, done - off))
+         break;
+      tcache_add_node(rec, False);
+      off += TCacheRec__size(rec);
+      n_tcache_loaded++;
+   }
+
+   VG_(debugLog)(1, "transtab", "loaded %llu translations from %s\n",
+                 n_tcache_loaded, VG_(clo_transtab_cache));
+}
+
+/* Map the file 'fd' as the shared cache, if it is one for this
+   run.  It must belong to us and be writable by nobody else, since
+   we are going to run the code in it. */
+static Bool map_tshare ( Int fd, Bool check_hdr )
+{
+   struct vg_stat st;
+   SysRes sres;
+
+   if (!tcache_file_is_private(fd, &st)
+       || st.size != TSHARE_SZB)
+      return False;
+   sres = VG_(am_shared_mmap_file_float_valgrind)
+             ( TSHARE_SZB, VKI_PROT_READ|VKI_PROT_WRITE, fd, 0 );
+   if (sr_isError(sres))
+      return False;
+   tshare = (TShareHdr*)(AddrH)sr_Res(sres);
+   if (check_hdr
+       && (VG_(memcmp)(tshare->magic, TSHARE_MAGIC,
+                       sizeof(tshare->magic)) != 0
+           || tshare->key != tcache_key || tshare->szB != TSHARE_SZB)) {
+      VG_(am_munmap_valgrind)( (Addr)tshare, TSHARE_SZB );
+      tshare = NULL;
+      return False;
+   }
+   return True;
+}
+
+/* Find the shared cache file for this tool executable and option set,
+   creating it if need be.  A new file is set up under a temporary
+   name and renamed into place, so nobody maps it before it has a
+   header.  If two processes create it at once, the second one's file
+   replaces the first, which its creator goes on using alone. */
+static void init_tshare ( void )
+{
+   const HChar* tmpdir = VG_(tmpdir)();
+   HChar* name;
+   HChar* tmpname;
+   SysRes sres;
+   Int    fd;
+   UChar  zero = 0;
+
+   name    = VG_(malloc)("transtab.tshare.name", VG_(strlen)(tmpdir) + 64);
+   tmpname = VG_(malloc)("transtab.tshare.name", VG_(strlen)(tmpdir) + 64);
+   VG_(sprintf)(name, "%s/vgtt-%d-%016llx", tmpdir, VG_(geteuid)(),
+                tcache_key);
+   VG_(sprintf)(tmpname, "%s.tmp.%d", name, VG_(getpid)());
+
+   sres = VG_(open)(name, VKI_O_RDWR, 0);
+   if (!sr_isError(sres)) {
+      fd = sr_Res(sres);
+      if (map_tshare(fd, True)) {
+         VG_(close)(fd);
+         VG_(debugLog)(1, "transtab", "sharing translations in %s, "
+                       "%u bytes used\n", name, tshare->used);
+         goto out;
+      }
+      VG_(close)(fd);
+   }
+
+   sres = VG_(open)(tmpname, VKI_O_CREAT|VKI_O_EXCL|VKI_O_RDWR,
+                    VKI_S_IRUSR|VKI_S_IWUSR);
+   if (sr_isError(sres)) {
+      VG_(umsg)("Warning: cannot create shared translation cache %s\n",
+                tmpname);
+      goto out;
+   }
+   fd = sr_Res(sres);
+   /* Make it full size without writing it all out; the pages only
+      take up space as they are used. */
+   if (VG_(lseek)(fd, TSHARE_SZB - 1, VKI_SEEK_SET) != TSHARE_SZB - 1
+       || VG_(write)(fd, &zero, 1) != 1
+       || !map_tshare(fd, False)) {
+      VG_(umsg)("Warning: cannot set up shared translation cache %s\n",
+                tmpname);
+      VG_(close)(fd);
+      VG_(unlink)(tmpname);
+      goto out;
+   }
+   VG_(close)(fd);
+   tshare->key  = tcache_key;
+   tshare->szB  = TSHARE_SZB;
+   tshare->used = VG_ROUNDUP(sizeof(TShareHdr), 8);
+   VG_(memcpy)(tshare->magic, TSHARE_MAGIC, sizeof(tshare->magic));
+   if (VG_(rename)(tmpname, name) != 0)
+      VG_(unlink)(tmpname);
+   VG_(debugLog)(1, "transtab", "created shared translation cache %s\n",
+                 name);
+
+  out:
+   VG_(free)(tmpname);
+   VG_(free)(name);
+}
+
+static void init_tcache ( void )
+{
+   if (VG_(clo_transtab_cache) == NULL && !VG_(clo_transtab_reuse)
+       && !VG_(clo_transtab_share))
+      return;
+   if (!VG_(needs).persistent_translations) {
+      VG_(umsg)("Warning: %s is not supported by this tool"
+                " (or with its current options); ignored.\n",
+                VG_(clo_transtab_cache) ? "--transtab-cache"
+                : VG_(clo_transtab_reuse) ? "--transtab-reuse"
+                                          : "--transtab-share");
+      return;
+   }
+   tcache_active = True;
+   tcache_key    = compute_tcache_key();
+   /* The records are only kept in this process if they are to be
+      saved or reused; otherwise the shared file holds them. */
+   if (VG_(clo_transtab_cache) || VG_(clo_transtab_reuse))
+      tcache_ht  = VG_(HT_construct)("transtab.tcache");
+   if (VG_(clo_transtab_cache))
+      load_tcache();
+   if (VG_(clo_transtab_share))
+      init_tshare();
+}
+
+Bool VG_(transtab_cache_active) ( void )
+{
+   return tcache_active;
+}
+
+/* Would 'rec' be made again from the code now at its guest address?
+   Let the caller check the extents are still mapped and would still
+   be translated the same way, and only then look at the guest bytes
+   themselves. */
+static Bool tcache_rec_matches ( TCacheRec* rec,
+                                 Bool (*entry_ok)( void* opaque,
+                                                   VexGuestExtents* vge,
+                                                   UInt sc_bitmask ),
+                                 void* opaque )
+{
+   UChar* guest;
+   UInt   i;
+
+   if (!entry_ok(opaque, &rec->vge, rec->sc_bitmask))
+      return False;
+   guest = TCacheRec__guest(rec);
+   for (i = 0; i < rec->vge.n_used; i++) {
+      if (VG_(memcmp)(guest, (void*)(Addr)rec->vge.base[i],
+                      rec->vge.len[i]) != 0)
+         return False;
+      guest += rec->vge.len[i];
+   }
+   return True;
+}
+
+static inline UInt tshare_bucket ( Addr64 nraddr )
+{
+   return (UInt)((nraddr ^ (nraddr >> 16)) % TSHARE_N_BUCKETS);
+}
+
+/* Find a usable record for nraddr in the shared file.  Newer records
+   are nearer the head of a chain, so a translation made again after
+   its code changed is found before the stale one.  Another process
+   may have written anything at all to the file, so check every offset
+   and record before using it, and don't follow a chain for ever. */
+static TCacheRec* tshare_lookup ( Addr64 nraddr,
+                                  Bool (*entry_ok)( void* opaque,
+                                                    VexGuestExtents* vge,
+                                                    UInt sc_bitmask ),
+                                  void* opaque )
+{
+   UInt off   = tshare->buckets[tshare_bucket(nraddr)];
+   UInt steps = 0;
+   Bool seen  = False;
+
+   while (off != 0 && steps++ < TSHARE_MAX_CHAIN) {
+      TShareRec* r;
+      if (off < sizeof(TShareHdr) || off % 8 != 0
+          || off > TSHARE_SZB - sizeof(TShareRec))
+         break;
+      r = (TShareRec*)((UChar*)tshare + off);
+      if (r->rec.nraddr == nraddr
+          && tcache_rec_sane(&r->rec, TSHARE_SZB - off - 8)) {
+         if (tcache_rec_matches(&r->rec, entry_ok, opaque)) {
+            n_tshare_hits++;
+            return &r->rec;
+         }
+         seen = True;
+      }
+      off = r->next;
+   }
+   if (seen)
+      n_tshare_rejected++;
+   return NULL;
+}
+
+/* Append 'tmp', with its guest bytes and host code, to the shared
+   file, and publish it for the other processes. */
+static void tshare_publish ( const TCacheRec* tmp, VexGuestExtents* vge,
+                             AddrH code )
+{
+   UInt           szB = 8 + TCacheRec__size(tmp);
+   UInt           off, old, i;
+   TShareRec*     r;
+   UChar*         guest;
+   volatile UInt* head;
+
+   if (tshare_full)
+      return;
+   off = __sync_fetch_and_add(&tshare->used, szB);
+   if (off < sizeof(TShareHdr) || off > TSHARE_SZB - szB) {
+      /* Full (or nonsense).  Don't try again, so that 'used' doesn't
+         keep on growing. */
+      tshare_full = True;
+      return;
+   }
+   r = (TShareRec*)((UChar*)tshare + off);
+   r->rec = *tmp;
+   guest = TCacheRec__guest(&r->rec);
+   for (i = 0; i < vge->n_used; i++) {
+      VG_(memcpy)(guest, (void*)(Addr)vge->base[i], vge->len[i]);
+      guest += vge->len[i];
+   }
+   VG_(memcpy)(TCacheRec__code(&r->rec), (void*)code, tmp->code_len);
+
+   /* The compare-and-swap is a full barrier, so the record is complete
+      before anybody can find it. */
+   head = &tshare->buckets[tshare_bucket(tmp->nraddr)];
+   do {
+      old = *head;
+      r->next = old;
+   } while (!__sync_bool_compare_and_swap(head, old, off));
+   n_tshare_published++;
+}
+
+Bool VG_(search_transtab_cache) ( Addr64 nraddr,
+                                  Bool (*entry_ok)( void* opaque,
+                                                    VexGuestExtents* vge,
+                                                    UInt sc_bitmask ),
+                                  void* opaque,
+                                  /*OUT*/VexGuestExtents* vge )
+{
+   TCacheNode* node;
+   TCacheRec*  rec = NULL;
+
+   if (!tcache_active)
+      return False;
+
+   node = tcache_ht ? VG_(HT_lookup)(tcache_ht, (UWord)nraddr) : NULL;
+   if (node) {
+      vg_assert(node->rec->nraddr == nraddr);
+      if (tcache_rec_matches(node->rec, entry_ok, opaque)) {
+         rec = node->rec;
+         n_tcache_hits++;
+      } else {
+         n_tcache_rejected++;
+         node = VG_(HT_remove)(tcache_ht, (UWord)nraddr);
+         vg_assert(node);
+         if (node->rec_is_malloced)
+            ttaux_free(node->rec);
+         ttaux_free(node);
+      }
+   }
+   if (rec == NULL && tshare)
+      rec = tshare_lookup(nraddr, entry_ok, opaque);
+   if (rec == NULL)
+      return False;
+
+   *vge = rec->vge;
+   VG_(add_to_transtab)( &rec->vge,
+                         nraddr,
+                         (AddrH)TCacheRec__code(rec),
+                         rec->code_len,
+                         rec->n_sc_extents > 0,
+                         rec->offs_profInc,
+                         rec->n_guest_instrs );
+   return True;
+}
+
+void VG_(add_to_transtab_cache) ( VexGuestExtents* vge,
+                                  Addr64           nraddr,
+                                  AddrH            code,
+                                  UInt             code_len,
+                                  UInt             n_sc_extents,
+                                  UInt             sc_bitmask,
+                                  Int              offs_profInc,
+                                  UInt             n_guest_instrs )
+{
+   TCacheRec  tmp;
+   TCacheRec* rec;
+   UChar*     guest;
+   UInt       i;
+
+   if (!tcache_active)
+      return;
+
+   VG_(memset)(&tmp, 0, sizeof(tmp));
+   tmp.nraddr         = nraddr;
+   tmp.vge            = *vge;
+   tmp.sc_bitmask     = sc_bitmask;
+   tmp.n_sc_extents   = n_sc_extents;
+   tmp.offs_profInc   = offs_profInc;
+   tmp.n_guest_instrs = n_guest_instrs;
+   tmp.guest_len      = vge_osize(vge);
+   tmp.code_len       = code_len;
+
+   if (tshare)
+      tshare_publish(&tmp, vge, code);
+
+   if (tcache_ht == NULL
+       || VG_(HT_count_nodes)(tcache_ht) >= TCACHE_MAX_ENTRIES
+       || tcache_recorded_szB >= TCACHE_MAX_SZB)
+      return;
+
+   rec = ttaux_malloc("transtab.tcache.rec", TCacheRec__size(&tmp));
+   *rec = tmp;
+   guest = TCacheRec__guest(rec);
+   for (i = 0; i < vge->n_used; i++) {
+      VG_(memcpy)(guest, (void*)(Addr)vge->base[i], vge->len[i]);
+      guest += vge->len[i];
+   }
+   VG_(memcpy)(TCacheRec__code(rec), (void*)code, code_len);
+
+   tcache_add_node(rec, True);
+   n_tcache_recorded++;
+   tcache_recorded_szB += TCacheRec__size(rec);
+}
+
+void VG_(save_transtab_cache) ( void )
+{
+   HChar*      tmpname;
+   SysRes      sres;
+   Int         fd;
+   Bool        ok;
+   TCacheHdr   hdr;
+   TCacheNode* node;
+
+   if (!tcache_active || VG_(clo_transtab_cache) == NULL)
+      return;
+
+   /* Write to a temporary and rename it into place, so concurrent
+      runs sharing a cache file never see a partially written one. */
+   tmpname = VG_(malloc)("transtab.tcache.tmpname",
+                         VG_(strlen)(VG_(clo_transtab_cache)) + 32);
+   VG_(sprintf)(tmpname, "%s.tmp.%d", VG_(clo_transtab_cache),
+                VG_(getpid)());
+   VG_(unlink)(tmpname);
+   sres = VG_(open)(tmpname, VKI_O_CREAT|VKI_O_EXCL|VKI_O_WRONLY,
+                    VKI_S_IRUSR|VKI_S_IWUSR);
+   if (sr_isError(sres)) {
+      VG_(umsg)("Warning: cannot create translation cache file %s\n",
+                tmpname);
+      VG_(free)(tmpname);
+      return;
+   }
+   fd = sr_Res(sres);
+
+   VG_(memcpy)(hdr.magic, TCACHE_MAGIC, sizeof(hdr.magic));
+   hdr.key    = tcache_key;
+   hdr.n_recs = VG_(HT_count_nodes)(tcache_ht);
+   ok = VG_(write)(fd, &hdr, sizeof(hdr)) == sizeof(hdr);
+
+   VG_(HT_ResetIter)(tcache_ht);
+   while (ok && (node = VG_(HT_Next)(tcache_ht))) {
+      Int szB = TCacheRec__size(node->rec);
+      ok = VG_(write)(fd, node->rec, szB) == szB;
+   }
+   VG_(close)(fd);
+
+   if (ok && VG_(rename)(tmpname, VG_(clo_transtab_cache)) == 0) {
+      VG_(debugLog)(1, "transtab", "saved %d translations to %s\n",
+                    (Int)hdr.n_recs, VG_(clo_transtab_cache));
+   } else {
+      VG_(umsg)("Warning: failed to write translation cache file %s\n",
+                VG_(clo_transtab_cache));
+      VG_(unlink)(tmpname);
+   }
+   VG_(free)(tmpname);
+}
+
+
+/*------------------------------------------------------------*/
+/*--- Write-protection of code pages (--smc-check=protect) ---*/
+/*------------------------------------------------------------*/
+
+/* A page which translations have been made from.  Pages are never
+   removed from the table, so that writes to them are remembered even
+   after they stop being protected. */
+typedef
+   struct _SmcPage {
+      struct _SmcPage* next;
+      Addr  page;        /* the hash key */
+      Bool  protected;   /* currently write-protected? */
+      UInt  n_faults;    /* writes to it whilst it was protected */
+   }
+   SmcPage;
+
+/* Once a page has been written to this many times whilst protected,
+   its code gets self-checks instead: it is evidently data as well as
+   code, and the faults would cost more than the checks. */
+#define SMC_MAX_WRITE_FAULTS 8
+
+static VgHashTable smc_pages       = NULL;
+static UInt        smc_n_pages     = 0;
+static UInt        smc_n_protected = 0;
+
+/* Stats */
+static ULong n_smc_protects = 0;
+static ULong n_smc_faults   = 0;
+static ULong n_smc_syswrites = 0;
+static ULong n_smc_given_up = 0;
+
+/* Set the real permissions of a page to aspacem's view of them,
+   minus write permission if !writable. */
+static void smc_set_prot ( Addr page, Bool writable )
+{
+   NSegment const* seg = VG_(am_find_nsegment)(page);
+   UInt prot = 0;
+
+   /* The page may since have been unmapped, or mapped over. */
+   if (seg == NULL
+       || (seg->kind != SkAnonC && seg->kind != SkFileC
+           && seg->kind != SkShmC))
+      return;
+   if (seg->hasR)             prot |= VKI_PROT_READ;
+   if (seg->hasW && writable) prot |= VKI_PROT_WRITE;
+   if (seg->hasX)             prot |= VKI_PROT_EXEC;
+   (void)VG_(do_syscall3)(__NR_mprotect, page, VKI_PAGE_SIZE, prot);
+}
+
+/* Apply fn to each page in the table which overlaps [a, a+len).  fn
+   may discard translations, and so call back here. */
+static void smc_apply_to_range ( Addr64 a, ULong len,
+                                 void (*fn)( SmcPage* ) )
+{
+   Addr lo, hi, pg;
+   UInt i, n;
+
+   if (smc_pages == NULL || len == 0)
+      return;
+   lo = VG_PGROUNDDN((Addr)a);
+   hi = len - 1 > (ULong)(~(Addr)0 - (Addr)a) ? ~(Addr)0
+                                               : (Addr)(a + len - 1);
+   hi = VG_PGROUNDDN(hi);
+
+   if ((hi - lo) / VKI_PAGE_SIZE < smc_n_pages) {
+      for (pg = lo; ; pg += VKI_PAGE_SIZE) {
+         SmcPage* p = VG_(HT_lookup)(smc_pages, pg);
+         if (p)
+            fn(p);
+         if (pg == hi)
+            break;
+      }
+   } else {
+      /* Quicker to look at all the pages; take a copy of the table,
+         since fn can change it. */
+      SmcPage** pages = (SmcPage**)VG_(HT_to_array)(smc_pages, &n);
+      for (i = 0; i < n; i++) {
+         if (pages[i]->page >= lo && pages[i]->page <= hi)
+            fn(pages[i]);
+      }
+      VG_(free)(pages);
+   }
+}
+
+static void smc_page_discarded ( SmcPage* p )
+{
+   if (p->protected) {
+      p->protected = False;
+      smc_n_protected--;
+      smc_set_prot(p->page, True/*writable*/);
+   }
+}
+
+static void smc_page_syswrite ( SmcPage* p )
+{
+   if (p->protected) {
+      n_smc_syswrites++;
+      if (++p->n_faults == SMC_MAX_WRITE_FAULTS)
+         n_smc_given_up++;
+      VG_(discard_translations)( (Addr64)p->page, VKI_PAGE_SIZE,
+                                 "smc_page_syswrite" );
+      vg_assert(!p->protected);
+   }
+}
+
+static void smc_page_reprotect ( SmcPage* p )
+{
+   if (p->protected)
+      smc_set_prot(p->page, False/*!writable*/);
+}
+
+/* Called by VG_(discard_translations): the pages in the range have
+   no translations left, so stop protecting them. */
+static void smc_discard_range ( Addr64 a, ULong len )
+{
+   if (smc_n_protected > 0)
+      smc_apply_to_range(a, len, smc_page_discarded);
+}
+
+Bool VG_(smc_can_protect) ( Addr a, SizeT len )
+{
+   NSegment const* seg = VG_(am_find_nsegment)(a);
+   Addr pg, last;
+
+   /* Only private anonymous memory.  Protection is per mapping, so a
+      page which is also mapped elsewhere (SysV shm, MAP_SHARED) could
+      be changed through another mapping without a fault. */
+   if (seg == NULL || seg->kind != SkAnonC || seg->isShared)
+      return False;
+   last = len == 0 ? a : a + len - 1;
+   if (last > seg->end)
+      return False;
+   if (smc_pages == NULL)
+      return True;
+   for (pg = VG_PGROUNDDN(a); pg <= last; pg += VKI_PAGE_SIZE) {
+      SmcPage* p = VG_(HT_lookup)(smc_pages, pg);
+      if (p && p->n_faults >= SMC_MAX_WRITE_FAULTS)
+         return False;
+   }
+   return True;
+}
+
+void VG_(smc_protect) ( Addr a, SizeT len )
+{
+   Addr pg, last;
+
+   vg_assert(VG_(clo_smc_check) == Vg_SmcProtect);
+   if (smc_pages == NULL)
+      smc_pages = VG_(HT_construct)("transtab.smc_pages");
+
+   last = len == 0 ? a : a + len - 1;
+   for (pg = VG_PGROUNDDN(a); pg <= last; pg += VKI_PAGE_SIZE) {
+      SmcPage* p = VG_(HT_lookup)(smc_pages, pg);
+      if (p == NULL) {
+         p = VG_(malloc)("transtab.smc_protect.1", sizeof(SmcPage));
+         p->page      = pg;
+         p->protected = False;
+         p->n_faults  = 0;
+         VG_(HT_add_node)(smc_pages, p);
+         smc_n_pages++;
+      }
+      if (!p->protected) {
+         p->protected = True;
+         smc_n_protected++;
+         n_smc_protects++;
+         smc_set_prot(pg, False/*!writable*/);
+      }
+   }
+}
+
+void VG_(smc_unprotect) ( Addr a, SizeT len )
+{
+   if (smc_n_protected > 0)
+      smc_apply_to_range(a, len, smc_page_syswrite);
+}
+
+void VG_(smc_reprotect) ( Addr a, SizeT len )
+{
+   if (smc_n_protected > 0)
+      smc_apply_to_range(a, len, smc_page_reprotect);
+}
+
+Bool VG_(smc_handle_write_fault) ( Addr a )
+{
+   NSegment const* seg;
+   SmcPage* p;
+
+   if (smc_n_protected == 0)
+      return False;
+   p = VG_(HT_lookup)(smc_pages, VG_PGROUNDDN(a));
+   if (p == NULL || !p->protected)
+      return False;
+   /* If the client may not write to the page anyway, the fault is its
+      own business. */
+   seg = VG_(am_find_nsegment)(a);
+   if (seg == NULL || !seg->hasW)
+      return False;
+
+   n_smc_faults++;
+   if (++p->n_faults == SMC_MAX_WRITE_FAULTS)
+      n_smc_given_up++;
+   VG_(discard_translations)( (Addr64)p->page, VKI_PAGE_SIZE,
+                              "VG_(smc_handle_write_fault)" );
+   vg_assert(!p->protected);
+   return True;
+}
+
+
 /*------------------------------------------------------------*/
 /*--- Initialisation.                                      ---*/
 /*------------------------------------------------------------*/
@@ -2202,11 +3647,15 @@ void VG_(init_tt_tc) ( void )
    /* Otherwise lots of things go wrong... */
    vg_assert(sizeof(ULong) == 8);
    vg_assert(sizeof(Addr64) == 8);
-   /* check fast cache entries really are 2 words long */
+   /* check fast cache sets really are 2 words per way long, as the
+      dispatchers assume */
    vg_assert(sizeof(Addr) == sizeof(void*));
-   vg_assert(sizeof(FastCacheEntry) == 2 * sizeof(Addr));
-   /* check fast cache entries are packed back-to-back with no spaces */
-   vg_assert(sizeof( VG_(tt_fast) ) == VG_TT_FAST_SIZE * sizeof(FastCacheEntry));
+   vg_assert(sizeof(FastCacheSet) == 2 * VG_TT_FAST_WAYS * sizeof(Addr));
+#  if defined(VGA_amd64) || defined(VGA_arm64)
+   vg_assert(sizeof(FastCacheSet) == 64);
+#  endif
+   /* check fast cache sets are packed back-to-back with no spaces */
+   vg_assert(sizeof( VG_(tt_fast) ) == VG_TT_FAST_SIZE * sizeof(FastCacheSet));
    /* check fast cache is aligned as we requested.  Not fatal if it
       isn't, but we might as well make sure. */
    vg_assert(VG_IS_16_ALIGNED( ((Addr) & VG_(tt_fast)[0]) ));
@@ -2226,6 +3675,11 @@ void VG_(init_tt_tc) ( void )
 
    n_sectors = VG_(clo_num_transtab_sectors);
    vg_assert(n_sectors >= MIN_N_SECTORS);
+   if (VG_(clo_hot_code_layout)) {
+      /* m_main makes sure there is room for it. */
+      hot_sector = n_sectors;
+      n_sectors++;
+   }
    vg_assert(n_sectors <= MAX_N_SECTORS);
 
    /* Initialise the sectors, even the ones we aren't going to use.
@@ -2242,9 +3696,16 @@ void VG_(init_tt_tc) ( void )
    /* Initialise the fast cache. */
    invalidateFastCache();
 
+   /* and the profile counters */
+   counter_pa = VG_(newPA)( sizeof(ULong), 1000, ttaux_malloc,
+                            "transtab.counters", ttaux_free );
+
    /* and the unredir tt/tc */
    init_unredir_tt_tc();
 
+   /* and the persistent cache, if requested */
+   init_tcache();
+
    if (VG_(clo_verbosity) > 2 || VG_(clo_stats)
        || VG_(debugLog_getLevel) () >= 2) {
       VG_(message)(Vg_DebugMsg,
@@ -2288,6 +3749,9 @@ void VG_(print_tt_tc_stats) ( void )
    VG_(message)(Vg_DebugMsg,
       "    tt/tc: %'llu fast-cache updates, %'llu flushes\n",
       n_fast_updates, n_fast_flushes );
+   VG_(message)(Vg_DebugMsg,
+      "    tt/tc: fast-cache %d sets x %d ways, %'llu entries evicted\n",
+      VG_TT_FAST_SIZE, VG_TT_FAST_WAYS, n_fast_evictions );
 
    VG_(message)(Vg_DebugMsg,
                 " transtab: new        %'lld "
@@ -2295,12 +3759,72 @@ void VG_(print_tt_tc_stats) ( void )
                 n_in_count, n_in_osize, n_in_tsize,
                 safe_idiv(10*n_in_tsize, n_in_osize),
                 n_in_sc_count);
+   VG_(message)(Vg_DebugMsg,
+                " transtab: host code  %'llu.%02llu bytes per guest byte, "
+                "%'llu bytes per translation\n",
+                safe_idiv(n_in_tsize, n_in_osize),
+                safe_idiv(100*n_in_tsize, n_in_osize) % 100,
+                safe_idiv(n_in_tsize, n_in_count));
    VG_(message)(Vg_DebugMsg,
                 " transtab: dumped     %'llu (%'llu -> ?" "?)\n",
                 n_dump_count, n_dump_osize );
    VG_(message)(Vg_DebugMsg,
                 " transtab: discarded  %'llu (%'llu -> ?" "?)\n",
                 n_disc_count, n_disc_osize );
+   VG_(message)(Vg_DebugMsg,
+                " transtab: kept       %'llu, retranslated %'llu\n",
+                n_kept_count, n_retrans_count );
+   if (hot_sector != -1) {
+      /* Include the runs since the last VG_(move_hot_translations),
+         or all of them if the counts are never reset. */
+      ULong execs_all = n_hot_execs_all;
+      ULong execs_hot = n_hot_execs_hot;
+      Int   sno, i;
+      for (sno = 0; sno < n_sectors; sno++) {
+         if (sectors[sno].tc == NULL)
+            continue;
+         for (i = 0; i < N_TTES_PER_SECTOR; i++) {
+            if (sectors[sno].tt[i].status != InUse
+                || sectors[sno].tt[i].countp == NULL)
+               continue;
+            execs_all += *sectors[sno].tt[i].countp;
+            if (sno == hot_sector)
+               execs_hot += *sectors[sno].tt[i].countp;
+         }
+      }
+      ULong hot_used = sectors[hot_sector].tc == NULL ? 0
+                       : 8 * (sectors[hot_sector].tc_next
+                              - sectors[hot_sector].tc);
+      VG_(message)(Vg_DebugMsg,
+                   " transtab: hot        %'llu moved (%'llu bytes), "
+                   "%'llu recycles, %'llu bytes in use\n",
+                   n_hot_moved, n_hot_tsize, n_hot_recycles, hot_used );
+      VG_(message)(Vg_DebugMsg,
+                   " transtab: hot        %'llu of %'llu block runs "
+                   "(%llu%%) in the hot sector\n",
+                   execs_hot, execs_all,
+                   safe_idiv(100 * execs_hot, execs_all) );
+   }
+   if (tcache_active)
+      VG_(message)(Vg_DebugMsg,
+                   " transtab: cache      %'llu loaded, %'llu hits, "
+                   "%'llu rejected, %'llu new\n",
+                   n_tcache_loaded, n_tcache_hits, n_tcache_rejected,
+                   n_tcache_recorded );
+   if (tshare)
+      VG_(message)(Vg_DebugMsg,
+                   " transtab: shared     %'llu hits, %'llu rejected, "
+                   "%'llu published, %'u of %'u bytes used%s\n",
+                   n_tshare_hits, n_tshare_rejected, n_tshare_published,
+                   tshare->used < TSHARE_SZB ? tshare->used : TSHARE_SZB,
+                   TSHARE_SZB, tshare_full ? " (full)" : "");
+   if (VG_(clo_smc_check) == Vg_SmcProtect)
+      VG_(message)(Vg_DebugMsg,
+                   " transtab: smc        %'llu page protects, "
+                   "%'llu write faults, %'llu syscall writes, "
+                   "%'llu pages given up\n",
+                   n_smc_protects, n_smc_faults, n_smc_syswrites,
+                   n_smc_given_up );
 
    if (DEBUG_TRANSTAB) {
       Int i;
@@ -2314,13 +3838,31 @@ void VG_(print_tt_tc_stats) ( void )
    }
 }
 
+void VG_(tt_tc_metrics) ( void (*put)(const HChar* name, ULong value) )
+{
+   ULong entries = 0;
+   Int   sno;
+   for (sno = 0; sno < n_sectors; sno++)
+      if (sectors[sno].tc != NULL)
+         entries += sectors[sno].tt_n_inuse;
+   put("transtab.translations", n_in_count);
+   put("transtab.translated_bytes", n_in_tsize);
+   put("transtab.dumped", n_dump_count);
+   put("transtab.discarded", n_disc_count);
+   put("transtab.entries", entries);
+   put("transtab.capacity", (ULong)n_sectors * N_TTES_PER_SECTOR_USABLE);
+   put("transtab.fast_cache_flushes", n_fast_flushes);
+   put("transtab.fast_cache_evictions", n_fast_evictions);
+}
+
 /*------------------------------------------------------------*/
 /*--- Printing out of profiling results.                   ---*/
 /*------------------------------------------------------------*/
 
 static ULong score ( TTEntry* tte )
 {
-   return ((ULong)tte->weight) * ((ULong)tte->count);
+   return tte->countp == NULL
+          ? 0 : ((ULong)tte->weight) * (*tte->countp);
 }
 
 ULong VG_(get_SB_profile) ( SBProfEntry tops[], UInt n_tops )
@@ -2380,9 +3922,10 @@ ULong VG_(get_SB_profile) ( SBProfEntry tops[], UInt n_tops )
       if (sectors[sno].tc == NULL)
          continue;
       for (i = 0; i < N_TTES_PER_SECTOR; i++) {
-         if (sectors[sno].tt[i].status != InUse)
+         if (sectors[sno].tt[i].status != InUse
+             || sectors[sno].tt[i].countp == NULL)
             continue;
-         sectors[sno].tt[i].count = 0;
+         *sectors[sno].tt[i].countp = 0;
       }
    }
 
@@ -77,15 +77,39 @@ typedef
    }
    MaybeWord;
 
+/* One node of the B-tree, for WordFMs made by VG_(newFM_BTree).
+   Every node but the root holds between BT_MINDEG-1 and BT_MAXKEYS
+   keys, in increasing order, with their values alongside; a node
+   which is not a leaf has nKeys+1 children.  Leaves are allocated
+   without the child array.  With 8-byte words, the keys of a node
+   span two cache lines, so a search needs far fewer cache misses
+   than in the AVL tree. */
+#define BT_MINDEG   8                   // minimum degree
+#define BT_MAXKEYS  (2 * BT_MINDEG - 1)
+
+typedef
+   struct _BtNode {
+      UShort nKeys;
+      Bool   leaf;
+      UWord  key[BT_MAXKEYS];
+      UWord  val[BT_MAXKEYS];
+      struct _BtNode* child[BT_MAXKEYS + 1]; /* not there in leaves */
+   }
+   BtNode;
+
+#define BT_LEAF_SZB  offsetof(BtNode, child)
+
 #define WFM_STKMAX    32    // At most 2**32 entries can be iterated over
 
 struct _WordFM {
    AvlNode* root;
+   BtNode*  btRoot;                // Used instead of root if btree
+   Bool     btree;
    void*    (*alloc_nofail)( const HChar*, SizeT );
    const HChar* cc;
    void     (*dealloc)(void*);
    Word     (*kCmp)(UWord,UWord);
-   AvlNode* nodeStack[WFM_STKMAX]; // Iterator node stack
+   void*    nodeStack[WFM_STKMAX]; // Iterator node stack
    Int      numStack[WFM_STKMAX];  // Iterator num stack
    Int      stackTop;              // Iterator stack pointer, one past end
 }; 
@@ -552,6 +576,522 @@ AvlNode* avl_dopy ( AvlNode* nd,
    return nyu;
 }
 
+/* --- B-tree implementation, for VG_(newFM_BTree) --- */
+
+static BtNode* bt_new_node ( WordFM* fm, Bool leaf )
+{
+   BtNode* nd = fm->alloc_nofail( fm->cc, leaf ? BT_LEAF_SZB
+                                               : sizeof(BtNode) );
+   tl_assert(nd);
+   nd->nKeys = 0;
+   nd->leaf  = leaf;
+   return nd;
+}
+
+static void bt_free_node ( WordFM* fm, BtNode* nd )
+{
+   VG_(memset)(nd, 0, nd->leaf ? BT_LEAF_SZB : sizeof(BtNode));
+   fm->dealloc(nd);
+}
+
+/* Find the index of the first key in nd which is >= k.  *found says
+   whether it is equal to k. */
+static Int bt_find_in_node ( BtNode* nd, UWord k,
+                             Word(*kCmp)(UWord,UWord),
+                             /*OUT*/Bool* found )
+{
+   Int lo = 0, hi = nd->nKeys;
+   *found = False;
+   while (lo < hi) {
+      Int  mid = (lo + hi) / 2;
+      Word cmpresS = kCmp ? /*boxed*/   kCmp( nd->key[mid], k )
+                          : /*unboxed*/ cmp_unsigned_Words( nd->key[mid], k );
+      if (cmpresS < 0) {
+         lo = mid + 1;
+      } else if (cmpresS > 0) {
+         hi = mid;
+      } else {
+         *found = True;
+         return mid;
+      }
+   }
+   return lo;
+}
+
+static BtNode* bt_find_node ( BtNode* nd, UWord k,
+                              Word(*kCmp)(UWord,UWord), /*OUT*/Int* ix )
+{
+   Bool found;
+   while (nd) {
+      Int i = bt_find_in_node( nd, k, kCmp, &found );
+      if (found) {
+         *ix = i;
+         return nd;
+      }
+      if (nd->leaf)
+         return NULL;
+      nd = nd->child[i];
+   }
+   return NULL;
+}
+
+/* Split the full child i of x, which is not full, moving its median
+   key up into x. */
+static void bt_split_child ( WordFM* fm, BtNode* x, Int i )
+{
+   Int     j;
+   BtNode* y = x->child[i];
+   BtNode* z = bt_new_node( fm, y->leaf );
+   tl_assert(y->nKeys == BT_MAXKEYS && x->nKeys < BT_MAXKEYS);
+
+   for (j = 0; j < BT_MINDEG - 1; j++) {
+      z->key[j] = y->key[BT_MINDEG + j];
+      z->val[j] = y->val[BT_MINDEG + j];
+   }
+   if (!y->leaf) {
+      for (j = 0; j < BT_MINDEG; j++)
+         z->child[j] = y->child[BT_MINDEG + j];
+   }
+   z->nKeys = BT_MINDEG - 1;
+   y->nKeys = BT_MINDEG - 1;
+
+   for (j = x->nKeys; j > i; j--)
+      x->child[j+1] = x->child[j];
+   x->child[i+1] = z;
+   for (j = x->nKeys - 1; j >= i; j--) {
+      x->key[j+1] = x->key[j];
+      x->val[j+1] = x->val[j];
+   }
+   x->key[i] = y->key[BT_MINDEG - 1];
+   x->val[i] = y->val[BT_MINDEG - 1];
+   x->nKeys++;
+}
+
+/* Add (k,v), splitting the full nodes met on the way down so that
+   there is always room for the key in the leaf.  As for the AVL tree,
+   returns True, having updated the value, if k was already there. */
+static Bool bt_insert ( WordFM* fm, UWord k, UWord v )
+{
+   Bool    found;
+   Int     i, j;
+   BtNode* nd = fm->btRoot;
+
+   if (!nd) {
+      nd = bt_new_node( fm, True );
+      nd->key[0] = k;
+      nd->val[0] = v;
+      nd->nKeys  = 1;
+      fm->btRoot = nd;
+      return False;
+   }
+   if (nd->nKeys == BT_MAXKEYS) {
+      BtNode* r = bt_new_node( fm, False );
+      r->child[0] = nd;
+      fm->btRoot  = r;
+      bt_split_child( fm, r, 0 );
+      nd = r;
+   }
+   while (True) {
+      i = bt_find_in_node( nd, k, fm->kCmp, &found );
+      if (found) {
+         nd->val[i] = v;
+         return True;
+      }
+      if (nd->leaf)
+         break;
+      if (nd->child[i]->nKeys == BT_MAXKEYS) {
+         Word cmpresS;
+         bt_split_child( fm, nd, i );
+         cmpresS = fm->kCmp ? fm->kCmp( nd->key[i], k )
+                            : cmp_unsigned_Words( nd->key[i], k );
+         if (cmpresS == 0) {
+            nd->val[i] = v;
+            return True;
+         }
+         if (cmpresS < 0)
+            i++;
+      }
+      nd = nd->child[i];
+   }
+   for (j = nd->nKeys; j > i; j--) {
+      nd->key[j] = nd->key[j-1];
+      nd->val[j] = nd->val[j-1];
+   }
+   nd->key[i] = k;
+   nd->val[i] = v;
+   nd->nKeys++;
+   return False;
+}
+
+/* Merge child i+1 of x, and key i, into child i. */
+static void bt_merge_children ( WordFM* fm, BtNode* x, Int i )
+{
+   Int     j;
+   BtNode* y = x->child[i];
+   BtNode* z = x->child[i+1];
+   tl_assert(y->nKeys + 1 + z->nKeys <= BT_MAXKEYS);
+
+   y->key[y->nKeys] = x->key[i];
+   y->val[y->nKeys] = x->val[i];
+   for (j = 0; j < z->nKeys; j++) {
+      y->key[y->nKeys + 1 + j] = z->key[j];
+      y->val[y->nKeys + 1 + j] = z->val[j];
+   }
+   if (!y->leaf) {
+      for (j = 0; j <= z->nKeys; j++)
+         y->child[y->nKeys + 1 + j] = z->child[j];
+   }
+   y->nKeys += 1 + z->nKeys;
+
+   for (j = i; j < x->nKeys - 1; j++) {
+      x->key[j] = x->key[j+1];
+      x->val[j] = x->val[j+1];
+      x->child[j+1] = x->child[j+2];
+   }
+   x->nKeys--;
+   bt_free_node( fm, z );
+}
+
+/* Make sure child i of x has more than the minimum number of keys,
+   by taking one from a sibling or else merging it with one.  Returns
+   the child to go down into. */
+static BtNode* bt_fill_child ( WordFM* fm, BtNode* x, Int i )
+{
+   Int     j;
+   BtNode* c = x->child[i];
+
+   if (c->nKeys >= BT_MINDEG)
+      return c;
+
+   if (i > 0 && x->child[i-1]->nKeys >= BT_MINDEG) {
+      /* Rotate the last key of the left sibling through x. */
+      BtNode* l = x->child[i-1];
+      for (j = c->nKeys; j > 0; j--) {
+         c->key[j] = c->key[j-1];
+         c->val[j] = c->val[j-1];
+      }
+      if (!c->leaf) {
+         for (j = c->nKeys + 1; j > 0; j--)
+            c->child[j] = c->child[j-1];
+         c->child[0] = l->child[l->nKeys];
+      }
+      c->key[0] = x->key[i-1];
+      c->val[0] = x->val[i-1];
+      c->nKeys++;
+      x->key[i-1] = l->key[l->nKeys - 1];
+      x->val[i-1] = l->val[l->nKeys - 1];
+      l->nKeys--;
+      return c;
+   }
+
+   if (i < x->nKeys && x->child[i+1]->nKeys >= BT_MINDEG) {
+      /* Rotate the first key of the right sibling through x. */
+      BtNode* r = x->child[i+1];
+      c->key[c->nKeys] = x->key[i];
+      c->val[c->nKeys] = x->val[i];
+      if (!c->leaf)
+         c->child[c->nKeys + 1] = r->child[0];
+      c->nKeys++;
+      x->key[i] = r->key[0];
+      x->val[i] = r->val[0];
+      for (j = 0; j < r->nKeys - 1; j++) {
+         r->key[j] = r->key[j+1];
+         r->val[j] = r->val[j+1];
+      }
+      if (!r->leaf) {
+         for (j = 0; j < r->nKeys; j++)
+            r->child[j] = r->child[j+1];
+      }
+      r->nKeys--;
+      return c;
+   }
+
+   if (i < x->nKeys) {
+      bt_merge_children( fm, x, i );
+      return x->child[i];
+   } else {
+      bt_merge_children( fm, x, i-1 );
+      return x->child[i-1];
+   }
+}
+
+/* Delete k from the subtree at x, which is the root or has more than
+   the minimum number of keys, so that a key can be taken from it
+   without having to come back up. */
+static Bool bt_delete ( WordFM* fm, BtNode* x, UWord k,
+                        /*OUT*/UWord* oldK, /*OUT*/UWord* oldV )
+{
+   Bool found;
+   Int  i, j;
+
+   while (True) {
+      i = bt_find_in_node( x, k, fm->kCmp, &found );
+
+      if (found && x->leaf) {
+         if (oldK) *oldK = x->key[i];
+         if (oldV) *oldV = x->val[i];
+         for (j = i; j < x->nKeys - 1; j++) {
+            x->key[j] = x->key[j+1];
+            x->val[j] = x->val[j+1];
+         }
+         x->nKeys--;
+         return True;
+      }
+
+      if (found) {
+         BtNode* y = x->child[i];
+         BtNode* z = x->child[i+1];
+         if (y->nKeys >= BT_MINDEG || z->nKeys >= BT_MINDEG) {
+            /* Replace k by its predecessor or successor, and delete
+               that from the leaf it comes from. */
+            BtNode* nd;
+            UWord   k2, v2;
+            if (oldK) *oldK = x->key[i];
+            if (oldV) *oldV = x->val[i];
+            if (y->nKeys >= BT_MINDEG) {
+               for (nd = y; !nd->leaf; nd = nd->child[nd->nKeys])
+                  ;
+               k2 = nd->key[nd->nKeys - 1];
+            } else {
+               for (nd = z; !nd->leaf; nd = nd->child[0])
+                  ;
+               k2 = nd->key[0];
+            }
+            found = bt_delete( fm, y->nKeys >= BT_MINDEG ? y : z,
+                               k2, NULL, &v2 );
+            tl_assert(found);
+            x->key[i] = k2;
+            x->val[i] = v2;
+            return True;
+         }
+         bt_merge_children( fm, x, i );
+         x = y;
+         continue;
+      }
+
+      if (x->leaf)
+         return False;
+      x = bt_fill_child( fm, x, i );
+   }
+}
+
+static Bool bt_remove ( WordFM* fm, UWord k,
+                        /*OUT*/UWord* oldK, /*OUT*/UWord* oldV )
+{
+   Bool    found;
+   BtNode* r = fm->btRoot;
+   if (!r)
+      return False;
+   found = bt_delete( fm, r, k, oldK, oldV );
+   if (r->nKeys == 0) {
+      fm->btRoot = r->leaf ? NULL : r->child[0];
+      bt_free_node( fm, r );
+   }
+   return found;
+}
+
+static UWord bt_size ( BtNode* nd )
+{
+   Int   i;
+   UWord n = nd->nKeys;
+   if (!nd->leaf) {
+      for (i = 0; i <= nd->nKeys; i++)
+         n += bt_size( nd->child[i] );
+   }
+   return n;
+}
+
+static
+Bool bt_find_bounds ( BtNode* nd,
+                      /*OUT*/UWord* kMinP, /*OUT*/UWord* vMinP,
+                      /*OUT*/UWord* kMaxP, /*OUT*/UWord* vMaxP,
+                      UWord minKey, UWord minVal,
+                      UWord maxKey, UWord maxVal,
+                      UWord key,
+                      Word(*kCmp)(UWord,UWord) )
+{
+   Bool  found;
+   UWord kLowerBound = minKey;
+   UWord vLowerBound = minVal;
+   UWord kUpperBound = maxKey;
+   UWord vUpperBound = maxVal;
+   while (nd) {
+      Int i = bt_find_in_node( nd, key, kCmp, &found );
+      if (found)
+         return False; /* as for the AVL tree */
+      if (i > 0) {
+         kLowerBound = nd->key[i-1];
+         vLowerBound = nd->val[i-1];
+      }
+      if (i < nd->nKeys) {
+         kUpperBound = nd->key[i];
+         vUpperBound = nd->val[i];
+      }
+      nd = nd->leaf ? NULL : nd->child[i];
+   }
+   if (kMinP) *kMinP = kLowerBound;
+   if (vMinP) *vMinP = vLowerBound;
+   if (kMaxP) *kMaxP = kUpperBound;
+   if (vMaxP) *vMaxP = vUpperBound;
+   return True;
+}
+
+/* For the B-tree, each iterator stack entry holds a node and the
+   index of the next key of it to produce; the entries below the top
+   are for the ancestors of the top node. */
+static inline void bt_stackPush ( WordFM* fm, BtNode* nd, Int i )
+{
+   tl_assert(fm->stackTop < WFM_STKMAX);
+   tl_assert(0 <= i && i <= nd->nKeys);
+   fm->nodeStack[fm->stackTop] = nd;
+   fm-> numStack[fm->stackTop] = i;
+   fm->stackTop++;
+}
+
+static void bt_stackPushLeftmost ( WordFM* fm, BtNode* nd )
+{
+   while (True) {
+      bt_stackPush(fm, nd, 0);
+      if (nd->leaf)
+         break;
+      nd = nd->child[0];
+   }
+}
+
+static Bool bt_next ( WordFM* fm, /*OUT*/UWord* pKey, /*OUT*/UWord* pVal )
+{
+   while (fm->stackTop > 0) {
+      BtNode* nd = fm->nodeStack[fm->stackTop - 1];
+      Int     i  = fm->numStack[fm->stackTop - 1];
+      if (i < nd->nKeys) {
+         if (pKey) *pKey = nd->key[i];
+         if (pVal) *pVal = nd->val[i];
+         fm->numStack[fm->stackTop - 1] = i + 1;
+         if (!nd->leaf)
+            bt_stackPushLeftmost(fm, nd->child[i+1]);
+         return True;
+      }
+      fm->stackTop--;
+      fm->nodeStack[fm->stackTop] = NULL;
+      fm-> numStack[fm->stackTop] = 0;
+   }
+   return False;
+}
+
+static void bt_initIterAt ( WordFM* fm, UWord start_at )
+{
+   Bool    found;
+   BtNode* nd = fm->btRoot;
+   while (nd) {
+      Int i = bt_find_in_node( nd, start_at, fm->kCmp, &found );
+      bt_stackPush(fm, nd, i);
+      if (found || nd->leaf)
+         return;
+      nd = nd->child[i];
+   }
+}
+
+static 
+BtNode* bt_dopy ( BtNode* nd, 
+                  UWord(*dopyK)(UWord), 
+                  UWord(*dopyV)(UWord),
+                  void*(alloc_nofail)(const HChar*,SizeT),
+                  const HChar* cc )
+{
+   Int     i;
+   SizeT   szB = nd->leaf ? BT_LEAF_SZB : sizeof(BtNode);
+   BtNode* nyu = alloc_nofail(cc, szB);
+   tl_assert(nyu);
+   VG_(memcpy)(nyu, nd, szB);
+
+   for (i = 0; i < nd->nKeys; i++) {
+      if (dopyK) {
+         nyu->key[i] = dopyK( nd->key[i] );
+         if (nd->key[i] != 0 && nyu->key[i] == 0)
+            return NULL; /* oom in key dcopy */
+      }
+      if (dopyV) {
+         nyu->val[i] = dopyV( nd->val[i] );
+         if (nd->val[i] != 0 && nyu->val[i] == 0)
+            return NULL; /* oom in val dcopy */
+      }
+   }
+   if (!nd->leaf) {
+      for (i = 0; i <= nd->nKeys; i++) {
+         nyu->child[i] = bt_dopy( nd->child[i], dopyK, dopyV,
+                                  alloc_nofail, cc );
+         if (! nyu->child[i])
+            return NULL;
+      }
+   }
+   return nyu;
+}
+
+static void bt_free ( WordFM* fm, BtNode* nd,
+                      void(*kFin)(UWord), void(*vFin)(UWord) )
+{
+   Int i;
+   if (!nd->leaf) {
+      for (i = 0; i <= nd->nKeys; i++)
+         bt_free( fm, nd->child[i], kFin, vFin );
+   }
+   for (i = 0; i < nd->nKeys; i++) {
+      if (kFin)
+         kFin( nd->key[i] );
+      if (vFin)
+         vFin( nd->val[i] );
+   }
+   bt_free_node( fm, nd );
+}
+
+/* Build a subtree of height h holding the n sorted keys (and vals, if
+   non-NULL), spreading them evenly over as few nodes as possible.
+   Each child of height h-1 takes between BT_MINDEG**(h-1) and
+   (2*BT_MINDEG)**(h-1) keys-plus-one, so that the result is a valid
+   B-tree provided the caller picked h so that n fits. */
+static BtNode* bt_build ( WordFM* fm, const UWord* keys, const UWord* vals,
+                          UWord n, Int h, Bool isRoot )
+{
+   Int     j;
+   UWord   slotsC, nC, pos, m;
+   BtNode* nd = bt_new_node( fm, h == 1 );
+
+   if (h == 1) {
+      tl_assert(n <= BT_MAXKEYS);
+      tl_assert(isRoot || n >= BT_MINDEG - 1);
+      for (j = 0; j < n; j++) {
+         nd->key[j] = keys[j];
+         nd->val[j] = vals ? vals[j] : 0;
+      }
+      nd->nKeys = n;
+      return nd;
+   }
+
+   slotsC = 1;   /* max keys-plus-one of a child */
+   for (j = 1; j < h; j++)
+      slotsC *= 2 * BT_MINDEG;
+   nC = (n + slotsC) / slotsC;   /* ie. ceil((n+1) / slotsC) */
+   if (nC < (isRoot ? 2 : BT_MINDEG))
+      nC = isRoot ? 2 : BT_MINDEG;
+   tl_assert(nC <= BT_MAXKEYS + 1);
+
+   pos = 0;
+   for (j = 0; j < nC; j++) {
+      m = (n + 1) / nC + (j < (n + 1) % nC ? 1 : 0) - 1;
+      nd->child[j] = bt_build( fm, keys + pos, vals ? vals + pos : NULL,
+                               m, h - 1, False );
+      pos += m;
+      if (j < nC - 1) {
+         nd->key[j] = keys[pos];
+         nd->val[j] = vals ? vals[pos] : 0;
+         pos++;
+      }
+   }
+   tl_assert(pos == n);
+   nd->nKeys = nC - 1;
+   return nd;
+}
+
 /* Initialise a WordFM. */
 static void initFM ( WordFM* fm,
                      void*   (*alloc_nofail)( const HChar*, SizeT ),
@@ -560,6 +1100,8 @@ static void initFM ( WordFM* fm,
                      Word    (*kCmp)(UWord,UWord) )
 {
    fm->root         = 0;
+   fm->btRoot       = NULL;
+   fm->btree        = False;
    fm->kCmp         = kCmp;
    fm->alloc_nofail = alloc_nofail;
    fm->cc           = cc;
@@ -587,6 +1129,18 @@ WordFM* VG_(newFM) ( void* (*alloc_nofail)( const HChar*, SizeT ),
    return fm;
 }
 
+/* Allocate and initialise a WordFM which uses a B-tree rather than an
+   AVL tree.  See comment in pub_tool_wordfm.h. */
+WordFM* VG_(newFM_BTree) ( void* (*alloc_nofail)( const HChar*, SizeT ),
+                           const HChar* cc,
+                           void  (*dealloc)(void*),
+                           Word  (*kCmp)(UWord,UWord) )
+{
+   WordFM* fm = VG_(newFM)( alloc_nofail, cc, dealloc, kCmp );
+   fm->btree = True;
+   return fm;
+}
+
 static void avl_free ( AvlNode* nd, 
                        void(*kFin)(UWord),
                        void(*vFin)(UWord),
@@ -611,6 +1165,8 @@ static void avl_free ( AvlNode* nd,
 void VG_(deleteFM) ( WordFM* fm, void(*kFin)(UWord), void(*vFin)(UWord) )
 {
    void(*dealloc)(void*) = fm->dealloc;
+   if (fm->btRoot)
+      bt_free( fm, fm->btRoot, kFin, vFin );
    avl_free( fm->root, kFin, vFin, dealloc );
    VG_(memset)(fm, 0, sizeof(WordFM) );
    dealloc(fm);
@@ -621,6 +1177,8 @@ Bool VG_(addToFM) ( WordFM* fm, UWord k, UWord v )
 {
    MaybeWord oldV;
    AvlNode* node;
+   if (fm->btree)
+      return bt_insert( fm, k, v );
    node = fm->alloc_nofail( fm->cc, sizeof(AvlNode) );
    node->key = k;
    node->val = v;
@@ -638,7 +1196,10 @@ Bool VG_(addToFM) ( WordFM* fm, UWord k, UWord v )
 Bool VG_(delFromFM) ( WordFM* fm,
                       /*OUT*/UWord* oldK, /*OUT*/UWord* oldV, UWord key )
 {
-   AvlNode* node = avl_find_node( fm->root, key, fm->kCmp );
+   AvlNode* node;
+   if (fm->btree)
+      return bt_remove( fm, key, oldK, oldV );
+   node = avl_find_node( fm->root, key, fm->kCmp );
    if (node) {
       avl_remove_wrk( &fm->root, node, fm->kCmp );
       if (oldK)
@@ -656,7 +1217,19 @@ Bool VG_(delFromFM) ( WordFM* fm,
 Bool VG_(lookupFM) ( WordFM* fm, 
                      /*OUT*/UWord* keyP, /*OUT*/UWord* valP, UWord key )
 {
-   AvlNode* node = avl_find_node( fm->root, key, fm->kCmp );
+   AvlNode* node;
+   if (fm->btree) {
+      Int     i;
+      BtNode* nd = bt_find_node( fm->btRoot, key, fm->kCmp, &i );
+      if (!nd)
+         return False;
+      if (keyP)
+         *keyP = nd->key[i];
+      if (valP)
+         *valP = nd->val[i];
+      return True;
+   }
+   node = avl_find_node( fm->root, key, fm->kCmp );
    if (node) {
       if (keyP)
          *keyP = node->key;
@@ -678,6 +1251,12 @@ Bool VG_(findBoundsFM)( WordFM* fm,
 {
    /* really we should assert that minKey <= key <= maxKey,
       where <= is as defined by fm->kCmp. */
+   if (fm->btree)
+      return bt_find_bounds( fm->btRoot, kMinP, vMinP,
+                                         kMaxP, vMaxP,
+                                         minKey, minVal,
+                                         maxKey, maxVal,
+                                         key, fm->kCmp );
    return avl_find_bounds( fm->root, kMinP, vMinP,
                                      kMaxP, vMaxP,
                                      minKey, minVal, 
@@ -689,6 +1268,8 @@ Bool VG_(findBoundsFM)( WordFM* fm,
 UWord VG_(sizeFM) ( WordFM* fm )
 {
    // Hmm, this is a bad way to do this
+   if (fm->btree)
+      return fm->btRoot ? bt_size( fm->btRoot ) : 0;
    return fm->root ? size_avl_nonNull( fm->root ) : 0;
 }
 
@@ -703,6 +1284,11 @@ void VG_(initIterFM) ( WordFM* fm )
 {
    tl_assert(fm);
    stackClear(fm);
+   if (fm->btree) {
+      if (fm->btRoot)
+         bt_stackPushLeftmost(fm, fm->btRoot);
+      return;
+   }
    if (fm->root)
       stackPush(fm, fm->root, 1);
 }
@@ -721,6 +1307,11 @@ void VG_(initIterAtFM) ( WordFM* fm, UWord start_at )
    tl_assert(fm);
    stackClear(fm);
 
+   if (fm->btree) {
+      bt_initIterAt(fm, start_at);
+      return;
+   }
+
    if (!fm->root) 
       return;
 
@@ -768,6 +1359,9 @@ Bool VG_(nextIterFM) ( WordFM* fm, /*OUT*/UWord* pKey, /*OUT*/UWord* pVal )
    
    tl_assert(fm);
 
+   if (fm->btree)
+      return bt_next(fm, pKey, pVal);
+
    // This in-order traversal requires each node to be pushed and popped
    // three times.  These could be avoided by updating nodes in-situ on the
    // top of the stack, but the push/pop cost is so small that it's worth
@@ -818,6 +1412,13 @@ WordFM* VG_(dopyFM) ( WordFM* fm, UWord(*dopyK)(UWord), UWord(*dopyV)(UWord) )
    VG_(memset)(fm->nodeStack, 0, sizeof(fm->nodeStack));
    VG_(memset)(fm->numStack, 0,  sizeof(fm->numStack));
 
+   if (nyu->btRoot) {
+      nyu->btRoot = bt_dopy( nyu->btRoot, dopyK, dopyV,
+                             fm->alloc_nofail, fm->cc );
+      if (! nyu->btRoot)
+         return NULL;
+   }
+
    if (nyu->root) {
       nyu->root = avl_dopy( nyu->root, dopyK, dopyV,
                             fm->alloc_nofail, fm->cc );
@@ -828,6 +1429,33 @@ WordFM* VG_(dopyFM) ( WordFM* fm, UWord(*dopyK)(UWord), UWord(*dopyV)(UWord) )
    return nyu;
 }
 
+// See comment in pub_tool_wordfm.h
+void VG_(addSortedToFM) ( WordFM* fm, UWord n,
+                          const UWord* keys, const UWord* vals )
+{
+   UWord i, slots;
+   Int   h;
+
+   tl_assert(fm->root == NULL && fm->btRoot == NULL);
+   for (i = 1; i < n; i++)
+      tl_assert((fm->kCmp ? fm->kCmp( keys[i-1], keys[i] )
+                          : cmp_unsigned_Words( keys[i-1], keys[i] )) < 0);
+
+   if (!fm->btree) {
+      for (i = 0; i < n; i++)
+         VG_(addToFM)( fm, keys[i], vals ? vals[i] : 0 );
+      return;
+   }
+
+   if (n == 0)
+      return;
+   /* The smallest height at which n keys fit. */
+   h = 1;
+   for (slots = 2 * BT_MINDEG; slots < n + 1; slots *= 2 * BT_MINDEG)
+      h++;
+   fm->btRoot = bt_build( fm, keys, vals, n, h, True/*isRoot*/ );
+}
+
 // admin: what's the 'common' allocation size (for tree nodes?)
 SizeT VG_(getNodeSizeFM)( void )
 {
@@ -235,11 +235,26 @@ extern SysRes VG_(am_mmap_anon_fixed_client)
    update the segment array accordingly.  */
 extern SysRes VG_(am_mmap_anon_float_client) ( SizeT length, Int prot );
 
+/* Same, with an inaccessible guard page before and after the mapping.
+   The result is the start of the accessible part. */
+extern SysRes VG_(am_mmap_anon_float_client_guarded) ( SizeT length,
+                                                        Int prot );
+
 /* Map anonymously at an unconstrained address for V, and update the
    segment array accordingly.  This is fundamentally how V allocates
    itself more address space when needed. */
 extern SysRes VG_(am_mmap_anon_float_valgrind)( SizeT cszB );
 
+/* How many bytes VG_(am_mmap_anon_float_valgrind) has handed out that
+   were eligible for huge pages under --huge-pages; how many of those
+   came from the hugetlb pool; how many were instead advised with
+   MADV_HUGEPAGE; and how much of V's anonymous memory the kernel is
+   currently backing with transparent huge pages. */
+extern void VG_(am_get_huge_page_stats) ( /*OUT*/ULong* requested,
+                                          /*OUT*/ULong* hugetlb,
+                                          /*OUT*/ULong* advised,
+                                          /*OUT*/ULong* thp_backed );
+
 /* Map privately a file at an unconstrained address for V, and update the
    segment array accordingly.  This is used by V for transiently
    mapping in object files to read their debug info.  */
@@ -260,6 +275,11 @@ extern SysRes VG_(am_shared_mmap_file_float_valgrind)
 extern SysRes VG_(am_munmap_client)( /*OUT*/Bool* need_discard,
                                      Addr start, SizeT length );
 
+/* Unmap a mapping made by VG_(am_mmap_anon_float_client_guarded),
+   guard pages included.  (start,length) is its accessible part. */
+extern SysRes VG_(am_munmap_client_guarded)( /*OUT*/Bool* need_discard,
+                                             Addr start, SizeT length );
+
 /* Let (start,len) denote an area within a single Valgrind-owned
   segment (anon or file).  Change the ownership of [start, start+len)
   to the client instead.  Fails if (start,len) does not denote a
@@ -0,0 +1,74 @@
+
+/*--------------------------------------------------------------------*/
+/*--- Checkpoints of a running program.      pub_core_checkpoint.h ---*/
+/*--------------------------------------------------------------------*/
+
+/*
+   This file is part of Valgrind, a dynamic binary instrumentation
+   framework.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of the
+   License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+   02111-1307, USA.
+
+   The GNU General Public License is contained in the file COPYING.
+*/
+
+#ifndef __PUB_CORE_CHECKPOINT_H
+#define __PUB_CORE_CHECKPOINT_H
+
+//--------------------------------------------------------------------
+// PURPOSE: This module implements checkpoints: a checkpoint saves the
+// whole state of the Valgrind process -- guest and shadow memory,
+// thread state, tool state, translations -- so that the run can later
+// be continued from this point again, without redoing what was done
+// before it.
+//
+// A checkpoint is made by forking.  The parent process stays stopped,
+// and is the checkpoint, while the child continues the run.  Each
+// checkpoint thus is an ancestor of the running process, and waits
+// on a pipe whose write end only its descendants have.  To restore a
+// checkpoint, the running process writes on its pipe and exits: the
+// checkpoints made after it see the end of their pipe and exit, and
+// the restored checkpoint continues the run once its child has
+// exited.  When the run ends normally, all the checkpoints exit in
+// the same way, with the exit status of the run, so the first
+// Valgrind process ends last, as without checkpoints.
+//--------------------------------------------------------------------
+
+// Makes a checkpoint.  Returns 0 in the process which continues the
+// run, or if the checkpoint could not be made, and the number of the
+// checkpoint if it is later restored.
+extern UWord VG_(checkpoint) ( ThreadId tid );
+
+// Asks for a checkpoint to be made by VG_(maybe_checkpoint).  Used by
+// the monitor command, which can't fork from within gdbserver.
+extern void VG_(request_checkpoint) ( void );
+
+// Makes the checkpoint asked by VG_(request_checkpoint), if any.
+// Called by the scheduler between timeslices.
+extern void VG_(maybe_checkpoint) ( ThreadId tid );
+
+// Restores checkpoint n.  Only returns, with False, if there is no
+// such checkpoint.
+extern Bool VG_(restore_checkpoint) ( Int n );
+
+// Shows the checkpoints which can be restored, with VG_(gdb_printf).
+extern void VG_(show_checkpoints) ( void );
+
+#endif   // __PUB_CORE_CHECKPOINT_H
+
+/*--------------------------------------------------------------------*/
+/*--- end                                                          ---*/
+/*--------------------------------------------------------------------*/
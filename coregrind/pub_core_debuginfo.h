@@ -138,6 +138,20 @@ extern Bool VG_(use_CF_info) ( /*MOD*/D3UnwindRegs* uregs,
                                Addr min_accessible,
                                Addr max_accessible );
 
+#if defined(VGA_amd64) || defined(VGA_x86)
+/* As VG_(use_CF_info), but on success also say where in memory the
+   new xip and xbp were read from: the unwind step can be repeated
+   without the CFI while the same regs are unwound and those words
+   hold the same values.  *ra_slot is 0 if that can't be said (the
+   rule involves CFI expressions), *bp_slot is 0 if xbp is
+   unchanged. */
+extern Bool VG_(use_CF_info_with_slots) ( /*MOD*/D3UnwindRegs* uregs,
+                                          Addr min_accessible,
+                                          Addr max_accessible,
+                                          /*OUT*/Addr* ra_slot,
+                                          /*OUT*/Addr* bp_slot );
+#endif
+
 /* returns the "generation" of the CF info.
    Each time some debuginfo is changed (e.g. loaded or unloaded),
    the VG_(CF_info_generation) value returned will be increased.
@@ -193,6 +207,14 @@ typedef
    set either to NULL or to a NULL terminated vector containing
    pointers to the secondary names. */
 Int  VG_(DebugInfo_syms_howmany) ( const DebugInfo *di );
+
+/* The handle VG_(di_notify_mmap) returned for di. */
+ULong VG_(DebugInfo_get_handle) ( const DebugInfo *di );
+
+/* Changes whenever a DebugInfo is added or discarded, or its tables
+   change. */
+UInt VG_(debugInfo_generation) ( void );
+
 void VG_(DebugInfo_syms_getidx)  ( const DebugInfo *di, 
                                    Int idx,
                                    /*OUT*/SymAVMAs* ad,
@@ -43,7 +43,24 @@
  * (2) undoes C++ demangling, if 'do_cxx_demangle' is True.  */
 extern 
 void VG_(demangle) ( Bool do_cxx_demangling, Bool do_z_demangling,
-                     HChar* orig, HChar* result, Int result_size );
+                     const HChar* orig, HChar* result, Int result_size );
+
+/* As VG_(demangle), but remembers the result, so that a name is only
+   demangled on its first use.  The cache is keyed by the address of
+   'orig', so 'orig' must stay at that address with the same contents
+   until the next VG_(demangle_cache_flush) -- as is the case for the
+   interned symbol names of a DebugInfo. */
+extern
+void VG_(demangle_interned) ( Bool do_cxx_demangling, Bool do_z_demangling,
+                              const HChar* orig,
+                              HChar* result, Int result_size );
+
+/* Forget all the names remembered by VG_(demangle_interned).  Must be
+   called before the strings they were demangled from are freed. */
+extern void VG_(demangle_cache_flush) ( void );
+
+/* Show how well VG_(demangle_interned) did. */
+extern void VG_(print_demangle_stats) ( void );
 
 /* Demangle a Z-encoded name as described in pub_tool_redir.h. 
    Z-encoded names are used by Valgrind for doing function 
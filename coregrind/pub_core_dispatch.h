@@ -60,10 +60,17 @@
    two_words holds the return values (two words).  First is
    a TRC value.  Second is generally unused, except in the case
    where we have to return a chain-me request.
+
+   fast_cache is the fast cache the dispatcher is to look up indirect
+   jumps in; see VG_(get_fast_cache).  Only the amd64-linux dispatcher
+   takes any notice of it, the others always use VG_(tt_fast), which
+   is what it is unless --parallel-threads=yes.
 */
+struct _FastCacheSet;
 void VG_(disp_run_translations)( HWord* two_words,
                                  void*  guest_state, 
-                                 Addr   host_addr );
+                                 Addr   host_addr,
+                                 struct _FastCacheSet* fast_cache );
 
 /* We need to know addresses of the continuation-point (cp_) labels so
    we can tell VEX what they are.  They will get baked into the code
@@ -72,6 +79,10 @@ void VG_(disp_run_translations)( HWord* two_words,
 void VG_(disp_cp_chain_me_to_slowEP)(void);
 void VG_(disp_cp_chain_me_to_fastEP)(void);
 void VG_(disp_cp_xindir)(void);
+#if defined(VGP_amd64_linux)
+/* Stands in for both chain-me points with --parallel-threads=yes. */
+void VG_(disp_cp_xdirect_unchained)(void);
+#endif
 void VG_(disp_cp_xassisted)(void);
 void VG_(disp_cp_evcheck_fail)(void);
 
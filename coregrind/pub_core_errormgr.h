@@ -71,6 +71,10 @@ extern UInt VG_(get_n_errs_shown)         ( void );
 
 extern void VG_(print_errormgr_stats)     ( void );
 
+/* Give the error manager metrics to put (see pub_core_metrics.h). */
+extern void VG_(errormgr_metrics) ( void (*put)(const HChar* name,
+                                                ULong value) );
+
 #endif   // __PUB_CORE_ERRORMGR_H
 
 /*--------------------------------------------------------------------*/
@@ -47,12 +47,8 @@
 // If with_stacktraces, outputs all the recorded stacktraces.
 extern void VG_(print_ExeContext_stats) ( Bool with_stacktraces );
 
-// Extract the StackTrace from an ExeContext.
-// (Minor hack: we use Addr* as the return type instead of StackTrace so
-// that modules #including this file don't also have to #include
-// pub_core_stacktrace.h also.)
-extern
-/*StackTrace*/Addr* VG_(get_ExeContext_StackTrace) ( ExeContext* e );
+// Returns the number of ExeContexts stored.
+extern ULong VG_(get_n_ExeContexts) ( void );
 
 
 #endif   // __PUB_CORE_EXECONTEXT_H
@@ -0,0 +1,61 @@
+
+/*--------------------------------------------------------------------*/
+/*--- The fork server.                       pub_core_forkserver.h ---*/
+/*--------------------------------------------------------------------*/
+
+/*
+   This file is part of Valgrind, a dynamic binary instrumentation
+   framework.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of the
+   License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+   02111-1307, USA.
+
+   The GNU General Public License is contained in the file COPYING.
+*/
+
+#ifndef __PUB_CORE_FORKSERVER_H
+#define __PUB_CORE_FORKSERVER_H
+
+//--------------------------------------------------------------------
+// PURPOSE: This module implements the fork server: when the client
+// does the VALGRIND_FORK_SERVER client request, Valgrind stops there
+// and, for each request read from the --fork-server-fd file
+// descriptor, forks a child which continues the client from that
+// point.  The children thus start with the client initialised, and
+// with the translations and debug info of the parent.
+//
+// The protocol is the one of the AFL fork server.  Requests are read
+// on fd <n>, and replies are written on fd <n>+1; all messages are 4
+// bytes integers in host byte order.  When the server is started, it
+// writes a message (value 0).  Then, for each message it reads (its
+// value is ignored), it forks a child, replies with the child pid,
+// waits for the end of the child, and replies with its wait status.
+// When the requests fd is closed, the server process exits.
+//--------------------------------------------------------------------
+
+// Take over the --fork-server-fd file descriptors, if the option was
+// given.  Must be called after setup_file_descriptors.
+extern void VG_(fork_server_init) ( void );
+
+// Does the VALGRIND_FORK_SERVER client request for tid.  Only returns
+// in the children, with 1, or immediately with 0 if there is no fork
+// server.
+extern UWord VG_(fork_server) ( ThreadId tid );
+
+#endif   // __PUB_CORE_FORKSERVER_H
+
+/*--------------------------------------------------------------------*/
+/*--- end                                                          ---*/
+/*--------------------------------------------------------------------*/
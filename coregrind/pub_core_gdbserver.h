@@ -146,6 +146,11 @@ extern IRSB* VG_(instrument_for_gdbserver_if_needed)
       VexGuestExtents* vge,
       IRType gWordTy, IRType hWordTy);
 
+/* Does a translation of vge need gdbserver instrumentation, given
+   the current breakpoints, single stepping and --vgdb setting ?
+   Vg_VgdbNo means it does not. */
+extern VgVgdb VG_(gdbserver_instrumentation_needed) (VexGuestExtents* vge);
+
 /* reason for which gdbserver connection must be finished */
 typedef
    enum {
@@ -186,6 +191,9 @@ typedef
       int offset_status;
       int offset_lwpid;
 
+      // nr of slots in VG_(threads), i.e. VG_N_THREADS
+      int nr_threads;
+
       // PID of the vgdb that last connected to the Valgrind gdbserver.
       // It will be set by vgdb after connecting.
       int vgdb_pid;
@@ -204,6 +212,8 @@ typedef
       int offset_status;
       int offset_lwpid;
 
+      int nr_threads;
+
       int vgdb_pid;
    } VgdbShared64;
 
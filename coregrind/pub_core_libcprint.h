@@ -48,6 +48,17 @@ typedef
 extern OutputSink VG_(log_output_sink);
 extern OutputSink VG_(xml_output_sink);
 
+/* Start accumulating the output sent to sink (one of the above, going
+   to a file or a socket) in a buffer of VG_(clo_output_buffer_size)
+   bytes, written out when full.  With VG_(clo_output_socket_drop),
+   output to a socket is written without waiting for the listener, and
+   dropped when the buffer is full. */
+extern void VG_(buffer_output_sink) ( OutputSink* sink );
+
+/* Write out (waiting for socket listeners if needed) all the buffered
+   output.  Must be done before forking and exiting. */
+extern void VG_(flush_output_sinks) ( void );
+
 /* Get the elapsed wallclock time since startup into buf, which must
    16 chars long.  This is unchecked.  It also relies on the
    millisecond timer having been set to zero by an initial read in
@@ -84,12 +84,23 @@ extern void VG_(do_atfork_pre)    ( ThreadId tid );
 extern void VG_(do_atfork_parent) ( ThreadId tid );
 extern void VG_(do_atfork_child)  ( ThreadId tid );
 
+// Finer than VG_(read_millisecond_timer), but the starting point is
+// arbitrary, so only differences are meaningful.
+extern ULong VG_(read_nanosecond_timer) ( void );
+
 // icache invalidation
 extern void VG_(invalidate_icache) ( void *ptr, SizeT nbytes );
 
 // dcache flushing
 extern void VG_(flush_dcache) ( void *ptr, SizeT nbytes );
 
+// The worker lock, which serialises the state shared by the threads of
+// VG_(run_workers), for the allocator and printing.  It can be taken
+// again by the thread holding it, and does nothing when no workers are
+// running.
+extern void VG_(acquire_worker_lock) ( void );
+extern void VG_(release_worker_lock) ( void );
+
 #endif   // __PUB_CORE_LIBCPROC_H
 
 /*--------------------------------------------------------------------*/
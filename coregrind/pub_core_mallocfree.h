@@ -136,6 +136,10 @@ extern void  VG_(sanity_check_malloc_all) ( void );
 
 extern void  VG_(print_all_arena_stats) ( void );
 
+/* Give the metrics of each arena to put (see pub_core_metrics.h). */
+extern void  VG_(arena_metrics) ( void (*put)(const HChar* name,
+                                              ULong value) );
+
 extern void  VG_(print_arena_cc_analysis) ( void );
 
 typedef 
@@ -0,0 +1,62 @@
+
+/*--------------------------------------------------------------------*/
+/*--- Counters describing a running Valgrind.    pub_core_metrics.h ---*/
+/*--------------------------------------------------------------------*/
+
+/*
+   This file is part of Valgrind, a dynamic binary instrumentation
+   framework.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of the
+   License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+   02111-1307, USA.
+
+   The GNU General Public License is contained in the file COPYING.
+*/
+
+#ifndef __PUB_CORE_METRICS_H
+#define __PUB_CORE_METRICS_H
+
+//--------------------------------------------------------------------
+// PURPOSE: This module gathers the metrics of the core modules and of
+// the tool -- counters such as the number of translations made or the
+// bytes of memory allocated -- and makes them available while the
+// program runs: on demand with the "v.info metrics" monitor command,
+// and every --metrics-interval seconds in the --metrics-file file.
+//
+// The metrics are given as lines of the form "<name> <value>", where
+// <name> is made of lower case letters, digits, '_' and '.', and
+// <value> is a decimal unsigned integer.  The first line is
+// "metrics <version>".  Names are not reused with another meaning:
+// a metric whose meaning changes gets a new name, and the version is
+// increased if the format itself ever changes.
+//--------------------------------------------------------------------
+
+// Print the metrics with VG_(printf).
+extern void VG_(print_metrics) ( void );
+
+// Write the metrics to the --metrics-file file if --metrics-interval
+// seconds have passed since they were last written, or in any case if
+// final.  Cheap enough to be called at each scheduler timeslice.
+extern void VG_(maybe_write_metrics) ( Bool final );
+
+// Note that start up is over and the client is about to run, for the
+// "startup_ms" metric.
+extern void VG_(metrics_startup_done) ( void );
+
+#endif   // __PUB_CORE_METRICS_H
+
+/*--------------------------------------------------------------------*/
+/*--- end                                                          ---*/
+/*--------------------------------------------------------------------*/
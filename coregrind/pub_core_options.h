@@ -122,11 +122,59 @@ extern const HChar* VG_(clo_trace_children_skip_by_arg);
    after the subsequent exec(). */
 extern Bool  VG_(clo_child_silent_after_fork);
 
+/* If not -1, the fork server started by the VALGRIND_FORK_SERVER client
+   request reads its requests on this fd, and writes its replies on the
+   next one. */
+extern Int   VG_(clo_fork_server_fd);
+
+/* With --fast-forward=yes, the program runs without the tool's
+   instrumentation until the instrumentation is started: by the
+   VALGRIND_STOP_FAST_FORWARD client request, the "v.do
+   stop_fast_forward" monitor command, once VG_(clo_fast_forward_bbs)
+   blocks have run if that is not 0, or on entry to a function matching
+   VG_(clo_fast_forward_fn) if that is not NULL.  VG_(clo_fast_forward)
+   is cleared when the instrumentation starts. */
+extern Bool  VG_(clo_fast_forward);
+extern Long  VG_(clo_fast_forward_bbs);
+extern const HChar* VG_(clo_fast_forward_fn);
+
+/* Comma-separated lists of obj:<pattern> and fun:<pattern>.  The code
+   of matching objects and functions is given only the tool's cheap
+   instrumentation with --skip-instrument, and all but it with
+   --instrument-only. */
+extern const HChar* VG_(clo_skip_instrument);
+extern const HChar* VG_(clo_instrument_only);
+
 /* If the user specified --log-file=STR and/or --xml-file=STR, these
    hold STR after expansion of the %p and %q templates. */
 extern HChar* VG_(clo_log_fname_expanded);
 extern HChar* VG_(clo_xml_fname_expanded);
 
+/* Size of the buffer in which the output to a --log-file, --log-socket,
+   --xml-file or --xml-socket destination is accumulated before being
+   written out.  0 means each message is written out at once.
+   default: 64KB */
+extern Int   VG_(clo_output_buffer_size);
+
+/* Drop the output to a --log-socket or --xml-socket destination when
+   the listener doesn't take it quickly enough, rather than waiting
+   for it?  default: NO */
+extern Bool  VG_(clo_output_socket_drop);
+
+/* The file in which to write the metrics (see pub_core_metrics.h), or
+   NULL if not to write them.  May contain %p and %q templates.
+   default: NULL */
+extern const HChar* VG_(clo_metrics_fname);
+
+/* Number of seconds between two writes of the --metrics-file.
+   default: 10 */
+extern Int   VG_(clo_metrics_interval);
+
+/* In the XML output, print each stack trace and each frame in full
+   only the first time, giving it an id, and thereafter just refer to
+   it by that id?  default: NO */
+extern Bool  VG_(clo_xml_stack_refs);
+
 /* Add timestamps to log messages?  default: NO */
 extern Bool  VG_(clo_time_stamp);
 
@@ -174,6 +222,19 @@ extern UChar VG_(clo_profyle_flags);
    this-many back edges (event checks).  default: zero (== show
    profiling results only at the end of the run. */
 extern ULong VG_(clo_profyle_interval);
+/* DEBUG: if nonzero, look at which SB each thread is about to run
+   once every this-many event checks on average, and show the most
+   often seen ones at the end of the run.  Unlike the SB profiling
+   above, this needs no change to the translations.  default: zero
+   (== NO) */
+extern UInt  VG_(clo_profile_sample);
+/* DEBUG: count host events (cycles, cache misses, ...) with the
+   performance counters, separately for each phase of Valgrind?  See
+   pub_core_perfevents.h.  default: NO */
+extern Bool  VG_(clo_perf_counters);
+/* DEBUG: write a /tmp/perf-<pid>.map file naming the translations,
+   for "perf report"?  default: NO */
+extern Bool  VG_(clo_perf_map);
 
 /* DEBUG: if tracing codegen, be quiet until after this bb */
 extern Int   VG_(clo_trace_notbelow);
@@ -200,10 +261,22 @@ extern Bool  VG_(clo_trace_redir);
 /* Enable fair scheduling on multicore systems? default: NO */
 enum FairSchedType { disable_fair_sched, enable_fair_sched, try_fair_sched };
 extern enum FairSchedType VG_(clo_fair_sched);
+/* Let threads run translations at the same time, taking the_BigLock
+   only to get in and out of generated code?  Only for tools which
+   have called VG_(needs_thread_safe_instrumentation).  default: NO */
+extern Bool  VG_(clo_parallel_threads);
+/* Shorten the timeslices of threads which keep others waiting for
+   the_BigLock, and don't give it up at the end of a timeslice when
+   nobody is waiting?  default: NO */
+extern Bool  VG_(clo_adaptive_quantum);
+/* Pin all threads to the core the program starts on?  default: NO */
+extern Bool  VG_(clo_sched_affinity);
 /* DEBUG: print thread scheduling events?  default: NO */
 extern Bool  VG_(clo_trace_sched);
 /* DEBUG: do heap profiling?  default: NO */
 extern Bool  VG_(clo_profile_heap);
+/* DEBUG: time the phases of translation?  default: NO */
+extern Bool  VG_(clo_profile_jit);
 #define MAX_REDZONE_SZB 128
 // Maximum for the default values for core arenas and for client
 // arena given by the tool.
@@ -216,6 +289,11 @@ extern Int VG_(clo_core_redzone_size);
 // VG_(clo_redzone_size) has default value -1, indicating to keep
 // the tool provided value.
 extern Int VG_(clo_redzone_size);
+// Allocate small client blocks in slabs?  See m_mallocfree.c.
+extern Bool VG_(clo_malloc_slabs);
+// Client blocks of at least this many bytes get their own mapping, with
+// an inaccessible page on each side.  0 means none do.
+extern SizeT VG_(clo_guard_pages_above);
 /* DEBUG: display gory details for the k'th most popular error.
    default: Infinity. */
 extern Int   VG_(clo_dump_error);
@@ -243,6 +321,22 @@ extern Bool VG_(clo_sym_offsets);
 extern Bool VG_(clo_read_inline_info);
 /* Read DWARF3 variable info even if tool doesn't ask for it? */
 extern Bool VG_(clo_read_var_info);
+/* Read only the symbols of each object eagerly, and the rest of its
+   debug info (line numbers, CFI, inline and variable info) when it is
+   first needed?  Default: NO */
+extern Bool VG_(clo_lazy_debuginfo);
+/* How many threads to read the line, unwind and variable info of the
+   loaded objects on, all at once when it is first needed.  With 1,
+   each object's is read when it is loaded (or, with
+   --lazy-debuginfo=yes, when it is needed).  Default: 1 */
+extern Int  VG_(clo_debuginfo_threads);
+/* Directory in which to keep the read symbol, line number and CFI
+   tables of objects with a build-id, for later runs to use.  Default:
+   NULL (no cache) */
+extern const HChar* VG_(clo_debuginfo_cache);
+/* How many 8KB blocks of each object file being read to keep in
+   memory.  Default: 128 */
+extern Int  VG_(clo_debuginfo_image_cache);
 /* Which prefix to strip from full source file paths, if any. */
 extern const HChar* VG_(clo_prefix_to_strip);
 
@@ -311,6 +405,43 @@ extern Int VG_(clo_merge_recursive_frames);
 /* Max number of sectors that will be used by the translation code cache. */
 extern UInt VG_(clo_num_transtab_sectors);
 
+/* File to load translations from at startup and save them to at
+   exit, for tools that allow it.  Default: NULL (don't). */
+extern const HChar* VG_(clo_transtab_cache);
+
+/* Keep the translations of this run, as for --transtab-cache but
+   without a file, so that code which is discarded and then turns up
+   again unchanged at the same address needn't be translated again? */
+extern Bool VG_(clo_transtab_reuse);
+
+/* Share translations with other processes running the same tool with
+   the same options, through a file mapped by all of them? */
+extern Bool VG_(clo_transtab_share);
+
+/* When a sector of the translation cache is recycled, move the
+   translations in it that are still in use to the new sector instead
+   of throwing them away? */
+extern Bool VG_(clo_transtab_keep_hot);
+
+/* Count how often each translation runs, and every so often move the
+   most frequently run ones into a sector of their own? */
+extern Bool VG_(clo_hot_code_layout);
+
+/* Should V's big anonymous mappings (translation cache sectors, tool
+   shadow memory) be backed by huge pages?  With Vg_HugePagesYes they
+   are taken from the hugetlb pool where possible, falling back to
+   madvise(MADV_HUGEPAGE) when it is empty; with
+   Vg_HugePagesTransparent only the madvise is done.  Default: no. */
+typedef
+   enum {
+      Vg_HugePagesNo,
+      Vg_HugePagesTransparent,
+      Vg_HugePagesYes
+   }
+   VgHugePages;
+
+extern VgHugePages VG_(clo_huge_pages);
+
 /* Only client requested fixed mapping can be done below 
    VG_(clo_aspacem_minAddr). */
 extern Addr VG_(clo_aspacem_minAddr);
@@ -327,8 +458,10 @@ typedef
       Vg_SmcStack, // generate s-c-t's for code found in stacks
                    // (this is the default)
       Vg_SmcAll,   // make all translations self-checking.
-      Vg_SmcAllNonFile // make all translations derived from
+      Vg_SmcAllNonFile, // make all translations derived from
                    // non-file-backed memory self checking
+      Vg_SmcProtect // as Vg_SmcAllNonFile, but write-protect the
+                   // code's pages instead where possible
    } 
    VgSmc;
 
@@ -370,6 +503,30 @@ extern Bool VG_(should_we_trace_this_child) ( HChar* child_exe_name,
    depends on verbosity (False if -q). */
 extern Bool VG_(clo_sigill_diag);
 
+/* Translate the constant successors of each new superblock at the
+   same time as the superblock itself? */
+extern Bool VG_(clo_pretranslate_successors);
+
+/* --pretranslate=<obj>:<fn>,...: functions to translate as soon as
+   their object's debug info has been read, or NULL. */
+extern const HChar* VG_(clo_pretranslate);
+
+/* If nonzero, translate blocks cheaply at first, and in full once
+   they have run this many times. */
+extern UInt VG_(clo_tier_up_threshold);
+
+/* When re-translating a block that has become hot, chase its
+   conditional branches in the directions they have usually gone? */
+extern Bool VG_(clo_hot_traces);
+
+/* When re-translating a block that has become hot, unroll loops in it
+   as far as possible? */
+extern Bool VG_(clo_hot_loops);
+
+/* When re-translating a block that has become hot, add a chainable
+   exit for the place its indirect jump last went to? */
+extern Bool VG_(clo_inline_caches);
+
 /* Unwind using stack scanning (a nasty hack at the best of times)
    when the normal CFI/FP-chain scan fails.  If the number of
    "normally" recovered frames is below this number, stack scanning
@@ -383,6 +540,12 @@ extern UInt VG_(clo_unw_stack_scan_thresh);
    low by default.  Default: 5 */
 extern UInt VG_(clo_unw_stack_scan_frames);
 
+/* amd64 only: when unwinding the stack, follow the %rbp chain for
+   all but the innermost frame, rather than looking for CFI first.
+   Only right for programs which keep a frame pointer throughout.
+   Default: False */
+extern Bool VG_(clo_unw_frame_pointer);
+
 #endif   // __PUB_CORE_OPTIONS_H
 
 /*--------------------------------------------------------------------*/
@@ -0,0 +1,73 @@
+
+/*--------------------------------------------------------------------*/
+/*--- Host performance counters.             pub_core_perfevents.h ---*/
+/*--------------------------------------------------------------------*/
+
+/*
+   This file is part of Valgrind, a dynamic binary instrumentation
+   framework.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of the
+   License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+   02111-1307, USA.
+
+   The GNU General Public License is contained in the file COPYING.
+*/
+
+#ifndef __PUB_CORE_PERFEVENTS_H
+#define __PUB_CORE_PERFEVENTS_H
+
+//--------------------------------------------------------------------
+// PURPOSE: This module helps finding out why Valgrind is slow on a
+// given program, using the host's performance counters (Linux
+// perf_event_open).  With --perf-counters=yes, it counts host events
+// (cycles, instructions, branch mispredicts, i-cache and iTLB misses)
+// separately for each phase Valgrind goes through: running the
+// translated code, translating, doing system calls and the rest of the
+// core.  With --perf-map=yes, it writes a /tmp/perf-<pid>.map file
+// naming each translation after the guest function it comes from, so
+// that "perf report" can attribute samples in the translation cache.
+//--------------------------------------------------------------------
+
+typedef
+   enum {
+      VgPerf_Core=0,   // the scheduler, signals, the tool outside
+                       // translated code, ...
+      VgPerf_Guest,    // translated code, with the dispatcher and the
+                       // helpers it calls
+      VgPerf_Jit,      // VG_(translate)
+      VgPerf_Syscall,  // the client's system calls and their wrappers
+      VgPerf_N_PHASES
+   }
+   VgPerfPhase;
+
+// Tell that thread tid now enters phase, and return the phase it was
+// in, for giving back to VG_(perf_phase) at the end of phase.  Does
+// nothing (but return VgPerf_Core) unless --perf-counters=yes.
+extern VgPerfPhase VG_(perf_phase) ( ThreadId tid, VgPerfPhase phase );
+
+// Print the counts of each phase, if --perf-counters=yes.
+extern void VG_(print_perf_counters) ( void );
+
+// Tell the --perf-map file that the host code at [code, code+len)
+// translates the guest code at guest_addr.  Does nothing unless
+// --perf-map=yes.
+extern void VG_(perf_map_translation) ( Addr code, UInt len,
+                                        Addr64 guest_addr );
+
+#endif   // __PUB_CORE_PERFEVENTS_H
+
+/*--------------------------------------------------------------------*/
+/*--- end                                                          ---*/
+/*--------------------------------------------------------------------*/
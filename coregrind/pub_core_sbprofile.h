@@ -40,6 +40,15 @@
    run-end profile. */
 void VG_(get_and_show_SB_profile) ( ULong ecs_done );
 
+/* For --profile-sample: the number of event checks after which the
+   scheduler should take the next sample, and recording a sample, that
+   is the guest address of the SB a thread is about to run. */
+UInt VG_(SB_sample_interval) ( void );
+void VG_(sample_SB) ( Addr addr );
+
+/* Print the blocks most often seen by VG_(sample_SB). */
+void VG_(show_SB_samples) ( void );
+
 #endif   // __PUB_CORE_SBPROFILE_H
 
 /*--------------------------------------------------------------------*/
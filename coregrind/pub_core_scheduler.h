@@ -84,6 +84,23 @@ extern void VG_(release_BigLock_LL) ( const HChar* who );
 /* Whether the specified thread owns the big lock. */
 extern Bool VG_(owns_BigLock_LL) ( ThreadId tid );
 
+/* With --parallel-threads=yes, threads run generated code without
+   holding the_BigLock.  VG_(stop_parallel_threads), called with the
+   lock held, makes them all come back out of it, and waits until
+   they have; they then can't go back in until the lock is released.
+   It must be done before changing anything generated code may be
+   using: translations, and the fast caches.  Does nothing if no
+   threads are in generated code. */
+extern void VG_(stop_parallel_threads) ( void );
+
+/* For signal handlers, which need the_BigLock.  If tid was running
+   generated code without the lock, take it, make tid the running
+   thread and return True; otherwise return False.  In the True case
+   the handler must call VG_(return_to_parallel_code) before
+   returning to the generated code, unless it longjmps out of it. */
+extern Bool VG_(leave_parallel_code) ( ThreadId tid );
+extern void VG_(return_to_parallel_code) ( ThreadId tid );
+
 /* Yield the CPU for a while.  Drops/acquires the lock using the
    normal (non _LL) functions. */
 extern void VG_(vg_yield)(void);
@@ -110,6 +127,10 @@ extern void VG_(force_vgdb_poll) ( void );
 /* Stats ... */
 extern void VG_(print_scheduler_stats) ( void );
 
+/* Give the scheduler metrics to put (see pub_core_metrics.h). */
+extern void VG_(scheduler_metrics)
+               ( void (*put)(const HChar* name, ULong value) );
+
 /* If False, a fault is Valgrind-internal (ie, a bug) */
 extern Bool VG_(in_generated_code);
 
@@ -36,7 +36,8 @@
 // PURPOSE: Provides an implementation of a sparse array of host words
 // (UWord).  The indices are themselves host words.  The implementation
 // uses a 256-way radix tree, which is therefore 4 levels deep on a 
-// 32-bit platform and 8 levels deep on a 64-bit platform.
+// 32-bit platform and 8 levels deep on a 64-bit platform, or, if made
+// by VG_(newSWA_ART), an adaptive radix tree with compressed paths.
 //--------------------------------------------------------------------
 
 // No core-only exports; everything in this module is visible to both
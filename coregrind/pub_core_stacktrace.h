@@ -57,6 +57,11 @@ UInt VG_(get_StackTrace_wrk) ( ThreadId tid_if_known,
                                UnwindStartRegs* startRegs,
                                Addr fp_max_orig );
 
+// Print the StackTrace of the ExeContext with unique tag ecu.  The
+// same as VG_(pp_StackTrace), except that with --xml-stack-refs=yes
+// a stack already printed is only referred to.
+void VG_(pp_StackTrace_of_ECU) ( UInt ecu, StackTrace ips, UInt n_ips );
+
 #endif   // __PUB_CORE_STACKTRACE_H
 
 /*--------------------------------------------------------------------*/
@@ -365,6 +365,11 @@ typedef struct {
    Bool               sched_jmpbuf_valid;
    VG_MINIMAL_JMP_BUF(sched_jmpbuf);
 
+   /* With --parallel-threads=yes: is this thread running generated
+      code without holding the_BigLock?  Its status stays
+      VgTs_Runnable meanwhile, but it isn't VG_(running_tid). */
+   volatile Bool      in_parallel_code;
+
    /* This thread's name. NULL, if no name. */
    HChar *thread_name;
 }
@@ -375,10 +380,10 @@ ThreadState;
 /*--- The thread table.                                    ---*/
 /*------------------------------------------------------------*/
 
-/* A statically allocated array of threads.  NOTE: [0] is
-   never used, to simplify the simulation of initialisers for
-   LinuxThreads. */
-extern ThreadState VG_(threads)[VG_N_THREADS];
+/* An array of VG_N_THREADS threads, allocated by VG_(init_Threads).
+   NOTE: [0] is never used, to simplify the simulation of initialisers
+   for LinuxThreads. */
+extern ThreadState* VG_(threads);
 
 // The running thread.  m_scheduler should be the only other module
 // to write to this.
@@ -89,11 +89,17 @@ typedef
       Bool syscall_wrapper;
       Bool sanity_checks;
       Bool print_stats;
+      Bool metrics;
       Bool info_location;
       Bool var_info;
       Bool malloc_replacement;
       Bool xml_output;
       Bool final_IR_tidy_pass;
+      Bool persistent_translations;
+      Bool thread_safe_instrumentation;
+      Bool fast_forward;
+      Bool instrumentation_filter;
+      Bool merged_stack_events;
    } 
    VgNeeds;
 
@@ -154,6 +160,9 @@ typedef struct {
    // VG_(needs).print_stats
    void (*tool_print_stats)(void);
 
+   // VG_(needs).metrics
+   void (*tool_metrics)(void (*put)(const HChar* name, ULong value));
+
    // VG_(needs).info_location
    void (*tool_info_location)(Addr a);
 
@@ -176,6 +185,15 @@ typedef struct {
    // VG_(needs).xml_output
    // (none)
 
+   // VG_(needs).fast_forward
+   void (*tool_start_instrumentation)(void);
+
+   // VG_(needs).instrumentation_filter
+   IRSB* (*tool_instrument_skipped)(VgCallbackClosure*,
+                                    IRSB*,
+                                    VexGuestLayout*, VexGuestExtents*,
+                                    VexArchInfo*, IRType, IRType);
+
    // -- Event tracking functions ------------------------------------
    void (*track_new_mem_startup)     (Addr, SizeT, Bool, Bool, Bool, ULong);
    void (*track_new_mem_stack_signal)(Addr, SizeT, ThreadId);
@@ -227,6 +245,12 @@ typedef struct {
    void (*track_pre_mem_read_asciiz)(CorePart, ThreadId, const HChar*, Addr);
    void (*track_pre_mem_write)      (CorePart, ThreadId, const HChar*, Addr, SizeT);
    void (*track_post_mem_write)     (CorePart, ThreadId, Addr, SizeT);
+   void (*track_pre_mem_read_iov)   (CorePart, ThreadId, const HChar*,
+                                     const struct vki_iovec*, UInt, SizeT);
+   void (*track_pre_mem_write_iov)  (CorePart, ThreadId, const HChar*,
+                                     const struct vki_iovec*, UInt, SizeT);
+   void (*track_post_mem_write_iov) (CorePart, ThreadId,
+                                     const struct vki_iovec*, UInt, SizeT);
 
    void (*track_pre_reg_read)  (CorePart, ThreadId, const HChar*, PtrdiffT, SizeT);
    void (*track_post_reg_write)(CorePart, ThreadId,               PtrdiffT, SizeT);
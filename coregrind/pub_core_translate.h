@@ -48,6 +48,40 @@ Bool VG_(translate) ( ThreadId tid,
 
 extern void VG_(print_translation_stats) ( void );
 
+/* For VALGRIND_PRETRANSLATE: translate the code in [start, start+len)
+   reachable from start by direct jumps and calls, ahead of its being
+   run.  Returns the number of translations made. */
+extern UInt VG_(pretranslate_range) ( ThreadId tid, Addr start, SizeT len,
+                                      ULong bbs_done );
+
+/* For --pretranslate: translates the functions it names in any
+   objects whose debug info has been read since the last call. */
+extern void VG_(maybe_pretranslate) ( ThreadId tid, ULong bbs_done );
+
+/* With --fast-forward, ask for the instrumentation to be started, for
+   the reason 'why', at the next VG_(maybe_start_instrumentation). */
+extern void VG_(request_start_instrumentation) ( const HChar* why );
+
+/* Called by the scheduler at points where all the translations can be
+   discarded, with the number of blocks run so far.  Starts the
+   instrumentation if it has been asked for, or if --fast-forward-bbs
+   blocks have run. */
+extern void VG_(maybe_start_instrumentation) ( ULong bbs_done );
+
+/* Checks the --skip-instrument and --instrument-only options, and
+   prepares to apply them. */
+extern void VG_(init_instrumentation_filter) ( void );
+
+/* Is the code at a filtered out of the instrumentation by them? */
+extern Bool VG_(is_skipped_code) ( Addr a );
+
+/* Shows where translation time went, per phase of LibVEX_Translate.
+   Times are only taken with --profile-jit=yes or --stats=yes. */
+extern void VG_(print_jit_profile) ( void );
+
+/* Give the translation metrics to put (see pub_core_metrics.h). */
+extern void VG_(jit_metrics) ( void (*put)(const HChar* name, ULong value) );
+
 #endif   // __PUB_CORE_TRANSLATE_H
 
 /*--------------------------------------------------------------------*/
@@ -40,19 +40,25 @@
 #include "pub_core_transtab_asm.h"
 
 /* The fast-cache for tt-lookup.  Unused entries are denoted by .guest
-   == 1, which is assumed to be a bogus address for all guest code. */
+   == 1, which is assumed to be a bogus address for all guest code.
+   Within a set, way 0 holds the most recently added entry. */
 typedef
-   struct { 
-      Addr guest;
-      Addr host;
+   struct _FastCacheSet { 
+      Addr guest[VG_TT_FAST_WAYS];
+      Addr host[VG_TT_FAST_WAYS];
    }
-   FastCacheEntry;
+   FastCacheSet;
 
-extern __attribute__((aligned(16)))
-       FastCacheEntry VG_(tt_fast) [VG_TT_FAST_SIZE];
+extern __attribute__((aligned(64)))
+       FastCacheSet VG_(tt_fast) [VG_TT_FAST_SIZE];
 
 #define TRANSTAB_BOGUS_GUEST_ADDR ((Addr)1)
 
+/* The fast cache thread tid's indirect jumps are to be looked up in:
+   VG_(tt_fast), unless --parallel-threads=yes, in which case each
+   thread has its own. */
+extern FastCacheSet* VG_(get_fast_cache) ( ThreadId tid );
+
 
 /* Initialises the TC, using VG_(clo_num_transtab_sectors).
    VG_(clo_num_transtab_sectors) must be >= MIN_N_SECTORS
@@ -102,6 +108,14 @@ extern void VG_(discard_translations) ( Addr64 start, ULong range,
 
 extern void VG_(print_tt_tc_stats) ( void );
 
+/* Give the translation table and cache metrics to put (see
+   pub_core_metrics.h). */
+extern void VG_(tt_tc_metrics) ( void (*put)(const HChar* name, ULong value) );
+
+/* For --hot-code-layout=yes: move the translations which have run
+   most since the last call into the hot sector. */
+extern void VG_(move_hot_translations) ( void );
+
 extern UInt VG_(get_bbs_translated) ( void );
 
 /* Add to / search the auxiliary, small, unredirected translation
@@ -116,6 +130,73 @@ extern
 Bool VG_(search_unredir_transtab) ( /*OUT*/AddrH* result,
                                     Addr64        guest_addr );
 
+/* The persistent translation cache (--transtab-cache,
+   --transtab-reuse and --transtab-share).  It is only active if one of
+   the options was given and the tool has declared
+   VG_(needs_persistent_translations). */
+extern Bool VG_(transtab_cache_active) ( void );
+
+/* Look for a cached translation of nraddr.  If one exists, entry_ok
+   is asked whether its extents would still be translated the same
+   way; if so, and the guest bytes are unchanged, the translation is
+   added to the TT/TC, its extents are written to *vge and True is
+   returned.  Otherwise the entry is discarded and False returned. */
+extern
+Bool VG_(search_transtab_cache) ( Addr64 nraddr,
+                                  Bool (*entry_ok)( void* opaque,
+                                                    VexGuestExtents* vge,
+                                                    UInt sc_bitmask ),
+                                  void* opaque,
+                                  /*OUT*/VexGuestExtents* vge );
+
+/* Remember a freshly made (and not yet chained) translation so that
+   it can be written out by VG_(save_transtab_cache), or found by other
+   processes sharing the cache.  'sc_bitmask' is the self-check bitmask
+   it was made with. */
+extern
+void VG_(add_to_transtab_cache) ( VexGuestExtents* vge,
+                                  Addr64           nraddr,
+                                  AddrH            code,
+                                  UInt             code_len,
+                                  UInt             n_sc_extents,
+                                  UInt             sc_bitmask,
+                                  Int              offs_profInc,
+                                  UInt             n_guest_instrs );
+
+/* Write the cache out to the --transtab-cache file. */
+extern void VG_(save_transtab_cache) ( void );
+
+/* Write-protection of code pages, for --smc-check=protect.  Rather
+   than checking translations of code in private anonymous memory, the pages
+   it came from are made read-only (in reality, not in aspacem's view
+   of them), and a write to one of them discards the page's
+   translations and makes it writable again. */
+
+/* Can the pages of [a, a+len) be write-protected?  False for pages
+   not in private anonymous client memory (SysV shm and MAP_SHARED
+   pages can be written through another mapping), and for pages which
+   have been written to so often that protecting them is not worth
+   it. */
+extern Bool VG_(smc_can_protect) ( Addr a, SizeT len );
+
+/* Write-protect the pages of [a, a+len), which translations have
+   just been made from. */
+extern void VG_(smc_protect) ( Addr a, SizeT len );
+
+/* The kernel is about to write to [a, a+len) on the client's behalf:
+   discard the translations of any protected pages in it, and so make
+   them writable. */
+extern void VG_(smc_unprotect) ( Addr a, SizeT len );
+
+/* The client has changed the permissions of [a, a+len): take write
+   permission away again from any protected pages in it. */
+extern void VG_(smc_reprotect) ( Addr a, SizeT len );
+
+/* Called for a SIGSEGV at address a.  If it is a write to a protected
+   page, discard the page's translations, make it writable and return
+   True; the faulting instruction can then be restarted. */
+extern Bool VG_(smc_handle_write_fault) ( Addr a );
+
 // SB profiling stuff
 
 typedef struct _SBProfEntry {
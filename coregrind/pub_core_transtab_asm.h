@@ -31,10 +31,17 @@
 #ifndef __PUB_CORE_TRANSTAB_ASM_H
 #define __PUB_CORE_TRANSTAB_ASM_H
 
-/* Constants for the fast translation lookup cache.  It is a direct
-   mapped cache, with 2^VG_TT_FAST_BITS entries.
+/* Constants for the fast translation lookup cache.  It has
+   2^VG_TT_FAST_BITS sets of VG_TT_FAST_WAYS entries each.
 
-   On x86/amd64, the cache index is computed as
+   On amd64 and arm64 it is 4-way set associative, so each set fills
+   exactly one 64-byte cache line, and the dispatcher checks all four
+   ways before giving up.  That reduces the conflict misses of a large
+   program with many indirect branches.  On the other platforms the
+   dispatchers check only one entry, so the cache is direct mapped.
+   All platforms have 2^15 entries in total.
+
+   On x86/amd64, the set number is computed as
    'address[VG_TT_FAST_BITS-1 : 0]'.
 
    On ppc32/ppc64/mips32/mips64/arm64, the bottom two bits of
@@ -49,7 +56,13 @@
    On s390x the rightmost bit of an instruction address is zero.
    For best table utilization shift the address to the right by 1 bit. */
 
-#define VG_TT_FAST_BITS 15
+#if defined(VGA_amd64) || defined(VGA_arm64)
+#  define VG_TT_FAST_WAYS 4
+#  define VG_TT_FAST_BITS 13
+#else
+#  define VG_TT_FAST_WAYS 1
+#  define VG_TT_FAST_BITS 15
+#endif
 #define VG_TT_FAST_SIZE (1 << VG_TT_FAST_BITS)
 #define VG_TT_FAST_MASK ((VG_TT_FAST_SIZE) - 1)
 
@@ -207,7 +207,8 @@ typedef struct {
    Int lwpid;
 }
 VgdbThreadState;
-static VgdbThreadState vgdb_threads[VG_N_THREADS];
+static VgdbThreadState *vgdb_threads;
+static int vg_n_threads;
 
 static const
 HChar* name_of_ThreadStatus ( ThreadStatus status )
@@ -408,18 +409,25 @@ Bool acquire_and_suspend_threads (pid_t pid)
       sz_tst = shared32->sizeof_ThreadState;
       off_status = shared32->offset_status;
       off_lwpid = shared32->offset_lwpid;
+      vg_n_threads = shared32->nr_threads;
    }
    else if (shared64 != NULL) {
       vgt = shared64->threads;
       sz_tst = shared64->sizeof_ThreadState;
       off_status = shared64->offset_status;
       off_lwpid = shared64->offset_lwpid;
+      vg_n_threads = shared64->nr_threads;
    } else {
       assert (0);
    }
 
+   if (vgdb_threads == NULL) {
+      vgdb_threads = vmalloc(vg_n_threads * sizeof(VgdbThreadState));
+      memset(vgdb_threads, 0, vg_n_threads * sizeof(VgdbThreadState));
+   }
+
    /* note: the entry 0 is unused */
-   for (i = 1; i < VG_N_THREADS; i++) {
+   for (i = 1; i < vg_n_threads; i++) {
       vgt += sz_tst;
       rw = ptrace_read_memory(pid, vgt+off_status,
                               &(vgdb_threads[i].status),
@@ -486,7 +494,7 @@ void detach_from_all_threads (pid_t pid)
    Bool pid_found = False;
 
    /* detach from all the threads  */
-   for (i = 1; i < VG_N_THREADS; i++) {
+   for (i = 1; i < vg_n_threads; i++) {
       if (vgdb_threads[i].status != VgTs_Empty) {
          if (vgdb_threads[i].status == VgTs_Init
              && vgdb_threads[i].lwpid == 0) {
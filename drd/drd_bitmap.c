@@ -36,6 +36,7 @@
 
 /* Local function declarations. */
 
+static Bool bm2_is_empty(const struct bitmap2* const bm2);
 static void bm2_merge(struct bitmap2* const bm2l,
                       const struct bitmap2* const bm2r);
 static void bm2_print(const struct bitmap2* const bm2);
@@ -350,15 +351,14 @@ Bool DRD_(bm_has_any_load_g)(struct bitmap* const bm)
    for ( ; (bm2 = VG_(OSetGen_Next)(bm->oset)) != NULL; ) {
       Addr b_start;
       Addr b_end;
-      UWord b0;
       const struct bitmap1* const p1 = &bm2->bm1;
 
       b_start = make_address(bm2->addr, 0);
       b_end = make_address(bm2->addr + 1, 0);
 
-      for (b0 = address_lsb(b_start); b0 <= address_lsb(b_end - 1); b0++)
-         if (bm0_is_set(p1->bm0_r, b0))
-            return True;
+      if (bm0_is_any_set_in(p1->bm0_r, address_lsb(b_start),
+                            address_lsb(b_end - 1)))
+         return True;
    }
    return False;
 }
@@ -384,7 +384,6 @@ DRD_(bm_has_any_load)(struct bitmap* const bm, const Addr a1, const Addr a2)
       {
          Addr b_start;
          Addr b_end;
-         UWord b0;
          const struct bitmap1* const p1 = &bm2->bm1;
 
          if (make_address(bm2->addr, 0) < a1)
@@ -404,12 +403,10 @@ DRD_(bm_has_any_load)(struct bitmap* const bm, const Addr a1, const Addr a2)
          tl_assert(b_start < b_end);
          tl_assert(address_lsb(b_start) <= address_lsb(b_end - 1));
 
-         for (b0 = address_lsb(b_start); b0 <= address_lsb(b_end - 1); b0++)
+         if (bm0_is_any_set_in(p1->bm0_r, address_lsb(b_start),
+                               address_lsb(b_end - 1)))
          {
-            if (bm0_is_set(p1->bm0_r, b0))
-            {
-               return True;
-            }
+            return True;
          }
       }
    }
@@ -437,7 +434,6 @@ Bool DRD_(bm_has_any_store)(struct bitmap* const bm,
       {
          Addr b_start;
          Addr b_end;
-         UWord b0;
          const struct bitmap1* const p1 = &bm2->bm1;
 
          if (make_address(bm2->addr, 0) < a1)
@@ -457,12 +453,10 @@ Bool DRD_(bm_has_any_store)(struct bitmap* const bm,
          tl_assert(b_start < b_end);
          tl_assert(address_lsb(b_start) <= address_lsb(b_end - 1));
 
-         for (b0 = address_lsb(b_start); b0 <= address_lsb(b_end - 1); b0++)
+         if (bm0_is_any_set_in(p1->bm0_w, address_lsb(b_start),
+                               address_lsb(b_end - 1)))
          {
-            if (bm0_is_set(p1->bm0_w, b0))
-            {
-               return True;
-            }
+            return True;
          }
       }
    }
@@ -492,7 +486,6 @@ Bool DRD_(bm_has_any_access)(struct bitmap* const bm,
       {
          Addr b_start;
          Addr b_end;
-         UWord b0;
          const struct bitmap1* const p1 = &bm2->bm1;
 
          if (make_address(bm2->addr, 0) < a1)
@@ -512,16 +505,16 @@ Bool DRD_(bm_has_any_access)(struct bitmap* const bm,
          tl_assert(b_start < b_end);
          tl_assert(address_lsb(b_start) <= address_lsb(b_end - 1));
 
-         for (b0 = address_lsb(b_start); b0 <= address_lsb(b_end - 1); b0++)
+         /*
+          * Note: the statement below uses a binary or instead of a logical
+          * or on purpose.
+          */
+         if (bm0_is_any_set_in(p1->bm0_r, address_lsb(b_start),
+                               address_lsb(b_end - 1))
+             | bm0_is_any_set_in(p1->bm0_w, address_lsb(b_start),
+                                 address_lsb(b_end - 1)))
          {
-            /*
-             * Note: the statement below uses a binary or instead of a logical
-             * or on purpose.
-             */
-            if (bm0_is_set(p1->bm0_r, b0) | bm0_is_set(p1->bm0_w, b0))
-            {
-               return True;
-            }
+            return True;
          }
       }
    }
@@ -845,23 +838,21 @@ Bool DRD_(bm_has_conflict_with)(struct bitmap* const bm,
          tl_assert(b_start < b_end);
          tl_assert(address_lsb(b_start) <= address_lsb(b_end - 1));
 
-         for (b0 = address_lsb(b_start); b0 <= address_lsb(b_end - 1); b0++)
+         b0 = address_lsb(b_start);
+         if (access_type == eLoad)
          {
-            if (access_type == eLoad)
+            if (bm0_is_any_set_in(p1->bm0_w, b0, address_lsb(b_end - 1)))
             {
-               if (bm0_is_set(p1->bm0_w, b0))
-               {
-                  return True;
-               }
+               return True;
             }
-            else
+         }
+         else
+         {
+            tl_assert(access_type == eStore);
+            if (bm0_is_any_set_in(p1->bm0_r, b0, address_lsb(b_end - 1))
+                | bm0_is_any_set_in(p1->bm0_w, b0, address_lsb(b_end - 1)))
             {
-               tl_assert(access_type == eStore);
-               if (bm0_is_set(p1->bm0_r, b0)
-                   | bm0_is_set(p1->bm0_w, b0))
-               {
-                  return True;
-               }
+               return True;
             }
          }
       }
@@ -957,10 +948,7 @@ Bool DRD_(bm_equal)(struct bitmap* const lhs, struct bitmap* const rhs)
 
    for ( ; (bm2l = VG_(OSetGen_Next)(lhs->oset)) != 0; )
    {
-      while (bm2l
-             && ! DRD_(bm_has_any_access)(lhs,
-                                          make_address(bm2l->addr, 0),
-                                          make_address(bm2l->addr + 1, 0)))
+      while (bm2l && bm2_is_empty(bm2l))
       {
          bm2l = VG_(OSetGen_Next)(lhs->oset);
       }
@@ -974,14 +962,9 @@ Bool DRD_(bm_equal)(struct bitmap* const lhs, struct bitmap* const rhs)
          if (bm2r == 0)
             return False;
       }
-      while (! DRD_(bm_has_any_access)(rhs,
-                                       make_address(bm2r->addr, 0),
-                                       make_address(bm2r->addr + 1, 0)));
+      while (bm2_is_empty(bm2r));
 
       tl_assert(bm2r);
-      tl_assert(DRD_(bm_has_any_access)(rhs,
-                                        make_address(bm2r->addr, 0),
-                                        make_address(bm2r->addr + 1, 0)));
 
       if (bm2l != bm2r
           && (bm2l->addr != bm2r->addr
@@ -994,14 +977,9 @@ Bool DRD_(bm_equal)(struct bitmap* const lhs, struct bitmap* const rhs)
    do
    {
       bm2r = VG_(OSetGen_Next)(rhs->oset);
-   } while (bm2r && ! DRD_(bm_has_any_access)(rhs,
-                                              make_address(bm2r->addr, 0),
-                                              make_address(bm2r->addr + 1, 0)));
+   } while (bm2r && bm2_is_empty(bm2r));
    if (bm2r)
    {
-      tl_assert(DRD_(bm_has_any_access)(rhs,
-                                        make_address(bm2r->addr, 0),
-                                        make_address(bm2r->addr + 1, 0)));
       return False;
    }
    return True;
@@ -1141,9 +1119,7 @@ void DRD_(bm_remove_cleared_marked)(struct bitmap* bm)
    for ( ; (bm2 = VG_(OSetGen_Next)(bm->oset)) != 0; )
    {
       const UWord a1 = bm2->addr;
-      if (bm2->recalc
-          && ! DRD_(bm_has_any_access(bm, make_address(a1, 0),
-                                      make_address(a1 + 1, 0))))
+      if (bm2->recalc && bm2_is_empty(bm2))
       {
          bm2_remove(bm, a1);
          VG_(OSetGen_ResetIterAt)(bm->oset, &a1);
@@ -1187,16 +1163,22 @@ int DRD_(bm_has_races)(struct bitmap* const lhs, struct bitmap* const rhs)
 
       for (k = 0; k < BITMAP1_UWORD_COUNT; k++)
       {
+         /*
+          * Evaluate HAS_RACE() for all BITS_PER_UWORD addresses covered by
+          * bm0_*[k] at once and only look at the individual addresses for
+          * which HAS_RACE() is true.
+          */
+         UWord race_mask
+            = (bm1r->bm0_w[k] & (bm1l->bm0_r[k] | bm1l->bm0_w[k]))
+            | (bm1l->bm0_w[k] & (bm1r->bm0_r[k] | bm1r->bm0_w[k]));
          unsigned b;
-         for (b = 0; b < BITS_PER_UWORD; b++)
+         for (b = 0; race_mask; b++, race_mask >>= 1)
          {
-            UWord const access_mask
-               = ((bm1l->bm0_r[k] & bm0_mask(b)) ? LHS_R : 0)
-               | ((bm1l->bm0_w[k] & bm0_mask(b)) ? LHS_W : 0)
-               | ((bm1r->bm0_r[k] & bm0_mask(b)) ? RHS_R : 0)
-               | ((bm1r->bm0_w[k] & bm0_mask(b)) ? RHS_W : 0);
-            Addr const a = make_address(bm2l->addr, k * BITS_PER_UWORD | b);
-            if (HAS_RACE(access_mask) && ! DRD_(is_suppressed)(a, a + 1))
+            Addr a;
+            if ((race_mask & 1) == 0)
+               continue;
+            a = make_address(bm2l->addr, k * BITS_PER_UWORD | b);
+            if (! DRD_(is_suppressed)(a, a + 1))
             {
                return 1;
             }
@@ -1272,9 +1254,22 @@ void bm2_merge(struct bitmap2* const bm2l, const struct bitmap2* const bm2r)
    for (k = 0; k < BITMAP1_UWORD_COUNT; k++)
    {
       bm2l->bm1.bm0_r[k] |= bm2r->bm1.bm0_r[k];
-   }
-   for (k = 0; k < BITMAP1_UWORD_COUNT; k++)
-   {
       bm2l->bm1.bm0_w[k] |= bm2r->bm1.bm0_w[k];
    }
 }
+
+/**
+ * Report whether no access at all has been recorded in *bm2, testing one
+ * UWord at a time instead of one address at a time.
+ */
+static Bool bm2_is_empty(const struct bitmap2* const bm2)
+{
+   UWord any = 0;
+   unsigned k;
+
+   tl_assert(bm2);
+
+   for (k = 0; k < BITMAP1_UWORD_COUNT; k++)
+      any |= bm2->bm1.bm0_r[k] | bm2->bm1.bm0_w[k];
+   return any == 0;
+}
@@ -322,6 +322,35 @@ static __inline__ UWord bm0_is_any_set(const UWord* bm0,
    return (bm0[uword_msb(a)] & ((((UWord)1 << size) - 1) << uword_lsb(a)));
 }
 
+/**
+ * Return true if a bit corresponding to any of the addresses in range
+ * [ a1 << ADDR_IGNORED_BITS .. a2 << ADDR_IGNORED_BITS ] is set in bm0.
+ * Unlike bm0_is_any_set() the range may span multiple UWords, which are
+ * tested one UWord at a time.
+ */
+static __inline__ UWord bm0_is_any_set_in(const UWord* bm0,
+                                          const UWord a1, const UWord a2)
+{
+   const UWord k1 = uword_msb(a1);
+   const UWord k2 = uword_msb(a2);
+   const UWord m1 = ~(UWord)0 << uword_lsb(a1);
+   const UWord m2 = ~(UWord)0 >> (BITS_PER_UWORD - 1 - uword_lsb(a2));
+   UWord k;
+
+#ifdef ENABLE_DRD_CONSISTENCY_CHECKS
+   tl_assert(a1 <= a2);
+   tl_assert(address_msb(make_address(0, a2)) == 0);
+#endif
+   if (k1 == k2)
+      return bm0[k1] & m1 & m2;
+   if (bm0[k1] & m1)
+      return True;
+   for (k = k1 + 1; k < k2; k++)
+      if (bm0[k])
+         return True;
+   return bm0[k2] & m2;
+}
+
 
 
 /*********************************************************************/
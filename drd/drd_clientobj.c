@@ -41,6 +41,15 @@
 static OSet* s_clientobj_set;
 static Bool s_trace_clientobj;
 
+/*
+ * Direct-mapped cache in front of s_clientobj_set, for the exact-address
+ * lookups that every synchronization call does. Entries point at nodes of
+ * s_clientobj_set, which do not move, and are cleared when their node is
+ * removed.
+ */
+#define CLIENTOBJ_CACHE_SIZE 4096
+static DrdClientobj* s_clientobj_cache[CLIENTOBJ_CACHE_SIZE];
+
 
 /* Local functions. */
 
@@ -49,6 +58,24 @@ static Bool clientobj_remove_obj(DrdClientobj* const p);
 
 /* Function definitions. */
 
+static __inline__ UWord clientobj_cache_ix(const Addr addr)
+{
+   return ((addr >> 3) ^ (addr >> 15)) & (CLIENTOBJ_CACHE_SIZE - 1);
+}
+
+static __inline__ DrdClientobj* clientobj_lookup(const Addr addr)
+{
+   const UWord ix = clientobj_cache_ix(addr);
+   DrdClientobj* p = s_clientobj_cache[ix];
+
+   if (p && p->any.a1 == addr)
+      return p;
+   p = VG_(OSetGen_Lookup)(s_clientobj_set, &addr);
+   if (p)
+      s_clientobj_cache[ix] = p;
+   return p;
+}
+
 void DRD_(clientobj_set_trace)(const Bool trace)
 {
    s_trace_clientobj = trace;
@@ -83,7 +110,7 @@ void DRD_(clientobj_cleanup)(void)
  */
 DrdClientobj* DRD_(clientobj_get_any)(const Addr addr)
 {
-   return VG_(OSetGen_Lookup)(s_clientobj_set, &addr);
+   return clientobj_lookup(addr);
 }
 
 /**
@@ -94,7 +121,7 @@ DrdClientobj* DRD_(clientobj_get_any)(const Addr addr)
 DrdClientobj* DRD_(clientobj_get)(const Addr addr, const ObjType t)
 {
    DrdClientobj* p;
-   p = VG_(OSetGen_Lookup)(s_clientobj_set, &addr);
+   p = clientobj_lookup(addr);
    if (p && p->any.type == t)
       return p;
    return 0;
@@ -102,21 +129,18 @@ DrdClientobj* DRD_(clientobj_get)(const Addr addr, const ObjType t)
 
 /** Return true if and only if the address range of any client object overlaps
  *  with the specified address range.
+ *
+ * @note Since s_clientobj_set is sorted on start address, only the first
+ *   object at or after a1 has to be looked at.
  */
 Bool DRD_(clientobj_present)(const Addr a1, const Addr a2)
 {
    DrdClientobj *p;
 
    tl_assert(a1 <= a2);
-   VG_(OSetGen_ResetIter)(s_clientobj_set);
-   for ( ; (p = VG_(OSetGen_Next)(s_clientobj_set)) != 0; )
-   {
-      if (a1 <= p->any.a1 && p->any.a1 < a2)
-      {
-         return True;
-      }
-   }
-   return False;
+   VG_(OSetGen_ResetIterAt)(s_clientobj_set, &a1);
+   p = VG_(OSetGen_Next)(s_clientobj_set);
+   return p && p->any.a1 < a2;
 }
 
 /**
@@ -159,7 +183,7 @@ Bool DRD_(clientobj_remove)(const Addr addr, const ObjType t)
 {
    DrdClientobj* p;
 
-   p = VG_(OSetGen_Lookup)(s_clientobj_set, &addr);
+   p = clientobj_lookup(addr);
    tl_assert(p);
    tl_assert(p->any.type == t);
    return clientobj_remove_obj(p);
@@ -189,6 +213,8 @@ static Bool clientobj_remove_obj(DrdClientobj* const p)
 
    tl_assert(p->any.cleanup);
    (*p->any.cleanup)(p);
+   if (s_clientobj_cache[clientobj_cache_ix(p->any.a1)] == p)
+      s_clientobj_cache[clientobj_cache_ix(p->any.a1)] = 0;
    VG_(OSetGen_Remove)(s_clientobj_set, &p->any.a1);
    VG_(OSetGen_FreeNode)(s_clientobj_set, p);
    return True;
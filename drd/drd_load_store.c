@@ -34,6 +34,10 @@
 #include "drd_thread.c"
 #include "drd_vc.c"
 #include "libvex_guest_offsets.h"
+#include "pub_tool_debuginfo.h"   // VG_(get_fnname)()
+#include "pub_tool_mallocfree.h"  // VG_(strdup)()
+#include "pub_tool_seqmatch.h"    // VG_(string_match)()
+#include "pub_tool_xarray.h"
 
 
 /* STACK_POINTER_OFFSET: VEX register offset for the stack pointer register. */
@@ -65,6 +69,38 @@
 static Bool s_check_stack_accesses = False;
 static Bool s_first_race_only      = False;
 
+/*
+ * Sampling of memory accesses (--sample-rate). Each superblock is assigned
+ * a sampler slot by hashing its guest address. A slot alternates between
+ * checking DRD_SAMPLE_BURST consecutive runs of the superblock and skipping
+ * a number of runs. The number of skipped runs starts at DRD_SAMPLE_BURST
+ * and doubles every time until the requested rate has been reached, such
+ * that cold code is always checked and hot code at the requested rate.
+ */
+#define DRD_N_SAMPLE_SITES (1 << 14)
+#define DRD_SAMPLE_BURST   10
+
+struct sample_site {
+   UInt left;     /* Number of runs left in the current phase. */
+   UInt skip;     /* Length of the most recent skipping phase. */
+   Bool checking; /* Whether the current phase is a checking phase. */
+};
+
+static UInt               s_sample_rate = 100;
+static UInt               s_sample_max_skip;
+static struct sample_site s_sample_site[DRD_N_SAMPLE_SITES];
+static ULong              s_sample_checked_count;
+static ULong              s_sample_skipped_count;
+/* Guard for the memory accesses of the superblock being instrumented. */
+static IRExpr*            s_sample_guard;
+
+/*
+ * Function name patterns passed via --ignore-fn, or NULL if none. Memory
+ * accesses by the code of matching functions are not instrumented at all.
+ */
+static XArray*            s_ignored_fns;
+static ULong              s_ignored_fn_insn_count;
+
 
 /* Function definitions. */
 
@@ -90,6 +126,89 @@ void DRD_(set_first_race_only)(const Bool fro)
    s_first_race_only = fro;
 }
 
+UInt DRD_(get_sample_rate)(void)
+{
+   return s_sample_rate;
+}
+
+void DRD_(set_sample_rate)(const UInt percentage)
+{
+   tl_assert(1 <= percentage && percentage <= 100);
+   s_sample_rate = percentage;
+   /*
+    * A checking phase of DRD_SAMPLE_BURST runs followed by a skipping phase
+    * of s_sample_max_skip runs yields the requested rate.
+    */
+   s_sample_max_skip = DRD_SAMPLE_BURST * (100 - percentage) / percentage;
+}
+
+ULong DRD_(get_sample_checked_count)(void)
+{
+   return s_sample_checked_count;
+}
+
+ULong DRD_(get_sample_skipped_count)(void)
+{
+   return s_sample_skipped_count;
+}
+
+void DRD_(add_ignored_fn)(const HChar* const pattern)
+{
+   HChar* const p = VG_(strdup)("drd.ignored_fn.1", pattern);
+
+   if (!s_ignored_fns)
+      s_ignored_fns = VG_(newXA)(VG_(malloc), "drd.ignored_fn.2", VG_(free),
+                                 sizeof(HChar*));
+   VG_(addToXA)(s_ignored_fns, &p);
+}
+
+ULong DRD_(get_ignored_fn_insn_count)(void)
+{
+   return s_ignored_fn_insn_count;
+}
+
+/**
+ * Whether the guest code at address a belongs to a function whose name
+ * matches one of the --ignore-fn patterns.
+ */
+static Bool is_in_ignored_fn(const Addr a)
+{
+   HChar fnname[256];
+   Word i;
+
+   if (!s_ignored_fns || !VG_(get_fnname)(a, fnname, sizeof(fnname)))
+      return False;
+   for (i = 0; i < VG_(sizeXA)(s_ignored_fns); i++) {
+      if (VG_(string_match)(*(HChar**)VG_(indexXA)(s_ignored_fns, i), fnname))
+         return True;
+   }
+   return False;
+}
+
+/** Decide whether the memory accesses of this superblock run are checked. */
+static VG_REGPARM(1) HWord drd_sample_site(const HWord ix)
+{
+   struct sample_site* const p = &s_sample_site[ix];
+
+   if (LIKELY(p->left > 0)) {
+      p->left--;
+   } else if (p->checking && s_sample_max_skip > 0) {
+      p->skip = p->skip == 0 ? DRD_SAMPLE_BURST : 2 * p->skip;
+      if (p->skip > s_sample_max_skip)
+         p->skip = s_sample_max_skip;
+      p->checking = False;
+      p->left = p->skip - 1;
+   } else {
+      p->checking = True;
+      p->left = DRD_SAMPLE_BURST - 1;
+   }
+   if (p->checking)
+      s_sample_checked_count++;
+   else
+      s_sample_skipped_count++;
+   return p->checking;
+}
+
 void DRD_(trace_mem_access)(const Addr addr, const SizeT size,
                             const BmAccessTypeT access_type,
                             const HWord stored_value_hi,
@@ -337,6 +456,90 @@ static Bool is_stack_access(IRSB* const bb, IRExpr* const addr_expr)
    return result;
 }
 
+/**
+ * Insert a call to drd_sample_site() for the superblock at guest address
+ * sb_base and return an Ity_I1 expression that is true if the memory
+ * accesses of the current run have to be checked.
+ */
+static IRExpr* instr_sample_site(IRSB* const bb, const Addr64 sb_base,
+                                 const IRType hWordTy)
+{
+   const HWord ix = (HWord)((sb_base * 0x9E3779B97F4A7C15ULL) >> 32)
+                    % DRD_N_SAMPLE_SITES;
+   const IRTemp res = newIRTemp(bb->tyenv, hWordTy);
+   const IRTemp g = newIRTemp(bb->tyenv, Ity_I1);
+   IRDirty* di;
+
+   di = unsafeIRDirty_1_N(res, /*regparms*/1, "drd_sample_site",
+                          VG_(fnptr_to_fnentry)(drd_sample_site),
+                          mkIRExprVec_1(mkIRExpr_HWord(ix)));
+   addStmtToIRSB(bb, IRStmt_Dirty(di));
+   addStmtToIRSB(bb, IRStmt_WrTmp(g, hWordTy == Ity_I32
+                    ? IRExpr_Binop(Iop_CmpNE32, IRExpr_RdTmp(res),
+                                   IRExpr_Const(IRConst_U32(0)))
+                    : IRExpr_Binop(Iop_CmpNE64, IRExpr_RdTmp(res),
+                                   IRExpr_Const(IRConst_U64(0)))));
+   return IRExpr_RdTmp(g);
+}
+
+/** Whether or not superblock bb contains any memory accesses. */
+static Bool has_mem_refs(IRSB* const bb)
+{
+   Int i;
+
+   for (i = 0; i < bb->stmts_used; i++) {
+      const IRStmt* const st = bb->stmts[i];
+
+      switch (st->tag) {
+      case Ist_Store:
+      case Ist_StoreG:
+      case Ist_LoadG:
+      case Ist_CAS:
+      case Ist_LLSC:
+         return True;
+      case Ist_WrTmp:
+         if (st->Ist.WrTmp.data->tag == Iex_Load)
+            return True;
+         break;
+      case Ist_Dirty:
+         if (st->Ist.Dirty.details->mFx != Ifx_None)
+            return True;
+         break;
+      default:
+         break;
+      }
+   }
+   return False;
+}
+
+/**
+ * Combine the guard of an access with the sampling guard of the current
+ * superblock, if any. Returns NULL if the access is unconditional.
+ */
+static IRExpr* sample_guard(IRSB* const bb, IRExpr* const guard)
+{
+   IRTemp w1, w2, and, res;
+
+   if (!s_sample_guard)
+      return guard;
+   if (!guard)
+      return s_sample_guard;
+   tl_assert(isIRAtom(guard));
+   w1 = newIRTemp(bb->tyenv, Ity_I32);
+   w2 = newIRTemp(bb->tyenv, Ity_I32);
+   and = newIRTemp(bb->tyenv, Ity_I32);
+   res = newIRTemp(bb->tyenv, Ity_I1);
+   addStmtToIRSB(bb, IRStmt_WrTmp(w1, IRExpr_Unop(Iop_1Uto32, guard)));
+   addStmtToIRSB(bb, IRStmt_WrTmp(w2, IRExpr_Unop(Iop_1Uto32,
+                                                  s_sample_guard)));
+   addStmtToIRSB(bb, IRStmt_WrTmp(and, IRExpr_Binop(Iop_And32,
+                                                    IRExpr_RdTmp(w1),
+                                                    IRExpr_RdTmp(w2))));
+   addStmtToIRSB(bb, IRStmt_WrTmp(res, IRExpr_Unop(Iop_32to1,
+                                                   IRExpr_RdTmp(and))));
+   return IRExpr_RdTmp(res);
+}
+
 static const IROp u_widen_irop[5][9] = {
    [Ity_I1  - Ity_I1] = { [4] = Iop_1Uto32,  [8] = Iop_1Uto64 },
    [Ity_I8  - Ity_I1] = { [4] = Iop_8Uto32,  [8] = Iop_8Uto64 },
@@ -477,6 +680,7 @@ static void instrument_load(IRSB* const bb, IRExpr* const addr_expr,
    IRExpr* size_expr;
    IRExpr** argv;
    IRDirty* di;
+   IRExpr* guard_with_sampling;
 
    if (!s_check_stack_accesses && is_stack_access(bb, addr_expr))
       return;
@@ -520,7 +724,8 @@ static void instrument_load(IRSB* const bb, IRExpr* const addr_expr,
                              argv);
       break;
    }
-   if (guard) di->guard = guard;
+   guard_with_sampling = sample_guard(bb, guard);
+   if (guard_with_sampling) di->guard = guard_with_sampling;
    addStmtToIRSB(bb, IRStmt_Dirty(di));
 }
 
@@ -531,6 +736,7 @@ static void instrument_store(IRSB* const bb, IRExpr* addr_expr,
    IRExpr* size_expr;
    IRExpr** argv;
    IRDirty* di;
+   IRExpr* guard_with_sampling;
    HWord size;
 
    size = sizeofIRType(typeOfIRExpr(bb->tyenv, data_expr));
@@ -584,7 +790,8 @@ static void instrument_store(IRSB* const bb, IRExpr* addr_expr,
                              argv);
       break;
    }
-   if (guard_expr) di->guard = guard_expr;
+   guard_with_sampling = sample_guard(bb, guard_expr);
+   if (guard_with_sampling) di->guard = guard_with_sampling;
    addStmtToIRSB(bb, IRStmt_Dirty(di));
 }
 
@@ -609,6 +816,10 @@ IRSB* DRD_(instrument)(VgCallbackClosure* const closure,
    bb->jumpkind = bb_in->jumpkind;
    bb->offsIP   = bb_in->offsIP;
 
+   s_sample_guard = NULL;
+   if (s_sample_rate < 100 && has_mem_refs(bb_in))
+      s_sample_guard = instr_sample_site(bb, vge->base[0], hWordTy);
+
    for (i = 0; i < bb_in->stmts_used; i++)
    {
       IRStmt* const st = bb_in->stmts[i];
@@ -626,6 +837,11 @@ IRSB* DRD_(instrument)(VgCallbackClosure* const closure,
       case Ist_IMark:
          instrument = VG_(DebugInfo_sect_kind)(NULL, 0, st->Ist.IMark.addr)
             != Vg_SectPLT;
+         /* Functions ignored via --ignore-fn are not instrumented at all. */
+         if (instrument && is_in_ignored_fn(st->Ist.IMark.addr)) {
+            instrument = False;
+            s_ignored_fn_insn_count++;
+         }
          addStmtToIRSB(bb, st);
          break;
 
@@ -715,6 +931,7 @@ IRSB* DRD_(instrument)(VgCallbackClosure* const closure,
                           "drd_trace_load",
                           VG_(fnptr_to_fnentry)(DRD_(trace_load)),
                           argv);
+                  if (s_sample_guard) di->guard = s_sample_guard;
                   addStmtToIRSB(bb, IRStmt_Dirty(di));
                }
                if (mFx == Ifx_Write || mFx == Ifx_Modify)
@@ -724,6 +941,7 @@ IRSB* DRD_(instrument)(VgCallbackClosure* const closure,
                           "drd_trace_store",
                           VG_(fnptr_to_fnentry)(DRD_(trace_store)),
                           argv);
+                  if (s_sample_guard) di->guard = s_sample_guard;
                   addStmtToIRSB(bb, IRStmt_Dirty(di));
                }
                break;
@@ -808,6 +1026,7 @@ IRSB* DRD_(instrument)(VgCallbackClosure* const closure,
       }
    }
 
+   s_sample_guard = NULL;
    return bb;
 }
 
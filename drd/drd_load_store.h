@@ -39,6 +39,12 @@ Bool DRD_(get_check_stack_accesses)(void);
 void DRD_(set_check_stack_accesses)(const Bool c);
 Bool DRD_(get_first_race_only)(void);
 void DRD_(set_first_race_only)(const Bool fro);
+UInt DRD_(get_sample_rate)(void);
+void DRD_(set_sample_rate)(const UInt percentage);
+ULong DRD_(get_sample_checked_count)(void);
+ULong DRD_(get_sample_skipped_count)(void);
+void DRD_(add_ignored_fn)(const HChar* const pattern);
+ULong DRD_(get_ignored_fn_insn_count)(void);
 IRSB* DRD_(instrument)(VgCallbackClosure* const closure,
                        IRSB* const bb_in,
                        VexGuestLayout* const layout,
@@ -73,6 +73,7 @@ static Bool DRD_(process_cmd_line_option)(const HChar* arg)
    int exclusive_threshold_ms = -1;
    int first_race_only        = -1;
    int report_signal_unlocked = -1;
+   int sample_rate            = -1;
    int segment_merging        = -1;
    int segment_merge_interval = -1;
    int shared_threshold_ms    = -1;
@@ -92,6 +93,7 @@ static Bool DRD_(process_cmd_line_option)(const HChar* arg)
    int trace_suppression      = -1;
    const HChar* trace_address = 0;
    const HChar* ptrace_address= 0;
+   const HChar* ignore_fn     = 0;
 
    if      VG_BOOL_CLO(arg, "--check-stack-var",     check_stack_accesses) {}
    else if VG_INT_CLO (arg, "--join-list-vol",       join_list_vol) {}
@@ -100,6 +102,7 @@ static Bool DRD_(process_cmd_line_option)(const HChar* arg)
    else if VG_BOOL_CLO(arg, "--free-is-write",       DRD_(g_free_is_write)) {}
    else if VG_BOOL_CLO(arg,"--report-signal-unlocked",report_signal_unlocked)
    {}
+   else if VG_BINT_CLO(arg, "--sample-rate",         sample_rate, 1, 100) {}
    else if VG_BOOL_CLO(arg, "--segment-merging",     segment_merging) {}
    else if VG_INT_CLO (arg, "--segment-merging-interval", segment_merge_interval)
    {}
@@ -124,6 +127,7 @@ static Bool DRD_(process_cmd_line_option)(const HChar* arg)
    else if VG_BOOL_CLO(arg, "--verify-conflict-set", DRD_(verify_conflict_set))
    {}
    else if VG_INT_CLO (arg, "--exclusive-threshold", exclusive_threshold_ms) {}
+   else if VG_STR_CLO (arg, "--ignore-fn",           ignore_fn) {}
    else if VG_STR_CLO (arg, "--ptrace-addr",         ptrace_address) {}
    else if VG_INT_CLO (arg, "--shared-threshold",    shared_threshold_ms)    {}
    else if VG_STR_CLO (arg, "--trace-addr",          trace_address) {}
@@ -141,12 +145,16 @@ static Bool DRD_(process_cmd_line_option)(const HChar* arg)
    {
       DRD_(set_first_race_only)(first_race_only);
    }
+   if (ignore_fn)
+      DRD_(add_ignored_fn)(ignore_fn);
    if (join_list_vol != -1)
       DRD_(thread_set_join_list_vol)(join_list_vol);
    if (report_signal_unlocked != -1)
    {
       DRD_(cond_set_report_signal_unlocked)(report_signal_unlocked);
    }
+   if (sample_rate != -1)
+      DRD_(set_sample_rate)(sample_rate);
    if (shared_threshold_ms != -1)
    {
       DRD_(rwlock_set_shared_threshold)(shared_threshold_ms);
@@ -212,11 +220,16 @@ static void DRD_(print_usage)(void)
 "                              a memory location instead of all races [no].\n"
 "    --free-is-write=yes|no    Whether to report races between freeing memory\n"
 "                              and subsequent accesses of that memory[no].\n"
+"    --ignore-fn=<pattern>     Do not check the memory accesses of functions\n"
+"                              whose name matches <pattern>. May be specified\n"
+"                              more than once [none].\n"
 "    --join-list-vol=<n>       Number of threads to delay cleanup for [10].\n"
 "    --report-signal-unlocked=yes|no Whether to report calls to\n"
 "                              pthread_cond_signal() where the mutex associated\n"
 "                              with the signal via pthread_cond_wait() is not\n"
 "                              locked at the time the signal is sent [yes].\n"
+"    --sample-rate=<n>         Percentage of memory accesses in frequently\n"
+"                              executed code that is checked for races [100].\n"
 "    --segment-merging=yes|no  Controls segment merging [yes].\n"
 "        Segment merging is an algorithm to limit memory usage of the\n"
 "        data race detection algorithm. Disabling segment merging may\n"
@@ -773,8 +786,10 @@ static void DRD_(fini)(Int exitcode)
                    "   thread: %lld context switches.\n",
                    DRD_(thread_get_context_switch_count)());
       VG_(message)(Vg_UserMsg,
-                   "confl set: %lld full updates and %lld partial updates;\n",
+                   "confl set: %lld full updates (%lld avoided) and %lld partial"
+                   " updates;\n",
                    DRD_(thread_get_compute_conflict_set_count)(),
+                   DRD_(thread_get_deferred_conflict_set_count)(),
                    pu);
       VG_(message)(Vg_UserMsg,
                    "           %lld partial updates during segment creation,\n",
@@ -812,6 +827,16 @@ static void DRD_(fini)(Int exitcode)
       VG_(message)(Vg_UserMsg,
                    "    mutex: %lld non-recursive lock/unlock events.\n",
                    DRD_(get_mutex_lock_count)());
+      if (DRD_(get_ignored_fn_insn_count)() > 0)
+         VG_(message)(Vg_UserMsg,
+                      "ignore-fn: %lld instructions not instrumented.\n",
+                      DRD_(get_ignored_fn_insn_count)());
+      if (DRD_(get_sample_rate)() < 100)
+         VG_(message)(Vg_UserMsg,
+                      " sampling: %lld superblock runs checked and %lld"
+                      " skipped.\n",
+                      DRD_(get_sample_checked_count)(),
+                      DRD_(get_sample_skipped_count)());
       DRD_(print_malloc_stats)();
    }
 
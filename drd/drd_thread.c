@@ -57,6 +57,7 @@ static Bool thread_conflict_set_up_to_date(const DrdThreadId tid);
 static ULong    s_context_switch_count;
 static ULong    s_discard_ordered_segments_count;
 static ULong    s_compute_conflict_set_count;
+static ULong    s_deferred_conflict_set_count;
 static ULong    s_update_conflict_set_count;
 static ULong    s_update_conflict_set_new_sg_count;
 static ULong    s_update_conflict_set_sync_count;
@@ -65,8 +66,9 @@ static ULong    s_conflict_set_bitmap_creation_count;
 static ULong    s_conflict_set_bitmap2_creation_count;
 static ThreadId s_vg_running_tid  = VG_INVALID_THREADID;
 DrdThreadId     DRD_(g_drd_running_tid) = DRD_INVALID_THREADID;
-ThreadInfo      DRD_(g_threadinfo)[DRD_N_THREADS];
+ThreadInfo*     DRD_(g_threadinfo);
 struct bitmap*  DRD_(g_conflict_set);
+Bool            DRD_(g_conflict_set_is_stale);
 Bool DRD_(verify_conflict_set);
 static Bool     s_trace_context_switches = False;
 static Bool     s_trace_conflict_set = False;
@@ -142,6 +144,8 @@ void DRD_(thread_set_join_list_vol)(const int jlv)
 
 void DRD_(thread_init)(void)
 {
+   DRD_(g_threadinfo) = VG_(calloc)("drd.main.ti.1", DRD_N_THREADS,
+                                    sizeof(DRD_(g_threadinfo)[0]));
 }
 
 /**
@@ -152,7 +156,7 @@ void DRD_(thread_init)(void)
  */
 DrdThreadId DRD_(VgThreadIdToDrdThreadId)(const ThreadId tid)
 {
-   int i;
+   unsigned i;
 
    if (tid == VG_INVALID_THREADID)
       return DRD_INVALID_THREADID;
@@ -172,7 +176,7 @@ DrdThreadId DRD_(VgThreadIdToDrdThreadId)(const ThreadId tid)
 /** Allocate a new DRD thread ID for the specified Valgrind thread ID. */
 static DrdThreadId DRD_(VgThreadIdToNewDrdThreadId)(const ThreadId tid)
 {
-   int i;
+   unsigned i;
 
    tl_assert(DRD_(VgThreadIdToDrdThreadId)(tid) == DRD_INVALID_THREADID);
 
@@ -218,7 +222,7 @@ static DrdThreadId DRD_(VgThreadIdToNewDrdThreadId)(const ThreadId tid)
 /** Convert a POSIX thread ID into a DRD thread ID. */
 DrdThreadId DRD_(PtThreadIdToDrdThreadId)(const PThreadId tid)
 {
-   int i;
+   unsigned i;
 
    if (tid != INVALID_POSIX_THREADID)
    {
@@ -336,7 +340,7 @@ DrdThreadId DRD_(thread_post_create)(const ThreadId vg_created)
 
 static void DRD_(thread_delayed_delete)(const DrdThreadId tid)
 {
-   int j;
+   unsigned j;
 
    DRD_(g_threadinfo)[tid].vg_thread_exists = False;
    DRD_(g_threadinfo)[tid].posix_thread_exists = False;
@@ -476,7 +480,8 @@ void DRD_(thread_set_on_alt_stack)(const DrdThreadId tid,
 
 Int DRD_(thread_get_threads_on_alt_stack)(void)
 {
-   int i, n = 0;
+   unsigned i;
+   int n = 0;
 
    for (i = 1; i < DRD_N_THREADS; i++)
       n += DRD_(g_threadinfo)[i].on_alt_stack;
@@ -557,8 +562,7 @@ void DRD_(drd_thread_atfork_child)(const DrdThreadId tid)
       tl_assert(!DRD_(IsValidDrdThreadId(i)));
    }
 
-   DRD_(bm_cleanup)(DRD_(g_conflict_set));
-   DRD_(bm_init)(DRD_(g_conflict_set));
+   DRD_(g_conflict_set_is_stale) = True;
 }
 
 /** Called just before pthread_cancel(). */
@@ -685,8 +689,10 @@ void DRD_(thread_set_vg_running_tid)(const ThreadId vg_tid)
 }
 
 /**
- * Update s_vg_running_tid, DRD_(g_drd_running_tid) and recalculate the
- * conflict set.
+ * Update s_vg_running_tid, DRD_(g_drd_running_tid) and mark the conflict set
+ * as stale. The conflict set is only recalculated once it is used, such that
+ * no time is spent on it for threads that get descheduled again before they
+ * access any memory, e.g. because they are waiting in a system call.
  */
 void DRD_(thread_set_running_tid)(const ThreadId vg_tid,
                                   const DrdThreadId drd_tid)
@@ -707,7 +713,9 @@ void DRD_(thread_set_running_tid)(const ThreadId vg_tid,
       }
       s_vg_running_tid = vg_tid;
       DRD_(g_drd_running_tid) = drd_tid;
-      thread_compute_conflict_set(&DRD_(g_conflict_set), drd_tid);
+      if (DRD_(g_conflict_set_is_stale))
+         s_deferred_conflict_set_count++;
+      DRD_(g_conflict_set_is_stale) = True;
       s_context_switch_count++;
    }
 
@@ -715,6 +723,18 @@ void DRD_(thread_set_running_tid)(const ThreadId vg_tid,
    tl_assert(DRD_(g_drd_running_tid) != DRD_INVALID_THREADID);
 }
 
+/**
+ * Compute the conflict set for the currently running thread after a context
+ * switch. Called via DRD_(thread_get_conflict_set)().
+ */
+void DRD_(thread_compute_stale_conflict_set)(void)
+{
+   tl_assert(DRD_(g_conflict_set_is_stale));
+
+   thread_compute_conflict_set(&DRD_(g_conflict_set), DRD_(g_drd_running_tid));
+   DRD_(g_conflict_set_is_stale) = False;
+}
+
 /**
  * Increase the synchronization nesting counter. Must be called before the
  * client calls a synchronization function.
@@ -1023,18 +1043,26 @@ static void thread_merge_segments(void)
       tl_assert(DRD_(sane_ThreadInfo)(&DRD_(g_threadinfo)[i]));
 #endif
 
-      for (sg = DRD_(g_threadinfo)[i].sg_first; sg; sg = sg->thr_next) {
+      for (sg = DRD_(g_threadinfo)[i].sg_first; sg; ) {
          if (DRD_(sg_get_refcnt)(sg) == 1 && sg->thr_next) {
             Segment* const sg_next = sg->thr_next;
             if (DRD_(sg_get_refcnt)(sg_next) == 1
                 && sg_next->thr_next
                 && thread_consistent_segment_ordering(i, sg, sg_next))
             {
-               /* Merge sg and sg_next into sg. */
+               /*
+                * Merge sg and sg_next into sg. Since equiv() is an
+                * equivalence relation, the merged segment may be merged
+                * with its new successor too, so try that before moving on.
+                * This folds a whole run of equivalent segments in a single
+                * pass instead of one pair per pass.
+                */
                DRD_(sg_merge)(sg, sg_next);
                thread_discard_segment(i, sg_next);
+               continue;
             }
          }
+         sg = sg->thr_next;
       }
 
 #ifdef ENABLE_DRD_CONSISTENCY_CHECKS
@@ -1059,7 +1087,8 @@ void DRD_(thread_new_segment)(const DrdThreadId tid)
    last_sg = DRD_(g_threadinfo)[tid].sg_last;
    new_sg = DRD_(sg_new)(tid, tid);
    thread_append_segment(tid, new_sg);
-   if (tid == DRD_(g_drd_running_tid) && last_sg)
+   if (tid == DRD_(g_drd_running_tid) && last_sg
+       && !DRD_(g_conflict_set_is_stale))
    {
       DRD_(thread_update_conflict_set)(tid, &last_sg->vc);
       s_update_conflict_set_new_sg_count++;
@@ -1098,7 +1127,7 @@ void DRD_(thread_combine_vc_join)(DrdThreadId joiner, DrdThreadId joinee)
       VG_(free)(str1);
       VG_(free)(str2);
    }
-   if (joiner == DRD_(g_drd_running_tid)) {
+   if (joiner == DRD_(g_drd_running_tid) && !DRD_(g_conflict_set_is_stale)) {
       VectorClock old_vc;
 
       DRD_(vc_copy)(&old_vc, DRD_(thread_get_vc)(joiner));
@@ -1154,8 +1183,10 @@ static void thread_combine_vc_sync(DrdThreadId tid, const Segment* sg)
 
       thread_discard_ordered_segments();
 
-      DRD_(thread_update_conflict_set)(tid, &old_vc);
-      s_update_conflict_set_sync_count++;
+      if (!DRD_(g_conflict_set_is_stale)) {
+         DRD_(thread_update_conflict_set)(tid, &old_vc);
+         s_update_conflict_set_sync_count++;
+      }
 
       DRD_(vc_cleanup)(&old_vc);
    } else {
@@ -1200,7 +1231,8 @@ void DRD_(thread_stop_using_mem)(const Addr a1, const Addr a2)
    for (p = DRD_(g_sg_list); p; p = p->g_next)
       DRD_(bm_clear)(DRD_(sg_bm)(p), a1, a2);
 
-   DRD_(bm_clear)(DRD_(g_conflict_set), a1, a2);
+   if (!DRD_(g_conflict_set_is_stale))
+      DRD_(bm_clear)(DRD_(g_conflict_set), a1, a2);
 }
 
 /** Specify whether memory loads should be recorded. */
@@ -1353,7 +1385,7 @@ static Bool thread_conflict_set_up_to_date(const DrdThreadId tid)
    Bool result;
    struct bitmap* computed_conflict_set = 0;
 
-   if (!DRD_(verify_conflict_set))
+   if (!DRD_(verify_conflict_set) || DRD_(g_conflict_set_is_stale))
       return True;
 
    thread_compute_conflict_set(&computed_conflict_set, tid);
@@ -1482,6 +1514,11 @@ void DRD_(thread_update_conflict_set)(const DrdThreadId tid,
              && tid != DRD_INVALID_THREADID);
    tl_assert(old_vc);
    tl_assert(tid == DRD_(g_drd_running_tid));
+
+   /* Nothing to do if the conflict set will be recomputed anyway. */
+   if (DRD_(g_conflict_set_is_stale))
+      return;
+
    tl_assert(DRD_(g_conflict_set));
 
    if (s_trace_conflict_set) {
@@ -1599,6 +1636,16 @@ ULong DRD_(thread_get_compute_conflict_set_count)()
    return s_compute_conflict_set_count;
 }
 
+/**
+ * Return how many times a context switch did not require a full conflict set
+ * update because the thread did not use its conflict set before the next
+ * context switch.
+ */
+ULong DRD_(thread_get_deferred_conflict_set_count)(void)
+{
+   return s_deferred_conflict_set_count;
+}
+
 /** Return how many times the conflict set has been updated partially. */
 ULong DRD_(thread_get_update_conflict_set_count)(void)
 {
@@ -113,9 +113,15 @@ typedef struct
  */
 extern DrdThreadId    DRD_(g_drd_running_tid);
 /** Per-thread information managed by DRD. */
-extern ThreadInfo     DRD_(g_threadinfo)[DRD_N_THREADS];
+extern ThreadInfo*    DRD_(g_threadinfo);
 /** Conflict set for the currently running thread. */
 extern struct bitmap* DRD_(g_conflict_set);
+/**
+ * Whether DRD_(g_conflict_set) still has to be computed for the currently
+ * running thread, which is deferred from the context switch until the
+ * conflict set is used for the first time.
+ */
+extern Bool           DRD_(g_conflict_set_is_stale);
 extern Bool           DRD_(verify_conflict_set);
 
 
@@ -164,6 +170,7 @@ void DRD_(thread_set_name)(const DrdThreadId tid, const HChar* const name);
 void DRD_(thread_set_vg_running_tid)(const ThreadId vg_tid);
 void DRD_(thread_set_running_tid)(const ThreadId vg_tid,
                                   const DrdThreadId drd_tid);
+void DRD_(thread_compute_stale_conflict_set)(void);
 int DRD_(thread_enter_synchr)(const DrdThreadId tid);
 int DRD_(thread_leave_synchr)(const DrdThreadId tid);
 int DRD_(thread_get_synchr_nesting_count)(const DrdThreadId tid);
@@ -193,6 +200,7 @@ ULong DRD_(thread_get_context_switch_count)(void);
 ULong DRD_(thread_get_report_races_count)(void);
 ULong DRD_(thread_get_discard_ordered_segments_count)(void);
 ULong DRD_(thread_get_compute_conflict_set_count)(void);
+ULong DRD_(thread_get_deferred_conflict_set_count)(void);
 ULong DRD_(thread_get_update_conflict_set_count)(void);
 ULong DRD_(thread_get_update_conflict_set_new_sg_count)(void);
 ULong DRD_(thread_get_update_conflict_set_sync_count)(void);
@@ -233,6 +241,8 @@ DrdThreadId DRD_(thread_get_running_tid)(void)
 static __inline__
 struct bitmap* DRD_(thread_get_conflict_set)(void)
 {
+   if (UNLIKELY(DRD_(g_conflict_set_is_stale)))
+      DRD_(thread_compute_stale_conflict_set)();
    return DRD_(g_conflict_set);
 }
 
@@ -323,7 +333,7 @@ Bool DRD_(thread_address_on_stack)(const Addr a)
 static __inline__
 Bool DRD_(thread_address_on_any_stack)(const Addr a)
 {
-   int i;
+   unsigned i;
 
    for (i = 1; i < DRD_N_THREADS; i++)
    {
@@ -43,9 +43,12 @@
 #include "pub_tool_mallocfree.h" /* plain_free */
 #include "pub_tool_machine.h"    /* VG_(fnptr_to_fnentry) */
 #include "pub_tool_debuginfo.h"  /* VG_(get_fnname) */
+#include "pub_tool_aspacemgr.h" /* VG_(am_is_valid_for_client) */
 
 #include "pub_tool_oset.h"       /* ordered set stuff */
 
+#include "bbv.h"                 /* client requests */
+
    /* instruction special cases */
 #define REP_INSTRUCTION   0x1
 #define FLDCW_INSTRUCTION 0x2
@@ -59,34 +62,56 @@ static const HChar *clo_bb_out_file="bb.out.%p";
 static const HChar *clo_pc_out_file="pc.out.%p";
 static HChar *pc_out_file=NULL;
 static HChar *bb_out_file=NULL;
+static const HChar *clo_ckpt_out_file="ckpt.out.%p";
+static HChar *ckpt_out_file=NULL;
+static const HChar *clo_checkpoints=NULL;
+static const HChar *clo_checkpoints_file=NULL;
 
 
    /* output parameters */
 static Bool instr_count_only=False;
 static Bool generate_pc_file=False;
+static Bool clo_bb_out_gzip=False;
+
+   /* region of interest: are we counting instructions at the moment? */
+static Bool clo_count_atstart=True;
+static Bool counting=True;
 
    /* write buffer */
 static HChar buf[1024];
 
+   /* An output file, written in large chunks, and optionally gzipped */
+typedef struct out_file OutFile;
+
    /* Global values */
 static OSet* instr_info_table;  /* table that holds the basic block info */
 static Int block_num=1;         /* global next block number */
 static Int current_thread=0;
 static Int allocated_threads=1;
 struct thread_info *bbv_thread=NULL;
+   /* &bbv_thread[current_thread], for the inline counting code */
+static struct thread_info *cur_thread_info=NULL;
 
    /* Per-thread variables */
+   /* dyn_instr and rep_count are word-sized so the inline counting */
+   /*   code can use them directly on 32-bit platforms too.          */
 struct thread_info {
-   ULong dyn_instr;         /* Current retired instruction count */
-   ULong total_instr;       /* Total retired instruction count   */
+   UWord dyn_instr;         /* Instruction count in this interval */
+   ULong n_intervals;       /* Intervals completed                */
    Addr last_rep_addr;      /* rep counting values */
-   ULong rep_count;
+   UWord rep_count;
    ULong global_rep_count;
    ULong unique_rep_count;
    ULong fldcw_count;       /* fldcw count */
-   Int bbtrace_fd;          /* file descriptor */
+   OutFile *bbtrace;        /* output file */
 };
 
+   /* Total retired instruction count */
+static ULong total_instr(struct thread_info *t)
+{
+   return t->n_intervals * (ULong)interval_size + t->dyn_instr;
+}
+
 #define FUNCTION_NAME_LENGTH 20
 
 struct BB_info {
@@ -99,6 +124,232 @@ struct BB_info {
 };
 
 
+/*--------------------------------------------------------------------*/
+/*--- Output files                                                 ---*/
+/*--------------------------------------------------------------------*/
+
+   /* The bb files are written through a buffer, rather than with a   */
+   /*   write() for each entry.  With --bb-out-gzip=yes they are       */
+   /*   written in gzip format, which SimPoint can read directly, by   */
+   /*   a small deflate compressor: greedy LZ77 matching within each   */
+   /*   chunk of input, coded with the fixed Huffman codes.  The       */
+   /*   vectors are text with a lot of repetition, so this is enough   */
+   /*   to make them several times smaller.                            */
+
+#define OUT_CHUNK     32768      /* input compressed at a time */
+#define OUT_BUF_SIZE  65536
+#define HASH_BITS     12
+#define MIN_MATCH     3
+#define MAX_MATCH     258
+
+struct out_file {
+   Int    fd;
+   Bool   gzip;
+   UChar  in[OUT_CHUNK];
+   Int    in_used;
+   UChar  out[OUT_BUF_SIZE];
+   Int    out_used;
+   ULong  bits;                  /* pending output bits, LSB first */
+   Int    n_bits;
+   UInt   crc;
+   UInt   size;
+   Int    hash[1 << HASH_BITS];
+};
+
+static UInt crc_table[256];
+
+static void make_crc_table(void)
+{
+   UInt n, c;
+   Int  k;
+
+   for (n = 0; n < 256; n++) {
+      c = n;
+      for (k = 0; k < 8; k++)
+         c = (c & 1) ? 0xedb88320U ^ (c >> 1) : c >> 1;
+      crc_table[n] = c;
+   }
+}
+
+static void flush_out(OutFile *o)
+{
+   if (o->out_used > 0) {
+      VG_(write)(o->fd, o->out, o->out_used);
+      o->out_used = 0;
+   }
+}
+
+static void put_byte(OutFile *o, UChar b)
+{
+   if (o->out_used == OUT_BUF_SIZE)
+      flush_out(o);
+   o->out[o->out_used++] = b;
+}
+
+static void put_bits(OutFile *o, UInt bits, Int n)
+{
+   o->bits |= (ULong)bits << o->n_bits;
+   o->n_bits += n;
+   while (o->n_bits >= 8) {
+      put_byte(o, o->bits & 0xff);
+      o->bits >>= 8;
+      o->n_bits -= 8;
+   }
+}
+
+   /* Huffman codes go out most significant bit first */
+static void put_code(OutFile *o, UInt code, Int n)
+{
+   UInt rev = 0;
+   Int  i;
+
+   for (i = 0; i < n; i++)
+      rev |= ((code >> i) & 1) << (n - 1 - i);
+   put_bits(o, rev, n);
+}
+
+   /* A literal/length symbol, in the fixed Huffman code */
+static void put_litlen(OutFile *o, UInt sym)
+{
+   if (sym < 144)
+      put_code(o, 0x30 + sym, 8);
+   else if (sym < 256)
+      put_code(o, 0x190 + sym - 144, 9);
+   else if (sym < 280)
+      put_code(o, sym - 256, 7);
+   else
+      put_code(o, 0xc0 + sym - 280, 8);
+}
+
+static void put_match(OutFile *o, UInt len, UInt dist)
+{
+   static const UShort len_base[29] = {
+      3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+      35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+   static const UChar len_extra[29] = {
+      0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+      3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+   static const UShort dist_base[30] = {
+      1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+      257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+      8193, 12289, 16385, 24577 };
+   static const UChar dist_extra[30] = {
+      0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+      7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+   Int l = 28, d = 29;
+
+   while (len_base[l] > len)
+      l--;
+   while (dist_base[d] > dist)
+      d--;
+   put_litlen(o, 257 + l);
+   put_bits(o, len - len_base[l], len_extra[l]);
+   put_code(o, d, 5);
+   put_bits(o, dist - dist_base[d], dist_extra[d]);
+}
+
+   /* Compress the input we have as one deflate block */
+static void deflate_chunk(OutFile *o, Bool last)
+{
+   const UChar *in = o->in;
+   Int n = o->in_used;
+   Int i = 0;
+
+   put_bits(o, last ? 1 : 0, 1);      /* BFINAL */
+   put_bits(o, 1, 2);                 /* BTYPE: fixed Huffman codes */
+   VG_(memset)(o->hash, 0xff, sizeof(o->hash));
+   while (i < n) {
+      Int len = 0, cand = -1;
+      if (i + MIN_MATCH <= n) {
+         UInt h = ((in[i] << 16) | (in[i+1] << 8) | in[i+2]) * 2654435761U
+                  >> (32 - HASH_BITS);
+         cand = o->hash[h];
+         o->hash[h] = i;
+      }
+      if (cand >= 0) {
+         while (i + len < n && len < MAX_MATCH && in[cand+len] == in[i+len])
+            len++;
+      }
+      if (len >= MIN_MATCH) {
+         put_match(o, len, i - cand);
+         i += len;
+      } else {
+         put_litlen(o, in[i]);
+         i++;
+      }
+   }
+   put_litlen(o, 256);                /* end of block */
+   o->in_used = 0;
+}
+
+static void write_out(OutFile *o, const HChar *s, Int len)
+{
+   Int i;
+
+   if (!o->gzip) {
+      for (i = 0; i < len; i++)
+         put_byte(o, s[i]);
+      return;
+   }
+   for (i = 0; i < len; i++) {
+      UChar c = s[i];
+      o->crc = crc_table[(o->crc ^ c) & 0xff] ^ (o->crc >> 8);
+      if (o->in_used == OUT_CHUNK)
+         deflate_chunk(o, False);
+      o->in[o->in_used++] = c;
+   }
+   o->size += len;
+}
+
+static void write_out_str(OutFile *o, const HChar *s)
+{
+   write_out(o, s, VG_(strlen)(s));
+}
+
+static OutFile *new_out_file(Int fd, Bool gzip)
+{
+   static const UChar gzip_header[10] =
+      { 0x1f, 0x8b, 8, 0, 0, 0, 0, 0, 0, 3 };
+   OutFile *o = VG_(malloc)("bbv.out_file", sizeof(OutFile));
+   Int i;
+
+   o->fd       = fd;
+   o->gzip     = gzip;
+   o->in_used  = 0;
+   o->out_used = 0;
+   o->bits     = 0;
+   o->n_bits   = 0;
+   o->crc      = 0xffffffffU;
+   o->size     = 0;
+   if (gzip) {
+      if (crc_table[1] == 0)
+         make_crc_table();
+      for (i = 0; i < 10; i++)
+         put_byte(o, gzip_header[i]);
+   }
+   return o;
+}
+
+static void close_out_file(OutFile *o)
+{
+   Int i;
+
+   if (o->gzip) {
+      deflate_chunk(o, True);
+      put_bits(o, 0, 7);              /* to a byte boundary */
+      o->n_bits = 0;
+      o->crc ^= 0xffffffffU;
+      for (i = 0; i < 4; i++)
+         put_byte(o, (o->crc >> (8 * i)) & 0xff);
+      for (i = 0; i < 4; i++)
+         put_byte(o, (o->size >> (8 * i)) & 0xff);
+   }
+   flush_out(o);
+   VG_(close)(o->fd);
+   VG_(free)(o);
+}
+
+
    /* dump the optional PC file, which contains basic block number to */
    /*   instruction address and function name mappings                */
 static void dumpPcFile(void)
@@ -134,7 +385,7 @@ static void dumpPcFile(void)
    VG_(close)(pctrace_fd);
 }
 
-static Int open_tracefile(Int thread_num)
+static OutFile *open_tracefile(Int thread_num)
 {
    SysRes  sres;
    HChar temp_string[2048];
@@ -157,45 +408,330 @@ static Int open_tracefile(Int thread_num)
       VG_(exit)(1);
    }
 
-   return sr_Res(sres);
+   return new_out_file(sr_Res(sres), clo_bb_out_gzip);
 }
 
-static void handle_overflow(void)
+/*--------------------------------------------------------------------*/
+/*--- Checkpoints                                                  ---*/
+/*--------------------------------------------------------------------*/
+
+   /* With --checkpoints, a checkpoint of the main thread is written  */
+   /*   at the start of each of the given intervals, for starting a    */
+   /*   simulation there without running the program up to it: the    */
+   /*   registers, and the contents of every page touched during the   */
+   /*   interval, as it was when first touched.                        */
+   /*                                                                  */
+   /*   The inline counting code only counts runs of instructions, so  */
+   /*   when the main thread gets within CKPT_MARGIN instructions of    */
+   /*   the interval everything is retranslated to count instruction   */
+   /*   by instruction (the "precise" code), which also checks before  */
+   /*   each instruction, with the guest registers up to date, whether */
+   /*   the interval has started.  Once the checkpoint is taken,       */
+   /*   everything is retranslated again, to record the pages touched, */
+   /*   until the interval ends.                                       */
+   /*                                                                  */
+   /*   The checkpoint for interval N goes in <checkpoint-out-file>.N, */
+   /*   in the host's byte order:                                      */
+   /*     CKPT_MAGIC, then the guest architecture's name padded with   */
+   /*       NULs to 16 bytes                                           */
+   /*     ULongs: the interval, the instructions run before it, the PC */
+   /*     UInts: the size of the registers, the size of a page         */
+   /*     the registers, as Valgrind's guest state structure for the   */
+   /*       architecture (see VEX/pub/libvex_guest_*.h)                */
+   /*     for each page: a ULong address, then the page's contents     */
+
+#define CKPT_MAGIC   "BBVCKPT1"
+#define CKPT_MARGIN  10000
+#define CKPT_THREAD  1           /* only the main thread's are taken */
+
+#if defined(VGA_x86)
+#  define CKPT_ARCH "x86"
+#elif defined(VGA_amd64)
+#  define CKPT_ARCH "amd64"
+#elif defined(VGA_ppc32)
+#  define CKPT_ARCH "ppc32"
+#elif defined(VGA_ppc64)
+#  define CKPT_ARCH "ppc64"
+#elif defined(VGA_arm)
+#  define CKPT_ARCH "arm"
+#elif defined(VGA_arm64)
+#  define CKPT_ARCH "arm64"
+#elif defined(VGA_s390x)
+#  define CKPT_ARCH "s390x"
+#elif defined(VGA_mips32)
+#  define CKPT_ARCH "mips32"
+#elif defined(VGA_mips64)
+#  define CKPT_ARCH "mips64"
+#else
+#  error "Unknown architecture"
+#endif
+
+static ULong  *ckpt_intervals=NULL;  /* sorted, without duplicates */
+static Int    n_ckpts=0;
+static Int    next_ckpt=0;           /* the next one to take       */
+static Int    ckpts_taken=0;
+
+static Bool   ckpt_near=False;       /* nearly at the next one     */
+static Bool   ckpt_armed=False;      /* take it at next instruction */
+static OutFile *ckpt_file=NULL;      /* the one being recorded     */
+static OSet   *ckpt_pages=NULL;      /* pages recorded in it       */
+static Addr   ckpt_last_page=1;
+   /* ckpt_armed or recording, for the guard in the precise code */
+static UWord  ckpt_pending=0;
+
+   /* How code is being instrumented at the moment */
+static Bool   instr_precise=False;   /* count instruction by instruction */
+static Bool   instr_touch=False;     /* record the pages touched         */
+static UWord  overflow_at;           /* when to call interval_overflow() */
+
+   /* From the guest layout */
+static Int    guest_state_size=0;
+static Int    guest_offset_IP=0;
+
+   /* Not exported to tools: declared here as callgrind does */
+extern void VG_(discard_translations) ( Addr64 start, ULong range,
+                                        const HChar* who );
+
+static void discard_all_translations(void)
 {
-   struct BB_info *bb_elem;
+   VG_(discard_translations)( (Addr64)0x1000, (ULong) ~0xfffl, "exp-bbv");
+}
 
-   if (bbv_thread[current_thread].dyn_instr > interval_size) {
+   /* Work out how to instrument, now that the main thread is in */
+   /*   the given interval, and retranslate if that has changed   */
+static void ckpt_update_mode(ULong interval, Bool discard)
+{
+   Bool  precise = ckpt_near || ckpt_armed;
+   Bool  touch;
+   UWord limit = interval_size;
 
-      if (!instr_count_only) {
+   if (next_ckpt < n_ckpts && ckpt_intervals[next_ckpt] == interval + 1) {
+      if (interval_size <= CKPT_MARGIN) {
+         precise = True;
+      } else {
+         limit = interval_size - CKPT_MARGIN;
+      }
+   }
+      /* the inline code isn't used while counting precisely */
+   if (precise) {
+      limit = overflow_at;
+   }
+   touch = precise || ckpt_file != NULL;
+   ckpt_pending = ckpt_armed || ckpt_file != NULL;
 
-            /* If our output fd hasn't been opened, open it */
-         if (bbv_thread[current_thread].bbtrace_fd < 0) {
-            bbv_thread[current_thread].bbtrace_fd=open_tracefile(current_thread);
-         }
+   if (precise == instr_precise && touch == instr_touch &&
+       limit == overflow_at) {
+      return;
+   }
+   instr_precise = precise;
+   instr_touch = touch;
+   overflow_at = limit;
+   if (discard) {
+      discard_all_translations();
+   }
+}
 
-           /* put an entry to the bb.out file */
+static void touch_page(Addr page)
+{
+   ULong addr = page;
 
-         VG_(write)(bbv_thread[current_thread].bbtrace_fd,"T",1);
+   if (page == ckpt_last_page) {
+      return;
+   }
+   ckpt_last_page = page;
+   if (VG_(OSetWord_Contains)(ckpt_pages, page)) {
+      return;
+   }
+   VG_(OSetWord_Insert)(ckpt_pages, page);
+
+      /* If it can't be read, the access is going to fault anyway */
+   if (VG_(am_is_valid_for_client)(page, VKI_PAGE_SIZE, VKI_PROT_READ)) {
+      write_out(ckpt_file, (HChar *)&addr, sizeof(addr));
+      write_out(ckpt_file, (HChar *)page, VKI_PAGE_SIZE);
+   }
+}
+
+   /* Record the pages holding [a, a+len), if not recorded already */
+static void touch_pages(Addr a, UWord len)
+{
+   Addr page = VG_PGROUNDDN(a);
+   Addr last = VG_PGROUNDDN(a + len - 1);
+
+   while (True) {
+      touch_page(page);
+      if (page == last) {
+         break;
+      }
+      page += VKI_PAGE_SIZE;
+   }
+}
+
+   /* Called before each memory access, when recording pages */
+static VG_REGPARM(2) void touch_mem(Addr a, UWord size)
+{
+   if (ckpt_file != NULL) {
+      touch_pages(a, size);
+   }
+}
+
+static void take_checkpoint(Addr pc)
+{
+   struct thread_info *t = &bbv_thread[CKPT_THREAD];
+   HChar  temp_string[2048];
+   HChar  arch[16];
+   ULong  hdr[3];
+   UInt   sizes[2];
+   UChar  *regs;
+   SysRes sres;
+
+   VG_(sprintf)(temp_string,"%s.%llu",ckpt_out_file,
+                ckpt_intervals[next_ckpt]);
+   sres = VG_(open)(temp_string, VKI_O_CREAT|VKI_O_TRUNC|VKI_O_WRONLY,
+                              VKI_S_IRUSR|VKI_S_IWUSR|VKI_S_IRGRP|VKI_S_IWGRP);
+   if (sr_isError(sres)) {
+      VG_(umsg)("Error: cannot create checkpoint file %s\n",temp_string);
+      VG_(exit)(1);
+   }
+   ckpt_file = new_out_file(sr_Res(sres), False);
+
+   VG_(memset)(arch, 0, sizeof(arch));
+   VG_(strcpy)(arch, CKPT_ARCH);
+   hdr[0] = ckpt_intervals[next_ckpt];
+   hdr[1] = total_instr(t);
+   hdr[2] = pc;
+   sizes[0] = guest_state_size;
+   sizes[1] = VKI_PAGE_SIZE;
+   write_out(ckpt_file, CKPT_MAGIC, 8);
+   write_out(ckpt_file, arch, sizeof(arch));
+   write_out(ckpt_file, (HChar *)hdr, sizeof(hdr));
+   write_out(ckpt_file, (HChar *)sizes, sizeof(sizes));
+
+      /* The precise code keeps everything but the PC up to date */
+   regs = VG_(malloc)("bbv.ckpt.regs", guest_state_size);
+   VG_(get_shadow_regs_area)(CKPT_THREAD, regs, 0, 0, guest_state_size);
+   VG_(memcpy)(regs + guest_offset_IP, &pc, sizeof(pc));
+   write_out(ckpt_file, (HChar *)regs, guest_state_size);
+   VG_(free)(regs);
+
+   ckpt_pages = VG_(OSetWord_Create)(VG_(malloc), "bbv.ckpt.pages",
+                                     VG_(free));
+   ckpt_last_page = 1;
+   ckpt_armed = False;
+   next_ckpt++;
+   ckpts_taken++;
+   ckpt_update_mode(t->n_intervals, True);
+}
+
+static void finish_checkpoint(void)
+{
+   close_out_file(ckpt_file);
+   ckpt_file = NULL;
+   VG_(OSetWord_Destroy)(ckpt_pages);
+   ckpt_pages = NULL;
+}
+
+   /* Called by the precise code before each instruction, when a     */
+   /*   checkpoint is about to be taken or its pages being recorded  */
+static VG_REGPARM(2) void checkpoint_instr(Addr pc, UWord len)
+{
+   if (ckpt_armed && current_thread == CKPT_THREAD) {
+      take_checkpoint(pc);
+   }
+   if (ckpt_file != NULL) {
+      touch_pages(pc, len);
+   }
+}
+
+   /* The main thread has started a new interval */
+static void ckpt_interval_done(ULong interval)
+{
+   if (ckpt_file != NULL) {
+      finish_checkpoint();
+   }
+   ckpt_near = False;
+   if (next_ckpt < n_ckpts && ckpt_intervals[next_ckpt] == interval) {
+      ckpt_armed = True;
+   }
+   ckpt_update_mode(interval, True);
+}
 
-         VG_(OSetGen_ResetIter)(instr_info_table);
-         while ( (bb_elem = VG_(OSetGen_Next)(instr_info_table)) ) {
-            if ( bb_elem->inst_counter[current_thread] != 0 ) {
-               VG_(sprintf)( buf,":%d:%d   ",
-                         bb_elem->block_num,
-                         bb_elem->inst_counter[current_thread]);
-               VG_(write)(bbv_thread[current_thread].bbtrace_fd,
-                          (void*)buf, VG_(strlen)(buf));
-               bb_elem->inst_counter[current_thread] = 0;
-            }
-         }
 
-         VG_(write)(bbv_thread[current_thread].bbtrace_fd,"\n",1);
+   /* Write out the vector for the interval just finished, and zero */
+   /*   the counts for the next one                                  */
+static void dump_interval(void)
+{
+   struct BB_info *bb_elem;
+   struct thread_info *t = &bbv_thread[current_thread];
+
+   if (!instr_count_only) {
+
+         /* If our output file hasn't been opened, open it */
+      if (t->bbtrace == NULL) {
+         t->bbtrace=open_tracefile(current_thread);
+      }
+
+        /* put an entry to the bb.out file */
+
+      write_out(t->bbtrace,"T",1);
+
+      VG_(OSetGen_ResetIter)(instr_info_table);
+      while ( (bb_elem = VG_(OSetGen_Next)(instr_info_table)) ) {
+         if ( bb_elem->inst_counter[current_thread] != 0 ) {
+            VG_(sprintf)( buf,":%d:%d   ",
+                      bb_elem->block_num,
+                      bb_elem->inst_counter[current_thread]);
+            write_out_str(t->bbtrace, buf);
+            bb_elem->inst_counter[current_thread] = 0;
+         }
       }
 
-      bbv_thread[current_thread].dyn_instr -= interval_size;
+      write_out(t->bbtrace,"\n",1);
+   }
+
+   t->dyn_instr -= interval_size;
+   t->n_intervals++;
+
+   if (n_ckpts > 0 && current_thread == CKPT_THREAD) {
+      ckpt_interval_done(t->n_intervals);
    }
 }
 
+static void handle_overflow(void)
+{
+   if (bbv_thread[current_thread].dyn_instr > (UWord)interval_size) {
+      dump_interval();
+   }
+}
+
+   /* Called by the inline counting code when the n_instrs instructions */
+   /*   it has just counted for bbInfo take us past the end of the       */
+   /*   interval.  The ones after the one that ended it belong to the    */
+   /*   next interval, so take them out of this one's vector first.      */
+static VG_REGPARM(2) void interval_overflow(struct BB_info *bbInfo,
+                                            UWord n_instrs)
+{
+   struct thread_info *t = &bbv_thread[current_thread];
+   UWord before = t->dyn_instr - n_instrs;
+   UWord upto, rest;
+
+      /* Nearly at a checkpoint: count precisely from now on */
+   if (overflow_at < (UWord)interval_size && current_thread == CKPT_THREAD &&
+       !ckpt_near) {
+      ckpt_near = True;
+      ckpt_update_mode(t->n_intervals, True);
+   }
+
+   while (t->dyn_instr > (UWord)interval_size) {
+         /* instructions up to and including the one that ended it */
+      upto = before <= (UWord)interval_size ? interval_size + 1 - before : 1;
+      rest = n_instrs - upto;
+      bbInfo->inst_counter[current_thread] -= rest;
+      dump_interval();
+      bbInfo->inst_counter[current_thread] = rest;
+      before = before + upto - interval_size;
+      n_instrs = rest;
+   }
+}
 
 static void close_out_reps(void)
 {
@@ -219,7 +755,6 @@ static VG_REGPARM(1) void per_instruction_BBV(struct BB_info *bbInfo)
 
    bbInfo->inst_counter[current_thread]+=n_instrs;
 
-   bbv_thread[current_thread].total_instr+=n_instrs;
    bbv_thread[current_thread].dyn_instr +=n_instrs;
 
    handle_overflow();
@@ -232,7 +767,6 @@ static VG_REGPARM(1) void per_instruction_BBV_rep(Addr addr)
    if (bbv_thread[current_thread].last_rep_addr!=addr) {
       if (bbv_thread[current_thread].rep_count) {
          close_out_reps();
-         bbv_thread[current_thread].total_instr++;
          bbv_thread[current_thread].dyn_instr++;
       }
       bbv_thread[current_thread].last_rep_addr=addr;
@@ -260,12 +794,22 @@ static VG_REGPARM(1) void per_instruction_BBV_fldcw(struct BB_info *bbInfo)
 
    bbInfo->inst_counter[current_thread]+=n_instrs;
 
-   bbv_thread[current_thread].total_instr+=n_instrs;
    bbv_thread[current_thread].dyn_instr +=n_instrs;
 
    handle_overflow();
 }
 
+   /* Called by the inline counting code, at the start of a superblock,  */
+   /*   when a rep instruction has just finished: it counts as one more */
+   /*   instruction, as per_instruction_BBV() does.  The counts are      */
+   /*   checked for the end of the interval with the block's own.        */
+static VG_REGPARM(1) void close_pending_reps(struct BB_info *bbInfo)
+{
+   close_out_reps();
+   bbInfo->inst_counter[current_thread]++;
+   bbv_thread[current_thread].dyn_instr++;
+}
+
    /* Check if the instruction pointed to is one that needs */
    /*   special handling.  If so, set a bit in the return   */
    /*   value indicating what type.                         */
@@ -338,6 +882,251 @@ static Int get_inst_type(Int len, Addr addr)
 }
 
 
+#if defined(VG_BIGENDIAN)
+# define BBVEndness Iend_BE
+#elif defined(VG_LITTLEENDIAN)
+# define BBVEndness Iend_LE
+#else
+# error "Unknown endianness"
+#endif
+
+   /* Emit IR to count n_instrs instructions for bbInfo: add them to   */
+   /*   the thread's count for the block and for the interval, and     */
+   /*   call interval_overflow() if that takes it past overflow_at:    */
+   /*   the end of the interval, or near it before a checkpoint.       */
+static void add_count(IRSB *sbOut, struct BB_info *bbInfo, Int n_instrs,
+                      IRType tyW)
+{
+   IROp    opAdd  = tyW == Ity_I64 ? Iop_Add64    : Iop_Add32;
+   IROp    opShl  = tyW == Ity_I64 ? Iop_Shl64    : Iop_Shl32;
+   IROp    opCmp  = tyW == Ity_I64 ? Iop_CmpLT64U : Iop_CmpLT32U;
+   IRTemp  ti     = newIRTemp(sbOut->tyenv, tyW);
+   IRTemp  dynA   = newIRTemp(sbOut->tyenv, tyW);
+   IRTemp  dyn0   = newIRTemp(sbOut->tyenv, tyW);
+   IRTemp  dyn1   = newIRTemp(sbOut->tyenv, tyW);
+   IRTemp  arr    = newIRTemp(sbOut->tyenv, tyW);
+   IRTemp  tid    = newIRTemp(sbOut->tyenv, Ity_I32);
+   IRTemp  tidW   = newIRTemp(sbOut->tyenv, tyW);
+   IRTemp  offs   = newIRTemp(sbOut->tyenv, tyW);
+   IRTemp  cntA   = newIRTemp(sbOut->tyenv, tyW);
+   IRTemp  cnt0   = newIRTemp(sbOut->tyenv, Ity_I32);
+   IRTemp  cnt1   = newIRTemp(sbOut->tyenv, Ity_I32);
+   IRTemp  over   = newIRTemp(sbOut->tyenv, Ity_I1);
+   IRDirty *di;
+
+      /* cur_thread_info->dyn_instr += n_instrs */
+   addStmtToIRSB(sbOut, IRStmt_WrTmp(ti,
+      IRExpr_Load(BBVEndness, tyW, mkIRExpr_HWord((HWord)&cur_thread_info))));
+   addStmtToIRSB(sbOut, IRStmt_WrTmp(dynA,
+      IRExpr_Binop(opAdd, IRExpr_RdTmp(ti),
+                   mkIRExpr_HWord(offsetof(struct thread_info, dyn_instr)))));
+   addStmtToIRSB(sbOut, IRStmt_WrTmp(dyn0,
+      IRExpr_Load(BBVEndness, tyW, IRExpr_RdTmp(dynA))));
+   addStmtToIRSB(sbOut, IRStmt_WrTmp(dyn1,
+      IRExpr_Binop(opAdd, IRExpr_RdTmp(dyn0), mkIRExpr_HWord(n_instrs))));
+   addStmtToIRSB(sbOut, IRStmt_Store(BBVEndness, IRExpr_RdTmp(dynA),
+                                     IRExpr_RdTmp(dyn1)));
+
+      /* bbInfo->inst_counter[current_thread] += n_instrs */
+   addStmtToIRSB(sbOut, IRStmt_WrTmp(arr,
+      IRExpr_Load(BBVEndness, tyW,
+                  mkIRExpr_HWord((HWord)&bbInfo->inst_counter))));
+   addStmtToIRSB(sbOut, IRStmt_WrTmp(tid,
+      IRExpr_Load(BBVEndness, Ity_I32,
+                  mkIRExpr_HWord((HWord)&current_thread))));
+   addStmtToIRSB(sbOut, IRStmt_WrTmp(tidW,
+      tyW == Ity_I64 ? IRExpr_Unop(Iop_32Uto64, IRExpr_RdTmp(tid))
+                     : IRExpr_RdTmp(tid)));
+   addStmtToIRSB(sbOut, IRStmt_WrTmp(offs,
+      IRExpr_Binop(opShl, IRExpr_RdTmp(tidW), IRExpr_Const(IRConst_U8(2)))));
+   addStmtToIRSB(sbOut, IRStmt_WrTmp(cntA,
+      IRExpr_Binop(opAdd, IRExpr_RdTmp(arr), IRExpr_RdTmp(offs))));
+   addStmtToIRSB(sbOut, IRStmt_WrTmp(cnt0,
+      IRExpr_Load(BBVEndness, Ity_I32, IRExpr_RdTmp(cntA))));
+   addStmtToIRSB(sbOut, IRStmt_WrTmp(cnt1,
+      IRExpr_Binop(Iop_Add32, IRExpr_RdTmp(cnt0),
+                   IRExpr_Const(IRConst_U32(n_instrs)))));
+   addStmtToIRSB(sbOut, IRStmt_Store(BBVEndness, IRExpr_RdTmp(cntA),
+                                     IRExpr_RdTmp(cnt1)));
+
+      /* if (overflow_at < dyn_instr) interval_overflow(...) */
+   addStmtToIRSB(sbOut, IRStmt_WrTmp(over,
+      IRExpr_Binop(opCmp, mkIRExpr_HWord(overflow_at),
+                   IRExpr_RdTmp(dyn1))));
+   di = unsafeIRDirty_0_N(2, "interval_overflow",
+                          VG_(fnptr_to_fnentry)(&interval_overflow),
+                          mkIRExprVec_2(mkIRExpr_HWord((HWord)bbInfo),
+                                        mkIRExpr_HWord(n_instrs)));
+   di->guard = IRExpr_RdTmp(over);
+   addStmtToIRSB(sbOut, IRStmt_Dirty(di));
+}
+
+static void add_touch_call(IRSB *sbOut, IRExpr *addr, Int size,
+                           IRExpr *guard)
+{
+   IRDirty *di;
+
+   di = unsafeIRDirty_0_N(2, "touch_mem",
+                          VG_(fnptr_to_fnentry)(&touch_mem),
+                          mkIRExprVec_2(addr, mkIRExpr_HWord(size)));
+   if (guard) {
+      di->guard = guard;
+   }
+   addStmtToIRSB(sbOut, IRStmt_Dirty(di));
+}
+
+   /* Emit a call to touch_mem() for each memory access of st, to */
+   /*   record the pages accessed for a checkpoint                */
+static void add_touch(IRSB *sbOut, IRStmt *st)
+{
+   IRType  type, typeWide;
+   Int     size;
+
+   switch (st->tag) {
+      case Ist_WrTmp:
+         if (st->Ist.WrTmp.data->tag == Iex_Load) {
+            add_touch_call(sbOut, st->Ist.WrTmp.data->Iex.Load.addr,
+                           sizeofIRType(st->Ist.WrTmp.data->Iex.Load.ty),
+                           NULL);
+         }
+         break;
+      case Ist_Store:
+         type = typeOfIRExpr(sbOut->tyenv, st->Ist.Store.data);
+         add_touch_call(sbOut, st->Ist.Store.addr, sizeofIRType(type), NULL);
+         break;
+      case Ist_StoreG:
+         type = typeOfIRExpr(sbOut->tyenv, st->Ist.StoreG.details->data);
+         add_touch_call(sbOut, st->Ist.StoreG.details->addr,
+                        sizeofIRType(type), st->Ist.StoreG.details->guard);
+         break;
+      case Ist_LoadG:
+         typeOfIRLoadGOp(st->Ist.LoadG.details->cvt, &typeWide, &type);
+         add_touch_call(sbOut, st->Ist.LoadG.details->addr,
+                        sizeofIRType(type), st->Ist.LoadG.details->guard);
+         break;
+      case Ist_Dirty:
+         if (st->Ist.Dirty.details->mFx != Ifx_None) {
+            add_touch_call(sbOut, st->Ist.Dirty.details->mAddr,
+                           st->Ist.Dirty.details->mSize, NULL);
+         }
+         break;
+      case Ist_CAS:
+         type = typeOfIRExpr(sbOut->tyenv, st->Ist.CAS.details->dataLo);
+         size = sizeofIRType(type);
+         if (st->Ist.CAS.details->dataHi != NULL) {
+            size *= 2;               /* a doubleword CAS */
+         }
+         add_touch_call(sbOut, st->Ist.CAS.details->addr, size, NULL);
+         break;
+      case Ist_LLSC:
+         if (st->Ist.LLSC.storedata == NULL) {
+            type = typeOfIRTemp(sbOut->tyenv, st->Ist.LLSC.result);
+         } else {
+            type = typeOfIRExpr(sbOut->tyenv, st->Ist.LLSC.storedata);
+         }
+         add_touch_call(sbOut, st->Ist.LLSC.addr, sizeofIRType(type), NULL);
+         break;
+      default:
+         break;
+   }
+}
+
+   /* Emit a call to checkpoint_instr() for the instruction at addr,    */
+   /*   when a checkpoint is pending.  It says it reads all the guest   */
+   /*   state, so that the registers are up to date when it is called. */
+static void add_checkpoint_call(IRSB *sbOut, Addr64 addr, Int len, IRType tyW)
+{
+   IRTemp  pend = newIRTemp(sbOut->tyenv, tyW);
+   IRTemp  guard = newIRTemp(sbOut->tyenv, Ity_I1);
+   IRDirty *di;
+
+   addStmtToIRSB(sbOut, IRStmt_WrTmp(pend,
+      IRExpr_Load(BBVEndness, tyW, mkIRExpr_HWord((HWord)&ckpt_pending))));
+   addStmtToIRSB(sbOut, IRStmt_WrTmp(guard,
+      IRExpr_Binop(tyW == Ity_I64 ? Iop_CmpNE64 : Iop_CmpNE32,
+                   IRExpr_RdTmp(pend), mkIRExpr_HWord(0))));
+   di = unsafeIRDirty_0_N(2, "checkpoint_instr",
+                          VG_(fnptr_to_fnentry)(&checkpoint_instr),
+                          mkIRExprVec_2(mkIRExpr_HWord((HWord)addr),
+                                        mkIRExpr_HWord(len)));
+   di->guard = IRExpr_RdTmp(guard);
+   di->nFxState = 1;
+   di->fxState[0].fx        = Ifx_Read;
+   di->fxState[0].offset    = 0;
+   di->fxState[0].size      = guest_state_size;
+   di->fxState[0].nRepeats  = 0;
+   di->fxState[0].repeatLen = 0;
+   addStmtToIRSB(sbOut, IRStmt_Dirty(di));
+}
+
+   /* Instrument a block with no instructions that need special       */
+   /*   handling, starting at statement i, its first IMark.  Rather    */
+   /*   than calling a helper for each instruction, count them inline, */
+   /*   a run of instructions at a time: from the start of the block,  */
+   /*   or a side exit, up to the next side exit.                      */
+static void add_inline_counts(IRSB *sbOut, IRSB *sbIn, Int i,
+                              struct BB_info *bbInfo, IRType tyW)
+{
+   IRStmt  *st;
+   Int     j, n_instrs;
+   Bool    run_start=True;
+
+#if defined(VGA_x86) || defined(VGA_amd64)
+      /* if (cur_thread_info->rep_count != 0) close_pending_reps(...) */
+   {
+      IRTemp  ti  = newIRTemp(sbOut->tyenv, tyW);
+      IRTemp  repA = newIRTemp(sbOut->tyenv, tyW);
+      IRTemp  rep = newIRTemp(sbOut->tyenv, tyW);
+      IRTemp  pending = newIRTemp(sbOut->tyenv, Ity_I1);
+      IRDirty *di;
+
+      addStmtToIRSB(sbOut, IRStmt_WrTmp(ti,
+         IRExpr_Load(BBVEndness, tyW,
+                     mkIRExpr_HWord((HWord)&cur_thread_info))));
+      addStmtToIRSB(sbOut, IRStmt_WrTmp(repA,
+         IRExpr_Binop(tyW == Ity_I64 ? Iop_Add64 : Iop_Add32,
+                      IRExpr_RdTmp(ti),
+                      mkIRExpr_HWord(offsetof(struct thread_info,
+                                              rep_count)))));
+      addStmtToIRSB(sbOut, IRStmt_WrTmp(rep,
+         IRExpr_Load(BBVEndness, tyW, IRExpr_RdTmp(repA))));
+      addStmtToIRSB(sbOut, IRStmt_WrTmp(pending,
+         IRExpr_Binop(tyW == Ity_I64 ? Iop_CmpNE64 : Iop_CmpNE32,
+                      IRExpr_RdTmp(rep), mkIRExpr_HWord(0))));
+      di = unsafeIRDirty_0_N(1, "close_pending_reps",
+                             VG_(fnptr_to_fnentry)(&close_pending_reps),
+                             mkIRExprVec_1(mkIRExpr_HWord((HWord)bbInfo)));
+      di->guard = IRExpr_RdTmp(pending);
+      addStmtToIRSB(sbOut, IRStmt_Dirty(di));
+   }
+#endif
+
+   for (/*use current i*/; i < sbIn->stmts_used; i++) {
+      st=sbIn->stmts[i];
+
+      if (st->tag == Ist_IMark && run_start) {
+            /* count the instructions up to the next side exit */
+         n_instrs=0;
+         for (j=i; j < sbIn->stmts_used; j++) {
+            if (sbIn->stmts[j]->tag == Ist_IMark) {
+               n_instrs++;
+            } else if (sbIn->stmts[j]->tag == Ist_Exit) {
+               break;
+            }
+         }
+         add_count(sbOut, bbInfo, n_instrs, tyW);
+         run_start=False;
+      } else if (st->tag == Ist_Exit) {
+         run_start=True;
+      }
+
+      if (instr_touch) {
+         add_touch(sbOut, st);
+      }
+      addStmtToIRSB( sbOut, st );
+   }
+}
+
 
    /* Our instrumentation function       */
    /*    sbIn = super block to translate */
@@ -350,7 +1139,8 @@ static IRSB* bbv_instrument ( VgCallbackClosure* closure,
                              VexArchInfo* archinfo_host,
                              IRType gWordTy, IRType hWordTy )
 {
-   Int      i,n_instrs=1;
+   Int      i,j,n_instrs=1;
+   Bool     special;
    IRSB     *sbOut;
    IRStmt   *st;
    struct BB_info  *bbInfo;
@@ -364,6 +1154,14 @@ static IRSB* bbv_instrument ( VgCallbackClosure* closure,
       VG_(tool_panic)("host/guest word size mismatch");
    }
 
+   guest_state_size = layout->total_sizeB;
+   guest_offset_IP = layout->offset_IP;
+
+      /* Outside the region of interest, don't instrument at all */
+   if (!counting) {
+      return sbIn;
+   }
+
       /* Set up SB */
    sbOut = deepCopyIRSBExceptStmts(sbIn);
 
@@ -409,6 +1207,30 @@ static IRSB* bbv_instrument ( VgCallbackClosure* closure,
       VG_(OSetGen_Insert)( instr_info_table, bbInfo );
    }
 
+      /* Does the block have instructions that need special handling? */
+      /*   If so, call a helper for each instruction, as they need.    */
+      /*   This is rare: only rep-prefixed string instructions and     */
+      /*   fldcw, on x86 and amd64, and near a checkpoint.             */
+   special=instr_precise;
+   for (j=i; j < sbIn->stmts_used; j++) {
+      st=sbIn->stmts[j];
+      if (st->tag != Ist_IMark) {
+         continue;
+      }
+      if (get_inst_type(st->Ist.IMark.len,st->Ist.IMark.addr) != 0) {
+         special=True;
+      }
+         /* record the code's pages, while recording a checkpoint */
+      if (ckpt_file != NULL) {
+         touch_pages(st->Ist.IMark.addr, st->Ist.IMark.len);
+      }
+   }
+
+   if (!special) {
+      add_inline_counts(sbOut, sbIn, i, bbInfo, gWordTy);
+      return sbOut;
+   }
+
       /* Iterate through the basic block, putting the original   */
       /* instructions in place, plus putting a call to updateBBV */
       /* for each original instruction                           */
@@ -451,9 +1273,15 @@ static IRSB* bbv_instrument ( VgCallbackClosure* closure,
          }
 
 
-            /* Insert our call */
+            /* Insert our call, after the check for a checkpoint */
+         if (instr_precise) {
+            add_checkpoint_call(sbOut, ourAddr, st->Ist.IMark.len, gWordTy);
+         }
          addStmtToIRSB( sbOut,  IRStmt_Dirty(di));
       }
+      else if (instr_touch) {
+         add_touch(sbOut, st);
+      }
 
          /* Insert the original instruction */
       addStmtToIRSB( sbOut, st );
@@ -480,12 +1308,12 @@ static struct thread_info *allocate_new_thread(struct thread_info *old,
    for(i=old_number;i<new_number;i++) {
       temp[i].last_rep_addr=0;
       temp[i].dyn_instr=0;
-      temp[i].total_instr=0;
+      temp[i].n_intervals=0;
       temp[i].global_rep_count=0;
       temp[i].unique_rep_count=0;
       temp[i].rep_count=0;
       temp[i].fldcw_count=0;
-      temp[i].bbtrace_fd=-1;
+      temp[i].bbtrace=NULL;
    }
       /* expand the inst_counter on all allocated basic blocks */
    VG_(OSetGen_ResetIter)(instr_info_table);
@@ -509,6 +1337,37 @@ static void bbv_thread_called ( ThreadId tid, ULong nDisp )
       allocated_threads=tid+1;
    }
    current_thread=tid;
+   cur_thread_info=&bbv_thread[tid];
+}
+
+static void set_counting(Bool state)
+{
+   if (counting == state) {
+      return;
+   }
+   counting = state;
+      /* Retranslate everything, with or without the counting code */
+   discard_all_translations();
+}
+
+static Bool bbv_handle_client_request(ThreadId tid, UWord *args, UWord *ret)
+{
+   if (!VG_IS_TOOL_USERREQ('B','V',args[0])) {
+      return False;
+   }
+
+   switch (args[0]) {
+      case VG_USERREQ__BBV_START_COUNTING:
+         set_counting(True);
+         break;
+      case VG_USERREQ__BBV_STOP_COUNTING:
+         set_counting(False);
+         break;
+      default:
+         return False;
+   }
+   *ret = 0;
+   return True;
 }
 
 
@@ -518,15 +1377,116 @@ static void bbv_thread_called ( ThreadId tid, ULong nDisp )
 /*--- Setup                                                        ---*/
 /*--------------------------------------------------------------------*/
 
+static void add_checkpoint_interval(ULong interval)
+{
+   ckpt_intervals = VG_(realloc)("bbv.ckpt_intervals", ckpt_intervals,
+                                 (n_ckpts + 1) * sizeof(ULong));
+   ckpt_intervals[n_ckpts++] = interval;
+}
+
+   /* Get interval numbers for checkpoints from s: separated by commas, */
+   /*   or, from a SimPoint -saveSimpoints file, the first on each line */
+static void parse_checkpoints(const HChar *opt, const HChar *s,
+                              Bool simpoints)
+{
+   HChar *end;
+   Long  n;
+
+   while (*s != '\0') {
+      while (simpoints && VG_(isspace)(*s)) {
+         s++;
+      }
+      if (*s == '\0') {
+         break;
+      }
+      n = VG_(strtoll10)(s, &end);
+      if (end == s || n < 0) {
+         VG_(fmsg_bad_option)(opt, "Bad interval number\n");
+      }
+      add_checkpoint_interval(n);
+      s = end;
+      if (simpoints) {
+         while (*s != '\0' && *s != '\n') {
+            s++;
+         }
+      } else if (*s == ',') {
+         s++;
+      } else if (*s != '\0') {
+         VG_(fmsg_bad_option)(opt, "Bad interval number\n");
+      }
+   }
+}
+
+static HChar *read_simpoints_file(const HChar *name)
+{
+   SysRes sres;
+   HChar  *text;
+   Int    fd, n, size=0, max=4096;
+
+   sres = VG_(open)(name, VKI_O_RDONLY, 0);
+   if (sr_isError(sres)) {
+      VG_(fmsg_bad_option)("--checkpoints-file", "Cannot open %s\n", name);
+   }
+   fd = sr_Res(sres);
+
+   text = VG_(malloc)("bbv.simpoints", max);
+   while ( (n = VG_(read)(fd, text + size, max - 1 - size)) > 0 ) {
+      size += n;
+      if (size == max - 1) {
+         max *= 2;
+         text = VG_(realloc)("bbv.simpoints", text, max);
+      }
+   }
+   text[size] = '\0';
+   VG_(close)(fd);
+   return text;
+}
+
+static Int cmp_ulong(const void *a, const void *b)
+{
+   ULong x = *(const ULong *)a, y = *(const ULong *)b;
+
+   return x < y ? -1 : x > y ? 1 : 0;
+}
+
 static void bbv_post_clo_init(void)
 {
+   HChar *text;
+   Int   i, n;
+
    bb_out_file =
           VG_(expand_file_name)("--bb-out-file", clo_bb_out_file);
 
+   if (clo_checkpoints != NULL) {
+      parse_checkpoints("--checkpoints", clo_checkpoints, False);
+   }
+   if (clo_checkpoints_file != NULL) {
+      text = read_simpoints_file(clo_checkpoints_file);
+      parse_checkpoints("--checkpoints-file", text, True);
+      VG_(free)(text);
+   }
+   if (n_ckpts > 0) {
+      VG_(ssort)(ckpt_intervals, n_ckpts, sizeof(ULong), cmp_ulong);
+      for (i = 1, n = 1; i < n_ckpts; i++) {
+         if (ckpt_intervals[i] != ckpt_intervals[n-1]) {
+            ckpt_intervals[n++] = ckpt_intervals[i];
+         }
+      }
+      n_ckpts = n;
+      ckpt_out_file =
+          VG_(expand_file_name)("--checkpoint-out-file", clo_ckpt_out_file);
+         /* interval 0 starts with the first instruction */
+      ckpt_armed = ckpt_intervals[0] == 0;
+   }
+   overflow_at = interval_size;
+   ckpt_update_mode(0, False);
+
       /* Try a closer approximation of basic blocks  */
       /* This is the same as the command line option */
       /* --vex-guest-chase-thresh=0                  */
    VG_(clo_vex_control).guest_chase_thresh = 0;
+
+   counting = clo_count_atstart;
 }
 
    /* Parse the command line options */
@@ -538,6 +1498,11 @@ static Bool bbv_process_cmd_line_option(const HChar* arg)
       generate_pc_file = True;
    }
    else if VG_BOOL_CLO (arg, "--instr-count-only", instr_count_only) {}
+   else if VG_BOOL_CLO (arg, "--bb-out-gzip",      clo_bb_out_gzip) {}
+   else if VG_BOOL_CLO (arg, "--count-atstart",    clo_count_atstart) {}
+   else if VG_STR_CLO  (arg, "--checkpoints",      clo_checkpoints) {}
+   else if VG_STR_CLO  (arg, "--checkpoints-file", clo_checkpoints_file) {}
+   else if VG_STR_CLO  (arg, "--checkpoint-out-file", clo_ckpt_out_file) {}
    else {
       return False;
    }
@@ -552,6 +1517,15 @@ static void bbv_print_usage(void)
 "   --pc-out-file=<file>       filename for BB addresses and function names\n"
 "   --interval-size=<num>      interval size\n"
 "   --instr-count-only=yes|no  only print total instruction count\n"
+"   --bb-out-gzip=yes|no       write the BBV info gzipped [no]\n"
+"   --count-atstart=yes|no     count from the start, rather than from the\n"
+"                              BBV_START_COUNTING client request [yes]\n"
+"   --checkpoints=<n>,<n>,...  write checkpoints at the start of these\n"
+"                              intervals\n"
+"   --checkpoints-file=<file>  ... and of those in a SimPoint -saveSimpoints\n"
+"                              file\n"
+"   --checkpoint-out-file=<file>  filename prefix for checkpoints\n"
+"                              [ckpt.out.%%p]\n"
    );
 }
 
@@ -568,9 +1542,16 @@ static void bbv_fini(Int exitcode)
       dumpPcFile();
    }
 
+   if (ckpt_file != NULL) {
+      finish_checkpoint();
+   }
+   if (n_ckpts > 0) {
+      VG_(umsg)("Checkpoints written: %d of %d\n", ckpts_taken, n_ckpts);
+   }
+
    for(i=0;i<allocated_threads;i++) {
 
-      if (bbv_thread[i].total_instr!=0) {
+      if (total_instr(&bbv_thread[i])!=0) {
 
          VG_(sprintf)(buf,"\n\n"
                           "# Thread %d\n"
@@ -580,9 +1561,9 @@ static void bbv_fini(Int exitcode)
                           "#   Unique reps: %lld\n"
                           "#   Total fldcw instructions: %lld\n\n",
                 i,
-                (Int)(bbv_thread[i].total_instr/(ULong)interval_size),
+                (Int)(total_instr(&bbv_thread[i])/(ULong)interval_size),
                 interval_size,
-                bbv_thread[i].total_instr,
+                total_instr(&bbv_thread[i]),
                 bbv_thread[i].global_rep_count,
                 bbv_thread[i].unique_rep_count,
                 bbv_thread[i].fldcw_count);
@@ -591,12 +1572,12 @@ static void bbv_fini(Int exitcode)
          VG_(umsg)("%s\n", buf);
 
             /* open the output file if it hasn't already */
-         if (bbv_thread[i].bbtrace_fd < 0) {
-            bbv_thread[i].bbtrace_fd=open_tracefile(i);
+         if (bbv_thread[i].bbtrace == NULL) {
+            bbv_thread[i].bbtrace=open_tracefile(i);
          }
             /* Also print to results file */
-         VG_(write)(bbv_thread[i].bbtrace_fd,(void*)buf,VG_(strlen)(buf));
-         VG_(close)(bbv_thread[i].bbtrace_fd);
+         write_out_str(bbv_thread[i].bbtrace, buf);
+         close_out_file(bbv_thread[i].bbtrace);
       }
    }
 }
@@ -618,6 +1599,8 @@ static void bbv_pre_clo_init(void)
                                    bbv_print_usage,
                                    bbv_print_debug_usage);
 
+   VG_(needs_client_requests)     (bbv_handle_client_request);
+
    VG_(track_start_client_code)( bbv_thread_called );
 
 
@@ -626,6 +1609,7 @@ static void bbv_pre_clo_init(void)
                                           VG_(malloc), "bbv.1", VG_(free));
 
    bbv_thread=allocate_new_thread(bbv_thread,0,allocated_threads);
+   cur_thread_info=&bbv_thread[0];
 }
 
 VG_DETERMINE_INTERFACE_VERSION(bbv_pre_clo_init)
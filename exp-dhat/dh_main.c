@@ -31,8 +31,14 @@
 
 
 #include "pub_tool_basics.h"
+#include "pub_tool_vki.h"
+#include "pub_tool_clientstate.h"  // VG_(args_the_exename)
+#include "pub_tool_debuginfo.h"
+#include "pub_tool_execontext.h"
+#include "pub_tool_hashtable.h"
 #include "pub_tool_libcbase.h"
 #include "pub_tool_libcassert.h"
+#include "pub_tool_libcfile.h"
 #include "pub_tool_libcprint.h"
 #include "pub_tool_machine.h"      // VG_(fnptr_to_fnentry)
 #include "pub_tool_mallocfree.h"
@@ -40,9 +46,22 @@
 #include "pub_tool_replacemalloc.h"
 #include "pub_tool_tooliface.h"
 #include "pub_tool_wordfm.h"
+#include "pub_tool_xarray.h"
+
+/* --cache-sim=yes uses Cachegrind's cache configuration and simulator. */
+#include "cg_arch.c"
+#include "cg_sim.c"
 
 #define HISTOGRAM_SIZE_LIMIT 1024
 
+/* Blocks too big for a histogram, but no bigger than this, get a
+   bitmap of the bytes touched instead, so that cache line utilisation
+   can still be computed for them. */
+#define TOUCHED_SIZE_LIMIT (16 * 1024 * 1024)
+
+/* Cache line size assumed for the line utilisation figures. */
+#define LINE_SZB 64
+
 
 //------------------------------------------------------------//
 //--- Globals                                              ---//
@@ -62,9 +81,17 @@ static ULong g_cur_bytes_live  = 0; // curr # bytes live
 static ULong g_max_blocks_live = 0; // bytes and blocks at
 static ULong g_max_bytes_live  = 0; // the max residency point
 
+// With --cache-sim=yes, the simulated D1 and LL misses of all data
+// accesses, and of those to heap blocks.
+static Bool  clo_cache_sim = False;
+
+static ULong g_D1mr = 0, g_D1mw = 0, g_DLmr = 0, g_DLmw = 0;
+static ULong g_heap_D1mr = 0, g_heap_D1mw = 0;
+static ULong g_heap_DLmr = 0, g_heap_DLmw = 0;
+
 
 //------------------------------------------------------------//
-//--- an Interval Tree of live blocks                      ---//
+//--- a Page Map of live blocks                           ---//
 //------------------------------------------------------------//
 
 /* Tracks information about live blocks. */
@@ -80,17 +107,58 @@ typedef
          therefore at 0xFFFF.  Can be NULL if the block is resized or if
          the block is larger than HISTOGRAM_SIZE_LIMIT. */
       UShort*     histoW; /* [0 .. req_szB-1] */
+      /* One bit per payload byte, set if the byte has been accessed.
+         Only used if histoW is NULL because the block is too large
+         for it; also thrown away if the block is resized. */
+      UChar*      touched; /* [0 .. (req_szB+7)/8-1] */
+      /* With --cache-sim=yes, the D1 and LL misses of accesses to the
+         block.  If it has a histogram, also its D1 misses by the offset
+         at which the missing access starts; allocated at the first
+         miss. */
+      ULong       D1mr, D1mw, DLmr, DLmw;
+      UInt*       missW; /* [0 .. req_szB-1] */
    }
    Block;
 
-/* May not contain zero-sized blocks.  May not contain
-   overlapping blocks. */
-static WordFM* interval_tree = NULL;  /* WordFM* Block* void */
+/* For each page that live blocks overlap, the blocks overlapping it,
+   sorted by payload address.  So a lookup is a hash lookup on the page
+   number, which fails straight away for the many accesses to non-heap
+   memory, plus a binary search among the few blocks in the page.  A
+   block is entered in every page it overlaps, so may not be zero-sized;
+   blocks may not overlap each other.
+
+   Blocks overlapping more than BIG_BLOCK_PAGES pages would take that
+   many entries, so they go instead in 'big_blocks', an interval tree,
+   which is only searched when the page map fails to find an address in
+   the range that the big blocks span. */
+#define PAGE_MAP_BITS   12
+#define BIG_BLOCK_PAGES 16
+
+typedef
+   struct _PageBlocks {
+      struct _PageBlocks* next;
+      UWord   key;         /* page number */
+      UInt    n_blocks;
+      UInt    max_blocks;
+      Block** blocks;      /* [0 .. n_blocks-1], sorted by payload */
+   }
+   PageBlocks;
+
+static VgHashTable page_map = NULL;  /* of PageBlocks */
+
+static UWord stats__n_page_map_pages = 0;
+static UWord stats__max_page_map_pages = 0;
+
+static WordFM* big_blocks = NULL;  /* WordFM* Block* void */
+static UWord   n_big_blocks = 0;
+static Addr    big_blocks_min = ~(Addr)0;  /* of all live big blocks, */
+static Addr    big_blocks_max = 0;         /* or more while any live */
 
-/* Here's the comparison function.  Since the tree is required
-to contain non-zero sized, non-overlapping blocks, it's good
-enough to consider any overlap as a match. */
-static Word interval_tree_Cmp ( UWord k1, UWord k2 )
+static UWord stats__max_big_blocks = 0;
+
+/* Since the tree is required to contain non-zero sized, non-overlapping
+   blocks, it's good enough to consider any overlap as a match. */
+static Word big_blocks_Cmp ( UWord k1, UWord k2 )
 {
    Block* b1 = (Block*)k1;
    Block* b2 = (Block*)k2;
@@ -101,6 +169,120 @@ static Word interval_tree_Cmp ( UWord k1, UWord k2 )
    return 0;
 }
 
+static Bool is_big_Block ( Block* bk )
+{
+   return ((bk->payload + bk->req_szB - 1) >> PAGE_MAP_BITS)
+          - (bk->payload >> PAGE_MAP_BITS) >= BIG_BLOCK_PAGES;
+}
+
+static Block* find_big_Block_containing ( Addr a )
+{
+   Block fake;
+   UWord foundkey, foundval;
+   if (a < big_blocks_min || a > big_blocks_max)
+      return NULL;
+   fake.payload = a;
+   fake.req_szB = 1;
+   if (!VG_(lookupFM)( big_blocks, &foundkey, &foundval, (UWord)&fake ))
+      return NULL;
+   return (Block*)foundkey;
+}
+
+/* Index of the last block in 'pb' starting at or before 'a', or -1 */
+static Int find_in_PageBlocks ( PageBlocks* pb, Addr a )
+{
+   Int lo = 0, hi = (Int)pb->n_blocks - 1;
+   while (lo <= hi) {
+      Int mid = (lo + hi) / 2;
+      if (pb->blocks[mid]->payload <= a)
+         lo = mid + 1;
+      else
+         hi = mid - 1;
+   }
+   return hi;
+}
+
+static void add_Block ( Block* bk )
+{
+   UWord page;
+   tl_assert(bk->req_szB > 0);
+   if (is_big_Block(bk)) {
+      Bool present = VG_(addToFM)( big_blocks, (UWord)bk, 0 );
+      tl_assert(!present);
+      if (bk->payload < big_blocks_min)
+         big_blocks_min = bk->payload;
+      if (bk->payload + bk->req_szB - 1 > big_blocks_max)
+         big_blocks_max = bk->payload + bk->req_szB - 1;
+      if (++n_big_blocks > stats__max_big_blocks)
+         stats__max_big_blocks = n_big_blocks;
+      return;
+   }
+   for (page = bk->payload >> PAGE_MAP_BITS;
+        page <= (bk->payload + bk->req_szB - 1) >> PAGE_MAP_BITS;
+        page++) {
+      PageBlocks* pb = VG_(HT_lookup)( page_map, page );
+      Int i;
+      if (!pb) {
+         pb = VG_(malloc)("dh.add_Block.1", sizeof(PageBlocks));
+         pb->key        = page;
+         pb->n_blocks   = 0;
+         pb->max_blocks = 2;
+         pb->blocks     = VG_(malloc)("dh.add_Block.2",
+                                      pb->max_blocks * sizeof(Block*));
+         VG_(HT_add_node)( page_map, pb );
+         stats__n_page_map_pages++;
+         if (stats__n_page_map_pages > stats__max_page_map_pages)
+            stats__max_page_map_pages = stats__n_page_map_pages;
+      }
+      if (pb->n_blocks == pb->max_blocks) {
+         pb->max_blocks *= 2;
+         pb->blocks = VG_(realloc)("dh.add_Block.3", pb->blocks,
+                                   pb->max_blocks * sizeof(Block*));
+      }
+      // insert after the last block starting before it
+      i = find_in_PageBlocks( pb, bk->payload ) + 1;
+      tl_assert(i == 0 || pb->blocks[i-1]->payload
+                          + pb->blocks[i-1]->req_szB <= bk->payload);
+      VG_(memmove)( &pb->blocks[i+1], &pb->blocks[i],
+                    (pb->n_blocks - i) * sizeof(Block*) );
+      pb->blocks[i] = bk;
+      pb->n_blocks++;
+   }
+}
+
+// remove a block; asserts if it is not there.
+static void remove_Block ( Block* bk )
+{
+   UWord page;
+   if (is_big_Block(bk)) {
+      Bool found = VG_(delFromFM)( big_blocks, NULL, NULL, (UWord)bk );
+      tl_assert(found);
+      if (--n_big_blocks == 0) {
+         big_blocks_min = ~(Addr)0;
+         big_blocks_max = 0;
+      }
+      return;
+   }
+   for (page = bk->payload >> PAGE_MAP_BITS;
+        page <= (bk->payload + bk->req_szB - 1) >> PAGE_MAP_BITS;
+        page++) {
+      PageBlocks* pb = VG_(HT_lookup)( page_map, page );
+      Int i;
+      tl_assert(pb);
+      i = find_in_PageBlocks( pb, bk->payload );
+      tl_assert(i >= 0 && pb->blocks[i] == bk);
+      pb->n_blocks--;
+      VG_(memmove)( &pb->blocks[i], &pb->blocks[i+1],
+                    (pb->n_blocks - i) * sizeof(Block*) );
+      if (pb->n_blocks == 0) {
+         VG_(HT_remove)( page_map, page );
+         VG_(free)( pb->blocks );
+         VG_(free)( pb );
+         stats__n_page_map_pages--;
+      }
+   }
+}
+
 // 2-entry cache for find_Block_containing
 static Block* fbc_cache0 = NULL;
 static Block* fbc_cache1 = NULL;
@@ -128,21 +310,19 @@ static Block* find_Block_containing ( Addr a )
       stats__n_fBc_cached++;
       return fbc_cache0;
    }
-   Block fake;
-   fake.payload = a;
-   fake.req_szB = 1;
-   UWord foundkey = 1;
-   UWord foundval = 1;
-   Bool found = VG_(lookupFM)( interval_tree,
-                               &foundkey, &foundval, (UWord)&fake );
-   if (!found) {
+   PageBlocks* pb = VG_(HT_lookup)( page_map, a >> PAGE_MAP_BITS );
+   Block* res = NULL;
+   if (pb) {
+      Int i = find_in_PageBlocks( pb, a );
+      if (i >= 0 && a < pb->blocks[i]->payload + pb->blocks[i]->req_szB)
+         res = pb->blocks[i];
+   }
+   if (!res)
+      res = find_big_Block_containing( a );
+   if (!res) {
       stats__n_fBc_notfound++;
       return NULL;
    }
-   tl_assert(foundval == 0); // we don't store vals in the interval tree
-   tl_assert(foundkey != 1);
-   Block* res = (Block*)foundkey;
-   tl_assert(res != &fake);
    // put at the top position
    fbc_cache1 = fbc_cache0;
    fbc_cache0 = res;
@@ -150,16 +330,10 @@ static Block* find_Block_containing ( Addr a )
    return res;
 }
 
-// delete a block; asserts if not found.  (viz, 'a' must be
-// known to be present.)
-static void delete_Block_starting_at ( Addr a )
+// delete a block; asserts if not found.
+static void delete_Block ( Block* bk )
 {
-   Block fake;
-   fake.payload = a;
-   fake.req_szB = 1;
-   Bool found = VG_(delFromFM)( interval_tree,
-                                NULL, NULL, (Addr)&fake );
-   tl_assert(found);
+   remove_Block( bk );
    fbc_cache0 = fbc_cache1 = NULL;
 }
 
@@ -195,6 +369,17 @@ typedef
       // by this AP.
       ULong n_reads;
       ULong n_writes;
+      // Cache line usage, summed over all retired blocks allocated by
+      // this AP that have a histogram or touched-bitmap.  A line is
+      // a LINE_SZB-aligned piece of the address space overlapping the
+      // block.  line_bytes_touched counts the block's bytes that were
+      // accessed at least once.
+      ULong lines_tot;
+      ULong lines_touched;
+      ULong line_bytes_touched;
+      // With --cache-sim=yes, the D1 and LL misses in all retired
+      // blocks allocated by this AP.
+      ULong D1mr, D1mw, DLmr, DLmw;
       /* Histogram information.  We maintain a histogram aggregated for
          all retiring Blocks allocated by this AP, but only if:
          - this AP has only ever allocated objects of one size
@@ -210,6 +395,9 @@ typedef
       enum { Unknown=999, Exactly, Mixed } xsize_tag;
       SizeT xsize;
       UInt* histo; /* [0 .. xsize-1] */
+      /* D1 misses by offset, summed like histo; allocated when the
+         first retiring block with misses by offset is folded in. */
+      UInt* miss_histo; /* [0 .. xsize-1] */
    }
    APInfo;
 
@@ -280,6 +468,40 @@ static void intro_Block ( Block* bk )
 }
 
 
+static inline Bool is_touched_in_block ( Block* bk, UWord off )
+{
+   if (bk->histoW)
+      return bk->histoW[off] > 0;
+   return (bk->touched[off >> 3] >> (off & 7)) & 1;
+}
+
+/* Fold the cache line usage of 'bk' into 'api'.  Does nothing if we
+   don't know which bytes of the block were accessed. */
+static void fold_line_usage ( APInfo* api, Block* bk )
+{
+   if (!bk->histoW && !bk->touched)
+      return;
+
+   UWord off = 0;
+   while (off < bk->req_szB) {
+      Addr  lineEnd = VG_ROUNDDN(bk->payload + off, LINE_SZB) + LINE_SZB;
+      UWord offEnd  = lineEnd - bk->payload;
+      UWord n_touched = 0;
+      if (offEnd > bk->req_szB)
+         offEnd = bk->req_szB;
+      for (; off < offEnd; off++) {
+         if (is_touched_in_block(bk, off))
+            n_touched++;
+      }
+      api->lines_tot++;
+      if (n_touched > 0) {
+         api->lines_touched++;
+         api->line_bytes_touched += n_touched;
+      }
+   }
+}
+
+
 /* 'bk' is retiring (being freed).  Find the relevant APInfo entry for
    it, which must already exist.  Then, fold info from 'bk' into that
    entry.  'because_freed' is True if the block is retiring because
@@ -331,6 +553,15 @@ static void retire_Block ( Block* bk, Bool because_freed )
    api->n_reads  += bk->n_reads;
    api->n_writes += bk->n_writes;
 
+   // cache line usage
+   fold_line_usage(api, bk);
+
+   // cache misses
+   api->D1mr += bk->D1mr;
+   api->D1mw += bk->D1mw;
+   api->DLmr += bk->DLmr;
+   api->DLmw += bk->DLmw;
+
    // histo stuff.  First, do state transitions for xsize/xsize_tag.
    switch (api->xsize_tag) {
 
@@ -361,6 +592,10 @@ static void retire_Block ( Block* bk, Bool because_freed )
                VG_(free)(api->histo);
                api->histo = NULL;
             }
+            if (api->miss_histo) {
+               VG_(free)(api->miss_histo);
+               api->miss_histo = NULL;
+            }
          }
          break;
 
@@ -385,6 +620,18 @@ static void retire_Block ( Block* bk, Bool because_freed )
       }
       if (0) VG_(printf)("fold in, AP = %p\n", api);
    }
+   if (api->xsize_tag == Exactly && api->histo && bk->missW) {
+      UWord i;
+      if (!api->miss_histo) {
+         api->miss_histo = VG_(malloc)("dh.main.retire_Block.2",
+                                       api->xsize * sizeof(UInt));
+         VG_(memset)(api->miss_histo, 0, api->xsize * sizeof(UInt));
+      }
+      for (i = 0; i < api->xsize; i++) {
+         if (api->miss_histo[i] <= 0xFFFE0000)
+            api->miss_histo[i] += bk->missW[i];
+      }
+   }
 
 
 
@@ -457,7 +704,7 @@ void* new_block ( ThreadId tid, void* p, SizeT req_szB, SizeT req_alignB,
    if ((SSizeT)req_szB < 0) return NULL;
 
    if (req_szB == 0)
-      req_szB = 1;  /* can't allow zero-sized blocks in the interval tree */
+      req_szB = 1;  /* can't allow zero-sized blocks in the page map */
 
    // Allocate and zero if necessary
    if (!p) {
@@ -481,15 +728,22 @@ void* new_block ( ThreadId tid, void* p, SizeT req_szB, SizeT req_alignB,
    bk->allocd_at = g_guest_instrs_executed;
    bk->n_reads   = 0;
    bk->n_writes  = 0;
+   bk->D1mr = bk->D1mw = bk->DLmr = bk->DLmw = 0;
+   bk->missW     = NULL;
    // set up histogram array, if the block isn't too large
    bk->histoW = NULL;
    if (req_szB <= HISTOGRAM_SIZE_LIMIT) {
       bk->histoW = VG_(malloc)("dh.new_block.2", req_szB * sizeof(UShort));
       VG_(memset)(bk->histoW, 0, req_szB * sizeof(UShort));
    }
+   // otherwise a touched-bitmap, if it isn't too large either
+   bk->touched = NULL;
+   if (!bk->histoW && req_szB <= TOUCHED_SIZE_LIMIT) {
+      bk->touched = VG_(malloc)("dh.new_block.3", (req_szB + 7) / 8);
+      VG_(memset)(bk->touched, 0, (req_szB + 7) / 8);
+   }
 
-   Bool present = VG_(addToFM)( interval_tree, (UWord)bk, (UWord)0/*no val*/);
-   tl_assert(!present);
+   add_Block(bk);
    fbc_cache0 = fbc_cache1 = NULL;
 
    intro_Block(bk);
@@ -525,11 +779,19 @@ void die_block ( void* p, Bool custom_free )
    retire_Block(bk, True/*because_freed*/);
 
    VG_(cli_free)( (void*)bk->payload );
-   delete_Block_starting_at( bk->payload );
+   delete_Block( bk );
    if (bk->histoW) {
       VG_(free)( bk->histoW );
       bk->histoW = NULL;
    }
+   if (bk->touched) {
+      VG_(free)( bk->touched );
+      bk->touched = NULL;
+   }
+   if (bk->missW) {
+      VG_(free)( bk->missW );
+      bk->missW = NULL;
+   }
    VG_(free)( bk );
 }
 
@@ -558,19 +820,31 @@ void* renew_block ( ThreadId tid, void* p_old, SizeT new_req_szB )
    }
 
    // Keeping the histogram alive in any meaningful way across
-   // block resizing is too darn complicated.  Just throw it away.
+   // block resizing is too darn complicated.  Just throw it away,
+   // and the touched-bitmap and misses by offset too.
    if (bk->histoW) {
       VG_(free)(bk->histoW);
       bk->histoW = NULL;
    }
+   if (bk->touched) {
+      VG_(free)(bk->touched);
+      bk->touched = NULL;
+   }
+   if (bk->missW) {
+      VG_(free)(bk->missW);
+      bk->missW = NULL;
+   }
 
    // Actually do the allocation, if necessary.
    if (new_req_szB <= bk->req_szB) {
 
-      // New size is smaller or same; block not moved.
+      // New size is smaller or same; block not moved.  But it may
+      // now overlap fewer pages.
       apinfo_change_cur_bytes_live(bk->ap,
                                    (Long)new_req_szB - (Long)bk->req_szB);
+      delete_Block( bk );
       bk->req_szB = new_req_szB;
+      add_Block( bk );
       return p_old;
 
    } else {
@@ -587,11 +861,10 @@ void* renew_block ( ThreadId tid, void* p_old, SizeT new_req_szB )
       VG_(memcpy)(p_new, p_old, bk->req_szB);
       VG_(cli_free)(p_old);
 
-      // Since the block has moved, we need to re-insert it into the
-      // interval tree at the new place.  Do this by removing
-      // and re-adding it.
-      delete_Block_starting_at( (Addr)p_old );
-      // now 'bk' is no longer in the tree, but the Block itself
+      // Since the block has moved, we need to re-insert it at the
+      // new place.  Do this by removing and re-adding it.
+      delete_Block( bk );
+      // now 'bk' is no longer findable, but the Block itself
       // is still alive
 
       // Update the metadata.
@@ -601,9 +874,7 @@ void* renew_block ( ThreadId tid, void* p_old, SizeT new_req_szB )
       bk->req_szB = new_req_szB;
 
       // and re-add
-      Bool present
-         = VG_(addToFM)( interval_tree, (UWord)bk, (UWord)0/*no val*/); 
-      tl_assert(!present);
+      add_Block( bk );
       fbc_cache0 = fbc_cache1 = NULL;
 
       return p_new;
@@ -697,14 +968,35 @@ void inc_histo_for_block ( Block* bk, Addr addr, UWord szB )
    }
 }
 
+static
+void mark_touched_for_block ( Block* bk, Addr addr, UWord szB )
+{
+   UWord i, offMin, offMax1;
+   offMin = addr - bk->payload;
+   tl_assert(offMin < bk->req_szB);
+   offMax1 = offMin + szB;
+   if (offMax1 > bk->req_szB)
+      offMax1 = bk->req_szB;
+   for (i = offMin; i < offMax1; i++)
+      bk->touched[i >> 3] |= (UChar)(1 << (i & 7));
+}
+
+static inline
+void note_access_to_block ( Block* bk, Addr addr, UWord szB )
+{
+   if (bk->histoW)
+      inc_histo_for_block(bk, addr, szB);
+   else if (bk->touched)
+      mark_touched_for_block(bk, addr, szB);
+}
+
 static VG_REGPARM(2)
 void dh_handle_write ( Addr addr, UWord szB )
 {
    Block* bk = find_Block_containing(addr);
    if (bk) {
       bk->n_writes += szB;
-      if (bk->histoW)
-         inc_histo_for_block(bk, addr, szB);
+      note_access_to_block(bk, addr, szB);
    }
 }
 
@@ -714,8 +1006,70 @@ void dh_handle_read ( Addr addr, UWord szB )
    Block* bk = find_Block_containing(addr);
    if (bk) {
       bk->n_reads += szB;
-      if (bk->histoW)
-         inc_histo_for_block(bk, addr, szB);
+      note_access_to_block(bk, addr, szB);
+   }
+}
+
+/* Count 'm1' D1 misses at 'addr' by offset, if 'bk' has a histogram. */
+static void note_miss_in_block ( Block* bk, Addr addr, ULong m1 )
+{
+   if (!bk->histoW)
+      return;
+   if (!bk->missW) {
+      bk->missW = VG_(malloc)("dh.note_miss_in_block.1",
+                              bk->req_szB * sizeof(UInt));
+      VG_(memset)(bk->missW, 0, bk->req_szB * sizeof(UInt));
+   }
+   bk->missW[addr - bk->payload] += (UInt)m1;
+}
+
+/* With --cache-sim=yes, these are called for every data access instead
+   of the two above, since all accesses, heap or not, go through the
+   simulated caches.  As in Cachegrind, an access is taken to be no
+   bigger than MIN_LINE_SIZE, so that it touches at most two lines. */
+static VG_REGPARM(2)
+void dh_handle_write_sim ( Addr addr, UWord szB )
+{
+   ULong m1 = 0, m2 = 0, mL = 0, mT = 0;
+   cachesim_D1_doref(addr, szB > MIN_LINE_SIZE ? MIN_LINE_SIZE : szB,
+                     &m1, &m2, &mL, &mT);
+   g_D1mw += m1;
+   g_DLmw += mL;
+
+   Block* bk = find_Block_containing(addr);
+   if (bk) {
+      bk->n_writes += szB;
+      note_access_to_block(bk, addr, szB);
+      if (m1) {
+         bk->D1mw += m1;
+         bk->DLmw += mL;
+         g_heap_D1mw += m1;
+         g_heap_DLmw += mL;
+         note_miss_in_block(bk, addr, m1);
+      }
+   }
+}
+
+static VG_REGPARM(2)
+void dh_handle_read_sim ( Addr addr, UWord szB )
+{
+   ULong m1 = 0, m2 = 0, mL = 0, mT = 0;
+   cachesim_D1_doref(addr, szB > MIN_LINE_SIZE ? MIN_LINE_SIZE : szB,
+                     &m1, &m2, &mL, &mT);
+   g_D1mr += m1;
+   g_DLmr += mL;
+
+   Block* bk = find_Block_containing(addr);
+   if (bk) {
+      bk->n_reads += szB;
+      note_access_to_block(bk, addr, szB);
+      if (m1) {
+         bk->D1mr += m1;
+         bk->DLmr += mL;
+         g_heap_D1mr += m1;
+         g_heap_DLmr += mL;
+         note_miss_in_block(bk, addr, m1);
+      }
    }
 }
 
@@ -811,7 +1165,10 @@ void addMemEvent(IRSB* sbOut, Bool isWrite, Int szB, IRExpr* addr,
    tyAddr = typeOfIRExpr( sbOut->tyenv, addr );
    tl_assert(tyAddr == Ity_I32 || tyAddr == Ity_I64);
 
-   if (isWrite) {
+   if (clo_cache_sim) {
+      hName = isWrite ? "dh_handle_write_sim" : "dh_handle_read_sim";
+      hAddr = isWrite ? &dh_handle_write_sim : &dh_handle_read_sim;
+   } else if (isWrite) {
       hName = "dh_handle_write";
       hAddr = &dh_handle_write;
    } else {
@@ -829,6 +1186,12 @@ void addMemEvent(IRSB* sbOut, Bool isWrite, Int szB, IRExpr* addr,
                            hName, VG_(fnptr_to_fnentry)( hAddr ),
                            argv );
 
+   /* The simulated caches have to see stack accesses too. */
+   if (clo_cache_sim) {
+      addStmtToIRSB( sbOut, IRStmt_Dirty(di) );
+      return;
+   }
+
    /* Generate the guard condition: "(addr - (SP - RZ)) >u N", for
       some arbitrary N.  If that fails then addr is in the range (SP -
       RZ .. SP + N - RZ).  If N is smallish (a page?) then we can say
@@ -1034,6 +1397,11 @@ static Bool identify_metric ( /*OUT*/ULong(**get_metricP)(APInfo*),
 
 static Int    clo_show_top_n = 10;
 static const HChar *clo_sort_by = "max-bytes-live";
+static const HChar *clo_cache_out_file = "dhat.cache.out.%p";
+
+static cache_t clo_I1_cache = UNDEFINED_CACHE;
+static cache_t clo_D1_cache = UNDEFINED_CACHE;
+static cache_t clo_LL_cache = UNDEFINED_CACHE;
 
 static Bool dh_process_cmd_line_option(const HChar* arg)
 {
@@ -1050,6 +1418,14 @@ static Bool dh_process_cmd_line_option(const HChar* arg)
        // second call to identify_metric.
    }
 
+   else if VG_BOOL_CLO(arg, "--cache-sim", clo_cache_sim) {}
+   else if VG_STR_CLO(arg, "--cache-out-file", clo_cache_out_file) {}
+   else if (VG_(str_clo_cache_opt)(arg,
+                                   &clo_I1_cache,
+                                   &clo_D1_cache,
+                                   NULL,
+                                   &clo_LL_cache)) {}
+
    else
       return VG_(replacement_malloc_process_cmd_line_option)(arg);
 
@@ -1067,7 +1443,14 @@ static void dh_print_usage(void)
 "                max-bytes-live    maximum live bytes [default]\n"
 "                tot-bytes-allocd  total allocation (turnover)\n"
 "                max-blocks-live   maximum live blocks\n"
+"                d1-misses         D1 misses (needs --cache-sim=yes)\n"
+"                ll-misses         LL misses (needs --cache-sim=yes)\n"
+"    --cache-sim=no|yes        simulate D1 and LL caches, and attribute\n"
+"                              their misses to alloc points [no]\n"
+"    --cache-out-file=<file>   also write the misses to <file>, by alloc\n"
+"                              point, for cg_annotate [dhat.cache.out.%%p]\n"
    );
+   VG_(print_cache_clo_opts)();
 }
 
 static void dh_print_debug_usage(void)
@@ -1091,6 +1474,109 @@ static void show_N_div_100( /*OUT*/HChar* buf, ULong n )
                 nR);
 }
 
+/* A run of consecutive offsets in an AP's histogram that all have
+   the same, nonzero, access count.  Such a run is often one field of
+   the allocated struct, or several fields that are always accessed
+   together. */
+typedef
+   struct {
+      UWord off;
+      UWord szB;
+      UInt  count;
+   }
+   HotField;
+
+static Int cmp_HotField_by_count ( const void* v1, const void* v2 )
+{
+   const HotField* hf1 = v1;
+   const HotField* hf2 = v2;
+   if (hf1->count > hf2->count) return -1;
+   if (hf1->count < hf2->count) return 1;
+   if (hf1->off < hf2->off) return -1;
+   if (hf1->off > hf2->off) return 1;
+   return 0;
+}
+
+#define N_HOT_FIELDS_TO_SHOW 10
+
+/* Print the hottest fields of an exactly-sized AP, and the bytes
+   that are never accessed at all, to help with reordering fields,
+   or splitting hot and cold ones into separate structs. */
+static void show_hot_fields ( APInfo* api )
+{
+   UWord i, n_fields = 0, n_cold = 0;
+   HotField* fields = VG_(malloc)("dh.show_hot_fields.1",
+                                  api->xsize * sizeof(HotField));
+
+   for (i = 0; i < api->xsize; ) {
+      UWord j = i + 1;
+      while (j < api->xsize && api->histo[j] == api->histo[i])
+         j++;
+      if (api->histo[i] > 0) {
+         fields[n_fields].off   = i;
+         fields[n_fields].szB   = j - i;
+         fields[n_fields].count = api->histo[i];
+         n_fields++;
+      } else {
+         n_cold += j - i;
+      }
+      i = j;
+   }
+
+   VG_(ssort)(fields, n_fields, sizeof(HotField), cmp_HotField_by_count);
+
+   VG_(umsg)("\nHottest fields (runs of equal access counts):\n");
+   VG_(umsg)("\n");
+   for (i = 0; i < n_fields && i < N_HOT_FIELDS_TO_SHOW; i++) {
+      VG_(umsg)("[%4lu..%4lu]  %4lu bytes, %u accesses, line %lu\n",
+                fields[i].off, fields[i].off + fields[i].szB - 1,
+                fields[i].szB, fields[i].count, fields[i].off / LINE_SZB);
+   }
+   if (n_fields > N_HOT_FIELDS_TO_SHOW)
+      VG_(umsg)("... and %lu colder\n", n_fields - N_HOT_FIELDS_TO_SHOW);
+   VG_(free)(fields);
+
+   VG_(umsg)("\nNever-accessed bytes: %lu of %lu", n_cold, api->xsize);
+   for (i = 0; i < api->xsize; ) {
+      UWord j = i + 1;
+      while (j < api->xsize && api->histo[j] == api->histo[i])
+         j++;
+      if (api->histo[i] == 0)
+         VG_(umsg)(" [%lu..%lu]", i, j - 1);
+      i = j;
+   }
+   VG_(umsg)("\n");
+}
+
+/* Print the offsets of an exactly-sized AP with the most D1 misses.
+   A miss is counted at the offset where the missing access starts. */
+static void show_miss_offsets ( APInfo* api )
+{
+   UWord i, n_offs = 0;
+   HotField* offs = VG_(malloc)("dh.show_miss_offsets.1",
+                                api->xsize * sizeof(HotField));
+
+   for (i = 0; i < api->xsize; i++) {
+      if (api->miss_histo[i] > 0) {
+         offs[n_offs].off   = i;
+         offs[n_offs].szB   = 1;
+         offs[n_offs].count = api->miss_histo[i];
+         n_offs++;
+      }
+   }
+   VG_(ssort)(offs, n_offs, sizeof(HotField), cmp_HotField_by_count);
+
+   VG_(umsg)("\nOffsets with most D1 misses:\n");
+   VG_(umsg)("\n");
+   for (i = 0; i < n_offs && i < N_HOT_FIELDS_TO_SHOW; i++) {
+      VG_(umsg)("[%4lu]  %u misses, line %lu\n",
+                offs[i].off, offs[i].count, offs[i].off / LINE_SZB);
+   }
+   if (n_offs > N_HOT_FIELDS_TO_SHOW)
+      VG_(umsg)("... and %lu with fewer\n", n_offs - N_HOT_FIELDS_TO_SHOW);
+   VG_(free)(offs);
+}
+
 static void show_APInfo ( APInfo* api )
 {
    HChar bufA[80];
@@ -1140,10 +1626,36 @@ static void show_APInfo ( APInfo* api )
       VG_(strcat)(bufW, "Inf");
    }
 
+   HChar bufRW[80];
+   VG_(memset)(bufRW, 0, sizeof(bufRW));
+   if (api->n_writes > 0)
+      show_N_div_100(bufRW, (100ULL * api->n_reads) / api->n_writes);
+   else
+      VG_(strcat)(bufRW, "Inf");
+
    VG_(umsg)("acc-ratios:  %s rd, %s wr "
-             " (%'llu b-read, %'llu b-written)\n",
+             " (%'llu b-read, %'llu b-written, %s rd/wr)\n",
              bufR, bufW,
-             api->n_reads, api->n_writes);
+             api->n_reads, api->n_writes, bufRW);
+
+   if (api->lines_touched > 0) {
+      // Percentage of the bytes in touched lines that were used.
+      HChar bufU[16];
+      show_N_div_100(bufU, (10000ULL * api->line_bytes_touched)
+                              / (api->lines_touched * LINE_SZB));
+      VG_(umsg)("line-util:   %s%% of %d-byte lines used "
+                "(%'llu lines touched, %'llu untouched)\n",
+                bufU, LINE_SZB, api->lines_touched,
+                api->lines_tot - api->lines_touched);
+   } else if (api->lines_tot > 0) {
+      VG_(umsg)("line-util:   none (%'llu lines, none touched)\n",
+                api->lines_tot);
+   }
+
+   if (clo_cache_sim) {
+      VG_(umsg)("cache-miss:  D1 %'llu rd, %'llu wr;  LL %'llu rd, %'llu wr\n",
+                api->D1mr, api->D1mw, api->DLmr, api->DLmw);
+   }
 
    VG_(pp_ExeContext)(api->ap);
 
@@ -1161,6 +1673,9 @@ static void show_APInfo ( APInfo* api )
          VG_(umsg)("%u ", api->histo[i]);
       }
       VG_(umsg)("\n");
+      show_hot_fields(api);
+      if (api->miss_histo)
+         show_miss_offsets(api);
    }
 }
 
@@ -1175,6 +1690,12 @@ static ULong get_metric__tot_bytes ( APInfo* api ) {
 static ULong get_metric__max_blocks_live ( APInfo* api ) {
    return api->max_blocks_live;
 }
+static ULong get_metric__D1_misses ( APInfo* api ) {
+   return api->D1mr + api->D1mw;
+}
+static ULong get_metric__LL_misses ( APInfo* api ) {
+   return api->DLmr + api->DLmw;
+}
 
 /* Given a string, return the metric-access function and also a Bool
    indicating whether we want increasing or decreasing values of the
@@ -1200,6 +1721,16 @@ static Bool identify_metric ( /*OUT*/ULong(**get_metricP)(APInfo*),
       *increasingP = False;
       return True;
    }
+   if (0 == VG_(strcmp)(metric_name, "d1-misses")) {
+      *get_metricP = get_metric__D1_misses;
+      *increasingP = False;
+      return True;
+   }
+   if (0 == VG_(strcmp)(metric_name, "ll-misses")) {
+      *get_metricP = get_metric__LL_misses;
+      *increasingP = False;
+      return True;
+   }
    return False;
 }
 
@@ -1265,6 +1796,103 @@ static void show_top_n_apinfos ( void )
 }
 
 
+/* With --cache-sim=yes, write the misses of each AP in Cachegrind's
+   output format, so that cg_annotate can show them against the source
+   lines that allocate the blocks.  An AP is put at its first frame
+   below the allocation function itself.  Misses outside heap blocks
+   aren't in the file. */
+#define FILE_LEN  VKI_PATH_MAX
+#define FN_LEN    256
+
+static void write_cache_out_file ( void )
+{
+   Int    i, fd;
+   SysRes sres;
+   HChar  buf[512];
+   HChar  file[FILE_LEN], dir[FILE_LEN], fn[FN_LEN];
+   UInt   line;
+   Bool   found_dirname;
+   UWord  keyW, valW;
+   ULong  tot_D1mr = 0, tot_D1mw = 0, tot_DLmr = 0, tot_DLmw = 0;
+
+   HChar* cache_out_file =
+      VG_(expand_file_name)("--cache-out-file", clo_cache_out_file);
+   sres = VG_(open)(cache_out_file, VKI_O_CREAT|VKI_O_TRUNC|VKI_O_WRONLY,
+                                    VKI_S_IRUSR|VKI_S_IWUSR);
+   if (sr_isError(sres)) {
+      VG_(umsg)("error: can't open cache miss output file '%s'\n",
+                cache_out_file);
+      VG_(free)(cache_out_file);
+      return;
+   }
+   fd = sr_Res(sres);
+   VG_(free)(cache_out_file);
+
+   VG_(sprintf)(buf, "desc: D1 cache:         %s\n"
+                     "desc: LL cache:         %s\n"
+                     "desc: Misses by the allocation point of the heap "
+                     "block accessed\n",
+                     D1.desc_line, LL.desc_line);
+   VG_(write)(fd, buf, VG_(strlen)(buf));
+
+   VG_(strcpy)(buf, "cmd: ");
+   VG_(write)(fd, buf, VG_(strlen)(buf));
+   VG_(write)(fd, VG_(args_the_exename), VG_(strlen)(VG_(args_the_exename)));
+   for (i = 0; i < VG_(sizeXA)( VG_(args_for_client) ); i++) {
+      HChar* arg = * (HChar**) VG_(indexXA)( VG_(args_for_client), i );
+      if (arg) {
+         VG_(write)(fd, " ", 1);
+         VG_(write)(fd, arg, VG_(strlen)(arg));
+      }
+   }
+   VG_(strcpy)(buf, "\nevents: D1mr D1mw DLmr DLmw\n");
+   VG_(write)(fd, buf, VG_(strlen)(buf));
+
+   VG_(initIterFM)( apinfo );
+   while (VG_(nextIterFM)( apinfo, &keyW, &valW )) {
+      APInfo* api  = (APInfo*)valW;
+      Addr*   ips  = VG_(get_ExeContext_StackTrace)(api->ap);
+      UInt    n    = VG_(get_ExeContext_n_ips)(api->ap);
+      Addr    ip   = n > 1 ? ips[1] : ips[0];
+
+      if (api->D1mr + api->D1mw == 0)
+         continue;
+
+      if (!VG_(get_filename_linenum)(ip, file, FILE_LEN,
+                                     dir, FILE_LEN, &found_dirname,
+                                     &line)) {
+         VG_(strcpy)(file, "???");
+         line = 0;
+      } else if (found_dirname
+                 && VG_(strlen)(dir) + VG_(strlen)(file) + 1 < FILE_LEN) {
+         VG_(strcat)(dir, "/");
+         VG_(strcat)(dir, file);
+         VG_(strcpy)(file, dir);
+      }
+      if (!VG_(get_fnname)(ip, fn, FN_LEN))
+         VG_(strcpy)(fn, "???");
+
+      VG_(write)(fd, "fl=", 3);
+      VG_(write)(fd, file, VG_(strlen)(file));
+      VG_(write)(fd, "\nfn=", 4);
+      VG_(write)(fd, fn, VG_(strlen)(fn));
+      VG_(sprintf)(buf, "\n%u %llu %llu %llu %llu\n", line,
+                   api->D1mr, api->D1mw, api->DLmr, api->DLmw);
+      VG_(write)(fd, buf, VG_(strlen)(buf));
+
+      tot_D1mr += api->D1mr;
+      tot_D1mw += api->D1mw;
+      tot_DLmr += api->DLmr;
+      tot_DLmw += api->DLmw;
+   }
+   VG_(doneIterFM)( apinfo );
+
+   VG_(sprintf)(buf, "summary: %llu %llu %llu %llu\n",
+                tot_D1mr, tot_D1mw, tot_DLmr, tot_DLmw);
+   VG_(write)(fd, buf, VG_(strlen)(buf));
+   VG_(close)(fd);
+}
+
 static void dh_fini(Int exit_status)
 {
    // Before printing statistics, we must harvest access counts for
@@ -1272,15 +1900,23 @@ static void dh_fini(Int exit_status)
    // access ratios which are too low (zero, in the worst case)
    // for such blocks, since the accesses that do get made will
    // (if we skip this step) not get folded into the AP summaries.
-   UWord keyW, valW;
-   VG_(initIterFM)( interval_tree );
-   while (VG_(nextIterFM)( interval_tree, &keyW, &valW )) {
-      Block* bk = (Block*)keyW;
-      tl_assert(valW == 0);
-      tl_assert(bk);
-      retire_Block(bk, False/*!because_freed*/);
+   // Each block is retired from the page holding its start.
+   PageBlocks* pb;
+   VG_(HT_ResetIter)( page_map );
+   while ((pb = VG_(HT_Next)( page_map ))) {
+      UInt i;
+      for (i = 0; i < pb->n_blocks; i++) {
+         Block* bk = pb->blocks[i];
+         tl_assert(bk);
+         if ((bk->payload >> PAGE_MAP_BITS) == pb->key)
+            retire_Block(bk, False/*!because_freed*/);
+      }
    }
-   VG_(doneIterFM)( interval_tree );
+   UWord keyW, valW;
+   VG_(initIterFM)( big_blocks );
+   while (VG_(nextIterFM)( big_blocks, &keyW, &valW ))
+      retire_Block((Block*)keyW, False/*!because_freed*/);
+   VG_(doneIterFM)( big_blocks );
 
    // show results
    VG_(umsg)("======== SUMMARY STATISTICS ========\n");
@@ -1298,6 +1934,16 @@ static void dh_fini(Int exit_status)
                 g_guest_instrs_executed / g_tot_bytes);
       VG_(umsg)("\n");
    }
+   if (clo_cache_sim) {
+      VG_(umsg)("D1 misses:    %'llu rd, %'llu wr "
+                "(%'llu rd, %'llu wr in heap blocks)\n",
+                g_D1mr, g_D1mw, g_heap_D1mr, g_heap_D1mw);
+      VG_(umsg)("LL misses:    %'llu rd, %'llu wr "
+                "(%'llu rd, %'llu wr in heap blocks)\n",
+                g_DLmr, g_DLmw, g_heap_DLmr, g_heap_DLmw);
+      VG_(umsg)("\n");
+      write_cache_out_file();
+   }
 
    show_top_n_apinfos();
 
@@ -1329,6 +1975,10 @@ static void dh_fini(Int exit_status)
                 stats__n_fBc_cached,
                 stats__n_fBc_uncached);
       VG_(dmsg)("          notfound: %'lu\n", stats__n_fBc_notfound);
+      VG_(dmsg)(" dhat: page map: %'lu pages (max %'lu)\n",
+                stats__n_page_map_pages, stats__max_page_map_pages);
+      VG_(dmsg)(" dhat: big blocks: %'lu (max %'lu)\n",
+                n_big_blocks, stats__max_big_blocks);
       VG_(dmsg)("\n");
    }
 }
@@ -1340,6 +1990,15 @@ static void dh_fini(Int exit_status)
 
 static void dh_post_clo_init(void)
 {
+   if (clo_cache_sim) {
+      cache_t I1c, D1c, LLc;
+      VG_(post_clo_init_configure_caches)(&I1c, &D1c, NULL, &LLc,
+                                          &clo_I1_cache,
+                                          &clo_D1_cache,
+                                          NULL,
+                                          &clo_LL_cache);
+      cachesim_initcaches(I1c, D1c, NULL, LLc, False);
+   }
 }
 
 static void dh_pre_clo_init(void)
@@ -1380,14 +2039,15 @@ static void dh_pre_clo_init(void)
    //VG_(track_pre_mem_read_asciiz) ( check_mem_is_defined_asciiz );
    VG_(track_post_mem_write)      ( dh_handle_noninsn_write );
 
-   tl_assert(!interval_tree);
+   tl_assert(!page_map);
    tl_assert(!fbc_cache0);
    tl_assert(!fbc_cache1);
 
-   interval_tree = VG_(newFM)( VG_(malloc),
-                               "dh.main.interval_tree.1",
-                               VG_(free),
-                               interval_tree_Cmp );
+   page_map = VG_(HT_construct)( "dh.main.page_map.1" );
+   big_blocks = VG_(newFM)( VG_(malloc),
+                            "dh.main.big_blocks.1",
+                            VG_(free),
+                            big_blocks_Cmp );
 
    apinfo = VG_(newFM)( VG_(malloc),
                         "dh.main.apinfo.1",
@@ -0,0 +1,24 @@
+#include <stdlib.h>
+
+/* Writes to every 64-byte line of a block twice the size of the
+   simulated D1, four times over: every write misses in D1, but only
+   the first round misses in LL.  Only the first write to the small
+   block misses; the reads of it hit. */
+
+#define BIG_SIZE (64 * 1024)
+
+int main(void)
+{
+   int   i, r;
+   char* big   = malloc(BIG_SIZE);
+   char* small = malloc(64);
+
+   small[0] = 1;
+   for (r = 0; r < 4; r++)
+      for (i = 0; i < BIG_SIZE; i += 64)
+         big[i] = small[0];
+
+   free(small);
+   free(big);
+   return 0;
+}
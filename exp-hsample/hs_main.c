@@ -0,0 +1,485 @@
+//--------------------------------------------------------------------*/
+//--- HSample: a sampling heap profiler                  hs_main.c ---*/
+//--------------------------------------------------------------------*/
+
+/*
+   This file is part of HSample, a Valgrind tool for sampling the
+   heap allocations of programs.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of the
+   License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+   02111-1307, USA.
+
+   The GNU General Public License is contained in the file COPYING.
+*/
+
+// HSample replaces malloc et al like DHAT and Massif do, but leaves
+// the client's code uninstrumented, as Nulgrind does, and only looks
+// at a sample of the allocations.  An allocation is sampled when the
+// bytes allocated since the last sampled one reach a distance drawn
+// from an exponential distribution with mean --sample-bytes (Poisson
+// sampling by bytes, as tcmalloc's heap profiler does).  Only sampled
+// blocks get a stack trace and are tracked until freed.  At exit the
+// samples are written as a heap profile in the legacy text format
+// that pprof reads, which undoes the sampling itself.
+
+#include "pub_tool_basics.h"
+#include "pub_tool_vki.h"
+#include "pub_tool_execontext.h"
+#include "pub_tool_hashtable.h"
+#include "pub_tool_libcbase.h"
+#include "pub_tool_libcassert.h"
+#include "pub_tool_libcfile.h"
+#include "pub_tool_libcprint.h"
+#include "pub_tool_libcproc.h"
+#include "pub_tool_mallocfree.h"
+#include "pub_tool_options.h"
+#include "pub_tool_replacemalloc.h"
+#include "pub_tool_tooliface.h"
+
+#define HS_BUF_LEN 1024
+
+
+//------------------------------------------------------------//
+//--- Globals                                              ---//
+//------------------------------------------------------------//
+
+// The mean distance in bytes between sampled allocations.
+static Long clo_sample_bytes = 512 * 1024;
+
+static const HChar* clo_hsample_out_file = "hsample.out.%p";
+
+// Bytes still to be allocated before the next sampled allocation.
+static Long bytes_until_sample = 0;
+
+static UInt sample_seed = 0x5eed;
+
+// Counts for the stats.
+static ULong g_n_allocs  = 0;
+static ULong g_n_samples = 0;
+
+
+//------------------------------------------------------------//
+//--- Sampling                                             ---//
+//------------------------------------------------------------//
+
+// The natural logarithm of x > 0.  With x = m * 2^e and m in [1,2),
+// ln(m) is 2 * atanh((m-1)/(m+1)), whose series converges quickly as
+// its argument is at most 1/3.
+static double hs_log ( double x )
+{
+   union { double d; ULong u; } v;
+   double t, t2, term, sum = 0.0;
+   Int e, k;
+
+   v.d = x;
+   e   = (Int)((v.u >> 52) & 0x7FF) - 1023;
+   v.u = (v.u & 0x000FFFFFFFFFFFFFULL) | 0x3FF0000000000000ULL;
+
+   t    = (v.d - 1.0) / (v.d + 1.0);
+   t2   = t * t;
+   term = t;
+   for (k = 1; k <= 19; k += 2) {
+      sum  += term / k;
+      term *= t2;
+   }
+   return e * 0.69314718055994530942 + 2.0 * sum;
+}
+
+// The distance to the next sampled allocation: an exponentially
+// distributed number of bytes with mean clo_sample_bytes.
+static Long pick_next_sample ( void )
+{
+   // A uniform number in (0,1].
+   double u = ((double)(VG_(random)(&sample_seed) & 0x7FFFFFFF) + 1.0)
+              / 2147483648.0;
+   return (Long)(-hs_log(u) * (double)clo_sample_bytes) + 1;
+}
+
+
+//------------------------------------------------------------//
+//--- Sampled blocks and their allocation points           ---//
+//------------------------------------------------------------//
+
+// The samples taken at one allocation point.  Nb: first two fields
+// must match core's VgHashNode.
+typedef
+   struct _APSamples {
+      struct _APSamples* next;
+      UWord       ecu;
+      ExeContext* ec;
+      ULong       alloc_n;       // sampled blocks allocated
+      ULong       alloc_szB;
+      ULong       inuse_n;       // sampled blocks not yet freed
+      ULong       inuse_szB;
+   }
+   APSamples;
+
+// A sampled block which is still live.  Nb: first two fields must
+// match core's VgHashNode.
+typedef
+   struct _SampledBlock {
+      struct _SampledBlock* next;
+      Addr       payload;
+      SizeT      req_szB;
+      APSamples* ap;
+   }
+   SampledBlock;
+
+static VgHashTable ap_samples = NULL;
+static VgHashTable sampled_blocks = NULL;
+
+static APSamples* get_APSamples ( ExeContext* ec )
+{
+   UWord      ecu = VG_(get_ECU_from_ExeContext)(ec);
+   APSamples* ap  = VG_(HT_lookup)(ap_samples, ecu);
+
+   if (ap == NULL) {
+      ap = VG_(malloc)("hs.main.ga.1", sizeof(APSamples));
+      VG_(memset)(ap, 0, sizeof(APSamples));
+      ap->ecu = ecu;
+      ap->ec  = ec;
+      VG_(HT_add_node)(ap_samples, ap);
+   }
+   return ap;
+}
+
+static void sample_block ( ThreadId tid, Addr p, SizeT req_szB )
+{
+   ExeContext*   ec = VG_(record_ExeContext)(tid, 0/*first_ip_delta*/);
+   APSamples*    ap = get_APSamples(ec);
+   SampledBlock* sb = VG_(malloc)("hs.main.sb.1", sizeof(SampledBlock));
+
+   ap->alloc_n++;
+   ap->alloc_szB += req_szB;
+   ap->inuse_n++;
+   ap->inuse_szB += req_szB;
+
+   sb->payload = p;
+   sb->req_szB = req_szB;
+   sb->ap      = ap;
+   VG_(HT_add_node)(sampled_blocks, sb);
+   g_n_samples++;
+}
+
+static void unsample_block ( Addr p )
+{
+   SampledBlock* sb = VG_(HT_remove)(sampled_blocks, p);
+   if (sb == NULL)
+      return;
+
+   tl_assert(sb->ap->inuse_n > 0);
+   sb->ap->inuse_n--;
+   sb->ap->inuse_szB -= sb->req_szB;
+   VG_(free)(sb);
+}
+
+
+//------------------------------------------------------------//
+//--- malloc() et al replacement wrappers                  ---//
+//------------------------------------------------------------//
+
+static
+void* new_block ( ThreadId tid, SizeT req_szB, SizeT req_alignB,
+                  Bool is_zeroed )
+{
+   void* p = VG_(cli_malloc)(req_alignB, req_szB);
+   if (p == NULL)
+      return NULL;
+   if (is_zeroed)
+      VG_(memset)(p, 0, req_szB);
+
+   g_n_allocs++;
+   bytes_until_sample -= req_szB;
+   if (UNLIKELY(bytes_until_sample <= 0)) {
+      sample_block(tid, (Addr)p, req_szB);
+      bytes_until_sample = pick_next_sample();
+   }
+   return p;
+}
+
+static void die_block ( void* p )
+{
+   if (p == NULL)
+      return;
+   if (VG_(HT_count_nodes)(sampled_blocks) > 0)
+      unsample_block((Addr)p);
+   VG_(cli_free)(p);
+}
+
+static void* hs_malloc ( ThreadId tid, SizeT szB )
+{
+   return new_block( tid, szB, VG_(clo_alignment), /*is_zeroed*/False );
+}
+
+static void* hs___builtin_new ( ThreadId tid, SizeT szB )
+{
+   return new_block( tid, szB, VG_(clo_alignment), /*is_zeroed*/False );
+}
+
+static void* hs___builtin_vec_new ( ThreadId tid, SizeT szB )
+{
+   return new_block( tid, szB, VG_(clo_alignment), /*is_zeroed*/False );
+}
+
+static void* hs_calloc ( ThreadId tid, SizeT m, SizeT szB )
+{
+   return new_block( tid, m*szB, VG_(clo_alignment), /*is_zeroed*/True );
+}
+
+static void *hs_memalign ( ThreadId tid, SizeT alignB, SizeT szB )
+{
+   return new_block( tid, szB, alignB, False );
+}
+
+static void hs_free ( ThreadId tid __attribute__((unused)), void* p )
+{
+   die_block( p );
+}
+
+static void hs___builtin_delete ( ThreadId tid, void* p )
+{
+   die_block( p );
+}
+
+static void hs___builtin_vec_delete ( ThreadId tid, void* p )
+{
+   die_block( p );
+}
+
+static void* hs_realloc ( ThreadId tid, void* p_old, SizeT new_szB )
+{
+   void* p_new;
+   SizeT old_szB;
+
+   if (p_old == NULL) {
+      return hs_malloc(tid, new_szB);
+   }
+   if (new_szB == 0) {
+      hs_free(tid, p_old);
+      return NULL;
+   }
+
+   p_new = new_block( tid, new_szB, VG_(clo_alignment), False );
+   if (p_new == NULL)
+      return NULL;
+   old_szB = VG_(malloc_usable_size)(p_old);
+   VG_(memcpy)(p_new, p_old, old_szB < new_szB ? old_szB : new_szB);
+   die_block( p_old );
+   return p_new;
+}
+
+static SizeT hs_malloc_usable_size ( ThreadId tid, void* p )
+{
+   return VG_(malloc_usable_size)(p);
+}
+
+
+//------------------------------------------------------------//
+//--- Instrumentation                                      ---//
+//------------------------------------------------------------//
+
+static
+IRSB* hs_instrument ( VgCallbackClosure* closure,
+                      IRSB* bb,
+                      VexGuestLayout* layout,
+                      VexGuestExtents* vge,
+                      VexArchInfo* archinfo_host,
+                      IRType gWordTy, IRType hWordTy )
+{
+   return bb;
+}
+
+
+//------------------------------------------------------------//
+//--- Command line args                                    ---//
+//------------------------------------------------------------//
+
+static Bool hs_process_cmd_line_option(const HChar* arg)
+{
+   if VG_BINT_CLO(arg, "--sample-bytes", clo_sample_bytes, 1, 1LL << 40) {}
+   else if VG_STR_CLO(arg, "--hsample-out-file", clo_hsample_out_file) {}
+   else
+      return VG_(replacement_malloc_process_cmd_line_option)(arg);
+
+   return True;
+}
+
+static void hs_print_usage(void)
+{
+   VG_(printf)(
+"    --sample-bytes=<number>       mean bytes allocated between sampled\n"
+"                                  allocations [524288]\n"
+"    --hsample-out-file=<file>     output file name [hsample.out.%%p]\n"
+   );
+}
+
+static void hs_print_debug_usage(void)
+{
+   VG_(printf)(
+"    (none)\n"
+   );
+}
+
+
+//------------------------------------------------------------//
+//--- Finalisation                                         ---//
+//------------------------------------------------------------//
+
+static void hs_printf ( Int fd, const HChar* format, ... )
+{
+   static HChar buf[HS_BUF_LEN];
+   va_list vargs;
+   va_start(vargs, format);
+   VG_(vsnprintf)(buf, HS_BUF_LEN, format, vargs);
+   va_end(vargs);
+   VG_(write)(fd, buf, VG_(strlen)(buf));
+}
+
+// Copies our /proc/self/maps, which is the client's too, so that
+// pprof can find the objects the addresses are in.
+static void write_mapped_libraries ( Int fd )
+{
+   HChar  buf[HS_BUF_LEN];
+   Int    n, maps_fd;
+   SysRes sres = VG_(open)("/proc/self/maps", VKI_O_RDONLY, 0);
+
+   hs_printf(fd, "\nMAPPED_LIBRARIES:\n");
+   if (sr_isError(sres))
+      return;
+   maps_fd = sr_Res(sres);
+   while ((n = VG_(read)(maps_fd, buf, sizeof(buf))) > 0)
+      VG_(write)(fd, buf, n);
+   VG_(close)(maps_fd);
+}
+
+static void write_profile ( void )
+{
+   HChar*     out_file = VG_(expand_file_name)("--hsample-out-file",
+                                               clo_hsample_out_file);
+   SysRes     sres     = VG_(open)(out_file,
+                                   VKI_O_CREAT|VKI_O_TRUNC|VKI_O_WRONLY,
+                                   VKI_S_IRUSR|VKI_S_IWUSR);
+   APSamples* ap;
+   ULong      inuse_n = 0, inuse_szB = 0, alloc_n = 0, alloc_szB = 0;
+   Int        fd, i, n_ips;
+
+   if (sr_isError(sres)) {
+      VG_(umsg)("error: can't open output file '%s'\n", out_file);
+      VG_(umsg)("       ... so the heap profile will be missing.\n");
+      VG_(free)(out_file);
+      return;
+   }
+   fd = sr_Res(sres);
+   if (VG_(clo_verbosity) > 0)
+      VG_(umsg)("Writing the heap profile to %s\n", out_file);
+   VG_(free)(out_file);
+
+   VG_(HT_ResetIter)(ap_samples);
+   while ( (ap = VG_(HT_Next)(ap_samples)) ) {
+      inuse_n   += ap->inuse_n;
+      inuse_szB += ap->inuse_szB;
+      alloc_n   += ap->alloc_n;
+      alloc_szB += ap->alloc_szB;
+   }
+   hs_printf(fd, "heap profile: %llu: %llu [%llu: %llu] @ heap_v2/%lld\n",
+             inuse_n, inuse_szB, alloc_n, alloc_szB, clo_sample_bytes);
+
+   VG_(HT_ResetIter)(ap_samples);
+   while ( (ap = VG_(HT_Next)(ap_samples)) ) {
+      Addr* ips = VG_(get_ExeContext_StackTrace)(ap->ec);
+      n_ips = VG_(get_ExeContext_n_ips)(ap->ec);
+
+      hs_printf(fd, "%llu: %llu [%llu: %llu] @",
+                ap->inuse_n, ap->inuse_szB, ap->alloc_n, ap->alloc_szB);
+      // Leave out the first entry, which is in our malloc replacement.
+      for (i = 1; i < n_ips; i++)
+         hs_printf(fd, " 0x%lx", ips[i]);
+      hs_printf(fd, "\n");
+   }
+
+   write_mapped_libraries(fd);
+   VG_(close)(fd);
+}
+
+static void hs_fini(Int exit_status)
+{
+   write_profile();
+
+   if (VG_(clo_stats)) {
+      VG_(dmsg)(" hsample: %'llu allocations, %'llu sampled, "
+                "%'d allocation points\n",
+                g_n_allocs, g_n_samples, VG_(HT_count_nodes)(ap_samples));
+   }
+}
+
+
+//------------------------------------------------------------//
+//--- Initialisation                                       ---//
+//------------------------------------------------------------//
+
+static void hs_post_clo_init(void)
+{
+   sample_seed = VG_(getpid)();
+   bytes_until_sample = pick_next_sample();
+}
+
+static void hs_pre_clo_init(void)
+{
+   VG_(details_name)            ("HSample");
+   VG_(details_version)         (NULL);
+   VG_(details_description)     ("a sampling heap profiler");
+   VG_(details_copyright_author)(
+      "Copyright (C) 2015, and GNU GPL'd, by the Valgrind developers.");
+   VG_(details_bug_reports_to)  (VG_BUGS_TO);
+
+   VG_(details_avg_translation_sizeB) ( 275 );
+
+   // Basic functions.
+   VG_(basic_tool_funcs)          (hs_post_clo_init,
+                                   hs_instrument,
+                                   hs_fini);
+
+   // Needs.
+   VG_(needs_libc_freeres)();
+   VG_(needs_command_line_options)(hs_process_cmd_line_option,
+                                   hs_print_usage,
+                                   hs_print_debug_usage);
+   VG_(needs_malloc_replacement)  (hs_malloc,
+                                   hs___builtin_new,
+                                   hs___builtin_vec_new,
+                                   hs_memalign,
+                                   hs_calloc,
+                                   hs_free,
+                                   hs___builtin_delete,
+                                   hs___builtin_vec_delete,
+                                   hs_realloc,
+                                   hs_malloc_usable_size,
+                                   0 );
+
+   // The translations are left as they are, as Nulgrind's, so they
+   // can be kept across runs and run by several threads at once: the
+   // allocation functions are called with the_BigLock held.
+   VG_(needs_persistent_translations) ();
+   VG_(needs_thread_safe_instrumentation) ();
+
+   ap_samples     = VG_(HT_construct)( "hs.main.ap_samples.1" );
+   sampled_blocks = VG_(HT_construct)( "hs.main.sampled_blocks.1" );
+}
+
+VG_DETERMINE_INTERFACE_VERSION(hs_pre_clo_init)
+
+//--------------------------------------------------------------------//
+//--- end                                                hs_main.c ---//
+//--------------------------------------------------------------------//
@@ -0,0 +1,42 @@
+#include <stdlib.h>
+
+// With --sample-bytes=1 every allocation of more than a few bytes is
+// sampled, so the profile has them all: 5 of the 10 blocks from
+// alloc_some still in use, the one from alloc_big, and none of the
+// 3 from alloc_zeroed.
+
+static void* blocks[10];
+
+__attribute__((noinline))
+static void alloc_some ( void )
+{
+   int i;
+   for (i = 0; i < 10; i++)
+      blocks[i] = malloc(100);
+   for (i = 0; i < 10; i += 2)
+      free(blocks[i]);
+}
+
+__attribute__((noinline))
+static void* alloc_big ( void )
+{
+   return malloc(1000);
+}
+
+__attribute__((noinline))
+static void alloc_zeroed ( void )
+{
+   int i;
+   for (i = 0; i < 3; i++)
+      free(calloc(4, 50));
+}
+
+int main ( void )
+{
+   void* big;
+
+   alloc_some();
+   big = alloc_big();
+   alloc_zeroed();
+   return big == NULL;
+}
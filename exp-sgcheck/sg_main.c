@@ -989,7 +989,18 @@ static void show_Invar( HChar* buf, Word nBuf, Invar* inv, Word depth )
 //////////////////////////////////////////////////////////////
 ///
 
-#define N_QCACHE 16
+/* The number of entries in a query cache starts at N_QCACHE_INIT and
+   is adjusted between N_QCACHE_MIN and N_QCACHE_MAX, according to
+   how well it is doing, every QCACHE_RESIZE_EVERY queries. */
+#define N_QCACHE_MIN   4
+#define N_QCACHE_INIT 16
+#define N_QCACHE_MAX  64
+
+#define QCACHE_RESIZE_EVERY 65536
+
+/* After growing a cache didn't help, don't try again for this many
+   resizing periods. */
+#define QCACHE_BACKOFF 16
 
 /* Powers of two only, else the result will be chaos */
 #define QCACHE_ADVANCE_EVERY 16
@@ -1007,13 +1018,32 @@ typedef
 typedef
    struct {
       Word   nInUse;
-      QCElem elems[N_QCACHE];
+      Word   nMax;     /* current size, <= N_QCACHE_MAX */
+      /* Incremented whenever the cache is invalidated, that is,
+         whenever the thread's stack block tree or the global tree
+         changes; the per-instruction caches (IInstance.ok_*) are only
+         valid while it stays the same. */
+      UWord  gen;
+      /* For deciding on the size; since the last decision. */
+      UWord  nQueries;
+      UWord  nMisses;
+      UWord  nEvictions;  /* misses that pushed out an entry */
+      UWord  prevMisses;  /* nMisses before the last grow, if any */
+      Bool   justGrew;
+      UWord  backoff;
+      QCElem elems[N_QCACHE_MAX];
    }
    QCache;
 
 static void QCache__invalidate ( QCache* qc ) {
    tl_assert(qc->nInUse >= 0);
    qc->nInUse = 0;
+   qc->gen++;
+}
+
+static void QCache__init ( QCache* qc ) {
+   VG_(memset)(qc, 0, sizeof(QCache) - sizeof(qc->elems));
+   qc->nMax = N_QCACHE_INIT;
 }
 
 static void QCache__pp ( QCache* qc, const HChar* who )
@@ -1031,6 +1061,47 @@ static void QCache__pp ( QCache* qc, const HChar* who )
 static ULong stats__qcache_queries = 0;
 static ULong stats__qcache_misses  = 0;
 static ULong stats__qcache_probes  = 0;
+static ULong stats__qcache_grows   = 0;
+static ULong stats__qcache_shrinks = 0;
+
+/* Called every QCACHE_RESIZE_EVERY queries, to resize the cache.
+   Misses which push an entry out are the ones a bigger cache could
+   avoid, but every entry makes misses, and hits far down, slower to
+   find.  So grow when there are a lot of those, and go back if that
+   didn't cut the misses much; shrink when there are none and the
+   cache isn't filling up anyway. */
+static void QCache__resize ( QCache* qc )
+{
+   if (qc->backoff > 0)
+      qc->backoff--;
+
+   if (qc->justGrew) {
+      qc->justGrew = False;
+      if (4 * qc->nMisses > 3 * qc->prevMisses) {
+         qc->nMax /= 2;
+         qc->backoff = QCACHE_BACKOFF;
+         stats__qcache_shrinks++;
+      }
+   }
+   else if (64 * qc->nEvictions > qc->nQueries
+            && qc->nMax < N_QCACHE_MAX && qc->backoff == 0) {
+      qc->nMax *= 2;
+      qc->prevMisses = qc->nMisses;
+      qc->justGrew = True;
+      stats__qcache_grows++;
+   }
+   else if (qc->nEvictions == 0 && qc->nMax > N_QCACHE_MIN
+            && 2 * qc->nInUse <= qc->nMax) {
+      qc->nMax /= 2;
+      stats__qcache_shrinks++;
+   }
+
+   if (qc->nInUse > qc->nMax)
+      qc->nInUse = qc->nMax;
+   qc->nQueries   = 0;
+   qc->nMisses    = 0;
+   qc->nEvictions = 0;
+}
 
 ///
 //////////////////////////////////////////////////////////////
@@ -1039,11 +1110,11 @@ static ULong stats__qcache_probes  = 0;
    * a shadow stack of StackFrames, which is a double-linked list
    * an stack block interval tree
 */
-static  struct _StackFrame*          shadowStacks[VG_N_THREADS];
+static  struct _StackFrame**         shadowStacks; /* [VG_N_THREADS] */
 
-static  WordFM* /* StackTreeNode */  siTrees[VG_N_THREADS];
+static  WordFM** /* StackTreeNode */ siTrees;      /* [VG_N_THREADS] */
 
-static  QCache                       qcaches[VG_N_THREADS];
+static  QCache*                      qcaches;      /* [VG_N_THREADS] */
 
 
 /* Additionally, there is one global variable interval tree
@@ -1063,11 +1134,17 @@ static void invalidate_all_QCaches ( void )
 static void ourGlobals_init ( void )
 {
    Word i;
+   shadowStacks = sg_malloc("di.sg_main.oGi.2",
+                            VG_N_THREADS * sizeof shadowStacks[0]);
+   siTrees      = sg_malloc("di.sg_main.oGi.3",
+                            VG_N_THREADS * sizeof siTrees[0]);
+   qcaches      = sg_malloc("di.sg_main.oGi.4",
+                            VG_N_THREADS * sizeof qcaches[0]);
    for (i = 0; i < VG_N_THREADS; i++) {
       shadowStacks[i] = NULL;
       siTrees[i] = NULL;
+      QCache__init( &qcaches[i] );
    }
-   invalidate_all_QCaches();
    giTree = VG_(newFM)( sg_malloc, "di.sg_main.oGi.1", sg_free, 
                         (Word(*)(UWord,UWord))cmp_intervals_GlobalTreeNode );
 }
@@ -1101,6 +1178,11 @@ static void acquire_globals ( ULong di_handle )
       add_block_to_GlobalTree( giTree, gbp );
    }
 
+   /* The caches may say that some of the new blocks' addresses are
+      in no block at all. */
+   if (n > 0)
+      invalidate_all_QCaches();
+
    VG_(deleteXA)( gbs );
 }
 
@@ -1175,6 +1257,9 @@ static ULong stats__htab_fast        = 0;
 static ULong stats__htab_searches    = 0;
 static ULong stats__htab_probes      = 0;
 static ULong stats__htab_resizes     = 0;
+static ULong stats__ok_range_hits    = 0;
+static ULong stats__static_elided    = 0;
+static ULong stats__static_checked   = 0;
 
 
 /* A dynamic instance of an instruction */
@@ -1185,6 +1270,17 @@ typedef
       XArray* blocks; /* XArray* of StackBlock, or NULL if none */
       /* MUTABLE */
       Invar invar;
+      /* A range of addresses, around the last access, which all fall
+         in the block (or in the space between blocks) described by
+         'invar'.  While SP and FP stay at ok_sp and ok_fp, and the
+         thread's query cache generation at ok_gen, an access entirely
+         within [ok_lo, ok_hi) can't be an error, and needs no more
+         checking.  Empty if ok_hi is zero. */
+      Addr  ok_lo;
+      Addr  ok_hi;
+      Addr  ok_sp;
+      Addr  ok_fp;
+      UWord ok_gen;
    }
    IInstance;
 
@@ -1437,6 +1533,7 @@ static IInstance* find_or_create_IInstance_SLOW (
    sf->htab[ix].insn_addr = ip;
    sf->htab[ix].blocks    = ip_frameblocks;
    sf->htab[ix].invar.tag = Inv_Unset;
+   sf->htab[ix].ok_hi     = 0;
    sf->htab_used++;
    return &sf->htab[ix];
 }
@@ -1462,6 +1559,7 @@ static IInstance* find_or_create_IInstance (
       sf->htab[ix].insn_addr = ip;
       sf->htab[ix].blocks    = ip_frameblocks;
       sf->htab[ix].invar.tag = Inv_Unset;
+      sf->htab[ix].ok_hi     = 0;
       sf->htab_used++;
       return &sf->htab[ix];
    }
@@ -1503,15 +1601,19 @@ static XArray* /* Addr */ calculate_StackBlock_EAs (
 
 /* Try to classify the block into which a memory access falls, and
    write the result in 'inv'.  This writes all relevant fields of
-   'inv'. */
+   'inv'.  Also write in [*lo, *hi) the extent of the block, or of the
+   space between blocks, that the access falls in, if known, or make
+   it empty (*hi == 0) if not. */
 __attribute__((noinline)) 
 static void classify_address ( /*OUT*/Invar* inv,
+                               /*OUT*/Addr* lo, /*OUT*/Addr* hi,
                                ThreadId tid,
                                Addr ea, Addr sp, Addr fp,
                                UWord szB,
                                XArray* /* of StackBlock */ thisInstrBlocks )
 {
    tl_assert(szB > 0);
+   *lo = *hi = 0;
    /* First, look in the stack blocks accessible in this instruction's
       frame. */
    { 
@@ -1526,6 +1628,8 @@ static void classify_address ( /*OUT*/Invar* inv,
            inv->Inv.Stack0.addr  = bea;
            inv->Inv.Stack0.szB   = descr->szB;
            inv->Inv.Stack0.descr = descr;
+           *lo = bea;
+           *hi = bea + descr->szB;
            stats__classify_Stack0++;
            return;
         }
@@ -1536,6 +1640,8 @@ static void classify_address ( /*OUT*/Invar* inv,
      QCache* cache = &qcaches[tid];
      static UWord ctr = 0;
      stats__qcache_queries++;
+     if (UNLIKELY(++cache->nQueries == QCACHE_RESIZE_EVERY))
+        QCache__resize(cache);
      for (i = 0; i < cache->nInUse; i++) {
         if (0) /* expensive in a loop like this */
                tl_assert(cache->elems[i].addr + cache->elems[i].szB != 0);
@@ -1551,10 +1657,13 @@ static void classify_address ( /*OUT*/Invar* inv,
               i--;
            }
            *inv = cache->elems[i].inv;
+           *lo  = cache->elems[i].addr;
+           *hi  = cache->elems[i].addr + cache->elems[i].szB;
            return;
         }
      }
      stats__qcache_misses++;
+     cache->nMisses++;
    }
    /* Ok, so it's not a block in the top frame.  Perhaps it's a block
       in some calling frame?  Consult this thread's stack-block
@@ -1739,8 +1848,10 @@ static void classify_address ( /*OUT*/Invar* inv,
        Word i;
        Word ip = cache->nInUse / 2; /* doesn't seem critical */
 
-       if (cache->nInUse < N_QCACHE)
+       if (cache->nInUse < cache->nMax)
           cache->nInUse++;
+       else
+          cache->nEvictions++;
        for (i = cache->nInUse-1; i > ip; i--) {
           cache->elems[i] = cache->elems[i-1];
        }
@@ -1749,6 +1860,8 @@ static void classify_address ( /*OUT*/Invar* inv,
        cache->elems[ip].addr = toadd_addr;
        cache->elems[ip].szB  = toadd_szB;
        cache->elems[ip].inv  = *inv;
+       *lo = toadd_addr;
+       *hi = toadd_addr + toadd_szB;
      }
 
      if (show) QCache__pp(cache, "after upd");
@@ -1757,6 +1870,46 @@ static void classify_address ( /*OUT*/Invar* inv,
 }
 
 
+/* Having classified an access as 'inv', and found that the block or
+   the space between blocks it is in is [lo, hi), remember in
+   'iinstance' which other accesses by the same instruction must be
+   classified the same way.  That is [lo, hi) less any of the
+   instruction's stack blocks but the one the access is in, since
+   those are looked at first; if the access overlaps one of them, it
+   is nothing. */
+static void set_ok_range ( IInstance* iinstance, Invar* inv,
+                           Addr lo, Addr hi,
+                           ThreadId tid, Addr ea, UWord szB,
+                           Addr sp, Addr fp )
+{
+   XArray* blocks = iinstance->blocks;
+   Word    i, nBlocks = VG_(sizeXA)( blocks );
+   StackBlock* mine
+      = inv->tag == Inv_Stack0 ? inv->Inv.Stack0.descr : NULL;
+
+   for (i = 0; i < nBlocks && hi != 0; i++) {
+      StackBlock* descr = VG_(indexXA)( blocks, i );
+      Addr bea, bend;
+      if (descr == mine)
+         continue;
+      bea  = calculate_StackBlock_EA( descr, sp, fp );
+      bend = bea + descr->szB;
+      if (bend <= ea) {
+         if (bend > lo) lo = bend;
+      } else if (ea + szB <= bea) {
+         if (bea < hi) hi = bea;
+      } else {
+         hi = 0;
+      }
+   }
+   iinstance->ok_lo  = lo;
+   iinstance->ok_hi  = hi;
+   iinstance->ok_sp  = sp;
+   iinstance->ok_fp  = fp;
+   iinstance->ok_gen = qcaches[tid].gen;
+}
+
+
 /* CALLED FROM GENERATED CODE */
 static 
 VG_REGPARM(3)
@@ -1769,6 +1922,7 @@ void helperc__mem_access ( /* Known only at run time: */
    IInstance* iinstance;
    Invar* inv;
    Invar new_inv;
+   Addr lo, hi;
    ThreadId tid = VG_(get_running_tid)();
    StackFrame* frame;
    HChar bufE[160], bufA[160], bufD[32];
@@ -1790,28 +1944,41 @@ void helperc__mem_access ( /* Known only at run time: */
 
    inv = &iinstance->invar;
 
+   /* The fast case: the access is in the same block, or the same
+      space between blocks, as an earlier one that was classified as
+      'inv'. */
+   if (LIKELY(iinstance->ok_lo <= ea && ea + szB <= iinstance->ok_hi
+              && iinstance->ok_sp == sp && iinstance->ok_fp == fp
+              && iinstance->ok_gen == qcaches[tid].gen)) {
+      stats__ok_range_hits++;
+      return;
+   }
+
    /* Deal with first uses of instruction instances. */
    if (inv->tag == Inv_Unset) {
       /* This is the first use of this instance of the instruction, so
          we can't make any check; we merely record what we saw, so we
          can compare it against what happens for 2nd and subsequent
          accesses. */
-      classify_address( inv,
+      classify_address( inv, &lo, &hi,
                         tid, ea, sp, fp, szB, iinstance->blocks );
       tl_assert(inv->tag != Inv_Unset);
+      set_ok_range( iinstance, inv, lo, hi, tid, ea, szB, sp, fp );
       return;
    }
 
    /* So generate an Invar and see if it's different from what
       we had before. */
-   classify_address( &new_inv,
+   classify_address( &new_inv, &lo, &hi,
                      tid, ea, sp, fp, szB, iinstance->blocks );
    tl_assert(new_inv.tag != Inv_Unset);
 
    /* Did we see something different from before?  If no, then there's
       no error. */
-   if (LIKELY(eq_Invar(&new_inv, inv)))
+   if (LIKELY(eq_Invar(&new_inv, inv))) {
+      set_ok_range( iinstance, &new_inv, lo, hi, tid, ea, szB, sp, fp );
       return;
+   }
 
    tl_assert(inv->tag != Inv_Unset);
 
@@ -1831,6 +1998,7 @@ void helperc__mem_access ( /* Known only at run time: */
    /* And now install the new observation as "standard", so as to
       make future error messages make more sense. */
    *inv = new_inv;
+   set_ok_range( iinstance, inv, lo, hi, tid, ea, szB, sp, fp );
 }
 
 
@@ -2070,6 +2238,10 @@ struct _SGEnv {
       we basically can't really handle properly; and so we ignore all
       but the first ref. */
    Bool firstRef;
+   /* Which IRTemps hold the SP or FP plus a constant, indexed by
+      IRTemp; see is_frame_slot. */
+   UChar* frameTemps;
+   Int    nFrameTemps;
    /* READONLY */
    IRTemp (*newIRTemp_cb)(IRType,void*);
    void* newIRTemp_opaque;
@@ -2114,6 +2286,63 @@ static IRTemp gen_Get_FP ( struct _SGEnv*  sge,
    return fp_temp;
 }
 
+/* The static pass: keep track of which IRTemps hold SP or FP plus a
+   constant.  An access at such an address is at a fixed place in the
+   frame, so each time the instruction runs in a given call it accesses
+   the same stack slot, or the same place in a calling frame, and it
+   can never be classified differently from the first time.  So there
+   is no need to check it.  Array accesses, which are what can overrun,
+   have an index or a pointer in the address. */
+static void note_frame_temp ( struct _SGEnv* sge, IRTemp t, IRExpr* e,
+                              VexGuestLayout* layout )
+{
+   Bool is = False;
+   switch (e->tag) {
+      case Iex_Get:
+         is = (e->Iex.Get.offset == layout->offset_SP
+               || e->Iex.Get.offset == layout->offset_FP)
+              && sizeofIRType(e->Iex.Get.ty) == layout->sizeof_SP;
+         break;
+      case Iex_RdTmp:
+         is = e->Iex.RdTmp.tmp < sge->nFrameTemps
+              && sge->frameTemps[e->Iex.RdTmp.tmp];
+         break;
+      case Iex_Binop:
+         switch (e->Iex.Binop.op) {
+            case Iop_Add32: case Iop_Add64:
+            case Iop_Sub32: case Iop_Sub64:
+               is = e->Iex.Binop.arg1->tag == Iex_RdTmp
+                    && e->Iex.Binop.arg2->tag == Iex_Const
+                    && e->Iex.Binop.arg1->Iex.RdTmp.tmp < sge->nFrameTemps
+                    && sge->frameTemps[e->Iex.Binop.arg1->Iex.RdTmp.tmp];
+               break;
+            default:
+               break;
+         }
+         break;
+      default:
+         break;
+   }
+   if (!is)
+      return;
+   if (t >= sge->nFrameTemps) {
+      Int n = 2 * t + 16;
+      sge->frameTemps = VG_(realloc)( "di.sg_main.nft.1",
+                                      sge->frameTemps, n );
+      VG_(memset)( sge->frameTemps + sge->nFrameTemps, 0,
+                   n - sge->nFrameTemps );
+      sge->nFrameTemps = n;
+   }
+   sge->frameTemps[t] = 1;
+}
+
+static Bool is_frame_slot ( struct _SGEnv* sge, IRExpr* addr )
+{
+   return addr->tag == Iex_RdTmp
+          && addr->Iex.RdTmp.tmp < sge->nFrameTemps
+          && sge->frameTemps[addr->Iex.RdTmp.tmp];
+}
+
 static void instrument_mem_access ( struct _SGEnv* sge,
                                     IRSB*   bbOut, 
                                     IRExpr* addr,
@@ -2129,6 +2358,12 @@ static void instrument_mem_access ( struct _SGEnv* sge,
    tl_assert(isIRAtom(addr));
    tl_assert(hWordTy_szB == 4 || hWordTy_szB == 8);
 
+   if (is_frame_slot( sge, addr )) {
+      stats__static_elided++;
+      return;
+   }
+   stats__static_checked++;
+
    tyAddr = typeOfIRExpr( bbOut->tyenv, addr );
    tl_assert(tyAddr == Ity_I32 || tyAddr == Ity_I64);
 
@@ -2183,6 +2418,8 @@ struct _SGEnv * sg_instrument_init ( IRTemp (*newIRTemp_cb)(IRType,void*),
    env->curr_IP          = 0;
    env->curr_IP_known    = False;
    env->firstRef         = True;
+   env->frameTemps       = NULL;
+   env->nFrameTemps      = 0;
    env->newIRTemp_cb     = newIRTemp_cb;
    env->newIRTemp_opaque = newIRTemp_opaque;
    return env;
@@ -2190,6 +2427,8 @@ struct _SGEnv * sg_instrument_init ( IRTemp (*newIRTemp_cb)(IRType,void*),
 
 void sg_instrument_fini ( struct _SGEnv * env )
 {
+   if (env->frameTemps)
+      VG_(free)(env->frameTemps);
    sg_free(env);
 }
 
@@ -2245,6 +2484,7 @@ void sg_instrument_IRStmt ( /*MOD*/struct _SGEnv * env,
 
       case Ist_WrTmp: {
          IRExpr* data = st->Ist.WrTmp.data;
+         note_frame_temp( env, st->Ist.WrTmp.tmp, data, layout );
          if (data->tag == Iex_Load) {
             tl_assert(env->curr_IP_known);
             if (env->firstRef) {
@@ -2534,6 +2774,18 @@ void sg_fini(Int exitcode)
       VG_(message)(Vg_DebugMsg, 
          " sg_:     qcache: %'llu searches, %'llu probes, %'llu misses\n",
          stats__qcache_queries, stats__qcache_probes, stats__qcache_misses);
+      VG_(message)(Vg_DebugMsg, 
+         " sg_:     qcache: %'llu grows, %'llu shrinks\n",
+         stats__qcache_grows, stats__qcache_shrinks);
+      VG_(message)(Vg_DebugMsg, 
+         " sg_:   ok-range: %'llu hits (%'llu%% of accesses)\n",
+         stats__ok_range_hits,
+         stats__total_accesses == 0 ? 0ULL
+            : 100 * stats__ok_range_hits / stats__total_accesses);
+      VG_(message)(Vg_DebugMsg, 
+         " sg_:     static: %'llu accesses checked, %'llu at fixed frame "
+         "offsets not\n",
+         stats__static_checked, stats__static_elided);
       VG_(message)(Vg_DebugMsg, 
          " sg_:  htab-fast: %'llu hits\n",
          stats__htab_fast);
@@ -86,6 +86,8 @@ UWord HG_(clo_vts_pruning) = 1;
 
 Bool  HG_(clo_check_stack_refs) = True;
 
+UWord HG_(clo_sample_rate) = 100;
+
 /*--------------------------------------------------------------------*/
 /*--- end                                              hg_basics.c ---*/
 /*--------------------------------------------------------------------*/
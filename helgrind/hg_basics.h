@@ -126,6 +126,13 @@ extern UWord HG_(clo_vts_pruning);
    the stack, which speeds things up a bit.  Default: True. */
 extern Bool HG_(clo_check_stack_refs); 
 
+/* Percentage of memory references which are race checked in hot
+   code.  Each superblock starts off fully checked and backs off
+   towards this rate the more often it runs.  Synchronisation events
+   are always tracked, so sampling can miss races but never invents
+   them.  Default: 100, meaning no sampling. */
+extern UWord HG_(clo_sample_rate);
+
 #endif /* ! __HG_BASICS_H */
 
 /*--------------------------------------------------------------------*/
@@ -613,6 +613,10 @@ PTH_FUNC(int, pthreadZumutexZulock, // pthread_mutex_lock
 // therefore not to complain if the lock is nonrecursive and 
 // already locked by this thread -- because then it'll just fail
 // immediately with EBUSY.
+//
+// For a trylock the pre-lock checks can't stop us blocking, so they
+// are done after the call instead, together with the post-lock
+// actions if it succeeded: one client request rather than two.
 PTH_FUNC(int, pthreadZumutexZutrylock, // pthread_mutex_trylock
               pthread_mutex_t *mutex)
 {
@@ -623,9 +627,6 @@ PTH_FUNC(int, pthreadZumutexZutrylock, // pthread_mutex_trylock
       fprintf(stderr, "<< pthread_mxtrylock %p", mutex); fflush(stderr);
    }
 
-   DO_CREQ_v_WW(_VG_USERREQ__HG_PTHREAD_MUTEX_LOCK_PRE,
-                pthread_mutex_t*,mutex, long,1/*isTryLock*/);
-
    CALL_FN_W_W(ret, fn, mutex);
 
    /* There's a hole here: libpthread now knows the lock is locked,
@@ -634,9 +635,11 @@ PTH_FUNC(int, pthreadZumutexZutrylock, // pthread_mutex_trylock
       this matter?  Not sure, but I don't think so. */
 
    if (ret == 0 /*success*/) {
-      DO_CREQ_v_W(_VG_USERREQ__HG_PTHREAD_MUTEX_LOCK_POST,
-                  pthread_mutex_t*,mutex);
+      DO_CREQ_v_WW(_VG_USERREQ__HG_PTHREAD_MUTEX_ACQUIRED,
+                   pthread_mutex_t*,mutex, long,1/*isTryLock*/);
    } else { 
+      DO_CREQ_v_WW(_VG_USERREQ__HG_PTHREAD_MUTEX_LOCK_PRE,
+                   pthread_mutex_t*,mutex, long,1/*isTryLock*/);
       if (ret != EBUSY)
          DO_PthAPIerror( "pthread_mutex_trylock", ret );
    }
@@ -665,9 +668,6 @@ PTH_FUNC(int, pthreadZumutexZutimedlock, // pthread_mutex_timedlock
       fflush(stderr);
    }
 
-   DO_CREQ_v_WW(_VG_USERREQ__HG_PTHREAD_MUTEX_LOCK_PRE,
-                pthread_mutex_t*,mutex, long,1/*isTryLock-ish*/);
-
    CALL_FN_W_WW(ret, fn, mutex,timeout);
 
    /* There's a hole here: libpthread now knows the lock is locked,
@@ -676,9 +676,11 @@ PTH_FUNC(int, pthreadZumutexZutimedlock, // pthread_mutex_timedlock
       this matter?  Not sure, but I don't think so. */
 
    if (ret == 0 /*success*/) {
-      DO_CREQ_v_W(_VG_USERREQ__HG_PTHREAD_MUTEX_LOCK_POST,
-                  pthread_mutex_t*,mutex);
+      DO_CREQ_v_WW(_VG_USERREQ__HG_PTHREAD_MUTEX_ACQUIRED,
+                   pthread_mutex_t*,mutex, long,1/*isTryLock-ish*/);
    } else { 
+      DO_CREQ_v_WW(_VG_USERREQ__HG_PTHREAD_MUTEX_LOCK_PRE,
+                   pthread_mutex_t*,mutex, long,1/*isTryLock-ish*/);
       if (ret != ETIMEDOUT)
          DO_PthAPIerror( "pthread_mutex_timedlock", ret );
    }
@@ -709,10 +711,9 @@ PTH_FUNC(int, pthreadZumutexZuunlock, // pthread_mutex_unlock
 
    CALL_FN_W_W(ret, fn, mutex);
 
-   if (ret == 0 /*success*/) {
-      DO_CREQ_v_W(_VG_USERREQ__HG_PTHREAD_MUTEX_UNLOCK_POST,
-                  pthread_mutex_t*,mutex);
-   } else { 
+   /* Helgrind has nothing to do once the lock is released, so there
+      is no _VG_USERREQ__HG_PTHREAD_MUTEX_UNLOCK_POST here. */
+   if (ret != 0 /*success*/) {
       DO_PthAPIerror( "pthread_mutex_unlock", ret );
    }
 
@@ -1774,10 +1775,9 @@ static int pthread_rwlock_unlock_WRK(pthread_rwlock_t* rwlock)
 
    CALL_FN_W_W(ret, fn, rwlock);
 
-   if (ret == 0 /*success*/) {
-      DO_CREQ_v_W(_VG_USERREQ__HG_PTHREAD_RWLOCK_UNLOCK_POST,
-                  pthread_rwlock_t*,rwlock);
-   } else { 
+   /* As for pthread_mutex_unlock, there is nothing to tell the tool
+      afterwards. */
+   if (ret != 0 /*success*/) {
       DO_PthAPIerror( "pthread_rwlock_unlock", ret );
    }
 
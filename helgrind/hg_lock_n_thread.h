@@ -136,6 +136,8 @@ typedef
       SO*           hbso;      /* associated SO */
       Addr          guestaddr; /* Guest address of lock */
       LockKind      kind;      /* what kind of lock this is */
+      UWord         laog_ord;  /* position in laog's topological order,
+                                  0 if not in laog */
       /* USEFUL-DYNAMIC */
       Bool          heldW; 
       WordBag*      heldBy; /* bag of threads that hold this lock */
@@ -57,6 +57,7 @@
 #include "pub_tool_aspacemgr.h" // VG_(am_is_valid_for_client)
 #include "pub_tool_poolalloc.h"
 #include "pub_tool_addrinfo.h"
+#include "pub_tool_seqmatch.h"  // VG_(string_match)
 
 #include "hg_basics.h"
 #include "hg_wordset.h"
@@ -599,13 +600,13 @@ static void initialise_data_structures ( Thr* hbthr_root )
 
    tl_assert(sizeof(Addr) == sizeof(UWord));
    tl_assert(map_locks == NULL);
-   map_locks = VG_(newFM)( HG_(zalloc), "hg.ids.2", HG_(free), 
-                           NULL/*unboxed Word cmp*/);
+   map_locks = VG_(newFM_BTree)( HG_(zalloc), "hg.ids.2", HG_(free),
+                                 NULL/*unboxed Word cmp*/);
    tl_assert(map_locks != NULL);
 
    tl_assert(univ_lsets == NULL);
    univ_lsets = HG_(newWordSetU)( HG_(zalloc), "hg.ids.4", HG_(free),
-                                  8/*cacheSize*/ );
+                                  1024/*cacheSize*/ );
    tl_assert(univ_lsets != NULL);
    /* Ensure that univ_lsets is non-empty, with lockset zero being the
       empty lockset.  hg_errors.c relies on the assumption that
@@ -616,7 +617,7 @@ static void initialise_data_structures ( Thr* hbthr_root )
    tl_assert(univ_laog == NULL);
    if (HG_(clo_track_lockorders)) {
       univ_laog = HG_(newWordSetU)( HG_(zalloc), "hg.ids.5 (univ_laog)",
-                                    HG_(free), 24/*cacheSize*/ );
+                                    HG_(free), 1024/*cacheSize*/ );
       tl_assert(univ_laog != NULL);
    }
 
@@ -1789,6 +1790,41 @@ void evh__pre_mem_write ( CorePart part, ThreadId tid, const HChar* s,
       all__sanity_check("evh__pre_mem_write-post");
 }
 
+/* The buffers of an iovec, as passed to readv, writev and the like. */
+static
+void evh__pre_mem_read_iov ( CorePart part, ThreadId tid, const HChar* s,
+                             const struct vki_iovec* iov, UInt n_iov,
+                             SizeT max_len ) {
+   Thread* thr = map_threads_lookup(tid);
+   SizeT   len;
+   UInt    i;
+   if (SHOW_EVENTS >= 1)
+      VG_(printf)("evh__pre_mem_read_iov(ctid=%d, \"%s\", %p, %u, %lu)\n", 
+                  (Int)tid, s, iov, n_iov, max_len );
+   for (i = 0; i < n_iov && max_len > 0; i++) {
+      len = iov[i].iov_len < max_len ? iov[i].iov_len : max_len;
+      max_len -= len;
+      shadow_mem_cread_range( thr, (Addr)iov[i].iov_base, len );
+   }
+}
+
+static
+void evh__pre_mem_write_iov ( CorePart part, ThreadId tid, const HChar* s,
+                              const struct vki_iovec* iov, UInt n_iov,
+                              SizeT max_len ) {
+   Thread* thr = map_threads_lookup(tid);
+   SizeT   len;
+   UInt    i;
+   if (SHOW_EVENTS >= 1)
+      VG_(printf)("evh__pre_mem_write_iov(ctid=%d, \"%s\", %p, %u, %lu)\n", 
+                  (Int)tid, s, iov, n_iov, max_len );
+   for (i = 0; i < n_iov && max_len > 0; i++) {
+      len = iov[i].iov_len < max_len ? iov[i].iov_len : max_len;
+      max_len -= len;
+      shadow_mem_cwrite_range( thr, (Addr)iov[i].iov_base, len );
+   }
+}
+
 static
 void evh__new_mem_heap ( Addr a, SizeT len, Bool is_inited ) {
    if (SHOW_EVENTS >= 1)
@@ -3312,10 +3348,7 @@ void evh__HG_USERSO_FORGET_ALL ( ThreadId tid, UWord usertag )
 /*--- Lock acquisition order monitoring                      ---*/
 /*--------------------------------------------------------------*/
 
-/* FIXME: here are some optimisations still to do in
-          laog__pre_thread_acquires_lock.
-
-   The graph is structured so that if L1 --*--> L2 then L1 must be
+/* The graph is structured so that if L1 --*--> L2 then L1 must be
    acquired before L2.
 
    The common case is that some thread T holds (eg) L1 L2 and L3 and
@@ -3336,6 +3369,24 @@ void evh__HG_USERSO_FORGET_ALL ( ThreadId tid, UWord usertag )
    (2) Cache these add-edge requests and ignore them if said edges
        have already been added to laog.  Invalidate the cache any time
        any edges are deleted from laog.
+
+   laog_cache below does both: it remembers the (lock set, lock)
+   pairs for which the query found no error and the edges were added,
+   and is invalidated by any change to laog.
+
+   When the cache misses, the query is answered using a topological
+   order of laog which is maintained incrementally as edges are added,
+   following Pearce and Kelly, "A Dynamic Topological Sort Algorithm
+   for Directed Acyclic Graphs", ACM JEA 11 (2006).  Lock.laog_ord
+   holds the position of each lock in that order, so that
+   L1 --> L2 implies L1->laog_ord < L2->laog_ord.  Hence there is no
+   path from Ln to {L1,L2,L3} if Ln->laog_ord is higher than that of
+   each Li, which avoids the search altogether in the common case, and
+   otherwise the search can skip all locks ordered after the Li.
+
+   A lock order error means laog has a cycle, and then there is no
+   topological order.  From then on laog_has_cycle is set and the
+   plain search is used.
 */
 
 typedef
@@ -3374,6 +3425,33 @@ static Word cmp_LAOGLinkExposition ( UWord llx1W, UWord llx2W ) {
 static WordFM* laog_exposition = NULL; /* WordFM LAOGLinkExposition* NULL */
 /* end EXPOSITION ONLY */
 
+/* Next Lock.laog_ord to hand out to a lock entering laog. */
+static UWord laog_next_ord = 1;
+/* Set once laog has a cycle, after which Lock.laog_ord is meaningless. */
+static Bool  laog_has_cycle = False;
+
+/* Incremented each time an edge is added to or deleted from laog. */
+static UWord laog_gen = 1;
+
+/* Direct mapped cache of the (locksetA, lk) pairs for which
+   laog__pre_thread_acquires_lock had nothing to report and added all
+   edges, when laog was at generation .gen.  Lock sets in univ_lsets
+   are never garbage collected, so the WordSetIDs stay meaningful. */
+#define N_LAOG_CACHE 1021 /* prime */
+typedef
+   struct {
+      WordSetID lockset; /* in univ_lsets */
+      Lock*     lk;
+      UWord     gen;
+   }
+   LAOGCacheEnt;
+static LAOGCacheEnt laog_cache[N_LAOG_CACHE];
+
+static UWord stats__laog_cache_hits  = 0;
+static UWord stats__laog_queries     = 0;
+static UWord stats__laog_searches    = 0;
+static UWord stats__laog_reorders    = 0;
+
 
 __attribute__((noinline))
 static void laog__init ( void )
@@ -3497,6 +3575,8 @@ static void univ_laog_do_GC ( void ) {
 }
 
 
+static void laog__reorder ( Lock* src, Lock* dst ); /* fwds */
+
 __attribute__((noinline))
 static void laog__add_edge ( Lock* src, Lock* dst ) {
    UWord      keyW;
@@ -3549,6 +3629,16 @@ static void laog__add_edge ( Lock* src, Lock* dst ) {
 
    tl_assert( (presentF && presentR) || (!presentF && !presentR) );
 
+   if (!presentF) {
+      laog_gen++;
+      if (src->laog_ord == 0)
+         src->laog_ord = laog_next_ord++;
+      if (dst->laog_ord == 0)
+         dst->laog_ord = laog_next_ord++;
+      if (!laog_has_cycle && src->laog_ord > dst->laog_ord)
+         laog__reorder( src, dst );
+   }
+
    if (!presentF && src->acquired_at && dst->acquired_at) {
       LAOGLinkExposition expo;
       /* If this edge is entering the graph, and we have acquired_at
@@ -3585,6 +3675,7 @@ static void laog__del_edge ( Lock* src, Lock* dst ) {
    UWord      keyW;
    LAOGLinks* links;
    if (0) VG_(printf)("laog__del_edge enter %p %p\n", src, dst);
+   laog_gen++;
    /* Update the out edges for src */
    keyW  = 0;
    links = NULL;
@@ -3654,6 +3745,137 @@ static WordSetID /* in univ_laog */ laog__preds ( Lock* lk ) {
    }
 }
 
+/* Collect in an XArray of Lock* 'start' and the locks reachable from
+   it, forwards or backwards according to 'forwards', through locks
+   whose laog_ord is below (forwards) or above (backwards) 'bound'.
+   Set *reached if 'target' is among them. */
+static XArray* laog__collect_bounded ( Lock* start, Bool forwards,
+                                       UWord bound, Lock* target,
+                                       Bool* reached )
+{
+   XArray*   stack;   /* of Lock* */
+   XArray*   found;   /* of Lock* */
+   WordFM*   visited; /* Lock* -> void, iow, Set(Lock*) */
+   Lock*     here;
+   WordSetID nexts;
+   UWord     nexts_size, i;
+   UWord*    nexts_words;
+
+   *reached = False;
+   stack   = VG_(newXA)( HG_(zalloc), "hg.lcb.1", HG_(free), sizeof(Lock*) );
+   found   = VG_(newXA)( HG_(zalloc), "hg.lcb.2", HG_(free), sizeof(Lock*) );
+   visited = VG_(newFM)( HG_(zalloc), "hg.lcb.3", HG_(free), NULL/*unboxedcmp*/ );
+
+   (void) VG_(addToXA)( stack, &start );
+   VG_(addToFM)( visited, (UWord)start, 0 );
+
+   while (VG_(sizeXA)( stack ) > 0) {
+      here = *(Lock**) VG_(indexXA)( stack, VG_(sizeXA)( stack ) - 1 );
+      VG_(dropTailXA)( stack, 1 );
+      (void) VG_(addToXA)( found, &here );
+
+      nexts = forwards ? laog__succs( here ) : laog__preds( here );
+      HG_(getPayloadWS)( &nexts_words, &nexts_size, univ_laog, nexts );
+      for (i = 0; i < nexts_size; i++) {
+         Lock* next = (Lock*)nexts_words[i];
+         if (next == target) {
+            *reached = True;
+            break;
+         }
+         if (forwards ? next->laog_ord >= bound : next->laog_ord <= bound)
+            continue;
+         if (VG_(lookupFM)( visited, NULL, NULL, (UWord)next ))
+            continue;
+         VG_(addToFM)( visited, (UWord)next, 0 );
+         (void) VG_(addToXA)( stack, &next );
+      }
+      if (*reached)
+         break;
+   }
+
+   VG_(deleteFM)( visited, NULL, NULL );
+   VG_(deleteXA)( stack );
+   return found;
+}
+
+static Int cmp_Lock_by_laog_ord ( const void* v1, const void* v2 ) {
+   const Lock* lk1 = *(Lock* const *)v1;
+   const Lock* lk2 = *(Lock* const *)v2;
+   if (lk1->laog_ord < lk2->laog_ord) return -1;
+   if (lk1->laog_ord > lk2->laog_ord) return  1;
+   return 0;
+}
+
+static Int cmp_UWord ( const void* v1, const void* v2 ) {
+   UWord w1 = *(const UWord*)v1;
+   UWord w2 = *(const UWord*)v2;
+   if (w1 < w2) return -1;
+   if (w1 > w2) return  1;
+   return 0;
+}
+
+/* The edge src --> dst has just been added to laog, and violates the
+   topological order since src->laog_ord > dst->laog_ord.  Restore the
+   order as Pearce and Kelly do: only the locks reachable from dst and
+   ordered before src, and the locks reaching src and ordered after
+   dst, need to move.  They keep their relative order, and the locks
+   reaching src are given the lowest of their combined positions.  If
+   src is reachable from dst, the new edge closed a cycle instead. */
+__attribute__((noinline))
+static void laog__reorder ( Lock* src, Lock* dst )
+{
+   XArray* deltaF; /* of Lock* */
+   XArray* deltaB; /* of Lock* */
+   XArray* ords;   /* of UWord */
+   Word    nF, nB, i;
+   Bool    cycle;
+
+   tl_assert(!laog_has_cycle);
+   tl_assert(src->laog_ord > dst->laog_ord);
+
+   stats__laog_reorders++;
+
+   deltaF = laog__collect_bounded( dst, True/*forwards*/, src->laog_ord,
+                                   src, &cycle );
+   if (cycle) {
+      laog_has_cycle = True;
+      VG_(deleteXA)( deltaF );
+      return;
+   }
+   deltaB = laog__collect_bounded( src, False/*forwards*/, dst->laog_ord,
+                                   NULL, &cycle );
+   tl_assert(!cycle);
+
+   nF = VG_(sizeXA)( deltaF );
+   nB = VG_(sizeXA)( deltaB );
+   ords = VG_(newXA)( HG_(zalloc), "hg.lr.1", HG_(free), sizeof(UWord) );
+   for (i = 0; i < nB; i++)
+      (void) VG_(addToXA)( ords,
+                           &(*(Lock**)VG_(indexXA)( deltaB, i ))->laog_ord );
+   for (i = 0; i < nF; i++)
+      (void) VG_(addToXA)( ords,
+                           &(*(Lock**)VG_(indexXA)( deltaF, i ))->laog_ord );
+
+   VG_(setCmpFnXA)( deltaB, cmp_Lock_by_laog_ord );
+   VG_(sortXA)( deltaB );
+   VG_(setCmpFnXA)( deltaF, cmp_Lock_by_laog_ord );
+   VG_(sortXA)( deltaF );
+   VG_(setCmpFnXA)( ords, cmp_UWord );
+   VG_(sortXA)( ords );
+
+   for (i = 0; i < nB; i++)
+      (*(Lock**)VG_(indexXA)( deltaB, i ))->laog_ord
+         = *(UWord*)VG_(indexXA)( ords, i );
+   for (i = 0; i < nF; i++)
+      (*(Lock**)VG_(indexXA)( deltaF, i ))->laog_ord
+         = *(UWord*)VG_(indexXA)( ords, nB + i );
+   tl_assert(src->laog_ord < dst->laog_ord);
+
+   VG_(deleteXA)( ords );
+   VG_(deleteXA)( deltaB );
+   VG_(deleteXA)( deltaF );
+}
+
 __attribute__((noinline))
 static void laog__sanity_check ( const HChar* who ) {
    UWord i, ws_size;
@@ -3681,6 +3903,9 @@ static void laog__sanity_check ( const HChar* who ) {
                              laog__preds( (Lock*)ws_words[i] ), 
                              (UWord)me ))
             goto bad;
+         if (!laog_has_cycle
+             && me->laog_ord >= ((Lock*)ws_words[i])->laog_ord)
+            goto bad;
       }
       me = NULL;
       links = NULL;
@@ -3710,6 +3935,7 @@ Lock* laog__do_dfs_from_to ( Lock* src, WordSetID dsts /* univ_lsets */ )
    WordSetID succs;
    UWord     succs_size, i;
    UWord*    succs_words;
+   UWord     max_ord;
    //laog__sanity_check();
 
    /* If the destination set is empty, we can never get there from
@@ -3717,6 +3943,28 @@ Lock* laog__do_dfs_from_to ( Lock* src, WordSetID dsts /* univ_lsets */ )
    if (HG_(isEmptyWS)( univ_lsets, dsts ))
       return NULL;
 
+   if (HG_(elemWS)( univ_lsets, dsts, (UWord)src ))
+      return src;
+
+   /* Any path from 'src' only goes up in the topological order, so it
+      cannot reach 'dsts' if 'src' comes after all of them, and it does
+      not need to visit locks that come after all of them. */
+   max_ord = ~(UWord)0;
+   if (!laog_has_cycle) {
+      UWord* dsts_words;
+      UWord  dsts_size;
+      HG_(getPayloadWS)( &dsts_words, &dsts_size, univ_lsets, dsts );
+      max_ord = 0;
+      for (i = 0; i < dsts_size; i++) {
+         if (((Lock*)dsts_words[i])->laog_ord > max_ord)
+            max_ord = ((Lock*)dsts_words[i])->laog_ord;
+      }
+      if (src->laog_ord == 0 || src->laog_ord > max_ord)
+         return NULL;
+   }
+
+   stats__laog_searches++;
+
    ret     = NULL;
    stack   = VG_(newXA)( HG_(zalloc), "hg.lddft.1", HG_(free), sizeof(Lock*) );
    visited = VG_(newFM)( HG_(zalloc), "hg.lddft.2", HG_(free), NULL/*unboxedcmp*/ );
@@ -3741,8 +3989,10 @@ Lock* laog__do_dfs_from_to ( Lock* src, WordSetID dsts /* univ_lsets */ )
 
       succs = laog__succs( here );
       HG_(getPayloadWS)( &succs_words, &succs_size, univ_laog, succs );
-      for (i = 0; i < succs_size; i++)
-         (void) VG_(addToXA)( stack, &succs_words[i] );
+      for (i = 0; i < succs_size; i++) {
+         if (((Lock*)succs_words[i])->laog_ord <= max_ord)
+            (void) VG_(addToXA)( stack, &succs_words[i] );
+      }
    }
 
    VG_(deleteFM)( visited, NULL, NULL );
@@ -3764,6 +4014,7 @@ static void laog__pre_thread_acquires_lock (
    UWord*   ls_words;
    UWord    ls_size, i;
    Lock*    other;
+   LAOGCacheEnt* ce;
 
    /* It may be that 'thr' already holds 'lk' and is recursively
       relocking in.  In this case we just ignore the call. */
@@ -3771,6 +4022,17 @@ static void laog__pre_thread_acquires_lock (
    if (HG_(elemWS)( univ_lsets, thr->locksetA, (UWord)lk ))
       return;
 
+   /* If laog has not changed since this was last done for the same
+      lock set and lock, there is no error to report and all the
+      edges are already present. */
+   stats__laog_queries++;
+   ce = &laog_cache[ ((UWord)lk ^ (UWord)thr->locksetA) % N_LAOG_CACHE ];
+   if (ce->gen == laog_gen && ce->lk == lk
+       && ce->lockset == thr->locksetA) {
+      stats__laog_cache_hits++;
+      return;
+   }
+
    /* First, the check.  Complain if there is any path in laog from lk
       to any of the locks already held by thr, since if any such path
       existed, it would mean that previously lk was acquired before
@@ -3868,6 +4130,12 @@ static void laog__pre_thread_acquires_lock (
       laog__add_edge( old, lk );
    }
 
+   if (!other) {
+      ce->lockset = thr->locksetA;
+      ce->lk      = lk;
+      ce->gen     = laog_gen;
+   }
+
    /* Why "except_Locks" ?  We're here because a lock is being
       acquired by a thread, and we're in an inconsistent state here.
       See the call points in evhH__post_thread_{r,w}_acquires_lock.
@@ -4286,6 +4554,106 @@ static IRExpr* mk_And1 ( IRSB* sbOut, IRExpr* arg1, IRExpr* arg2 )
    return mkexpr(res);
 }
 
+/* Sampling of memory references (--sample-rate).  Each superblock
+   gets a slot in sample_sites, picked by hashing its guest address.
+   A slot alternates between checking SAMPLE_BURST consecutive runs
+   of the superblock and skipping a stretch of runs.  The stretch
+   starts at SAMPLE_BURST and doubles each time, until the fraction
+   checked falls to the requested rate, so cold code is always checked
+   and hot code is checked at that rate.  Colliding superblocks just
+   share a sampler. */
+#define N_SAMPLE_SITES (1 << 14)
+#define SAMPLE_BURST   10
+
+typedef
+   struct {
+      UInt left;     /* runs remaining in the current phase */
+      UInt skip;     /* length of the last skipping phase */
+      Bool checking; /* is the current phase a checking one? */
+   }
+   SampleSite;
+
+static SampleSite sample_sites[N_SAMPLE_SITES];
+static UInt       sample_max_skip = 0;
+
+static ULong stats__sample_checked = 0;
+static ULong stats__sample_skipped = 0;
+
+/* Called at the start of each run of a sampled superblock; decides
+   whether its memory references are checked this time round. */
+static VG_REGPARM(1) UWord hg_sample_site ( UWord ix )
+{
+   SampleSite* site = &sample_sites[ix];
+   if (LIKELY(site->left > 0)) {
+      site->left--;
+   } else if (site->checking && sample_max_skip > 0) {
+      site->skip = site->skip == 0 ? SAMPLE_BURST : 2 * site->skip;
+      if (site->skip > sample_max_skip)
+         site->skip = sample_max_skip;
+      site->checking = False;
+      site->left = site->skip - 1;
+   } else {
+      site->checking = True;
+      site->left = SAMPLE_BURST - 1;
+   }
+   if (site->checking)
+      stats__sample_checked++;
+   else
+      stats__sample_skipped++;
+   return site->checking;
+}
+
+/* The guard for the memory references of the superblock being
+   instrumented, or NULL if it isn't sampled. */
+static IRExpr* sample_guard = NULL;
+
+/* Does 'bb' contain anything which instrument_mem_access might be
+   asked to instrument? */
+static Bool sb_has_mem_refs ( IRSB* bb )
+{
+   Int i;
+   for (i = 0; i < bb->stmts_used; i++) {
+      IRStmt* st = bb->stmts[i];
+      switch (st->tag) {
+         case Ist_Store: case Ist_StoreG: case Ist_LoadG:
+         case Ist_CAS:   case Ist_LLSC:
+            return True;
+         case Ist_WrTmp:
+            if (st->Ist.WrTmp.data->tag == Iex_Load)
+               return True;
+            break;
+         case Ist_Dirty:
+            if (st->Ist.Dirty.details->mFx != Ifx_None)
+               return True;
+            break;
+         default:
+            break;
+      }
+   }
+   return False;
+}
+
+/* Add a call to hg_sample_site for the superblock at 'sb_base', and
+   return an Ity_I1 atom which is true if it says to check this
+   run. */
+static IRExpr* mk_sample_guard ( IRSB* sbOut, Addr64 sb_base,
+                                 IRType hWordTy )
+{
+   UWord    ix  = (UWord)((sb_base * 0x9E3779B97F4A7C15ULL) >> 32)
+                  % N_SAMPLE_SITES;
+   IRTemp   res = newIRTemp(sbOut->tyenv, hWordTy);
+   IRTemp   g   = newIRTemp(sbOut->tyenv, Ity_I1);
+   IRDirty* di  = unsafeIRDirty_1_N( res, 1, "hg_sample_site",
+                     VG_(fnptr_to_fnentry)( &hg_sample_site ),
+                     mkIRExprVec_1( mkIRExpr_HWord( ix ) ) );
+   addStmtToIRSB( sbOut, IRStmt_Dirty(di) );
+   addStmtToIRSB( sbOut,
+      assign(g, hWordTy == Ity_I32
+                   ? binop(Iop_CmpNE32, mkexpr(res), mkU32(0))
+                   : binop(Iop_CmpNE64, mkexpr(res), mkU64(0))) );
+   return mkexpr(g);
+}
+
 static void instrument_mem_access ( IRSB*   sbOut, 
                                     IRExpr* addr,
                                     Int     szB,
@@ -4447,6 +4815,11 @@ static void instrument_mem_access ( IRSB*   sbOut,
       di->guard = mk_And1(sbOut, di->guard, guard);
    }
 
+   /* Likewise if we're only checking some runs of this superblock. */
+   if (sample_guard) {
+      di->guard = mk_And1(sbOut, di->guard, sample_guard);
+   }
+
    /* Add the helper. */
    addStmtToIRSB( sbOut, IRStmt_Dirty(di) );
 }
@@ -4485,6 +4858,31 @@ static Bool is_in_dynamic_linker_shared_object( Addr64 ga )
    return False;
 }
 
+/* Patterns given with --ignore-fn, as HChar*s, or NULL if none. */
+static XArray* ignore_fn_patterns = NULL;
+
+static ULong stats__ignored_fn_insns = 0;
+
+/* Figure out if GA is a guest code address in a function whose name
+   matches one of the --ignore-fn patterns, and if so return True.
+   Otherwise (and if GA is not in any known function) return False. */
+static Bool is_in_ignored_function( Addr64 ga )
+{
+   HChar fnname[256];
+   Word  i;
+
+   if (!ignore_fn_patterns)
+      return False;
+   if (!VG_(get_fnname)( (Addr)ga, fnname, sizeof(fnname) ))
+      return False;
+   for (i = 0; i < VG_(sizeXA)( ignore_fn_patterns ); i++) {
+      HChar* pat = *(HChar**)VG_(indexXA)( ignore_fn_patterns, i );
+      if (VG_(string_match)( pat, fnname ))
+         return True;
+   }
+   return False;
+}
+
 static
 IRSB* hg_instrument ( VgCallbackClosure* closure,
                       IRSB* bbIn,
@@ -4499,6 +4897,7 @@ IRSB* hg_instrument ( VgCallbackClosure* closure,
    IRStmt* st;
    Bool    inLDSO = False;
    Addr64  inLDSOmask4K = 1; /* mismatches on first check */
+   Bool    inIgnoredFn = False;
 
    const Int goff_sp = layout->offset_SP;
 
@@ -4533,6 +4932,10 @@ IRSB* hg_instrument ( VgCallbackClosure* closure,
    cia = st->Ist.IMark.addr;
    st = NULL;
 
+   sample_guard = NULL;
+   if (HG_(clo_sample_rate) < 100 && sb_has_mem_refs(bbIn))
+      sample_guard = mk_sample_guard(bbOut, vge->base[0], hWordTy);
+
    for (/*use current i*/; i < bbIn->stmts_used; i++) {
       st = bbIn->stmts[i];
       tl_assert(st);
@@ -4564,6 +4967,12 @@ IRSB* hg_instrument ( VgCallbackClosure* closure,
             } else {
                if (0) VG_(printf)("old %#lx\n", (Addr)cia);
             }
+            /* Nor functions the user asked us to ignore.  Their
+               memory references are dropped here, rather than being
+               checked and then suppressed at run time. */
+            inIgnoredFn = is_in_ignored_function(cia);
+            if (inIgnoredFn)
+               stats__ignored_fn_insns++;
             break;
 
          case Ist_MBE:
@@ -4592,7 +5001,7 @@ IRSB* hg_instrument ( VgCallbackClosure* closure,
                tl_assert(!cas->dataHi);
             }
             /* Just be boring about it. */
-            if (!inLDSO) {
+            if (!inLDSO && !inIgnoredFn) {
                instrument_mem_access(
                   bbOut,
                   cas->addr,
@@ -4614,7 +5023,7 @@ IRSB* hg_instrument ( VgCallbackClosure* closure,
             if (st->Ist.LLSC.storedata == NULL) {
                /* LL */
                dataTy = typeOfIRTemp(bbIn->tyenv, st->Ist.LLSC.result);
-               if (!inLDSO) {
+               if (!inLDSO && !inIgnoredFn) {
                   instrument_mem_access(
                      bbOut,
                      st->Ist.LLSC.addr,
@@ -4632,7 +5041,7 @@ IRSB* hg_instrument ( VgCallbackClosure* closure,
          }
 
          case Ist_Store:
-            if (!inLDSO) {
+            if (!inLDSO && !inIgnoredFn) {
                instrument_mem_access( 
                   bbOut, 
                   st->Ist.Store.addr, 
@@ -4650,10 +5059,12 @@ IRSB* hg_instrument ( VgCallbackClosure* closure,
             IRExpr*   addr = sg->addr;
             IRType    type = typeOfIRExpr(bbIn->tyenv, data);
             tl_assert(type != Ity_INVALID);
-            instrument_mem_access( bbOut, addr, sizeofIRType(type),
-                                   True/*isStore*/,
-                                   sizeofIRType(hWordTy),
-                                   goff_sp, sg->guard );
+            if (!inIgnoredFn) {
+               instrument_mem_access( bbOut, addr, sizeofIRType(type),
+                                      True/*isStore*/,
+                                      sizeofIRType(hWordTy),
+                                      goff_sp, sg->guard );
+            }
             break;
          }
 
@@ -4664,17 +5075,19 @@ IRSB* hg_instrument ( VgCallbackClosure* closure,
             IRExpr*  addr     = lg->addr;
             typeOfIRLoadGOp(lg->cvt, &typeWide, &type);
             tl_assert(type != Ity_INVALID);
-            instrument_mem_access( bbOut, addr, sizeofIRType(type),
-                                   False/*!isStore*/,
-                                   sizeofIRType(hWordTy),
-                                   goff_sp, lg->guard );
+            if (!inIgnoredFn) {
+               instrument_mem_access( bbOut, addr, sizeofIRType(type),
+                                      False/*!isStore*/,
+                                      sizeofIRType(hWordTy),
+                                      goff_sp, lg->guard );
+            }
             break;
          }
 
          case Ist_WrTmp: {
             IRExpr* data = st->Ist.WrTmp.data;
             if (data->tag == Iex_Load) {
-               if (!inLDSO) {
+               if (!inLDSO && !inIgnoredFn) {
                   instrument_mem_access(
                      bbOut,
                      data->Iex.Load.addr,
@@ -4698,7 +5111,7 @@ IRSB* hg_instrument ( VgCallbackClosure* closure,
                tl_assert(d->mSize != 0);
                dataSize = d->mSize;
                if (d->mFx == Ifx_Read || d->mFx == Ifx_Modify) {
-                  if (!inLDSO) {
+                  if (!inLDSO && !inIgnoredFn) {
                      instrument_mem_access( 
                         bbOut, d->mAddr, dataSize, False/*!isStore*/,
                         sizeofIRType(hWordTy), goff_sp, NULL/*no-guard*/
@@ -4706,7 +5119,7 @@ IRSB* hg_instrument ( VgCallbackClosure* closure,
                   }
                }
                if (d->mFx == Ifx_Write || d->mFx == Ifx_Modify) {
-                  if (!inLDSO) {
+                  if (!inLDSO && !inIgnoredFn) {
                      instrument_mem_access( 
                         bbOut, d->mAddr, dataSize, True/*isStore*/,
                         sizeofIRType(hWordTy), goff_sp, NULL/*no-guard*/
@@ -4730,6 +5143,7 @@ IRSB* hg_instrument ( VgCallbackClosure* closure,
       addStmtToIRSB( bbOut, st );
    } /* iterate over bbIn->stmts */
 
+   sample_guard = NULL;
    return bbOut;
 }
 
@@ -5056,6 +5470,13 @@ Bool hg_handle_client_request ( ThreadId tid, UWord* args, UWord* ret)
          evh__HG_PTHREAD_MUTEX_LOCK_POST( tid, (void*)args[1] );
          break;
 
+      /* A lock that couldn't block, such as a trylock, succeeded: do
+         the pre-lock checks and the post-lock actions together. */
+      case _VG_USERREQ__HG_PTHREAD_MUTEX_ACQUIRED:     // pth_mx_t*, Word
+         evh__HG_PTHREAD_MUTEX_LOCK_PRE( tid, (void*)args[1], args[2] );
+         evh__HG_PTHREAD_MUTEX_LOCK_POST( tid, (void*)args[1] );
+         break;
+
       /* This thread is about to do pthread_cond_signal on the
          pthread_cond_t* in arg[1].  Ditto pthread_cond_broadcast. */
       case _VG_USERREQ__HG_PTHREAD_COND_SIGNAL_PRE:
@@ -5253,7 +5674,7 @@ static Bool hg_process_cmd_line_option ( const HChar* arg )
                             HG_(clo_history_level), 2);
 
    /* If you change the 10k/30mill limits, remember to also change
-      them in assertions at the top of event_map_maybe_GC. */
+      them in assertions at the end of event_map_init. */
    else if VG_BINT_CLO(arg, "--conflict-cache-size",
                        HG_(clo_conflict_cache_size), 10*1000, 30*1000*1000) {}
 
@@ -5291,6 +5712,17 @@ static Bool hg_process_cmd_line_option ( const HChar* arg )
    else if VG_BOOL_CLO(arg, "--check-stack-refs",
                             HG_(clo_check_stack_refs)) {}
 
+   else if VG_BINT_CLO(arg, "--sample-rate",
+                       HG_(clo_sample_rate), 1, 100) {}
+
+   else if VG_STR_CLO(arg, "--ignore-fn", tmp_str) {
+      HChar* pat = HG_(strdup)( "hg.pclo.1", tmp_str );
+      if (!ignore_fn_patterns)
+         ignore_fn_patterns = VG_(newXA)( HG_(zalloc), "hg.pclo.2",
+                                          HG_(free), sizeof(HChar*) );
+      (void) VG_(addToXA)( ignore_fn_patterns, &pat );
+   }
+
    else 
       return VG_(replacement_malloc_process_cmd_line_option)(arg);
 
@@ -5309,6 +5741,11 @@ static void hg_print_usage ( void )
 "    --conflict-cache-size=N   size of 'full' history cache [1000000]\n"
 "    --check-stack-refs=no|yes race-check reads and writes on the\n"
 "                              main stack and thread stacks? [yes]\n"
+"    --sample-rate=1..100      race-check only this percentage of memory\n"
+"                              accesses in hot code [100]\n"
+"    --ignore-fn=<pattern>     don't race-check memory accesses made by\n"
+"                              functions matching <pattern> (may be\n"
+"                              given more than once) [none]\n"
    );
 }
 
@@ -5358,6 +5795,19 @@ static void hg_print_stats (void)
    //zz       VG_(printf)(" hbefore: %'10lu cache invals\n",   stats__hbefore_invals);
    //zz       VG_(printf)(" hbefore: %'10lu probes\n",         stats__hbefore_probes);
 
+   if (ignore_fn_patterns) {
+      VG_(printf)("\n");
+      VG_(printf)("      ignore-fn: %'llu instructions not instrumented\n",
+                  stats__ignored_fn_insns);
+   }
+
+   if (HG_(clo_sample_rate) < 100) {
+      VG_(printf)("\n");
+      VG_(printf)("        sampling: %'llu superblock runs checked, "
+                  "%'llu skipped\n",
+                  stats__sample_checked, stats__sample_skipped);
+   }
+
    VG_(printf)("\n");
    VG_(printf)("        locksets: %'8d unique lock sets\n",
                (Int)HG_(cardinalityWSU)( univ_lsets ));
@@ -5382,6 +5832,11 @@ static void hg_print_stats (void)
                   (Int)(laog ? VG_(sizeFM)( laog ) : 0));
       VG_(printf)(" LAOG exposition: %'8d map size\n",
                   (Int)(laog_exposition ? VG_(sizeFM)( laog_exposition ) : 0));
+      VG_(printf)("      LAOG query: %'8lu queries, %'lu cached, "
+                  "%'lu searches, %'lu reorders%s\n",
+                  stats__laog_queries, stats__laog_cache_hits,
+                  stats__laog_searches, stats__laog_reorders,
+                  laog_has_cycle ? " (has cycle)" : "");
    }
 
    VG_(printf)("           locks: %'8lu acquires, "
@@ -5468,6 +5923,11 @@ static void hg_post_clo_init ( void )
    if (HG_(clo_track_lockorders))
       laog__init();
 
+   /* A checking phase of SAMPLE_BURST runs followed by a skipping
+      phase of this many runs gives the requested rate. */
+   sample_max_skip = SAMPLE_BURST * (100 - HG_(clo_sample_rate))
+                     / HG_(clo_sample_rate);
+
    initialise_data_structures(hbthr_root);
 }
 
@@ -5517,6 +5977,7 @@ static void hg_pre_clo_init ( void )
 
    VG_(needs_print_stats) (hg_print_stats);
    VG_(needs_info_location) (hg_info_location);
+   VG_(needs_merged_stack_events) ();
 
    VG_(needs_malloc_replacement)  (hg_cli__malloc,
                                    hg_cli____builtin_new,
@@ -5559,6 +6020,8 @@ static void hg_pre_clo_init ( void )
    VG_(track_pre_mem_read_asciiz) ( evh__pre_mem_read_asciiz );
    VG_(track_pre_mem_write)       ( evh__pre_mem_write );
    VG_(track_post_mem_write)      (NULL);
+   VG_(track_pre_mem_read_iov)    ( evh__pre_mem_read_iov );
+   VG_(track_pre_mem_write_iov)   ( evh__pre_mem_write_iov );
 
    /////////////////
 
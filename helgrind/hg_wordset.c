@@ -52,78 +52,97 @@
 //------------------------------------------------------------------//
 
 typedef
-   struct { UWord arg1; UWord arg2; UWord res; }
+   struct { UWord arg1; UWord arg2; UWord res; UWord epoch; }
    WCacheEnt;
 
-/* Each cache is a fixed sized array of N_WCACHE_STAT_MAX entries.
-   However only the first .dynMax are used.  This is because at some
-   point, expanding the cache further overall gives a slowdown because
-   searching more entries more than negates any performance advantage
-   from caching those entries in the first place.  Hence use .dynMax
-   to allow the size of the cache(s) to be set differently for each
-   different WordSetU. */
-#define N_WCACHE_STAT_MAX 32
+/* Each cache is a set-associative array of .nSets sets of WCACHE_WAYS
+   entries.  The set is chosen by hashing both arguments, and the
+   entries of a set are kept in most-recently-used-first order.  Hence
+   a lookup looks at no more than WCACHE_WAYS entries however big the
+   cache is, and the cache can be made big enough for programs that
+   use many locks.  (It used to be a single move-to-front list, which
+   stopped paying off at about 32 entries.)
+
+   An entry is only valid if its .epoch is the cache's .epoch, so the
+   whole cache is emptied by incrementing .epoch. */
+#define WCACHE_WAYS 4
 typedef
    struct {
-      WCacheEnt ent[N_WCACHE_STAT_MAX];
-      UWord     dynMax; /* 1 .. N_WCACHE_STAT_MAX inclusive */
-      UWord     inUse;  /* 0 .. dynMax inclusive */
+      WCacheEnt* ent;   /* nSets * WCACHE_WAYS entries */
+      UWord      nSets; /* a power of 2, >= 2 */
+      UWord      sBits; /* log2(nSets) */
+      UWord      epoch; /* never 0 */
    }
    WCache;
 
-#define WCache_INIT(_zzcache,_zzdynmax)                              \
-   do {                                                              \
-      tl_assert((_zzdynmax) >= 1);                                   \
-      tl_assert((_zzdynmax) <= N_WCACHE_STAT_MAX);                   \
-      (_zzcache).dynMax = (_zzdynmax);                               \
-      (_zzcache).inUse = 0;                                          \
-   } while (0)
+static inline UWord WCache_setno ( const WCache* cache,
+                                   UWord arg1, UWord arg2 )
+{
+   ULong h = ((ULong)arg1 * 0x9E3779B97F4A7C15ULL + (ULong)arg2)
+             * 0x9E3779B97F4A7C15ULL;
+   return (UWord)(h >> (64 - cache->sBits));
+}
+
+static inline Bool WCache_lookup ( WCache* cache, UWord arg1, UWord arg2,
+                                   /*OUT*/UWord* res )
+{
+   UWord      i;
+   WCacheEnt* set = &cache->ent[WCache_setno(cache, arg1, arg2)
+                                * WCACHE_WAYS];
+   if (LIKELY(set[0].arg1 == arg1 && set[0].arg2 == arg2
+              && set[0].epoch == cache->epoch)) {
+      *res = set[0].res;
+      return True;
+   }
+   for (i = 1; i < WCACHE_WAYS; i++) {
+      if (set[i].arg1 == arg1 && set[i].arg2 == arg2
+          && set[i].epoch == cache->epoch) {
+         WCacheEnt tmp = set[i];
+         for (; i > 0; i--)
+            set[i] = set[i-1];
+         set[0] = tmp;
+         *res = tmp.res;
+         return True;
+      }
+   }
+   return False;
+}
+
+static inline void WCache_update ( WCache* cache, UWord arg1, UWord arg2,
+                                   UWord res )
+{
+   UWord      i;
+   WCacheEnt* set = &cache->ent[WCache_setno(cache, arg1, arg2)
+                                * WCACHE_WAYS];
+   for (i = WCACHE_WAYS-1; i > 0; i--)
+      set[i] = set[i-1];
+   set[0].arg1  = arg1;
+   set[0].arg2  = arg2;
+   set[0].res   = res;
+   set[0].epoch = cache->epoch;
+}
+
+static inline void WCache_invalidate ( WCache* cache )
+{
+   cache->epoch++;
+   if (UNLIKELY(cache->epoch == 0)) {
+      VG_(memset)( cache->ent, 0,
+                   cache->nSets * WCACHE_WAYS * sizeof(WCacheEnt) );
+      cache->epoch = 1;
+   }
+}
 
 #define WCache_LOOKUP_AND_RETURN(_retty,_zzcache,_zzarg1,_zzarg2)    \
    do {                                                              \
-      UWord   _i;                                                    \
-      UWord   _arg1  = (UWord)(_zzarg1);                             \
-      UWord   _arg2  = (UWord)(_zzarg2);                             \
-      WCache* _cache = &(_zzcache);                                  \
-      tl_assert(_cache->dynMax >= 1);                                \
-      tl_assert(_cache->dynMax <= N_WCACHE_STAT_MAX);                \
-      tl_assert(_cache->inUse >= 0);                                 \
-      tl_assert(_cache->inUse <= _cache->dynMax);                    \
-      if (_cache->inUse > 0) {                                       \
-         if (_cache->ent[0].arg1 == _arg1                            \
-             && _cache->ent[0].arg2 == _arg2)                        \
-            return (_retty)_cache->ent[0].res;                       \
-         for (_i = 1; _i < _cache->inUse; _i++) {                    \
-            if (_cache->ent[_i].arg1 == _arg1                        \
-                && _cache->ent[_i].arg2 == _arg2) {                  \
-               WCacheEnt tmp     = _cache->ent[_i-1];                \
-               _cache->ent[_i-1] = _cache->ent[_i];                  \
-               _cache->ent[_i]   = tmp;                              \
-               return (_retty)_cache->ent[_i-1].res;                 \
-            }                                                        \
-         }                                                           \
-      }                                                              \
+      UWord _res;                                                    \
+      if (WCache_lookup( &(_zzcache), (UWord)(_zzarg1),              \
+                         (UWord)(_zzarg2), &_res ))                  \
+         return (_retty)_res;                                        \
    } while (0)
 
 #define WCache_UPDATE(_zzcache,_zzarg1,_zzarg2,_zzresult)            \
-   do {                                                              \
-      Word    _i;                                                    \
-      UWord   _arg1  = (UWord)(_zzarg1);                             \
-      UWord   _arg2  = (UWord)(_zzarg2);                             \
-      UWord   _res   = (UWord)(_zzresult);                           \
-      WCache* _cache = &(_zzcache);                                  \
-      tl_assert(_cache->dynMax >= 1);                                \
-      tl_assert(_cache->dynMax <= N_WCACHE_STAT_MAX);                \
-      tl_assert(_cache->inUse >= 0);                                 \
-      tl_assert(_cache->inUse <= _cache->dynMax);                    \
-      if (_cache->inUse < _cache->dynMax)                            \
-         _cache->inUse++;                                            \
-      for (_i = _cache->inUse-1; _i >= 1; _i--)                      \
-         _cache->ent[_i] = _cache->ent[_i-1];                        \
-      _cache->ent[0].arg1 = _arg1;                                   \
-      _cache->ent[0].arg2 = _arg2;                                   \
-      _cache->ent[0].res  = _res;                                    \
-   } while (0)
+   WCache_update( &(_zzcache), (UWord)(_zzarg1), (UWord)(_zzarg2),   \
+                  (UWord)(_zzresult) )
 
 
 //------------------------------------------------------------------//
@@ -146,7 +165,15 @@ typedef
 
    If a WordVec WV is marked as dead by HG(dieWS), WV is removed from
    vec2ix. The entry of the dead WVs in ix2vec are used to maintain a
-   linked list of free (to be re-used) ix2vec entries. */
+   linked list of free (to be re-used) ix2vec entries.
+
+   The operations build their result in .scratch, and it is only
+   copied to a newly allocated WordVec if vec2ix does not already
+   hold it, which is the usual case.  A WordVec and its words are
+   allocated as one block.  Blocks of dead WordVecs with fewer than
+   N_WV_FREELISTS words are kept on .wv_free, one list per size, and
+   are handed out again before allocating new ones. */
+#define N_WV_FREELISTS 16
 struct _WordSetU {
       void*     (*alloc)(const HChar*,SizeT);
       const HChar* cc;
@@ -157,6 +184,11 @@ struct _WordSetU {
       UWord     ix2vec_used;
       WordVec** ix2vec_free;
       WordSet   empty; /* cached, for speed */
+      /* Where results are built before being looked up in vec2ix */
+      WordVec   scratch;
+      UWord     scratch_cap;
+      /* Dead WordVecs, by size, linked through their .words field */
+      WordVec*  wv_free[N_WV_FREELISTS];
       /* Caches for some operations */
       WCache    cache_addTo;
       WCache    cache_delFrom;
@@ -179,34 +211,79 @@ struct _WordSetU {
       UWord     n_isSingleton;
       UWord     n_anyElementOf;
       UWord     n_isSubsetOf;
+      UWord     n_wv_found;
+      UWord     n_wv_alloc;
+      UWord     n_wv_recycled;
    };
 
+static void WCache_init ( WCache* cache, WordSetU* wsu, Word cacheSize )
+{
+   tl_assert(cacheSize >= 1);
+   cache->sBits = 1;
+   while ((1UL << cache->sBits) * WCACHE_WAYS < (UWord)cacheSize)
+      cache->sBits++;
+   cache->nSets = 1UL << cache->sBits;
+   cache->ent   = wsu->alloc( wsu->cc, cache->nSets * WCACHE_WAYS
+                                       * sizeof(WCacheEnt) );
+   VG_(memset)( cache->ent, 0,
+                cache->nSets * WCACHE_WAYS * sizeof(WCacheEnt) );
+   cache->epoch = 1;
+}
+
+/* Return .scratch, with room for sz words.  Its contents are
+   undefined. */
+
+static WordVec* scratch_WV_of_size ( WordSetU* wsu, UWord sz )
+{
+   if (sz > wsu->scratch_cap) {
+      UWord new_cap = 2 * wsu->scratch_cap;
+      if (new_cap < sz) new_cap = sz;
+      if (wsu->scratch.words)
+         wsu->dealloc(wsu->scratch.words);
+      wsu->scratch.words = wsu->alloc( wsu->cc, new_cap * sizeof(UWord) );
+      wsu->scratch_cap = new_cap;
+   }
+   wsu->scratch.size = sz;
+   return &wsu->scratch;
+}
+
 /* Create a new WordVec of the given size. */
 
 static WordVec* new_WV_of_size ( WordSetU* wsu, UWord sz )
 {
    WordVec* wv;
    tl_assert(sz >= 0);
-   wv = wsu->alloc( wsu->cc, sizeof(WordVec) );
+   if (sz < N_WV_FREELISTS && wsu->wv_free[sz]) {
+      wv = wsu->wv_free[sz];
+      wsu->wv_free[sz] = (WordVec*)wv->words;
+      wsu->n_wv_recycled++;
+   } else {
+      wv = wsu->alloc( wsu->cc, sizeof(WordVec) + (SizeT)sz * sizeof(UWord) );
+      wsu->n_wv_alloc++;
+   }
    wv->owner = wsu;
-   wv->words = NULL;
+   wv->words = sz > 0 ? (UWord*)(wv + 1) : NULL;
    wv->size = sz;
-   if (sz > 0) {
-     wv->words = wsu->alloc( wsu->cc, (SizeT)sz * sizeof(UWord) );
-   }
    return wv;
 }
 
+static void free_WV ( WordVec* wv )
+{
+   wv->owner->dealloc(wv);
+}
+static void free_WV_for_FM ( UWord wv ) {
+   free_WV( (WordVec*)wv );
+}
+
 static void delete_WV ( WordVec* wv )
 {
-   void (*dealloc)(void*) = wv->owner->dealloc;
-   if (wv->words) {
-      dealloc(wv->words);
+   WordSetU* wsu = wv->owner;
+   if (wv->size < N_WV_FREELISTS) {
+      wv->words = (UWord*)wsu->wv_free[wv->size];
+      wsu->wv_free[wv->size] = wv;
+   } else {
+      free_WV( wv );
    }
-   dealloc(wv);
-}
-static void delete_WV_for_FM ( UWord wv ) {
-   delete_WV( (WordVec*)wv );
 }
 
 static Word cmp_WordVecs_for_FM ( UWord wv1W, UWord wv2W )
@@ -305,31 +382,39 @@ static WordVec* do_ix2vec_with_dead ( WordSetU* wsu, WordSet ws )
    return wv;
 }
 
-/* See if wv is contained within wsu.  If so, deallocate wv and return
-   the index of the already-present copy.  If not, add wv to both the
-   vec2ix and ix2vec mappings and return its index. 
+/* See if the contents of wv, which is .scratch, are contained within
+   wsu.  If so, return the index of the already-present copy.  If not,
+   add a copy of wv to both the vec2ix and ix2vec mappings and return
+   its index. 
 */
-static WordSet add_or_dealloc_WordVec( WordSetU* wsu, WordVec* wv_new )
+static WordSet add_or_copy_WordVec( WordSetU* wsu, WordVec* wv_tmp )
 {
    Bool     have;
    WordVec* wv_old;
+   WordVec* wv_new;
    UWord/*Set*/ ix_old = -1;
    /* Really WordSet, but need something that can safely be casted to
       a Word* in the lookupFM.  Making it WordSet (which is 32 bits)
       causes failures on a 64-bit platform. */
-   tl_assert(wv_new->owner == wsu);
+   tl_assert(wv_tmp == &wsu->scratch);
+   tl_assert(wv_tmp->owner == wsu);
    have = VG_(lookupFM)( wsu->vec2ix, 
                          (UWord*)&wv_old, (UWord*)&ix_old,
-                         (UWord)wv_new );
+                         (UWord)wv_tmp );
    if (have) {
-      tl_assert(wv_old != wv_new);
+      tl_assert(wv_old != wv_tmp);
       tl_assert(wv_old);
       tl_assert(wv_old->owner == wsu);
       tl_assert(ix_old < wsu->ix2vec_used);
       tl_assert(wsu->ix2vec[ix_old] == wv_old);
-      delete_WV( wv_new );
+      wsu->n_wv_found++;
       return (WordSet)ix_old;
-   } else if (wsu->ix2vec_free) {
+   }
+   wv_new = new_WV_of_size( wsu, wv_tmp->size );
+   if (wv_tmp->size > 0)
+      VG_(memcpy)( wv_new->words, wv_tmp->words,
+                   wv_tmp->size * sizeof(UWord) );
+   if (wsu->ix2vec_free) {
       WordSet ws;
       tl_assert(is_dead(wsu,(WordVec*)wsu->ix2vec_free));
       ws = wsu->ix2vec_free - &(wsu->ix2vec[0]);
@@ -372,21 +457,36 @@ WordSetU* HG_(newWordSetU) ( void* (*alloc_nofail)( const HChar*, SizeT ),
    wsu->ix2vec_size = 0;
    wsu->ix2vec      = NULL;
    wsu->ix2vec_free = NULL;
-   WCache_INIT(wsu->cache_addTo,     cacheSize);
-   WCache_INIT(wsu->cache_delFrom,   cacheSize);
-   WCache_INIT(wsu->cache_intersect, cacheSize);
-   WCache_INIT(wsu->cache_minus,     cacheSize);
-   empty = new_WV_of_size( wsu, 0 );
-   wsu->empty = add_or_dealloc_WordVec( wsu, empty );
+   wsu->scratch.owner = wsu;
+   WCache_init(&wsu->cache_addTo,     wsu, cacheSize);
+   WCache_init(&wsu->cache_delFrom,   wsu, cacheSize);
+   WCache_init(&wsu->cache_intersect, wsu, cacheSize);
+   WCache_init(&wsu->cache_minus,     wsu, cacheSize);
+   empty = scratch_WV_of_size( wsu, 0 );
+   wsu->empty = add_or_copy_WordVec( wsu, empty );
 
    return wsu;
 }
 
 void HG_(deleteWordSetU) ( WordSetU* wsu )
 {
+   UWord i;
    void (*dealloc)(void*) = wsu->dealloc;
    tl_assert(wsu->vec2ix);
-   VG_(deleteFM)( wsu->vec2ix, delete_WV_for_FM, NULL/*val-finalizer*/ );
+   VG_(deleteFM)( wsu->vec2ix, free_WV_for_FM, NULL/*val-finalizer*/ );
+   for (i = 0; i < N_WV_FREELISTS; i++) {
+      while (wsu->wv_free[i]) {
+         WordVec* wv = wsu->wv_free[i];
+         wsu->wv_free[i] = (WordVec*)wv->words;
+         free_WV( wv );
+      }
+   }
+   if (wsu->scratch.words)
+      dealloc(wsu->scratch.words);
+   dealloc(wsu->cache_addTo.ent);
+   dealloc(wsu->cache_delFrom.ent);
+   dealloc(wsu->cache_intersect.ent);
+   dealloc(wsu->cache_minus.ent);
    if (wsu->ix2vec)
       dealloc(wsu->ix2vec);
    dealloc(wsu);
@@ -486,10 +586,10 @@ void HG_(dieWS) ( WordSetU* wsu, WordSet ws )
 
    delete_WV( wv );
 
-   wsu->cache_addTo.inUse = 0;
-   wsu->cache_delFrom.inUse = 0;
-   wsu->cache_intersect.inUse = 0;
-   wsu->cache_minus.inUse = 0;
+   WCache_invalidate(&wsu->cache_addTo);
+   WCache_invalidate(&wsu->cache_delFrom);
+   WCache_invalidate(&wsu->cache_intersect);
+   WCache_invalidate(&wsu->cache_minus);
 }
 
 Bool HG_(plausibleWS) ( WordSetU* wsu, WordSet ws )
@@ -537,21 +637,21 @@ WordSet HG_(doubletonWS) ( WordSetU* wsu, UWord w1, UWord w2 )
    WordVec* wv;
    wsu->n_doubleton++;
    if (w1 == w2) {
-      wv = new_WV_of_size(wsu, 1);
+      wv = scratch_WV_of_size(wsu, 1);
       wv->words[0] = w1;
    }
    else if (w1 < w2) {
-      wv = new_WV_of_size(wsu, 2);
+      wv = scratch_WV_of_size(wsu, 2);
       wv->words[0] = w1;
       wv->words[1] = w2;
    }
    else {
       tl_assert(w1 > w2);
-      wv = new_WV_of_size(wsu, 2);
+      wv = scratch_WV_of_size(wsu, 2);
       wv->words[0] = w2;
       wv->words[1] = w1;
    }
-   return add_or_dealloc_WordVec( wsu, wv );
+   return add_or_copy_WordVec( wsu, wv );
 }
 
 WordSet HG_(singletonWS) ( WordSetU* wsu, UWord w )
@@ -600,6 +700,11 @@ void HG_(ppWSUstats) ( WordSetU* wsu, const HChar* name )
    VG_(printf)("      anyElementOf %10lu\n",   wsu->n_anyElementOf);
    VG_(printf)("      isSubsetOf   %10lu\n",   wsu->n_isSubsetOf);
    VG_(printf)("      dieWS        %10lu\n",   wsu->n_die);
+   VG_(printf)("      op caches    %10lu sets x %d ways each\n",
+               wsu->cache_addTo.nSets, WCACHE_WAYS);
+   VG_(printf)("      vectors      %10lu found, %lu allocated, "
+               "%lu recycled\n",
+               wsu->n_wv_found, wsu->n_wv_alloc, wsu->n_wv_recycled);
 }
 
 WordSet HG_(addToWS) ( WordSetU* wsu, WordSet ws, UWord w )
@@ -622,7 +727,7 @@ WordSet HG_(addToWS) ( WordSetU* wsu, WordSet ws, UWord w )
       }
    }
    /* Ok, not present.  Build a new one ... */
-   wv_new = new_WV_of_size( wsu, wv->size + 1 );
+   wv_new = scratch_WV_of_size( wsu, wv->size + 1 );
    k = j = 0;
    for (; k < wv->size && wv->words[k] < w; k++) {
       wv_new->words[j++] = wv->words[k];
@@ -635,7 +740,7 @@ WordSet HG_(addToWS) ( WordSetU* wsu, WordSet ws, UWord w )
    tl_assert(j == wv_new->size);
 
    /* Find any existing copy, or add the new one. */
-   result = add_or_dealloc_WordVec( wsu, wv_new );
+   result = add_or_copy_WordVec( wsu, wv_new );
    tl_assert(result != (WordSet)(-1));
 
   out:
@@ -675,7 +780,7 @@ WordSet HG_(delFromWS) ( WordSetU* wsu, WordSet ws, UWord w )
    tl_assert(i >= 0 && i < wv->size);
    tl_assert(wv->size > 0);
 
-   wv_new = new_WV_of_size( wsu, wv->size - 1 );
+   wv_new = scratch_WV_of_size( wsu, wv->size - 1 );
    j = k = 0;
    for (; j < wv->size; j++) {
       if (j == i)
@@ -684,7 +789,7 @@ WordSet HG_(delFromWS) ( WordSetU* wsu, WordSet ws, UWord w )
    }
    tl_assert(k == wv_new->size);
 
-   result = add_or_dealloc_WordVec( wsu, wv_new );
+   result = add_or_copy_WordVec( wsu, wv_new );
    if (wv->size == 1) {
       tl_assert(result == wsu->empty);
    }
@@ -727,7 +832,7 @@ WordSet HG_(unionWS) ( WordSetU* wsu, WordSet ws1, WordSet ws2 )
       sz += (wv1->size - i1);
    }
 
-   wv_new = new_WV_of_size( wsu, sz );
+   wv_new = scratch_WV_of_size( wsu, sz );
    k = 0;
 
    i1 = i2 = 0;
@@ -761,7 +866,7 @@ WordSet HG_(unionWS) ( WordSetU* wsu, WordSet ws1, WordSet ws2 )
 
    tl_assert(k == sz);
 
-   return add_or_dealloc_WordVec( wsu, wv_new );
+   return add_or_copy_WordVec( wsu, wv_new );
 }
 
 WordSet HG_(intersectWS) ( WordSetU* wsu, WordSet ws1, WordSet ws2 )
@@ -810,7 +915,7 @@ WordSet HG_(intersectWS) ( WordSetU* wsu, WordSet ws1, WordSet ws2 )
    tl_assert(i2 <= wv2->size);
    tl_assert(i1 == wv1->size || i2 == wv2->size);
 
-   wv_new = new_WV_of_size( wsu, sz );
+   wv_new = scratch_WV_of_size( wsu, sz );
    k = 0;
 
    i1 = i2 = 0;
@@ -834,7 +939,7 @@ WordSet HG_(intersectWS) ( WordSetU* wsu, WordSet ws1, WordSet ws2 )
 
    tl_assert(k == sz);
 
-   ws_new = add_or_dealloc_WordVec( wsu, wv_new );
+   ws_new = add_or_copy_WordVec( wsu, wv_new );
    if (sz == 0) {
       tl_assert(ws_new == wsu->empty);
    }
@@ -882,7 +987,7 @@ WordSet HG_(minusWS) ( WordSetU* wsu, WordSet ws1, WordSet ws2 )
       sz += (wv1->size - i1);
    }
 
-   wv_new = new_WV_of_size( wsu, sz );
+   wv_new = scratch_WV_of_size( wsu, sz );
    k = 0;
 
    i1 = i2 = 0;
@@ -910,7 +1015,7 @@ WordSet HG_(minusWS) ( WordSetU* wsu, WordSet ws1, WordSet ws2 )
 
    tl_assert(k == sz);
 
-   ws_new = add_or_dealloc_WordVec( wsu, wv_new );
+   ws_new = add_or_copy_WordVec( wsu, wv_new );
    if (sz == 0) {
       tl_assert(ws_new == wsu->empty);
    }
@@ -46,7 +46,9 @@ typedef  struct _WordSetU  WordSetU;  /* opaque */
 
 typedef  UInt              WordSet;   /* opaque, small int index */
 
-/* Allocate and initialise a WordSetU */
+/* Allocate and initialise a WordSetU.  cacheSize is the number of
+   entries in each of the caches of addTo, delFrom, intersect and minus
+   results; it is rounded up to a power of 2 of at least 8. */
 WordSetU* HG_(newWordSetU) ( void* (*alloc_nofail)( const HChar*, SizeT ),
                              const HChar* cc,
                              void  (*dealloc)(void*),
@@ -318,6 +318,13 @@ struct _Thr {
       we need to be able to find a given scalar Kw in this array
       later, by binary search. */
    XArray* /* ULong_n_EC */ local_Kws_n_stacks;
+
+   /* How many of the cache_shmem references, misses and line
+      write-backs happened while this thread was running.  Only
+      updated when switching threads; see cache_stats_switch_to. */
+   UWord stats_cache_refs;
+   UWord stats_cache_misses;
+   UWord stats_cache_wbacks;
 };
 
 
@@ -507,11 +514,12 @@ typedef
    Z rep: .dict[0] from SVal_INVALID to other   -- rcinc_LineZ
 */
 typedef
-   struct {
+   struct _SecMap {
       UInt   magic;
       LineZ  linesZ[N_SECMAP_ZLINES];
       LineF* linesF;
       UInt   linesF_size;
+      struct _SecMap* next_free; /* on shmem__SecMap_freelist */
    }
    SecMap;
 
@@ -558,6 +566,8 @@ static Cache   cache_shmem;
 static UWord stats__secmaps_search       = 0; // # SM finds
 static UWord stats__secmaps_search_slow  = 0; // # SM lookupFMs
 static UWord stats__secmaps_allocd       = 0; // # SecMaps issued
+static UWord stats__secmaps_freed        = 0; // # SecMaps given back
+static ULong stats__secmaps_freed_bytes  = 0; // .. and their storage
 static UWord stats__secmap_ga_space_covered = 0; // # ga bytes covered
 static UWord stats__secmap_linesZ_allocd = 0; // # LineZ's issued
 static UWord stats__secmap_linesZ_bytes  = 0; // .. using this much storage
@@ -574,7 +584,8 @@ static UWord stats__cache_totrefs        = 0; // # total accesses
 static UWord stats__cache_totmisses      = 0; // # misses
 static ULong stats__cache_make_New_arange = 0; // total arange made New
 static ULong stats__cache_make_New_inZrep = 0; // arange New'd on Z reps
-static UWord stats__cline_normalises     = 0; // # calls to cacheline_normalise
+static UWord stats__cline_normalises     = 0; // # lines fetched+normalised
+static UWord stats__cline_whole_trees    = 0; // # trees fetched as one SVal
 static UWord stats__cline_cread64s       = 0; // # calls to s_m_read64
 static UWord stats__cline_cread32s       = 0; // # calls to s_m_read32
 static UWord stats__cline_cread16s       = 0; // # calls to s_m_read16
@@ -613,6 +624,32 @@ static UWord stats__vts_set__focaa    = 0;
 // allocation
 static UWord stats__vts_set__focaa_a  = 0;
 
+/* cache_shmem is shared by all threads, since Valgrind runs only one
+   at a time.  To still show how each thread uses it, the global
+   cache counters are sampled each time a different thread starts
+   running, and the differences are credited to the one that was
+   running before.  This costs nothing on the access paths. */
+static Thr*  cache_stats_thr     = NULL;
+static UWord cache_stats_refs0   = 0;
+static UWord cache_stats_misses0 = 0;
+static UWord cache_stats_wbacks0 = 0;
+
+static void cache_stats_switch_to ( Thr* thr )
+{
+   UWord wbacks = stats__cache_Z_wbacks + stats__cache_F_wbacks;
+   if (cache_stats_thr) {
+      cache_stats_thr->stats_cache_refs
+         += stats__cache_totrefs - cache_stats_refs0;
+      cache_stats_thr->stats_cache_misses
+         += stats__cache_totmisses - cache_stats_misses0;
+      cache_stats_thr->stats_cache_wbacks += wbacks - cache_stats_wbacks0;
+   }
+   cache_stats_refs0   = stats__cache_totrefs;
+   cache_stats_misses0 = stats__cache_totmisses;
+   cache_stats_wbacks0 = wbacks;
+   cache_stats_thr     = thr;
+}
+
 
 static inline Addr shmem__round_to_SecMap_base ( Addr a ) {
    return a & ~(N_SECMAP_ARANGE - 1);
@@ -634,6 +671,8 @@ static HChar* shmem__bigchunk_end1 = NULL;
 
 static void* shmem__bigchunk_alloc ( SizeT n )
 {
+   /* A whole number of 2MB huge pages, so that with --huge-pages the
+      chunks are entirely huge-page backed. */
    const SizeT sHMEM__BIGCHUNK_SIZE = 4096 * 256 * 4;
    tl_assert(n > 0);
    n = VG_ROUNDUP(n, 16);
@@ -657,10 +696,21 @@ static void* shmem__bigchunk_alloc ( SizeT n )
    return shmem__bigchunk_next - n;
 }
 
+/* SecMaps whose whole range has become NoAccess are freed by
+   shmem__free_SecMap, and kept here for reuse, since the big chunks
+   they come from are never given back. */
+static SecMap* shmem__SecMap_freelist = NULL;
+
 static SecMap* shmem__alloc_SecMap ( void )
 {
    Word    i, j;
-   SecMap* sm = shmem__bigchunk_alloc( sizeof(SecMap) );
+   SecMap* sm;
+   if (shmem__SecMap_freelist) {
+      sm = shmem__SecMap_freelist;
+      shmem__SecMap_freelist = sm->next_free;
+   } else {
+      sm = shmem__bigchunk_alloc( sizeof(SecMap) );
+   }
    if (0) VG_(printf)("alloc_SecMap %p\n",sm);
    tl_assert(sm);
    sm->magic = SecMap_MAGIC;
@@ -674,6 +724,7 @@ static SecMap* shmem__alloc_SecMap ( void )
    }
    sm->linesF      = NULL;
    sm->linesF_size = 0;
+   sm->next_free   = NULL;
    stats__secmaps_allocd++;
    stats__secmap_ga_space_covered += N_SECMAP_ARANGE;
    stats__secmap_linesZ_allocd += N_SECMAP_ZLINES;
@@ -681,6 +732,15 @@ static SecMap* shmem__alloc_SecMap ( void )
    return sm;
 }
 
+/* Most client addresses are below VG_(am_flat_shadow_span)(), and
+   for those, shmem__flat_SecMaps holds the SecMap of each
+   N_SECMAP_ARANGE-sized piece of them, or NULL if there isn't one
+   yet.  It is a flat shadow region, so only the parts of it covering
+   memory the client has used take up any space.  SecMaps for higher
+   addresses are only in map_shmem, which holds all of them. */
+static SecMap** shmem__flat_SecMaps     = NULL;
+static Addr     shmem__flat_SecMaps_end = 0;  /* client addr limit */
+
 typedef struct { Addr gaKey; SecMap* sm; } SMCacheEnt;
 static SMCacheEnt smCache[3] = { {1,NULL}, {1,NULL}, {1,NULL} };
 
@@ -688,8 +748,10 @@ static SecMap* shmem__find_SecMap ( Addr ga )
 {
    SecMap* sm    = NULL;
    Addr    gaKey = shmem__round_to_SecMap_base(ga);
-   // Cache
    stats__secmaps_search++;
+   if (LIKELY(ga < shmem__flat_SecMaps_end))
+      return shmem__flat_SecMaps[ga >> N_SECMAP_BITS];
+   // Cache
    if (LIKELY(gaKey == smCache[0].gaKey))
       return smCache[0].sm;
    if (LIKELY(gaKey == smCache[1].gaKey)) {
@@ -730,6 +792,8 @@ static SecMap* shmem__find_or_alloc_SecMap ( Addr ga )
       sm = shmem__alloc_SecMap();
       tl_assert(sm);
       VG_(addToFM)( map_shmem, (UWord)gaKey, (UWord)sm );
+      if (ga < shmem__flat_SecMaps_end)
+         shmem__flat_SecMaps[ga >> N_SECMAP_BITS] = sm;
       return sm;
    }
 }
@@ -1192,22 +1256,6 @@ static UShort normalise_tree ( /*MOD*/SVal* tree )
    return descr;
 }
 
-/* This takes a cacheline where all the data is at the leaves
-   (w8[..]) and builds a correctly normalised tree. */
-static void normalise_CacheLine ( /*MOD*/CacheLine* cl )
-{
-   Word tno, cloff;
-   for (tno = 0, cloff = 0;  tno < N_LINE_TREES;  tno++, cloff += 8) {
-      SVal* tree = &cl->svals[cloff];
-      cl->descrs[tno] = normalise_tree( tree );
-   }
-   tl_assert(cloff == N_LINE_ARANGE);
-   if (CHECK_ZSM)
-      tl_assert(is_sane_CacheLine(cl)); /* EXPENSIVE */
-   stats__cline_normalises++;
-}
-
-
 typedef struct { UChar count; SVal sval; } CountedSVal;
 
 static
@@ -1230,6 +1278,12 @@ void sequentialise_CacheLine ( /*OUT*/CountedSVal* dst,
               dst[dstUsed++].sval  = (_v);             \
          } while (0)
 
+      /* The common case: the whole tree has one value. */
+      if (LIKELY(descr == TREE_DESCR_64)) {
+         PUT(8, tree[0]);
+         continue;
+      }
+
       /* byte 0 */
       if (descr & TREE_DESCR_64)   PUT(8, tree[0]); else
       if (descr & TREE_DESCR_32_0) PUT(4, tree[0]); else
@@ -1343,22 +1397,19 @@ static __attribute__((noinline)) void cacheline_wback ( UWord wix )
       break; /* we'll have to use the f rep */
      dict_ok:
       m = csvals[k].count;
+      /* 8- and 4-byte runs are aligned, so they fill whole bytes of
+         the 2-bit array. */
       if (m == 8) {
-         write_twobit_array( lineZ->ix2s, i+0, j );
-         write_twobit_array( lineZ->ix2s, i+1, j );
-         write_twobit_array( lineZ->ix2s, i+2, j );
-         write_twobit_array( lineZ->ix2s, i+3, j );
-         write_twobit_array( lineZ->ix2s, i+4, j );
-         write_twobit_array( lineZ->ix2s, i+5, j );
-         write_twobit_array( lineZ->ix2s, i+6, j );
-         write_twobit_array( lineZ->ix2s, i+7, j );
+         if (CHECK_ZSM)
+            tl_assert(0 == (i & 7));
+         lineZ->ix2s[(i >> 2) + 0] = j * 0x55;
+         lineZ->ix2s[(i >> 2) + 1] = j * 0x55;
          i += 8;
       }
       else if (m == 4) {
-         write_twobit_array( lineZ->ix2s, i+0, j );
-         write_twobit_array( lineZ->ix2s, i+1, j );
-         write_twobit_array( lineZ->ix2s, i+2, j );
-         write_twobit_array( lineZ->ix2s, i+3, j );
+         if (CHECK_ZSM)
+            tl_assert(0 == (i & 3));
+         lineZ->ix2s[i >> 2] = j * 0x55;
          i += 4;
       }
       else if (m == 1) {
@@ -1418,7 +1469,7 @@ static __attribute__((noinline)) void cacheline_wback ( UWord wix )
    from. */
 static __attribute__((noinline)) void cacheline_fetch ( UWord wix )
 {
-   Word       i;
+   Word       i, tno, cloff;
    Addr       tag;
    CacheLine* cl;
    LineZ*     lineZ;
@@ -1440,26 +1491,59 @@ static __attribute__((noinline)) void cacheline_fetch ( UWord wix )
    find_ZF_for_reading( &lineZ, &lineF, tag );
    tl_assert( (lineZ && !lineF) || (!lineZ && lineF) );
 
-   /* expand the data into the bottom layer of the tree, then get
-      cacheline_normalise to build the descriptor array. */
+   /* expand the data into the bottom layer of each tree, then get
+      normalise_tree to build its descriptor.  Trees whose 8 bytes all
+      have the same value, which they usually do for programs that
+      mostly make aligned word-sized accesses, are filled in as such
+      directly. */
    if (lineF) {
       tl_assert(lineF->inUse);
-      for (i = 0; i < N_LINE_ARANGE; i++) {
-         cl->svals[i] = lineF->w64s[i];
+      for (tno = 0, cloff = 0;  tno < N_LINE_TREES;  tno++, cloff += 8) {
+         SVal* src  = &lineF->w64s[cloff];
+         SVal* tree = &cl->svals[cloff];
+         if (src[1] == src[0] && src[2] == src[0] && src[3] == src[0]
+             && src[4] == src[0] && src[5] == src[0] && src[6] == src[0]
+             && src[7] == src[0]) {
+            tree[0] = src[0];
+            tree[1] = tree[2] = tree[3] = tree[4] = tree[5] = tree[6]
+                    = tree[7] = SVal_INVALID;
+            cl->descrs[tno] = TREE_DESCR_64;
+            stats__cline_whole_trees++;
+         } else {
+            for (i = 0; i < 8; i++)
+               tree[i] = src[i];
+            cl->descrs[tno] = normalise_tree( tree );
+         }
       }
       stats__cache_F_fetches++;
    } else {
-      for (i = 0; i < N_LINE_ARANGE; i++) {
-         SVal sv;
-         UWord ix = read_twobit_array( lineZ->ix2s, i );
-         /* correct, but expensive: tl_assert(ix >= 0 && ix <= 3); */
-         sv = lineZ->dict[ix];
-         tl_assert(sv != SVal_INVALID);
-         cl->svals[i] = sv;
+      for (tno = 0, cloff = 0;  tno < N_LINE_TREES;  tno++, cloff += 8) {
+         UChar b0   = lineZ->ix2s[(cloff >> 2) + 0];
+         UChar b1   = lineZ->ix2s[(cloff >> 2) + 1];
+         SVal* tree = &cl->svals[cloff];
+         if (b0 == b1 && b0 == (b0 & 3) * 0x55) {
+            tree[0] = lineZ->dict[b0 & 3];
+            tl_assert(tree[0] != SVal_INVALID);
+            tree[1] = tree[2] = tree[3] = tree[4] = tree[5] = tree[6]
+                    = tree[7] = SVal_INVALID;
+            cl->descrs[tno] = TREE_DESCR_64;
+            stats__cline_whole_trees++;
+         } else {
+            for (i = 0; i < 8; i++) {
+               UWord ix = read_twobit_array( lineZ->ix2s, cloff + i );
+               /* correct, but expensive: tl_assert(ix >= 0 && ix <= 3); */
+               tree[i] = lineZ->dict[ix];
+               tl_assert(tree[i] != SVal_INVALID);
+            }
+            cl->descrs[tno] = normalise_tree( tree );
+         }
       }
       stats__cache_Z_fetches++;
    }
-   normalise_CacheLine( cl );
+   tl_assert(cloff == N_LINE_ARANGE);
+   if (CHECK_ZSM)
+      tl_assert(is_sane_CacheLine(cl)); /* EXPENSIVE */
+   stats__cline_normalises++;
 }
 
 static void shmem__invalidate_scache ( void ) {
@@ -1762,6 +1846,15 @@ static void zsm_init ( void(*p_rcinc)(SVal), void(*p_rcdec)(SVal) )
    tl_assert(map_shmem != NULL);
    shmem__invalidate_scache();
 
+   /* The SecMap lookup table for the usual range of client addresses.
+      Without it, all lookups go through map_shmem. */
+   { Addr  end = VG_ROUNDUP(VG_(am_flat_shadow_span)(), N_SECMAP_ARANGE);
+     SizeT szB = (end >> N_SECMAP_BITS) * sizeof(SecMap*);
+     shmem__flat_SecMaps = VG_(am_flat_shadow_reserve)( szB );
+     if (shmem__flat_SecMaps != NULL)
+        shmem__flat_SecMaps_end = end;
+   }
+
    /* a SecMap must contain an integral number of CacheLines */
    tl_assert(0 == (N_SECMAP_ARANGE % N_LINE_ARANGE));
    /* also ... a CacheLine holds an integral number of trees */
@@ -1824,14 +1917,24 @@ static void scalarts_limitations_fail_NORETURN ( Bool due_to_nThrs )
    listed here if we have been notified thereof by libhb_async_exit.
    New entries are added at the end.  The order isn't important, but
    the ThrID values must be unique.  This table lists the identity of
-   all threads that have ever died -- none are ever removed.  We keep
-   this table so as to be able to prune entries from VTSs.  We don't
-   actually need to keep the set of threads that have ever died --
-   only the threads that have died since the previous round of
-   pruning.  But it's useful for sanity check purposes to keep the
-   entire set, so we do. */
+   all threads that have died since the previous round of pruning.
+   We keep this table so as to be able to prune entries from VTSs.
+   Once a round of pruning has removed a ThrID from every VTS in the
+   system, nothing can ever mention it again, so it is moved to
+   pruned_thrid_table, from where Thr__new can eventually recycle it
+   (see comments on Thr__new). */
 static XArray* /* of ThrID */ verydead_thread_table = NULL;
 
+/* ThrIDs which have been pruned from all VTSs but which may still be
+   mentioned by the conflicting-access machinery (oldrefTree).  These
+   are only moved to free_thrid_table, after purging oldrefTree, when
+   thrid_counter runs out. */
+static XArray* /* of ThrID */ pruned_thrid_table = NULL;
+
+/* ThrIDs mentioned nowhere at all, and hence available for reuse by
+   Thr__new. */
+static XArray* /* of ThrID */ free_thrid_table = NULL;
+
 /* Arbitrary total ordering on ThrIDs. */
 static Int cmp__ThrID ( const void* v1, const void* v2 ) {
    ThrID id1 = *(const ThrID*)v1;
@@ -1850,6 +1953,19 @@ static void verydead_thread_table_init ( void )
                    HG_(free), sizeof(ThrID) );
    tl_assert(verydead_thread_table);
    VG_(setCmpFnXA)(verydead_thread_table, cmp__ThrID);
+   tl_assert(!pruned_thrid_table);
+   pruned_thrid_table
+     = VG_(newXA)( HG_(zalloc),
+                   "libhb.verydead_thread_table_init.2",
+                   HG_(free), sizeof(ThrID) );
+   tl_assert(pruned_thrid_table);
+   VG_(setCmpFnXA)(pruned_thrid_table, cmp__ThrID);
+   tl_assert(!free_thrid_table);
+   free_thrid_table
+     = VG_(newXA)( HG_(zalloc),
+                   "libhb.verydead_thread_table_init.3",
+                   HG_(free), sizeof(ThrID) );
+   tl_assert(free_thrid_table);
 }
 
 
@@ -3136,6 +3252,17 @@ static void vts_tab__do_GC ( Bool show_stats )
                "after pruning %lu (avg sz %lu)\n",
                nBeforePruning, nSTSsBefore / nBeforePruning,
                nAfterPruning, nSTSsAfter / nAfterPruning);
+
+   /* Every ThrID in the dead thread table has now been removed from
+      every VTS, and since the corresponding threads can never again
+      run, they cannot reappear.  Move them off to the pruned table,
+      so that subsequent prunings don't bother with them and so that
+      Thr__new can recycle them if it runs out. */
+   for (i = 0; i < nBT; i++) {
+      ThrID thrid = *(ThrID*)VG_(indexXA)( verydead_thread_table, i );
+      VG_(addToXA)( pruned_thrid_table, &thrid );
+   }
+   VG_(dropTailXA)( verydead_thread_table, nBT );
    /* ---------- END VTS PRUNING ---------- */
 }
 
@@ -3176,8 +3303,22 @@ static
    struct { VtsID vi1; VtsID vi2; VtsID res; }
    join2_cache[N_JOIN2_CACHE];
 
+/* A one-entry cache for msmcread: the last C-state SVal which a read
+   by a thread with clocks (msm_fast_viR, msm_fast_viW) left
+   unchanged.  Read-shared data tends to have the same SVal across
+   large areas, so repeated reads of it by the same thread in the
+   same epoch hit here and skip the comparison and join.  Since it
+   holds VtsIDs it has to be dropped whenever they might be
+   renumbered, which is why it lives with the other caches. */
+static SVal  msm_fast_sv  = SVal_INVALID;
+static VtsID msm_fast_viR = VtsID_INVALID;
+static VtsID msm_fast_viW = VtsID_INVALID;
+
 static void VtsID__invalidate_caches ( void ) {
    Int i;
+   msm_fast_sv  = SVal_INVALID;
+   msm_fast_viR = VtsID_INVALID;
+   msm_fast_viW = VtsID_INVALID;
    for (i = 0; i < N_CMPLEQ_CACHE; i++) {
       cmpLEQ_cache[i].vi1 = VtsID_INVALID;
       cmpLEQ_cache[i].vi2 = VtsID_INVALID;
@@ -3661,6 +3802,48 @@ static Thr* Thr__from_ThrID ( UInt thrid ) {
    return thr;
 }
 
+static void event_map_purge_thrids ( XArray* thrids ); /* fwds */
+
+static UWord stats__thrids_recycled = 0;
+
+/* Hand out a ThrID for a new thread.  Normally these come from
+   thrid_counter, but if that runs out (a program which creates more
+   than 2^SCALARTS_N_THRBITS - 1024 threads over its lifetime) we fall
+   back to recycling the ThrIDs of threads which have been removed
+   from all VTSs by pruning.  Before doing so, any references to them
+   in the conflicting-access machinery have to be discarded, since
+   otherwise a race report could attribute an old access by a long-
+   dead thread to the new owner of the ThrID. */
+static ThrID Thr__alloc_ThrID ( void )
+{
+   if (LIKELY(thrid_counter < ThrID_MAX_VALID))
+      return thrid_counter++;
+
+   if (VG_(sizeXA)( free_thrid_table ) == 0
+       && VG_(sizeXA)( pruned_thrid_table ) > 0) {
+      Word i, n;
+      VG_(sortXA)( pruned_thrid_table );
+      event_map_purge_thrids( pruned_thrid_table );
+      n = VG_(sizeXA)( pruned_thrid_table );
+      for (i = 0; i < n; i++)
+         VG_(addToXA)( free_thrid_table,
+                       VG_(indexXA)( pruned_thrid_table, i ) );
+      VG_(dropTailXA)( pruned_thrid_table, n );
+   }
+
+   Word nFree = VG_(sizeXA)( free_thrid_table );
+   if (nFree == 0) {
+      /* We're hosed.  We have to stop. */
+      scalarts_limitations_fail_NORETURN( True/*due_to_nThrs*/ );
+   }
+
+   ThrID thrid = *(ThrID*)VG_(indexXA)( free_thrid_table, nFree-1 );
+   VG_(dropTailXA)( free_thrid_table, 1 );
+   tl_assert(thrid >= 1024 && thrid < ThrID_MAX_VALID);
+   stats__thrids_recycled++;
+   return thrid;
+}
+
 static Thr* Thr__new ( void )
 {
    Thr* thr = HG_(zalloc)( "libhb.Thr__new.1", sizeof(Thr) );
@@ -3683,14 +3866,17 @@ static Thr* Thr__new ( void )
       tl_assert(thrid_to_thr_map);
    }
 
-   if (thrid_counter >= ThrID_MAX_VALID) {
-      /* We're hosed.  We have to stop. */
-      scalarts_limitations_fail_NORETURN( True/*due_to_nThrs*/ );
+   thr->thrid = Thr__alloc_ThrID();
+   Word ix = thr->thrid - 1024;
+   if (ix == VG_(sizeXA)( thrid_to_thr_map )) {
+      VG_(addToXA)( thrid_to_thr_map, &thr );
+   } else {
+      /* A recycled ThrID.  The previous owner is very dead and will
+         never be looked up by ThrID again. */
+      tl_assert(ix < VG_(sizeXA)( thrid_to_thr_map ));
+      *(Thr**)VG_(indexXA)( thrid_to_thr_map, ix ) = thr;
    }
-
-   thr->thrid = thrid_counter++;
-   Word ix = VG_(addToXA)( thrid_to_thr_map, &thr );
-   tl_assert(ix + 1024 == thr->thrid);
+   tl_assert(Thr__from_ThrID(thr->thrid) == thr);
 
    return thr;
 }
@@ -3818,8 +4004,6 @@ static void SVal__rcdec ( SVal s ) {
 //                                                     //
 /////////////////////////////////////////////////////////
 
-#define EVENT_MAP_GC_DISCARD_FRACTION  0.5
-
 /* This is in two parts:
 
    1. A hash table of RCECs.  This is a set of reference-counted stack
@@ -3832,8 +4016,8 @@ static void SVal__rcdec ( SVal s ) {
    2. A SparseWA of OldRefs.  These store information about each old
       ref that we need to record.  It is indexed by address of the
       location for which the information is recorded.  For LRU
-      purposes, each OldRef also contains a generation number,
-      indicating when it was most recently accessed.
+      purposes, all OldRefs are also chained on a doubly linked list,
+      most recently accessed first.
 
       The important part of an OldRef is, however, its accs[] array.
       This is an array of N_OLDREF_ACCS which binds (thread, R/W,
@@ -3843,12 +4027,13 @@ static void SVal__rcdec ( SVal s ) {
       falls off the end, that's too bad -- we will lose info about
       that triple's access to this location.
 
-      When the SparseWA becomes too big, we can throw away the OldRefs
-      whose generation numbers are below some threshold; hence doing
-      approximate LRU discarding.  For each discarded OldRef we must
-      of course decrement the reference count on the all RCECs it
-      refers to, in order that entries from (1) eventually get
-      discarded too.
+      The SparseWA never holds more than HG_(clo_conflict_cache_size)
+      OldRefs.  Once it is full, recording a new location recycles
+      the least recently accessed OldRef, at the end of the LRU list.
+      That costs O(1), unlike a sweep over the whole SparseWA, and
+      keeps the memory used by (2) fixed.  For each discarded OldRef
+      we must of course decrement the reference count on the all
+      RCECs it refers to, so that entries from (1) get discarded too.
 
    A major improvement in reliability of this mechanism would be to
    have a dynamically sized OldRef.accs[] array, so no entries ever
@@ -3921,13 +4106,29 @@ static Word RCEC__cmp_by_frames ( RCEC* ec1, RCEC* ec2 ) {
 }
 
 
-/* Dec the ref of this RCEC. */
+static void free_RCEC ( RCEC* rcec ); /* fwds */
+
+/* Dec the ref of this RCEC, and remove it from contextTab and free
+   it if that was the last reference. */
 static void ctxt__rcdec ( RCEC* ec )
 {
+   RCEC** pp;
    stats__ctxt_rcdec_calls++;
    tl_assert(ec && ec->magic == RCEC_MAGIC);
    tl_assert(ec->rc > 0);
    ec->rc--;
+   if (LIKELY(ec->rc > 0))
+      return;
+   pp = &contextTab[ec->frames_hash % N_RCEC_TAB];
+   while (*pp != ec) {
+      tl_assert(*pp);
+      pp = &(*pp)->next;
+   }
+   *pp = ec->next;
+   free_RCEC(ec);
+   tl_assert(stats__ctxt_tab_curr > 0);
+   stats__ctxt_tab_curr--;
+   stats__ctxt_rcdec_discards++;
 }
 
 static void ctxt__rcinc ( RCEC* ec )
@@ -4092,10 +4293,11 @@ typedef
 #define N_OLDREF_ACCS 5
 
 typedef
-   struct {
+   struct _OldRef {
       UWord magic;  /* sanity check only */
-      UWord gen;    /* when most recently accessed */
-                    /* or free list when not in use */
+      struct _OldRef* prev; /* LRU list: more recently accessed */
+      struct _OldRef* next; /* LRU list: less recently accessed */
+      Addr  ga;     /* key in oldrefTree, needed when recycling */
       /* unused slots in this array have .thrid == 0, which is invalid */
       Thr_n_RCEC accs[N_OLDREF_ACCS];
    }
@@ -4117,9 +4319,63 @@ static void free_OldRef ( OldRef* r ) {
 
 
 static SparseWA* oldrefTree     = NULL; /* SparseWA* OldRef* */
-static UWord     oldrefGen      = 0;    /* current LRU generation # */
 static UWord     oldrefTreeN    = 0;    /* # elems in oldrefTree */
-static UWord     oldrefGenIncAt = 0;    /* inc gen # when size hits this */
+static OldRef*   oldrefMRU      = NULL; /* head of the LRU list */
+static OldRef*   oldrefLRU      = NULL; /* tail of the LRU list */
+
+static UWord stats__oldref_recycled = 0;
+
+/* Take 'ref' off the LRU list. */
+static inline void OldRef_unchain ( OldRef* ref )
+{
+   if (ref->prev)
+      ref->prev->next = ref->next;
+   else
+      oldrefMRU = ref->next;
+   if (ref->next)
+      ref->next->prev = ref->prev;
+   else
+      oldrefLRU = ref->prev;
+   ref->prev = ref->next = NULL;
+}
+
+/* Put 'ref', which must not be on the LRU list, at its head. */
+static inline void OldRef_newest ( OldRef* ref )
+{
+   ref->prev = NULL;
+   ref->next = oldrefMRU;
+   if (oldrefMRU)
+      oldrefMRU->prev = ref;
+   else
+      oldrefLRU = ref;
+   oldrefMRU = ref;
+}
+
+/* Throw away the least recently accessed OldRef, dropping its RCEC
+   references, and hand it back ready for reuse. */
+static OldRef* OldRef_recycle_LRU ( void )
+{
+   OldRef* ref = oldrefLRU;
+   UWord   keyW, valW;
+   Word    j;
+   Bool    b;
+   tl_assert(ref && ref->magic == OldRef_MAGIC);
+   b = VG_(delFromSWA)( oldrefTree, &keyW, &valW, ref->ga );
+   tl_assert(b);
+   tl_assert(keyW == ref->ga && valW == (UWord)ref);
+   for (j = 0; j < N_OLDREF_ACCS; j++) {
+      if (ref->accs[j].rcec) {
+         tl_assert(ref->accs[j].thrid != 0);
+         stats__ctxt_rcdec3++;
+         ctxt__rcdec( ref->accs[j].rcec );
+      } else {
+         tl_assert(ref->accs[j].thrid == 0);
+      }
+   }
+   OldRef_unchain(ref);
+   stats__oldref_recycled++;
+   return ref;
+}
 
 inline static UInt min_UInt ( UInt a, UInt b ) {
    return a < b ? a : b;
@@ -4237,21 +4493,25 @@ static void event_map_bind ( Addr a, SizeT szB, Bool isW, Thr* thr )
          /* tl_assert(thrid != 0); */ /* There's a dominating assert above. */
       }
 
-      ref->gen = oldrefGen;
+      if (ref != oldrefMRU) {
+         OldRef_unchain(ref);
+         OldRef_newest(ref);
+      }
 
    } else {
 
-      /* We don't have a record for this address.  Create a new one. */
-      if (oldrefTreeN >= oldrefGenIncAt) {
-         oldrefGen++;
-         oldrefGenIncAt = oldrefTreeN + 50000;
-         if (0) VG_(printf)("oldrefTree: new gen %lu at size %lu\n",
-                            oldrefGen, oldrefTreeN );
+      /* We don't have a record for this address.  Create a new one,
+         or, if the cache is full, reuse the least recently accessed
+         one. */
+      if (oldrefTreeN >= HG_(clo_conflict_cache_size)) {
+         ref = OldRef_recycle_LRU();
+      } else {
+         ref = alloc_OldRef();
+         oldrefTreeN++;
       }
-
-      ref = alloc_OldRef();
       ref->magic = OldRef_MAGIC;
-      ref->gen   = oldrefGen;
+      ref->ga    = a;
+      OldRef_newest(ref);
       ref->accs[0].thrid      = thrid;
       ref->accs[0].szLg2B     = szLg2B;
       ref->accs[0].isW        = (UInt)(isW & 1);
@@ -4271,7 +4531,6 @@ static void event_map_bind ( Addr a, SizeT szB, Bool isW, Thr* thr )
          ref->accs[j].locksHeldW = 0;
       }
       VG_(addToSWA)( oldrefTree, a, (UWord)ref );
-      oldrefTreeN++;
 
    }
 }
@@ -4426,16 +4685,20 @@ static void event_map_init ( void )
 
    /* Oldref tree */
    tl_assert(!oldrefTree);
-   oldrefTree = VG_(newSWA)(
+   oldrefTree = VG_(newSWA_ART)(
                    HG_(zalloc),
                    "libhb.event_map_init.4 (oldref tree)", 
                    HG_(free)
                 );
    tl_assert(oldrefTree);
 
-   oldrefGen = 0;
-   oldrefGenIncAt = 0;
    oldrefTreeN = 0;
+   oldrefMRU = oldrefLRU = NULL;
+
+   /* Check for sane command line params.  Limit values must match
+      those in hg_process_cmd_line_option. */
+   tl_assert( HG_(clo_conflict_cache_size) >= 10*1000 );
+   tl_assert( HG_(clo_conflict_cache_size) <= 30*1000*1000 );
 }
 
 static void event_map__check_reference_counts ( Bool before )
@@ -4492,279 +4755,78 @@ static void event_map__check_reference_counts ( Bool before )
    }
 }
 
-__attribute__((noinline))
-static void event_map_maybe_GC ( void )
+/* Remove all references to the ThrIDs in 'thrids' (which must be
+   sorted) from oldrefTree, in preparation for them being recycled.
+   Surviving entries in each OldRef are slid down so that the unused
+   slots remain at the end, and OldRefs which end up with no entries
+   at all are deleted. */
+static void event_map_purge_thrids ( XArray* thrids )
 {
    OldRef* oldref;
-   UWord   keyW, valW, retained, maxGen;
+   UWord   keyW, valW;
    XArray* refs2del;
    Word    i, j, n2del;
+   UWord   nPurged = 0;
 
-   UWord* genMap      = NULL;
-   UWord  genMap_min  = 0;
-   UWord  genMap_size = 0;
-
-   if (LIKELY(oldrefTreeN < HG_(clo_conflict_cache_size)))
+   tl_assert(thrids);
+   if (VG_(sizeXA)( thrids ) == 0)
       return;
 
-   if (0)
-      VG_(printf)("libhb: event_map GC at size %lu\n", oldrefTreeN);
-
-   /* Check for sane command line params.  Limit values must match
-      those in hg_process_cmd_line_option. */
-   tl_assert( HG_(clo_conflict_cache_size) >= 10*1000 );
-   tl_assert( HG_(clo_conflict_cache_size) <= 30*1000*1000 );
-
-   /* Check our counting is sane (expensive) */
-   if (CHECK_CEM)
-      tl_assert(oldrefTreeN == VG_(sizeSWA)( oldrefTree ));
-
-   /* Check the reference counts (expensive) */
-   if (CHECK_CEM)
-      event_map__check_reference_counts( True/*before*/ );
-
-   /* Compute the distribution of generation values in the ref tree.
-      There are likely only to be a few different generation numbers
-      in the whole tree, but we don't know what they are.  Hence use a
-      dynamically resized array of counters.  The array is genMap[0
-      .. genMap_size-1], where genMap[0] is the count for the
-      generation number genMap_min, genMap[1] is the count for
-      genMap_min+1, etc.  If a new number is seen outside the range
-      [genMap_min .. genMap_min + genMap_size - 1] then the array is
-      copied into a larger array, and genMap_min and genMap_size are
-      adjusted accordingly. */
-
-   /* genMap :: generation-number -> count-of-nodes-with-that-number */
-
-   VG_(initIterSWA)( oldrefTree );
-   while ( VG_(nextIterSWA)( oldrefTree, &keyW, &valW )) {
-
-       UWord ea, key;
-       oldref = (OldRef*)valW;
-       key = oldref->gen;
-
-      /* BEGIN find 'ea', which is the index in genMap holding the
-         count for generation number 'key'. */
-      if (UNLIKELY(genMap == NULL)) {
-         /* deal with the first key to be seen, so that the following
-            cases don't need to handle the complexity of a NULL count
-            array. */
-         genMap_min  = key;
-         genMap_size = 1;
-         genMap = HG_(zalloc)( "libhb.emmG.1a",
-                                genMap_size * sizeof(UWord) );
-         ea = 0;
-         if (0) VG_(printf)("(%lu) case 1 [%lu .. %lu]\n",
-                            key, genMap_min, genMap_min+genMap_size- 1 );
-      }
-      else
-      if (LIKELY(key >= genMap_min && key < genMap_min + genMap_size)) {
-         /* this is the expected (almost-always-happens) case: 'key'
-            is already mapped in the array. */
-         ea = key - genMap_min;
-      }
-      else
-      if (key < genMap_min) {
-         /* 'key' appears before the start of the current array.
-            Extend the current array by allocating a larger one and
-            copying the current one to the upper end of it. */
-         Word   more;
-         UWord* map2;
-         more = genMap_min - key;
-         tl_assert(more > 0);
-         map2 = HG_(zalloc)( "libhb.emmG.1b",
-                             (genMap_size + more) * sizeof(UWord) );
-         VG_(memcpy)( &map2[more], genMap, genMap_size * sizeof(UWord) );
-         HG_(free)( genMap );
-         genMap = map2;
-         genMap_size += more;
-         genMap_min -= more;
-         ea = 0;
-         tl_assert(genMap_min == key);
-         if (0) VG_(printf)("(%lu) case 2 [%lu .. %lu]\n",
-                            key, genMap_min,  genMap_min+genMap_size- 1 );
-      }
-      else {
-         /* 'key' appears after the end of the current array.  Extend
-            the current array by allocating a larger one and copying
-            the current one to the lower end of it. */
-         Word   more;
-         UWord* map2;
-         tl_assert(key >= genMap_min + genMap_size);
-         more = key - (genMap_min + genMap_size) + 1;
-         tl_assert(more > 0);
-         map2 = HG_(zalloc)( "libhb.emmG.1c",
-                             (genMap_size + more) * sizeof(UWord) );
-         VG_(memcpy)( &map2[0], genMap, genMap_size * sizeof(UWord) );
-         HG_(free)( genMap );
-         genMap = map2;
-         genMap_size += more;
-         ea = genMap_size - 1;;
-         tl_assert(genMap_min + genMap_size - 1 == key);
-         if (0) VG_(printf)("(%lu) case 3 [%lu .. %lu]\n",
-                            key, genMap_min, genMap_min+genMap_size- 1 );
-      }
-      /* END find 'ea' from 'key' */
-
-      tl_assert(ea >= 0 && ea < genMap_size);
-      /* and the whole point of this elaborate computation of 'ea' is .. */
-      genMap[ea]++;
-   }
-
-   tl_assert(genMap);
-   tl_assert(genMap_size > 0);
-
-   /* Sanity check what we just computed */
-   { UWord sum = 0;
-     for (i = 0; i < genMap_size; i++) {
-        if (0) VG_(printf)("  xxx: gen %ld has %lu\n",
-                           i + genMap_min, genMap[i] );
-        sum += genMap[i];
-     }
-     tl_assert(sum == oldrefTreeN);
-   }
-
-   /* Figure out how many generations to throw away */
-   retained = oldrefTreeN;
-   maxGen = 0;
-
-   for (i = 0; i < genMap_size; i++) {
-      keyW = i + genMap_min;
-      valW = genMap[i];
-      tl_assert(keyW > 0); /* can't allow a generation # 0 */
-      if (0) VG_(printf)("  XXX: gen %lu has %lu\n", keyW, valW );
-      tl_assert(keyW >= maxGen);
-      tl_assert(retained >= valW);
-      if (retained - valW
-          > (UWord)(HG_(clo_conflict_cache_size) 
-                    * EVENT_MAP_GC_DISCARD_FRACTION)) {
-         retained -= valW;
-         maxGen = keyW;
-      } else {
-         break;
-      }
-   }
-
-   HG_(free)(genMap);
-
-   tl_assert(retained >= 0 && retained <= oldrefTreeN);
-
-   /* Now make up a big list of the oldrefTree entries we want to
-      delete.  We can't simultaneously traverse the tree and delete
-      stuff from it, so first we need to copy them off somewhere
-      else. (sigh) */
-   refs2del = VG_(newXA)( HG_(zalloc), "libhb.emmG.2",
+   refs2del = VG_(newXA)( HG_(zalloc), "libhb.empt.1",
                           HG_(free), sizeof(Addr) );
 
-   if (retained < oldrefTreeN) {
-
-      /* This is the normal (expected) case.  We discard any ref whose
-         generation number <= maxGen. */
-      VG_(initIterSWA)( oldrefTree );
-      while (VG_(nextIterSWA)( oldrefTree, &keyW, &valW )) {
-         oldref = (OldRef*)valW;
-         tl_assert(oldref->magic == OldRef_MAGIC);
-         if (oldref->gen <= maxGen) {
-            VG_(addToXA)( refs2del, &keyW );
-         }
-      }
-      if (VG_(clo_stats)) {
-         VG_(message)(Vg_DebugMsg,
-            "libhb: EvM GC: delete generations %lu and below, "
-            "retaining %lu entries\n",
-            maxGen, retained );
-      }
-
-   } else {
-
-      static UInt rand_seed = 0; /* leave as static */
-
-      /* Degenerate case: there's only one generation in the entire
-         tree, so we need to have some other way of deciding which
-         refs to throw away.  Just throw out half of them randomly. */
-      tl_assert(retained == oldrefTreeN);
-      VG_(initIterSWA)( oldrefTree );
-      while (VG_(nextIterSWA)( oldrefTree, &keyW, &valW )) {
-         UInt n;
-         oldref = (OldRef*)valW;
-         tl_assert(oldref->magic == OldRef_MAGIC);
-         n = VG_(random)( &rand_seed );
-         if ((n & 0xFFF) < 0x800) {
-            VG_(addToXA)( refs2del, &keyW );
-            retained--;
+   VG_(initIterSWA)( oldrefTree );
+   while (VG_(nextIterSWA)( oldrefTree, &keyW, &valW )) {
+      oldref = (OldRef*)valW;
+      tl_assert(oldref->magic == OldRef_MAGIC);
+      for (i = 0, j = 0; i < N_OLDREF_ACCS; i++) {
+         ThrID aThrID = oldref->accs[i].thrid;
+         if (aThrID == 0)
+            break;
+         if (VG_(lookupXA)( thrids, &aThrID, NULL, NULL )) {
+            tl_assert(oldref->accs[i].rcec);
+            ctxt__rcdec( oldref->accs[i].rcec );
+            nPurged++;
+            continue;
          }
+         if (j < i)
+            oldref->accs[j] = oldref->accs[i];
+         j++;
       }
-      if (VG_(clo_stats)) {
-         VG_(message)(Vg_DebugMsg,
-            "libhb: EvM GC: randomly delete half the entries, "
-            "retaining %lu entries\n",
-            retained );
+      for (; j < i; j++) {
+         oldref->accs[j].rcec       = NULL;
+         oldref->accs[j].thrid      = 0;
+         oldref->accs[j].szLg2B     = 0;
+         oldref->accs[j].isW        = 0;
+         oldref->accs[j].locksHeldW = 0;
       }
-
+      if (oldref->accs[0].thrid == 0)
+         VG_(addToXA)( refs2del, &keyW );
    }
 
    n2del = VG_(sizeXA)( refs2del );
-   tl_assert(n2del == (Word)(oldrefTreeN - retained));
-
-   if (0) VG_(printf)("%s","deleting entries\n");
    for (i = 0; i < n2del; i++) {
       Bool  b;
       Addr  ga2del = *(Addr*)VG_(indexXA)( refs2del, i );
       b = VG_(delFromSWA)( oldrefTree, &keyW, &valW, ga2del );
       tl_assert(b);
       tl_assert(keyW == ga2del);
-      oldref = (OldRef*)valW;
-      for (j = 0; j < N_OLDREF_ACCS; j++) {
-         ThrID aThrID = oldref->accs[j].thrid;
-         RCEC* aRef   = oldref->accs[j].rcec;
-         if (aRef) {
-            tl_assert(aThrID != 0);
-            stats__ctxt_rcdec3++;
-            ctxt__rcdec( aRef );
-         } else {
-            tl_assert(aThrID == 0);
-         }
-      }
-
-      free_OldRef( oldref );
+      OldRef_unchain( (OldRef*)valW );
+      free_OldRef( (OldRef*)valW );
    }
-
    VG_(deleteXA)( refs2del );
 
-   tl_assert( VG_(sizeSWA)( oldrefTree ) == retained );
-
-   oldrefTreeN = retained;
-   oldrefGenIncAt = oldrefTreeN; /* start new gen right away */
+   tl_assert(oldrefTreeN >= (UWord)n2del);
+   oldrefTreeN -= n2del;
+   tl_assert( VG_(sizeSWA)( oldrefTree ) == oldrefTreeN );
 
-   /* Throw away all RCECs with zero reference counts */
-   for (i = 0; i < N_RCEC_TAB; i++) {
-      RCEC** pp = &contextTab[i];
-      RCEC*  p  = *pp;
-      while (p) {
-         if (p->rc == 0) {
-            *pp = p->next;
-            free_RCEC(p);
-            p = *pp;
-            tl_assert(stats__ctxt_tab_curr > 0);
-            stats__ctxt_tab_curr--;
-         } else {
-            pp = &p->next;
-            p = p->next;
-         }
-      }
+   if (VG_(clo_stats)) {
+      VG_(message)(Vg_DebugMsg,
+         "libhb: EvM purge: %lu ThrIDs, %lu accesses, %ld entries\n",
+         (UWord)VG_(sizeXA)( thrids ), nPurged, n2del );
    }
-
-   /* Check the reference counts (expensive) */
-   if (CHECK_CEM)
-      event_map__check_reference_counts( False/*after*/ );
-
-   //if (0)
-   //VG_(printf)("XXXX final sizes: oldrefTree %ld, contextTree %ld\n\n",
-   //            VG_(OSetGen_Size)(oldrefTree), VG_(OSetGen_Size)(contextTree));
-
 }
 
-
 /////////////////////////////////////////////////////////
 //                                                     //
 // Core MSM                                            //
@@ -4777,6 +4839,8 @@ static void event_map_maybe_GC ( void )
 
 static ULong stats__msmcread         = 0;
 static ULong stats__msmcread_change  = 0;
+static ULong stats__msmcread_fast    = 0;
+static ULong stats__msmcwrite_fast   = 0;
 static ULong stats__msmcwrite        = 0;
 static ULong stats__msmcwrite_change = 0;
 
@@ -4967,6 +5031,16 @@ static inline SVal msmcread ( SVal svOld,
    if (LIKELY(SVal__isC(svOld))) {
       VtsID tviR  = acc_thr->viR;
       VtsID tviW  = acc_thr->viW;
+      /* Fast path: the location was last written by this thread in
+         its current epoch (tviW <= tviR, so no race and the join is
+         the identity), or it has the same read-shared state as the
+         last location this thread read without changing it. */
+      if (svOld == SVal__mkC(tviW, tviW)
+          || (svOld == msm_fast_sv
+              && tviR == msm_fast_viR && tviW == msm_fast_viW)) {
+         stats__msmcread_fast++;
+         return svOld;
+      }
       VtsID rmini = SVal__unC_Rmin(svOld);
       VtsID wmini = SVal__unC_Wmin(svOld);
       Bool  leq   = VtsID__cmpLEQ(rmini,tviR);
@@ -4974,6 +5048,11 @@ static inline SVal msmcread ( SVal svOld,
          /* no race */
          /* Note: RWLOCK subtlety: use tviW, not tviR */
          svNew = SVal__mkC( rmini, VtsID__join2(wmini, tviW) );
+         if (svNew == svOld) {
+            msm_fast_sv  = svOld;
+            msm_fast_viR = tviR;
+            msm_fast_viW = tviW;
+         }
          goto out;
       } else {
          /* assert on sanity of constraints. */
@@ -5031,6 +5110,12 @@ static inline SVal msmcwrite ( SVal svOld,
 
    if (LIKELY(SVal__isC(svOld))) {
       VtsID tviW  = acc_thr->viW;
+      /* Fast path: already written by this thread in its current
+         epoch, so the new state is the same as the old. */
+      if (svOld == SVal__mkC(tviW, tviW)) {
+         stats__msmcwrite_fast++;
+         return svOld;
+      }
       VtsID wmini = SVal__unC_Wmin(svOld);
       Bool  leq   = VtsID__cmpLEQ(wmini,tviW);
       if (LIKELY(leq)) {
@@ -5614,6 +5699,97 @@ void zsm_sset_range_SMALL ( Addr a, SizeT len, SVal svNew )
 }
 
 
+/* Garbage collection of SecMaps.  A range of memory that has become
+   NoAccess (munmap'd, or mprotect'd to no access) looks just the same
+   as one that has no SecMap at all, so when all of a SecMap is
+   NoAccess it can be freed.  Any lines of it in the cache are dropped
+   rather than written back: the cache holds no references to SVals,
+   only the Z and F reps do, and those are rcdec'd here. */
+
+static inline Bool shmem__line_is_cached ( Addr tag, /*OUT*/UWord* wixp )
+{
+   UWord wix = (tag >> N_LINE_BITS) & (N_WAY_NENT - 1);
+   *wixp = wix;
+   return toBool(cache_shmem.tags0[wix] == tag);
+}
+
+/* Is every byte covered by sm (whose range starts at gaKey) in
+   NoAccess state?  Lines that are in the cache are looked at there,
+   since the cache is writeback.  Conservative: a line in F rep, or a
+   Z rep whose dictionary holds anything else, is taken to hold other
+   values. */
+static Bool shmem__SecMap_is_NoAccess ( Addr gaKey, SecMap* sm )
+{
+   UWord zix, i, wix;
+   for (zix = 0; zix < N_SECMAP_ZLINES; zix++) {
+      Addr tag = gaKey + zix * N_LINE_ARANGE;
+      if (shmem__line_is_cached(tag, &wix)) {
+         CacheLine* cl = &cache_shmem.lyns0[wix];
+         for (i = 0; i < N_LINE_ARANGE; i++)
+            if (cl->svals[i] != SVal_NOACCESS
+                && cl->svals[i] != SVal_INVALID)
+               return False;
+      } else {
+         LineZ* lineZ = &sm->linesZ[zix];
+         if (lineZ->dict[0] != SVal_NOACCESS
+             || lineZ->dict[1] != SVal_INVALID
+             || lineZ->dict[2] != SVal_INVALID
+             || lineZ->dict[3] != SVal_INVALID)
+            return False;
+      }
+   }
+   return True;
+}
+
+static void shmem__free_SecMap ( Addr gaKey, SecMap* sm )
+{
+   UWord zix, i, wix;
+   Bool  found;
+   tl_assert(is_sane_SecMap(sm));
+   tl_assert(gaKey == shmem__round_to_SecMap_base(gaKey));
+   for (zix = 0; zix < N_SECMAP_ZLINES; zix++) {
+      LineZ* lineZ = &sm->linesZ[zix];
+      if (shmem__line_is_cached(gaKey + zix * N_LINE_ARANGE, &wix))
+         cache_shmem.tags0[wix] = 1/*INVALID*/;
+      if (lineZ->dict[0] == SVal_INVALID) {
+         LineF* lineF = &sm->linesF[(UInt)lineZ->dict[1]];
+         rcdec_LineF(lineF);
+         lineF->inUse = False;
+      } else {
+         rcdec_LineZ(lineZ);
+      }
+   }
+   stats__secmaps_freed++;
+   stats__secmaps_freed_bytes
+      += sizeof(SecMap) + (ULong)sm->linesF_size * sizeof(LineF);
+   if (sm->linesF)
+      HG_(free)(sm->linesF);
+   sm->linesF      = NULL;
+   sm->linesF_size = 0;
+
+   found = VG_(delFromFM)( map_shmem, NULL, NULL, (UWord)gaKey );
+   tl_assert(found);
+   if (gaKey < shmem__flat_SecMaps_end)
+      shmem__flat_SecMaps[gaKey >> N_SECMAP_BITS] = NULL;
+   for (i = 0; i < 3; i++) {
+      if (smCache[i].gaKey == gaKey) {
+         smCache[i].gaKey = 1;
+         smCache[i].sm    = NULL;
+      }
+   }
+   sm->next_free = shmem__SecMap_freelist;
+   shmem__SecMap_freelist = sm;
+}
+
+/* Free the SecMap holding 'a', if it exists and is all NoAccess. */
+static void shmem__maybe_free_SecMap ( Addr a )
+{
+   Addr    gaKey = shmem__round_to_SecMap_base(a);
+   SecMap* sm    = shmem__find_SecMap(gaKey);
+   if (sm && shmem__SecMap_is_NoAccess(gaKey, sm))
+      shmem__free_SecMap(gaKey, sm);
+}
+
 /* If we're doing a small range, hand off to zsm_sset_range_SMALL.  But
    for larger ranges, try to operate directly on the out-of-cache
    representation, rather than dragging lines into the cache,
@@ -5684,9 +5860,24 @@ static void zsm_sset_range ( Addr a, SizeT len, SVal svNew )
          if (aligned_start >= after_start)
             break;
          tl_assert(get_cacheline_offset(aligned_start) == 0);
+         if (svNew == SVal_NOACCESS
+             && shmem__get_SecMap_offset(aligned_start) == 0
+             && after_start - aligned_start >= N_SECMAP_ARANGE) {
+            /* A whole SecMap becomes NoAccess: free it, if there is
+               one, rather than filling it in. */
+            SecMap* sm = shmem__find_SecMap(aligned_start);
+            if (sm)
+               shmem__free_SecMap(aligned_start, sm);
+            aligned_start += N_SECMAP_ARANGE;
+            aligned_len   -= N_SECMAP_ARANGE;
+            continue;
+         }
          tag = aligned_start & ~(N_LINE_ARANGE - 1);
          wix = (aligned_start >> N_LINE_BITS) & (N_WAY_NENT - 1);
-         if (tag == cache_shmem.tags0[wix]) {
+         if (svNew == SVal_NOACCESS && tag != cache_shmem.tags0[wix]
+             && shmem__find_SecMap(tag) == NULL) {
+            /* Nothing to do: no SecMap means NoAccess already. */
+         } else if (tag == cache_shmem.tags0[wix]) {
             UWord i;
             for (i = 0; i < N_LINE_ARANGE / 8; i++)
                zsm_swrite64( aligned_start + i * 8, svNew );
@@ -5714,6 +5905,15 @@ static void zsm_sset_range ( Addr a, SizeT len, SVal svNew )
       }
       tl_assert(aligned_start == after_start);
       tl_assert(aligned_len == 0);
+
+      /* The SecMaps at either end, which were only partly covered,
+         may now be all NoAccess too. */
+      if (svNew == SVal_NOACCESS) {
+         shmem__maybe_free_SecMap(a);
+         if (shmem__round_to_SecMap_base(a + len - 1)
+             != shmem__round_to_SecMap_base(a))
+            shmem__maybe_free_SecMap(a + len - 1);
+      }
    }
 }
 
@@ -5976,6 +6176,7 @@ void libhb_Thr_resumes ( Thr* thr )
    tl_assert(thr);
    tl_assert(!thr->llexit_done);
    Filter__clear(thr->filter, "libhb_Thr_resumes");
+   cache_stats_switch_to(thr);
    /* A kludge, but .. if this thread doesn't have any marker stacks
       at all, get one right now.  This is easier than figuring out
       exactly when at thread startup we can and can't take a stack
@@ -6174,6 +6375,10 @@ void libhb_shutdown ( Bool show_stats )
       VG_(printf)(" secmaps: %'10lu allocd (%'12lu g-a-range)\n",
                   stats__secmaps_allocd,
                   stats__secmap_ga_space_covered);
+      VG_(printf)(" secmaps: %'10lu freed  (%'12llu bytes reclaimed), "
+                  "%'lu in use\n",
+                  stats__secmaps_freed, stats__secmaps_freed_bytes,
+                  VG_(sizeFM)( map_shmem ));
       VG_(printf)("  linesZ: %'10lu allocd (%'12lu bytes occupied)\n",
                   stats__secmap_linesZ_allocd,
                   stats__secmap_linesZ_bytes);
@@ -6184,6 +6389,13 @@ void libhb_shutdown ( Bool show_stats )
                   stats__secmap_iterator_steppings);
       VG_(printf)(" secmaps: %'10lu searches (%'12lu slow)\n",
                   stats__secmaps_search, stats__secmaps_search_slow);
+      if (shmem__flat_SecMaps != NULL) {
+         SizeT szB = (shmem__flat_SecMaps_end >> N_SECMAP_BITS)
+                     * sizeof(SecMap*);
+         VG_(printf)(" secmaps: lookup table %'lu bytes (%'lu in use)\n",
+                     szB, VG_(am_flat_shadow_committed)( shmem__flat_SecMaps,
+                                                         szB ));
+      }
 
       VG_(printf)("%s","\n");
       VG_(printf)("   cache: %'lu totrefs (%'lu misses)\n",
@@ -6197,10 +6409,46 @@ void libhb_shutdown ( Bool show_stats )
       VG_(printf)("   cache: %'14llu arange_New  %'14llu direct-to-Zreps\n",
                   stats__cache_make_New_arange,
                   stats__cache_make_New_inZrep);
+      if (thrid_to_thr_map) {
+         /* Per-thread figures, for the threads that did the most
+            references. */
+#        define N_SHOW 10
+         Word  i, j, n_thrs = VG_(sizeXA)( thrid_to_thr_map );
+         Thr*  top[N_SHOW];
+         Word  n_top = 0;
+         HChar hit[8];
+         cache_stats_switch_to(cache_stats_thr);
+         for (i = 0; i < n_thrs; i++) {
+            Thr* thr = *(Thr**)VG_(indexXA)( thrid_to_thr_map, i );
+            for (j = n_top; j > 0; j--) {
+               if (top[j-1]->stats_cache_refs >= thr->stats_cache_refs)
+                  break;
+               if (j < N_SHOW)
+                  top[j] = top[j-1];
+            }
+            if (j < N_SHOW) {
+               top[j] = thr;
+               if (n_top < N_SHOW)
+                  n_top++;
+            }
+         }
+#        undef N_SHOW
+         for (i = 0; i < n_top && top[i]->stats_cache_refs > 0; i++) {
+            Thr* thr = top[i];
+            VG_(percentify)( thr->stats_cache_refs - thr->stats_cache_misses,
+                             thr->stats_cache_refs, 2, 7, hit );
+            VG_(printf)("   cache: thr#%u %'14lu refs, %s hit, "
+                        "%'lu wbacks\n",
+                        (UInt)thr->thrid, thr->stats_cache_refs,
+                        hit, thr->stats_cache_wbacks );
+         }
+         if (n_thrs > n_top)
+            VG_(printf)("   cache: (%ld threads in all)\n", n_thrs);
+      }
 
       VG_(printf)("%s","\n");
-      VG_(printf)("   cline: %'10lu normalises\n",
-                  stats__cline_normalises );
+      VG_(printf)("   cline: %'10lu normalises (%'lu trees whole)\n",
+                  stats__cline_normalises, stats__cline_whole_trees );
       VG_(printf)("   cline: c rds 8/4/2/1: %'13lu %'13lu %'13lu %'13lu\n",
                   stats__cline_cread64s,
                   stats__cline_cread32s,
@@ -6232,10 +6480,14 @@ void libhb_shutdown ( Bool show_stats )
 
       VG_(printf)("%s","\n");
 
-      VG_(printf)("   libhb: %'13llu msmcread  (%'llu dragovers)\n",
-                  stats__msmcread, stats__msmcread_change);
-      VG_(printf)("   libhb: %'13llu msmcwrite (%'llu dragovers)\n",
-                  stats__msmcwrite, stats__msmcwrite_change);
+      VG_(printf)("   libhb: %'13llu msmcread  (%'llu dragovers, "
+                  "%'llu fast)\n",
+                  stats__msmcread, stats__msmcread_change,
+                  stats__msmcread_fast);
+      VG_(printf)("   libhb: %'13llu msmcwrite (%'llu dragovers, "
+                  "%'llu fast)\n",
+                  stats__msmcwrite, stats__msmcwrite_change,
+                  stats__msmcwrite_fast);
       VG_(printf)("   libhb: %'13llu cmpLEQ queries (%'llu misses)\n",
                   stats__cmpLEQ_queries, stats__cmpLEQ_misses);
       VG_(printf)("   libhb: %'13llu join2  queries (%'llu misses)\n",
@@ -6258,6 +6510,11 @@ void libhb_shutdown ( Bool show_stats )
       );
       VG_(printf)( "   libhb: %lu entries in vts_set\n",
                    VG_(sizeFM)( vts_set ) );
+      VG_(printf)( "   libhb: ThrIDs: %u from counter, %lu recycled, "
+                   "%ld pruned, %ld free\n",
+                   (UInt)(thrid_counter - 1024), stats__thrids_recycled,
+                   VG_(sizeXA)( pruned_thrid_table ),
+                   VG_(sizeXA)( free_thrid_table ) );
 
       VG_(printf)("%s","\n");
       VG_(printf)( "   libhb: ctxt__rcdec: 1=%lu(%lu eq), 2=%lu, 3=%lu\n",
@@ -6266,6 +6523,8 @@ void libhb_shutdown ( Bool show_stats )
                    stats__ctxt_rcdec3 );
       VG_(printf)( "   libhb: ctxt__rcdec: calls %lu, discards %lu\n",
                    stats__ctxt_rcdec_calls, stats__ctxt_rcdec_discards);
+      VG_(printf)( "   libhb: oldrefTree: %lu entries, %lu recycled\n",
+                   oldrefTreeN, stats__oldref_recycled );
       VG_(printf)( "   libhb: contextTab: %lu slots, %lu max ents\n",
                    (UWord)N_RCEC_TAB,
                    stats__ctxt_tab_curr );
@@ -6552,7 +6811,9 @@ void libhb_copy_shadow_state ( Thr* thr, Addr src, Addr dst, SizeT len )
 
 void libhb_maybe_GC ( void )
 {
-   event_map_maybe_GC();
+   /* Check the reference counts (expensive) */
+   if (CHECK_CEM)
+      event_map__check_reference_counts( False/*!before*/ );
    /* If there are still freelist entries available, no need for a
       GC. */
    if (vts_tab_freelist != VtsID_INVALID)
@@ -0,0 +1,131 @@
+/* Tests pthread_mutex_trylock and pthread_mutex_timedlock: which
+   errors Helgrind reports for them and in which order, and that a lock
+   taken with either of them protects the accesses made while it is
+   held.  All the errors are in the root thread, so that the output
+   doesn't depend on the scheduling. */
+
+#include <assert.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+static pthread_mutex_t mx = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t held = PTHREAD_MUTEX_INITIALIZER;
+static int shared1 = 0, shared2 = 0;
+static int to_main[2], to_child[2];
+
+static void in_10ms ( struct timespec* ts )
+{
+   clock_gettime(CLOCK_REALTIME, ts);
+   ts->tv_nsec += 10 * 1000 * 1000;
+   if (ts->tv_nsec >= 1000 * 1000 * 1000) {
+      ts->tv_sec++;
+      ts->tv_nsec -= 1000 * 1000 * 1000;
+   }
+}
+
+static const char* err ( int r )
+{
+   return r == 0 ? "0" : r == EBUSY ? "EBUSY"
+          : r == ETIMEDOUT ? "ETIMEDOUT" : r == EINVAL ? "EINVAL" : "other";
+}
+
+/* Writes shared1 and shared2 without a lock. */
+static void* racer ( void* v )
+{
+   char c = 'x';
+   shared1 = 1;
+   shared2 = 1;
+   assert(write(to_main[1], &c, 1) == 1);
+   assert(read(to_child[0], &c, 1) == 1);
+   return NULL;
+}
+
+/* Holds 'held' until main has tried to take it. */
+static void* holder ( void* v )
+{
+   char c = 'x';
+   pthread_mutex_lock(&held);
+   assert(write(to_main[1], &c, 1) == 1);
+   assert(read(to_child[0], &c, 1) == 1);
+   pthread_mutex_unlock(&held);
+   return NULL;
+}
+
+int main ( void )
+{
+   pthread_t t;
+   pthread_rwlock_t rw;
+   pthread_mutex_t gone;
+   struct timespec ts;
+   char c = 'x';
+   int r;
+
+   assert(pipe(to_main) == 0 && pipe(to_child) == 0);
+
+   /* Races with a thread that takes no lock: each report shows the
+      lock taken by trylock or timedlock as held. */
+   assert(pthread_create(&t, NULL, racer, NULL) == 0);
+   assert(read(to_main[0], &c, 1) == 1);
+   r = pthread_mutex_trylock(&mx);
+   fprintf(stderr, "trylock: %s\n", err(r));
+   shared1++;
+   pthread_mutex_unlock(&mx);
+   clock_gettime(CLOCK_REALTIME, &ts);
+   ts.tv_sec += 60;
+   r = pthread_mutex_timedlock(&mx, &ts);
+   fprintf(stderr, "timedlock: %s\n", err(r));
+   shared2++;
+   pthread_mutex_unlock(&mx);
+   assert(write(to_child[1], &c, 1) == 1);
+   pthread_join(t, NULL);
+
+   /* Lock held by another thread: both fail, no error. */
+   assert(pthread_create(&t, NULL, holder, NULL) == 0);
+   assert(read(to_main[0], &c, 1) == 1);
+   r = pthread_mutex_trylock(&held);
+   fprintf(stderr, "trylock held by other thread: %s\n", err(r));
+   in_10ms(&ts);
+   r = pthread_mutex_timedlock(&held, &ts);
+   fprintf(stderr, "timedlock held by other thread: %s\n", err(r));
+   assert(write(to_child[1], &c, 1) == 1);
+   pthread_join(t, NULL);
+
+   /* Non-recursive lock held by this thread: both fail, and unlike
+      pthread_mutex_lock this is not an error. */
+   pthread_mutex_lock(&mx);
+   r = pthread_mutex_trylock(&mx);
+   fprintf(stderr, "trylock held by this thread: %s\n", err(r));
+   in_10ms(&ts);
+   r = pthread_mutex_timedlock(&mx, &ts);
+   fprintf(stderr, "timedlock held by this thread: %s\n", err(r));
+   pthread_mutex_unlock(&mx);
+
+   /* A rwlock passed in: an error each time, whether the call succeeds
+      or not. */
+   pthread_rwlock_init(&rw, NULL);
+   r = pthread_mutex_trylock((pthread_mutex_t*)&rw);
+   fprintf(stderr, "trylock on new rwlock: %s\n", err(r));
+   if (r == 0)
+      pthread_mutex_unlock((pthread_mutex_t*)&rw);
+   pthread_rwlock_wrlock(&rw);
+   r = pthread_mutex_trylock((pthread_mutex_t*)&rw);
+   fprintf(stderr, "trylock on write-locked rwlock: %s\n", err(r));
+   pthread_rwlock_unlock(&rw);
+   pthread_rwlock_destroy(&rw);
+
+   /* A destroyed and overwritten mutex: the call fails with EINVAL. */
+   pthread_mutex_init(&gone, NULL);
+   pthread_mutex_destroy(&gone);
+   memset(&gone, 0xff, sizeof(gone));
+   r = pthread_mutex_trylock(&gone);
+   fprintf(stderr, "trylock on destroyed mutex: %s\n", err(r));
+   in_10ms(&ts);
+   r = pthread_mutex_timedlock(&gone, &ts);
+   fprintf(stderr, "timedlock on destroyed mutex: %s\n", err(r));
+
+   return 0;
+}
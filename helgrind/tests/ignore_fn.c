@@ -0,0 +1,42 @@
+/* The same race in two functions, one of which is left out with
+   --ignore-fn.  Only the race in the other one is reported. */
+
+#include <pthread.h>
+#include <unistd.h>
+
+static int ignored_var;
+static int checked_var;
+
+__attribute__((noinline))
+static void ignored_update(void)
+{
+	ignored_var++;
+}
+
+__attribute__((noinline))
+static void checked_update(void)
+{
+	checked_var++;
+}
+
+static void *th(void *v)
+{
+	ignored_update();
+	checked_update();
+
+	return 0;
+}
+
+int main()
+{
+	pthread_t a, b;
+
+	pthread_create(&a, NULL, th, NULL);
+	sleep(1);		/* force ordering */
+	pthread_create(&b, NULL, th, NULL);
+
+	pthread_join(a, NULL);
+	pthread_join(b, NULL);
+
+	return 0;
+}
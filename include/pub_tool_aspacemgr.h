@@ -112,6 +112,7 @@ typedef
       Bool    hasT;     // True --> translations have (or MAY have)
                         // been taken from this segment
       Bool    isCH;     // True --> is client heap (SkAnonC ONLY)
+      Bool    isShared; // True --> mapped MAP_SHARED (SkAnonC, SkFileC)
       /* Admin */
       Bool    mark;
    }
@@ -148,6 +149,42 @@ extern Bool VG_(am_is_valid_for_client) ( Addr start, SizeT len,
 /* Really just a wrapper around VG_(am_mmap_anon_float_valgrind). */
 extern void* VG_(am_shadow_alloc)(SizeT size);
 
+/* The huge page size V's own big mappings are being backed with
+   (--huge-pages), or 0 if they aren't.  Tools can use it to carve
+   their shadow memory out of chunks of that size rather than mapping
+   small pieces of it one at a time. */
+extern SizeT VG_(am_huge_page_szB) ( void );
+
+/* Flat shadow regions.  Rather than a multi-level map, a tool can
+   reserve one big region of address space at startup and find the
+   shadow of a client address by scaling it and adding it to the base.
+   The region reads as zeroes, and its pages only use memory once
+   written to (on Linux; elsewhere, it is an ordinary mapping).
+   Returns NULL if the space isn't available. */
+extern void* VG_(am_flat_shadow_reserve) ( SizeT size );
+
+/* Client addresses below this cover the client's heap, stack and
+   anonymous mappings, so this is what a flat shadow region needs to
+   cover.  Other client mappings can only be at higher addresses if
+   the client asked for them explicitly. */
+extern Addr VG_(am_flat_shadow_span) ( void );
+
+/* How much of [base, base+size) of a flat shadow region is actually
+   backed by memory? */
+extern SizeT VG_(am_flat_shadow_committed) ( void* base, SizeT size );
+
+/* Give back the pages of [base, base+size) of a flat shadow region
+   which are all zeroes, so that they stop using memory.  They read as
+   zeroes afterwards, as before.  Returns the number of bytes given
+   back. */
+extern SizeT VG_(am_flat_shadow_release_zeroes) ( void* base, SizeT size );
+
+/* How much of the client's mappings is resident, as shown by
+   /proc/self/smaps, so not counting V's own memory.  This reads the
+   whole file, so it is too slow to call often.  Gives 0 if it can't be
+   found out. */
+extern SizeT VG_(am_client_rss_szB) ( void );
+
 /* Unmap the given address range and update the segment array
    accordingly.  This fails if the range isn't valid for valgrind. */
 extern SysRes VG_(am_munmap_valgrind)( Addr start, SizeT length );
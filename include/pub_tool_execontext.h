@@ -83,6 +83,12 @@ extern void VG_(apply_ExeContext)( void(*action)(UInt n, Addr ip),
 //   Vg_HighRes: all
 extern Bool VG_(eq_ExeContext) ( VgRes res, ExeContext* e1, ExeContext* e2 );
 
+// A hash and a total ordering of ExeContexts that agree with
+// VG_(eq_ExeContext) for the same `res': ExeContexts it finds equal hash
+// to the same value and compare as 0.
+extern UWord VG_(hash_ExeContext) ( VgRes res, ExeContext* e );
+extern Word  VG_(cmp_ExeContext)  ( VgRes res, ExeContext* e1, ExeContext* e2 );
+
 // Print an ExeContext.
 extern void VG_(pp_ExeContext) ( ExeContext* ec );
 
@@ -95,6 +101,13 @@ extern UInt VG_(get_ECU_from_ExeContext)( ExeContext* e );
 // How many entries (frames) in this ExeContext?
 extern Int VG_(get_ExeContext_n_ips)( ExeContext* e );
 
+// Extract the StackTrace from an ExeContext.
+// (Minor hack: we use Addr* as the return type instead of StackTrace so
+// that modules #including this file don't also have to #include
+// pub_tool_stacktrace.h also.)
+extern
+/*StackTrace*/Addr* VG_(get_ExeContext_StackTrace) ( ExeContext* e );
+
 // Find the ExeContext that has the given ECU, if any.
 // NOTE: very slow.  Do not call often.
 extern ExeContext* VG_(get_ExeContext_from_ECU)( UInt uniq );
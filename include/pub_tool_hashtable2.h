@@ -0,0 +1,71 @@
+
+/*--------------------------------------------------------------------*/
+/*--- An open-addressing hash table.          pub_tool_hashtable2.h ---*/
+/*--------------------------------------------------------------------*/
+
+/*
+   This file is part of Valgrind, a dynamic binary instrumentation
+   framework.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of the
+   License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+   02111-1307, USA.
+
+   The GNU General Public License is contained in the file COPYING.
+*/
+
+#ifndef __PUB_TOOL_HASHTABLE2_H
+#define __PUB_TOOL_HASHTABLE2_H
+
+#include "pub_tool_basics.h"      // VG_ macro
+#include "pub_tool_hashtable.h"   // VgHashNode, HT_Cmp_t
+
+/* A hash table with the same interface as VgHashTable, but using open
+   addressing rather than separate chaining: the table holds pointers
+   to the nodes, and a control byte per slot with some bits of the
+   hash of the slot's key, which are checked for a whole group of
+   slots at once.  So a lookup, whether it succeeds or not, nearly
+   always reads only one group of control bytes and one slot, and
+   looks at no node but the one it finds.  Use it for large tables
+   which are looked up often, such as the tables of heap blocks.
+
+   The nodes are VgHashNodes, as for VgHashTable; the 'next' field is
+   used to chain nodes with duplicate keys, which are permitted.  As
+   for VgHashTable, the most recently added of the duplicates is the
+   one found by VG_(HT2_lookup) and removed by VG_(HT2_remove).  The
+   functions below are as the VG_(HT_*) ones of the same names. */
+
+typedef struct _VgHashTable2 * VgHashTable2;
+
+extern VgHashTable2 VG_(HT2_construct) ( const HChar* name );
+extern Int   VG_(HT2_count_nodes) ( VgHashTable2 table );
+extern void  VG_(HT2_add_node)    ( VgHashTable2 t, void* node );
+extern void* VG_(HT2_lookup)      ( VgHashTable2 table, UWord key );
+extern void* VG_(HT2_remove)      ( VgHashTable2 table, UWord key );
+extern void* VG_(HT2_gen_lookup)  ( VgHashTable2 table, void* node,
+                                    HT_Cmp_t cmp );
+extern void* VG_(HT2_gen_remove)  ( VgHashTable2 table, void* node,
+                                    HT_Cmp_t cmp );
+extern VgHashNode** VG_(HT2_to_array) ( VgHashTable2 t,
+                                        /*OUT*/ UInt* n_elems );
+extern void  VG_(HT2_ResetIter)   ( VgHashTable2 table );
+extern void* VG_(HT2_Next)        ( VgHashTable2 table );
+extern void  VG_(HT2_destruct)    ( VgHashTable2 t,
+                                    void(*freenode_fn)(void*) );
+
+#endif   // __PUB_TOOL_HASHTABLE2_H
+
+/*--------------------------------------------------------------------*/
+/*--- end                                                          ---*/
+/*--------------------------------------------------------------------*/
@@ -89,6 +89,31 @@ extern Int VG_(getegid) ( void );
 // steps).
 extern UInt VG_(read_millisecond_timer) ( void );
 
+/* ---------------------------------------------------------------------
+   Worker threads
+   ------------------------------------------------------------------ */
+
+// Runs fn(arg, i) for each i in 0 .. n-1, and returns when all of them
+// have finished.  i == 0 runs on the calling thread.  On amd64-linux the
+// others each get a host thread of their own (falling back to the
+// calling thread if one can't be created); elsewhere they all run on the
+// calling thread, one after another.  The extra threads have all signals
+// blocked and are unknown to the rest of Valgrind, so fn may only read
+// memory that cannot fault and update shared data atomically.  While
+// the workers run, allocation and printing are serialised between them
+// (at a cost to both), but fn must not call anything else that keeps
+// state, except for read-only address space queries.  n must not be
+// more than VG_MAX_WORKERS.
+#define VG_MAX_WORKERS 64
+extern void VG_(run_workers) ( Int n, void (*fn)(void* arg, Int i),
+                               void* arg );
+
+// Which of the running workers' threads this is: a number in
+// 0 .. VG_MAX_WORKERS-1 which no other thread running at the same time
+// has.  0 on the calling thread of VG_(run_workers), and when no
+// workers are running.
+extern Int VG_(worker_self) ( void );
+
 /* ---------------------------------------------------------------------
    atfork
    ------------------------------------------------------------------ */
@@ -35,7 +35,7 @@
 
 //--------------------------------------------------------------------
 // PURPOSE: Provides efficient allocation and free of elements of
-// the same size.
+// the same size, and regions for bulk allocation (see below).
 // This pool allocator manages elements alloc/free by allocating
 // "pools" of many elements from a lower level allocator (typically
 // pub_tool_mallocfree.h).
@@ -88,6 +88,50 @@ extern void VG_(addRefPA) ( PoolAlloc* pa);
 // count.
 extern UWord VG_(releasePA) ( PoolAlloc* pa);
 
+
+//--------------------------------------------------------------------
+// Regions: scoped bump allocation, for data that lives for one phase
+// of a computation.  Memory is taken from a lower level allocator in
+// large blocks and handed out by bumping a pointer; it is only given
+// back, all at once, when the region is freed.
+//
+// Regions nest.  VG_(allocInRegion) and VG_(freeInRegion) work on the
+// innermost live region and have the signatures of the alloc and free
+// callbacks of XArray, OSet, WordFM and PoolAlloc, so any of those can
+// be built in a region:
+//
+//    Region* r  = VG_(newRegion)(VG_(malloc), "tool.phase", VG_(free));
+//    XArray* xa = VG_(newXA)(VG_(allocInRegion), "tool.phase.1",
+//                            VG_(freeInRegion), sizeof(Addr));
+//    ... use xa ...
+//    VG_(freeRegion)(r);   // xa is gone; no VG_(deleteXA) needed
+//
+// A structure built in a region must only grow while that region is
+// the innermost one.  Regions are not thread safe.
+//--------------------------------------------------------------------
+
+typedef  struct _Region  Region;
+
+/* Create a new region, which becomes the innermost one.  Its blocks
+   come from alloc, which must not fail, and go back via free_fn. */
+extern Region* VG_(newRegion) ( void*  (*alloc)(const HChar*, SizeT),
+                                const  HChar* cc,
+                                void   (*free_fn)(void*) );
+
+/* Free r and everything allocated in it.  r must be the innermost
+   region; its enclosing region becomes the innermost one again. */
+extern void VG_(freeRegion) ( Region* r );
+
+/* Allocate nbytes from the innermost region.  The result is aligned
+   as VG_(malloc)'s is.  cc is ignored; it is there so that this can be
+   passed as an alloc callback. */
+extern void* VG_(allocInRegion) ( const HChar* cc, SizeT nbytes );
+
+/* Usually does nothing: the memory is reclaimed by VG_(freeRegion).
+   Only the most recent allocation of the innermost region is given
+   back, which makes push/pop usage cheap. */
+extern void VG_(freeInRegion) ( void* p );
+
 #endif   // __PUB_TOOL_POOLALLOC_
 
 /*--------------------------------------------------------------------*/
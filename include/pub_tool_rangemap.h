@@ -57,8 +57,9 @@ void VG_(deleteRangeMap) ( RangeMap* );
 /* Bind the range [key_min, key_max] to val, overwriting any other
    bindings existing in the range.  Asserts if key_min > key_max.  If
    as a result of this addition, there come to be multiple adjacent
-   ranges with the same value, these ranges are merged together.  Note
-   that this is slow: O(N) in the number of existing ranges. */
+   ranges with the same value, these ranges are merged together.  This
+   is O(log N) in the number of existing ranges, plus O(log N) for
+   each range that [key_min, key_max] covers. */
 void VG_(bindRangeMap) ( RangeMap* rm,
                          UWord key_min, UWord key_max, UWord val );
 
@@ -72,10 +73,23 @@ void VG_(lookupRangeMap) ( /*OUT*/UWord* key_min, /*OUT*/UWord* key_max,
 /* How many elements are there in the map? */
 Word VG_(sizeRangeMap) ( RangeMap* rm );
 
-/* Get the i'th component */
+/* Get the i'th component.  Getting the components in increasing
+   order of i costs O(1) each; otherwise this is O(i). */
 void VG_(indexRangeMap) ( /*OUT*/UWord* key_min, /*OUT*/UWord* key_max,
                           /*OUT*/UWord* val, RangeMap* rm, Word ix );
 
+/* Set up rm for iteration so that the first range produced by
+   VG_(nextIterRangeMap) is the one containing |key|.  To visit the
+   ranges overlapping [lo, hi], start at lo and stop after the range
+   whose key_max is >= hi.  Behaviour is undefined if rm is changed
+   by VG_(bindRangeMap) during the iteration. */
+void VG_(initIterRangeMap) ( RangeMap* rm, UWord key );
+
+/* Get the next range in increasing key order.  Returns False when
+   there are no more. */
+Bool VG_(nextIterRangeMap) ( RangeMap* rm, /*OUT*/UWord* key_min,
+                             /*OUT*/UWord* key_max, /*OUT*/UWord* val );
+
 #endif   // __PUB_TOOL_RANGEMAP_H
 
 /*--------------------------------------------------------------------*/
@@ -55,6 +55,16 @@ SparseWA* VG_(newSWA) ( void*(*alloc_nofail)(const HChar* cc, SizeT),
                         const HChar* cc,
                         void(*dealloc)(void*) );
 
+// Create a new one that uses an adaptive radix tree: nodes have room
+// for 4, 16, 48 or 256 entries, growing and shrinking as needed, and
+// chains of nodes with a single child are collapsed.  Much smaller
+// than the plain variant when keys are clustered, and lookups don't
+// have to go through all sizeof(UWord) levels.  The interface is the
+// same for both.
+SparseWA* VG_(newSWA_ART) ( void*(*alloc_nofail)(const HChar* cc, SizeT),
+                            const HChar* cc,
+                            void(*dealloc)(void*) );
+
 // Delete one, and free all associated storage
 void VG_(deleteSWA) ( SparseWA* swa );
 
@@ -33,12 +33,14 @@
 
 #include "pub_tool_basics.h"   // ThreadID
 
-/* The maximum number of pthreads that we support.  This is
-   deliberately not very high since our implementation of some of the
-   scheduler algorithms is surely O(N) in the number of threads, since
-   that's simple, at least.  And (in practice) we hope that most
-   programs do not need many threads. */
-#define VG_N_THREADS 500
+/* The maximum number of pthreads that we support, plus one (as
+   ThreadId 0 is never used).  It is 500 unless changed with
+   --max-threads, and is fixed from before the tool's pre_clo_init
+   onwards, so tables indexed by ThreadId can be allocated there or
+   later.  Some of the scheduler algorithms are O(N) in the number of
+   threads, since that's simple, at least. */
+extern UInt VG_(n_threads);
+#define VG_N_THREADS (VG_(n_threads))
 
 /* Special magic value for an invalid ThreadId.  It corresponds to
    LinuxThreads using zero as the initial value for
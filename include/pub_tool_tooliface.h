@@ -458,6 +458,14 @@ extern void VG_(needs_print_stats) (
    void (*print_stats)(void)
 );
 
+/* Has the tool metrics to give, in addition to the core ones, to the
+   "v.info metrics" monitor command and to --metrics-file? */
+extern void VG_(needs_metrics) (
+   // Give each metric to put.  Names should start with the tool name
+   // and a '.', and keep their meaning from one release to the next.
+   void (*metrics)(void (*put)(const HChar* name, ULong value))
+);
+
 /* Has the tool a tool specific function to retrieve and print location info
    of an address ? */
 extern void VG_(needs_info_location) (
@@ -496,6 +504,57 @@ extern void VG_(needs_xml_output) ( void );
    function here. */
 extern void VG_(needs_final_IR_tidy_pass) ( IRSB*(*final_tidy)(IRSB*) );
 
+/* Can the tool's translations be saved and reused by a later run
+   (--transtab-cache)?  Only say so if the instrumentation depends on
+   nothing but the guest code and the command line options: in
+   particular it must not embed addresses of, or keep, any per-run or
+   per-superblock state.  May be called from post_clo_init. */
+extern void VG_(needs_persistent_translations) ( void );
+
+/* Can the tool's translations be run by several threads at once
+   (--parallel-threads)?  Only say so if the instrumentation, and any
+   helper it calls, touches nothing but the guest state and guest
+   memory, or else updates shared state atomically: the helpers run
+   without the_BigLock, so they must not call into the core, and
+   VG_(get_running_tid) means nothing in them. */
+extern void VG_(needs_thread_safe_instrumentation) ( void );
+
+/* Can the tool take the stack events of several consecutive stack
+   pointer changes as one?  If so, within a superblock, a run of
+   decrements of SP is reported with a single new_mem_stack event at
+   the first of them, covering them all, and a run of increments with
+   a single die_mem_stack event at the last of them.  The tool must
+   then not rely on the sizes of the events matching the program's
+   pushes and pops.  Runs are never merged across a side exit, nor
+   when origin tags are wanted (new_mem_stack_w_ECU). */
+extern void VG_(needs_merged_stack_events) ( void );
+
+/* Can the program be run without the tool's instrumentation at first
+   (--fast-forward)?  The core then translates the code without calling
+   the instrument function, nor tracking the stack pointer, until the
+   instrumentation starts.  start_instrumentation is called at that
+   point, before any instrumented code runs, to bring the tool's state
+   up to date with what happened meanwhile. */
+extern void VG_(needs_fast_forward) (
+   void (*start_instrumentation)(void)
+);
+
+/* Can the tool instrument code cheaply, for --skip-instrument and
+   --instrument-only?  instrument_skipped is then used instead of the
+   instrument function for the code of the objects and functions which
+   the user asks to skip.  It need do no checking (the core drops the
+   errors found in that code anyway), but must keep the tool's state
+   consistent for the rest of the code: for instance Memcheck marks
+   the memory and registers written by skipped code as defined. */
+extern void VG_(needs_instrumentation_filter) (
+   IRSB*(*instrument_skipped)(VgCallbackClosure* closure,
+                              IRSB* sb_in,
+                              VexGuestLayout* layout,
+                              VexGuestExtents* vge,
+                              VexArchInfo* archinfo_host,
+                              IRType gWordTy, IRType hWordTy)
+);
+
 
 /* ------------------------------------------------------------------ */
 /* Core events to track */
@@ -620,6 +679,27 @@ void VG_(track_pre_mem_write)      (void(*f)(CorePart part, ThreadId tid,
 void VG_(track_post_mem_write)     (void(*f)(CorePart part, ThreadId tid,
                                              Addr a, SizeT size));
 
+/* The same, for the first 'max_len' bytes of the 'n_iov' buffers
+   described by 'iov', as a system call such as readv, writev, sendmsg or
+   recvmsg uses them.  The core has checked that 'iov' itself can be
+   read.  If a tool doesn't provide these, the core calls the ones above
+   once for each buffer, so they are only worth providing if a tool can
+   do a list of buffers more cheaply than one call per buffer.  's' may
+   contain "%u" (and no other '%'), standing for the index of the buffer;
+   format it with VG_(sprintf)(buf, s, i) when reporting an error. */
+struct vki_iovec;
+void VG_(track_pre_mem_read_iov)  (void(*f)(CorePart part, ThreadId tid,
+                                            const HChar* s,
+                                            const struct vki_iovec* iov,
+                                            UInt n_iov, SizeT max_len));
+void VG_(track_pre_mem_write_iov) (void(*f)(CorePart part, ThreadId tid,
+                                            const HChar* s,
+                                            const struct vki_iovec* iov,
+                                            UInt n_iov, SizeT max_len));
+void VG_(track_post_mem_write_iov)(void(*f)(CorePart part, ThreadId tid,
+                                            const struct vki_iovec* iov,
+                                            UInt n_iov, SizeT max_len));
+
 /* Register events.  Use VG_(set_shadow_state_area)() to set the shadow regs
    for these events.  */
 void VG_(track_pre_reg_read)  (void(*f)(CorePart part, ThreadId tid,
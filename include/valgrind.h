@@ -6178,7 +6178,20 @@ typedef
           VG_USERREQ__CHANGE_ERR_DISABLEMENT = 0x1801,
 
           /* Initialise IR injection */
-          VG_USERREQ__VEX_INIT_FOR_IRI = 0x1901
+          VG_USERREQ__VEX_INIT_FOR_IRI = 0x1901,
+
+          /* Start the fork server. */
+          VG_USERREQ__FORK_SERVER      = 0x1a01,
+
+          /* Make or restore a checkpoint. */
+          VG_USERREQ__CHECKPOINT         = 0x1a02,
+          VG_USERREQ__RESTORE_CHECKPOINT = 0x1a03,
+
+          /* End --fast-forward, starting the instrumentation. */
+          VG_USERREQ__STOP_FAST_FORWARD  = 0x1a04,
+
+          /* Translate a range of code ahead of its being run. */
+          VG_USERREQ__PRETRANSLATE       = 0x1a05
    } Vg_ClientRequest;
 
 #if !defined(__GNUC__)
@@ -6560,6 +6573,53 @@ VALGRIND_PRINTF_BACKTRACE(const char *format, ...)
     VALGRIND_DO_CLIENT_REQUEST_STMT(VG_USERREQ__CHANGE_ERR_DISABLEMENT, \
                                     -1, 0, 0, 0, 0)
 
+/* Start the fork server, if Valgrind was given --fork-server-fd=<fd>.
+   Valgrind then stops the program here and, for each request read from
+   the file descriptor, forks a process which continues from here, with
+   everything done so far already done.  Returns 1 in these processes,
+   and 0 if there is no fork server, e.g. when not running on Valgrind.
+   The program must have only one thread when it does this request. */
+#define VALGRIND_FORK_SERVER                                            \
+    (unsigned)VALGRIND_DO_CLIENT_REQUEST_EXPR(0,                        \
+                                    VG_USERREQ__FORK_SERVER,            \
+                                    0, 0, 0, 0, 0)
+
+/* Make a checkpoint of the program run, from which the run can later be
+   continued again with VALGRIND_RESTORE_CHECKPOINT or the
+   "v.do restore_checkpoint" monitor command.  Returns 0 when continuing
+   after making it (or when it could not be made, e.g. when not running
+   on Valgrind), and the number of the checkpoint, starting from 1, when
+   it is restored.  The program must have only one thread when it does
+   this request. */
+#define VALGRIND_CHECKPOINT                                             \
+    (unsigned)VALGRIND_DO_CLIENT_REQUEST_EXPR(0,                        \
+                                    VG_USERREQ__CHECKPOINT,             \
+                                    0, 0, 0, 0, 0)
+
+/* Continue the run from checkpoint _qzz_n, ending the current one.
+   Only returns, with -1, if there is no such checkpoint. */
+#define VALGRIND_RESTORE_CHECKPOINT(_qzz_n)                             \
+    (int)VALGRIND_DO_CLIENT_REQUEST_EXPR(-1,                            \
+                                    VG_USERREQ__RESTORE_CHECKPOINT,     \
+                                    (_qzz_n), 0, 0, 0, 0)
+
+/* With --fast-forward=yes, start the tool's instrumentation, from the
+   next basic block on.  Does nothing if it has started already, or
+   when not running on Valgrind. */
+#define VALGRIND_STOP_FAST_FORWARD                                      \
+    VALGRIND_DO_CLIENT_REQUEST_STMT(VG_USERREQ__STOP_FAST_FORWARD,      \
+                                    0, 0, 0, 0, 0)
+
+/* Translate the code in [_qzz_start, _qzz_start+_qzz_len) that can be
+   reached from _qzz_start by direct jumps and calls now, rather than
+   when it is first run, so that a latency-sensitive part of the
+   program doesn't pay for it.  Returns the number of translations
+   made, which is 0 when not running on Valgrind. */
+#define VALGRIND_PRETRANSLATE(_qzz_start, _qzz_len)                     \
+    (unsigned)VALGRIND_DO_CLIENT_REQUEST_EXPR(0,                        \
+                                    VG_USERREQ__PRETRANSLATE,           \
+                                    (_qzz_start), (_qzz_len), 0, 0, 0)
+
 /* Execute a monitor command from the client program.
    If a connection is opened with GDB, the output will be sent
    according to the output mode set for vgdb.
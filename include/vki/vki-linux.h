@@ -1273,6 +1273,13 @@ struct  vki_seminfo {
 #define VKI_MREMAP_MAYMOVE	1
 #define VKI_MREMAP_FIXED	2
 
+//----------------------------------------------------------------------
+// From linux-2.6.38/include/asm-generic/mman-common.h
+//----------------------------------------------------------------------
+
+#define VKI_MADV_DONTNEED	4	/* Don't need these pages */
+#define VKI_MADV_HUGEPAGE	14	/* Worth backing with hugepages */
+
 //----------------------------------------------------------------------
 // From linux-2.6.31-rc4/include/linux/futex.h
 //----------------------------------------------------------------------
@@ -2901,6 +2908,52 @@ struct vki_perf_event_attr {
 	};
 };
 
+enum vki_perf_type_id {
+	VKI_PERF_TYPE_HARDWARE			= 0,
+	VKI_PERF_TYPE_SOFTWARE			= 1,
+	VKI_PERF_TYPE_TRACEPOINT		= 2,
+	VKI_PERF_TYPE_HW_CACHE			= 3,
+	VKI_PERF_TYPE_RAW			= 4,
+	VKI_PERF_TYPE_BREAKPOINT		= 5,
+};
+
+enum vki_perf_hw_id {
+	VKI_PERF_COUNT_HW_CPU_CYCLES		= 0,
+	VKI_PERF_COUNT_HW_INSTRUCTIONS		= 1,
+	VKI_PERF_COUNT_HW_CACHE_REFERENCES	= 2,
+	VKI_PERF_COUNT_HW_CACHE_MISSES		= 3,
+	VKI_PERF_COUNT_HW_BRANCH_INSTRUCTIONS	= 4,
+	VKI_PERF_COUNT_HW_BRANCH_MISSES		= 5,
+	VKI_PERF_COUNT_HW_BUS_CYCLES		= 6,
+};
+
+enum vki_perf_hw_cache_id {
+	VKI_PERF_COUNT_HW_CACHE_L1D		= 0,
+	VKI_PERF_COUNT_HW_CACHE_L1I		= 1,
+	VKI_PERF_COUNT_HW_CACHE_LL		= 2,
+	VKI_PERF_COUNT_HW_CACHE_DTLB		= 3,
+	VKI_PERF_COUNT_HW_CACHE_ITLB		= 4,
+	VKI_PERF_COUNT_HW_CACHE_BPU		= 5,
+};
+
+enum vki_perf_hw_cache_op_id {
+	VKI_PERF_COUNT_HW_CACHE_OP_READ		= 0,
+	VKI_PERF_COUNT_HW_CACHE_OP_WRITE	= 1,
+	VKI_PERF_COUNT_HW_CACHE_OP_PREFETCH	= 2,
+};
+
+enum vki_perf_hw_cache_op_result_id {
+	VKI_PERF_COUNT_HW_CACHE_RESULT_ACCESS	= 0,
+	VKI_PERF_COUNT_HW_CACHE_RESULT_MISS	= 1,
+};
+
+enum vki_perf_event_read_format {
+	VKI_PERF_FORMAT_TOTAL_TIME_ENABLED	= 1U << 0,
+	VKI_PERF_FORMAT_TOTAL_TIME_RUNNING	= 1U << 1,
+	VKI_PERF_FORMAT_ID			= 1U << 2,
+	VKI_PERF_FORMAT_GROUP			= 1U << 3,
+};
+
 /*--------------------------------------------------------------------*/
 // From linux-2.6.32.4/include/linux/getcpu.h
 /*--------------------------------------------------------------------*/
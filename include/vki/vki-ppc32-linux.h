@@ -302,6 +302,7 @@ struct vki_sigcontext {
 #define VKI_MAP_FIXED		0x10     /* Interpret addr exactly */
 #define VKI_MAP_ANONYMOUS	0x20     /* don't use a file */
 #define VKI_MAP_NORESERVE	0x40     /* don't reserve swap pages */
+#define VKI_MAP_HUGETLB		0x40000  /* create a huge page mapping */
 
 //----------------------------------------------------------------------
 // From linux-2.6.9/include/asm-ppc/fcntl.h
@@ -306,6 +306,8 @@ typedef struct vki_sigaltstack {
 #define VKI_MAP_PRIVATE 	0x0002	/*  */
 #define VKI_MAP_FIXED   	0x0010	/*  */
 #define VKI_MAP_ANONYMOUS	0x0020	/*  */
+#define VKI_MAP_HUGETLB		0x40000	/* create a huge page mapping */
+#define VKI_MAP_NORESERVE	0x4000	/* don't check for reservations */
 
 
 //----------------------------------------------------------------------
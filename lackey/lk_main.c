@@ -103,6 +103,17 @@
 // Instructions using x86 "rep" prefixes are traced as if they are repeated
 // N times.
 //
+// Printing the trace is slow, and it is big.  With --trace-mem-file=<file>,
+// Lackey instead writes a binary trace to <file>, which is typically an
+// order of magnitude smaller and takes far less time to write; add
+// --trace-mem-compress=yes to make it several times smaller again.  The
+// events are put into a buffer, and written out as a block when it is full
+// or another thread starts running, so the blocks also say which thread
+// made the accesses.  The format is described in lk_trace.h;
+// lk_trace_decode turns a binary trace back into the text above, and is
+// a starting point for simulators that want to read the binary trace
+// directly.
+//
 // Lackey with --trace-mem gives good traces, but they are not perfect, for
 // the following reasons:
 //
@@ -177,6 +188,13 @@
 #include "pub_tool_libcbase.h"
 #include "pub_tool_options.h"
 #include "pub_tool_machine.h"     // VG_(fnptr_to_fnentry)
+#include "pub_tool_vki.h"
+#include "pub_tool_libcfile.h"
+#include "pub_tool_libcproc.h"    // VG_(atfork)
+#include "pub_tool_mallocfree.h"
+#include "pub_tool_threadstate.h"
+
+#include "lk_trace.h"
 
 /*------------------------------------------------------------*/
 /*--- Command line options                                 ---*/
@@ -189,6 +207,11 @@ static Bool clo_detailed_counts = False;
 static Bool clo_trace_mem       = False;
 static Bool clo_trace_sbs       = False;
 
+/* Where to write the --trace-mem trace in binary form, if anywhere, and
+ * whether to compress it. */
+static const HChar* clo_trace_mem_file = NULL;
+static Bool clo_trace_mem_compress     = False;
+
 /* The name of the function of which the number of calls (under
  * --basic-counts=yes) is to be counted, with default. Override with command
  * line option --fnname. */
@@ -201,6 +224,8 @@ static Bool lk_process_cmd_line_option(const HChar* arg)
    else if VG_BOOL_CLO(arg, "--detailed-counts",   clo_detailed_counts) {}
    else if VG_BOOL_CLO(arg, "--trace-mem",         clo_trace_mem) {}
    else if VG_BOOL_CLO(arg, "--trace-superblocks", clo_trace_sbs) {}
+   else if VG_STR_CLO(arg, "--trace-mem-file",     clo_trace_mem_file) {}
+   else if VG_BOOL_CLO(arg, "--trace-mem-compress", clo_trace_mem_compress) {}
    else
       return False;
    
@@ -215,6 +240,9 @@ static void lk_print_usage(void)
 "    --basic-counts=no|yes     count instructions, jumps, etc. [yes]\n"
 "    --detailed-counts=no|yes  count loads, stores and alu ops [no]\n"
 "    --trace-mem=no|yes        trace all loads and stores [no]\n"
+"    --trace-mem-file=<file>   write the --trace-mem trace to <file>, in\n"
+"                              binary; implies --trace-mem=yes [none]\n"
+"    --trace-mem-compress=no|yes  compress the binary trace [no]\n"
 "    --trace-superblocks=no|yes  trace all superblock entries [no]\n"
 "    --fnname=<name>           count calls to <name> (only used if\n"
 "                              --basic-count=yes)  [main]\n"
@@ -468,6 +496,267 @@ static VG_REGPARM(2) void trace_modify(Addr addr, SizeT size)
    VG_(printf)(" M %08lx,%lu\n", addr, size);
 }
 
+/* The binary trace.  The events go into trace_buf, which is written out as
+   a block when it's full, or when another thread starts running. */
+
+// The most bytes one event can take: the leading byte and two ULEB128
+// numbers of up to 64 bits.
+#define MAX_EVENT_LEN   (1 + 10 + 10)
+
+static Int      trace_fd = -1;
+static HChar*   trace_file_name = NULL;
+static UChar    trace_buf[LK_TRACE_BLOCK_SIZE];
+static Int      trace_used = 0;
+static ThreadId trace_tid = 1;      // the thread whose events are in trace_buf
+static Addr     trace_last_iaddr = 0;
+static Addr     trace_last_daddr = 0;
+
+static ULong    trace_n_events = 0;
+static ULong    trace_n_raw_bytes = 0;
+static ULong    trace_n_written_bytes = 0;
+
+static void trace_write(const UChar* buf, Int len)
+{
+   while (len > 0 && trace_fd >= 0) {
+      Int n = VG_(write)(trace_fd, buf, len);
+      if (n <= 0) {
+         VG_(umsg)("error: can't write to memory trace file '%s'\n",
+                   trace_file_name);
+         VG_(umsg)("       ... so the trace will be incomplete.\n");
+         VG_(close)(trace_fd);
+         trace_fd = -1;
+         return;
+      }
+      buf += n;
+      len -= n;
+      trace_n_written_bytes += n;
+   }
+}
+
+static void put_le32(UChar* p, UInt w)
+{
+   p[0] = w & 0xff;
+   p[1] = (w >> 8) & 0xff;
+   p[2] = (w >> 16) & 0xff;
+   p[3] = (w >> 24) & 0xff;
+}
+
+static __inline__ UInt get_le32(const UChar* p)
+{
+   return p[0] | (p[1] << 8) | (p[2] << 16) | ((UInt)p[3] << 24);
+}
+
+/* Block compression, in the style of LZ4: greedy, using a hash table of
+   where each 4-byte sequence was last seen.  Traces of loops compress very
+   well, as their events encode to the same bytes on each iteration. */
+
+#define LZ_HASH_BITS    13
+
+static UInt  lz_hash[1 << LZ_HASH_BITS];   // position + 1, or 0 for none
+static UChar lz_buf[LK_TRACE_BLOCK_SIZE + LK_TRACE_BLOCK_SIZE / 255 + 16];
+
+static UChar* lz_put_len(UChar* op, UInt len)
+{
+   for (len -= 15; len >= 255; len -= 255)
+      *op++ = 255;
+   *op++ = len;
+   return op;
+}
+
+static UChar* lz_put_seq(UChar* op, const UChar* lit, UInt n_lit,
+                         UInt offset, UInt match_len)
+{
+   UInt m = match_len - LK_TRACE_MIN_MATCH;
+
+   *op++ = ((n_lit < 15 ? n_lit : 15) << 4) | (m < 15 ? m : 15);
+   if (n_lit >= 15)
+      op = lz_put_len(op, n_lit);
+   VG_(memcpy)(op, lit, n_lit);
+   op += n_lit;
+   if (match_len > 0) {
+      *op++ = offset & 0xff;
+      *op++ = offset >> 8;
+      if (m >= 15)
+         op = lz_put_len(op, m);
+   }
+   return op;
+}
+
+static Int lz_compress(const UChar* in, Int in_len, UChar* out)
+{
+   const UChar* ip     = in;
+   const UChar* anchor = in;
+   const UChar* end    = in + in_len;
+   UChar*       op     = out;
+
+   VG_(memset)(lz_hash, 0, sizeof(lz_hash));
+   while (ip + LK_TRACE_MIN_MATCH <= end) {
+      UInt seq  = get_le32(ip);
+      UInt h    = (seq * 2654435761U) >> (32 - LZ_HASH_BITS);
+      UInt cand = lz_hash[h];
+      const UChar *mp, *mend;
+
+      lz_hash[h] = ip - in + 1;
+      if (cand == 0 || get_le32(in + cand - 1) != seq) {
+         ip++;
+         continue;
+      }
+      mp   = in + cand - 1 + LK_TRACE_MIN_MATCH;
+      mend = ip + LK_TRACE_MIN_MATCH;
+      while (mend < end && *mend == *mp) {
+         mend++;
+         mp++;
+      }
+      op = lz_put_seq(op, anchor, ip - anchor, ip - (in + cand - 1),
+                      mend - ip);
+      ip = anchor = mend;
+   }
+   op = lz_put_seq(op, anchor, end - anchor, 0, 0);
+   return op - out;
+}
+
+static void flush_trace_block(void)
+{
+   UChar        hdr[LK_TRACE_BLOCK_HEADER_LEN];
+   const UChar* out     = trace_buf;
+   Int          out_len = trace_used;
+
+   if (trace_used == 0)
+      return;
+   if (clo_trace_mem_compress) {
+      Int len = lz_compress(trace_buf, trace_used, lz_buf);
+      if (len < trace_used) {
+         out     = lz_buf;
+         out_len = len;
+      }
+   }
+   put_le32(hdr,     trace_tid);
+   put_le32(hdr + 4, trace_used);
+   put_le32(hdr + 8, out_len);
+   trace_write(hdr, sizeof(hdr));
+   trace_write(out, out_len);
+
+   trace_n_raw_bytes += trace_used;
+   trace_used        = 0;
+   trace_last_iaddr  = 0;
+   trace_last_daddr  = 0;
+}
+
+static __inline__ UChar* put_uleb(UChar* p, ULong n)
+{
+   while (n >= 0x80) {
+      *p++ = (n & 0x7f) | 0x80;
+      n >>= 7;
+   }
+   *p++ = n;
+   return p;
+}
+
+static __inline__ void trace_event(UInt kind, Addr addr, SizeT size, Addr* last)
+{
+   UChar* p;
+   ULong  delta;
+
+   if (trace_used > LK_TRACE_BLOCK_SIZE - MAX_EVENT_LEN)
+      flush_trace_block();
+   p     = trace_buf + trace_used;
+   delta = (ULong)addr - (ULong)*last;
+   *last = addr;
+   if (size < LK_TRACE_BIG_SIZE) {
+      *p++ = (kind << 6) | size;
+   } else {
+      *p++ = (kind << 6) | LK_TRACE_BIG_SIZE;
+      p = put_uleb(p, size);
+   }
+   // Zigzag: 0, -1, 1, -2, ... become 0, 1, 2, 3, ...
+   p = put_uleb(p, (delta << 1) ^ (ULong)((Long)delta >> 63));
+   trace_used = p - trace_buf;
+   trace_n_events++;
+}
+
+static VG_REGPARM(2) void trace_instr_bin(Addr addr, SizeT size)
+{
+   trace_event(LK_TRACE_INSTR, addr, size, &trace_last_iaddr);
+}
+
+static VG_REGPARM(2) void trace_load_bin(Addr addr, SizeT size)
+{
+   trace_event(LK_TRACE_LOAD, addr, size, &trace_last_daddr);
+}
+
+static VG_REGPARM(2) void trace_store_bin(Addr addr, SizeT size)
+{
+   trace_event(LK_TRACE_STORE, addr, size, &trace_last_daddr);
+}
+
+static VG_REGPARM(2) void trace_modify_bin(Addr addr, SizeT size)
+{
+   trace_event(LK_TRACE_MODIFY, addr, size, &trace_last_daddr);
+}
+
+static void trace_start_client_code(ThreadId tid, ULong blocks_done)
+{
+   if (tid != trace_tid) {
+      flush_trace_block();
+      trace_tid = tid;
+   }
+}
+
+static void open_trace_file(void)
+{
+   UChar  hdr[LK_TRACE_HEADER_LEN];
+   SysRes sres;
+
+   trace_file_name = VG_(expand_file_name)("--trace-mem-file",
+                                           clo_trace_mem_file);
+   sres = VG_(open)(trace_file_name, VKI_O_CREAT|VKI_O_TRUNC|VKI_O_WRONLY,
+                                     VKI_S_IRUSR|VKI_S_IWUSR);
+   if (sr_isError(sres)) {
+      VG_(umsg)("error: can't open memory trace file '%s'\n",
+                trace_file_name);
+      VG_(umsg)("       ... so there will be no trace.\n");
+      trace_fd = -1;
+      return;
+   }
+   trace_fd = sr_Res(sres);
+
+   VG_(memset)(hdr, 0, sizeof(hdr));
+   VG_(memcpy)(hdr, LK_TRACE_MAGIC, LK_TRACE_MAGIC_LEN);
+   hdr[8] = clo_trace_mem_compress ? LK_TRACE_COMPRESSED : 0;
+   hdr[9] = sizeof(Addr);
+   trace_write(hdr, sizeof(hdr));
+}
+
+// Write out what the parent traced before forking, so the child doesn't
+// write it again.  The child gets its own trace file, which needs a %p in
+// the file name to be a different one from the parent's.
+static void trace_atfork_pre(ThreadId tid)
+{
+   flush_trace_block();
+}
+
+static void trace_atfork_child(ThreadId tid)
+{
+   HChar* parent_file_name = trace_file_name;
+
+   if (trace_fd >= 0)
+      VG_(close)(trace_fd);
+   trace_fd = -1;
+   trace_tid = tid;
+   trace_file_name = VG_(expand_file_name)("--trace-mem-file",
+                                           clo_trace_mem_file);
+   if (VG_(strcmp)(trace_file_name, parent_file_name) == 0) {
+      VG_(umsg)("warning: the child of a fork has the same memory trace "
+                "file as its parent,\n");
+      VG_(umsg)("         so it won't be traced.  Put %%p in the "
+                "--trace-mem-file name.\n");
+   } else {
+      VG_(free)(trace_file_name);
+      open_trace_file();
+   }
+   VG_(free)(parent_file_name);
+}
+
 
 static void flushEvents(IRSB* sb)
 {
@@ -477,6 +766,7 @@ static void flushEvents(IRSB* sb)
    IRExpr**   argv;
    IRDirty*   di;
    Event*     ev;
+   Bool       bin = clo_trace_mem_file != NULL;
 
    for (i = 0; i < events_used; i++) {
 
@@ -484,17 +774,21 @@ static void flushEvents(IRSB* sb)
       
       // Decide on helper fn to call and args to pass it.
       switch (ev->ekind) {
-         case Event_Ir: helperName = "trace_instr";
-                        helperAddr =  trace_instr;  break;
+         case Event_Ir: helperName = bin ? "trace_instr_bin" : "trace_instr";
+                        helperAddr = bin ?  trace_instr_bin  :  trace_instr;
+                        break;
 
-         case Event_Dr: helperName = "trace_load";
-                        helperAddr =  trace_load;   break;
+         case Event_Dr: helperName = bin ? "trace_load_bin" : "trace_load";
+                        helperAddr = bin ?  trace_load_bin  :  trace_load;
+                        break;
 
-         case Event_Dw: helperName = "trace_store";
-                        helperAddr =  trace_store;  break;
+         case Event_Dw: helperName = bin ? "trace_store_bin" : "trace_store";
+                        helperAddr = bin ?  trace_store_bin  :  trace_store;
+                        break;
 
-         case Event_Dm: helperName = "trace_modify";
-                        helperAddr =  trace_modify; break;
+         case Event_Dm: helperName = bin ? "trace_modify_bin" : "trace_modify";
+                        helperAddr = bin ?  trace_modify_bin  :  trace_modify;
+                        break;
          default:
             tl_assert(0);
       }
@@ -641,6 +935,13 @@ static void lk_post_clo_init(void)
          for (tyIx = 0; tyIx < N_TYPES; tyIx++)
             detailCounts[op][tyIx] = 0;
    }
+
+   if (clo_trace_mem_file) {
+      clo_trace_mem = True;
+      open_trace_file();
+      VG_(track_start_client_code)(trace_start_client_code);
+      VG_(atfork)(trace_atfork_pre, NULL, trace_atfork_child);
+   }
 }
 
 static
@@ -1043,6 +1344,18 @@ static void lk_fini(Int exitcode)
       VG_(umsg)("\n");
       VG_(umsg)("Exit code:       %d\n", exitcode);
    }
+
+   if (clo_trace_mem_file) {
+      flush_trace_block();
+      if (trace_fd >= 0)
+         VG_(close)(trace_fd);
+      if (VG_(clo_verbosity) > 1) {
+         VG_(umsg)("\n");
+         VG_(umsg)("Memory trace:    %'llu events, %'llu bytes, "
+                   "%'llu written\n", trace_n_events, trace_n_raw_bytes,
+                   trace_n_written_bytes);
+      }
+   }
 }
 
 static void lk_pre_clo_init(void)
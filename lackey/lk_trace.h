@@ -0,0 +1,96 @@
+
+/*--------------------------------------------------------------------*/
+/*--- Lackey's binary memory trace format.              lk_trace.h ---*/
+/*--------------------------------------------------------------------*/
+
+/*
+   This file is part of Lackey, an example Valgrind tool that does
+   some simple program measurement and tracing.
+
+   Copyright (C) 2002-2013 Nicholas Nethercote
+      njn@valgrind.org
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of the
+   License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+   02111-1307, USA.
+
+   The GNU General Public License is contained in the file COPYING.
+*/
+
+// This header is shared by Lackey and lk_trace_decode, so it only has
+// plain C definitions in it.
+//
+// A trace written with --trace-mem-file is:
+//
+//   header:  the 8 bytes LK_TRACE_MAGIC, then one byte of flags
+//            (LK_TRACE_COMPRESSED), one byte giving the size of a guest
+//            address in bytes, and two zero bytes.
+//
+//   blocks:  each holds the events of one thread, from one stretch of it
+//            running; the blocks are in the order the events happened.
+//            A block starts with three 32-bit little-endian words: the
+//            thread id, the length of the events, and the length of what
+//            is stored for them, which follows.  If the two lengths are
+//            equal the events are stored as they are, otherwise they are
+//            compressed as described below.
+//
+// Events are encoded with a leading byte holding the kind of event in its
+// top two bits (LK_TRACE_INSTR, etc) and the size of the access in its
+// bottom six; if the size doesn't fit, the bottom bits are
+// LK_TRACE_BIG_SIZE and the size follows as a ULEB128 number.  Then comes
+// the difference between the address and that of the previous event of
+// the same sort (instruction or data) in the block, zigzag-encoded (so
+// that small negative differences are small numbers too) as a ULEB128
+// number.  Both previous addresses are zero at the start of each block.
+// Most events take two or three bytes.
+//
+// Compressed events are a series of sequences in the style of LZ4.  Each
+// starts with a token byte whose top four bits are the number of literal
+// bytes and bottom four the length of a match minus LK_TRACE_MIN_MATCH.
+// A value of 15 in either is continued by extra bytes, which are added
+// to it, up to and including the first one that isn't 255.  The
+// literal count's extra bytes come straight after the token, followed by
+// the literal bytes; then, unless that was the end of the block, a 16-bit
+// little-endian offset back into the decompressed events to copy the
+// match from, followed by the match length's extra bytes.
+
+#ifndef __LK_TRACE_H
+#define __LK_TRACE_H
+
+#define LK_TRACE_MAGIC       "LKTRACE1"
+#define LK_TRACE_MAGIC_LEN   8
+#define LK_TRACE_HEADER_LEN  12
+#define LK_TRACE_BLOCK_HEADER_LEN  12
+
+#define LK_TRACE_COMPRESSED  0x1    // header flag
+
+// The events of a block take at most this many bytes, so that match
+// offsets fit in 16 bits.
+#define LK_TRACE_BLOCK_SIZE  65536
+
+// Event kinds.
+#define LK_TRACE_INSTR       0
+#define LK_TRACE_LOAD        1
+#define LK_TRACE_STORE       2
+#define LK_TRACE_MODIFY      3
+
+#define LK_TRACE_BIG_SIZE    63
+
+#define LK_TRACE_MIN_MATCH   4
+
+#endif   // __LK_TRACE_H
+
+/*--------------------------------------------------------------------*/
+/*--- end                                               lk_trace.h ---*/
+/*--------------------------------------------------------------------*/
@@ -0,0 +1,258 @@
+
+/*--------------------------------------------------------------------*/
+/*--- A program that decodes Lackey's binary memory traces.        ---*/
+/*---                                             lk_trace_decode.c ---*/
+/*--------------------------------------------------------------------*/
+
+/*
+   This file is part of Lackey, an example Valgrind tool that does
+   some simple program measurement and tracing.
+
+   Copyright (C) 2002-2013 Nicholas Nethercote
+      njn@valgrind.org
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of the
+   License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+   02111-1307, USA.
+
+   The GNU General Public License is contained in the file COPYING.
+*/
+
+// Reads a trace written by Lackey's --trace-mem-file and prints it in the
+// same text format as --trace-mem=yes does.  With -t, it also prints a
+// "T <tid>" line whenever the events switch to another thread; with -s,
+// it prints a summary on stderr at the end.
+//
+// A cache or prefetch simulator that wants to read binary traces directly
+// can use read_block() and decode_block() as they are, and do its work
+// in place of print_event().
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lk_trace.h"
+
+typedef unsigned char      UChar;
+typedef unsigned int       UInt;
+typedef unsigned long long ULong;
+
+static const char* argv0 = "lk_trace_decode";
+
+static void barf(const char* msg)
+{
+   fprintf(stderr, "%s: %s\n", argv0, msg);
+   exit(1);
+}
+
+static UInt get_le32(const UChar* p)
+{
+   return p[0] | (p[1] << 8) | (p[2] << 16) | ((UInt)p[3] << 24);
+}
+
+static ULong get_uleb(const UChar** pp, const UChar* end)
+{
+   const UChar* p = *pp;
+   ULong n = 0;
+   int shift = 0;
+
+   do {
+      if (p == end || shift > 63)
+         barf("bad event in trace");
+      n |= (ULong)(*p & 0x7f) << shift;
+      shift += 7;
+   } while (*p++ & 0x80);
+   *pp = p;
+   return n;
+}
+
+static const UChar* get_len(const UChar* ip, const UChar* end, UInt* len)
+{
+   UInt b;
+
+   if (*len < 15)
+      return ip;
+   do {
+      if (ip == end)
+         barf("bad compressed block in trace");
+      b = *ip++;
+      *len += b;
+   } while (b == 255);
+   return ip;
+}
+
+// Decompress 'in' into 'out', which must come to exactly 'out_len'
+// bytes.  See lk_trace.h for the format.
+static void decompress(const UChar* in, UInt in_len, UChar* out, UInt out_len)
+{
+   const UChar* ip   = in;
+   const UChar* iend = in + in_len;
+   UChar*       op   = out;
+   UChar*       oend = out + out_len;
+
+   while (ip < iend) {
+      UInt token = *ip++;
+      UInt n_lit = token >> 4;
+      UInt match_len = token & 15;
+      UInt offset;
+
+      ip = get_len(ip, iend, &n_lit);
+      if (n_lit > (UInt)(iend - ip) || n_lit > (UInt)(oend - op))
+         barf("bad compressed block in trace");
+      memcpy(op, ip, n_lit);
+      op += n_lit;
+      ip += n_lit;
+      if (ip == iend)
+         break;
+
+      if (iend - ip < 2)
+         barf("bad compressed block in trace");
+      offset = ip[0] | (ip[1] << 8);
+      ip += 2;
+      ip = get_len(ip, iend, &match_len);
+      match_len += LK_TRACE_MIN_MATCH;
+      if (offset == 0 || offset > (UInt)(op - out)
+          || match_len > (UInt)(oend - op))
+         barf("bad compressed block in trace");
+      // The match can overlap what it is copying, so go byte by byte.
+      while (match_len-- > 0) {
+         *op = op[-(long)offset];
+         op++;
+      }
+   }
+   if (op != oend)
+      barf("bad compressed block in trace");
+}
+
+// Read the next block of events into 'events'.  Returns 0 at the end of
+// the trace.
+static int read_block(FILE* f, UInt* tid, UChar* events, UInt* len)
+{
+   static UChar stored[LK_TRACE_BLOCK_SIZE];
+   UChar hdr[LK_TRACE_BLOCK_HEADER_LEN];
+   size_t n = fread(hdr, 1, sizeof(hdr), f);
+   UInt stored_len;
+
+   if (n == 0)
+      return 0;
+   if (n != sizeof(hdr))
+      barf("trace is truncated");
+   *tid       = get_le32(hdr);
+   *len       = get_le32(hdr + 4);
+   stored_len = get_le32(hdr + 8);
+   if (*len > LK_TRACE_BLOCK_SIZE || stored_len > *len)
+      barf("bad block in trace");
+   if (fread(stored_len == *len ? events : stored, 1, stored_len, f)
+       != stored_len)
+      barf("trace is truncated");
+   if (stored_len != *len)
+      decompress(stored, stored_len, events, *len);
+   return 1;
+}
+
+static ULong n_events[4];
+static ULong n_blocks = 0;
+
+static void print_event(UInt kind, ULong addr, ULong size)
+{
+   static const char* const fmt[4] = {
+      "I  %08llx,%llu\n",
+      " L %08llx,%llu\n",
+      " S %08llx,%llu\n",
+      " M %08llx,%llu\n",
+   };
+   printf(fmt[kind], addr, size);
+}
+
+static void decode_block(const UChar* p, UInt len, ULong addr_mask)
+{
+   const UChar* end   = p + len;
+   ULong        iaddr = 0;
+   ULong        daddr = 0;
+
+   while (p < end) {
+      UInt   kind = *p >> 6;
+      ULong  size = *p++ & 63;
+      ULong  zz, delta;
+      ULong* last;
+
+      if (size == LK_TRACE_BIG_SIZE)
+         size = get_uleb(&p, end);
+      zz    = get_uleb(&p, end);
+      delta = (zz >> 1) ^ -(zz & 1);
+      last  = kind == LK_TRACE_INSTR ? &iaddr : &daddr;
+      *last = (*last + delta) & addr_mask;
+      print_event(kind, *last, size);
+      n_events[kind]++;
+   }
+}
+
+int main(int argc, char** argv)
+{
+   static UChar events[LK_TRACE_BLOCK_SIZE];
+   UChar hdr[LK_TRACE_HEADER_LEN];
+   const char* file = NULL;
+   int   show_threads = 0, summary = 0, i;
+   UInt  tid, len, last_tid = 0;
+   ULong addr_mask;
+   FILE* f;
+
+   for (i = 1; i < argc; i++) {
+      if (0 == strcmp(argv[i], "-t"))
+         show_threads = 1;
+      else if (0 == strcmp(argv[i], "-s"))
+         summary = 1;
+      else if (argv[i][0] != '-' && file == NULL)
+         file = argv[i];
+      else
+         break;
+   }
+   if (i < argc || file == NULL) {
+      fprintf(stderr, "usage: %s [-t] [-s] tracefile\n", argv0);
+      fprintf(stderr, "   -t   show which thread the events are from\n");
+      fprintf(stderr, "   -s   print a summary on stderr\n");
+      return 1;
+   }
+
+   f = fopen(file, "rb");
+   if (f == NULL)
+      barf("can't open trace file");
+   if (fread(hdr, 1, sizeof(hdr), f) != sizeof(hdr)
+       || memcmp(hdr, LK_TRACE_MAGIC, LK_TRACE_MAGIC_LEN) != 0)
+      barf("not a Lackey memory trace");
+   if (hdr[9] != 4 && hdr[9] != 8)
+      barf("bad address size in trace");
+   addr_mask = hdr[9] == 8 ? ~0ULL : 0xffffffffULL;
+
+   setvbuf(stdout, NULL, _IOFBF, 1 << 20);
+   while (read_block(f, &tid, events, &len)) {
+      if (show_threads && tid != last_tid)
+         printf("T %u\n", tid);
+      last_tid = tid;
+      decode_block(events, len, addr_mask);
+      n_blocks++;
+   }
+   fclose(f);
+
+   if (summary)
+      fprintf(stderr, "%llu blocks, %llu instrs, %llu loads, %llu stores, "
+                      "%llu modifies\n", n_blocks, n_events[LK_TRACE_INSTR],
+              n_events[LK_TRACE_LOAD], n_events[LK_TRACE_STORE],
+              n_events[LK_TRACE_MODIFY]);
+   return 0;
+}
+
+/*--------------------------------------------------------------------*/
+/*--- end                                         lk_trace_decode.c ---*/
+/*--------------------------------------------------------------------*/
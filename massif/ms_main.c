@@ -75,10 +75,9 @@
 //   [Introduction of --time-unit=i as the default slowed things down by
 //   roughly 0--20%.]
 //
-// - get_XCon accounts for about 9% of konqueror startup time.  Try
-//   keeping XPt children sorted by 'ip' and use binary search in get_XCon.
-//   Requires factoring out binary search code from various places into a
-//   VG_(bsearch) function.  
+// - get_XCon accounted for about 9% of konqueror startup time.  Repeated
+//   allocation sites now hit the XCon cache, which skips both the alloc-fn
+//   filtering and the XTree descent.
 //
 // Todo -- low priority:
 // - In each XPt, record both bytes and the number of allocations, and
@@ -178,6 +177,7 @@ Number of snapshots: 50
 #include "pub_tool_stacktrace.h"
 #include "pub_tool_threadstate.h"
 #include "pub_tool_tooliface.h"
+#include "pub_tool_wordfm.h"
 #include "pub_tool_xarray.h"
 #include "pub_tool_clientstate.h"
 #include "pub_tool_gdbserver.h"
@@ -248,6 +248,8 @@ static UInt n_ignored_heap_reallocs = 0;
 static UInt n_stack_allocs          = 0;
 static UInt n_stack_frees           = 0;
 static UInt n_xpts                  = 0;
+static UInt n_xpts_pruned           = 0;
+static UInt n_prunings              = 0;
 static UInt n_xpt_init_expansions   = 0;
 static UInt n_xpt_later_expansions  = 0;
 static UInt n_sxpt_allocs           = 0;
@@ -258,6 +260,8 @@ static UInt n_detailed_snapshots    = 0;
 static UInt n_peak_snapshots        = 0;
 static UInt n_cullings              = 0;
 static UInt n_XCon_redos            = 0;
+static UInt n_XCon_cache_hits       = 0;
+static UInt n_XCon_cache_misses     = 0;
 
 //------------------------------------------------------------//
 //--- Globals                                              ---//
@@ -405,6 +409,7 @@ static double clo_peak_inaccuracy = 1.0;  // percentage
 static Int    clo_time_unit       = TimeI;
 static Int    clo_detailed_freq   = 10;
 static Int    clo_max_snapshots   = 100;
+static Long   clo_stream_interval = 0;    // 0: no streaming
 static const HChar* clo_massif_out_file = "massif.out.%p";
 
 static XArray* args_for_massif;
@@ -449,6 +454,9 @@ static Bool ms_process_cmd_line_option(const HChar* arg)
 
    else if VG_BINT_CLO(arg, "--max-snapshots",  clo_max_snapshots, 10, 1000) {}
 
+   else if VG_BINT_CLO(arg, "--stream-interval", clo_stream_interval,
+                       0, 0x7fffffffffffffffLL) {}
+
    else if VG_STR_CLO(arg, "--massif-out-file", clo_massif_out_file) {}
 
    else
@@ -474,6 +482,8 @@ static void ms_print_usage(void)
 "                              or heap bytes alloc'd/dealloc'd [i]\n"
 "    --detailed-freq=<N>       every Nth snapshot should be detailed [10]\n"
 "    --max-snapshots=<N>       maximum number of snapshots recorded [100]\n"
+"    --stream-interval=<t>     write snapshots as they are taken, at least\n"
+"                              <t> time units apart, without culling [0, off]\n"
 "    --massif-out-file=<file>  output file name [massif.out.%%p]\n"
    );
 }
@@ -585,12 +595,22 @@ struct _SXPt {
 // parent node to all top-XPts.
 static XPt* alloc_xpt;
 
+// XPts pruned from the XTree (see maybe_prune_XTree), linked through
+// 'parent', for reuse.
+static XPt* free_xpts = NULL;
+
 static XPt* new_XPt(Addr ip, XPt* parent)
 {
-   // XPts are never freed, so we can use VG_(perm_malloc) to allocate them.
-   // Note that we cannot use VG_(perm_malloc) for the 'children' array, because
-   // that needs to be resizable.
-   XPt* xpt    = VG_(perm_malloc)(sizeof(XPt), vg_alignof(XPt));
+   // XPts are never freed, only reused, so we can use VG_(perm_malloc) to
+   // allocate them.  Note that we cannot use VG_(perm_malloc) for the
+   // 'children' array, because that needs to be resizable.
+   XPt* xpt;
+   if (free_xpts) {
+      xpt       = free_xpts;
+      free_xpts = xpt->parent;
+   } else {
+      xpt = VG_(perm_malloc)(sizeof(XPt), vg_alignof(XPt));
+   }
    xpt->ip     = ip;
    xpt->szB    = 0;
    xpt->parent = parent;
@@ -806,6 +826,7 @@ static void sanity_check_SXTree(SXPt* sxpt)
 
 // This is the limit on the number of removed alloc-fns that can be in a
 // single XCon.
+#define MIN_OVERESTIMATE   3
 #define MAX_OVERESTIMATE   50
 #define MAX_IPS            (MAX_DEPTH + MAX_OVERESTIMATE)
 
@@ -849,7 +870,7 @@ Int get_IPs( ThreadId tid, Bool exclude_first_entry, Addr ips[])
 
    // Main loop.
    redo = True;      // Assume this to begin with.
-   for (overestimate = 3; redo; overestimate += 6) {
+   for (overestimate = MIN_OVERESTIMATE; redo; overestimate += 6) {
       // This should never happen -- would require MAX_OVERESTIMATE
       // alloc-fns to be removed from the stack trace.
       if (overestimate > MAX_OVERESTIMATE)
@@ -898,9 +919,97 @@ Int get_IPs( ThreadId tid, Bool exclude_first_entry, Addr ips[])
    return n_ips;
 }
 
+// XCon cache.  Most allocations come from a small number of sites, and
+// for a repeated site both the alloc-fn filtering in get_IPs (which calls
+// the expensive VG_(get_fnname) for every entry) and the descent through
+// the XTree give the same bottom-XPt as last time.  So we map the raw,
+// unfiltered stack trace -- as fetched by the first iteration of get_IPs
+// -- to the result of get_XCon.  Traces for which get_IPs had to redo the
+// walk are not cached, as their result depends on deeper entries.
+// Entries are only freed when their XPt is pruned.
+typedef struct _XConCacheNode XConCacheNode;
+struct _XConCacheNode {
+   XConCacheNode* next;
+   UWord          key;           // hash of the raw stack trace
+   Bool           exclude_first_entry;
+   Int            n_ips;
+   Addr*          ips;           // the raw stack trace
+   XPt*           xpt;           // bottom-XPt, or NULL if ignored
+};
+
+static VgHashTable xcon_cache = NULL;
+
+static UWord hash_IPs(Addr ips[], Int n_ips, Bool exclude_first_entry)
+{
+   UWord h = exclude_first_entry ? 1 : 0;
+   Int i;
+   for (i = 0; i < n_ips; i++)
+      h = (h << 5) + (h >> (sizeof(UWord) * 8 - 5)) + ips[i];
+   return h;
+}
+
+static Word cmp_XConCacheNode(const void* node1, const void* node2)
+{
+   const XConCacheNode* n1 = node1;
+   const XConCacheNode* n2 = node2;
+   Int i;
+
+   if (n1->exclude_first_entry != n2->exclude_first_entry ||
+       n1->n_ips != n2->n_ips)
+      return 1;
+   for (i = 0; i < n1->n_ips; i++)
+      if (n1->ips[i] != n2->ips[i])
+         return 1;
+   return 0;
+}
+
+static XPt* get_XCon_uncached( ThreadId tid, Bool exclude_first_entry );
+
 // Gets an XCon and puts it in the tree.  Returns the XCon's bottom-XPt.
 // Unless the allocation should be ignored, in which case we return NULL.
 static XPt* get_XCon( ThreadId tid, Bool exclude_first_entry )
+{
+   static Addr raw_ips[MAX_IPS];
+   XConCacheNode  lookup;
+   XConCacheNode* node;
+   UInt redos;
+   XPt* xpt;
+
+   // Same request as the first iteration of get_IPs.
+   Int n_raw_ips = VG_(get_StackTrace)( tid, raw_ips,
+                                        clo_depth + MIN_OVERESTIMATE,
+                                        NULL/*array to dump SP values in*/,
+                                        NULL/*array to dump FP values in*/,
+                                        0/*first_ip_delta*/ );
+   tl_assert(n_raw_ips > 0);
+
+   lookup.key = hash_IPs(raw_ips, n_raw_ips, exclude_first_entry);
+   lookup.exclude_first_entry = exclude_first_entry;
+   lookup.n_ips = n_raw_ips;
+   lookup.ips = raw_ips;
+   node = VG_(HT_gen_lookup)(xcon_cache, &lookup, cmp_XConCacheNode);
+   if (node) {
+      n_XCon_cache_hits++;
+      return node->xpt;
+   }
+   n_XCon_cache_misses++;
+
+   redos = n_XCon_redos;
+   xpt = get_XCon_uncached(tid, exclude_first_entry);
+   if (redos == n_XCon_redos) {
+      node = VG_(malloc)("ms.main.gX.1", sizeof(XConCacheNode));
+      node->key = lookup.key;
+      node->exclude_first_entry = exclude_first_entry;
+      node->n_ips = n_raw_ips;
+      node->ips = VG_(malloc)("ms.main.gX.2", n_raw_ips * sizeof(Addr));
+      VG_(memcpy)(node->ips, raw_ips, n_raw_ips * sizeof(Addr));
+      node->xpt = xpt;
+      VG_(HT_add_node)(xcon_cache, node);
+   }
+   return xpt;
+}
+
+static XPt* get_XCon_uncached( ThreadId tid, Bool exclude_first_entry )
 {
    static Addr ips[MAX_IPS];
    Int i;
@@ -923,6 +1032,9 @@ static XPt* get_XCon( ThreadId tid, Bool exclude_first_entry )
       // Linear search, ugh -- about 10% of time for konqueror startup tried
       // caching last result, only hit about 4% for konqueror.
       // Nb:  this search hits about 98% of the time for konqueror
+      // Nb:  only done on XCon cache misses.  The children are not kept
+      // sorted by IP, as their order decides the order of equally sized
+      // entries in the output.
       for (ch = 0; True; ch++) {
          if (ch == xpt->n_children) {
             // IP not found in the children.
@@ -1032,6 +1144,7 @@ typedef
       SizeT heap_szB;
       SizeT heap_extra_szB;// Heap slop + admin bytes.
       SizeT stacks_szB;
+      SizeT rss_szB;       // Resident client memory; --pages-as-heap only.
       SXPt* alloc_sxpt;    // Heap XTree root, if a detailed snapshot,
    }                       // otherwise NULL.
    Snapshot;
@@ -1039,6 +1152,11 @@ typedef
 static UInt      next_snapshot_i = 0;  // Index of where next snapshot will go.
 static Snapshot* snapshots;            // Array of snapshots.
 
+// In streaming mode (--stream-interval), each snapshot is written out as
+// soon as it is taken, from snapshots[0], and then deleted.  So nothing is
+// ever culled, and memory use does not grow with the number of snapshots.
+static void stream_snapshot(Snapshot* snapshot);
+
 static Bool is_snapshot_in_use(Snapshot* snapshot)
 {
    if (Unused == snapshot->kind) {
@@ -1047,6 +1165,7 @@ static Bool is_snapshot_in_use(Snapshot* snapshot)
       tl_assert(snapshot->heap_extra_szB == 0);
       tl_assert(snapshot->heap_szB       == 0);
       tl_assert(snapshot->stacks_szB     == 0);
+      tl_assert(snapshot->rss_szB        == 0);
       tl_assert(snapshot->alloc_sxpt     == NULL);
       return False;
    } else {
@@ -1098,6 +1217,7 @@ static void clear_snapshot(Snapshot* snapshot, Bool do_sanity_check)
    snapshot->heap_extra_szB = 0;
    snapshot->heap_szB       = 0;
    snapshot->stacks_szB     = 0;
+   snapshot->rss_szB        = 0;
    snapshot->alloc_sxpt     = NULL;
 }
 
@@ -1332,6 +1452,12 @@ take_snapshot(Snapshot* snapshot, SnapshotKind kind, Time my_time,
       snapshot->stacks_szB = stacks_szB;
    }
 
+   // With --pages-as-heap=yes the heap is what is mapped, so also say how
+   // much of it is actually resident.
+   if (clo_pages_as_heap) {
+      snapshot->rss_szB = VG_(am_client_rss_szB)();
+   }
+
    // Rest of snapshot.
    snapshot->kind = kind;
    snapshot->time = my_time;
@@ -1437,10 +1563,17 @@ maybe_take_snapshot(SnapshotKind kind, const HChar* what)
    VERB_snapshot(2, what, next_snapshot_i);
    n_skipped_snapshots_since_last_snapshot = 0;
 
-   // Cull the entries, if our snapshot table is full.
-   next_snapshot_i++;
-   if (clo_max_snapshots == next_snapshot_i) {
-      min_time_interval = cull_snapshots();
+   if (clo_stream_interval > 0) {
+      // Write it out now, rather than keeping it.
+      stream_snapshot(snapshot);
+      min_time_interval = clo_stream_interval;
+
+   } else {
+      // Cull the entries, if our snapshot table is full.
+      next_snapshot_i++;
+      if (clo_max_snapshots == next_snapshot_i) {
+         min_time_interval = cull_snapshots();
+      }
    }
 
    // Work out the earliest time when the next snapshot can happen.
@@ -1507,6 +1640,123 @@ static void update_heap_stats(SSizeT heap_szB_delta, Int heap_extra_szB_delta)
    update_alloc_stats(heap_szB_delta + heap_extra_szB_delta);
 }
 
+//------------------------------------------------------------//
+//--- XTree pruning                                        ---//
+//------------------------------------------------------------//
+
+// A program that allocates from very many different stacks, most of
+// them for blocks that are soon freed again, would make the XTree grow
+// without bound.  But an XPt with no memory in it plays no part in
+// future snapshots (past ones have their own copies, as SXTrees), so
+// every so often -- whenever the number of XPts in use has doubled --
+// such XPts are cut out of the XTree, together with the XCon cache
+// entries leading to them.  Should the same stack allocate again, its
+// XPts are simply made again.  The only XPts with no memory in them that
+// are still needed are those of live zero-sized blocks, and their
+// ancestors.
+
+#define MIN_XPTS_TO_PRUNE 100000
+
+static UInt prune_xpts_at = MIN_XPTS_TO_PRUNE;
+
+// Unlinks the XTree below xpt, collecting its XPts in 'dead'.  Their
+// 'parent' is set to NULL, which marks them as dead.
+static void kill_XTree(XPt* xpt, XArray* dead)
+{
+   UInt i;
+
+   for (i = 0; i < xpt->n_children; i++)
+      kill_XTree(xpt->children[i], dead);
+   if (xpt->children)
+      VG_(free)(xpt->children);
+   xpt->children     = NULL;
+   xpt->n_children   = 0;
+   xpt->max_children = 0;
+   xpt->parent       = NULL;
+   VG_(addToXA)(dead, &xpt);
+}
+
+// Kills the children of xpt with no memory in them, unless they are in
+// 'keep', and does the same further down for the others.  The order of
+// the remaining children is kept, since it matters for the output.
+static void prune_XTree(XPt* xpt, WordFM* keep, XArray* dead)
+{
+   UInt i, j;
+
+   for (i = 0, j = 0; i < xpt->n_children; i++) {
+      XPt* child = xpt->children[i];
+      if (0 == child->szB
+          && !VG_(lookupFM)(keep, NULL, NULL, (UWord)child)) {
+         kill_XTree(child, dead);
+      } else {
+         prune_XTree(child, keep, dead);
+         xpt->children[j++] = child;
+      }
+   }
+   xpt->n_children = j;
+}
+
+static void maybe_prune_XTree(void)
+{
+   WordFM*    keep;
+   XArray*    dead;
+   HP_Chunk*  hc;
+   XPt*       xpt;
+   VgHashNode** nodes;
+   UInt       i, n_nodes, n_live;
+   Word       n_dead;
+
+   if (n_xpts - n_xpts_pruned < prune_xpts_at)
+      return;
+
+   keep = VG_(newFM)(VG_(malloc), "ms.main.mpX.1", VG_(free), NULL);
+   VG_(HT_ResetIter)(malloc_list);
+   while ( (hc = VG_(HT_Next)(malloc_list)) ) {
+      if (0 != hc->req_szB)
+         continue;
+      for (xpt = hc->where; xpt != NULL; xpt = xpt->parent) {
+         if (VG_(lookupFM)(keep, NULL, NULL, (UWord)xpt))
+            break;
+         VG_(addToFM)(keep, (UWord)xpt, 0);
+      }
+   }
+
+   dead = VG_(newXA)(VG_(malloc), "ms.main.mpX.2", VG_(free), sizeof(XPt*));
+   prune_XTree(alloc_xpt, keep, dead);
+   VG_(deleteFM)(keep, NULL, NULL);
+   n_dead = VG_(sizeXA)(dead);
+
+   if (n_dead > 0) {
+      // Forget the cached XCons leading to dead XPts.  (alloc_xpt has no
+      // parent either, but is never dead.)
+      nodes = VG_(HT_to_array)(xcon_cache, &n_nodes);
+      for (i = 0; i < n_nodes; i++) {
+         XConCacheNode* node = (XConCacheNode*)nodes[i];
+         if (node->xpt && node->xpt != alloc_xpt
+             && NULL == node->xpt->parent) {
+            VG_(HT_gen_remove)(xcon_cache, node, cmp_XConCacheNode);
+            VG_(free)(node->ips);
+            VG_(free)(node);
+         }
+      }
+      VG_(free)(nodes);
+
+      for (i = 0; i < n_dead; i++) {
+         xpt = *(XPt**)VG_(indexXA)(dead, i);
+         xpt->parent = free_xpts;
+         free_xpts   = xpt;
+      }
+   }
+   VG_(deleteXA)(dead);
+
+   n_xpts_pruned += n_dead;
+   n_prunings++;
+   n_live = n_xpts - n_xpts_pruned;
+   prune_xpts_at = 2 * n_live > MIN_XPTS_TO_PRUNE
+                 ? 2 * n_live : MIN_XPTS_TO_PRUNE;
+   VERB(1, "pruned %ld XPts, %u left\n", n_dead, n_live);
+}
+
 static
 void* record_block( ThreadId tid, void* p, SizeT req_szB, SizeT slop_szB,
                     Bool exclude_first_entry, Bool maybe_snapshot )
@@ -1522,6 +1772,7 @@ void* record_block( ThreadId tid, void* p, SizeT req_szB, SizeT slop_szB,
    if (clo_heap) {
       VERB(3, "<<< record_block (%lu, %lu)\n", req_szB, slop_szB);
 
+      maybe_prune_XTree();
       hc->where = get_XCon( tid, exclude_first_entry );
 
       if (hc->where) {
@@ -1803,33 +2054,166 @@ static SizeT ms_malloc_usable_size ( ThreadId tid, void* p )
 //--- Page handling                                        ---//
 //------------------------------------------------------------//
 
+// With --pages-as-heap=yes, the pages are not recorded in malloc_list one
+// at a time.  Each mmap, brk, etc. is recorded as a single range, and
+// neighbouring ranges from the same XCon are coalesced, so that a program
+// that maps a lot of memory doesn't need a node per page.  Unmapping part
+// of a range splits it.  The ranges never overlap, and page_ranges orders
+// them by address;  a lookup with a range finds one that overlaps it.
+typedef
+   struct {
+      Addr  start;
+      SizeT len;
+      XPt*  where;
+   }
+   PageRange;
+
+static WordFM* page_ranges = NULL;   // PageRange* -> nothing
+
+static Word cmp_PageRange ( UWord key1, UWord key2 )
+{
+   const PageRange* r1 = (const PageRange*)key1;
+   const PageRange* r2 = (const PageRange*)key2;
+   if (r1->start + r1->len <= r2->start) return -1;
+   if (r2->start + r2->len <= r1->start) return  1;
+   return 0;
+}
+
+static PageRange* find_page_range ( Addr a, SizeT len )
+{
+   PageRange probe;
+   UWord     key;
+   probe.start = a;
+   probe.len   = len;
+   return VG_(lookupFM)(page_ranges, &key, NULL, (UWord)&probe)
+          ? (PageRange*)key : NULL;
+}
+
+// Brk is often grown by a page or two at a time, by allocators that call
+// sbrk for each small request.  Getting a stack trace for each of those
+// costs more than it tells, so an increment of less than
+// BRK_SAMPLE_MAX_SZB is just added to the range below it, and only every
+// BRK_SAMPLE_EVERY'th one gets a stack trace of its own.
+#define BRK_SAMPLE_MAX_SZB  (64 * 1024)
+#define BRK_SAMPLE_EVERY    16
+
+static UInt n_brk_unsampled = 0;
+
+// Remove [a, a+len) from the ranges, and from the heap.  Returns the
+// number of bytes that were recorded.
+static SizeT unrecord_page_range ( Addr a, SizeT len )
+{
+   Addr       end     = a + len;
+   SizeT      removed = 0;
+   PageRange* r;
+
+   while ((r = find_page_range(a, len)) != NULL) {
+      Addr  r_end = r->start + r->len;
+      Addr  lo    = r->start > a ? r->start : a;
+      Addr  hi    = r_end < end  ? r_end    : end;
+
+      update_heap_stats(-(SSizeT)(hi - lo), 0);
+      update_XCon(r->where, -(SSizeT)(hi - lo));
+      removed += hi - lo;
+
+      if (r->start < a && r_end > end) {
+         // The hole is in the middle;  keep both ends.
+         PageRange* tail = VG_(malloc)("ms.main.urpr.1", sizeof(PageRange));
+         tail->start = end;
+         tail->len   = r_end - end;
+         tail->where = r->where;
+         r->len = a - r->start;
+         VG_(addToFM)(page_ranges, (UWord)tail, 0);
+      } else if (r->start < a) {
+         r->len = a - r->start;
+      } else if (r_end > end) {
+         // Moving the start up keeps r in the same place in the order.
+         r->start = end;
+         r->len   = r_end - end;
+      } else {
+         VG_(delFromFM)(page_ranges, NULL, NULL, (UWord)r);
+         VG_(free)(r);
+      }
+   }
+   return removed;
+}
+
+// Add [a, a+len), which must not be recorded already, to the ranges and
+// to the heap, coalescing it with the ranges either side if they have the
+// same XCon.
+static void record_page_range ( Addr a, SizeT len, XPt* where )
+{
+   PageRange* below = a > 0 ? find_page_range(a - 1, 1) : NULL;
+   PageRange* above = find_page_range(a + len, 1);
+
+   update_heap_stats(len, 0);
+   update_XCon(where, len);
+
+   if (below && below->where != where) below = NULL;
+   if (above && above->where != where) above = NULL;
+
+   if (below && above) {
+      below->len += len + above->len;
+      VG_(delFromFM)(page_ranges, NULL, NULL, (UWord)above);
+      VG_(free)(above);
+   } else if (below) {
+      below->len += len;
+   } else if (above) {
+      above->start = a;
+      above->len  += len;
+   } else {
+      PageRange* r = VG_(malloc)("ms.main.rpr.1", sizeof(PageRange));
+      r->start = a;
+      r->len   = len;
+      r->where = where;
+      VG_(addToFM)(page_ranges, (UWord)r, 0);
+   }
+}
+
+// 'where' is the XCon to attribute the pages to, or NULL to get a stack
+// trace for them.
 static
-void ms_record_page_mem ( Addr a, SizeT len )
+void ms_record_page_mem ( Addr a, SizeT len, XPt* where )
 {
-   ThreadId tid = VG_(get_running_tid)();
-   Addr end;
    tl_assert(VG_IS_PAGE_ALIGNED(len));
    tl_assert(len >= VKI_PAGE_SIZE);
-   // Record the first N-1 pages as blocks, but don't do any snapshots.
-   for (end = a + len - VKI_PAGE_SIZE; a < end; a += VKI_PAGE_SIZE) {
-      record_block( tid, (void*)a, VKI_PAGE_SIZE, /*slop_szB*/0,
-                    /*exclude_first_entry*/False, /*maybe_snapshot*/False );
+   VERB(3, "<<< ms_record_page_mem (%#lx, %lu)\n", a, len);
+
+   // A mapping can replace some that are already there (eg. MAP_FIXED).
+   unrecord_page_range(a, len);
+
+   if (where == NULL)
+      where = get_XCon( VG_(get_running_tid)(), /*exclude_first_entry*/False );
+   if (where) {
+      n_heap_allocs++;
+      record_page_range(a, len, where);
+      maybe_take_snapshot(Normal, "  alloc");
+   } else {
+      // Ignored allocation.
+      n_ignored_heap_allocs++;
+      VERB(3, "(ignored)\n");
    }
-   // Record the last page as a block, and maybe do a snapshot afterwards.
-   record_block( tid, (void*)a, VKI_PAGE_SIZE, /*slop_szB*/0,
-                 /*exclude_first_entry*/False, /*maybe_snapshot*/True );
+   VERB(3, ">>>\n");
 }
 
 static
 void ms_unrecord_page_mem( Addr a, SizeT len )
 {
-   Addr end;
    tl_assert(VG_IS_PAGE_ALIGNED(len));
    tl_assert(len >= VKI_PAGE_SIZE);
-   for (end = a + len - VKI_PAGE_SIZE; a < end; a += VKI_PAGE_SIZE) {
-      unrecord_block((void*)a, /*maybe_snapshot*/False);
+   VERB(3, "<<< ms_unrecord_page_mem (%#lx, %lu)\n", a, len);
+
+   // Only take snapshots if some of the pages were recorded, like
+   // unrecord_block() does.
+   if (find_page_range(a, len)) {
+      n_heap_frees++;
+      maybe_take_snapshot(Peak, "de-PEAK");
+      unrecord_page_range(a, len);
+      maybe_take_snapshot(Normal, "dealloc");
+   } else {
+      n_ignored_heap_frees++;
    }
-   unrecord_block((void*)a, /*maybe_snapshot*/True);
+   VERB(3, ">>>\n");
 }
 
 //------------------------------------------------------------//
@@ -1839,7 +2223,7 @@ void ms_new_mem_mmap ( Addr a, SizeT len,
                        Bool rr, Bool ww, Bool xx, ULong di_handle )
 {
    tl_assert(VG_IS_PAGE_ALIGNED(len));
-   ms_record_page_mem(a, len);
+   ms_record_page_mem(a, len, NULL);
 }
 
 static
@@ -1848,9 +2232,11 @@ void ms_new_mem_startup( Addr a, SizeT len,
 {
    // startup maps are always be page-sized, except the trampoline page is
    // marked by the core as only being the size of the trampoline itself,
-   // which is something like 57 bytes.  Round it up to page size.
-   len = VG_PGROUNDUP(len);
-   ms_record_page_mem(a, len);
+   // which is something like 57 bytes, and isn't at the start of its
+   // page.  Round it out to the whole page.
+   len = VG_PGROUNDUP(a + len) - VG_PGROUNDDN(a);
+   a   = VG_PGROUNDDN(a);
+   ms_record_page_mem(a, len, NULL);
 }
 
 static
@@ -1859,12 +2245,27 @@ void ms_new_mem_brk ( Addr a, SizeT len, ThreadId tid )
    // brk limit is not necessarily aligned on a page boundary.
    // If new memory being brk-ed implies to allocate a new page,
    // then call ms_record_page_mem with page aligned parameters
-   // otherwise just ignore.
+   // otherwise just ignore.  The new pages start at the one after
+   // old_bottom_page, which was already in use.
    Addr old_bottom_page = VG_PGROUNDDN(a - 1);
    Addr new_top_page = VG_PGROUNDDN(a + len - 1);
-   if (old_bottom_page != new_top_page)
-      ms_record_page_mem(VG_PGROUNDDN(a),
-                         (new_top_page - old_bottom_page));
+   Addr start = old_bottom_page + VKI_PAGE_SIZE;
+   SizeT pages_szB = new_top_page - old_bottom_page;
+   XPt* where = NULL;
+
+   if (old_bottom_page == new_top_page)
+      return;
+
+   // Sample the stack for small increments, see BRK_SAMPLE_MAX_SZB.
+   if (pages_szB < BRK_SAMPLE_MAX_SZB) {
+      PageRange* below = find_page_range(start - 1, 1);
+      if (below && ++n_brk_unsampled < BRK_SAMPLE_EVERY) {
+         where = below->where;
+      } else {
+         n_brk_unsampled = 0;
+      }
+   }
+   ms_record_page_mem(start, pages_szB, where);
 }
 
 static
@@ -1872,7 +2273,7 @@ void ms_copy_mem_remap( Addr from, Addr to, SizeT len)
 {
    tl_assert(VG_IS_PAGE_ALIGNED(len));
    ms_unrecord_page_mem(from, len);
-   ms_record_page_mem(to, len);
+   ms_record_page_mem(to, len, NULL);
 }
 
 static
@@ -1890,7 +2291,7 @@ void ms_die_mem_brk( Addr a, SizeT len )
    Addr new_bottom_page = VG_PGROUNDDN(a - 1);
    Addr old_top_page = VG_PGROUNDDN(a + len - 1);
    if (old_top_page != new_bottom_page)
-      ms_unrecord_page_mem(VG_PGROUNDDN(a),
+      ms_unrecord_page_mem(new_bottom_page + VKI_PAGE_SIZE,
                            (old_top_page - new_bottom_page));
 
 }
@@ -2133,12 +2534,55 @@ static const HChar* make_perc(double x)
    return mbuf;
 }
 
-static void pp_snapshot_SXPt(Int fd, SXPt* sxpt, Int depth, HChar* depth_str,
-                            Int depth_str_len,
+// Finds the child of 'prev' that corresponds to 'child', ie. the one for
+// the same code location, or the Insig one.  Returns NULL if there is none.
+static SXPt* find_matching_child_SXPt(SXPt* prev, SXPt* child)
+{
+   Int i;
+   tl_assert(SigSXPt == prev->tag);
+   for (i = 0; i < prev->Sig.n_children; i++) {
+      SXPt* prev_child = prev->Sig.children[i];
+      if (prev_child->tag == child->tag &&
+          (InsigSXPt == child->tag || prev_child->Sig.ip == child->Sig.ip))
+         return prev_child;
+   }
+   return NULL;
+}
+
+// Would 'sxpt' be printed exactly like 'prev'?  (Apart from the order of
+// equally sized children.)
+static Bool is_same_SXTree(SXPt* sxpt, SXPt* prev)
+{
+   Int i;
+
+   if (sxpt->tag != prev->tag || sxpt->szB != prev->szB)
+      return False;
+   if (InsigSXPt == sxpt->tag)
+      return sxpt->Insig.n_xpts == prev->Insig.n_xpts;
+
+   if (sxpt->Sig.ip != prev->Sig.ip ||
+       sxpt->Sig.n_children != prev->Sig.n_children)
+      return False;
+   for (i = 0; i < sxpt->Sig.n_children; i++) {
+      SXPt* child      = sxpt->Sig.children[i];
+      SXPt* prev_child = find_matching_child_SXPt(prev, child);
+      if (NULL == prev_child || !is_same_SXTree(child, prev_child))
+         return False;
+   }
+   return True;
+}
+
+// If 'prev' is non-NULL, it is the corresponding SXPt in the previously
+// printed detailed snapshot, and a subtree the same as its 'prev' is
+// printed as a single "n=:" line, which ms_print replaces by a copy of
+// 'prev'.
+static void pp_snapshot_SXPt(Int fd, SXPt* sxpt, SXPt* prev, Int depth,
+                            HChar* depth_str, Int depth_str_len,
                             SizeT snapshot_heap_szB, SizeT snapshot_total_szB)
 {
    Int   i, j, n_insig_children_sxpts;
    SXPt* child = NULL;
+   Bool  is_same = ( prev && is_same_SXTree(sxpt, prev) );
 
    // Used for printing function names.  Is made static to keep it out
    // of the stack frame -- this function is recursive.  Obviously this
@@ -2178,7 +2622,11 @@ static void pp_snapshot_SXPt(Int fd, SXPt* sxpt, Int depth, HChar* depth_str,
       }
       
       // Do the non-ip_desc part first...
-      FP("%sn%d: %lu ", depth_str, sxpt->Sig.n_children, sxpt->szB);
+      if (is_same) {
+         FP("%sn=: ", depth_str);
+      } else {
+         FP("%sn%d: %lu ", depth_str, sxpt->Sig.n_children, sxpt->szB);
+      }
 
       // For ip_descs beginning with "0xABCD...:" addresses, we first
       // measure the length of the "0xabcd: " address at the start of the
@@ -2215,6 +2663,9 @@ static void pp_snapshot_SXPt(Int fd, SXPt* sxpt, Int depth, HChar* depth_str,
       FP_buf[BUF_LEN-18+j-1] = '\0';   // The string is terminated.
       VG_(write)(fd, (void*)FP_buf, VG_(strlen)(FP_buf));
 
+      // An unchanged subtree is complete with that line.
+      if (is_same) break;
+
       // Indent.
       tl_assert(depth+1 < depth_str_len-1);    // -1 for end NUL char
       depth_str[depth+0] = ' ';
@@ -2240,7 +2691,9 @@ static void pp_snapshot_SXPt(Int fd, SXPt* sxpt, Int depth, HChar* depth_str,
          // Ok, print the child.  NB: contents of ip_desc_array will be
          // trashed by this recursive call.  Doesn't matter currently,
          // but worth noting.
-         pp_snapshot_SXPt(fd, child, depth+1, depth_str, depth_str_len,
+         pp_snapshot_SXPt(fd, child,
+            ( prev ? find_matching_child_SXPt(prev, child) : NULL ),
+            depth+1, depth_str, depth_str_len,
             snapshot_heap_szB, snapshot_total_szB);
       }
 
@@ -2254,9 +2707,14 @@ static void pp_snapshot_SXPt(Int fd, SXPt* sxpt, Int depth, HChar* depth_str,
 
     case InsigSXPt: {
       const HChar* s = ( 1 == sxpt->Insig.n_xpts ? "," : "s, all" );
-      FP("%sn0: %lu in %d place%s below massif's threshold (%s)\n",
-         depth_str, sxpt->szB, sxpt->Insig.n_xpts, s,
-         make_perc(clo_threshold));
+      if (is_same) {
+         FP("%sn=: in %d place%s below massif's threshold (%s)\n",
+            depth_str, sxpt->Insig.n_xpts, s, make_perc(clo_threshold));
+      } else {
+         FP("%sn0: %lu in %d place%s below massif's threshold (%s)\n",
+            depth_str, sxpt->szB, sxpt->Insig.n_xpts, s,
+            make_perc(clo_threshold));
+      }
       break;
     }
 
@@ -2265,7 +2723,10 @@ static void pp_snapshot_SXPt(Int fd, SXPt* sxpt, Int depth, HChar* depth_str,
    }
 }
 
-static void pp_snapshot(Int fd, Snapshot* snapshot, Int snapshot_n)
+// 'prev_sxpt' is the heap XTree of the previously printed detailed
+// snapshot, if the detailed snapshot should be printed relative to it.
+static void pp_snapshot(Int fd, Snapshot* snapshot, Int snapshot_n,
+                        SXPt* prev_sxpt)
 {
    sanity_check_snapshot(snapshot);
 
@@ -2276,6 +2737,9 @@ static void pp_snapshot(Int fd, Snapshot* snapshot, Int snapshot_n)
    FP("mem_heap_B=%lu\n",       snapshot->heap_szB);
    FP("mem_heap_extra_B=%lu\n", snapshot->heap_extra_szB);
    FP("mem_stacks_B=%lu\n",     snapshot->stacks_szB);
+   if (clo_pages_as_heap) {
+      FP("mem_rss_B=%lu\n",        snapshot->rss_szB);
+   }
 
    if (is_detailed_snapshot(snapshot)) {
       // Detailed snapshot -- print heap tree.
@@ -2287,7 +2751,7 @@ static void pp_snapshot(Int fd, Snapshot* snapshot, Int snapshot_n)
       depth_str[0] = '\0';   // Initialise depth_str to "".
 
       FP("heap_tree=%s\n", ( Peak == snapshot->kind ? "peak" : "detailed" ));
-      pp_snapshot_SXPt(fd, snapshot->alloc_sxpt, 0, depth_str,
+      pp_snapshot_SXPt(fd, snapshot->alloc_sxpt, prev_sxpt, 0, depth_str,
                        depth_str_len, snapshot->heap_szB,
                        snapshot_total_szB);
 
@@ -2298,9 +2762,9 @@ static void pp_snapshot(Int fd, Snapshot* snapshot, Int snapshot_n)
    }
 }
 
-static void write_snapshots_to_file(const HChar* massif_out_file, 
-                                    Snapshot snapshots_array[], 
-                                    Int nr_elements)
+// Opens the output file and writes the header lines.  Returns the file
+// descriptor, or -1 if the file can't be opened.
+static Int open_output_file(const HChar* massif_out_file)
 {
    Int i, fd;
    SysRes sres;
@@ -2312,7 +2776,7 @@ static void write_snapshots_to_file(const HChar* massif_out_file,
       // between multiple cachegrinded processes?), give up now.
       VG_(umsg)("error: can't open output file '%s'\n", massif_out_file );
       VG_(umsg)("       ... so profiling results will be missing.\n");
-      return;
+      return -1;
    } else {
       fd = sr_Res(sres);
    }
@@ -2341,13 +2805,96 @@ static void write_snapshots_to_file(const HChar* massif_out_file,
 
    FP("time_unit: %s\n", TimeUnit_to_string(clo_time_unit));
 
+   return fd;
+}
+
+static void write_snapshots_to_file(const HChar* massif_out_file, 
+                                    Snapshot snapshots_array[], 
+                                    Int nr_elements)
+{
+   Int i;
+   Int fd = open_output_file(massif_out_file);
+   if (fd < 0) return;
+
    for (i = 0; i < nr_elements; i++) {
       Snapshot* snapshot = & snapshots_array[i];
-      pp_snapshot(fd, snapshot, i);     // Detailed snapshot!
+      pp_snapshot(fd, snapshot, i, NULL);     // Detailed snapshot!
    }
    VG_(close) (fd);
 }
 
+// Streaming state.  Only the heap XTree of the last detailed snapshot is
+// kept, as later detailed snapshots are written relative to it.
+static Int   stream_fd            = -1;
+static Int   stream_pid           = 0;
+static Int   n_streamed_snapshots = 0;
+static SXPt* stream_prev_sxpt     = NULL;
+
+// Does what pp_snapshot_SXPt does for main-or-below-main, but for all of
+// the descendants of 'sxpt' and freeing what is cut off.  Done before
+// printing a streamed snapshot, so that the SXTree kept for comparison
+// looks like the printed one even where it was not printed in full.
+static void cut_SXTree_below_main(SXPt* sxpt)
+{
+   Int i, j;
+
+   tl_assert(SigSXPt == sxpt->tag);
+   for (i = 0; i < sxpt->Sig.n_children; i++) {
+      SXPt* child = sxpt->Sig.children[i];
+      Vg_FnNameKind kind;
+
+      if (SigSXPt != child->tag) continue;
+
+      kind = VG_(get_fnname_kind_from_IP)(child->Sig.ip);
+      if (Vg_FnNameMain == kind || Vg_FnNameBelowMain == kind) {
+         for (j = 0; j < child->Sig.n_children; j++) {
+            free_SXTree(child->Sig.children[j]);
+         }
+         VG_(free)(child->Sig.children);
+         child->Sig.children   = NULL;
+         child->Sig.n_children = 0;
+      } else {
+         cut_SXTree_below_main(child);
+      }
+   }
+}
+
+static void stream_snapshot(Snapshot* snapshot)
+{
+   if (stream_pid != VG_(getpid)()) {
+      // First snapshot, or the first one in a forked child:  start a new
+      // file, as late as possible for the same reason as
+      // write_snapshots_array_to_file.
+      HChar* massif_out_file =
+         VG_(expand_file_name)("--massif-out-file", clo_massif_out_file);
+      if (stream_fd >= 0) VG_(close)(stream_fd);
+      if (stream_prev_sxpt) {
+         free_SXTree(stream_prev_sxpt);
+         stream_prev_sxpt = NULL;
+      }
+      stream_pid = VG_(getpid)();
+      n_streamed_snapshots = 0;
+      stream_fd = open_output_file(massif_out_file);
+      VG_(free)(massif_out_file);
+   }
+
+   if (is_detailed_snapshot(snapshot) && !VG_(clo_show_below_main))
+      cut_SXTree_below_main(snapshot->alloc_sxpt);
+
+   if (stream_fd >= 0)
+      pp_snapshot(stream_fd, snapshot, n_streamed_snapshots,
+                  stream_prev_sxpt);
+   n_streamed_snapshots++;
+
+   // Keep the heap XTree as the base for the next detailed snapshot.
+   if (is_detailed_snapshot(snapshot)) {
+      if (stream_prev_sxpt) free_SXTree(stream_prev_sxpt);
+      stream_prev_sxpt     = snapshot->alloc_sxpt;
+      snapshot->alloc_sxpt = NULL;
+   }
+   delete_snapshot(snapshot);
+}
+
 static void write_snapshots_array_to_file(void)
 {
    // Setup output filename.  Nb: it's important to do this now, ie. as late
@@ -2432,6 +2979,8 @@ static void ms_print_stats (void)
    STATS("stack allocs:          %u\n", n_stack_allocs);
    STATS("stack frees:           %u\n", n_stack_frees);
    STATS("XPts:                  %u\n", n_xpts);
+   STATS("XPts pruned:           %u (%u prunings)\n",
+      n_xpts_pruned, n_prunings);
    STATS("top-XPts:              %u (%d%%)\n",
       alloc_xpt->n_children,
       ( n_xpts ? alloc_xpt->n_children * 100 / n_xpts : 0));
@@ -2445,6 +2994,8 @@ static void ms_print_stats (void)
    STATS("peak snapshots:        %u\n", n_peak_snapshots);
    STATS("cullings:              %u\n", n_cullings);
    STATS("XCon redos:            %u\n", n_XCon_redos);
+   STATS("XCon cache hits:       %u (%u misses)\n",
+      n_XCon_cache_hits, n_XCon_cache_misses);
 #undef STATS
 }
 
@@ -2455,7 +3006,11 @@ static void ms_print_stats (void)
 static void ms_fini(Int exit_status)
 {
    // Output.
-   write_snapshots_array_to_file();
+   if (clo_stream_interval > 0) {
+      if (stream_fd >= 0) VG_(close)(stream_fd);
+   } else {
+      write_snapshots_array_to_file();
+   }
 
    // Stats
    tl_assert(n_xpts > 0);  // always have alloc_xpt
@@ -2555,6 +3110,9 @@ static void ms_post_clo_init(void)
 
       VG_(track_die_mem_brk)     ( ms_die_mem_brk     );
       VG_(track_die_mem_munmap)  ( ms_die_mem_munmap  ); 
+
+      page_ranges = VG_(newFM)(VG_(malloc), "ms.main.mpoci.2", VG_(free),
+                               cmp_PageRange);
    }
 
    // Initialise snapshot array, and sanity-check it.
@@ -2610,6 +3168,7 @@ static void ms_pre_clo_init(void)
 
    // HP_Chunks.
    malloc_list = VG_(HT_construct)( "Massif's malloc list" );
+   xcon_cache  = VG_(HT_construct)( "Massif's XCon cache" );
 
    // Dummy node at top of the context structure.
    alloc_xpt = new_XPt(/*ip*/0, /*parent*/NULL);
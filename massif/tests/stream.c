@@ -0,0 +1,24 @@
+#include <stdlib.h>
+
+// Allocates from one place only at the start, and from another all
+// along.  With --stream-interval, the detailed snapshots after the first
+// write the first place's unchanged subtree as a single "n=:" line.
+
+#define N 40
+
+__attribute__((noinline)) static void* once(int n)  { return malloc(n); }
+__attribute__((noinline)) static void* often(int n) { return malloc(n); }
+
+int main(void)
+{
+   int   i;
+   void* a[N];
+   void* b = once(4000);
+
+   for (i = 0; i < N; i++)
+      a[i] = often(400);   // 400 is divisible by 16 -- so no slop.
+   for (i = 0; i < N; i++)
+      free(a[i]);
+   free(b);
+   return 0;
+}
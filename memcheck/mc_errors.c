@@ -33,6 +33,7 @@
 #include "pub_tool_gdbserver.h"
 #include "pub_tool_poolalloc.h"     // For mc_include.h
 #include "pub_tool_hashtable.h"     // For mc_include.h
+#include "pub_tool_hashtable2.h"     // For mc_include.h
 #include "pub_tool_libcbase.h"
 #include "pub_tool_libcassert.h"
 #include "pub_tool_libcprint.h"
@@ -43,6 +44,7 @@
 #include "pub_tool_tooliface.h"
 #include "pub_tool_threadstate.h"
 #include "pub_tool_debuginfo.h"     // VG_(get_dataname_and_offset)
+#include "pub_tool_execontext.h"
 #include "pub_tool_xarray.h"
 #include "pub_tool_addrinfo.h"
 
@@ -706,6 +708,145 @@ void MC_(pp_Error) ( Error* err )
    }
 }
 
+/*------------------------------------------------------------*/
+/*--- Adaptive definedness checking                        ---*/
+/*------------------------------------------------------------*/
+
+/* With --adaptive-definedness-checks=yes, superblocks are first
+   instrumented with the cheap interpretation of Add, Sub and CmpEQ/NE
+   (see mce.bogusLiterals in mc_translate.c), which now and then gives
+   false undefined-value errors.  The first time such an error turns up
+   at an instruction, it is held back: the instruction becomes a site,
+   the translations containing it are discarded, and when it is next
+   translated, MC_(instrument) uses the expensive interpretation for the
+   whole superblock and calls MC_(helperc_adaptive_recheck) when the
+   instruction is reached.  If the instruction gives the error again, it
+   is reported as usual.  If it is executed again without giving the
+   error, the held-back error was most likely a false one, and is
+   dropped at exit.  If it is never executed again, the held-back error
+   is reported at exit, since nothing is known either way.
+
+   Only the translations containing the site itself are redone, so the
+   expensive interpretation doesn't help when the undefinedness comes
+   from a false positive in some earlier superblock. */
+
+/* Defined in m_transtab.c, but not exported to tools. */
+extern void VG_(discard_translations) ( Addr start, ULong range,
+                                        const HChar* who );
+
+typedef
+   struct _AdaptiveSite {
+      struct _AdaptiveSite* next;
+      UWord       addr;       /* instruction address; the hash key */
+      Bool        pending;    /* error held back, not yet settled */
+      Bool        rechecked;  /* run again with expensive checks, OK */
+      ThreadId    tid;
+      Int         szB;        /* as for Err_Value, or -1 for Err_Cond */
+      UInt        otag;
+      ExeContext* where;
+   }
+   AdaptiveSite;
+
+static VgHashTable adaptive_sites = NULL;
+
+static ULong n_adaptive_sites   = 0;
+static ULong n_adaptive_dropped = 0;
+static ULong n_adaptive_late    = 0;
+
+/* Hold back a value error (szB >= 0) or a conditional jump error (szB
+   == -1) if it is the first one at its instruction.  Returns True if it
+   was held back, and so shouldn't be recorded now. */
+static Bool hold_back_definedness_error ( ThreadId tid, Int szB, UInt otag )
+{
+   Addr          ip = VG_(get_IP)(tid);
+   AdaptiveSite* site;
+
+   if (adaptive_sites == NULL)
+      adaptive_sites = VG_(HT_construct)( "mc.adaptive_sites" );
+
+   site = VG_(HT_lookup)( adaptive_sites, ip );
+   if (site != NULL) {
+      /* Seen before, now with the expensive checks: it's real. */
+      site->pending = False;
+      return False;
+   }
+
+   site = VG_(malloc)( "mc.hbde.1", sizeof(AdaptiveSite) );
+   site->addr      = ip;
+   site->pending   = True;
+   site->rechecked = False;
+   site->tid       = tid;
+   site->szB       = szB;
+   site->otag      = otag;
+   site->where     = VG_(record_ExeContext)( tid, 0/*first_ip_delta*/ );
+   VG_(HT_add_node)( adaptive_sites, site );
+   n_adaptive_sites++;
+
+   VG_(discard_translations)( ip, 1, "memcheck(adaptive-definedness)" );
+   return True;
+}
+
+Bool MC_(is_adaptive_site) ( Addr a, /*OUT*/Bool* pending )
+{
+   AdaptiveSite* site;
+
+   if (adaptive_sites == NULL)
+      return False;
+   site = VG_(HT_lookup)( adaptive_sites, a );
+   if (site == NULL)
+      return False;
+   *pending = site->pending;
+   return True;
+}
+
+VG_REGPARM(1) void MC_(helperc_adaptive_recheck) ( UWord addr )
+{
+   AdaptiveSite* site = VG_(HT_lookup)( adaptive_sites, addr );
+   tl_assert(site);
+   site->rechecked = True;
+}
+
+void MC_(flush_adaptive_sites) ( void )
+{
+   AdaptiveSite* site;
+   MC_Error      extra;
+
+   if (adaptive_sites == NULL)
+      return;
+
+   VG_(HT_ResetIter)( adaptive_sites );
+   while ( (site = VG_(HT_Next)( adaptive_sites )) ) {
+      if (!site->pending)
+         continue;
+      if (site->rechecked) {
+         n_adaptive_dropped++;
+         continue;
+      }
+      n_adaptive_late++;
+      if (site->szB >= 0) {
+         extra.Err.Value.szB       = site->szB;
+         extra.Err.Value.otag      = site->otag;
+         extra.Err.Value.origin_ec = NULL;  /* Filled in later */
+      } else {
+         extra.Err.Cond.otag       = site->otag;
+         extra.Err.Cond.origin_ec  = NULL;  /* Filled in later */
+      }
+      VG_(unique_error)( site->tid, site->szB >= 0 ? Err_Value : Err_Cond,
+                         /*addr*/0, /*s*/NULL, &extra, site->where,
+                         /*print_error*/True, /*allow_GDB_attach*/False,
+                         /*count_error*/True );
+      site->pending = False;
+   }
+}
+
+void MC_(print_adaptive_stats) ( void )
+{
+   VG_(message)(Vg_DebugMsg,
+      " memcheck: adaptive definedness: %llu sites rechecked, "
+      "%llu errors dropped, %llu reported at exit\n",
+      n_adaptive_sites, n_adaptive_dropped, n_adaptive_late );
+}
+
 /*------------------------------------------------------------*/
 /*--- Recording errors                                     ---*/
 /*------------------------------------------------------------*/
@@ -759,6 +900,9 @@ void MC_(record_value_error) ( ThreadId tid, Int szB, UInt otag )
    tl_assert( MC_(clo_mc_level) >= 2 );
    if (otag > 0)
       tl_assert( MC_(clo_mc_level) == 3 );
+   if (MC_(clo_adaptive_definedness_checks)
+       && hold_back_definedness_error( tid, szB, otag ))
+      return;
    extra.Err.Value.szB       = szB;
    extra.Err.Value.otag      = otag;
    extra.Err.Value.origin_ec = NULL;  /* Filled in later */
@@ -771,6 +915,9 @@ void MC_(record_cond_error) ( ThreadId tid, UInt otag )
    tl_assert( MC_(clo_mc_level) >= 2 );
    if (otag > 0)
       tl_assert( MC_(clo_mc_level) == 3 );
+   if (MC_(clo_adaptive_definedness_checks)
+       && hold_back_definedness_error( tid, -1, otag ))
+      return;
    extra.Err.Cond.otag      = otag;
    extra.Err.Cond.origin_ec = NULL;  /* Filled in later */
    VG_(maybe_record_error)( tid, Err_Cond, /*addr*/0, /*s*/NULL, &extra );
@@ -1037,8 +1184,8 @@ static void describe_addr ( Addr a, /*OUT*/AddrInfo* ai )
       We however detect and report that this is a recently re-allocated
       block. */
    /* -- Search for a currently malloc'd block which might bracket it. -- */
-   VG_(HT_ResetIter)(MC_(malloc_list));
-   while ( (mc = VG_(HT_Next)(MC_(malloc_list))) ) {
+   VG_(HT2_ResetIter)(MC_(malloc_list));
+   while ( (mc = VG_(HT2_Next)(MC_(malloc_list))) ) {
       if (addr_is_in_MC_Chunk_default_REDZONE_SZB(mc, a)) {
          ai->tag = Addr_Block;
          ai->Addr.Block.block_kind = Block_Mallocd;
@@ -1217,8 +1364,8 @@ static Bool mempool_block_maybe_describe( Addr a,
    while ( (mp = VG_(HT_Next)(MC_(mempool_list))) ) {
       if (mp->chunks != NULL) {
          MC_Chunk* mc;
-         VG_(HT_ResetIter)(mp->chunks);
-         while ( (mc = VG_(HT_Next)(mp->chunks)) ) {
+         VG_(HT2_ResetIter)(mp->chunks);
+         while ( (mc = VG_(HT2_Next)(mp->chunks)) ) {
             if (addr_is_in_MC_Chunk_with_REDZONE_SZB(mc, a, mp->rzB)) {
                ai->tag = Addr_Block;
                ai->Addr.Block.block_kind = Block_MempoolChunk;
@@ -0,0 +1,524 @@
+/*--------------------------------------------------------------------*/
+/*--- A massif-compatible heap profile of the client blocks.       ---*/
+/*---                                                mc_heapprof.c ---*/
+/*--------------------------------------------------------------------*/
+
+/*
+   This file is part of MemCheck, a heavyweight Valgrind tool for
+   detecting memory errors.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of the
+   License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+   02111-1307, USA.
+
+   The GNU General Public License is contained in the file COPYING.
+*/
+
+#include "pub_tool_basics.h"
+#include "pub_tool_vki.h"
+#include "pub_tool_poolalloc.h"     // For mc_include.h
+#include "pub_tool_hashtable.h"     // For mc_include.h
+#include "pub_tool_hashtable2.h"     // For mc_include.h
+#include "pub_tool_libcbase.h"
+#include "pub_tool_libcassert.h"
+#include "pub_tool_libcfile.h"
+#include "pub_tool_libcprint.h"
+#include "pub_tool_mallocfree.h"
+#include "pub_tool_options.h"
+#include "pub_tool_debuginfo.h"
+#include "pub_tool_execontext.h"
+#include "pub_tool_clientstate.h"
+#include "pub_tool_xarray.h"
+#include "pub_tool_tooliface.h"
+
+#include "mc_include.h"
+
+
+/*------------------------------------------------------------*/
+/*--- Overview                                             ---*/
+/*------------------------------------------------------------*/
+
+/* With --heap-profile=yes, the live bytes of the blocks in
+   MC_(malloc_list) are kept per allocation ExeContext, which memcheck
+   records for each block anyway.  Like massif with --time-unit=B,
+   snapshots of the heap size are taken as the bytes allocated and
+   freed so far grow, every HP_DETAILED_FREQ'th one also recording the
+   live bytes of each allocation site, and a detailed snapshot is taken
+   at the heap peak.  At exit the snapshots are written in massif's
+   output format, so that ms_print can show them.
+
+   When the snapshot array is full, every other snapshot is discarded
+   and the interval between snapshots grows accordingly. */
+
+/* The maximum number of snapshots kept. */
+#define HP_MAX_SNAPSHOTS   100
+
+/* Every HP_DETAILED_FREQ'th snapshot is a detailed one. */
+#define HP_DETAILED_FREQ   10
+
+/* A peak snapshot is retaken when the heap grows by this percentage
+   above the last one. */
+#define HP_PEAK_INACCURACY 1
+
+/* Allocation sites below this percentage of the heap are merged in
+   the printed heap trees. */
+#define HP_THRESHOLD       1
+
+/* The maximum depth of the printed heap trees. */
+#define HP_DEPTH           30
+
+#define HP_BUF_LEN         1024
+
+
+/*------------------------------------------------------------*/
+/*--- Allocation sites and snapshots                       ---*/
+/*------------------------------------------------------------*/
+
+/* The live bytes of an allocation site.  Nb: first two fields must
+   match core's VgHashNode. */
+typedef
+   struct _HP_Site {
+      struct _HP_Site* next;
+      UWord            ecu;     // ECU of 'ec'
+      ExeContext*      ec;      // where the blocks were allocated
+      SizeT            szB;     // live bytes allocated at 'ec'
+   }
+   HP_Site;
+
+typedef
+   struct {
+      ExeContext* ec;
+      SizeT       szB;
+   }
+   HP_SiteSzB;
+
+typedef
+   struct {
+      ULong       time;         // bytes allocated and freed before it
+      SizeT       heap_szB;
+      Bool        is_peak;
+      HP_SiteSzB* sites;        // live sites; NULL unless detailed
+      UInt        n_sites;
+   }
+   HP_Snapshot;
+
+static VgHashTable hp_sites = NULL;
+
+static HP_Snapshot hp_snapshots[HP_MAX_SNAPSHOTS];
+static UInt        hp_n_snapshots = 0;
+static ULong       hp_n_taken     = 0;
+
+static HP_Snapshot hp_peak;
+static Bool        hp_have_peak   = False;
+
+static ULong       hp_time        = 0;
+static ULong       hp_next_time   = 0;
+static ULong       hp_interval    = 0;
+static SizeT       hp_heap_szB    = 0;
+
+static void take_snapshot ( HP_Snapshot* snapshot, Bool detailed )
+{
+   HP_Site* site;
+   UInt     n = 0;
+
+   snapshot->time     = hp_time;
+   snapshot->heap_szB = hp_heap_szB;
+   snapshot->is_peak  = False;
+   snapshot->sites    = NULL;
+   snapshot->n_sites  = 0;
+   if (!detailed)
+      return;
+
+   snapshot->sites = VG_(malloc)("mc.hp.ts.1",
+                        (VG_(HT_count_nodes)(hp_sites) + 1)
+                        * sizeof(HP_SiteSzB));
+   VG_(HT_ResetIter)(hp_sites);
+   while ( (site = VG_(HT_Next)(hp_sites)) ) {
+      if (site->szB == 0)
+         continue;
+      snapshot->sites[n].ec  = site->ec;
+      snapshot->sites[n].szB = site->szB;
+      n++;
+   }
+   snapshot->n_sites = n;
+}
+
+static void delete_snapshot ( HP_Snapshot* snapshot )
+{
+   if (snapshot->sites)
+      VG_(free)(snapshot->sites);
+   snapshot->sites   = NULL;
+   snapshot->n_sites = 0;
+}
+
+/* Discard every other snapshot, keeping the first, and space the next
+   ones as far apart as the kept ones are on average. */
+static void cull_snapshots ( void )
+{
+   UInt i, n = 0;
+
+   for (i = 0; i < hp_n_snapshots; i++) {
+      if (i % 2 == 0)
+         hp_snapshots[n++] = hp_snapshots[i];
+      else
+         delete_snapshot(&hp_snapshots[i]);
+   }
+   hp_n_snapshots = n;
+   tl_assert(n > 1);
+   hp_interval = (hp_snapshots[n-1].time - hp_snapshots[0].time) / (n-1);
+}
+
+static void add_snapshot ( Bool detailed )
+{
+   if (hp_n_snapshots == HP_MAX_SNAPSHOTS)
+      cull_snapshots();
+   take_snapshot(&hp_snapshots[hp_n_snapshots++], detailed);
+}
+
+static void maybe_take_snapshot ( void )
+{
+   if (hp_time < hp_next_time)
+      return;
+
+   hp_n_taken++;
+   add_snapshot(hp_n_taken % HP_DETAILED_FREQ == 0);
+   hp_next_time = hp_time + hp_interval;
+}
+
+/* The heap is about to shrink: if it is now clearly bigger than at
+   the last peak snapshot, it was at a new peak. */
+static void maybe_take_peak_snapshot ( void )
+{
+   if (hp_have_peak
+       && hp_heap_szB <= hp_peak.heap_szB
+                         + hp_peak.heap_szB / 100 * HP_PEAK_INACCURACY)
+      return;
+   if (hp_heap_szB == 0)
+      return;
+
+   delete_snapshot(&hp_peak);
+   take_snapshot(&hp_peak, /*detailed*/True);
+   hp_peak.is_peak = True;
+   hp_have_peak = True;
+}
+
+static HP_Site* get_site ( ExeContext* ec )
+{
+   UWord    ecu  = VG_(get_ECU_from_ExeContext)(ec);
+   HP_Site* site = VG_(HT_lookup)(hp_sites, ecu);
+
+   if (site == NULL) {
+      site = VG_(malloc)("mc.hp.gs.1", sizeof(HP_Site));
+      site->ecu = ecu;
+      site->ec  = ec;
+      site->szB = 0;
+      VG_(HT_add_node)(hp_sites, site);
+   }
+   return site;
+}
+
+/* Nb: MC_(allocated_at) can't be used, as blocks being freed are no
+   longer in MC_(malloc_list).  --heap-profile=yes needs a
+   --keep-stacktraces value for which where[0] is the allocation stack
+   until the block is freed. */
+void MC_(heap_profile_alloc) ( MC_Chunk* mc )
+{
+   HP_Site* site = get_site(mc->where[0]);
+
+   site->szB   += mc->szB;
+   hp_heap_szB += mc->szB;
+   hp_time     += mc->szB;
+   maybe_take_snapshot();
+}
+
+void MC_(heap_profile_free) ( MC_Chunk* mc )
+{
+   HP_Site* site = get_site(mc->where[0]);
+
+   maybe_take_peak_snapshot();
+
+   tl_assert(site->szB >= mc->szB);
+   site->szB   -= mc->szB;
+   hp_heap_szB -= mc->szB;
+   hp_time     += mc->szB;
+   maybe_take_snapshot();
+}
+
+void MC_(heap_profile_init) ( void )
+{
+   hp_sites = VG_(HT_construct)("mc.hp.hpi.1");
+   add_snapshot(/*detailed*/False);
+}
+
+
+/*------------------------------------------------------------*/
+/*--- Writing the profile                                  ---*/
+/*------------------------------------------------------------*/
+
+/* The allocation functions removed from the top of the allocation
+   stacks, as massif does by default. */
+static const HChar* hp_alloc_fns[] = {
+   "malloc",
+   "__builtin_new",
+   "operator new(unsigned)",
+   "operator new(unsigned long)",
+   "__builtin_vec_new",
+   "operator new[](unsigned)",
+   "operator new[](unsigned long)",
+   "calloc",
+   "realloc",
+   "memalign",
+   "posix_memalign",
+   "valloc",
+   "operator new(unsigned, std::nothrow_t const&)",
+   "operator new[](unsigned, std::nothrow_t const&)",
+   "operator new(unsigned long, std::nothrow_t const&)",
+   "operator new[](unsigned long, std::nothrow_t const&)",
+#  if defined(VGO_darwin)
+   "malloc_zone_malloc",
+   "malloc_zone_calloc",
+   "malloc_zone_realloc",
+   "malloc_zone_memalign",
+   "malloc_zone_valloc",
+#  endif
+};
+
+static Bool is_alloc_fn ( Addr ip )
+{
+   static HChar buf[HP_BUF_LEN];
+   UInt i;
+
+   if (!VG_(get_fnname)(ip, buf, HP_BUF_LEN))
+      return False;
+   for (i = 0; i < sizeof(hp_alloc_fns) / sizeof(hp_alloc_fns[0]); i++) {
+      if (VG_(strcmp)(buf, hp_alloc_fns[i]) == 0)
+         return True;
+   }
+   return False;
+}
+
+/* A node of the heap tree of a detailed snapshot: the bytes allocated
+   from code location 'ip', by way of its parent's code location. */
+typedef
+   struct _HP_Node {
+      Addr              ip;
+      SizeT             szB;
+      UInt              n_children;
+      UInt              max_children;
+      struct _HP_Node** children;
+   }
+   HP_Node;
+
+static HP_Node* new_node ( Addr ip )
+{
+   HP_Node* node = VG_(malloc)("mc.hp.nn.1", sizeof(HP_Node));
+   node->ip           = ip;
+   node->szB          = 0;
+   node->n_children   = 0;
+   node->max_children = 0;
+   node->children     = NULL;
+   return node;
+}
+
+static void free_node ( HP_Node* node )
+{
+   UInt i;
+   for (i = 0; i < node->n_children; i++)
+      free_node(node->children[i]);
+   if (node->children)
+      VG_(free)(node->children);
+   VG_(free)(node);
+}
+
+static HP_Node* get_child ( HP_Node* node, Addr ip )
+{
+   UInt i;
+   for (i = 0; i < node->n_children; i++) {
+      if (node->children[i]->ip == ip)
+         return node->children[i];
+   }
+   if (node->n_children == node->max_children) {
+      node->max_children = node->max_children ? 2 * node->max_children : 4;
+      node->children = VG_(realloc)("mc.hp.gc.1", node->children,
+                                    node->max_children * sizeof(HP_Node*));
+   }
+   node->children[node->n_children] = new_node(ip);
+   return node->children[node->n_children++];
+}
+
+static HP_Node* build_tree ( HP_Snapshot* snapshot )
+{
+   HP_Node* root = new_node(0);
+   UInt     i;
+   Int      j, first, n_ips;
+
+   for (i = 0; i < snapshot->n_sites; i++) {
+      ExeContext* ec   = snapshot->sites[i].ec;
+      Addr*       ips  = VG_(get_ExeContext_StackTrace)(ec);
+      HP_Node*    node = root;
+
+      n_ips = VG_(get_ExeContext_n_ips)(ec);
+      for (first = 0; first < n_ips && is_alloc_fn(ips[first]); first++)
+         ;
+      if (n_ips - first > HP_DEPTH)
+         n_ips = first + HP_DEPTH;
+
+      root->szB += snapshot->sites[i].szB;
+      for (j = first; j < n_ips; j++) {
+         node = get_child(node, ips[j]);
+         node->szB += snapshot->sites[i].szB;
+      }
+   }
+   return root;
+}
+
+static Int node_revcmp_szB ( const void* n1, const void* n2 )
+{
+   const HP_Node* a = *(const HP_Node* const*)n1;
+   const HP_Node* b = *(const HP_Node* const*)n2;
+   return ( a->szB < b->szB ?  1
+          : a->szB > b->szB ? -1
+          :                    0);
+}
+
+static void hp_printf ( Int fd, const HChar* format, ... )
+{
+   static HChar buf[HP_BUF_LEN];
+   va_list vargs;
+   va_start(vargs, format);
+   VG_(vsnprintf)(buf, HP_BUF_LEN, format, vargs);
+   va_end(vargs);
+   VG_(write)(fd, buf, VG_(strlen)(buf));
+}
+
+static const HChar* indent ( Int depth )
+{
+   static HChar buf[HP_DEPTH + 2];
+   tl_assert(depth < sizeof(buf));
+   VG_(memset)(buf, ' ', depth);
+   buf[depth] = '\0';
+   return buf;
+}
+
+static void pp_node ( Int fd, HP_Node* node, Int depth, SizeT heap_szB )
+{
+   static HChar ip_desc[HP_BUF_LEN];
+   SizeT insig_szB = 0;
+   UInt  i, n_sig = 0, n_insig = 0;
+
+   VG_(ssort)(node->children, node->n_children, sizeof(HP_Node*),
+              node_revcmp_szB);
+   for (i = 0; i < node->n_children; i++) {
+      if (node->children[i]->szB * 100 >= heap_szB * HP_THRESHOLD) {
+         n_sig++;
+      } else {
+         n_insig++;
+         insig_szB += node->children[i]->szB;
+      }
+   }
+
+   if (depth > 0 && !VG_(clo_show_below_main)) {
+      Vg_FnNameKind kind = VG_(get_fnname_kind_from_IP)(node->ip);
+      if (Vg_FnNameMain == kind || Vg_FnNameBelowMain == kind)
+         n_sig = n_insig = 0;
+   }
+
+   hp_printf(fd, "%sn%u: %lu ", indent(depth), n_sig + (n_insig > 0 ? 1 : 0),
+             node->szB);
+   if (depth == 0)
+      hp_printf(fd, "(heap allocation functions) malloc/new/new[], "
+                    "--alloc-fns, etc.\n");
+   else
+      hp_printf(fd, "%s\n",
+                VG_(describe_IP)(node->ip - 1, ip_desc, HP_BUF_LEN, NULL));
+
+   for (i = 0; i < n_sig; i++)
+      pp_node(fd, node->children[i], depth + 1, heap_szB);
+   if (n_insig > 0)
+      hp_printf(fd, "%sn0: %lu in %u place%s below massif's threshold "
+                    "(%d.00%%)\n", indent(depth + 1), insig_szB, n_insig,
+                    n_insig == 1 ? "," : "s, all", HP_THRESHOLD);
+}
+
+static void pp_snapshot ( Int fd, HP_Snapshot* snapshot, Int snapshot_n )
+{
+   hp_printf(fd, "#-----------\n");
+   hp_printf(fd, "snapshot=%d\n", snapshot_n);
+   hp_printf(fd, "#-----------\n");
+   hp_printf(fd, "time=%llu\n", snapshot->time);
+   hp_printf(fd, "mem_heap_B=%lu\n", snapshot->heap_szB);
+   hp_printf(fd, "mem_heap_extra_B=0\n");
+   hp_printf(fd, "mem_stacks_B=0\n");
+
+   if (snapshot->sites) {
+      HP_Node* root = build_tree(snapshot);
+      hp_printf(fd, "heap_tree=%s\n", snapshot->is_peak ? "peak" : "detailed");
+      pp_node(fd, root, 0, snapshot->heap_szB);
+      free_node(root);
+   } else {
+      hp_printf(fd, "heap_tree=empty\n");
+   }
+}
+
+static void write_profile ( void )
+{
+   HChar* out_file = VG_(expand_file_name)("--heap-profile-out-file",
+                                           MC_(clo_heap_profile_out_file));
+   SysRes sres     = VG_(open)(out_file, VKI_O_CREAT|VKI_O_TRUNC|VKI_O_WRONLY,
+                                         VKI_S_IRUSR|VKI_S_IWUSR);
+   Int    fd, i, n = 0;
+   Bool   peak_done = !hp_have_peak;
+
+   if (sr_isError(sres)) {
+      VG_(umsg)("error: can't open heap profile file '%s'\n", out_file);
+      VG_(umsg)("       ... so the heap profile will be missing.\n");
+      VG_(free)(out_file);
+      return;
+   }
+   fd = sr_Res(sres);
+   VG_(free)(out_file);
+
+   hp_printf(fd, "desc: --tool=memcheck --heap-profile=yes\n");
+   hp_printf(fd, "cmd: %s", VG_(args_the_exename));
+   for (i = 0; i < VG_(sizeXA)( VG_(args_for_client) ); i++) {
+      HChar* arg = * (HChar**) VG_(indexXA)( VG_(args_for_client), i );
+      if (arg)
+         hp_printf(fd, " %s", arg);
+   }
+   hp_printf(fd, "\n");
+   hp_printf(fd, "time_unit: B\n");
+
+   for (i = 0; i < hp_n_snapshots; i++) {
+      if (!peak_done && hp_peak.time < hp_snapshots[i].time) {
+         pp_snapshot(fd, &hp_peak, n++);
+         peak_done = True;
+      }
+      pp_snapshot(fd, &hp_snapshots[i], n++);
+   }
+   if (!peak_done)
+      pp_snapshot(fd, &hp_peak, n++);
+
+   VG_(close)(fd);
+}
+
+void MC_(heap_profile_fini) ( void )
+{
+   maybe_take_peak_snapshot();
+   add_snapshot(/*detailed*/True);
+   write_profile();
+}
+
+/*--------------------------------------------------------------------*/
+/*--- end                                            mc_heapprof.c ---*/
+/*--------------------------------------------------------------------*/
@@ -93,7 +93,8 @@ typedef
       Addr          pool;           // pool identifier
       SizeT         rzB;            // pool red-zone size
       Bool          is_zeroed;      // allocations from this pool are zeroed
-      VgHashTable   chunks;         // chunks associated with this pool
+      VgHashTable2  chunks;         // chunks associated with this pool
+      UInt          n_ops;          // trims/changes since last full check
    }
    MC_Mempool;
 
@@ -101,7 +102,7 @@ typedef
 void* MC_(new_block)  ( ThreadId tid,
                         Addr p, SizeT size, SizeT align,
                         Bool is_zeroed, MC_AllocKind kind,
-                        VgHashTable table);
+                        VgHashTable2 table);
 void MC_(handle_free) ( ThreadId tid,
                         Addr p, UInt rzB, MC_AllocKind kind );
 
@@ -124,10 +125,11 @@ MC_Chunk* MC_(get_freed_block_bracketting)( Addr a );
 extern PoolAlloc* MC_(chunk_poolalloc);
 
 /* For tracking malloc'd blocks.  Nb: it's quite important that it's a
-   VgHashTable, because VgHashTable allows duplicate keys without complaint.
+   VgHashTable2, because VgHashTable2 allows duplicate keys without complaint.
    This can occur if a user marks a malloc() block as also a custom block with
-   MALLOCLIKE_BLOCK. */
-extern VgHashTable MC_(malloc_list);
+   MALLOCLIKE_BLOCK.  It is looked up on every free, hence the open-addressing
+   table rather than a VgHashTable. */
+extern VgHashTable2 MC_(malloc_list);
 
 /* For tracking memory pools. */
 extern VgHashTable MC_(mempool_list);
@@ -157,6 +159,12 @@ SizeT MC_(malloc_usable_size)   ( ThreadId tid, void* p );
 void MC_(handle_resizeInPlace)(ThreadId tid, Addr p,
                                SizeT oldSizeB, SizeT newSizeB, SizeT rzB);
 
+/* Functions defined in mc_heapprof.c, used with --heap-profile=yes */
+void MC_(heap_profile_init)  ( void );
+void MC_(heap_profile_alloc) ( MC_Chunk* mc );
+void MC_(heap_profile_free)  ( MC_Chunk* mc );
+void MC_(heap_profile_fini)  ( void );
+
 
 /*------------------------------------------------------------*/
 /*--- Origin tracking translate-time support               ---*/
@@ -166,6 +174,9 @@ void MC_(handle_resizeInPlace)(ThreadId tid, Addr p,
 Int MC_(get_otrack_shadow_offset) ( Int offset, Int szB );
 IRType MC_(get_otrack_reg_array_equiv_int_type) ( IRRegArray* arr );
 
+/* Make all of a thread's registers defined, with no origin. */
+void MC_(make_regs_defined) ( ThreadId tid );
+
 /* Constants which are used as the lowest 2 bits in origin tags.
    
    An origin tag comprises an upper 30-bit ECU field and a lower 2-bit
@@ -366,6 +377,11 @@ Bool MC_(print_block_list) ( UInt loss_record_nr);
 // the given range [address, address+szB[ is found.
 void MC_(who_points_at) ( Addr address, SizeT szB);
 
+// Leaves [start, start+len[ out of the root set of leak searches, or puts
+// it back if !ignore.  For VALGRIND_LEAK_CHECK_IGNORE_RANGE and when
+// memory is unmapped.
+void MC_(leak_check_ignore_range) ( Addr start, SizeT len, Bool ignore );
+
 // if delta_mode == LCD_Any, prints in buf an empty string
 // otherwise prints a delta in the layout  " (+%'lu)" or " (-%'lu)" 
 extern HChar * MC_(snprintf_delta) (HChar * buf, Int size, 
@@ -376,6 +392,26 @@ extern HChar * MC_(snprintf_delta) (HChar * buf, Int size,
 Bool MC_(is_valid_aligned_word)     ( Addr a );
 Bool MC_(is_within_valid_secondary) ( Addr a );
 
+// Versions of the above which don't update memcheck's own lookup caches,
+// and so can be used from several leak check workers at once.  Each
+// worker passes its own MC_SecMapCache, which remembers the last
+// secondary map found above the primary map.
+typedef
+   struct {
+      Addr        base;
+      const void* sm;
+   }
+   MC_SecMapCache;
+
+void MC_(init_SecMapCache)             ( MC_SecMapCache* c );
+Bool MC_(is_valid_aligned_word_MT)     ( Addr a, MC_SecMapCache* c );
+Bool MC_(is_within_valid_secondary_MT) ( Addr a, MC_SecMapCache* c );
+
+/* For --incremental-leak-check.  Has the SecMap-sized granule holding a
+   been written since it was last cleaned? */
+Bool MC_(is_lc_granule_dirty) ( Addr a );
+void MC_(clean_lc_granule)    ( Addr a );
+
 // Prints as user msg a description of the given loss record.
 void MC_(pp_LossRecord)(UInt n_this_record, UInt n_total_records,
                         LossRecord* l);
@@ -418,6 +454,13 @@ void MC_(record_address_error) ( ThreadId tid, Addr a, Int szB,
                                  Bool isWrite );
 void MC_(record_cond_error)    ( ThreadId tid, UInt otag );
 void MC_(record_value_error)   ( ThreadId tid, Int szB, UInt otag );
+
+/* For --adaptive-definedness-checks=yes; see mc_errors.c.  Is 'a' an
+   instruction at which a definedness error was held back, and is it
+   still waiting to be rechecked? */
+Bool MC_(is_adaptive_site)     ( Addr a, /*OUT*/Bool* pending );
+void MC_(flush_adaptive_sites) ( void );
+void MC_(print_adaptive_stats) ( void );
 void MC_(record_jump_error)    ( ThreadId tid, Addr a );
 
 void MC_(record_free_error)            ( ThreadId tid, Addr a ); 
@@ -493,6 +536,14 @@ extern LeakCheckMode MC_(clo_leak_check);
 /* How closely should we compare ExeContexts in leak records? default: 2 */
 extern VgRes MC_(clo_leak_resolution);
 
+/* How many threads mark the blocks reachable from the root set during
+   a leak search?  default: 1 */
+extern Int MC_(clo_leak_check_threads);
+
+/* Should a leak search reuse what the last one found in memory that has
+   not been written since?  default: NO */
+extern Bool MC_(clo_incremental_leak_check);
+
 /* In leak check, show loss records if their R2S(reachedness) is set.
    Default : R2S(Possible) | R2S(Unreached). */
 extern UInt MC_(clo_show_leak_kinds);
@@ -588,9 +639,36 @@ extern KeepStacktraces MC_(clo_keep_stacktraces);
 */
 extern Int MC_(clo_mc_level);
 
+/* When MC_(clo_mc_level) >= 2, the percentage of superblocks in which
+   undefined values are tracked and checked.  The others are
+   instrumented as for MC_(clo_mc_level) == 1, except that what they
+   write to registers and memory is marked as defined.  Default: 100 */
+extern Int MC_(clo_definedness_sampling);
+
+/* When MC_(clo_mc_level) >= 2, start with the cheap interpretation of
+   Add, Sub and CmpEQ/NE everywhere, and switch a superblock to the
+   expensive one when it gives an undefined value error, holding the
+   error back until it has been rechecked.  Default: NO */
+extern Bool MC_(clo_adaptive_definedness_checks);
+
 /* Should we show mismatched frees?  Default: YES */
 extern Bool MC_(clo_show_mismatched_frees);
 
+/* Should SecMaps which have become uniform again be swapped back for
+   distinguished ones?  Default: YES */
+extern Bool MC_(clo_collapse_secmaps);
+
+/* Should the common cases of shadow loads and stores be done in the
+   generated code, rather than by calling a helper?  Default: NO */
+extern Bool MC_(clo_inline_shadow_access);
+
+/* Should the live heap bytes per allocation stack be written in
+   massif's format?  Default: NO */
+extern Bool MC_(clo_heap_profile);
+
+/* The file the heap profile is written to.  Default: massif.out.%p */
+extern const HChar* MC_(clo_heap_profile_out_file);
+
 
 /*------------------------------------------------------------*/
 /*--- Instrumentation                                      ---*/
@@ -616,6 +694,9 @@ VG_REGPARM(0) void MC_(helperc_value_check4_fail_no_o) ( void );
 VG_REGPARM(0) void MC_(helperc_value_check1_fail_no_o) ( void );
 VG_REGPARM(0) void MC_(helperc_value_check0_fail_no_o) ( void );
 
+/* For --adaptive-definedness-checks=yes */
+VG_REGPARM(1) void MC_(helperc_adaptive_recheck) ( UWord );
+
 /* V-bits load/store helpers */
 VG_REGPARM(1) void MC_(helperc_STOREV64be) ( Addr, ULong );
 VG_REGPARM(1) void MC_(helperc_STOREV64le) ( Addr, ULong );
@@ -624,6 +705,13 @@ VG_REGPARM(2) void MC_(helperc_STOREV32le) ( Addr, UWord );
 VG_REGPARM(2) void MC_(helperc_STOREV16be) ( Addr, UWord );
 VG_REGPARM(2) void MC_(helperc_STOREV16le) ( Addr, UWord );
 VG_REGPARM(2) void MC_(helperc_STOREV8)    ( Addr, UWord );
+VG_REGPARM(1) void MC_(helperc_STOREV64be_defined) ( Addr );
+VG_REGPARM(1) void MC_(helperc_STOREV64le_defined) ( Addr );
+VG_REGPARM(1) void MC_(helperc_STOREV32be_defined) ( Addr );
+VG_REGPARM(1) void MC_(helperc_STOREV32le_defined) ( Addr );
+VG_REGPARM(1) void MC_(helperc_STOREV16be_defined) ( Addr );
+VG_REGPARM(1) void MC_(helperc_STOREV16le_defined) ( Addr );
+VG_REGPARM(1) void MC_(helperc_STOREV8_defined)    ( Addr );
 
 VG_REGPARM(2) void  MC_(helperc_LOADV256be) ( /*OUT*/V256*, Addr );
 VG_REGPARM(2) void  MC_(helperc_LOADV256le) ( /*OUT*/V256*, Addr );
@@ -637,9 +725,28 @@ VG_REGPARM(1) UWord MC_(helperc_LOADV16be)  ( Addr );
 VG_REGPARM(1) UWord MC_(helperc_LOADV16le)  ( Addr );
 VG_REGPARM(1) UWord MC_(helperc_LOADV8)     ( Addr );
 
+/* Where the primary map is, and the highest address it covers, for
+   the inline LOADV/STOREV fast paths made by mc_translate.c. */
+Addr MC_(primary_map_base)     ( void );
+Addr MC_(max_primary_address)  ( void );
+
 void MC_(helperc_MAKE_STACK_UNINIT) ( Addr base, UWord len,
                                                  Addr nia );
 
+/* MC_(helperc_b_store_batch) does up to MC_B_BATCH_MAX origin stores
+   of 1, 2, 4 or 8 bytes at signed 8-bit offsets from 'base'.  Bits
+   1:0 of 'layout' are the number of stores less one, and store i is
+   described by the 10 bits from bit 2+10*i: the log2 of its size in
+   bits 1:0 and the offset in bits 9:2.  On 64-bit hosts the otags for
+   stores 0 and 1 are the low and high halves of 'd01', and those for
+   2 and 3 likewise of 'd23'; on 32-bit hosts 'd01' and 'd23' are the
+   otags for stores 0 and 1. */
+#if VG_WORDSIZE == 8
+#  define MC_B_BATCH_MAX 4
+#else
+#  define MC_B_BATCH_MAX 2
+#endif
+
 /* Origin tag load/store helpers */
 VG_REGPARM(2) void  MC_(helperc_b_store1) ( Addr a, UWord d32 );
 VG_REGPARM(2) void  MC_(helperc_b_store2) ( Addr a, UWord d32 );
@@ -647,6 +754,8 @@ VG_REGPARM(2) void  MC_(helperc_b_store4) ( Addr a, UWord d32 );
 VG_REGPARM(2) void  MC_(helperc_b_store8) ( Addr a, UWord d32 );
 VG_REGPARM(2) void  MC_(helperc_b_store16)( Addr a, UWord d32 );
 VG_REGPARM(2) void  MC_(helperc_b_store32)( Addr a, UWord d32 );
+VG_REGPARM(2) void  MC_(helperc_b_store_batch) ( Addr base, UWord layout,
+                                                 UWord d01, UWord d23 );
 VG_REGPARM(1) UWord MC_(helperc_b_load1) ( Addr a );
 VG_REGPARM(1) UWord MC_(helperc_b_load2) ( Addr a );
 VG_REGPARM(1) UWord MC_(helperc_b_load4) ( Addr a );
@@ -662,8 +771,19 @@ IRSB* MC_(instrument) ( VgCallbackClosure* closure,
                         VexArchInfo* archinfo_host,
                         IRType gWordTy, IRType hWordTy );
 
+IRSB* MC_(instrument_skipped) ( VgCallbackClosure* closure,
+                                IRSB* bb_in,
+                                VexGuestLayout* layout,
+                                VexGuestExtents* vge,
+                                VexArchInfo* archinfo_host,
+                                IRType gWordTy, IRType hWordTy );
+
 IRSB* MC_(final_tidy) ( IRSB* );
 
+/* Value checks seen and removed by MC_(final_tidy), for --stats=yes. */
+extern ULong MC_(n_value_checks);
+extern ULong MC_(n_value_checks_removed);
+
 #endif /* ndef __MC_INCLUDE_H */
 
 /*--------------------------------------------------------------------*/
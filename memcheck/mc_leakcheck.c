@@ -34,18 +34,22 @@
 #include "pub_tool_aspacemgr.h"
 #include "pub_tool_execontext.h"
 #include "pub_tool_hashtable.h"
+#include "pub_tool_hashtable2.h"
 #include "pub_tool_libcbase.h"
 #include "pub_tool_libcassert.h"
 #include "pub_tool_libcprint.h"
+#include "pub_tool_libcproc.h"      // VG_(run_workers)
 #include "pub_tool_libcsignal.h"
 #include "pub_tool_machine.h"
 #include "pub_tool_mallocfree.h"
 #include "pub_tool_options.h"
 #include "pub_tool_oset.h"
-#include "pub_tool_poolalloc.h"     
+#include "pub_tool_poolalloc.h"     // Region
+#include "pub_tool_rangemap.h"
 #include "pub_tool_signals.h"       // Needed for mc_include.h
 #include "pub_tool_libcsetjmp.h"    // setjmp facilities
 #include "pub_tool_tooliface.h"     // Needed for mc_include.h
+#include "pub_tool_xarray.h"
 
 #include "mc_include.h"
 
@@ -342,7 +346,7 @@ find_active_chunks(Int* pn_chunks)
    // First we collect all the malloc chunks into an array and sort it.
    // We do this because we want to query the chunks by interior
    // pointers, requiring binary search.
-   mallocs = (MC_Chunk**) VG_(HT_to_array)( MC_(malloc_list), &n_mallocs );
+   mallocs = (MC_Chunk**) VG_(HT2_to_array)( MC_(malloc_list), &n_mallocs );
    if (n_mallocs == 0) {
       tl_assert(mallocs == NULL);
       *pn_chunks = 0;
@@ -361,8 +365,8 @@ find_active_chunks(Int* pn_chunks)
    // malloc chunk containing the mempool chunk.
    VG_(HT_ResetIter)(MC_(mempool_list));
    while ( (mp = VG_(HT_Next)(MC_(mempool_list))) ) {
-      VG_(HT_ResetIter)(mp->chunks);
-      while ( (mc = VG_(HT_Next)(mp->chunks)) ) {
+      VG_(HT2_ResetIter)(mp->chunks);
+      while ( (mc = VG_(HT2_Next)(mp->chunks)) ) {
 
          // We'll need to record this chunk.
          n_chunks++;
@@ -396,8 +400,8 @@ find_active_chunks(Int* pn_chunks)
    // combined array of chunks.
    VG_(HT_ResetIter)(MC_(mempool_list));
    while ( (mp = VG_(HT_Next)(MC_(mempool_list))) ) {
-      VG_(HT_ResetIter)(mp->chunks);
-      while ( (mc = VG_(HT_Next)(mp->chunks)) ) {
+      VG_(HT2_ResetIter)(mp->chunks);
+      while ( (mc = VG_(HT2_Next)(mp->chunks)) ) {
          tl_assert(s < n_chunks);
          chunks[s++] = mc;
       }
@@ -459,12 +463,94 @@ static SizeT lc_chunks_n_frees_marker;
 // lc_extras[i] describe the same block).
 static LC_Extra* lc_extras;
 
+// A bitmap with a bit for each hash of a page number, built along with
+// lc_chunks.  The bits of the pages holding any part of a chunk are set,
+// so a word whose page has a clear bit can't point to a chunk, and is
+// rejected without a search of lc_chunks.  Most words that are not
+// pointers to the heap get rejected this way.
+static UChar*    lc_page_filter;
+static UWord     lc_page_filter_mask;   // number of bits - 1
+
+static __inline__ UWord lc_page_filter_bit(Addr a)
+{
+   UWord page = a >> VKI_PAGE_SHIFT;
+   return (page ^ (page >> 21)) & lc_page_filter_mask;
+}
+
+static __inline__ Bool lc_page_filter_maybe_chunk(Addr a)
+{
+   UWord b;
+   if (UNLIKELY(lc_page_filter == NULL))
+      return False;   // no leak search done, or no chunks
+   b = lc_page_filter_bit(a);
+   return (lc_page_filter[b >> 3] >> (b & 7)) & 1;
+}
+
+static void lc_free_page_filter(void)
+{
+   if (lc_page_filter) {
+      VG_(free)(lc_page_filter);
+      lc_page_filter = NULL;
+   }
+}
+
+// Build lc_page_filter from the sorted and checked lc_chunks.
+static void lc_build_page_filter(void)
+{
+   Int   i;
+   UWord n_pages = 0, n_bits;
+
+   for (i = 0; i < lc_n_chunks; i++) {
+      MC_Chunk* ch = lc_chunks[i];
+      Addr last = ch->data + (ch->szB == 0 ? 0 : ch->szB - 1);
+      n_pages += (last >> VKI_PAGE_SHIFT) - (ch->data >> VKI_PAGE_SHIFT) + 1;
+   }
+   // About 8 bits per page, to keep collisions rare, but small enough
+   // to stay in the cache for ordinary heaps.
+   n_bits = 1 << 12;
+   while (n_bits < 8 * n_pages && n_bits < (1 << 26))
+      n_bits <<= 1;
+
+   lc_free_page_filter();
+   lc_page_filter      = VG_(calloc)("mc.lbpf.1", n_bits / 8, 1);
+   lc_page_filter_mask = n_bits - 1;
+
+   for (i = 0; i < lc_n_chunks; i++) {
+      MC_Chunk* ch = lc_chunks[i];
+      Addr last = ch->data + (ch->szB == 0 ? 0 : ch->szB - 1);
+      Addr a;
+      if ((last >> VKI_PAGE_SHIFT) - (ch->data >> VKI_PAGE_SHIFT) >= n_bits) {
+         // A chunk this big sets every bit anyway.
+         VG_(memset)(lc_page_filter, 0xFF, n_bits / 8);
+         break;
+      }
+      for (a = VG_PGROUNDDN(ch->data); a <= last; a += VKI_PAGE_SIZE) {
+         UWord b = lc_page_filter_bit(a);
+         lc_page_filter[b >> 3] |= 1 << (b & 7);
+         if (a + VKI_PAGE_SIZE < a)
+            break;   // top of memory
+      }
+   }
+}
+
 // chunks will be converted and merged in loss record, maintained in lr_table
 // lr_table elements are kept from one leak_search to another to implement
 // the "print new/changed leaks" client request
 static OSet*        lr_table;
 // Array of sorted loss record (produced during last leak search).
 static LossRecord** lr_array;
+// When only the biggest loss records are output, only lr_array[from ..]
+// is sorted (and everything before lr_array_sorted_from is no bigger).
+// MC_(print_block_list) sorts the rest when it needs the numbering.
+static Int          lr_array_sorted_from;
+
+// Hash index of the loss records in lr_table, so that merging a chunk
+// into its loss record doesn't have to compare stack traces all the way
+// down a tree.  Open addressing with linear probing; lr_index_size is a
+// power of 2 and the table is kept at most half full.
+static LossRecord** lr_index;
+static UWord        lr_index_size;
+static UWord        lr_index_used;
 
 // Value of the heuristics parameter used in the current (or last) leak check.
 static UInt detect_memory_leaks_last_heuristics;
@@ -495,6 +581,9 @@ static SizeT lc_scanned_szB;
 // Keeps track of how many bytes we have not scanned due to read errors that
 // caused a signal such as SIGSEGV.
 static SizeT lc_sig_skipped_szB;
+// Keeps track of how many bytes of the root set we have not scanned because
+// the client asked us not to.
+static SizeT lc_ignored_szB;
 
 
 SizeT MC_(bytes_leaked)     = 0;
@@ -525,11 +614,14 @@ lc_is_a_chunk_ptr(Addr ptr, Int* pch_no, MC_Chunk** pch, LC_Extra** pex)
    MC_Chunk* ch;
    LC_Extra* ex;
 
-   // Quick filter. Note: implemented with am, not with get_vabits2
+   // Quick filters.  The page filter rejects most words without touching
+   // lc_chunks.  The second is implemented with am, not with get_vabits2
    // as ptr might be random data pointing anywhere. On 64 bit
    // platforms, getting va bits for random data can be quite costly
    // due to the secondary map.
-   if (!VG_(am_is_valid_for_client)(ptr, 1, VKI_PROT_READ)) {
+   if (!lc_page_filter_maybe_chunk(ptr)) {
+      return False;
+   } else if (!VG_(am_is_valid_for_client)(ptr, 1, VKI_PROT_READ)) {
       return False;
    } else {
       ch_no = find_chunk_for(ptr, lc_chunks, lc_n_chunks);
@@ -673,14 +765,22 @@ static Bool aligned_ptr_above_page0_is_vtable_addr(Addr ptr)
    return False;
 }
 
+// Like MC_(is_valid_aligned_word), but safe to call from a leak check
+// worker when smc is not NULL.
+static Bool lc_is_valid_aligned_word ( Addr a, MC_SecMapCache* smc )
+{
+   return smc ? MC_(is_valid_aligned_word_MT)(a, smc)
+              : MC_(is_valid_aligned_word)(a);
+}
+
 // true if a is properly aligned and points to 64bits of valid memory
-static Bool is_valid_aligned_ULong ( Addr a )
+static Bool is_valid_aligned_ULong ( Addr a, MC_SecMapCache* smc )
 {
    if (sizeof(Word) == 8)
-      return MC_(is_valid_aligned_word)(a);
+      return lc_is_valid_aligned_word(a, smc);
 
-   return MC_(is_valid_aligned_word)(a)
-      && MC_(is_valid_aligned_word)(a + 4);
+   return lc_is_valid_aligned_word(a, smc)
+      && lc_is_valid_aligned_word(a + 4, smc);
 }
 
 // If ch is heuristically reachable via an heuristic member of heur_set,
@@ -692,9 +792,11 @@ static Bool is_valid_aligned_ULong ( Addr a )
 // inspired from DrMemory:
 //  see http://www.burningcutlery.com/derek/docs/drmem-CGO11.pdf [section VI,C]
 //  and bug 280271.
+// smc is NULL, or the cache to use for lc_is_valid_aligned_word.
 static LeakCheckHeuristic heuristic_reachedness (Addr ptr,
                                                  MC_Chunk *ch, LC_Extra *ex,
-                                                 UInt heur_set)
+                                                 UInt heur_set,
+                                                 MC_SecMapCache* smc)
 {
    if (HiS(LchStdString, heur_set)) {
       // Detects inner pointers to Std::String for layout being
@@ -704,10 +806,10 @@ static LeakCheckHeuristic heuristic_reachedness (Addr ptr,
       // not for refcount, as refcount size might be smaller than
       // a SizeT, giving a uninitialised hole in the first 3 SizeT.
       if ( ptr == ch->data + 3 * sizeof(SizeT)
-           && MC_(is_valid_aligned_word)(ch->data + sizeof(SizeT))) {
+           && lc_is_valid_aligned_word(ch->data + sizeof(SizeT), smc)) {
          const SizeT capacity = *((SizeT*)(ch->data + sizeof(SizeT)));
          if (3 * sizeof(SizeT) + capacity + 1 == ch->szB
-            && MC_(is_valid_aligned_word)(ch->data)) {
+            && lc_is_valid_aligned_word(ch->data, smc)) {
             const SizeT length = *((SizeT*)ch->data);
             if (length <= capacity) {
                // ??? could check there is no null byte from ptr to ptr+length-1
@@ -732,7 +834,7 @@ static LeakCheckHeuristic heuristic_reachedness (Addr ptr,
       // Note that on 64bit platforms, a block matching LchLength64 will
       // also be matched by LchNewArray.
       if ( ptr == ch->data + sizeof(ULong)
-          && is_valid_aligned_ULong(ch->data)) {
+          && is_valid_aligned_ULong(ch->data, smc)) {
          const ULong size = *((ULong*)ch->data);
          if (size > 0 && (ch->szB - sizeof(ULong)) == size) {
             return LchLength64;
@@ -757,7 +859,7 @@ static LeakCheckHeuristic heuristic_reachedness (Addr ptr,
       // because a chunk "word-sized" is allocated to store the (0) nr
       // of elements.
       if ( ptr == ch->data + sizeof(SizeT)
-           && MC_(is_valid_aligned_word)(ch->data)) {
+           && lc_is_valid_aligned_word(ch->data, smc)) {
          const SizeT nr_elts = *((SizeT*)ch->data);
          if (nr_elts > 0 && (ch->szB - sizeof(SizeT)) % nr_elts == 0) {
             // ??? could check that ch->allockind is MC_AllocNewVec ???
@@ -770,7 +872,7 @@ static LeakCheckHeuristic heuristic_reachedness (Addr ptr,
       // Detect inner pointer used for multiple inheritance.
       // Assumption is that the vtable pointers are before the object.
       if (VG_IS_WORD_ALIGNED(ptr)
-          && MC_(is_valid_aligned_word)(ptr)) {
+          && lc_is_valid_aligned_word(ptr, smc)) {
          Addr first_addr;
          Addr inner_addr;
 
@@ -785,7 +887,7 @@ static LeakCheckHeuristic heuristic_reachedness (Addr ptr,
          inner_addr = *((Addr*)ptr);
          if (VG_IS_WORD_ALIGNED(inner_addr) 
              && inner_addr >= (Addr)VKI_PAGE_SIZE
-             && MC_(is_valid_aligned_word)(ch->data)) {
+             && lc_is_valid_aligned_word(ch->data, smc)) {
             first_addr = *((Addr*)ch->data);
             if (VG_IS_WORD_ALIGNED(first_addr)
                 && first_addr >= (Addr)VKI_PAGE_SIZE
@@ -833,7 +935,8 @@ lc_push_without_clique_if_a_chunk_ptr(Addr ptr, Bool is_prior_definite)
    else if (detect_memory_leaks_last_heuristics) {
       ex->heuristic 
          = heuristic_reachedness (ptr, ch, ex,
-                                  detect_memory_leaks_last_heuristics);
+                                  detect_memory_leaks_last_heuristics,
+                                  NULL);
       if (ex->heuristic)
          ch_via_ptr = Reachable;
       else
@@ -967,10 +1070,14 @@ void scan_all_valid_memory_catcher ( Int sigNo, Addr addr )
 // In such a case, lc_scan_memory just scans [start..start+len[ for pointers
 // to searched and outputs the places where searched is found.
 // It does not recursively scans the found memory.
+//
+// With --incremental-leak-check=yes, lc_scan_memory_direct is only used
+// in search ptr mode and for those parts of the memory not handled by
+// lc_scan_memory_incr, see below.
 static void
-lc_scan_memory(Addr start, SizeT len, Bool is_prior_definite,
-               Int clique, Int cur_clique,
-               Addr searched, SizeT szB)
+lc_scan_memory_direct(Addr start, SizeT len, Bool is_prior_definite,
+                      Int clique, Int cur_clique,
+                      Addr searched, SizeT szB)
 {
    /* memory scan is based on the assumption that valid pointers are aligned
       on a multiple of sizeof(Addr). So, we can (and must) skip the begin and
@@ -1087,7 +1194,8 @@ lc_scan_memory(Addr start, SizeT len, Bool is_prior_definite,
                   if (lc_is_a_chunk_ptr(addr, &ch_no, &ch, &ex) ) {
                      Int h;
                      for (h = LchStdString; h < N_LEAK_CHECK_HEURISTICS; h++) {
-                        if (heuristic_reachedness(addr, ch, ex, H2S(h)) == h) {
+                        if (heuristic_reachedness(addr, ch, ex, H2S(h),
+                                                  NULL) == h) {
                            VG_(umsg)("block at %#lx considered reachable "
                                      "by ptr %#lx using %s heuristic\n",
                                      ch->data, addr, pp_heuristic(h));
@@ -1115,6 +1223,282 @@ lc_scan_memory(Addr start, SizeT len, Bool is_prior_definite,
 }
 
 
+/*------------------------------------------------------------*/
+/*--- Incremental leak checking.                           ---*/
+/*------------------------------------------------------------*/
+
+// With --incremental-leak-check=yes, the words that might be pointers,
+// and which lc_scan_memory_direct would read, are recorded for each
+// SecMap-sized granule the first time a leak search scans any part of
+// it.  Memcheck marks a granule dirty whenever its contents or VA bits
+// change (see MC_(is_lc_granule_dirty)).  Until that happens, later
+// searches take the words from the record instead of reading memory
+// and checking VA bits again.
+//
+// A word is recorded if its value lies in memory readable by the client
+// at the time.  The values in a clean granule are unchanged, but memory
+// can become readable, so all records are dropped if any has.  Chunks
+// coming and going doesn't matter, as the recorded values are looked up
+// again in lc_chunks by every search.  Marking is still redone from
+// scratch each time: only the reading of memory is saved.
+//
+// Granules in device mappings, shared mappings and SysV shm segments are
+// never recorded: other processes, or the kernel, can change them without
+// the granule being marked dirty.
+
+// A granule holding more words than this that might be pointers is not
+// recorded, to bound the memory used.
+#define LC_GRANULE_MAX_WORDS 1024
+
+typedef
+   struct _LC_Granule {
+      struct _LC_Granule* next;
+      UWord               key;      // address of the granule
+      Int                 n_words;  // -1 if not recorded
+      Addr*               words;    // n_words (address, value) pairs,
+                                    // sorted by address
+   }
+   LC_Granule;
+
+// NULL unless --incremental-leak-check=yes.
+static VgHashTable lc_granules = NULL;
+
+// The memory readable by the client at the last search, as sorted and
+// merged [start, end] pairs of Addr.
+static XArray* lc_readable = NULL;
+
+static void lc_free_granule(void* g)
+{
+   if (((LC_Granule*)g)->words)
+      VG_(free)(((LC_Granule*)g)->words);
+   VG_(free)(g);
+}
+
+static XArray* lc_get_readable(void)
+{
+   Int     i, n_seg_starts;
+   Addr*   seg_starts = VG_(get_segment_starts)( &n_seg_starts );
+   XArray* xa = VG_(newXA)(VG_(malloc), "mc.lgr.1", VG_(free), sizeof(Addr));
+
+   tl_assert(seg_starts && n_seg_starts > 0);
+   for (i = 0; i < n_seg_starts; i++) {
+      NSegment const* seg = VG_(am_find_nsegment)( seg_starts[i] );
+      Word n = VG_(sizeXA)(xa);
+      tl_assert(seg);
+      if (seg->kind != SkAnonC && seg->kind != SkFileC && seg->kind != SkShmC)
+         continue;
+      if (!seg->hasR)
+         continue;
+      if (n > 0 && *(Addr*)VG_(indexXA)(xa, n-1) + 1 == seg->start) {
+         *(Addr*)VG_(indexXA)(xa, n-1) = seg->end;
+      } else {
+         VG_(addToXA)(xa, &seg->start);
+         VG_(addToXA)(xa, &seg->end);
+      }
+   }
+   VG_(free)(seg_starts);
+   return xa;
+}
+
+// Is every range in cur inside one in prev?
+static Bool lc_readable_is_within(XArray* cur, XArray* prev)
+{
+   Word i, j = 0;
+   Word n_cur = VG_(sizeXA)(cur), n_prev = VG_(sizeXA)(prev);
+
+   for (i = 0; i < n_cur; i += 2) {
+      Addr start = *(Addr*)VG_(indexXA)(cur, i);
+      Addr end   = *(Addr*)VG_(indexXA)(cur, i+1);
+      while (j < n_prev && *(Addr*)VG_(indexXA)(prev, j+1) < start)
+         j += 2;
+      if (j >= n_prev
+          || *(Addr*)VG_(indexXA)(prev, j) > start
+          || *(Addr*)VG_(indexXA)(prev, j+1) < end)
+         return False;
+   }
+   return True;
+}
+
+// Called at the start of each leak search.  Drops the records that can't
+// be used any more.
+static void lc_prepare_granules(void)
+{
+   XArray* cur = lc_get_readable();
+
+   if (lc_granules == NULL
+       || lc_readable == NULL || !lc_readable_is_within(cur, lc_readable)) {
+      if (lc_granules)
+         VG_(HT_destruct)(lc_granules, lc_free_granule);
+      lc_granules = VG_(HT_construct)("mc.lpg.1");
+   } else {
+      UInt         i, n;
+      VgHashNode** gs = VG_(HT_to_array)(lc_granules, &n);
+      for (i = 0; i < n; i++) {
+         if (MC_(is_lc_granule_dirty)(gs[i]->key))
+            lc_free_granule(VG_(HT_remove)(lc_granules, gs[i]->key));
+      }
+      VG_(free)(gs);
+   }
+   if (lc_readable)
+      VG_(deleteXA)(lc_readable);
+   lc_readable = cur;
+}
+
+// Record the words of g that might be pointers.  Gives up, leaving
+// n_words at -1, if there are too many or if part of the granule must
+// not be read.
+static void lc_record_granule(LC_Granule* g)
+{
+#if defined(VGA_s390x)
+   // See lc_scan_memory_direct.
+   volatile
+#endif
+   Addr ptr = g->key;
+   const Addr end = g->key + SM_SIZE;   // 0 for the last granule
+   vki_sigset_t sigmask;
+   XArray* xa;
+
+   if (! MC_(is_within_valid_secondary)(ptr)) {
+      g->n_words = 0;   // no valid words at all
+      return;
+   }
+   g->n_words = -1;
+
+   xa = VG_(newXA)(VG_(malloc), "mc.lrg.1", VG_(free), 2 * sizeof(Addr));
+   VG_(sigprocmask)(VKI_SIG_SETMASK, NULL, &sigmask);
+   VG_(set_fault_catcher)(scan_all_valid_memory_catcher);
+
+   if (VG_MINIMAL_SETJMP(memscan_jmpbuf) != 0) {
+      VG_(sigprocmask)(VKI_SIG_SETMASK, &sigmask, NULL);
+#     if defined(VGA_s390x)
+      ptr = VG_PGROUNDDN(ptr) + VKI_PAGE_SIZE;
+#     else
+      ptr = bad_scanned_addr + sizeof(Addr);
+#     endif
+   }
+   while (ptr != end) {
+      if (UNLIKELY((ptr % VKI_PAGE_SIZE) == 0)) {
+         NSegment const* seg;
+         if (!VG_(am_is_valid_for_client)(ptr, sizeof(Addr), VKI_PROT_READ)) {
+            ptr += VKI_PAGE_SIZE;
+            continue;
+         }
+         // Not even a chunk in a device mapping is read ahead of time.
+         // Nor is memory which other processes, or the kernel, can
+         // write without Memcheck marking the granule dirty: a shared
+         // mapping or a SysV shm segment.
+         seg = VG_(am_find_nsegment)(ptr);
+         if (seg
+             && (seg->kind == SkShmC || seg->isShared
+                 || (seg->kind == SkFileC
+                     && (VKI_S_ISCHR(seg->mode) || VKI_S_ISBLK(seg->mode))))) {
+            VG_(deleteXA)(xa);
+            xa = NULL;
+            break;
+         }
+      }
+      if ( MC_(is_valid_aligned_word)(ptr) ) {
+         Addr w[2];
+         lc_scanned_szB += sizeof(Addr);
+         w[0] = ptr;
+         w[1] = *(Addr *)ptr;
+         if (w[1] >= VKI_PAGE_SIZE
+             && VG_(am_is_valid_for_client)(w[1], 1, VKI_PROT_READ)) {
+            if (VG_(sizeXA)(xa) == LC_GRANULE_MAX_WORDS) {
+               VG_(deleteXA)(xa);
+               xa = NULL;
+               break;
+            }
+            VG_(addToXA)(xa, w);
+         }
+      }
+      ptr += sizeof(Addr);
+   }
+
+   VG_(sigprocmask)(VKI_SIG_SETMASK, &sigmask, NULL);
+   VG_(set_fault_catcher)(NULL);
+
+   if (xa) {
+      g->n_words = VG_(sizeXA)(xa);
+      if (g->n_words > 0) {
+         g->words = VG_(malloc)("mc.lrg.2", g->n_words * 2 * sizeof(Addr));
+         VG_(memcpy)(g->words, VG_(indexXA)(xa, 0),
+                     g->n_words * 2 * sizeof(Addr));
+      }
+      VG_(deleteXA)(xa);
+   }
+}
+
+// The record of the granule starting at a, made now if needed, or NULL
+// if the granule isn't recorded.
+static LC_Granule* lc_get_granule(Addr a)
+{
+   LC_Granule* g = VG_(HT_lookup)(lc_granules, a);
+
+   if (g == NULL || MC_(is_lc_granule_dirty)(a)) {
+      if (g == NULL) {
+         g = VG_(malloc)("mc.lgg.1", sizeof(LC_Granule));
+         g->key = a;
+         VG_(HT_add_node)(lc_granules, g);
+      } else if (g->words) {
+         VG_(free)(g->words);
+      }
+      g->words = NULL;
+      lc_record_granule(g);
+      MC_(clean_lc_granule)(a);
+   }
+   return g->n_words >= 0 ? g : NULL;
+}
+
+// lc_scan_memory_direct in leak check mode, taking the words from the
+// granule records where there are any.
+static void
+lc_scan_memory_incr(Addr start, SizeT len, Bool is_prior_definite,
+                    Int clique, Int cur_clique)
+{
+   Addr ptr = VG_ROUNDUP(start, sizeof(Addr));
+   const Addr end = VG_ROUNDDN(start+len, sizeof(Addr));
+
+   while (ptr < end) {
+      Addr        g_start = ptr & ~(Addr)SM_MASK;
+      Addr        g_end   = g_start + SM_SIZE;
+      Addr        p_end   = (g_end == 0 || g_end > end) ? end : g_end;
+      LC_Granule* g       = lc_get_granule(g_start);
+
+      if (g == NULL) {
+         lc_scan_memory_direct(ptr, p_end - ptr, is_prior_definite,
+                               clique, cur_clique, /*searched*/0, 0);
+      } else {
+         Int lo = 0, hi = g->n_words;
+         // Find the first word at or after ptr.
+         while (lo < hi) {
+            Int mid = (lo + hi) / 2;
+            if (g->words[2*mid] < ptr)
+               lo = mid + 1;
+            else
+               hi = mid;
+         }
+         for (; lo < g->n_words && g->words[2*lo] < p_end; lo++)
+            lc_push_if_a_chunk_ptr(g->words[2*lo+1], clique, cur_clique,
+                                   is_prior_definite);
+      }
+      ptr = p_end;
+   }
+}
+
+static void
+lc_scan_memory(Addr start, SizeT len, Bool is_prior_definite,
+               Int clique, Int cur_clique,
+               Addr searched, SizeT szB)
+{
+   if (lc_granules != NULL && searched == 0)
+      lc_scan_memory_incr(start, len, is_prior_definite, clique, cur_clique);
+   else
+      lc_scan_memory_direct(start, len, is_prior_definite,
+                            clique, cur_clique, searched, szB);
+}
+
+
 // Process the mark stack until empty.
 static void lc_process_markstack(Int clique)
 {
@@ -1142,13 +1526,69 @@ static Word cmp_LossRecordKey_LossRecord(const void* key, const void* elem)
    if (a->state < b->state) return -1;
    if (a->state > b->state) return  1;
    // Ok, the states are equal.  Now compare the locations, which is slower.
-   if (VG_(eq_ExeContext)(
-            MC_(clo_leak_resolution), a->allocated_at, b->allocated_at))
-      return 0;
-   // Different locations.  Ordering is arbitrary, just use the ec pointer.
-   if (a->allocated_at < b->allocated_at) return -1;
-   if (a->allocated_at > b->allocated_at) return  1;
-   VG_(tool_panic)("bad LossRecord comparison");
+   // This must order the locations consistently with how
+   // --leak-resolution merges them, so that the OSet finds them again.
+   return VG_(cmp_ExeContext)(
+             MC_(clo_leak_resolution), a->allocated_at, b->allocated_at);
+}
+
+static UWord lr_index_hash(const LossRecordKey* key)
+{
+   return VG_(hash_ExeContext)(MC_(clo_leak_resolution), key->allocated_at)
+          ^ ((UWord)key->state * 0x9E3779B1UL);
+}
+
+static void lr_index_free(void)
+{
+   if (lr_index != NULL)
+      VG_(free)(lr_index);
+   lr_index = NULL;
+   lr_index_size = lr_index_used = 0;
+}
+
+static void lr_index_add(LossRecord* lr)
+{
+   UWord h;
+
+   if (2 * (lr_index_used + 1) > lr_index_size) {
+      LossRecord** old       = lr_index;
+      UWord        old_size  = lr_index_size;
+      UWord        i;
+
+      lr_index_size = lr_index_size == 0 ? 1024 : 2 * lr_index_size;
+      lr_index = VG_(calloc)("mc.lr_index", lr_index_size,
+                             sizeof(LossRecord*));
+      lr_index_used = 0;
+      for (i = 0; i < old_size; i++)
+         if (old[i] != NULL)
+            lr_index_add(old[i]);
+      if (old != NULL)
+         VG_(free)(old);
+   }
+   h = lr_index_hash(&lr->key) & (lr_index_size - 1);
+   while (lr_index[h] != NULL)
+      h = (h + 1) & (lr_index_size - 1);
+   lr_index[h] = lr;
+   lr_index_used++;
+}
+
+// Same result as VG_(OSetGen_Lookup)(lr_table, key).
+static LossRecord* lr_index_lookup(const LossRecordKey* key)
+{
+   UWord h;
+
+   if (lr_index_size == 0)
+      return NULL;
+   h = lr_index_hash(key) & (lr_index_size - 1);
+   while (lr_index[h] != NULL) {
+      LossRecord* lr = lr_index[h];
+      if (lr->key.state == key->state
+          && VG_(eq_ExeContext)(MC_(clo_leak_resolution),
+                                key->allocated_at, lr->key.allocated_at))
+         return lr;
+      h = (h + 1) & (lr_index_size - 1);
+   }
+   return NULL;
 }
 
 static Int cmp_LossRecords(const void* va, const void* vb)
@@ -1176,6 +1616,57 @@ static Int cmp_LossRecords(const void* va, const void* vb)
    return 0;
 }
 
+// Rearranges lr_array so that its last m elements are the m biggest loss
+// records, in sorted order, and everything before them is no bigger.
+static void sort_biggest_lossrecords(Int n_lossrecords, Int m)
+{
+   Int k  = n_lossrecords - m;
+   Int lo = 0;
+   Int hi = n_lossrecords - 1;
+
+   // Quickselect for the element that belongs at lr_array[k].
+   // cmp_LossRecords never finds two different loss records equal, so
+   // the sorted part ends up exactly as a full sort would leave it.
+   while (lo < hi) {
+      Int         i = lo, j = hi;
+      LossRecord* a = lr_array[lo];
+      LossRecord* b = lr_array[lo + (hi - lo) / 2];
+      LossRecord* c = lr_array[hi];
+      LossRecord* pivot;
+
+      // Median of three.
+      if (cmp_LossRecords(&a, &b) > 0) { LossRecord* t = a; a = b; b = t; }
+      if (cmp_LossRecords(&b, &c) > 0) b = c;
+      pivot = cmp_LossRecords(&a, &b) > 0 ? a : b;
+
+      while (i <= j) {
+         while (cmp_LossRecords(&lr_array[i], &pivot) < 0) i++;
+         while (cmp_LossRecords(&lr_array[j], &pivot) > 0) j--;
+         if (i <= j) {
+            LossRecord* t = lr_array[i];
+            lr_array[i++] = lr_array[j];
+            lr_array[j--] = t;
+         }
+      }
+      if (k <= j)
+         hi = j;
+      else if (k >= i)
+         lo = i;
+      else
+         break;
+   }
+   VG_(ssort)(lr_array + k, m, sizeof(LossRecord*), cmp_LossRecords);
+   lr_array_sorted_from = k;
+}
+
+// Sorts what sort_biggest_lossrecords left unsorted.
+static void sort_remaining_lossrecords(void)
+{
+   VG_(ssort)(lr_array, lr_array_sorted_from, sizeof(LossRecord*),
+              cmp_LossRecords);
+   lr_array_sorted_from = 0;
+}
+
 // allocates or reallocates lr_array, and set its elements to the loss records
 // contains in lr_table.
 static Int get_lr_array_from_lr_table(void) {
@@ -1306,6 +1797,13 @@ static void print_results(ThreadId tid, LeakCheckParams* lcp)
    VG_(free) (lr_array);
    lr_array = NULL;
 
+   // Index the kept loss records, so that the chunks can be merged into
+   // them (or into new ones) without going through lr_table.
+   lr_index_free();
+   VG_(OSetGen_ResetIter)(lr_table);
+   while ( (lr = VG_(OSetGen_Next)(lr_table)) )
+      lr_index_add(lr);
+
    // Convert the chunks into loss records, merging them where appropriate.
    for (i = 0; i < lc_n_chunks; i++) {
       MC_Chunk*     ch = lc_chunks[i];
@@ -1324,7 +1822,7 @@ static void print_results(ThreadId tid, LeakCheckParams* lcp)
                        ch->data, (unsigned long)ch->szB);
      }
 
-      old_lr = VG_(OSetGen_Lookup)(lr_table, &lrkey);
+      old_lr = lr_index_lookup(&lrkey);
       if (old_lr) {
          // We found an existing loss record matching this chunk.  Update the
          // loss record's details in-situ.  This is safe because we don't
@@ -1348,6 +1846,7 @@ static void print_results(ThreadId tid, LeakCheckParams* lcp)
          lr->old_indirect_szB = 0;
          lr->old_num_blocks   = 0;
          VG_(OSetGen_Insert)(lr_table, lr);
+         lr_index_add(lr);
       }
    }
 
@@ -1355,9 +1854,18 @@ static void print_results(ThreadId tid, LeakCheckParams* lcp)
    n_lossrecords = get_lr_array_from_lr_table ();
    tl_assert(VG_(OSetGen_Size)(lr_table) == n_lossrecords);
 
-   // Sort the array by loss record sizes.
-   VG_(ssort)(lr_array, n_lossrecords, sizeof(LossRecord*),
-              cmp_LossRecords);
+   // Sort the array by loss record sizes.  If only the biggest records
+   // can be output, start by sorting only a few more of them than that;
+   // the scan below sorts the rest if it has to go further down.
+   if (lcp->mode == LC_Full
+       && 2 * (SizeT)lcp->max_loss_records_output < (SizeT)n_lossrecords)
+      sort_biggest_lossrecords(n_lossrecords,
+                               2 * lcp->max_loss_records_output);
+   else {
+      VG_(ssort)(lr_array, n_lossrecords, sizeof(LossRecord*),
+                 cmp_LossRecords);
+      lr_array_sorted_from = 0;
+   }
 
    // Zero totals.
    MC_(blocks_leaked)     = MC_(bytes_leaked)     = 0;
@@ -1376,6 +1884,8 @@ static void print_results(ThreadId tid, LeakCheckParams* lcp)
       Int nr_printable_records = 0;
       for (i = n_lossrecords - 1; i >= 0 && start_lr_output_scan == 0; i--) {
          Bool count_as_error, print_record;
+         if (i < lr_array_sorted_from)
+            sort_remaining_lossrecords();
          lr = lr_array[i];
          get_printing_rules (lcp, lr, &count_as_error, &print_record);
          // Do not use get_printing_rules results for is_suppressed, as we
@@ -1523,7 +2033,7 @@ static void print_clique (Int clique, UInt level)
          Int lr_i;
          ind_lrkey.state = ind_ex->state;
          ind_lrkey.allocated_at = MC_(allocated_at)(ind_ch);
-         ind_lr = VG_(OSetGen_Lookup)(lr_table, &ind_lrkey);
+         ind_lr = lr_index_lookup(&ind_lrkey);
          for (lr_i = 0; lr_i < n_lossrecords; lr_i++)
             if (ind_lr == lr_array[lr_i])
                break;
@@ -1561,6 +2071,10 @@ Bool MC_(print_block_list) ( UInt loss_record_nr)
       return False; // Invalid loss record nr.
 
    tl_assert (lr_array);
+   // The loss record numbers (also those of the indirect loss records
+   // printed by print_clique) are positions in the fully sorted array.
+   if (lr_array_sorted_from > 0)
+      sort_remaining_lossrecords();
    lr = lr_array[loss_record_nr];
    
    // (re-)print the loss record details.
@@ -1576,7 +2090,7 @@ Bool MC_(print_block_list) ( UInt loss_record_nr)
       lrkey.state        = ex->state;
       lrkey.allocated_at = MC_(allocated_at)(ch);
 
-      old_lr = VG_(OSetGen_Lookup)(lr_table, &lrkey);
+      old_lr = lr_index_lookup(&lrkey);
       if (old_lr) {
          // We found an existing loss record matching this chunk.
          // If this is the loss record we are looking for, output the pointer.
@@ -1602,10 +2116,79 @@ Bool MC_(print_block_list) ( UInt loss_record_nr)
    return True;
 }
 
+// Memory the client has said holds no pointers to heap blocks, with
+// VALGRIND_LEAK_CHECK_IGNORE_RANGE, eg. big data buffers.  It is left out
+// of the root set.  Ranges are forgotten when they are unmapped, so that
+// whatever is mapped there later is scanned.  NULL until the first
+// request.
+static RangeMap* lc_ignored_roots = NULL;
+
+void MC_(leak_check_ignore_range) ( Addr start, SizeT len, Bool ignore )
+{
+   if (len == 0 || (!ignore && lc_ignored_roots == NULL))
+      return;
+   if (lc_ignored_roots == NULL)
+      lc_ignored_roots = VG_(newRangeMap)( VG_(malloc), "mc.lcir.1",
+                                           VG_(free), /*not ignored*/0 );
+   VG_(bindRangeMap)( lc_ignored_roots, start, start + len - 1,
+                      ignore ? 1 : 0 );
+}
+
+// Finds the first part of [*start, end] that isn't an ignored range, and
+// sets *start and *last to its first and last bytes.  Returns False if
+// there is none.  What is skipped counts as lc_ignored_szB.
+static Bool lc_next_root_range ( Addr* start, Addr end, Addr* last )
+{
+   Addr a = *start;
+
+   if (lc_ignored_roots == NULL) {
+      *last = end;
+      return True;
+   }
+   while (True) {
+      UWord lo, hi, ignored;
+      VG_(lookupRangeMap)( &lo, &hi, &ignored, lc_ignored_roots, a );
+      if (hi > end)
+         hi = end;
+      if (!ignored) {
+         *start = a;
+         *last  = hi;
+         return True;
+      }
+      lc_ignored_szB += hi - a + 1;
+      if (hi == end)
+         return False;
+      a = hi + 1;
+   }
+}
+
 // If searched = 0, scan memory root set, pushing onto the mark stack the blocks
 // encountered.
 // Otherwise (searched != 0), scan the memory root set searching for ptr
 // pointing inside [searched, searched+szB[.
+// Is seg part of the root set?
+static Bool lc_is_root_segment(NSegment const* seg)
+{
+   if (seg->kind != SkFileC && seg->kind != SkAnonC) return False;
+   if (!(seg->hasR && seg->hasW))                    return False;
+   if (seg->isCH)                                    return False;
+
+   // Don't poke around in device segments as this may cause
+   // hangs.  Exclude /dev/zero just in case someone allocated
+   // memory by explicitly mapping /dev/zero.
+   if (seg->kind == SkFileC 
+       && (VKI_S_ISCHR(seg->mode) || VKI_S_ISBLK(seg->mode))) {
+      HChar* dev_name = VG_(am_get_filename)( seg );
+      if (dev_name && 0 == VG_(strcmp)(dev_name, "/dev/zero")) {
+         // Don't skip /dev/zero.
+      } else {
+         // Skip this device mapping.
+         return False;
+      }
+   }
+   return True;
+}
+
 static void scan_memory_root_set(Addr searched, SizeT szB)
 {
    Int   i;
@@ -1616,30 +2199,17 @@ static void scan_memory_root_set(Addr searched, SizeT szB)
 
    lc_scanned_szB = 0;
    lc_sig_skipped_szB = 0;
+   lc_ignored_szB = 0;
 
    // VG_(am_show_nsegments)( 0, "leakcheck");
    for (i = 0; i < n_seg_starts; i++) {
       SizeT seg_size;
+      Addr  start, last;
       NSegment const* seg = VG_(am_find_nsegment)( seg_starts[i] );
       tl_assert(seg);
 
-      if (seg->kind != SkFileC && seg->kind != SkAnonC) continue;
-      if (!(seg->hasR && seg->hasW))                    continue;
-      if (seg->isCH)                                    continue;
-
-      // Don't poke around in device segments as this may cause
-      // hangs.  Exclude /dev/zero just in case someone allocated
-      // memory by explicitly mapping /dev/zero.
-      if (seg->kind == SkFileC 
-          && (VKI_S_ISCHR(seg->mode) || VKI_S_ISBLK(seg->mode))) {
-         HChar* dev_name = VG_(am_get_filename)( seg );
-         if (dev_name && 0 == VG_(strcmp)(dev_name, "/dev/zero")) {
-            // Don't skip /dev/zero.
-         } else {
-            // Skip this device mapping.
-            continue;
-         }
-      }
+      if (!lc_is_root_segment(seg))
+         continue;
 
       if (0)
          VG_(printf)("ACCEPT %2d  %#lx %#lx\n", i, seg->start, seg->end);
@@ -1652,13 +2222,415 @@ static void scan_memory_root_set(Addr searched, SizeT szB)
                       "  Scanning root segment: %#lx..%#lx (%lu)\n",
                       seg->start, seg->end, seg_size);
       }
-      lc_scan_memory(seg->start, seg_size, /*is_prior_definite*/True,
-                     /*clique*/-1, /*cur_clique*/-1,
-                     searched, szB);
+      for (start = seg->start;
+           lc_next_root_range(&start, seg->end, &last);
+           start = last + 1) {
+         lc_scan_memory(start, last - start + 1, /*is_prior_definite*/True,
+                        /*clique*/-1, /*cur_clique*/-1,
+                        searched, szB);
+         if (last == seg->end)
+            break;
+      }
    }
    VG_(free)(seg_starts);
 }
 
+/*------------------------------------------------------------*/
+/*--- Marking on several threads.                          ---*/
+/*------------------------------------------------------------*/
+
+// With --leak-check-threads=N for N > 1, the scan of the root set and the
+// tracing of everything reachable from it are shared between N workers
+// (see VG_(run_workers)).  The workers share lc_chunks, which is only
+// read, and lc_extras, whose state and heuristic fields they change with
+// compare-and-swap.  They don't use the mark stack: a chunk whose state a
+// worker upgrades goes on the worker's own small stack, or on
+// lc_par_queue if that is full.  The work is done in rounds.  Round 0
+// scans the root set, cut into pieces; each later round scans the chunks
+// queued during the one before.  Gathering cliques afterwards is
+// sequential, as before.
+//
+// The workers can't catch faults, so they only read anonymous memory,
+// which can't fault once aspacemgr says it is readable.  A file mapping
+// can: a read past the end of a file truncated since it was mapped gives
+// SIGBUS.  So root segments mapped from files are scanned on the main
+// thread, under scan_all_valid_memory_catcher, before round 0, and a
+// chunk which a worker finds to reach into such a mapping is left in
+// lc_par_deferred, to be scanned there too between rounds.
+
+// Largest piece of the root set handed out at once.
+#define LC_PAR_PIECE_SZB (16 * SM_SIZE)
+// Size of each worker's own stack.
+#define LC_PAR_STACK_SIZE 256
+// A round only gets an extra worker for each this many queued chunks.
+#define LC_PAR_CHUNKS_PER_WORKER 64
+
+typedef
+   struct {
+      Addr  start;
+      SizeT szB;
+   }
+   LC_Piece;
+
+typedef
+   struct {
+      Int            stack[LC_PAR_STACK_SIZE];
+      Int            stack_top;     // -1 if empty
+      SizeT          scanned_szB;
+      MC_SecMapCache scan_smc;      // for the memory being scanned
+      MC_SecMapCache heur_smc;      // for heuristic_reachedness
+   }
+   LC_Worker;
+
+// The first word of an LC_Extra, holding state, pending and heuristic.
+typedef
+   union {
+      LC_Extra ex;
+      UInt     w;
+   }
+   LC_ExtraWord;
+
+// All of these are only changed between rounds, except for lc_par_next
+// and lc_par_n_queued, which workers bump atomically.
+static LC_Worker*   lc_par_workers;
+static LC_Piece*    lc_par_pieces;     // round 0 only, else NULL
+static Int          lc_par_n_pieces;
+// Chunks queued for scanning in a later round.  A chunk is queued at most
+// twice (Unreached -> Possible -> Reachable), hence 2*lc_n_chunks entries
+// are enough.
+static Int*         lc_par_queue;
+static volatile Int lc_par_n_queued;
+// Chunks to be scanned on the main thread.  Each queued chunk is deferred
+// at most once, so 2*lc_n_chunks entries are enough here as well.
+static Int*         lc_par_deferred;
+static volatile Int lc_par_n_deferred;
+// lc_par_queue[lc_par_round_lo .. lc_par_round_hi-1] is this round's work.
+static Int          lc_par_round_lo;
+static Int          lc_par_round_hi;
+// Index of the next piece or queued chunk to take in this round.
+static volatile Int lc_par_next;
+
+static void lc_par_push(Int ch_no, LC_Worker* w)
+{
+   if (w->stack_top < LC_PAR_STACK_SIZE-1) {
+      w->stack[++w->stack_top] = ch_no;
+   } else {
+      Int i = __sync_fetch_and_add(&lc_par_n_queued, 1);
+      tl_assert(i < 2 * lc_n_chunks);
+      lc_par_queue[i] = ch_no;
+   }
+}
+
+// The same as lc_push_without_clique_if_a_chunk_ptr, but with the update
+// of the LC_Extra done atomically.
+static void
+lc_par_push_if_a_chunk_ptr(Addr ptr, Bool is_prior_definite, LC_Worker* w)
+{
+   Int ch_no;
+   MC_Chunk* ch;
+   LC_Extra* ex;
+   Reachedness ch_via_ptr;
+
+   if ( ! lc_is_a_chunk_ptr(ptr, &ch_no, &ch, &ex) )
+      return;
+
+   while (True) {
+      volatile UInt* wp = (volatile UInt*)ex;
+      LC_ExtraWord   old, nyu;
+      Bool           push = False;
+
+      old.w = nyu.w = *wp;
+      if (old.ex.state == Reachable) {
+         if (!(old.ex.heuristic && ptr == ch->data))
+            return;
+         nyu.ex.heuristic = LchNone;
+      } else {
+         if (ptr == ch->data)
+            ch_via_ptr = Reachable;
+         else if (detect_memory_leaks_last_heuristics) {
+            nyu.ex.heuristic
+               = heuristic_reachedness (ptr, ch, ex,
+                                        detect_memory_leaks_last_heuristics,
+                                        &w->heur_smc);
+            if (nyu.ex.heuristic)
+               ch_via_ptr = Reachable;
+            else
+               ch_via_ptr = Possible;
+         } else
+            ch_via_ptr = Possible;
+
+         if (ch_via_ptr == Reachable && is_prior_definite) {
+            nyu.ex.state = Reachable;
+            push = True;
+         } else if (old.ex.state == Unreached) {
+            nyu.ex.state = Possible;
+            push = True;
+         }
+      }
+
+      if (nyu.w == old.w)
+         return;
+      if (__sync_bool_compare_and_swap(wp, old.w, nyu.w)) {
+         if (push)
+            lc_par_push(ch_no, w);
+         return;
+      }
+      // Another worker got there first; have another look.
+   }
+}
+
+static void
+lc_par_push_if_a_chunk_ptr_register(ThreadId tid, const HChar* regname,
+                                    Addr ptr)
+{
+   lc_par_push_if_a_chunk_ptr(ptr, /*is_prior_definite*/True,
+                              &lc_par_workers[0]);
+}
+
+// Can a worker read the readable client page at 'a' without any risk
+// of a fault?
+static Bool lc_par_page_is_anon(Addr a)
+{
+   NSegment const* seg = VG_(am_find_nsegment)(a);
+   return seg != NULL && seg->kind == SkAnonC;
+}
+
+// lc_scan_memory in leak check mode.  On a worker ('on_main' False),
+// without fault catching: it gives up, returning False, on reaching a
+// page which isn't anonymous.  On the main thread, with fault catching
+// as in lc_scan_memory.
+static Bool lc_par_scan_memory(Addr start, SizeT len, Bool is_prior_definite,
+                               LC_Worker* w, Bool on_main)
+{
+#if defined(VGA_s390x)
+   // See lc_scan_memory.
+   volatile
+#endif
+   Addr ptr = VG_ROUNDUP(start, sizeof(Addr));
+   const Addr end = VG_ROUNDDN(start+len, sizeof(Addr));
+   vki_sigset_t sigmask;
+
+   if ( ! MC_(is_within_valid_secondary_MT)(ptr, &w->scan_smc) ) {
+      ptr = VG_ROUNDUP(ptr+1, SM_SIZE);
+   } else if (!VG_(am_is_valid_for_client)(ptr, sizeof(Addr), VKI_PROT_READ)) {
+      ptr = VG_PGROUNDUP(ptr+1);
+   } else if (!on_main && !lc_par_page_is_anon(ptr)) {
+      return False;
+   }
+
+   if (on_main) {
+      VG_(sigprocmask)(VKI_SIG_SETMASK, NULL, &sigmask);
+      VG_(set_fault_catcher)(scan_all_valid_memory_catcher);
+      if (VG_MINIMAL_SETJMP(memscan_jmpbuf) != 0) {
+         VG_(sigprocmask)(VKI_SIG_SETMASK, &sigmask, NULL);
+#        if defined(VGA_s390x)
+         lc_sig_skipped_szB += VKI_PAGE_SIZE;
+         ptr = ptr + VKI_PAGE_SIZE;
+#        else
+         lc_sig_skipped_szB += sizeof(Addr);
+         ptr = bad_scanned_addr + sizeof(Addr);
+#        endif
+      }
+   }
+   while (ptr < end) {
+      if (UNLIKELY((ptr % SM_SIZE) == 0)) {
+         if ( ! MC_(is_within_valid_secondary_MT)(ptr, &w->scan_smc) ) {
+            ptr = VG_ROUNDUP(ptr+1, SM_SIZE);
+            continue;
+         }
+      }
+      if (UNLIKELY((ptr % VKI_PAGE_SIZE) == 0)) {
+         if (!VG_(am_is_valid_for_client)(ptr, sizeof(Addr), VKI_PROT_READ)) {
+            ptr += VKI_PAGE_SIZE;
+            continue;
+         }
+         if (!on_main && !lc_par_page_is_anon(ptr))
+            return False;
+      }
+      if ( MC_(is_valid_aligned_word_MT)(ptr, &w->scan_smc) ) {
+         w->scanned_szB += sizeof(Addr);
+         lc_par_push_if_a_chunk_ptr(*(Addr *)ptr, is_prior_definite, w);
+      }
+      ptr += sizeof(Addr);
+   }
+   if (on_main)
+      VG_(set_fault_catcher)(NULL);
+   return True;
+}
+
+static void lc_par_scan_chunk(Int ch_no, LC_Worker* w, Bool on_main)
+{
+   LC_ExtraWord e;
+   e.w = *(volatile UInt*)&lc_extras[ch_no];
+   // If the state is stale, the chunk has been pushed again, and will
+   // be rescanned.
+   if (!lc_par_scan_memory(lc_chunks[ch_no]->data, lc_chunks[ch_no]->szB,
+                           /*is_prior_definite*/ e.ex.state != Possible,
+                           w, on_main)) {
+      Int i = __sync_fetch_and_add(&lc_par_n_deferred, 1);
+      tl_assert(i < 2 * lc_n_chunks);
+      lc_par_deferred[i] = ch_no;
+   }
+}
+
+static void lc_par_drain_stack(LC_Worker* w)
+{
+   while (w->stack_top >= 0) {
+      Int ch_no = w->stack[w->stack_top--];
+      lc_par_scan_chunk(ch_no, w, /*on_main*/False);
+   }
+}
+
+static void lc_par_worker(void* unused, Int i)
+{
+   LC_Worker* w = &lc_par_workers[i];
+
+   lc_par_drain_stack(w);
+   while (True) {
+      Int k = __sync_fetch_and_add(&lc_par_next, 1);
+      if (lc_par_pieces) {
+         if (k >= lc_par_n_pieces)
+            break;
+         Bool done = lc_par_scan_memory(lc_par_pieces[k].start,
+                                        lc_par_pieces[k].szB,
+                                        /*is_prior_definite*/True,
+                                        w, /*on_main*/False);
+         tl_assert(done);   // the pieces are all anonymous
+      } else {
+         if (lc_par_round_lo + k >= lc_par_round_hi)
+            break;
+         lc_par_scan_chunk(lc_par_queue[lc_par_round_lo + k], w,
+                           /*on_main*/False);
+      }
+      lc_par_drain_stack(w);
+   }
+}
+
+// Replaces scan_memory_root_set, the scan of the registers and
+// lc_process_markstack(-1) when there are several workers.
+static void lc_par_mark_from_root_set(Int n_workers)
+{
+   Int      i, n_seg_starts;
+   Addr*    seg_starts;
+   XArray*  pieces;
+   XArray*  main_pieces;   // of file mappings, for the main thread
+   Int      n_deferred_done = 0;
+   UInt     n_rounds = 0;
+   // Everything below lives until the marking is done.
+   Region*  region = VG_(newRegion)(VG_(malloc), "mc.lpmfrs.0", VG_(free));
+
+   lc_scanned_szB = 0;
+   lc_sig_skipped_szB = 0;
+   lc_ignored_szB = 0;
+
+   lc_par_workers = VG_(allocInRegion)("mc.lpmfrs.1",
+                                       n_workers * sizeof(LC_Worker));
+   for (i = 0; i < n_workers; i++) {
+      lc_par_workers[i].stack_top   = -1;
+      lc_par_workers[i].scanned_szB = 0;
+      MC_(init_SecMapCache)(&lc_par_workers[i].scan_smc);
+      MC_(init_SecMapCache)(&lc_par_workers[i].heur_smc);
+   }
+   lc_par_queue = VG_(allocInRegion)("mc.lpmfrs.2",
+                                     2 * lc_n_chunks * sizeof(Int));
+   lc_par_n_queued = 0;
+   lc_par_deferred = VG_(allocInRegion)("mc.lpmfrs.4",
+                                        2 * lc_n_chunks * sizeof(Int));
+   lc_par_n_deferred = 0;
+
+   // Cut the root set into pieces.
+   pieces = VG_(newXA)(VG_(allocInRegion), "mc.lpmfrs.3", VG_(freeInRegion),
+                       sizeof(LC_Piece));
+   main_pieces = VG_(newXA)(VG_(allocInRegion), "mc.lpmfrs.5",
+                            VG_(freeInRegion), sizeof(LC_Piece));
+   seg_starts = VG_(get_segment_starts)( &n_seg_starts );
+   tl_assert(seg_starts && n_seg_starts > 0);
+   for (i = 0; i < n_seg_starts; i++) {
+      NSegment const* seg = VG_(am_find_nsegment)( seg_starts[i] );
+      Addr a, start, last;
+      tl_assert(seg);
+      if (!lc_is_root_segment(seg))
+         continue;
+      if (VG_(clo_verbosity) > 2) {
+         VG_(message)(Vg_DebugMsg,
+                      "  Scanning root segment: %#lx..%#lx (%lu)\n",
+                      seg->start, seg->end, seg->end - seg->start + 1);
+      }
+      for (start = seg->start;
+           lc_next_root_range(&start, seg->end, &last);
+           start = last + 1) {
+         for (a = start; a <= last; a += LC_PAR_PIECE_SZB) {
+            LC_Piece p;
+            p.start = a;
+            p.szB   = last - a + 1;
+            if (p.szB > LC_PAR_PIECE_SZB)
+               p.szB = LC_PAR_PIECE_SZB;
+            VG_(addToXA)(seg->kind == SkAnonC ? pieces : main_pieces, &p);
+            if (p.szB < LC_PAR_PIECE_SZB)
+               break;   // also avoids wrapping at the top of memory
+         }
+         if (last == seg->end)
+            break;
+      }
+   }
+   VG_(free)(seg_starts);
+
+   // Round 0: registers and file mappings, which seed worker 0's stack,
+   // and the rest of the root set.
+   VG_(apply_to_GP_regs)(lc_par_push_if_a_chunk_ptr_register);
+   for (i = 0; i < VG_(sizeXA)(main_pieces); i++) {
+      LC_Piece* p = VG_(indexXA)(main_pieces, i);
+      lc_par_scan_memory(p->start, p->szB, /*is_prior_definite*/True,
+                         &lc_par_workers[0], /*on_main*/True);
+   }
+   lc_par_n_pieces = VG_(sizeXA)(pieces);
+   lc_par_pieces   = lc_par_n_pieces > 0 ? VG_(indexXA)(pieces, 0) : NULL;
+   lc_par_next     = 0;
+   VG_(run_workers)(n_workers, lc_par_worker, NULL);
+   n_rounds++;
+   lc_par_pieces = NULL;
+
+   // Later rounds: whatever the previous round queued.  Once there is
+   // nothing left, scan the deferred chunks on this thread, and go on
+   // with whatever that queued.
+   lc_par_round_hi = 0;
+   while (True) {
+      Int n;
+      if (lc_par_round_hi == lc_par_n_queued) {
+         LC_Worker* w0 = &lc_par_workers[0];
+         if (n_deferred_done == lc_par_n_deferred)
+            break;
+         while (n_deferred_done < lc_par_n_deferred)
+            lc_par_scan_chunk(lc_par_deferred[n_deferred_done++], w0,
+                              /*on_main*/True);
+         while (w0->stack_top >= 0)
+            lc_par_scan_chunk(w0->stack[w0->stack_top--], w0,
+                              /*on_main*/True);
+         continue;
+      }
+      lc_par_round_lo = lc_par_round_hi;
+      lc_par_round_hi = lc_par_n_queued;
+      lc_par_next     = 0;
+      n = 1 + (lc_par_round_hi - lc_par_round_lo) / LC_PAR_CHUNKS_PER_WORKER;
+      VG_(run_workers)(n < n_workers ? n : n_workers, lc_par_worker, NULL);
+      n_rounds++;
+   }
+
+   for (i = 0; i < n_workers; i++) {
+      tl_assert(lc_par_workers[i].stack_top == -1);
+      lc_scanned_szB += lc_par_workers[i].scanned_szB;
+   }
+   if (VG_(clo_verbosity) > 2)
+      VG_(message)(Vg_DebugMsg, "  Marked with %d workers in %u rounds, "
+                   "%d chunks queued, %d deferred\n", n_workers, n_rounds,
+                   lc_par_n_queued, lc_par_n_deferred);
+
+   VG_(freeRegion)(region);
+   lc_par_queue = NULL;
+   lc_par_deferred = NULL;
+   lc_par_workers = NULL;
+}
+
 /*------------------------------------------------------------*/
 /*--- Top-level entry point.                               ---*/
 /*------------------------------------------------------------*/
@@ -1687,6 +2659,7 @@ void MC_(detect_memory_leaks) ( ThreadId tid, LeakCheckParams* lcp)
       VG_(free)(lc_chunks);
       lc_chunks = NULL;
    }
+   lc_free_page_filter();
    lc_chunks = find_active_chunks(&lc_n_chunks);
    lc_chunks_n_frees_marker = MC_(get_cmalloc_n_frees)();
    if (lc_n_chunks == 0) {
@@ -1699,6 +2672,7 @@ void MC_(detect_memory_leaks) ( ThreadId tid, LeakCheckParams* lcp)
          // This will then output all LossRecords with a size decreasing to 0
          VG_(OSetGen_Destroy) (lr_table);
          lr_table = NULL;
+         lr_index_free();
       }
       if (VG_(clo_verbosity) >= 1 && !VG_(clo_xml)) {
          VG_(umsg)("All heap blocks were freed -- no leaks are possible\n");
@@ -1778,6 +2752,8 @@ void MC_(detect_memory_leaks) ( ThreadId tid, LeakCheckParams* lcp)
       }
    }
 
+   lc_build_page_filter();
+
    // Initialise lc_extras.
    if (lc_extras) {
       VG_(free)(lc_extras);
@@ -1798,28 +2774,39 @@ void MC_(detect_memory_leaks) ( ThreadId tid, LeakCheckParams* lcp)
    }
    lc_markstack_top = -1;
 
+   if (MC_(clo_incremental_leak_check))
+      lc_prepare_granules();
+
    // Verbosity.
    if (VG_(clo_verbosity) > 1 && !VG_(clo_xml)) {
       VG_(umsg)( "Searching for pointers to %'d not-freed blocks\n",
                  lc_n_chunks );
    }
 
-   // Scan the memory root-set, pushing onto the mark stack any blocks
-   // pointed to.
-   scan_memory_root_set(/*searched*/0, 0);
+   if (MC_(clo_leak_check_threads) > 1) {
+      // The same as below, but shared between several workers.
+      lc_par_mark_from_root_set(MC_(clo_leak_check_threads));
+   } else {
+      // Scan the memory root-set, pushing onto the mark stack any blocks
+      // pointed to.
+      scan_memory_root_set(/*searched*/0, 0);
 
-   // Scan GP registers for chunk pointers.
-   VG_(apply_to_GP_regs)(lc_push_if_a_chunk_ptr_register);
+      // Scan GP registers for chunk pointers.
+      VG_(apply_to_GP_regs)(lc_push_if_a_chunk_ptr_register);
 
-   // Process the pushed blocks.  After this, every block that is reachable
-   // from the root-set has been traced.
-   lc_process_markstack(/*clique*/-1);
+      // Process the pushed blocks.  After this, every block that is
+      // reachable from the root-set has been traced.
+      lc_process_markstack(/*clique*/-1);
+   }
 
    if (VG_(clo_verbosity) > 1 && !VG_(clo_xml)) {
       VG_(umsg)("Checked %'lu bytes\n", lc_scanned_szB);
       if (lc_sig_skipped_szB > 0)
          VG_(umsg)("Skipped %'lu bytes due to read errors\n",
                    lc_sig_skipped_szB);
+      if (lc_ignored_szB > 0)
+         VG_(umsg)("Skipped %'lu bytes of ignored ranges\n",
+                   lc_ignored_szB);
       VG_(umsg)( "\n" );
    }
 
@@ -38,8 +38,10 @@
 #include "pub_tool_basics.h"
 #include "pub_tool_poolalloc.h"     // For mc_include.h
 #include "pub_tool_hashtable.h"     // For mc_include.h
+#include "pub_tool_hashtable2.h"     // For mc_include.h
 #include "pub_tool_libcassert.h"
 #include "pub_tool_libcprint.h"
+#include "pub_tool_machine.h"       // VG_(set_shadow_regs_area)
 #include "pub_tool_tooliface.h"
 
 #include "mc_include.h"
@@ -1390,6 +1392,17 @@ IRType MC_(get_otrack_reg_array_equiv_int_type) ( IRRegArray* arr )
 }
 
 
+/* Make all of thread tid's registers defined, with no origin: the V
+   bits and the origin tags for that are all zero. */
+void MC_(make_regs_defined) ( ThreadId tid )
+{
+   static UChar zeroes[MC_SIZEOF_GUEST_STATE];
+
+   VG_(set_shadow_regs_area)( tid, 1, 0, MC_SIZEOF_GUEST_STATE, zeroes );
+   if (MC_(clo_mc_level) == 3)
+      VG_(set_shadow_regs_area)( tid, 2, 0, MC_SIZEOF_GUEST_STATE, zeroes );
+}
+
 /*--------------------------------------------------------------------*/
 /*--- end                                             mc_machine.c ---*/
 /*--------------------------------------------------------------------*/
@@ -35,6 +35,7 @@
 #include "pub_tool_gdbserver.h"
 #include "pub_tool_poolalloc.h"
 #include "pub_tool_hashtable.h"     // For mc_include.h
+#include "pub_tool_hashtable2.h"     // For mc_include.h
 #include "pub_tool_libcbase.h"
 #include "pub_tool_libcassert.h"
 #include "pub_tool_libcprint.h"
@@ -46,6 +47,7 @@
 #include "pub_tool_replacemalloc.h"
 #include "pub_tool_tooliface.h"
 #include "pub_tool_threadstate.h"
+#include "pub_tool_vki.h"         // VKI_PROT_READ
 
 #include "mc_include.h"
 #include "memcheck.h"   /* for client requests */
@@ -288,6 +290,51 @@ static INLINE Bool is_distinguished_sm ( SecMap* sm ) {
 // Forward declaration
 static void update_SM_counts(SecMap* oldSM, SecMap* newSM);
 
+/* With --huge-pages, non-distinguished secondaries are carved out of
+   huge-page-sized chunks, and freed ones are kept on a list for
+   reuse, rather than each being mapped and unmapped by itself.  That
+   keeps them on huge pages, and saves an aspacem segment per SecMap.
+   Freed SecMaps are linked through their first word. */
+static SecMap* sm_pool_next   = NULL;  // next unused SecMap in chunk
+static SecMap* sm_pool_limit  = NULL;  // end of current chunk
+static SecMap* sm_free_list   = NULL;
+static Int     n_sm_pool_chunks = 0;
+
+static SecMap* alloc_SM ( void )
+{
+   SizeT   chunk_szB = VG_(am_huge_page_szB)();
+   SecMap* sm;
+
+   if (chunk_szB == 0)
+      return VG_(am_shadow_alloc)(sizeof(SecMap));
+
+   if (sm_free_list != NULL) {
+      sm = sm_free_list;
+      sm_free_list = *(SecMap**)sm;
+      return sm;
+   }
+   if (sm_pool_next == sm_pool_limit) {
+      tl_assert(chunk_szB % sizeof(SecMap) == 0);
+      sm_pool_next = VG_(am_shadow_alloc)(chunk_szB);
+      if (sm_pool_next == NULL)
+         return NULL;
+      sm_pool_limit = sm_pool_next + chunk_szB / sizeof(SecMap);
+      n_sm_pool_chunks++;
+   }
+   return sm_pool_next++;
+}
+
+static void free_SM ( SecMap* sm )
+{
+   if (VG_(am_huge_page_szB)() == 0) {
+      SysRes sres = VG_(am_munmap_valgrind)((Addr)sm, sizeof(SecMap));
+      tl_assert2(! sr_isError(sres), "SecMap valgrind munmap failure\n");
+      return;
+   }
+   *(SecMap**)sm = sm_free_list;
+   sm_free_list = sm;
+}
+
 /* dist_sm points to one of our three distinguished secondaries.  Make
    a copy of it so that we can write to it.
 */
@@ -298,7 +345,7 @@ static SecMap* copy_for_writing ( SecMap* dist_sm )
           || dist_sm == &sm_distinguished[1]
           || dist_sm == &sm_distinguished[2]);
 
-   new_sm = VG_(am_shadow_alloc)(sizeof(SecMap));
+   new_sm = alloc_SM();
    if (new_sm == NULL)
       VG_(out_of_memory_NORETURN)( "memcheck:allocate new SecMap", 
                                    sizeof(SecMap) );
@@ -587,6 +634,48 @@ static AuxMapEnt* find_or_alloc_in_auxmap ( Addr a )
    return nyu;
 }
 
+/* --------------- Dirty granules for the leak checker --------------- */
+
+/* With --incremental-leak-check=yes, lc_dirty has a byte for each
+   SecMap-sized granule below MAX_PRIMARY_ADDRESS.  It is set whenever
+   the contents or the VA bits of the granule may have changed: by the
+   STOREV helpers, which see every client store, and by everything that
+   writes VA bits.  The leak checker clears it when it records the
+   pointers the granule holds, and reuses that record for as long as it
+   stays clear.  Memory above MAX_PRIMARY_ADDRESS is not tracked and
+   always counts as dirty.  lc_dirty is NULL if the option is off. */
+static UChar* lc_dirty = NULL;
+
+#define MARK_LC_DIRTY_LOW(_a)                                   \
+   do {                                                         \
+      if (UNLIKELY(lc_dirty != NULL)) lc_dirty[(_a) >> 16] = 1; \
+   } while (0)
+
+static void mark_lc_dirty_range ( Addr a, SizeT len )
+{
+   Addr last;
+   if (LIKELY(lc_dirty == NULL) || len == 0 || a > MAX_PRIMARY_ADDRESS)
+      return;
+   last = a + len - 1;
+   if (last > MAX_PRIMARY_ADDRESS || last < a)
+      last = MAX_PRIMARY_ADDRESS;
+   VG_(memset)(&lc_dirty[a >> 16], 1, (last >> 16) - (a >> 16) + 1);
+}
+
+Bool MC_(is_lc_granule_dirty) ( Addr a )
+{
+   tl_assert(lc_dirty != NULL);
+   return a > MAX_PRIMARY_ADDRESS || lc_dirty[a >> 16] != 0;
+}
+
+void MC_(clean_lc_granule) ( Addr a )
+{
+   tl_assert(lc_dirty != NULL);
+   if (a <= MAX_PRIMARY_ADDRESS)
+      lc_dirty[a >> 16] = 0;
+}
+
+
 /* --------------- SecMap fundamentals --------------- */
 
 // In all these, 'low' means it's definitely in the main primary map,
@@ -624,19 +713,28 @@ static INLINE SecMap* get_secmap_for_reading_high ( Addr a )
    return *get_secmap_high_ptr(a);
 }
 
+static void note_filling_SM ( Addr a );
+
 static INLINE SecMap* get_secmap_for_writing_low(Addr a)
 {
    SecMap** p = get_secmap_low_ptr(a);
-   if (UNLIKELY(is_distinguished_sm(*p)))
+   MARK_LC_DIRTY_LOW(a);
+   if (UNLIKELY(is_distinguished_sm(*p))) {
+      if (*p == &sm_distinguished[SM_DIST_UNDEFINED])
+         note_filling_SM(a);
       *p = copy_for_writing(*p);
+   }
    return *p;
 }
 
 static INLINE SecMap* get_secmap_for_writing_high ( Addr a )
 {
    SecMap** p = get_secmap_high_ptr(a);
-   if (UNLIKELY(is_distinguished_sm(*p)))
+   if (UNLIKELY(is_distinguished_sm(*p))) {
+      if (*p == &sm_distinguished[SM_DIST_UNDEFINED])
+         note_filling_SM(a);
       *p = copy_for_writing(*p);
+   }
    return *p;
 }
 
@@ -1467,6 +1565,8 @@ void mc_STOREVn_slow ( Addr a, SizeT nBits, ULong vbytes, Bool bigendian )
 
    PROF_EVENT(35, "mc_STOREVn_slow");
 
+   mark_lc_dirty_range(a, szB);
+
    /* ------------ BEGIN semi-fast cases ------------ */
    /* These deal quickly-ish with the common auxiliary primary map
       cases on 64-bit platforms.  Are merely a speedup hack; can be
@@ -1474,7 +1574,7 @@ void mc_STOREVn_slow ( Addr a, SizeT nBits, ULong vbytes, Bool bigendian )
       both cases the "sizeof(void*) == 8" causes these cases to be
       folded out by compilers on 32-bit platforms.  The logic below
       is somewhat similar to some cases extensively commented in
-      MC_(helperc_STOREV8).
+      mc_STOREV8.
    */
    if (LIKELY(sizeof(void*) == 8 
                       && nBits == 64 && VG_IS_8_ALIGNED(a))) {
@@ -1541,6 +1641,406 @@ void mc_STOREVn_slow ( Addr a, SizeT nBits, ULong vbytes, Bool bigendian )
 }
 
 
+/*------------------------------------------------------------*/
+/*--- Scanning and filling runs of vabits8 chunks.         ---*/
+/*------------------------------------------------------------*/
+
+/* For multi-megabyte ranges, set_address_range_perms and the range
+   checkers spend most of their time walking the vabits8[] array of
+   a secondary.  These routines do that a vector, or at least a word,
+   at a time.  A scan looks for chunks that are either exactly equal
+   to a given vabits8 (all-defined, say) or have no VA_BITS2_NOACCESS
+   field.  The latter holds when, for each 2-bit field, either bit is
+   set, ie. ((v | (v >> 1)) & 0x55..55) == 0x55..55.  Shifting a
+   whole word or vector lane only disturbs the bits which the mask
+   throws away, so the same test applies at every width.
+
+   SSE2 on amd64 and NEON on arm64 are always available, so the
+   16-byte loops use GCC's generic vector types and the compiler
+   picks the instructions.  On amd64, 32-byte AVX2 loops are used
+   too if the host supports them; mc_post_clo_init decides that. */
+
+#define VABITS8_REP(_b)  (((UWord)(_b)) * (~(UWord)0 / 0xFF))
+
+static INLINE Bool vabits8_chunk_ok ( UWord vabits8, UWord want8,
+                                      Bool addr_only )
+{
+   if (addr_only)
+      return ((vabits8 | (vabits8 >> 1)) & 0x55) == 0x55;
+   return vabits8 == want8;
+}
+
+static INLINE Bool vabits8_word_ok ( UWord w, UWord want, Bool addr_only )
+{
+   if (addr_only)
+      return ((w | (w >> 1)) & VABITS8_REP(0x55)) == VABITS8_REP(0x55);
+   return w == want;
+}
+
+#if (defined(VGA_amd64) || defined(VGA_arm64)) \
+    && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#  define MC_VABITS_V128 1
+typedef ULong V128_64x2 __attribute__((vector_size(16)));
+#endif
+
+#if defined(MC_VABITS_V128) && defined(VGA_amd64)
+#  define MC_VABITS_V256 1
+typedef ULong V256_64x4 __attribute__((vector_size(32)));
+
+static Bool mc_use_avx2 = False;
+
+/* 'p' must be 32-aligned.  Returns the number of leading bytes, a
+   multiple of 128, that pass the scan. */
+__attribute__((target("avx2")))
+static SizeT scan_vabits8_avx2 ( const UChar* p, SizeT n,
+                                 ULong want, Bool addr_only )
+{
+   const V256_64x4 wantV = { want, want, want, want };
+   const V256_64x4 mask  = { 0x5555555555555555ULL, 0x5555555555555555ULL,
+                             0x5555555555555555ULL, 0x5555555555555555ULL };
+   SizeT i = 0;
+   while (i + 128 <= n) {
+      const V256_64x4* q = (const V256_64x4*)(p + i);
+      V256_64x4 v0 = q[0], v1 = q[1], v2 = q[2], v3 = q[3];
+      V256_64x4 d;
+      if (addr_only) {
+         d =   (((v0 | (v0 >> 1)) & mask) ^ mask)
+             | (((v1 | (v1 >> 1)) & mask) ^ mask)
+             | (((v2 | (v2 >> 1)) & mask) ^ mask)
+             | (((v3 | (v3 >> 1)) & mask) ^ mask);
+      } else {
+         d = (v0 ^ wantV) | (v1 ^ wantV) | (v2 ^ wantV) | (v3 ^ wantV);
+      }
+      if ((d[0] | d[1] | d[2] | d[3]) != 0)
+         break;
+      i += 128;
+   }
+   return i;
+}
+
+__attribute__((target("avx2")))
+static void fill_vabits8_avx2 ( UChar* p, SizeT n, ULong v )
+{
+   const V256_64x4 vV = { v, v, v, v };
+   V256_64x4* q = (V256_64x4*)p;
+   SizeT i;
+   for (i = 0; i + 32 <= n; i += 32)
+      *q++ = vV;
+}
+#endif
+
+#if defined(MC_VABITS_V128)
+/* The alignment the vector loops want. */
+static INLINE UInt mc_vabits_align ( void )
+{
+#  if defined(MC_VABITS_V256)
+   return mc_use_avx2 ? 32 : 16;
+#  else
+   return 16;
+#  endif
+}
+#endif
+
+/* Returns the number of leading chunks in p[0 .. n-1] that pass the
+   scan described above. */
+static SizeT scan_vabits8 ( const UChar* p, SizeT n, UWord want8,
+                            Bool addr_only )
+{
+   const UWord want = VABITS8_REP(want8);
+   SizeT i = 0;
+
+#  if defined(MC_VABITS_V128)
+   const V128_64x2 wantV = { want, want };
+   const V128_64x2 mask  = { 0x5555555555555555ULL, 0x5555555555555555ULL };
+   const UInt align = mc_vabits_align();
+
+   while (i < n && ((Addr)(p + i) & (align - 1)) != 0) {
+      if (!vabits8_chunk_ok(p[i], want8, addr_only)) return i;
+      i++;
+   }
+#  if defined(MC_VABITS_V256)
+   if (mc_use_avx2)
+      i += scan_vabits8_avx2(p + i, n - i, want, addr_only);
+#  endif
+   while (i + 64 <= n) {
+      const V128_64x2* q = (const V128_64x2*)(p + i);
+      V128_64x2 v0 = q[0], v1 = q[1], v2 = q[2], v3 = q[3];
+      V128_64x2 d;
+      if (addr_only) {
+         d =   (((v0 | (v0 >> 1)) & mask) ^ mask)
+             | (((v1 | (v1 >> 1)) & mask) ^ mask)
+             | (((v2 | (v2 >> 1)) & mask) ^ mask)
+             | (((v3 | (v3 >> 1)) & mask) ^ mask);
+      } else {
+         d = (v0 ^ wantV) | (v1 ^ wantV) | (v2 ^ wantV) | (v3 ^ wantV);
+      }
+      if ((d[0] | d[1]) != 0)
+         break;
+      i += 64;
+   }
+#  else
+   while (i < n && !VG_IS_WORD_ALIGNED(p + i)) {
+      if (!vabits8_chunk_ok(p[i], want8, addr_only)) return i;
+      i++;
+   }
+#  endif
+
+   // Word steps, then byte steps to find exactly where it went wrong.
+   while (i + sizeof(UWord) <= n
+          && vabits8_word_ok(*(const UWord*)(p + i), want, addr_only))
+      i += sizeof(UWord);
+   while (i < n) {
+      if (!vabits8_chunk_ok(p[i], want8, addr_only)) return i;
+      i++;
+   }
+   return i;
+}
+
+/* Set p[0 .. n-1] to vabits8. */
+static void fill_vabits8 ( UChar* p, SizeT n, UWord vabits8 )
+{
+   const UWord v = VABITS8_REP(vabits8);
+   SizeT i = 0;
+
+#  if defined(MC_VABITS_V128)
+   const V128_64x2 vV = { v, v };
+   const UInt align = mc_vabits_align();
+
+   while (i < n && ((Addr)(p + i) & (align - 1)) != 0)
+      p[i++] = vabits8;
+#  if defined(MC_VABITS_V256)
+   if (mc_use_avx2) {
+      fill_vabits8_avx2(p + i, n - i, v);
+      i += (n - i) & ~(SizeT)31;
+   }
+#  endif
+   for (; i + 16 <= n; i += 16)
+      *(V128_64x2*)(p + i) = vV;
+#  else
+   while (i < n && !VG_IS_WORD_ALIGNED(p + i))
+      p[i++] = vabits8;
+#  endif
+
+   for (; i + sizeof(UWord) <= n; i += sizeof(UWord))
+      *(UWord*)(p + i) = v;
+   while (i < n)
+      p[i++] = vabits8;
+}
+
+/* Returns the length of the longest prefix of [a, a+len) in which
+   every chunk passes the scan, and which ends at a chunk boundary or
+   at a+len.  Whole distinguished secondaries are passed or failed
+   without looking at them.  What is left is for the caller to look at
+   a byte at a time, since that is where the first bad byte is. */
+static SizeT vabits_ok_prefix ( Addr a, SizeT len, UWord want8,
+                                Bool addr_only )
+{
+   const Addr a0 = a;
+
+   for (; len > 0 && !VG_IS_4_ALIGNED(a); a++, len--) {
+      UWord vabits2 = get_vabits2(a);
+      if (addr_only ? VA_BITS2_NOACCESS == vabits2
+                    : (want8 & 0x3) != vabits2)
+         return a - a0;
+   }
+   while (len >= 4) {
+      SecMap* sm     = get_secmap_for_reading(a);
+      UWord   sm_off = SM_OFF(a);
+      SizeT   n      = SM_CHUNKS - sm_off;
+      SizeT   m;
+      if (n > len / 4)
+         n = len / 4;
+      if (is_distinguished_sm(sm))
+         m = vabits8_chunk_ok(sm->vabits8[0], want8, addr_only) ? n : 0;
+      else
+         m = scan_vabits8(&sm->vabits8[sm_off], n, want8, addr_only);
+      a   += 4 * m;
+      len -= 4 * m;
+      if (m < n)
+         break;
+   }
+   return a - a0;
+}
+
+/*------------------------------------------------------------*/
+/*--- Collapsing uniform SecMaps.                          ---*/
+/*------------------------------------------------------------*/
+
+/* A non-distinguished SecMap stays allocated even after everything in
+   it has gone back to being uniformly noaccess, undefined or defined,
+   for instance once a partially initialised buffer has been filled
+   in, or a stack has shrunk again.  With --collapse-secmaps=yes, all
+   the SecMaps are looked at every so often and the uniform ones are
+   replaced by the matching distinguished SecMap, and freed.
+
+   That happens when the number of SecMaps in use has doubled since
+   the end of the last pass, so the cost is amortised over the SecMaps
+   issued in between.  It's done at the start of
+   set_address_range_perms, since nothing can be holding a SecMap
+   pointer at that point. */
+
+#define SM_COLLAPSE_MIN_SMS 1024
+
+static Int   n_SMs_after_collapse = 0;
+static ULong n_collapse_passes    = 0;
+static ULong n_collapsed_SMs      = 0;
+
+/* If *sm_ptr is uniform, switch it to the matching distinguished
+   SecMap. */
+static void maybe_collapse_SM ( SecMap** sm_ptr )
+{
+   SecMap* sm = *sm_ptr;
+   UWord   vabits8;
+   SecMap* dsm;
+
+   if (is_distinguished_sm(sm))
+      return;
+   vabits8 = sm->vabits8[0];
+   switch (vabits8) {
+      case VA_BITS8_NOACCESS:  dsm = &sm_distinguished[SM_DIST_NOACCESS];  break;
+      case VA_BITS8_UNDEFINED: dsm = &sm_distinguished[SM_DIST_UNDEFINED]; break;
+      case VA_BITS8_DEFINED:   dsm = &sm_distinguished[SM_DIST_DEFINED];   break;
+      default: return;
+   }
+   if (scan_vabits8(sm->vabits8, SM_CHUNKS, vabits8, False) != SM_CHUNKS)
+      return;
+   update_SM_counts(sm, dsm);
+   *sm_ptr = dsm;
+   free_SM(sm);
+   n_collapsed_SMs++;
+}
+
+static void collapse_uniform_SMs ( void )
+{
+   UWord      i;
+   AuxMapEnt* elem;
+   ULong      n_before = n_collapsed_SMs;
+
+   n_collapse_passes++;
+   for (i = 0; i < N_PRIMARY_MAP; i++)
+      maybe_collapse_SM(&primary_map[i]);
+   VG_(OSetGen_ResetIter)(auxmap_L2);
+   while ( (elem = VG_(OSetGen_Next)(auxmap_L2)) )
+      maybe_collapse_SM(&elem->sm);
+
+   n_SMs_after_collapse = n_non_DSM_SMs;
+   if (VG_(clo_verbosity) > 1)
+      VG_(message)(Vg_DebugMsg,
+                   "memcheck: collapsed %llu uniform SecMaps, %d left\n",
+                   n_collapsed_SMs - n_before, n_non_DSM_SMs);
+}
+
+/* Most memory which starts off undefined -- fresh heap blocks and
+   mappings -- is filled in soon afterwards and then stays defined.
+   A 64k chunk of it that is still the undefined distinguished SecMap
+   gets its own copy at the program's first store, and would keep it
+   until the next pass, although once it has been filled in it could
+   go straight back to being the defined distinguished SecMap.  So
+   those SecMaps are remembered, the most recent SM_FILLING_MAX of
+   them, and at every SM_FILLING_EVERY'th collapse point the ones that
+   look filled in (both ends defined) are checked and collapsed.  One
+   that turns out not to be uniform after all is forgotten, and left to
+   the passes. */
+
+#define SM_FILLING_MAX   64
+#define SM_FILLING_EVERY 16
+
+static Addr  sm_filling[SM_FILLING_MAX];
+static Int   n_sm_filling    = 0;
+static Int   next_sm_filling = 0;   // where the next one goes when full
+static ULong n_filled_SMs    = 0;
+static UInt  n_collapse_points = 0;
+
+static void note_filling_SM ( Addr a )
+{
+   if (!MC_(clo_collapse_secmaps))
+      return;
+   if (n_sm_filling < SM_FILLING_MAX) {
+      sm_filling[n_sm_filling++] = start_of_this_sm(a);
+   } else {
+      sm_filling[next_sm_filling] = start_of_this_sm(a);
+      next_sm_filling = (next_sm_filling + 1) % SM_FILLING_MAX;
+   }
+}
+
+static void collapse_filled_SMs ( void )
+{
+   Int i = 0;
+
+   while (i < n_sm_filling) {
+      SecMap** sm_ptr = get_secmap_ptr(sm_filling[i]);
+      SecMap*  sm     = *sm_ptr;
+      if (!is_distinguished_sm(sm)
+          && (sm->vabits8[0]             != VA_BITS8_DEFINED
+              || sm->vabits8[SM_CHUNKS-1] != VA_BITS8_DEFINED)) {
+         /* Still being filled in, or not going to be uniform. */
+         i++;
+         continue;
+      }
+      if (!is_distinguished_sm(sm)) {
+         maybe_collapse_SM(sm_ptr);
+         if (is_distinguished_sm(*sm_ptr))
+            n_filled_SMs++;
+      }
+      /* Done with this one either way. */
+      sm_filling[i] = sm_filling[--n_sm_filling];
+   }
+   next_sm_filling = 0;
+}
+
+static INLINE void maybe_collapse_uniform_SMs ( void )
+{
+   if (UNLIKELY(n_sm_filling > 0)
+       && (++n_collapse_points % SM_FILLING_EVERY) == 0)
+      collapse_filled_SMs();
+   if (UNLIKELY(n_non_DSM_SMs >= SM_COLLAPSE_MIN_SMS
+                && n_non_DSM_SMs >= 2 * n_SMs_after_collapse)
+       && MC_(clo_collapse_secmaps))
+      collapse_uniform_SMs();
+}
+
+
+/* With --fast-forward, nothing the program did before the
+   instrumentation started was checked, so treat all its accessible
+   memory as defined from then on: every A-and-V-bit pair other than
+   noaccess becomes defined. */
+static void make_SM_defined ( SecMap** sm_ptr )
+{
+   SecMap* sm = *sm_ptr;
+   UWord   i, vabits8;
+
+   if (sm == &sm_distinguished[SM_DIST_UNDEFINED]) {
+      update_SM_counts(sm, &sm_distinguished[SM_DIST_DEFINED]);
+      *sm_ptr = &sm_distinguished[SM_DIST_DEFINED];
+      return;
+   }
+   if (is_distinguished_sm(sm))
+      return;
+   for (i = 0; i < SM_CHUNKS; i++) {
+      vabits8 = sm->vabits8[i];
+      /* 01b, 10b and 11b all give 10b; 00b stays. */
+      sm->vabits8[i] = ((vabits8 | (vabits8 >> 1)) & 0x55) << 1;
+   }
+}
+
+static void make_all_accessible_defined ( void )
+{
+   UWord      i;
+   AuxMapEnt* elem;
+
+   for (i = 0; i < N_PRIMARY_MAP; i++)
+      make_SM_defined(&primary_map[i]);
+   VG_(OSetGen_ResetIter)(auxmap_L2);
+   while ( (elem = VG_(OSetGen_Next)(auxmap_L2)) )
+      make_SM_defined(&elem->sm);
+   mark_lc_dirty_range(0, ~(SizeT)0);
+
+   /* No partially defined bytes are left. */
+   VG_(OSetGen_Destroy)(secVBitTable);
+   secVBitTable = createSecVBitTable();
+}
+
+
 /*------------------------------------------------------------*/
 /*--- Setting permissions over address ranges.             ---*/
 /*------------------------------------------------------------*/
@@ -1548,7 +2048,7 @@ void mc_STOREVn_slow ( Addr a, SizeT nBits, ULong vbytes, Bool bigendian )
 static void set_address_range_perms ( Addr a, SizeT lenT, UWord vabits16,
                                       UWord dsm_num )
 {
-   UWord    sm_off, sm_off16;
+   UWord    sm_off;
    UWord    vabits2 = vabits16 & 0x3;
    SizeT    lenA, lenB, len_to_next_secmap;
    Addr     aNext;
@@ -1558,6 +2058,8 @@ static void set_address_range_perms ( Addr a, SizeT lenT, UWord vabits16,
 
    PROF_EVENT(150, "set_address_range_perms");
 
+   mark_lc_dirty_range(a, lenT);
+
    /* Check the V+A bits make sense. */
    tl_assert(VA_BITS16_NOACCESS  == vabits16 ||
              VA_BITS16_UNDEFINED == vabits16 ||
@@ -1600,6 +2102,8 @@ static void set_address_range_perms ( Addr a, SizeT lenT, UWord vabits16,
 
    /*------------------ standard handling ------------------ */
 
+   maybe_collapse_uniform_SMs();
+
    /* Get the distinguished secondary that we might want
       to use (part of the space-compression scheme). */
    example_dsm = &sm_distinguished[dsm_num];
@@ -1683,14 +2187,13 @@ static void set_address_range_perms ( Addr a, SizeT lenT, UWord vabits16,
       a    += 1;
       lenA -= 1;
    }
-   // 8-aligned, 8 byte steps
-   while (True) {
-      if (lenA < 8) break;
+   // 8-aligned, 8 byte steps, all done in one go
+   if (lenA >= 8) {
+      SizeT len8 = lenA & ~(SizeT)7;
       PROF_EVENT(157, "set_address_range_perms-loop8a");
-      sm_off16 = SM_OFF_16(a);
-      ((UShort*)(sm->vabits8))[sm_off16] = vabits16;
-      a    += 8;
-      lenA -= 8;
+      fill_vabits8( &(sm->vabits8[SM_OFF(a)]), len8 / 4, vabits16 & 0xFF );
+      a    += len8;
+      lenA -= len8;
    }
    // 1 byte steps
    while (True) {
@@ -1722,8 +2225,7 @@ static void set_address_range_perms ( Addr a, SizeT lenT, UWord vabits16,
          PROF_EVENT(160, "set_address_range_perms-loop64K-free-dist-sm");
          // Free the non-distinguished sec-map that we're replacing.  This
          // case happens moderately often, enough to be worthwhile.
-         SysRes sres = VG_(am_munmap_valgrind)((Addr)*sm_ptr, sizeof(SecMap));
-         tl_assert2(! sr_isError(sres), "SecMap valgrind munmap failure\n");
+         free_SM(*sm_ptr);
       }
       update_SM_counts(*sm_ptr, example_dsm);
       // Make the sec-map entry point to the example DSM
@@ -1756,14 +2258,13 @@ static void set_address_range_perms ( Addr a, SizeT lenT, UWord vabits16,
    }
    sm = *sm_ptr;
 
-   // 8-aligned, 8 byte steps
-   while (True) {
-      if (lenB < 8) break;
+   // 8-aligned, 8 byte steps, all done in one go
+   if (lenB >= 8) {
+      SizeT len8 = lenB & ~(SizeT)7;
       PROF_EVENT(163, "set_address_range_perms-loop8b");
-      sm_off16 = SM_OFF_16(a);
-      ((UShort*)(sm->vabits8))[sm_off16] = vabits16;
-      a    += 8;
-      lenB -= 8;
+      fill_vabits8( &(sm->vabits8[SM_OFF(a)]), len8 / 4, vabits16 & 0xFF );
+      a    += len8;
+      lenB -= len8;
    }
    // 1 byte steps
    while (True) {
@@ -1841,15 +2342,25 @@ void MC_(make_mem_defined) ( Addr a, SizeT len )
       ocache_sarp_Clear_Origins ( a, len );
 }
 
+static Bool is_mem_addressable ( Addr a, SizeT len, /*OUT*/Addr* bad_addr );
+
 /* For each byte in [a,a+len), if the byte is addressable, make it be
    defined, but if it isn't addressible, leave it alone.  In other
    words a version of MC_(make_mem_defined) that doesn't mess with
-   addressibility.  Low-performance implementation. */
+   addressibility.  Low-performance implementation, except when all of
+   the range is addressable. */
 static void make_mem_defined_if_addressable ( Addr a, SizeT len )
 {
    SizeT i;
    UChar vabits2;
+   Addr  bad_addr;
    DEBUG("make_mem_defined_if_addressable(%p, %llu)\n", a, (ULong)len);
+   /* Usually the whole range is addressable, as for a receive buffer,
+      and then it can be done at full speed. */
+   if (LIKELY(is_mem_addressable( a, len, &bad_addr ))) {
+      MC_(make_mem_defined)( a, len );
+      return;
+   }
    for (i = 0; i < len; i++) {
       vabits2 = get_vabits2( a+i );
       if (LIKELY(VA_BITS2_NOACCESS != vabits2)) {
@@ -1883,8 +2394,8 @@ static void make_mem_defined_if_noaccess ( Addr a, SizeT len )
 
 void MC_(copy_address_range_state) ( Addr src, Addr dst, SizeT len )
 {
-   SizeT i, j;
-   UChar vabits2, vabits8;
+   SizeT i, j, k;
+   UChar vabits2;
    Bool  aligned, nooverlap;
 
    DEBUG("MC_(copy_address_range_state)\n");
@@ -1893,34 +2404,57 @@ void MC_(copy_address_range_state) ( Addr src, Addr dst, SizeT len )
    if (len == 0 || src == dst)
       return;
 
+   mark_lc_dirty_range(dst, len);
+
    aligned   = VG_IS_4_ALIGNED(src) && VG_IS_4_ALIGNED(dst);
    nooverlap = src+len <= dst || dst+len <= src;
 
    if (nooverlap && aligned) {
 
-      /* Vectorised fast case, when no overlap and suitably aligned */
-      /* vector loop */
+      /* Fast case, when no overlap and suitably aligned.  Go a run at a
+         time, each run lying within one SecMap on both sides.  A run
+         from a distinguished SecMap is a plain range to set, which for
+         a whole SecMap means pointing dst's entry at the same
+         distinguished SecMap.  Otherwise the vabits8 are copied
+         wholesale, and only chunks holding partially defined bytes are
+         looked at a byte at a time. */
       i = 0;
       while (len >= 4) {
-         vabits8 = get_vabits8_for_aligned_word32( src+i );
-         set_vabits8_for_aligned_word32( dst+i, vabits8 );
-         if (LIKELY(VA_BITS8_DEFINED == vabits8 
-                            || VA_BITS8_UNDEFINED == vabits8 
-                            || VA_BITS8_NOACCESS == vabits8)) {
-            /* do nothing */
+         SecMap* src_sm = get_secmap_for_reading( src+i );
+         SizeT   n      = SM_SIZE - ((src+i) & SM_MASK);
+         SizeT   n_dst  = SM_SIZE - ((dst+i) & SM_MASK);
+         if (n > n_dst)
+            n = n_dst;
+         if (n > len)
+            n = len & ~(SizeT)3;
+         if (is_distinguished_sm(src_sm)) {
+            PROF_EVENT(53, "MC_(copy_address_range_state)(dist-run)");
+            if (src_sm == &sm_distinguished[SM_DIST_DEFINED])
+               set_address_range_perms( dst+i, n, VA_BITS16_DEFINED,
+                                        SM_DIST_DEFINED );
+            else if (src_sm == &sm_distinguished[SM_DIST_UNDEFINED])
+               set_address_range_perms( dst+i, n, VA_BITS16_UNDEFINED,
+                                        SM_DIST_UNDEFINED );
+            else
+               set_address_range_perms( dst+i, n, VA_BITS16_NOACCESS,
+                                        SM_DIST_NOACCESS );
          } else {
-            /* have to copy secondary map info */
-            if (VA_BITS2_PARTDEFINED == get_vabits2( src+i+0 ))
-               set_sec_vbits8( dst+i+0, get_sec_vbits8( src+i+0 ) );
-            if (VA_BITS2_PARTDEFINED == get_vabits2( src+i+1 ))
-               set_sec_vbits8( dst+i+1, get_sec_vbits8( src+i+1 ) );
-            if (VA_BITS2_PARTDEFINED == get_vabits2( src+i+2 ))
-               set_sec_vbits8( dst+i+2, get_sec_vbits8( src+i+2 ) );
-            if (VA_BITS2_PARTDEFINED == get_vabits2( src+i+3 ))
-               set_sec_vbits8( dst+i+3, get_sec_vbits8( src+i+3 ) );
+            SecMap* dst_sm = get_secmap_for_writing( dst+i );
+            UChar*  src8   = &src_sm->vabits8[SM_OFF(src+i)];
+            PROF_EVENT(54, "MC_(copy_address_range_state)(run)");
+            VG_(memcpy)( &dst_sm->vabits8[SM_OFF(dst+i)], src8, n / 4 );
+            for (j = 0; j < n / 4; j++) {
+               /* Any 11b pair means a partially defined byte. */
+               if (LIKELY((src8[j] & (src8[j] >> 1) & 0x55) == 0))
+                  continue;
+               for (k = 4*j; k < 4*j + 4; k++) {
+                  if (VA_BITS2_PARTDEFINED == get_vabits2( src+i+k ))
+                     set_sec_vbits8( dst+i+k, get_sec_vbits8( src+i+k ) );
+               }
+            }
          }
-         i += 4;
-         len -= 4;
+         i += n;
+         len -= n;
       }
       /* fixup loop */
       while (len >= 1) {
@@ -2281,6 +2815,8 @@ static UWord stats_ocacheL1_found_at_N     = 0;
 static UWord stats_ocacheL1_misses         = 0;
 static UWord stats_ocacheL1_lossage        = 0;
 static UWord stats_ocacheL1_movefwds       = 0;
+static UWord stats_ocacheL1_store_batches  = 0;
+static UWord stats_ocacheL1_batched_stores = 0;
 
 static UWord stats__ocacheL2_refs          = 0;
 static UWord stats__ocacheL2_misses        = 0;
@@ -2298,12 +2834,22 @@ static INLINE Bool is_valid_oc_tag ( Addr tag ) {
    return 0 == (tag & ((1 << OC_BITS_PER_LINE) - 1));
 }
 
-#define OC_LINES_PER_SET 2
+#define OC_LINES_PER_SET 4
 
-#define OC_N_SET_BITS    20
-#define OC_N_SETS        (1 << OC_N_SET_BITS)
+/* ocacheL1 starts with 2^OC_MIN_SET_BITS sets, so that programs with
+   a small working set don't pay for a big one.  Only a hit in line 0
+   of a set is handled inline; everything else, hits in the other
+   lines as well as misses, goes through find_OCacheLine_SLOW.  Every
+   2^OC_GROW_CHECK_BITS slow finds, if more than 1 in OC_GROW_SLOW_RATIO
+   of the finds since the last check were slow, it is given
+   2^OC_GROW_SET_BITS times as many sets, up to 2^OC_MAX_SET_BITS. */
+#define OC_MIN_SET_BITS      13
+#define OC_MAX_SET_BITS      19
+#define OC_GROW_SET_BITS     2
+#define OC_GROW_SLOW_RATIO   16
+#define OC_GROW_CHECK_BITS   16
 
-/* These settings give:
+/* At the largest, these settings give:
    64 bit host: ocache:  100,663,296 sizeB    67,108,864 useful
    32 bit host: ocache:   92,274,688 sizeB    67,108,864 useful
 */
@@ -2342,32 +2888,43 @@ typedef
    }
    OCacheSet;
 
-typedef
-   struct {
-      OCacheSet set[OC_N_SETS];
-   }
-   OCache;
+/* ocacheL1 is an array of oc_n_sets_mask+1 sets. */
+static OCacheSet* ocacheL1 = NULL;
+static UWord      oc_n_set_bits = 0;
+static UWord      oc_n_sets_mask = 0;
+static UWord      ocacheL1_event_ctr = 0;
 
-static OCache* ocacheL1 = NULL;
-static UWord   ocacheL1_event_ctr = 0;
+/* Stats: # times ocacheL1 was grown */
+static UWord stats_ocacheL1_grows = 0;
+/* # finds that missed line 0 of their set */
+static UWord ocacheL1_slow_finds = 0;
+/* stats_ocacheL1_find at the last check of the slow find rate */
+static UWord ocacheL1_finds_at_check = 0;
 
-static void init_ocacheL2 ( void ); /* fwds */
-static void init_OCache ( void )
+static OCacheSet* alloc_ocacheL1 ( UWord n_set_bits )
 {
-   UWord line, set;
-   tl_assert(MC_(clo_mc_level) >= 3);
-   tl_assert(ocacheL1 == NULL);
-   ocacheL1 = VG_(am_shadow_alloc)(sizeof(OCache));
-   if (ocacheL1 == NULL) {
-      VG_(out_of_memory_NORETURN)( "memcheck:allocating ocacheL1", 
-                                   sizeof(OCache) );
+   UWord      line, set;
+   SizeT      szB  = sizeof(OCacheSet) << n_set_bits;
+   OCacheSet* sets = VG_(am_shadow_alloc)(szB);
+   if (sets == NULL) {
+      VG_(out_of_memory_NORETURN)( "memcheck:allocating ocacheL1", szB );
    }
-   tl_assert(ocacheL1 != NULL);
-   for (set = 0; set < OC_N_SETS; set++) {
+   for (set = 0; set < ((UWord)1 << n_set_bits); set++) {
       for (line = 0; line < OC_LINES_PER_SET; line++) {
-         ocacheL1->set[set].line[line].tag = 1/*invalid*/;
+         sets[set].line[line].tag = 1/*invalid*/;
       }
    }
+   return sets;
+}
+
+static void init_ocacheL2 ( void ); /* fwds */
+static void init_OCache ( void )
+{
+   tl_assert(MC_(clo_mc_level) >= 3);
+   tl_assert(ocacheL1 == NULL);
+   ocacheL1       = alloc_ocacheL1(OC_MIN_SET_BITS);
+   oc_n_set_bits  = OC_MIN_SET_BITS;
+   oc_n_sets_mask = ((UWord)1 << OC_MIN_SET_BITS) - 1;
    init_ocacheL2();
 }
 
@@ -2462,44 +3019,12 @@ static void ocacheL2_add_line ( OCacheLine* line )
 ////
 //////////////////////////////////////////////////////////////
 
-__attribute__((noinline))
-static OCacheLine* find_OCacheLine_SLOW ( Addr a )
+/* Write 'victim', which is about to be thrown out of ocacheL1, back
+   to ocacheL2 as needed. */
+static void evict_OCacheLine ( OCacheLine* victim )
 {
-   OCacheLine *victim, *inL2;
-   UChar c;
-   UWord line;
-   UWord setno   = (a >> OC_BITS_PER_LINE) & (OC_N_SETS - 1);
-   UWord tagmask = ~((1 << OC_BITS_PER_LINE) - 1);
-   UWord tag     = a & tagmask;
-   tl_assert(setno >= 0 && setno < OC_N_SETS);
-
-   /* we already tried line == 0; skip therefore. */
-   for (line = 1; line < OC_LINES_PER_SET; line++) {
-      if (ocacheL1->set[setno].line[line].tag == tag) {
-         if (line == 1) {
-            stats_ocacheL1_found_at_1++;
-         } else {
-            stats_ocacheL1_found_at_N++;
-         }
-         if (UNLIKELY(0 == (ocacheL1_event_ctr++ 
-                            & ((1<<OC_MOVE_FORWARDS_EVERY_BITS)-1)))) {
-            moveLineForwards( &ocacheL1->set[setno], line );
-            line--;
-         }
-         return &ocacheL1->set[setno].line[line];
-      }
-   }
-
-   /* A miss.  Use the last slot.  Implicitly this means we're
-      ejecting the line in the last slot. */
-   stats_ocacheL1_misses++;
-   tl_assert(line == OC_LINES_PER_SET);
-   line--;
-   tl_assert(line > 0);
-
-   /* First, move the to-be-ejected line to the L2 cache. */
-   victim = &ocacheL1->set[setno].line[line];
-   c = classify_OCacheLine(victim);
+   OCacheLine* inL2;
+   UChar c = classify_OCacheLine(victim);
    switch (c) {
       case 'e':
          /* the line is empty (has invalid tag); ignore it. */
@@ -2526,43 +3051,135 @@ static OCacheLine* find_OCacheLine_SLOW ( Addr a )
       default:
          tl_assert(0);
    }
+}
+
+/* Give ocacheL1 2^OC_GROW_SET_BITS times as many sets, and move the
+   lines across, keeping their order within a set.  A set can't
+   overflow, since the lines in a new set all come from the same old
+   one. */
+__attribute__((noinline))
+static void grow_ocacheL1 ( void )
+{
+   UWord      set, line, i;
+   UWord      new_bits = oc_n_set_bits + OC_GROW_SET_BITS;
+   UWord      new_mask = ((UWord)1 << new_bits) - 1;
+   OCacheSet* old      = ocacheL1;
+   OCacheSet* nyu      = alloc_ocacheL1(new_bits);
+   SysRes     sres;
+
+   for (set = 0; set <= oc_n_sets_mask; set++) {
+      for (line = 0; line < OC_LINES_PER_SET; line++) {
+         OCacheLine* ol = &old[set].line[line];
+         OCacheSet*  ns;
+         if (ol->tag == 1/*invalid*/)
+            continue;
+         ns = &nyu[(ol->tag >> OC_BITS_PER_LINE) & new_mask];
+         for (i = 0; i < OC_LINES_PER_SET; i++) {
+            if (ns->line[i].tag == 1/*invalid*/)
+               break;
+         }
+         tl_assert(i < OC_LINES_PER_SET);
+         ns->line[i] = *ol;
+      }
+   }
+
+   sres = VG_(am_munmap_valgrind)( (Addr)old,
+                                   sizeof(OCacheSet) << oc_n_set_bits );
+   tl_assert(!sr_isError(sres));
+   ocacheL1       = nyu;
+   oc_n_set_bits  = new_bits;
+   oc_n_sets_mask = new_mask;
+   stats_ocacheL1_grows++;
+}
+
+__attribute__((noinline))
+static OCacheLine* find_OCacheLine_SLOW ( Addr a )
+{
+   OCacheLine *inL2;
+   OCacheSet* set;
+   UWord line;
+   UWord setno   = (a >> OC_BITS_PER_LINE) & oc_n_sets_mask;
+   UWord tagmask = ~((1 << OC_BITS_PER_LINE) - 1);
+   UWord tag     = a & tagmask;
+   tl_assert(setno >= 0 && setno <= oc_n_sets_mask);
+
+   /* If too many finds have missed line 0 lately, the sets are
+      probably too few for the working set, so try a bigger L1. */
+   if (UNLIKELY(0 == (++ocacheL1_slow_finds
+                      & ((1 << OC_GROW_CHECK_BITS) - 1)))) {
+      UWord finds = stats_ocacheL1_find - ocacheL1_finds_at_check;
+      ocacheL1_finds_at_check = stats_ocacheL1_find;
+      if (oc_n_set_bits < OC_MAX_SET_BITS
+          && finds < ((UWord)OC_GROW_SLOW_RATIO << OC_GROW_CHECK_BITS)) {
+         grow_ocacheL1();
+         setno = (a >> OC_BITS_PER_LINE) & oc_n_sets_mask;
+         /* Growing keeps the order of lines within a set, so 'a' may
+            now be in line 0 of its new set. */
+         if (ocacheL1[setno].line[0].tag == tag)
+            return &ocacheL1[setno].line[0];
+      }
+   }
+   set = &ocacheL1[setno];
+
+   /* we already tried line == 0; skip therefore. */
+   for (line = 1; line < OC_LINES_PER_SET; line++) {
+      if (set->line[line].tag == tag) {
+         if (line == 1) {
+            stats_ocacheL1_found_at_1++;
+         } else {
+            stats_ocacheL1_found_at_N++;
+         }
+         if (UNLIKELY(0 == (ocacheL1_event_ctr++ 
+                            & ((1<<OC_MOVE_FORWARDS_EVERY_BITS)-1)))) {
+            moveLineForwards( set, line );
+            line--;
+         }
+         return &set->line[line];
+      }
+   }
+
+   /* A miss.  Implicitly this means we're ejecting the line in the
+      last slot. */
+   stats_ocacheL1_misses++;
+   tl_assert(line == OC_LINES_PER_SET);
+
+   /* First, move the to-be-ejected line to the L2 cache, and make
+      room for the new one at the front of the set. */
+   evict_OCacheLine( &set->line[OC_LINES_PER_SET-1] );
+   for (line = OC_LINES_PER_SET-1; line > 0; line--)
+      set->line[line] = set->line[line-1];
 
    /* Now we must reload the L1 cache from the backing tree, if
       possible. */
-   tl_assert(tag != victim->tag); /* stay sane */
    inL2 = ocacheL2_find_tag( tag );
    if (inL2) {
       /* We're in luck.  It's in the L2. */
-      ocacheL1->set[setno].line[line] = *inL2;
+      set->line[0] = *inL2;
    } else {
       /* Missed at both levels of the cache hierarchy.  We have to
          declare it as full of zeroes (unknown origins). */
       stats__ocacheL2_misses++;
-      zeroise_OCacheLine( &ocacheL1->set[setno].line[line], tag );
+      zeroise_OCacheLine( &set->line[0], tag );
    }
 
-   /* Move it one forwards */
-   moveLineForwards( &ocacheL1->set[setno], line );
-   line--;
-
-   return &ocacheL1->set[setno].line[line];
+   return &set->line[0];
 }
 
 static INLINE OCacheLine* find_OCacheLine ( Addr a )
 {
-   UWord setno   = (a >> OC_BITS_PER_LINE) & (OC_N_SETS - 1);
+   UWord setno   = (a >> OC_BITS_PER_LINE) & oc_n_sets_mask;
    UWord tagmask = ~((1 << OC_BITS_PER_LINE) - 1);
    UWord tag     = a & tagmask;
 
    stats_ocacheL1_find++;
 
    if (OC_ENABLE_ASSERTIONS) {
-      tl_assert(setno >= 0 && setno < OC_N_SETS);
+      tl_assert(setno >= 0 && setno <= oc_n_sets_mask);
       tl_assert(0 == (tag & (4 * OC_W32S_PER_LINE - 1)));
    }
 
-   if (LIKELY(ocacheL1->set[setno].line[0].tag == tag)) {
-      return &ocacheL1->set[setno].line[0];
+   if (LIKELY(ocacheL1[setno].line[0].tag == tag)) {
+      return &ocacheL1[setno].line[0];
    }
 
    return find_OCacheLine_SLOW( a );
@@ -3753,7 +4370,9 @@ Bool MC_(check_mem_is_noaccess) ( Addr a, SizeT len, Addr* bad_addr )
    UWord vabits2;
 
    PROF_EVENT(60, "check_mem_is_noaccess");
-   for (i = 0; i < len; i++) {
+   i = vabits_ok_prefix(a, len, VA_BITS8_NOACCESS, False);
+   a += i;
+   for (; i < len; i++) {
       PROF_EVENT(61, "check_mem_is_noaccess(loop)");
       vabits2 = get_vabits2(a);
       if (VA_BITS2_NOACCESS != vabits2) {
@@ -3772,7 +4391,9 @@ static Bool is_mem_addressable ( Addr a, SizeT len,
    UWord vabits2;
 
    PROF_EVENT(62, "is_mem_addressable");
-   for (i = 0; i < len; i++) {
+   i = vabits_ok_prefix(a, len, 0, True);
+   a += i;
+   for (; i < len; i++) {
       PROF_EVENT(63, "is_mem_addressable(loop)");
       vabits2 = get_vabits2(a);
       if (VA_BITS2_NOACCESS == vabits2) {
@@ -3791,7 +4412,9 @@ static Bool is_mem_undefined ( Addr a, SizeT len,
    UWord vabits2;
 
    PROF_EVENT(68, "is_mem_undefined");
-   for (i = 0; i < len; i++) {
+   i = vabits_ok_prefix(a, len, VA_BITS8_UNDEFINED, False);
+   a += i;
+   for (; i < len; i++) {
       PROF_EVENT(69, "is_mem_undefined(loop)");
       vabits2 = get_vabits2(a);
       if (VA_BITS2_UNDEFINED != vabits2) {
@@ -3815,7 +4438,11 @@ static MC_ReadResult is_mem_defined ( Addr a, SizeT len,
 
    if (otag)     *otag = 0;
    if (bad_addr) *bad_addr = 0;
-   for (i = 0; i < len; i++) {
+   // Without --undef-value-errors only addressability matters, so
+   // skip over anything that isn't noaccess.
+   i = vabits_ok_prefix(a, len, VA_BITS8_DEFINED, MC_(clo_mc_level) == 1);
+   a += i;
+   for (; i < len; i++) {
       PROF_EVENT(65, "is_mem_defined(loop)");
       vabits2 = get_vabits2(a);
       if (VA_BITS2_DEFINED != vabits2) {
@@ -4003,6 +4630,58 @@ void check_mem_is_defined ( CorePart part, ThreadId tid, const HChar* s,
    }
 }
 
+/* The buffers of an iovec, as passed to readv, writev and the like.
+   's' has a "%u" standing for the index of the buffer, which is only
+   filled in if there is an error to report. */
+static
+void check_iov_is_addressable ( CorePart part, ThreadId tid, const HChar* s,
+                                const struct vki_iovec* iov, UInt n_iov,
+                                SizeT max_len )
+{
+   Addr  bad_addr;
+   SizeT len;
+   UInt  i;
+
+   tl_assert(part == Vg_CoreSysCall);
+   for (i = 0; i < n_iov && max_len > 0; i++) {
+      len = iov[i].iov_len < max_len ? iov[i].iov_len : max_len;
+      max_len -= len;
+      if (!is_mem_addressable ( (Addr)iov[i].iov_base, len, &bad_addr )) {
+         HChar name[VG_(strlen)(s) + 11];
+         VG_(sprintf) ( name, s, i );
+         MC_(record_memparam_error) ( tid, bad_addr, 
+                                      /*isAddrErr*/True, name, 0/*otag*/ );
+      }
+   }
+}
+
+static
+void check_iov_is_defined ( CorePart part, ThreadId tid, const HChar* s,
+                            const struct vki_iovec* iov, UInt n_iov,
+                            SizeT max_len )
+{
+   UInt  otag;
+   Addr  bad_addr;
+   SizeT len;
+   UInt  i;
+   MC_ReadResult res;
+
+   tl_assert(part == Vg_CoreSysCall);
+   for (i = 0; i < n_iov && max_len > 0; i++) {
+      len = iov[i].iov_len < max_len ? iov[i].iov_len : max_len;
+      max_len -= len;
+      otag = 0;
+      res = is_mem_defined ( (Addr)iov[i].iov_base, len, &bad_addr, &otag );
+      if (MC_Ok != res) {
+         Bool isAddrErr = ( MC_AddrErr == res ? True : False );
+         HChar name[VG_(strlen)(s) + 11];
+         VG_(sprintf) ( name, s, i );
+         MC_(record_memparam_error) ( tid, bad_addr, isAddrErr, name,
+                                      isAddrErr ? 0 : otag );
+      }
+   }
+}
+
 static
 void check_mem_is_defined_asciiz ( CorePart part, ThreadId tid,
                                    const HChar* s, Addr str )
@@ -4087,9 +4766,20 @@ void mc_new_mem_mmap ( Addr a, SizeT len, Bool rr, Bool ww, Bool xx,
    }
 }
 
+static
+void mc_die_mem_munmap ( Addr a, SizeT len )
+{
+   MC_(make_mem_noaccess)(a, len);
+   /* Whatever is mapped here next is scanned by leak searches. */
+   MC_(leak_check_ignore_range)(a, len, /*ignore*/False);
+}
+
 static
 void mc_new_mem_mprotect ( Addr a, SizeT len, Bool rr, Bool ww, Bool xx )
 {
+   /* Whether the leak checker may read the range has changed. */
+   mark_lc_dirty_range(a, len);
+
    if (rr || ww || xx) {
       /* (4) mprotect other  ->  change any "noaccess" to "defined" */
       make_mem_defined_if_noaccess(a, len);
@@ -4130,6 +4820,21 @@ void mc_post_mem_write(CorePart part, ThreadId tid, Addr a, SizeT len)
    MC_(make_mem_defined)(a, len);
 }
 
+static
+void mc_post_mem_write_iov(CorePart part, ThreadId tid,
+                           const struct vki_iovec* iov, UInt n_iov,
+                           SizeT max_len)
+{
+   SizeT len;
+   UInt  i;
+
+   for (i = 0; i < n_iov && max_len > 0; i++) {
+      len = iov[i].iov_len < max_len ? iov[i].iov_len : max_len;
+      max_len -= len;
+      MC_(make_mem_defined)((Addr)iov[i].iov_base, len);
+   }
+}
+
 
 /*------------------------------------------------------------*/
 /*--- Register event handlers                              ---*/
@@ -4375,6 +5080,16 @@ VG_REGPARM(2) void MC_(helperc_LOADV128le) ( /*OUT*/V128* res, Addr a )
    mc_LOADV_128_or_256(&res->w64[0], a, 128, False);
 }
 
+Addr MC_(primary_map_base) ( void )
+{
+   return (Addr)&primary_map[0];
+}
+
+Addr MC_(max_primary_address) ( void )
+{
+   return MAX_PRIMARY_ADDRESS;
+}
+
 /* ------------------------ Size = 8 ------------------------ */
 
 static INLINE
@@ -4443,13 +5158,14 @@ void mc_STOREV64 ( Addr a, ULong vbits64, Bool isBigEndian )
          mc_STOREVn_slow( a, 64, vbits64, isBigEndian );
          return;
       }
+      MARK_LC_DIRTY_LOW(a);
 
       sm       = get_secmap_for_reading_low(a);
       sm_off16 = SM_OFF_16(a);
       vabits16 = ((UShort*)(sm->vabits8))[sm_off16];
 
       // To understand the below cleverness, see the extensive comments
-      // in MC_(helperc_STOREV8).
+      // in mc_STOREV8.
       if (LIKELY(V_BITS64_DEFINED == vbits64)) {
          if (LIKELY(vabits16 == (UShort)VA_BITS16_DEFINED)) {
             return;
@@ -4490,6 +5206,19 @@ VG_REGPARM(1) void MC_(helperc_STOREV64le) ( Addr a, ULong vbits64 )
    mc_STOREV64(a, vbits64, False);
 }
 
+/* Variants for data the instrumenter already knows to be all defined:
+   stores of constants, and all stores when definedness isn't being
+   tracked.  With the V bits a constant, the store folds down to the
+   defined-on-defined test and the direct mod. */
+VG_REGPARM(1) void MC_(helperc_STOREV64be_defined) ( Addr a )
+{
+   mc_STOREV64(a, V_BITS64_DEFINED, True);
+}
+VG_REGPARM(1) void MC_(helperc_STOREV64le_defined) ( Addr a )
+{
+   mc_STOREV64(a, V_BITS64_DEFINED, False);
+}
+
 
 /* ------------------------ Size = 4 ------------------------ */
 
@@ -4559,13 +5288,14 @@ void mc_STOREV32 ( Addr a, UWord vbits32, Bool isBigEndian )
          mc_STOREVn_slow( a, 32, (ULong)vbits32, isBigEndian );
          return;
       }
+      MARK_LC_DIRTY_LOW(a);
 
       sm      = get_secmap_for_reading_low(a);
       sm_off  = SM_OFF(a);
       vabits8 = sm->vabits8[sm_off];
 
       // To understand the below cleverness, see the extensive comments
-      // in MC_(helperc_STOREV8).
+      // in mc_STOREV8.
       if (LIKELY(V_BITS32_DEFINED == vbits32)) {
          if (LIKELY(vabits8 == (UInt)VA_BITS8_DEFINED)) {
             return;
@@ -4605,6 +5335,14 @@ VG_REGPARM(2) void MC_(helperc_STOREV32le) ( Addr a, UWord vbits32 )
 {
    mc_STOREV32(a, vbits32, False);
 }
+VG_REGPARM(1) void MC_(helperc_STOREV32be_defined) ( Addr a )
+{
+   mc_STOREV32(a, V_BITS32_DEFINED, True);
+}
+VG_REGPARM(1) void MC_(helperc_STOREV32le_defined) ( Addr a )
+{
+   mc_STOREV32(a, V_BITS32_DEFINED, False);
+}
 
 
 /* ------------------------ Size = 2 ------------------------ */
@@ -4689,13 +5427,14 @@ void mc_STOREV16 ( Addr a, UWord vbits16, Bool isBigEndian )
          mc_STOREVn_slow( a, 16, (ULong)vbits16, isBigEndian );
          return;
       }
+      MARK_LC_DIRTY_LOW(a);
 
       sm      = get_secmap_for_reading_low(a);
       sm_off  = SM_OFF(a);
       vabits8 = sm->vabits8[sm_off];
 
       // To understand the below cleverness, see the extensive comments
-      // in MC_(helperc_STOREV8).
+      // in mc_STOREV8.
       if (LIKELY(V_BITS16_DEFINED == vbits16)) {
          if (LIKELY(vabits8 == VA_BITS8_DEFINED)) {
             return;
@@ -4738,6 +5477,14 @@ VG_REGPARM(2) void MC_(helperc_STOREV16le) ( Addr a, UWord vbits16 )
 {
    mc_STOREV16(a, vbits16, False);
 }
+VG_REGPARM(1) void MC_(helperc_STOREV16be_defined) ( Addr a )
+{
+   mc_STOREV16(a, V_BITS16_DEFINED, True);
+}
+VG_REGPARM(1) void MC_(helperc_STOREV16le_defined) ( Addr a )
+{
+   mc_STOREV16(a, V_BITS16_DEFINED, False);
+}
 
 
 /* ------------------------ Size = 1 ------------------------ */
@@ -4785,8 +5532,8 @@ UWord MC_(helperc_LOADV8) ( Addr a )
 }
 
 
-VG_REGPARM(2)
-void MC_(helperc_STOREV8) ( Addr a, UWord vbits8 )
+static INLINE
+void mc_STOREV8 ( Addr a, UWord vbits8 )
 {
    PROF_EVENT(270, "mc_STOREV8");
 
@@ -4802,6 +5549,7 @@ void MC_(helperc_STOREV8) ( Addr a, UWord vbits8 )
          mc_STOREVn_slow( a, 8, (ULong)vbits8, False/*irrelevant*/ );
          return;
       }
+      MARK_LC_DIRTY_LOW(a);
 
       sm      = get_secmap_for_reading_low(a);
       sm_off  = SM_OFF(a);
@@ -4882,6 +5630,15 @@ void MC_(helperc_STOREV8) ( Addr a, UWord vbits8 )
 #endif
 }
 
+VG_REGPARM(2) void MC_(helperc_STOREV8) ( Addr a, UWord vbits8 )
+{
+   mc_STOREV8(a, vbits8);
+}
+VG_REGPARM(1) void MC_(helperc_STOREV8_defined) ( Addr a )
+{
+   mc_STOREV8(a, V_BITS8_DEFINED);
+}
+
 
 /*------------------------------------------------------------*/
 /*--- Functions called directly from generated code:       ---*/
@@ -5038,6 +5795,59 @@ Bool MC_(is_valid_aligned_word) ( Addr a )
       return True;
 }
 
+/* Find the secmap for reading |a| without going through the auxmap's
+   self-organising L1 cache, which would be a data race between leak
+   check workers.  The L2 lookup is read-only. */
+static const SecMap* get_secmap_for_reading_MT ( Addr a, MC_SecMapCache* c )
+{
+   AuxMapEnt  key;
+   AuxMapEnt* res;
+
+   if (a <= MAX_PRIMARY_ADDRESS)
+      return primary_map[ a >> 16 ];
+
+   a &= ~(Addr)0xFFFF;
+   if (c->base == a)
+      return c->sm;
+   key.base = a;
+   key.sm   = 0;
+   res = VG_(OSetGen_Lookup)(auxmap_L2, &key);
+   c->base = a;
+   c->sm   = res ? res->sm : &sm_distinguished[SM_DIST_NOACCESS];
+   return c->sm;
+}
+
+void MC_(init_SecMapCache) ( MC_SecMapCache* c )
+{
+   /* No auxmap entry has this base, as it isn't 64k-aligned. */
+   c->base = 1;
+   c->sm   = NULL;
+}
+
+Bool MC_(is_within_valid_secondary_MT) ( Addr a, MC_SecMapCache* c )
+{
+   return get_secmap_for_reading_MT(a, c)
+          != &sm_distinguished[SM_DIST_NOACCESS];
+}
+
+Bool MC_(is_valid_aligned_word_MT) ( Addr a, MC_SecMapCache* c )
+{
+   const SecMap* sm;
+   tl_assert(VG_IS_WORD_ALIGNED(a));
+   sm = get_secmap_for_reading_MT(a, c);
+   if (sm->vabits8[SM_OFF(a)] != VA_BITS8_DEFINED)
+      return False;
+   if (sizeof(UWord) == 8) {
+      /* a+4 is in the same secmap, as a is 8-aligned. */
+      if (sm->vabits8[SM_OFF(a + 4)] != VA_BITS8_DEFINED)
+         return False;
+   }
+   if (UNLIKELY(MC_(in_ignored_range)(a)))
+      return False;
+   else
+      return True;
+}
+
 
 /*------------------------------------------------------------*/
 /*--- Initialisation                                       ---*/
@@ -5208,12 +6018,20 @@ VgRes         MC_(clo_leak_resolution)        = Vg_HighRes;
 UInt          MC_(clo_show_leak_kinds)        = R2S(Possible) | R2S(Unreached);
 UInt          MC_(clo_error_for_leak_kinds)   = R2S(Possible) | R2S(Unreached);
 UInt          MC_(clo_leak_check_heuristics)  = 0;
+Int           MC_(clo_leak_check_threads)     = 1;
+Bool          MC_(clo_incremental_leak_check) = False;
 Bool          MC_(clo_workaround_gcc296_bugs) = False;
 Int           MC_(clo_malloc_fill)            = -1;
 Int           MC_(clo_free_fill)              = -1;
 KeepStacktraces MC_(clo_keep_stacktraces)     = KS_alloc_then_free;
 Int           MC_(clo_mc_level)               = 2;
+Int           MC_(clo_definedness_sampling)   = 100;
+Bool          MC_(clo_adaptive_definedness_checks) = False;
 Bool          MC_(clo_show_mismatched_frees)  = True;
+Bool          MC_(clo_collapse_secmaps)       = True;
+Bool          MC_(clo_inline_shadow_access)   = False;
+Bool          MC_(clo_heap_profile)           = False;
+const HChar*  MC_(clo_heap_profile_out_file)  = "massif.out.%p";
 
 static const HChar * MC_(parse_leak_heuristics_tokens) =
    "-,stdstring,length64,newarray,multipleinheritance";
@@ -5314,6 +6132,16 @@ static Bool mc_process_cmd_line_options(const HChar* arg)
    else if VG_XACT_CLO(arg, "--leak-resolution=high",
                             MC_(clo_leak_resolution), Vg_HighRes) {}
 
+   else if VG_BINT_CLO(arg, "--definedness-sampling",
+                            MC_(clo_definedness_sampling), 0, 100) {}
+   else if VG_BOOL_CLO(arg, "--adaptive-definedness-checks",
+                            MC_(clo_adaptive_definedness_checks)) {}
+
+   else if VG_BINT_CLO(arg, "--leak-check-threads",
+                            MC_(clo_leak_check_threads), 1, 64) {}
+   else if VG_BOOL_CLO(arg, "--incremental-leak-check",
+                            MC_(clo_incremental_leak_check)) {}
+
    else if VG_STR_CLO(arg, "--ignore-ranges", tmp_str) {
       Bool ok = parse_ignore_ranges(tmp_str);
       if (!ok) {
@@ -5360,6 +6188,13 @@ static Bool mc_process_cmd_line_options(const HChar* arg)
 
    else if VG_BOOL_CLO(arg, "--show-mismatched-frees",
                        MC_(clo_show_mismatched_frees)) {}
+   else if VG_BOOL_CLO(arg, "--collapse-secmaps",
+                       MC_(clo_collapse_secmaps)) {}
+   else if VG_BOOL_CLO(arg, "--inline-shadow-access",
+                       MC_(clo_inline_shadow_access)) {}
+   else if VG_BOOL_CLO(arg, "--heap-profile", MC_(clo_heap_profile)) {}
+   else if VG_STR_CLO(arg, "--heap-profile-out-file",
+                      MC_(clo_heap_profile_out_file)) {}
 
    else
       return VG_(replacement_malloc_process_cmd_line_option)(arg);
@@ -5392,6 +6227,9 @@ static void mc_print_usage(void)
 "        improving leak search false positive [none]\n"
 "        where heur is one of:\n"
 "          stdstring length64 newarray multipleinheritance all none\n"
+"    --leak-check-threads=<number>    threads marking reachable blocks [1]\n"
+"    --incremental-leak-check=no|yes  only rescan memory written since the\n"
+"                                     last leak search? [no]\n"
 "    --show-reachable=yes             same as --show-leak-kinds=all\n"
 "    --show-reachable=no --show-possibly-lost=yes\n"
 "                                     same as --show-leak-kinds=definite,possible\n"
@@ -5399,6 +6237,11 @@ static void mc_print_usage(void)
 "                                     same as --show-leak-kinds=definite\n"
 "    --undef-value-errors=no|yes      check for undefined value errors [yes]\n"
 "    --track-origins=no|yes           show origins of undefined values? [no]\n"
+"    --definedness-sampling=<0..100>  percentage of code in which undefined\n"
+"                                     values are tracked [100]\n"
+"    --adaptive-definedness-checks=no|yes  recheck code that gives an\n"
+"                                     undefined value error more precisely\n"
+"                                     before reporting it [no]\n"
 "    --partial-loads-ok=no|yes        too hard to explain here; see manual [%s]\n"
 "    --freelist-vol=<number>          volume of freed blocks queue     [20000000]\n"
 "    --freelist-big-blocks=<number>   releases first blocks with size>= [1000000]\n"
@@ -5409,6 +6252,14 @@ static void mc_print_usage(void)
 "    --keep-stacktraces=alloc|free|alloc-and-free|alloc-then-free|none\n"
 "        stack trace(s) to keep for malloc'd/free'd areas       [alloc-then-free]\n"
 "    --show-mismatched-frees=no|yes   show frees that don't match the allocator? [yes]\n"
+"    --collapse-secmaps=no|yes        free shadow memory which has become\n"
+"                                     uniform again? [yes]\n"
+"    --inline-shadow-access=no|yes    do common shadow loads and stores\n"
+"                                     without calling a helper? [no]\n"
+"    --heap-profile=no|yes            write the heap size over time and the\n"
+"                                     allocation stacks using it, in massif's\n"
+"                                     format? [no]\n"
+"    --heap-profile-out-file=<file>   file for --heap-profile [massif.out.%%p]\n"
 , plo_default
    );
 }
@@ -5837,6 +6688,136 @@ static Bool handle_gdb_monitor_command (ThreadId tid, HChar *req)
 /*--- Client requests                                      ---*/
 /*------------------------------------------------------------*/
 
+/* VG_USERREQ__CHECK_MEM_IS_DEFINED: report any errors, and return the
+   lower of the two erring addresses, if any. */
+static UWord client_check_mem_is_defined ( ThreadId tid, Addr a, SizeT len )
+{
+   Bool errorV    = False;
+   Addr bad_addrV = 0;
+   UInt otagV     = 0;
+   Bool errorA    = False;
+   Addr bad_addrA = 0;
+   is_mem_defined_comprehensive( 
+      a, len,
+      &errorV, &bad_addrV, &otagV, &errorA, &bad_addrA
+   );
+   if (errorV) {
+      MC_(record_user_error) ( tid, bad_addrV,
+                               /*isAddrErr*/False, otagV );
+   }
+   if (errorA) {
+      MC_(record_user_error) ( tid, bad_addrA,
+                               /*isAddrErr*/True, 0 );
+   }
+   if (errorV && errorA)
+      return bad_addrV < bad_addrA ? bad_addrV : bad_addrA;
+   if (errorV)
+      return bad_addrV;
+   if (errorA)
+      return bad_addrA;
+   return 0;
+}
+
+/* The _EXTENTS requests: apply the check or marking to 'nExt'
+   (offset, length) pairs at 'ext', for each of 'count' elements
+   starting at 'base', 'stride' bytes apart.  The checks stop at the
+   first range with an error.  Elements which are a single range
+   filling the stride are done as one range, which is the common case
+   of an array of a basic type. */
+static UWord client_do_extents ( ThreadId tid, UWord req, Addr base,
+                                 Addr ext_addr, UWord nExt, UWord count,
+                                 UWord stride )
+{
+   const UWord* ext = (const UWord*)ext_addr;
+   UWord i, j, res;
+   Addr  bad_addr;
+
+   if (nExt == 0 || count == 0)
+      return 0;
+   if (nExt > (~(UWord)0) / (2 * sizeof(UWord))
+       || !VG_(am_is_valid_for_client)( ext_addr, nExt * 2 * sizeof(UWord),
+                                        VKI_PROT_READ )) {
+      MC_(record_user_error) ( tid, ext_addr, /*isAddrErr*/True, 0 );
+      return ext_addr;
+   }
+   if (nExt == 1 && ext[0] == 0 && ext[1] == stride
+       && count <= (~(UWord)0) / stride) {
+      ext   = NULL;
+      nExt  = count * stride;
+      count = 1;
+   }
+
+   for (i = 0; i < count; i++) {
+      Addr elem = base + i * stride;
+      for (j = 0; j < (ext ? nExt : 1); j++) {
+         Addr  a   = ext ? elem + ext[2*j] : elem;
+         SizeT len = ext ? ext[2*j+1] : nExt;
+         if (len == 0)
+            continue;
+         switch (req) {
+            case VG_USERREQ__CHECK_MEM_EXTENTS_ARE_ADDRESSABLE:
+               if (!is_mem_addressable ( a, len, &bad_addr )) {
+                  MC_(record_user_error) ( tid, bad_addr,
+                                           /*isAddrErr*/True, 0 );
+                  return bad_addr;
+               }
+               break;
+            case VG_USERREQ__CHECK_MEM_EXTENTS_ARE_DEFINED:
+               res = client_check_mem_is_defined ( tid, a, len );
+               if (res != 0)
+                  return res;
+               break;
+            case VG_USERREQ__MAKE_MEM_EXTENTS_DEFINED_IF_ADDRESSABLE:
+               make_mem_defined_if_addressable ( a, len );
+               break;
+            default:
+               tl_assert(0);
+         }
+      }
+   }
+   return 0;
+}
+
+/* VG_USERREQ__MAKE_MEM_BATCH: apply 'n' (address, length, state)
+   triples at 'triples_addr'.  Stops at the first bad state. */
+static void client_make_mem_batch ( ThreadId tid, Addr triples_addr, UWord n )
+{
+   const UWord* t = (const UWord*)triples_addr;
+   UWord i;
+
+   if (n == 0)
+      return;
+   if (n > (~(UWord)0) / (3 * sizeof(UWord))
+       || !VG_(am_is_valid_for_client)( triples_addr, n * 3 * sizeof(UWord),
+                                        VKI_PROT_READ )) {
+      MC_(record_user_error) ( tid, triples_addr, /*isAddrErr*/True, 0 );
+      return;
+   }
+
+   for (i = 0; i < n; i++, t += 3) {
+      switch (t[2]) {
+         case VALGRIND_MEM_NOACCESS:
+            MC_(make_mem_noaccess) ( t[0], t[1] );
+            break;
+         case VALGRIND_MEM_UNDEFINED:
+            make_mem_undefined_w_tid_and_okind ( t[0], t[1], tid,
+                                                 MC_OKIND_USER );
+            break;
+         case VALGRIND_MEM_DEFINED:
+            MC_(make_mem_defined) ( t[0], t[1] );
+            break;
+         case VALGRIND_MEM_DEFINED_IF_ADDRESSABLE:
+            make_mem_defined_if_addressable ( t[0], t[1] );
+            break;
+         default:
+            VG_(message)(Vg_UserMsg, 
+                         "Warning: unknown state %lu in "
+                         "VALGRIND_MAKE_MEM_BATCH\n", t[2]);
+            return;
+      }
+   }
+}
+
 static Bool mc_handle_client_request ( ThreadId tid, UWord* arg, UWord* ret )
 {
    Int   i;
@@ -5880,37 +6861,16 @@ static Bool mc_handle_client_request ( ThreadId tid, UWord* arg, UWord* ret )
          break;
       }
 
-      case VG_USERREQ__CHECK_MEM_IS_DEFINED: {
-         Bool errorV    = False;
-         Addr bad_addrV = 0;
-         UInt otagV     = 0;
-         Bool errorA    = False;
-         Addr bad_addrA = 0;
-         is_mem_defined_comprehensive( 
-            arg[1], arg[2],
-            &errorV, &bad_addrV, &otagV, &errorA, &bad_addrA
-         );
-         if (errorV) {
-            MC_(record_user_error) ( tid, bad_addrV,
-                                     /*isAddrErr*/False, otagV );
-         }
-         if (errorA) {
-            MC_(record_user_error) ( tid, bad_addrA,
-                                     /*isAddrErr*/True, 0 );
-         }
-         /* Return the lower of the two erring addresses, if any. */
-         *ret = 0;
-         if (errorV && !errorA) {
-            *ret = bad_addrV;
-         }
-         if (!errorV && errorA) {
-            *ret = bad_addrA;
-         }
-         if (errorV && errorA) {
-            *ret = bad_addrV < bad_addrA ? bad_addrV : bad_addrA;
-         }
+      case VG_USERREQ__CHECK_MEM_IS_DEFINED:
+         *ret = client_check_mem_is_defined ( tid, arg[1], arg[2] );
+         break;
+
+      case VG_USERREQ__CHECK_MEM_EXTENTS_ARE_ADDRESSABLE:
+      case VG_USERREQ__CHECK_MEM_EXTENTS_ARE_DEFINED:
+      case VG_USERREQ__MAKE_MEM_EXTENTS_DEFINED_IF_ADDRESSABLE:
+         *ret = client_do_extents ( tid, arg[0], arg[1], arg[2], arg[3],
+                                    arg[4], arg[5] );
          break;
-      }
 
       case VG_USERREQ__DO_LEAK_CHECK: {
          LeakCheckParams lcp;
@@ -5970,6 +6930,19 @@ static Bool mc_handle_client_request ( ThreadId tid, UWord* arg, UWord* ret )
          *ret = -1;
          break;
 
+      case VG_USERREQ__MAKE_MEM_BATCH:
+         client_make_mem_batch ( tid, arg[1], arg[2] );
+         *ret = -1;
+         break;
+
+      case VG_USERREQ__LEAK_CHECK_IGNORE_RANGE:
+      case VG_USERREQ__LEAK_CHECK_UNIGNORE_RANGE:
+         MC_(leak_check_ignore_range)
+            ( arg[1], arg[2],
+              arg[0] == VG_USERREQ__LEAK_CHECK_IGNORE_RANGE );
+         *ret = -1;
+         break;
+
       case VG_USERREQ__CREATE_BLOCK: /* describe a block */
          if (arg[1] != 0 && arg[2] != 0) {
             i = alloc_client_block();
@@ -6497,6 +7470,34 @@ void VG_REGPARM(2) MC_(helperc_b_store32)( Addr a, UWord d32 ) {
    MC_(helperc_b_store8)( a + 24, d32 );
 }
 
+void VG_REGPARM(2) MC_(helperc_b_store_batch)( Addr base, UWord layout,
+                                               UWord d01, UWord d23 ) {
+   UWord i, d32;
+   UWord n = (layout & 3) + 1;
+
+   if (OC_ENABLE_ASSERTIONS) {
+      tl_assert(n >= 2 && n <= MC_B_BATCH_MAX);
+   }
+   stats_ocacheL1_store_batches++;
+   stats_ocacheL1_batched_stores += n;
+
+   for (i = 0; i < n; i++) {
+      UWord descr = layout >> (2 + 10 * i);
+      Addr  a     = base + (Word)(Char)(descr >> 2);
+#     if VG_WORDSIZE == 8
+      d32 = ((i < 2 ? d01 : d23) >> (32 * (i & 1))) & 0xFFFFFFFFUL;
+#     else
+      d32 = i == 0 ? d01 : d23;
+#     endif
+      switch (descr & 3) {
+         case 0: MC_(helperc_b_store1)( a, d32 ); break;
+         case 1: MC_(helperc_b_store2)( a, d32 ); break;
+         case 2: MC_(helperc_b_store4)( a, d32 ); break;
+         case 3: MC_(helperc_b_store8)( a, d32 ); break;
+      }
+   }
+}
+
 
 /*--------------------------------------------*/
 /*--- Origin tracking: sarp handlers       ---*/
@@ -6589,6 +7590,34 @@ static void mc_post_clo_init ( void )
 
    tl_assert( MC_(clo_mc_level) >= 1 && MC_(clo_mc_level) <= 3 );
 
+   if (MC_(clo_incremental_leak_check)) {
+      /* Without V bit tracking there are no STOREV calls to see the
+         client's stores. */
+      if (MC_(clo_mc_level) == 1)
+         VG_(fmsg_bad_option)("--incremental-leak-check=yes",
+            "It needs --undef-value-errors=yes.\n");
+      lc_dirty = VG_(calloc)("mc.mpci.1", N_PRIMARY_MAP, 1);
+   }
+
+   if (MC_(clo_heap_profile)) {
+      /* The profile is kept per allocation stack. */
+      if (MC_(clo_keep_stacktraces) == KS_none
+          || MC_(clo_keep_stacktraces) == KS_free)
+         VG_(fmsg_bad_option)("--heap-profile=yes",
+            "It needs --keep-stacktraces to keep the allocation stacks.\n");
+      MC_(heap_profile_init)();
+   }
+
+#  if defined(MC_VABITS_V256)
+   /* Use AVX2 for the vabits8 scans and fills if the host has it. */
+   {
+      VexArch     arch;
+      VexArchInfo vai;
+      VG_(machine_get_VexArchInfo)(&arch, &vai);
+      mc_use_avx2 = (vai.hwcaps & VEX_HWCAPS_AMD64_AVX2) != 0;
+   }
+#  endif
+
    if (MC_(clo_mc_level) == 3) {
       /* We're doing origin tracking. */
 #     ifdef PERF_FAST_STACK
@@ -6697,6 +7726,14 @@ static void mc_post_clo_init ( void )
    /* Do not check definedness of guest state if --undef-value-errors=no */
    if (MC_(clo_mc_level) >= 2)
       VG_(track_pre_reg_read) ( mc_pre_reg_read );
+
+   /* Our translations only depend on the guest code and the options,
+      except when origin tracking, where the core's SP update pass
+      embeds ECUs which are only meaningful in this run, and with
+      --adaptive-definedness-checks=yes, where they depend on the
+      errors found so far. */
+   if (MC_(clo_mc_level) < 3 && !MC_(clo_adaptive_definedness_checks))
+      VG_(needs_persistent_translations) ();
 }
 
 static void print_SM_info(const HChar* type, Int n_SMs)
@@ -6709,6 +7746,35 @@ static void print_SM_info(const HChar* type, Int n_SMs)
       n_SMs * sizeof(SecMap) / (1024 * 1024UL) );
 }
 
+static void mc_metrics ( void (*put)(const HChar* name, ULong value) )
+{
+   put("memcheck.secmaps", n_non_DSM_SMs);
+   put("memcheck.secmap_bytes", (ULong)n_non_DSM_SMs * sizeof(SecMap));
+   put("memcheck.sec_vbit_nodes", VG_(OSetGen_Size)(secVBitTable));
+   put("memcheck.auxmap_nodes", n_auxmap_L2_nodes);
+   put("memcheck.freelist_bytes", VG_(free_queue_volume));
+   put("memcheck.freelist_blocks", VG_(free_queue_length));
+   put("memcheck.heap_blocks", VG_(HT2_count_nodes)(MC_(malloc_list)));
+}
+
+/* The stack pointer was not tracked before the instrumentation
+   started either, so the live part of each stack (and the redzone
+   below it) is made defined, and so are the registers. */
+static void mc_start_instrumentation ( void )
+{
+   ThreadId tid;
+   Addr     stack_min, stack_max;
+
+   make_all_accessible_defined();
+   VG_(thread_stack_reset_iter)(&tid);
+   while ( VG_(thread_stack_next)(&tid, &stack_min, &stack_max) ) {
+      stack_min -= VG_STACK_REDZONE_SZB;
+      if (stack_min <= stack_max)
+         MC_(make_mem_defined)(stack_min, stack_max - stack_min + 1);
+      MC_(make_regs_defined)(tid);
+   }
+}
+
 static void mc_print_stats (void)
 {
    SizeT max_secVBit_szB, max_SMs_szB, max_shmem_szB;
@@ -6740,6 +7806,19 @@ static void mc_print_stats (void)
    print_SM_info("max_undefined", max_undefined_SMs);
    print_SM_info("max_defined  ", max_defined_SMs);
    print_SM_info("max_non_DSM  ", max_non_DSM_SMs);
+   VG_(message)(Vg_DebugMsg,
+      " memcheck: value checks: %llu generated, %llu removed as repeats\n",
+      MC_(n_value_checks), MC_(n_value_checks_removed));
+   if (n_collapse_passes > 0 || n_filled_SMs > 0)
+      VG_(message)(Vg_DebugMsg,
+         " memcheck: %llu SecMaps collapsed in %llu passes, "
+         "%llu once filled in\n",
+         n_collapsed_SMs - n_filled_SMs, n_collapse_passes, n_filled_SMs);
+   if (n_sm_pool_chunks > 0)
+      VG_(message)(Vg_DebugMsg,
+         " memcheck: SecMaps carved from %d huge-page chunks (%luM)\n",
+         n_sm_pool_chunks,
+         n_sm_pool_chunks * VG_(am_huge_page_szB)() / (1024 * 1024));
 
    // Three DSMs, plus the non-DSM ones
    max_SMs_szB = (3 + max_non_DSM_SMs) * sizeof(SecMap);
@@ -6782,9 +7861,18 @@ static void mc_print_stats (void)
                    stats_ocacheL1_found_at_N,
                    stats_ocacheL1_movefwds );
       VG_(message)(Vg_DebugMsg,
-                   " ocacheL1: %'12lu sizeB  %'12u useful\n",
-                   (UWord)sizeof(OCache),
-                   4 * OC_W32S_PER_LINE * OC_LINES_PER_SET * OC_N_SETS );
+                   " ocacheL1: %'12lu sizeB  %'12lu useful\n",
+                   (UWord)sizeof(OCacheSet) * (oc_n_sets_mask + 1),
+                   (UWord)4 * OC_W32S_PER_LINE * OC_LINES_PER_SET
+                      * (oc_n_sets_mask + 1) );
+      VG_(message)(Vg_DebugMsg,
+                   " ocacheL1: %'12lu sets   %'12lu grows\n",
+                   oc_n_sets_mask + 1,
+                   stats_ocacheL1_grows );
+      VG_(message)(Vg_DebugMsg,
+                   " ocacheL1: %'12lu batched stores (%'lu helper calls)\n",
+                   stats_ocacheL1_batched_stores,
+                   stats_ocacheL1_store_batches );
       VG_(message)(Vg_DebugMsg,
                    " ocacheL2: %'12lu refs   %'12lu misses\n",
                    stats__ocacheL2_refs, 
@@ -6805,8 +7893,14 @@ static void mc_print_stats (void)
 
 static void mc_fini ( Int exitcode )
 {
+   if (MC_(clo_adaptive_definedness_checks))
+      MC_(flush_adaptive_sites)();
+
    MC_(print_malloc_stats)();
 
+   if (MC_(clo_heap_profile))
+      MC_(heap_profile_fini)();
+
    if (MC_(clo_leak_check) != LC_Off) {
       LeakCheckParams lcp;
       lcp.mode = MC_(clo_leak_check);
@@ -6875,8 +7969,11 @@ static void mc_fini ( Int exitcode )
 
    done_prof_mem();
 
-   if (VG_(clo_stats))
+   if (VG_(clo_stats)) {
       mc_print_stats();
+      if (MC_(clo_adaptive_definedness_checks))
+         MC_(print_adaptive_stats)();
+   }
 
    if (0) {
       VG_(message)(Vg_DebugMsg, 
@@ -6939,6 +8036,10 @@ static void mc_pre_clo_init(void)
    VG_(needs_sanity_checks)       (mc_cheap_sanity_check,
                                    mc_expensive_sanity_check);
    VG_(needs_print_stats)         (mc_print_stats);
+   VG_(needs_metrics)             (mc_metrics);
+   VG_(needs_fast_forward)        (mc_start_instrumentation);
+   VG_(needs_merged_stack_events) ();
+   VG_(needs_instrumentation_filter) (MC_(instrument_skipped));
    VG_(needs_info_location)       (MC_(pp_describe_addr));
    VG_(needs_malloc_replacement)  (MC_(malloc),
                                    MC_(__builtin_new),
@@ -6967,7 +8068,7 @@ static void mc_pre_clo_init(void)
 
    VG_(track_die_mem_stack_signal)( MC_(make_mem_noaccess) ); 
    VG_(track_die_mem_brk)         ( MC_(make_mem_noaccess) );
-   VG_(track_die_mem_munmap)      ( MC_(make_mem_noaccess) ); 
+   VG_(track_die_mem_munmap)      ( mc_die_mem_munmap );
 
    /* Defer the specification of the new_mem_stack functions to the
       post_clo_init function, since we need to first parse the command
@@ -6992,6 +8093,9 @@ static void mc_pre_clo_init(void)
    VG_(track_pre_mem_read_asciiz) ( check_mem_is_defined_asciiz );
    VG_(track_pre_mem_write)       ( check_mem_is_addressable );
    VG_(track_post_mem_write)      ( mc_post_mem_write );
+   VG_(track_pre_mem_read_iov)    ( check_iov_is_defined );
+   VG_(track_pre_mem_write_iov)   ( check_iov_is_addressable );
+   VG_(track_post_mem_write_iov)  ( mc_post_mem_write_iov );
 
    VG_(track_post_reg_write)                  ( mc_post_reg_write );
    VG_(track_post_reg_write_clientcall_return)( mc_post_reg_write_clientcall );
@@ -7001,7 +8105,7 @@ static void mc_pre_clo_init(void)
    init_shadow_memory();
    // MC_(chunk_poolalloc) must be allocated in post_clo_init
    tl_assert(MC_(chunk_poolalloc) == NULL);
-   MC_(malloc_list)  = VG_(HT_construct)( "MC_(malloc_list)" );
+   MC_(malloc_list)  = VG_(HT2_construct)( "MC_(malloc_list)" );
    MC_(mempool_list) = VG_(HT_construct)( "MC_(mempool_list)" );
    init_prof_mem();
 
@@ -33,6 +33,7 @@
 #include "pub_tool_execontext.h"
 #include "pub_tool_poolalloc.h"
 #include "pub_tool_hashtable.h"
+#include "pub_tool_hashtable2.h"
 #include "pub_tool_libcbase.h"
 #include "pub_tool_libcassert.h"
 #include "pub_tool_libcprint.h"
@@ -66,7 +67,7 @@ static ULong cmalloc_bs_mallocd = 0;
 SizeT MC_(Malloc_Redzone_SzB) = -10000000; // If used before set, should BOMB
 
 /* Record malloc'd blocks. */
-VgHashTable MC_(malloc_list) = NULL;
+VgHashTable2 MC_(malloc_list) = NULL;
 
 /* Memory pools: a hash table of MC_Mempools.  Search key is
    MC_Mempool::pool. */
@@ -224,9 +225,9 @@ void delete_MC_Chunk (MC_Chunk* mc)
 }
 
 // True if mc is in the given block list.
-static Bool in_block_list (VgHashTable block_list, MC_Chunk* mc)
+static Bool in_block_list (VgHashTable2 block_list, MC_Chunk* mc)
 {
-   MC_Chunk* found_mc = VG_(HT_lookup) ( block_list, (UWord)mc->data );
+   MC_Chunk* found_mc = VG_(HT2_lookup) ( block_list, (UWord)mc->data );
    if (found_mc) {
       tl_assert (found_mc->data == mc->data);
       /* If a user builds a pool from a malloc-ed superblock
@@ -352,7 +353,7 @@ UInt MC_(n_where_pointers) (void)
 /* Allocate memory and note change in memory available */
 void* MC_(new_block) ( ThreadId tid,
                        Addr p, SizeT szB, SizeT alignB,
-                       Bool is_zeroed, MC_AllocKind kind, VgHashTable table)
+                       Bool is_zeroed, MC_AllocKind kind, VgHashTable2 table)
 {
    MC_Chunk* mc;
 
@@ -378,7 +379,9 @@ void* MC_(new_block) ( ThreadId tid,
    cmalloc_n_mallocs ++;
    cmalloc_bs_mallocd += (ULong)szB;
    mc = create_MC_Chunk (tid, p, szB, kind);
-   VG_(HT_add_node)( table, mc );
+   VG_(HT2_add_node)( table, mc );
+   if (MC_(clo_heap_profile) && table == MC_(malloc_list))
+      MC_(heap_profile_alloc)( mc );
 
    if (is_zeroed)
       MC_(make_mem_defined)( p, szB );
@@ -480,9 +483,9 @@ void record_freemismatch_error (ThreadId tid, MC_Chunk* mc)
       again a "clean allocated block", report the error, and then
       re-remove the chunk.  This avoids to do a VG_(HT_lookup)
       followed by a VG_(HT_remove) in all "non-erroneous cases". */
-   VG_(HT_add_node)( MC_(malloc_list), mc );
+   VG_(HT2_add_node)( MC_(malloc_list), mc );
    MC_(record_freemismatch_error) ( tid, mc );
-   if ((mc != VG_(HT_remove) ( MC_(malloc_list), (UWord)mc->data )))
+   if ((mc != VG_(HT2_remove) ( MC_(malloc_list), (UWord)mc->data )))
       tl_assert(0);
 }
 
@@ -492,7 +495,7 @@ void MC_(handle_free) ( ThreadId tid, Addr p, UInt rzB, MC_AllocKind kind )
 
    cmalloc_n_frees++;
 
-   mc = VG_(HT_remove) ( MC_(malloc_list), (UWord)p );
+   mc = VG_(HT2_remove) ( MC_(malloc_list), (UWord)p );
    if (mc == NULL) {
       MC_(record_free_error) ( tid, p );
    } else {
@@ -501,6 +504,8 @@ void MC_(handle_free) ( ThreadId tid, Addr p, UInt rzB, MC_AllocKind kind )
          tl_assert(p == mc->data);
          record_freemismatch_error ( tid, mc );
       }
+      if (MC_(clo_heap_profile))
+         MC_(heap_profile_free)( mc );
       die_and_free_mem ( tid, mc, rzB );
    }
 }
@@ -538,7 +543,7 @@ void* MC_(realloc) ( ThreadId tid, void* p_old, SizeT new_szB )
    cmalloc_bs_mallocd += (ULong)new_szB;
 
    /* Remove the old block */
-   old_mc = VG_(HT_remove) ( MC_(malloc_list), (UWord)p_old );
+   old_mc = VG_(HT2_remove) ( MC_(malloc_list), (UWord)p_old );
    if (old_mc == NULL) {
       MC_(record_free_error) ( tid, (Addr)p_old );
       /* We return to the program regardless. */
@@ -571,7 +576,9 @@ void* MC_(realloc) ( ThreadId tid, void* p_old, SizeT new_szB )
       new_mc = create_MC_Chunk( tid, a_new, new_szB, MC_AllocMalloc );
 
       // Now insert the new mc (with a new 'data' field) into malloc_list.
-      VG_(HT_add_node)( MC_(malloc_list), new_mc );
+      VG_(HT2_add_node)( MC_(malloc_list), new_mc );
+      if (MC_(clo_heap_profile))
+         MC_(heap_profile_alloc)( new_mc );
 
       /* Retained part is copied, red zones set as normal */
 
@@ -625,13 +632,15 @@ void* MC_(realloc) ( ThreadId tid, void* p_old, SizeT new_szB )
       /* Nb: we have to allocate a new MC_Chunk for the new memory rather
          than recycling the old one, so that any erroneous accesses to the
          old memory are reported. */
+      if (MC_(clo_heap_profile))
+         MC_(heap_profile_free)( old_mc );
       die_and_free_mem ( tid, old_mc, MC_(Malloc_Redzone_SzB) );
 
    } else {
       /* Could not allocate new client memory.
          Re-insert the old_mc (with the old ptr) in the HT, as old_mc was
          unconditionally removed at the beginning of the function. */
-      VG_(HT_add_node)( MC_(malloc_list), old_mc );
+      VG_(HT2_add_node)( MC_(malloc_list), old_mc );
    }
 
    return (void*)a_new;
@@ -639,7 +648,7 @@ void* MC_(realloc) ( ThreadId tid, void* p_old, SizeT new_szB )
 
 SizeT MC_(malloc_usable_size) ( ThreadId tid, void* p )
 {
-   MC_Chunk* mc = VG_(HT_lookup) ( MC_(malloc_list), (UWord)p );
+   MC_Chunk* mc = VG_(HT2_lookup) ( MC_(malloc_list), (UWord)p );
 
    // There may be slop, but pretend there isn't because only the asked-for
    // area will be marked as addressable.
@@ -653,7 +662,7 @@ SizeT MC_(malloc_usable_size) ( ThreadId tid, void* p )
 void MC_(handle_resizeInPlace)(ThreadId tid, Addr p,
                                SizeT oldSizeB, SizeT newSizeB, SizeT rzB)
 {
-   MC_Chunk* mc = VG_(HT_lookup) ( MC_(malloc_list), (UWord)p );
+   MC_Chunk* mc = VG_(HT2_lookup) ( MC_(malloc_list), (UWord)p );
    if (!mc || mc->szB != oldSizeB || newSizeB == 0) {
       /* Reject if: p is not found, or oldSizeB is wrong,
          or new block would be empty. */
@@ -664,7 +673,11 @@ void MC_(handle_resizeInPlace)(ThreadId tid, Addr p,
    if (oldSizeB == newSizeB)
       return;
 
+   if (MC_(clo_heap_profile))
+      MC_(heap_profile_free)( mc );
    mc->szB = newSizeB;
+   if (MC_(clo_heap_profile))
+      MC_(heap_profile_alloc)( mc );
    if (newSizeB < oldSizeB) {
       MC_(make_mem_noaccess)( p + newSizeB, oldSizeB - newSizeB + rzB );
    } else {
@@ -688,6 +701,20 @@ void MC_(handle_resizeInPlace)(ThreadId tid, Addr p,
 
 static void check_mempool_sane(MC_Mempool* mp); /*forward*/
 
+/* check_mempool_sane sorts all the chunks of the pool, which is much
+   too slow to do on every trim or change of a pool with many chunks.
+   So do it once there have been as many of them as there are chunks.
+   That makes its cost per operation O(log n), and still reports
+   overlapping chunks soon after they appear. */
+static void maybe_check_mempool_sane(MC_Mempool* mp)
+{
+   if (MP_DETAILED_SANITY_CHECKS
+       || ++mp->n_ops >= VG_(HT2_count_nodes)(mp->chunks)) {
+      mp->n_ops = 0;
+      check_mempool_sane(mp);
+   }
+}
+
 
 void MC_(create_mempool)(Addr pool, UInt rzB, Bool is_zeroed)
 {
@@ -709,7 +736,8 @@ void MC_(create_mempool)(Addr pool, UInt rzB, Bool is_zeroed)
    mp->pool       = pool;
    mp->rzB        = rzB;
    mp->is_zeroed  = is_zeroed;
-   mp->chunks     = VG_(HT_construct)( "MC_(create_mempool)" );
+   mp->chunks     = VG_(HT2_construct)( "MC_(create_mempool)" );
+   mp->n_ops      = 0;
    check_mempool_sane(mp);
 
    /* Paranoia ... ensure this area is off-limits to the client, so
@@ -745,14 +773,14 @@ void MC_(destroy_mempool)(Addr pool)
    check_mempool_sane(mp);
 
    // Clean up the chunks, one by one
-   VG_(HT_ResetIter)(mp->chunks);
-   while ( (mc = VG_(HT_Next)(mp->chunks)) ) {
+   VG_(HT2_ResetIter)(mp->chunks);
+   while ( (mc = VG_(HT2_Next)(mp->chunks)) ) {
       /* Note: make redzones noaccess again -- just in case user made them
          accessible with a client request... */
       MC_(make_mem_noaccess)(mc->data-mp->rzB, mc->szB + 2*mp->rzB );
    }
    // Destroy the chunk table
-   VG_(HT_destruct)(mp->chunks, (void (*)(void *))delete_MC_Chunk);
+   VG_(HT2_destruct)(mp->chunks, (void (*)(void *))delete_MC_Chunk);
 
    VG_(free)(mp);
 }
@@ -773,7 +801,7 @@ check_mempool_sane(MC_Mempool* mp)
    UInt n_chunks, i, bad = 0;   
    static UInt tick = 0;
 
-   MC_Chunk **chunks = (MC_Chunk**) VG_(HT_to_array)( mp->chunks, &n_chunks );
+   MC_Chunk **chunks = (MC_Chunk**) VG_(HT2_to_array)( mp->chunks, &n_chunks );
    if (!chunks)
       return;
 
@@ -786,8 +814,8 @@ check_mempool_sane(MC_Mempool* mp)
 	 VG_(HT_ResetIter)(MC_(mempool_list));
 	 while ( (mp2 = VG_(HT_Next)(MC_(mempool_list))) ) {
 	   total_pools++;
-	   VG_(HT_ResetIter)(mp2->chunks);
-	   while (VG_(HT_Next)(mp2->chunks)) {
+	   VG_(HT2_ResetIter)(mp2->chunks);
+	   while (VG_(HT2_Next)(mp2->chunks)) {
 	     total_chunks++;
 	   }
 	 }
@@ -890,7 +918,7 @@ void MC_(mempool_free)(Addr pool, Addr addr)
    }
 
    if (MP_DETAILED_SANITY_CHECKS) check_mempool_sane(mp);
-   mc = VG_(HT_remove)(mp->chunks, (UWord)addr);
+   mc = VG_(HT2_remove)(mp->chunks, (UWord)addr);
    if (mc == NULL) {
       MC_(record_free_error)(tid, (Addr)addr);
       return;
@@ -927,8 +955,7 @@ void MC_(mempool_trim)(Addr pool, Addr addr, SizeT szB)
       return;
    }
 
-   check_mempool_sane(mp);
-   chunks = VG_(HT_to_array) ( mp->chunks, &n_shadows );
+   chunks = VG_(HT2_to_array) ( mp->chunks, &n_shadows );
    if (n_shadows == 0) {
      tl_assert(chunks == NULL);
      return;
@@ -959,7 +986,7 @@ void MC_(mempool_trim)(Addr pool, Addr addr, SizeT szB)
          /* The current chunk is entirely outside the trim extent:
             delete it. */
 
-         if (VG_(HT_remove)(mp->chunks, (UWord)mc->data) == NULL) {
+         if (VG_(HT2_remove)(mp->chunks, (UWord)mc->data) == NULL) {
             MC_(record_free_error)(tid, (Addr)mc->data);
             VG_(free)(chunks);
             if (MP_DETAILED_SANITY_CHECKS) check_mempool_sane(mp);
@@ -974,7 +1001,7 @@ void MC_(mempool_trim)(Addr pool, Addr addr, SizeT szB)
 
          tl_assert(EXTENT_CONTAINS(lo) ||
                    EXTENT_CONTAINS(hi));
-         if (VG_(HT_remove)(mp->chunks, (UWord)mc->data) == NULL) {
+         if (VG_(HT2_remove)(mp->chunks, (UWord)mc->data) == NULL) {
             MC_(record_free_error)(tid, (Addr)mc->data);
             VG_(free)(chunks);
             if (MP_DETAILED_SANITY_CHECKS) check_mempool_sane(mp);
@@ -1011,13 +1038,13 @@ void MC_(mempool_trim)(Addr pool, Addr addr, SizeT szB)
 
          mc->data = lo;
          mc->szB = (UInt) (hi - lo);
-         VG_(HT_add_node)( mp->chunks, mc );        
+         VG_(HT2_add_node)( mp->chunks, mc );        
       }
 
 #undef EXTENT_CONTAINS
       
    }
-   check_mempool_sane(mp);
+   maybe_check_mempool_sane(mp);
    VG_(free)(chunks);
 }
 
@@ -1061,9 +1088,7 @@ void MC_(mempool_change)(Addr pool, Addr addrA, Addr addrB, SizeT szB)
       return;
    }
 
-   check_mempool_sane(mp);
-
-   mc = VG_(HT_remove)(mp->chunks, (UWord)addrA);
+   mc = VG_(HT2_remove)(mp->chunks, (UWord)addrA);
    if (mc == NULL) {
       MC_(record_free_error)(tid, (Addr)addrA);
       return;
@@ -1071,9 +1096,9 @@ void MC_(mempool_change)(Addr pool, Addr addrA, Addr addrB, SizeT szB)
 
    mc->data = addrB;
    mc->szB  = szB;
-   VG_(HT_add_node)( mp->chunks, mc );
+   VG_(HT2_add_node)( mp->chunks, mc );
 
-   check_mempool_sane(mp);
+   maybe_check_mempool_sane(mp);
 }
 
 Bool MC_(mempool_exists)(Addr pool)
@@ -1104,8 +1129,8 @@ void MC_(print_malloc_stats) ( void )
       return;
 
    /* Count memory still in use. */
-   VG_(HT_ResetIter)(MC_(malloc_list));
-   while ( (mc = VG_(HT_Next)(MC_(malloc_list))) ) {
+   VG_(HT2_ResetIter)(MC_(malloc_list));
+   while ( (mc = VG_(HT2_Next)(MC_(malloc_list))) ) {
       nblocks++;
       nbytes += (ULong)mc->szB;
    }
@@ -33,6 +33,7 @@
 #include "pub_tool_basics.h"
 #include "pub_tool_poolalloc.h"
 #include "pub_tool_hashtable.h"
+#include "pub_tool_hashtable2.h"
 #include "pub_tool_redir.h"
 #include "pub_tool_tooliface.h"
 #include "pub_tool_clreq.h"
@@ -32,6 +32,7 @@
 #include "pub_tool_basics.h"
 #include "pub_tool_poolalloc.h"     // For mc_include.h
 #include "pub_tool_hashtable.h"     // For mc_include.h
+#include "pub_tool_hashtable2.h"     // For mc_include.h
 #include "pub_tool_libcassert.h"
 #include "pub_tool_libcprint.h"
 #include "pub_tool_tooliface.h"
@@ -39,6 +40,7 @@
 #include "pub_tool_xarray.h"
 #include "pub_tool_mallocfree.h"
 #include "pub_tool_libcbase.h"
+#include "pub_tool_debuginfo.h"     // VG_(find_DebugInfo)
 
 #include "mc_include.h"
 
@@ -216,6 +218,33 @@ typedef
          arguments of type 'HWord' to be passed to helper functions.
          Ity_I32 or Ity_I64 only. */
       IRType hWordTy;
+
+      /* READONLY: whether undefined values are tracked and checked in
+         this superblock.  Only ever False with MC_(clo_mc_level) >= 2
+         and --definedness-sampling below 100, or for code skipped with
+         --skip-instrument or --instrument-only.  The superblock is then
+         instrumented as if for MC_(clo_mc_level) == 1, except that
+         shadow PUTs are still done, of all-defined values, so that
+         the superblocks which are tracked don't see stale shadow
+         registers. */
+      Bool trackDefinedness;
+
+      /* MODIFIED: for each original tmp that was assigned a constant
+         offset from another atom, that atom and the offset; NULL and
+         0 otherwise.  Only used when tracking origins, and then
+         indexed like tmpMap but only over the original tmps. */
+      IRExpr** origBase;
+      Int*     origBias;
+
+      /* MODIFIED: origin stores for plain stores which are yet to be
+         generated.  They are all at small constant offsets from
+         .bStoreBase, and are done by a single call to
+         MC_(helperc_b_store_batch) when flushBStores is called. */
+      IRExpr*  bStoreBase;
+      Int      bStoresUsed;
+      Int      bStoreSzB[MC_B_BATCH_MAX];
+      Int      bStoreBias[MC_B_BATCH_MAX];
+      IRExpr*  bStoreData[MC_B_BATCH_MAX];
    }
    MCEnv;
 
@@ -1221,7 +1250,7 @@ static void complainIfUndefined ( MCEnv* mce, IRAtom* atom, IRExpr *guard )
    Int      nargs;
 
    // Don't do V bit tests if we're not reporting undefined value errors.
-   if (MC_(clo_mc_level) == 1)
+   if (MC_(clo_mc_level) == 1 || !mce->trackDefinedness)
       return;
 
    if (guard)
@@ -1342,6 +1371,8 @@ static void complainIfUndefined ( MCEnv* mce, IRAtom* atom, IRExpr *guard )
    di = unsafeIRDirty_0_N( nargs/*regparms*/, nm, 
                            VG_(fnptr_to_fnentry)( fn ), args );
    di->guard = cond; // and cond is PCast-to-1(atom#)
+   di->cold  = True; // only happens when there is an error to report
+   di->idempotent = True; // a repeat would report the same error again
 
    /* If the complaint is to be issued under a guard condition, AND
       that into the guard condition for the helper call. */
@@ -1441,10 +1472,15 @@ void do_shadow_PUT ( MCEnv* mce,  Int offset,
    if (atom) {
       tl_assert(!vatom);
       tl_assert(isOriginalAtom(mce, atom));
-      vatom = expr2vbits( mce, atom );
+      vatom = mce->trackDefinedness
+                 ? expr2vbits( mce, atom )
+                 : definedOfType(
+                      shadowTypeV(typeOfIRExpr(mce->sb->tyenv, atom)) );
    } else {
       tl_assert(vatom);
       tl_assert(isShadowAtom(mce, vatom));
+      if (!mce->trackDefinedness)
+         vatom = definedOfType( typeOfIRExpr(mce->sb->tyenv, vatom) );
    }
 
    ty = typeOfIRExpr(mce->sb->tyenv, vatom);
@@ -1492,7 +1528,10 @@ void do_shadow_PUTI ( MCEnv* mce, IRPutI *puti)
       return;
    
    tl_assert(isOriginalAtom(mce,atom));
-   vatom = expr2vbits( mce, atom );
+   vatom = mce->trackDefinedness
+              ? expr2vbits( mce, atom )
+              : definedOfType(
+                   shadowTypeV(typeOfIRExpr(mce->sb->tyenv, atom)) );
    tl_assert(sameKindedAtoms(atom, vatom));
    ty   = descr->elemTy;
    tyS  = shadowTypeV(ty);
@@ -4556,6 +4595,133 @@ IRExpr* expr2vbits_Unop ( MCEnv* mce, IROp op, IRAtom* atom )
 }
 
 
+/* Inline fast paths for the LOADV/STOREV helpers.
+
+   With --inline-shadow-access=yes, on 64-bit little-endian hosts, the
+   commonest cases of the 8/16/32/64-bit LOADV and STOREV helpers are
+   done in the generated code, and the helper is called only when they
+   don't apply.  That is the same test as the helpers' own fast paths
+   make: the access is naturally aligned, lies below the end of the
+   primary map, and hits a vabits8 chunk (or, for 64 bits, two of them)
+   which is all-defined or all-undefined.  For 8/16/32 bits the test
+   is on the whole of the 4-byte chunk, so it is conservative, as it
+   is for the helpers.
+
+   There is no need to cache SecMap pointers to do this: the primary
+   map is indexed directly, since the address has already been checked
+   to be in range.  So nothing needs invalidating when a SecMap is
+   replaced. */
+
+static Bool inline_shadow_access_ok ( MCEnv* mce, IREndness end,
+                                      IRType ty, IRAtom* guard )
+{
+   if (!MC_(clo_inline_shadow_access))
+      return False;
+   /* Inline stores would not mark granules dirty. */
+   if (MC_(clo_incremental_leak_check))
+      return False;
+   if (guard != NULL || end != Iend_LE || mce->hWordTy != Ity_I64)
+      return False;
+   switch (ty) {
+      case Ity_I8: case Ity_I16: case Ity_I32: case Ity_I64:
+         return True;
+      default:
+         return False;
+   }
+}
+
+/* Generate IR which fetches the vabits for the |ty|-sized access at
+   |addr|.  *badP is set to an Ity_I64 atom which is nonzero if the
+   fast path can't be used.  Otherwise *vbitsP, also Ity_I64, holds
+   the V bits for the access, all-defined (zero) or all-undefined (all
+   ones).  The arithmetic relies on the all-undefined vabits being the
+   complement of the all-defined ones: x = vabits ^ DEFINED is then 0
+   or all ones, and x + 1 has no bits set below the top one (which is
+   where the V bits come from) just when the vabits are one of the
+   two. */
+static void gen_inline_vabits ( MCEnv* mce, IRType ty, IRAtom* addr,
+                                /*OUT*/IRAtom** badP,
+                                /*OUT*/IRAtom** vbitsP )
+{
+   Addr    max_primary = MC_(max_primary_address)();
+   ULong   szB         = sizeofIRType(ty);
+   IRAtom *badAddr, *smPtrAddr, *sm, *vaAddr, *vabits, *x1;
+   IRType  tyVA;
+   ULong   def;
+   UInt    nVA;
+
+   tl_assert(max_primary >= 0xFFFF && ((max_primary + 1) & 0xFFFF) == 0);
+
+   /* Not aligned, or above the primary map? */
+   badAddr = assignNew('V', mce, Ity_I64,
+                       binop(Iop_And64, addr,
+                             mkU64((szB - 1) | ~(ULong)max_primary)));
+
+   /* primary_map[(a & max_primary) >> 16], which is in range whatever
+      a is. */
+   smPtrAddr
+      = assignNew('V', mce, Ity_I64,
+                  binop(Iop_Add64,
+                        mkU64((ULong)MC_(primary_map_base)()),
+                        assignNew('V', mce, Ity_I64,
+                                  binop(Iop_Shr64,
+                                        assignNew('V', mce, Ity_I64,
+                                                  binop(Iop_And64, addr,
+                                                        mkU64(max_primary
+                                                         & ~0xFFFFULL))),
+                                        mkU8(16 - 3)))));
+   sm = assignNew('V', mce, Ity_I64,
+                  IRExpr_Load(Iend_LE, Ity_I64, smPtrAddr));
+
+   /* ... ->vabits8[SM_OFF(a)], or for 64-bit accesses, the 16 bits at
+      SM_OFF_16(a). */
+   if (szB == 8) {
+      tyVA = Ity_I16;  nVA = 16;  def = 0xAAAA;  /* VA_BITS16_DEFINED */
+   } else {
+      tyVA = Ity_I8;   nVA = 8;   def = 0xAA;    /* VA_BITS8_DEFINED */
+   }
+   vaAddr = assignNew('V', mce, Ity_I64,
+                      binop(Iop_Add64, sm,
+                            assignNew('V', mce, Ity_I64,
+                                      binop(Iop_Shr64,
+                                            assignNew('V', mce, Ity_I64,
+                                                      binop(Iop_And64, addr,
+                                                            mkU64(szB == 8
+                                                                  ? 0xFFF8
+                                                                  : 0xFFFF))),
+                                            mkU8(2)))));
+   vabits = assignNew('V', mce, Ity_I64,
+                      unop(szB == 8 ? Iop_16Uto64 : Iop_8Uto64,
+                           assignNew('V', mce, tyVA,
+                                     IRExpr_Load(Iend_LE, tyVA, vaAddr))));
+
+   x1 = assignNew('V', mce, Ity_I64,
+                  binop(Iop_Add64,
+                        assignNew('V', mce, Ity_I64,
+                                  binop(Iop_Xor64, vabits, mkU64(def))),
+                        mkU64(1)));
+   *badP = assignNew('V', mce, Ity_I64,
+                     binop(Iop_Or64, badAddr,
+                           assignNew('V', mce, Ity_I64,
+                                     binop(Iop_And64, x1,
+                                           mkU64((1ULL << nVA) - 2)))));
+   *vbitsP = assignNew('V', mce, Ity_I64,
+                       binop(Iop_Sub64, mkU64(0),
+                             assignNew('V', mce, Ity_I64,
+                                       binop(Iop_Shr64, x1, mkU8(nVA)))));
+}
+
+/* |bad| (Ity_I64) is nonzero when the helper call |di| is needed.
+   That is the uncommon case, so let the back end move the call out
+   of line. */
+static void guard_helper_on_bad ( MCEnv* mce, IRDirty* di, IRAtom* bad )
+{
+   di->guard = assignNew('V', mce, Ity_I1,
+                         binop(Iop_CmpNE64, bad, mkU64(0)));
+   di->cold  = True;
+}
+
+
 /* Worker function -- do not call directly.  See comments on
    expr2vbits_Load for the meaning of |guard|.
 
@@ -4659,6 +4825,25 @@ IRAtom* expr2vbits_Load_WRK ( MCEnv* mce,
       addrAct = assignNew('V', mce, tyAddr, binop(mkAdd, addr, eBias) );
    }
 
+   /* Maybe do the common case inline, in which case the helper is
+      called only when |bad| is nonzero. */
+   IRAtom* bad  = NULL;
+   IRAtom* fast = NULL;
+   if (inline_shadow_access_ok(mce, end, ty, guard)) {
+      IRAtom* vbits;
+      gen_inline_vabits(mce, ty, addrAct, &bad, &vbits);
+      switch (ty) {
+         case Ity_I64: fast = vbits; break;
+         case Ity_I32: fast = assignNew('V', mce, ty, unop(Iop_64to32, vbits));
+                       break;
+         case Ity_I16: fast = assignNew('V', mce, ty, unop(Iop_64to16, vbits));
+                       break;
+         case Ity_I8:  fast = assignNew('V', mce, ty, unop(Iop_64to8, vbits));
+                       break;
+         default:      tl_assert(0);
+      }
+   }
+
    /* We need to have a place to park the V bits we're just about to
       read. */
    IRTemp datavbits = newTemp(mce, ty, VSh);
@@ -4675,6 +4860,9 @@ IRAtom* expr2vbits_Load_WRK ( MCEnv* mce,
                               1/*regparms*/, 
                               hname, VG_(fnptr_to_fnentry)( helper ), 
                               mkIRExprVec_1( addrAct ) );
+      /* Loading again from the same address, with no store in
+         between, gives the same V bits (and the same error, if any). */
+      di->idempotent = True;
    }
 
    setHelperAnns( mce, di );
@@ -4686,6 +4874,15 @@ IRAtom* expr2vbits_Load_WRK ( MCEnv* mce,
          value (0b01 repeating, 0x55 etc) as that'll still look pretty
          undefined if it ever leaks out. */
    }
+   if (bad) {
+      guard_helper_on_bad(mce, di, bad);
+      stmt( 'V', mce, IRStmt_Dirty(di) );
+      return assignNew('V', mce, ty,
+                       IRExpr_ITE(assignNew('V', mce, Ity_I1,
+                                            binop(Iop_CmpEQ64, bad,
+                                                  mkU64(0))),
+                                  fast, mkexpr(datavbits)));
+   }
    stmt( 'V', mce, IRStmt_Dirty(di) );
 
    return mkexpr(datavbits);
@@ -4953,6 +5150,37 @@ IRExpr* zwidenToHostWord ( MCEnv* mce, IRAtom* vatom )
 }
 
 
+/* Is vdata a constant meaning "all defined"? */
+static Bool isAllDefinedConst ( IRAtom* vdata )
+{
+   IRConst* c;
+   if (vdata->tag != Iex_Const)
+      return False;
+   c = vdata->Iex.Const.con;
+   switch (c->tag) {
+      case Ico_U8:   return c->Ico.U8   == V_BITS8_DEFINED;
+      case Ico_U16:  return c->Ico.U16  == V_BITS16_DEFINED;
+      case Ico_U32:  return c->Ico.U32  == V_BITS32_DEFINED;
+      case Ico_U64:  return c->Ico.U64  == V_BITS64_DEFINED;
+      case Ico_V128: return c->Ico.V128 == V_BITS16_DEFINED;
+      case Ico_V256: return c->Ico.V256 == V_BITS32_DEFINED;
+      default:       return False;
+   }
+}
+
+/* Make a regparm(1) call to a store helper: with (addr, vdata), or
+   just (addr) for a _defined variant, which vdata == NULL means. */
+static IRDirty* mk_STOREV_call ( const HChar* hname, void* helper,
+                                 IRAtom* addr, IRAtom* vdata )
+{
+   return unsafeIRDirty_0_N(
+             1/*regparms*/,
+             hname, VG_(fnptr_to_fnentry)( helper ),
+             vdata ? mkIRExprVec_2( addr, vdata ) : mkIRExprVec_1( addr )
+          );
+}
+
+
 /* Generate a shadow store.  |addr| is always the original address
    atom.  You can pass in either originals or V-bits for the data
    atom, but obviously not both.  This function generates a check for
@@ -4974,7 +5202,10 @@ void do_shadow_Store ( MCEnv* mce,
    IROp     mkAdd;
    IRType   ty, tyAddr;
    void*    helper = NULL;
+   void*    helperD = NULL;
    const HChar* hname = NULL;
+   const HChar* hnameD = NULL;
+   Bool     defd;
    IRConst* c;
 
    tyAddr = mce->hWordTy;
@@ -5004,7 +5235,7 @@ void do_shadow_Store ( MCEnv* mce,
    // If we're not doing undefined value checking, pretend that this value
    // is "all valid".  That lets Vex's optimiser remove some of the V bit
    // shadow computation ops that precede it.
-   if (MC_(clo_mc_level) == 1) {
+   if (MC_(clo_mc_level) == 1 || !mce->trackDefinedness) {
       switch (ty) {
          case Ity_V256: // V256 weirdness -- used four times
                         c = IRConst_V256(V_BITS32_DEFINED); break;
@@ -5025,22 +5256,33 @@ void do_shadow_Store ( MCEnv* mce,
    complainIfUndefined( mce, addr, guard );
 
    /* Now decide which helper function to call to write the data V
-      bits into shadow memory. */
+      bits into shadow memory.  If the V bits are a constant "all
+      defined", as they are for stores of constants and for every
+      store when definedness isn't tracked, use the variant that is
+      specialised for that and doesn't take them at all. */
    if (end == Iend_LE) {
       switch (ty) {
          case Ity_V256: /* we'll use the helper four times */
          case Ity_V128: /* we'll use the helper twice */
          case Ity_I64: helper = &MC_(helperc_STOREV64le);
                        hname = "MC_(helperc_STOREV64le)";
+                       helperD = &MC_(helperc_STOREV64le_defined);
+                       hnameD = "MC_(helperc_STOREV64le_defined)";
                        break;
          case Ity_I32: helper = &MC_(helperc_STOREV32le);
                        hname = "MC_(helperc_STOREV32le)";
+                       helperD = &MC_(helperc_STOREV32le_defined);
+                       hnameD = "MC_(helperc_STOREV32le_defined)";
                        break;
          case Ity_I16: helper = &MC_(helperc_STOREV16le);
                        hname = "MC_(helperc_STOREV16le)";
+                       helperD = &MC_(helperc_STOREV16le_defined);
+                       hnameD = "MC_(helperc_STOREV16le_defined)";
                        break;
          case Ity_I8:  helper = &MC_(helperc_STOREV8);
                        hname = "MC_(helperc_STOREV8)";
+                       helperD = &MC_(helperc_STOREV8_defined);
+                       hnameD = "MC_(helperc_STOREV8_defined)";
                        break;
          default:      VG_(tool_panic)("memcheck:do_shadow_Store(LE)");
       }
@@ -5049,21 +5291,34 @@ void do_shadow_Store ( MCEnv* mce,
          case Ity_V128: /* we'll use the helper twice */
          case Ity_I64: helper = &MC_(helperc_STOREV64be);
                        hname = "MC_(helperc_STOREV64be)";
+                       helperD = &MC_(helperc_STOREV64be_defined);
+                       hnameD = "MC_(helperc_STOREV64be_defined)";
                        break;
          case Ity_I32: helper = &MC_(helperc_STOREV32be);
                        hname = "MC_(helperc_STOREV32be)";
+                       helperD = &MC_(helperc_STOREV32be_defined);
+                       hnameD = "MC_(helperc_STOREV32be_defined)";
                        break;
          case Ity_I16: helper = &MC_(helperc_STOREV16be);
                        hname = "MC_(helperc_STOREV16be)";
+                       helperD = &MC_(helperc_STOREV16be_defined);
+                       hnameD = "MC_(helperc_STOREV16be_defined)";
                        break;
          case Ity_I8:  helper = &MC_(helperc_STOREV8);
                        hname = "MC_(helperc_STOREV8)";
+                       helperD = &MC_(helperc_STOREV8_defined);
+                       hnameD = "MC_(helperc_STOREV8_defined)";
                        break;
          /* Note, no V256 case here, because no big-endian target that
             we support, has 256 vectors. */
          default:      VG_(tool_panic)("memcheck:do_shadow_Store(BE)");
       }
    }
+   defd = isAllDefinedConst(vdata);
+   if (defd) {
+      helper = helperD;
+      hname  = hnameD;
+   }
 
    if (UNLIKELY(ty == Ity_V256)) {
 
@@ -5086,39 +5341,27 @@ void do_shadow_Store ( MCEnv* mce,
 
       eBiasQ0 = tyAddr==Ity_I32 ? mkU32(bias+offQ0) : mkU64(bias+offQ0);
       addrQ0  = assignNew('V', mce, tyAddr, binop(mkAdd, addr, eBiasQ0) );
-      vdataQ0 = assignNew('V', mce, Ity_I64, unop(Iop_V256to64_0, vdata));
-      diQ0    = unsafeIRDirty_0_N( 
-                   1/*regparms*/, 
-                   hname, VG_(fnptr_to_fnentry)( helper ), 
-                   mkIRExprVec_2( addrQ0, vdataQ0 )
-                );
+      vdataQ0 = defd ? NULL
+                : assignNew('V', mce, Ity_I64, unop(Iop_V256to64_0, vdata));
+      diQ0    = mk_STOREV_call( hname, helper, addrQ0, vdataQ0 );
 
       eBiasQ1 = tyAddr==Ity_I32 ? mkU32(bias+offQ1) : mkU64(bias+offQ1);
       addrQ1  = assignNew('V', mce, tyAddr, binop(mkAdd, addr, eBiasQ1) );
-      vdataQ1 = assignNew('V', mce, Ity_I64, unop(Iop_V256to64_1, vdata));
-      diQ1    = unsafeIRDirty_0_N( 
-                   1/*regparms*/, 
-                   hname, VG_(fnptr_to_fnentry)( helper ), 
-                   mkIRExprVec_2( addrQ1, vdataQ1 )
-                );
+      vdataQ1 = defd ? NULL
+                : assignNew('V', mce, Ity_I64, unop(Iop_V256to64_1, vdata));
+      diQ1    = mk_STOREV_call( hname, helper, addrQ1, vdataQ1 );
 
       eBiasQ2 = tyAddr==Ity_I32 ? mkU32(bias+offQ2) : mkU64(bias+offQ2);
       addrQ2  = assignNew('V', mce, tyAddr, binop(mkAdd, addr, eBiasQ2) );
-      vdataQ2 = assignNew('V', mce, Ity_I64, unop(Iop_V256to64_2, vdata));
-      diQ2    = unsafeIRDirty_0_N( 
-                   1/*regparms*/, 
-                   hname, VG_(fnptr_to_fnentry)( helper ), 
-                   mkIRExprVec_2( addrQ2, vdataQ2 )
-                );
+      vdataQ2 = defd ? NULL
+                : assignNew('V', mce, Ity_I64, unop(Iop_V256to64_2, vdata));
+      diQ2    = mk_STOREV_call( hname, helper, addrQ2, vdataQ2 );
 
       eBiasQ3 = tyAddr==Ity_I32 ? mkU32(bias+offQ3) : mkU64(bias+offQ3);
       addrQ3  = assignNew('V', mce, tyAddr, binop(mkAdd, addr, eBiasQ3) );
-      vdataQ3 = assignNew('V', mce, Ity_I64, unop(Iop_V256to64_3, vdata));
-      diQ3    = unsafeIRDirty_0_N( 
-                   1/*regparms*/, 
-                   hname, VG_(fnptr_to_fnentry)( helper ), 
-                   mkIRExprVec_2( addrQ3, vdataQ3 )
-                );
+      vdataQ3 = defd ? NULL
+                : assignNew('V', mce, Ity_I64, unop(Iop_V256to64_3, vdata));
+      diQ3    = mk_STOREV_call( hname, helper, addrQ3, vdataQ3 );
 
       if (guard)
          diQ0->guard = diQ1->guard = diQ2->guard = diQ3->guard = guard;
@@ -5155,20 +5398,14 @@ void do_shadow_Store ( MCEnv* mce,
 
       eBiasLo64 = tyAddr==Ity_I32 ? mkU32(bias+offLo64) : mkU64(bias+offLo64);
       addrLo64  = assignNew('V', mce, tyAddr, binop(mkAdd, addr, eBiasLo64) );
-      vdataLo64 = assignNew('V', mce, Ity_I64, unop(Iop_V128to64, vdata));
-      diLo64    = unsafeIRDirty_0_N( 
-                     1/*regparms*/, 
-                     hname, VG_(fnptr_to_fnentry)( helper ), 
-                     mkIRExprVec_2( addrLo64, vdataLo64 )
-                  );
+      vdataLo64 = defd ? NULL
+                  : assignNew('V', mce, Ity_I64, unop(Iop_V128to64, vdata));
+      diLo64    = mk_STOREV_call( hname, helper, addrLo64, vdataLo64 );
       eBiasHi64 = tyAddr==Ity_I32 ? mkU32(bias+offHi64) : mkU64(bias+offHi64);
       addrHi64  = assignNew('V', mce, tyAddr, binop(mkAdd, addr, eBiasHi64) );
-      vdataHi64 = assignNew('V', mce, Ity_I64, unop(Iop_V128HIto64, vdata));
-      diHi64    = unsafeIRDirty_0_N( 
-                     1/*regparms*/, 
-                     hname, VG_(fnptr_to_fnentry)( helper ), 
-                     mkIRExprVec_2( addrHi64, vdataHi64 )
-                  );
+      vdataHi64 = defd ? NULL
+                  : assignNew('V', mce, Ity_I64, unop(Iop_V128HIto64, vdata));
+      diHi64    = mk_STOREV_call( hname, helper, addrHi64, vdataHi64 );
       if (guard) diLo64->guard = guard;
       if (guard) diHi64->guard = guard;
       setHelperAnns( mce, diLo64 );
@@ -5190,15 +5427,13 @@ void do_shadow_Store ( MCEnv* mce,
          addrAct = assignNew('V', mce, tyAddr, binop(mkAdd, addr, eBias));
       }
 
-      if (ty == Ity_I64) {
+      if (defd) {
+         di = mk_STOREV_call( hname, helper, addrAct, NULL );
+      } else if (ty == Ity_I64) {
          /* We can't do this with regparm 2 on 32-bit platforms, since
             the back ends aren't clever enough to handle 64-bit
             regparm args.  Therefore be different. */
-         di = unsafeIRDirty_0_N( 
-                 1/*regparms*/, 
-                 hname, VG_(fnptr_to_fnentry)( helper ), 
-                 mkIRExprVec_2( addrAct, vdata )
-              );
+         di = mk_STOREV_call( hname, helper, addrAct, vdata );
       } else {
          di = unsafeIRDirty_0_N( 
                  2/*regparms*/, 
@@ -5208,6 +5443,26 @@ void do_shadow_Store ( MCEnv* mce,
               );
       }
       if (guard) di->guard = guard;
+
+      /* Maybe do the common case inline: if the shadow memory is
+         already all-defined and so is the data (or both all
+         undefined), there is nothing to do. */
+      if (inline_shadow_access_ok(mce, end, ty, guard)) {
+         IRAtom *bad, *vbits, *vdataW;
+         ULong  onesW = ty == Ity_I64
+                           ? ~0ULL : (1ULL << (8 * sizeofIRType(ty))) - 1;
+         gen_inline_vabits(mce, ty, addrAct, &bad, &vbits);
+         vdataW = ty == Ity_I64 ? vdata : zwidenToHostWord(mce, vdata);
+         bad = assignNew('V', mce, Ity_I64,
+                  binop(Iop_Or64, bad,
+                        assignNew('V', mce, Ity_I64,
+                           binop(Iop_And64, mkU64(onesW),
+                                 assignNew('V', mce, Ity_I64,
+                                           binop(Iop_Xor64,
+                                                 vbits, vdataW))))));
+         guard_helper_on_bad(mce, di, bad);
+      }
+
       setHelperAnns( mce, di );
       stmt( 'V', mce, IRStmt_Dirty(di) );
    }
@@ -6051,6 +6306,9 @@ static void do_shadow_LoadG ( MCEnv* mce, IRLoadG* lg )
 /*------------------------------------------------------------*/
 
 static void schemeS ( MCEnv* mce, IRStmt* st );
+static void flushBStores ( MCEnv* mce );
+static Bool needsBStoresFlushed ( IRStmt* st );
+static void noteAddrBias ( MCEnv* mce, IRStmt* st );
 
 static Bool isBogusAtom ( IRAtom* at )
 {
@@ -6198,12 +6456,49 @@ static Bool checkForBogusLiterals ( /*FLAT*/ IRStmt* st )
 }
 
 
-IRSB* MC_(instrument) ( VgCallbackClosure* closure,
-                        IRSB* sb_in, 
-                        VexGuestLayout* layout, 
-                        VexGuestExtents* vge,
-                        VexArchInfo* archinfo_host,
-                        IRType gWordTy, IRType hWordTy )
+/* Is 'a' in our own memcmp replacement, in the text of
+   vgpreload_memcheck?  It compares whole words some of whose bytes may
+   be undefined (see MEMCMP in vg_replace_strmem.c), so it is always
+   instrumented as if it had bogus literals in it.  The other
+   replacements are not: the malloc ones rely on the cheap checks to
+   complain about partially undefined arguments.  The preload's range is
+   looked up until it has been mapped, and then kept. */
+static Bool is_in_mc_memcmp ( Addr a )
+{
+   static Addr  preload_avma = 0;
+   static SizeT preload_size = 0;
+   HChar fnname[64];
+
+   if (preload_size == 0) {
+      DebugInfo*   di = VG_(find_DebugInfo)( a );
+      const HChar* filename;
+      if (di == NULL)
+         return False;
+      filename = VG_(DebugInfo_get_filename)( di );
+      if (filename == NULL
+          || VG_(strstr)( filename, "vgpreload_memcheck" ) == NULL)
+         return False;
+      preload_avma = VG_(DebugInfo_get_text_avma)( di );
+      preload_size = VG_(DebugInfo_get_text_size)( di );
+   }
+   if (a - preload_avma >= preload_size
+       || !VG_(get_fnname)( a, fnname, sizeof(fnname) ))
+      return False;
+   return VG_(strstr)( fnname, "memcmp" ) != NULL
+          || VG_(strcmp)( fnname, "bcmp" ) == 0;
+}
+
+
+/* If skipped, the superblock is instrumented as one in which undefined
+   values are not tracked (see MCEnv.trackDefinedness): whatever it
+   writes to memory and registers becomes defined. */
+static IRSB* mc_instrument_wrk ( VgCallbackClosure* closure,
+                                 IRSB* sb_in,
+                                 VexGuestLayout* layout,
+                                 VexGuestExtents* vge,
+                                 VexArchInfo* archinfo_host,
+                                 IRType gWordTy, IRType hWordTy,
+                                 Bool skipped )
 {
    Bool    verboze = 0||False;
    Bool    bogus;
@@ -6242,6 +6537,19 @@ IRSB* MC_(instrument) ( VgCallbackClosure* closure,
    mce.layout         = layout;
    mce.hWordTy        = hWordTy;
    mce.bogusLiterals  = False;
+   mce.bStoresUsed    = 0;
+
+   /* With --definedness-sampling, pick the superblocks in which
+      undefined values are tracked by hashing their guest address, so
+      that the choice is the same each time a superblock is
+      translated. */
+   mce.trackDefinedness = !skipped;
+   if (!skipped
+       && MC_(clo_mc_level) >= 2 && MC_(clo_definedness_sampling) < 100) {
+      ULong h = (ULong)vge->base[0] * 0x9E3779B97F4A7C15ULL;
+      mce.trackDefinedness
+         = (Int)((h >> 32) % 100) < MC_(clo_definedness_sampling);
+   }
 
    /* Do expensive interpretation for Iop_Add32 and Iop_Add64 on
       Darwin.  10.7 is mostly built with LLVM, which uses these for
@@ -6268,6 +6576,14 @@ IRSB* MC_(instrument) ( VgCallbackClosure* closure,
    }
    tl_assert( VG_(sizeXA)( mce.tmpMap ) == sb_in->tyenv->types_used );
 
+   if (MC_(clo_mc_level) == 3) {
+      Int nTmps = sb_in->tyenv->types_used;
+      mce.origBase = VG_(calloc)( "mc.MC_(instrument).2", nTmps + 1,
+                                  sizeof(IRAtom*) );
+      mce.origBias = VG_(calloc)( "mc.MC_(instrument).3", nTmps + 1,
+                                  sizeof(Int) );
+   }
+
    /* Make a preliminary inspection of the statements, to see if there
       are any dodgy-looking literals.  If there are, we generate
       extra-detailed (hence extra-expensive) instrumentation in
@@ -6291,8 +6607,21 @@ IRSB* MC_(instrument) ( VgCallbackClosure* closure,
          }
       }
 
+      /* With --adaptive-definedness-checks=yes, a superblock containing
+         an instruction that gave a definedness error is done the
+         expensive way from then on. */
+      if (!bogus && MC_(clo_adaptive_definedness_checks)
+          && st->tag == Ist_IMark) {
+         Bool pending;
+         bogus = MC_(is_adaptive_site)( (Addr)st->Ist.IMark.addr,
+                                        &pending );
+      }
+
    }
 
+   if (!bogus && is_in_mc_memcmp( vge->base[0] ))
+      bogus = True;
+
    mce.bogusLiterals = bogus;
 
    /* Copy verbatim any IR preamble preceding the first IMark */
@@ -6373,6 +6702,10 @@ IRSB* MC_(instrument) ( VgCallbackClosure* closure,
       }
 
       if (MC_(clo_mc_level) == 3) {
+         if (needsBStoresFlushed(st))
+            flushBStores( &mce );
+         if (st->tag == Ist_WrTmp)
+            noteAddrBias( &mce, st );
          /* See comments on case Ist_CAS below. */
          if (st->tag != Ist_CAS) 
             schemeS( &mce, st );
@@ -6418,8 +6751,24 @@ IRSB* MC_(instrument) ( VgCallbackClosure* closure,
             complainIfUndefined( &mce, st->Ist.Exit.guard, NULL );
             break;
 
-         case Ist_IMark:
+         case Ist_IMark: {
+            Bool pending;
+            if (MC_(clo_adaptive_definedness_checks)
+                && MC_(is_adaptive_site)( (Addr)st->Ist.IMark.addr,
+                                          &pending )
+                && pending) {
+               IRDirty* di = unsafeIRDirty_0_N(
+                                1/*regparms*/,
+                                "MC_(helperc_adaptive_recheck)",
+                                VG_(fnptr_to_fnentry)(
+                                   &MC_(helperc_adaptive_recheck) ),
+                                mkIRExprVec_1(
+                                   mkIRExpr_HWord( st->Ist.IMark.addr ) )
+                             );
+               stmt( 'V', &mce, IRStmt_Dirty(di) );
+            }
             break;
+         }
 
          case Ist_NoOp:
          case Ist_MBE:
@@ -6478,6 +6827,12 @@ IRSB* MC_(instrument) ( VgCallbackClosure* closure,
          stmt('C', &mce, st);
    }
 
+   if (MC_(clo_mc_level) == 3) {
+      flushBStores( &mce );
+      VG_(free)( mce.origBase );
+      VG_(free)( mce.origBias );
+   }
+
    /* Now we need to complain if the jump target is undefined. */
    first_stmt = sb_out->stmts_used;
 
@@ -6507,6 +6862,29 @@ IRSB* MC_(instrument) ( VgCallbackClosure* closure,
    return sb_out;
 }
 
+IRSB* MC_(instrument) ( VgCallbackClosure* closure,
+                        IRSB* sb_in,
+                        VexGuestLayout* layout,
+                        VexGuestExtents* vge,
+                        VexArchInfo* archinfo_host,
+                        IRType gWordTy, IRType hWordTy )
+{
+   return mc_instrument_wrk( closure, sb_in, layout, vge, archinfo_host,
+                             gWordTy, hWordTy, False/*!skipped*/ );
+}
+
+/* For the code skipped with --skip-instrument or --instrument-only. */
+IRSB* MC_(instrument_skipped) ( VgCallbackClosure* closure,
+                                IRSB* sb_in,
+                                VexGuestLayout* layout,
+                                VexGuestExtents* vge,
+                                VexArchInfo* archinfo_host,
+                                IRType gWordTy, IRType hWordTy )
+{
+   return mc_instrument_wrk( closure, sb_in, layout, vge, archinfo_host,
+                             gWordTy, hWordTy, True/*skipped*/ );
+}
+
 /*------------------------------------------------------------*/
 /*--- Post-tree-build final tidying                        ---*/
 /*------------------------------------------------------------*/
@@ -6523,7 +6901,22 @@ IRSB* MC_(instrument) ( VgCallbackClosure* closure,
    register.  After optimisation of the instrumentation, you get a
    test for the definedness of the base register for each memory
    reference, which is kinda pointless.  MC_(final_tidy) therefore
-   looks for such repeated calls and removes all but the first. */
+   looks for such repeated calls and removes all but the first.
+
+   All the value-check helpers are treated alike: a second check of
+   the same guard, even at a different size, tests the same shadow
+   value, and would only report the same undefinedness again.  Since
+   the guards are trees by now, they usually read the shadow of a guest
+   register straight from the guest state, so a Get counts as the same
+   value as an earlier one of the same slice, as long as there has been
+   no write to the guest state in between that could change it.  Once
+   calls have been removed, temporaries which were only computed for
+   their guards are removed too. */
+
+/* How many value checks MC_(final_tidy) saw, and how many of those it
+   removed.  Shown by --stats=yes. */
+ULong MC_(n_value_checks)         = 0;
+ULong MC_(n_value_checks_removed) = 0;
 
 /* A struct for recording which (helper, guard) pairs we have already
    seen. */
@@ -6564,6 +6957,10 @@ static Bool sameIRValue ( IRExpr* e1, IRExpr* e2 )
             appear to be used. */
          return False;
       case Iex_Get:
+         /* MC_(final_tidy) forgets guards which read the guest state
+            as soon as it might have changed. */
+         return e1->Iex.Get.offset == e2->Iex.Get.offset
+                && e1->Iex.Get.ty == e2->Iex.Get.ty;
       case Iex_GetI:
       case Iex_Load:
          /* be conservative - these may not give the same value each
@@ -6580,6 +6977,52 @@ static Bool sameIRValue ( IRExpr* e1, IRExpr* e2 )
    }
 }
 
+/* Does 'e' read any of the guest state in [minoff, maxoff]? */
+
+static Bool readsGuestState ( IRExpr* e, Int minoff, Int maxoff )
+{
+   switch (e->tag) {
+      case Iex_Get:
+         return e->Iex.Get.offset <= maxoff
+                && e->Iex.Get.offset
+                      + sizeofIRType(e->Iex.Get.ty) - 1 >= minoff;
+      case Iex_GetI:
+         return True;
+      case Iex_Binop:
+         return readsGuestState(e->Iex.Binop.arg1, minoff, maxoff)
+                || readsGuestState(e->Iex.Binop.arg2, minoff, maxoff);
+      case Iex_Unop:
+         return readsGuestState(e->Iex.Unop.arg, minoff, maxoff);
+      case Iex_ITE:
+         return readsGuestState(e->Iex.ITE.cond, minoff, maxoff)
+                || readsGuestState(e->Iex.ITE.iftrue, minoff, maxoff)
+                || readsGuestState(e->Iex.ITE.iffalse, minoff, maxoff);
+      default:
+         /* sameIRValue never says these are the same, so it doesn't
+            matter what they read. */
+         return False;
+   }
+}
+
+/* Forget the guards in 'pairs' which read any of the guest state in
+   [minoff, maxoff], since it is being written. */
+
+static void forget_guards_reading ( XArray* /*of Pair*/ pairs,
+                                    Int minoff, Int maxoff )
+{
+   Int i, j, n = VG_(sizeXA)( pairs );
+   for (i = j = 0; i < n; i++) {
+      Pair* pp = VG_(indexXA)( pairs, i );
+      if (readsGuestState(pp->guard, minoff, maxoff))
+         continue;
+      if (j != i)
+         *(Pair*)VG_(indexXA)( pairs, j ) = *pp;
+      j++;
+   }
+   if (j < n)
+      VG_(dropTailXA)( pairs, n - j );
+}
+
 /* See if 'pairs' already has an entry for (entry, guard).  Return
    True if so.  If not, add an entry. */
 
@@ -6591,7 +7034,7 @@ Bool check_or_add ( XArray* /*of Pair*/ pairs, IRExpr* guard, void* entry )
    Int   i, n = VG_(sizeXA)( pairs );
    for (i = 0; i < n; i++) {
       pp = VG_(indexXA)( pairs, i );
-      if (pp->entry == entry && sameIRValue(pp->guard, guard))
+      if (sameIRValue(pp->guard, guard))
          return True;
    }
    p.guard = guard;
@@ -6607,49 +7050,217 @@ static Bool is_helperc_value_checkN_fail ( const HChar* name )
       || 0==VG_(strcmp)(name, "MC_(helperc_value_check1_fail_no_o)")
       || 0==VG_(strcmp)(name, "MC_(helperc_value_check4_fail_no_o)")
       || 0==VG_(strcmp)(name, "MC_(helperc_value_check8_fail_no_o)")
+      || 0==VG_(strcmp)(name, "MC_(helperc_value_checkN_fail_no_o)")
       || 0==VG_(strcmp)(name, "MC_(helperc_value_check0_fail_w_o)")
       || 0==VG_(strcmp)(name, "MC_(helperc_value_check1_fail_w_o)")
       || 0==VG_(strcmp)(name, "MC_(helperc_value_check4_fail_w_o)")
-      || 0==VG_(strcmp)(name, "MC_(helperc_value_check8_fail_w_o)");
+      || 0==VG_(strcmp)(name, "MC_(helperc_value_check8_fail_w_o)")
+      || 0==VG_(strcmp)(name, "MC_(helperc_value_checkN_fail_w_o)");
 }
 
-IRSB* MC_(final_tidy) ( IRSB* sb_in )
+/* Remove the WrTmps whose temporaries are no longer used, now that
+   some of the calls have gone. */
+
+static void count_tmp_uses ( Int* uses, IRExpr* e )
+{
+   Int i;
+   switch (e->tag) {
+      case Iex_RdTmp:
+         uses[e->Iex.RdTmp.tmp]++;
+         return;
+      case Iex_Get: case Iex_Const:
+         return;
+      case Iex_GetI:
+         count_tmp_uses(uses, e->Iex.GetI.ix);
+         return;
+      case Iex_Load:
+         count_tmp_uses(uses, e->Iex.Load.addr);
+         return;
+      case Iex_Unop:
+         count_tmp_uses(uses, e->Iex.Unop.arg);
+         return;
+      case Iex_Binop:
+         count_tmp_uses(uses, e->Iex.Binop.arg1);
+         count_tmp_uses(uses, e->Iex.Binop.arg2);
+         return;
+      case Iex_Triop:
+         count_tmp_uses(uses, e->Iex.Triop.details->arg1);
+         count_tmp_uses(uses, e->Iex.Triop.details->arg2);
+         count_tmp_uses(uses, e->Iex.Triop.details->arg3);
+         return;
+      case Iex_Qop:
+         count_tmp_uses(uses, e->Iex.Qop.details->arg1);
+         count_tmp_uses(uses, e->Iex.Qop.details->arg2);
+         count_tmp_uses(uses, e->Iex.Qop.details->arg3);
+         count_tmp_uses(uses, e->Iex.Qop.details->arg4);
+         return;
+      case Iex_ITE:
+         count_tmp_uses(uses, e->Iex.ITE.cond);
+         count_tmp_uses(uses, e->Iex.ITE.iftrue);
+         count_tmp_uses(uses, e->Iex.ITE.iffalse);
+         return;
+      case Iex_CCall:
+         for (i = 0; e->Iex.CCall.args[i]; i++)
+            count_tmp_uses(uses, e->Iex.CCall.args[i]);
+         return;
+      case Iex_VECRET: case Iex_BBPTR:
+         return;
+      default:
+         ppIRExpr(e);
+         VG_(tool_panic)("memcheck:count_tmp_uses");
+   }
+}
+
+static void count_stmt_tmp_uses ( Int* uses, IRStmt* st )
 {
    Int i;
+   switch (st->tag) {
+      case Ist_NoOp: case Ist_IMark: case Ist_MBE:
+         return;
+      case Ist_AbiHint:
+         count_tmp_uses(uses, st->Ist.AbiHint.base);
+         count_tmp_uses(uses, st->Ist.AbiHint.nia);
+         return;
+      case Ist_Put:
+         count_tmp_uses(uses, st->Ist.Put.data);
+         return;
+      case Ist_PutI:
+         count_tmp_uses(uses, st->Ist.PutI.details->ix);
+         count_tmp_uses(uses, st->Ist.PutI.details->data);
+         return;
+      case Ist_WrTmp:
+         count_tmp_uses(uses, st->Ist.WrTmp.data);
+         return;
+      case Ist_Store:
+         count_tmp_uses(uses, st->Ist.Store.addr);
+         count_tmp_uses(uses, st->Ist.Store.data);
+         return;
+      case Ist_StoreG:
+         count_tmp_uses(uses, st->Ist.StoreG.details->addr);
+         count_tmp_uses(uses, st->Ist.StoreG.details->data);
+         count_tmp_uses(uses, st->Ist.StoreG.details->guard);
+         return;
+      case Ist_LoadG:
+         count_tmp_uses(uses, st->Ist.LoadG.details->addr);
+         count_tmp_uses(uses, st->Ist.LoadG.details->alt);
+         count_tmp_uses(uses, st->Ist.LoadG.details->guard);
+         return;
+      case Ist_CAS:
+         count_tmp_uses(uses, st->Ist.CAS.details->addr);
+         if (st->Ist.CAS.details->expdHi)
+            count_tmp_uses(uses, st->Ist.CAS.details->expdHi);
+         count_tmp_uses(uses, st->Ist.CAS.details->expdLo);
+         if (st->Ist.CAS.details->dataHi)
+            count_tmp_uses(uses, st->Ist.CAS.details->dataHi);
+         count_tmp_uses(uses, st->Ist.CAS.details->dataLo);
+         return;
+      case Ist_LLSC:
+         count_tmp_uses(uses, st->Ist.LLSC.addr);
+         if (st->Ist.LLSC.storedata)
+            count_tmp_uses(uses, st->Ist.LLSC.storedata);
+         return;
+      case Ist_Dirty: {
+         IRDirty* di = st->Ist.Dirty.details;
+         count_tmp_uses(uses, di->guard);
+         for (i = 0; di->args[i]; i++)
+            count_tmp_uses(uses, di->args[i]);
+         if (di->mAddr)
+            count_tmp_uses(uses, di->mAddr);
+         return;
+      }
+      case Ist_Exit:
+         count_tmp_uses(uses, st->Ist.Exit.guard);
+         return;
+      case Ist_Flush:
+         count_tmp_uses(uses, st->Ist.Flush.addr);
+         return;
+      default:
+         ppIRStmt(st);
+         VG_(tool_panic)("memcheck:count_stmt_tmp_uses");
+   }
+}
+
+static void remove_dead_tmps ( IRSB* sb )
+{
+   Int  i;
+   Int* uses = VG_(calloc)( "mc.rdt.1", sb->tyenv->types_used + 1,
+                            sizeof(Int) );
+   count_tmp_uses(uses, sb->next);
+   /* Go backwards, so that a WrTmp which is removed no longer keeps
+      the ones before it alive. */
+   for (i = sb->stmts_used - 1; i >= 0; i--) {
+      IRStmt* st = sb->stmts[i];
+      if (st->tag == Ist_WrTmp && uses[st->Ist.WrTmp.tmp] == 0
+          && st->Ist.WrTmp.data->tag != Iex_Load) {
+         sb->stmts[i] = IRStmt_NoOp();
+         continue;
+      }
+      count_stmt_tmp_uses(uses, st);
+   }
+   VG_(free)( uses );
+}
+
+IRSB* MC_(final_tidy) ( IRSB* sb_in )
+{
+   Int i, j;
    IRStmt*   st;
    IRDirty*  di;
    IRExpr*   guard;
    IRCallee* cee;
    Bool      alreadyPresent;
+   Bool      anyRemoved = False;
    XArray*   pairs = VG_(newXA)( VG_(malloc), "mc.ft.1",
                                  VG_(free), sizeof(Pair) );
    /* Scan forwards through the statements.  Each time a call to one
       of the relevant helpers is seen, check if we have made a
-      previous call to the same helper using the same guard
-      expression, and if so, delete the call. */
+      previous call to one of them using the same guard expression,
+      and if so, delete the call.  Writes to the guest state make us
+      forget the guards which read it. */
    for (i = 0; i < sb_in->stmts_used; i++) {
       st = sb_in->stmts[i];
       tl_assert(st);
+      if (st->tag == Ist_Put) {
+         Int minoff = st->Ist.Put.offset;
+         Int maxoff = minoff + sizeofIRType(typeOfIRExpr(sb_in->tyenv,
+                                               st->Ist.Put.data)) - 1;
+         forget_guards_reading( pairs, minoff, maxoff );
+         continue;
+      }
+      if (st->tag == Ist_PutI) {
+         forget_guards_reading( pairs, 0, 0x7FFFFFFF );
+         continue;
+      }
       if (st->tag != Ist_Dirty)
          continue;
       di = st->Ist.Dirty.details;
+      for (j = 0; j < di->nFxState; j++) {
+         if (di->fxState[j].fx != Ifx_Read) {
+            forget_guards_reading( pairs, 0, 0x7FFFFFFF );
+            break;
+         }
+      }
       guard = di->guard;
       tl_assert(guard);
       if (0) { ppIRExpr(guard); VG_(printf)("\n"); }
       cee = di->cee;
       if (!is_helperc_value_checkN_fail( cee->name )) 
          continue;
-       /* Ok, we have a call to helperc_value_check0/1/4/8_fail with
-          guard 'guard'.  Check if we have already seen a call to this
-          function with the same guard.  If so, delete it.  If not,
+       /* Ok, we have a call to helperc_value_check0/1/4/8/N_fail with
+          guard 'guard'.  Check if we have already seen a call to one
+          of them with the same guard.  If so, delete it.  If not,
           add it to the set of calls we do know about. */
+      MC_(n_value_checks)++;
       alreadyPresent = check_or_add( pairs, guard, cee->addr );
       if (alreadyPresent) {
          sb_in->stmts[i] = IRStmt_NoOp();
+         MC_(n_value_checks_removed)++;
+         anyRemoved = True;
          if (0) VG_(printf)("XX\n");
       }
    }
    VG_(deleteXA)( pairs );
+   if (anyRemoved)
+      remove_dead_tmps( sb_in );
    return sb_in;
 }
 
@@ -6747,6 +7358,9 @@ static IRAtom* gen_guarded_load_b ( MCEnv* mce, Int szB,
          trump all legitimate otags via Max32, and it's pretty
          obviously bogus. */
    }
+   /* As for the V bits, a repeat with no store in between is
+      pointless. */
+   di->idempotent = True;
    /* no need to mess with any annotations.  This call accesses
       neither guest state nor guest memory. */
    stmt( 'B', mce, IRStmt_Dirty(di) );
@@ -7242,14 +7856,175 @@ static void do_origins_Store_guarded ( MCEnv* mce,
 }
 
 
-/* Generate IR for origin shadowing for a plain store. */
+/* Generate the origin stores collected by do_origins_Store_plain,
+   with a single helper call if there is more than one. */
+static void flushBStores ( MCEnv* mce )
+{
+   Int      i;
+   UWord    layout;
+   IRAtom*  ea;
+   IRAtom*  d01;
+   IRAtom*  d23;
+   IRDirty* di;
+   IRType   aTy;
+   Int      n = mce->bStoresUsed;
+
+   if (n == 0)
+      return;
+   mce->bStoresUsed = 0;
+   if (n == 1) {
+      gen_store_b( mce, mce->bStoreSzB[0], mce->bStoreBase,
+                   mce->bStoreBias[0], mce->bStoreData[0], NULL );
+      return;
+   }
+
+   layout = n - 1;
+   for (i = 0; i < n; i++) {
+      Int   rel   = mce->bStoreBias[i] - mce->bStoreBias[0];
+      UWord lgSzB = mce->bStoreSzB[i] == 1 ? 0
+                    : mce->bStoreSzB[i] == 2 ? 1
+                    : mce->bStoreSzB[i] == 4 ? 2 : 3;
+      tl_assert(rel >= -128 && rel <= 127);
+      layout |= (lgSzB | ((UWord)(rel & 0xFF) << 2)) << (2 + 10 * i);
+   }
+
+   aTy = typeOfIRExpr( mce->sb->tyenv, mce->bStoreBase );
+   ea  = mce->bStoreBase;
+   if (mce->bStoreBias[0] != 0) {
+      IRAtom* off = aTy == Ity_I32 ? mkU32( mce->bStoreBias[0] )
+                                   : mkU64( (Long)mce->bStoreBias[0] );
+      ea = assignNew( 'B', mce, aTy,
+                      binop(aTy == Ity_I32 ? Iop_Add32 : Iop_Add64,
+                            ea, off) );
+   }
+
+   if (mce->hWordTy == Ity_I64) {
+      d01 = assignNew( 'B', mce, Ity_I64,
+                       binop(Iop_32HLto64, mce->bStoreData[1],
+                                           mce->bStoreData[0]) );
+      if (n == 2)
+         d23 = mkU64(0);
+      else if (n == 3)
+         d23 = assignNew( 'B', mce, Ity_I64,
+                          unop(Iop_32Uto64, mce->bStoreData[2]) );
+      else
+         d23 = assignNew( 'B', mce, Ity_I64,
+                          binop(Iop_32HLto64, mce->bStoreData[3],
+                                              mce->bStoreData[2]) );
+   } else {
+      tl_assert(n == 2);
+      d01 = mce->bStoreData[0];
+      d23 = mce->bStoreData[1];
+   }
+
+   di = unsafeIRDirty_0_N( 2/*regparms*/,
+           "MC_(helperc_b_store_batch)",
+           VG_(fnptr_to_fnentry)( &MC_(helperc_b_store_batch) ),
+           mkIRExprVec_4( ea, mkIRExpr_HWord( layout ), d01, d23 )
+        );
+   /* As with gen_store_b, this accesses neither guest state nor
+      guest memory. */
+   stmt( 'B', mce, IRStmt_Dirty(di) );
+}
+
+/* Must any origin stores collected so far be generated before the
+   instrumentation of 'st'?  Yes, unless 'st' neither reads origins
+   from nor writes them to memory, and can't leave the block. */
+static Bool needsBStoresFlushed ( IRStmt* st )
+{
+   switch (st->tag) {
+      case Ist_NoOp: case Ist_IMark: case Ist_Put: case Ist_PutI:
+      case Ist_Store:
+         return False;
+      case Ist_WrTmp:
+         return st->Ist.WrTmp.data->tag == Iex_Load;
+      default:
+         return True;
+   }
+}
+
+/* Note 'tmp = st.data' in mce->origBase/origBias if it is a constant
+   offset from some other atom. */
+static void noteAddrBias ( MCEnv* mce, IRStmt* st )
+{
+   IRExpr* e = st->Ist.WrTmp.data;
+   IRExpr* base;
+   Long    bias;
+   IRTemp  tmp;
+
+   if (e->tag != Iex_Binop
+       || e->Iex.Binop.arg1->tag != Iex_RdTmp
+       || e->Iex.Binop.arg2->tag != Iex_Const)
+      return;
+   switch (e->Iex.Binop.op) {
+      case Iop_Add32: case Iop_Sub32:
+         bias = (Int)e->Iex.Binop.arg2->Iex.Const.con->Ico.U32;
+         break;
+      case Iop_Add64: case Iop_Sub64:
+         bias = (Long)e->Iex.Binop.arg2->Iex.Const.con->Ico.U64;
+         break;
+      default:
+         return;
+   }
+   if (e->Iex.Binop.op == Iop_Sub32 || e->Iex.Binop.op == Iop_Sub64)
+      bias = -bias;
+
+   base = e->Iex.Binop.arg1;
+   tmp  = base->Iex.RdTmp.tmp;
+   if (mce->origBase[tmp]) {
+      bias += mce->origBias[tmp];
+      base  = mce->origBase[tmp];
+   }
+   /* Only small offsets are of any use to do_origins_Store_plain. */
+   if (bias < -0x10000 || bias > 0x10000)
+      return;
+   mce->origBase[st->Ist.WrTmp.tmp] = base;
+   mce->origBias[st->Ist.WrTmp.tmp] = (Int)bias;
+}
+
+/* Generate IR for origin shadowing for a plain store.  Stores of up
+   to 8 bytes are collected in mce, so that runs of stores near to
+   each other (register spills, initialising a struct, etc) are done
+   with a single helper call. */
 static void do_origins_Store_plain ( MCEnv* mce,
                                      IREndness stEnd,
                                      IRExpr* stAddr,
                                      IRExpr* stData )
 {
-   do_origins_Store_guarded ( mce, stEnd, stAddr, stData,
-                              NULL/*guard*/ );
+   Int     dszB, bias, i;
+   IRAtom* base;
+   IRAtom* dataB;
+
+   tl_assert(isIRAtom(stAddr));
+   tl_assert(isIRAtom(stData));
+   dszB = sizeofIRType( typeOfIRExpr(mce->sb->tyenv, stData ) );
+   if (dszB > 8) {
+      flushBStores( mce );
+      do_origins_Store_guarded ( mce, stEnd, stAddr, stData,
+                                 NULL/*guard*/ );
+      return;
+   }
+   dataB = schemeE( mce, stData );
+
+   base = stAddr;
+   bias = 0;
+   if (stAddr->tag == Iex_RdTmp && mce->origBase[stAddr->Iex.RdTmp.tmp]) {
+      base = mce->origBase[stAddr->Iex.RdTmp.tmp];
+      bias = mce->origBias[stAddr->Iex.RdTmp.tmp];
+   }
+
+   if (mce->bStoresUsed > 0) {
+      Int rel = bias - mce->bStoreBias[0];
+      if (!eqIRAtom(base, mce->bStoreBase) || rel < -128 || rel > 127)
+         flushBStores( mce );
+   }
+   i = mce->bStoresUsed++;
+   mce->bStoreBase    = base;
+   mce->bStoreSzB[i]  = dszB;
+   mce->bStoreBias[i] = bias;
+   mce->bStoreData[i] = dataB;
+   if (mce->bStoresUsed == MC_B_BATCH_MAX)
+      flushBStores( mce );
 }
 
 
@@ -102,6 +102,15 @@ typedef
       VG_USERREQ__CHECK_MEM_IS_UNADDRESSABLE,
       VG_USERREQ__CHECK_MEM_IS_UNDEFINED,
 
+      VG_USERREQ__CHECK_MEM_EXTENTS_ARE_ADDRESSABLE,
+      VG_USERREQ__CHECK_MEM_EXTENTS_ARE_DEFINED,
+      VG_USERREQ__MAKE_MEM_EXTENTS_DEFINED_IF_ADDRESSABLE,
+
+      VG_USERREQ__MAKE_MEM_BATCH,
+
+      VG_USERREQ__LEAK_CHECK_IGNORE_RANGE,
+      VG_USERREQ__LEAK_CHECK_UNIGNORE_RANGE,
+
       /* This is just for memcheck's internal use - don't use it */
       _VG_USERREQ__MEMCHECK_RECORD_OVERLAP_ERROR 
          = VG_USERREQ_TOOL_BASE('M','C') + 256
@@ -139,6 +148,24 @@ typedef
                             VG_USERREQ__MAKE_MEM_DEFINED_IF_ADDRESSABLE, \
                             (_qzz_addr), (_qzz_len), 0, 0, 0)
 
+/* The states for VALGRIND_MAKE_MEM_BATCH. */
+#define VALGRIND_MEM_NOACCESS                0
+#define VALGRIND_MEM_UNDEFINED               1
+#define VALGRIND_MEM_DEFINED                 2
+#define VALGRIND_MEM_DEFINED_IF_ADDRESSABLE  3
+
+/* Do many of the four requests above with one request, which is much
+   cheaper than doing them one by one, for example in a pool allocator
+   that marks a lot of small blocks at a time.  _qzz_triples points to
+   an array of 3 * _qzz_n unsigned longs, which are triples of
+   (address, length, state), the state being one of the
+   VALGRIND_MEM_ values above.  They are applied in order.  Returns -1
+   when run on Valgrind and 0 otherwise. */
+#define VALGRIND_MAKE_MEM_BATCH(_qzz_triples,_qzz_n)             \
+    VALGRIND_DO_CLIENT_REQUEST_EXPR(0 /* default return */,      \
+                            VG_USERREQ__MAKE_MEM_BATCH,          \
+                            (_qzz_triples), (_qzz_n), 0, 0, 0)
+
 /* Create a block-description handle.  The description is an ascii
    string which is included in any messages pertaining to addresses
    within the specified memory range.  Has no other effect on the
@@ -203,6 +230,38 @@ typedef
                             VG_USERREQ__CHECK_MEM_IS_UNDEFINED,    \
                             (_qzz_addr), (_qzz_len), 0, 0, 0)
 
+/* The following three do the same as VALGRIND_CHECK_MEM_IS_ADDRESSABLE,
+   VALGRIND_CHECK_MEM_IS_DEFINED and
+   VALGRIND_MAKE_MEM_DEFINED_IF_ADDRESSABLE, but for many address ranges
+   in one go, such as the fields of each element of an array of
+   structs.  _qzz_extents points to an array of 2 * _qzz_nextents
+   unsigned longs, which are pairs of (offset, length) giving the ranges
+   of one element, with offsets relative to the start of the element.
+   They are applied to _qzz_count elements, the first at _qzz_base, the
+   next at _qzz_base + _qzz_stride, and so on.  The checks stop at the
+   first range that fails, print an error message for it and return the
+   address of its first offending byte; otherwise they return zero. */
+#define VALGRIND_CHECK_MEM_EXTENTS_ARE_ADDRESSABLE(_qzz_base,            \
+           _qzz_extents,_qzz_nextents,_qzz_count,_qzz_stride)            \
+    VALGRIND_DO_CLIENT_REQUEST_EXPR(0,                                   \
+                      VG_USERREQ__CHECK_MEM_EXTENTS_ARE_ADDRESSABLE,     \
+                      (_qzz_base), (_qzz_extents), (_qzz_nextents),      \
+                      (_qzz_count), (_qzz_stride))
+
+#define VALGRIND_CHECK_MEM_EXTENTS_ARE_DEFINED(_qzz_base,                \
+           _qzz_extents,_qzz_nextents,_qzz_count,_qzz_stride)            \
+    VALGRIND_DO_CLIENT_REQUEST_EXPR(0,                                   \
+                      VG_USERREQ__CHECK_MEM_EXTENTS_ARE_DEFINED,         \
+                      (_qzz_base), (_qzz_extents), (_qzz_nextents),      \
+                      (_qzz_count), (_qzz_stride))
+
+#define VALGRIND_MAKE_MEM_EXTENTS_DEFINED_IF_ADDRESSABLE(_qzz_base,      \
+           _qzz_extents,_qzz_nextents,_qzz_count,_qzz_stride)            \
+    VALGRIND_DO_CLIENT_REQUEST_EXPR(0,                                   \
+                      VG_USERREQ__MAKE_MEM_EXTENTS_DEFINED_IF_ADDRESSABLE, \
+                      (_qzz_base), (_qzz_extents), (_qzz_nextents),      \
+                      (_qzz_count), (_qzz_stride))
+
 /* Do a full memory leak check (like --leak-check=full) mid-execution. */
 #define VALGRIND_DO_LEAK_CHECK                                   \
     VALGRIND_DO_CLIENT_REQUEST_STMT(VG_USERREQ__DO_LEAK_CHECK,   \
@@ -316,5 +375,20 @@ typedef
        VG_USERREQ__ENABLE_ADDR_ERROR_REPORTING_IN_RANGE,       \
        (_qzz_addr), (_qzz_len), 0, 0, 0)
 
+/* Tell the leak checker that the _qzz_len bytes at _qzz_addr never hold
+   pointers to heap blocks, so that it needn't scan them for any.  Worth
+   doing for big data buffers, which can take a lot of a leak search's
+   time.  The range is scanned again after it is unmapped, or after
+   VALGRIND_LEAK_CHECK_UNIGNORE_RANGE. */
+#define VALGRIND_LEAK_CHECK_IGNORE_RANGE(_qzz_addr,_qzz_len)       \
+    VALGRIND_DO_CLIENT_REQUEST_STMT(                               \
+       VG_USERREQ__LEAK_CHECK_IGNORE_RANGE,                        \
+       (_qzz_addr), (_qzz_len), 0, 0, 0)
+
+#define VALGRIND_LEAK_CHECK_UNIGNORE_RANGE(_qzz_addr,_qzz_len)     \
+    VALGRIND_DO_CLIENT_REQUEST_STMT(                               \
+       VG_USERREQ__LEAK_CHECK_UNIGNORE_RANGE,                      \
+       (_qzz_addr), (_qzz_len), 0, 0, 0)
+
 #endif
 
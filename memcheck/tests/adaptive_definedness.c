@@ -0,0 +1,55 @@
+#include <stdio.h>
+#include "../memcheck.h"
+
+/* --adaptive-definedness-checks=yes.  Comparing a partly undefined value
+   with zero gives a false error with the cheap interpretation of
+   CmpEQ, since the defined bits already differ; after the recheck it
+   runs cleanly, so its error is dropped.  A comparison of a wholly
+   undefined value gives the error again when rerun, so it is reported
+   then.  One which is never rerun is reported at exit. */
+
+__attribute__((noinline))
+static int is_zero(volatile long* p)
+{
+   if (*p == 0)
+      return 1;
+   return 0;
+}
+
+__attribute__((noinline))
+static int is_zero_twice(volatile long* p)
+{
+   if (*p == 0)
+      return 1;
+   return 0;
+}
+
+__attribute__((noinline))
+static int is_zero_once(volatile long* p)
+{
+   if (*p == 0)
+      return 1;
+   return 0;
+}
+
+int main(void)
+{
+   volatile long partly = 0x1200;
+   volatile long wholly, once;
+   int i;
+
+   (void)VALGRIND_MAKE_MEM_UNDEFINED(&partly, 1);
+
+   for (i = 0; i < 2; i++) {
+      is_zero(&partly);
+      fprintf(stderr, "partly undefined, run %d\n", i + 1);
+   }
+   for (i = 0; i < 2; i++) {
+      is_zero_twice(&wholly);
+      fprintf(stderr, "wholly undefined, run %d\n", i + 1);
+   }
+   is_zero_once(&once);
+   fprintf(stderr, "wholly undefined, run once\n");
+
+   return 0;
+}
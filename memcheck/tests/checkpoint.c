@@ -0,0 +1,66 @@
+/* Tests VALGRIND_CHECKPOINT and VALGRIND_RESTORE_CHECKPOINT: what is
+   done after a checkpoint, to the program's memory, memcheck's shadow
+   memory and the heap, is undone when it is restored, and restoring an
+   older checkpoint ends the newer ones. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../memcheck.h"
+
+static int   counter;
+static char  buf[16];
+static char* block;
+
+static const char* buf_state ( void )
+{
+   unsigned char vbits[sizeof(buf)];
+   if (VALGRIND_GET_VBITS(buf, vbits, sizeof(buf)) != 1)
+      return "?";
+   return vbits[0] == 0 ? "defined" : "undefined";
+}
+
+/* The output is buffered: flush it before the process is forked, or
+   ends without exiting normally. */
+static void say ( const char* what, unsigned r )
+{
+   printf("%-18s returned %u, counter %d, buf %s, %s\n", what, r,
+          counter, buf_state(), block ? "block allocated" : "no block");
+   fflush(stdout);
+}
+
+int main ( void )
+{
+   unsigned r1, r2;
+
+   memset(buf, 'x', sizeof(buf));
+   counter = 1;
+   printf("restoring a checkpoint not made: %d\n",
+          VALGRIND_RESTORE_CHECKPOINT(1));
+   fflush(stdout);
+
+   r1 = VALGRIND_CHECKPOINT;
+   say("checkpoint 1:", r1);
+   if (r1 == 1) {
+      // Last: nothing done after checkpoint 1 is left, not even leaks.
+      return 0;
+   }
+
+   counter = 2;
+   VALGRIND_MAKE_MEM_UNDEFINED(buf, sizeof(buf));
+   block = malloc(100);
+
+   r2 = VALGRIND_CHECKPOINT;
+   say("checkpoint 2:", r2);
+   if (r2 == 0) {
+      counter = 3;
+      VALGRIND_MAKE_MEM_DEFINED(buf, sizeof(buf));
+      block = malloc(200);
+      say("before restoring:", 0);
+      (void)VALGRIND_RESTORE_CHECKPOINT(2);
+   } else {
+      (void)VALGRIND_RESTORE_CHECKPOINT(1);
+   }
+   printf("not reached\n");
+   return 1;
+}
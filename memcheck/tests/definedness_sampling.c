@@ -0,0 +1,45 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+// Tests --definedness-sampling, at 0 and 100 percent.  At 0 only the
+// addressability errors are reported, and what the program copies is
+// taken to be defined; but memory it never wrote is still undefined,
+// for the system calls.
+
+__attribute__((noinline))
+static void copy ( char* dst, const char* src, int n )
+{
+   int i;
+   for (i = 0; i < n; i++)
+      dst[i] = src[i];
+}
+
+int main ( void )
+{
+   char* p = malloc(10);
+   char* q = malloc(10);
+   int*  x = malloc(sizeof(int));
+   int   fd = open("/dev/null", O_WRONLY);
+
+   // Definedness errors.
+   if (*x == 42)
+      fprintf(stderr, "42\n");
+   copy(q, p, 10);
+   if (write(fd, q, 10) != 10)
+      fprintf(stderr, "write of copy failed\n");
+   if (write(fd, p + 5, 5) != 5)
+      fprintf(stderr, "write failed\n");
+
+   // Addressability errors.
+   p[10] = 'x';
+   free(q);
+   fprintf(stderr, "%c\n", q[0] == 'x' ? 'x' : '-');
+
+   free(p);
+   free(x);
+   close(fd);
+   return 0;
+}
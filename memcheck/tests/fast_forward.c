@@ -0,0 +1,40 @@
+/* Tests --fast-forward.  Nothing is checked until the instrumentation
+   starts, either at the VALGRIND_STOP_FAST_FORWARD request (when run
+   with an argument) or on entry to late_phase (--fast-forward-fn).  The
+   memory there is then taken to be defined, so only what is allocated
+   afterwards is undefined. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../memcheck.h"
+
+__attribute__((noinline))
+static int check ( const char* what, int* p )
+{
+   if (*p == 42)
+      return 1;
+   fprintf(stderr, "checked %s\n", what);
+   return 0;
+}
+
+__attribute__((noinline))
+static void late_phase ( int* early )
+{
+   int* late = malloc(sizeof(int));
+
+   check("early block, after", early);   // not an error
+   check("late block", late);            // an error
+   free(late);
+}
+
+int main ( int argc, char** argv )
+{
+   int* early = malloc(sizeof(int));
+
+   check("early block, before", early);  // not looked at
+   if (argc > 1)
+      VALGRIND_STOP_FAST_FORWARD;
+   late_phase(early);
+   free(early);
+   return 0;
+}
@@ -0,0 +1,44 @@
+#include <setjmp.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* With --guard-pages-above=65536, a write a page below a 64KB heap
+   block hits the guard page below it, instead of the block before it.
+   Memcheck reports the invalid write before the fault. */
+
+static sigjmp_buf env;
+
+static void handler(int sig)
+{
+   siglongjmp(env, sig);
+}
+
+int main(void)
+{
+   struct sigaction sa;
+   char* a;
+   char* b;
+   int   sig;
+
+   memset(&sa, 0, sizeof(sa));
+   sa.sa_handler = handler;
+   sigaction(SIGSEGV, &sa, NULL);
+
+   a = malloc(65536);
+   b = malloc(65536);
+
+   sig = sigsetjmp(env, 1);
+   if (sig == 0) {
+      b[-4096] = 1;
+      fprintf(stderr, "underrun: no fault\n");
+   } else {
+      fprintf(stderr, "underrun: %s\n",
+              sig == SIGSEGV ? "SIGSEGV" : "other signal");
+   }
+
+   free(b);
+   free(a);
+   return 0;
+}
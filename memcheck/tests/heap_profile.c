@@ -0,0 +1,31 @@
+#include <stdlib.h>
+
+// Tests --heap-profile: the heap grows from two allocation sites and
+// then shrinks, as in massif's basic test, and the profile is shown by
+// ms_print.  Everything is freed, so memcheck has nothing to report.
+
+#define N 24
+
+__attribute__((noinline))
+static void* small ( void )
+{
+   return malloc(400);
+}
+
+__attribute__((noinline))
+static void* large ( void )
+{
+   return malloc(1200);
+}
+
+int main ( void )
+{
+   int   i;
+   void* a[N];
+
+   for (i = 0; i < N; i++)
+      a[i] = i % 3 == 0 ? large() : small();
+   for (i = 0; i < N; i++)
+      free(a[i]);
+   return 0;
+}
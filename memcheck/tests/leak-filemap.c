@@ -0,0 +1,73 @@
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "leak.h"
+#include "../memcheck.h"
+
+/* Heap blocks pointed to only from file mappings: from custom blocks
+   (VALGRIND_MALLOCLIKE_BLOCK) carved out of them, and from the mappings
+   themselves.  One of the files is then truncated, so that reading the
+   second page of its mapping gives SIGBUS, which the leak search must
+   survive.  The blocks pointed to from there are reported as lost. */
+
+static char* map_file(const char* name, size_t len, int* fd)
+{
+   char* p;
+   *fd = open(name, O_RDWR|O_CREAT|O_TRUNC, 0600);
+   if (*fd < 0 || ftruncate(*fd, len) != 0) {
+      perror(name);
+      exit(1);
+   }
+   unlink(name);
+   p = mmap(NULL, len, PROT_READ|PROT_WRITE, MAP_SHARED, *fd, 0);
+   if (p == MAP_FAILED) {
+      perror("mmap");
+      exit(1);
+   }
+   return p;
+}
+
+static void* volatile custom_kept;
+static void* volatile custom_cut;
+
+int main(void)
+{
+   DECLARE_LEAK_COUNTERS;
+   long  page = sysconf(_SC_PAGESIZE);
+   int   kept_fd, cut_fd;
+   char* kept;
+   char* cut;
+
+   GET_INITIAL_LEAK_COUNTS;
+
+   kept = map_file("leak-filemap.tmp1", 2 * page, &kept_fd);
+   cut  = map_file("leak-filemap.tmp2", 2 * page, &cut_fd);
+
+   /* Reachable, from a custom block in a mapping which stays whole. */
+   custom_kept = kept + page + 64;
+   VALGRIND_MALLOCLIKE_BLOCK(custom_kept, 64, 0, 0);
+   *(void**)custom_kept = malloc(16);
+
+   /* Reachable, from the readable first page of the truncated one. */
+   *(void**)(cut + 64) = malloc(24);
+
+   /* Lost: the custom block holding the only pointer, and the page it is
+      in, become unreadable. */
+   custom_cut = cut + page + 64;
+   VALGRIND_MALLOCLIKE_BLOCK(custom_cut, 64, 0, 0);
+   *(void**)custom_cut = malloc(32);
+   *(void**)(cut + page + 256) = malloc(40);
+
+   if (ftruncate(cut_fd, page) != 0) {
+      perror("ftruncate");
+      exit(1);
+   }
+
+   CLEAR_CALLER_SAVED_REGS;
+   GET_FINAL_LEAK_COUNTS;
+   PRINT_LEAK_COUNTS(stderr);
+
+   return 0;
+}
@@ -0,0 +1,70 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "tests/sys_mman.h"
+#include "leak.h"
+#include "../memcheck.h"
+
+// Tests VALGRIND_LEAK_CHECK_IGNORE_RANGE.  A block which is pointed to
+// only from an ignored range is lost, and so is what it points to; once
+// a range is no longer ignored, or has been unmapped and mapped again,
+// its pointers count again.
+
+#define PAGE 4096
+
+static void* ignored[512];
+static void* scanned[4];
+
+static char* page_a;
+static char* page_b;
+
+__attribute__((noinline))
+static void make_blocks ( void )
+{
+   void** lost;
+
+   // 100 bytes only reachable from 'ignored', and 20 from those.
+   lost = malloc(100);
+   lost[0] = malloc(20);
+   ignored[100] = lost;
+   VALGRIND_LEAK_CHECK_IGNORE_RANGE(ignored, sizeof(ignored));
+
+   // 200 bytes reachable from elsewhere as well.
+   scanned[1] = malloc(200);
+   ignored[200] = scanned[1];
+
+   // 300 bytes from a page ignored, then not any more.
+   page_a = mmap(NULL, PAGE, PROT_READ|PROT_WRITE,
+                 MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+   VALGRIND_LEAK_CHECK_IGNORE_RANGE(page_a, PAGE);
+   *(void**)(page_a + 64) = malloc(300);
+   VALGRIND_LEAK_CHECK_UNIGNORE_RANGE(page_a, PAGE);
+
+   // 400 bytes from a page ignored, unmapped, and mapped again.
+   page_b = mmap(NULL, PAGE, PROT_READ|PROT_WRITE,
+                 MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+   VALGRIND_LEAK_CHECK_IGNORE_RANGE(page_b, PAGE);
+   munmap(page_b, PAGE);
+   page_b = mmap(page_b, PAGE, PROT_READ|PROT_WRITE,
+                 MAP_PRIVATE|MAP_ANONYMOUS|MAP_FIXED, -1, 0);
+   *(void**)(page_b + 64) = malloc(400);
+}
+
+int main ( void )
+{
+   DECLARE_LEAK_COUNTERS;
+
+   GET_INITIAL_LEAK_COUNTS;
+
+   make_blocks();
+   CLEAR_CALLER_SAVED_REGS;
+
+   GET_FINAL_LEAK_COUNTS;
+
+   PRINT_LEAK_COUNTS(stderr);
+
+   free(scanned[1]);
+   free(*(void**)(page_a + 64));
+   free(*(void**)(page_b + 64));
+   return 0;
+}
@@ -0,0 +1,95 @@
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#include <sys/wait.h>
+#include "tests/sys_mman.h"
+#include "../memcheck.h"
+
+// Tests --incremental-leak-check on memory which can change without a
+// store by this process: a MAP_SHARED file mapping, written to through
+// the file, and a SysV shm segment, written to by a child process.
+// Each search must see the change.
+
+static unsigned long hidden[2];   // the blocks' addresses, not as pointers
+
+static void search ( const char* what )
+{
+   unsigned long leaked, dubious, reachable, suppressed;
+   VALGRIND_DO_QUICK_LEAK_CHECK;
+   VALGRIND_COUNT_LEAK_BLOCKS(leaked, dubious, reachable, suppressed);
+   (void)reachable; (void)suppressed;
+   fprintf(stderr, "%-36s %lu lost, %lu possibly lost\n",
+           what, leaked, dubious);
+}
+
+__attribute__((noinline))
+static void* block ( int i )
+{
+   return (void*)~hidden[i];
+}
+
+// Sets *p in a child process; only the kernel tells us about it.
+static void set_by_child ( void** p, void* val )
+{
+   pid_t pid = fork();
+   if (pid == 0) {
+      *p = val;
+      _exit(0);
+   }
+   waitpid(pid, NULL, 0);
+}
+
+int main ( void )
+{
+   long   page = sysconf(_SC_PAGESIZE);
+   int    fd, shmid;
+   void** file;
+   void** shm;
+   void*  val;
+
+   fd = open("leak-incremental-shared.tmp", O_RDWR|O_CREAT|O_TRUNC, 0600);
+   if (fd < 0 || ftruncate(fd, page) != 0) {
+      perror("open");
+      return 1;
+   }
+   unlink("leak-incremental-shared.tmp");
+   file = mmap(NULL, page, PROT_READ|PROT_WRITE, MAP_SHARED, fd, 0);
+   shmid = shmget(IPC_PRIVATE, page, IPC_CREAT|0600);
+   shm = shmat(shmid, NULL, 0);
+   shmctl(shmid, IPC_RMID, NULL);
+   if (file == MAP_FAILED || shm == (void*)-1) {
+      perror("map");
+      return 1;
+   }
+   // A shm segment is not a root, so hold the pointer in a custom block.
+   VALGRIND_MALLOCLIKE_BLOCK(shm, 64, 0, 0);
+
+   file[10] = malloc(100);
+   hidden[0] = ~(unsigned long)file[10];
+   shm[2] = malloc(200);
+   hidden[1] = ~(unsigned long)shm[2];
+   search("pointed to");
+   search("again, nothing changed");
+
+   val = NULL;
+   if (pwrite(fd, &val, sizeof(val), 10 * sizeof(void*)) != sizeof(val))
+      perror("pwrite");
+   search("file pointer cleared by pwrite");
+   val = block(0);
+   if (pwrite(fd, &val, sizeof(val), 10 * sizeof(void*)) != sizeof(val))
+      perror("pwrite");
+   search("file pointer set by pwrite");
+
+   set_by_child(&shm[2], NULL);
+   search("shm pointer cleared by a child");
+   set_by_child(&shm[2], block(1));
+   search("shm pointer set by a child");
+
+   VALGRIND_FREELIKE_BLOCK(shm, 0);
+   free(block(0));
+   free(block(1));
+   return 0;
+}
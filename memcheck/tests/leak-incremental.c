@@ -0,0 +1,80 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "tests/sys_mman.h"
+#include "../memcheck.h"
+
+// Tests --incremental-leak-check: the only pointer to a block is
+// changed between leak searches in ways which are not client stores,
+// by a system call, by mprotect, and by unmapping and mapping the
+// memory it is in again.  Each search must see the change.
+
+#define SIZE  (4 * 65536)
+
+static void**        area;
+static int           fds[2];
+static unsigned long hidden;    // the block's address, not as a pointer
+
+static void search ( const char* what )
+{
+   unsigned long leaked, dubious, reachable, suppressed;
+   VALGRIND_DO_QUICK_LEAK_CHECK;
+   VALGRIND_COUNT_LEAK_BLOCKS(leaked, dubious, reachable, suppressed);
+   (void)reachable; (void)suppressed;
+   fprintf(stderr, "%-36s %lu lost, %lu possibly lost\n",
+           what, leaked, dubious);
+}
+
+// Sets *p without a client store, by reading it from a pipe.
+static void set_by_syscall ( void** p, void* val )
+{
+   if (write(fds[1], &val, sizeof(val)) != sizeof(val)
+       || read(fds[0], p, sizeof(val)) != sizeof(val))
+      perror("pipe");
+}
+
+static void* map_area ( void* at )
+{
+   return mmap(at, SIZE, PROT_READ|PROT_WRITE,
+               MAP_PRIVATE|MAP_ANONYMOUS|(at ? MAP_FIXED : 0), -1, 0);
+}
+
+__attribute__((noinline))
+static void* block ( void )
+{
+   return (void*)~hidden;
+}
+
+int main ( void )
+{
+   void** slot;
+
+   if (pipe(fds) != 0)
+      return 1;
+   area = map_area(NULL);
+   slot = &area[2 * 65536 / sizeof(void*) + 10];
+
+   *slot = malloc(100);
+   hidden = ~(unsigned long)*slot;
+   search("pointed to");
+   search("again, nothing changed");
+
+   set_by_syscall(slot, NULL);
+   search("pointer cleared by a syscall");
+   set_by_syscall(slot, block());
+   search("pointer set by a syscall");
+
+   mprotect(area, SIZE, PROT_NONE);
+   search("pointer unreadable");
+   mprotect(area, SIZE, PROT_READ|PROT_WRITE);
+   search("pointer readable again");
+
+   munmap(area, SIZE);
+   map_area(area);
+   search("pointer unmapped and mapped again");
+
+   *slot = block();
+   search("pointer stored");
+   free(block());
+   return 0;
+}
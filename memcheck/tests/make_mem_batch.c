@@ -0,0 +1,77 @@
+/* Tests VALGRIND_MAKE_MEM_BATCH: the A and V bits it leaves behind, as
+   seen by VALGRIND_GET_VBITS, with triples that overlap each other, an
+   unknown state, and a triple array that isn't there. */
+
+#include <stdio.h>
+#include "../memcheck.h"
+
+#define N 64
+
+static char buf[N];
+
+/* One character per byte of buf: '-' not addressable, 'U' undefined,
+   'D' defined. */
+static void show ( const char* what )
+{
+   int  i;
+   char s[N + 1];
+   for (i = 0; i < N; i++) {
+      unsigned char vbits;
+      switch (VALGRIND_GET_VBITS(&buf[i], &vbits, 1)) {
+         case 1:  s[i] = vbits == 0 ? 'D' : vbits == 0xFF ? 'U' : '?'; break;
+         case 3:  s[i] = '-'; break;
+         default: s[i] = '!'; break;
+      }
+   }
+   s[N] = 0;
+   printf("%-22s %s\n", what, s);
+}
+
+#define T(off, len, state)  (unsigned long)&buf[off], (len), (state)
+
+int main ( void )
+{
+   int r;
+
+   /* Applied in order, so later triples win where they overlap. */
+   unsigned long plain[] = {
+      T(0,  16, VALGRIND_MEM_NOACCESS),
+      T(16, 16, VALGRIND_MEM_UNDEFINED),
+      T(32, 32, VALGRIND_MEM_DEFINED),
+      T(8,  16, VALGRIND_MEM_DEFINED),
+      T(28, 8,  VALGRIND_MEM_NOACCESS),
+      T(48, 8,  VALGRIND_MEM_UNDEFINED),
+      T(60, 0,  VALGRIND_MEM_NOACCESS),   /* empty */
+   };
+   unsigned long if_addressable[] = {
+      T(0,  64, VALGRIND_MEM_UNDEFINED),
+      T(0,  4,  VALGRIND_MEM_NOACCESS),
+      T(0,  32, VALGRIND_MEM_DEFINED_IF_ADDRESSABLE),
+   };
+   /* Stops at the unknown state: the last triple is not done. */
+   unsigned long bad_state[] = {
+      T(0,  64, VALGRIND_MEM_DEFINED),
+      T(0,  8,  VALGRIND_MEM_UNDEFINED),
+      T(8,  8,  7),
+      T(16, 8,  VALGRIND_MEM_NOACCESS),
+   };
+
+   show("initially");
+   r = VALGRIND_MAKE_MEM_BATCH(plain, sizeof(plain) / sizeof(plain[0]) / 3);
+   show("overlapping");
+   printf("result %d\n", r);
+   VALGRIND_MAKE_MEM_BATCH(if_addressable, 3);
+   show("defined if addr.");
+   VALGRIND_MAKE_MEM_BATCH(bad_state, 4);
+   show("unknown state");
+
+   /* Nothing to do; then a triple array that can't be read, which is
+      an error and changes nothing. */
+   VALGRIND_MAKE_MEM_BATCH(bad_state, 0);
+   VALGRIND_MAKE_MEM_BATCH(0, 0);
+   VALGRIND_MAKE_MEM_BATCH(0, 2);
+   show("bad array");
+
+   VALGRIND_MAKE_MEM_DEFINED(buf, N);
+   return 0;
+}
@@ -0,0 +1,61 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+// Tests --skip-instrument and --instrument-only: no error is reported
+// in the skipped_* functions, and what they write is defined.  The
+// checked_* functions are the same, and are checked as usual.
+
+__attribute__((noinline))
+static void skipped_copy ( char* dst, const char* src, int n )
+{
+   int i;
+   for (i = 0; i < n; i++)
+      dst[i] = src[i];
+}
+
+__attribute__((noinline))
+static void checked_copy ( char* dst, const char* src, int n )
+{
+   int i;
+   for (i = 0; i < n; i++)
+      dst[i] = src[i];
+}
+
+__attribute__((noinline))
+static int skipped_bad ( char* p )
+{
+   p[10] = 'x';
+   return p[0] == 'x';
+}
+
+__attribute__((noinline))
+static int checked_bad ( char* p )
+{
+   p[10] = 'x';
+   return p[0] == 'x';
+}
+
+int main ( void )
+{
+   char* p = malloc(10);
+   char* q = malloc(10);
+   char* r = malloc(10);
+   int   n = 0;
+
+   skipped_copy(q, p, 10);
+   if (q[3] == 'x')
+      n++;
+   checked_copy(r, p, 10);
+   if (r[3] == 'x')
+      n++;
+   if (skipped_bad(p))
+      n++;
+   if (checked_bad(p))
+      n++;
+   fprintf(stderr, "done\n");
+
+   free(p);
+   free(q);
+   free(r);
+   return n > 10;
+}
@@ -0,0 +1,331 @@
+// This module does unit testing of m_hashtable2.c: random inserts,
+// removals and lookups, checked against a simple reference, through
+// many resizes and much reuse of deleted slots, and a table which can't
+// grow any more filling up.
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pub_core_basics.h"
+#include "pub_core_libcbase.h"
+#include "pub_core_libcassert.h"
+#include "pub_core_libcprint.h"
+#include "pub_core_debuglog.h"
+#include "pub_core_mallocfree.h"
+
+// Crudely redirect various VG_(foo)() functions to their libc equivalents.
+#undef vg_assert
+#define vg_assert(e)                   assert(e)
+#undef vg_assert2
+#define vg_assert2(e, fmt, args...)    assert(e)
+
+#define vgPlain_memset                 memset
+
+static void* test_malloc ( const HChar* cc, SizeT szB )
+{ return malloc(szB); }
+static void* test_calloc ( const HChar* cc, SizeT n, SizeT szB )
+{ return calloc(n, szB); }
+#define vgPlain_malloc                 test_malloc
+#define vgPlain_calloc                 test_calloc
+#define vgPlain_free                   free
+
+// Count the rehashes, rather than printing them.
+static Int n_rehashes = 0;
+static void test_debugLog ( Int level, const HChar* modulename,
+                            const HChar* format, ... )
+{ n_rehashes++; }
+#define vgPlain_debugLog               test_debugLog
+
+// A table that can't grow and is full ends the test.
+static void test_out_of_memory ( const HChar* who, SizeT szB )
+{
+   printf("out of memory: %s\n", who);
+   exit(0);
+}
+#define vgPlain_out_of_memory_NORETURN test_out_of_memory
+
+// Small enough for a table to be filled up quickly.
+#define MAX_GROUP_BITS 12
+
+#include "coregrind/m_hashtable2.c"
+
+#define N_SLOTS_MAX   ((1 << MAX_GROUP_BITS) * GROUP_SZ)
+
+/* Consistent random number generator, so it produces the
+   same results on all platforms. */
+
+#define random error_do_not_use_libc_random
+
+static UInt seed = 0;
+static UInt myrandom( void )
+{
+  seed = (1103515245 * seed + 12345);
+  return seed;
+}
+
+
+//---------------------------------------------------------------------------
+// The reference: for each of NKEYS keys, the nodes with that key, most
+// recently added first, just as the table chains them.
+//---------------------------------------------------------------------------
+
+typedef
+   struct _Node {
+      struct _Node* next;
+      UWord         key;
+      Int           id;
+      Bool          seen;
+   }
+   Node;
+
+#define NKEYS   8000
+
+#define MAX_DUPS 64
+
+typedef struct { Node* nodes[MAX_DUPS]; Int n; } RefChain;
+
+static UWord    keys[NKEYS];
+static RefChain chains[NKEYS];
+static Int      ref_n_nodes = 0;
+static Int      next_id = 0;
+
+static Node* ref_head ( Int k )
+{
+   return chains[k].n > 0 ? chains[k].nodes[0] : NULL;
+}
+
+static Word cmp_id ( const void* n1, const void* n2 )
+{
+   return ((const Node*)n1)->id - ((const Node*)n2)->id;
+}
+
+static void ref_add ( Int k, Node* n )
+{
+   RefChain* c = &chains[k];
+   assert(c->n < MAX_DUPS);
+   memmove(&c->nodes[1], &c->nodes[0], c->n * sizeof(Node*));
+   c->nodes[0] = n;
+   c->n++;
+   ref_n_nodes++;
+}
+
+static void ref_del ( Int k, Int pos )
+{
+   RefChain* c = &chains[k];
+   assert(pos < c->n);
+   memmove(&c->nodes[pos], &c->nodes[pos+1],
+           (c->n - pos - 1) * sizeof(Node*));
+   c->n--;
+   ref_n_nodes--;
+}
+
+static Node* new_node ( Int k )
+{
+   Node* n = malloc(sizeof(Node));
+   n->key  = keys[k];
+   n->id   = next_id++;
+   n->seen = False;
+   return n;
+}
+
+
+//---------------------------------------------------------------------------
+// Checking the table against the reference
+//---------------------------------------------------------------------------
+
+static void check_all ( VgHashTable2 t )
+{
+   Int          k, i;
+   UInt         n_arr;
+   VgHashNode** arr;
+   Node*        n;
+
+   assert(VG_(HT2_count_nodes)(t) == ref_n_nodes);
+   assert(t->n_keys <= t->n_used);
+   assert(t->n_used <= t->n_groups * GROUP_SZ);
+
+   // Every key finds the newest of its nodes, and the chain is the
+   // reference's.
+   for (k = 0; k < NKEYS; k++) {
+      assert(VG_(HT2_lookup)(t, keys[k]) == ref_head(k));
+      n = ref_head(k);
+      for (i = 0; i < chains[k].n; i++) {
+         assert(n == chains[k].nodes[i]);
+         assert(VG_(HT2_gen_lookup)(t, n, cmp_id) == n);
+         n = (Node*)n->next;
+      }
+      assert(n == NULL);
+   }
+
+   // Iteration and HT2_to_array visit every node exactly once.
+   VG_(HT2_ResetIter)(t);
+   i = 0;
+   while ((n = VG_(HT2_Next)(t)) != NULL) {
+      assert(!n->seen);
+      n->seen = True;
+      i++;
+   }
+   assert(i == ref_n_nodes);
+   arr = VG_(HT2_to_array)(t, &n_arr);
+   assert(n_arr == ref_n_nodes);
+   for (i = 0; i < n_arr; i++) {
+      n = (Node*)arr[i];
+      assert(n->seen);
+      n->seen = False;
+   }
+   free(arr);
+}
+
+// Does one random operation; 'insert_pc' percent of them are inserts.
+// Returns True if it was an insert of a new key which reused a deleted
+// slot.
+static Bool random_op ( VgHashTable2 t, UInt insert_pc )
+{
+   Int   k = myrandom() % NKEYS;
+   UInt  r = myrandom() % 100;
+   Node* n;
+
+   if (r < insert_pc) {
+      UInt n_used  = t->n_used;
+      UInt n_keys  = t->n_keys;
+      Int  n_rh    = n_rehashes;
+      Bool new_key = chains[k].n == 0;
+      if (chains[k].n == MAX_DUPS)
+         return False;
+      n = new_node(k);
+      VG_(HT2_add_node)(t, n);
+      ref_add(k, n);
+      assert(t->n_keys == n_keys + (new_key ? 1 : 0));
+      return new_key && n_rh == n_rehashes && t->n_used == n_used;
+
+   } else if (r < insert_pc + (100 - insert_pc) / 2) {
+      // Remove by key: the newest node goes.
+      n = VG_(HT2_remove)(t, keys[k]);
+      assert(n == ref_head(k));
+      if (n) {
+         ref_del(k, 0);
+         free(n);
+      }
+
+   } else if (chains[k].n > 0) {
+      // Remove a particular node.
+      Int   pos = myrandom() % chains[k].n;
+      Node* want = chains[k].nodes[pos];
+      Node  probe;
+      probe.key = keys[k];
+      probe.id  = want->id;
+      n = VG_(HT2_gen_remove)(t, &probe, cmp_id);
+      assert(n == want);
+      ref_del(k, pos);
+      free(n);
+
+   } else {
+      Node probe;
+      probe.key = keys[k];
+      probe.id  = -1;
+      assert(VG_(HT2_gen_remove)(t, &probe, cmp_id) == NULL);
+      assert(VG_(HT2_lookup)(t, keys[k]) == NULL);
+   }
+   return False;
+}
+
+static void free_node ( void* p )
+{
+   free(p);
+}
+
+static void test_random ( void )
+{
+   VgHashTable2 t = VG_(HT2_construct)("unit_hashtable2");
+   Int i, n_reused = 0;
+
+   // Keys with differing low bits, high bits, and nothing in between.
+   for (i = 0; i < NKEYS; i++) {
+      switch (i % 3) {
+         case 0:  keys[i] = i; break;
+         case 1:  keys[i] = (UWord)i << (VG_WORDSIZE * 8 - 14); break;
+         default: keys[i] = ((UWord)myrandom() << 13) | i; break;
+      }
+   }
+
+   // Mostly inserts, so the table grows a lot.
+   for (i = 0; i < 40000; i++) {
+      random_op(t, 80);
+      if (i % 5000 == 0)
+         check_all(t);
+   }
+   check_all(t);
+   assert(n_rehashes >= 5);
+   printf("growing: ok\n");
+
+   // Mostly removals, leaving many deleted slots.
+   for (i = 0; i < 60000; i++) {
+      random_op(t, 20);
+      if (i % 5000 == 0)
+         check_all(t);
+   }
+   check_all(t);
+   assert(t->n_used > t->n_keys);
+   printf("removals: ok\n");
+
+   // Churn: new keys go into deleted slots.
+   for (i = 0; i < 200000; i++) {
+      if (random_op(t, 50))
+         n_reused++;
+      if (i % 20000 == 0)
+         check_all(t);
+   }
+   check_all(t);
+   assert(n_reused > 0);
+   printf("churn: ok\n");
+
+   VG_(HT2_destruct)(t, free_node);
+   for (i = 0; i < NKEYS; i++)
+      chains[i].n = 0;
+   ref_n_nodes = 0;
+}
+
+// A table at its maximum size fills up completely; lookups of missing
+// keys still terminate; and one key too many fails gracefully.
+static void test_full ( void )
+{
+   VgHashTable2 t = VG_(HT2_construct)("unit_hashtable2.full");
+   UWord i;
+   Node* n;
+
+   for (i = 0; i < N_SLOTS_MAX; i++) {
+      n = malloc(sizeof(Node));
+      n->key = i * 3;
+      n->id  = i;
+      VG_(HT2_add_node)(t, n);
+   }
+   assert(t->n_group_bits == MAX_GROUP_BITS);
+   assert(t->n_keys == N_SLOTS_MAX && t->n_used == N_SLOTS_MAX);
+   for (i = 0; i < N_SLOTS_MAX; i++)
+      assert(VG_(HT2_lookup)(t, i * 3) != NULL);
+   // Each of these looks at every group.
+   for (i = 0; i < 10; i++)
+      assert(VG_(HT2_lookup)(t, i * 3 + 1) == NULL);
+   printf("filled %u slots: ok\n", N_SLOTS_MAX);
+
+   // A deleted slot can be used again.
+   n = VG_(HT2_remove)(t, 0);
+   assert(n != NULL);
+   VG_(HT2_add_node)(t, n);
+   assert(VG_(HT2_lookup)(t, 0) == n);
+
+   n = malloc(sizeof(Node));
+   n->key = 1;
+   n->id  = -1;
+   VG_(HT2_add_node)(t, n);
+   assert(0);
+}
+
+int main(void)
+{
+   test_random();
+   test_full();
+   return 1;
+}
@@ -0,0 +1,279 @@
+// This module does unit testing of m_rangemap.c: random bindings, which
+// split and merge ranges, checked against the original simple
+// implementation (a sorted array, searched by bisection and split and
+// merged by moving its elements about), which is kept here.  Lookups,
+// indexing, and iteration over the ranges overlapping an interval are
+// all compared.
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pub_core_basics.h"
+#include "pub_core_libcbase.h"
+#include "pub_core_libcassert.h"
+#include "pub_core_libcprint.h"
+
+// Crudely redirect various VG_(foo)() functions to their libc equivalents.
+#undef vg_assert
+#define vg_assert(e)                   assert(e)
+#undef vg_assert2
+#define vg_assert2(e, fmt, args...)    assert(e)
+#undef tl_assert
+#define tl_assert(e)                   assert(e)
+#undef tl_assert2
+#define tl_assert2(e, fmt, args...)    assert(e)
+
+#define vgPlain_printf                 printf
+#define vgPlain_memset                 memset
+#define vgPlain_memcpy                 memcpy
+
+#include "coregrind/m_wordfm.c"
+#include "coregrind/m_rangemap.c"
+
+/* Consistent random number generator, so it produces the
+   same results on all platforms. */
+
+#define random error_do_not_use_libc_random
+
+static UInt seed = 0;
+static UInt myrandom( void )
+{
+  seed = (1103515245 * seed + 12345);
+  return seed;
+}
+
+// The low bits of myrandom() have short periods; these don't.
+static UInt rand_below ( UInt n )
+{
+   return (myrandom() >> 12) % n;
+}
+
+static void* allocate_node(const HChar* cc, SizeT szB)
+{ return malloc(szB); }
+
+static void free_node(void* p)
+{ free(p); }
+
+
+//---------------------------------------------------------------------------
+// The reference: the original implementation, on a plain array
+//---------------------------------------------------------------------------
+
+#define MAX_REF  100000
+
+typedef
+   struct { UWord key_min; UWord key_max; UWord val; }
+   RefRange;
+
+static RefRange ref[MAX_REF];
+static Word     ref_n;
+
+static void ref_init ( UWord initialVal )
+{
+   ref[0].key_min = UWORD_MIN;
+   ref[0].key_max = UWORD_MAX;
+   ref[0].val     = initialVal;
+   ref_n = 1;
+}
+
+static Word ref_find ( UWord key )
+{
+   Word lo = 0;
+   Word hi = ref_n - 1;
+   while (True) {
+      Word mid;
+      assert(lo <= hi);
+      mid = (lo + hi) / 2;
+      if (key < ref[mid].key_min) { hi = mid-1; continue; }
+      if (key > ref[mid].key_max) { lo = mid+1; continue; }
+      return mid;
+   }
+}
+
+static void ref_split_at ( UWord key )
+{
+   Word i = ref_find(key);
+   if (ref[i].key_min == key)
+      return;
+   assert(ref_n < MAX_REF);
+   memmove(&ref[i+1], &ref[i], (ref_n - i) * sizeof(RefRange));
+   ref_n++;
+   ref[i+0].key_max = key-1;
+   ref[i+1].key_min = key;
+}
+
+static void ref_preen ( void )
+{
+   Word i;
+   for (i = 0; i < ref_n - 1; i++) {
+      if (ref[i].val != ref[i+1].val)
+         continue;
+      ref[i].key_max = ref[i+1].key_max;
+      memmove(&ref[i+1], &ref[i+2], (ref_n - i - 2) * sizeof(RefRange));
+      ref_n--;
+      i--;
+   }
+}
+
+static void ref_bind ( UWord key_min, UWord key_max, UWord val )
+{
+   Word i, iMin, iMax;
+   ref_split_at(key_min);
+   if (key_max < UWORD_MAX)
+      ref_split_at(key_max + 1);
+   iMin = ref_find(key_min);
+   iMax = ref_find(key_max);
+   for (i = iMin; i <= iMax; i++)
+      ref[i].val = val;
+   ref_preen();
+}
+
+
+//---------------------------------------------------------------------------
+// Checks against the reference
+//---------------------------------------------------------------------------
+
+static void check_lookup ( RangeMap* rm, UWord key )
+{
+   UWord kMin, kMax, v;
+   Word  i = ref_find(key);
+   VG_(lookupRangeMap)(&kMin, &kMax, &v, rm, key);
+   assert(kMin == ref[i].key_min && kMax == ref[i].key_max
+          && v == ref[i].val);
+}
+
+// The ranges overlapping [lo, hi], found as pub_tool_rangemap.h says.
+static void check_overlap ( RangeMap* rm, UWord lo, UWord hi )
+{
+   UWord kMin, kMax, v;
+   Word  i = ref_find(lo);
+
+   VG_(initIterRangeMap)(rm, lo);
+   while (True) {
+      assert(i < ref_n);
+      assert(VG_(nextIterRangeMap)(rm, &kMin, &kMax, &v));
+      assert(kMin == ref[i].key_min && kMax == ref[i].key_max
+             && v == ref[i].val);
+      if (kMax >= hi)
+         break;
+      i++;
+   }
+   if (kMax == UWORD_MAX)
+      assert(!VG_(nextIterRangeMap)(rm, &kMin, &kMax, &v));
+}
+
+static void check_all ( RangeMap* rm )
+{
+   UWord kMin, kMax, v;
+   Word  i;
+
+   assert(VG_(sizeRangeMap)(rm) == ref_n);
+   assert(rm->starts->btRoot
+          && bt_size(rm->starts->btRoot) == ref_n);
+
+   // In order, and then a few out of order.
+   for (i = 0; i < ref_n; i++) {
+      VG_(indexRangeMap)(&kMin, &kMax, &v, rm, i);
+      assert(kMin == ref[i].key_min && kMax == ref[i].key_max
+             && v == ref[i].val);
+      if (i > 0)
+         assert(ref[i].key_min == ref[i-1].key_max + 1
+                && ref[i].val != ref[i-1].val);
+   }
+   for (i = 0; i < 20; i++) {
+      Word ix = rand_below(ref_n);
+      VG_(indexRangeMap)(&kMin, &kMax, &v, rm, ix);
+      assert(kMin == ref[ix].key_min && kMax == ref[ix].key_max
+             && v == ref[ix].val);
+   }
+
+   // At, and either side of, every boundary.
+   for (i = 0; i < ref_n; i++) {
+      check_lookup(rm, ref[i].key_min);
+      check_lookup(rm, ref[i].key_max);
+      if (ref[i].key_min > UWORD_MIN)
+         check_lookup(rm, ref[i].key_min - 1);
+      if (ref[i].key_max < UWORD_MAX)
+         check_lookup(rm, ref[i].key_max + 1);
+   }
+
+   check_overlap(rm, UWORD_MIN, UWORD_MAX);
+}
+
+
+//---------------------------------------------------------------------------
+// Random bindings
+//---------------------------------------------------------------------------
+
+// Keys mostly in a small space, so that ranges are often split, merged
+// and swallowed; and sometimes at the ends of the key space.
+#define SPACE  4096
+
+static UWord rand_key ( void )
+{
+   switch (rand_below(20)) {
+      case 0:  return UWORD_MIN + rand_below(4);
+      case 1:  return UWORD_MAX - rand_below(4);
+      case 2:  return UWORD_MAX / 2 + rand_below(SPACE);
+      default: return rand_below(SPACE);
+   }
+}
+
+static void random_bind ( RangeMap* rm, UInt n_vals, UWord max_len )
+{
+   UWord lo  = rand_key();
+   UWord len = rand_below(max_len);
+   UWord hi  = lo + len < lo ? UWORD_MAX : lo + len;
+   UWord val = rand_below(n_vals);
+   UWord qlo, qhi;
+
+   if (rand_below(50) == 0) {
+      // Now and again, a huge one.
+      lo = rand_below(2) ? UWORD_MIN : rand_key();
+      hi = UWORD_MAX - rand_below(2) * rand_below(SPACE);
+      if (hi < lo)
+         hi = lo;
+   }
+   VG_(bindRangeMap)(rm, lo, hi, val);
+   ref_bind(lo, hi, val);
+   assert(VG_(sizeRangeMap)(rm) == ref_n);
+
+   // The ranges around what was just bound, and somewhere else.
+   qlo = lo > 10 ? lo - 10 : UWORD_MIN;
+   qhi = hi < UWORD_MAX - 10 ? hi + 10 : UWORD_MAX;
+   check_overlap(rm, qlo, qhi);
+   qlo = rand_key();
+   qhi = qlo + rand_below(SPACE / 4);
+   check_overlap(rm, qlo, qhi < qlo ? UWORD_MAX : qhi);
+   check_lookup(rm, rand_key());
+}
+
+static void test ( const HChar* name, UInt n_vals, UWord max_len,
+                   Int n_binds )
+{
+   Int       i;
+   RangeMap* rm = VG_(newRangeMap)(allocate_node, "unit_rangemap",
+                                   free_node, 0);
+   ref_init(0);
+   check_all(rm);
+   for (i = 0; i < n_binds; i++) {
+      random_bind(rm, n_vals, max_len);
+      if (i % 1000 == 0)
+         check_all(rm);
+   }
+   check_all(rm);
+   VG_(deleteRangeMap)(rm);
+   printf("%s: ok\n", name);
+}
+
+int main(void)
+{
+   // Few values: lots of merging.  Many values: lots of ranges.
+   test("short ranges, few values",  3,  8,          20000);
+   test("short ranges, many values", 1000, 8,        20000);
+   test("long ranges, few values",   3,  SPACE / 4,  20000);
+   test("long ranges, many values",  1000, SPACE / 4, 20000);
+   return 0;
+}
@@ -0,0 +1,273 @@
+// This module does unit testing of m_sparsewa.c: random adds, deletes,
+// lookups and iterations on an adaptive radix tree SparseWA and a plain
+// one, side by side, checking that they always agree, and that the
+// adaptive radix tree stays well formed.
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pub_core_basics.h"
+#include "pub_core_libcbase.h"
+#include "pub_core_libcassert.h"
+#include "pub_core_libcprint.h"
+
+// Crudely redirect various VG_(foo)() functions to their libc equivalents.
+#undef vg_assert
+#define vg_assert(e)                   assert(e)
+#undef vg_assert2
+#define vg_assert2(e, fmt, args...)    assert(e)
+
+#define vgPlain_printf                 printf
+#define vgPlain_memset                 memset
+
+#include "coregrind/m_sparsewa.c"
+
+/* Consistent random number generator, so it produces the
+   same results on all platforms. */
+
+#define random error_do_not_use_libc_random
+
+static UInt seed = 0;
+static UInt myrandom( void )
+{
+  seed = (1103515245 * seed + 12345);
+  return seed;
+}
+
+// The low bits of myrandom() have short periods; these don't.
+static UInt rand_below ( UInt n )
+{
+   return (myrandom() >> 12) % n;
+}
+
+static UWord rand_word ( void )
+{
+   UWord w = myrandom();
+   w = (w << 16) << 16;    // nothing, on a 32-bit platform
+   return w ^ myrandom();
+}
+
+static void* allocate_node(const HChar* cc, SizeT szB)
+{ return malloc(szB); }
+
+static void free_node(void* p)
+{ free(p); }
+
+
+//---------------------------------------------------------------------------
+// The keys
+//---------------------------------------------------------------------------
+
+// A dense run, which fills leaves and makes them grow to Art_256 and
+// shrink again; clusters at random places, sharing long prefixes; keys
+// scattered everywhere; and the extremes.
+#define NKEYS      6000
+#define N_DENSE    1000
+#define N_CLUSTERS 8
+
+static UWord keys[NKEYS];
+static Bool  present[NKEYS];
+static UWord n_present = 0;
+
+static void make_keys ( void )
+{
+   Int   i, c;
+   UWord base[N_CLUSTERS];
+
+   for (c = 0; c < N_CLUSTERS; c++)
+      base[c] = rand_word();
+   for (i = 0; i < N_DENSE; i++)
+      keys[i] = 0x12300 + i;
+   for (; i < NKEYS / 2; i++)
+      keys[i] = base[i % N_CLUSTERS] + i * (1 + i % 3) * 16;
+   for (; i < NKEYS - 4; i++)
+      keys[i] = rand_word();
+   keys[i++] = 0;
+   keys[i++] = 1;
+   keys[i++] = ~(UWord)0;
+   keys[i++] = (UWord)1 << (8 * sizeof(UWord) - 1);
+
+   // Randomly chosen keys may have come out the same as others.
+   for (i = 0; i < NKEYS; i++) {
+      for (c = 0; c < i; c++)
+         if (keys[c] == keys[i])
+            break;
+      if (c < i)
+         keys[i] = keys[i - 1] ^ 0x5a5a00;   // try again
+      for (c = 0; c < i; c++)
+         assert(keys[c] != keys[i]);
+   }
+}
+
+
+//---------------------------------------------------------------------------
+// Checks
+//---------------------------------------------------------------------------
+
+// An adaptive radix tree node is well formed: it is full enough for its
+// type, and each child looks at a deeper byte and has the prefix which
+// leads to it.  Returns the number of values below it.
+static Bool seen_Art_4, seen_Art_16, seen_Art_48, seen_Art_256;
+
+static UWord art_check ( ArtHdr* nd )
+{
+   UWord  b = 0, n = 0;
+   UWord* slot;
+
+   assert(nd->n <= nd->type);
+   switch (nd->type) {
+      case Art_4:   assert(nd->n >= 1);  seen_Art_4   = True; break;
+      case Art_16:  assert(nd->n >= 4);  seen_Art_16  = True; break;
+      case Art_48:  assert(nd->n >= 13); seen_Art_48  = True; break;
+      case Art_256: assert(nd->n >= 41); seen_Art_256 = True; break;
+      default:      assert(0);
+   }
+   if (nd->depth == ART_LEAF_DEPTH)
+      return nd->n;
+
+   assert(nd->n >= 2);
+   while (b < 256 && (slot = art_next(nd, &b)) != NULL) {
+      ArtHdr* child = (ArtHdr*)*slot;
+      assert(child->depth > nd->depth);
+      assert(art_prefix_matches(nd, child->pkey));
+      assert(art_byte(child->pkey, nd->depth) == b);
+      n += art_check(child);
+      b++;
+   }
+   return n;
+}
+
+// Both agree on every key, and iterate over the same pairs in the same
+// (increasing key) order.
+static void check_all ( SparseWA* art, SparseWA* plain )
+{
+   Int   i;
+   UWord k1, v1, k2, v2, prev = 0;
+   Bool  b1, b2;
+
+   assert(art->artRoot ? art_check(art->artRoot) == n_present
+                       : n_present == 0);
+   assert(VG_(sizeSWA)(art) == n_present);
+   assert(VG_(sizeSWA)(plain) == n_present);
+
+   for (i = 0; i < NKEYS; i++) {
+      b1 = VG_(lookupSWA)(art, &k1, &v1, keys[i]);
+      b2 = VG_(lookupSWA)(plain, &k2, &v2, keys[i]);
+      assert(b1 == present[i] && b2 == present[i]);
+      if (b1)
+         assert(k1 == keys[i] && k2 == keys[i] && v1 == v2);
+   }
+
+   VG_(initIterSWA)(art);
+   VG_(initIterSWA)(plain);
+   i = 0;
+   while (True) {
+      b1 = VG_(nextIterSWA)(art, &k1, &v1);
+      b2 = VG_(nextIterSWA)(plain, &k2, &v2);
+      assert(b1 == b2);
+      if (!b1)
+         break;
+      assert(k1 == k2 && v1 == v2);
+      assert(i == 0 || k1 > prev);
+      prev = k1;
+      i++;
+   }
+   assert(i == n_present);
+}
+
+
+//---------------------------------------------------------------------------
+// Random operations
+//---------------------------------------------------------------------------
+
+// Keys are chosen from the first 'n_keys', so that the dense run can be
+// made to fill up.
+static void random_op ( SparseWA* art, SparseWA* plain,
+                        UInt add_pc, Int n_keys )
+{
+   Int   i = rand_below(n_keys);
+   UInt  r = rand_below(100);
+   UWord k1, v1, k2, v2;
+   Bool  b1, b2;
+
+   if (r < add_pc) {
+      UWord v = rand_word();
+      b1 = VG_(addToSWA)(art, keys[i], v);
+      b2 = VG_(addToSWA)(plain, keys[i], v);
+      assert(b1 == present[i] && b2 == present[i]);
+      if (!present[i])
+         n_present++;
+      present[i] = True;
+
+   } else if (r < add_pc + (100 - add_pc) * 3 / 4) {
+      b1 = VG_(delFromSWA)(art, &k1, &v1, keys[i]);
+      b2 = VG_(delFromSWA)(plain, &k2, &v2, keys[i]);
+      assert(b1 == present[i] && b2 == present[i]);
+      if (b1) {
+         assert(k1 == keys[i] && k2 == keys[i] && v1 == v2);
+         present[i] = False;
+         n_present--;
+      }
+
+   } else {
+      // Keys which are nearly, but not quite, in the maps.
+      UWord k = keys[i] ^ ((UWord)1 << rand_below(8 * sizeof(UWord)));
+      b1 = VG_(lookupSWA)(art, &k1, &v1, k);
+      b2 = VG_(lookupSWA)(plain, &k2, &v2, k);
+      assert(b1 == b2);
+      if (b1)
+         assert(k1 == k && k2 == k && v1 == v2);
+   }
+}
+
+static void run ( SparseWA* art, SparseWA* plain,
+                  Int n_ops, UInt add_pc, Int n_keys )
+{
+   Int i;
+   for (i = 0; i < n_ops; i++) {
+      random_op(art, plain, add_pc, n_keys);
+      if (i % 5000 == 0)
+         check_all(art, plain);
+   }
+   check_all(art, plain);
+}
+
+int main(void)
+{
+   Int i;
+   SparseWA* art   = VG_(newSWA_ART)(allocate_node, "unit_sparsewa",
+                                     free_node);
+   SparseWA* plain = VG_(newSWA)(allocate_node, "unit_sparsewa", free_node);
+
+   make_keys();
+
+   // The dense run alone: leaves grow all the way, then shrink.
+   run(art, plain, 5000, 90, N_DENSE);
+   run(art, plain, 8000, 10, N_DENSE);
+   run(art, plain, 8000, 2, N_DENSE);
+   assert(seen_Art_4 && seen_Art_16 && seen_Art_48 && seen_Art_256);
+   printf("dense: ok\n");
+
+   // Everything: growing, shrinking to empty, then churning.
+   run(art, plain, 40000, 70, NKEYS);
+   run(art, plain, 20000, 20, NKEYS);
+   for (i = 0; i < NKEYS; i++) {
+      UWord k, v;
+      if (present[i]) {
+         assert(VG_(delFromSWA)(art, &k, &v, keys[i]));
+         assert(VG_(delFromSWA)(plain, &k, &v, keys[i]));
+         present[i] = False;
+         n_present--;
+      }
+   }
+   check_all(art, plain);
+   assert(art->artRoot == NULL);
+   run(art, plain, 60000, 50, NKEYS);
+   printf("all keys: ok\n");
+
+   VG_(deleteSWA)(art);
+   VG_(deleteSWA)(plain);
+   return 0;
+}
@@ -0,0 +1,347 @@
+// This module does unit testing of m_wordfm.c, mostly of the B-tree
+// kind of WordFM: random adds, deletes, lookups, bounds and iterations,
+// including deleting keys in the middle of an iteration, all checked
+// against a simple reference.  The AVL kind gets the same treatment.
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pub_core_basics.h"
+#include "pub_core_libcbase.h"
+#include "pub_core_libcassert.h"
+#include "pub_core_libcprint.h"
+
+// Crudely redirect various VG_(foo)() functions to their libc equivalents.
+#undef vg_assert
+#define vg_assert(e)                   assert(e)
+#undef vg_assert2
+#define vg_assert2(e, fmt, args...)    assert(e)
+#undef tl_assert
+#define tl_assert(e)                   assert(e)
+#undef tl_assert2
+#define tl_assert2(e, fmt, args...)    assert(e)
+
+#define vgPlain_memset                 memset
+#define vgPlain_memcpy                 memcpy
+
+#include "coregrind/m_wordfm.c"
+
+/* Consistent random number generator, so it produces the
+   same results on all platforms. */
+
+#define random error_do_not_use_libc_random
+
+static UInt seed = 0;
+static UInt myrandom( void )
+{
+  seed = (1103515245 * seed + 12345);
+  return seed;
+}
+
+// The low bits of myrandom() have short periods; these don't.
+static UInt rand_below ( UInt n )
+{
+   return (myrandom() >> 12) % n;
+}
+
+static void* allocate_node(const HChar* cc, SizeT szB)
+{ return malloc(szB); }
+
+static void free_node(void* p)
+{ free(p); }
+
+
+//---------------------------------------------------------------------------
+// The reference
+//---------------------------------------------------------------------------
+
+// Key i of the reference is KEY(i).  The words in between, and either
+// side of them all, are never in a map, so can be used as keys which
+// are missing.
+#define NK        5000
+#define KEY(i)    ((UWord)(i) * 4 + 4)
+#define GAP(i)    ((UWord)(i) * 4 + 2)      // just before KEY(i)
+
+static Bool  present[NK];
+static UWord vals[NK];
+static Int   n_present;
+
+// The maps are ordered either by increasing or, through a kCmp, by
+// decreasing key.  POS(p) is the reference index at position p.
+static Bool descending;
+#define POS(p)    (descending ? NK - 1 - (p) : (p))
+
+static Word cmp_descending ( UWord k1, UWord k2 )
+{
+   return k1 > k2 ? -1 : k1 < k2 ? 1 : 0;
+}
+
+static void ref_clear ( void )
+{
+   memset(present, 0, sizeof(present));
+   n_present = 0;
+}
+
+
+//---------------------------------------------------------------------------
+// Checks against the reference
+//---------------------------------------------------------------------------
+
+// Iterating from 'start' (the whole map if it's ~0) finds exactly the
+// reference's keys, in order.  At most 'max' are looked at.
+static void check_iter_at ( WordFM* fm, UWord start, Int p, Int max )
+{
+   UWord k, v;
+   Int   n = 0;
+
+   if (start == ~0UL)
+      VG_(initIterFM)(fm);
+   else
+      VG_(initIterAtFM)(fm, start);
+   for (; p < NK && n < max; p++) {
+      if (!present[POS(p)])
+         continue;
+      assert(VG_(nextIterFM)(fm, &k, &v));
+      assert(k == KEY(POS(p)) && v == vals[POS(p)]);
+      n++;
+   }
+   if (n < max)
+      assert(!VG_(nextIterFM)(fm, &k, &v));
+   VG_(doneIterFM)(fm);
+}
+
+// The B-tree is well formed: its keys are in order, every node but the
+// root is at least half full, and all the leaves are at the same depth.
+// Returns the height of 'nd', and the number of keys in it.
+static Int bt_check ( WordFM* fm, BtNode* nd, Bool isRoot,
+                      /*OUT*/UWord* n_keys )
+{
+   Int   i, h = 0;
+   UWord n;
+
+   assert(nd->nKeys <= BT_MAXKEYS);
+   assert(nd->nKeys >= (isRoot ? 1 : BT_MINDEG - 1));
+   for (i = 1; i < nd->nKeys; i++)
+      assert((fm->kCmp ? fm->kCmp(nd->key[i-1], nd->key[i])
+                       : cmp_unsigned_Words(nd->key[i-1], nd->key[i])) < 0);
+   *n_keys = nd->nKeys;
+   if (nd->leaf)
+      return 1;
+   for (i = 0; i <= nd->nKeys; i++) {
+      Int hc = bt_check(fm, nd->child[i], False, &n);
+      assert(i == 0 || hc == h);
+      h = hc;
+      *n_keys += n;
+   }
+   return h + 1;
+}
+
+static void check_all ( WordFM* fm )
+{
+   Int   i;
+   UWord k, v;
+
+   if (fm->btRoot) {
+      UWord n;
+      bt_check(fm, fm->btRoot, True, &n);
+      assert(n == n_present);
+   }
+   assert(VG_(sizeFM)(fm) == n_present);
+   for (i = 0; i < NK; i++) {
+      if (present[i]) {
+         assert(VG_(lookupFM)(fm, &k, &v, KEY(i)));
+         assert(k == KEY(i) && v == vals[i]);
+      } else {
+         assert(!VG_(lookupFM)(fm, &k, &v, KEY(i)));
+      }
+      assert(!VG_(lookupFM)(fm, NULL, NULL, GAP(i)));
+   }
+   check_iter_at(fm, ~0UL, 0, NK);
+}
+
+// The neighbours of a missing key, from VG_(findBoundsFM), are those of
+// the reference.
+static void check_bounds ( WordFM* fm, Int p )
+{
+   UWord kMin, vMin, kMax, vMax;
+   UWord minKey = descending ? ~0UL : 0;
+   UWord maxKey = descending ? 0 : ~0UL;
+   UWord key    = descending ? GAP(POS(p)) + 4 : GAP(POS(p));
+   Int   q;
+
+   // 'key' lies just before position p.
+   assert(VG_(findBoundsFM)(fm, &kMin, &vMin, &kMax, &vMax,
+                            minKey, 11, maxKey, 22, key));
+   for (q = p - 1; q >= 0 && !present[POS(q)]; q--)
+      ;
+   if (q >= 0)
+      assert(kMin == KEY(POS(q)) && vMin == vals[POS(q)]);
+   else
+      assert(kMin == minKey && vMin == 11);
+   for (q = p; q < NK && !present[POS(q)]; q++)
+      ;
+   if (q < NK)
+      assert(kMax == KEY(POS(q)) && vMax == vals[POS(q)]);
+   else
+      assert(kMax == maxKey && vMax == 22);
+
+   if (present[POS(p)])
+      assert(!VG_(findBoundsFM)(fm, NULL, NULL, NULL, NULL,
+                                minKey, 11, maxKey, 22, KEY(POS(p))));
+}
+
+
+//---------------------------------------------------------------------------
+// Random operations
+//---------------------------------------------------------------------------
+
+// Walks from position p, deleting some of the keys met on the way,
+// restarting the iteration after each delete, as callers do.
+static void delete_while_iterating ( WordFM* fm, Int p )
+{
+   UWord k, v, oldK, oldV;
+   Int   n;
+
+   VG_(initIterAtFM)(fm, KEY(POS(p)));
+   for (n = 0; n < 50; n++) {
+      for (; p < NK && !present[POS(p)]; p++)
+         ;
+      if (p == NK) {
+         assert(!VG_(nextIterFM)(fm, &k, &v));
+         break;
+      }
+      assert(VG_(nextIterFM)(fm, &k, &v));
+      assert(k == KEY(POS(p)) && v == vals[POS(p)]);
+      if (rand_below(3) == 0) {
+         assert(VG_(delFromFM)(fm, &oldK, &oldV, k));
+         assert(oldK == k && oldV == v);
+         present[POS(p)] = False;
+         n_present--;
+         VG_(initIterAtFM)(fm, k);
+      }
+      p++;
+   }
+   VG_(doneIterFM)(fm);
+}
+
+static void random_op ( WordFM* fm, UInt add_pc )
+{
+   Int   i = rand_below(NK);
+   UInt  r = rand_below(100);
+   UWord k, v;
+
+   if (r < add_pc) {
+      v = myrandom();
+      assert(VG_(addToFM)(fm, KEY(i), v) == present[i]);
+      if (!present[i])
+         n_present++;
+      present[i] = True;
+      vals[i] = v;
+
+   } else if (r < add_pc + (100 - add_pc) * 3 / 4) {
+      Bool found = VG_(delFromFM)(fm, &k, &v, KEY(i));
+      assert(found == present[i]);
+      if (found) {
+         assert(k == KEY(i) && v == vals[i]);
+         present[i] = False;
+         n_present--;
+      }
+      assert(!VG_(delFromFM)(fm, NULL, NULL, GAP(i)));
+
+   } else {
+      // Position, rather than index, from here on.
+      switch (r % 4) {
+         case 0:
+            check_bounds(fm, i);
+            break;
+         case 1:
+            check_iter_at(fm, KEY(POS(i)), i, 30);
+            break;
+         case 2:
+            check_iter_at(fm, descending ? GAP(POS(i)) + 4 : GAP(POS(i)),
+                          i, 30);
+            break;
+         default:
+            delete_while_iterating(fm, i);
+            break;
+      }
+   }
+}
+
+static void test ( const HChar* name, Bool btree, Bool desc )
+{
+   WordFM* fm;
+   WordFM* fm2;
+   UWord   sorted_k[NK], sorted_v[NK];
+   Int     i, p, n;
+   Word (*kCmp)(UWord,UWord) = desc ? cmp_descending : NULL;
+
+   descending = desc;
+   ref_clear();
+   fm = btree ? VG_(newFM_BTree)(allocate_node, "unit_wordfm", free_node, kCmp)
+              : VG_(newFM)(allocate_node, "unit_wordfm", free_node, kCmp);
+
+   // Growing, then shrinking to empty, then churning.
+   for (i = 0; i < 30000; i++) {
+      random_op(fm, 70);
+      if (i % 3000 == 0)
+         check_all(fm);
+   }
+   check_all(fm);
+   for (i = 0; i < 30000; i++) {
+      random_op(fm, 20);
+      if (i % 3000 == 0)
+         check_all(fm);
+   }
+   for (i = 0; n_present > 0; i++) {
+      random_op(fm, 0);
+      if (i % 3000 == 0)
+         check_all(fm);
+   }
+   check_all(fm);
+   for (i = 0; i < 60000; i++) {
+      random_op(fm, 50);
+      if (i % 6000 == 0)
+         check_all(fm);
+   }
+   check_all(fm);
+
+   // A copy is the same, and independent of the original.
+   fm2 = VG_(dopyFM)(fm, NULL, NULL);
+   check_all(fm2);
+   VG_(deleteFM)(fm, NULL, NULL);
+   for (i = 0; i < 20000; i++)
+      random_op(fm2, 50);
+   check_all(fm2);
+
+   // Built from sorted keys: the same again.
+   for (p = n = 0; p < NK; p++) {
+      if (present[POS(p)]) {
+         sorted_k[n] = KEY(POS(p));
+         sorted_v[n] = vals[POS(p)];
+         n++;
+      }
+   }
+   fm = btree ? VG_(newFM_BTree)(allocate_node, "unit_wordfm", free_node, kCmp)
+              : VG_(newFM)(allocate_node, "unit_wordfm", free_node, kCmp);
+   VG_(addSortedToFM)(fm, n, sorted_k, sorted_v);
+   check_all(fm);
+   for (i = 0; i < 20000; i++)
+      random_op(fm, 50);
+   check_all(fm);
+
+   VG_(deleteFM)(fm, NULL, NULL);
+   VG_(deleteFM)(fm2, NULL, NULL);
+   printf("%s: ok\n", name);
+}
+
+int main(void)
+{
+   test("btree", True, False);
+   test("btree, descending", True, True);
+   test("avl", False, False);
+   test("avl, descending", False, True);
+   return 0;
+}
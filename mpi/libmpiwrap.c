@@ -935,6 +935,136 @@ void mpiwrap_walk_type_EXTERNALLY_VISIBLE
 }
 
 
+/*------------------------------------------------------------*/
+/*--- Flattened type layouts                               ---*/
+/*------------------------------------------------------------*/
+
+/* Walking a derived type costs a few MPI calls per node of it and a
+   client request per contiguous fragment, which for large strided
+   types is far more work than the communication itself.  So each
+   type is walked just once, into a list of the (offset, length)
+   fragments of one item of it, adjacent fragments merged.  The list
+   is cached, keyed by the type handle, and is handed as it is to
+   Memcheck, which checks or paints all the items of a buffer in one
+   request (see the _EXTENTS requests in memcheck.h).  Type_free drops
+   the cached list, since the handle can then be reused for another
+   type. */
+
+typedef
+   struct _Layout {
+      struct _Layout* next;
+      MPI_Datatype    ty;
+      long            extent;
+      long            n_frags;
+      long            size_frags;  /* number allocated */
+      UWord*          frags;       /* 2 * n_frags: offset, length */
+   }
+   Layout;
+
+#define N_LAYOUT_BUCKETS 61
+
+static Layout*         layouts[N_LAYOUT_BUCKETS];
+static pthread_mutex_t layouts_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* The layout walk_type is adding fragments to.  walk_type's callback
+   has no closure argument, so this is a global, protected by
+   building_lock.  This has to be a different lock from layouts_lock,
+   because walk_type frees the types it gets from
+   PMPI_Type_get_contents, through the Type_free wrapper. */
+static Layout*         building = NULL;
+static pthread_mutex_t building_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static __inline__ UWord layout_bucket ( MPI_Datatype ty )
+{
+   return ((UWord)ty) % N_LAYOUT_BUCKETS;
+}
+
+static void add_frag ( void* addr, long nbytes )
+{
+   Layout* lay = building;
+   UWord   off = (UWord)addr;
+
+   if (nbytes <= 0)
+      return;
+   if (lay->n_frags > 0
+       && lay->frags[2 * lay->n_frags - 2] 
+          + lay->frags[2 * lay->n_frags - 1] == off) {
+      lay->frags[2 * lay->n_frags - 1] += nbytes;
+      return;
+   }
+   if (lay->n_frags == lay->size_frags) {
+      lay->size_frags = lay->size_frags == 0 ? 4 : 2 * lay->size_frags;
+      lay->frags = realloc(lay->frags, 2 * lay->size_frags * sizeof(UWord));
+      assert(lay->frags);
+   }
+   lay->frags[2 * lay->n_frags]     = off;
+   lay->frags[2 * lay->n_frags + 1] = nbytes;
+   lay->n_frags++;
+}
+
+static Layout* build_layout ( MPI_Datatype ty )
+{
+   Layout* lay = calloc(1, sizeof(Layout));
+   assert(lay);
+   lay->ty     = ty;
+   lay->extent = extentOfTy(ty);
+   pthread_mutex_lock(&building_lock);
+   building = lay;
+   walk_type( add_frag, (char*)0, ty );
+   building = NULL;
+   pthread_mutex_unlock(&building_lock);
+   return lay;
+}
+
+static void free_layout ( Layout* lay )
+{
+   if (lay->frags) free(lay->frags);
+   free(lay);
+}
+
+/* Find the layout of 'ty', building it if need be.  Returns with
+   layouts_lock held, so that the layout can't be freed by another
+   thread while the caller is using it. */
+static Layout* get_layout ( MPI_Datatype ty )
+{
+   Layout *lay, *built;
+   UWord   b = layout_bucket(ty);
+
+   pthread_mutex_lock(&layouts_lock);
+   for (lay = layouts[b]; lay; lay = lay->next)
+      if (lay->ty == ty)
+         return lay;
+   pthread_mutex_unlock(&layouts_lock);
+
+   built = build_layout(ty);
+
+   pthread_mutex_lock(&layouts_lock);
+   /* Another thread may have got there first. */
+   for (lay = layouts[b]; lay; lay = lay->next)
+      if (lay->ty == ty) {
+         free_layout(built);
+         return lay;
+      }
+   built->next = layouts[b];
+   layouts[b]  = built;
+   return built;
+}
+
+static void forget_layout ( MPI_Datatype ty )
+{
+   Layout **prev, *lay;
+
+   pthread_mutex_lock(&layouts_lock);
+   for (prev = &layouts[layout_bucket(ty)]; (lay = *prev); prev = &lay->next)
+      if (lay->ty == ty) {
+         *prev = lay->next;
+         free_layout(lay);
+         break;
+      }
+   pthread_mutex_unlock(&layouts_lock);
+}
+
+
 /*------------------------------------------------------------*/
 /*--- Address-range helpers                                ---*/
 /*------------------------------------------------------------*/
@@ -991,7 +1121,13 @@ void make_mem_defined_if_addressable_if_success_untyped ( int err,
 static __inline__
 void check_mem_is_defined ( char* buffer, long count, MPI_Datatype datatype )
 {
-   walk_type_array( check_mem_is_defined_untyped, buffer, datatype, count );
+   Layout* lay;
+   if (count <= 0)
+      return;
+   lay = get_layout(datatype);
+   VALGRIND_CHECK_MEM_EXTENTS_ARE_DEFINED(buffer, lay->frags, lay->n_frags,
+                                          count, lay->extent);
+   pthread_mutex_unlock(&layouts_lock);
 }
 
 
@@ -1002,7 +1138,14 @@ void check_mem_is_defined ( char* buffer, long count, MPI_Datatype datatype )
 static __inline__
 void check_mem_is_addressable ( void *buffer, long count, MPI_Datatype datatype )
 {
-   walk_type_array( check_mem_is_addressable_untyped, buffer, datatype, count );
+   Layout* lay;
+   if (count <= 0)
+      return;
+   lay = get_layout(datatype);
+   VALGRIND_CHECK_MEM_EXTENTS_ARE_ADDRESSABLE(buffer, lay->frags,
+                                              lay->n_frags, count,
+                                              lay->extent);
+   pthread_mutex_unlock(&layouts_lock);
 }
 
 
@@ -1012,8 +1155,14 @@ void check_mem_is_addressable ( void *buffer, long count, MPI_Datatype datatype
 static __inline__
 void make_mem_defined_if_addressable ( void *buffer, int count, MPI_Datatype datatype )
 {
-   walk_type_array( make_mem_defined_if_addressable_untyped,
-                    buffer, datatype, count );
+   Layout* lay;
+   if (count <= 0)
+      return;
+   lay = get_layout(datatype);
+   VALGRIND_MAKE_MEM_EXTENTS_DEFINED_IF_ADDRESSABLE(buffer, lay->frags,
+                                                    lay->n_frags, count,
+                                                    lay->extent);
+   pthread_mutex_unlock(&layouts_lock);
 }
 
 static __inline__
@@ -1779,6 +1928,7 @@ int WRAPPER_FOR(PMPI_Type_free)( MPI_Datatype* ty )
    VALGRIND_GET_ORIG_FN(fn);
    before("Type_free");
    check_mem_is_defined_untyped(ty, sizeof(*ty));
+   forget_layout(*ty);
    if (cONFIG_DER) VALGRIND_DISABLE_ERROR_REPORTING;
    CALL_FN_W_W(err, fn, ty);
    if (cONFIG_DER) VALGRIND_ENABLE_ERROR_REPORTING;
@@ -46,6 +46,10 @@ IRSB* nl_instrument ( VgCallbackClosure* closure,
     return bb;
 }
 
+static void nl_start_instrumentation(void)
+{
+}
+
 static void nl_fini(Int exitcode)
 {
 }
@@ -65,7 +69,21 @@ static void nl_pre_clo_init(void)
                                  nl_instrument,
                                  nl_fini);
 
-   /* No needs, no core events to track */
+   /* Nothing but the guest code goes into our translations, so they
+      can be reused by later runs. */
+   VG_(needs_persistent_translations) ();
+
+   /* And they have no instrumentation at all, so several threads can
+      run them at once. */
+   VG_(needs_thread_safe_instrumentation) ();
+
+   /* Nor any state to catch up with when --fast-forward ends. */
+   VG_(needs_fast_forward) (nl_start_instrumentation);
+
+   /* And all the code is as cheap to instrument as it can be. */
+   VG_(needs_instrumentation_filter) (nl_instrument);
+
+   /* No other needs, no core events to track */
 }
 
 VG_DETERMINE_INTERFACE_VERSION(nl_pre_clo_init)
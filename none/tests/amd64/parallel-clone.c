@@ -0,0 +1,159 @@
+/* Stress test for --parallel-threads=yes, with threads made directly
+   by clone(), so that nothing but the threads' own code runs in them.
+
+   "spin": four threads each run a loop of direct calls and jumps at
+   the same time.  With --parallel-threads nothing is chained, so every
+   direct exit goes through the unchained dispatch stub.  The main
+   thread checks their results against a run of its own.
+
+   "discard": as "spin", but the threads also keep calling through a
+   pointer into one of two code pages, while the main thread switches
+   the pointer, discards the translations of both pages, and maps, runs
+   and unmaps a page of code of its own.  The threads have to be
+   stopped before each discard; a thread left running in a discarded
+   translation would crash or see a wrong value. */
+
+#define _GNU_SOURCE
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#include "tests/sys_mman.h"
+#include "../../../include/valgrind.h"
+
+#define N_THREADS  4
+#define N_ITERS    2000000
+#define N_ROUNDS   300
+#define STACK_SIZE 65536
+
+typedef int (*CodeFn)(void);
+
+static char stacks[N_THREADS][STACK_SIZE] __attribute__((aligned(16)));
+
+static int                    discard_mode;
+static volatile int           started;
+static volatile int           stop;
+static volatile int           done[N_THREADS];
+static volatile unsigned long results[N_THREADS];
+static volatile unsigned long bad[N_THREADS];
+static CodeFn volatile        code_fn;
+static unsigned char*         code_pages[2];
+
+__attribute__((noinline))
+static unsigned long step ( unsigned long x, unsigned long i )
+{
+   if (i & 1)
+      return x * 3 + 1;
+   else
+      return (x >> 1) + i;
+}
+
+__attribute__((noinline))
+static unsigned long run ( unsigned long seed )
+{
+   unsigned long i, x = seed;
+   for (i = 0; i < N_ITERS; i++)
+      x = step(x, i);
+   return x;
+}
+
+/* Writes "mov $val, %eax ; ret" at p. */
+static void put_code ( unsigned char* p, int val )
+{
+   p[0] = 0xB8;
+   memcpy(p + 1, &val, 4);
+   p[5] = 0xC3;
+}
+
+static unsigned char* map_code ( int val )
+{
+   unsigned char* p = mmap(NULL, 4096, PROT_READ|PROT_WRITE|PROT_EXEC,
+                           MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+   if (p == MAP_FAILED) {
+      perror("mmap");
+      return NULL;
+   }
+   put_code(p, val);
+   return p;
+}
+
+static int thread_fn ( void* arg )
+{
+   long          me = (long)arg;
+   unsigned long n_bad = 0;
+   int           v;
+
+   __atomic_fetch_add(&started, 1, __ATOMIC_RELEASE);
+   if (discard_mode) {
+      while (!stop) {
+         v = code_fn();
+         if (v != 1 && v != 2)
+            n_bad++;
+      }
+   }
+   results[me] = run(me + 1);
+   bad[me] = n_bad;
+   __atomic_store_n(&done[me], 1, __ATOMIC_RELEASE);
+   return 0;
+}
+
+static void main_rounds ( void )
+{
+   unsigned char* mine;
+   int            i, n_bad = 0;
+
+   for (i = 0; i < N_ROUNDS; i++) {
+      code_fn = (CodeFn)code_pages[i & 1];
+      VALGRIND_DISCARD_TRANSLATIONS(code_pages[0], 4096);
+      VALGRIND_DISCARD_TRANSLATIONS(code_pages[1], 4096);
+
+      mine = map_code(100 + i);
+      if (mine == NULL || ((CodeFn)mine)() != 100 + i)
+         n_bad++;
+      munmap(mine, 4096);
+   }
+   printf("main: %s\n", n_bad ? "wrong code run" : "ok");
+}
+
+int main ( int argc, char** argv )
+{
+   long i;
+
+   if (argc != 2
+       || (strcmp(argv[1], "spin") && strcmp(argv[1], "discard"))) {
+      fprintf(stderr, "usage: parallel-clone spin|discard\n");
+      return 1;
+   }
+   discard_mode = !strcmp(argv[1], "discard");
+
+   code_pages[0] = map_code(1);
+   code_pages[1] = map_code(2);
+   if (code_pages[0] == NULL || code_pages[1] == NULL)
+      return 1;
+   code_fn = (CodeFn)code_pages[0];
+
+   for (i = 0; i < N_THREADS; i++) {
+      if (clone(thread_fn, stacks[i] + STACK_SIZE,
+                CLONE_VM | CLONE_FS | CLONE_FILES | CLONE_SIGHAND
+                | CLONE_THREAD | CLONE_SYSVSEM, (void*)i) == -1) {
+         perror("clone");
+         return 1;
+      }
+   }
+
+   if (discard_mode) {
+      while (__atomic_load_n(&started, __ATOMIC_ACQUIRE) < N_THREADS)
+         sched_yield();
+      main_rounds();
+   }
+   stop = 1;
+
+   for (i = 0; i < N_THREADS; i++)
+      while (!__atomic_load_n(&done[i], __ATOMIC_ACQUIRE))
+         sched_yield();
+
+   for (i = 0; i < N_THREADS; i++)
+      printf("thread %ld: %s\n", i,
+             results[i] != run(i + 1) ? "wrong result"
+             : bad[i] ? "wrong code run" : "ok");
+   return 0;
+}
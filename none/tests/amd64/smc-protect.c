@@ -0,0 +1,115 @@
+/* Test --smc-check=protect.  Code is written to memory, run, then
+   rewritten and run again, many times over, in three kinds of memory:
+
+   - a private anonymous mapping, which Valgrind write-protects;
+
+   - a System V shared memory segment attached twice, with the code
+     written through one attachment and run through the other.  A
+     write through the first attachment doesn't fault on the second,
+     so the code must be checked instead;
+
+   - a MAP_SHARED anonymous mapping, with the code rewritten by a
+     child process, whose writes can't fault in the parent either.
+
+   For each, CORRECT output is 100 (every run of the code returned the
+   value just written into it); WRONG output is less.  Running natively
+   or with --smc-check=all-non-file gives the same output.
+*/
+
+#include <stdio.h>
+#include <assert.h>
+#include <unistd.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#include <sys/wait.h>
+#include "tests/sys_mman.h"
+
+#define N_RUNS 100
+
+typedef unsigned char UChar;
+
+/* Make code be  movl $n, %eax ; ret */
+static void set_code ( UChar* code, int n )
+{
+   code[0] = 0xB8;
+   code[1] = (n & 0xFF);
+   code[2] = ((n >>  8) & 0xFF);
+   code[3] = ((n >> 16) & 0xFF);
+   code[4] = ((n >> 24) & 0xFF);
+   code[5] = 0xC3;
+}
+
+/* Call the code through a pointer, so vex can't chase into it. */
+__attribute__((noinline))
+static int run_code ( UChar* code )
+{
+   return ((int(*)(void))code)();
+}
+
+static void test_private ( void )
+{
+   int i, n_ok = 0;
+   UChar* code = mmap(NULL, 4096, PROT_READ|PROT_WRITE|PROT_EXEC,
+                      MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+   assert(code != MAP_FAILED);
+   for (i = 0; i < N_RUNS; i++) {
+      set_code(code, i);
+      if (run_code(code) == i)
+         n_ok++;
+   }
+   printf("private anonymous: %d\n", n_ok);
+   /* Not unmapped: Valgrind has given up protecting this page by now,
+      and a later test mapping the same address would inherit that. */
+}
+
+static void test_sysv_shm ( void )
+{
+   int i, n_ok = 0;
+   UChar *wr, *ex;
+   int id = shmget(IPC_PRIVATE, 4096, IPC_CREAT | 0600);
+   assert(id != -1);
+   wr = shmat(id, NULL, 0);
+   ex = shmat(id, NULL, SHM_RDONLY);
+   shmctl(id, IPC_RMID, NULL);
+   assert(wr != (void*)-1 && ex != (void*)-1 && wr != ex);
+   if (mprotect(ex, 4096, PROT_READ|PROT_EXEC) != 0)
+      perror("mprotect");
+   for (i = 0; i < N_RUNS; i++) {
+      set_code(wr, i);
+      if (run_code(ex) == i)
+         n_ok++;
+   }
+   printf("sysv shm attached twice: %d\n", n_ok);
+}
+
+static void test_shared_anon ( void )
+{
+   int i, n_ok = 0;
+   UChar* code = mmap(NULL, 4096, PROT_READ|PROT_WRITE|PROT_EXEC,
+                      MAP_SHARED|MAP_ANONYMOUS, -1, 0);
+   assert(code != MAP_FAILED);
+   set_code(code, -1);
+   run_code(code);
+   fflush(stdout);
+   for (i = 0; i < N_RUNS; i++) {
+      pid_t pid = fork();
+      assert(pid != -1);
+      if (pid == 0) {
+         set_code(code, i);
+         _exit(0);
+      }
+      waitpid(pid, NULL, 0);
+      if (run_code(code) == i)
+         n_ok++;
+   }
+   printf("shared anonymous, written by child: %d\n", n_ok);
+   munmap(code, 4096);
+}
+
+int main ( void )
+{
+   test_private();
+   test_sysv_shm();
+   test_shared_anon();
+   return 0;
+}
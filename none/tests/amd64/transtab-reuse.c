@@ -0,0 +1,58 @@
+/* --transtab-reuse=yes: a page of code is unmapped and mapped again at
+   the same address, over and over.  While its bytes are the same, its
+   translation is reused; once they change, the recorded translation
+   has to be rejected, and the new code run. */
+
+#include <stdio.h>
+#include <string.h>
+#include "tests/sys_mman.h"
+
+#define N_ROUNDS 100
+
+typedef int (*CodeFn)(void);
+
+/* Writes "mov $val, %eax ; ret" at p. */
+static void put_code ( unsigned char* p, int val )
+{
+   p[0] = 0xB8;
+   memcpy(p + 1, &val, 4);
+   p[5] = 0xC3;
+}
+
+static unsigned char* map_code ( void* at, int val )
+{
+   unsigned char* p = mmap(at, 4096, PROT_READ|PROT_WRITE|PROT_EXEC,
+                           MAP_PRIVATE|MAP_ANONYMOUS|(at ? MAP_FIXED : 0),
+                           -1, 0);
+   if (p == MAP_FAILED) {
+      perror("mmap");
+      return NULL;
+   }
+   put_code(p, val);
+   return p;
+}
+
+int main ( void )
+{
+   unsigned char* page;
+   int            i, n_bad = 0;
+
+   page = map_code(NULL, 1);
+   if (page == NULL)
+      return 1;
+   for (i = 0; i < N_ROUNDS; i++) {
+      if (((CodeFn)page)() != 1)
+         n_bad++;
+      munmap(page, 4096);
+      if (map_code(page, 1) == NULL)
+         return 1;
+   }
+   printf("unchanged code: %s\n", n_bad ? "wrong result" : "ok");
+
+   munmap(page, 4096);
+   if (map_code(page, 2) == NULL)
+      return 1;
+   printf("changed code: %s\n",
+          ((CodeFn)page)() != 2 ? "wrong result" : "ok");
+   return 0;
+}
@@ -0,0 +1,96 @@
+/* Tests VALGRIND_FORK_SERVER.  Run with no arguments, this is the
+   driver: it starts itself again, as the server, with the request and
+   reply pipes on fds 8 and 9, and asks for a few runs, as AFL
+   would.  The server does some initialisation once, and each run
+   continues from the request with its results. */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "../../include/valgrind.h"
+
+#define REQ_FD   8
+#define REPLY_FD 9
+#define N_RUNS   3
+
+static int read_int ( int fd )
+{
+   int n;
+   if (read(fd, &n, sizeof(n)) != sizeof(n)) {
+      printf("driver: short read\n");
+      exit(1);
+   }
+   return n;
+}
+
+static void driver ( const char* self )
+{
+   int req[2], rep[2], i, status;
+   pid_t server;
+
+   assert(pipe(req) == 0 && pipe(rep) == 0);
+   fflush(stdout);
+   server = fork();
+   assert(server != -1);
+   if (server == 0) {
+      dup2(req[0], REQ_FD);
+      dup2(rep[1], REPLY_FD);
+      close(req[0]); close(req[1]);
+      close(rep[0]); close(rep[1]);
+      execl(self, self, "server", (char*)NULL);
+      perror("execl");
+      exit(1);
+   }
+   close(req[0]);
+   close(rep[1]);
+
+   printf("driver: server says hello %d\n", read_int(rep[0]));
+   for (i = 0; i < N_RUNS; i++) {
+      int msg = 0, pid;
+      fflush(stdout);
+      assert(write(req[1], &msg, sizeof(msg)) == sizeof(msg));
+      pid = read_int(rep[0]);
+      status = read_int(rep[0]);
+      printf("driver: run %d: %s, exit status %d\n", i,
+             pid > 0 && pid != server ? "new process" : "bad pid",
+             WIFEXITED(status) ? WEXITSTATUS(status) : -1);
+   }
+
+   /* No more requests: the server exits. */
+   close(req[1]);
+   assert(waitpid(server, &status, 0) == server);
+   printf("driver: server exit status %d\n",
+          WIFEXITED(status) ? WEXITSTATUS(status) : -1);
+}
+
+static void server ( void )
+{
+   static int table[1000];
+   int i, sum = 0;
+   unsigned r;
+
+   printf("server: initialising\n");
+   for (i = 0; i < 1000; i++)
+      table[i] = i * i;
+   fflush(stdout);
+
+   r = VALGRIND_FORK_SERVER;
+
+   /* From here on, in each of the runs. */
+   for (i = 0; i < 1000; i++)
+      sum += table[i];
+   printf("run: request returned %u, sum %d\n", r, sum);
+   fflush(stdout);
+   exit(7);
+}
+
+int main ( int argc, char** argv )
+{
+   if (argc == 1)
+      driver(argv[0]);
+   else
+      server();
+   return 0;
+}
@@ -0,0 +1,47 @@
+/* Tests VALGRIND_PRETRANSLATE and --pretranslate.  The handler is
+   translated ahead of time by one or the other, and then runs as
+   usual.  What is translated already, and what is not code, is not
+   translated (again). */
+
+#include <stdio.h>
+#include "../../include/valgrind.h"
+
+static const int not_code[16] = { 1, 2, 3 };
+
+__attribute__((noinline))
+static int helper ( int x )
+{
+   return x * 3 + 1;
+}
+
+__attribute__((noinline))
+static int handler ( int x )
+{
+   int i, r = 0;
+   for (i = 0; i < x; i++) {
+      if (i & 1)
+         r += helper(i);
+      else
+         r -= i;
+   }
+   return r;
+}
+
+static const char* made ( unsigned n )
+{
+   return n > 0 ? "some translations made" : "no translations made";
+}
+
+int main ( void )
+{
+   /* The handler and helper are much smaller than this. */
+   unsigned n1 = VALGRIND_PRETRANSLATE(handler, 4096);
+   unsigned n2 = VALGRIND_PRETRANSLATE(handler, 4096);
+   unsigned n3 = VALGRIND_PRETRANSLATE(not_code, sizeof(not_code));
+
+   printf("handler:     %s\n", made(n1));
+   printf("again:       %s\n", made(n2));
+   printf("not code:    %s\n", made(n3));
+   printf("handler(10): %d\n", handler(10));
+   return 0;
+}
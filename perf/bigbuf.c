@@ -0,0 +1,46 @@
+// This artificial program allocates, checks and frees a lot of
+// multi-megabyte buffers.  Apart from the malloc/free and mmap/munmap
+// calls themselves, every read() and write() makes Memcheck check the
+// whole buffer, so it is a stress test for set_address_range_perms and
+// the range checkers (is_mem_defined and friends) on large ranges.
+
+#include <assert.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#define NITERS 200
+#define MAX_SZB (16 * 1024 * 1024)
+
+int main(void)
+{
+   int i, zero, null;
+   size_t szB;
+   char* p;
+
+   zero = open("/dev/zero", O_RDONLY);
+   null = open("/dev/null", O_WRONLY);
+   assert(zero >= 0 && null >= 0);
+
+   for (i = 0; i < NITERS; i++) {
+      // Sizes from 1MB up to MAX_SZB, not a multiple of any page size.
+      szB = (1024 * 1024) + (i * 987654) % (MAX_SZB - 1024 * 1024);
+
+      p = malloc(szB);
+      assert(p);
+      memset(p, i, szB / 2);
+      assert(read(zero, p + szB / 2, szB - szB / 2) == szB - szB / 2);
+      assert(write(null, p, szB) == szB);
+      free(p);
+
+      p = mmap(NULL, szB, PROT_READ | PROT_WRITE,
+               MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      assert(p != MAP_FAILED);
+      assert(write(null, p, szB) == szB);
+      assert(read(zero, p, szB) == szB);
+      munmap(p, szB);
+   }
+   return 0;
+}
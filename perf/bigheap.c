@@ -0,0 +1,42 @@
+// This artificial program builds a big heap: a given number of megabytes
+// (first argument, 1024 by default) in blocks of a few KB, all live at
+// once and all written to, and then reads it all back and frees it.  It
+// measures how the tools scale with the size of the heap: shadow memory
+// for all of it, the bookkeeping for many live blocks, and the cost of
+// freeing them.  Give it a large size, say 10240, for a test of really
+// big programs, on a machine which can take it.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+int main(int argc, char** argv)
+{
+   long mb = argc > 1 ? atol(argv[1]) : 1024;
+   long n_blocks, i;
+   char** blocks;
+   unsigned long sum = 0;
+   const size_t szB = 4000;
+
+   n_blocks = mb * 1024 * 1024 / szB;
+   blocks = malloc(n_blocks * sizeof(char*));
+   if (blocks == NULL) {
+      fprintf(stderr, "bigheap: out of memory\n");
+      return 1;
+   }
+   for (i = 0; i < n_blocks; i++) {
+      blocks[i] = malloc(szB);
+      if (blocks[i] == NULL) {
+         fprintf(stderr, "bigheap: out of memory\n");
+         return 1;
+      }
+      memset(blocks[i], (int)i, szB);
+   }
+   for (i = 0; i < n_blocks; i++)
+      sum += blocks[i][i % szB];
+   for (i = 0; i < n_blocks; i++)
+      free(blocks[i]);
+   free(blocks);
+   printf("%d\n", sum > 0);
+   return 0;
+}
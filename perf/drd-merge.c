@@ -0,0 +1,49 @@
+// This test creates many threads that each touch a private slice of a
+// shared array and a shared read-only table, and that synchronise through a
+// single mutex after every slice.  Every lock hand-off starts a new segment,
+// so under DRD the run time is dominated by the bitmap merges and conflict
+// checks between the segments of the different threads.
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define N_THREADS  100
+#define N_ROUNDS   50
+#define SLICE_SIZE 256
+
+static unsigned char table[4096];
+static unsigned char data[N_THREADS][SLICE_SIZE];
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static unsigned long counter;
+
+static void* thread_func(void* arg)
+{
+   const long tid = (long)arg;
+   int r, i;
+
+   for (r = 0; r < N_ROUNDS; r++) {
+      for (i = 0; i < SLICE_SIZE; i++)
+         data[tid][i] += table[(tid * SLICE_SIZE + r + i) % sizeof(table)];
+      pthread_mutex_lock(&lock);
+      counter += data[tid][r % SLICE_SIZE];
+      pthread_mutex_unlock(&lock);
+   }
+   return NULL;
+}
+
+int main(void)
+{
+   pthread_t tids[N_THREADS];
+   long t;
+   unsigned i;
+
+   for (i = 0; i < sizeof(table); i++)
+      table[i] = i * 7;
+   for (t = 0; t < N_THREADS; t++)
+      pthread_create(&tids[t], NULL, thread_func, (void*)t);
+   for (t = 0; t < N_THREADS; t++)
+      pthread_join(tids[t], NULL);
+   printf("counter = %lu\n", counter);
+   return 0;
+}
@@ -0,0 +1,64 @@
+// This artificial program maps, touches, protects and unmaps a lot of
+// anonymous and file-backed memory, of many sizes, with many mappings
+// live at a time.  It stresses the address space manager (segment
+// splitting and merging), the handling of mmap/munmap/mprotect in the
+// tools (shadow memory set up and torn down for each mapping), and the
+// discarding of translations for unmapped code.
+
+#include <assert.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#define N_LIVE  256
+#define N_ITERS 5000
+
+int main(void)
+{
+   static char* maps[N_LIVE];
+   static size_t sizes[N_LIVE];
+   long page = sysconf(_SC_PAGESIZE);
+   unsigned long sum = 0;
+   int zero, i;
+
+   zero = open("/dev/zero", O_RDONLY);
+   assert(zero >= 0);
+
+   for (i = 0; i < N_ITERS; i++) {
+      int slot = (i * 7919) % N_LIVE;
+      size_t npages = 1 + (i * 31) % 64;
+      char* p;
+      size_t j;
+
+      if (maps[slot] != NULL)
+         munmap(maps[slot], sizes[slot]);
+
+      if (i % 4 == 0)
+         p = mmap(NULL, npages * page, PROT_READ|PROT_WRITE,
+                  MAP_PRIVATE, zero, 0);
+      else
+         p = mmap(NULL, npages * page, PROT_READ|PROT_WRITE,
+                  MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+      assert(p != MAP_FAILED);
+
+      for (j = 0; j < npages; j++)
+         p[j * page] = (char)j;
+      // Make the middle read-only, splitting the mapping in three.
+      if (npages >= 3)
+         mprotect(p + page, (npages - 2) * page, PROT_READ);
+      for (j = 0; j < npages; j++)
+         sum += p[j * page];
+
+      maps[slot] = p;
+      sizes[slot] = npages * page;
+   }
+
+   for (i = 0; i < N_LIVE; i++)
+      if (maps[i] != NULL)
+         munmap(maps[i], sizes[i]);
+   close(zero);
+   printf("%d\n", sum > 0);
+   return 0;
+}
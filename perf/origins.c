@@ -0,0 +1,33 @@
+// This artificial program sweeps over two 256KB areas 1MB apart again
+// and again, adding each word of the second area into the matching word
+// of the first, touching one word in every 32 bytes.  Run with
+// --track-origins=yes, every load and store also looks up Memcheck's
+// origin cache (ocacheL1), which has a 32 byte line.  Until the cache
+// has enough sets, the two words of each addition land in the same set,
+// so one of them is always found on the slow path although both areas
+// fit in the cache and hardly anything misses.  This is a test of how
+// well the cache adapts to such working sets.
+
+#define AREA_WORDS   (256 * 1024 / sizeof(unsigned int))
+#define APART_WORDS  (1024 * 1024 / sizeof(unsigned int))
+#define LINE_WORDS   (32 / sizeof(unsigned int))
+#define NPASSES      1000
+
+static unsigned int buf[APART_WORDS + AREA_WORDS];
+
+volatile unsigned int sink;
+
+int main(void)
+{
+   unsigned int i, pass;
+
+   for (pass = 0; pass < NPASSES; pass++) {
+      for (i = 0; i < AREA_WORDS; i += LINE_WORDS)
+         buf[i] += buf[i + APART_WORDS] + 1;
+   }
+
+   for (i = 0; i < AREA_WORDS; i += LINE_WORDS)
+      sink = buf[i];
+
+   return 0;
+}
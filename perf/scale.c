@@ -0,0 +1,164 @@
+// This test measures how the slowdown changes with the number of guest
+// threads.  The same total amount of work is split between N threads,
+// which share it in one of several ways:
+//
+//   indep       each thread works on its own private data
+//   readmostly  threads mostly read a shared table, under a rwlock, and
+//               now and then one of them updates it
+//   mutex       threads update shared counters under a single mutex
+//   condvar     a token is passed round the threads, each one waiting on
+//               its own condition variable for its turn
+//   atomic      threads update shared counters with atomic instructions
+//
+// Natively, the run time should hardly depend on N (on a machine with a
+// few cores, the contended patterns even get slower).  Under Valgrind only
+// one thread runs at a time, so what this shows is the cost of thread
+// switches under the big lock, and how the tools' per-thread and
+// synchronisation data structures grow with the number of threads.
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_THREADS   128
+#define N_OPS         (1 << 21)   // total, shared between the threads
+#define N_HANDOFFS    20000       // total, for "condvar"
+#define TABLE_SIZE    256         // words, for "readmostly"
+#define WRITE_EVERY   1024        // reads per update, for "readmostly"
+
+typedef enum { INDEP, READMOSTLY, MUTEX, CONDVAR, ATOMIC } Pattern;
+
+static Pattern pattern;
+static long    n_threads;
+
+static pthread_mutex_t  lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_rwlock_t rwlock = PTHREAD_RWLOCK_INITIALIZER;
+static pthread_cond_t   conds[MAX_THREADS];
+static long             turn;           // whose turn it is, for "condvar"
+static long             handoffs;
+
+static unsigned long    counters[4];
+static unsigned long    table[TABLE_SIZE];
+static unsigned long    sums[MAX_THREADS];
+
+static void* thread_func(void* arg)
+{
+   const long tid = (long)arg;
+   const long n_ops = N_OPS / n_threads;
+   unsigned long sum = 0;
+   long i;
+
+   switch (pattern) {
+   case INDEP: {
+      unsigned long* mine = calloc(TABLE_SIZE, sizeof(unsigned long));
+      for (i = 0; i < n_ops; i++) {
+         mine[i % TABLE_SIZE] += i;
+         sum += mine[(i * 7) % TABLE_SIZE];
+      }
+      free(mine);
+      break;
+   }
+   case READMOSTLY:
+      for (i = 0; i < n_ops; i++) {
+         if (i % WRITE_EVERY == tid % WRITE_EVERY) {
+            pthread_rwlock_wrlock(&rwlock);
+            table[i % TABLE_SIZE]++;
+            pthread_rwlock_unlock(&rwlock);
+         } else if (i % 16 == 0) {
+            // Take the read lock for a batch of reads, as a real reader
+            // would, rather than for each one.
+            long j;
+            pthread_rwlock_rdlock(&rwlock);
+            for (j = 0; j < 16; j++)
+               sum += table[(i + j) % TABLE_SIZE];
+            pthread_rwlock_unlock(&rwlock);
+         }
+      }
+      break;
+   case MUTEX:
+      for (i = 0; i < n_ops; i++) {
+         pthread_mutex_lock(&lock);
+         counters[(tid + i) & 3]++;
+         pthread_mutex_unlock(&lock);
+      }
+      break;
+   case CONDVAR:
+      pthread_mutex_lock(&lock);
+      for (;;) {
+         while (turn != tid && handoffs < N_HANDOFFS)
+            pthread_cond_wait(&conds[tid], &lock);
+         if (handoffs >= N_HANDOFFS)
+            break;
+         handoffs++;
+         sum++;
+         turn = (tid + 1) % n_threads;
+         pthread_cond_signal(&conds[turn]);
+      }
+      // Wake up the next one, so that it sees that we are done too.
+      pthread_cond_signal(&conds[(tid + 1) % n_threads]);
+      pthread_mutex_unlock(&lock);
+      break;
+   case ATOMIC:
+      for (i = 0; i < n_ops; i++)
+         __sync_fetch_and_add(&counters[(tid + i) & 3], 1);
+      break;
+   }
+   sums[tid] = sum;
+   return NULL;
+}
+
+int main(int argc, char** argv)
+{
+   static const char* const names[] =
+      { "indep", "readmostly", "mutex", "condvar", "atomic" };
+   pthread_t tids[MAX_THREADS];
+   unsigned long total = 0, expected;
+   long t;
+   int p;
+
+   if (argc != 3) {
+      fprintf(stderr, "usage: scale <pattern> <n-threads>\n");
+      return 1;
+   }
+   for (p = 0; p < 5; p++)
+      if (strcmp(argv[1], names[p]) == 0)
+         break;
+   n_threads = atol(argv[2]);
+   if (p == 5 || n_threads < 1 || n_threads > MAX_THREADS) {
+      fprintf(stderr, "scale: bad pattern or thread count\n");
+      return 1;
+   }
+   pattern = p;
+
+   for (t = 0; t < n_threads; t++)
+      pthread_cond_init(&conds[t], NULL);
+   for (t = 0; t < n_threads; t++)
+      pthread_create(&tids[t], NULL, thread_func, (void*)t);
+   for (t = 0; t < n_threads; t++)
+      pthread_join(tids[t], NULL);
+
+   // Check that the threads did all the work.
+   switch (pattern) {
+   case MUTEX:
+   case ATOMIC:
+      for (t = 0; t < 4; t++)
+         total += counters[t];
+      expected = (unsigned long)(N_OPS / n_threads) * n_threads;
+      break;
+   case CONDVAR:
+      for (t = 0; t < n_threads; t++)
+         total += sums[t];
+      expected = N_HANDOFFS;
+      break;
+   default:
+      total = expected = 0;
+      break;
+   }
+   if (total != expected) {
+      fprintf(stderr, "scale: total %lu is wrong, expected %lu\n",
+              total, expected);
+      return 1;
+   }
+   return 0;
+}
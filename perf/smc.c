@@ -0,0 +1,47 @@
+// This artificial program behaves like a JIT compiler: it keeps writing
+// small functions into a buffer and calling them, patching constants in
+// code it has already run.  Every patch must make Valgrind discard and
+// redo the translations of the code concerned, so it stresses the
+// self-modifying code detection (run it with --smc-check=all) and the
+// translation table's discarding.  It only generates code on x86 and
+// amd64; elsewhere it does nothing.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#define N_FUNCS 64
+#define N_ITERS 20000
+
+typedef int (*Fn)(void);
+
+int main(void)
+{
+#if defined(__i386__) || defined(__x86_64__)
+   unsigned char* buf;
+   long sum = 0;
+   int i;
+
+   buf = mmap(NULL, N_FUNCS * 16, PROT_READ|PROT_WRITE|PROT_EXEC,
+              MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+   if (buf == MAP_FAILED) {
+      perror("mmap");
+      return 1;
+   }
+
+   for (i = 0; i < N_ITERS; i++) {
+      int f = i % N_FUNCS;
+      unsigned char* code = buf + f * 16;
+      int k = i;
+      // mov $k, %eax ; ret
+      code[0] = 0xB8;
+      memcpy(code + 1, &k, 4);
+      code[5] = 0xC3;
+      __builtin___clear_cache((char*)code, (char*)code + 6);
+      sum += ((Fn)code)();
+   }
+   printf("%d\n", sum == (long)N_ITERS * (N_ITERS - 1) / 2);
+#endif
+   return 0;
+}
@@ -0,0 +1,53 @@
+// This artificial program does a lot of small system calls: writes and
+// reads of a temporary file, pipe round trips, stat and lseek.  Each one
+// makes Valgrind leave the translated code, check the arguments (and for
+// Memcheck, the memory they point to) and update the shadow state for
+// the results, so this measures the fixed cost per system call rather
+// than the cost of running code.
+
+#include <assert.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define N_ITERS 50000
+
+int main(void)
+{
+   char name[] = "/tmp/vg_perf_syscalls.XXXXXX";
+   char buf[512];
+   int fds[2];
+   struct stat st;
+   unsigned long sum = 0;
+   int fd, i;
+
+   fd = mkstemp(name);
+   assert(fd >= 0);
+   unlink(name);
+   assert(pipe(fds) == 0);
+   memset(buf, 'x', sizeof buf);
+
+   for (i = 0; i < N_ITERS; i++) {
+      size_t n = 1 + i % sizeof buf;
+      assert(write(fd, buf, n) == (ssize_t)n);
+      if (i % 64 == 63) {
+         lseek(fd, 0, SEEK_SET);
+         while (read(fd, buf, sizeof buf) > 0)
+            sum += buf[0];
+         assert(ftruncate(fd, 0) == 0);
+         lseek(fd, 0, SEEK_SET);
+      }
+      assert(write(fds[1], &i, sizeof i) == sizeof i);
+      assert(read(fds[0], &i, sizeof i) == sizeof i);
+      assert(fstat(fd, &st) == 0);
+      sum += st.st_size;
+   }
+   close(fd);
+   close(fds[0]);
+   close(fds[1]);
+   printf("%d\n", sum > 0);
+   return 0;
+}
@@ -0,0 +1,57 @@
+// This artificial program is made of many template instantiations, deeply
+// nested, and is compiled with -g.  So it has a lot of long mangled
+// names and a lot of debug info, and its stack traces go through many
+// small inlined and out-of-line functions.  It stresses the debuginfo
+// reader and symbol table at startup, demangling, and stack unwinding
+// (every allocation records a stack trace in most tools).
+
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
+
+template <int N, typename T>
+struct Node {
+   T value;
+   Node<N - 1, std::vector<T> > child;
+
+   __attribute__((noinline)) unsigned long walk(int depth)
+   {
+      std::vector<T> v(1 + depth % 3, value);
+      return v.size() + child.walk(depth + 1);
+   }
+};
+
+template <typename T>
+struct Node<0, T> {
+   T value;
+   __attribute__((noinline)) unsigned long walk(int depth)
+   {
+      return (unsigned long)depth;
+   }
+};
+
+template <int K>
+struct Family {
+   __attribute__((noinline)) static unsigned long run(int i)
+   {
+      Node<8, std::map<int, std::string> > n;
+      n.value[i] = "x";
+      return n.walk(i) + Family<K - 1>::run(i + 1);
+   }
+};
+
+template <>
+struct Family<0> {
+   static unsigned long run(int) { return 0; }
+};
+
+int main(void)
+{
+   unsigned long sum = 0;
+   for (int i = 0; i < 2000; i++)
+      sum += Family<40>::run(i);
+   std::printf("%d\n", sum > 0);
+   return 0;
+}
@@ -0,0 +1,58 @@
+// This test runs several threads which all update a few shared counters,
+// either under a single mutex ("lock") or with atomic read-modify-write
+// instructions and no locks at all ("atomic").  The lock variant stresses
+// the cost of pthread synchronisation (thread switches under the big lock,
+// and the happens-before bookkeeping of Helgrind and DRD).  The atomic
+// variant stresses the handling of LOCK-prefixed instructions and
+// lock-free code, which the race detectors have to reason about without
+// any synchronisation calls to go on.
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define N_THREADS 8
+#define N_OPS     200000
+
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static unsigned long counters[4];
+static int use_atomics;
+
+static void* thread_func(void* arg)
+{
+   const long tid = (long)arg;
+   long i;
+
+   for (i = 0; i < N_OPS; i++) {
+      unsigned long* c = &counters[(tid + i) & 3];
+      if (use_atomics) {
+         __sync_fetch_and_add(c, 1);
+      } else {
+         pthread_mutex_lock(&lock);
+         (*c)++;
+         pthread_mutex_unlock(&lock);
+      }
+   }
+   return NULL;
+}
+
+int main(int argc, char** argv)
+{
+   pthread_t tids[N_THREADS];
+   unsigned long total = 0;
+   long t;
+
+   use_atomics = argc > 1 && strcmp(argv[1], "atomic") == 0;
+   for (t = 0; t < N_THREADS; t++)
+      pthread_create(&tids[t], NULL, thread_func, (void*)t);
+   for (t = 0; t < N_THREADS; t++)
+      pthread_join(tids[t], NULL);
+   for (t = 0; t < 4; t++)
+      total += counters[t];
+   if (total != (unsigned long)N_THREADS * N_OPS) {
+      fprintf(stderr, "threads: total %lu is wrong\n", total);
+      return 1;
+   }
+   return 0;
+}
@@ -0,0 +1,91 @@
+// Microbenchmark for the WordFM finite maps (coregrind/m_wordfm.c):
+// inserts, lookups and in-order iteration over a large map, using
+// either the AVL tree or the B-tree (VG_(newFM_BTree)) backend,
+// depending on the first argument ("avl" or "btree").  As in
+// memcheck/tests/unit_oset.c, the module is compiled into the
+// program directly, with the few VG_(foo)() functions it uses
+// crudely redirected to their libc equivalents.
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pub_core_basics.h"
+#include "pub_core_libcbase.h"
+#include "pub_core_libcassert.h"
+
+#undef vg_assert
+#define vg_assert(e)                   assert(e)
+#undef tl_assert
+#define tl_assert(e)                   assert(e)
+
+#define vgPlain_memset                 memset
+#define vgPlain_memcpy                 memcpy
+#include "coregrind/m_wordfm.c"
+
+#define NKEYS    (200 * 1000)
+#define NLOOKUPS (4 * 1000 * 1000)
+#define NITERS   20
+
+/* Consistent random number generator, so it produces the
+   same results on all platforms. */
+static UInt seed = 0;
+static UInt myrandom( void )
+{
+   seed = (1103515245 * seed + 12345);
+   return seed;
+}
+
+static void* allocate_node(const HChar* cc, SizeT szB)
+{ return malloc(szB); }
+
+static void free_node(void* p)
+{ free(p); }
+
+static UWord sorted_keys[NKEYS];
+
+int main ( int argc, char* argv[] )
+{
+   Int     i, j;
+   UWord   k, v, sum = 0;
+   Bool    btree = argc > 1 && 0 == strcmp(argv[1], "btree");
+   WordFM* fm;
+
+   // Random inserts, then lookups of keys half of which are present.
+   fm = btree ? VG_(newFM_BTree)( allocate_node, "wordfm", free_node, NULL )
+              : VG_(newFM)( allocate_node, "wordfm", free_node, NULL );
+   for (i = 0; i < NKEYS; i++) {
+      k = 2 * (myrandom() % (4 * NKEYS));
+      VG_(addToFM)( fm, k, i );
+   }
+   for (i = 0; i < NLOOKUPS; i++) {
+      if (VG_(lookupFM)( fm, NULL, &v, myrandom() % (8 * NKEYS) ))
+         sum += v;
+   }
+
+   // In-order iteration over the whole map.
+   for (j = 0; j < NITERS; j++) {
+      VG_(initIterFM)( fm );
+      while (VG_(nextIterFM)( fm, &k, &v ))
+         sum += k ^ v;
+      VG_(doneIterFM)( fm );
+   }
+   VG_(deleteFM)( fm, NULL, NULL );
+
+   // Bulk loading from sorted keys, then deleting them all.
+   for (i = 0; i < NKEYS; i++)
+      sorted_keys[i] = 3 * i;
+   for (j = 0; j < 5; j++) {
+      fm = btree ? VG_(newFM_BTree)( allocate_node, "wordfm", free_node, NULL )
+                 : VG_(newFM)( allocate_node, "wordfm", free_node, NULL );
+      VG_(addSortedToFM)( fm, NKEYS, sorted_keys, NULL );
+      for (i = 0; i < NKEYS; i++)
+         VG_(delFromFM)( fm, NULL, NULL, sorted_keys[(i * 7919) % NKEYS] );
+      assert(VG_(sizeFM)( fm ) == 0);
+      VG_(deleteFM)( fm, NULL, NULL );
+   }
+
+   printf("%lu\n", sum & 0xFFFF);
+   return 0;
+}
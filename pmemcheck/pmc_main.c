@@ -21,6 +21,7 @@
 #include "pub_tool_libcfile.h"
 #include <fcntl.h>
 #include "pub_tool_oset.h"
+#include "pub_tool_hashtable.h"
 #include "pub_tool_mallocfree.h"
 #include "pub_tool_options.h"
 #include "pub_tool_libcbase.h"
@@ -30,6 +31,7 @@
 #include "pub_tool_libcassert.h"
 #include "pub_tool_libcprint.h"
 #include "pub_tool_machine.h"
+#include "pub_tool_libcproc.h"
 
 #include "pmemcheck.h"
 #include "pmc_include.h"
@@ -58,10 +60,107 @@
 /** Max allowable path length */
 #define MAX_PATH_SIZE 4096
 
+/** Page size used by the pmem page map */
+#define PMEM_PAGE_BITS 12
+
+/** Pages covered by one secondary page map - 4GB worth */
+#define PMEM_SEC_BITS 20
+
+/** Entries in the primary page map, enough for 48 address bits */
+#define PMEM_PRIM_BITS 16
+
+/** Size of the buffer for the binary store log */
+#define LOG_BUFFER_SIZE (1 << 20)
+
+/** The first bytes of a binary store log */
+#define LOG_MAGIC "PMCLOG01"
+
+/**
+ * Binary store log record types. Each record is the type byte, followed by
+ * the record's 64-bit arguments in host byte order.
+ */
+enum log_record {
+    /** No arguments */
+    LOG_START = 1,
+    /** No arguments */
+    LOG_STOP,
+    /** Address, value, size */
+    LOG_STORE,
+    /** Address, size */
+    LOG_FLUSH,
+    /** No arguments */
+    LOG_FENCE,
+    /** No arguments */
+    LOG_COMMIT,
+    /** Base, size, offset, name length, followed by the name */
+    LOG_REGISTER_FILE,
+    /** No arguments */
+    LOG_FREORDER,
+    /** No arguments */
+    LOG_PREORDER,
+    /** No arguments */
+    LOG_FAULT_ONLY,
+    /** No arguments */
+    LOG_NO_REORDER_FAULT
+};
+
+/** Line state bits - the states of the stores overlapping a cache line. */
+#define LINE_FLUSHED    (1 << 0)
+#define LINE_FENCED     (1 << 1)
+#define LINE_COMMITTED  (1 << 2)
+
+/** Stores to persistent memory overlapping a single cache line. */
+struct pmem_line {
+    /** Hash chain, has to be the first member. */
+    struct pmem_line *next;
+
+    /** The cache line number - the address divided by the line size. */
+    UWord key;
+
+    /** LINE_* bits, a superset of the states of the stores in the line. */
+    UInt state;
+
+    /** Set if the line is on the list of lines waiting for a fence. */
+    Bool on_fence_list;
+
+    /** Set if the line is on the list of lines waiting for a commit. */
+    Bool on_commit_list;
+
+    /** Next line waiting for a fence. */
+    struct pmem_line *next_fence;
+
+    /** Next line waiting for a commit. */
+    struct pmem_line *next_commit;
+
+    /** The stores overlapping this line, in no particular order. */
+    struct pmem_st **stores;
+
+    /** The number of stores overlapping this line. */
+    UWord n_stores;
+
+    /** The allocated size of stores. */
+    UWord max_stores;
+};
+
 /** Holds parameters and runtime data */
 static struct pmem_ops {
-    /** Set of stores to persistent memory. */
-    OSet *pmem_stores;
+    /**
+     * Stores to persistent memory, indexed by cache line. A store is
+     * registered in every line it overlaps. Stores never overlap each other.
+     */
+    VgHashTable pmem_stores;
+
+    /** Lines with flushed or committed stores, which a fence changes. */
+    struct pmem_line *fence_list;
+
+    /** Lines with fenced stores, which a commit changes. */
+    struct pmem_line *commit_list;
+
+    /** Stores found by the last call to collect_stores. */
+    struct pmem_st **found_stores;
+
+    /** The allocated size of found_stores. */
+    UWord found_stores_size;
 
     /** Set of registered persistent memory regions. */
     OSet *pmem_mappings;
@@ -100,6 +199,18 @@ static struct pmem_ops {
     /** Toggles logging on user requests */
     Bool loggin_on;
 
+    /** The file to write a binary store log to, instead of the text log. */
+    const HChar *log_file;
+
+    /** The descriptor of log_file, -1 if not open. */
+    Int log_fd;
+
+    /** Binary store log records not yet written to log_fd. */
+    UChar *log_buf;
+
+    /** The number of bytes used in log_buf. */
+    UWord log_buf_used;
+
     /** Toggles summary printing. */
     Bool print_summary;
 
@@ -147,6 +258,71 @@ typedef struct {
 /** Number of sblock run. */
 static ULong sblocks = 0;
 
+/**
+ * The pmem page map - a two-level bitmap of the pages stores to which may go
+ * to persistent memory, tested inline before calling trace_pmem_store. A
+ * page's bit is also set if the next page is persistent memory, so that
+ * stores crossing into it are not missed. Unused primary entries point to
+ * pmem_page_map_none, so the inline test needs no NULL check.
+ */
+static UChar pmem_page_map_none[1 << (PMEM_SEC_BITS - 3)];
+static UChar *pmem_page_map[1 << PMEM_PRIM_BITS];
+
+/**
+* \brief Set or clear the bit for a page in the pmem page map.
+* \param[in] page The page number.
+* \param[in] on The new value of the bit.
+*/
+static void
+set_pmem_page_bit(UWord page, Bool on)
+{
+    UWord prim = (page >> PMEM_SEC_BITS) & ((1 << PMEM_PRIM_BITS) - 1);
+    UWord sec = page & ((1 << PMEM_SEC_BITS) - 1);
+    UChar *map = pmem_page_map[prim];
+
+    if (map == pmem_page_map_none) {
+        if (!on)
+            return;
+        map = VG_(malloc)("pmc.main.spb.1", sizeof (pmem_page_map_none));
+        VG_(memset)(map, 0, sizeof (pmem_page_map_none));
+        pmem_page_map[prim] = map;
+    }
+
+    if (on)
+        map[sec >> 3] |= 1 << (sec & 7);
+    else
+        map[sec >> 3] &= ~(1 << (sec & 7));
+}
+
+/**
+* \brief Update the pmem page map after a change of the persistent memory
+*        mappings in the given region.
+* \param[in] base The base address of the changed region.
+* \param[in] size The size of the changed region.
+*/
+static void
+update_pmem_page_map(Addr base, UWord size)
+{
+    if (size == 0)
+        return;
+
+    UWord first = base >> PMEM_PAGE_BITS;
+    UWord last = (base + size - 1) >> PMEM_PAGE_BITS;
+    UWord page;
+
+    /* the page before the region holds stores crossing into it */
+    if (first > 0)
+        --first;
+
+    for (page = first; page <= last; ++page) {
+        struct pmem_st tmp = {0};
+        tmp.addr = page << PMEM_PAGE_BITS;
+        tmp.size = 2 << PMEM_PAGE_BITS;
+        set_pmem_page_bit(page,
+                VG_(OSetGen_Contains)(pmem.pmem_mappings, &tmp));
+    }
+}
+
 /**
 * \brief Check if a given store overlaps with registered persistent memory
 *        regions.
@@ -163,6 +339,398 @@ is_pmem_access(Addr addr, SizeT size)
     return VG_(OSetGen_Contains)(pmem.pmem_mappings, &tmp);
 }
 
+/**
+* \brief Write out the buffered binary store log records.
+*/
+static void
+flush_log_buffer(void)
+{
+    UWord done = 0;
+    while (done < pmem.log_buf_used) {
+        Int written = VG_(write)(pmem.log_fd, pmem.log_buf + done,
+                pmem.log_buf_used - done);
+        if (written <= 0) {
+            VG_(umsg)("Warning: cannot write the store log, it is "
+                    "incomplete\n");
+            break;
+        }
+        done += written;
+    }
+    pmem.log_buf_used = 0;
+}
+
+/**
+* \brief Flush the binary store log before a fork, so that the child does
+*        not write the parent's records again.
+*/
+static void
+flush_log_buffer_at_fork(ThreadId tid)
+{
+    if (pmem.log_fd >= 0)
+        flush_log_buffer();
+}
+
+/**
+* \brief Append a record to the binary store log.
+* \param[in] type The record type.
+* \param[in] args The record arguments.
+* \param[in] nargs The number of arguments.
+* \param[in] data Bytes following the arguments, may be NULL.
+* \param[in] data_size The number of bytes in data.
+*/
+static void
+log_record(enum log_record type, const ULong *args, UWord nargs,
+        const void *data, UWord data_size)
+{
+    UWord size = 1 + nargs * sizeof (ULong) + data_size;
+    tl_assert(size <= LOG_BUFFER_SIZE);
+
+    if (pmem.log_buf_used + size > LOG_BUFFER_SIZE)
+        flush_log_buffer();
+
+    UChar *rec = pmem.log_buf + pmem.log_buf_used;
+    rec[0] = type;
+    VG_(memcpy)(rec + 1, args, nargs * sizeof (ULong));
+    if (data_size)
+        VG_(memcpy)(rec + 1 + nargs * sizeof (ULong), data, data_size);
+    pmem.log_buf_used += size;
+}
+
+/**
+* \brief Log an event without arguments.
+* \param[in] type The binary record type.
+* \param[in] text The text log form of the event.
+*/
+static void
+log_event(enum log_record type, const HChar *text)
+{
+    if (pmem.log_fd >= 0)
+        log_record(type, NULL, 0, NULL, 0);
+    else
+        VG_(emit)("%s", text);
+}
+
+/**
+* \brief Log a store.
+*/
+static void
+log_store(Addr addr, UWord value, SizeT size)
+{
+    if (pmem.log_fd >= 0) {
+        ULong args[3] = { addr, value, size };
+        log_record(LOG_STORE, args, 3, NULL, 0);
+    } else {
+        VG_(emit)("|STORE;0x%lx;0x%lx;0x%lx", addr, value, size);
+    }
+}
+
+/**
+* \brief Log a flush.
+*/
+static void
+log_flush(Addr addr, ULong size)
+{
+    if (pmem.log_fd >= 0) {
+        ULong args[2] = { addr, size };
+        log_record(LOG_FLUSH, args, 2, NULL, 0);
+    } else {
+        VG_(emit)("|FLUSH;0x%lx;0x%llx", addr, size);
+    }
+}
+
+/**
+* \brief Log the registration of a file mapping.
+*/
+static void
+log_register_file(const HChar *file_name, UWord base, UWord size,
+        UWord offset)
+{
+    if (pmem.log_fd >= 0) {
+        UWord name_len = VG_(strlen)(file_name);
+        ULong args[4] = { base, size, offset, name_len };
+        log_record(LOG_REGISTER_FILE, args, 4, file_name, name_len);
+    } else {
+        VG_(emit)("|REGISTER_FILE;%s;0x%lx;0x%lx;0x%lx", file_name, base,
+                size, offset);
+    }
+}
+
+/**
+* \brief Get the number of the cache line containing the given address.
+*/
+static inline UWord
+line_of(Addr addr)
+{
+    return addr / pmem.flush_align_size;
+}
+
+/**
+* \brief Get the line state bit for a given store state.
+*/
+static UInt
+line_state_bit(enum store_state state)
+{
+    switch (state) {
+        case STST_FLUSHED:
+            return LINE_FLUSHED;
+        case STST_FENCED:
+            return LINE_FENCED;
+        case STST_COMMITTED:
+            return LINE_COMMITTED;
+        default:
+            return 0;
+    }
+}
+
+/**
+* \brief Add state bits to a line and queue it for the fence or commit which
+*        will change the state of its stores.
+*/
+static void
+set_line_state(struct pmem_line *line, UInt bits)
+{
+    line->state |= bits;
+
+    if ((bits & (LINE_FLUSHED | LINE_COMMITTED)) && !line->on_fence_list) {
+        line->on_fence_list = True;
+        line->next_fence = pmem.fence_list;
+        pmem.fence_list = line;
+    }
+
+    if ((bits & LINE_FENCED) && !line->on_commit_list) {
+        line->on_commit_list = True;
+        line->next_commit = pmem.commit_list;
+        pmem.commit_list = line;
+    }
+}
+
+/**
+* \brief Free a line if it has no stores and is not queued.
+*/
+static void
+free_line_if_unused(struct pmem_line *line)
+{
+    if (line->n_stores != 0 || line->on_fence_list || line->on_commit_list)
+        return;
+
+    struct pmem_line *removed = VG_(HT_remove)(pmem.pmem_stores, line->key);
+    tl_assert(removed == line);
+    VG_(free)(line->stores);
+    VG_(free)(line);
+}
+
+/**
+* \brief Recompute the state bits of a line from its stores, requeueing or
+*        freeing it as needed. The line must not be on any list.
+*/
+static void
+recompute_line_state(struct pmem_line *line)
+{
+    tl_assert(!line->on_fence_list && !line->on_commit_list);
+
+    UInt bits = 0;
+    UWord i;
+    for (i = 0; i < line->n_stores; ++i)
+        bits |= line_state_bit(line->stores[i]->state);
+
+    line->state = 0;
+    set_line_state(line, bits);
+    free_line_if_unused(line);
+}
+
+/**
+* \brief Register a store in all cache lines it overlaps.
+*/
+static void
+index_store(struct pmem_st *store)
+{
+    tl_assert(store->size > 0);
+
+    UWord key;
+    UWord last = line_of(store->addr + store->size - 1);
+    for (key = line_of(store->addr); key <= last; ++key) {
+        struct pmem_line *line = VG_(HT_lookup)(pmem.pmem_stores, key);
+        if (line == NULL) {
+            line = VG_(malloc)("pmc.main.is.1", sizeof (struct pmem_line));
+            VG_(memset)(line, 0, sizeof (struct pmem_line));
+            line->key = key;
+            VG_(HT_add_node)(pmem.pmem_stores, line);
+        }
+
+        if (line->n_stores == line->max_stores) {
+            line->max_stores = line->max_stores ? 2 * line->max_stores : 4;
+            line->stores = VG_(realloc)("pmc.main.is.2", line->stores,
+                    line->max_stores * sizeof (struct pmem_st *));
+        }
+        line->stores[line->n_stores++] = store;
+        set_line_state(line, line_state_bit(store->state));
+    }
+}
+
+/**
+* \brief Remove a store from all cache lines it overlaps.
+*/
+static void
+unindex_store(struct pmem_st *store)
+{
+    UWord key;
+    UWord last = line_of(store->addr + store->size - 1);
+    for (key = line_of(store->addr); key <= last; ++key) {
+        struct pmem_line *line = VG_(HT_lookup)(pmem.pmem_stores, key);
+        tl_assert(line != NULL);
+
+        UWord i;
+        for (i = 0; i < line->n_stores; ++i) {
+            if (line->stores[i] == store)
+                break;
+        }
+        tl_assert(i < line->n_stores);
+        line->stores[i] = line->stores[--line->n_stores];
+        free_line_if_unused(line);
+    }
+}
+
+/**
+* \brief Update the line state bits after a change of a store's state.
+*/
+static void
+update_store_lines(struct pmem_st *store)
+{
+    UInt bit = line_state_bit(store->state);
+    UWord key;
+    UWord last = line_of(store->addr + store->size - 1);
+    for (key = line_of(store->addr); key <= last; ++key)
+        set_line_state(VG_(HT_lookup)(pmem.pmem_stores, key), bit);
+}
+
+/**
+* \brief Compare stores by their address.
+*/
+static Int
+cmp_store_by_addr(const void *lhs, const void *rhs)
+{
+    const struct pmem_st *l = *(struct pmem_st * const *)lhs;
+    const struct pmem_st *r = *(struct pmem_st * const *)rhs;
+
+    if (l->addr < r->addr)
+        return -1;
+    return l->addr > r->addr;
+}
+
+/**
+* \brief Add the stores of a line overlapping [start, end) to found_stores.
+*
+* A store overlapping several lines of the range is only taken from the first
+* of them, so that it is found once.
+*/
+static void
+collect_line_stores(struct pmem_line *line, Addr start, Addr end, UWord *n)
+{
+    UWord i;
+    for (i = 0; i < line->n_stores; ++i) {
+        struct pmem_st *store = line->stores[i];
+        if (store->addr >= end || store->addr + store->size <= start
+                || line_of(MAX(store->addr, start)) != line->key)
+            continue;
+
+        if (*n == pmem.found_stores_size) {
+            pmem.found_stores_size = pmem.found_stores_size
+                    ? 2 * pmem.found_stores_size : 64;
+            pmem.found_stores = VG_(realloc)("pmc.main.cls.1",
+                    pmem.found_stores,
+                    pmem.found_stores_size * sizeof (struct pmem_st *));
+        }
+        pmem.found_stores[(*n)++] = store;
+    }
+}
+
+/**
+* \brief Find the stores overlapping the region [start, end).
+*
+* Only the lines of the region are looked at, unless there are fewer lines
+* in use than that.
+* \return The number of stores found, they are in found_stores sorted by
+* address, and stay valid until the next call.
+*/
+static UWord
+collect_stores(Addr start, Addr end)
+{
+    UWord n = 0;
+    if (end <= start)
+        return 0;
+
+    UWord first = line_of(start);
+    UWord last = line_of(end - 1);
+    if (last - first < VG_(HT_count_nodes)(pmem.pmem_stores)) {
+        UWord key;
+        for (key = first; key <= last; ++key) {
+            struct pmem_line *line = VG_(HT_lookup)(pmem.pmem_stores, key);
+            if (line != NULL)
+                collect_line_stores(line, start, end, &n);
+        }
+    } else {
+        struct pmem_line *line;
+        VG_(HT_ResetIter)(pmem.pmem_stores);
+        while ((line = VG_(HT_Next)(pmem.pmem_stores)) != NULL)
+            collect_line_stores(line, start, end, &n);
+    }
+
+    VG_(ssort)(pmem.found_stores, n, sizeof (struct pmem_st *),
+            cmp_store_by_addr);
+    return n;
+}
+
+/**
+* \brief Find all registered stores.
+* \return The number of stores, as for collect_stores.
+*/
+static UWord
+collect_all_stores(void)
+{
+    return collect_stores(0, ~(Addr)0);
+}
+
+/**
+* \brief Mark the stores in the given region as clean, that is forget them.
+*
+* Stores partially overlapping the region are trimmed.
+*/
+static void
+remove_stores(Addr base, UWord size)
+{
+    Addr end = base + size;
+    UWord n = collect_stores(base, end);
+    UWord i;
+    for (i = 0; i < n; ++i) {
+        struct pmem_st *store = pmem.found_stores[i];
+        Addr store_end = store->addr + store->size;
+        unindex_store(store);
+
+        if (store->addr < base && store_end > end) {
+            /* slice, keeping the head in store */
+            struct pmem_st *tail = VG_(malloc)("pmc.main.rs.1",
+                    sizeof (struct pmem_st));
+            *tail = *store;
+            tail->addr = end;
+            tail->size = store_end - end;
+            index_store(tail);
+        }
+
+        if (store->addr < base) {
+            /* keep the head */
+            store->size = base - store->addr;
+            index_store(store);
+        } else if (store_end > end) {
+            /* keep the tail */
+            store->addr = end;
+            store->size = store_end - end;
+            index_store(store);
+        } else {
+            VG_(free)(store);
+        }
+    }
+}
+
 /**
 * \brief State to string change for information purposes.
 */
@@ -265,22 +833,21 @@ print_multiple_stores(void)
 static void
 print_store_stats(void)
 {
-    VG_(umsg)("Number of stores not made persistent: %lu\n", VG_(OSetGen_Size)
-            (pmem.pmem_stores));
+    UWord n = collect_all_stores();
+    VG_(umsg)("Number of stores not made persistent: %lu\n", n);
 
-    if (VG_(OSetGen_Size)(pmem.pmem_stores) != 0) {
-        VG_(OSetGen_ResetIter)(pmem.pmem_stores);
+    if (n != 0) {
         struct pmem_st *tmp;
         UWord total = 0;
-        Int i = 0;
+        Int i;
         VG_(umsg)("Stores not made persistent properly:\n");
-        while ((tmp = VG_(OSetGen_Next)(pmem.pmem_stores)) != NULL) {
+        for (i = 0; i < n; ++i) {
+            tmp = pmem.found_stores[i];
             VG_(umsg)("[%d] ", i);
             VG_(pp_ExeContext)(tmp->context);
             VG_(umsg)("\tAddress: 0x%lx\tsize: %llu\tstate: %s\n",
                     tmp->addr, tmp->size, store_state_to_string(tmp->state));
             total += tmp->size;
-            ++i;
         }
         VG_(umsg)("Total memory not made persistent: %lu\n", total);
     }
@@ -356,8 +923,8 @@ trace_pmem_store(Addr addr, SizeT size, UWord value)
     if (LIKELY(!is_pmem_access(addr, size)))
         return;
 
-    struct pmem_st *store = VG_(OSetGen_AllocNode)(pmem.pmem_stores,
-            (SizeT) sizeof (struct pmem_st));
+    struct pmem_st *store = VG_(malloc)("pmc.main.tps.1",
+            sizeof (struct pmem_st));
     store->addr = addr;
     store->size = size;
     store->state = STST_DIRTY;
@@ -368,15 +935,16 @@ trace_pmem_store(Addr addr, SizeT size, UWord value)
     /* log the store, regardless if it is a double store */
     if (pmem.log_stores && ( pmem.loggin_on || VG_(OSetGen_Contains)
             (pmem.loggable_regions, store)))
-        VG_(emit)("|STORE;0x%lx;0x%lx;0x%lx", addr, value, size);
+        log_store(addr, value, size);
 
-    struct pmem_st *existing;
-    while ((existing = VG_(OSetGen_Lookup)(pmem.pmem_stores, store)) !=
-            NULL) {
-        VG_(OSetGen_Remove)(pmem.pmem_stores, existing);
+    UWord n = collect_stores(addr, addr + size);
+    UWord i;
+    for (i = 0; i < n; ++i) {
+        struct pmem_st *existing = pmem.found_stores[i];
+        unindex_store(existing);
         /* not tracking multiple stores, remove and move on */
         if (LIKELY(!pmem.track_multiple_stores)) {
-            VG_(OSetGen_FreeNode)(pmem.pmem_stores, existing);
+            VG_(free)(existing);
             continue;
         }
 
@@ -385,7 +953,7 @@ trace_pmem_store(Addr addr, SizeT size, UWord value)
                 && existing->addr == store->addr
                 && existing->size == store->size
                 && existing->value == store->value) {
-            VG_(OSetGen_FreeNode)(pmem.pmem_stores, existing);
+            VG_(free)(existing);
             continue;
         } else {
             add_warning_event(pmem.multiple_stores, &pmem.multiple_stores_reg,
@@ -394,7 +962,7 @@ trace_pmem_store(Addr addr, SizeT size, UWord value)
         }
     }
     /* it is now safe to insert the new store */
-    VG_(OSetGen_Insert)(pmem.pmem_stores, store);
+    index_store(store);
 
     /* do transaction check */
     handle_tx_store(store);
@@ -623,6 +1191,53 @@ handle_wide_expr(IRSB *sb, IREndness end, IRAtom *addr, IRAtom *data,
     }
 }
 
+/**
+* \brief Make the guard for a store helper call, which is true only if the
+*        store address is on a page set in the pmem page map.
+* \param[in,out] sb The IR superblock to which the expressions are added.
+* \param[in] daddr The expression with the address of the store.
+* \param[in] guard The guard of the store, or NULL if unconditional.
+* \return The new guard.
+*/
+static IRAtom *
+make_pmem_page_guard(IRSB *sb, IRAtom *daddr, IRAtom *guard)
+{
+    tl_assert(typeOfIRExpr(sb->tyenv, daddr) == Ity_I64);
+
+    /* load the secondary map */
+    IRAtom *prim = make_expr(sb, Ity_I64, binop(Iop_Shr64, daddr,
+            mkU8(PMEM_PAGE_BITS + PMEM_SEC_BITS)));
+    prim = make_expr(sb, Ity_I64, binop(Iop_And64, prim,
+            mkU64((1 << PMEM_PRIM_BITS) - 1)));
+    prim = make_expr(sb, Ity_I64, binop(Iop_Shl64, prim, mkU8(3)));
+    prim = make_expr(sb, Ity_I64, binop(Iop_Add64, prim,
+            mkU64((Addr)pmem_page_map)));
+    IRAtom *map = make_expr(sb, Ity_I64, IRExpr_Load(Iend_LE, Ity_I64, prim));
+
+    /* load the byte holding the page's bit */
+    IRAtom *byte = make_expr(sb, Ity_I64, binop(Iop_Shr64, daddr,
+            mkU8(PMEM_PAGE_BITS + 3)));
+    byte = make_expr(sb, Ity_I64, binop(Iop_And64, byte,
+            mkU64((1 << (PMEM_SEC_BITS - 3)) - 1)));
+    byte = make_expr(sb, Ity_I64, binop(Iop_Add64, map, byte));
+    byte = make_expr(sb, Ity_I8, IRExpr_Load(Iend_LE, Ity_I8, byte));
+    byte = make_expr(sb, Ity_I64, unop(Iop_8Uto64, byte));
+
+    /* and extract the bit */
+    IRAtom *bit = make_expr(sb, Ity_I64, binop(Iop_Shr64, daddr,
+            mkU8(PMEM_PAGE_BITS)));
+    bit = make_expr(sb, Ity_I64, binop(Iop_And64, bit, mkU64(7)));
+    bit = make_expr(sb, Ity_I8, unop(Iop_64to8, bit));
+    bit = make_expr(sb, Ity_I64, binop(Iop_Shr64, byte, bit));
+    bit = make_expr(sb, Ity_I64, binop(Iop_And64, bit, mkU64(1)));
+
+    if (guard)
+        bit = make_expr(sb, Ity_I64, binop(Iop_And64, bit,
+                make_expr(sb, Ity_I64, unop(Iop_1Uto64, guard))));
+
+    return make_expr(sb, Ity_I1, binop(Iop_CmpNE64, bit, mkU64(0)));
+}
+
 /**
 * \brief Add a guarded write event.
 * \param[in,out] sb The IR superblock to which the expression belongs.
@@ -644,6 +1259,9 @@ add_event_dw_guarded(IRSB *sb, IRAtom *daddr, Int dsize, IRAtom *guard,
     IRExpr **argv;
     IRDirty *di;
 
+    /* call the helper only for stores which may go to persistent memory */
+    guard = make_pmem_page_guard(sb, daddr, guard);
+
     if (value->tag == Iex_RdTmp
             && typeOfIRExpr(sb->tyenv, value) == Ity_I64) {
         /* handle the normal case */
@@ -709,23 +1327,45 @@ do_fence(void)
 {
     if (pmem.log_stores && (pmem.loggin_on
             || (VG_(OSetGen_Size)(pmem.loggable_regions) != 0)))
-        VG_(emit)("|FENCE");
-
-    /* go through the stores and move them from flushed to fenced */
-    VG_(OSetGen_ResetIter)(pmem.pmem_stores);
-    struct pmem_st *being_fenced = NULL;
-    while ((being_fenced = VG_(OSetGen_Next)(pmem.pmem_stores)) != NULL) {
-        if (being_fenced->state == STST_FLUSHED) {
-            being_fenced->state = STST_FENCED;
-        } else if (being_fenced->state == STST_COMMITTED) {
-            /* remove it from the oset */
-            struct pmem_st temp = *being_fenced;
-            VG_(OSetGen_Remove)(pmem.pmem_stores, being_fenced);
-            VG_(OSetGen_FreeNode)(pmem.pmem_stores, being_fenced);
-            /* reset the iterator (remove invalidated store) */
-            VG_(OSetGen_ResetIterAt)(pmem.pmem_stores, &temp);
+        log_event(LOG_FENCE, "|FENCE");
+
+    /*
+     * Go through the lines with flushed or committed stores and move the
+     * stores from flushed to fenced. Each store is handled in its first line.
+     */
+    struct pmem_line *lines = pmem.fence_list;
+    struct pmem_line *line, *next;
+    pmem.fence_list = NULL;
+    for (line = lines; line != NULL; line = line->next_fence) {
+        if (!(line->state & (LINE_FLUSHED | LINE_COMMITTED)))
+            continue;
+
+        UWord i = 0;
+        while (i < line->n_stores) {
+            struct pmem_st *being_fenced = line->stores[i];
+            if (line_of(being_fenced->addr) != line->key) {
+                ++i;
+            } else if (being_fenced->state == STST_FLUSHED) {
+                being_fenced->state = STST_FENCED;
+                update_store_lines(being_fenced);
+                ++i;
+            } else if (being_fenced->state == STST_COMMITTED) {
+                /* forget it, this moves another store to index i */
+                unindex_store(being_fenced);
+                VG_(free)(being_fenced);
+            } else {
+                ++i;
+            }
         }
     }
+
+    /* the lines are now off the fence list, requeue or free them */
+    for (line = lines; line != NULL; line = next) {
+        next = line->next_fence;
+        line->on_fence_list = False;
+        if (!line->on_commit_list)
+            recompute_line_state(line);
+    }
 }
 
 /**
@@ -741,13 +1381,35 @@ do_commit(void)
 {
     if (pmem.log_stores && (pmem.loggin_on
             || (VG_(OSetGen_Size)(pmem.loggable_regions) != 0)))
-        VG_(emit)("|COMMIT");
-    /* go through the stores and move them from fenced to clean */
-    VG_(OSetGen_ResetIter)(pmem.pmem_stores);
-    struct pmem_st *being_fenced = NULL;
-    while ((being_fenced = VG_(OSetGen_Next)(pmem.pmem_stores)) != NULL) {
-        if (being_fenced->state == STST_FENCED)
-            being_fenced->state = STST_COMMITTED;
+        log_event(LOG_COMMIT, "|COMMIT");
+    /*
+     * Go through the lines with fenced stores and move the stores from
+     * fenced to committed. Each store is handled in its first line.
+     */
+    struct pmem_line *lines = pmem.commit_list;
+    struct pmem_line *line, *next;
+    pmem.commit_list = NULL;
+    for (line = lines; line != NULL; line = line->next_commit) {
+        if (!(line->state & LINE_FENCED))
+            continue;
+
+        UWord i;
+        for (i = 0; i < line->n_stores; ++i) {
+            struct pmem_st *being_committed = line->stores[i];
+            if (line_of(being_committed->addr) == line->key
+                    && being_committed->state == STST_FENCED) {
+                being_committed->state = STST_COMMITTED;
+                update_store_lines(being_committed);
+            }
+        }
+    }
+
+    /* the lines are now off the commit list, requeue or free them */
+    for (line = lines; line != NULL; line = next) {
+        next = line->next_commit;
+        line->on_commit_list = False;
+        if (!line->on_fence_list)
+            recompute_line_state(line);
     }
 }
 
@@ -777,21 +1439,14 @@ do_flush(UWord base, UWord size)
 
     if (pmem.log_stores && (pmem.loggin_on
             || (VG_(OSetGen_Size)(pmem.loggable_regions) != 0)))
-        VG_(emit)("|FLUSH;0x%lx;0x%llx", flush_info.addr, flush_info.size);
-
-    /* unfortunately lookup doesn't work here, the oset is an avl tree */
+        log_flush(flush_info.addr, flush_info.size);
 
     Bool valid_flush = False;
-    /* reset the iterator */
-    VG_(OSetGen_ResetIter)(pmem.pmem_stores);
     Addr flush_max = flush_info.addr + flush_info.size;
-    struct pmem_st *being_flushed;
-    while ((being_flushed = VG_(OSetGen_Next)(pmem.pmem_stores)) != NULL){
-
-       /* not an interesting entry, flush doesn't matter */
-       if (cmp_pmem_st(&flush_info, being_flushed) != 0) {
-           continue;
-       }
+    UWord n = collect_stores(flush_info.addr, flush_max);
+    UWord i;
+    for (i = 0; i < n; ++i) {
+       struct pmem_st *being_flushed = pmem.found_stores[i];
 
        valid_flush = True;
        /* check for multiple flushes of stores */
@@ -809,45 +1464,47 @@ do_flush(UWord base, UWord size)
            continue;
        }
 
+       if (being_flushed->addr >= flush_info.addr
+               && being_flushed->addr + being_flushed->size <= flush_max) {
+           /* store fully flushed */
+           being_flushed->state = STST_FLUSHED;
+           update_store_lines(being_flushed);
+           continue;
+       }
+
+       /* the store is split, reindex the parts */
+       unindex_store(being_flushed);
        being_flushed->state = STST_FLUSHED;
 
        /* store starts before base flush address */
        if (being_flushed->addr < flush_info.addr) {
-            /* split and reinsert */
-            struct pmem_st *split = VG_(OSetGen_AllocNode)(pmem.pmem_stores,
-                    (SizeT)sizeof (struct pmem_st));
+            struct pmem_st *split = VG_(malloc)("pmc.main.df.1",
+                    sizeof (struct pmem_st));
             *split = *being_flushed;
             split->size = flush_info.addr - being_flushed->addr;
             split->state = STST_DIRTY;
+            index_store(split);
 
             /* adjust original */
-            VG_(OSetGen_Remove)(pmem.pmem_stores, being_flushed);
             being_flushed->addr = flush_info.addr;
             being_flushed->size -= split->size;
-            VG_(OSetGen_Insert)(pmem.pmem_stores, split);
-            VG_(OSetGen_Insert)(pmem.pmem_stores, being_flushed);
-            /* reset iter */
-            VG_(OSetGen_ResetIterAt)(pmem.pmem_stores, being_flushed);
        }
 
        /* end of store is behind max flush */
        if (being_flushed->addr + being_flushed->size > flush_max) {
-            /* split and reinsert */
-            struct pmem_st *split = VG_(OSetGen_AllocNode)(pmem.pmem_stores,
-                    (SizeT)sizeof (struct pmem_st));
+            struct pmem_st *split = VG_(malloc)("pmc.main.df.2",
+                    sizeof (struct pmem_st));
             *split = *being_flushed;
             split->addr = flush_max;
             split->size = being_flushed->addr + being_flushed->size - flush_max;
             split->state = STST_DIRTY;
+            index_store(split);
 
             /* adjust original */
-            VG_(OSetGen_Remove)(pmem.pmem_stores, being_flushed);
             being_flushed->size -= split->size;
-            VG_(OSetGen_Insert)(pmem.pmem_stores, split);
-            VG_(OSetGen_Insert)(pmem.pmem_stores, being_flushed);
-            /* reset iter */
-            VG_(OSetGen_ResetIterAt)(pmem.pmem_stores, split);
        }
+
+       index_store(being_flushed);
     }
 
     if (!valid_flush && pmem.check_flush) {
@@ -973,8 +1630,7 @@ register_new_file(Int fd, UWord base, UWord size, UWord offset)
 
     /* logging_on shall have no effect on this */
     if (pmem.log_stores)
-        VG_(emit)("|REGISTER_FILE;%s;0x%lx;0x%lx;0x%lx", file_name, base,
-                size, offset);
+        log_register_file(file_name, base, size, offset);
 out:
     VG_(free)(file_name);
     return retval;
@@ -1070,10 +1726,11 @@ static Bool handle_gdb_monitor_command(ThreadId tid, HChar *req)
 
         case  2: {/* print_pmem_regions */
             VG_(gdb_printf)("Registered persistent memory regions:\n");
-            struct pmem_st *tmp;
-            while ((tmp = VG_(OSetGen_Next)(pmem.pmem_stores)) != NULL) {
+            UWord n = collect_all_stores();
+            UWord i;
+            for (i = 0; i < n; ++i) {
                 VG_(gdb_printf)("\tAddress: 0x%lx \tsize: %llu\n",
-                        tmp->addr, tmp->size);
+                        pmem.found_stores[i]->addr, pmem.found_stores[i]->size);
             }
             return True;
         }
@@ -1350,6 +2007,7 @@ pmc_handle_client_request(ThreadId tid, UWord *arg, UWord *ret )
             temp_info.size = arg[2];
 
             add_region(&temp_info, pmem.pmem_mappings);
+            update_pmem_page_map(temp_info.addr, temp_info.size);
             break;
         }
 
@@ -1359,6 +2017,7 @@ pmc_handle_client_request(ThreadId tid, UWord *arg, UWord *ret )
             temp_info.size = arg[2];
 
             remove_region(&temp_info, pmem.pmem_mappings);
+            update_pmem_page_map(temp_info.addr, temp_info.size);
             break;
         }
 
@@ -1444,37 +2103,33 @@ pmc_handle_client_request(ThreadId tid, UWord *arg, UWord *ret )
         case VG_USERREQ__PMC_FULL_REORDED: {
             if (pmem.log_stores && (pmem.loggin_on || (VG_(OSetGen_Size)
                     (pmem.loggable_regions) != 0)))
-                VG_(emit)("|FREORDER");
+                log_event(LOG_FREORDER, "|FREORDER");
             break;
         }
 
         case VG_USERREQ__PMC_PARTIAL_REORDER: {
             if (pmem.log_stores && (pmem.loggin_on || (VG_(OSetGen_Size)
                     (pmem.loggable_regions) != 0)))
-                VG_(emit)("|PREORDER");
+                log_event(LOG_PREORDER, "|PREORDER");
             break;
         }
 
         case VG_USERREQ__PMC_ONLY_FAULT: {
             if (pmem.log_stores && (pmem.loggin_on || (VG_(OSetGen_Size)
                     (pmem.loggable_regions) != 0)))
-                VG_(emit)("|FAULT_ONLY");
+                log_event(LOG_FAULT_ONLY, "|FAULT_ONLY");
             break;
         }
 
         case VG_USERREQ__PMC_STOP_REORDER_FAULT: {
             if (pmem.log_stores && (pmem.loggin_on || (VG_(OSetGen_Size)
                     (pmem.loggable_regions) != 0)))
-                VG_(emit)("|NO_REORDER_FAULT");
+                log_event(LOG_NO_REORDER_FAULT, "|NO_REORDER_FAULT");
             break;
         }
 
         case VG_USERREQ__PMC_SET_CLEAN: {
-            struct pmem_st temp_info = {0};
-            temp_info.addr = arg[1];
-            temp_info.size = arg[2];
-
-            remove_region(&temp_info, pmem.pmem_stores);
+            remove_stores(arg[1], arg[2]);
             break;
         }
 
@@ -1560,6 +2215,7 @@ pmc_process_cmd_line_option(const HChar *arg)
     if VG_BOOL_CLO(arg, "--mult-stores", pmem.track_multiple_stores) {}
     else if VG_BINT_CLO(arg, "--indiff", pmem.store_sb_indiff, 0, UINT_MAX) {}
     else if VG_BOOL_CLO(arg, "--log-stores", pmem.log_stores) {}
+    else if VG_STR_CLO(arg, "--log-stores-file", pmem.log_file) {}
     else if VG_BOOL_CLO(arg, "--print-summary", pmem.print_summary) {}
     else if VG_BOOL_CLO(arg, "--flush-check", pmem.check_flush) {}
     else if VG_BOOL_CLO(arg, "--flush-align", pmem.force_flush_align) {}
@@ -1577,8 +2233,9 @@ pmc_process_cmd_line_option(const HChar *arg)
 static void
 pmc_post_clo_init(void)
 {
-    pmem.pmem_stores = VG_(OSetGen_Create)(/*keyOff*/0, cmp_pmem_st,
-            VG_(malloc), "pmc.main.cpci.1", VG_(free));
+    pmem.flush_align_size = read_cache_line_size();
+
+    pmem.pmem_stores = VG_(HT_construct)("pmc.main.cpci.1");
 
     if (pmem.track_multiple_stores)
         pmem.multiple_stores = VG_(malloc)("pmc.main.cpci.2",
@@ -1590,18 +2247,37 @@ pmc_post_clo_init(void)
     pmem.pmem_mappings = VG_(OSetGen_Create)(/*keyOff*/0, cmp_pmem_st,
             VG_(malloc), "pmc.main.cpci.4", VG_(free));
 
+    Int i;
+    for (i = 0; i < (1 << PMEM_PRIM_BITS); ++i)
+        pmem_page_map[i] = pmem_page_map_none;
+
     pmem.loggable_regions = VG_(OSetGen_Create)(/*keyOff*/0, cmp_pmem_st,
             VG_(malloc), "pmc.main.cpci.5", VG_(free));
 
     pmem.superfluous_flushes = VG_(malloc)("pmc.main.cpci.6",
             MAX_FLUSH_ERROR_EVENTS * sizeof (struct pmem_st *));
 
-    pmem.flush_align_size = read_cache_line_size();
-
     init_transactions(pmem.transactions_only);
 
+    if (pmem.log_file) {
+        pmem.log_stores = True;
+
+        HChar *name = VG_(expand_file_name)("--log-stores-file",
+                pmem.log_file);
+        pmem.log_fd = VG_(fd_open)(name, O_CREAT | O_WRONLY | O_TRUNC, 0600);
+        if (pmem.log_fd < 0)
+            VG_(fmsg_bad_option)("--log-stores-file",
+                    "Cannot create the store log file '%s'\n", name);
+        VG_(free)(name);
+
+        pmem.log_buf = VG_(malloc)("pmc.main.cpci.7", LOG_BUFFER_SIZE);
+        VG_(memcpy)(pmem.log_buf, LOG_MAGIC, sizeof (LOG_MAGIC) - 1);
+        pmem.log_buf_used = sizeof (LOG_MAGIC) - 1;
+        VG_(atfork)(flush_log_buffer_at_fork, NULL, NULL);
+    }
+
     if (pmem.log_stores)
-        VG_(emit)("START");
+        log_event(LOG_START, "START");
 }
 
 /**
@@ -1617,6 +2293,8 @@ pmc_print_usage(void)
             "                               address default [no]\n"
             "    --log-stores=<yes|no>      log all stores to persistence\n"
             "                               default [no]\n"
+            "    --log-stores-file=<file>   log all stores to persistence to\n"
+            "                               <file> in binary, see pmc_log2txt\n"
             "    --print-summary=<yes|no>   print summary on program exit\n"
             "                               default [yes]\n"
             "    --flush-check=<yes|no>     register multiple flushes of stores\n"
@@ -1649,7 +2327,13 @@ static void
 pmc_fini(Int exitcode)
 {
     if (pmem.log_stores)
-        VG_(emit)("|STOP\n");
+        log_event(LOG_STOP, "|STOP\n");
+
+    if (pmem.log_fd >= 0) {
+        flush_log_buffer();
+        VG_(close)(pmem.log_fd);
+        pmem.log_fd = -1;
+    }
 
     if (pmem.print_summary)
         print_pmem_stats(False);
@@ -1685,6 +2369,7 @@ pmc_pre_clo_init(void)
 
     pmem.print_summary = True;
     pmem.automatic_isa_rec = True;
+    pmem.log_fd = -1;
 }
 
 VG_DETERMINE_INTERFACE_VERSION(pmc_pre_clo_init)
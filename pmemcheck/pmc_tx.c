@@ -14,12 +14,14 @@
  */
 
 #include "pub_tool_oset.h"
+#include "pub_tool_hashtable.h"
 #include "pub_tool_mallocfree.h"
 #include "pub_tool_options.h"
 #include "pub_tool_threadstate.h"
 #include "pub_tool_libcprint.h"
 #include "pub_tool_libcassert.h"
 #include "pub_tool_execontext.h"
+#include "pub_tool_libcbase.h"
 
 #include "pmc_include.h"
 
@@ -27,6 +29,15 @@
 
 #define MAX_CROSS_EVS 1000UL
 
+/** The log2 of the granule size of the transaction region index. */
+#define TX_INDEX_GRANULE_BITS 8
+
+/**
+ * Regions spanning more granules are not indexed, the transaction is
+ * instead checked for every store.
+ */
+#define TX_INDEX_MAX_GRANULES 64UL
+
 /** Transaction descriptor. */
 struct tx_info {
     /** The id of the transaction. */
@@ -43,6 +54,30 @@ struct tx_info {
 
     /** The last added region - cached. */
     struct pmem_st cached_region;
+
+    /** Granules under which this transaction is in the region index. */
+    OSet *indexed;
+
+    /** True if the transaction has a region too big to be indexed. */
+    Bool wide;
+};
+
+/** Region index entry - the transactions with regions in a granule. */
+struct tx_granule {
+    /** Hash chain, has to be the first member. */
+    struct tx_granule *next;
+
+    /** The granule number - the address divided by the granule size. */
+    UWord key;
+
+    /** The ids of the transactions, in no particular order. */
+    UWord *tx_ids;
+
+    /** The number of transactions. */
+    UWord n_txs;
+
+    /** The allocated size of tx_ids. */
+    UWord max_txs;
 };
 
 /** Thread to transaction descriptor. */
@@ -97,6 +132,22 @@ static struct transaction_ops {
 
     /** Holds the number of registered out-of-transaction writes. */
     UWord cross_tx_reg;
+
+    /**
+     * Maps granules of memory to the transactions which registered regions
+     * overlapping them. A superset - regions removed from a transaction
+     * stay indexed until the transaction ends.
+     */
+    VgHashTable tx_index;
+
+    /** Ids of transactions with regions too big to be indexed. */
+    OSet *wide_txs;
+
+    /** Transaction ids found by the last call to collect_txs. */
+    UWord *found_txs;
+
+    /** The allocated size of found_txs. */
+    UWord found_txs_size;
 } trans;
 
 /**
@@ -119,6 +170,11 @@ void init_transactions(Bool transactions_only)
     trans.cross_tx_evs = VG_(malloc)("pmc.trans.cpci.5", MAX_CROSS_EVS
                             * sizeof (struct transaction_ops *));
 
+    trans.tx_index = VG_(HT_construct)("pmc.trans.cpci.6");
+
+    trans.wide_txs = VG_(OSetWord_Create)(VG_(malloc), "pmc.trans.cpci.7",
+                            VG_(free));
+
     trans.verbose = (VG_(clo_verbosity) > 1);
 
     trans.transactions_only = transactions_only;
@@ -278,6 +334,168 @@ create_get_thread_entry(UWord thread_id)
     return new_thread;
 }
 
+/**
+ * \brief Get the first and last granule of a region.
+ * \param[in] region The region.
+ * \param[out] first The first granule overlapped by the region.
+ * \param[out] last The last granule overlapped by the region.
+ */
+static void
+region_granules(const struct pmem_st *region, UWord *first, UWord *last)
+{
+    *first = region->addr >> TX_INDEX_GRANULE_BITS;
+    if (region->size == 0)
+        *last = *first;
+    else
+        *last = (region->addr + region->size - 1) >> TX_INDEX_GRANULE_BITS;
+}
+
+/**
+ * \brief Add a region of a transaction to the region index.
+ * \param[in,out] tx The transaction the region was added to.
+ * \param[in] region The added region.
+ */
+static void
+index_tx_region(struct tx_info *tx, const struct pmem_st *region)
+{
+    UWord first, last, key;
+    region_granules(region, &first, &last);
+
+    if (last - first >= TX_INDEX_MAX_GRANULES) {
+        if (!tx->wide) {
+            tx->wide = True;
+            VG_(OSetWord_Insert)(trans.wide_txs, tx->tx_id);
+        }
+        return;
+    }
+
+    for (key = first; key <= last; ++key) {
+        if (VG_(OSetWord_Contains)(tx->indexed, key))
+            continue;
+        VG_(OSetWord_Insert)(tx->indexed, key);
+
+        struct tx_granule *gr = VG_(HT_lookup)(trans.tx_index, key);
+        if (gr == NULL) {
+            gr = VG_(malloc)("pmc.trans.itr.1", sizeof (struct tx_granule));
+            VG_(memset)(gr, 0, sizeof (struct tx_granule));
+            gr->key = key;
+            VG_(HT_add_node)(trans.tx_index, gr);
+        }
+
+        if (gr->n_txs == gr->max_txs) {
+            gr->max_txs = gr->max_txs ? 2 * gr->max_txs : 4;
+            gr->tx_ids = VG_(realloc)("pmc.trans.itr.2", gr->tx_ids,
+                    gr->max_txs * sizeof (UWord));
+        }
+        gr->tx_ids[gr->n_txs++] = tx->tx_id;
+    }
+}
+
+/**
+ * \brief Remove all regions of a transaction from the region index.
+ * \param[in,out] tx The ending transaction.
+ */
+static void
+unindex_tx(struct tx_info *tx)
+{
+    UWord key;
+    VG_(OSetWord_ResetIter)(tx->indexed);
+    while (VG_(OSetWord_Next)(tx->indexed, &key)) {
+        struct tx_granule *gr = VG_(HT_lookup)(trans.tx_index, key);
+        tl_assert(gr != NULL);
+
+        UWord i;
+        for (i = 0; i < gr->n_txs; ++i) {
+            if (gr->tx_ids[i] == tx->tx_id) {
+                gr->tx_ids[i] = gr->tx_ids[--gr->n_txs];
+                break;
+            }
+        }
+
+        if (gr->n_txs == 0) {
+            VG_(HT_remove)(trans.tx_index, key);
+            VG_(free)(gr->tx_ids);
+            VG_(free)(gr);
+        }
+    }
+    VG_(OSetWord_Destroy)(tx->indexed);
+    tx->indexed = NULL;
+
+    if (tx->wide)
+        VG_(OSetWord_Remove)(trans.wide_txs, tx->tx_id);
+}
+
+/**
+ * \brief Compare transaction ids.
+ */
+static Int
+cmp_tx_ids(const void *lhs, const void *rhs)
+{
+    UWord l = *(const UWord *)lhs;
+    UWord r = *(const UWord *)rhs;
+
+    if (l < r)
+        return -1;
+    return l > r;
+}
+
+/**
+ * \brief Add a transaction id to found_txs.
+ * \param[in] tx_id The transaction id.
+ * \param[in,out] n The number of ids in found_txs.
+ */
+static void
+add_found_tx(UWord tx_id, UWord *n)
+{
+    if (*n == trans.found_txs_size) {
+        trans.found_txs_size = trans.found_txs_size
+                ? 2 * trans.found_txs_size : 64;
+        trans.found_txs = VG_(realloc)("pmc.trans.aft.1", trans.found_txs,
+                trans.found_txs_size * sizeof (UWord));
+    }
+    trans.found_txs[(*n)++] = tx_id;
+}
+
+/**
+ * \brief Find the transactions which may have regions overlapping a region.
+ *
+ * The region has to span at most TX_INDEX_MAX_GRANULES granules.
+ * \param[in] region The region.
+ * \return The number of transactions found, their ids are in found_txs
+ * sorted and without duplicates, and stay valid until the next call.
+ */
+static UWord
+collect_txs(const struct pmem_st *region)
+{
+    UWord first, last, key, i;
+    UWord n = 0;
+    region_granules(region, &first, &last);
+
+    for (key = first; key <= last; ++key) {
+        struct tx_granule *gr = VG_(HT_lookup)(trans.tx_index, key);
+        if (gr == NULL)
+            continue;
+        for (i = 0; i < gr->n_txs; ++i)
+            add_found_tx(gr->tx_ids[i], &n);
+    }
+
+    UWord tx_id;
+    VG_(OSetWord_ResetIter)(trans.wide_txs);
+    while (VG_(OSetWord_Next)(trans.wide_txs, &tx_id))
+        add_found_tx(tx_id, &n);
+
+    if (n < 2)
+        return n;
+
+    VG_(ssort)(trans.found_txs, n, sizeof (UWord), cmp_tx_ids);
+    UWord unique = 1;
+    for (i = 1; i < n; ++i) {
+        if (trans.found_txs[i] != trans.found_txs[unique - 1])
+            trans.found_txs[unique++] = trans.found_txs[i];
+    }
+    return unique;
+}
+
 /**
  * \brief Check if given store is exactly the same region as the cached value.
  * \param store The store to check.
@@ -310,6 +528,9 @@ register_new_tx(UWord tx_id)
                                 VG_(malloc), "pmc.trans.cpci.1", VG_(free));
         new_tx->cached_region.addr = 0;
         new_tx->cached_region.size = 0;
+        new_tx->indexed = VG_(OSetWord_Create)(VG_(malloc),
+                                "pmc.trans.cpci.8", VG_(free));
+        new_tx->wide = False;
         VG_(OSetGen_Insert)(trans.transactions, new_tx);
     }
 
@@ -371,6 +592,7 @@ remove_tx(UWord tx_id)
             remove_thread_entry(elem);
     }
 
+    unindex_tx(tx);
     VG_(OSetGen_Destroy)(tx->regions);
     VG_(OSetGen_Remove)(trans.transactions, &tx_id);
     VG_(OSetGen_FreeNode)(trans.transactions, tx);
@@ -415,6 +637,24 @@ flush_cache(struct tx_info *tx)
     tx->cached_region.size = 0;
 }
 
+/**
+ * \brief Register a cross-transaction event if a region being added to a
+ * transaction is already in another one.
+ * \param[in] reg The region being added.
+ * \param[in] tx_id The id of the transaction the region is added to.
+ * \param[in] other The other transaction.
+ */
+static void
+check_cross_tx(const struct pmem_st *reg, UWord tx_id, struct tx_info *other)
+{
+    if (cmp_pmem_st(reg, &(other->cached_region)) == 0)
+        register_cross_event(&other->cached_region, other->tx_id,
+                             reg, tx_id);
+    else if (is_in_mapping_set(reg, other->regions))
+        register_cross_event(VG_(OSetGen_Lookup)(other->regions, reg),
+                             other->tx_id, reg, tx_id);
+}
+
 /**
  * \brief Add a memory region to a transaction.
  * \param[in] tx_id The id of the transaction the object will be added to.
@@ -449,19 +689,27 @@ add_obj_to_tx(UWord tx_id, UWord base, UWord size)
     reg.context = VG_(record_ExeContext)(VG_(get_running_tid)(), 0);
 
     /* check if it is already in any other transaction */
-    VG_(OSetGen_ResetIter)(trans.transactions);
-    struct tx_info *tx_iter;
-    while ((tx_iter = VG_(OSetGen_Next)(trans.transactions)) != NULL) {
-        /* omit self */
-        if (tx_iter->tx_id == tx_id)
-            continue;
-        if (cmp_pmem_st(&reg, &(tx_iter->cached_region)) == 0)
-            register_cross_event(&tx_iter->cached_region, tx_iter->tx_id,
-                                 &reg, tx_id);
-        else if (is_in_mapping_set(&reg, tx_iter->regions))
-            register_cross_event(VG_(OSetGen_Lookup)(tx_iter->regions, &reg),
-                                 tx_iter->tx_id, &reg, tx_id);
+    UWord first, last;
+    region_granules(&reg, &first, &last);
+    if (LIKELY(last - first < TX_INDEX_MAX_GRANULES)) {
+        /* only the transactions indexed under the region can overlap it */
+        UWord n = collect_txs(&reg);
+        UWord i;
+        for (i = 0; i < n; ++i) {
+            if (trans.found_txs[i] != tx_id)
+                check_cross_tx(&reg, tx_id, VG_(OSetGen_Lookup)
+                        (trans.transactions, &trans.found_txs[i]));
+        }
+    } else {
+        VG_(OSetGen_ResetIter)(trans.transactions);
+        struct tx_info *tx_iter;
+        while ((tx_iter = VG_(OSetGen_Next)(trans.transactions)) != NULL) {
+            /* omit self */
+            if (tx_iter->tx_id != tx_id)
+                check_cross_tx(&reg, tx_id, tx_iter);
+        }
     }
+    index_tx_region(tx, &reg);
 
     /* cache not empty, consider options */
     if (LIKELY((tx->cached_region.addr != 0)
@@ -673,14 +921,22 @@ handle_tx_store(const struct pmem_st *store)
         return;
     }
 
-    /* ensure store is within any of the transactions */
-    UWord tx_id;
-    VG_(OSetWord_ResetIter)(tinfo->tx_ids);
-    while (VG_(OSetWord_Next)(tinfo->tx_ids, &tx_id)) {
-        if (is_store_in_tx(store, tx_id))
+    /*
+     * ensure store is within any of the transactions, a region containing
+     * the store is indexed under the granule of its first byte
+     */
+    struct pmem_st first_byte = {0};
+    first_byte.addr = store->addr;
+    first_byte.size = 1;
+    UWord n = collect_txs(&first_byte);
+    UWord i;
+    for (i = 0; i < n; ++i) {
+        if (VG_(OSetWord_Contains)(tinfo->tx_ids, trans.found_txs[i])
+                && is_store_in_tx(store, trans.found_txs[i]))
             return;
     }
 
+    UWord tx_id;
     if (trans.verbose) {
         VG_(OSetWord_ResetIter)(tinfo->tx_ids);
         while (VG_(OSetWord_Next)(tinfo->tx_ids, &tx_id)) {
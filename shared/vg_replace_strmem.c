@@ -854,7 +854,18 @@ static inline void my_exit ( int x )
                /* Pull up to a UWord boundary. */ \
                while ((s & WM) != 0 && n >= 1) \
                   { *(UChar*)d = *(UChar*)s; s += 1; d += 1; n -= 1; } \
-               /* Copy UWords. */ \
+               /* Copy UWords, four at a time while we can. */ \
+               while (n >= 4 * WS) { \
+                  UWord w0 = ((UWord*)s)[0]; \
+                  UWord w1 = ((UWord*)s)[1]; \
+                  UWord w2 = ((UWord*)s)[2]; \
+                  UWord w3 = ((UWord*)s)[3]; \
+                  ((UWord*)d)[0] = w0; \
+                  ((UWord*)d)[1] = w1; \
+                  ((UWord*)d)[2] = w2; \
+                  ((UWord*)d)[3] = w3; \
+                  s += 4 * WS; d += 4 * WS; n -= 4 * WS; \
+               } \
                while (n >= WS) \
                   { *(UWord*)d = *(UWord*)s; s += WS; d += WS; n -= WS; } \
                if (n == 0) \
@@ -940,18 +951,40 @@ static inline void my_exit ( int x )
 
 /*---------------------- memcmp ----------------------*/
 
+/* memcmp may read all n bytes of both arguments, so when they have the
+   same UWord alignment we can compare a UWord at a time, and go back
+   to bytes for the word that differs.  Under Memcheck the word
+   comparison can involve bytes after the first difference that are
+   undefined; Memcheck instruments these replacements with its exact
+   (expensive) comparisons, so that doesn't give an error the byte loop
+   wouldn't. */
 #define MEMCMP(soname, fnname) \
    int VG_REPLACE_FUNCTION_EZU(20190,soname,fnname)       \
           ( const void *s1V, const void *s2V, SizeT n ); \
    int VG_REPLACE_FUNCTION_EZU(20190,soname,fnname)       \
           ( const void *s1V, const void *s2V, SizeT n )  \
    { \
+      const SizeT WS = sizeof(UWord); /* 8 or 4 */ \
+      const SizeT WM = WS - 1;        /* 7 or 3 */ \
       int res; \
       UChar a0; \
       UChar b0; \
       const UChar* s1 = s1V; \
       const UChar* s2 = s2V; \
       \
+      if ((((Addr)s1 ^ (Addr)s2) & WM) == 0) { \
+         /* Pull up to a UWord boundary. */ \
+         while (((Addr)s1 & WM) != 0 && n >= 1) { \
+            res = ((int)s1[0]) - ((int)s2[0]); \
+            if (res != 0) \
+               return res; \
+            s1 += 1; s2 += 1; n -= 1; \
+         } \
+         /* Compare UWords; the byte loop finds the difference. */ \
+         while (n >= WS && *(const UWord*)s1 == *(const UWord*)s2) \
+            { s1 += WS; s2 += WS; n -= WS; } \
+      } \
+      \
       while (n != 0) { \
          a0 = s1[0]; \
          b0 = s2[0]; \
@@ -1070,6 +1103,11 @@ static inline void my_exit ( int x )
          c8 = (c8 << 32) | c8; \
          while ((a & 7) != 0 && n >= 1) \
             { *(UChar*)a = (UChar)c; a += 1; n -= 1; } \
+         while (n >= 32) { \
+            ((ULong*)a)[0] = c8; ((ULong*)a)[1] = c8; \
+            ((ULong*)a)[2] = c8; ((ULong*)a)[3] = c8; \
+            a += 32; n -= 32; \
+         } \
          while (n >= 8) \
             { *(ULong*)a = c8; a += 8; n -= 8; } \
          while (n >= 1) \
@@ -1082,6 +1120,11 @@ static inline void my_exit ( int x )
          c4 = (c4 << 16) | c4; \
          while ((a & 3) != 0 && n >= 1) \
             { *(UChar*)a = (UChar)c; a += 1; n -= 1; } \
+         while (n >= 16) { \
+            ((UInt*)a)[0] = c4; ((UInt*)a)[1] = c4; \
+            ((UInt*)a)[2] = c4; ((UInt*)a)[3] = c4; \
+            a += 16; n -= 16; \
+         } \
          while (n >= 4) \
             { *(UInt*)a = c4; a += 4; n -= 4; } \
          while (n >= 1) \